@@ -0,0 +1,69 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ChargedTrackPartition.h
+/// \brief Tracks of a collision split by the sign of their charge, for building track combinations
+
+#ifndef O2_ANALYSIS_CHARGEDTRACKPARTITION_H_
+#define O2_ANALYSIS_CHARGEDTRACKPARTITION_H_
+
+#include <array>
+#include <vector>
+
+#include "ReconstructionDataFormats/Track.h"
+#include "AnalysisCore/trackUtilities.h"
+
+/// Tracks of a collision split by the sign of their charge, each with its parametrisation.
+///
+/// Loops building combinations of opposite- or like-sign tracks run over the tracks of one
+/// sign only, instead of testing the sign of every track in every inner loop, and the track
+/// parametrisations needed by the vertexing are extracted once per track rather than once per
+/// combination. The tracks keep their order in the table, so that the combinations come out
+/// in the same order as with loops over the full table.
+/// \tparam T  track (iterator) type
+template <typename T>
+class ChargedTrackPartition
+{
+ public:
+  enum Sign { Positive = 0,
+              Negative = 1 };
+
+  struct Entry {
+    T track;
+    o2::track::TrackParCov trackParCov;
+  };
+
+  /// Fills the partition with the tracks for which select(track) is true.
+  /// The storage is reused between calls.
+  /// \param tracks  table of the tracks of the collision
+  /// \param select  selection applied to every track (iterator)
+  template <typename TTracks, typename TSelect>
+  void fill(const TTracks& tracks, TSelect&& select)
+  {
+    for (auto& entries : mEntries) {
+      entries.clear();
+    }
+    for (auto track = tracks.begin(); track != tracks.end(); ++track) {
+      if (!select(track)) {
+        continue;
+      }
+      mEntries[track.signed1Pt() < 0.f ? Negative : Positive].push_back(Entry{track, getTrackParCov(track)});
+    }
+  }
+
+  /// \return tracks with the given sign of the charge
+  const std::vector<Entry>& get(Sign sign) const { return mEntries[sign]; }
+
+ private:
+  std::array<std::vector<Entry>, 2> mEntries; ///< tracks per sign
+};
+
+#endif // O2_ANALYSIS_CHARGEDTRACKPARTITION_H_
@@ -28,6 +28,7 @@
 #include "fastjet/tools/Subtractor.hh"
 #include "fastjet/contrib/ConstituentSubtractor.hh"
 
+#include <tuple>
 #include <vector>
 
 class JetFinder
@@ -156,6 +157,7 @@ class JetFinder
 
   /// Performs jet finding
   /// \note the input particle and jet lists are passed by reference
+  /// \note the jet, area and background definitions are only rebuilt when the parameters changed since the previous call
   /// \param inputParticles vector of input particles/tracks
   /// \param jets veector of jets to be filled
   /// \return ClusterSequenceArea object needed to access constituents
@@ -168,6 +170,22 @@ class JetFinder
   std::unique_ptr<fastjet::Subtractor> sub;
   std::unique_ptr<fastjet::contrib::ConstituentSubtractor> constituentSub;
 
+  /// parameters the definitions are built from
+  using Config = std::tuple<bool, float, float, float, float, float, float, float, float, float,
+                            float, float, int, double, float, float,
+                            float, float, float, float, float, float, float, BkgSubMode,
+                            fastjet::JetAlgorithm, fastjet::RecombinationScheme, fastjet::Strategy, fastjet::AreaType,
+                            fastjet::JetAlgorithm, fastjet::RecombinationScheme, fastjet::Strategy, fastjet::AreaType>;
+  Config getConfig() const
+  {
+    return Config{isReclustering, etaMin, etaMax, jetR, jetPtMin, jetPtMax, jetPhiMin, jetPhiMax, jetEtaMin, jetEtaMax,
+                  ghostEtaMax, ghostArea, ghostRepeatN, ghostktMean, gridScatter, ktScatter,
+                  jetBkgR, bkgPhiMin, bkgPhiMax, bkgEtaMin, bkgEtaMax, constSubAlpha, constSubRMax, bkgSubMode,
+                  algorithm, recombScheme, strategy, areaType, algorithmBkg, recombSchemeBkg, strategyBkg, areaTypeBkg};
+  }
+  bool mConfigured = false; //!
+  Config mConfig;           //! parameters of the current definitions
+
   ClassDefNV(JetFinder, 1);
 };
 
@@ -176,8 +194,20 @@ template <typename T>
 void fillConstituents(const T& constituent, std::vector<fastjet::PseudoJet>& constituents)
 {
 
-  auto energy = std::sqrt(constituent.p() * constituent.p() + JetFinder::mPion * JetFinder::mPion);
+  auto p = constituent.p();
+  auto energy = std::sqrt(p * p + JetFinder::mPion * JetFinder::mPion);
   constituents.emplace_back(constituent.px(), constituent.py(), constituent.pz(), energy);
 }
 
+/// Fills the constituents from all tracks of the table, with their global index as user index
+template <typename T>
+void fillConstituentsFromTable(const T& tracks, std::vector<fastjet::PseudoJet>& constituents)
+{
+  constituents.reserve(constituents.size() + tracks.size());
+  for (auto& track : tracks) {
+    fillConstituents(track, constituents);
+    constituents.back().set_user_index(track.globalIndex());
+  }
+}
+
 #endif
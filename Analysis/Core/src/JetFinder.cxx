@@ -75,13 +75,19 @@ void JetFinder::setSub()
 /// \return ClusterSequenceArea object needed to access constituents
 fastjet::ClusterSequenceArea JetFinder::findJets(std::vector<fastjet::PseudoJet>& inputParticles, std::vector<fastjet::PseudoJet>& jets) //ideally find a way of passing the cluster sequence as a reeference
 {
-  setParams();
-  setBkgE();
+  if (!mConfigured || getConfig() != mConfig) {
+    setParams();
+    setBkgE();
+    if (bkgE) {
+      setSub();
+    }
+    mConfig = getConfig();
+    mConfigured = true;
+  }
   jets.clear();
 
   if (bkgE) {
     bkgE->set_particles(inputParticles);
-    setSub();
   }
   if (constituentSub) {
     inputParticles = constituentSub->subtract_event(inputParticles);
@@ -21,6 +21,7 @@
 #include "DetectorsVertexing/DCAFitterN.h"
 #include "AnalysisDataModel/HFSecondaryVertex.h"
 #include "AnalysisCore/trackUtilities.h"
+#include "AnalysisCore/ChargedTrackPartition.h"
 #include "AnalysisDataModel/EventSelection.h"
 //#include "AnalysisDataModel/Centrality.h"
 #include "AnalysisDataModel/StrangenessTables.h"
@@ -734,6 +735,8 @@ struct HfTrackIndexSkimsCreator {
   // FIXME
   //Partition<SelectedTracks> tracksPos = aod::track::signed1Pt > 0.f;
   //Partition<SelectedTracks> tracksNeg = aod::track::signed1Pt < 0.f;
+  using TrackPartition = ChargedTrackPartition<SelectedTracks::iterator>;
+  TrackPartition trackPartition; // tracks of the current collision, split by charge
 
   // int nColls{0}; //can be added to run over limited collisions per file - for tesing purposes
 
@@ -792,33 +795,26 @@ struct HfTrackIndexSkimsCreator {
     auto nCand2 = rowTrackIndexProng2.lastIndex();
     auto nCand3 = rowTrackIndexProng3.lastIndex();
 
+    // split the tracks selected for 2- or 3-prong candidates by charge, with their parametrisation
+    trackPartition.fill(tracks, [](const auto& track) {
+      return TESTBIT(track.isSelProng(), CandidateType::Cand2Prong) || TESTBIT(track.isSelProng(), CandidateType::Cand3Prong);
+    });
+    const auto& tracksPos = trackPartition.get(TrackPartition::Positive);
+    const auto& tracksNeg = trackPartition.get(TrackPartition::Negative);
+
     // first loop over positive tracks
-    //for (auto trackPos1 = tracksPos.begin(); trackPos1 != tracksPos.end(); ++trackPos1) {
-    for (auto trackPos1 = tracks.begin(); trackPos1 != tracks.end(); ++trackPos1) {
-      if (trackPos1.signed1Pt() < 0) {
-        continue;
-      }
+    for (auto iPos1 = 0u; iPos1 < tracksPos.size(); ++iPos1) {
+      const auto& trackPos1 = tracksPos[iPos1].track;
+      const auto& trackParVarPos1 = tracksPos[iPos1].trackParCov;
       bool sel2ProngStatusPos = TESTBIT(trackPos1.isSelProng(), CandidateType::Cand2Prong);
       bool sel3ProngStatusPos1 = TESTBIT(trackPos1.isSelProng(), CandidateType::Cand3Prong);
-      if (!sel2ProngStatusPos && !sel3ProngStatusPos1) {
-        continue;
-      }
-
-      auto trackParVarPos1 = getTrackParCov(trackPos1);
 
       // first loop over negative tracks
-      //for (auto trackNeg1 = tracksNeg.begin(); trackNeg1 != tracksNeg.end(); ++trackNeg1) {
-      for (auto trackNeg1 = tracks.begin(); trackNeg1 != tracks.end(); ++trackNeg1) {
-        if (trackNeg1.signed1Pt() > 0) {
-          continue;
-        }
+      for (auto iNeg1 = 0u; iNeg1 < tracksNeg.size(); ++iNeg1) {
+        const auto& trackNeg1 = tracksNeg[iNeg1].track;
+        const auto& trackParVarNeg1 = tracksNeg[iNeg1].trackParCov;
         bool sel2ProngStatusNeg = TESTBIT(trackNeg1.isSelProng(), CandidateType::Cand2Prong);
         bool sel3ProngStatusNeg1 = TESTBIT(trackNeg1.isSelProng(), CandidateType::Cand3Prong);
-        if (!sel2ProngStatusNeg && !sel3ProngStatusNeg1) {
-          continue;
-        }
-
-        auto trackParVarNeg1 = getTrackParCov(trackNeg1);
 
         int isSelected2ProngCand = n2ProngBit; //bitmap for checking status of two-prong candidates (1 is true, 0 is rejected)
 
@@ -903,11 +899,8 @@ struct HfTrackIndexSkimsCreator {
           }
 
           // second loop over positive tracks
-          //for (auto trackPos2 = trackPos1 + 1; trackPos2 != tracksPos.end(); ++trackPos2) {
-          for (auto trackPos2 = trackPos1 + 1; trackPos2 != tracks.end(); ++trackPos2) {
-            if (trackPos2.signed1Pt() < 0) {
-              continue;
-            }
+          for (auto iPos2 = iPos1 + 1; iPos2 < tracksPos.size(); ++iPos2) {
+            const auto& trackPos2 = tracksPos[iPos2].track;
             if (!TESTBIT(trackPos2.isSelProng(), CandidateType::Cand3Prong)) {
               continue;
             }
@@ -929,7 +922,7 @@ struct HfTrackIndexSkimsCreator {
             }
 
             // reconstruct the 3-prong secondary vertex
-            auto trackParVarPos2 = getTrackParCov(trackPos2);
+            const auto& trackParVarPos2 = tracksPos[iPos2].trackParCov;
             if (df3.process(trackParVarPos1, trackParVarNeg1, trackParVarPos2) == 0) {
               continue;
             }
@@ -1013,11 +1006,8 @@ struct HfTrackIndexSkimsCreator {
           }
 
           // second loop over negative tracks
-          //for (auto trackNeg2 = trackNeg1 + 1; trackNeg2 != tracksNeg.end(); ++trackNeg2) {
-          for (auto trackNeg2 = trackNeg1 + 1; trackNeg2 != tracks.end(); ++trackNeg2) {
-            if (trackNeg2.signed1Pt() > 0) {
-              continue;
-            }
+          for (auto iNeg2 = iNeg1 + 1; iNeg2 < tracksNeg.size(); ++iNeg2) {
+            const auto& trackNeg2 = tracksNeg[iNeg2].track;
             if (!TESTBIT(trackNeg2.isSelProng(), CandidateType::Cand3Prong)) {
               continue;
             }
@@ -1039,7 +1029,7 @@ struct HfTrackIndexSkimsCreator {
             }
 
             // reconstruct the 3-prong secondary vertex
-            auto trackParVarNeg2 = getTrackParCov(trackNeg2);
+            const auto& trackParVarNeg2 = tracksNeg[iNeg2].trackParCov;
             if (df3.process(trackParVarNeg1, trackParVarPos1, trackParVarNeg2) == 0) {
               continue;
             }
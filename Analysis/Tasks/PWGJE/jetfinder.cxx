@@ -87,13 +87,7 @@ struct JetFinderTask {
     jets.clear();
     inputParticles.clear();
 
-    for (auto& track : tracks) {
-      /*  auto energy = std::sqrt(track.p() * track.p() + mPion*mPion);
-      inputParticles.emplace_back(track.px(), track.py(), track.pz(), energy);
-      inputParticles.back().set_user_index(track.globalIndex());*/
-      fillConstituents(track, inputParticles);
-      inputParticles.back().set_user_index(track.globalIndex());
-    }
+    fillConstituentsFromTable(tracks, inputParticles);
 
     fastjet::ClusterSequenceArea clusterSeq(jetFinder.findJets(inputParticles, jets));
 
@@ -21,12 +21,53 @@
 #include <map>
 #include <unordered_map>
 #include <memory>
+#include <future>
+#include <mutex>
+#include <typeinfo>
 
 // #include <FairLogger.h>
 
 namespace o2::ccdb
 {
 
+/// Objects retrieved by the manager instances of a process which enabled the shared caching.
+/// An instance needing an object valid for a given timestamp takes it from here, if another instance has
+/// retrieved it, instead of querying CCDB. Only weak references are kept, the objects are owned by the instances.
+class CCDBSharedCache
+{
+ public:
+  struct Entry {
+    std::weak_ptr<void> objPtr;
+    const std::type_info* type = nullptr;
+    std::string uuid;
+    long startvalidity = 0;
+    long endvalidity = 0;
+  };
+
+  static CCDBSharedCache& instance()
+  {
+    static CCDBSharedCache inst;
+    return inst;
+  }
+
+  /// key of a query, objects can be shared only among identical queries
+  static std::string makeKey(std::string const& url, std::string const& path, std::map<std::string, std::string> const& metaData,
+                             long createdNotAfter, long createdNotBefore);
+
+  /// returns an object of the given type valid for the timestamp, with its description in entry, nullptr if there is none
+  std::shared_ptr<void> find(std::string const& key, long timestamp, std::type_info const& type, Entry& entry);
+
+  /// adds an object retrieved for the key
+  void add(std::string const& key, std::shared_ptr<void> const& objPtr, std::type_info const& type, std::string const& uuid,
+           long startvalidity, long endvalidity);
+
+  void clear();
+
+ private:
+  std::mutex mMutex;
+  std::unordered_multimap<std::string, Entry> mEntries;
+};
+
 /// A simple class offering simplified access to CCDB (mainly for MC simulation)
 /// The class encapsulates timestamp and URL and is easily usable from detector code.
 ///
@@ -39,11 +80,19 @@ namespace o2::ccdb
 
 class CCDBManagerInstance
 {
+  /// object retrieved in the background, with the headers of the reply
+  struct PrefetchedObject {
+    std::shared_ptr<void> objPtr;
+    const std::type_info* type = nullptr;
+    std::map<std::string, std::string> headers;
+  };
+
   struct CachedObject {
     std::shared_ptr<void> objPtr;
     std::string uuid;
     long startvalidity = 0;
     long endvalidity = 0;
+    std::future<PrefetchedObject> next; // the object following this one, when it is being prefetched
     bool isValid(long ts) { return ts < endvalidity && ts > startvalidity; }
   };
 
@@ -135,6 +184,22 @@ class CCDBManagerInstance
   /// reset the object upper validity limit
   void resetCreatedNotBefore() { mCreatedNotBefore = 0; }
 
+  /// get the time before the end of the validity of a cached object at which the next one is retrieved in the background
+  long getPrefetchMargin() const { return mPrefetchMargin; }
+
+  /// Set the time before the end of the validity of a cached object at which the next one is retrieved in the background,
+  /// so that crossing the end of validity does not wait for CCDB. 0 disables the prefetching.
+  /// It requires the caching and the checks of object validity.
+  void setPrefetchMargin(long v) { mPrefetchMargin = v > 0 ? v : 0; }
+
+  /// check if the cached objects are shared with the other instances of the process
+  bool isSharedCachingEnabled() const { return mSharedCachingEnabled; }
+
+  /// Share the cached objects with the other instances of the process which enable it. An object valid for the
+  /// requested timestamp which was retrieved by another instance is then used without querying CCDB.
+  /// The shared objects must not be modified. It requires the caching and the checks of object validity.
+  void setSharedCaching(bool v) { mSharedCachingEnabled = v; }
+
  private:
   // we access the CCDB via the CURL based C++ API
   o2::ccdb::CcdbApi mCCDBAccessor;
@@ -147,6 +212,16 @@ class CCDBManagerInstance
   bool mCheckObjValidityEnabled = false;                // wether the validity of cached object is checked before proceeding to a CCDB API query
   long mCreatedNotAfter = 0;                            // upper limit for object creation timestamp (TimeMachine mode) - If-Not-After HTTP header
   long mCreatedNotBefore = 0;                           // lower limit for object creation timestamp (TimeMachine mode) - If-Not-Before HTTP header
+  long mPrefetchMargin = 0;                             // time before the end of validity at which the next object is prefetched, 0 if disabled
+  bool mSharedCachingEnabled = false;                   // whether the cached objects are shared with the other instances
+
+  template <typename T>
+  void prefetchNext(std::string const& path, CachedObject& cached);
+  bool takePrefetched(std::string const& path, CachedObject& cached, long timestamp);
+  std::string sharedCacheKey(std::string const& path) const
+  {
+    return CCDBSharedCache::makeKey(getURL(), path, mMetaData, mCreatedNotAfter, mCreatedNotBefore);
+  }
 };
 
 template <typename T>
@@ -158,8 +233,25 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
                                                  mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
   }
   auto& cached = mCache[path];
-  if (mCheckObjValidityEnabled && cached.isValid(timestamp)) {
-    return reinterpret_cast<T*>(cached.objPtr.get());
+  if (mCheckObjValidityEnabled) {
+    bool valid = cached.isValid(timestamp) || takePrefetched(path, cached, timestamp);
+    if (!valid && mSharedCachingEnabled) {
+      CCDBSharedCache::Entry entry;
+      if (auto objPtr = CCDBSharedCache::instance().find(sharedCacheKey(path), timestamp, typeid(T), entry)) {
+        cached.objPtr = objPtr;
+        cached.uuid = entry.uuid;
+        cached.startvalidity = entry.startvalidity;
+        cached.endvalidity = entry.endvalidity;
+        valid = true;
+      }
+    }
+    if (valid) {
+      if (mPrefetchMargin > 0 && timestamp >= cached.endvalidity - mPrefetchMargin && !cached.next.valid()) {
+        prefetchNext<T>(path, cached);
+      }
+      mMetaData.clear();
+      return reinterpret_cast<T*>(cached.objPtr.get());
+    }
   }
 
   T* ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached.uuid,
@@ -170,6 +262,9 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
     cached.uuid = mHeaders["ETag"];
     cached.startvalidity = std::stol(mHeaders["Valid-From"]);
     cached.endvalidity = std::stol(mHeaders["Valid-Until"]);
+    if (mSharedCachingEnabled && mCheckObjValidityEnabled) {
+      CCDBSharedCache::instance().add(sharedCacheKey(path), cached.objPtr, typeid(T), cached.uuid, cached.startvalidity, cached.endvalidity);
+    }
   } else if (mHeaders.count("Error")) { // in case of errors the pointer is 0 and headers["Error"] should be set
     clearCache(path);                   // in case of any error clear cache for this object
   } else {                              // the old object is valid
@@ -180,6 +275,23 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
   return ptr;
 }
 
+/// Retrieves in the background the object which is valid when the cached one stops being so.
+template <typename T>
+void CCDBManagerInstance::prefetchNext(std::string const& path, CachedObject& cached)
+{
+  // retrieveFromTFile is const and uses its own curl handle, so it can run concurrently to the other queries
+  cached.next = std::async(std::launch::async,
+                           [&api = mCCDBAccessor, path, metaData = mMetaData, timestamp = cached.endvalidity,
+                            createdNotAfter = mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
+                            createdNotBefore = mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : ""]() {
+                             PrefetchedObject prefetched;
+                             prefetched.type = &typeid(T);
+                             T* ptr = api.retrieveFromTFileAny<T>(path, metaData, timestamp, &prefetched.headers, "", createdNotAfter, createdNotBefore);
+                             prefetched.objPtr = std::shared_ptr<void>(ptr, [](void* obj) { delete static_cast<T*>(obj); });
+                             return prefetched;
+                           });
+}
+
 class BasicCCDBManager : public CCDBManagerInstance
 {
  public:
@@ -20,6 +20,9 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <functional>
+#include <typeinfo>
+#include <vector>
 #include <curl/curl.h>
 #include <TObject.h>
 #include <TMessage.h>
@@ -148,6 +151,69 @@ class CcdbApi //: public DatabaseInterface
                           long timestamp = -1, std::map<std::string, std::string>* headers = nullptr, std::string const& etag = "",
                           const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const;
 
+  /**
+   * Store an o2::gpu::FlatObject as its flat image (the bit-wise copy of the object followed by its flat buffer)
+   * instead of a ROOT file. It has to be retrieved with retrieveFlatObject, which needs neither the ROOT streaming
+   * nor a clone of the object.
+   *
+   * @param obj The constructed FlatObject.
+   * @param path The path where the object is going to be stored.
+   * @param metadata Key-values representing the metadata for this object.
+   * @param startValidityTimestamp Start of validity. If omitted, current timestamp is used.
+   * @param endValidityTimestamp End of validity. If omitted, current timestamp + 1 year is used.
+   */
+  template <typename T>
+  void storeAsFlatObject(T const& obj, std::string const& path, std::map<std::string, std::string> const& metadata,
+                         long startValidityTimestamp = -1, long endValidityTimestamp = -1) const
+  {
+    auto image = T::createFlatImage(obj);
+    storeAsFlatImage(image, T::Class_Name(), path, metadata, startValidityTimestamp, endValidityTimestamp);
+  }
+
+  /**
+   * Retrieve an o2::gpu::FlatObject stored with storeAsFlatObject, the parameters are the ones of retrieveFromTFileAny.
+   * The flat buffer is copied once to a new buffer owned by the object, which is then relocated there.
+   *
+   * @return the object, or nullptr if none were found or the content is not a flat image of T.
+   */
+  template <typename T>
+  T* retrieveFlatObject(std::string const& path, std::map<std::string, std::string> const& metadata,
+                        long timestamp = -1, std::map<std::string, std::string>* headers = nullptr, std::string const& etag = "",
+                        const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const
+  {
+    ContentReader reader = [](char const* content, size_t size) -> void* { return T::template readFromFlatImage<T>(content, size); };
+    return static_cast<T*>(retrieveContent(typeid(T), &reader, path, metadata, timestamp, headers, etag, createdNotAfter, createdNotBefore));
+  }
+
+  /// A request of a retrieval through retrieveFromTFiles. The object and the headers are filled by the retrieval.
+  struct RetrievalRequest {
+    std::string path;
+    std::map<std::string, std::string> metadata;
+    long timestamp = -1;
+    std::type_info const* type = nullptr;
+    std::string etag;
+    std::map<std::string, std::string> headers; // received headers, "Error" is set if the retrieval failed
+    void* object = nullptr;                     // retrieved object, owned by the caller
+  };
+
+  /// Creates a request for the retrieval of an object of type T.
+  template <typename T>
+  static RetrievalRequest makeRetrievalRequest(std::string const& path, std::map<std::string, std::string> const& metadata = {},
+                                               long timestamp = -1)
+  {
+    return RetrievalRequest{path, metadata, timestamp, &typeid(T)};
+  }
+
+  /**
+   * Retrieve several objects at once, retrieveFromTFile is called for every request.
+   * The queries (including their redirections) of up to nParallel requests run concurrently, while the connections
+   * to the servers are reused by all the retrievals of the process. The objects are deserialized one at a time.
+   *
+   * @param requests The requests, which are filled with the retrieved objects and headers.
+   * @param nParallel Maximum number of concurrent retrievals.
+   */
+  void retrieveFromTFiles(std::vector<RetrievalRequest>& requests, int nParallel = 8) const;
+
   /**
    * Delete all versions of the object at this path.
    *
@@ -323,8 +389,9 @@ class CcdbApi //: public DatabaseInterface
  public:
   /**
    * A generic method to store a binary buffer (e.g. an image of the TMemFile)
+   * @return 0 on success, the curl error code or the HTTP status of the failed request otherwise
    */
-  void storeAsBinaryFile(const char* buffer, size_t size, const std::string& fileName, const std::string& objectType,
+  int storeAsBinaryFile(const char* buffer, size_t size, const std::string& fileName, const std::string& objectType,
                          const std::string& path, const std::map<std::string, std::string>& metadata,
                          long startValidityTimestamp, long endValidityTimestamp) const;
 
@@ -342,6 +409,21 @@ class CcdbApi //: public DatabaseInterface
                           const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const;
 
  private:
+  /// Interprets a retrieved content and returns the object made of it, or nullptr if it is not possible
+  using ContentReader = std::function<void*(char const* content, size_t size)>;
+
+  /// Implementation of the retrievals: the content is interpreted by reader if it is given, as a TFile otherwise
+  void* retrieveContent(std::type_info const&, ContentReader const* reader, std::string const& path, std::map<std::string, std::string> const& metadata,
+                        long timestamp, std::map<std::string, std::string>* headers, std::string const& etag,
+                        const std::string& createdNotAfter, const std::string& createdNotBefore) const;
+
+  /// Stores the flat image of a FlatObject of the given class
+  void storeAsFlatImage(std::vector<char> const& image, std::string const& className, std::string const& path,
+                        std::map<std::string, std::string> const& metadata, long startValidityTimestamp, long endValidityTimestamp) const;
+
+  /// Reads the content of a local file with reader
+  void* readFromLocalFile(std::string const& filename, ContentReader const& reader) const;
+
   /**
    * A helper function to extract object from a local ROOT file
    * @param filename name of ROOT file
@@ -365,7 +447,8 @@ class CcdbApi //: public DatabaseInterface
 
   /// Queries the CCDB server and navigates through possible redirects until binary content is found; Retrieves content as instance
   /// given by tinfo if that is possible. Returns nullptr if something fails...
-  void* navigateURLsAndRetrieveContent(CURL*, std::string const& url, std::type_info const& tinfo, std::map<std::string, std::string>* headers) const;
+  void* navigateURLsAndRetrieveContent(CURL*, std::string const& url, std::type_info const& tinfo, std::map<std::string, std::string>* headers,
+                                       ContentReader const* reader = nullptr) const;
 
   // helper that interprets a content chunk as TMemFile and extracts the object therefrom
   void* interpretAsTMemFileAndExtract(char* contentptr, size_t contentsize, std::type_info const& tinfo) const;
@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CcdbUploadQueue.h
+/// \brief  Asynchronous upload of object images to the CCDB
+///
+
+#ifndef O2_CCDB_UPLOADQUEUE_H
+#define O2_CCDB_UPLOADQUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CCDB/CcdbObjectInfo.h"
+
+namespace o2
+{
+namespace ccdb
+{
+
+class CcdbApi;
+
+/**
+ * Queue of the uploads to the CCDB, done asynchronously by a pool of threads, each with its own CcdbApi.
+ * push() returns as soon as the image is queued. A failed upload is retried with an increasing delay, and if
+ * all the attempts fail the object is spooled to a local directory (if one is given), from which it is queued
+ * again by recoverSpooled(), e.g. at the next start. The uploads of the same CCDB path are done one at a time
+ * in the order they were queued, so that the creation times of the objects of a path follow the queue order.
+ */
+class CcdbUploadQueue
+{
+ public:
+  CcdbUploadQueue() = default;
+  ~CcdbUploadQueue();
+  CcdbUploadQueue(const CcdbUploadQueue&) = delete;
+  CcdbUploadQueue& operator=(const CcdbUploadQueue&) = delete;
+
+  /**
+   * Start the upload threads
+   * @param url The URL of the CCDB
+   * @param nThreads The number of concurrent uploads
+   * @param maxRetries The number of retries of a failed upload
+   * @param retryDelayMS The delay before the 1st retry, doubled at every further retry
+   * @param spoolDir The directory to spool the objects which could not be uploaded, no spooling if empty
+   */
+  void init(const std::string& url, int nThreads = 2, int maxRetries = 3, int retryDelayMS = 1000, const std::string& spoolDir = "");
+
+  /// queue the image of an object for the upload
+  void push(std::vector<char>&& image, const CcdbObjectInfo& info);
+
+  /// queue again the objects spooled in the spool directory, return their number
+  int recoverSpooled();
+
+  /// wait until all the queued uploads are done (or spooled)
+  void flush();
+
+  /// flush and stop the upload threads
+  void stop();
+
+  size_t getNQueued() const;
+  size_t getNUploaded() const { return mNUploaded; }
+  size_t getNFailed() const { return mNFailed; }
+  size_t getNSpooled() const { return mNSpooled; }
+
+ private:
+  struct Upload {
+    std::vector<char> image;
+    CcdbObjectInfo info;
+    std::string spoolFile; // file from which the upload was recovered, removed once it is uploaded
+  };
+
+  void process(int id, const std::string& url);
+  bool upload(CcdbApi& api, const Upload& upl) const;
+  bool spool(const Upload& upl);
+
+  std::string mSpoolDir{};
+  int mMaxRetries = 3;
+  int mRetryDelayMS = 1000;
+
+  std::deque<Upload> mQueue;
+  std::set<std::string> mPathsInProgress; // paths of the uploads in progress
+  mutable std::mutex mMutex;
+  std::condition_variable mCondQueue; // signals a new upload or the stop to the threads
+  std::condition_variable mCondDone;  // signals the end of an upload to flush()
+  std::vector<std::thread> mThreads;
+  bool mStop = false;
+
+  std::atomic<size_t> mNUploaded{0}; // uploaded objects
+  std::atomic<size_t> mNFailed{0};   // objects which failed all the attempts
+  std::atomic<size_t> mNSpooled{0};  // failed objects spooled
+  std::atomic<size_t> mSpoolID{0};   // to make the spool files unique
+};
+
+} // namespace ccdb
+} // namespace o2
+
+#endif
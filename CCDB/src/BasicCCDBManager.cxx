@@ -25,5 +25,78 @@ void CCDBManagerInstance::setURL(std::string const& url)
   mCCDBAccessor.init(url);
 }
 
+bool CCDBManagerInstance::takePrefetched(std::string const& path, CachedObject& cached, long timestamp)
+{
+  if (!cached.next.valid()) {
+    return false;
+  }
+  auto prefetched = cached.next.get(); // waits for the retrieval if it is not over yet
+  auto& headers = prefetched.headers;
+  if (!prefetched.objPtr || headers.count("Error") || !headers.count("Valid-From") || !headers.count("Valid-Until")) {
+    return false;
+  }
+  long startvalidity = std::stol(headers["Valid-From"]);
+  long endvalidity = std::stol(headers["Valid-Until"]);
+  if (timestamp <= startvalidity || timestamp >= endvalidity) {
+    return false; // the timestamp jumped beyond the next object
+  }
+  cached.objPtr = prefetched.objPtr;
+  cached.uuid = headers["ETag"];
+  cached.startvalidity = startvalidity;
+  cached.endvalidity = endvalidity;
+  if (mSharedCachingEnabled) {
+    CCDBSharedCache::instance().add(sharedCacheKey(path), cached.objPtr, *prefetched.type, cached.uuid, startvalidity, endvalidity);
+  }
+  return true;
+}
+
+std::string CCDBSharedCache::makeKey(std::string const& url, std::string const& path, std::map<std::string, std::string> const& metaData,
+                                     long createdNotAfter, long createdNotBefore)
+{
+  std::string key = url + "/" + path + "?" + std::to_string(createdNotAfter) + "&" + std::to_string(createdNotBefore);
+  for (auto const& [name, value] : metaData) {
+    key += "&" + name + "=" + value;
+  }
+  return key;
+}
+
+std::shared_ptr<void> CCDBSharedCache::find(std::string const& key, long timestamp, std::type_info const& type, Entry& entry)
+{
+  std::lock_guard<std::mutex> guard(mMutex);
+  auto range = mEntries.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto const& candidate = it->second;
+    if (*candidate.type == type && timestamp > candidate.startvalidity && timestamp < candidate.endvalidity) {
+      if (auto objPtr = candidate.objPtr.lock()) {
+        entry = candidate;
+        return objPtr;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void CCDBSharedCache::add(std::string const& key, std::shared_ptr<void> const& objPtr, std::type_info const& type, std::string const& uuid,
+                          long startvalidity, long endvalidity)
+{
+  std::lock_guard<std::mutex> guard(mMutex);
+  auto range = mEntries.equal_range(key);
+  for (auto it = range.first; it != range.second;) {
+    // the objects which are not used by any instance anymore are forgotten
+    if (it->second.objPtr.expired() || it->second.uuid == uuid) {
+      it = mEntries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  mEntries.emplace(key, Entry{objPtr, &type, uuid, startvalidity, endvalidity});
+}
+
+void CCDBSharedCache::clear()
+{
+  std::lock_guard<std::mutex> guard(mMutex);
+  mEntries.clear();
+}
+
 } // namespace ccdb
 } // namespace o2
@@ -32,7 +32,12 @@
 #include <TClass.h>
 #include <CCDB/CCDBTimeStampUtils.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <future>
 #include <boost/algorithm/string.hpp>
 #include <iostream>
 #include <mutex>
@@ -47,6 +52,58 @@ using namespace std;
 
 std::mutex gIOMutex; // to protect TMemFile IO operations
 
+namespace
+{
+// A curl share handle, through which all the retrievals of the process use the same DNS cache, TLS sessions
+// and connection cache. Successive (and concurrent) queries to a server thus reuse its open connections
+// instead of establishing a new one for every object.
+class CurlShare
+{
+ public:
+  static CURLSH* get()
+  {
+    static CurlShare instance;
+    return instance.mShare;
+  }
+
+ private:
+  CurlShare()
+  {
+    mShare = curl_share_init();
+    if (mShare == nullptr) {
+      LOG(WARN) << "CCDB: could not create a curl share handle, connections will not be reused";
+      return;
+    }
+    curl_share_setopt(mShare, CURLSHOPT_LOCKFUNC, lock);
+    curl_share_setopt(mShare, CURLSHOPT_UNLOCKFUNC, unlock);
+    curl_share_setopt(mShare, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+    curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+  }
+  ~CurlShare()
+  {
+    if (mShare) {
+      curl_share_cleanup(mShare);
+    }
+  }
+
+  static void lock(CURL*, curl_lock_data data, curl_lock_access, void* userptr)
+  {
+    static_cast<CurlShare*>(userptr)->mMutexes[data].lock();
+  }
+  static void unlock(CURL*, curl_lock_data data, void* userptr)
+  {
+    static_cast<CurlShare*>(userptr)->mMutexes[data].unlock();
+  }
+
+  CURLSH* mShare = nullptr;
+  std::array<std::mutex, CURL_LOCK_DATA_LAST> mMutexes;
+};
+} // namespace
+
 CcdbApi::~CcdbApi()
 {
   curl_global_cleanup();
@@ -131,11 +188,20 @@ void CcdbApi::storeAsTFile_impl(const void* obj, std::type_info const& tinfo, st
                     path, metadata, startValidityTimestamp, endValidityTimestamp);
 }
 
-void CcdbApi::storeAsBinaryFile(const char* buffer, size_t size, const std::string& filename, const std::string& objectType,
-                                const std::string& path, const std::map<std::string, std::string>& metadata,
-                                long startValidityTimestamp, long endValidityTimestamp) const
+void CcdbApi::storeAsFlatImage(std::vector<char> const& image, std::string const& className, std::string const& path,
+                               std::map<std::string, std::string> const& metadata, long startValidityTimestamp, long endValidityTimestamp) const
+{
+  // the extension tells that the file is not a ROOT file
+  std::string fileName = className + "_" + std::to_string(o2::ccdb::getCurrentTimestamp()) + ".flat";
+  storeAsBinaryFile(image.data(), image.size(), fileName, className, path, metadata, startValidityTimestamp, endValidityTimestamp);
+}
+
+int CcdbApi::storeAsBinaryFile(const char* buffer, size_t size, const std::string& filename, const std::string& objectType,
+                               const std::string& path, const std::map<std::string, std::string>& metadata,
+                               long startValidityTimestamp, long endValidityTimestamp) const
 {
   // Store a binary file
+  int result = -1;
 
   // Prepare URL
   long sanitizedStartValidityTimestamp = startValidityTimestamp;
@@ -179,6 +245,14 @@ void CcdbApi::storeAsBinaryFile(const char* buffer, size_t size, const std::stri
     if (res != CURLE_OK) {
       fprintf(stderr, "curl_easy_perform() failed: %s\n",
               curl_easy_strerror(res));
+      result = res;
+    } else {
+      long responseCode = 0;
+      curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+      result = (responseCode >= 200 && responseCode < 300) ? 0 : int(responseCode);
+      if (result) {
+        LOG(ERROR) << "CCDB: storage of " << path << "/" << filename << " failed with HTTP code " << responseCode;
+      }
     }
 
     /* always cleanup */
@@ -191,6 +265,7 @@ void CcdbApi::storeAsBinaryFile(const char* buffer, size_t size, const std::stri
   } else {
     cerr << "curl initialization failure" << endl;
   }
+  return result;
 }
 
 void CcdbApi::storeAsTFile(const TObject* rootObject, std::string const& path, std::map<std::string, std::string> const& metadata,
@@ -230,6 +305,14 @@ string CcdbApi::getFullUrlForStorage(CURL* curl, const string& path, const strin
   return fullUrl;
 }
 
+// checks if the file starts with the ROOT file identifier
+bool isROOTFile(std::string const& filename)
+{
+  char id[4] = {0};
+  std::ifstream file(filename, std::ios::binary);
+  return file.read(id, sizeof(id)) && std::strncmp(id, "root", sizeof(id)) == 0;
+}
+
 std::string getSnapshotPath(std::string const& topdir, const string& path)
 {
   return topdir + "/" + path + "/snapshot.root";
@@ -402,7 +485,8 @@ void CcdbApi::retrieveBlob(std::string const& path, std::string const& targetdir
   }
   curl_easy_cleanup(curl_handle);
 
-  if (success) {
+  // flat images are not ROOT files and cannot take the metadata
+  if (success && isROOTFile(targetpath)) {
     // trying to append metadata to the file so that it can be inspected WHERE/HOW/WHAT IT corresponds to
     // Just a demonstrator for the moment
     CCDBQuery querysummary(path, metadata, timestamp);
@@ -480,6 +564,19 @@ void* CcdbApi::extractFromLocalFile(std::string const& filename, std::type_info
   return extractFromTFile(f, tcl);
 }
 
+void* CcdbApi::readFromLocalFile(std::string const& filename, ContentReader const& reader) const
+{
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file.good()) {
+    LOG(ERROR) << "Local snapshot " << filename << " not found \n";
+    return nullptr;
+  }
+  std::vector<char> content(file.tellg());
+  file.seekg(0);
+  file.read(content.data(), content.size());
+  return reader(content.data(), content.size());
+}
+
 bool CcdbApi::checkAlienToken() const
 {
 #ifdef __APPLE__
@@ -503,6 +600,9 @@ bool CcdbApi::checkAlienToken() const
 
 bool CcdbApi::initTGrid() const
 {
+  // the connection might be requested by concurrent retrievals
+  static std::mutex alienMutex;
+  std::lock_guard<std::mutex> guard(alienMutex);
   if (!mAlienInstance) {
     if (mHaveAlienToken) {
       mAlienInstance = TGrid::Connect("alien");
@@ -549,7 +649,8 @@ void* CcdbApi::interpretAsTMemFileAndExtract(char* contentptr, size_t contentsiz
 }
 
 // navigate sequence of URLs until TFile content is found; object is extracted and returned
-void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string const& url, std::type_info const& tinfo, std::map<string, string>* headers) const
+void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string const& url, std::type_info const& tinfo, std::map<string, string>* headers,
+                                              ContentReader const* reader) const
 {
   // a global internal data structure that can be filled with HTTP header information
   // static --> to avoid frequent alloc/dealloc as optimization
@@ -558,6 +659,10 @@ void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string con
 
   // let's see first of all if the url is something specific that curl cannot handle
   if (url.find("alien:/", 0) != std::string::npos) {
+    if (reader) {
+      LOG(ERROR) << "Retrieval of raw content from alien is not supported: " << url;
+      return nullptr;
+    }
     return downloadAlienContent(url, tinfo);
   }
   // add other final cases here
@@ -594,7 +699,7 @@ void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string con
     }
     if (200 <= response_code && response_code < 300) {
       // good response and the content is directly provided and should have been dumped into "chunk"
-      content = interpretAsTMemFileAndExtract(chunk.memory, chunk.size, tinfo);
+      content = reader ? (*reader)(chunk.memory, chunk.size) : interpretAsTMemFileAndExtract(chunk.memory, chunk.size, tinfo);
     } else if (response_code == 304) {
       // this means the object exist but I am not serving
       // it since it's already in your possession
@@ -635,7 +740,7 @@ void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string con
       for (auto& l : locs) {
         if (l.size() > 0) {
           LOG(DEBUG) << "Trying content location " << l;
-          content = navigateURLsAndRetrieveContent(curl_handle, l, tinfo, nullptr);
+          content = navigateURLsAndRetrieveContent(curl_handle, l, tinfo, nullptr, reader);
           if (content /* or other success marker in future */) {
             break;
           }
@@ -666,6 +771,14 @@ void* CcdbApi::retrieveFromTFile(std::type_info const& tinfo, std::string const&
                                  std::map<std::string, std::string> const& metadata, long timestamp,
                                  std::map<std::string, std::string>* headers, std::string const& etag,
                                  const std::string& createdNotAfter, const std::string& createdNotBefore) const
+{
+  return retrieveContent(tinfo, nullptr, path, metadata, timestamp, headers, etag, createdNotAfter, createdNotBefore);
+}
+
+void* CcdbApi::retrieveContent(std::type_info const& tinfo, ContentReader const* reader, std::string const& path,
+                               std::map<std::string, std::string> const& metadata, long timestamp,
+                               std::map<std::string, std::string>* headers, std::string const& etag,
+                               const std::string& createdNotAfter, const std::string& createdNotBefore) const
 {
   // The environment option ALICEO2_CCDB_LOCALCACHE allows
   // to reduce the number of queries to the server, by collecting the objects in a local
@@ -717,7 +830,7 @@ void* CcdbApi::retrieveFromTFile(std::type_info const& tinfo, std::string const&
         boost::interprocess::named_semaphore::remove(semhashedstring.c_str());
       }
     }
-    return extractFromLocalFile(snapshotfile, tinfo, headers);
+    return reader ? readFromLocalFile(snapshotfile, *reader) : extractFromLocalFile(snapshotfile, tinfo, headers);
   }
 
   // normal mode follows
@@ -726,8 +839,14 @@ void* CcdbApi::retrieveFromTFile(std::type_info const& tinfo, std::string const&
   string fullUrl = getFullUrlForRetrieval(curl_handle, path, metadata, timestamp);
   // if we are in snapshot mode we can simply open the file; extract the object and return
   if (mInSnapshotMode) {
-    return extractFromLocalFile(fullUrl, tinfo, headers);
+    curl_easy_cleanup(curl_handle);
+    return reader ? readFromLocalFile(fullUrl, *reader) : extractFromLocalFile(fullUrl, tinfo, headers);
+  }
+  if (auto share = CurlShare::get()) {
+    curl_easy_setopt(curl_handle, CURLOPT_SHARE, share);
   }
+  // multiplex the queries over a single connection when the server supports it
+  curl_easy_setopt(curl_handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
 
   // add some global options to the curl query
   struct curl_slist* list = nullptr;
@@ -745,11 +864,41 @@ void* CcdbApi::retrieveFromTFile(std::type_info const& tinfo, std::string const&
   }
   curl_easy_setopt(curl_handle, CURLOPT_HTTPHEADER, list);
 
-  auto content = navigateURLsAndRetrieveContent(curl_handle, fullUrl, tinfo, headers);
+  auto content = navigateURLsAndRetrieveContent(curl_handle, fullUrl, tinfo, headers, reader);
   curl_easy_cleanup(curl_handle);
+  curl_slist_free_all(list);
   return content;
 }
 
+void CcdbApi::retrieveFromTFiles(std::vector<RetrievalRequest>& requests, int nParallel) const
+{
+  if (requests.empty()) {
+    return;
+  }
+  // every worker takes the next pending request, so that a slow object does not hold back the others
+  std::atomic<size_t> next{0};
+  auto worker = [this, &requests, &next]() {
+    for (size_t i = next++; i < requests.size(); i = next++) {
+      auto& request = requests[i];
+      if (request.type == nullptr) {
+        LOG(ERROR) << "CCDB: no type given for the retrieval of " << request.path;
+        request.headers["Error"] = "An error occurred during retrieval";
+        continue;
+      }
+      request.object = retrieveFromTFile(*request.type, request.path, request.metadata, request.timestamp, &request.headers, request.etag);
+    }
+  };
+  size_t nWorkers = std::min(requests.size(), size_t(std::max(nParallel, 1)));
+  std::vector<std::future<void>> workers;
+  for (size_t i = 1; i < nWorkers; i++) {
+    workers.emplace_back(std::async(std::launch::async, worker));
+  }
+  worker();
+  for (auto& w : workers) {
+    w.get();
+  }
+}
+
 size_t CurlWrite_CallbackFunc_StdString2(void* contents, size_t size, size_t nmemb, std::string* s)
 {
   size_t newLength = size * nmemb;
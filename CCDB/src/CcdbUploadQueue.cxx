@@ -0,0 +1,241 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CcdbUploadQueue.cxx
+/// \brief  Asynchronous upload of object images to the CCDB
+///
+
+#include "CCDB/CcdbUploadQueue.h"
+#include "CCDB/CcdbApi.h"
+#include "CCDB/CCDBTimeStampUtils.h"
+#include <FairLogger.h>
+#include <TFile.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+namespace o2
+{
+namespace ccdb
+{
+
+extern std::mutex gIOMutex; // protects the ROOT IO, see CcdbApi.cxx
+
+namespace
+{
+constexpr const char* SpoolSuffix = ".ccdb.root";
+constexpr const char* SpoolInfoKey = "ccdb_object_info";
+constexpr const char* SpoolImageKey = "ccdb_object_image";
+} // namespace
+
+CcdbUploadQueue::~CcdbUploadQueue()
+{
+  stop();
+}
+
+void CcdbUploadQueue::init(const std::string& url, int nThreads, int maxRetries, int retryDelayMS, const std::string& spoolDir)
+{
+  stop();
+  mMaxRetries = std::max(0, maxRetries);
+  mRetryDelayMS = std::max(0, retryDelayMS);
+  mSpoolDir = spoolDir;
+  mStop = false;
+  for (int i = 0; i < std::max(1, nThreads); i++) {
+    mThreads.emplace_back(&CcdbUploadQueue::process, this, i, url);
+  }
+  LOG(INFO) << "CCDB upload queue to " << url << " with " << mThreads.size() << " threads, " << mMaxRetries << " retries"
+            << (mSpoolDir.empty() ? std::string(", no spooling") : ", spooling to " + mSpoolDir);
+}
+
+void CcdbUploadQueue::push(std::vector<char>&& image, const CcdbObjectInfo& info)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mThreads.empty()) {
+      LOG(ERROR) << "CCDB upload queue is not initialized, " << info.getPath() << "/" << info.getFileName() << " is dropped";
+      return;
+    }
+    mQueue.push_back(Upload{std::move(image), info, ""});
+  }
+  mCondQueue.notify_one();
+}
+
+size_t CcdbUploadQueue::getNQueued() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mQueue.size();
+}
+
+void CcdbUploadQueue::flush()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  if (mThreads.empty()) {
+    return;
+  }
+  mCondDone.wait(lock, [this] { return mQueue.empty() && mPathsInProgress.empty(); });
+}
+
+void CcdbUploadQueue::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mCondQueue.notify_all();
+  for (auto& th : mThreads) {
+    th.join();
+  }
+  if (!mThreads.empty()) {
+    LOG(INFO) << "CCDB upload queue stopped: " << mNUploaded << " objects uploaded, " << mNFailed << " failed, " << mNSpooled << " spooled";
+  }
+  mThreads.clear();
+}
+
+void CcdbUploadQueue::process(int id, const std::string& url)
+{
+  CcdbApi api;
+  api.init(url);
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    // the 1st queued upload to a path without upload in progress, the threads exit once the queue is drained
+    auto next = mQueue.end();
+    mCondQueue.wait(lock, [this, &next] {
+      next = std::find_if(mQueue.begin(), mQueue.end(), [this](const Upload& upl) { return !mPathsInProgress.count(upl.info.getPath()); });
+      return next != mQueue.end() || (mStop && mQueue.empty());
+    });
+    if (next == mQueue.end()) {
+      break;
+    }
+    Upload upl = std::move(*next);
+    mQueue.erase(next);
+    mPathsInProgress.insert(upl.info.getPath());
+    lock.unlock();
+
+    bool done = upload(api, upl);
+    for (int attempt = 1; attempt <= mMaxRetries && !done; attempt++) {
+      int delay = mRetryDelayMS << (attempt - 1);
+      LOGP(WARNING, "CCDB upload thread {}: upload of {}/{} failed, retry {} of {} in {} ms", id, upl.info.getPath(), upl.info.getFileName(), attempt, mMaxRetries, delay);
+      std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+      done = upload(api, upl);
+    }
+    if (done) {
+      mNUploaded++;
+      if (!upl.spoolFile.empty()) {
+        std::error_code ec;
+        std::filesystem::remove(upl.spoolFile, ec);
+      }
+    } else {
+      mNFailed++;
+      LOG(ERROR) << "CCDB upload of " << upl.info.getPath() << "/" << upl.info.getFileName() << " failed after " << mMaxRetries + 1 << " attempts";
+      if (upl.spoolFile.empty() && !mSpoolDir.empty() && spool(upl)) { // a recovered object stays in its spool file
+        mNSpooled++;
+      }
+    }
+
+    lock.lock();
+    mPathsInProgress.erase(upl.info.getPath());
+    mCondDone.notify_all();
+    mCondQueue.notify_all(); // the next upload to the same path may be waiting
+  }
+}
+
+bool CcdbUploadQueue::upload(CcdbApi& api, const Upload& upl) const
+{
+  const auto& info = upl.info;
+  return api.storeAsBinaryFile(upl.image.data(), upl.image.size(), info.getFileName(), info.getObjectType(), info.getPath(),
+                               info.getMetaData(), info.getStartValidityTimestamp(), info.getEndValidityTimestamp()) == 0;
+}
+
+bool CcdbUploadQueue::spool(const Upload& upl)
+{
+  // the file names start with the time, so that the spooled objects are recovered in the order they were queued
+  std::error_code ec;
+  std::filesystem::create_directories(mSpoolDir, ec);
+  auto fileName = fmt::format("{}/{}_{:06d}{}", mSpoolDir, getCurrentTimestamp(), mSpoolID++, SpoolSuffix);
+  auto tmpName = fileName + ".part"; // renamed once complete, an interrupted spooling leaves no file to recover
+  {
+    std::lock_guard<std::mutex> guard(gIOMutex);
+    TFile fl(tmpName.c_str(), "recreate");
+    if (fl.IsZombie()) {
+      LOG(ERROR) << "CCDB: could not create the spool file " << tmpName;
+      return false;
+    }
+    fl.WriteObjectAny(&upl.info, "o2::ccdb::CcdbObjectInfo", SpoolInfoKey);
+    fl.WriteObjectAny(&upl.image, "std::vector<char>", SpoolImageKey);
+    fl.Close();
+  }
+  std::filesystem::rename(tmpName, fileName, ec);
+  if (ec) {
+    LOG(ERROR) << "CCDB: could not create the spool file " << fileName << ": " << ec.message();
+    return false;
+  }
+  LOG(WARNING) << "CCDB: " << upl.info.getPath() << "/" << upl.info.getFileName() << " spooled to " << fileName;
+  return true;
+}
+
+int CcdbUploadQueue::recoverSpooled()
+{
+  std::error_code ec;
+  if (mSpoolDir.empty() || !std::filesystem::is_directory(mSpoolDir, ec)) {
+    return 0;
+  }
+  std::vector<std::string> files;
+  for (const auto& entry : std::filesystem::directory_iterator(mSpoolDir, ec)) {
+    const auto name = entry.path().string();
+    if (entry.is_regular_file() && name.size() > strlen(SpoolSuffix) && name.compare(name.size() - strlen(SpoolSuffix), std::string::npos, SpoolSuffix) == 0) {
+      files.push_back(name);
+    }
+  }
+  std::sort(files.begin(), files.end());
+  int nRecovered = 0;
+  for (const auto& name : files) {
+    Upload upl;
+    {
+      std::lock_guard<std::mutex> guard(gIOMutex);
+      TFile fl(name.c_str());
+      CcdbObjectInfo* info = nullptr;
+      std::vector<char>* image = nullptr;
+      if (!fl.IsZombie()) {
+        fl.GetObject(SpoolInfoKey, info);
+        fl.GetObject(SpoolImageKey, image);
+      }
+      if (!info || !image) {
+        LOG(ERROR) << "CCDB: could not read the spool file " << name;
+        delete info;
+        delete image;
+        continue;
+      }
+      upl.info = *info;
+      upl.image = std::move(*image);
+      delete info;
+      delete image;
+    }
+    upl.spoolFile = name;
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (mThreads.empty()) {
+        LOG(ERROR) << "CCDB upload queue is not initialized, spooled objects are not recovered";
+        return nRecovered;
+      }
+      mQueue.push_back(std::move(upl));
+    }
+    mCondQueue.notify_one();
+    nRecovered++;
+  }
+  LOG(INFO) << "CCDB: " << nRecovered << " spooled objects queued again for the upload";
+  return nRecovered;
+}
+
+} // namespace ccdb
+} // namespace o2
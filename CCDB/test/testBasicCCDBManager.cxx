@@ -121,4 +121,19 @@ BOOST_AUTO_TEST_CASE(TestBasicCCDBManager)
   objA = cdb.get<std::string>(pathA); // will be loaded from scratch
   LOG(INFO) << "Reading A again, it should not be cached: " << *objA;
   BOOST_CHECK(objA && (*objA) != hack); // make sure correct object is loaded
+
+  // instances sharing their objects, with the next object prefetched before the end of validity
+  CCDBManagerInstance cdb1(uri), cdb2(uri);
+  for (auto* inst : {&cdb1, &cdb2}) {
+    inst->setLocalObjectValidityChecking();
+    inst->setSharedCaching(true);
+    inst->setPrefetchMargin(stop - start);
+  }
+  objA = cdb1.getForTimeStamp<std::string>(pathA, (start + stop) / 2); // will be loaded and the next object prefetched
+  BOOST_CHECK(objA && (*objA) == ccdbObjO);
+  auto* objA2 = cdb2.getForTimeStamp<std::string>(pathA, (start + stop) / 2); // should be taken from the other instance
+  BOOST_CHECK(objA2 == objA);
+  objA = cdb1.getForTimeStamp<std::string>(pathA, stop + (stop - start) / 2); // should be the prefetched object
+  LOG(INFO) << "Reading A after the end of validity with prefetching: " << *objA;
+  BOOST_CHECK(objA && (*objA) == ccdbObjN);
 }
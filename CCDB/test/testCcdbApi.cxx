@@ -304,6 +304,29 @@ BOOST_AUTO_TEST_CASE(retrieveTMemFile_test, *utf::precondition(if_reachable()))
   BOOST_CHECK_EQUAL(obj, nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(retrieveTFiles_test, *utf::precondition(if_reachable()))
+{
+  test_fixture f;
+
+  std::vector<CcdbApi::RetrievalRequest> requests;
+  for (auto name : {"th1", "graph", "tree", "th1"}) {
+    requests.push_back(CcdbApi::makeRetrievalRequest<TObject>(basePath + name, f.metadata));
+  }
+  requests.push_back(CcdbApi::makeRetrievalRequest<TObject>("Wrong/wrong", f.metadata));
+  f.api.retrieveFromTFiles(requests, 3);
+
+  std::vector<std::string> classes{"TH1F", "TGraph", "TTree", "TH1F"};
+  for (size_t i = 0; i < classes.size(); i++) {
+    auto obj = static_cast<TObject*>(requests[i].object);
+    BOOST_REQUIRE_NE(obj, nullptr);
+    BOOST_CHECK_EQUAL(obj->ClassName(), classes[i]);
+    BOOST_CHECK_EQUAL(requests[i].headers["Hello"], "World");
+    delete obj;
+  }
+  BOOST_CHECK_EQUAL(requests.back().object, nullptr);
+  BOOST_CHECK(requests.back().headers.count("Error") == 1);
+}
+
 BOOST_AUTO_TEST_CASE(truncate_test, *utf::precondition(if_reachable()))
 {
   test_fixture f;
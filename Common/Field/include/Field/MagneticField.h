@@ -107,6 +107,10 @@ class MagneticField : public FairField
   /// Main interface from TVirtualMagField used in simulation
   void Field(const Double_t* __restrict__ point, Double_t* __restrict__ bField) override;
 
+  /// Method to calculate the field at npoints points, stored as consecutive x,y,z triplets in point,
+  /// the field components are stored in the same way in bField
+  void Field(Int_t npoints, const Double_t* __restrict__ point, Double_t* __restrict__ bField);
+
   /// 3d field query alias for Alias Method to calculate the field at point xyz
   void GetBxyz(const Double_t p[3], Double_t* b) override { MagneticField::Field(p, b); }
 
@@ -210,6 +210,10 @@ class MagneticWrapperChebyshev : public TNamed
   /// it gets it at closest valid point
   virtual void Field(const Double_t* xyz, Double_t* b) const;
 
+  /// Computes field in cartesian coordinates for npoints points, stored as consecutive x,y,z triplets in xyz,
+  /// the field components are stored in the same way in b
+  void Field(Int_t npoints, const Double_t* xyz, Double_t* b) const;
+
   /// Computes Bz for the point in cartesian coordinates. If point is outside of the parameterized region
   /// it gets it at closest valid point
   Double_t getBz(const Double_t* xyz) const;
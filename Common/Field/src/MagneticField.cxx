@@ -280,6 +280,16 @@ void MagneticField::Field(const Double_t* __restrict__ xyz, Double_t* __restrict
   }
 }
 
+void MagneticField::Field(Int_t npoints, const Double_t* __restrict__ xyz, Double_t* __restrict__ b)
+{
+  /*
+   * query field values at npoints points
+   */
+  for (int i = 0; i < npoints; i++) {
+    MagneticField::Field(xyz + 3 * i, b + 3 * i);
+  }
+}
+
 Double_t MagneticField::getBz(const Double_t* xyz) const
 {
   /*
@@ -31,6 +31,26 @@ using namespace o2::math_utils;
 
 ClassImp(MagneticWrapperChebyshev);
 
+namespace
+{
+/// Last solenoid and dipole segments found by the current thread. Consecutive queries (e.g. propagation steps)
+/// are usually in the same segment, so the cached one is tested before doing the full lookup.
+struct SegmentCache {
+  const MagneticWrapperChebyshev* owner = nullptr;
+  int solenoid = -1;
+  int dipole = -1;
+};
+thread_local SegmentCache sSegmentCache;
+
+SegmentCache& getSegmentCache(const MagneticWrapperChebyshev* owner)
+{
+  if (sSegmentCache.owner != owner) {
+    sSegmentCache = SegmentCache{owner};
+  }
+  return sSegmentCache;
+}
+} // namespace
+
 MagneticWrapperChebyshev::MagneticWrapperChebyshev()
   : mNumberOfParameterizationSolenoid(0),
     mNumberOfDistinctZSegmentsSolenoid(0),
@@ -445,6 +465,13 @@ void MagneticWrapperChebyshev::Field(const Double_t* xyz, Double_t* b) const
   par->Eval(xyz, b);
 }
 
+void MagneticWrapperChebyshev::Field(Int_t npoints, const Double_t* xyz, Double_t* b) const
+{
+  for (int i = 0; i < npoints; i++) {
+    Field(xyz + 3 * i, b + 3 * i);
+  }
+}
+
 Double_t MagneticWrapperChebyshev::getBz(const Double_t* xyz) const
 {
   Double_t rphiz[3];
@@ -513,6 +540,10 @@ Int_t MagneticWrapperChebyshev::findDipoleSegment(const Double_t* xyz) const
   if (!mNumberOfParameterizationDipole) {
     return -1;
   }
+  auto& cache = getSegmentCache(this);
+  if (cache.dipole >= 0 && cache.dipole < mNumberOfParameterizationDipole && getParameterDipole(cache.dipole)->isInside(xyz)) {
+    return cache.dipole;
+  }
   int xid, yid, zid = TMath::BinarySearch(mNumberOfDistinctZSegmentsDipole, mCoordinatesSegmentsZDipole,
                                           (Float_t)xyz[2]); // find zsegment
 
@@ -551,7 +582,7 @@ Int_t MagneticWrapperChebyshev::findDipoleSegment(const Double_t* xyz) const
     }
     break;
   }
-  return mSegmentIdDipole[xid];
+  return (cache.dipole = mSegmentIdDipole[xid]);
 }
 
 Int_t MagneticWrapperChebyshev::findSolenoidSegment(const Double_t* rpz) const
@@ -559,6 +590,10 @@ Int_t MagneticWrapperChebyshev::findSolenoidSegment(const Double_t* rpz) const
   if (!mNumberOfParameterizationSolenoid) {
     return -1;
   }
+  auto& cache = getSegmentCache(this);
+  if (cache.solenoid >= 0 && cache.solenoid < mNumberOfParameterizationSolenoid && getParameterSolenoid(cache.solenoid)->isInside(rpz)) {
+    return cache.solenoid;
+  }
   int rid, pid, zid = TMath::BinarySearch(mNumberOfDistinctZSegmentsSolenoid, mCoordinatesSegmentsZSolenoid,
                                           (Float_t)rpz[2]); // find zsegment
 
@@ -595,7 +630,7 @@ Int_t MagneticWrapperChebyshev::findSolenoidSegment(const Double_t* rpz) const
     }
     break;
   }
-  return mSegmentIdSolenoid[rid];
+  return (cache.solenoid = mSegmentIdSolenoid[rid]);
 }
 
 Int_t MagneticWrapperChebyshev::findTPCSegment(const Double_t* rpz) const
@@ -17,6 +17,9 @@
 #include "Field/MagneticField.h"
 #include "Field/MagFieldFast.h"
 #include <memory>
+#include <vector>
+#include <cmath>
+#include <algorithm>
 #include "FairLogger.h" // for FairLogger
 #include <TStopwatch.h>
 #include <TRandom.h>
@@ -98,3 +101,31 @@ BOOST_AUTO_TEST_CASE(MagneticField_test)
     BOOST_CHECK(TMath::Abs(rms[i] / nomBz) < 1.e-3);
   }
 }
+
+BOOST_AUTO_TEST_CASE(MagneticField_batch_test)
+{
+  // the batched query must reproduce the single point one, regardless of the order of the queries
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+
+  const int ntst = 10000;
+  float rnd[3];
+  std::vector<double> xyz(3 * ntst), bBatch(3 * ntst);
+  for (int it = ntst; it--;) {
+    gRandom->RndmArray(3, rnd);
+    xyz[3 * it + 0] = rnd[0] * 400. * TMath::Cos(rnd[1] * TMath::Pi() * 2);
+    xyz[3 * it + 1] = rnd[0] * 400. * TMath::Sin(rnd[1] * TMath::Pi() * 2);
+    xyz[3 * it + 2] = (rnd[2] - 0.5) * 1500.; // cover both the solenoid and the dipole regions
+  }
+  fld->Field(ntst, xyz.data(), bBatch.data());
+
+  double maxDiff = 0.;
+  for (int it = ntst; it--;) {
+    double b[3];
+    fld->Field(&xyz[3 * it], b);
+    for (int i = 0; i < 3; i++) {
+      maxDiff = std::max(maxDiff, std::abs(b[i] - bBatch[3 * it + i]));
+    }
+  }
+  LOG(INFO) << "Max difference between batched and single point field queries: " << maxDiff;
+  BOOST_CHECK(maxDiff < 1.e-6);
+}
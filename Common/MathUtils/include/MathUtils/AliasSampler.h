@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// @file   AliasSampler.h
+/// @brief  Sampling of random numbers from a tabulated distribution
+///
+
+#ifndef ALICEO2_MATHUTILS_ALIASSAMPLER_H_
+#define ALICEO2_MATHUTILS_ALIASSAMPLER_H_
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+class TF1;
+class TH1;
+class TRandom;
+
+namespace o2
+{
+namespace math_utils
+{
+
+/// Sampler of random numbers from a 1D distribution, given as a function or histogram.
+///
+/// The distribution is tabulated once in bins, from which the bin of every draw is
+/// chosen in constant time with the alias method (Walker/Vose), followed by the position
+/// inside the bin: according to the linear interpolation of the function between the
+/// bin edges, or flat for histograms. This replaces TF1::GetRandom, which does a binary
+/// search in the cumulative integral and a quadratic interpolation for every draw, and
+/// whose cumulative integral is expensive to compute for fine binnings.
+class AliasSampler
+{
+ public:
+  AliasSampler() = default;
+
+  /// table of the function in its range, with its number of points (TF1::GetNpx) as bins
+  explicit AliasSampler(const TF1& function);
+
+  /// table of the function in [xmin, xmax], with nBins bins (the number of points of the function if 0)
+  AliasSampler(const TF1& function, double xmin, double xmax, int nBins = 0);
+
+  /// table of the contents of the histogram bins (w/o under- and overflow)
+  explicit AliasSampler(const TH1& histogram);
+
+  /// initialize from the (non-negative) values of the distribution at the nBins + 1
+  /// equidistant edges of the bins in [xmin, xmax], interpolated linearly in between
+  void initialize(const std::vector<double>& values, double xmin, double xmax);
+
+  /// initialize from the (non-negative) contents of the bins with the given nBins + 1 edges,
+  /// the distribution is flat inside the bins
+  void initializeBins(const std::vector<double>& contents, const std::vector<double>& edges);
+
+  bool isValid() const { return !mProbability.empty(); }
+  size_t getNBins() const { return mProbability.size(); }
+
+  /// the value for the uniform random numbers u1 and u2 in [0, 1): u1 selects the bin,
+  /// u2 the position inside it
+  float getValue(double u1, double u2) const
+  {
+    const int nBins = mProbability.size();
+    double x = u1 * nBins;
+    int bin = int(x);
+    if (bin >= nBins) {
+      bin = nBins - 1;
+    }
+    if (x - bin >= mProbability[bin]) {
+      bin = mAlias[bin];
+    }
+    const float low = mEdges[bin], width = mEdges[bin + 1] - low;
+    if (mValues.empty()) {
+      return low + u2 * width;
+    }
+    // inversion of the cumulative of the linear density a + (b - a) * t in [0, 1]
+    const double a = mValues[bin], b = mValues[bin + 1];
+    const double denominator = a + std::sqrt(a * a + (b * b - a * a) * u2);
+    const double t = denominator > 0 ? u2 * (a + b) / denominator : u2;
+    return low + t * width;
+  }
+
+  /// next random value, using gRandom
+  float sample() const;
+  /// next random value, using the given generator
+  float sample(TRandom& random) const;
+
+  /// fill values with n random values, generating all uniform numbers at once
+  void sample(float* values, size_t n) const;
+  void sample(float* values, size_t n, TRandom& random) const;
+
+ private:
+  void buildAliasTable(const std::vector<double>& weights);
+
+  std::vector<float> mProbability; ///< probability to keep the bin rather than taking its alias
+  std::vector<int> mAlias;         ///< alias bin of each bin
+  std::vector<float> mEdges;       ///< edges of the bins
+  std::vector<float> mValues;      ///< values of the distribution at the edges, empty for flat bins
+};
+
+} // namespace math_utils
+} // namespace o2
+
+#endif
@@ -165,6 +165,8 @@ class Chebyshev3DCalc : public TNamed
   /// Reads single line from the stream, skipping empty and commented lines. EOF is not expected
   static void readLine(TString& str, FILE* stream);
 
+  /// Evaluates Chebyshev parameterization for 3D function, thread-safe
+  /// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
   Float_t Eval(const Float_t* par) const;
 
   Double_t Eval(const Double_t* par) const;
@@ -213,37 +215,6 @@ inline Float_t Chebyshev3DCalc::chebyshevEvaluation1D(Float_t x, const Float_t*
   return b0 - x * b1;
 }
 
-/// Evaluates Chebyshev parameterization for 3D function.
-/// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
-inline Float_t Chebyshev3DCalc::Eval(const Float_t* par) const
-{
-  for (int id0 = mNumberOfRows; id0--;) {
-    int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
-    int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
-    for (int id1 = nCLoc; id1--;) {
-      int id = id1 + col0;
-      mTemporaryCoefficients2D[id1] = chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], mCoefficientBound2D0[id]);
-    }
-    mTemporaryCoefficients1D[id0] = chebyshevEvaluation1D(par[1], mTemporaryCoefficients2D, nCLoc);
-  }
-  return chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mNumberOfRows);
-}
-
-/// Evaluates Chebyshev parameterization for 3D function.
-/// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
-inline Double_t Chebyshev3DCalc::Eval(const Double_t* par) const
-{
-  for (int id0 = mNumberOfRows; id0--;) {
-    int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
-    int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
-    for (int id1 = nCLoc; id1--;) {
-      int id = id1 + col0;
-      mTemporaryCoefficients2D[id1] = chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], mCoefficientBound2D0[id]);
-    }
-    mTemporaryCoefficients1D[id0] = chebyshevEvaluation1D(par[1], mTemporaryCoefficients2D, nCLoc);
-  }
-  return chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mNumberOfRows);
-}
 } // namespace math_utils
 } // namespace o2
 
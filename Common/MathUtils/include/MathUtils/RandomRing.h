@@ -29,11 +29,13 @@
 #ifndef ALICEO2_MATHUTILS_RANDOMRING_H_
 #define ALICEO2_MATHUTILS_RANDOMRING_H_
 
+#include <algorithm>
 #include <array>
 
 #include "TF1.h"
 #include "TRandom.h"
 #include <functional>
+#include "MathUtils/AliasSampler.h"
 
 
 namespace o2
@@ -65,7 +67,9 @@ class RandomRing
   void initialize(const RandomType randomType = RandomType::Gaus);
 
   /// initialisation of the random ring
-  /// @param [in] randomType type of the random generator
+  /// The values are sampled from the tabulated function (see AliasSampler),
+  /// using its number of points (TF1::SetNpx) as bins
+  /// @param [in] function TF1 function
   void initialize(TF1& function);
 
   /// initialisation of the random ring
@@ -86,6 +90,25 @@ class RandomRing
     return value;
   }
 
+  /// next n random values from the ring buffer
+  /// This function copies the values in blocks and increases the buffer position by n,
+  /// giving the same values as n calls of getNextValue
+  /// @param [out] values destination of the random values
+  /// @param [in] n number of random values
+  void getNextValues(float* values, size_t n)
+  {
+    while (n) {
+      const size_t chunk = std::min(n, mRandomNumbers.size() - mRingPosition);
+      std::copy_n(mRandomNumbers.begin() + mRingPosition, chunk, values);
+      values += chunk;
+      n -= chunk;
+      mRingPosition += chunk;
+      if (mRingPosition >= mRandomNumbers.size()) {
+        mRingPosition = 0;
+      }
+    }
+  }
+
   /// next vector with random values
   /// This function retuns a Vc vector with random numbers to be
   /// used for vectorised programming and increases the buffer
@@ -169,9 +192,14 @@ template <size_t N>
 inline void RandomRing<N>::initialize(TF1& function)
 {
   mRandomType = RandomType::CustomTF1;
-  for (auto& v : mRandomNumbers) {
-    v = function.GetRandom();
+  const AliasSampler sampler(function);
+  if (!sampler.isValid()) {
+    for (auto& v : mRandomNumbers) {
+      v = function.GetRandom();
+    }
+    return;
   }
+  sampler.sample(mRandomNumbers.data(), mRandomNumbers.size());
 }
 
 //______________________________________________________________________________
@@ -744,6 +744,66 @@ GPUdi() Expr<MatrixMulOpGPU<SMatrixGPU<T, D1, D, R1>, SMatrixGPU<T, D, D2, R2>,
               typename MultPolicyGPU<T, R1, R2>::RepType>(MatMulOp(lhs, rhs));
 }
 
+/// Inversion of symmetric positive definite matrices via the LDL^T decomposition, without pivoting nor square roots.
+/// All the loops have compile-time bounds and are unrolled for the small sizes, the only branch is the check of the pivots.
+template <class T, unsigned int D>
+class CholInverter
+{
+ public:
+  /// \return false if the matrix is not positive definite, in which case it is left unchanged
+  GPUd() static bool Dinv(MatRepSymGPU<T, D>& rhs);
+
+ private:
+  static GPUdi() constexpr int idx(int i, int j) { return i * (i + 1) / 2 + j; } // packed lower triangle, for j <= i
+};
+
+template <class T, unsigned int D>
+GPUdi() bool CholInverter<T, D>::Dinv(MatRepSymGPU<T, D>& rhs)
+{
+  T l[MatRepSymGPU<T, D>::kSize]; // unit lower triangular L, below the diagonal
+  T d[D], dInv[D];                 // diagonal D and its inverse
+  // decomposition A = L D L^T
+  for (int j = 0; j < int(D); j++) {
+    T dj = rhs.Array()[idx(j, j)];
+    for (int k = 0; k < j; k++) {
+      dj -= l[idx(j, k)] * l[idx(j, k)] * d[k];
+    }
+    if (!(dj > T(0))) {
+      return false;
+    }
+    d[j] = dj;
+    dInv[j] = T(1) / dj;
+    for (int i = j + 1; i < int(D); i++) {
+      T lij = rhs.Array()[idx(i, j)];
+      for (int k = 0; k < j; k++) {
+        lij -= l[idx(i, k)] * l[idx(j, k)] * d[k];
+      }
+      l[idx(i, j)] = lij * dInv[j];
+    }
+  }
+  // L^-1, also unit lower triangular, in place of L
+  for (int i = 1; i < int(D); i++) {
+    for (int j = 0; j < i; j++) {
+      T mij = -l[idx(i, j)];
+      for (int k = j + 1; k < i; k++) {
+        mij -= l[idx(i, k)] * l[idx(k, j)];
+      }
+      l[idx(i, j)] = mij;
+    }
+  }
+  // A^-1 = L^-T D^-1 L^-1
+  for (int i = 0; i < int(D); i++) {
+    for (int j = 0; j <= i; j++) {
+      T aij = i == j ? dInv[i] : l[idx(i, j)] * dInv[i];
+      for (int k = i + 1; k < int(D); k++) {
+        aij += l[idx(k, i)] * l[idx(k, j)] * dInv[k];
+      }
+      rhs.Array()[idx(i, j)] = aij;
+    }
+  }
+  return true;
+}
+
 /// Inversion
 template <unsigned int D, unsigned int N = D>
 class Inverter
@@ -768,9 +828,15 @@ class Inverter
   }
 
   //  symmetric matrix inversion (Bunch-kaufman pivoting)
+  //  the sizes of the covariance matrices of the fits try first the LDL^T decomposition, valid for positive definite matrices
   template <class T>
   GPUd() static bool Dinv(MatRepSymGPU<T, D>& rhs)
   {
+    if constexpr (D == 2 || D == 3 || D == 5 || D == 6) {
+      if (CholInverter<T, D>::Dinv(rhs)) {
+        return true;
+      }
+    }
     int ifail{0};
     InvertBunchKaufman(rhs, ifail);
     if (!ifail) {
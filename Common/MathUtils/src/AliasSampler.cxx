@@ -0,0 +1,176 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// @file   AliasSampler.cxx
+/// @brief  Sampling of random numbers from a tabulated distribution
+///
+
+#include "MathUtils/AliasSampler.h"
+#include "FairLogger.h"
+#include <TF1.h>
+#include <TH1.h>
+#include <TRandom.h>
+#include <algorithm>
+#include <array>
+
+using namespace o2::math_utils;
+
+//_________________________________________________
+AliasSampler::AliasSampler(const TF1& function) : AliasSampler(function, function.GetXmin(), function.GetXmax())
+{
+}
+
+//_________________________________________________
+AliasSampler::AliasSampler(const TF1& function, double xmin, double xmax, int nBins)
+{
+  if (nBins <= 0) {
+    nBins = function.GetNpx();
+  }
+  std::vector<double> values(nBins + 1);
+  const double width = (xmax - xmin) / nBins;
+  for (int i = 0; i <= nBins; i++) {
+    values[i] = function.Eval(xmin + i * width);
+  }
+  initialize(values, xmin, xmax);
+}
+
+//_________________________________________________
+AliasSampler::AliasSampler(const TH1& histogram)
+{
+  const int nBins = histogram.GetNbinsX();
+  std::vector<double> contents(nBins), edges(nBins + 1);
+  for (int i = 0; i < nBins; i++) {
+    contents[i] = histogram.GetBinContent(i + 1);
+    edges[i] = histogram.GetXaxis()->GetBinLowEdge(i + 1);
+  }
+  edges[nBins] = histogram.GetXaxis()->GetBinUpEdge(nBins);
+  initializeBins(contents, edges);
+}
+
+//_________________________________________________
+void AliasSampler::initialize(const std::vector<double>& values, double xmin, double xmax)
+{
+  const int nBins = int(values.size()) - 1;
+  if (nBins < 1) {
+    LOG(ERROR) << "AliasSampler: at least 2 values are needed, " << values.size() << " given";
+    return;
+  }
+  mValues.resize(nBins + 1);
+  mEdges.resize(nBins + 1);
+  std::vector<double> weights(nBins);
+  const double width = (xmax - xmin) / nBins;
+  for (int i = 0; i <= nBins; i++) {
+    mValues[i] = std::max(values[i], 0.);
+    mEdges[i] = xmin + i * width;
+  }
+  for (int i = 0; i < nBins; i++) {
+    weights[i] = mValues[i] + mValues[i + 1];
+  }
+  buildAliasTable(weights);
+}
+
+//_________________________________________________
+void AliasSampler::initializeBins(const std::vector<double>& contents, const std::vector<double>& edges)
+{
+  if (contents.empty() || edges.size() != contents.size() + 1) {
+    LOG(ERROR) << "AliasSampler: " << contents.size() << " bins need " << contents.size() + 1 << " edges, " << edges.size() << " given";
+    return;
+  }
+  mValues.clear();
+  mEdges.assign(edges.begin(), edges.end());
+  std::vector<double> weights(contents.size());
+  std::transform(contents.begin(), contents.end(), weights.begin(), [](double c) { return std::max(c, 0.); });
+  buildAliasTable(weights);
+}
+
+//_________________________________________________
+void AliasSampler::buildAliasTable(const std::vector<double>& weights)
+{
+  // Vose's construction: the bins with a weight below the average are completed
+  // by a share of a bin above the average, which becomes their alias
+
+  const int nBins = weights.size();
+  double sum = 0;
+  for (auto w : weights) {
+    sum += w;
+  }
+  mProbability.clear();
+  mAlias.clear();
+  if (!(sum > 0)) {
+    LOG(ERROR) << "AliasSampler: the integral of the distribution is " << sum;
+    return;
+  }
+  std::vector<double> scaled(nBins);
+  std::vector<int> small, large;
+  for (int i = 0; i < nBins; i++) {
+    scaled[i] = weights[i] * nBins / sum;
+    (scaled[i] < 1. ? small : large).push_back(i);
+  }
+  mProbability.resize(nBins);
+  mAlias.resize(nBins);
+  while (!small.empty() && !large.empty()) {
+    int s = small.back(), l = large.back();
+    small.pop_back();
+    mProbability[s] = scaled[s];
+    mAlias[s] = l;
+    scaled[l] -= 1. - scaled[s];
+    if (scaled[l] < 1.) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // what is left is 1 up to rounding
+  for (auto i : large) {
+    mProbability[i] = 1.f;
+    mAlias[i] = i;
+  }
+  for (auto i : small) {
+    mProbability[i] = 1.f;
+    mAlias[i] = i;
+  }
+}
+
+//_________________________________________________
+float AliasSampler::sample() const
+{
+  return sample(*gRandom);
+}
+
+//_________________________________________________
+float AliasSampler::sample(TRandom& random) const
+{
+  const double u1 = random.Rndm();
+  return getValue(u1, random.Rndm());
+}
+
+//_________________________________________________
+void AliasSampler::sample(float* values, size_t n) const
+{
+  sample(values, n, *gRandom);
+}
+
+//_________________________________________________
+void AliasSampler::sample(float* values, size_t n, TRandom& random) const
+{
+  // the uniform numbers are generated in blocks, 2 per value
+  constexpr size_t BlockSize = 512;
+  std::array<double, 2 * BlockSize> uniform;
+  while (n) {
+    const size_t chunk = std::min(n, BlockSize);
+    random.RndmArray(2 * chunk, uniform.data());
+    for (size_t i = 0; i < chunk; i++) {
+      values[i] = getValue(uniform[2 * i], uniform[2 * i + 1]);
+    }
+    values += chunk;
+    n -= chunk;
+  }
+}
@@ -17,6 +17,7 @@
 #include <TSystem.h> // for TSystem, gSystem
 #include "TNamed.h"  // for TNamed
 #include "TString.h" // for TString, TString::EStripType::kBoth
+#include <vector>
 
 using namespace o2::math_utils;
 
@@ -203,6 +204,35 @@ void Chebyshev3DCalc::Print(const Option_t*) const
   printf("%d coefficients in %dx%dx%d matrix\n", mNumberOfCoefficients, mNumberOfRows, mNumberOfColumns, nmax3d);
 }
 
+Float_t Chebyshev3DCalc::Eval(const Float_t* par) const
+{
+  // the summation buffers are per thread rather than the mTemporaryCoefficients* members,
+  // so that the same parameterization (e.g. the field map) can be evaluated concurrently
+  thread_local std::vector<Float_t> tmpCoefficients;
+  if (tmpCoefficients.size() < size_t(mNumberOfRows + mNumberOfColumns)) {
+    tmpCoefficients.resize(mNumberOfRows + mNumberOfColumns);
+  }
+  Float_t* tmpCoefficients1D = tmpCoefficients.data();
+  Float_t* tmpCoefficients2D = tmpCoefficients1D + mNumberOfRows;
+  for (int id0 = mNumberOfRows; id0--;) {
+    int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
+    int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
+    for (int id1 = nCLoc; id1--;) {
+      int id = id1 + col0;
+      tmpCoefficients2D[id1] = chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], mCoefficientBound2D0[id]);
+    }
+    tmpCoefficients1D[id0] = chebyshevEvaluation1D(par[1], tmpCoefficients2D, nCLoc);
+  }
+  return chebyshevEvaluation1D(par[0], tmpCoefficients1D, mNumberOfRows);
+}
+
+Double_t Chebyshev3DCalc::Eval(const Double_t* par) const
+{
+  // the arguments are anyway used in single precision
+  Float_t parF[3] = {Float_t(par[0]), Float_t(par[1]), Float_t(par[2])};
+  return Eval(parF);
+}
+
 Float_t Chebyshev3DCalc::evaluateDerivative(int dim, const Float_t* par) const
 {
   int ncfRC;
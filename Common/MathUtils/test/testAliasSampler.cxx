@@ -0,0 +1,76 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test AliasSampler
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "MathUtils/AliasSampler.h"
+#include <TF1.h>
+#include <TH1F.h>
+#include <TRandom3.h>
+#include <vector>
+
+using namespace o2::math_utils;
+
+BOOST_AUTO_TEST_CASE(AliasSamplerTF1_test)
+{
+  TF1 func("testfunction", "std::pow(x, 1.2)*std::exp(-x/3.)", 0, 100.);
+  func.SetNpx(1000);
+  AliasSampler sampler(func);
+  BOOST_CHECK(sampler.isValid());
+  BOOST_CHECK(sampler.getNBins() == 1000);
+
+  TRandom3 random(1234);
+  const int n = 1000000;
+  std::vector<float> values(n);
+  sampler.sample(values.data(), n, random);
+  double sum = 0, sum2 = 0;
+  for (auto v : values) {
+    BOOST_CHECK(v >= 0 && v <= 100);
+    sum += v;
+    sum2 += v * v;
+  }
+  // gamma distribution with k = 2.2, theta = 3
+  const double mean = sum / n, variance = sum2 / n - mean * mean;
+  BOOST_CHECK_CLOSE(mean, 6.6, 0.5);
+  BOOST_CHECK_CLOSE(variance, 19.8, 1.);
+
+  // restricted range
+  AliasSampler restricted(func, 5., 10.);
+  for (int i = 0; i < 1000; i++) {
+    auto v = restricted.sample(random);
+    BOOST_CHECK(v >= 5 && v <= 10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AliasSamplerHistogram_test)
+{
+  TH1F hist("hist", "hist", 4, 0., 4.);
+  hist.SetBinContent(1, 1.);
+  hist.SetBinContent(3, 3.);
+  AliasSampler sampler(hist);
+  BOOST_CHECK(sampler.isValid());
+
+  TRandom3 random(1234);
+  const int n = 100000;
+  int nFirst = 0;
+  for (int i = 0; i < n; i++) {
+    auto v = sampler.sample(random);
+    // empty bins are never sampled
+    BOOST_CHECK((v >= 0 && v < 1) || (v >= 2 && v < 3));
+    nFirst += v < 1;
+  }
+  BOOST_CHECK_CLOSE(double(nFirst) / n, 0.25, 2.);
+
+  TH1F empty("empty", "empty", 4, 0., 4.);
+  BOOST_CHECK(!AliasSampler(empty).isValid());
+}
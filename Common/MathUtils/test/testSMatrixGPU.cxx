@@ -0,0 +1,92 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test SMatrixGPU
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <Math/SMatrix.h>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "MathUtils/SMatrixGPU.h"
+
+using namespace o2;
+
+// inversion of random symmetric matrices of size D, compared to the ROOT SMatrix one, and its timing
+template <unsigned int D>
+void testSymInversion(bool posDef)
+{
+  using MatGPU = math_utils::SMatrixGPU<double, D, D, math_utils::MatRepSymGPU<double, D>>;
+  using MatROOT = ROOT::Math::SMatrix<double, D, D, ROOT::Math::MatRepSym<double, D>>;
+  constexpr int NMat = 10000;
+  std::mt19937 gen(D);
+  std::normal_distribution<double> rnd;
+  std::vector<MatGPU> matGPU(NMat);
+  std::vector<MatROOT> matROOT(NMat);
+  for (int im = 0; im < NMat; im++) {
+    std::array<std::array<double, D>, D> b;
+    for (auto& row : b) {
+      for (auto& v : row) {
+        v = rnd(gen);
+      }
+    }
+    for (unsigned int i = 0; i < D; i++) {
+      for (unsigned int j = 0; j <= i; j++) {
+        double v = 0.;
+        if (posDef) { // B B^T + 0.1 I
+          for (unsigned int k = 0; k < D; k++) {
+            v += b[i][k] * b[j][k];
+          }
+          v += i == j ? 0.1 : 0.;
+        } else { // the inversion must fall back to the pivoting
+          v = i == j ? (i % 2 ? -1. : 1.) * (1. + std::abs(b[i][j])) : 0.1 * b[i][j];
+        }
+        matGPU[im](i, j) = matROOT[im](i, j) = v;
+      }
+    }
+  }
+  auto t0 = std::chrono::steady_clock::now();
+  for (auto& m : matGPU) {
+    BOOST_CHECK(m.Invert());
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (auto& m : matROOT) {
+    BOOST_CHECK(m.Invert());
+  }
+  auto t2 = std::chrono::steady_clock::now();
+  double maxDiff = 0.;
+  for (int im = 0; im < NMat; im++) {
+    for (unsigned int i = 0; i < D; i++) {
+      for (unsigned int j = 0; j <= i; j++) {
+        maxDiff = std::max(maxDiff, std::abs(matGPU[im](i, j) - matROOT[im](i, j)) / (1. + std::abs(matROOT[im](i, j))));
+      }
+    }
+  }
+  std::cout << "Symmetric " << D << "x" << D << (posDef ? " pos. definite" : " indefinite") << " inversion: max. rel. difference to ROOT " << maxDiff
+            << ", SMatrixGPU " << std::chrono::duration<double, std::nano>(t1 - t0).count() / NMat << " ns"
+            << ", ROOT SMatrix " << std::chrono::duration<double, std::nano>(t2 - t1).count() / NMat << " ns per matrix" << std::endl;
+  BOOST_CHECK(maxDiff < 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(SMatrixGPU_SymInversion)
+{
+  for (bool posDef : {true, false}) {
+    testSymInversion<2>(posDef);
+    testSymInversion<3>(posDef);
+    testSymInversion<4>(posDef);
+    testSymInversion<5>(posDef);
+    testSymInversion<6>(posDef);
+  }
+}
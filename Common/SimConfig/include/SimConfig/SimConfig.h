@@ -51,8 +51,9 @@ struct SimConfigData {
   int mField;                                // L3 field setting in kGauss: +-2,+-5 and 0
   bool mUniformField = false;                // uniform magnetic field
   bool mAsService = false;                   // if simulation should be run as service/deamon (does not exit after run)
+  std::string mGeometryCacheFile;            // file caching the geometry and material tables (written if absent, loaded otherwise)
 
-  ClassDefNV(SimConfigData, 4);
+  ClassDefNV(SimConfigData, 5);
 };
 
 // A singleton class which can be used
@@ -115,6 +116,7 @@ class SimConfig
   int getNSimWorkers() const { return mConfigData.mSimWorkers; }
   bool isFilterOutNoHitEvents() const { return mConfigData.mFilterNoHitEvents; }
   bool asService() const { return mConfigData.mAsService; }
+  std::string getGeometryCacheFile() const { return mConfigData.mGeometryCacheFile; }
 
  private:
   SimConfigData mConfigData; //!
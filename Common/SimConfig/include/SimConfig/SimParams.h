@@ -38,6 +38,15 @@ struct SimCutParams : public o2::conf::ConfigurableParamHelper<SimCutParams> {
   O2ParamDef(SimCutParams, "SimCutParams");
 };
 
+// parameters of the sampled step statistics in O2MCApplication stepping
+struct SimStepStatParams : public o2::conf::ConfigurableParamHelper<SimStepStatParams> {
+  int sampling = 0;         // record every n-th step in the per-volume and per-particle statistics (0 = off)
+  std::string volumes = ""; // comma separated names of the volumes to which the statistics is restricted (all if empty)
+  int nPrint = 20;          // number of volumes and particles with the largest time reported at the end of each event
+
+  O2ParamDef(SimStepStatParams, "SimStepStatParams");
+};
+
 // parameter influencing material manager
 struct SimMaterialParams : public o2::conf::ConfigurableParamHelper<SimMaterialParams> {
   float globalDensityFactor = 1.f;
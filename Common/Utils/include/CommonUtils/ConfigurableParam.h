@@ -189,18 +189,14 @@ class ConfigurableParam
   template <typename T>
   static T getValueAs(std::string key)
   {
-    if (!sIsFullyInitialized) {
-      initialize();
-    }
+    initializeFor(key);
     return sPtree->get<T>(key);
   }
 
   template <typename T>
   static void setValue(std::string const& mainkey, std::string const& subkey, T x)
   {
-    if (!sIsFullyInitialized) {
-      initialize();
-    }
+    initializeFor(mainkey);
     assert(sPtree);
     try {
       auto key = mainkey + "." + subkey;
@@ -220,9 +216,7 @@ class ConfigurableParam
   // which means that the type will be converted internally
   static void setValue(std::string const& key, std::string const& valuestring)
   {
-    if (!sIsFullyInitialized) {
-      initialize();
-    }
+    initializeFor(key);
     assert(sPtree);
     try {
       if (sPtree->get_optional<std::string>(key).is_initialized()) {
@@ -246,6 +240,10 @@ class ConfigurableParam
   // initializes the parameter database
   static void initialize();
 
+  // initializes the parameter database only for the parameter class of the key (main key or main key.subkey),
+  // the introspection of all the other classes is done only when they are accessed
+  static void initializeFor(std::string const& key);
+
   // create CCDB snapsnot
   static void toCCDB(std::string filename);
   // load from (CCDB) snapshot
@@ -306,6 +304,8 @@ class ConfigurableParam
   static boost::property_tree::ptree* sPtree; //!
   static bool sIsFullyInitialized;            //!
   static bool sRegisterMode;                  //! (flag to enable/disable autoregistering of child classes)
+
+  bool mIsInitialized = false; //! keys of this class are in the parameter database
 };
 
 } // end namespace conf
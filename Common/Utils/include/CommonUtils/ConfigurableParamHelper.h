@@ -95,9 +95,7 @@ class ConfigurableParamHelper : virtual public ConfigurableParam
   // one of the key methods, using introspection to print itself
   void printKeyValues(bool showProv = true) const final
   {
-    if (!isInitialized()) {
-      initialize();
-    }
+    initializeFor(getName());
     auto members = getDataMembers();
     _ParamHelper::printMembersImpl(getName(), members, showProv);
   }
@@ -22,6 +22,9 @@
 #include <list>
 #include <cstddef>
 #include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include <boost/interprocess/managed_external_buffer.hpp>
 #include <boost/interprocess/allocators/allocator.hpp>
@@ -36,6 +39,14 @@ namespace utils
 // the size dedicated to each attached worker/process
 constexpr size_t SHMPOOLSIZE = 1024 * 1024 * 1024; // 1 GB
 
+// small blocks are served from slabs of this size, taken from the pool and
+// split into blocks of one size class (powers of 2 from SHMMINBLOCKSIZE to SHMMAXBLOCKSIZE)
+constexpr size_t SHMSLABSIZE = 256 * 1024;
+constexpr size_t SHMMINBLOCKSIZE = 16;
+constexpr size_t SHMMAXBLOCKSIZE = 16 * 1024;
+constexpr int SHMNSIZECLASSES = 11;
+static_assert((SHMMINBLOCKSIZE << (SHMNSIZECLASSES - 1)) == SHMMAXBLOCKSIZE, "inconsistent size classes");
+
 // some meta info stored at the beginning of the global shared mem segment
 struct ShmMetaInfo {
   unsigned long long allocedbytes = 0;
@@ -50,6 +61,13 @@ struct ShmMetaInfo {
 // to put hits directly in shared mem; I hope this can be replaced/refactored
 // to use directly functionality by FairMQ some day.
 // For the moment a wrapper around boost allocators ... enhancing them with some state.
+//
+// The boost segment of a process is not thread safe by itself, so its use is serialized
+// by a mutex. Since the Geant workers allocate and free many small blocks concurrently,
+// these are served from slabs instead: every thread keeps its own free list and current
+// slab for each size class, which need no locking. Only the refill of an empty free list
+// from the blocks given back by other threads, the allocation of a new slab and the
+// blocks larger than SHMMAXBLOCKSIZE go through shared structures.
 class ShmManager
 {
  public:
@@ -72,6 +90,8 @@ class ShmManager
 
   // the equivalent of malloc
   void* getmemblock(size_t size);
+  // the same, returning nullptr instead of failing fatally if there is no space left
+  void* trygetmemblock(size_t size);
   // the equivalent of free
   void freememblock(void*, std::size_t = 1);
 
@@ -113,6 +133,32 @@ class ShmManager
   void* tryAttach(bool& success);
   size_t getPointerOffset(void* ptr) const { return (size_t)((char*)ptr - (char*)mBufferPtr); }
 
+  struct ThreadCache;
+  friend struct ThreadCache;
+  static ThreadCache& threadCache();
+
+  // the slab layer
+  void* allocateSmallBlock(int sizeclass);
+  void freeSmallBlock(void* ptr, int sizeclass);
+  void* allocateSlab(int sizeclass);
+  // index of the slab containing ptr, in units of SHMSLABSIZE from the aligned buffer start
+  size_t getSlabIndex(void* ptr) const { return ((size_t)ptr - ((size_t)mBufferPtr & ~(SHMSLABSIZE - 1))) / SHMSLABSIZE; }
+  // returns the size class of the slab containing ptr, -1 if ptr is not in a slab
+  int getSlabClass(void* ptr) const
+  {
+    auto index = getSlabIndex(ptr);
+    return index < mSlabClass.size() ? (int)mSlabClass[index].load(std::memory_order_relaxed) - 1 : -1;
+  }
+  // the free blocks given back by threads, as linked lists with their length
+  struct SharedFreeList {
+    std::mutex mutex;
+    std::vector<std::pair<void*, int>> lists;
+    std::atomic<int> nLists = 0; // to check for lists without locking
+  };
+  SharedFreeList mSharedFreeLists[SHMNSIZECLASSES];
+  std::vector<std::atomic<unsigned char>> mSlabClass; // size class + 1 of every slab of the pool, 0 if not a slab
+  std::mutex mSegmentMutex;                            // serializing the use of the boost segment
+
   boost::interprocess::wmanaged_external_buffer* boostmanagedbuffer;
   boost::interprocess::allocator<char, boost::interprocess::wmanaged_external_buffer::segment_manager>* boostallocator;
 };
@@ -18,6 +18,9 @@
 
 #include <TString.h>
 #include <TTree.h>
+#include <deque>
+#include <functional>
+#include <random>
 #include <vector>
 
 class TBranch;
@@ -48,9 +51,18 @@ class TreeStream
     std::string name;            ///< name of the element
   };
 
+  /// An entry with the data of all elements serialized, such that it can be filled to the tree later,
+  /// possibly from another thread (see TreeStreamRedirector::setAsync)
+  struct Entry {
+    std::vector<TreeDataElement> layout; ///< all elements (w/o data pointer) if the layout changed with this entry, empty otherwise
+    std::vector<int> sizes;              ///< size of the serialized data of each element, -1 for null objects
+    std::vector<char> buffer;            ///< serialized data of all elements
+  };
+  using EntrySink = std::function<void(Entry&&)>;
+
   TreeStream(const char* treename);
   TreeStream() = default;
-  virtual ~TreeStream() = default;
+  virtual ~TreeStream();
   void Close() { mTree.Write(); }
   Int_t CheckIn(Char_t type, void* pointer);
   void BuildTree();
@@ -58,6 +70,13 @@ class TreeStream
   Double_t getSize() { return mTree.GetZipBytes(); }
   TreeStream& Endl();
 
+  /// Instead of filling the tree, pass every entry serialized to the sink; the entries are then
+  /// filled with fillEntry, which is the only method accessing the tree in this mode
+  void setEntrySink(EntrySink sink) { mEntrySink = std::move(sink); }
+  void fillEntry(const Entry& entry);
+  /// Keep only a random fraction of the entries
+  void setSamplingFraction(float fraction) { mSamplingFraction = fraction; }
+
   TTree& getTree() { return mTree; }
   const char* getName() const { return mTree.GetName(); }
   void setID(int id) { mID = id; }
@@ -160,6 +179,13 @@ class TreeStream
   Int_t CheckIn(T* obj);
 
  private:
+  template <class Elements>
+  void buildTree(Elements& elements);
+  template <class Elements>
+  void fillTree(Elements& elements, bool doFill);
+  bool isSampled();
+  Entry createEntry();
+
   //
   std::vector<TreeDataElement> mElements;
   std::vector<TBranch*> mBranches; ///< pointers to branches
@@ -168,8 +194,20 @@ class TreeStream
   int mID = -1;                    ///< identifier of layout
   int mNextNameCounter = 0;        ///< next name counter
   int mStatus = 0;                 ///< status of the layout
+  int mNAccepted = 0;              ///< number of entries accepted for filling
   TString mNextName;               ///< name for next entry
 
+  float mSamplingFraction = 1.f; ///< fraction of the entries to keep
+  std::minstd_rand mSampler;     //! random generator for the sampling
+  EntrySink mEntrySink;          //! receiver of the serialized entries, if any
+  bool mLayoutChanged = false;   //! if elements were added or got their class since the last entry
+
+  /// element filled by fillEntry, with the storage for its data
+  struct FillElement : public TreeDataElement {
+    void* storage = nullptr;
+  };
+  std::deque<FillElement> mFillElements; //! deque, since the branches keep the address of the data pointers
+
   ClassDefNV(TreeStream, 0);
 };
 
@@ -196,10 +234,12 @@ Int_t TreeStream::CheckIn(T* obj)
     }
     element.name = name.Data();
     element.ptr = obj;
+    mLayoutChanged = true;
   } else {
     auto& element = mElements[mCurrentIndex];
     if (!element.cls) {
       element.cls = pClass;
+      mLayoutChanged |= pClass != nullptr;
     } else {
       if (element.cls != pClass && pClass) {
         mStatus++;
@@ -18,6 +18,8 @@
 
 #include <Rtypes.h>
 #include <TDirectory.h>
+#include <memory>
+#include <vector>
 #include "CommonUtils/TreeStream.h"
 
 namespace o2
@@ -36,6 +38,10 @@ namespace utils
 /// The flushing of trees to the file happens on TreeStreamRedirector::Close() call
 /// or at its desctruction.
 ///
+/// With setAsync() the entries are only serialized on the calling thread, while the trees are
+/// filled (and their baskets compressed and written) on a background thread. With
+/// setSamplingFraction() only a random fraction of the entries is kept.
+///
 /// See testTreeStream.cxx for functional example
 ///
 class TreeStreamRedirector
@@ -52,13 +58,28 @@ class TreeStreamRedirector
   void SetFile(TFile* sfile);
   static void FixLeafNameBug(TTree* tree);
 
+  /// Fill the trees on a background thread, at most maxQueued serialized entries are
+  /// kept in memory, beyond that the calling thread waits for the queue to drain.
+  /// Must be called before the first entry is streamed.
+  void setAsync(size_t maxQueued = 1000);
+  bool isAsync() const { return mAsync != nullptr; }
+
+  /// Keep only a random fraction of the entries of every stream
+  void setSamplingFraction(float fraction);
+
  private:
   TreeStreamRedirector(const TreeStreamRedirector& tsr);
   TreeStreamRedirector& operator=(const TreeStreamRedirector& tsr);
 
+  TreeStream& addDataLayout(const char* name, int id);
+
+  struct AsyncWriter;
+
   std::unique_ptr<TDirectory> mOwnDirectory;             // own directory of the redirector
   TDirectory* mDirectory = nullptr;                      // output directory
   std::vector<std::unique_ptr<TreeStream>> mDataLayouts; // array of data layouts
+  float mSamplingFraction = 1.f;                         // fraction of the entries to keep
+  std::unique_ptr<AsyncWriter> mAsync;                   //! background writer, if any
 
   ClassDefNV(TreeStreamRedirector, 0);
 };
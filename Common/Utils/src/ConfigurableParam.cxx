@@ -264,6 +264,11 @@ void ConfigurableParam::initPropertyTree()
   sPtree->clear();
   for (auto p : *sRegisteredParamClasses) {
     p->putKeyValues(sPtree);
+    p->mIsInitialized = true;
+  }
+  // the values of classes filled for the 1st time come from code
+  for (auto& key : *sKeyToStorageMap) {
+    sValueProvenanceMap->emplace(key.first, kCODE);
   }
 }
 
@@ -285,9 +290,7 @@ void ConfigurableParam::printAllKeyValuePairs()
 
 ConfigurableParam::EParamProvenance ConfigurableParam::getProvenance(const std::string& key)
 {
-  if (!sIsFullyInitialized) {
-    initialize();
-  }
+  initializeFor(key);
   auto iter = sValueProvenanceMap->find(key);
   if (iter == sValueProvenanceMap->end()) {
     throw std::runtime_error(fmt::format("provenace of unknown {:s} parameter is requested", key));
@@ -356,16 +359,36 @@ ConfigurableParam::ConfigurableParam()
 void ConfigurableParam::initialize()
 {
   initPropertyTree();
-  // initialize the provenance map
-  // initially the values come from code
-  for (auto& key : *sKeyToStorageMap) {
-    sValueProvenanceMap->insert(std::pair<std::string, ConfigurableParam::EParamProvenance>(key.first, kCODE));
-  }
   sIsFullyInitialized = true;
 }
 
 // ------------------------------------------------------------------
 
+void ConfigurableParam::initializeFor(std::string const& key)
+{
+  if (sIsFullyInitialized) {
+    return;
+  }
+  for (auto p : *sRegisteredParamClasses) {
+    auto name = p->getName();
+    if (key.compare(0, name.size(), name) != 0 || (key.size() > name.size() && key[name.size()] != '.')) {
+      continue;
+    }
+    if (!p->mIsInitialized) {
+      p->putKeyValues(sPtree);
+      p->mIsInitialized = true;
+      // initially the values come from code
+      name += '.';
+      for (auto it = sKeyToStorageMap->lower_bound(name); it != sKeyToStorageMap->end() && it->first.compare(0, name.size(), name) == 0; ++it) {
+        sValueProvenanceMap->emplace(it->first, kCODE);
+      }
+    }
+    return;
+  }
+}
+
+// ------------------------------------------------------------------
+
 void ConfigurableParam::printAllRegisteredParamNames()
 {
   for (auto p : *sRegisteredParamClasses) {
@@ -383,10 +406,6 @@ void ConfigurableParam::printAllRegisteredParamNames()
 // (to allow prefernce of run-time settings)
 void ConfigurableParam::updateFromFile(std::string const& configFile, std::string const& paramsList, bool unchangedOnly)
 {
-  if (!sIsFullyInitialized) {
-    initialize();
-  }
-
   auto cfgfile = o2::utils::Str::trim_copy(configFile);
 
   if (cfgfile.length() == 0) {
@@ -449,10 +468,6 @@ void ConfigurableParam::updateFromFile(std::string const& configFile, std::strin
 
 void ConfigurableParam::updateFromString(std::string const& configString)
 {
-  if (!sIsFullyInitialized) {
-    initialize();
-  }
-
   auto cfgStr = o2::utils::Str::trim_copy(configString);
   if (cfgStr.length() == 0) {
     return;
@@ -532,6 +547,7 @@ void ConfigurableParam::setValues(std::vector<std::pair<std::string, std::string
     std::string key = keyValue.first;
     std::string value = o2::utils::Str::trim_copy(keyValue.second);
 
+    initializeFor(key);
     if (!keyInTree(sPtree, key)) {
       LOG(FATAL) << "Inexistant ConfigurableParam key: " << key;
     }
@@ -22,6 +22,7 @@
 #include <sys/shm.h>
 #include <sys/ipc.h>
 #include <algorithm>
+#include <tuple>
 
 #include <boost/interprocess/managed_external_buffer.hpp>
 #include <boost/interprocess/allocators/allocator.hpp>
@@ -41,6 +42,54 @@ const char* SHMIDNAME = "ALICEO2_SIMSHM_SHMID";
 // a common virtual address under which this should be mapped
 const char* SHMADDRNAME = "ALICEO2_SIMSHM_COMMONADDR";
 
+namespace
+{
+// number of free blocks moved at once from a thread to the shared free lists
+constexpr int SHMFREEBATCH = 256;
+
+// the free blocks are linked through their first bytes
+void*& nextBlock(void* block)
+{
+  return *static_cast<void**>(block);
+}
+
+int getSizeClass(size_t size)
+{
+  int sizeclass = 0;
+  for (size_t blocksize = SHMMINBLOCKSIZE; blocksize < size; blocksize <<= 1) {
+    sizeclass++;
+  }
+  return sizeclass;
+}
+} // namespace
+
+// the free blocks and the current slab of one thread, for each size class
+struct ShmManager::ThreadCache {
+  void* freeList[SHMNSIZECLASSES] = {};
+  int nFree[SHMNSIZECLASSES] = {};
+  char* slabCurrent[SHMNSIZECLASSES] = {};
+  char* slabEnd[SHMNSIZECLASSES] = {};
+
+  ~ThreadCache()
+  {
+    // give the free blocks back for the other threads (the rest of the current slabs is lost)
+    for (int c = 0; c < SHMNSIZECLASSES; c++) {
+      if (freeList[c]) {
+        auto& shared = ShmManager::Instance().mSharedFreeLists[c];
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.lists.emplace_back(freeList[c], nFree[c]);
+        shared.nLists.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+ShmManager::ThreadCache& ShmManager::threadCache()
+{
+  thread_local ThreadCache cache;
+  return cache;
+}
+
 ShmManager::ShmManager() = default;
 
 void* ShmManager::tryAttach(bool& success)
@@ -204,6 +253,7 @@ void ShmManager::occupySegment()
     boostmanagedbuffer = new boost::interprocess::wmanaged_external_buffer(create_only, mBufferPtr, SHMPOOLSIZE);
     boostallocator = new boost::interprocess::allocator<char, wmanaged_external_buffer::segment_manager>(
       boostmanagedbuffer->get_segment_manager());
+    mSlabClass = std::vector<std::atomic<unsigned char>>(SHMPOOLSIZE / SHMSLABSIZE + 1);
 
     LOG(INFO) << "SHARED MEM OCCUPIED AT ID " << mShmID << " AND SEGMENT COUNTER " << segmentcounter;
   } else {
@@ -220,8 +270,16 @@ ShmManager::~ShmManager()
 // ... but we are using available boost functionality
 void* ShmManager::getmemblock(size_t size)
 {
+  if (size <= SHMMAXBLOCKSIZE) {
+    auto addr = allocateSmallBlock(getSizeClass(size));
+    if (!addr) {
+      LOG(FATAL) << "NO SPACE LEFT FOR A NEW SLAB IN BOOST SHM ALLOCATION";
+    }
+    return addr;
+  }
   void* addr = nullptr;
   try {
+    std::lock_guard<std::mutex> lock(mSegmentMutex);
     addr = (void*)boostallocator->allocate(size).get();
   } catch (const std::exception& e) {
     LOG(FATAL) << "THROW IN BOOST SHM ALLOCATION";
@@ -229,11 +287,100 @@ void* ShmManager::getmemblock(size_t size)
   return addr;
 }
 
+void* ShmManager::trygetmemblock(size_t size)
+{
+  if (size <= SHMMAXBLOCKSIZE) {
+    return allocateSmallBlock(getSizeClass(size));
+  }
+  try {
+    std::lock_guard<std::mutex> lock(mSegmentMutex);
+    return (void*)boostallocator->allocate(size).get();
+  } catch (const std::exception& e) {
+    LOG(DEBUG) << "NO SPACE LEFT IN BOOST SHM ALLOCATION (" << size << " bytes requested)";
+  };
+  return nullptr;
+}
+
 void ShmManager::freememblock(void* ptr, size_t s)
 {
+  // the size is not needed (nor always given), the slab tells which kind of block this is
+  auto sizeclass = getSlabClass(ptr);
+  if (sizeclass >= 0) {
+    freeSmallBlock(ptr, sizeclass);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mSegmentMutex);
   boostallocator->deallocate((char*)ptr, s);
 }
 
+void* ShmManager::allocateSmallBlock(int sizeclass)
+{
+  auto& cache = threadCache();
+  if (!cache.freeList[sizeclass]) {
+    // take the blocks freed by other threads, if any
+    auto& shared = mSharedFreeLists[sizeclass];
+    if (shared.nLists.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(shared.mutex);
+      if (!shared.lists.empty()) {
+        std::tie(cache.freeList[sizeclass], cache.nFree[sizeclass]) = shared.lists.back();
+        shared.lists.pop_back();
+        shared.nLists.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+  }
+  if (auto block = cache.freeList[sizeclass]) {
+    cache.freeList[sizeclass] = nextBlock(block);
+    cache.nFree[sizeclass]--;
+    return block;
+  }
+  // carve the block from the current slab of the thread
+  if (cache.slabCurrent[sizeclass] == cache.slabEnd[sizeclass]) {
+    auto slab = static_cast<char*>(allocateSlab(sizeclass));
+    if (!slab) {
+      return nullptr;
+    }
+    cache.slabCurrent[sizeclass] = slab;
+    cache.slabEnd[sizeclass] = slab + SHMSLABSIZE;
+  }
+  auto block = cache.slabCurrent[sizeclass];
+  cache.slabCurrent[sizeclass] += SHMMINBLOCKSIZE << sizeclass;
+  return block;
+}
+
+void ShmManager::freeSmallBlock(void* ptr, int sizeclass)
+{
+  auto& cache = threadCache();
+  nextBlock(ptr) = cache.freeList[sizeclass];
+  cache.freeList[sizeclass] = ptr;
+  if (++cache.nFree[sizeclass] < 2 * SHMFREEBATCH) {
+    return;
+  }
+  // keep the most recently freed blocks, give the older ones to the other threads
+  auto last = cache.freeList[sizeclass];
+  for (int i = 1; i < SHMFREEBATCH; i++) {
+    last = nextBlock(last);
+  }
+  auto older = nextBlock(last);
+  nextBlock(last) = nullptr;
+  auto& shared = mSharedFreeLists[sizeclass];
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  shared.lists.emplace_back(older, cache.nFree[sizeclass] - SHMFREEBATCH);
+  shared.nLists.fetch_add(1, std::memory_order_relaxed);
+  cache.nFree[sizeclass] = SHMFREEBATCH;
+}
+
+void* ShmManager::allocateSlab(int sizeclass)
+{
+  std::lock_guard<std::mutex> lock(mSegmentMutex);
+  auto slab = boostmanagedbuffer->get_segment_manager()->allocate_aligned(SHMSLABSIZE, SHMSLABSIZE, std::nothrow);
+  if (!slab) {
+    LOG(DEBUG) << "NO SPACE LEFT FOR A NEW SLAB OF " << (SHMMINBLOCKSIZE << sizeclass) << " BYTE BLOCKS";
+    return nullptr;
+  }
+  mSlabClass[getSlabIndex(slab)].store(sizeclass + 1, std::memory_order_relaxed);
+  return slab;
+}
+
 void ShmManager::release()
 {
 #ifdef USESHM
@@ -13,9 +13,33 @@
 
 #include "CommonUtils/TreeStream.h"
 #include <TBranch.h>
+#include <TBufferFile.h>
+#include <TClass.h>
 
 using namespace o2::utils;
 
+namespace
+{
+// size of the elementary types, as defined by their type code
+int basicTypeSize(char type)
+{
+  switch (type) {
+    case 'B':
+    case 'b':
+      return 1;
+    case 'S':
+    case 's':
+      return 2;
+    case 'I':
+    case 'i':
+    case 'F':
+      return 4;
+    default: // 'L', 'l', 'D'
+      return 8;
+  }
+}
+} // namespace
+
 //_________________________________________________
 TreeStream::TreeStream(const char* treename) : mTree(treename, treename)
 {
@@ -23,6 +47,22 @@ TreeStream::TreeStream(const char* treename) : mTree(treename, treename)
   // Standard ctor
 }
 
+//_________________________________________________
+TreeStream::~TreeStream()
+{
+  // delete the storage of the entries filled by fillEntry
+  for (auto& element : mFillElements) {
+    if (!element.storage) {
+      continue;
+    }
+    if (element.cls) {
+      const_cast<TClass*>(element.cls)->Destructor(element.storage);
+    } else {
+      delete[] static_cast<char*>(element.storage);
+    }
+  }
+}
+
 //_________________________________________________
 int TreeStream::CheckIn(Char_t type, void* pointer)
 {
@@ -42,6 +82,7 @@ int TreeStream::CheckIn(Char_t type, void* pointer)
     }
     element.name = name.Data();
     element.ptr = pointer;
+    mLayoutChanged = true;
   } else {
     auto& element = mElements[mCurrentIndex];
     if (element.type != type) {
@@ -58,17 +99,25 @@ int TreeStream::CheckIn(Char_t type, void* pointer)
 void TreeStream::BuildTree()
 {
   // Build the Tree
+  buildTree(mElements);
+}
+
+//_________________________________________________
+template <class Elements>
+void TreeStream::buildTree(Elements& elements)
+{
+  // Build the Tree for the given elements
 
   int entriesFilled = mTree.GetEntries();
-  if (mBranches.size() < mElements.size()) {
-    mBranches.resize(mElements.size());
+  if (mBranches.size() < elements.size()) {
+    mBranches.resize(elements.size());
   }
 
   TString name;
   TBranch* br = nullptr;
-  for (int i = 0; i < static_cast<int>(mElements.size()); i++) {
+  for (int i = 0; i < static_cast<int>(elements.size()); i++) {
     //
-    auto& element = mElements[i];
+    auto& element = elements[i];
     if (mBranches[i]) {
       continue;
     }
@@ -107,13 +156,22 @@ void TreeStream::BuildTree()
 void TreeStream::Fill()
 {
   // Fill the tree
+  fillTree(mElements, !mStatus); // fill only in case of non conflicts
+  mStatus = 0;
+}
 
-  int entries = mElements.size();
+//_________________________________________________
+template <class Elements>
+void TreeStream::fillTree(Elements& elements, bool doFill)
+{
+  // Fill the tree with the data of the given elements
+
+  int entries = elements.size();
   if (entries > mTree.GetNbranches()) {
-    BuildTree();
+    buildTree(elements);
   }
   for (int i = 0; i < entries; i++) {
-    auto& element = mElements[i];
+    auto& element = elements[i];
     if (!element.type) {
       continue;
     }
@@ -124,10 +182,9 @@ void TreeStream::Fill()
       }
     }
   }
-  if (!mStatus) {
-    mTree.Fill(); // fill only in case of non conflicts
+  if (doFill) {
+    mTree.Fill();
   }
-  mStatus = 0;
 }
 
 //_________________________________________________
@@ -135,15 +192,108 @@ TreeStream& TreeStream::Endl()
 {
   // Perform pseudo endl operation
 
-  if (mTree.GetNbranches() == 0) {
-    BuildTree();
+  if (!mStatus && !isSampled()) {
+    mStatus++; // entry not kept, treated as a rejected one
+  }
+  if (!mStatus) {
+    mNAccepted++;
+  }
+  if (mEntrySink) {
+    if (!mStatus) {
+      mEntrySink(createEntry());
+    }
+  } else {
+    if (mTree.GetNbranches() == 0) {
+      BuildTree();
+    }
+    Fill();
   }
-  Fill();
   mStatus = 0;
   mCurrentIndex = 0;
   return *this;
 }
 
+//_________________________________________________
+bool TreeStream::isSampled()
+{
+  // decide if the current entry is kept
+  return mSamplingFraction >= 1.f || std::uniform_real_distribution<float>(0.f, 1.f)(mSampler) < mSamplingFraction;
+}
+
+//_________________________________________________
+TreeStream::Entry TreeStream::createEntry()
+{
+  // serialize the data of all elements of the current entry,
+  // the layout is passed only when it changed
+
+  Entry entry;
+  if (mLayoutChanged) {
+    entry.layout = mElements;
+    for (auto& element : entry.layout) {
+      element.ptr = nullptr;
+    }
+    mLayoutChanged = false;
+  }
+  entry.sizes.reserve(mElements.size());
+  TBufferFile buffer(TBuffer::kWrite);
+  for (const auto& element : mElements) {
+    int start = buffer.Length();
+    if (element.cls) {
+      if (!element.ptr) {
+        entry.sizes.push_back(-1);
+        continue;
+      }
+      element.cls->Streamer(element.ptr, buffer);
+    } else if (element.type > 0) {
+      buffer.WriteFastArray(static_cast<const char*>(element.ptr), basicTypeSize(element.type));
+    }
+    entry.sizes.push_back(buffer.Length() - start);
+  }
+  entry.buffer.assign(buffer.Buffer(), buffer.Buffer() + buffer.Length());
+  return entry;
+}
+
+//_________________________________________________
+void TreeStream::fillEntry(const Entry& entry)
+{
+  // fill the tree with a serialized entry, its data is read into the storage owned by the stream
+
+  for (size_t i = 0; i < entry.layout.size(); i++) {
+    if (i == mFillElements.size()) {
+      auto& element = mFillElements.emplace_back();
+      element.type = entry.layout[i].type;
+      element.name = entry.layout[i].name;
+    }
+    auto& element = mFillElements[i];
+    if (element.storage) {
+      continue;
+    }
+    element.cls = entry.layout[i].cls;
+    if (element.cls) {
+      element.storage = element.cls->New();
+    } else if (element.type > 0) {
+      element.storage = new char[basicTypeSize(element.type)];
+    }
+  }
+
+  TBufferFile buffer(TBuffer::kRead, entry.buffer.size(), const_cast<char*>(entry.buffer.data()), kFALSE);
+  for (size_t i = 0; i < mFillElements.size(); i++) {
+    auto& element = mFillElements[i];
+    int size = entry.sizes[i];
+    if (size < 0 || !element.storage) {
+      element.ptr = nullptr;
+      continue;
+    }
+    if (element.cls) {
+      element.cls->Streamer(element.storage, buffer);
+    } else {
+      buffer.ReadFastArray(static_cast<char*>(element.storage), size);
+    }
+    element.ptr = element.storage;
+  }
+  fillTree(mFillElements, true);
+}
+
 //_________________________________________________
 TreeStream& TreeStream::operator<<(const Char_t* name)
 {
@@ -154,7 +304,7 @@ TreeStream& TreeStream::operator<<(const Char_t* name)
   }
   //
   // if tree was already defined ignore
-  if (mTree.GetEntries() > 0) {
+  if (mNAccepted > 0) {
     return *this;
   }
   // check branch name if tree was not
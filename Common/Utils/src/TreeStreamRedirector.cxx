@@ -14,10 +14,70 @@
 #include "CommonUtils/TreeStreamRedirector.h"
 #include <TFile.h>
 #include <TLeaf.h>
+#include <TROOT.h>
+#include <condition_variable>
+#include <algorithm>
 #include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <mutex>
+#include <thread>
 
 using namespace o2::utils;
 
+/// Queue of serialized entries, filled to their trees by a dedicated thread
+struct TreeStreamRedirector::AsyncWriter {
+  size_t maxQueued = 1000;
+  std::deque<std::pair<TreeStream*, TreeStream::Entry>> queue;
+  std::mutex queueMutex;
+  std::condition_variable queueFilled;
+  std::condition_variable queueDrained;
+  std::mutex fileMutex; // held while filling an entry or creating a tree in the output directory
+  bool stop = false;
+  std::thread worker;
+
+  void push(TreeStream* stream, TreeStream::Entry&& entry)
+  {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueDrained.wait(lock, [this] { return queue.size() < maxQueued; });
+    queue.emplace_back(stream, std::move(entry));
+    lock.unlock();
+    queueFilled.notify_one();
+  }
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+      queueFilled.wait(lock, [this] { return stop || !queue.empty(); });
+      if (queue.empty()) {
+        break; // stopped and all entries are written
+      }
+      auto item = std::move(queue.front());
+      queue.pop_front();
+      lock.unlock();
+      queueDrained.notify_one();
+      {
+        std::lock_guard<std::mutex> fileLock(fileMutex);
+        item.first->fillEntry(item.second);
+      }
+      lock.lock();
+    }
+  }
+
+  void finish()
+  {
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      stop = true;
+    }
+    queueFilled.notify_one();
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+};
+
 //_________________________________________________
 TreeStreamRedirector::TreeStreamRedirector(const char* fname, const char* option)
 {
@@ -39,6 +99,33 @@ TreeStreamRedirector::~TreeStreamRedirector()
   Close(); // write the tree to the selected file
 }
 
+//_________________________________________________
+void TreeStreamRedirector::setAsync(size_t maxQueued)
+{
+  // fill the trees on a background thread
+  if (mAsync) {
+    return;
+  }
+  if (!mDataLayouts.empty()) {
+    throw std::runtime_error("TreeStreamRedirector::setAsync must be called before streaming any entry");
+  }
+  ROOT::EnableThreadSafety();
+  mAsync = std::make_unique<AsyncWriter>();
+  mAsync->maxQueued = std::max(size_t(1), maxQueued);
+  auto async = mAsync.get();
+  async->worker = std::thread([async] { async->run(); });
+}
+
+//_________________________________________________
+void TreeStreamRedirector::setSamplingFraction(float fraction)
+{
+  // keep only a random fraction of the entries
+  mSamplingFraction = fraction;
+  for (auto& layout : mDataLayouts) {
+    layout->setSamplingFraction(fraction);
+  }
+}
+
 //_________________________________________________
 void TreeStreamRedirector::SetFile(TFile* sfile)
 {
@@ -72,15 +159,7 @@ TreeStream& TreeStreamRedirector::operator<<(Int_t id)
     }
   }
 
-  TDirectory* backup = gDirectory;
-  mDirectory->cd();
-  mDataLayouts.emplace_back(std::unique_ptr<TreeStream>(new TreeStream(Form("Tree%d", id))));
-  auto layout = mDataLayouts.back().get();
-  layout->setID(id);
-  if (backup) {
-    backup->cd();
-  }
-  return *layout;
+  return addDataLayout(Form("Tree%d", id), id);
 }
 
 //_________________________________________________
@@ -96,11 +175,28 @@ TreeStream& TreeStreamRedirector::operator<<(const char* name)
   }
 
   // create new
+  return addDataLayout(name, -1);
+}
+
+//_________________________________________________
+TreeStream& TreeStreamRedirector::addDataLayout(const char* name, int id)
+{
+  // create new data layout with its tree in the output directory
+
+  std::unique_lock<std::mutex> fileLock;
+  if (mAsync) {
+    fileLock = std::unique_lock<std::mutex>(mAsync->fileMutex);
+  }
   TDirectory* backup = gDirectory;
   mDirectory->cd();
   mDataLayouts.emplace_back(std::unique_ptr<TreeStream>(new TreeStream(name)));
   auto layout = mDataLayouts.back().get();
-  layout->setID(-1);
+  layout->setID(id);
+  layout->setSamplingFraction(mSamplingFraction);
+  if (mAsync) {
+    auto async = mAsync.get();
+    layout->setEntrySink([async, layout](TreeStream::Entry&& entry) { async->push(layout, std::move(entry)); });
+  }
   if (backup) {
     backup->cd();
   }
@@ -112,6 +208,10 @@ void TreeStreamRedirector::Close()
 {
   // flush and close
 
+  if (mAsync) {
+    mAsync->finish(); // all queued entries are filled
+    mAsync.reset();
+  }
   TDirectory* backup = gDirectory;
   mDirectory->cd();
   for (auto& layout : mDataLayouts) {
@@ -109,6 +109,69 @@ BOOST_AUTO_TEST_CASE(TreeStream_test)
   //
 }
 
+BOOST_AUTO_TEST_CASE(TreeStreamAsync_test)
+{
+  std::string outFName("testTreeStreamAsync.root");
+  int nit = 1000;
+  {
+    TreeStreamRedirector tstStream(outFName.data(), "recreate");
+    tstStream.setAsync(10); // small queue, such that the streaming has to wait for the writer
+    std::array<float, o2::track::kNParams> par{};
+    for (int i = 0; i < nit; i++) {
+      par[o2::track::kQ2Pt] = 0.5 + float(i) / nit;
+      float x = 10. + float(i) / nit * 200.;
+      o2::track::TrackPar trc(0., 0., par);
+      trc.propagateParamTo(x, 0.5);
+      // the track is a temporary, the entry must be serialized when streamed
+      tstStream << "TrackTree"
+                << "id=" << i << "x=" << x << "track=" << trc << "\n";
+    }
+    tstStream.Close();
+  }
+  {
+    TFile inpf(outFName.data());
+    BOOST_CHECK(!inpf.IsZombie());
+    auto tree = (TTree*)inpf.GetObjectChecked("TrackTree", "TTree");
+    BOOST_CHECK(tree);
+    BOOST_CHECK(tree->GetEntries() == nit);
+    int id;
+    float x;
+    o2::track::TrackPar* trc = nullptr;
+    BOOST_CHECK(!tree->SetBranchAddress("id", &id));
+    BOOST_CHECK(!tree->SetBranchAddress("x", &x));
+    BOOST_CHECK(!tree->SetBranchAddress("track", &trc));
+    for (int i = 0; i < tree->GetEntries(); i++) {
+      tree->GetEntry(i);
+      BOOST_CHECK(id == i);
+      BOOST_CHECK(std::abs(x - trc->getX()) < 1e-4);
+    }
+  }
+
+  LOG(INFO) << "Testing sampling of the entries";
+  {
+    TreeStreamRedirector tstStream(outFName.data(), "recreate");
+    tstStream.setSamplingFraction(0.1);
+    for (int i = 0; i < nit; i++) {
+      tstStream << "Sampled"
+                << "id=" << i << "\n";
+    }
+  }
+  {
+    TFile inpf(outFName.data());
+    auto tree = (TTree*)inpf.GetObjectChecked("Sampled", "TTree");
+    BOOST_CHECK(tree);
+    int nent = tree->GetEntries();
+    BOOST_CHECK(nent > 0.05 * nit && nent < 0.15 * nit);
+    int id, idPrev = -1;
+    BOOST_CHECK(!tree->SetBranchAddress("id", &id));
+    for (int i = 0; i < nent; i++) {
+      tree->GetEntry(i);
+      BOOST_CHECK(id > idPrev);
+      idPrev = id;
+    }
+  }
+}
+
 //_________________________________________________
 bool UnitTestSparse(Double_t scale, Int_t testEntries)
 {
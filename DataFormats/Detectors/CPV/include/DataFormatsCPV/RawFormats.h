@@ -38,7 +38,7 @@ class CpvWord
 {
  public:
   CpvWord() = default;
-  CpvWord(std::vector<char>::const_iterator b, std::vector<char>::const_iterator e)
+  CpvWord(const char* b, const char* e)
   { //Reading
     //resposibility of coller to esure that
     //array will not end while reading
@@ -70,7 +70,7 @@ class CpvHeader
 {
  public:
   CpvHeader() = default;
-  CpvHeader(std::vector<char>::const_iterator b, std::vector<char>::const_iterator e)
+  CpvHeader(const char* b, const char* e)
   {                                               //reading header from file
     for (int i = 0; i < 16 && b != e; i++, b++) { //read up to 16 mBytes
       mBytes[i] = *b;
@@ -112,7 +112,7 @@ class CpvTrailer
 {
  public:
   CpvTrailer() = default;
-  CpvTrailer(std::vector<char>::const_iterator b, std::vector<char>::const_iterator e)
+  CpvTrailer(const char* b, const char* e)
   {                                               //reading
     for (int i = 0; i < 16 && b != e; i++, b++) { //read up to 16 mBytes
       mBytes[i] = *b;
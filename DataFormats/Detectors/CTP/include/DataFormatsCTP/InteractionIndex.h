@@ -0,0 +1,110 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file InteractionIndex.h
+/// \brief Per-TF index of the interaction BCs seen by the CTP and FT0
+
+#ifndef _CTP_INTERACTIONINDEX_H_
+#define _CTP_INTERACTIONINDEX_H_
+
+#include "CommonDataFormat/InteractionRecord.h"
+#include <gsl/span>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace ctp
+{
+/// Interaction BC of the TF with the trigger information it was seen with
+struct InteractionIndexEntry {
+  enum Source : uint8_t { CTP = 0x1,
+                          FT0 = 0x2 };
+  o2::InteractionRecord intRecord;
+  uint64_t classMask = 0; /// CTP classes fired in this BC
+  uint64_t inputMask = 0; /// CTP inputs fired in this BC
+  int ft0RecPoint = -1;   /// index of the (selected) FT0 RecPoint of this BC, -1 if none
+  uint8_t sources = 0;    /// Source bits of the detectors which have seen this BC
+  bool hasSource(Source s) const { return sources & s; }
+  ClassDefNV(InteractionIndexEntry, 1);
+};
+
+/// Non-owning view of the interaction index of a TF: the entries sorted in BC and
+/// a table of the first entry of each bucket of 2^BucketShift BCs from the TF start,
+/// so that the entries compatible with a BC or a time interval are found in constant time.
+/// The entries and the bucket table are produced once per TF by the interaction index
+/// device, see fill(), and shipped as 2 messages.
+class InteractionIndex
+{
+ public:
+  static constexpr int BucketShift = 6; /// 64 BCs per bucket
+
+  InteractionIndex() = default;
+  InteractionIndex(gsl::span<const InteractionIndexEntry> entries, gsl::span<const int> buckets, const o2::InteractionRecord& startIR)
+    : mEntries(entries), mBuckets(buckets), mStartIR(startIR) {}
+
+  /// sorts the entries, merges those of the same BC and fills the bucket table for a TF of nOrbits from startIR
+  static void fill(std::vector<InteractionIndexEntry>& entries, std::vector<int>& buckets, const o2::InteractionRecord& startIR, int nOrbits);
+
+  size_t size() const { return mEntries.size(); }
+  const InteractionIndexEntry& operator[](int i) const { return mEntries[i]; }
+  gsl::span<const InteractionIndexEntry> getEntries() const { return mEntries; }
+  const o2::InteractionRecord& getStartIR() const { return mStartIR; }
+
+  /// index of the 1st entry with BC >= bc, where bc counts the BCs from the TF start; size() if there is none
+  int findFirst(int64_t bc) const
+  {
+    if (bc < 0) {
+      return 0;
+    }
+    int64_t b = bc >> BucketShift;
+    if (b >= int64_t(mBuckets.size()) - 1) {
+      return int(mEntries.size());
+    }
+    int i = mBuckets[b], iLast = mBuckets[b + 1];
+    while (i < iLast && mEntries[i].intRecord.differenceInBC(mStartIR) < bc) {
+      i++;
+    }
+    return i;
+  }
+  int findFirst(const o2::InteractionRecord& ir) const { return findFirst(ir.differenceInBC(mStartIR)); }
+
+  /// entry of the given BC, nullptr if there is none
+  const InteractionIndexEntry* find(const o2::InteractionRecord& ir) const
+  {
+    int i = findFirst(ir);
+    return (i < int(mEntries.size()) && mEntries[i].intRecord == ir) ? &mEntries[i] : nullptr;
+  }
+
+  /// range [first, last) of the entries with BC in [irMin, irMax]
+  std::pair<int, int> getRange(const o2::InteractionRecord& irMin, const o2::InteractionRecord& irMax) const
+  {
+    return {findFirst(irMin), findFirst(irMax.differenceInBC(mStartIR) + 1)};
+  }
+
+  /// range [first, last) of the entries with time in [tMin, tMax], in \mus from the TF start
+  std::pair<int, int> getRangeMUS(float tMin, float tMax) const
+  {
+    auto bcMin = int64_t(std::ceil(tMin / o2::constants::lhc::LHCBunchSpacingMUS));
+    auto bcMax = int64_t(std::floor(tMax / o2::constants::lhc::LHCBunchSpacingMUS));
+    return {findFirst(bcMin), findFirst(bcMax + 1)};
+  }
+
+ private:
+  gsl::span<const InteractionIndexEntry> mEntries;
+  gsl::span<const int> mBuckets;
+  o2::InteractionRecord mStartIR;
+};
+
+} // namespace ctp
+} // namespace o2
+#endif //_CTP_INTERACTIONINDEX_H_
@@ -18,6 +18,8 @@
 #pragma link C++ class vector < o2::ctp::CTPDigit> + ;
 #pragma link C++ class o2::ctp::CTPInputDigit + ;
 #pragma link C++ class vector < o2::ctp::CTPInputDigit> + ;
+#pragma link C++ class o2::ctp::InteractionIndexEntry + ;
+#pragma link C++ class vector < o2::ctp::InteractionIndexEntry> + ;
 #pragma link C++ class o2::ctp::BCMask + ;
 #pragma link C++ class vector < o2::ctp::BCMask> + ;
 #pragma link C++ class o2::ctp::CTPInput + ;
@@ -0,0 +1,56 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file InteractionIndex.cxx
+
+#include "DataFormatsCTP/InteractionIndex.h"
+#include <algorithm>
+
+using namespace o2::ctp;
+
+void InteractionIndex::fill(std::vector<InteractionIndexEntry>& entries, std::vector<int>& buckets, const o2::InteractionRecord& startIR, int nOrbits)
+{
+  // entries outside of the TF are dropped, those of the same BC are merged
+  const int64_t nBC = int64_t(nOrbits) * o2::constants::lhc::LHCMaxBunches;
+  entries.erase(std::remove_if(entries.begin(), entries.end(), [&startIR, nBC](const InteractionIndexEntry& e) {
+                  auto bc = e.intRecord.differenceInBC(startIR);
+                  return bc < 0 || bc >= nBC;
+                }),
+                entries.end());
+  std::stable_sort(entries.begin(), entries.end(), [](const InteractionIndexEntry& a, const InteractionIndexEntry& b) { return a.intRecord < b.intRecord; });
+  size_t nMerged = 0;
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (nMerged && entries[nMerged - 1].intRecord == entries[i].intRecord) {
+      auto& dest = entries[nMerged - 1];
+      dest.classMask |= entries[i].classMask;
+      dest.inputMask |= entries[i].inputMask;
+      dest.sources |= entries[i].sources;
+      if (dest.ft0RecPoint < 0) {
+        dest.ft0RecPoint = entries[i].ft0RecPoint;
+      }
+    } else {
+      entries[nMerged++] = entries[i];
+    }
+  }
+  entries.resize(nMerged);
+
+  // buckets[b] is the 1st entry with BC >= b * 2^BucketShift, the last one closes the table
+  int nBuckets = int((nBC + (1 << BucketShift) - 1) >> BucketShift);
+  buckets.resize(nBuckets + 1);
+  int ie = 0, ne = entries.size();
+  for (int b = 0; b <= nBuckets; b++) {
+    int64_t bcMin = int64_t(b) << BucketShift;
+    while (ie < ne && entries[ie].intRecord.differenceInBC(startIR) < bcMin) {
+      ie++;
+    }
+    buckets[b] = ie;
+  }
+}
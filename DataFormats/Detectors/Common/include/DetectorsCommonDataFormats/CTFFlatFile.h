@@ -0,0 +1,62 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CTFFlatFile.h
+/// \brief Layout of CTF files storing the flat EncodedBlocks buffers w/o ROOT streaming
+
+///  The file is a sequence of TF records. Every record starts with a FlatTFHeader, followed by a FlatDetHeader
+///  and the flat EncodedBlocks image for every detector present in the CTFHeader::detectors mask.
+///  All items start at the offset aligned to o2::ctf::Alignment, so that a buffer mapped at the page boundary
+///  can be used by EncodedBlocks::getImage directly.
+
+#ifndef ALICEO2_CTF_FLATFILE_H
+#define ALICEO2_CTF_FLATFILE_H
+
+#include <cstdint>
+#include <type_traits>
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+
+namespace o2
+{
+namespace ctf
+{
+
+struct FlatTFHeader {
+  static constexpr uint32_t MagicWord = 0x46544f32; // "2OTF"
+  static constexpr uint32_t CurrentVersion = 1;
+
+  uint32_t magic = MagicWord;
+  uint32_t version = CurrentVersion;
+  uint64_t size = 0;      // size in bytes of the whole TF record, including this header
+  uint32_t tfCounter = 0; // TF counter of the DataHeader of the CTF
+  uint32_t nDetectors = 0;
+  CTFHeader ctfHeader{};
+
+  bool isValid() const { return magic == MagicWord && version == CurrentVersion; }
+  static size_t getAlignedSize() { return alignSize(sizeof(FlatTFHeader)); }
+};
+
+struct FlatDetHeader {
+  uint32_t det = 0; // DetID of the detector
+  uint32_t reserved = 0;
+  uint64_t size = 0; // size in bytes of the flat EncodedBlocks image following the (aligned) header, w/o padding
+
+  static size_t getAlignedSize() { return alignSize(sizeof(FlatDetHeader)); }
+};
+
+static_assert(std::is_trivially_copyable_v<FlatTFHeader>);
+static_assert(std::is_trivially_copyable_v<FlatDetHeader>);
+
+} // namespace ctf
+} // namespace o2
+
+#endif
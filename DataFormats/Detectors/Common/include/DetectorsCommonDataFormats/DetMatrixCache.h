@@ -16,6 +16,7 @@
 #include "GPUCommonRtypes.h"
 
 #include <array>
+#include <string>
 #include <vector>
 
 #include "MathUtils/Cartesian.h"
@@ -63,6 +64,10 @@ class MatrixCache
   const T& getMatrix(int sensID) const { return mCache[sensID]; }
   bool isFilled() const { return !mCache.empty(); }
 
+  /// direct access to the matrices, for the bulk copies
+  const T* getData() const { return mCache.data(); }
+  T* getData() { return mCache.data(); }
+
  private:
   std::vector<T> mCache;
   ClassDefNV(MatrixCache, 1);
@@ -109,6 +114,16 @@ class DetMatrixCache
   // before calling fillMatrixCache, detector implementation should set the size of the matrix cache
   void setSize(int s);
 
+  // Node-local cache of the matrices, shared by the processes building the same geometry:
+  // if the environment variable O2_MATRIX_CACHE_DIR is set (e.g. to a directory in /dev/shm), the file
+  // <dir>/<detector>_matrices.bin stores the filled caches in a flat binary form. The user is responsible
+  // for using a directory per geometry / alignment.
+  // readMatrixCache fills from this file the caches of the mask which are not filled yet, returning true if
+  // all of them are filled afterwards; writeMatrixCache stores the filled caches, if some are missing on the file.
+  bool readMatrixCache(int mask);
+  void writeMatrixCache() const;
+  static std::string getMatrixCacheFileName(const char* detName);
+
   // acces to non-const caches for filling in the base classes only
   MatrixCache<Mat3D>& getCacheT2L() { return mT2L; }
   MatrixCache<Mat3D>& getCacheT2G() { return mT2G; }
@@ -95,6 +95,12 @@ struct ANSHeader {
   uint8_t majorVersion;
   uint8_t minorVersion;
 
+  /// number of rANS states interleaved in the entropy coded blocks:
+  /// up to version 0.x the coder used 2 states, starting from version 1.0 it uses 8
+  static constexpr size_t NInterleavedStreamsV0 = 2;
+  static constexpr size_t NInterleavedStreamsV1 = 8;
+  bool useWideInterleaving() const { return majorVersion >= 1; }
+
   void clear() { majorVersion = minorVersion = 0; }
   ClassDefNV(ANSHeader, 1);
 };
@@ -413,14 +419,46 @@ class EncodedBlocks
 
   /// encode vector src to bloc at provided slot
   template <typename VE, typename buffer_T>
-  inline void encode(const VE& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const void* encoderExt = nullptr)
+  inline void encode(const VE& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const void* encoderExt = nullptr, const rans::FrequencyTable* dictExt = nullptr)
   {
-    encode(std::begin(src), std::end(src), slot, symbolTablePrecision, opt, buffer, encoderExt);
+    encode(std::begin(src), std::end(src), slot, symbolTablePrecision, opt, buffer, encoderExt, dictExt);
   }
 
-  /// encode vector src to bloc at provided slot
+  /// encode vector src to bloc at provided slot.
+  /// If the external encoder was built from the dictExt, the latter is stored in the block, which then can be decoded w/o external decoder
   template <typename input_IT, typename buffer_T>
-  void encode(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const void* encoderExt = nullptr);
+  void encode(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const void* encoderExt = nullptr, const rans::FrequencyTable* dictExt = nullptr);
+
+  /// entropy-coded block kept outside of the flat container, see prepare / store
+  struct PreparedBlock {
+    Metadata md;
+    std::vector<W> dict;
+    std::vector<W> data;
+    std::vector<W> literals;
+    /// size in bytes this block will claim once stored in the container
+    size_t estimateStoredSize() const { return estimateBlockSize(dict.size()) + estimateBlockSize(data.size()) + estimateBlockSize(literals.size()); }
+  };
+
+  /// encode vector src to a standalone block which can be stored later by store()
+  template <typename VE>
+  static PreparedBlock prepare(const VE& src, uint8_t symbolTablePrecision, Metadata::OptStore opt, const ANSHeader& ansHeader, const void* encoderExt = nullptr, const rans::FrequencyTable* dictExt = nullptr)
+  {
+    return prepare(std::begin(src), std::end(src), symbolTablePrecision, opt, ansHeader, encoderExt, dictExt);
+  }
+
+  /// encode [srcBegin, srcEnd) to a standalone block which can be stored later by store().
+  /// No container is accessed, so the blocks of different slots can be prepared concurrently.
+  template <typename input_IT>
+  static PreparedBlock prepare(const input_IT srcBegin, const input_IT srcEnd, uint8_t symbolTablePrecision, Metadata::OptStore opt, const ANSHeader& ansHeader, const void* encoderExt = nullptr, const rans::FrequencyTable* dictExt = nullptr);
+
+  /// store the prepared block to the provided slot. Slots must be filled in increasing order, as for encode
+  template <typename buffer_T>
+  void store(const PreparedBlock& block, int slot, buffer_T* buffer = nullptr);
+
+  /// store the prepared blocks to the consecutive slots starting from the 1st unfilled one, expanding the storage at most once.
+  /// Note: "this" might be invalid after the call if the buffer was expanded, use get(buffer->data())
+  template <typename buffer_T>
+  void store(const std::vector<PreparedBlock>& blocks, buffer_T* buffer = nullptr);
 
   /// decode block at provided slot to destination vector (will be resized as needed)
   template <class container_T, class container_IT = typename container_T::iterator>
@@ -482,7 +520,7 @@ void EncodedBlocks<H, N, W>::readFromTree(TTree& tree, const std::string& name,
 {
   readTreeBranch(tree, o2::utils::Str::concat_string(name, "_wrapper."), *this, ev);
   for (int i = 0; i < N; i++) {
-    readTreeBranch(tree, o2::utils::Str::concat_string(name, "_block.", std::to_string(i), "."), mBlocks[i]);
+    readTreeBranch(tree, o2::utils::Str::concat_string(name, "_block.", std::to_string(i), "."), mBlocks[i], ev);
   }
 }
 
@@ -497,7 +535,7 @@ void EncodedBlocks<H, N, W>::readFromTree(VD& vec, TTree& tree, const std::strin
   tmp = tmp->expand(vec, tmp->estimateSizeFromMetadata());
   for (int i = 0; i < N; i++) {
     Block<W> bl;
-    readTreeBranch(tree, o2::utils::Str::concat_string(name, "_block.", std::to_string(i), "."), bl);
+    readTreeBranch(tree, o2::utils::Str::concat_string(name, "_block.", std::to_string(i), "."), bl, ev);
     tmp->mBlocks[i].store(bl.getNDict(), bl.getNData(), bl.getNLiterals(), bl.getDict(), bl.getData(), bl.getLiterals());
   }
 }
@@ -761,11 +799,15 @@ void EncodedBlocks<H, N, W>::decode(D_IT dest,                    // iterator to
         // to D-word array
         literals = std::vector<dest_t>{reinterpret_cast<const dest_t*>(block.getLiterals()), reinterpret_cast<const dest_t*>(block.getLiterals()) + md.nLiterals};
       }
-      decoder->process(block.getData() + block.getNData(), dest, md.messageLength, literals);
+      if (mANSHeader.useWideInterleaving()) {
+        decoder->template process<ANSHeader::NInterleavedStreamsV1>(block.getData() + block.getNData(), dest, md.messageLength, literals);
+      } else {
+        decoder->template process<ANSHeader::NInterleavedStreamsV0>(block.getData() + block.getNData(), dest, md.messageLength, literals);
+      }
     } else { // data was stored as is
       using destPtr_t = typename std::iterator_traits<D_IT>::pointer;
       destPtr_t srcBegin = reinterpret_cast<destPtr_t>(block.payload);
-      destPtr_t srcEnd = srcBegin + md.messageLength * sizeof(dest_t);
+      destPtr_t srcEnd = srcBegin + md.messageLength;
       std::copy(srcBegin, srcEnd, dest);
       //std::memcpy(dest, block.payload, md.messageLength * sizeof(dest_t));
     }
@@ -781,7 +823,8 @@ void EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,      // iterator be
                                     uint8_t symbolTablePrecision, // encoding into
                                     Metadata::OptStore opt,       // option for data compression
                                     buffer_T* buffer,             // optional buffer (vector) providing memory for encoded blocks
-                                    const void* encoderExt)       // optional external encoder
+                                    const void* encoderExt,       // optional external encoder
+                                    const rans::FrequencyTable* dictExt) // optional dictionary of external encoder to store
 {
 
   using storageBuffer_t = W;
@@ -797,6 +840,8 @@ void EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,      // iterator be
   // fill a new block
   assert(slot == mRegistry.nFilledBlocks);
   mRegistry.nFilledBlocks++;
+  // the header version defines how many rANS states are interleaved. Note: "this" might be invalid after expandStorage call!
+  const bool wideInterleaving = mANSHeader.useWideInterleaving();
 
   const size_t messageLength = std::distance(srcBegin, srcEnd);
   // cover three cases:
@@ -837,7 +882,7 @@ void EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,      // iterator be
 
     const auto [inplaceEncoder, frequencyTable] = [&]() {
       if (encoderExt) {
-        return std::make_tuple(ransEncoder_t{}, rans::FrequencyTable{});
+        return std::make_tuple(ransEncoder_t{}, dictExt ? *dictExt : rans::FrequencyTable{});
       } else {
         rans::FrequencyTable frequencyTable{};
         frequencyTable.addSamples(srcBegin, srcEnd);
@@ -860,7 +905,8 @@ void EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,      // iterator be
     // directly encode source message into block buffer.
     storageBuffer_t* const blockBufferBegin = thisBlock->getCreateData();
     const size_t maxBufferSize = thisBlock->registry->getFreeSize(); // note: "this" might be not valid after expandStorage call!!!
-    const auto encodedMessageEnd = encoder->process(srcBegin, srcEnd, blockBufferBegin, literals);
+    const auto encodedMessageEnd = wideInterleaving ? encoder->template process<ANSHeader::NInterleavedStreamsV1>(srcBegin, srcEnd, blockBufferBegin, literals)
+                                                    : encoder->template process<ANSHeader::NInterleavedStreamsV0>(srcBegin, srcEnd, blockBufferBegin, literals);
     rans::utils::checkBounds(encodedMessageEnd, blockBufferBegin + maxBufferSize);
     dataSize = encodedMessageEnd - thisBlock->getData();
     thisBlock->setNData(dataSize);
@@ -904,12 +950,162 @@ void EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,      // iterator be
 
     const size_t nBufferElems = calculateNDestTElements<input_t, storageBuffer_t>(messageLength);
     expandStorage(nBufferElems);
-    thisBlock->storeData(thisMetadata->nDataWords, reinterpret_cast<const storageBuffer_t*>(tmp.data()));
+    thisBlock->storeData(nBufferElems, reinterpret_cast<const storageBuffer_t*>(tmp.data()));
 
     *thisMetadata = Metadata{messageLength, 0, sizeof(ransState_t), sizeof(storageBuffer_t), symbolTablePrecision, opt, 0, 0, 0, static_cast<int>(nBufferElems), 0};
   }
 }
 
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename input_IT>
+typename EncodedBlocks<H, N, W>::PreparedBlock EncodedBlocks<H, N, W>::prepare(const input_IT srcBegin,      // iterator begin of source message
+                                                                               const input_IT srcEnd,        // iterator end of source message
+                                                                               uint8_t symbolTablePrecision, // encoding into
+                                                                               Metadata::OptStore opt,       // option for data compression
+                                                                               const ANSHeader& ansHeader,   // header of the container the block will be stored to
+                                                                               const void* encoderExt,       // optional external encoder
+                                                                               const rans::FrequencyTable* dictExt) // optional dictionary of external encoder to store
+{
+  using storageBuffer_t = W;
+  using input_t = typename std::iterator_traits<input_IT>::value_type;
+  using ransEncoder_t = typename rans::LiteralEncoder64<input_t>;
+  using ransState_t = typename ransEncoder_t::coder_t;
+  using ransStream_t = typename ransEncoder_t::stream_t;
+
+  static_assert(std::is_same_v<storageBuffer_t, ransStream_t>);
+  static_assert(std::is_same_v<storageBuffer_t, typename rans::FrequencyTable::count_t>);
+
+  PreparedBlock block;
+  const size_t messageLength = std::distance(srcBegin, srcEnd);
+
+  // case 1: empty source message
+  if (messageLength == 0) {
+    block.md = Metadata{0, 0, sizeof(ransState_t), sizeof(ransStream_t), symbolTablePrecision, Metadata::OptStore::NODATA, 0, 0, 0, 0, 0};
+    return block;
+  }
+
+  // case 3: message where entropy coding should be applied
+  if (opt == Metadata::OptStore::EENCODE) {
+    constexpr size_t SizeEstMarginAbs = 10 * 1024;
+    constexpr float SizeEstMarginRel = 1.05;
+
+    const auto [inplaceEncoder, frequencyTable] = [&]() {
+      if (encoderExt) {
+        return std::make_tuple(ransEncoder_t{}, dictExt ? *dictExt : rans::FrequencyTable{});
+      } else {
+        rans::FrequencyTable frequencyTable{};
+        frequencyTable.addSamples(srcBegin, srcEnd);
+        return std::make_tuple(ransEncoder_t{frequencyTable, symbolTablePrecision}, frequencyTable);
+      }
+    }();
+    ransEncoder_t const* const encoder = encoderExt ? reinterpret_cast<ransEncoder_t const* const>(encoderExt) : &inplaceEncoder;
+
+    if (frequencyTable.size()) {
+      block.dict.assign(frequencyTable.data(), frequencyTable.data() + frequencyTable.size());
+    }
+    // same estimate of the encode buffer as for the in-place encoding, but the buffer is private to this block
+    int dataSize = rans::calculateMaxBufferSize(messageLength, encoder->getAlphabetRangeBits(), sizeof(input_t)); // size in bytes
+    dataSize = SizeEstMarginAbs + int(SizeEstMarginRel * (dataSize / sizeof(storageBuffer_t))) + (sizeof(input_t) < sizeof(storageBuffer_t)); // size in words of output stream
+    block.data.resize(dataSize);
+    std::vector<input_t> literals;
+    storageBuffer_t* const blockBufferBegin = block.data.data();
+    const auto encodedMessageEnd = ansHeader.useWideInterleaving() ? encoder->template process<ANSHeader::NInterleavedStreamsV1>(srcBegin, srcEnd, blockBufferBegin, literals)
+                                                                   : encoder->template process<ANSHeader::NInterleavedStreamsV0>(srcBegin, srcEnd, blockBufferBegin, literals);
+    rans::utils::checkBounds(encodedMessageEnd, blockBufferBegin + block.data.size());
+    dataSize = encodedMessageEnd - blockBufferBegin;
+    block.data.resize(dataSize);
+
+    // store incompressible symbols if any
+    const size_t nLiteralSymbols = literals.size();
+    if (!literals.empty()) {
+      // introduce padding in case literals don't align;
+      literals.resize(calculatePaddedSize<input_t, storageBuffer_t>(nLiteralSymbols), {});
+      const size_t nLiteralStorageElems = calculateNDestTElements<input_t, storageBuffer_t>(nLiteralSymbols);
+      block.literals.resize(nLiteralStorageElems);
+      memcpy(block.literals.data(), literals.data(), nLiteralStorageElems * sizeof(storageBuffer_t));
+    }
+
+    block.md = Metadata{messageLength,
+                        nLiteralSymbols,
+                        sizeof(ransState_t),
+                        sizeof(ransStream_t),
+                        static_cast<uint8_t>(encoder->getSymbolTablePrecision()),
+                        opt,
+                        encoder->getMinSymbol(),
+                        encoder->getMaxSymbol(),
+                        static_cast<int32_t>(frequencyTable.size()),
+                        dataSize,
+                        static_cast<int32_t>(literals.size())};
+  } else { // store original data w/o EEncoding
+    const size_t nSourceElemsPadded = calculatePaddedSize<input_t, storageBuffer_t>(messageLength);
+    std::vector<input_t> tmp(nSourceElemsPadded, {});
+    std::copy(srcBegin, srcEnd, std::begin(tmp));
+
+    const size_t nBufferElems = calculateNDestTElements<input_t, storageBuffer_t>(messageLength);
+    block.data.resize(nBufferElems);
+    memcpy(block.data.data(), tmp.data(), nBufferElems * sizeof(storageBuffer_t));
+
+    block.md = Metadata{messageLength, 0, sizeof(ransState_t), sizeof(storageBuffer_t), symbolTablePrecision, opt, 0, 0, 0, static_cast<int>(nBufferElems), 0};
+  }
+  return block;
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename buffer_T>
+void EncodedBlocks<H, N, W>::store(const PreparedBlock& block, int slot, buffer_T* buffer)
+{
+  assert(slot == mRegistry.nFilledBlocks);
+  mRegistry.nFilledBlocks++;
+  auto* thisBlock = &mBlocks[slot];
+  auto* thisMetadata = &mMetadata[slot];
+  if (block.md.opt != Metadata::OptStore::NODATA) {
+    const size_t additionalSize = block.estimateStoredSize();
+    if (additionalSize >= getFreeSize()) {
+      LOG(INFO) << "Slot " << slot << ": free size: " << getFreeSize() << ", need " << additionalSize << " bytes";
+      if (!buffer) {
+        throw std::runtime_error("no room for encoded block in provided container");
+      }
+      auto* newHead = expand(*buffer, size() + (additionalSize - getFreeSize()));
+      thisMetadata = &(newHead->mMetadata[slot]);
+      thisBlock = &(newHead->mBlocks[slot]); // in case of resizing this and any this.xxx becomes invalid
+    }
+    if (!block.dict.empty()) {
+      thisBlock->storeDict(block.dict.size(), block.dict.data());
+    }
+    if (!block.data.empty()) {
+      thisBlock->storeData(block.data.size(), block.data.data());
+    }
+    if (!block.literals.empty()) {
+      thisBlock->storeLiterals(block.literals.size(), block.literals.data());
+    }
+  }
+  *thisMetadata = block.md;
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename buffer_T>
+void EncodedBlocks<H, N, W>::store(const std::vector<PreparedBlock>& blocks, buffer_T* buffer)
+{
+  assert(mRegistry.nFilledBlocks + blocks.size() <= N);
+  size_t additionalSize = 0;
+  for (const auto& block : blocks) {
+    additionalSize += block.estimateStoredSize();
+  }
+  auto* head = this;
+  if (additionalSize >= getFreeSize()) {
+    if (!buffer) {
+      throw std::runtime_error("no room for encoded blocks in provided container");
+    }
+    head = expand(*buffer, size() + (additionalSize - getFreeSize())); // "this" is invalid from here on
+  }
+  for (const auto& block : blocks) {
+    head->store(block, head->mRegistry.nFilledBlocks, buffer);
+  }
+}
+
 /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
 template <typename H, int N, typename W>
 std::vector<char> EncodedBlocks<H, N, W>::createDictionaryBlocks(const std::vector<o2::rans::FrequencyTable>& vfreq, const std::vector<Metadata>& vmd)
@@ -55,6 +55,12 @@ class NameConf : public o2::conf::ConfigurableParamHelper<NameConf>
     return o2::utils::Str::concat_string(prefix, "_", KINE_STRING, ".root");
   }
 
+  // Filename of the flat, indexed copy of the kinematics (memory-mapped by the MCKinematicsReader)
+  static std::string getMCKinematicsIndexFileName(const std::string_view prefix = STANDARDSIMPREFIX)
+  {
+    return o2::utils::Str::concat_string(prefix, "_", KINE_STRING, ".idx");
+  }
+
   // Filename to store kinematics + TrackRefs
   static std::string getMCHeadersFileName(const std::string_view prefix = STANDARDSIMPREFIX)
   {
@@ -101,7 +107,7 @@ class NameConf : public o2::conf::ConfigurableParamHelper<NameConf>
   static constexpr std::string_view CTFTREENAME = "ctf"; // hardcoded
 
   // CTF Filename
-  static std::string getCTFFileName(uint32_t run, uint32_t orb, uint32_t id, const std::string_view prefix = "o2_ctf");
+  static std::string getCTFFileName(uint32_t run, uint32_t orb, uint32_t id, const std::string_view prefix = "o2_ctf", const std::string_view ext = ".root");
 
   // CTF Dictionary
   static std::string getCTFDictFileName();
@@ -12,6 +12,10 @@
 #include "DetectorsCommonDataFormats/DetMatrixCache.h"
 #include <TGeoMatrix.h>
 #include "MathUtils/Utils.h"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <unistd.h>
 
 using namespace o2::detectors;
 
@@ -29,6 +33,137 @@ void DetMatrixCache::setSize(int s)
   mSize = s;
 }
 
+namespace
+{
+// header of the matrix cache file, followed by the matrices of every cache of the mask,
+// in the order of TransformType
+struct MatrixCacheFileHeader {
+  static constexpr uint32_t MAGIC = 0x4d434831; // MCH1
+  uint32_t magic = MAGIC;
+  int32_t detID = -1;
+  int32_t size = 0;
+  int32_t mask = 0;
+  uint32_t sizeMat3D = sizeof(DetMatrixCache::Mat3D);
+  uint32_t sizeRot2D = sizeof(DetMatrixCache::Rot2D);
+};
+
+template <typename C>
+size_t cacheBytes(const C& cache, int size)
+{
+  return size * sizeof(*cache.getData());
+}
+} // namespace
+
+//_______________________________________________________
+std::string DetMatrixCache::getMatrixCacheFileName(const char* detName)
+{
+  auto dir = std::getenv("O2_MATRIX_CACHE_DIR");
+  if (!dir || !dir[0]) {
+    return "";
+  }
+  return std::string(dir) + "/" + detName + "_matrices.bin";
+}
+
+//_______________________________________________________
+bool DetMatrixCache::readMatrixCache(int mask)
+{
+  using namespace o2::math_utils;
+  auto fileName = getMatrixCacheFileName(getName());
+  if (fileName.empty() || mSize < 1) {
+    return false;
+  }
+  FILE* fp = fopen(fileName.c_str(), "rb");
+  if (!fp) {
+    return false;
+  }
+  MatrixCacheFileHeader ref, header;
+  ref.detID = mDetID;
+  ref.size = mSize;
+  bool ok = fread(&header, sizeof(header), 1, fp) == 1 && header.magic == ref.magic && header.detID == ref.detID &&
+            header.size == ref.size && header.sizeMat3D == ref.sizeMat3D && header.sizeRot2D == ref.sizeRot2D;
+  int nRead = 0;
+  auto readCache = [&](auto& cache, int type) {
+    if (!ok || !(header.mask & bit2Mask(type))) {
+      return;
+    }
+    if (!(mask & bit2Mask(type)) || cache.isFilled()) { // stored but not needed
+      ok = fseek(fp, cacheBytes(cache, mSize), SEEK_CUR) == 0;
+      return;
+    }
+    cache.setSize(mSize);
+    if (!(ok = fread(cache.getData(), cacheBytes(cache, mSize), 1, fp) == 1)) {
+      LOG(ERROR) << "Failed to read the " << getName() << " matrix cache from " << fileName;
+      return;
+    }
+    nRead++;
+  };
+  readCache(mL2G, TransformType::L2G);
+  readCache(mT2L, TransformType::T2L);
+  readCache(mT2G, TransformType::T2G);
+  readCache(mT2GRot, TransformType::T2GRot);
+  fclose(fp);
+  if (nRead) {
+    LOG(INFO) << "Loaded " << nRead << " " << getName() << " matrix caches from " << fileName;
+  }
+  return ok && ((mask & bit2Mask(TransformType::L2G)) == 0 || mL2G.isFilled()) &&
+         ((mask & bit2Mask(TransformType::T2L)) == 0 || mT2L.isFilled()) &&
+         ((mask & bit2Mask(TransformType::T2G)) == 0 || mT2G.isFilled()) &&
+         ((mask & bit2Mask(TransformType::T2GRot)) == 0 || mT2GRot.isFilled());
+}
+
+//_______________________________________________________
+void DetMatrixCache::writeMatrixCache() const
+{
+  using namespace o2::math_utils;
+  auto fileName = getMatrixCacheFileName(getName());
+  if (fileName.empty() || mSize < 1) {
+    return;
+  }
+  MatrixCacheFileHeader header;
+  header.detID = mDetID;
+  header.size = mSize;
+  header.mask = (mL2G.isFilled() ? bit2Mask(TransformType::L2G) : 0) | (mT2L.isFilled() ? bit2Mask(TransformType::T2L) : 0) |
+                (mT2G.isFilled() ? bit2Mask(TransformType::T2G) : 0) | (mT2GRot.isFilled() ? bit2Mask(TransformType::T2GRot) : 0);
+  if (FILE* fp = fopen(fileName.c_str(), "rb")) { // don't rewrite if nothing would be added
+    MatrixCacheFileHeader stored;
+    bool complete = fread(&stored, sizeof(stored), 1, fp) == 1 && stored.magic == header.magic && stored.detID == header.detID && stored.size == header.size &&
+                    (stored.mask & header.mask) == header.mask;
+    fclose(fp);
+    if (complete) {
+      return;
+    }
+  }
+  // write to a temporary file renamed at the end, so that concurrent readers never see a partial file
+  auto tmpName = fileName + ".tmp" + std::to_string(getpid());
+  FILE* fp = fopen(tmpName.c_str(), "wb");
+  if (!fp) {
+    LOG(WARNING) << "Failed to create the matrix cache file " << tmpName;
+    return;
+  }
+  bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+  auto writeCache = [&](const auto& cache) {
+    if (ok && cache.isFilled()) {
+      ok = fwrite(cache.getData(), cacheBytes(cache, mSize), 1, fp) == 1;
+    }
+  };
+  writeCache(mL2G);
+  writeCache(mT2L);
+  writeCache(mT2G);
+  writeCache(mT2GRot);
+  ok = (fclose(fp) == 0) && ok;
+  std::error_code ec;
+  if (ok) {
+    std::filesystem::rename(tmpName, fileName, ec);
+  }
+  if (!ok || ec) {
+    LOG(WARNING) << "Failed to write the " << getName() << " matrix cache to " << fileName;
+    std::filesystem::remove(tmpName, ec);
+    return;
+  }
+  LOG(INFO) << "Stored " << getName() << " matrix caches in " << fileName;
+}
+
+//_______________________________________________________
 void DetMatrixCacheIndirect::setSize(int size, int sizeIndirect)
 {
   // set the size of the matrix cache, can be done only once
@@ -27,6 +27,9 @@
 #include "SimulationDataFormat/ConstMCTruthContainer.h"
 #include <gsl/span>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 // We forward declare the internal structures, to reduce header dependencies.
 // Please include headers for TPC Hits or TRD tracklets directly (DataFormatsTPC/WorkflowHelper.h / DataFormatsTRD/RecoInputContainer.h)
@@ -158,6 +161,10 @@ struct DataRequest {
 // Note that random access like getITSTracks()[i] has an overhead, since for every call a span is created.
 // Therefore, for the random access better to use direct getter, i.e. auto& tr = getITSTrack(gid)
 // while for looping over the whole span first create a span then iterate over it.
+// The inputs which need a deserialization (MC truth of ITS and TOF clusters) are fetched only on the
+// first call of their getter, hence the getters may be called only while the ProcessingContext passed
+// to collectData is valid, i.e. in the run method of the device.
+// Structures derived from the inputs can be built once per TF and shared by all consumers via getDerived.
 
 struct RecoContainer {
   RecoContainer();
@@ -213,8 +220,8 @@ struct RecoContainer {
   SVertexAccessor svtxPool; // containers for secondary vertex related objects
   CosmicsAccessor cosmPool; // containers for cosmics track data
 
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcITSClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcTOFClusters;
+  mutable std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcITSClusters; // loaded on 1st request
+  mutable std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcTOFClusters; // loaded on 1st request
 
   gsl::span<const unsigned char> clusterShMapTPC; ///< externally set TPC clusters sharing map
 
@@ -341,7 +348,7 @@ struct RecoContainer {
   auto getITSClustersROFRecords() const { return getSpan<o2::itsmft::ROFRecord>(GTrackID::ITS, CLUSREFS); }
   auto getITSClusters() const { return getSpan<o2::itsmft::CompClusterExt>(GTrackID::ITS, CLUSTERS); }
   auto getITSClustersPatterns() const { return getSpan<unsigned char>(GTrackID::ITS, PATTERNS); }
-  auto getITSClustersMCLabels() const { return mcITSClusters.get(); }
+  const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* getITSClustersMCLabels() const;
 
   // MFT
   const o2::mft::TrackMFT& getMFTTrack(GTrackID gid) const { return getTrack<o2::mft::TrackMFT>(gid); }
@@ -431,7 +438,7 @@ struct RecoContainer {
 
   // TOF clusters
   auto getTOFClusters() const { return getSpan<o2::tof::Cluster>(GTrackID::TOF, CLUSTERS); }
-  auto getTOFClustersMCLabels() const { return mcTOFClusters.get(); }
+  const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* getTOFClustersMCLabels() const;
 
   // FT0
   auto getFT0RecPoints() const { return getSpan<o2::ft0::RecPoints>(GTrackID::FT0, TRACKS); }
@@ -462,6 +469,30 @@ struct RecoContainer {
 
   // IRFrames where ITS was reconstructed and tracks were seen (e.g. sync.w-flow mult. selection)
   auto getIRFramesITS() const { return getSpan<o2::dataformats::IRFrame>(GTrackID::ITS, VARIA); }
+
+  // Structure derived from the inputs, e.g. clusters per ROF or track time brackets, identified by its name:
+  // the 1st caller builds it with builder(T&), the following ones get the same object for the rest of the TF
+  template <typename T, typename F>
+  const T& getDerived(const std::string& name, F&& builder) const
+  {
+    std::lock_guard<std::mutex> lock(mDerivedMutex);
+    auto& obj = mDerived[name];
+    if (!obj) {
+      auto newObj = std::make_shared<T>();
+      builder(*newObj);
+      obj = newObj;
+    }
+    return *static_cast<const T*>(obj.get());
+  }
+
+ private:
+  o2::framework::ProcessingContext* mPC = nullptr; // context of the TF, for the inputs loaded on request
+  bool mITSClustersMCRequested = false;
+  bool mTOFClustersMCRequested = false;
+  mutable std::once_flag mITSClustersMCLoaded;
+  mutable std::once_flag mTOFClustersMCLoaded;
+  mutable std::mutex mDerivedMutex;
+  mutable std::unordered_map<std::string, std::shared_ptr<void>> mDerived;
 };
 
 } // namespace globaltracking
@@ -291,6 +291,7 @@ void RecoContainer::collectData(ProcessingContext& pc, const DataRequest& reques
 
   const auto* dh = o2::header::get<o2::header::DataHeader*>(pc.inputs().getFirstValid(true).header);
   startIR = {0, dh->firstTForbit};
+  mPC = &pc;
 
   auto req = reqMap.find("trackITS");
   if (req != reqMap.end()) {
@@ -519,9 +520,7 @@ void RecoContainer::addITSClusters(ProcessingContext& pc, bool mc)
   commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::ROFRecord>>("clusITSROF"), CLUSREFS);
   commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("clusITS"), CLUSTERS);
   commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<unsigned char>>("clusITSPatt"), PATTERNS);
-  if (mc) {
-    mcITSClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("clusITSMC");
-  }
+  mITSClustersMCRequested = mc; // deserialized on request, see getITSClustersMCLabels
 }
 
 //__________________________________________________________
@@ -543,9 +542,7 @@ void RecoContainer::addTRDTracklets(ProcessingContext& pc)
 void RecoContainer::addTOFClusters(ProcessingContext& pc, bool mc)
 {
   commonPool[GTrackID::TOF].registerContainer(pc.inputs().get<gsl::span<o2::tof::Cluster>>("tofcluster"), CLUSTERS);
-  if (mc) {
-    mcTOFClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("tofclusterlabel");
-  }
+  mTOFClustersMCRequested = mc; // deserialized on request, see getTOFClustersMCLabels
 }
 
 //__________________________________________________________
@@ -559,6 +556,26 @@ void RecoContainer::addFT0RecPoints(ProcessingContext& pc, bool mc)
   }
 }
 
+const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* RecoContainer::getITSClustersMCLabels() const
+{
+  std::call_once(mITSClustersMCLoaded, [this]() {
+    if (mITSClustersMCRequested) {
+      mcITSClusters = mPC->inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("clusITSMC");
+    }
+  });
+  return mcITSClusters.get();
+}
+
+const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* RecoContainer::getTOFClustersMCLabels() const
+{
+  std::call_once(mTOFClustersMCLoaded, [this]() {
+    if (mTOFClustersMCRequested) {
+      mcTOFClusters = mPC->inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("tofclusterlabel");
+    }
+  });
+  return mcTOFClusters.get();
+}
+
 const o2::tpc::ClusterNativeAccess& RecoContainer::getTPCClusters() const
 {
   return inputsTPCclusters->clusterIndex;
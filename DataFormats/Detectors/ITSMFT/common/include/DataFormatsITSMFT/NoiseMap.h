@@ -19,6 +19,8 @@
 #include <climits>
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <cstdint>
 
 #include "gsl/span"
 
@@ -51,10 +53,13 @@ class NoiseMap
   /// Destructor
   ~NoiseMap() = default;
 
+  /// Key of a pixel for increaseNoiseCounts
+  static uint64_t getKey(int chip, int row, int col) { return (uint64_t(chip) << ChipShift) | uint64_t(row * 1024 + col); }
+
   /// Get the noise level for this pixels
   float getNoiseLevel(int chip, int row, int col) const
   {
-    if (chip > mNoisyPixels.size()) {
+    if (chip >= mNoisyPixels.size()) {
       return 0;
     }
     auto key = row * 1024 + col;
@@ -67,13 +72,18 @@ class NoiseMap
 
   void increaseNoiseCount(int chip, int row, int col)
   {
-    if (chip > mNoisyPixels.size()) {
+    if (chip >= mNoisyPixels.size()) {
       return;
     }
     auto key = row * 1024 + col;
     mNoisyPixels[chip][key]++;
+    mMaskChipStart.clear();
   }
 
+  /// Increase the counts of the pixels fired in a bunch of strobes, given as sorted getKey() keys:
+  /// the map of a pixel is updated once with the number of its repetitions
+  void increaseNoiseCounts(gsl::span<const uint64_t> sortedKeys);
+
   int dumpAboveThreshold(int t = 3) const
   {
     int n = 0;
@@ -113,16 +123,24 @@ class NoiseMap
         }
       }
     }
+    buildMask();
   }
   float getProbThreshold() const { return mProbThreshold; }
   long int getNumOfStrobes() const { return mNumOfStrobes; }
 
+  /// Build the compact mask used by isNoisy from the current maps, it is dropped when the counts are modified
+  void buildMask();
+
   bool isNoisy(int chip, int row, int col) const
   {
-    if (chip > mNoisyPixels.size()) {
+    if (chip >= mNoisyPixels.size()) {
       return false;
     }
     auto key = row * 1024 + col;
+    if (!mMaskChipStart.empty()) {
+      auto first = mMaskKeys.begin() + mMaskChipStart[chip], last = mMaskKeys.begin() + mMaskChipStart[chip + 1];
+      return first != last && std::binary_search(first, last, key);
+    }
     const auto keyIt = mNoisyPixels[chip].find(key);
     if (keyIt != mNoisyPixels[chip].end()) {
       return true;
@@ -136,9 +154,14 @@ class NoiseMap
   void merge(const NoiseMap* prev) {}
 
  private:
+  static constexpr int ChipShift = 20;
+  static constexpr uint64_t PixelMask = (uint64_t(1) << ChipShift) - 1;
+
   std::vector<std::map<int, int>> mNoisyPixels; ///< Internal noise map representation
   long int mNumOfStrobes = 0;                   ///< Accumulated number of ALPIDE strobes
   float mProbThreshold = 0;                     ///< Probability threshold for noisy pixels
+  std::vector<int> mMaskKeys;                   //! sorted keys of the noisy pixels of all chips
+  std::vector<int> mMaskChipStart;              //! first entry of each chip in mMaskKeys, nchips + 1 entries
 
   ClassDefNV(NoiseMap, 2);
 };
@@ -31,6 +31,7 @@
 #define ALICEO2_ITSMFT_TOPOLOGYDICTIONARY_H
 #include "DataFormatsITSMFT/ClusterPattern.h"
 #include "Framework/Logger.h"
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <unordered_map>
@@ -64,6 +65,17 @@ struct GroupStruct {
   ClassDefNV(GroupStruct, 3);
 };
 
+/// Parameters of a topology needed for the conversion of the compact clusters to space points,
+/// stored contiguously by ID to have them with a single access per cluster
+struct ClusterParams {
+  float mXCOG;   ///< x position of the COG wrt the bottom left corner of the bounding box
+  float mZCOG;   ///< z position of the COG wrt the bottom left corner of the bounding box
+  float mErr2X;  ///< Squared error associated to the hit point in the x direction
+  float mErr2Z;  ///< Squared error associated to the hit point in the z direction
+  bool mIsGroup; ///< false: common topology; true: group of rare topologies
+  ClassDefNV(ClusterParams, 1);
+};
+
 class TopologyDictionary
 {
  public:
@@ -81,6 +93,11 @@ class TopologyDictionary
   static constexpr int NumberOfRareGroups = MaxNumberOfRowClasses * MaxNumberOfColClasses;          ///< Number of entries corresponding to groups of rare topologies (those whos matrix exceed the max number of bytes are empty).
   /// Prints the dictionary
   friend std::ostream& operator<<(std::ostream& os, const TopologyDictionary& dictionary);
+  /// Magic word and version of the binary file format; files w/o the header are read in the legacy format
+  static constexpr uint64_t BinaryFileMagic = 0x5444434944504f54UL; ///< "TOPDICDT"
+  static constexpr uint32_t BinaryFileVersion = 1;
+  /// Size of the entry of a topology in the binary file
+  static constexpr size_t BinaryEntrySize = sizeof(unsigned long) + 6 * sizeof(float) + sizeof(int) + sizeof(double) + sizeof(bool) + ClusterPattern::kExtendedPatternBytes;
   /// Prints the dictionary in a binary file
   void writeBinaryFile(std::string outputFile);
   /// Reads the dictionary from a binary file
@@ -151,6 +168,28 @@ class TopologyDictionary
     assert(n >= 0 || n < (int)mVectorOfIDs.size());
     return mVectorOfIDs[n].mPattern;
   }
+  /// Returns the position of the common topology with given complete hash or -1 if it is not in the dictionary
+  inline int getCommonTopologyID(unsigned long hash) const
+  {
+    if (mPerfectHashKeys.empty()) { // perfect hash is not available
+      auto ret = mCommonMap.find(hash);
+      return ret != mCommonMap.end() ? ret->second : -1;
+    }
+    uint32_t bucket = mixHash(hash, 0) % uint32_t(mPerfectHashDisp.size());
+    uint32_t slot = mixHash(hash, mPerfectHashDisp[bucket]) % uint32_t(mPerfectHashKeys.size());
+    return mPerfectHashKeys[slot] == hash ? mPerfectHashIDs[slot] : -1;
+  }
+  /// Returns the parameters for the conversion of the clusters with the n_th element
+  inline const ClusterParams& getClusterParams(int n) const
+  {
+    assert(n >= 0 || n < (int)mClusterParams.size());
+    return mClusterParams[n];
+  }
+  /// Returns the parameters for the conversion of the clusters of all elements, indexed by ID,
+  /// empty for dictionaries stored before they were introduced
+  const std::vector<ClusterParams>& getClusterParams() const { return mClusterParams; }
+  /// Computes from the elements the parameters for the conversion of the clusters
+  void getClusterParams(std::vector<ClusterParams>& params) const;
   /// Fills a hostogram with the distribution of the IDs
   static void getTopologyDistribution(const TopologyDictionary& dict, TH1F*& histo, const char* histName);
   /// Returns the number of elements in the dicionary;
@@ -165,12 +204,32 @@ class TopologyDictionary
   friend TopologyFastSimulation;
 
  private:
+  /// Builds the minimal perfect hash of the common topologies from the mCommonMap
+  void buildPerfectHash();
+  /// Fills the mClusterParams from the mVectorOfIDs
+  void fillClusterParams() { getClusterParams(mClusterParams); }
+  /// Mixes the complete hash of the topology with the seed
+  static inline uint32_t mixHash(unsigned long key, uint32_t seed)
+  {
+    uint64_t h = uint64_t(key) ^ (uint64_t(seed) * 0x9e3779b97f4a7c15UL);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdUL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53UL;
+    h ^= h >> 33;
+    return uint32_t(h);
+  }
+
   std::unordered_map<unsigned long, int> mCommonMap; ///< Map of pair <hash, position in mVectorOfIDs>
   std::unordered_map<int, int> mGroupMap;            ///< Map of pair <groudID, position in mVectorOfIDs>
   int mSmallTopologiesLUT[8 * 255 + 1];              ///< Look-Up Table for the topologies with 1-byte linearised matrix
   std::vector<GroupStruct> mVectorOfIDs;             ///< Vector of topologies and groups
+  std::vector<uint32_t> mPerfectHashDisp;            ///< Displacement (seed) of every bucket of the common topologies perfect hash
+  std::vector<unsigned long> mPerfectHashKeys;       ///< Complete hash of the common topology in every slot of the perfect hash
+  std::vector<int> mPerfectHashIDs;                  ///< Position in mVectorOfIDs of the common topology in every slot of the perfect hash
+  std::vector<ClusterParams> mClusterParams;         ///< Parameters for the conversion of the clusters of every element of mVectorOfIDs
 
-  ClassDefNV(TopologyDictionary, 4);
+  ClassDefNV(TopologyDictionary, 6);
 }; // namespace itsmft
 } // namespace itsmft
 } // namespace o2
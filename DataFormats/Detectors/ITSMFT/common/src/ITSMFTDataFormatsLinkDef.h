@@ -37,6 +37,7 @@
 #pragma link C++ class o2::itsmft::ClusterTopology + ;
 #pragma link C++ class o2::itsmft::TopologyDictionary + ;
 #pragma link C++ class o2::itsmft::GroupStruct + ;
+#pragma link C++ class o2::itsmft::ClusterParams + ;
 
 #pragma link C++ class o2::itsmft::TrkClusRef + ;
 #pragma link C++ class std::vector < o2::itsmft::TrkClusRef> + ;
@@ -35,6 +35,37 @@ void NoiseMap::print()
   LOG(INFO) << "Probability threshold: " << mProbThreshold;
 }
 
+void NoiseMap::increaseNoiseCounts(gsl::span<const uint64_t> sortedKeys)
+{
+  mMaskChipStart.clear();
+  size_t nKeys = sortedKeys.size();
+  for (size_t i = 0; i < nKeys;) {
+    auto key = sortedKeys[i];
+    size_t j = i + 1;
+    while (j < nKeys && sortedKeys[j] == key) {
+      j++;
+    }
+    auto chip = key >> ChipShift;
+    if (chip < mNoisyPixels.size()) {
+      mNoisyPixels[chip][int(key & PixelMask)] += int(j - i);
+    }
+    i = j;
+  }
+}
+
+void NoiseMap::buildMask()
+{
+  mMaskKeys.clear();
+  mMaskChipStart.resize(mNoisyPixels.size() + 1);
+  for (size_t chip = 0; chip < mNoisyPixels.size(); chip++) {
+    mMaskChipStart[chip] = mMaskKeys.size();
+    for (const auto& pair : mNoisyPixels[chip]) {
+      mMaskKeys.push_back(pair.first);
+    }
+  }
+  mMaskChipStart[mNoisyPixels.size()] = mMaskKeys.size();
+}
+
 void NoiseMap::fill(const gsl::span<const CompClusterExt> data)
 {
   for (const auto& c : data) {
@@ -16,7 +16,10 @@
 
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 #include "DataFormatsITSMFT/ClusterTopology.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include "ITSMFTBase/SegmentationAlpide.h"
 
 using std::cout;
@@ -53,21 +56,33 @@ std::ostream& operator<<(std::ostream& os, const TopologyDictionary& dict)
 
 void TopologyDictionary::writeBinaryFile(string outputfile)
 {
+  // header with the magic word, the version and the number of entries, followed by the fixed-size entries
   std::ofstream file_output(outputfile, std::ios::out | std::ios::binary);
+  uint64_t magic = BinaryFileMagic;
+  uint32_t version = BinaryFileVersion, nEntries = mVectorOfIDs.size();
+  file_output.write(reinterpret_cast<char*>(&magic), sizeof(magic));
+  file_output.write(reinterpret_cast<char*>(&version), sizeof(version));
+  file_output.write(reinterpret_cast<char*>(&nEntries), sizeof(nEntries));
+  std::vector<char> buffer(BinaryEntrySize * nEntries);
+  char* pos = buffer.data();
+  auto put = [&pos](const void* src, size_t size) {
+    memcpy(pos, src, size);
+    pos += size;
+  };
   for (auto& p : mVectorOfIDs) {
-    file_output.write(reinterpret_cast<char*>(&p.mHash), sizeof(unsigned long));
-    file_output.write(reinterpret_cast<char*>(&p.mErrX), sizeof(float));
-    file_output.write(reinterpret_cast<char*>(&p.mErrZ), sizeof(float));
-    file_output.write(reinterpret_cast<char*>(&p.mErr2X), sizeof(float));
-    file_output.write(reinterpret_cast<char*>(&p.mErr2Z), sizeof(float));
-    file_output.write(reinterpret_cast<char*>(&p.mXCOG), sizeof(float));
-    file_output.write(reinterpret_cast<char*>(&p.mZCOG), sizeof(float));
-    file_output.write(reinterpret_cast<char*>(&p.mNpixels), sizeof(int));
-    file_output.write(reinterpret_cast<char*>(&p.mFrequency), sizeof(double));
-    file_output.write(reinterpret_cast<char*>(&p.mIsGroup), sizeof(bool));
-    file_output.write(reinterpret_cast<char*>(&p.mPattern.mBitmap),
-                      sizeof(unsigned char) * (ClusterPattern::kExtendedPatternBytes));
+    put(&p.mHash, sizeof(unsigned long));
+    put(&p.mErrX, sizeof(float));
+    put(&p.mErrZ, sizeof(float));
+    put(&p.mErr2X, sizeof(float));
+    put(&p.mErr2Z, sizeof(float));
+    put(&p.mXCOG, sizeof(float));
+    put(&p.mZCOG, sizeof(float));
+    put(&p.mNpixels, sizeof(int));
+    put(&p.mFrequency, sizeof(double));
+    put(&p.mIsGroup, sizeof(bool));
+    put(&p.mPattern.mBitmap, sizeof(unsigned char) * (ClusterPattern::kExtendedPatternBytes));
   }
+  file_output.write(buffer.data(), buffer.size());
   file_output.close();
 }
 
@@ -75,43 +90,155 @@ int TopologyDictionary::readBinaryFile(string fname)
 {
   mVectorOfIDs.clear();
   mCommonMap.clear();
+  mGroupMap.clear();
   for (auto& p : mSmallTopologiesLUT) {
     p = -1;
   }
   std::ifstream in(fname.data(), std::ios::in | std::ios::binary);
-  GroupStruct gr;
-  int groupID = 0;
   if (!in.is_open()) {
     LOG(ERROR) << "The file " << fname << " coud not be opened";
     throw std::runtime_error("The file coud not be opened");
-  } else {
-    while (in.read(reinterpret_cast<char*>(&gr.mHash), sizeof(unsigned long))) {
-      in.read(reinterpret_cast<char*>(&gr.mErrX), sizeof(float));
-      in.read(reinterpret_cast<char*>(&gr.mErrZ), sizeof(float));
-      in.read(reinterpret_cast<char*>(&gr.mErr2X), sizeof(float));
-      in.read(reinterpret_cast<char*>(&gr.mErr2Z), sizeof(float));
-      in.read(reinterpret_cast<char*>(&gr.mXCOG), sizeof(float));
-      in.read(reinterpret_cast<char*>(&gr.mZCOG), sizeof(float));
-      in.read(reinterpret_cast<char*>(&gr.mNpixels), sizeof(int));
-      in.read(reinterpret_cast<char*>(&gr.mFrequency), sizeof(double));
-      in.read(reinterpret_cast<char*>(&gr.mIsGroup), sizeof(bool));
-      in.read(reinterpret_cast<char*>(&gr.mPattern.mBitmap), sizeof(unsigned char) * (ClusterPattern::kExtendedPatternBytes));
-      mVectorOfIDs.push_back(gr);
-      if (!gr.mIsGroup) {
-        mCommonMap.insert(std::make_pair(gr.mHash, groupID));
-        if (gr.mPattern.getUsedBytes() == 1) {
-          mSmallTopologiesLUT[(gr.mPattern.getColumnSpan() - 1) * 255 + (int)gr.mPattern.mBitmap[2]] = groupID;
-        }
-      } else {
-        mGroupMap.insert(std::make_pair((int)(gr.mHash >> 32) & 0x00000000ffffffff, groupID));
+  }
+  // the whole file is read at once: the entries are decoded from memory
+  std::vector<char> buffer{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  in.close();
+  const char* pos = buffer.data();
+  const char* end = pos + buffer.size();
+  uint64_t magic = 0;
+  if (buffer.size() >= sizeof(magic)) {
+    memcpy(&magic, pos, sizeof(magic));
+  }
+  size_t nEntries = buffer.size() / BinaryEntrySize; // legacy format: entries only
+  if (magic == BinaryFileMagic) {
+    uint32_t version = 0, nEntriesHeader = 0;
+    if (buffer.size() < sizeof(magic) + sizeof(version) + sizeof(nEntriesHeader)) {
+      LOG(ERROR) << "The file " << fname << " has a truncated header";
+      throw std::runtime_error("Truncated topology dictionary file");
+    }
+    pos += sizeof(magic);
+    memcpy(&version, pos, sizeof(version));
+    pos += sizeof(version);
+    memcpy(&nEntriesHeader, pos, sizeof(nEntriesHeader));
+    pos += sizeof(nEntriesHeader);
+    if (version != BinaryFileVersion) {
+      LOG(ERROR) << "The file " << fname << " has version " << version << ", supported: " << BinaryFileVersion;
+      throw std::runtime_error("Unsupported topology dictionary file version");
+    }
+    if (size_t(end - pos) < nEntriesHeader * BinaryEntrySize) {
+      LOG(ERROR) << "The file " << fname << " is truncated: " << nEntriesHeader << " entries expected";
+      throw std::runtime_error("Truncated topology dictionary file");
+    }
+    nEntries = nEntriesHeader;
+  }
+  auto get = [&pos](void* dst, size_t size) {
+    memcpy(dst, pos, size);
+    pos += size;
+  };
+  mVectorOfIDs.reserve(nEntries);
+  GroupStruct gr;
+  for (size_t groupID = 0; groupID < nEntries; groupID++) {
+    get(&gr.mHash, sizeof(unsigned long));
+    get(&gr.mErrX, sizeof(float));
+    get(&gr.mErrZ, sizeof(float));
+    get(&gr.mErr2X, sizeof(float));
+    get(&gr.mErr2Z, sizeof(float));
+    get(&gr.mXCOG, sizeof(float));
+    get(&gr.mZCOG, sizeof(float));
+    get(&gr.mNpixels, sizeof(int));
+    get(&gr.mFrequency, sizeof(double));
+    get(&gr.mIsGroup, sizeof(bool));
+    get(&gr.mPattern.mBitmap, sizeof(unsigned char) * (ClusterPattern::kExtendedPatternBytes));
+    mVectorOfIDs.push_back(gr);
+    if (!gr.mIsGroup) {
+      mCommonMap.insert(std::make_pair(gr.mHash, groupID));
+      if (gr.mPattern.getUsedBytes() == 1) {
+        mSmallTopologiesLUT[(gr.mPattern.getColumnSpan() - 1) * 255 + (int)gr.mPattern.mBitmap[2]] = groupID;
       }
-      groupID++;
+    } else {
+      mGroupMap.insert(std::make_pair((int)(gr.mHash >> 32) & 0x00000000ffffffff, groupID));
     }
   }
-  in.close();
+  buildPerfectHash();
+  fillClusterParams();
   return 0;
 }
 
+void TopologyDictionary::getClusterParams(std::vector<ClusterParams>& params) const
+{
+  params.resize(mVectorOfIDs.size());
+  for (size_t i = 0; i < mVectorOfIDs.size(); i++) {
+    const auto& gr = mVectorOfIDs[i];
+    params[i] = ClusterParams{gr.mXCOG, gr.mZCOG, gr.mErr2X, gr.mErr2Z, gr.mIsGroup};
+  }
+}
+
+void TopologyDictionary::buildPerfectHash()
+{
+  // CHD (compress, hash, displace) minimal perfect hash of the common topologies: the keys are distributed
+  // over buckets of ~4 keys, then, starting from the most populated bucket, the displacement is searched
+  // for which all the keys of the bucket fall to the free slots of the table of mCommonMap.size() entries
+  mPerfectHashDisp.clear();
+  mPerfectHashKeys.clear();
+  mPerfectHashIDs.clear();
+  uint32_t nKeys = mCommonMap.size();
+  if (!nKeys) {
+    return;
+  }
+  const uint32_t nBuckets = std::max(1u, nKeys / 4);
+  const uint32_t MaxDisplacement = 1u << 24;
+  std::vector<std::vector<unsigned long>> buckets(nBuckets);
+  for (const auto& p : mCommonMap) {
+    buckets[mixHash(p.first, 0) % nBuckets].push_back(p.first);
+  }
+  std::vector<uint32_t> order(nBuckets);
+  for (uint32_t i = 0; i < nBuckets; i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&buckets](uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+  std::vector<uint32_t> disp(nBuckets, 0);
+  std::vector<bool> taken(nKeys, false);
+  std::vector<uint32_t> slots;
+  for (auto ib : order) {
+    const auto& bucket = buckets[ib];
+    if (bucket.empty()) {
+      break;
+    }
+    uint32_t d = 1;
+    for (; d < MaxDisplacement; d++) {
+      slots.clear();
+      bool ok = true;
+      for (auto key : bucket) {
+        uint32_t slot = mixHash(key, d) % nKeys;
+        if (taken[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+          ok = false;
+          break;
+        }
+        slots.push_back(slot);
+      }
+      if (ok) {
+        break;
+      }
+    }
+    if (d == MaxDisplacement) {
+      LOG(WARNING) << "Failed to build perfect hash for " << nKeys << " common topologies, will use the map lookup";
+      return;
+    }
+    disp[ib] = d;
+    for (auto slot : slots) {
+      taken[slot] = true;
+    }
+  }
+  mPerfectHashKeys.resize(nKeys);
+  mPerfectHashIDs.resize(nKeys);
+  for (const auto& p : mCommonMap) {
+    uint32_t slot = mixHash(p.first, disp[mixHash(p.first, 0) % nBuckets]) % nKeys;
+    mPerfectHashKeys[slot] = p.first;
+    mPerfectHashIDs[slot] = p.second;
+  }
+  mPerfectHashDisp.swap(disp);
+}
+
 void TopologyDictionary::getTopologyDistribution(const TopologyDictionary& dict, TH1F*& histo, const char* histName)
 {
   int dictSize = (int)dict.getSize();
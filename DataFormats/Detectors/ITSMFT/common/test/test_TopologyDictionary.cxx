@@ -0,0 +1,163 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TopologyDictionary
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DataFormatsITSMFT/TopologyDictionary.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace o2::itsmft
+{
+
+namespace
+{
+/// writes the entries in the legacy layout of the binary file, i.e. w/o the header
+void writeLegacyFile(const std::string& fname, const std::vector<GroupStruct>& entries)
+{
+  std::ofstream out(fname, std::ios::out | std::ios::binary);
+  for (const auto& p : entries) {
+    out.write(reinterpret_cast<const char*>(&p.mHash), sizeof(unsigned long));
+    out.write(reinterpret_cast<const char*>(&p.mErrX), sizeof(float));
+    out.write(reinterpret_cast<const char*>(&p.mErrZ), sizeof(float));
+    out.write(reinterpret_cast<const char*>(&p.mErr2X), sizeof(float));
+    out.write(reinterpret_cast<const char*>(&p.mErr2Z), sizeof(float));
+    out.write(reinterpret_cast<const char*>(&p.mXCOG), sizeof(float));
+    out.write(reinterpret_cast<const char*>(&p.mZCOG), sizeof(float));
+    out.write(reinterpret_cast<const char*>(&p.mNpixels), sizeof(int));
+    out.write(reinterpret_cast<const char*>(&p.mFrequency), sizeof(double));
+    out.write(reinterpret_cast<const char*>(&p.mIsGroup), sizeof(bool));
+    auto bitmap = p.mPattern.getPattern();
+    out.write(reinterpret_cast<const char*>(bitmap.data()), ClusterPattern::kExtendedPatternBytes);
+  }
+}
+
+/// a few common topologies (among them 1-byte ones) followed by a group of rare topologies
+std::vector<GroupStruct> makeEntries()
+{
+  std::vector<GroupStruct> entries;
+  unsigned char patt[ClusterPattern::MaxPatternBytes] = {0};
+  for (int i = 0; i < 5; i++) {
+    GroupStruct gr;
+    int nRow = 1 + i % 3, nCol = 1 + i;
+    patt[0] = (unsigned char)(0x80 | (i << 2));
+    patt[1] = (unsigned char)(0x40 + i);
+    gr.mPattern.setPattern(nRow, nCol, patt);
+    gr.mHash = 0x1234567800000000UL + 17 * i + 1;
+    gr.mErrX = 1.e-3f * (i + 1);
+    gr.mErrZ = 2.e-3f * (i + 1);
+    gr.mErr2X = gr.mErrX * gr.mErrX;
+    gr.mErr2Z = gr.mErrZ * gr.mErrZ;
+    gr.mXCOG = 0.1f * i;
+    gr.mZCOG = -0.2f * i;
+    gr.mNpixels = i + 1;
+    gr.mFrequency = 0.5 / (i + 1);
+    gr.mIsGroup = false;
+    entries.push_back(gr);
+  }
+  GroupStruct gr;
+  memset(patt, 0xff, sizeof(patt));
+  gr.mPattern.setPattern(4, 4, patt);
+  gr.mHash = (unsigned long)3 << 32;
+  gr.mErrX = gr.mErrZ = 0.5f;
+  gr.mErr2X = gr.mErr2Z = 0.25f;
+  gr.mXCOG = gr.mZCOG = 1.5f;
+  gr.mNpixels = 16;
+  gr.mFrequency = 1.e-4;
+  gr.mIsGroup = true;
+  entries.push_back(gr);
+  return entries;
+}
+
+void checkDictionary(const TopologyDictionary& dict, const std::vector<GroupStruct>& entries)
+{
+  BOOST_REQUIRE_EQUAL(dict.getSize(), (int)entries.size());
+  BOOST_REQUIRE_EQUAL(dict.getClusterParams().size(), entries.size());
+  for (int i = 0; i < (int)entries.size(); i++) {
+    const auto& gr = entries[i];
+    BOOST_CHECK_EQUAL(dict.getHash(i), gr.mHash);
+    BOOST_CHECK_EQUAL(dict.getErrX(i), gr.mErrX);
+    BOOST_CHECK_EQUAL(dict.getErrZ(i), gr.mErrZ);
+    BOOST_CHECK_EQUAL(dict.getErr2X(i), gr.mErr2X);
+    BOOST_CHECK_EQUAL(dict.getErr2Z(i), gr.mErr2Z);
+    BOOST_CHECK_EQUAL(dict.getXCOG(i), gr.mXCOG);
+    BOOST_CHECK_EQUAL(dict.getZCOG(i), gr.mZCOG);
+    BOOST_CHECK_EQUAL(dict.getNpixels(i), gr.mNpixels);
+    BOOST_CHECK_EQUAL(dict.getFrequency(i), gr.mFrequency);
+    BOOST_CHECK_EQUAL(dict.isGroup(i), gr.mIsGroup);
+    BOOST_CHECK(dict.getPattern(i).getPattern() == gr.mPattern.getPattern());
+    const auto& par = dict.getClusterParams(i);
+    BOOST_CHECK_EQUAL(par.mXCOG, gr.mXCOG);
+    BOOST_CHECK_EQUAL(par.mZCOG, gr.mZCOG);
+    BOOST_CHECK_EQUAL(par.mErr2X, gr.mErr2X);
+    BOOST_CHECK_EQUAL(par.mErr2Z, gr.mErr2Z);
+    BOOST_CHECK_EQUAL(par.mIsGroup, gr.mIsGroup);
+    BOOST_CHECK_EQUAL(dict.getCommonTopologyID(gr.mHash), gr.mIsGroup ? -1 : i);
+  }
+  BOOST_CHECK_EQUAL(dict.getCommonTopologyID(0xdeadbeefUL), -1);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TopologyDictionary_binary_roundtrip)
+{
+  const std::string legacyName = "test_TopologyDictionary_legacy.bin", newName = "test_TopologyDictionary.bin";
+  auto entries = makeEntries();
+  writeLegacyFile(legacyName, entries);
+
+  // legacy layout: entries only
+  TopologyDictionary legacy;
+  BOOST_REQUIRE_EQUAL(legacy.readBinaryFile(legacyName), 0);
+  checkDictionary(legacy, entries);
+
+  // new layout: header followed by the same entries
+  legacy.writeBinaryFile(newName);
+  std::ifstream in(newName, std::ios::in | std::ios::binary);
+  std::vector<char> buffer{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  in.close();
+  BOOST_REQUIRE_EQUAL(buffer.size(), sizeof(uint64_t) + 2 * sizeof(uint32_t) + entries.size() * TopologyDictionary::BinaryEntrySize);
+  uint64_t magic = 0;
+  uint32_t version = 0, nEntries = 0;
+  memcpy(&magic, buffer.data(), sizeof(magic));
+  memcpy(&version, buffer.data() + sizeof(magic), sizeof(version));
+  memcpy(&nEntries, buffer.data() + sizeof(magic) + sizeof(version), sizeof(nEntries));
+  BOOST_CHECK_EQUAL(magic, TopologyDictionary::BinaryFileMagic);
+  BOOST_CHECK_EQUAL(version, TopologyDictionary::BinaryFileVersion);
+  BOOST_CHECK_EQUAL(nEntries, entries.size());
+
+  TopologyDictionary dict(newName);
+  checkDictionary(dict, entries);
+
+  // the entries following the header are the legacy ones
+  std::ifstream inLegacy(legacyName, std::ios::in | std::ios::binary);
+  std::vector<char> legacyBuffer{std::istreambuf_iterator<char>(inLegacy), std::istreambuf_iterator<char>()};
+  inLegacy.close();
+  BOOST_CHECK(std::equal(legacyBuffer.begin(), legacyBuffer.end(), buffer.begin() + sizeof(uint64_t) + 2 * sizeof(uint32_t)));
+
+  // a truncated file in the new layout is rejected
+  {
+    std::ofstream out(newName, std::ios::out | std::ios::binary);
+    out.write(buffer.data(), buffer.size() - 1);
+  }
+  TopologyDictionary truncated;
+  BOOST_CHECK_THROW(truncated.readBinaryFile(newName), std::runtime_error);
+
+  std::remove(legacyName.c_str());
+  std::remove(newName.c_str());
+}
+
+} // namespace o2::itsmft
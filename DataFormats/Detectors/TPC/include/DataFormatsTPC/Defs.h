@@ -67,9 +67,10 @@ enum class PadSubset : char {
 
 /// Statistics type
 enum class StatisticsType {
-  GausFit,     ///< Use slow gaus fit (better fit stability)
-  GausFitFast, ///< Use fast gaus fit (less accurate error treatment)
-  MeanStdDev   ///< Use mean and standard deviation
+  GausFit,         ///< Use slow gaus fit (better fit stability)
+  GausFitFast,     ///< Use fast gaus fit (less accurate error treatment)
+  MeanStdDev,      ///< Use mean and standard deviation
+  MeanStdDevOnline ///< Use mean and standard deviation from running sums, the ADC spectra are not stored
 };
 
 // default point definitions for PointND, PointNDlocal, PointNDglobal are in
@@ -0,0 +1,460 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   TrackParCovBlock.h
+/// @brief  Block of N tracks with errors in SoA layout, with batched rotation, propagation and update
+
+#ifndef INCLUDE_RECONSTRUCTIONDATAFORMATS_TRACKPARCOVBLOCK_H_
+#define INCLUDE_RECONSTRUCTIONDATAFORMATS_TRACKPARCOVBLOCK_H_
+
+#include "ReconstructionDataFormats/TrackParametrizationWithError.h"
+#include <cmath>
+
+namespace o2
+{
+namespace track
+{
+
+/*
+  N tracks stored as structure of arrays (x, alpha, 5 parameters and 15 covariance elements of every lane),
+  so that the rotation, propagation in constant field and update with a 2D measurement of all lanes are done
+  in branch-free loops over the lanes, which the compiler can vectorize. The math is that of the corresponding
+  TrackParametrizationWithError methods, including the intermediate double precision.
+  Every lane has a validity flag: the operations are applied only to the valid lanes, a lane for which the
+  operation fails (in the cases where the scalar method would return false) is left unchanged and invalidated.
+
+    TrackParCovBlock<float, 8> blk;
+    int n = blk.load(tracks.data(), tracks.size()); // up to 8 tracks
+    blk.propagateTo(xCl, bz);
+    blk.update<false>(yCl, zCl, sy2Cl, nullptr, sz2Cl, chi2); // uncorrelated y, z errors
+    for (int i = 0; i < n; i++) {
+      if (!blk.store(i, tracks[i])) { ... } // the fit of track i failed
+    }
+*/
+
+template <typename value_T = float, int N = 8>
+class TrackParCovBlock
+{
+ public:
+  using value_t = value_T;
+  using track_t = TrackParametrizationWithError<value_T>;
+  static constexpr int NLanes = N;
+
+  /// invalidate all lanes
+  void clear();
+  /// load the track in the given lane and validate it
+  void load(int lane, const track_t& trc);
+  /// load n (up to N) consecutive tracks in the 1st lanes, the others are invalidated; return the number of loaded tracks
+  int load(const track_t* trc, int n);
+  /// copy the x, alpha, parameters and covariance of a valid lane to the track (charge and PID are kept), return the lane validity
+  bool store(int lane, track_t& trc) const;
+
+  bool isValid(int lane) const { return mValid[lane]; }
+  void setValid(int lane, bool v) { mValid[lane] = v; }
+  int getNValid() const;
+
+  value_t getX(int lane) const { return mX[lane]; }
+  value_t getAlpha(int lane) const { return mAlpha[lane]; }
+  value_t getParam(int lane, int i) const { return mP[i][lane]; }
+  value_t getCov(int lane, int i) const { return mC[i][lane]; }
+
+  /// rotate every valid lane to its alpha
+  void rotate(const value_t* alpha);
+  /// propagate every valid lane to its X in the field b (kG)
+  void propagateTo(const value_t* xk, value_t b);
+  /// predicted chi2 of the measurement y, z with errors sy2, syz, sz2 of every valid lane, VeryBig for the invalid ones
+  /// (syz is not used with CorrYZ = false and may be nullptr)
+  template <bool CorrYZ = true>
+  void getPredictedChi2(const value_t* y, const value_t* z, const value_t* sy2, const value_t* syz, const value_t* sz2, value_t* chi2) const;
+  /// update every valid lane with the measurement y, z with errors sy2, syz, sz2, adding the predicted chi2 to chi2 if provided
+  /// (syz is not used with CorrYZ = false and may be nullptr, as for the clusters with uncorrelated errors in the tracking frame)
+  template <bool CorrYZ = true>
+  void update(const value_t* y, const value_t* z, const value_t* sy2, const value_t* syz, const value_t* sz2, value_t* chi2 = nullptr);
+
+ private:
+  void checkCovariance(const bool* updated);
+  static value_t limitDiag(value_t& diag, value_t maxDiag, bool updated);
+
+  alignas(64) value_t mX[N] = {};              ///< X of every lane
+  alignas(64) value_t mAlpha[N] = {};          ///< alpha of every lane
+  alignas(64) value_t mP[kNParams][N] = {};    ///< parameters of every lane
+  alignas(64) value_t mC[kCovMatSize][N] = {}; ///< covariance elements of every lane
+  alignas(64) value_t mCharged[N] = {};        ///< 1 for charged tracks, 0 for neutral ones (null curvature)
+  bool mValid[N] = {};                         ///< validity of every lane
+};
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+inline void TrackParCovBlock<value_T, N>::clear()
+{
+  for (int i = 0; i < N; i++) {
+    mValid[i] = false;
+  }
+}
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+inline void TrackParCovBlock<value_T, N>::load(int lane, const track_t& trc)
+{
+  mX[lane] = trc.getX();
+  mAlpha[lane] = trc.getAlpha();
+  for (int ip = 0; ip < kNParams; ip++) {
+    mP[ip][lane] = trc.getParam(ip);
+  }
+  const auto& cov = trc.getCov();
+  for (int ic = 0; ic < kCovMatSize; ic++) {
+    mC[ic][lane] = cov[ic];
+  }
+  mCharged[lane] = trc.getAbsCharge() ? 1 : 0;
+  mValid[lane] = true;
+}
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+inline int TrackParCovBlock<value_T, N>::load(const track_t* trc, int n)
+{
+  n = n < N ? n : N;
+  for (int i = 0; i < n; i++) {
+    load(i, trc[i]);
+  }
+  for (int i = n; i < N; i++) {
+    mValid[i] = false;
+  }
+  return n;
+}
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+inline bool TrackParCovBlock<value_T, N>::store(int lane, track_t& trc) const
+{
+  if (!mValid[lane]) {
+    return false;
+  }
+  trc.setX(mX[lane]);
+  trc.setAlpha(mAlpha[lane]);
+  for (int ip = 0; ip < kNParams; ip++) {
+    trc.setParam(mP[ip][lane], ip);
+  }
+  for (int ic = 0; ic < kCovMatSize; ic++) {
+    trc.setCov(mC[ic][lane], ic);
+  }
+  return true;
+}
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+inline int TrackParCovBlock<value_T, N>::getNValid() const
+{
+  int n = 0;
+  for (int i = 0; i < N; i++) {
+    n += mValid[i];
+  }
+  return n;
+}
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+inline void TrackParCovBlock<value_T, N>::rotate(const value_t* alpha)
+{
+  // rotate to alpha frame, see TrackParametrizationWithError::rotate
+  // the sin and cos of the rotation angles are evaluated in a separate loop, so that the rest can be vectorized
+  value_t alp[N], ca[N], sa[N];
+  for (int i = 0; i < N; i++) {
+    alp[i] = math_utils::detail::toPMPi<value_t>(alpha[i]);
+    math_utils::detail::sincos(alp[i] - mAlpha[i], sa[i], ca[i]);
+  }
+  bool updated[N];
+  for (int i = 0; i < N; i++) {
+    value_t snp = mP[kSnp][i];
+    value_t csp = gpu::CAMath::Sqrt(gpu::CAMath::Max(value_t(0), (1.f - snp) * (1.f + snp)));
+    value_t updSnp = snp * ca[i] - csp * sa[i];
+    // the rotation must keep the direction along the X axis
+    bool ok = mValid[i] & (gpu::CAMath::Abs(snp) <= constants::math::Almost1) & ((csp * ca[i] + snp * sa[i]) >= 0) & (gpu::CAMath::Abs(updSnp) <= constants::math::Almost1);
+    value_t x = mX[i] * ca[i] + mP[kY][i] * sa[i], y = -mX[i] * sa[i] + mP[kY][i] * ca[i];
+    csp = gpu::CAMath::Abs(csp) < constants::math::Almost0 ? constants::math::Almost0 : csp;
+    value_t rr = (ca[i] + snp / csp * sa[i]);
+    mAlpha[i] = ok ? alp[i] : mAlpha[i];
+    mX[i] = ok ? x : mX[i];
+    mP[kY][i] = ok ? y : mP[kY][i];
+    mP[kSnp][i] = ok ? updSnp : snp;
+    value_t sca = ok ? ca[i] : 1, srr = ok ? rr : 1;
+    mC[kSigY2][i] *= (sca * sca);
+    mC[kSigZY][i] *= sca;
+    mC[kSigSnpY][i] *= sca * srr;
+    mC[kSigSnpZ][i] *= srr;
+    mC[kSigSnp2][i] *= srr * srr;
+    mC[kSigTglY][i] *= sca;
+    mC[kSigTglSnp][i] *= srr;
+    mC[kSigQ2PtY][i] *= sca;
+    mC[kSigQ2PtSnp][i] *= srr;
+    mValid[i] = updated[i] = ok;
+  }
+  checkCovariance(updated);
+}
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+inline void TrackParCovBlock<value_T, N>::propagateTo(const value_t* xk, value_t b)
+{
+  // propagate to the plane X=xk (cm) in the field "b" (kG), see TrackParametrizationWithError::propagateTo
+  // the arcs are evaluated in a separate loop for the lanes which need them, so that the rest can be vectorized
+  value_t r1[N], r2[N], x2r[N], rot[N];
+  bool updated[N];
+  for (int i = 0; i < N; i++) {
+    value_t dx = xk[i] - mX[i];
+    value_t crv = mCharged[i] * mP[kQ2Pt][i] * b * constants::math::B2C;
+    x2r[i] = crv * dx;
+    value_t f1 = mP[kSnp][i], f2 = f1 + x2r[i];
+    r1[i] = gpu::CAMath::Sqrt(gpu::CAMath::Max(value_t(0), (1.f - f1) * (1.f + f1)));
+    r2[i] = gpu::CAMath::Sqrt(gpu::CAMath::Max(value_t(0), (1.f - f2) * (1.f + f2)));
+    bool move = gpu::CAMath::Abs(dx) >= constants::math::Almost0; // the lanes already at xk are left unchanged
+    bool ok = (gpu::CAMath::Abs(f1) <= constants::math::Almost1) & (gpu::CAMath::Abs(f2) <= constants::math::Almost1) &
+              (gpu::CAMath::Abs(r1[i]) >= constants::math::Almost0) & (gpu::CAMath::Abs(r2[i]) >= constants::math::Almost0);
+    updated[i] = mValid[i] & move & ok;
+    mValid[i] = mValid[i] & (!move | ok);
+    r1[i] = updated[i] ? r1[i] : 1.f; // protect the lanes which are not updated from the divisions
+    r2[i] = updated[i] ? r2[i] : 1.f;
+  }
+  for (int i = 0; i < N; i++) {
+    // for small dx/R the linear apporximation of the arc by the segment is OK, otherwise the arc is R*deltaPhi
+    rot[i] = 0;
+    if (updated[i] && gpu::CAMath::Abs(x2r[i]) >= 0.05f) {
+      value_t f1 = mP[kSnp][i], f2 = f1 + x2r[i];
+      rot[i] = gpu::CAMath::ASin(r1[i] * f2 - r2[i] * f1); // more economic version from Yura.
+      if (f1 * f1 + f2 * f2 > 1.f && f1 * f2 < 0.f) {     // special cases of large rotations or large abs angles
+        rot[i] = f2 > 0.f ? constants::math::PI - rot[i] : -constants::math::PI - rot[i];
+      }
+    }
+  }
+  for (int i = 0; i < N; i++) {
+    bool upd = updated[i];
+    value_t dx = xk[i] - mX[i], f1 = mP[kSnp][i], f2 = f1 + x2r[i];
+    double dy2dx = (f1 + f2) / (r1[i] + r2[i]);
+    value_t dY = dx * dy2dx;
+    value_t crv = gpu::CAMath::Abs(x2r[i]) < 0.05f ? value_t(1) : mCharged[i] * mP[kQ2Pt][i] * b * constants::math::B2C;
+    value_t dZ = gpu::CAMath::Abs(x2r[i]) < 0.05f ? value_t(dx * (r2[i] + f2 * dy2dx) * mP[kTgl][i]) : mP[kTgl][i] / crv * rot[i];
+
+    value_t &c00 = mC[kSigY2][i], &c10 = mC[kSigZY][i], &c11 = mC[kSigZ2][i], &c20 = mC[kSigSnpY][i], &c21 = mC[kSigSnpZ][i],
+            &c22 = mC[kSigSnp2][i], &c30 = mC[kSigTglY][i], &c31 = mC[kSigTglZ][i], &c32 = mC[kSigTglSnp][i], &c33 = mC[kSigTgl2][i],
+            &c40 = mC[kSigQ2PtY][i], &c41 = mC[kSigQ2PtZ][i], &c42 = mC[kSigQ2PtSnp][i], &c43 = mC[kSigQ2PtTgl][i],
+            &c44 = mC[kSigQ2Pt2][i];
+
+    // evaluate matrix in double prec.
+    value_t dxu = upd ? dx : value_t(0); // null transport matrix for the lanes which are not updated
+    double rinv = 1. / r1[i];
+    double r3inv = rinv * rinv * rinv;
+    double f24 = dxu * b * constants::math::B2C; // x2r/mP[kQ2Pt];
+    double f02 = dxu * r3inv;
+    double f04 = 0.5 * f24 * f02;
+    double f12 = f02 * mP[kTgl][i] * f1;
+    double f14 = 0.5 * f24 * f12; // 0.5*f24*f02*getTgl()*f1;
+    double f13 = dxu * rinv;
+
+    // b = C*ft
+    double b00 = f02 * c20 + f04 * c40, b01 = f12 * c20 + f14 * c40 + f13 * c30;
+    double b02 = f24 * c40;
+    double b10 = f02 * c21 + f04 * c41, b11 = f12 * c21 + f14 * c41 + f13 * c31;
+    double b12 = f24 * c41;
+    double b20 = f02 * c22 + f04 * c42, b21 = f12 * c22 + f14 * c42 + f13 * c32;
+    double b22 = f24 * c42;
+    double b40 = f02 * c42 + f04 * c44, b41 = f12 * c42 + f14 * c44 + f13 * c43;
+    double b42 = f24 * c44;
+    double b30 = f02 * c32 + f04 * c43, b31 = f12 * c32 + f14 * c43 + f13 * c33;
+    double b32 = f24 * c43;
+
+    // a = f*b = f*C*ft
+    double a00 = f02 * b20 + f04 * b40, a01 = f02 * b21 + f04 * b41, a02 = f02 * b22 + f04 * b42;
+    double a11 = f12 * b21 + f14 * b41 + f13 * b31, a12 = f12 * b22 + f14 * b42 + f13 * b32;
+    double a22 = f24 * b42;
+
+    // F*C*Ft = C + (b + bt + a)
+    c00 += b00 + b00 + a00;
+    c10 += b10 + b01 + a01;
+    c20 += b20 + b02 + a02;
+    c30 += b30;
+    c40 += b40;
+    c11 += b11 + b11 + a11;
+    c21 += b21 + b12 + a12;
+    c31 += b31;
+    c41 += b41;
+    c22 += b22 + b22 + a22;
+    c32 += b32;
+    c42 += b42;
+
+    mX[i] = upd ? xk[i] : mX[i];
+    mP[kY][i] += upd ? dY : value_t(0);
+    mP[kZ][i] += upd ? dZ : value_t(0);
+    mP[kSnp][i] += upd ? x2r[i] : value_t(0);
+  }
+  checkCovariance(updated);
+}
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+template <bool CorrYZ>
+inline void TrackParCovBlock<value_T, N>::getPredictedChi2(const value_t* y, const value_t* z, const value_t* sy2, const value_t* syz, const value_t* sz2, value_t* chi2) const
+{
+  // see TrackParametrizationWithError::getPredictedChi2
+  for (int i = 0; i < N; i++) {
+    auto sdd = static_cast<double>(mC[kSigY2][i]) + static_cast<double>(sy2[i]);
+    auto sdz = static_cast<double>(mC[kSigZY][i]);
+    if constexpr (CorrYZ) {
+      sdz += static_cast<double>(syz[i]);
+    }
+    auto szz = static_cast<double>(mC[kSigZ2][i]) + static_cast<double>(sz2[i]);
+    auto det = sdd * szz - sdz * sdz;
+    bool ok = mValid[i] & (gpu::CAMath::Abs(det) >= constants::math::Almost0);
+    det = ok ? det : 1.;
+    value_t d = mP[kY][i] - y[i];
+    value_t dz = mP[kZ][i] - z[i];
+    value_t res = (d * (szz * d - sdz * dz) + dz * (sdd * dz - d * sdz)) / det;
+    chi2[i] = ok ? res : constants::math::VeryBig;
+  }
+}
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+template <bool CorrYZ>
+inline void TrackParCovBlock<value_T, N>::update(const value_t* y, const value_t* z, const value_t* sy2, const value_t* syz, const value_t* sz2, value_t* chi2)
+{
+  // update with the space point y, z having the covariance matrix sy2, syz, sz2, see TrackParametrizationWithError::update
+  if (chi2) {
+    value_t chi2Pred[N];
+    getPredictedChi2<CorrYZ>(y, z, sy2, syz, sz2, chi2Pred);
+    for (int i = 0; i < N; i++) {
+      chi2[i] += mValid[i] ? chi2Pred[i] : value_t(0);
+    }
+  }
+  bool updated[N];
+  for (int i = 0; i < N; i++) {
+    value_t &cm00 = mC[kSigY2][i], &cm10 = mC[kSigZY][i], &cm11 = mC[kSigZ2][i], &cm20 = mC[kSigSnpY][i], &cm21 = mC[kSigSnpZ][i],
+            &cm22 = mC[kSigSnp2][i], &cm30 = mC[kSigTglY][i], &cm31 = mC[kSigTglZ][i], &cm32 = mC[kSigTglSnp][i], &cm33 = mC[kSigTgl2][i],
+            &cm40 = mC[kSigQ2PtY][i], &cm41 = mC[kSigQ2PtZ][i], &cm42 = mC[kSigQ2PtSnp][i], &cm43 = mC[kSigQ2PtTgl][i],
+            &cm44 = mC[kSigQ2Pt2][i];
+
+    double r00 = static_cast<double>(sy2[i]) + static_cast<double>(cm00);
+    double r01 = static_cast<double>(cm10);
+    if constexpr (CorrYZ) {
+      r01 += static_cast<double>(syz[i]);
+    }
+    double r11 = static_cast<double>(sz2[i]) + static_cast<double>(cm11);
+    double det = r00 * r11 - r01 * r01;
+    bool ok = mValid[i] & (gpu::CAMath::Abs(det) >= constants::math::Almost0);
+    double detI = 1. / (ok ? det : 1.);
+    double tmp = r00;
+    r00 = r11 * detI;
+    r11 = tmp * detI;
+    r01 = -r01 * detI;
+
+    double k00 = cm00 * r00 + cm10 * r01, k01 = cm00 * r01 + cm10 * r11;
+    double k10 = cm10 * r00 + cm11 * r01, k11 = cm10 * r01 + cm11 * r11;
+    double k20 = cm20 * r00 + cm21 * r01, k21 = cm20 * r01 + cm21 * r11;
+    double k30 = cm30 * r00 + cm31 * r01, k31 = cm30 * r01 + cm31 * r11;
+    double k40 = cm40 * r00 + cm41 * r01, k41 = cm40 * r01 + cm41 * r11;
+
+    value_t dy = y[i] - mP[kY][i], dz = z[i] - mP[kZ][i];
+    value_t dsnp = k20 * dy + k21 * dz;
+    ok = ok & (gpu::CAMath::Abs(mP[kSnp][i] + dsnp) <= constants::math::Almost1);
+    mValid[i] = updated[i] = ok;
+    double gain = ok ? 1. : 0.; // null gain for the lanes which are not updated
+    k00 *= gain;
+    k01 *= gain;
+    k10 *= gain;
+    k11 *= gain;
+    k20 *= gain;
+    k21 *= gain;
+    k30 *= gain;
+    k31 *= gain;
+    k40 *= gain;
+    k41 *= gain;
+    dsnp = ok ? dsnp : value_t(0);
+    mP[kY][i] += value_t(k00 * dy + k01 * dz);
+    mP[kZ][i] += value_t(k10 * dy + k11 * dz);
+    mP[kSnp][i] += dsnp;
+    mP[kTgl][i] += value_t(k30 * dy + k31 * dz);
+    mP[kQ2Pt][i] += value_t(k40 * dy + k41 * dz);
+
+    double c01 = cm10, c02 = cm20, c03 = cm30, c04 = cm40;
+    double c12 = cm21, c13 = cm31, c14 = cm41;
+
+    cm00 -= k00 * cm00 + k01 * cm10;
+    cm10 -= k00 * c01 + k01 * cm11;
+    cm20 -= k00 * c02 + k01 * c12;
+    cm30 -= k00 * c03 + k01 * c13;
+    cm40 -= k00 * c04 + k01 * c14;
+
+    cm11 -= k10 * c01 + k11 * cm11;
+    cm21 -= k10 * c02 + k11 * c12;
+    cm31 -= k10 * c03 + k11 * c13;
+    cm41 -= k10 * c04 + k11 * c14;
+
+    cm22 -= k20 * c02 + k21 * c12;
+    cm32 -= k20 * c03 + k21 * c13;
+    cm42 -= k20 * c04 + k21 * c14;
+
+    cm33 -= k30 * c03 + k31 * c13;
+    cm43 -= k30 * c04 + k31 * c14;
+
+    cm44 -= k40 * c04 + k41 * c14;
+  }
+  checkCovariance(updated);
+}
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+inline auto TrackParCovBlock<value_T, N>::limitDiag(value_t& diag, value_t maxDiag, bool updated) -> value_t
+{
+  // force the diagonal element of an updated lane to be positive and below maxDiag, return the scaling of the corresponding off-diagonal elements
+  value_t absDiag = gpu::CAMath::Abs(diag);
+  bool limit = updated & (absDiag > maxDiag);
+  value_t scl = limit ? gpu::CAMath::Sqrt(maxDiag / absDiag) : value_t(1);
+  diag = limit ? maxDiag : (updated ? absDiag : diag);
+  return scl;
+}
+
+//__________________________________________________________________________
+template <typename value_T, int N>
+inline void TrackParCovBlock<value_T, N>::checkCovariance(const bool* updated)
+{
+  // see TrackParametrizationWithError::checkCovariance, applied to the updated lanes
+  for (int i = 0; i < N; i++) {
+    value_t scl = limitDiag(mC[kSigY2][i], kCY2max, updated[i]);
+    mC[kSigZY][i] *= scl;
+    mC[kSigSnpY][i] *= scl;
+    mC[kSigTglY][i] *= scl;
+    mC[kSigQ2PtY][i] *= scl;
+    scl = limitDiag(mC[kSigZ2][i], kCZ2max, updated[i]);
+    mC[kSigZY][i] *= scl;
+    mC[kSigSnpZ][i] *= scl;
+    mC[kSigTglZ][i] *= scl;
+    mC[kSigQ2PtZ][i] *= scl;
+    scl = limitDiag(mC[kSigSnp2][i], kCSnp2max, updated[i]);
+    mC[kSigSnpY][i] *= scl;
+    mC[kSigSnpZ][i] *= scl;
+    mC[kSigTglSnp][i] *= scl;
+    mC[kSigQ2PtSnp][i] *= scl;
+    scl = limitDiag(mC[kSigTgl2][i], kCTgl2max, updated[i]);
+    mC[kSigTglY][i] *= scl;
+    mC[kSigTglZ][i] *= scl;
+    mC[kSigTglSnp][i] *= scl;
+    mC[kSigQ2PtTgl][i] *= scl;
+    scl = limitDiag(mC[kSigQ2Pt2][i], kC1Pt2max, updated[i]);
+    mC[kSigQ2PtY][i] *= scl;
+    mC[kSigQ2PtZ][i] *= scl;
+    mC[kSigQ2PtSnp][i] *= scl;
+    mC[kSigQ2PtTgl][i] *= scl;
+  }
+}
+
+} // namespace track
+} // namespace o2
+
+#endif /* INCLUDE_RECONSTRUCTIONDATAFORMATS_TRACKPARCOVBLOCK_H_ */
@@ -0,0 +1,99 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TrackParCovBlock class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "ReconstructionDataFormats/Track.h"
+#include "ReconstructionDataFormats/TrackParCovBlock.h"
+#include <array>
+#include <cmath>
+#include <random>
+
+namespace o2
+{
+using namespace o2::track;
+
+// the batched rotation, propagation and update must reproduce the scalar ones lane by lane
+BOOST_AUTO_TEST_CASE(TrackParCovBlock)
+{
+  constexpr int N = 8;
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> rnd(-1.f, 1.f);
+  auto isClose = [](float v, float vRef) { return std::abs(v - vRef) <= 1e-4f * std::abs(vRef) + 1e-9f; }; // allow for FMA contractions
+  int nFailed = 0, nOK = 0;
+  for (int iter = 0; iter < 200; iter++) {
+    std::array<TrackParCov, N> trc, ref;
+    std::array<bool, N> refOK;
+    for (int i = 0; i < N; i++) {
+      std::array<float, 5> par = {2.f * rnd(gen), 10.f * rnd(gen), 0.9f * rnd(gen), rnd(gen), (iter % 3 ? 5.f : 50.f) * rnd(gen)};
+      std::array<float, 5> sig2 = {1e-2f, 1e-2f, 1e-3f, 1e-3f, 1e-1f};
+      std::array<float, 15> cov;
+      for (int a = 0, k = 0; a < 5; a++) {
+        for (int b = 0; b <= a; b++, k++) {
+          cov[k] = a == b ? sig2[a] * (1.f + 0.5f * rnd(gen)) : 0.3f * rnd(gen) * std::sqrt(sig2[a] * sig2[b]);
+        }
+      }
+      ref[i] = trc[i] = TrackParCov(3.f + rnd(gen), 3.f * rnd(gen), par, cov, i == 3 ? 0 : 1);
+      refOK[i] = true;
+    }
+    o2::track::TrackParCovBlock<float, N> blk;
+    BOOST_CHECK(blk.load(trc.data(), N) == N);
+    float alpha[N], xk[N], y[N], z[N], sy2[N], syz[N], sz2[N], chi2[N] = {}, chi2Ref[N] = {};
+    for (int step = 0; step < 6; step++) {
+      for (int i = 0; i < N; i++) {
+        alpha[i] = ref[i].getAlpha() + 0.3f * rnd(gen);
+        xk[i] = ref[i].getX() + (i == 5 ? 0.f : 25.f + 20.f * rnd(gen));
+        y[i] = ref[i].getY() + 0.05f * rnd(gen);
+        z[i] = ref[i].getZ() + 0.05f * rnd(gen);
+        sy2[i] = 1e-4f;
+        syz[i] = step % 2 ? 2e-5f : 0.f;
+        sz2[i] = 2e-4f;
+      }
+      for (int i = 0; i < N; i++) {
+        refOK[i] = refOK[i] && ref[i].rotate(alpha[i]) && ref[i].propagateTo(xk[i], 5.f);
+        if (refOK[i]) {
+          std::array<float, 2> p = {y[i], z[i]};
+          std::array<float, 3> c = {sy2[i], syz[i], sz2[i]};
+          chi2Ref[i] += ref[i].getPredictedChi2(p, c);
+          refOK[i] = ref[i].update(p, c);
+        }
+      }
+      blk.rotate(alpha);
+      blk.propagateTo(xk, 5.f);
+      if (step % 2) {
+        blk.update<true>(y, z, sy2, syz, sz2, chi2);
+      } else {
+        blk.update<false>(y, z, sy2, nullptr, sz2, chi2);
+      }
+    }
+    for (int i = 0; i < N; i++) {
+      BOOST_CHECK(blk.store(i, trc[i]) == refOK[i]);
+      if (!refOK[i]) {
+        nFailed++;
+        continue;
+      }
+      nOK++;
+      BOOST_CHECK(isClose(trc[i].getX(), ref[i].getX()));
+      BOOST_CHECK(isClose(trc[i].getAlpha(), ref[i].getAlpha()));
+      BOOST_CHECK(isClose(chi2[i], chi2Ref[i]));
+      for (int k = 0; k < 5; k++) {
+        BOOST_CHECK(isClose(trc[i].getParam(k), ref[i].getParam(k)));
+      }
+      for (int k = 0; k < 15; k++) {
+        BOOST_CHECK(isClose(trc[i].getCov()[k], ref[i].getCov()[k]));
+      }
+    }
+  }
+  BOOST_CHECK(nOK > 0 && nFailed > 0); // both the successful and the failing lanes are tested
+}
+} // namespace o2
@@ -17,6 +17,8 @@
 #include "CommonConstants/LHCConstants.h"
 #include <bitset>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 namespace o2
 {
@@ -32,6 +34,7 @@ class BunchFilling
   const auto& getPattern() const { return mPattern; }
   int getFirstFilledBC() const;
   int getLastFilledBC() const;
+  std::vector<uint16_t> getFilledBCs() const; // filled BCs in increasing order
   // set BC filling a la TPC TDR, 12 50ns trains of 48 BCs
   // but instead of uniform train spacing we add 96empty BCs after each train
   void setDefault()
@@ -38,6 +38,19 @@ int BunchFilling::getLastFilledBC() const
   return -1;
 }
 
+//_________________________________________________
+std::vector<uint16_t> BunchFilling::getFilledBCs() const
+{
+  std::vector<uint16_t> bcs;
+  bcs.reserve(getNBunches());
+  for (int bc = 0; bc < o2::constants::lhc::LHCMaxBunches; bc++) {
+    if (testBC(bc)) {
+      bcs.push_back(bc);
+    }
+  }
+  return bcs;
+}
+
 //_________________________________________________
 void BunchFilling::setBC(int bcID, bool active)
 {
@@ -0,0 +1,395 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CompactMCLabelContainer.h
+/// \brief A compact, read-only version of MCTruthContainer<MCCompLabel> with delta-encoded labels
+
+#ifndef O2_COMPACTMCLABELCONTAINER_H
+#define O2_COMPACTMCLABELCONTAINER_H
+
+#include "SimulationDataFormat/MCTruthContainer.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+#include <gsl/span>
+#ifndef GPUCA_STANDALONE
+#include <Framework/Traits.h>
+#endif
+
+namespace o2
+{
+namespace dataformats
+{
+
+/// The flat layout of the compact label containers
+///
+/// Labels are split into a key, holding all but the track ID and the fake flag (i.e. the source and event),
+/// and the track ID. The distinct keys are stored once; each label is a variable length integer in a byte
+/// stream holding either the difference of the track ID to the previous label, if it has the same key,
+/// or the track ID followed by the index of the key. The first label of every block of kBlockSize labels
+/// is never delta coded, so that the decoding can start at any block. The number of labels per data index
+/// is run-length encoded: runs of consecutive indices with the same number of labels are stored once.
+///
+/// buffer: [CompactMCLabelFlatHeader][keys: uint64_t x nofKeys][runs: Run x nofRuns][blocks: uint32_t x nofBlocks][data]
+struct CompactMCLabelFlatHeader {
+  static constexpr uint32_t kBlockSize = 32; // number of labels per seek block
+
+  // the number of labels per index of a run follows from the next run (or from the totals for the last one)
+  struct Run {
+    uint32_t firstIndex;   // the first data index of the run
+    uint32_t firstElement; // the first label of the first index
+  };
+
+  uint8_t version = 1;
+  uint8_t reserved0 = 0;
+  uint16_t reserved1 = 0;
+  uint32_t nofHeaderElements = 0; // number of data indices
+  uint32_t nofTruthElements = 0;  // number of labels
+  uint32_t nofKeys = 0;           // number of distinct source/event keys
+  uint32_t nofRuns = 0;           // number of runs of indices with the same number of labels
+  uint32_t nofBlocks = 0;         // number of seek blocks
+  uint32_t dataSize = 0;          // size of the label byte stream
+  uint32_t reserved2 = 0;
+};
+
+namespace compact_labels
+{
+static constexpr ULong64_t FakeBit = ULong64_t(1) << 63;
+static constexpr ULong64_t KeyMask = ~(MCCompLabel::maskTrackID | FakeBit);
+
+inline void putVarint(std::vector<uint8_t>& data, uint64_t value)
+{
+  while (value >= 0x80) {
+    data.push_back(uint8_t(value) | 0x80);
+    value >>= 7;
+  }
+  data.push_back(uint8_t(value));
+}
+
+inline uint64_t getVarint(const uint8_t*& ptr)
+{
+  uint64_t value = 0;
+  int shift = 0;
+  while (*ptr & 0x80) {
+    value |= uint64_t(*ptr++ & 0x7f) << shift;
+    shift += 7;
+  }
+  value |= uint64_t(*ptr++) << shift;
+  return value;
+}
+
+inline uint64_t zigzag(int64_t v) { return (uint64_t(v) << 1) ^ uint64_t(v >> 63); }
+inline int64_t unzigzag(uint64_t v) { return int64_t(v >> 1) ^ -int64_t(v & 1); }
+} // namespace compact_labels
+
+/// sequential decoder of the labels of a compact buffer
+class CompactMCLabelDecoder
+{
+ public:
+  CompactMCLabelDecoder() = default;
+  CompactMCLabelDecoder(const uint64_t* keys, const uint8_t* ptr) : mKeys(keys), mPtr(ptr) {}
+
+  /// decodes the next label
+  MCCompLabel next()
+  {
+    const auto value = compact_labels::getVarint(mPtr);
+    if (value & 0x1) {
+      mTrack = value >> 2;
+      mKey = mKeys[compact_labels::getVarint(mPtr)];
+    } else {
+      mTrack += compact_labels::unzigzag(value >> 2);
+    }
+    return MCCompLabel::fromRawValue(mKey | mTrack | ((value & 0x2) ? compact_labels::FakeBit : 0));
+  }
+
+ private:
+  const uint64_t* mKeys = nullptr;
+  const uint8_t* mPtr = nullptr;
+  uint64_t mKey = 0;
+  uint64_t mTrack = 0;
+};
+
+class CompactMCLabelRange;
+
+/// @class CompactMCLabelContainerView
+/// @brief A read-only "view" on a compact label buffer, not owning the storage (similar to ConstMCTruthContainerView)
+///
+/// The buffer is created with compact_to from a MCTruthContainer<MCCompLabel> (or any label container
+/// providing getIndexedSize and getLabels), it can be sent as it is and accessed in the message memory.
+class CompactMCLabelContainerView
+{
+ public:
+  using FlatHeader = CompactMCLabelFlatHeader;
+
+  CompactMCLabelContainerView() = default;
+  CompactMCLabelContainerView(gsl::span<const char> const bufferview) : mStorage(bufferview) {}
+  CompactMCLabelContainerView(const CompactMCLabelContainerView&) = default;
+
+  // return the number of original data indexed here
+  size_t getIndexedSize() const { return isValid() ? getHeader().nofHeaderElements : 0; }
+
+  // return the number of labels managed in this container
+  size_t getNElements() const { return isValid() ? getHeader().nofTruthElements : 0; }
+
+  // get a decoding "view" on the labels for a given data index
+  CompactMCLabelRange getLabels(uint32_t dataindex) const;
+
+  // access an individual label, given its index in the label storage
+  MCCompLabel getElement(uint32_t elementindex) const
+  {
+    auto decoder = getDecoder(elementindex);
+    MCCompLabel label = decoder.next();
+    for (auto i = elementindex % FlatHeader::kBlockSize; i > 0; --i) {
+      label = decoder.next();
+    }
+    return label;
+  }
+
+  // returns a decoder positioned at the start of the block of the given label
+  CompactMCLabelDecoder getDecoder(uint32_t elementindex) const
+  {
+    return CompactMCLabelDecoder(getKeys(), getData() + getBlocks()[elementindex / FlatHeader::kBlockSize]);
+  }
+
+  // expands the labels into a regular container
+  void expand_to(MCTruthContainer<MCCompLabel>& container) const;
+
+  // return underlying buffer
+  const gsl::span<const char>& getBuffer() const { return mStorage; }
+
+ private:
+  gsl::span<const char> mStorage;
+
+  bool isValid() const { return (size_t)mStorage.size() >= sizeof(FlatHeader); }
+  FlatHeader const& getHeader() const { return *reinterpret_cast<FlatHeader const*>(mStorage.data()); }
+  uint64_t const* getKeys() const { return reinterpret_cast<uint64_t const*>(mStorage.data() + sizeof(FlatHeader)); }
+  FlatHeader::Run const* getRuns() const { return reinterpret_cast<FlatHeader::Run const*>(getKeys() + getHeader().nofKeys); }
+  uint32_t const* getBlocks() const { return reinterpret_cast<uint32_t const*>(getRuns() + getHeader().nofRuns); }
+  uint8_t const* getData() const { return reinterpret_cast<uint8_t const*>(getBlocks() + getHeader().nofBlocks); }
+};
+
+/// A "view" on the labels of one data index, decoding them on the fly (the equivalent of the span
+/// returned by the other label containers, labels are returned by value)
+class CompactMCLabelRange
+{
+ public:
+  class iterator
+  {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = MCCompLabel;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const MCCompLabel*;
+    using reference = MCCompLabel;
+
+    iterator() = default;
+    iterator(CompactMCLabelDecoder decoder, uint32_t element, uint32_t end) : mDecoder(decoder), mElement(element), mEnd(end)
+    {
+      if (mElement < mEnd) {
+        mLabel = mDecoder.next();
+      }
+    }
+    MCCompLabel operator*() const { return mLabel; }
+    pointer operator->() const { return &mLabel; }
+    iterator& operator++()
+    {
+      if (++mElement < mEnd) {
+        mLabel = mDecoder.next();
+      }
+      return *this;
+    }
+    iterator operator++(int)
+    {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    bool operator==(const iterator& other) const { return mElement == other.mElement; }
+    bool operator!=(const iterator& other) const { return mElement != other.mElement; }
+
+   private:
+    CompactMCLabelDecoder mDecoder;
+    uint32_t mElement = 0;
+    uint32_t mEnd = 0;
+    MCCompLabel mLabel;
+  };
+
+  CompactMCLabelRange() = default;
+  CompactMCLabelRange(CompactMCLabelContainerView const& view, uint32_t first, uint32_t size) : mView(view), mFirst(first), mSize(size) {}
+
+  size_t size() const { return mSize; }
+  bool empty() const { return mSize == 0; }
+  iterator begin() const;
+  iterator end() const { return iterator(CompactMCLabelDecoder(), mFirst + mSize, mFirst + mSize); }
+  /// random access, decoding from the start of the block of the label
+  MCCompLabel operator[](size_t i) const;
+  /// decodes all the labels at once
+  std::vector<MCCompLabel> toVector() const { return std::vector<MCCompLabel>(begin(), end()); }
+
+ private:
+  CompactMCLabelContainerView mView; // the view on the buffer the labels belong to
+  uint32_t mFirst = 0;               // the first label
+  uint32_t mSize = 0;                // the number of labels
+};
+
+inline CompactMCLabelRange CompactMCLabelContainerView::getLabels(uint32_t dataindex) const
+{
+  if (dataindex >= getIndexedSize()) {
+    return CompactMCLabelRange();
+  }
+  const auto runs = getRuns();
+  const auto& header = getHeader();
+  // the last run starting at or before dataindex
+  auto run = std::upper_bound(runs, runs + header.nofRuns, dataindex, [](uint32_t i, FlatHeader::Run const& r) { return i < r.firstIndex; }) - 1;
+  const auto [endIndex, endElement] = (run + 1 < runs + header.nofRuns) ? std::make_pair(run[1].firstIndex, run[1].firstElement)
+                                                                        : std::make_pair(header.nofHeaderElements, header.nofTruthElements);
+  const uint32_t nLabels = (endElement - run->firstElement) / (endIndex - run->firstIndex);
+  return CompactMCLabelRange(*this, run->firstElement + (dataindex - run->firstIndex) * nLabels, nLabels);
+}
+
+inline CompactMCLabelRange::iterator CompactMCLabelRange::begin() const
+{
+  if (mSize == 0) {
+    return end();
+  }
+  auto decoder = mView.getDecoder(mFirst);
+  // skip the labels of the block preceding the first one
+  for (auto i = mFirst % CompactMCLabelFlatHeader::kBlockSize; i > 0; --i) {
+    decoder.next();
+  }
+  return iterator(decoder, mFirst, mFirst + mSize);
+}
+
+inline MCCompLabel CompactMCLabelRange::operator[](size_t i) const
+{
+  return mView.getElement(mFirst + i);
+}
+
+inline void CompactMCLabelContainerView::expand_to(MCTruthContainer<MCCompLabel>& container) const
+{
+  container.clear();
+  for (uint32_t i = 0; i < getIndexedSize(); ++i) {
+    for (auto label : getLabels(i)) {
+      container.addElement(i, label);
+    }
+  }
+}
+
+/// @class CompactMCLabelContainer
+/// @brief Owning version of the compact label buffer, treated as a vector by DPL (like ConstMCTruthContainer)
+class CompactMCLabelContainer : public std::vector<char>
+{
+ public:
+  // (unfortunately we need these constructors for DPL)
+  using std::vector<char>::vector;
+  CompactMCLabelContainer() = default;
+
+  size_t getIndexedSize() const { return view().getIndexedSize(); }
+  size_t getNElements() const { return view().getNElements(); }
+  // note that the returned range refers to the storage of this container, which must not be modified as long as it is used
+  CompactMCLabelRange getLabels(uint32_t dataindex) const { return view().getLabels(dataindex); }
+  MCCompLabel getElement(uint32_t elementindex) const { return view().getElement(elementindex); }
+  void expand_to(MCTruthContainer<MCCompLabel>& container) const { view().expand_to(container); }
+
+  CompactMCLabelContainerView view() const { return CompactMCLabelContainerView(gsl::span<const char>(*this)); }
+};
+
+/// Writes the labels of a container (providing getIndexedSize and getLabels, e.g. MCTruthContainer<MCCompLabel>
+/// or ConstMCLabelContainerView) in the compact layout into a vector-like container of chars.
+/// Returns the size of the compact buffer.
+template <typename LabelContainer, typename ContainerType>
+size_t compact_to(LabelContainer const& labels, ContainerType& container)
+{
+  using FlatHeader = CompactMCLabelFlatHeader;
+  FlatHeader header;
+  std::vector<uint64_t> keys;
+  std::unordered_map<uint64_t, uint32_t> keyIndices;
+  std::vector<FlatHeader::Run> runs;
+  std::vector<uint32_t> blocks;
+  std::vector<uint8_t> data;
+
+  uint32_t element = 0;
+  uint32_t runLabels = 0; // the number of labels per index of the current run
+  uint32_t prevKeyIndex = 0;
+  uint64_t prevTrack = 0;
+  header.nofHeaderElements = labels.getIndexedSize();
+  for (uint32_t i = 0; i < header.nofHeaderElements; ++i) {
+    const auto indexLabels = labels.getLabels(i);
+    const uint32_t nLabels = indexLabels.size();
+    if (runs.empty() || runLabels != nLabels) {
+      runs.push_back(FlatHeader::Run{i, element});
+      runLabels = nLabels;
+    }
+    for (auto const& label : indexLabels) {
+      const auto raw = label.getRawValue();
+      const uint64_t track = raw & MCCompLabel::maskTrackID;
+      const uint64_t fake = (raw & compact_labels::FakeBit) ? 0x2 : 0x0;
+      auto [it, isNew] = keyIndices.emplace(raw & compact_labels::KeyMask, keys.size());
+      if (isNew) {
+        keys.push_back(raw & compact_labels::KeyMask);
+      }
+      const bool blockStart = element % FlatHeader::kBlockSize == 0;
+      if (blockStart) {
+        blocks.push_back(data.size());
+      }
+      if (!blockStart && it->second == prevKeyIndex) {
+        compact_labels::putVarint(data, (compact_labels::zigzag(int64_t(track) - int64_t(prevTrack)) << 2) | fake);
+      } else {
+        compact_labels::putVarint(data, (track << 2) | fake | 0x1);
+        compact_labels::putVarint(data, it->second);
+      }
+      prevKeyIndex = it->second;
+      prevTrack = track;
+      element++;
+    }
+  }
+  header.nofTruthElements = element;
+  header.nofKeys = keys.size();
+  header.nofRuns = runs.size();
+  header.nofBlocks = blocks.size();
+  header.dataSize = data.size();
+
+  const size_t bufferSize = sizeof(FlatHeader) + keys.size() * sizeof(uint64_t) + runs.size() * sizeof(FlatHeader::Run) +
+                            blocks.size() * sizeof(uint32_t) + data.size();
+  container.resize(bufferSize);
+  auto target = reinterpret_cast<char*>(container.data());
+  auto write = [&target](const void* source, size_t size) {
+    if (size > 0) {
+      std::memcpy(target, source, size);
+      target += size;
+    }
+  };
+  write(&header, sizeof(FlatHeader));
+  write(keys.data(), keys.size() * sizeof(uint64_t));
+  write(runs.data(), runs.size() * sizeof(FlatHeader::Run));
+  write(blocks.data(), blocks.size() * sizeof(uint32_t));
+  write(data.data(), data.size());
+  return bufferSize;
+}
+
+} // namespace dataformats
+} // namespace o2
+
+// This is done so that DPL treats this container as a vector (as for ConstMCTruthContainer)
+#ifndef GPUCA_STANDALONE
+namespace o2::framework
+{
+template <>
+struct is_specialization<o2::dataformats::CompactMCLabelContainer, std::vector> : std::true_type {
+};
+} // namespace o2::framework
+#endif
+
+#endif // O2_COMPACTMCLABELCONTAINER_H
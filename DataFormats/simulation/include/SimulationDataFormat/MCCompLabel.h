@@ -89,6 +89,13 @@ class MCCompLabel
 
   // allow to retrieve bare label
   ULong64_t getRawValue() const { return mLabel; }
+  // construct from a bare label value
+  static MCCompLabel fromRawValue(ULong64_t raw)
+  {
+    MCCompLabel label;
+    label.mLabel = raw;
+    return label;
+  }
 
   // comparison operator, compares only label, not eventual weight or correctness info
   bool operator==(const MCCompLabel& other) const { return (mLabel & maskFull) == (other.mLabel & maskFull); }
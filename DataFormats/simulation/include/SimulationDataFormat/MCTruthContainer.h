@@ -324,6 +324,43 @@ class MCTruthContainer
     }
   }
 
+  // number of truth elements associated with "n" entries starting from "from"
+  size_t getNElements(size_t from, size_t n) const
+  {
+    if (!n) {
+      return 0;
+    }
+    auto endIdx = from + n;
+    assert(endIdx <= mHeaderArray.size());
+    size_t last = (endIdx == mHeaderArray.size()) ? mTruthArray.size() : mHeaderArray[endIdx].index;
+    return last - mHeaderArray[from].index;
+  }
+
+  // resize the container to "nHeaders" entries and "nElements" truth elements, to be filled by copyAt
+  void resizeForCopy(size_t nHeaders, size_t nElements)
+  {
+    mHeaderArray.resize(nHeaders);
+    mTruthArray.resize(nElements);
+  }
+
+  // copy "n" entries starting from "from" of another container to the entries starting from "at" of this one, with
+  // their truth elements starting from "atElement". The space must be provided in advance by resizeForCopy.
+  // Since only the target range is modified, non-overlapping ranges can be filled concurrently
+  void copyAt(MCTruthContainer<TruthElement> const& other, size_t from, size_t n, size_t at, size_t atElement)
+  {
+    if (!n) {
+      return;
+    }
+    auto nElements = other.getNElements(from, n);
+    assert(at + n <= mHeaderArray.size() && atElement + nElements <= mTruthArray.size());
+    const auto firstElement = other.getMCTruthHeader(from).index;
+    long offset = long(atElement) - firstElement;
+    for (size_t i = 0; i < n; i++) {
+      mHeaderArray[at + i].index = other.mHeaderArray[from + i].index + offset;
+    }
+    std::copy(other.mTruthArray.begin() + firstElement, other.mTruthArray.begin() + firstElement + nElements, mTruthArray.begin() + atElement);
+  }
+
   /// Flatten the internal arrays to the provided container
   /// Copies the content of the two vectors of PODs to a contiguous container.
   /// The flattened data starts with a specific header @ref FlatHeader describing
@@ -229,6 +229,12 @@ class Stack : public FairGenericStack
 
   typedef std::function<bool(const TParticle& p, const std::vector<TParticle>& particles)> TransportFcn;
 
+  /// physics selection of the secondaries, decided when they are pushed from the flags of their mother
+  enum PhysicsFlags : char { kFromPrimaryDecayChain = 0x1, ///< from the decay chain of a primary
+                             kKeepPhysics = 0x2 };         ///< to be kept for physics analysis
+  /// PhysicsFlags of a secondary produced by proc, whose mother is a primary or has the PhysicsFlags motherFlags
+  static char getPhysicsFlags(bool motherIsPrimary, char motherFlags, TMCProcess proc);
+
  private:
   /// STL stack (FILO) used to handle the TParticles for tracking
   /// stack entries refer to
@@ -293,16 +299,26 @@ class Stack : public FairGenericStack
   /// a pointer to the current MCEventStats object
   o2::dataformats::MCEventStats* mMCEventStats = nullptr; //!
 
+  std::vector<char> mPhysicsFlags; //! PhysicsFlags of each entry of mParticles
+
+  // work buffers of FinishPrimary and ReorderKine, reused for all the primaries
+  std::vector<MCTrack> mTmpTracks;       //!
+  std::vector<int> mIndicesKept;         //!
+  std::vector<int> mReorderedIndices;    //!
+  std::vector<int> mInvReorderedIndices; //!
+  std::vector<int> mDaughtersStart;      //!
+  std::vector<int> mDaughters;           //!
+
   /// Mark tracks for output using selection criteria
   /// returns true if all available tracks are selected
   /// returns false if some tracks are discarded
   bool selectTracks();
 
   bool isPrimary(const MCTrack& part);
-  bool isFromPrimaryDecayChain(const MCTrack& part);
-  bool isFromPrimaryPairProduction(const MCTrack& part);
 
-  bool keepPhysics(const MCTrack& part);
+  char getPhysicsFlags(int parentId, TMCProcess proc) const;
+
+  bool keepPhysics(int entry) const { return mPhysicsFlags[entry] & kKeepPhysics; }
 
   Stack(const Stack&);
 
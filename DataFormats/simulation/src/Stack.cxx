@@ -213,11 +213,43 @@ void Stack::PushTrack(Int_t toBeDone, Int_t parentId, Int_t pdgCode, Double_t px
   //  Int_t daughter1Id = -1;
   //  Int_t daughter2Id = -1;
   Int_t iStatus = (proc == kPPrimary) ? is : trackId;
+
+  if (proc != kPPrimary) {
+    // Secondary: the output track is made directly from the arguments and the TParticle of
+    // the current secondary is refilled in place, no TParticle is constructed per secondary
+    auto& p = mCurrentParticle0;
+    p.SetMomentum(px, py, pz, e);
+    p.SetProductionVertex(vx, vy, vz, time);
+    p.SetPdgCode(pdgCode);
+    p.SetStatusCode(iStatus);
+    p.SetFirstMother(parentId);
+    p.SetLastMother(secondparentId);
+    p.SetFirstDaughter(daughter1Id);
+    p.SetLastDaughter(daughter2Id);
+    p.SetPolarisation(polx, poly, polz);
+    p.SetWeight(weight);
+    p.SetUniqueID(proc);
+    p.SetBit(ParticleStatus::kPrimary, 0);
+    p.SetBit(ParticleStatus::kToBeDone, toBeDone == 1 ? 1 : 0);
+    mNumberOfEntriesInParticles++;
+
+    insertInVector(mTrackIDtoParticlesEntry, trackId, (int)(mParticles.size()));
+    mPhysicsFlags.push_back(getPhysicsFlags(parentId, proc));
+    auto& track = mParticles.emplace_back(pdgCode, parentId, secondparentId, daughter1Id, daughter2Id, px, py, pz, vx, vy, vz, time * 1e09, 0);
+    track.setProcess(proc);
+    track.setToBeDone(toBeDone == 1);
+    // Geant4 keeps its own stack of secondaries, they are only popped from here by Geant3
+    if (!mIsG4Like) {
+      mStack.push(p);
+    }
+    return;
+  }
+
   TParticle p(pdgCode, iStatus, parentId, secondparentId, daughter1Id, daughter2Id, px, py, pz, e, vx, vy, vz, time);
   p.SetPolarisation(polx, poly, polz);
   p.SetWeight(weight);
   p.SetUniqueID(proc); // using the unique ID to transfer process ID
-  p.SetBit(ParticleStatus::kPrimary, proc == kPPrimary ? 1 : 0); // set primary bit
+  p.SetBit(ParticleStatus::kPrimary, 1);                         // set primary bit
   p.SetBit(ParticleStatus::kToBeDone, toBeDone == 1 ? 1 : 0);    // set to be done bit
   mNumberOfEntriesInParticles++;
 
@@ -225,36 +257,53 @@ void Stack::PushTrack(Int_t toBeDone, Int_t parentId, Int_t pdgCode, Double_t px
 
   handleTransportPrimary(p); // handle selective transport of primary particles
 
-  // Push particle on the stack if toBeDone is set
-  if (p.TestBit(ParticleStatus::kPrimary)) {
-    // This is a particle from the primary particle generator
-    //
-    // SetBit is used to pass information about the primary particle to the stack during transport.
-    // Sime particles have already decayed or are partons from a shower. They are needed for the
-    // event history in the stack, but not for transport.
-    //
-
-    // primary particles might have been pushed with a second creation process
-    // in case we pushed a secondary track of a previous simulation to be continued.
-    // We save therefore in the UniqueID the correct process
-    // while the particle will still be treated as a primary given its bit settings
-    p.SetUniqueID(proc2);
-
-    mIndexMap[trackId] = trackId;
-    p.SetBit(ParticleStatus::kKeep, 1);
-    if (p.TestBit(ParticleStatus::kToBeDone)) {
-      mNumberOfPrimariesforTracking++;
-    }
-    mNumberOfPrimaryParticles++;
-    mPrimaryParticles.push_back(p);
-    mTracks->emplace_back(p);
-  } else {
-    mParticles.emplace_back(p);
-    mCurrentParticle0 = p;
+  // This is a particle from the primary particle generator
+  //
+  // SetBit is used to pass information about the primary particle to the stack during transport.
+  // Sime particles have already decayed or are partons from a shower. They are needed for the
+  // event history in the stack, but not for transport.
+  //
+
+  // primary particles might have been pushed with a second creation process
+  // in case we pushed a secondary track of a previous simulation to be continued.
+  // We save therefore in the UniqueID the correct process
+  // while the particle will still be treated as a primary given its bit settings
+  p.SetUniqueID(proc2);
+
+  mIndexMap[trackId] = trackId;
+  p.SetBit(ParticleStatus::kKeep, 1);
+  if (p.TestBit(ParticleStatus::kToBeDone)) {
+    mNumberOfPrimariesforTracking++;
   }
+  mNumberOfPrimaryParticles++;
+  mPrimaryParticles.push_back(p);
+  mTracks->emplace_back(p);
   mStack.push(p);
 }
 
+char Stack::getPhysicsFlags(int parentId, TMCProcess proc) const
+{
+  // As the mother is pushed before its daughters, this is decided once per particle.
+  bool motherIsPrimary = parentId < mNumberOfPrimaryParticles;
+  return getPhysicsFlags(motherIsPrimary, motherIsPrimary ? 0 : mPhysicsFlags[mTrackIDtoParticlesEntry[parentId]], proc);
+}
+
+char Stack::getPhysicsFlags(bool motherIsPrimary, char motherFlags, TMCProcess proc)
+{
+  // Some particles have to kept on the stack for reasons motivated by physics analysis:
+  // the decay chain of the primaries and the pairs produced by the primaries or their decay chain.
+  if (!motherIsPrimary && !(motherFlags & kFromPrimaryDecayChain)) {
+    return 0;
+  }
+  if (proc == kPDecay) {
+    return kFromPrimaryDecayChain | kKeepPhysics;
+  }
+  if (proc == kPPair) {
+    return kKeepPhysics;
+  }
+  return 0;
+}
+
 void Stack::handleTransportPrimary(TParticle& p)
 {
   // this function tests whether we really want to transport
@@ -431,9 +480,10 @@ void Stack::FinishPrimary()
   int indexNew = 0;
   int indexoffset = mTracks->size();
   int neglected = 0;
-  std::vector<int> indicesKept((int)(mParticles.size()));
-  std::vector<MCTrack> tmpTracks;
-  Int_t ic = 0;
+  auto& indicesKept = mIndicesKept;
+  auto& tmpTracks = mTmpTracks;
+  indicesKept.resize(mParticles.size());
+  tmpTracks.clear();
 
   // mTrackIDtoParticlesEntry
   // trackID to mTrack -> index in mParticles
@@ -468,8 +518,10 @@ void Stack::FinishPrimary()
     mTracksDone++;
   }
   Int_t ntr = (int)(tmpTracks.size());
-  std::vector<int> reOrderedIndices(ntr);
-  std::vector<int> invreOrderedIndices(ntr);
+  auto& reOrderedIndices = mReorderedIndices;
+  auto& invreOrderedIndices = mInvReorderedIndices;
+  reOrderedIndices.resize(ntr);
+  invreOrderedIndices.resize(ntr);
   for (Int_t i = 0; i < ntr; i++) {
     invreOrderedIndices[i] = i;
     reOrderedIndices[i] = i;
@@ -515,13 +567,11 @@ void Stack::FinishPrimary()
     mIndexMap[idTrack] = index3 + indexoffset;
   }
 
-  // we can now clear the particles buffer!
-  reOrderedIndices.clear();
-  invreOrderedIndices.clear();
+  // we can now clear the particles buffer! The work buffers keep their capacity for the next primary
+  // and the stale entries of mTrackIDtoParticlesEntry are overwritten by the next track IDs
   mParticles.clear();
-  tmpTracks.clear();
+  mPhysicsFlags.clear();
   mTransportedIDs.clear();
-  mTrackIDtoParticlesEntry.clear();
   mIndexOfPrimaries.clear();
 }
 
@@ -557,15 +607,20 @@ void Stack::UpdateTrackIndex(TRefArray* detList)
 
   // update track references
   // use some caching since repeated trackIDs
+  int lastID = -1, lastNewID = -1;
   for (auto& ref : *mTrackRefs) {
     const auto id = ref.getTrackID();
-    auto iter = mIndexMap.find(id);
-    if (iter == mIndexMap.end()) {
-      LOG(INFO) << "Invalid trackref ... needs to be rmoved \n";
-      ref.setTrackID(-1);
-    } else {
-      ref.setTrackID(iter->second);
+    if (id != lastID || lastID < 0) {
+      auto iter = mIndexMap.find(id);
+      if (iter == mIndexMap.end()) {
+        LOG(INFO) << "Invalid trackref ... needs to be rmoved \n";
+        lastNewID = -1;
+      } else {
+        lastNewID = iter->second;
+      }
+      lastID = id;
     }
+    ref.setTrackID(lastNewID);
   }
 
   // sort trackrefs according to new track index
@@ -594,6 +649,7 @@ void Stack::Reset()
     mStack.pop();
   }
   mParticles.clear();
+  mPhysicsFlags.clear();
   mTracks->clear();
   if (!mIsExternalMode && (mPrimariesDone != mNumberOfPrimariesforTracking)) {
     LOG(FATAL) << "Inconsistency in primary particles treated " << mPrimariesDone << " vs expected "
@@ -671,12 +727,12 @@ bool Stack::selectTracks()
   // Check particles in the fParticle array
   int prim = -1; // counter how many primaries seen (mainly to constrain search in motherindex remapping)
   LOG(DEBUG) << "Stack: Entering track selection on " << mParticles.size() << " tracks";
-  for (auto& thisPart : mParticles) {
+  for (int entry = 0; entry < (int)mParticles.size(); entry++) {
+    auto& thisPart = mParticles[entry];
     Bool_t store = kTRUE;
     // Get track parameters
     Bool_t isPrimary = (thisPart.getProcess() == 0);
     Int_t iMother = thisPart.getMotherTrackId();
-    auto& mother = mParticles[iMother];
     Bool_t motherIsPrimary = (iMother < mNumberOfPrimaryParticles);
 
     if (isPrimary) {
@@ -717,7 +773,7 @@ bool Stack::selectTracks()
             tracksdiscarded = true;
           }
         }
-        if (keepPhysics(thisPart)) {
+        if (keepPhysics(entry)) {
           store = kTRUE;
           tracksdiscarded = false;
         }
@@ -729,18 +785,15 @@ bool Stack::selectTracks()
   }
 
   // If flag is set, flag recursively mothers of selected tracks
-  //
+  // the mothers precede their daughters, so a backward pass reaches all the ancestors
   if (mStoreMothers) {
-    for (auto& particle : mParticles) {
-      if (particle.getStore()) {
-        Int_t iMother = particle.getMotherTrackId();
-        while (iMother >= 0) {
-          auto& mother = mParticles[iMother];
-          mother.setStore(true);
-          iMother = mother.getMotherTrackId();
-        } // while mother
-      }   // store ?
-    }     // particle loop
+    for (int entry = (int)mParticles.size() - 1; entry >= 0; entry--) {
+      const auto& particle = mParticles[entry];
+      Int_t iMother = particle.getMotherTrackId();
+      if (particle.getStore() && iMother >= 0) {
+        mParticles[iMother].setStore(true);
+      }
+    }
   }
 
   return !tracksdiscarded;
@@ -756,65 +809,6 @@ bool Stack::isPrimary(const MCTrack& part)
   return false;
 }
 
-bool Stack::isFromPrimaryDecayChain(const MCTrack& part)
-{
-  /** check if the particle is from the 
-      decay chain of a primary particle **/
-
-  /** check if from decay **/
-  if (part.getProcess() != kPDecay) {
-    return false;
-  }
-  /** check if mother is primary **/
-  auto imother = part.getMotherTrackId();
-  auto mother = mParticles[imother];
-  if (isPrimary(mother)) {
-    return true;
-  }
-  /** else check if mother is from primary decay **/
-  return isFromPrimaryDecayChain(mother);
-}
-
-bool Stack::isFromPrimaryPairProduction(const MCTrack& part)
-{
-  /** check if the particle is from 
-      pair production from a particle
-      belonging to the primary decay chain **/
-
-  /** check if from pair production **/
-  if (part.getProcess() != kPPair) {
-    return false;
-  }
-  /** check if mother is primary **/
-  auto imother = part.getMotherTrackId();
-  auto mother = mParticles[imother];
-  if (isPrimary(mother)) {
-    return true;
-  }
-  /** else check if mother is from primary decay **/
-  return isFromPrimaryDecayChain(mother);
-}
-
-bool Stack::keepPhysics(const MCTrack& part)
-{
-  //
-  // Some particles have to kept on the stack for reasons motivated
-  // by physics analysis. Decision is put here.
-  //
-
-  if (isPrimary(part)) {
-    return true;
-  }
-  if (isFromPrimaryDecayChain(part)) {
-    return true;
-  }
-  if (isFromPrimaryPairProduction(part)) {
-    return true;
-  }
-
-  return false;
-}
-
 TClonesArray* Stack::GetListOfParticles()
 {
   LOG(FATAL) << "Stack::GetListOfParticles interface not implemented\n";
@@ -863,39 +857,48 @@ void Stack::ReorderKine(std::vector<MCTrack>& particles, std::vector<int>& reOrd
   // The result of the ordering is returned via the look-up table reOrderedIndices
   //
 
-  Int_t ntr = (int)(particles.size());
-  std::vector<bool> done(ntr, false);
+  // The daughters of each particle are grouped, in increasing index, with a counting sort on the
+  // mother index: slot 0 holds the daughters of the current primary, slot i + 1 those of particle i.
+  // Particles whose mother is not among the preceding ones are placed at their own position.
+  // This gives the same order as appending, for the primary and then for each particle in turn,
+  // the daughters not yet placed, in linear time.
 
+  Int_t ntr = (int)(particles.size());
   int indexoffset = mTracks->size();
-  Int_t index = 0;
-  Int_t imoOld = 0;
+  const Int_t imoPrimary = mIndexOfCurrentPrimary - indexoffset;
+  auto slot = [&](Int_t i) {
+    Int_t imo = particles[i].getMotherTrackId();
+    return imo == imoPrimary ? 0 : ((imo >= 0 && imo < i) ? imo + 1 : -1);
+  };
+
+  mDaughtersStart.assign(ntr + 2, 0);
   for (Int_t i = 0; i < ntr; i++) {
-    reOrderedIndices[i] = i;
+    auto s = slot(i);
+    if (s >= 0) {
+      mDaughtersStart[s + 1]++;
+    }
+  }
+  for (Int_t s = 0; s <= ntr; s++) {
+    mDaughtersStart[s + 1] += mDaughtersStart[s];
+  }
+  mDaughters.resize(mDaughtersStart[ntr + 1]);
+  for (Int_t i = 0; i < ntr; i++) {
+    auto s = slot(i);
+    if (s >= 0) {
+      mDaughters[mDaughtersStart[s]++] = i;
+    }
   }
+  // mDaughtersStart[s] is now the end of slot s, i.e. the start of slot s + 1
 
-  for (Int_t i = -1; i < ntr; i++) {
-    if (i != -1) {
-      // secondaries
-      if (!done[i]) {
-        reOrderedIndices[index] = i;
-        index++;
-        done[i] = true;
-      }
-      imoOld = i;
-    } else {
-      // current primary
-      imoOld = mIndexOfCurrentPrimary - indexoffset;
+  Int_t index = 0;
+  for (Int_t s = 0, first = 0; s <= ntr; first = mDaughtersStart[s], s++) {
+    if (s > 0 && slot(s - 1) < 0) {
+      reOrderedIndices[index++] = s - 1;
     }
-    for (Int_t j = i + 1; j < ntr; j++) {
-      if (!done[j]) {
-        if ((particles[j]).getMotherTrackId() == imoOld) {
-          reOrderedIndices[index] = j;
-          index++;
-          done[j] = true;
-        } // child found
-      }   // done
-    }     // j
-  }       // i
+    for (Int_t k = first; k < mDaughtersStart[s]; k++) {
+      reOrderedIndices[index++] = mDaughters[k];
+    }
+  }
 }
 
 FairGenericStack* Stack::CloneStack() const { return new o2::data::Stack(*this); }
@@ -23,6 +23,8 @@
 #include "TFile.h"
 #include "TParticle.h"
 #include "TMCProcess.h"
+#include <functional>
+#include <vector>
 
 using namespace o2;
 
@@ -93,3 +95,54 @@ BOOST_AUTO_TEST_CASE(Stack_test)
     BOOST_CHECK(inst->getPrimaries().size() == 2);
   }
 }
+
+// the physics selection decided when pushing the secondaries must be the one of the former recursive walk
+BOOST_AUTO_TEST_CASE(Stack_physics_selection)
+{
+  struct Particle {
+    int mother;
+    TMCProcess proc;
+  };
+  // 2 primaries followed by their secondaries, each one after its mother
+  const std::vector<Particle> tree{
+    {-1, kPPrimary}, {-1, kPPrimary},                      // 0, 1
+    {0, kPDecay}, {0, kPDeltaRay}, {0, kPHadronic},        // 2, 3, 4: daughters of a primary
+    {1, kPPair}, {1, kPCompton},                           // 5, 6
+    {2, kPDecay}, {2, kPPair}, {2, kPDeltaRay},            // 7, 8, 9: daughters of a decay daughter
+    {3, kPDecay}, {3, kPPair}, {4, kPDecay},               // 10, 11, 12: daughters of non selected ones
+    {5, kPDecay}, {5, kPPair},                             // 13, 14: daughters of a pair
+    {7, kPDecay}, {7, kPPair}, {8, kPDecay}, {10, kPPair}, // 15, 16, 17, 18
+  };
+  const std::vector<bool> expected{true, true, true, false, false, true, false, true, true, false,
+                                   false, false, false, false, false, true, true, false, false};
+
+  // former recursive selection
+  std::function<bool(int)> isFromPrimaryDecayChain = [&](int i) {
+    if (tree[i].proc != kPDecay) {
+      return false;
+    }
+    int mother = tree[i].mother;
+    return tree[mother].mother < 0 || isFromPrimaryDecayChain(mother);
+  };
+  auto isFromPrimaryPairProduction = [&](int i) {
+    if (tree[i].proc != kPPair) {
+      return false;
+    }
+    int mother = tree[i].mother;
+    return tree[mother].mother < 0 || isFromPrimaryDecayChain(mother);
+  };
+
+  std::vector<char> flags(tree.size(), 0);
+  for (int i = 0; i < (int)tree.size(); i++) {
+    bool isPrimary = tree[i].mother < 0;
+    bool reference = isPrimary || isFromPrimaryDecayChain(i) || isFromPrimaryPairProduction(i);
+    BOOST_CHECK_EQUAL(reference, expected[i]);
+    if (isPrimary) {
+      continue;
+    }
+    int mother = tree[i].mother;
+    flags[i] = o2::data::Stack::getPhysicsFlags(tree[mother].mother < 0, flags[mother], tree[i].proc);
+    BOOST_CHECK_EQUAL(bool(flags[i] & o2::data::Stack::kKeepPhysics), reference);
+    BOOST_CHECK_EQUAL(bool(flags[i] & o2::data::Stack::kFromPrimaryDecayChain), isFromPrimaryDecayChain(i));
+  }
+}
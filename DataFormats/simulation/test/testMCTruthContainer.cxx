@@ -15,6 +15,7 @@
 #include <boost/test/unit_test.hpp>
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "SimulationDataFormat/ConstMCTruthContainer.h"
+#include "SimulationDataFormat/CompactMCLabelContainer.h"
 #include "SimulationDataFormat/LabelContainer.h"
 #include "SimulationDataFormat/IOMCTruthContainerView.h"
 #include <algorithm>
@@ -116,6 +117,22 @@ BOOST_AUTO_TEST_CASE(MCTruth)
     BOOST_CHECK(container1.getNElements() == 8);
     BOOST_CHECK(lview.size() == lviewA.size());
     BOOST_CHECK(lview[0] == lviewA[0] && lview[1] == lviewA[1]);
+
+    // filling of preallocated container by parts, in reverse order
+    dataformats::MCTruthContainer<TruthElement> containerB;
+    BOOST_CHECK(container1.getNElements(0, 2) == 3);
+    BOOST_CHECK(container1.getNElements(2, 4) == 5);
+    containerB.resizeForCopy(container1.getIndexedSize(), container1.getNElements());
+    containerB.copyAt(container1, 2, 4, 2, 3);
+    containerB.copyAt(container1, 0, 2, 0, 0);
+    BOOST_CHECK(containerB.getIndexedSize() == container1.getIndexedSize());
+    BOOST_CHECK(containerB.getNElements() == container1.getNElements());
+    for (uint32_t i = 0; i < container1.getIndexedSize(); i++) {
+      auto v1 = container1.getLabels(i);
+      auto vB = containerB.getLabels(i);
+      BOOST_CHECK(v1.size() == vB.size());
+      BOOST_CHECK(std::equal(v1.begin(), v1.end(), vB.begin()));
+    }
   }
 }
 
@@ -371,4 +388,62 @@ BOOST_AUTO_TEST_CASE(MCTruthContainer_ROOTIO)
   BOOST_CHECK(cc.getLabels(BIGSIZE - 1)[1] == TruthElement(BIGSIZE, BIGSIZE - 1, BIGSIZE - 1));
 }
 
+BOOST_AUTO_TEST_CASE(CompactMCLabelContainer_roundtrip)
+{
+  // labels of several interleaved events and sources, with fake, noise and unset labels
+  // and indices with 0, 1 or several labels
+  dataformats::MCTruthContainer<MCCompLabel> container;
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 101 == 3) {
+      continue;
+    }
+    const int nlabels = (i % 13 == 0) ? 3 : 1;
+    for (int l = 0; l < nlabels; ++l) {
+      MCCompLabel label(1000 + i / 2 + 50 * l, (i / 10) % 4, i % 50 == 0 ? 1 : 0, i % 11 == 0);
+      if (i % 97 == 0) {
+        label.setNoise();
+      } else if (i % 89 == 0) {
+        label.unset();
+      }
+      container.addElement(i, label);
+    }
+  }
+  container.addElement(1200, MCCompLabel(MCCompLabel::maxTrackID(), MCCompLabel::maxEventID(), MCCompLabel::maxSourceID(), true));
+
+  dataformats::CompactMCLabelContainer compact;
+  dataformats::compact_to(container, compact);
+  BOOST_CHECK(compact.size() * 2 < container.getNElements() * sizeof(MCCompLabel));
+  BOOST_CHECK(compact.getIndexedSize() == container.getIndexedSize());
+  BOOST_CHECK(compact.getNElements() == container.getNElements());
+
+  // the zero-copy view on the buffer, as received in a message
+  dataformats::CompactMCLabelContainerView view(gsl::span<const char>(compact.data(), compact.size()));
+  for (uint32_t i = 0; i < container.getIndexedSize(); ++i) {
+    const auto labels = container.getLabels(i);
+    const auto compactlabels = view.getLabels(i);
+    BOOST_REQUIRE(compactlabels.size() == labels.size());
+    int l = 0;
+    for (auto label : compactlabels) {
+      BOOST_CHECK(label.getRawValue() == labels[l].getRawValue());
+      BOOST_CHECK(compactlabels[l].getRawValue() == labels[l].getRawValue());
+      l++;
+    }
+  }
+  for (uint32_t e = 0; e < container.getNElements(); ++e) {
+    BOOST_CHECK(view.getElement(e).getRawValue() == container.getElement(e).getRawValue());
+  }
+  BOOST_CHECK(view.getLabels(container.getIndexedSize()).empty());
+
+  dataformats::MCTruthContainer<MCCompLabel> expanded;
+  view.expand_to(expanded);
+  BOOST_CHECK(expanded.getIndexedSize() == container.getIndexedSize());
+  BOOST_CHECK(expanded.getNElements() == container.getNElements());
+
+  // empty containers
+  dataformats::MCTruthContainer<MCCompLabel> empty;
+  dataformats::compact_to(empty, compact);
+  BOOST_CHECK(compact.getIndexedSize() == 0);
+  BOOST_CHECK(dataformats::CompactMCLabelContainerView().getLabels(0).empty());
+}
+
 } // namespace o2
@@ -161,6 +161,7 @@ class AODProducerWorkflowDPL : public Task
   int64_t mTFNumber{-1};
   int mTruncate{1};
   int mRecoOnly{0};
+  int mNThreads{1};
   TStopwatch mTimer;
 
   // unordered map connects global indices and table indices of barrel tracks
@@ -270,6 +271,11 @@ class AODProducerWorkflowDPL : public Task
                                    TracksExtraCursorType& tracksExtraCursor,
                                    mftTracksCursorType& mftTracksCursor);
 
+  // helper for the extra info of a barrel track, it only reads the reconstructed data
+  // so that it can be called for several tracks in parallel
+  void fillTrackExtraInfo(GIndex trackIndex, int src, double interactionTime,
+                          o2::globaltracking::RecoContainer& data, TrackExtraInfo& extraInfoHolder);
+
   template <typename MCParticlesCursorType>
   void fillMCParticlesTable(o2::steer::MCKinematicsReader& mcReader,
                             const MCParticlesCursorType& mcParticlesCursor,
@@ -278,6 +284,18 @@ class AODProducerWorkflowDPL : public Task
                             o2::globaltracking::RecoContainer& data,
                             std::vector<std::pair<int, int>> const& mccolid_to_eventandsource);
 
+  // cluster counters of the TPC tracks, computed once per TF for all of them since the
+  // same TPC track can be a contributor of several barrel tracks and collisions
+  struct TPCCounters {
+    uint8_t shared = 0;
+    uint8_t found = 0;
+    uint8_t crossed = 0;
+  };
+  std::vector<TPCCounters> mTPCCounters;
+
+  // fill mTPCCounters for all TPC tracks
+  void countTPCClusters(const o2::globaltracking::RecoContainer& data);
+
   // helper for tpc clusters
   void countTPCClusters(const o2::tpc::TrackTPC& track,
                         const gsl::span<const o2::tpc::TPCClRefElem>& tpcClusRefs,
@@ -209,73 +209,91 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
                                                          TracksExtraCursorType& tracksExtraCursor,
                                                          mftTracksCursorType& mftTracksCursor)
 {
-  const auto& tpcClusRefs = data.getTPCTracksClusterRefs();
-  const auto& tpcClusShMap = data.clusterShMapTPC;
-  const auto& tpcClusAcc = data.getTPCClusters();
-  const auto& tpcTracks = data.getTPCTracks();
-  const auto& itsTracks = data.getITSTracks();
-  const auto& itsABRefs = data.getITSABRefs();
-
+  std::vector<std::pair<GIndex, int>> barrelTracks; // global index and source of the barrel tracks, in table order
   for (int src = GIndex::NSources; src--;) {
     int start = trackRef.getFirstEntryOfSource(src);
     int end = start + trackRef.getEntriesOfSource(src);
     LOG(DEBUG) << "Unassigned tracks: src = " << src << ", start = " << start << ", end = " << end;
     for (int ti = start; ti < end; ti++) {
-      TrackExtraInfo extraInfoHolder;
       auto& trackIndex = GIndices[ti];
       if (GIndex::includesSource(src, mInputSources)) {
         if (src == GIndex::Source::MFT) { // MFT tracks are treated separately since they are stored in a different table
           const auto& track = data.getMFTTrack(trackIndex.getIndex());
           addToMFTTracksTable(mftTracksCursor, track, collisionID);
         } else {
-          auto contributorsGID = data.getSingleDetectorRefs(trackIndex);
-          const auto& trackPar = data.getTrackParam(trackIndex);
-          if (contributorsGID[GIndex::Source::ITS].isIndexSet()) {
-            extraInfoHolder.itsClusterMap = itsTracks[contributorsGID[GIndex::ITS].getIndex()].getPattern();
-          } else if (contributorsGID[GIndex::Source::ITSAB].isIndexSet()) { // this is an ITS-TPC afterburner contributor
-            extraInfoHolder.itsClusterMap = itsABRefs[contributorsGID[GIndex::Source::ITSAB].getIndex()].pattern;
-          }
-          if (contributorsGID[GIndex::Source::TPC].isIndexSet()) {
-            const auto& tpcOrig = tpcTracks[contributorsGID[GIndex::TPC].getIndex()];
-            extraInfoHolder.tpcInnerParam = tpcOrig.getP();
-            extraInfoHolder.tpcChi2NCl = tpcOrig.getNClusters() ? tpcOrig.getChi2() / tpcOrig.getNClusters() : 0;
-            extraInfoHolder.tpcSignal = tpcOrig.getdEdx().dEdxTotTPC;
-            uint8_t shared, found, crossed; // fixme: need to switch from these placeholders to something more reasonable
-            countTPCClusters(tpcOrig, tpcClusRefs, tpcClusShMap, tpcClusAcc, shared, found, crossed);
-            extraInfoHolder.tpcNClsFindable = tpcOrig.getNClusters();
-            extraInfoHolder.tpcNClsFindableMinusFound = tpcOrig.getNClusters() - found;
-            extraInfoHolder.tpcNClsFindableMinusCrossedRows = tpcOrig.getNClusters() - crossed;
-            extraInfoHolder.tpcNClsShared = shared;
-          }
-          if (contributorsGID[GIndex::Source::ITSTPCTOF].isIndexSet()) {
-            const auto& tofMatch = data.getTOFMatch(contributorsGID[GIndex::Source::ITSTPCTOF]);
-            extraInfoHolder.tofChi2 = tofMatch.getChi2();
-            const auto& tofInt = tofMatch.getLTIntegralOut();
-            float intLen = tofInt.getL();
-            extraInfoHolder.length = intLen;
-            if (interactionTime > 0) {
-              extraInfoHolder.tofSignal = static_cast<float>(tofMatch.getSignal() - interactionTime);
-            }
-            const float mass = o2::constants::physics::MassPionCharged; // default pid = pion
-            if (tofInt.getTOF(o2::track::PID::Pion) > 0.f) {
-              const float expBeta = (intLen / (tofInt.getTOF(o2::track::PID::Pion) * cSpeed));
-              extraInfoHolder.tofExpMom = mass * expBeta / std::sqrt(1.f - expBeta * expBeta);
-            }
-          }
-          if (src == GIndex::Source::TPCTRD || src == GIndex::Source::ITSTPCTRD) {
-            const auto& trdOrig = data.getTrack<o2::trd::TrackTRD>(src, contributorsGID[src].getIndex());
-            extraInfoHolder.trdChi2 = trdOrig.getChi2();
-            extraInfoHolder.trdPattern = getTRDPattern(trdOrig);
-          }
-          addToTracksTable(tracksCursor, tracksCovCursor, trackPar, collisionID, src);
-          addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
-          // collecting table indices of barrel tracks for V0s table
-          mGIDToTableID.emplace(trackIndex, mTableTrID);
-          mTableTrID++;
+          barrelTracks.emplace_back(trackIndex, src);
         }
       }
     }
   }
+
+  // the extra info (TPC cluster counting, TOF and TRD matching) is computed for all the tracks
+  // of the collision in parallel, the tables are then filled sequentially
+  std::vector<TrackExtraInfo> extraInfos(barrelTracks.size());
+  int nBarrelTracks = barrelTracks.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(mNThreads) if (mNThreads > 1 && nBarrelTracks > 64)
+#endif
+  for (int i = 0; i < nBarrelTracks; i++) {
+    fillTrackExtraInfo(barrelTracks[i].first, barrelTracks[i].second, interactionTime, data, extraInfos[i]);
+  }
+
+  for (int i = 0; i < nBarrelTracks; i++) {
+    const auto& [trackIndex, src] = barrelTracks[i];
+    const auto& trackPar = data.getTrackParam(trackIndex);
+    addToTracksTable(tracksCursor, tracksCovCursor, trackPar, collisionID, src);
+    addToTracksExtraTable(tracksExtraCursor, extraInfos[i]);
+    // collecting table indices of barrel tracks for V0s table
+    mGIDToTableID.emplace(trackIndex, mTableTrID);
+    mTableTrID++;
+  }
+}
+
+void AODProducerWorkflowDPL::fillTrackExtraInfo(GIndex trackIndex, int src, double interactionTime,
+                                                o2::globaltracking::RecoContainer& data, TrackExtraInfo& extraInfoHolder)
+{
+  const auto& tpcTracks = data.getTPCTracks();
+  const auto& itsTracks = data.getITSTracks();
+  const auto& itsABRefs = data.getITSABRefs();
+
+  auto contributorsGID = data.getSingleDetectorRefs(trackIndex);
+  if (contributorsGID[GIndex::Source::ITS].isIndexSet()) {
+    extraInfoHolder.itsClusterMap = itsTracks[contributorsGID[GIndex::ITS].getIndex()].getPattern();
+  } else if (contributorsGID[GIndex::Source::ITSAB].isIndexSet()) { // this is an ITS-TPC afterburner contributor
+    extraInfoHolder.itsClusterMap = itsABRefs[contributorsGID[GIndex::Source::ITSAB].getIndex()].pattern;
+  }
+  if (contributorsGID[GIndex::Source::TPC].isIndexSet()) {
+    const auto tpcIndex = contributorsGID[GIndex::TPC].getIndex();
+    const auto& tpcOrig = tpcTracks[tpcIndex];
+    extraInfoHolder.tpcInnerParam = tpcOrig.getP();
+    extraInfoHolder.tpcChi2NCl = tpcOrig.getNClusters() ? tpcOrig.getChi2() / tpcOrig.getNClusters() : 0;
+    extraInfoHolder.tpcSignal = tpcOrig.getdEdx().dEdxTotTPC;
+    const auto& counters = mTPCCounters[tpcIndex]; // fixme: need to switch from these placeholders to something more reasonable
+    extraInfoHolder.tpcNClsFindable = tpcOrig.getNClusters();
+    extraInfoHolder.tpcNClsFindableMinusFound = tpcOrig.getNClusters() - counters.found;
+    extraInfoHolder.tpcNClsFindableMinusCrossedRows = tpcOrig.getNClusters() - counters.crossed;
+    extraInfoHolder.tpcNClsShared = counters.shared;
+  }
+  if (contributorsGID[GIndex::Source::ITSTPCTOF].isIndexSet()) {
+    const auto& tofMatch = data.getTOFMatch(contributorsGID[GIndex::Source::ITSTPCTOF]);
+    extraInfoHolder.tofChi2 = tofMatch.getChi2();
+    const auto& tofInt = tofMatch.getLTIntegralOut();
+    float intLen = tofInt.getL();
+    extraInfoHolder.length = intLen;
+    if (interactionTime > 0) {
+      extraInfoHolder.tofSignal = static_cast<float>(tofMatch.getSignal() - interactionTime);
+    }
+    const float mass = o2::constants::physics::MassPionCharged; // default pid = pion
+    if (tofInt.getTOF(o2::track::PID::Pion) > 0.f) {
+      const float expBeta = (intLen / (tofInt.getTOF(o2::track::PID::Pion) * cSpeed));
+      extraInfoHolder.tofExpMom = mass * expBeta / std::sqrt(1.f - expBeta * expBeta);
+    }
+  }
+  if (src == GIndex::Source::TPCTRD || src == GIndex::Source::ITSTPCTRD) {
+    const auto& trdOrig = data.getTrack<o2::trd::TrackTRD>(src, contributorsGID[src].getIndex());
+    extraInfoHolder.trdChi2 = trdOrig.getChi2();
+    extraInfoHolder.trdPattern = getTRDPattern(trdOrig);
+  }
 }
 
 template <typename MCParticlesCursorType>
@@ -432,6 +450,27 @@ void AODProducerWorkflowDPL::fillMCParticlesTable(o2::steer::MCKinematicsReader&
   }
 }
 
+void AODProducerWorkflowDPL::countTPCClusters(const o2::globaltracking::RecoContainer& data)
+{
+  const auto& tpcTracks = data.getTPCTracks();
+  mTPCCounters.clear();
+  mTPCCounters.resize(tpcTracks.size());
+  if (tpcTracks.empty()) {
+    return;
+  }
+  const auto& tpcClusRefs = data.getTPCTracksClusterRefs();
+  const auto& tpcClusShMap = data.clusterShMapTPC;
+  const auto& tpcClusAcc = data.getTPCClusters();
+  int nTPCTracks = tpcTracks.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(mNThreads) if (mNThreads > 1)
+#endif
+  for (int i = 0; i < nTPCTracks; i++) {
+    auto& counters = mTPCCounters[i];
+    countTPCClusters(tpcTracks[i], tpcClusRefs, tpcClusShMap, tpcClusAcc, counters.shared, counters.found, counters.crossed);
+  }
+}
+
 void AODProducerWorkflowDPL::countTPCClusters(const o2::tpc::TrackTPC& track,
                                               const gsl::span<const o2::tpc::TPCClRefElem>& tpcClusRefs,
                                               const gsl::span<const unsigned char>& tpcClusShMap,
@@ -495,6 +534,13 @@ void AODProducerWorkflowDPL::init(InitContext& ic)
   mTFNumber = ic.options().get<int64_t>("aod-timeframe-id");
   mRecoOnly = ic.options().get<int>("reco-mctracks-only");
   mTruncate = ic.options().get<int>("enable-truncation");
+  mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+#ifndef WITH_OPENMP
+  if (mNThreads > 1) {
+    LOG(WARNING) << "AOD producer is compiled without OpenMP, the track tables are filled with 1 thread";
+    mNThreads = 1;
+  }
+#endif
 
   if (mTFNumber == -1L) {
     LOG(INFO) << "TFNumber will be obtained from CCDB";
@@ -545,6 +591,7 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
 
   o2::globaltracking::RecoContainer recoData;
   recoData.collectData(pc, *mDataRequest);
+  countTPCClusters(recoData);
 
   auto primVertices = recoData.getPrimaryVertices();
   auto primVer2TRefs = recoData.getPrimaryVertexMatchedTrackRefs();
@@ -993,7 +1040,8 @@ DataProcessorSpec getAODProducerWorkflowSpec(GID::mask_t src, bool useMC)
     Options{
       ConfigParamSpec{"aod-timeframe-id", VariantType::Int64, -1L, {"Set timeframe number"}},
       ConfigParamSpec{"enable-truncation", VariantType::Int, 1, {"Truncation parameter: 1 -- on, != 1 -- off"}},
-      ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}}}};
+      ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}},
+      ConfigParamSpec{"nthreads", VariantType::Int, 1, {"Number of threads for the track tables filling"}}}};
 }
 
 } // namespace o2::aodproducer
@@ -376,8 +376,9 @@ class Controller : public TObject
   Char_t* getDOFLabelTxt(int idf) const;
   //
   static Char_t* getDetNameByDetID(int id) { return (Char_t*)sDetectorName[id]; }
-  static void mPRec2Mille(const char* mprecfile, const char* millefile = "mpData.mille", bool bindata = true);
-  static void mPRec2Mille(TTree* mprTree, const char* millefile = "mpData.mille", bool bindata = true);
+  static void mPRec2Mille(const char* mprecfile, const char* millefile = "mpData.mille", bool bindata = true, int nThreads = 1);
+  static void mPRec2Mille(TTree* mprTree, const char* millefile = "mpData.mille", bool bindata = true, int nThreads = 1);
+  static void fillMilleRecord(const Millepede2Record* rec, Mille& mille, TArrayF& buffDLoc);
   //
   //  AliSymMatrix* BuildMatrix(TVectorD& vec); FIXME(milettri): needs AliSymMatrix
   bool testLocalSolution();
@@ -482,6 +483,7 @@ class Controller : public TObject
   static const Char_t* sDetectorName[kNDetectors]; // names of detectors
   static const Char_t* sHStatName[kNHVars];        // names for stat.bins in the stat histo
   static const Char_t* sMPDataExt;                 // extension for MP2 binary data
+  static constexpr int sMPRecPerThread = 100;      // MPRecords per thread in each chunk converted in parallel
   //
   ClassDef(Controller, 3)
 };
@@ -25,12 +25,17 @@
  *  to write also derivatives and labels which are ==0.
  *  But note that **pede** will not be able to read text output and has not been tested with
  *  derivatives/labels ==0.
+ *
+ *  A Mille created without file name only builds the records, which are then appended to
+ *  a memory buffer by \c end(std::string&) and can be written later, in any order, to a
+ *  Mille with a file by \c write(). This allows to prepare the records in several threads.
  */
 
 #ifndef MILLE_H
 #define MILLE_H
 
 #include <fstream>
+#include <string>
 #include <TArrayI.h>
 #include <TArrayF.h>
 
@@ -43,6 +48,7 @@ class Mille
 {
  public:
   Mille(const char* outFileName, bool asBinary = true, bool writeZero = false);
+  explicit Mille(bool asBinary, bool writeZero = false);
   ~Mille();
 
   void mille(int NLC, const float* derLc, int NGL, const float* derGl,
@@ -50,10 +56,13 @@ class Mille
   void special(int nSpecial, const float* floatings, const int* integers);
   void kill();
   int end();
+  int end(std::string& buffer);
+  void write(const std::string& buffer);
 
  private:
   void newSet();
   bool checkBufferSize(int nLocal, int nGlobal);
+  int writeRecord(std::ostream& out);
 
   std::ofstream myOutFile; ///< C-binary for output
   bool myAsBinary;         ///< if false output as text
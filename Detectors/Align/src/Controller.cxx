@@ -49,11 +49,17 @@
 #include <TRandom.h>
 #include <TH1F.h>
 #include <TList.h>
+#include <algorithm>
 #include <cstdio>
+#include <memory>
 #include <TGeoGlobalMagField.h>
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DataFormatsParameters/GRPObject.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace TMath;
 using namespace o2::align::utils;
 using std::ifstream;
@@ -1820,7 +1826,7 @@ void Controller::checkConstraints(const char* params)
 }
 
 //___________________________________________________________
-void Controller::mPRec2Mille(const char* mprecfile, const char* millefile, bool bindata)
+void Controller::mPRec2Mille(const char* mprecfile, const char* millefile, bool bindata, int nThreads)
 {
   // converts MPRecord tree to millepede binary format
   TFile* flmpr = TFile::Open(mprecfile);
@@ -1833,14 +1839,14 @@ void Controller::mPRec2Mille(const char* mprecfile, const char* millefile, bool
     LOG(ERROR) << "No mpTree in xMPRecord file " << mprecfile;
     return;
   }
-  mPRec2Mille(mprTree, millefile, bindata);
+  mPRec2Mille(mprTree, millefile, bindata, nThreads);
   delete mprTree;
   flmpr->Close();
   delete flmpr;
 }
 
 //___________________________________________________________
-void Controller::mPRec2Mille(TTree* mprTree, const char* millefile, bool bindata)
+void Controller::mPRec2Mille(TTree* mprTree, const char* millefile, bool bindata, int nThreads)
 {
   // converts MPRecord tree to millepede binary format
   //
@@ -1849,8 +1855,6 @@ void Controller::mPRec2Mille(TTree* mprTree, const char* millefile, bool bindata
     LOG(ERROR) << "provided tree does not contain branch mprec";
     return;
   }
-  Millepede2Record* rec = new Millepede2Record();
-  br->SetAddress(&rec);
   int nent = mprTree->GetEntries();
   TString mlname = millefile;
   if (mlname.IsNull()) {
@@ -1860,41 +1864,93 @@ void Controller::mPRec2Mille(TTree* mprTree, const char* millefile, bool bindata
     mlname += sMPDataExt;
   }
   Mille* mille = new Mille(mlname, bindata);
-  TArrayF buffDLoc;
-  for (int i = 0; i < nent; i++) {
-    br->GetEntry(i);
-    int nr = rec->getNResid(); // number of residual records
-    int nloc = rec->getNVarLoc();
-    if (buffDLoc.GetSize() < nloc) {
-      buffDLoc.Set(nloc + 100);
+#ifndef WITH_OPENMP
+  if (nThreads > 1) {
+    LOG(WARNING) << "OpenMP is not available, converting MPRecords in a single thread";
+    nThreads = 1;
+  }
+#endif
+  if (nThreads < 1) {
+    nThreads = 1;
+  }
+  // The records are read sequentially in chunks, converted in parallel, each thread
+  // filling its own Mille buffers, and written in the order of the tree entries.
+  int chunkSize = nThreads > 1 ? nThreads * sMPRecPerThread : 1;
+  std::vector<Millepede2Record*> recs(chunkSize);
+  for (auto& rec : recs) {
+    rec = new Millepede2Record();
+  }
+  std::vector<std::string> records(nThreads > 1 ? chunkSize : 0);
+  std::vector<std::unique_ptr<Mille>> threadMille(nThreads > 1 ? nThreads : 0);
+  for (auto& tm : threadMille) {
+    tm = std::make_unique<Mille>(bindata);
+  }
+  std::vector<TArrayF> buffDLoc(nThreads);
+  for (int ient0 = 0; ient0 < nent; ient0 += chunkSize) {
+    int nrec = std::min(chunkSize, nent - ient0);
+    for (int irec = 0; irec < nrec; irec++) {
+      br->SetAddress(&recs[irec]);
+      br->GetEntry(ient0 + irec);
     }
-    float* buffLocV = buffDLoc.GetArray();
-    const float* recDGlo = rec->getArrGlo();
-    const float* recDLoc = rec->getArrLoc();
-    const short* recLabLoc = rec->getArrLabLoc();
-    const int* recLabGlo = rec->getArrLabGlo();
-    //
-    for (int ir = 0; ir < nr; ir++) {
-      memset(buffLocV, 0, nloc * sizeof(float));
-      int ndglo = rec->getNDGlo(ir);
-      int ndloc = rec->getNDLoc(ir);
-      // fill 0-suppressed array from MPRecord to non-0-suppressed array of Mille
-      for (int l = ndloc; l--;) {
-        buffLocV[recLabLoc[l]] = recDLoc[l];
-      }
-      //
-      mille->mille(nloc, buffLocV, ndglo, recDGlo, recLabGlo, rec->getResid(ir), rec->getResErr(ir));
-      //
-      recLabGlo += ndglo; // next record
-      recDGlo += ndglo;
-      recLabLoc += ndloc;
-      recDLoc += ndloc;
+    if (nThreads == 1) {
+      fillMilleRecord(recs[0], *mille, buffDLoc[0]);
+      mille->end();
+      continue;
+    }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+    for (int irec = 0; irec < nrec; irec++) {
+      int ith = 0;
+#ifdef WITH_OPENMP
+      ith = omp_get_thread_num();
+#endif
+      records[irec].clear();
+      fillMilleRecord(recs[irec], *threadMille[ith], buffDLoc[ith]);
+      threadMille[ith]->end(records[irec]);
+    }
+    for (int irec = 0; irec < nrec; irec++) {
+      mille->write(records[irec]);
     }
-    mille->end();
   }
   delete mille;
   br->SetAddress(nullptr);
-  delete rec;
+  for (auto rec : recs) {
+    delete rec;
+  }
+}
+
+//___________________________________________________________
+void Controller::fillMilleRecord(const Millepede2Record* rec, Mille& mille, TArrayF& buffDLoc)
+{
+  // fill the Mille buffers with the content of the MPRecord, the record is not ended
+  int nr = rec->getNResid(); // number of residual records
+  int nloc = rec->getNVarLoc();
+  if (buffDLoc.GetSize() < nloc) {
+    buffDLoc.Set(nloc + 100);
+  }
+  float* buffLocV = buffDLoc.GetArray();
+  const float* recDGlo = rec->getArrGlo();
+  const float* recDLoc = rec->getArrLoc();
+  const short* recLabLoc = rec->getArrLabLoc();
+  const int* recLabGlo = rec->getArrLabGlo();
+  //
+  for (int ir = 0; ir < nr; ir++) {
+    memset(buffLocV, 0, nloc * sizeof(float));
+    int ndglo = rec->getNDGlo(ir);
+    int ndloc = rec->getNDLoc(ir);
+    // fill 0-suppressed array from MPRecord to non-0-suppressed array of Mille
+    for (int l = ndloc; l--;) {
+      buffLocV[recLabLoc[l]] = recDLoc[l];
+    }
+    //
+    mille.mille(nloc, buffLocV, ndglo, recDGlo, recLabGlo, rec->getResid(ir), rec->getResErr(ir));
+    //
+    recLabGlo += ndglo; // next record
+    recDGlo += ndglo;
+    recLabLoc += ndloc;
+    recDLoc += ndloc;
+  }
 }
 
 //____________________________________________________________
@@ -24,6 +24,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 namespace o2
 {
@@ -56,6 +57,22 @@ Mille::Mille(const char* outFileName, bool asBinary, bool writeZero) : myOutFile
   }
 }
 
+//___________________________________________________________________________
+/// Creates a Mille without output file, to fill memory buffers with end(std::string&).
+/**
+ * \param[in] asBinary     flag for binary
+ * \param[in] writeZero    flag for keeping of zeros
+ */
+Mille::Mille(bool asBinary, bool writeZero) : myAsBinary(asBinary),
+                                              myWriteZero(writeZero),
+                                              myBufferSize(0),
+                                              myBufferInt(5000),
+                                              myBufferFloat(5000),
+                                              myBufferPos(-1),
+                                              myHasSpecial(false)
+{
+}
+
 //___________________________________________________________________________
 /// Closes file.
 Mille::~Mille()
@@ -183,6 +200,40 @@ void Mille::kill()
 //___________________________________________________________________________
 /// Write buffer (set of derivatives with same local parameters) to file.
 int Mille::end()
+{
+  int wrote = writeRecord(myOutFile);
+  myBufferPos = -1; // reset buffer for next set of derivatives
+  return wrote;
+}
+
+//___________________________________________________________________________
+/// Append buffer (set of derivatives with same local parameters) to a memory buffer.
+/**
+ * \param[out]  buffer  the record is appended to it, in the same format as in the file
+ * \return      number of bytes of the record in binary format
+ */
+int Mille::end(std::string& buffer)
+{
+  std::ostringstream out(myAsBinary ? (std::ios::binary | std::ios::out) : std::ios::out);
+  int wrote = writeRecord(out);
+  buffer += out.str();
+  myBufferPos = -1; // reset buffer for next set of derivatives
+  return wrote;
+}
+
+//___________________________________________________________________________
+/// Write to file records previously stored in a memory buffer by end(std::string&).
+/**
+ * \param[in]   buffer  records, in the format of this file
+ */
+void Mille::write(const std::string& buffer)
+{
+  myOutFile.write(buffer.data(), buffer.size());
+}
+
+//___________________________________________________________________________
+/// Write buffer to stream, if anything was stored.
+int Mille::writeRecord(std::ostream& out)
 {
   int wrote = 0;
   if (myBufferPos > 0) { // only if anything stored...
@@ -191,27 +242,26 @@ int Mille::end()
     int* bufferInt = myBufferInt.GetArray();
 
     if (myAsBinary) {
-      myOutFile.write(reinterpret_cast<const char*>(&numWordsToWrite),
-                      sizeof(numWordsToWrite));
-      myOutFile.write(reinterpret_cast<char*>(bufferFloat),
-                      (myBufferPos + 1) * sizeof(bufferFloat[0]));
-      myOutFile.write(reinterpret_cast<char*>(bufferInt),
-                      (myBufferPos + 1) * sizeof(bufferInt[0]));
+      out.write(reinterpret_cast<const char*>(&numWordsToWrite),
+                sizeof(numWordsToWrite));
+      out.write(reinterpret_cast<char*>(bufferFloat),
+                (myBufferPos + 1) * sizeof(bufferFloat[0]));
+      out.write(reinterpret_cast<char*>(bufferInt),
+                (myBufferPos + 1) * sizeof(bufferInt[0]));
     } else {
-      myOutFile << numWordsToWrite << "\n";
+      out << numWordsToWrite << "\n";
       for (int i = 0; i < myBufferPos + 1; ++i) {
-        myOutFile << bufferFloat[i] << " ";
+        out << bufferFloat[i] << " ";
       }
-      myOutFile << "\n";
+      out << "\n";
 
       for (int i = 0; i < myBufferPos + 1; ++i) {
-        myOutFile << bufferInt[i] << " ";
+        out << bufferInt[i] << " ";
       }
-      myOutFile << "\n";
+      out << "\n";
     }
     wrote = (myBufferPos + 1) * (sizeof(bufferFloat[0]) + sizeof(bufferInt[0])) + sizeof(int);
   }
-  myBufferPos = -1; // reset buffer for next set of derivatives
   return wrote;
 }
 
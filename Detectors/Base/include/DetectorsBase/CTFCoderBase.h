@@ -16,7 +16,10 @@
 #ifndef _ALICEO2_CTFCODER_BASE_H_
 #define _ALICEO2_CTFCODER_BASE_H_
 
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
 #include <TFile.h>
 #include <TTree.h>
 #include "DetectorsCommonDataFormats/DetID.h"
@@ -42,7 +45,7 @@ class CTFCoderBase
                             Decoder };
 
   CTFCoderBase() = delete;
-  CTFCoderBase(int n, DetID det) : mCoders(n), mDet(det) {}
+  CTFCoderBase(int n, DetID det) : mCoders(n), mAdaptiveCoders(n), mDet(det) {}
 
   std::unique_ptr<TFile> loadDictionaryTreeFile(const std::string& dictPath, bool mayFail = false);
 
@@ -84,9 +87,72 @@ class CTFCoderBase
     for (auto c : mCoders) {
       c.reset();
     }
+    for (auto& c : mAdaptiveCoders) {
+      c = AdaptiveCoder{};
+    }
+  }
+
+  /// In the adaptive dictionary mode (threshold > 0) the slots w/o external dictionary are encoded with the encoder built
+  /// for a previous TF as long as the KL divergence (in bits per symbol) of the new data from its dictionary stays below the threshold.
+  /// The dictionary of the reused encoder is still stored in every CTF, so that the latter can be decoded standalone.
+  void setAdaptiveDictionaryThreshold(float klBits) { mAdaptiveThreshold = klBits; }
+  float getAdaptiveDictionaryThreshold() const { return mAdaptiveThreshold; }
+
+  /// In the compact dictionary mode (coverage > 0) the dictionaries built for the slots w/o external dictionary are restricted,
+  /// if their range exceeds maxRangeBits, to the narrowest range of symbols holding the fraction coverage of the data, the other
+  /// symbols being stored as literals. This bounds the symbol tables of wide and sparse alphabets, see rans::compactFrequencyTable.
+  void setCompactDictionary(float coverage, int maxRangeBits = DefaultCompactRangeBits)
+  {
+    mCompactCoverage = coverage;
+    mCompactRangeBits = maxRangeBits;
+  }
+  float getCompactDictionaryCoverage() const { return mCompactCoverage; }
+  int getCompactDictionaryRangeBits() const { return mCompactRangeBits; }
+
+  /// dictionary to build the coders from, compacted if coverage > 0 (e.g. at the creation of the external dictionaries)
+  static o2::rans::FrequencyTable compactDictionary(const o2::rans::FrequencyTable& freq, float coverage, int maxRangeBits = DefaultCompactRangeBits)
+  {
+    return coverage > 0.f ? o2::rans::compactFrequencyTable(freq, coverage, maxRangeBits) : freq;
   }
 
+  static constexpr int DefaultCompactRangeBits = 12;
+
  protected:
+  struct AdaptiveCoder {
+    std::shared_ptr<void> encoder;
+    o2::rans::FrequencyTable dict; // frequencies the encoder was built from
+    uint8_t probabilityBits = 0;
+    size_t nReused = 0; // number of TFs the encoder was reused since it was built
+  };
+
+  /// KL divergence in bits per symbol of the frequencies freq from the dictionary dict,
+  /// symbols missing in the latter are accounted as literals of literalBits
+  static double klDivergence(const o2::rans::FrequencyTable& freq, const o2::rans::FrequencyTable& dict, int literalBits);
+
+  /// encoder to use for the block of given slot and the dictionary to store with it (if any):
+  /// the external encoder if it was loaded for the slot, in the adaptive or compact dictionary mode the cached one, otherwise none
+  template <typename C>
+  std::pair<const void*, const o2::rans::FrequencyTable*> getEncoderForSlot(const C& src, int slot, uint8_t probabilityBits)
+  {
+    if (mCoders[slot] || (mAdaptiveThreshold <= 0.f && mCompactCoverage <= 0.f) || std::empty(src)) {
+      return {mCoders[slot].get(), nullptr};
+    }
+    using S = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(src))>>;
+    o2::rans::FrequencyTable freq;
+    freq.addSamples(std::begin(src), std::end(src));
+    auto& cached = mAdaptiveCoders[slot];
+    if (cached.encoder && cached.probabilityBits == probabilityBits && mAdaptiveThreshold > 0.f && klDivergence(freq, cached.dict, sizeof(S) * 8) < mAdaptiveThreshold) {
+      cached.nReused++;
+    } else {
+      LOGP(DEBUG, "{}slot {}: building new encoder after {} reuses", getPrefix(), slot, cached.nReused);
+      cached.dict = compactDictionary(freq, mCompactCoverage, mCompactRangeBits);
+      cached.encoder = std::make_shared<o2::rans::LiteralEncoder64<S>>(cached.dict, probabilityBits);
+      cached.probabilityBits = probabilityBits;
+      cached.nReused = 0;
+    }
+    return {cached.encoder.get(), &cached.dict};
+  }
+
   std::string getPrefix() const { return o2::utils::Str::concat_string(mDet.getName(), "_CTF: "); }
   void assignDictVersion(CTFDictHeader& h) const
   {
@@ -96,7 +162,11 @@ class CTFCoderBase
   }
   void checkDictVersion(const CTFDictHeader& h) const;
 
-  std::vector<std::shared_ptr<void>> mCoders; // encoders/decoders
+  std::vector<std::shared_ptr<void>> mCoders;      // encoders/decoders
+  std::vector<AdaptiveCoder> mAdaptiveCoders;      // encoders cached across TFs in the adaptive dictionary mode
+  float mAdaptiveThreshold = 0.f;                  // KL divergence threshold for the rebuild of adaptive encoders, <= 0: disabled
+  float mCompactCoverage = 0.f;                    // fraction of the data covered by the compacted dictionaries, <= 0: disabled
+  int mCompactRangeBits = DefaultCompactRangeBits; // max. range of the dictionaries which are not compacted
   DetID mDet;
   CTFDictHeader mExtHeader; // external dictionary header
 
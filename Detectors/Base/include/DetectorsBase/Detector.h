@@ -17,6 +17,9 @@
 
 #include <map>
 #include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
 #include <initializer_list>
 #include <memory>
 
@@ -44,6 +47,23 @@ namespace o2
 namespace base
 {
 
+// how the hits of a detector are attached to the message parts,
+// communicated in the detector ID header preceding them
+enum class HitEncoding : int {
+  TMessage = 0,  // ROOT serialized containers
+  ShmObject = 1, // pointers to the containers in shared memory (see UseShm)
+  ShmBlock = 2   // trivially copyable hits copied into shared memory blocks (see UsePODHitTransport)
+};
+
+// a block of trivially copyable hits in the shared memory pool of a simulation worker;
+// the worker owns it and frees it once the receiver has reset the busy flag
+struct ShmHitBlock {
+  void* data = nullptr; // the hits (nullptr if there are none)
+  size_t size = 0;      // size in bytes
+  size_t capacity = 0;  // allocated size in bytes, known only to the owner
+  bool* busy = nullptr; // in shared memory, true as long as the receiver uses the block
+};
+
 /// This is the basic class for any AliceO2 detector module, whether it is
 /// sensitive or not. Detector classes depend on this.
 class Detector : public FairDetector
@@ -163,12 +183,22 @@ class Detector : public FairDetector
   // interfaces to attach properly encoded hit information to a FairMQ message
   // and to decode it
   virtual void attachHits(FairMQChannel&, FairMQParts&) = 0;
-  virtual void fillHitBranch(TTree& tr, FairMQParts& parts, int& index) = 0;
 
-  // interface needed to merge together hit entries in TBranches (as used by hit merger process)
+  // in-memory collection of the hits of the sub-events of one event (as used by hit merger process);
+  // the concrete type is only known to the detector implementation
+  struct SubEventHits {
+    virtual ~SubEventHits() = default;
+  };
+
+  // decodes the hits of the sub-event with the given entry (arrival index) from the message parts
+  // and keeps them in hits, which is created if needed; shared memory blocks are kept without copy
+  virtual void collectHits(std::unique_ptr<SubEventHits>& hits, int entry, HitEncoding encoding, FairMQParts& parts, int& index) = 0;
+
+  // interface needed to merge together the collected hit entries into a single entry of the target TTree
+  // (hits might be null if no sub-event provided any hits)
   // trackoffsets: a map giving the corresponding trackoffset to be applied to the trackID property when
   // merging
-  virtual void mergeHitEntries(TTree& origin, TTree& target, std::vector<int> const& trackoffsets, std::vector<int> const& nprimaries, std::vector<int> const& subevtsOrdered) = 0;
+  virtual void mergeHitEntries(SubEventHits* hits, TTree& target, std::vector<int> const& trackoffsets, std::vector<int> const& nprimaries, std::vector<int> const& subevtsOrdered) = 0;
 
   // hook which is called automatically to custom initialize the O2 detectors
   // all initialization not able to do in constructors should be done here
@@ -239,6 +269,15 @@ inline std::string demangle(const char* name)
 void attachShmMessage(void* hitsptr, FairMQChannel& channel, FairMQParts& parts, bool* busy_ptr);
 void* decodeShmCore(FairMQParts& dataparts, int index, bool*& busy);
 
+// allocates a block (and its busy flag) in the shared memory pool of this process;
+// returns false if the pool has no space left
+bool allocateShmHitBlock(ShmHitBlock& block, size_t size);
+void freeShmHitBlock(ShmHitBlock& block);
+// used by the receiver to give the block back to its owner
+void releaseShmHitBlock(ShmHitBlock& block);
+void attachShmHitBlockMessage(ShmHitBlock const& block, FairMQChannel& channel, FairMQParts& parts);
+ShmHitBlock decodeShmHitBlockMessage(FairMQParts& dataparts, int index);
+
 template <typename T>
 T decodeShmMessage(FairMQParts& dataparts, int index, bool*& busy)
 {
@@ -266,7 +305,9 @@ T decodeTMessage(FairMQParts& dataparts, int index)
   return static_cast<T>(decodeTMessageCore(dataparts, index));
 }
 
-void attachDetIDHeaderMessage(int id, FairMQChannel& channel, FairMQParts& parts);
+void attachDetIDHeaderMessage(int id, FairMQChannel& channel, FairMQParts& parts, HitEncoding encoding = HitEncoding::TMessage);
+// returns false if the message at index is not a detector ID header
+bool decodeDetIDHeaderMessage(FairMQParts& dataparts, int index, int& id, HitEncoding& encoding);
 
 template <typename T>
 TBranch* getOrMakeBranch(TTree& tree, const char* brname, T* ptr)
@@ -285,6 +326,13 @@ struct UseShm {
   static constexpr bool value = false;
 };
 
+// a trait to determine if hits of a given type can be sent as plain memory (in shared memory blocks)
+// instead of being serialized using TMessage
+template <typename Hit>
+struct UsePODHitTransport {
+  static constexpr bool value = std::is_trivially_copyable<Hit>::value;
+};
+
 // an implementation helper template which automatically implements
 // common functionality for deriving classes via the CRT pattern
 // (example: it implements the updateHitTrackIndices function and avoids
@@ -328,12 +376,52 @@ class DetImpl : public o2::base::Detector
     if (static_cast<Det*>(this)->Det::getHits(0) == nullptr) {
       return;
     }
+    using Hit_t = decltype(static_cast<Det*>(this)->Det::getHits(0));
+    using Value_t = typename std::remove_pointer<Hit_t>::type::value_type;
+
+    auto& instance = o2::utils::ShmManager::Instance();
+    auto encoding = HitEncoding::TMessage;
+    std::vector<ShmHitBlock> blocks;
+    if (UseShm<Det>::value && instance.isOperational()) {
+      encoding = HitEncoding::ShmObject;
+    } else if constexpr (UsePODHitTransport<Value_t>::value) {
+      if (instance.isOperational() && instance.readyToAllocate()) {
+        // copy the hits into shared memory blocks, of which only the descriptors are sent;
+        // fall back to serialization if the pool is exhausted (e.g. if the merger is lagging behind)
+        releaseShmHitBlocks();
+        encoding = HitEncoding::ShmBlock;
+        while (auto hits = static_cast<Det*>(this)->Det::getHits(probe++)) {
+          ShmHitBlock block;
+          if (!getShmHitBlock(block, hits->size() * sizeof(Value_t))) {
+            for (auto& b : blocks) {
+              recycleShmHitBlock(b);
+            }
+            blocks.clear();
+            encoding = HitEncoding::TMessage;
+            break;
+          }
+          if (block.size > 0) {
+            std::memcpy(block.data, hits->data(), block.size);
+          }
+          blocks.push_back(block);
+        }
+        probe = 0;
+      }
+    }
 
-    attachDetIDHeaderMessage(GetDetId(), channel, parts); // the DetId s are universal as they come from o2::detector::DetID
+    attachDetIDHeaderMessage(GetDetId(), channel, parts, encoding); // the DetId s are universal as they come from o2::detector::DetID
 
     while (auto hits = static_cast<Det*>(this)->Det::getHits(probe++)) {
-      if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
+      if (int(mLastHitCounts.size()) < probe) {
+        mLastHitCounts.resize(probe);
+      }
+      mLastHitCounts[probe - 1] = hits->size();
+      if (encoding == HitEncoding::TMessage) {
         attachTMessage(*hits, channel, parts);
+      } else if (encoding == HitEncoding::ShmBlock) {
+        auto& block = blocks[probe - 1];
+        attachShmHitBlockMessage(block, channel, parts);
+        mShmHitBlocks.push_back(block);
       } else {
         // this is the shared mem variant
         // we will just send the sharedmem ID and the offset inside
@@ -343,117 +431,232 @@ class DetImpl : public o2::base::Detector
     }
   }
 
-  // this merges several entries from the TBranch brname from the origin TTree
-  // into a single entry in a target TTree / same branch
-  // (assuming T is typically a vector; merging is simply done by appending)
-  // make this function a (static helper)
+  // moves the shared memory blocks which were released by the receiver to the pool of free blocks
+  void releaseShmHitBlocks()
+  {
+    auto released = [this](ShmHitBlock& block) {
+      if (*block.busy) {
+        return false;
+      }
+      recycleShmHitBlock(block);
+      return true;
+    };
+    mShmHitBlocks.erase(std::remove_if(mShmHitBlocks.begin(), mShmHitBlocks.end(), released), mShmHitBlocks.end());
+  }
+
+  // keeps a block no longer used for the next events, as long as the pool holds less than
+  // the blocks of NHITBUFFERS events
+  void recycleShmHitBlock(ShmHitBlock& block)
+  {
+    if (mShmFreeBlocks.size() < NHITBUFFERS * std::max(size_t(1), mLastHitCounts.size())) {
+      *block.busy = false;
+      mShmFreeBlocks.push_back(block);
+      block = ShmHitBlock{};
+    } else {
+      freeShmHitBlock(block);
+    }
+  }
+
+  void freeShmFreeBlocks()
+  {
+    for (auto& block : mShmFreeBlocks) {
+      freeShmHitBlock(block);
+    }
+    mShmFreeBlocks.clear();
+  }
+
+  // a busy block for size bytes: the smallest large enough free block if any, otherwise a new block
+  // with some margin on this size, so that it can be reused for the next events; the free blocks are
+  // given back to the shared memory pool if it is exhausted
+  bool getShmHitBlock(ShmHitBlock& block, size_t size)
+  {
+    auto best = mShmFreeBlocks.end();
+    for (auto it = mShmFreeBlocks.begin(); it != mShmFreeBlocks.end(); ++it) {
+      if (it->capacity >= size && (best == mShmFreeBlocks.end() || it->capacity < best->capacity)) {
+        best = it;
+      }
+    }
+    if (best != mShmFreeBlocks.end()) {
+      block = *best;
+      mShmFreeBlocks.erase(best);
+    } else if (!allocateShmHitBlock(block, size + size / 4)) {
+      freeShmFreeBlocks();
+      if (!allocateShmHitBlock(block, size)) {
+        return false;
+      }
+    }
+    block.size = size;
+    *block.busy = true;
+    return true;
+  }
+
+  // the hits of one sub-event as collected by the hit merger: decoded or, for trivially copyable hits,
+  // still in the shared memory block of the sender, which is released as soon as the entry is not needed
+  template <typename T>
+  struct SubEventHitEntry {
+    using Value_t = typename T::value_type;
+    std::unique_ptr<T> hits;
+    ShmHitBlock block;
+
+    SubEventHitEntry() = default;
+    SubEventHitEntry(SubEventHitEntry&& other) noexcept : hits(std::move(other.hits)), block(other.block) { other.block = ShmHitBlock{}; }
+    SubEventHitEntry& operator=(SubEventHitEntry&& other) noexcept
+    {
+      release();
+      hits = std::move(other.hits);
+      block = other.block;
+      other.block = ShmHitBlock{};
+      return *this;
+    }
+    ~SubEventHitEntry() { release(); }
+
+    bool empty() const { return !hits && !block.busy; }
+    size_t size() const { return hits ? hits->size() : block.size / sizeof(Value_t); }
+    // appends the hits to target; the hits are moved from this entry
+    void appendTo(T& target)
+    {
+      if (hits) {
+        target.insert(target.end(), std::make_move_iterator(hits->begin()), std::make_move_iterator(hits->end()));
+      } else if constexpr (UsePODHitTransport<Value_t>::value) {
+        if (block.size > 0) {
+          const auto first = target.size();
+          target.resize(first + size());
+          std::memcpy(target.data() + first, block.data, block.size);
+        }
+      }
+    }
+    void release()
+    {
+      hits.reset();
+      if (block.busy) {
+        releaseShmHitBlock(block);
+      }
+      block = ShmHitBlock{};
+    }
+  };
+
+  // the hits of all sub-events of an event, per hit branch (probe) and sub-event entry
   template <typename T>
-  void mergeAndAdjustHits(std::string const& brname, TTree& origin, TTree& target,
+  struct SubEventHitsImpl : public SubEventHits {
+    std::vector<std::vector<SubEventHitEntry<T>>> branches;
+  };
+
+  // this merges the hits of several sub-events into a single entry in a target TTree / branch brname
+  // (assuming T is a vector; merging is simply done by appending)
+  // the trackIDs are fixed in bulk over the appended range of each sub-event
+  template <typename T>
+  void mergeAndAdjustHits(std::string const& brname, std::vector<SubEventHitEntry<T>>* entries, TTree& target,
                           std::vector<int> const& trackoffsets, std::vector<int> const& nprimaries, std::vector<int> const& subevtsOrdered)
   {
-    auto originbr = origin.GetBranch(brname.c_str());
-    if (originbr) {
-      auto targetdata = new T;
-      T* incomingdata = nullptr;
-      originbr->SetAddress(&incomingdata);
-
-      T* filladdress = nullptr;
-      if (origin.GetEntries() == 1) {
-        originbr->GetEntry(0);
-        filladdress = incomingdata;
-      } else {
-        Int_t entries = origin.GetEntries();
-        Int_t nprimTot = 0;
-        for (auto entry = 0; entry < entries; entry++) {
-          nprimTot += nprimaries[entry];
+    T targetdata;
+    T* filladdress = &targetdata;
+    const Int_t nentries = nprimaries.size();
+    auto getEntry = [entries](int entry) -> SubEventHitEntry<T>* {
+      return (entries && entry < entries->size() && !(*entries)[entry].empty()) ? &(*entries)[entry] : nullptr;
+    };
+    if (nentries == 1) {
+      // this avoids useless copy in case there was no sub-event splitting; we just use the original data
+      if (auto incomingdata = getEntry(0)) {
+        if (incomingdata->hits) {
+          filladdress = incomingdata->hits.get();
+        } else {
+          incomingdata->appendTo(targetdata);
+          incomingdata->release();
         }
-        // offset for pimary track index
-        Int_t idelta0 = 0;
-        // offset for secondary track index
-        Int_t idelta1 = nprimTot;
-        for (int entry = entries - 1; entry >= 0; --entry) {
-          // proceed in the order of subevent Ids
-          Int_t index = subevtsOrdered[entry];
-          // numbe of primaries for this event
-          Int_t nprim = nprimaries[index];
-          idelta1 -= nprim;
-          filladdress = targetdata;
-          originbr->GetEntry(index);
-          if (incomingdata) {
-            // fix the trackIDs for this data
-            for (auto& hit : *incomingdata) {
-              const auto oldID = hit.GetTrackID();
-              // offset depends on whether the trackis a primary or secondary
-              Int_t offset = (oldID < nprim) ? idelta0 : idelta1;
-              hit.SetTrackID(oldID + offset);
-            }
-            // this could be further generalized by using a policy for T
-            std::copy(incomingdata->begin(), incomingdata->end(), std::back_inserter(*targetdata));
-            // adjust offset
-            delete incomingdata;
-            incomingdata = nullptr;
-          }
-          // adjust offsets for next subevent
-          idelta0 += nprim;
-          idelta1 += trackoffsets[index];
-        } // subevent loop
       }
-      // fill target for this event
-      auto targetbr = o2::base::getOrMakeBranch(target, brname.c_str(), &filladdress);
-      targetbr->SetAddress(&filladdress);
-      targetbr->Fill();
-      targetbr->ResetAddress();
-      targetdata->clear();
-      if (incomingdata) {
-        delete incomingdata;
-        incomingdata = nullptr;
+    } else {
+      size_t nhits = 0;
+      Int_t nprimTot = 0;
+      for (auto entry = 0; entry < nentries; entry++) {
+        nprimTot += nprimaries[entry];
+        if (auto incomingdata = getEntry(entry)) {
+          nhits += incomingdata->size();
+        }
       }
-      delete targetdata;
+      targetdata.reserve(nhits);
+      // offset for pimary track index
+      Int_t idelta0 = 0;
+      // offset for secondary track index
+      Int_t idelta1 = nprimTot;
+      for (int entry = nentries - 1; entry >= 0; --entry) {
+        // proceed in the order of subevent Ids
+        Int_t index = subevtsOrdered[entry];
+        // numbe of primaries for this event
+        Int_t nprim = nprimaries[index];
+        idelta1 -= nprim;
+        if (auto incomingdata = getEntry(index)) {
+          const auto first = targetdata.size();
+          incomingdata->appendTo(targetdata);
+          incomingdata->release();
+          // fix the trackIDs for this data; offset depends on whether the track is a primary or secondary
+          for (auto hit = targetdata.begin() + first; hit != targetdata.end(); ++hit) {
+            const auto oldID = hit->GetTrackID();
+            hit->SetTrackID(oldID + ((oldID < nprim) ? idelta0 : idelta1));
+          }
+        }
+        // adjust offsets for next subevent
+        idelta0 += nprim;
+        idelta1 += trackoffsets[index];
+      } // subevent loop
     }
+    // fill target for this event
+    auto targetbr = o2::base::getOrMakeBranch(target, brname.c_str(), &filladdress);
+    targetbr->SetAddress(&filladdress);
+    targetbr->Fill();
+    targetbr->ResetAddress();
   }
 
-  void mergeHitEntries(TTree& origin, TTree& target, std::vector<int> const& trackoffsets, std::vector<int> const& nprimaries, std::vector<int> const& subevtsOrdered) final
+  void mergeHitEntries(SubEventHits* hits, TTree& target, std::vector<int> const& trackoffsets, std::vector<int> const& nprimaries, std::vector<int> const& subevtsOrdered) final
   {
     // loop over hit containers / different branches
     // adjust trackID in hits on the go
     int probe = 0;
     using Hit_t = decltype(static_cast<Det*>(this)->Det::getHits(probe));
+    using Container_t = typename std::remove_pointer<Hit_t>::type;
+    auto collected = static_cast<SubEventHitsImpl<Container_t>*>(hits);
     std::string name = static_cast<Det*>(this)->getHitBranchNames(probe++);
     while (name.size() > 0) {
-      mergeAndAdjustHits<typename std::remove_pointer<Hit_t>::type>(name, origin, target, trackoffsets, nprimaries, subevtsOrdered);
+      auto entries = (collected && collected->branches.size() >= probe) ? &collected->branches[probe - 1] : nullptr;
+      mergeAndAdjustHits<Container_t>(name, entries, target, trackoffsets, nprimaries, subevtsOrdered);
       // next name
       name = static_cast<Det*>(this)->getHitBranchNames(probe++);
     }
   }
 
  public:
-  void fillHitBranch(TTree& tr, FairMQParts& parts, int& index) override
+  void collectHits(std::unique_ptr<SubEventHits>& hits, int entry, HitEncoding encoding, FairMQParts& parts, int& index) override
   {
     int probe = 0;
     bool* busy = nullptr;
     using Hit_t = decltype(static_cast<Det*>(this)->Det::getHits(probe));
+    using Container_t = typename std::remove_pointer<Hit_t>::type;
+    if (!hits) {
+      hits = std::make_unique<SubEventHitsImpl<Container_t>>();
+    }
+    auto& branches = static_cast<SubEventHitsImpl<Container_t>&>(*hits).branches;
     std::string name = static_cast<Det*>(this)->getHitBranchNames(probe++);
     while (name.size() > 0) {
-      if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
-
+      if (branches.size() < probe) {
+        branches.resize(probe);
+      }
+      auto& entries = branches[probe - 1];
+      if (entries.size() <= entry) {
+        entries.resize(entry + 1);
+      }
+      if (encoding == HitEncoding::TMessage) {
         // for each branch name we extract/decode hits from the message parts ...
-        auto hitsptr = decodeTMessage<Hit_t>(parts, index++);
-        if (hitsptr) {
-          // ... and fill the tree branch
-          auto br = getOrMakeBranch(tr, name.c_str(), hitsptr);
-          br->SetAddress(static_cast<void*>(&hitsptr));
-          br->Fill();
-          br->ResetAddress();
-          delete hitsptr;
-        }
+        entries[entry].hits.reset(decodeTMessage<Hit_t>(parts, index++));
+      } else if (encoding == HitEncoding::ShmBlock) {
+        // ... or we keep the shared memory block until the hits are merged
+        entries[entry].release();
+        entries[entry].block = decodeShmHitBlockMessage(parts, index++);
       } else {
         // for each branch name we extract/decode hits from the message parts ...
+        // ... and copy them, since the shared memory buffer is given back to the sender
         auto hitsptr = decodeShmMessage<Hit_t>(parts, index++, busy);
-        // ... and fill the tree branch
-        auto br = getOrMakeBranch(tr, name.c_str(), hitsptr);
-        br->SetAddress(static_cast<void*>(&hitsptr));
-        br->Fill();
-        br->ResetAddress();
+        if (hitsptr) {
+          entries[entry].hits = std::make_unique<Container_t>(hitsptr->begin(), hitsptr->end());
+        }
       }
       // next name
       name = static_cast<Det*>(this)->getHitBranchNames(probe++);
@@ -552,6 +755,14 @@ class DetImpl : public o2::base::Detector
         probe++;
       }
     }
+    // the hit containers are sized from the previous event, so that they are not grown in the stepping
+    int probe = 0;
+    while (auto hits = static_cast<Det*>(this)->Det::getHits(probe)) {
+      if (probe < int(mLastHitCounts.size())) {
+        hits->reserve(mLastHitCounts[probe] + mLastHitCounts[probe] / 4);
+      }
+      probe++;
+    }
   }
 
   ~DetImpl() override
@@ -567,6 +778,7 @@ class DetImpl : public o2::base::Detector
       }
     }
     freeHitBuffers();
+    freeShmFreeBlocks();
   }
 
  protected:
@@ -575,7 +787,10 @@ class DetImpl : public o2::base::Detector
                                            // (like done in typical data aquisition systems)
   bool* mShmBusy[NHITBUFFERS] = {nullptr}; //! pointer to bool in shared mem indicating of IO busy
   std::vector<void*> mCachedPtr[NHITBUFFERS];
-  int mCurrentBuffer = 0; // holding the current buffer information
+  int mCurrentBuffer = 0;                  // holding the current buffer information
+  std::vector<ShmHitBlock> mShmHitBlocks;  //! shared memory blocks of trivially copyable hits sent, not yet released
+  std::vector<ShmHitBlock> mShmFreeBlocks; //! shared memory blocks released by the receiver, for reuse
+  std::vector<size_t> mLastHitCounts;      //! number of hits per container in the last event sent
   int mInitialized = false;
   ClassDefOverride(DetImpl, 0);
 };
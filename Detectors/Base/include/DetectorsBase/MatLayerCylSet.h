@@ -90,6 +90,8 @@ class MatLayerCylSet : public o2::gpu::FlatObject
   }
 #endif // !GPUCA_ALIGPUCODE
   GPUd() MatBudget getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1) const;
+  // get material budgets of n segments, the i-th one going from xyz0[3*i..3*i+2] to xyz1[3*i..3*i+2]
+  GPUd() void getMatBudget(const float* xyz0, const float* xyz1, int n, MatBudget* budgets) const;
 
   GPUd() int searchSegment(float val, int low = -1, int high = -1) const;
 
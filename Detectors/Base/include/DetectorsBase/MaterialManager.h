@@ -211,6 +211,17 @@ class MaterialManager
   /// and all of its daughters
   static void printContainingMedia(std::string const& volumename);
 
+  /// write the material and medium tables (index mappings, names, special cuts and processes) filled
+  /// while constructing the geometry, e.g. to cache them together with the geometry
+  void writeTables(std::ostream& stream) const;
+
+  /// restore the tables written by writeTables for a geometry loaded from file (the TGeo media
+  /// are looked up in gGeoManager); returns false if the tables cannot be read
+  bool readTables(std::istream& stream);
+
+  /// pass the restored special cuts and processes to the VMC engine, once it knows the media
+  void applySpecialCutsAndProcesses() const;
+
  private:
   MaterialManager() = default;
 
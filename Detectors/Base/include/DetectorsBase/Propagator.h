@@ -27,6 +27,9 @@
 #ifndef GPUCA_GPUCODE
 #include <string>
 #endif
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+#include <gsl/span>
+#endif
 
 namespace o2
 {
@@ -61,6 +64,8 @@ class PropagatorImpl
   using TrackPar_t = track::TrackParametrization<value_type>;
   using TrackParCov_t = track::TrackParametrizationWithError<value_type>;
 
+  /// Material queries with USEMatCorrLUT only read the MatLayerCylSet, so that tracks can be propagated concurrently,
+  /// while USEMatCorrTGeo uses the TGeo navigator of the geometry, which must not be used from several threads
   enum class MatCorrType : int {
     USEMatCorrNONE, // flag to not use material corrections
     USEMatCorrTGeo, // flag to use TGeo for material queries
@@ -86,6 +91,19 @@ class PropagatorImpl
                            value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
                            track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0) const;
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+  // batched versions: propagate every tracks[i] to xToGo[i], the tracks are advanced in lockstep, step by step.
+  // status (if not empty) is filled with the per-track outcome, tofInfo (if not empty) is updated per track.
+  // Return the number of successfully propagated tracks
+  int PropagateToXBxByBz(gsl::span<TrackParCov_t> tracks, gsl::span<const value_type> xToGo, gsl::span<bool> status = {},
+                         value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
+                         gsl::span<track::TrackLTIntegral> tofInfo = {}, int signCorr = 0) const;
+
+  int propagateToX(gsl::span<TrackParCov_t> tracks, gsl::span<const value_type> xToGo, value_type bZ, gsl::span<bool> status = {},
+                   value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
+                   gsl::span<track::TrackLTIntegral> tofInfo = {}, int signCorr = 0) const;
+#endif
+
   template <typename track_T>
   GPUd() bool propagateTo(track_T& track, value_type x, bool bzOnly = false, value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP,
                           MatCorrType matCorr = MatCorrType::USEMatCorrLUT, track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0) const
@@ -16,6 +16,7 @@
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "DetectorsBase/CTFCoderBase.h"
 #include <filesystem>
+#include <cmath>
 
 using namespace o2::ctf;
 
@@ -73,3 +74,25 @@ void CTFCoderBase::checkDictVersion(const CTFDictHeader& h) const
     }
   }
 }
+
+double CTFCoderBase::klDivergence(const o2::rans::FrequencyTable& freq, const o2::rans::FrequencyTable& dict, int literalBits)
+{
+  const double nSamples = freq.getNumSamples(), nDictSamples = dict.getNumSamples();
+  if (nSamples == 0) {
+    return 0.;
+  }
+  if (nDictSamples == 0) {
+    return literalBits;
+  }
+  double kl = 0.;
+  for (auto symbol = freq.getMinSymbol(); symbol <= freq.getMaxSymbol(); symbol++) {
+    const auto count = freq[symbol];
+    if (!count) {
+      continue;
+    }
+    const double p = count / nSamples;
+    const auto dictCount = (symbol >= dict.getMinSymbol() && symbol <= dict.getMaxSymbol()) ? dict[symbol] : 0;
+    kl += dictCount ? p * std::log2(p * nDictSamples / dictCount) : p * literalBits;
+  }
+  return kl;
+}
@@ -206,11 +206,90 @@ void attachMessageBufferToParts(FairMQParts& parts, FairMQChannel& channel, void
   std::unique_ptr<FairMQMessage> message(channel.NewMessage(data, size, free_func, hint));
   parts.AddPart(std::move(message));
 }
-void attachDetIDHeaderMessage(int id, FairMQChannel& channel, FairMQParts& parts)
+namespace
 {
-  std::unique_ptr<FairMQMessage> message(channel.NewSimpleMessage(id));
+struct detidheader {
+  int id;
+  int encoding;
+};
+struct shmblockcontext {
+  void* data;
+  size_t size;
+  bool* busy_ptr;
+};
+} // namespace
+
+void attachDetIDHeaderMessage(int id, FairMQChannel& channel, FairMQParts& parts, HitEncoding encoding)
+{
+  std::unique_ptr<FairMQMessage> message(channel.NewSimpleMessage(detidheader{id, static_cast<int>(encoding)}));
   parts.AddPart(std::move(message));
 }
+bool decodeDetIDHeaderMessage(FairMQParts& dataparts, int index, int& id, HitEncoding& encoding)
+{
+  auto& message = dataparts.At(index);
+  if (message->GetSize() != sizeof(detidheader)) {
+    return false;
+  }
+  auto header = (detidheader*)message->GetData();
+  id = header->id;
+  encoding = static_cast<HitEncoding>(header->encoding);
+  return true;
+}
+
+bool allocateShmHitBlock(ShmHitBlock& block, size_t size)
+{
+  auto& instance = o2::utils::ShmManager::Instance();
+  block = ShmHitBlock{};
+  block.busy = (bool*)instance.trygetmemblock(sizeof(bool));
+  if (!block.busy) {
+    return false;
+  }
+  if (size > 0) {
+    block.data = instance.trygetmemblock(size);
+    if (!block.data) {
+      instance.freememblock(block.busy);
+      block.busy = nullptr;
+      return false;
+    }
+  }
+  block.size = size;
+  block.capacity = size;
+  *block.busy = true;
+  return true;
+}
+void freeShmHitBlock(ShmHitBlock& block)
+{
+  auto& instance = o2::utils::ShmManager::Instance();
+  if (block.data) {
+    instance.freememblock(block.data, block.capacity);
+  }
+  if (block.busy) {
+    instance.freememblock(block.busy);
+  }
+  block = ShmHitBlock{};
+}
+void releaseShmHitBlock(ShmHitBlock& block)
+{
+  if (block.busy) {
+    *block.busy = false;
+  }
+}
+void attachShmHitBlockMessage(ShmHitBlock const& block, FairMQChannel& channel, FairMQParts& parts)
+{
+  assert(o2::utils::ShmManager::Instance().isPointerOk(block.busy));
+  std::unique_ptr<FairMQMessage> message(channel.NewSimpleMessage(shmblockcontext{block.data, block.size, block.busy}));
+  parts.AddPart(std::move(message));
+}
+ShmHitBlock decodeShmHitBlockMessage(FairMQParts& dataparts, int index)
+{
+  auto rawmessage = std::move(dataparts.At(index));
+  auto info = (shmblockcontext*)rawmessage->GetData();
+  ShmHitBlock block;
+  block.data = info->data;
+  block.size = info->size;
+  block.busy = info->busy_ptr;
+  return block;
+}
 void attachShmMessage(void* hits_ptr, FairMQChannel& channel, FairMQParts& parts, bool* busy_ptr)
 {
   struct shmcontext {
@@ -364,6 +364,17 @@ GPUd() MatBudget MatLayerCylSet::getMatBudget(float x0, float y0, float z0, floa
   return rval;
 }
 
+//_________________________________________________________________________________________________
+GPUd() void MatLayerCylSet::getMatBudget(const float* xyz0, const float* xyz1, int n, MatBudget* budgets) const
+{
+  // get material budgets for a batch of segments, e.g. the steps of many tracks propagated together
+  for (int i = 0; i < n; i++) {
+    const float* p0 = xyz0 + 3 * i;
+    const float* p1 = xyz1 + 3 * i;
+    budgets[i] = getMatBudget(p0[0], p0[1], p0[2], p1[0], p1[1], p1[2]);
+  }
+}
+
 //_________________________________________________________________________________________________
 GPUd() bool MatLayerCylSet::getLayersRange(const Ray& ray, short& lmin, short& lmax) const
 {
@@ -19,6 +19,9 @@
 #include <TGeoManager.h>
 #include <TList.h>
 #include <iostream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 #include <utility>
 #include <FairLogger.h>
 #ifdef NDEBUG
@@ -626,6 +629,110 @@ const char* MaterialManager::getMediumNameFromMediumID(int globalindex) const
   return "UNKNOWN";
 }
 
+void MaterialManager::writeTables(std::ostream& stream) const
+{
+  // one entry per line, the names are quoted since they may contain blanks
+  stream << std::setprecision(std::numeric_limits<Float_t>::max_digits10);
+  for (auto& m : mMaterialMap) {
+    for (auto& i : m.second) {
+      stream << "material " << std::quoted(m.first) << " " << i.first << " " << i.second << "\n";
+    }
+  }
+  for (auto& m : mMediumMap) {
+    for (auto& i : m.second) {
+      stream << "medium " << std::quoted(m.first) << " " << i.first << " " << i.second << "\n";
+    }
+  }
+  for (auto& n : mMaterialNameToGlobalIndexMap) {
+    stream << "materialname " << std::quoted(n.first) << " " << n.second << "\n";
+  }
+  for (auto& n : mMediumNameToGlobalIndexMap) {
+    stream << "mediumname " << std::quoted(n.first) << " " << n.second << "\n";
+  }
+  for (auto& m : mMediumProcessMap) {
+    for (auto& p : m.second) {
+      stream << "process " << m.first << " " << static_cast<int>(p.first) << " " << p.second << "\n";
+    }
+  }
+  for (auto& m : mMediumCutMap) {
+    for (auto& c : m.second) {
+      stream << "cut " << m.first << " " << static_cast<int>(c.first) << " " << c.second << "\n";
+    }
+  }
+}
+
+bool MaterialManager::readTables(std::istream& stream)
+{
+  mMaterialMap.clear();
+  mMediumMap.clear();
+  mMaterialNameToGlobalIndexMap.clear();
+  mMediumNameToGlobalIndexMap.clear();
+  mMediumProcessMap.clear();
+  mMediumCutMap.clear();
+  mTGeoMediumMap.clear();
+
+  std::string line;
+  while (std::getline(stream, line)) {
+    std::istringstream entry(line);
+    std::string type, name;
+    int local = 0, global = 0, id = 0;
+    entry >> type;
+    if (type == "material" || type == "medium") {
+      entry >> std::quoted(name) >> local >> global;
+      (type == "material" ? mMaterialMap : mMediumMap)[name][local] = global;
+    } else if (type == "materialname" || type == "mediumname") {
+      entry >> std::quoted(name) >> global;
+      (type == "materialname" ? mMaterialNameToGlobalIndexMap : mMediumNameToGlobalIndexMap)[name] = global;
+    } else if (type == "process") {
+      int val = 0;
+      entry >> global >> id >> val;
+      mMediumProcessMap[global][static_cast<EProc>(id)] = val;
+    } else if (type == "cut") {
+      Float_t val = 0;
+      entry >> global >> id >> val;
+      mMediumCutMap[global][static_cast<ECut>(id)] = val;
+    } else if (!type.empty()) {
+      LOG(ERROR) << "Unknown entry in material tables: " << line;
+      return false;
+    }
+    if (entry.fail()) {
+      LOG(ERROR) << "Failed to parse entry in material tables: " << line;
+      return false;
+    }
+  }
+
+  // the TGeo media of the loaded geometry carry the global indices
+  for (auto& m : mMediumMap) {
+    for (auto& i : m.second) {
+      auto med = gGeoManager ? gGeoManager->GetMedium(i.second) : nullptr;
+      if (!med) {
+        LOG(ERROR) << "No TGeo medium with index " << i.second << " for " << m.first << " medium " << i.first;
+        return false;
+      }
+      mTGeoMediumMap[std::make_pair(m.first, i.first)] = med;
+    }
+  }
+  return true;
+}
+
+void MaterialManager::applySpecialCutsAndProcesses() const
+{
+  if (mApplySpecialProcesses) {
+    for (auto& m : mMediumProcessMap) {
+      for (auto& p : m.second) {
+        TVirtualMC::GetMC()->Gstpar(m.first, getProcessName(p.first), p.second);
+      }
+    }
+  }
+  if (mApplySpecialCuts) {
+    for (auto& m : mMediumCutMap) {
+      for (auto& c : m.second) {
+        TVirtualMC::GetMC()->Gstpar(m.first, getCutName(c.first), c.second);
+      }
+    }
+  }
+}
+
 /// print all tracking media inside a logical volume (specified by name)
 /// and all of its daughters
 void MaterialManager::printContainingMedia(std::string const& volumename)
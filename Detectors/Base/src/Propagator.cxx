@@ -29,6 +29,7 @@ using namespace o2::gpu;
 #include "DetectorsBase/GeometryManager.h"
 #include <FairRunAna.h> // eventually will get rid of it
 #include <TGeoGlobalMagField.h>
+#include <vector>
 
 template <typename value_T>
 PropagatorImpl<value_T>::PropagatorImpl(bool uninitialized)
@@ -354,6 +355,136 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackPar_t& track, value_type
   return true;
 }
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+//_______________________________________________________________________
+template <typename value_T>
+int PropagatorImpl<value_T>::PropagateToXBxByBz(gsl::span<TrackParCov_t> tracks, gsl::span<const value_type> xToGo, gsl::span<bool> status,
+                                                value_type maxSnp, value_type maxStep, PropagatorImpl<value_T>::MatCorrType matCorr,
+                                                gsl::span<track::TrackLTIntegral> tofInfo, int signCorr) const
+{
+  //----------------------------------------------------------------
+  //
+  // Batched version of the PropagateToXBxByBz: propagates tracks[i] to the plane X=xToGo[i] (cm)
+  // taking into account all the three components of the magnetic field
+  // and correcting for the crossed material.
+  // The tracks are advanced in lockstep: at every step the field is fetched for all active tracks
+  // in a dedicated loop, then the active tracks are propagated and corrected for the material.
+  // The results are identical to those of the single track version.
+  //
+  // status   - optional per-track outcome, if not empty must have the size of tracks
+  // tofInfo  - optional per-track containers for track length and PID-dependent TOF integration
+  //
+  // Returns the number of successfully propagated tracks
+  //----------------------------------------------------------------
+  const size_t nTracks = tracks.size();
+  if (xToGo.size() != nTracks || (!status.empty() && status.size() != nTracks) || (!tofInfo.empty() && tofInfo.size() != nTracks)) {
+    LOG(FATAL) << "Inconsistent sizes in batched propagation: " << nTracks << " tracks, " << xToGo.size() << " X, "
+               << status.size() << " status, " << tofInfo.size() << " tofInfo";
+  }
+  const value_type Epsilon = 0.00001;
+  std::vector<int> active;
+  std::vector<int> signs(nTracks);
+  std::vector<math_utils::Point3D<value_type>> xyz0(nTracks);
+  std::vector<gpu::gpustd::array<value_type, 3>> b(nTracks);
+  active.reserve(nTracks);
+  int nDone = 0;
+  auto setStatus = [&status, &nDone](int i, bool res) {
+    if (!status.empty()) {
+      status[i] = res;
+    }
+    nDone += res;
+  };
+  for (size_t i = 0; i < nTracks; i++) {
+    auto dx = xToGo[i] - tracks[i].getX();
+    signs[i] = signCorr ? signCorr : (dx > 0.f ? -1 : 1); // sign of eloss correction is not imposed
+    if (math_utils::detail::abs<value_type>(dx) > Epsilon) {
+      active.push_back(i);
+    } else {
+      tracks[i].setX(xToGo[i]);
+      setStatus(i, true);
+    }
+  }
+
+  while (!active.empty()) {
+    for (auto i : active) {
+      xyz0[i] = tracks[i].getXYZGlo();
+      getFieldXYZ(xyz0[i], &b[i][0]);
+    }
+    size_t nActive = 0;
+    for (auto i : active) {
+      auto& track = tracks[i];
+      auto dx = xToGo[i] - track.getX();
+      auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
+      if (dx < 0) {
+        step = -step;
+      }
+      if (!track.propagateTo(track.getX() + step, b[i]) || (maxSnp > 0 && math_utils::detail::abs<value_type>(track.getSnp()) >= maxSnp)) {
+        setStatus(i, false);
+        continue;
+      }
+      auto* tof = tofInfo.empty() ? nullptr : &tofInfo[i];
+      if (matCorr != MatCorrType::USEMatCorrNONE) {
+        auto xyz1 = track.getXYZGlo();
+        auto mb = getMatBudget(matCorr, xyz0[i], xyz1);
+        if (!track.correctForMaterial(mb.meanX2X0, mb.getXRho(signs[i]))) {
+          setStatus(i, false);
+          continue;
+        }
+        if (tof) {
+          tof->addStep(mb.length, track.getP2Inv()); // fill L,ToF info using already calculated step length
+          tof->addX2X0(mb.meanX2X0);
+          tof->addXRho(mb.getXRho(signs[i]));
+        }
+      } else if (tof) { // if tofInfo filling was requested w/o material correction, we need to calculate the step lenght
+        auto xyz1 = track.getXYZGlo();
+        math_utils::Vector3D<value_type> stepV(xyz1.X() - xyz0[i].X(), xyz1.Y() - xyz0[i].Y(), xyz1.Z() - xyz0[i].Z());
+        tof->addStep(stepV.R(), track.getP2Inv());
+      }
+      if (math_utils::detail::abs<value_type>(xToGo[i] - track.getX()) > Epsilon) {
+        active[nActive++] = i;
+      } else {
+        track.setX(xToGo[i]);
+        setStatus(i, true);
+      }
+    }
+    active.resize(nActive);
+  }
+  return nDone;
+}
+
+//_______________________________________________________________________
+template <typename value_T>
+int PropagatorImpl<value_T>::propagateToX(gsl::span<TrackParCov_t> tracks, gsl::span<const value_type> xToGo, value_type bZ, gsl::span<bool> status,
+                                          value_type maxSnp, value_type maxStep, PropagatorImpl<value_T>::MatCorrType matCorr,
+                                          gsl::span<track::TrackLTIntegral> tofInfo, int signCorr) const
+{
+  //----------------------------------------------------------------
+  //
+  // Batched version of the propagateToX in the constant field bZ: propagates tracks[i] to the plane X=xToGo[i] (cm)
+  // There is no field lookup to share between the tracks, so they are processed one after the other.
+  //
+  // status   - optional per-track outcome, if not empty must have the size of tracks
+  // tofInfo  - optional per-track containers for track length and PID-dependent TOF integration
+  //
+  // Returns the number of successfully propagated tracks
+  //----------------------------------------------------------------
+  const size_t nTracks = tracks.size();
+  if (xToGo.size() != nTracks || (!status.empty() && status.size() != nTracks) || (!tofInfo.empty() && tofInfo.size() != nTracks)) {
+    LOG(FATAL) << "Inconsistent sizes in batched propagation: " << nTracks << " tracks, " << xToGo.size() << " X, "
+               << status.size() << " status, " << tofInfo.size() << " tofInfo";
+  }
+  int nDone = 0;
+  for (size_t i = 0; i < nTracks; i++) {
+    bool res = propagateToX(tracks[i], xToGo[i], bZ, maxSnp, maxStep, matCorr, tofInfo.empty() ? nullptr : &tofInfo[i], signCorr);
+    if (!status.empty()) {
+      status[i] = res;
+    }
+    nDone += res;
+  }
+  return nDone;
+}
+#endif
+
 //_______________________________________________________________________
 template <typename value_T>
 GPUd() bool PropagatorImpl<value_T>::propagateToDCA(const o2::dataformats::VertexBase& vtx, TrackParCov_t& track, value_type bZ,
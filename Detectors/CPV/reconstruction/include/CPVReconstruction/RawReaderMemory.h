@@ -11,6 +11,7 @@
 #ifndef ALICEO2_CPV_RAWREADERMEMORY_H
 #define ALICEO2_CPV_RAWREADERMEMORY_H
 
+#include <vector>
 #include <gsl/span>
 #include <Rtypes.h>
 
@@ -50,7 +51,8 @@ enum RawErrorType_t {
 /// \author Dmitri Peresunko after Markus Fasel
 /// \since Sept. 25, 2020
 ///
-///It reads one HBF, stores HBF orbit number in getCurrentHBFOrbit() and produces digits in AddressChargeBC format
+///It reads one HBF, stores HBF orbit number in getCurrentHBFOrbit() and produces digits in AddressChargeBC format.
+///The payload is not copied: the reader keeps views of the page payloads in the raw memory chunk
 class RawReaderMemory
 {
  public:
@@ -84,12 +86,12 @@ class RawReaderMemory
   const o2::header::RDHAny& getRawHeader() const { return mRawHeader; }
 
   /// \brief access to the full raw payload (single or multiple DMA pages)
-  /// \return Raw Payload of the data until the stop bit is received.
-  const std::vector<char>& getPayload() const { return mRawPayload; }
+  /// \return Views of the page payloads in the raw memory until the stop bit is received.
+  const std::vector<gsl::span<const char>>& getPayloadPages() const { return mPayloadPages; }
 
   /// \brief Return size of the payload
   /// \return size of the payload
-  int getPayloadSize() const { return mRawPayload.size(); }
+  int getPayloadSize() const { return mPayloadSize; }
 
   /// \brief get the size of the file in bytes
   /// \return size of the file in byte
@@ -111,17 +113,18 @@ class RawReaderMemory
   o2::header::RDHAny decodeRawHeader(const void* headerwords);
 
  private:
-  gsl::span<const char> mRawMemoryBuffer; ///< Memory block with multiple DMA pages
-  o2::header::RDHAny mRawHeader;          ///< Raw header
-  std::vector<char> mRawPayload;          ///< Raw payload (can consist of multiple pages)
-  int mCurrentPosition = 0;               ///< Current page in file
-  bool mRawHeaderInitialized = false;     ///< RDH for current page initialized
-  bool mPayloadInitialized = false;       ///< Payload for current page initialized
-  uint32_t mCurrentHBFOrbit = 0;          ///< Current orbit of HBF
-  bool mStopBitWasNotFound;               ///< True if StopBit was not found but HBF orbit changed
-  bool mIsJustInited = false;             ///< True if init() was just called
-
-  ClassDefNV(RawReaderMemory, 2);
+  gsl::span<const char> mRawMemoryBuffer;           ///< Memory block with multiple DMA pages
+  o2::header::RDHAny mRawHeader;                    ///< Raw header
+  std::vector<gsl::span<const char>> mPayloadPages; ///< Raw payload of the pages (can consist of multiple pages)
+  int mPayloadSize = 0;                             ///< Total size of the raw payload
+  int mCurrentPosition = 0;                         ///< Current page in file
+  bool mRawHeaderInitialized = false;               ///< RDH for current page initialized
+  bool mPayloadInitialized = false;                 ///< Payload for current page initialized
+  uint32_t mCurrentHBFOrbit = 0;                    ///< Current orbit of HBF
+  bool mStopBitWasNotFound;                         ///< True if StopBit was not found but HBF orbit changed
+  bool mIsJustInited = false;                       ///< True if init() was just called
+
+  ClassDefNV(RawReaderMemory, 3);
 };
 
 } // namespace cpv
@@ -30,9 +30,9 @@ RawErrorType_t RawDecoder::decode()
   short linkID = o2::raw::RDHUtils::getLinkID(rdh);
   mDigits.clear();
   mBCRecords.clear();
+  mErrors.clear();
 
-  auto payloadWords = mRawReader.getPayload();
-  if (payloadWords.size() == 0) {
+  if (mRawReader.getPayloadSize() == 0) {
     return kOK_NO_PAYLOAD;
   }
 
@@ -43,93 +43,94 @@ RawErrorType_t RawDecoder::readChannels()
 {
   mChannelsInitialized = false;
 
-  auto& payloadWords = mRawReader.getPayload();
   uint32_t wordCountFromLastHeader = 1; //header word is included
   int nDigitsAddedFromLastHeader = 0;
   bool isHeaderExpected = true;    //true if we expect to read header, false otherwise
   bool skipUntilNextHeader = true; //true if something wrong with data format, try to read next header
   uint16_t currentBC;
   uint32_t currentOrbit = mRawReader.getCurrentHBFOrbit();
-  auto b = payloadWords.cbegin();
-  auto e = payloadWords.cend();
-  while (b != e) { //payload must start with cpvheader folowed by cpvwords and finished with cpvtrailer
-    CpvHeader header(b, e);
-    if (header.isOK()) {
-      LOG(DEBUG) << "RawDecoder::readChannels() : "
-                 << "I read cpv header for orbit = " << header.orbit()
-                 << " and BC = " << header.bc();
-      if (!isHeaderExpected) { //actually, header was not expected
-        LOG(ERROR) << "RawDecoder::readChannels() : "
-                   << "header was not expected";
-        removeLastNDigits(nDigitsAddedFromLastHeader); //remove previously added digits as they are bad
-        mErrors.emplace_back(5, 0, 0, 0, kNO_CPVTRAILER);
-      }
-      skipUntilNextHeader = false;
-      currentBC = header.bc();
-      wordCountFromLastHeader = 0;
-      nDigitsAddedFromLastHeader = 0;
-      if (currentOrbit != header.orbit()) { //bad cpvheader
-        LOG(ERROR) << "RawDecoder::readChannels() : "
-                   << "currentOrbit(=" << currentOrbit
-                   << ") != header.orbit()(=" << header.orbit() << ")";
-        mErrors.emplace_back(5, 0, 0, 0, kCPVHEADER_INVALID); //5 is non-existing link with general errors
-        skipUntilNextHeader = true;
-      }
-    } else {
-      if (skipUntilNextHeader) {
-        b += 16;
-        continue; //continue while'ing until it's not header
-      }
-      CpvWord word(b, e);
-      if (word.isOK()) {
-        wordCountFromLastHeader++;
-        for (int i = 0; i < 3; i++) {
-          PadWord pw = {word.cpvPadWord(i)};
-          if (pw.zero == 0) { //cpv pad word, not control or empty
-            if (addDigit(pw.mDataWord, word.ccId(), currentBC)) {
-              nDigitsAddedFromLastHeader++;
-            } else {
-              LOG(DEBUG) << "RawDecoder::readChannels() : "
-                         << "read pad word with non-valid pad address";
-              unsigned int dil = pw.dil, gas = pw.gas, address = pw.address;
-              mErrors.emplace_back(word.ccId(), dil, gas, address, kPadAddress);
-            }
-          }
+  for (auto& page : mRawReader.getPayloadPages()) { //cpv words are read directly from the page payloads in the raw memory
+    auto b = page.data();
+    auto e = page.data() + page.size();
+    while (b < e) { //payload must start with cpvheader folowed by cpvwords and finished with cpvtrailer
+      CpvHeader header(b, e);
+      if (header.isOK()) {
+        LOG(DEBUG) << "RawDecoder::readChannels() : "
+                   << "I read cpv header for orbit = " << header.orbit()
+                   << " and BC = " << header.bc();
+        if (!isHeaderExpected) { //actually, header was not expected
+          LOG(ERROR) << "RawDecoder::readChannels() : "
+                     << "header was not expected";
+          removeLastNDigits(nDigitsAddedFromLastHeader); //remove previously added digits as they are bad
+          mErrors.emplace_back(5, 0, 0, 0, kNO_CPVTRAILER);
         }
-      } else { //this may be trailer
-        CpvTrailer trailer(b, e);
-        if (trailer.isOK()) {
-          int diffInCount = wordCountFromLastHeader - trailer.wordCounter();
-          if (diffInCount > 1 ||
-              diffInCount < -1) {
-            //some words lost?
-            LOG(ERROR) << "RawDecoder::readChannels() : "
-                       << "Read " << wordCountFromLastHeader << " words, expected " << trailer.wordCounter();
-            mErrors.emplace_back(5, 0, 0, 0, kCPVTRAILER_INVALID);
-            //throw all previous data and go to next header
-            removeLastNDigits(nDigitsAddedFromLastHeader);
-            skipUntilNextHeader = true;
+        skipUntilNextHeader = false;
+        currentBC = header.bc();
+        wordCountFromLastHeader = 0;
+        nDigitsAddedFromLastHeader = 0;
+        if (currentOrbit != header.orbit()) { //bad cpvheader
+          LOG(ERROR) << "RawDecoder::readChannels() : "
+                     << "currentOrbit(=" << currentOrbit
+                     << ") != header.orbit()(=" << header.orbit() << ")";
+          mErrors.emplace_back(5, 0, 0, 0, kCPVHEADER_INVALID); //5 is non-existing link with general errors
+          skipUntilNextHeader = true;
+        }
+      } else {
+        if (skipUntilNextHeader) {
+          b += 16;
+          continue; //continue while'ing until it's not header
+        }
+        CpvWord word(b, e);
+        if (word.isOK()) {
+          wordCountFromLastHeader++;
+          for (int i = 0; i < 3; i++) {
+            PadWord pw = {word.cpvPadWord(i)};
+            if (pw.zero == 0) { //cpv pad word, not control or empty
+              if (addDigit(pw.mDataWord, word.ccId(), currentBC)) {
+                nDigitsAddedFromLastHeader++;
+              } else {
+                LOG(DEBUG) << "RawDecoder::readChannels() : "
+                           << "read pad word with non-valid pad address";
+                unsigned int dil = pw.dil, gas = pw.gas, address = pw.address;
+                mErrors.emplace_back(word.ccId(), dil, gas, address, kPadAddress);
+              }
+            }
           }
-          if (trailer.bc() != currentBC) {
-            //trailer does not fit header
+        } else { //this may be trailer
+          CpvTrailer trailer(b, e);
+          if (trailer.isOK()) {
+            int diffInCount = wordCountFromLastHeader - trailer.wordCounter();
+            if (diffInCount > 1 ||
+                diffInCount < -1) {
+              //some words lost?
+              LOG(ERROR) << "RawDecoder::readChannels() : "
+                         << "Read " << wordCountFromLastHeader << " words, expected " << trailer.wordCounter();
+              mErrors.emplace_back(5, 0, 0, 0, kCPVTRAILER_INVALID);
+              //throw all previous data and go to next header
+              removeLastNDigits(nDigitsAddedFromLastHeader);
+              skipUntilNextHeader = true;
+            }
+            if (trailer.bc() != currentBC) {
+              //trailer does not fit header
+              LOG(ERROR) << "RawDecoder::readChannels() : "
+                         << "CPVHeader BC is " << currentBC << " but CPVTrailer BC is " << trailer.bc();
+              mErrors.emplace_back(5, 0, 0, 0, kCPVTRAILER_INVALID);
+              removeLastNDigits(nDigitsAddedFromLastHeader);
+              skipUntilNextHeader = true;
+            }
+            isHeaderExpected = true;
+          } else {
+            wordCountFromLastHeader++;
+            //error
             LOG(ERROR) << "RawDecoder::readChannels() : "
-                       << "CPVHeader BC is " << currentBC << " but CPVTrailer BC is " << trailer.bc();
-            mErrors.emplace_back(5, 0, 0, 0, kCPVTRAILER_INVALID);
-            removeLastNDigits(nDigitsAddedFromLastHeader);
-            skipUntilNextHeader = true;
+                       << "Read unknown word";
+            mErrors.emplace_back(5, 0, 0, 0, kUNKNOWN_WORD); //add error for non-existing row
+            //what to do?
           }
-          isHeaderExpected = true;
-        } else {
-          wordCountFromLastHeader++;
-          //error
-          LOG(ERROR) << "RawDecoder::readChannels() : "
-                     << "Read unknown word";
-          mErrors.emplace_back(5, 0, 0, 0, kUNKNOWN_WORD); //add error for non-existing row
-          //what to do?
         }
       }
+      b += 16;
     }
-    b += 16;
   }
   mChannelsInitialized = true;
   return kOK;
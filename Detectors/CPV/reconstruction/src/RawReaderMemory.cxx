@@ -58,7 +58,8 @@ void RawReaderMemory::init()
 //it means we read 1 HBF per next() call
 RawErrorType_t RawReaderMemory::next()
 {
-  mRawPayload.clear();
+  mPayloadPages.clear();
+  mPayloadSize = 0;
   bool isStopBitFound = false;
   do {
     RawErrorType_t e = nextPage();
@@ -110,7 +111,6 @@ RawErrorType_t RawReaderMemory::nextPage()
   mRawHeader = rawHeader; //save RDH of current page as mRawHeader
   mRawHeaderInitialized = true;
 
-  auto tmp = mRawMemoryBuffer.data();
   int start = (mCurrentPosition + RDHDecoder::getHeaderSize(mRawHeader));
   int end = (mCurrentPosition + RDHDecoder::getMemorySize(mRawHeader));
   bool isPayloadIncomplete = false;
@@ -118,8 +118,9 @@ RawErrorType_t RawReaderMemory::nextPage()
     // Payload incomplete
     end = mRawMemoryBuffer.size(); //OK, lets read it anyway. Maybe there still are some completed events...
   }
-  for (auto iword = start; iword < end; iword++) {
-    mRawPayload.push_back(tmp[iword]);
+  if (end > start) {
+    mPayloadPages.emplace_back(mRawMemoryBuffer.data() + start, end - start);
+    mPayloadSize += end - start;
   }
   mPayloadInitialized = true;
 
@@ -128,6 +128,8 @@ void RawToDigitConverterSpec::run(framework::ProcessingContext& ctx)
   };
   for (const auto& rawData : framework::InputRecordWalker(ctx.inputs(), rawFilter)) {
     o2::cpv::RawReaderMemory rawreader(o2::framework::DataRefUtils::as<const char>(rawData));
+    // the decoder reads the pages directly from the input, its buffers are reused for all HBFs
+    o2::cpv::RawDecoder decoder(rawreader);
     // loop over all the DMA pages
     while (rawreader.hasNext()) {
       try {
@@ -154,7 +156,6 @@ void RawToDigitConverterSpec::run(framework::ProcessingContext& ctx)
         mOutputHWErrors.emplace_back(25, mod, 0, 0, kRDH_INVALID); //Add non-existing modules to non-existing ccId 25 and dilogic = mod
         continue;                                                  //skip STU mod
       }
-      o2::cpv::RawDecoder decoder(rawreader);
       RawErrorType_t err = decoder.decode();
 
       if (!(err == kOK || err == kOK_NO_PAYLOAD)) {
@@ -164,7 +165,7 @@ void RawToDigitConverterSpec::run(framework::ProcessingContext& ctx)
       }
 
       std::shared_ptr<std::vector<o2::cpv::Digit>> currentDigitContainer;
-      auto digilets = decoder.getDigits();
+      auto& digilets = decoder.getDigits();
       if (digilets.empty()) { //no digits -> continue to next pages
         continue;
       }
@@ -172,16 +173,15 @@ void RawToDigitConverterSpec::run(framework::ProcessingContext& ctx)
       // Loop over all the BCs
       for (auto itBCRecords : decoder.getBCRecords()) {
         currentIR.bc = itBCRecords.bc;
+        auto found = digitBuffer.find(currentIR);
+        if (found == digitBuffer.end()) {
+          currentDigitContainer = std::make_shared<std::vector<o2::cpv::Digit>>();
+          digitBuffer[currentIR] = currentDigitContainer;
+        } else {
+          currentDigitContainer = found->second;
+        }
         for (int iDig = itBCRecords.firstDigit; iDig <= itBCRecords.lastDigit; iDig++) {
           auto adch = digilets[iDig];
-          auto found = digitBuffer.find(currentIR);
-          if (found == digitBuffer.end()) {
-            currentDigitContainer = std::make_shared<std::vector<o2::cpv::Digit>>();
-            digitBuffer[currentIR] = currentDigitContainer;
-          } else {
-            currentDigitContainer = found->second;
-          }
-
           AddressCharge ac = {adch};
           unsigned short absId = ac.Address;
           //if we deal with non-pedestal data?
@@ -209,15 +209,13 @@ void RawToDigitConverterSpec::run(framework::ProcessingContext& ctx)
   // Loop over BCs, sort digits with increasing digit ID and write to output containers
   mOutputDigits.clear();
   mOutputTriggerRecords.clear();
-  for (auto [bc, digits] : digitBuffer) {
+  for (auto& [bc, digits] : digitBuffer) {
     int prevDigitSize = mOutputDigits.size();
     if (digits->size()) {
       // Sort digits according to digit ID
       std::sort(digits->begin(), digits->end(), [](o2::cpv::Digit& lhs, o2::cpv::Digit& rhs) { return lhs.getAbsId() < rhs.getAbsId(); });
 
-      for (auto digit : *digits) {
-        mOutputDigits.push_back(digit);
-      }
+      mOutputDigits.insert(mOutputDigits.end(), digits->begin(), digits->end());
     }
 
     mOutputTriggerRecords.emplace_back(bc, prevDigitSize, mOutputDigits.size() - prevDigitSize);
@@ -141,4 +141,27 @@ BOOST_AUTO_TEST_CASE(CompressedClustersTest)
   for (int i = 0; i < npatt; i += 100) {
     BOOST_CHECK(pattVecD[i] == pattVec[i]);
   }
+
+  // with adaptive dictionaries the 2nd TF reuses the encoders of the 1st one, its CTF must still be decodable standalone
+  std::vector<o2::ctf::BufferType> vecAd;
+  {
+    CTFCoder coder;
+    coder.setAdaptiveDictionaryThreshold(0.5);
+    coder.encode(vecAd, rows, digits, pattVec);
+    vecAd.clear();
+    coder.encode(vecAd, rows, digits, pattVec);
+  }
+  std::vector<Digit> digitsAd;
+  std::vector<ReadoutWindowData> rowsAd;
+  std::vector<uint8_t> pattVecAd;
+  {
+    CTFCoder coder;
+    coder.decode(*CTF::get(vecAd.data()), rowsAd, digitsAd, pattVecAd);
+  }
+  BOOST_CHECK(rowsAd.size() == rowsD.size());
+  BOOST_CHECK(digitsAd.size() == digitsD.size());
+  BOOST_CHECK(pattVecAd.size() == pattVecD.size());
+  for (size_t i = 0; i < std::min(digitsAd.size(), digitsD.size()); i++) {
+    BOOST_CHECK(digitsAd[i].getChannel() == digitsD[i].getChannel() && digitsAd[i].getTDC() == digitsD[i].getTDC() && digitsAd[i].getTOT() == digitsD[i].getTOT());
+  }
 }
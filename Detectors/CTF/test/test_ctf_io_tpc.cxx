@@ -132,4 +132,21 @@ BOOST_AUTO_TEST_CASE(CTFTest)
   // compare with original flat clusters
   BOOST_CHECK(vecIn.size() == bVec.size());
   BOOST_CHECK(memcmp(vecIn.data(), bVec.data(), bVec.size()) == 0);
+
+  // blocks encoded concurrently must decode to the same clusters
+  std::vector<o2::ctf::BufferType> vecIOMT;
+  {
+    CTFCoder coder;
+    coder.setCombineColumns(true);
+    coder.setNThreads(4);
+    coder.encode(vecIOMT, c);
+  }
+  std::vector<char> vecInMT;
+  {
+    CTFCoder coder;
+    coder.setCombineColumns(true);
+    coder.decode(*o2::tpc::CTF::get(vecIOMT.data()), vecInMT);
+  }
+  BOOST_CHECK(vecInMT.size() == bVec.size());
+  BOOST_CHECK(memcmp(vecInMT.data(), bVec.data(), bVec.size()) == 0);
 }
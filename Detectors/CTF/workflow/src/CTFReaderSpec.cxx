@@ -11,9 +11,18 @@
 
 /// @file   CTFReaderSpec.cxx
 
+#include <algorithm>
 #include <vector>
+#include <cstring>
+#include <filesystem>
 #include <TFile.h>
 #include <TTree.h>
+#include <TTreeCacheUnzip.h>
+#include <TROOT.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "Framework/Logger.h"
 #include "Framework/ControlService.h"
@@ -24,6 +33,7 @@
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
 #include "DataFormatsITSMFT/CTF.h"
 #include "DataFormatsTPC/CTF.h"
 #include "DataFormatsTRD/CTF.h"
@@ -68,17 +78,27 @@ class CTFReaderSpec : public o2::framework::Task
 {
  public:
   CTFReaderSpec(DetID::mask_t dm, const std::string& inp, int loop = 1, int delayMUS = 0);
-  ~CTFReaderSpec() override = default;
+  ~CTFReaderSpec() override { closeCTFFile(); }
   void init(o2::framework::InitContext& ic) final;
   void run(o2::framework::ProcessingContext& pc) final;
 
  private:
   void openCTFFile(const std::string& flname);
+  void openFlatCTFFile(const std::string& flname);
+  void closeCTFFile();
+  void adviseFlatPages(size_t offset, size_t size, int advice) const;
 
   DetID::mask_t mDets;             // detectors
   std::vector<std::string> mInput; // input files
   std::unique_ptr<TFile> mCTFFile;
   std::unique_ptr<TTree> mCTFTree;
+  // flat CTF files are memory mapped and the TF records are messaged as they are
+  const char* mFlatData = nullptr;
+  size_t mFlatSize = 0;
+  size_t mFlatOffset = 0; // offset of the next TF record
+  int mPrefetchTFs = 2;   // number of the TF records to prefetch in flat CTF files
+  int mNThreads = 1;      // threads to read and uncompress the detectors of a TF concurrently
+  std::string mFlatFileName = "";
   uint32_t mCTFCounter = 0;
   size_t mNextToProcess = 0;
   int mCurrEntry = 0;
@@ -101,6 +121,14 @@ CTFReaderSpec::CTFReaderSpec(DetID::mask_t dm, const std::string& inp, int loop,
 void CTFReaderSpec::init(InitContext& ic)
 {
   mCTFDir = o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("input-dir"));
+  mPrefetchTFs = ic.options().get<int>("prefetch-tfs");
+  mNThreads = std::max(1, ic.options().get<int>("reader-threads"));
+  if (mNThreads > 1) {
+    // the branches of the tree cannot be read from our own threads, since they share the TFile,
+    // but with the implicit MT ROOT uncompresses all baskets fetched by the tree cache in parallel
+    ROOT::EnableImplicitMT(mNThreads);
+    TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+  }
 }
 
 ///_______________________________________
@@ -115,9 +143,71 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
   if (!mCTFTree) {
     throw std::runtime_error("failed to load CTF tree");
   }
+  // cache only the branches of the requested detectors: the baskets of all of them are fetched
+  // in one go at the 1st branch read of each entry, and uncompressed in parallel if mNThreads > 1
+  mCTFTree->SetCacheSize(-1);
+  mCTFTree->AddBranchToCache("CTFHeader", true);
+  for (auto id = DetID::First; id <= DetID::Last; id++) {
+    if (mDets[id]) {
+      mCTFTree->AddBranchToCache(o2::utils::Str::concat_string(DetID::getName(id), "_*").c_str(), true);
+    }
+  }
+  mCTFTree->StopCacheLearningPhase();
+  mCurrEntry = 0;
+}
+
+///_______________________________________
+void CTFReaderSpec::openFlatCTFFile(const std::string& flname)
+{
+  int fd = open(flname.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    LOG(ERROR) << "Failed to open file " << flname;
+    throw std::runtime_error("failed to open CTF file");
+  }
+  mFlatSize = st.st_size;
+  void* data = mFlatSize ? mmap(nullptr, mFlatSize, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+  close(fd); // the mapping stays valid
+  if (data == MAP_FAILED || !data) {
+    mFlatSize = 0;
+    LOG(ERROR) << "Failed to map file " << flname;
+    throw std::runtime_error("failed to map CTF file");
+  }
+  mFlatData = reinterpret_cast<const char*>(data);
+  mFlatOffset = 0;
+  mFlatFileName = flname;
+  adviseFlatPages(0, mFlatSize, MADV_SEQUENTIAL);
   mCurrEntry = 0;
 }
 
+///_______________________________________
+void CTFReaderSpec::closeCTFFile()
+{
+  if (mFlatData) {
+    munmap(const_cast<char*>(mFlatData), mFlatSize);
+    mFlatData = nullptr;
+    mFlatSize = mFlatOffset = 0;
+  }
+  if (mCTFFile) {
+    mCTFTree.reset();
+    mCTFFile->Close();
+    mCTFFile.reset();
+  }
+}
+
+///_______________________________________
+void CTFReaderSpec::adviseFlatPages(size_t offset, size_t size, int advice) const
+{
+  static const size_t pageSize = sysconf(_SC_PAGESIZE);
+  size_t start = offset - offset % pageSize, end = std::min(offset + size, mFlatSize);
+  if (end > start) {
+    madvise(const_cast<char*>(mFlatData) + start, end - start, advice);
+  }
+}
+
 ///_______________________________________
 void CTFReaderSpec::run(ProcessingContext& pc)
 {
@@ -131,13 +221,29 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   auto cput = mTimer.CpuTime();
   mTimer.Start(false);
 
-  if (!mCTFTree) { // there is still a tree open with multiple entries
+  if (!mCTFTree && !mFlatData) { // otherwise there is still a file open with multiple entries
     std::string inputFile = o2::utils::Str::concat_string(mCTFDir, mInput[mNextToProcess]);
     LOG(INFO) << "Reading CTF input " << mNextToProcess << ' ' << inputFile;
-    openCTFFile(inputFile);
+    if (std::filesystem::path(inputFile).extension() == ".ctf") { // flat CTF file written with --flat-output
+      openFlatCTFFile(inputFile);
+    } else {
+      openCTFFile(inputFile);
+    }
   }
   CTFHeader ctfHeader;
-  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrEntry)) {
+  const FlatTFHeader* flatTF = nullptr;
+  if (mFlatData) {
+    flatTF = reinterpret_cast<const FlatTFHeader*>(mFlatData + mFlatOffset);
+    // the record size comes from the file: it must cover at least the header and stay within the file
+    if (FlatTFHeader::getAlignedSize() > mFlatSize - mFlatOffset || !flatTF->isValid() ||
+        flatTF->size < FlatTFHeader::getAlignedSize() || flatTF->size > mFlatSize - mFlatOffset) {
+      throw std::runtime_error(fmt::format("corrupted TF record at offset {} of {}", mFlatOffset, mFlatFileName));
+    }
+    if (mPrefetchTFs > 0) { // assume that the next TFs have similar size
+      adviseFlatPages(mFlatOffset + flatTF->size, flatTF->size * mPrefetchTFs, MADV_WILLNEED);
+    }
+    ctfHeader = flatTF->ctfHeader;
+  } else if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrEntry)) {
     throw std::runtime_error("did not find CTFHeader");
   }
   LOG(INFO) << ctfHeader;
@@ -158,6 +264,44 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   DetID::mask_t detsTF = mDets & ctfHeader.detectors;
   DetID det;
 
+  if (flatTF) { // flat images need no deserialization, just copy them to the output messages
+    // the messages are created here, the copies from the mapped file, i.e. the reading of their pages, are done concurrently
+    struct FlatCopy {
+      char* dest;
+      const char* src;
+      size_t size;
+    };
+    std::vector<FlatCopy> copies;
+    const char* ptr = reinterpret_cast<const char*>(flatTF) + FlatTFHeader::getAlignedSize();
+    const char* end = reinterpret_cast<const char*>(flatTF) + flatTF->size;
+    for (uint32_t idet = 0; idet < flatTF->nDetectors; idet++) {
+      // every detector header and image must be within the TF record
+      if (FlatDetHeader::getAlignedSize() > size_t(end - ptr)) {
+        throw std::runtime_error(fmt::format("truncated TF record at offset {} of {}: no room for the header of detector {} of {}", mFlatOffset, mFlatFileName, idet, flatTF->nDetectors));
+      }
+      const auto* detHeader = reinterpret_cast<const FlatDetHeader*>(ptr);
+      const char* image = ptr + FlatDetHeader::getAlignedSize();
+      if (detHeader->det >= DetID::nDetectors || detHeader->size % sizeof(o2::ctf::BufferType) || detHeader->size > size_t(end - image)) {
+        throw std::runtime_error(fmt::format("corrupted TF record at offset {} of {}: invalid header of detector {} of {} (ID {}, image size {})", mFlatOffset, mFlatFileName,
+                                             idet, flatTF->nDetectors, detHeader->det, detHeader->size));
+      }
+      det = DetID(DetID::ID(detHeader->det));
+      if (detsTF[det]) {
+        auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, detHeader->size / sizeof(o2::ctf::BufferType));
+        copies.push_back({reinterpret_cast<char*>(bufVec.data()), image, detHeader->size});
+        setFirstTFOrbit(det.getName());
+      }
+      ptr = image + std::min(alignSize(detHeader->size), size_t(end - image)); // a missing padding leaves ptr at the end, rejected by the next header check
+    }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+    for (int i = 0; i < int(copies.size()); i++) {
+      std::memcpy(copies[i].dest, copies[i].src, copies[i].size);
+    }
+    detsTF.reset(); // all requested detectors are done
+  }
+
   det = DetID::ITS;
   if (detsTF[det]) {
     auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::itsmft::CTF));
@@ -264,13 +408,19 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   }
 
   mTimer.Stop();
-  LOGP(INFO, "Read CTF#{} ({} of {} in {}) in {:.3f} s", mCTFCounter, mCurrEntry, mCTFTree->GetEntries(), mCTFFile->GetName(), mTimer.CpuTime() - cput);
-
-  bool moreToProcess = (++mCurrEntry < mCTFTree->GetEntries());
+  bool moreToProcess = false;
+  if (flatTF) {
+    LOGP(INFO, "Read CTF#{} ({} at offset {} of {} in {}) in {:.3f} s", mCTFCounter, mCurrEntry, mFlatOffset, mFlatSize, mFlatFileName, mTimer.CpuTime() - cput);
+    adviseFlatPages(mFlatOffset, flatTF->size, MADV_DONTNEED); // the TF was copied to the output, release its pages
+    mFlatOffset += flatTF->size;
+    mCurrEntry++;
+    moreToProcess = mFlatOffset < mFlatSize;
+  } else {
+    LOGP(INFO, "Read CTF#{} ({} of {} in {}) in {:.3f} s", mCTFCounter, mCurrEntry, mCTFTree->GetEntries(), mCTFFile->GetName(), mTimer.CpuTime() - cput);
+    moreToProcess = (++mCurrEntry < mCTFTree->GetEntries());
+  }
   if (!moreToProcess) { // this file is done, check if there are other files
-    mCTFTree.reset();
-    mCTFFile->Close();
-    mCTFFile.reset();
+    closeCTFFile();
     moreToProcess = true;
     if (++mNextToProcess >= mInput.size()) {
       if (++mLoopsCounter >= mLoops) {
@@ -309,7 +459,9 @@ DataProcessorSpec getCTFReaderSpec(DetID::mask_t dets, const std::string& inp, i
     Inputs{},
     outputs,
     AlgorithmSpec{adaptFromTask<CTFReaderSpec>(dets, inp, loop, delayMUS)},
-    Options{{"input-dir", VariantType::String, "none", {"CTF input directory"}}}};
+    Options{{"input-dir", VariantType::String, "none", {"CTF input directory"}},
+            {"prefetch-tfs", VariantType::Int, 2, {"Number of TFs to prefetch when reading flat (.ctf) CTF files"}},
+            {"reader-threads", VariantType::Int, 1, {"Number of threads to read and uncompress the detectors of a TF concurrently"}}}};
 }
 
 } // namespace ctf
@@ -18,8 +18,10 @@
 #include "CTFWorkflow/CTFWriterSpec.h"
 
 #include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "DetectorsBase/CTFCoderBase.h"
 #include "CommonUtils/StringUtils.h"
 #include "DataFormatsITSMFT/CTF.h"
 #include "DataFormatsTPC/CTF.h"
@@ -42,8 +44,16 @@
 #include <vector>
 #include <TFile.h>
 #include <TTree.h>
+#include <TROOT.h>
 #include <filesystem>
 #include <ctime>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 using namespace o2::framework;
 
@@ -80,15 +90,51 @@ class CTFWriterSpec : public o2::framework::Task
  public:
   CTFWriterSpec() = delete;
   CTFWriterSpec(DetID::mask_t dm, uint64_t r = 0, bool doCTF = true, bool doDict = false, bool dictPerDet = false, size_t smn = 0, size_t szmx = 0);
-  ~CTFWriterSpec() override = default;
+  ~CTFWriterSpec() override;
   void init(o2::framework::InitContext& ic) final;
   void run(o2::framework::ProcessingContext& pc) final;
   void endOfStream(o2::framework::EndOfStreamContext& ec) final;
   bool isPresent(DetID id) const { return mDets[id]; }
 
  private:
+  using TreeWriter = size_t (*)(gsl::span<const o2::ctf::BufferType> buffer, TTree& tree, DetID det);
+  /// CTF of single TF, detached from the DPL inputs when it is written after the processing of the TF is over
+  struct CTFWriteJob {
+    CTFHeader header;
+    uint32_t runNumber = 0;
+    uint32_t tfCounter = 0;
+    size_t nTF = 0;       // sequential number of the TF in this writer
+    size_t estimSize = 0; // estimated size of the CTF
+    std::array<gsl::span<const o2::ctf::BufferType>, DetID::nDetectors> images{}; // detectors images to write, in the DPL inputs or in buffers
+    std::array<std::vector<o2::ctf::BufferType>, DetID::nDetectors> buffers;       // own copies of the images, only for a job written after the processing
+    std::array<TreeWriter, DetID::nDetectors> treeWriters{};                       // type-aware writers of the detectors buffers to the tree
+
+    /// copy the images out of the DPL inputs, which are released after the processing of the TF
+    void detach()
+    {
+      for (auto id = DetID::First; id <= DetID::Last; id++) {
+        if (header.detectors[id]) {
+          buffers[id].assign(images[id].begin(), images[id].end());
+          images[id] = buffers[id];
+        }
+      }
+    }
+  };
+
   template <typename C>
-  size_t processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree);
+  static size_t appendDetToTree(gsl::span<const o2::ctf::BufferType> buffer, TTree& tree, DetID det)
+  {
+    return C::getImage(buffer.data()).appendToTree(tree, det.getName());
+  }
+
+  template <typename C>
+  void processDet(o2::framework::ProcessingContext& pc, DetID det, CTFWriteJob& job);
+  void writeCTF(const CTFWriteJob& job);
+  size_t writeFlatCTF(const CTFWriteJob& job);
+  void queueCTF(CTFWriteJob&& job);
+  void ioLoop();
+  void stopIOThread();
+  bool isCTFFileOpen() const { return mFlatOutput ? mFlatFileOut.is_open() : bool(mCTFTreeOut); }
   template <typename C>
   void storeDictionary(DetID det, CTFHeader& header);
   void storeDictionaries();
@@ -96,14 +142,17 @@ class CTFWriterSpec : public o2::framework::Task
   void closeDictionaryTreeAndFile(CTFHeader& header);
   std::string dictionaryFileName(const std::string& detName = "");
   void closeTFTreeAndFile();
-  void prepareTFTreeAndFile(const o2::header::DataHeader* dh);
+  void prepareTFTreeAndFile(const CTFWriteJob& job);
   size_t estimateCTFSize(ProcessingContext& pc);
 
   DetID::mask_t mDets; // detectors
   bool mWriteCTF = false;
   bool mCreateDict = false;
   bool mDictPerDetector = false;
+  bool mFlatOutput = false; // write flat EncodedBlocks images instead of ROOT trees
   int mSaveDictAfter = -1; // if positive and mWriteCTF==true, save dictionary after each mSaveDictAfter TFs processed
+  float mDictCompactCoverage = 0.f; // if positive, the stored dictionaries of wide alphabets are compacted to this fraction of the data
+  int mDictCompactRangeBits = o2::ctf::CTFCoderBase::DefaultCompactRangeBits; // max. range of the dictionaries which are not compacted
   uint64_t mRun = 0;
   size_t mMinSize = 0;     // if > 0, accumulate CTFs in the same tree until the total size exceeds this minimum
   size_t mMaxSize = 0;     // if > MinSize, and accumulated size will exceed this value, stop accumulation (even if mMinSize is not reached)
@@ -118,6 +167,16 @@ class CTFWriterSpec : public o2::framework::Task
   std::string mCurrentCTFFileName = "";
   std::unique_ptr<TFile> mCTFFileOut;
   std::unique_ptr<TTree> mCTFTreeOut;
+  std::ofstream mFlatFileOut;
+
+  // if mIOQueueSize > 0, the CTFs are written by the I/O thread, run() blocks only if mIOQueueSize CTFs are already waiting
+  size_t mIOQueueSize = 0;
+  std::deque<CTFWriteJob> mIOQueue;
+  std::mutex mIOMutex;
+  std::condition_variable mIOCondition;
+  std::thread mIOThread;
+  bool mStopIO = false;
+  std::exception_ptr mIOError;
 
   std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
   std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
@@ -132,25 +191,27 @@ class CTFWriterSpec : public o2::framework::Task
   TStopwatch mTimer;
 
   static const std::string TMPFileEnding;
+  static const std::string FlatFileEnding;
 };
 
 const std::string CTFWriterSpec::TMPFileEnding{".part"};
+const std::string CTFWriterSpec::FlatFileEnding{".ctf"};
 
 //___________________________________________________________________
 // process data of particular detector
 template <typename C>
-size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree)
+void CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det, CTFWriteJob& job)
 {
-  size_t sz = 0;
   if (!isPresent(det) || !pc.inputs().isValid(det.getName())) {
-    return sz;
+    return;
   }
   auto ctfBuffer = pc.inputs().get<gsl::span<o2::ctf::BufferType>>(det.getName());
   const auto ctfImage = C::getImage(ctfBuffer.data());
   ctfImage.print(o2::utils::Str::concat_string(det.getName(), ": "));
-  if (mWriteCTF) {
-    sz += ctfImage.appendToTree(*tree, det.getName());
-    header.detectors.set(det);
+  if (mWriteCTF) { // written from the input, unless the job is queued for the I/O thread
+    job.images[det] = ctfBuffer;
+    job.header.detectors.set(det);
+    job.treeWriters[det] = &appendDetToTree<C>;
   }
   if (mCreateDict) {
     if (!mFreqsAccumulation[det].size()) {
@@ -173,7 +234,6 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
       }
     }
   }
-  return sz;
 }
 
 //___________________________________________________________________
@@ -186,7 +246,22 @@ void CTFWriterSpec::storeDictionary(DetID det, CTFHeader& header)
   }
   prepareDictionaryTreeAndFile(det);
   // create vector whose data contains dictionary in CTF format (EncodedBlock)
-  auto dictBlocks = C::createDictionaryBlocks(mFreqsAccumulation[det], mFreqsMetaData[det]);
+  std::vector<char> dictBlocks;
+  if (mDictCompactCoverage > 0.f) { // the accumulation goes on with the full frequency tables, only the stored ones are compacted
+    auto freqs = mFreqsAccumulation[det];
+    auto mds = mFreqsMetaData[det];
+    for (size_t ib = 0; ib < freqs.size(); ib++) {
+      if (freqs[ib].size()) {
+        freqs[ib] = o2::ctf::CTFCoderBase::compactDictionary(mFreqsAccumulation[det][ib], mDictCompactCoverage, mDictCompactRangeBits);
+        mds[ib].min = freqs[ib].getMinSymbol();
+        mds[ib].max = freqs[ib].getMaxSymbol();
+        mds[ib].nDictWords = freqs[ib].size();
+      }
+    }
+    dictBlocks = C::createDictionaryBlocks(freqs, mds);
+  } else {
+    dictBlocks = C::createDictionaryBlocks(mFreqsAccumulation[det], mFreqsMetaData[det]);
+  }
   auto& h = C::get(dictBlocks.data())->getHeader();
   h = *reinterpret_cast<typename std::remove_reference<decltype(h)>::type*>(mHeaders[det].get());
   auto& hb = static_cast<o2::ctf::CTFDictHeader&>(h);
@@ -228,12 +303,26 @@ CTFWriterSpec::CTFWriterSpec(DetID::mask_t dm, uint64_t r, bool doCTF, bool doDi
   }
 }
 
+//___________________________________________________________________
+CTFWriterSpec::~CTFWriterSpec()
+{
+  try {
+    stopIOThread();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "CTF writing failed: " << e.what();
+  }
+}
+
 //___________________________________________________________________
 void CTFWriterSpec::init(InitContext& ic)
 {
   mSaveDictAfter = ic.options().get<int>("save-dict-after");
+  mDictCompactCoverage = ic.options().get<float>("ctf-dict-compact-coverage");
+  mDictCompactRangeBits = ic.options().get<int>("ctf-dict-compact-range-bits");
   mDictDir = o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("ctf-dict-dir"));
   mCTFDir = o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("output-dir"));
+  mFlatOutput = ic.options().get<bool>("flat-output");
+  mIOQueueSize = std::max(0, ic.options().get<int>("io-queue-size"));
   if (mWriteCTF) {
     if (mMinSize > 0) {
       LOG(INFO) << "Multiple CTFs will be accumulated in the tree/file until its size exceeds " << mMinSize << " bytes";
@@ -241,6 +330,14 @@ void CTFWriterSpec::init(InitContext& ic)
         LOG(INFO) << "but does not exceed " << mMaxSize << " bytes";
       }
     }
+    if (mFlatOutput) {
+      LOG(INFO) << "CTFs will be written as flat buffers to " << FlatFileEnding << " files";
+    }
+    if (mIOQueueSize) {
+      LOG(INFO) << "CTFs will be written by the I/O thread with up to " << mIOQueueSize << " CTFs queued";
+      ROOT::EnableThreadSafety();
+      mIOThread = std::thread(&CTFWriterSpec::ioLoop, this);
+    }
   }
 }
 
@@ -265,47 +362,41 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   mTimer.Start(false);
   const auto dh = DataRefUtils::getHeader<o2::header::DataHeader*>(pc.inputs().getFirstValid(true));
 
-  mCurrCTFSize = estimateCTFSize(pc);
-  if (mWriteCTF) {
-    prepareTFTreeAndFile(dh);
-  }
-
   // create header
-  CTFHeader header{mRun, dh->firstTForbit};
-  size_t szCTF = 0;
-  szCTF += processDet<o2::itsmft::CTF>(pc, DetID::ITS, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::itsmft::CTF>(pc, DetID::MFT, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::tpc::CTF>(pc, DetID::TPC, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::trd::CTF>(pc, DetID::TRD, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::tof::CTF>(pc, DetID::TOF, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::ft0::CTF>(pc, DetID::FT0, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::fv0::CTF>(pc, DetID::FV0, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::fdd::CTF>(pc, DetID::FDD, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::mid::CTF>(pc, DetID::MID, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::mch::CTF>(pc, DetID::MCH, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::emcal::CTF>(pc, DetID::EMC, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::phos::CTF>(pc, DetID::PHS, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::cpv::CTF>(pc, DetID::CPV, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::zdc::CTF>(pc, DetID::ZDC, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::hmpid::CTF>(pc, DetID::HMP, header, mCTFTreeOut.get());
-
-  mTimer.Stop();
+  CTFWriteJob job;
+  job.header = CTFHeader{mRun, dh->firstTForbit};
+  job.runNumber = dh->runNumber;
+  job.tfCounter = dh->tfCounter;
+  job.nTF = mNCTF;
+  job.estimSize = estimateCTFSize(pc);
+  processDet<o2::itsmft::CTF>(pc, DetID::ITS, job);
+  processDet<o2::itsmft::CTF>(pc, DetID::MFT, job);
+  processDet<o2::tpc::CTF>(pc, DetID::TPC, job);
+  processDet<o2::trd::CTF>(pc, DetID::TRD, job);
+  processDet<o2::tof::CTF>(pc, DetID::TOF, job);
+  processDet<o2::ft0::CTF>(pc, DetID::FT0, job);
+  processDet<o2::fv0::CTF>(pc, DetID::FV0, job);
+  processDet<o2::fdd::CTF>(pc, DetID::FDD, job);
+  processDet<o2::mid::CTF>(pc, DetID::MID, job);
+  processDet<o2::mch::CTF>(pc, DetID::MCH, job);
+  processDet<o2::emcal::CTF>(pc, DetID::EMC, job);
+  processDet<o2::phos::CTF>(pc, DetID::PHS, job);
+  processDet<o2::cpv::CTF>(pc, DetID::CPV, job);
+  processDet<o2::zdc::CTF>(pc, DetID::ZDC, job);
+  processDet<o2::hmpid::CTF>(pc, DetID::HMP, job);
 
   if (mWriteCTF) {
-    szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
-    mAccCTFSize += szCTF;
-    mCTFTreeOut->SetEntries(++mNAccCTF);
-    LOG(INFO) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << mCTFFileOut->GetName() << " in " << mTimer.CpuTime() - cput << " s";
-    if (mNAccCTF > 1) {
-      LOG(INFO) << "Current CTF tree has " << mNAccCTF << " entries with total size of " << mAccCTFSize << " bytes";
+    if (mIOQueueSize) {
+      job.detach(); // the inputs are released before the I/O thread writes the job
+      queueCTF(std::move(job));
+    } else {
+      writeCTF(job);
     }
   } else {
-    LOG(INFO) << "TF#" << mNCTF << " CTF writing is disabled, size was " << szCTF << " bytes";
-  }
-
-  if (mWriteCTF && mAccCTFSize >= mMinSize) {
-    closeTFTreeAndFile();
+    LOG(INFO) << "TF#" << mNCTF << " CTF writing is disabled, size was " << job.estimSize << " bytes";
   }
+  mTimer.Stop();
+  LOG(DEBUG) << "TF#" << mNCTF << " processed in " << mTimer.CpuTime() - cput << " s";
 
   mNCTF++;
   if (mCreateDict && mSaveDictAfter > 0 && (mNCTF % mSaveDictAfter) == 0) {
@@ -321,6 +412,7 @@ void CTFWriterSpec::endOfStream(EndOfStreamContext& ec)
     storeDictionaries();
   }
   if (mWriteCTF) {
+    stopIOThread(); // flushes the queued CTFs
     closeTFTreeAndFile();
   }
   LOGF(INFO, "CTF writing total timing: Cpu: %.3e Real: %.3e s in %d slots",
@@ -328,13 +420,131 @@ void CTFWriterSpec::endOfStream(EndOfStreamContext& ec)
 }
 
 //___________________________________________________________________
-void CTFWriterSpec::prepareTFTreeAndFile(const o2::header::DataHeader* dh)
+void CTFWriterSpec::writeCTF(const CTFWriteJob& job)
+{
+  mCurrCTFSize = job.estimSize;
+  prepareTFTreeAndFile(job);
+  size_t szCTF = 0;
+  if (mFlatOutput) {
+    szCTF = writeFlatCTF(job);
+  } else {
+    for (auto id = DetID::First; id <= DetID::Last; id++) {
+      if (job.header.detectors[id]) {
+        szCTF += job.treeWriters[id](job.images[id], *mCTFTreeOut.get(), DetID(id));
+      }
+    }
+    szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", job.header);
+    mCTFTreeOut->SetEntries(mNAccCTF + 1);
+  }
+  mAccCTFSize += szCTF;
+  mNAccCTF++;
+  LOG(INFO) << "TF#" << job.nTF << ": wrote CTF{" << job.header << "} of size " << szCTF << " to " << mCurrentCTFFileName;
+  if (mNAccCTF > 1) {
+    LOG(INFO) << "Current CTF file has " << mNAccCTF << " entries with total size of " << mAccCTFSize << " bytes";
+  }
+  if (mAccCTFSize >= mMinSize) {
+    closeTFTreeAndFile();
+  }
+}
+
+//___________________________________________________________________
+size_t CTFWriterSpec::writeFlatCTF(const CTFWriteJob& job)
+{
+  FlatTFHeader tfHeader;
+  tfHeader.tfCounter = job.tfCounter;
+  tfHeader.ctfHeader = job.header;
+  tfHeader.size = FlatTFHeader::getAlignedSize();
+  for (auto id = DetID::First; id <= DetID::Last; id++) {
+    if (job.header.detectors[id]) {
+      tfHeader.nDetectors++;
+      tfHeader.size += FlatDetHeader::getAlignedSize() + alignSize(job.images[id].size() * sizeof(o2::ctf::BufferType));
+    }
+  }
+  auto writeAligned = [this](const void* ptr, size_t sz) {
+    static constexpr char padding[Alignment] = {0};
+    mFlatFileOut.write(reinterpret_cast<const char*>(ptr), sz);
+    mFlatFileOut.write(padding, alignSize(sz) - sz);
+  };
+  writeAligned(&tfHeader, sizeof(tfHeader));
+  for (auto id = DetID::First; id <= DetID::Last; id++) {
+    if (job.header.detectors[id]) {
+      const auto& buffer = job.images[id];
+      FlatDetHeader detHeader{uint32_t(id), 0, buffer.size() * sizeof(o2::ctf::BufferType)};
+      writeAligned(&detHeader, sizeof(detHeader));
+      writeAligned(buffer.data(), detHeader.size);
+    }
+  }
+  if (!mFlatFileOut) {
+    throw std::runtime_error(fmt::format("Failed to write CTF to {}", mCurrentCTFFileName));
+  }
+  return tfHeader.size;
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::queueCTF(CTFWriteJob&& job)
+{
+  std::unique_lock<std::mutex> lock(mIOMutex);
+  mIOCondition.wait(lock, [this] { return mIOQueue.size() < mIOQueueSize || mIOError; });
+  if (mIOError) {
+    std::rethrow_exception(mIOError);
+  }
+  mIOQueue.push_back(std::move(job));
+  lock.unlock();
+  mIOCondition.notify_all();
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::ioLoop()
+{
+  while (true) {
+    CTFWriteJob job;
+    {
+      std::unique_lock<std::mutex> lock(mIOMutex);
+      mIOCondition.wait(lock, [this] { return mStopIO || !mIOQueue.empty(); });
+      if (mIOQueue.empty()) { // stop was requested and everything was written
+        return;
+      }
+      job = std::move(mIOQueue.front());
+      mIOQueue.pop_front();
+    }
+    mIOCondition.notify_all(); // there is room in the queue now
+    try {
+      writeCTF(job);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mIOMutex);
+      mIOError = std::current_exception();
+      mIOQueue.clear();
+      mIOCondition.notify_all();
+      return;
+    }
+  }
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::stopIOThread()
+{
+  if (!mIOThread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mIOMutex);
+    mStopIO = true;
+  }
+  mIOCondition.notify_all();
+  mIOThread.join();
+  if (mIOError) {
+    std::rethrow_exception(std::exchange(mIOError, nullptr));
+  }
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::prepareTFTreeAndFile(const CTFWriteJob& job)
 {
   if (!mWriteCTF) {
     return;
   }
   bool needToOpen = false;
-  if (!mCTFTreeOut) {
+  if (!isCTFFileOpen()) {
     needToOpen = true;
   } else {
     if ((mAccCTFSize >= mMinSize) ||                                                         // min size exceeded, may close the file
@@ -346,9 +556,17 @@ void CTFWriterSpec::prepareTFTreeAndFile(const o2::header::DataHeader* dh)
   }
   if (needToOpen) {
     closeTFTreeAndFile();
-    mCurrentCTFFileName = o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(dh->runNumber, dh->firstTForbit, dh->tfCounter));
-    mCTFFileOut.reset(TFile::Open(o2::utils::Str::concat_string(mCurrentCTFFileName, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
-    mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+    if (mFlatOutput) {
+      mCurrentCTFFileName = o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(job.runNumber, job.header.firstTForbit, job.tfCounter, "o2_ctf", FlatFileEnding));
+      mFlatFileOut.open(o2::utils::Str::concat_string(mCurrentCTFFileName, TMPFileEnding), std::ios::binary | std::ios::trunc); // to prevent premature external usage, use temporary name
+      if (!mFlatFileOut) {
+        throw std::runtime_error(fmt::format("Failed to open CTF file {}", mCurrentCTFFileName));
+      }
+    } else {
+      mCurrentCTFFileName = o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(job.runNumber, job.header.firstTForbit, job.tfCounter));
+      mCTFFileOut.reset(TFile::Open(o2::utils::Str::concat_string(mCurrentCTFFileName, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
+      mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+    }
     mNCTFFiles++;
   }
 }
@@ -356,11 +574,15 @@ void CTFWriterSpec::prepareTFTreeAndFile(const o2::header::DataHeader* dh)
 //___________________________________________________________________
 void CTFWriterSpec::closeTFTreeAndFile()
 {
-  if (mCTFTreeOut) {
-    mCTFTreeOut->Write();
-    mCTFTreeOut.reset();
-    mCTFFileOut->Close();
-    mCTFFileOut.reset();
+  if (isCTFFileOpen()) {
+    if (mFlatOutput) {
+      mFlatFileOut.close();
+    } else {
+      mCTFTreeOut->Write();
+      mCTFTreeOut.reset();
+      mCTFFileOut->Close();
+      mCTFFileOut.reset();
+    }
     if (!TMPFileEnding.empty()) {
       std::filesystem::rename(o2::utils::Str::concat_string(mCurrentCTFFileName, TMPFileEnding), mCurrentCTFFileName);
     }
@@ -456,7 +678,11 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, uint64_t run, bool doCTF,
     AlgorithmSpec{adaptFromTask<CTFWriterSpec>(dets, run, doCTF, doDict, dictPerDet, szmn, szmx)},
     Options{{"save-dict-after", VariantType::Int, -1, {"In dictionary generation mode save it dictionary after certain number of TFs processed"}},
             {"ctf-dict-dir", VariantType::String, "none", {"CTF dictionary directory"}},
-            {"output-dir", VariantType::String, "none", {"CTF output directory"}}}};
+            {"ctf-dict-compact-coverage", VariantType::Float, 0.f, {"If > 0, compact the dictionaries of wide alphabets to the symbol range holding this fraction of the data, the others are stored as literals"}},
+            {"ctf-dict-compact-range-bits", VariantType::Int, o2::ctf::CTFCoderBase::DefaultCompactRangeBits, {"Range in bits of the alphabet above which the dictionaries are compacted"}},
+            {"output-dir", VariantType::String, "none", {"CTF output directory"}},
+            {"flat-output", VariantType::Bool, false, {"Write CTFs as flat buffers (.ctf files) instead of ROOT trees"}},
+            {"io-queue-size", VariantType::Int, 0, {"If > 0, write CTFs in a separate I/O thread with up to this many CTFs queued"}}}};
 }
 
 } // namespace ctf
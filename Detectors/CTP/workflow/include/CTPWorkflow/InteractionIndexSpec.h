@@ -0,0 +1,53 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InteractionIndexSpec.h
+/// @brief  Device producing the per-TF interaction index from the CTP digits and FT0 RecPoints
+
+#ifndef O2_CTP_INTERACTIONINDEXSPEC_H
+#define O2_CTP_INTERACTIONINDEXSPEC_H
+
+#include <vector>
+
+#include "Framework/DataProcessorSpec.h"
+#include "Framework/Task.h"
+#include "DataFormatsCTP/InteractionIndex.h"
+
+namespace o2
+{
+namespace ctp
+{
+
+/// \class InteractionIndexSpec
+/// \brief Collects the interaction BCs of the TF seen by the CTP and by FT0 (selected by the ft0tag
+/// parameters) into one index, sent as {"CTP", "INTINDEX"} entries and {"CTP", "INTBUCKETS"} bucket
+/// table, to be viewed by the consumers with o2::ctp::InteractionIndex instead of building their own lists.
+class InteractionIndexSpec : public framework::Task
+{
+ public:
+  InteractionIndexSpec(bool useCTP, bool useFT0) : mUseCTP(useCTP), mUseFT0(useFT0) {}
+  ~InteractionIndexSpec() override = default;
+  void run(framework::ProcessingContext& pc) final;
+
+ private:
+  bool mUseCTP = true;
+  bool mUseFT0 = true;
+  std::vector<InteractionIndexEntry> mEntries;
+  std::vector<int> mBuckets;
+};
+
+/// create a processor spec
+framework::DataProcessorSpec getInteractionIndexSpec(bool useCTP, bool useFT0);
+
+} // namespace ctp
+} // namespace o2
+
+#endif
@@ -0,0 +1,90 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InteractionIndexSpec.cxx
+
+#include "CTPWorkflow/InteractionIndexSpec.h"
+#include "DataFormatsCTP/Digits.h"
+#include "DataFormatsFT0/RecPoints.h"
+#include "FT0Reconstruction/InteractionTag.h"
+#include "DetectorsRaw/HBFUtils.h"
+#include "Framework/ControlService.h"
+#include "Framework/DataRefUtils.h"
+#include "Framework/Logger.h"
+#include "Headers/DataHeader.h"
+
+using namespace o2::framework;
+
+namespace o2
+{
+namespace ctp
+{
+
+void InteractionIndexSpec::run(ProcessingContext& pc)
+{
+  const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(pc.inputs().getFirstValid(true));
+  const o2::InteractionRecord startIR{0, dh->firstTForbit};
+  mEntries.clear();
+
+  if (mUseFT0) {
+    const auto& ft0Tag = o2::ft0::InteractionTag::Instance();
+    auto recPoints = pc.inputs().get<gsl::span<o2::ft0::RecPoints>>("ft0recpoints");
+    for (int i = 0; i < int(recPoints.size()); i++) {
+      const auto& rp = recPoints[i];
+      if (!ft0Tag.isSelected(rp)) {
+        continue;
+      }
+      auto& entry = mEntries.emplace_back();
+      entry.intRecord = rp.getInteractionRecord();
+      entry.ft0RecPoint = i;
+      entry.sources = InteractionIndexEntry::FT0;
+    }
+  }
+  if (mUseCTP) {
+    auto digits = pc.inputs().get<gsl::span<CTPDigit>>("ctpdigits");
+    for (const auto& dig : digits) {
+      auto& entry = mEntries.emplace_back();
+      entry.intRecord = dig.intRecord;
+      entry.classMask = dig.CTPClassMask.to_ullong();
+      entry.inputMask = dig.CTPInputMask.to_ullong();
+      entry.sources = InteractionIndexEntry::CTP;
+    }
+  }
+  InteractionIndex::fill(mEntries, mBuckets, startIR, o2::raw::HBFUtils::Instance().getNOrbitsPerTF());
+  LOG(INFO) << "Interaction index: " << mEntries.size() << " BCs in " << mBuckets.size() - 1 << " buckets for TF starting at orbit " << startIR.orbit;
+
+  pc.outputs().snapshot(Output{"CTP", "INTINDEX", 0, Lifetime::Timeframe}, mEntries);
+  pc.outputs().snapshot(Output{"CTP", "INTBUCKETS", 0, Lifetime::Timeframe}, mBuckets);
+}
+
+DataProcessorSpec getInteractionIndexSpec(bool useCTP, bool useFT0)
+{
+  std::vector<InputSpec> inputs;
+  if (useCTP) {
+    inputs.emplace_back("ctpdigits", "CTP", "DIGITS", 0, Lifetime::Timeframe);
+  }
+  if (useFT0) {
+    inputs.emplace_back("ft0recpoints", "FT0", "RECPOINTS", 0, Lifetime::Timeframe);
+  }
+  std::vector<OutputSpec> outputs;
+  outputs.emplace_back("CTP", "INTINDEX", 0, Lifetime::Timeframe);
+  outputs.emplace_back("CTP", "INTBUCKETS", 0, Lifetime::Timeframe);
+
+  return DataProcessorSpec{
+    "ctp-interaction-index",
+    inputs,
+    outputs,
+    AlgorithmSpec{adaptFromTask<InteractionIndexSpec>(useCTP, useFT0)},
+    Options{}};
+}
+
+} // namespace ctp
+} // namespace o2
@@ -0,0 +1,60 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   ctp-interaction-index-workflow.cxx
+/// @brief  Workflow producing the per-TF interaction index from the CTP digits and FT0 RecPoints
+#include "Framework/WorkflowSpec.h"
+#include "Framework/ConfigParamSpec.h"
+#include "CTPWorkflow/InteractionIndexSpec.h"
+#include "CTPWorkflowIO/DigitReaderSpec.h"
+#include "FT0Workflow/RecPointReaderSpec.h"
+#include "CommonUtils/ConfigurableParam.h"
+#include "DetectorsRaw/HBFUtilsInitializer.h"
+
+// add workflow options, note that customization needs to be declared before
+// including Framework/runDataProcessing
+void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
+{
+  std::vector<o2::framework::ConfigParamSpec> options{
+    {"disable-ctp", o2::framework::VariantType::Bool, false, {"do not use the CTP digits"}},
+    {"disable-ft0", o2::framework::VariantType::Bool, false, {"do not use the FT0 RecPoints"}},
+    {"disable-root-input", o2::framework::VariantType::Bool, false, {"disable root-files input readers"}},
+    {"configKeyValues", o2::framework::VariantType::String, "", {"Semicolon separated key=value strings ..."}}};
+  o2::raw::HBFUtilsInitializer::addConfigOption(options);
+  std::swap(workflowOptions, options);
+}
+
+#include "Framework/runDataProcessing.h" // the main driver
+
+o2::framework::WorkflowSpec defineDataProcessing(o2::framework::ConfigContext const& cfgc)
+{
+  o2::conf::ConfigurableParam::updateFromString(cfgc.options().get<std::string>("configKeyValues"));
+  bool useCTP = !cfgc.options().get<bool>("disable-ctp");
+  bool useFT0 = !cfgc.options().get<bool>("disable-ft0");
+  if (!useCTP && !useFT0) {
+    throw std::invalid_argument("at least one of CTP and FT0 must be used for the interaction index");
+  }
+
+  o2::framework::WorkflowSpec wf;
+  if (!cfgc.options().get<bool>("disable-root-input")) {
+    if (useCTP) {
+      wf.emplace_back(o2::ctp::getDigitsReaderSpec(false));
+    }
+    if (useFT0) {
+      wf.emplace_back(o2::ft0::getRecPointReaderSpec(false));
+    }
+  }
+  wf.emplace_back(o2::ctp::getInteractionIndexSpec(useCTP, useFT0));
+
+  // configure dpl timer to inject correct firstTFOrbit: start from the 1st orbit of TF containing 1st sampled orbit
+  o2::raw::HBFUtilsInitializer hbfIni(cfgc, wf);
+  return std::move(wf);
+}
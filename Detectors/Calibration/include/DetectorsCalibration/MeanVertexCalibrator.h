@@ -59,6 +59,18 @@ class MeanVertexCalibrator final : public o2::calibration::TimeSlotCalibration<o
   uint64_t getNSlotsSMA() const { return mSMAslots; }
   void setNSlotsSMA(uint64_t nslots) { mSMAslots = nslots; }
 
+  /// estimate the mean vertex with the truncated moments of the vertices within nSigma robust standard deviations
+  /// from the median, instead of gaussian fits: the cost of the estimation does not depend on the statistics
+  void setUseTruncatedMoments(bool v, float nSigma = 3.f)
+  {
+    mUseTruncatedMoments = v;
+    mTruncationNSigma = nSigma;
+    if (v) {
+      mSMAdata.enableBinMoments();
+    }
+  }
+  bool getUseTruncatedMoments() const { return mUseTruncatedMoments; }
+
   void doSimpleMovingAverage(std::deque<float>& dq, float& sma);
   void doSimpleMovingAverage(std::deque<MVObject>& dq, MVObject& sma);
 
@@ -67,6 +79,8 @@ class MeanVertexCalibrator final : public o2::calibration::TimeSlotCalibration<o
   CcdbObjectInfoVector& getMeanVertexObjectInfoVector() { return mInfoVector; }
 
  private:
+  void estimate(const MeanVertexData& c, MVObject& mvo, const char* what) const;
+
   int mMinEntries = 0;
   int mNBinsX = 0;
   float mRangeX = 0.;
@@ -75,6 +89,8 @@ class MeanVertexCalibrator final : public o2::calibration::TimeSlotCalibration<o
   int mNBinsZ = 0;
   float mRangeZ = 0.;
   bool mUseFit = false;
+  bool mUseTruncatedMoments = false;
+  float mTruncationNSigma = 3.f;
   uint64_t mSMAslots = 5;
   CcdbObjectInfoVector mInfoVector;                                    // vector of CCDB Infos , each element is filled with the CCDB description
                                                                        // of the accompanying LHCPhase
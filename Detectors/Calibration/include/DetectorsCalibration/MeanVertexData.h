@@ -40,6 +40,15 @@ struct MeanVertexData {
   std::vector<float> histoY{0};
   std::vector<float> histoZ{0};
   bool useFit = false;
+  // sums of the positions and of their squares in every bin, kept with useBinMoments for the
+  // estimation with truncated moments, which are not limited by the bin width
+  bool useBinMoments = false;
+  std::vector<double> sumX{};
+  std::vector<double> sumY{};
+  std::vector<double> sumZ{};
+  std::vector<double> sum2X{};
+  std::vector<double> sum2Y{};
+  std::vector<double> sum2Z{};
 
   MeanVertexData();
 
@@ -97,6 +106,23 @@ struct MeanVertexData {
     histoZ.resize(nbinsZ, 0.);
   }
 
+  //_____________________________________________
+  void enableBinMoments()
+  {
+    useBinMoments = true;
+    sumX.resize(nbinsX, 0.);
+    sumY.resize(nbinsY, 0.);
+    sumZ.resize(nbinsZ, 0.);
+    sum2X.resize(nbinsX, 0.);
+    sum2Y.resize(nbinsY, 0.);
+    sum2Z.resize(nbinsZ, 0.);
+  }
+
+  /// Mean and standard deviation of the coordinate (0, 1, 2 for x, y, z) of the vertices within nSigma robust
+  /// standard deviations from the median, which are obtained from the quantiles of the histogram.
+  /// The cost does not depend on the number of entries. Returns false if there are not enough entries.
+  bool getTruncatedMoments(int coordinate, float nSigma, float& mean, float& sigma) const;
+
   //_____________________________________________
 
   size_t getEntries() const { return entries; }
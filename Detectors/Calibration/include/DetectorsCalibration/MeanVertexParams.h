@@ -34,6 +34,8 @@ struct MeanVertexParams : public o2::conf::ConfigurableParamHelper<MeanVertexPar
   float rangeZ = 20.f;
   int nSlots4SMA = 5;
   bool useFit = false;
+  bool useTruncatedMoments = false; // estimate with truncated moments instead of gaussian fits
+  float truncationNSigma = 3.f;     // window of the truncated moments, in robust standard deviations
   int tfPerSlot = 5;
   int maxTFdelay = 3;
 
@@ -13,6 +13,7 @@
 #define DETECTOR_CALIB_TIMESLOT_H_
 
 #include <memory>
+#include <vector>
 #include <Rtypes.h>
 #include "Framework/Logger.h"
 
@@ -42,6 +43,9 @@ class TimeSlot
     return *this;
   }
 
+  TimeSlot(TimeSlot&&) = default;
+  TimeSlot& operator=(TimeSlot&&) = default;
+
   ~TimeSlot() = default;
 
   TFType getTFStart() const { return mTFStart; }
@@ -59,10 +63,31 @@ class TimeSlot
   // merge data of previous slot to this one and extend the mTFStart to cover prev
   void mergeToPrevious(TimeSlot& prev)
   {
+    mergeSubContainers();
+    prev.mergeSubContainers();
     mContainer->merge(prev.mContainer.get());
     mTFStart = prev.mTFStart;
   }
 
+  // sub-containers, which are filled in parallel and merged to the container before it is used
+  // (the Container has to provide std::unique_ptr<Container> createSubContainer() const)
+  size_t getNSubContainers() const { return mSubContainers.size(); }
+  Container* getSubContainer(size_t i) { return mSubContainers[i].get(); }
+  template <typename C = Container>
+  void prepareSubContainers(size_t n)
+  {
+    while (mSubContainers.size() < n) {
+      mSubContainers.emplace_back(mContainer->createSubContainer());
+    }
+  }
+  void mergeSubContainers()
+  {
+    for (auto& sub : mSubContainers) {
+      mContainer->merge(sub.get());
+    }
+    mSubContainers.clear();
+  }
+
   void print() const
   {
     LOGF(INFO, "Calibration slot %5d <=TF<=  %5d", mTFStart, mTFEnd);
@@ -73,7 +98,8 @@ class TimeSlot
   TFType mTFStart = 0;
   TFType mTFEnd = 0;
   size_t mEntries = 0;
-  std::unique_ptr<Container> mContainer; // user object to accumulate the calibration data for this slot
+  std::unique_ptr<Container> mContainer;                  // user object to accumulate the calibration data for this slot
+  std::vector<std::unique_ptr<Container>> mSubContainers; //! data filled in parallel, not yet merged to mContainer
 
   ClassDefNV(TimeSlot, 1);
 };
@@ -15,15 +15,29 @@
 /// @brief Processor for the multiple time slots calibration
 
 #include "DetectorsCalibration/TimeSlot.h"
+#include <chrono>
 #include <deque>
+#include <future>
 #include <gsl/gsl>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 
 namespace o2
 {
 namespace calibration
 {
 
+/// true if the Container can be filled in parallel through sub-containers, merged to it with merge(const Container*)
+template <typename Container, typename = void>
+struct hasSubContainers : std::false_type {
+};
+template <typename Container>
+struct hasSubContainers<Container, std::void_t<decltype(std::declval<const Container&>().createSubContainer())>> : std::true_type {
+};
+
 template <typename Input, typename Container>
 class TimeSlotCalibration
 {
@@ -49,6 +63,23 @@ class TimeSlotCalibration
 
   void setUpdateAtTheEndOfRunOnly() { mUpdateAtTheEndOfRunOnly = kTRUE; }
 
+  /// The closed slots are finalized by a background worker, in their order, while the data intake goes on.
+  /// At most maxPending slots wait for or undergo the finalization, further slots to close wait for them.
+  /// 0 (default) finalizes the slots synchronously, in the thread calling process.
+  /// With background finalization, the outputs produced by finalizeSlot have to be accessed (and reset with
+  /// initOutput) holding lockOutput(), which must not be held while calling process, and waitForFinalizations()
+  /// has to be called before the calibrator is destroyed. The end of run (tf = INFINITE_TF) waits for all of them.
+  void setMaxPendingFinalizations(int maxPending) { mMaxPendingFinalizations = maxPending < 0 ? 0 : maxPending; }
+  int getMaxPendingFinalizations() const { return mMaxPendingFinalizations; }
+  int getNPendingFinalizations() const { return mPendingFinalizations.size(); }
+  void waitForFinalizations();
+  std::unique_lock<std::mutex> lockOutput() { return std::unique_lock<std::mutex>(mOutputMutex); }
+
+  /// Number of threads filling each TF, for containers providing createSubContainer(): the data are split among
+  /// per-thread sub-containers of the slot, which are merged to its container before it is checked or finalized.
+  void setNFillThreads(int n) { mNFillThreads = n < 1 ? 1 : n; }
+  int getNFillThreads() const { return mNFillThreads; }
+
   int getNSlots() const { return mSlots.size(); }
   Slot& getSlotForTF(TFType tf);
   Slot& getSlot(int i) { return (Slot&)mSlots.at(i); }
@@ -78,6 +109,8 @@ class TimeSlotCalibration
 
  private:
   TFType tf2SlotMin(TFType tf) const;
+  void fill(Slot& slot, const gsl::span<const Input> data);
+  void closeSlot(Slot& slot);
 
   std::deque<Slot> mSlots;
 
@@ -97,6 +130,10 @@ class TimeSlotCalibration
                                                 // the check on the statistics returned false, to determine
                                                 // after how many TF to check again.
   bool mWasCheckedInfiniteSlot = false;         // flag to know whether the statistics of the infinite slot was already checked
+  int mNFillThreads = 1;                        // number of threads filling the containers supporting sub-containers
+  int mMaxPendingFinalizations = 0;             // maximum number of slots finalized in the background, 0 for synchronous finalization
+  std::deque<std::shared_future<void>> mPendingFinalizations; //! finalizations running in the background, in the order of the slots
+  std::mutex mOutputMutex;                                    //! held by the background finalizations
 
   ClassDef(TimeSlotCalibration, 1);
 };
@@ -120,7 +157,7 @@ bool TimeSlotCalibration<Input, Container>::process(TFType tf, const gsl::span<c
   }
 
   auto& slotTF = getSlotForTF(tf);
-  slotTF.getContainer()->fill(data);
+  fill(slotTF, data);
   if (tf > mMaxSeenTF) {
     mMaxSeenTF = tf; // keep track of the most recent TF processed
   }
@@ -159,12 +196,13 @@ void TimeSlotCalibration<Input, Container>::checkSlotsToFinalize(TFType tf, int
         LOG(INFO) << "Update interval passed (" << checkInterval << "), checking slot for " << mSlots[0].getTFStart() << " <= TF <= " << mSlots[0].getTFEnd();
       }
       mLastCheckedTFInfiniteSlot = tf;
+      mSlots[0].mergeSubContainers();
       if (hasEnoughData(mSlots[0])) {
         mWasCheckedInfiniteSlot = false;
         mSlots[0].setTFStart(mLastClosedTF);
         mSlots[0].setTFEnd(mMaxSeenTF);
         LOG(INFO) << "Finalizing slot for " << mSlots[0].getTFStart() << " <= TF <= " << mSlots[0].getTFEnd();
-        finalizeSlot(mSlots[0]);                  // will be removed after finalization
+        closeSlot(mSlots[0]);                     // will be removed after finalization
         mLastClosedTF = mSlots[0].getTFEnd() + 1; // will not accept any TF below this
         mSlots.erase(mSlots.begin());
         // creating a new slot if we are not at the end of run
@@ -184,9 +222,10 @@ void TimeSlotCalibration<Input, Container>::checkSlotsToFinalize(TFType tf, int
     for (auto slot = mSlots.begin(); slot != mSlots.end();) {
       //if (maxDelay == 0 || (slot->getTFEnd() + maxDelay) < tf) {
       if ((slot->getTFEnd() + maxDelay) < tf) {
+        slot->mergeSubContainers();
         if (hasEnoughData(*slot)) {
           LOG(DEBUG) << "Finalizing slot for " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd();
-          finalizeSlot(*slot); // will be removed after finalization
+          closeSlot(*slot); // will be removed after finalization
         } else if ((slot + 1) != mSlots.end()) {
           LOG(INFO) << "Merging underpopulated slot " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd()
                     << " to slot " << (slot + 1)->getTFStart() << " <= TF <= " << (slot + 1)->getTFEnd();
@@ -203,6 +242,9 @@ void TimeSlotCalibration<Input, Container>::checkSlotsToFinalize(TFType tf, int
       }
     }
   }
+  if (tf == INFINITE_TF) {
+    waitForFinalizations();
+  }
 }
 
 //_________________________________________________
@@ -214,9 +256,78 @@ void TimeSlotCalibration<Input, Container>::finalizeOldestSlot()
     LOG(WARNING) << "There are no slots defined";
     return;
   }
-  finalizeSlot(mSlots.front());
+  mSlots.front().mergeSubContainers();
+  closeSlot(mSlots.front());
   mLastClosedTF = mSlots.front().getTFEnd() + 1; // do not accept any TF below this
   mSlots.erase(mSlots.begin());
+  // the finalization is enforced, so it is completed before returning
+  waitForFinalizations();
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::fill(Slot& slot, const gsl::span<const Input> data)
+{
+  if constexpr (hasSubContainers<Container>::value) {
+    if (mNFillThreads > 1 && data.size() >= size_t(mNFillThreads)) {
+      // every thread fills its own sub-container with a contiguous chunk of the data
+      slot.prepareSubContainers(mNFillThreads);
+      size_t chunk = (data.size() + mNFillThreads - 1) / mNFillThreads;
+      auto getChunk = [data, chunk](size_t i) {
+        size_t first = std::min(i * chunk, data.size());
+        return data.subspan(first, std::min(chunk, data.size() - first));
+      };
+      std::vector<std::future<void>> fills;
+      for (int i = 1; i < mNFillThreads; i++) {
+        fills.emplace_back(std::async(std::launch::async, [sub = slot.getSubContainer(i), part = getChunk(i)]() { sub->fill(part); }));
+      }
+      slot.getSubContainer(0)->fill(getChunk(0));
+      for (auto& f : fills) {
+        f.get();
+      }
+      return;
+    }
+  }
+  slot.getContainer()->fill(data);
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::closeSlot(Slot& slot)
+{
+  // Finalize the slot, which is then removed by the caller
+  if (mMaxPendingFinalizations == 0) {
+    finalizeSlot(slot);
+    return;
+  }
+  // the finalizations which are over are collected, their exceptions are rethrown here
+  while (!mPendingFinalizations.empty() &&
+         (mPendingFinalizations.size() >= size_t(mMaxPendingFinalizations) ||
+          mPendingFinalizations.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+    auto oldest = mPendingFinalizations.front();
+    mPendingFinalizations.pop_front();
+    oldest.get();
+  }
+  auto closed = std::make_shared<Slot>(std::move(slot));
+  std::shared_future<void> previous = mPendingFinalizations.empty() ? std::shared_future<void>() : mPendingFinalizations.back();
+  mPendingFinalizations.emplace_back(std::async(std::launch::async, [this, closed, previous]() {
+                                       if (previous.valid()) {
+                                         previous.wait(); // the slots are finalized in their order
+                                       }
+                                       std::lock_guard<std::mutex> guard(mOutputMutex);
+                                       finalizeSlot(*closed);
+                                     }).share());
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::waitForFinalizations()
+{
+  while (!mPendingFinalizations.empty()) {
+    auto oldest = mPendingFinalizations.front();
+    mPendingFinalizations.pop_front();
+    oldest.get();
+  }
 }
 
 //________________________________________
@@ -264,10 +375,18 @@ TimeSlot<Container>& TimeSlotCalibration<Input, Container>::getSlotForTF(TFType
     }
     return mSlots[0];
   }
-  for (auto it = mSlots.begin(); it != mSlots.end(); it++) {
-    auto rel = (*it).relateToTF(tf);
-    if (rel == 0) {
-      return (*it);
+  if (!mSlots.empty() && tf <= mSlots.back().getTFEnd()) {
+    // the slots are contiguous and have the same length, apart from those which absorbed underpopulated slots,
+    // which are at the beginning: the index is found from the last slot, the scan is only needed for those
+    auto fromBack = (mSlots.back().getTFEnd() - tf) / mSlotLength;
+    if (fromBack < mSlots.size() && mSlots[mSlots.size() - 1 - fromBack].relateToTF(tf) == 0) {
+      return mSlots[mSlots.size() - 1 - fromBack];
+    }
+    for (auto it = mSlots.begin(); it != mSlots.end(); it++) {
+      auto rel = (*it).relateToTF(tf);
+      if (rel == 0) {
+        return (*it);
+      }
     }
   }
   // need to add in the end
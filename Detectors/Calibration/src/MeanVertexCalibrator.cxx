@@ -45,40 +45,7 @@ void MeanVertexCalibrator::finalizeSlot(Slot& slot)
 
   if (mUseFit) {
     MeanVertexObject mvo;
-    // x coordinate
-    std::vector<float> fitValues;
-    float* array = &c->histoX[0];
-    double fitres = fitGaus(c->nbinsX, array, -(c->rangeX), c->rangeX, fitValues);
-    if (fitres >= 0) {
-      LOG(INFO) << "X: Fit result (of single Slot) => " << fitres << ". Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
-    } else {
-      LOG(ERROR) << "X: Fit failed with result = " << fitres;
-    }
-    mvo.setX(fitValues[1]);
-    mvo.setSigmaX(fitValues[2]);
-
-    // y coordinate
-    array = &c->histoY[0];
-    fitres = fitGaus(c->nbinsY, array, -(c->rangeY), c->rangeY, fitValues);
-    if (fitres >= 0) {
-      LOG(INFO) << "Y: Fit result (of single Slot) => " << fitres << ". Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
-    } else {
-      LOG(ERROR) << "Y: Fit failed with result = " << fitres;
-    }
-    mvo.setY(fitValues[1]);
-    mvo.setSigmaY(fitValues[2]);
-
-    // z coordinate
-    array = &c->histoZ[0];
-    fitres = fitGaus(c->nbinsZ, array, -(c->rangeZ), c->rangeZ, fitValues);
-    if (fitres >= 0) {
-      LOG(INFO) << "Z: Fit result (of single Slot) => " << fitres << ". Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
-    } else {
-      LOG(ERROR) << "Z: Fit failed with result = " << fitres;
-    }
-    mvo.setZ(fitValues[1]);
-    mvo.setSigmaZ(fitValues[2]);
-
+    estimate(*c, mvo, "of single Slot");
     // now we add the object to the deque
     mTmpMVobjDq.push_back(std::move(mvo));
   } else {
@@ -90,9 +57,6 @@ void MeanVertexCalibrator::finalizeSlot(Slot& slot)
     }
   }
 
-  // output object
-  MeanVertexObject mvo;
-
   if (mUseFit) {
     doSimpleMovingAverage(mTmpMVobjDq, mSMAMVobj);
   } else {
@@ -101,38 +65,7 @@ void MeanVertexCalibrator::finalizeSlot(Slot& slot)
     for (int i = 0; i < mSMAdata.nbinsX; i++) {
       LOG(DEBUG) << "i = " << i << ", content of histogram = " << mSMAdata.histoX[i];
     }
-    std::vector<float> fitValues;
-    float* array = &mSMAdata.histoX[0];
-    double fitres = fitGaus(mSMAdata.nbinsX, array, -(mSMAdata.rangeX), mSMAdata.rangeX, fitValues);
-    if (fitres >= 0) {
-      LOG(INFO) << "X: Fit result (of merged Slots) => " << fitres << ". Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
-    } else {
-      LOG(ERROR) << "X: Fit failed with result = " << fitres;
-    }
-    mSMAMVobj.setX(fitValues[1]);
-    mSMAMVobj.setSigmaX(fitValues[2]);
-
-    // y coordinate
-    array = &mSMAdata.histoY[0];
-    fitres = fitGaus(mSMAdata.nbinsY, array, -(mSMAdata.rangeY), mSMAdata.rangeY, fitValues);
-    if (fitres >= 0) {
-      LOG(INFO) << "Y: Fit result (of merged Slots) => " << fitres << ". Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
-    } else {
-      LOG(ERROR) << "Y: Fit failed with result = " << fitres;
-    }
-    mSMAMVobj.setY(fitValues[1]);
-    mSMAMVobj.setSigmaY(fitValues[2]);
-
-    // z coordinate
-    array = &mSMAdata.histoZ[0];
-    fitres = fitGaus(mSMAdata.nbinsZ, array, -(mSMAdata.rangeZ), mSMAdata.rangeZ, fitValues);
-    if (fitres >= 0) {
-      LOG(INFO) << "Z: Fit result (of merged Slots) => " << fitres << ". Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
-    } else {
-      LOG(ERROR) << "Z: Fit failed with result = " << fitres;
-    }
-    mSMAMVobj.setZ(fitValues[1]);
-    mSMAMVobj.setSigmaZ(fitValues[2]);
+    estimate(mSMAdata, mSMAMVobj, "of merged Slots");
   }
 
   // TODO: the timestamp is now given with the TF index, but it will have
@@ -152,6 +85,43 @@ void MeanVertexCalibrator::finalizeSlot(Slot& slot)
   slot.print();
 }
 
+//_____________________________________________
+void MeanVertexCalibrator::estimate(const MeanVertexData& c, MVObject& mvo, const char* what) const
+{
+  // estimate the position and the spread of the vertices, with gaussian fits of the histograms
+  // or with the truncated moments
+  const char* names[3] = {"X", "Y", "Z"};
+  const std::vector<float>* histos[3] = {&c.histoX, &c.histoY, &c.histoZ};
+  const int nbins[3] = {c.nbinsX, c.nbinsY, c.nbinsZ};
+  const float ranges[3] = {c.rangeX, c.rangeY, c.rangeZ};
+  float mean[3] = {0.f}, sigma[3] = {0.f};
+  for (int i = 0; i < 3; i++) {
+    if (mUseTruncatedMoments) {
+      if (c.getTruncatedMoments(i, mTruncationNSigma, mean[i], sigma[i])) {
+        LOG(INFO) << names[i] << ": Truncated moments (" << what << ") => Mean = " << mean[i] << " Sigma = " << sigma[i];
+      } else {
+        LOG(ERROR) << names[i] << ": Not enough entries for the truncated moments";
+      }
+      continue;
+    }
+    std::vector<float> fitValues;
+    double fitres = fitGaus(nbins[i], histos[i]->data(), -ranges[i], ranges[i], fitValues);
+    if (fitres >= 0) {
+      LOG(INFO) << names[i] << ": Fit result (" << what << ") => " << fitres << ". Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
+    } else {
+      LOG(ERROR) << names[i] << ": Fit failed with result = " << fitres;
+    }
+    mean[i] = fitValues[1];
+    sigma[i] = fitValues[2];
+  }
+  mvo.setX(mean[0]);
+  mvo.setSigmaX(sigma[0]);
+  mvo.setY(mean[1]);
+  mvo.setSigmaY(sigma[1]);
+  mvo.setZ(mean[2]);
+  mvo.setSigmaZ(sigma[2]);
+}
+
 //_____________________________________________
 void MeanVertexCalibrator::doSimpleMovingAverage(std::deque<float>& dq, float& sma)
 {
@@ -208,6 +178,9 @@ Slot& MeanVertexCalibrator::emplaceNewSlot(bool front, TFType tstart, TFType ten
   auto& cont = getSlots();
   auto& slot = front ? cont.emplace_front(tstart, tend) : cont.emplace_back(tstart, tend);
   slot.setContainer(std::make_unique<MeanVertexData>(mUseFit, mNBinsX, mRangeX, mNBinsY, mRangeY, mNBinsZ, mRangeZ));
+  if (mUseTruncatedMoments) {
+    slot.getContainer()->enableBinMoments();
+  }
   return slot;
 }
 
@@ -14,6 +14,8 @@
 #include "CommonUtils/MemFileHelper.h"
 #include "CCDB/CcdbApi.h"
 #include "DetectorsCalibration/Utils.h"
+#include <algorithm>
+#include <cmath>
 
 using namespace o2::calibration;
 
@@ -56,11 +58,19 @@ void MeanVertexData::fill(const gsl::span<const PVertex> data)
     uint32_t biny = dy < 0 ? 0xffffffff : (y + rangeY) * v2BinY;
     auto dz = z + rangeZ;
     uint32_t binz = dz < 0 ? 0xffffffff : (z + rangeZ) * v2BinZ;
-    if (binx < nbinsX || biny < nbinsY || binz < nbinsZ) { // accounts also for z<-rangeZ
+    if (binx < nbinsX && biny < nbinsY && binz < nbinsZ) { // accounts also for z<-rangeZ
       histoX[binx]++;
       histoY[biny]++;
       histoZ[binz]++;
       entries++;
+      if (useBinMoments) {
+        sumX[binx] += x;
+        sumY[biny] += y;
+        sumZ[binz] += z;
+        sum2X[binx] += double(x) * x;
+        sum2Y[biny] += double(y) * y;
+        sum2Z[binz] += double(z) * z;
+      }
     }
   }
 
@@ -93,6 +103,20 @@ void MeanVertexData::subtract(const MeanVertexData* prev)
   for (int i = histoZ.size(); i--;) {
     histoZ[i] -= prev->histoZ[i];
   }
+  if (useBinMoments && prev->useBinMoments) {
+    for (int i = sumX.size(); i--;) {
+      sumX[i] -= prev->sumX[i];
+      sum2X[i] -= prev->sum2X[i];
+    }
+    for (int i = sumY.size(); i--;) {
+      sumY[i] -= prev->sumY[i];
+      sum2Y[i] -= prev->sum2Y[i];
+    }
+    for (int i = sumZ.size(); i--;) {
+      sumZ[i] -= prev->sumZ[i];
+      sum2Z[i] -= prev->sum2Z[i];
+    }
+  }
   entries -= prev->entries;
 }
 
@@ -109,8 +133,75 @@ void MeanVertexData::merge(const MeanVertexData* prev)
     histoY[i] += prev->histoY[i];
     histoZ[i] += prev->histoZ[i];
   }
+  if (useBinMoments && prev->useBinMoments) {
+    for (int i = sumX.size(); i--;) {
+      sumX[i] += prev->sumX[i];
+      sum2X[i] += prev->sum2X[i];
+    }
+    for (int i = sumY.size(); i--;) {
+      sumY[i] += prev->sumY[i];
+      sum2Y[i] += prev->sum2Y[i];
+    }
+    for (int i = sumZ.size(); i--;) {
+      sumZ[i] += prev->sumZ[i];
+      sum2Z[i] += prev->sum2Z[i];
+    }
+  }
   entries += prev->entries;
 }
 
+//_____________________________________________
+bool MeanVertexData::getTruncatedMoments(int coordinate, float nSigma, float& mean, float& sigma) const
+{
+  const std::vector<float>* histos[3] = {&histoX, &histoY, &histoZ};
+  const std::vector<double>* sums[3] = {&sumX, &sumY, &sumZ};
+  const std::vector<double>* sums2[3] = {&sum2X, &sum2Y, &sum2Z};
+  const float ranges[3] = {rangeX, rangeY, rangeZ};
+  const float v2Bins[3] = {v2BinX, v2BinY, v2BinZ};
+  if (!useBinMoments || coordinate < 0 || coordinate > 2 || entries < 2) {
+    return false;
+  }
+  const auto& histo = *histos[coordinate];
+  const auto& sum = *sums[coordinate];
+  const auto& sum2 = *sums2[coordinate];
+  const float range = ranges[coordinate];
+  const float binWidth = 1.f / v2Bins[coordinate];
+  const int nBins = histo.size();
+
+  // position at which the cumulative distribution reaches the fraction q, interpolated within the bin
+  double total = 0.;
+  for (auto n : histo) {
+    total += n;
+  }
+  auto quantile = [&](double q) {
+    double target = q * total, cumulative = 0.;
+    for (int i = 0; i < nBins; i++) {
+      if (histo[i] > 0 && cumulative + histo[i] >= target) {
+        return -range + (i + (target - cumulative) / histo[i]) * binWidth;
+      }
+      cumulative += histo[i];
+    }
+    return double(range);
+  };
+  double median = quantile(0.5);
+  double robustSigma = 0.5 * (quantile(0.8413) - quantile(0.1587)); // the 68% interval of a Gaussian
+  double window = std::max(nSigma * robustSigma, double(binWidth));
+
+  int firstBin = std::max(0, int((median - window + range) / binWidth));
+  int lastBin = std::min(nBins - 1, int((median + window + range) / binWidth));
+  double n = 0., s = 0., s2 = 0.;
+  for (int i = firstBin; i <= lastBin; i++) {
+    n += histo[i];
+    s += sum[i];
+    s2 += sum2[i];
+  }
+  if (n < 2) {
+    return false;
+  }
+  mean = s / n;
+  sigma = std::sqrt(std::max(0., s2 / n - (s / n) * (s / n)));
+  return true;
+}
+
 } // end namespace calibration
 } // end namespace o2
@@ -28,6 +28,7 @@
 #include "CCDB/BasicCCDBManager.h"
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CcdbObjectInfo.h"
+#include "CCDB/CcdbUploadQueue.h"
 
 using CcdbManager = o2::ccdb::BasicCCDBManager;
 
@@ -48,6 +49,20 @@ class CCDBPopulator : public o2::framework::Task
     auto& mgr = CcdbManager::instance();
     mgr.setURL(mCCDBpath);
     mAPI.init(mgr.getURL());
+    int nUploadThreads = ic.options().get<int>("upload-threads");
+    if (nUploadThreads > 0) {
+      mUploadQueue = std::make_unique<o2::ccdb::CcdbUploadQueue>();
+      mUploadQueue->init(mgr.getURL(), nUploadThreads, ic.options().get<int>("upload-retries"), ic.options().get<int>("upload-retry-delay"),
+                         ic.options().get<std::string>("upload-spool-dir"));
+      mUploadQueue->recoverSpooled();
+    }
+  }
+
+  void endOfStream(o2::framework::EndOfStreamContext& ec) final
+  {
+    if (mUploadQueue) {
+      mUploadQueue->flush();
+    }
   }
 
   void run(o2::framework::ProcessingContext& pc) final
@@ -61,13 +76,18 @@ class CCDBPopulator : public o2::framework::Task
 
       LOG(INFO) << "Storing in ccdb " << wrp->getPath() << "/" << wrp->getFileName() << " of size " << pld.size()
                 << " Valid for " << wrp->getStartValidityTimestamp() << " : " << wrp->getEndValidityTimestamp();
-      mAPI.storeAsBinaryFile(&pld[0], pld.size(), wrp->getFileName(), wrp->getObjectType(), wrp->getPath(),
-                             wrp->getMetaData(), wrp->getStartValidityTimestamp(), wrp->getEndValidityTimestamp());
+      if (mUploadQueue) { // the payload is copied, since the input is released once we return
+        mUploadQueue->push(std::vector<char>(pld.begin(), pld.end()), *wrp);
+      } else {
+        mAPI.storeAsBinaryFile(&pld[0], pld.size(), wrp->getFileName(), wrp->getObjectType(), wrp->getPath(),
+                               wrp->getMetaData(), wrp->getStartValidityTimestamp(), wrp->getEndValidityTimestamp());
+      }
     }
   }
 
  private:
   CcdbApi mAPI;
+  std::unique_ptr<o2::ccdb::CcdbUploadQueue> mUploadQueue; // asynchronous uploads, if requested
   std::string mCCDBpath = "http://ccdb-test.cern.ch:8080"; // CCDB path
 };
 
@@ -87,7 +107,11 @@ DataProcessorSpec getCCDBPopulatorDeviceSpec()
     Outputs{},
     AlgorithmSpec{adaptFromTask<o2::calibration::CCDBPopulator>()},
     Options{
-      {"ccdb-path", VariantType::String, "http://ccdb-test.cern.ch:8080", {"Path to CCDB"}}}};
+      {"ccdb-path", VariantType::String, "http://ccdb-test.cern.ch:8080", {"Path to CCDB"}},
+      {"upload-threads", VariantType::Int, 2, {"Number of asynchronous uploads in parallel, 0 for synchronous uploads"}},
+      {"upload-retries", VariantType::Int, 3, {"Number of retries of a failed asynchronous upload"}},
+      {"upload-retry-delay", VariantType::Int, 1000, {"Delay (ms) before the 1st retry, doubled at every further retry"}},
+      {"upload-spool-dir", VariantType::String, "", {"Directory to spool the objects which could not be uploaded, queued again at the next start"}}}};
 }
 
 } // namespace framework
@@ -44,6 +44,7 @@ void MeanVertexCalibDevice::init(InitContext& ic)
   mCalibrator = std::make_unique<o2::calibration::MeanVertexCalibrator>(minEnt, useFit, nbX, rangeX, nbY, rangeY, nbZ, rangeZ, nSlots4SMA);
   mCalibrator->setSlotLength(slotL);
   mCalibrator->setMaxSlotsDelay(delay);
+  mCalibrator->setUseTruncatedMoments(params->useTruncatedMoments, params->truncationNSigma);
 }
 
 //_____________________________________________________________
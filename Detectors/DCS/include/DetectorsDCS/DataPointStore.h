@@ -0,0 +1,104 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_DCS_DATAPOINT_STORE_H
+#define O2_DCS_DATAPOINT_STORE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <gsl/span>
+
+#include "DetectorsDCS/DataPointCompositeObject.h"
+#include "DetectorsDCS/DataPointIdentifier.h"
+#include "DetectorsDCS/DataPointValue.h"
+#include "DetectorsDCS/DeliveryType.h"
+
+namespace o2::dcs
+{
+/**
+  * DataPointStore is the bookkeeping shared by the DCS processors.
+  *
+  * The data points a processor is configured for are given once (per run)
+  * and each of them gets a dense index. The vectors of data points received
+  * are then resolved to those indices in one go, and the last value and
+  * time received for each index are kept in flat arrays.
+  *
+  * Since the DCS proxy sends the data points mostly in the same order,
+  * the resolution first checks the index the data point at the same
+  * position had in the previous vector, then the index following the one
+  * of the previous data point, and only then looks it up in the table.
+  */
+class DataPointStore
+{
+ public:
+  static constexpr int InvalidIndex = -1;
+
+  DataPointStore() = default;
+  explicit DataPointStore(const std::vector<DataPointIdentifier>& dpids) { init(dpids); }
+
+  /// Set the data points to be handled, forgetting any previous value.
+  /// Duplicated ones are only taken once.
+  void init(const std::vector<DataPointIdentifier>& dpids);
+
+  /// @return the identifiers of all the aliases in @a patterns, with the
+  /// given @a type, as expanded by expandAliases
+  static std::vector<DataPointIdentifier> expandIdentifiers(const std::vector<std::string>& patterns, DeliveryType type);
+
+  size_t size() const { return mIds.size(); }
+
+  /// @return the index of @a dpid, InvalidIndex if it is not handled
+  int getIndex(const DataPointIdentifier& dpid) const;
+  const DataPointIdentifier& getIdentifier(int index) const { return mIds[index]; }
+
+  /// Resolve all the data points in @a dps and keep their values.
+  /// @return the index of each data point of @a dps, InvalidIndex for the
+  /// ones which are not handled. It is valid until the next update.
+  gsl::span<const int> update(gsl::span<const DataPointCompositeObject> dps);
+
+  /// Last value received for the data point @a index, if any
+  const DataPointValue& getLastValue(int index) const { return mValues[index]; }
+  /// Epoch time, in ms, of the last value received for @a index, 0 if none
+  uint64_t getLastTime(int index) const { return mTimes[index]; }
+  /// How many values were received for @a index since the last clear
+  uint32_t getNUpdates(int index) const { return mNUpdates[index]; }
+  bool hasValue(int index) const { return mNUpdates[index] != 0; }
+
+  /// Forget the values received so far, keeping the data points
+  void clearValues();
+
+ private:
+  /// The hash of DataPointIdentifier creates a string out of the alias,
+  /// this one simply mixes its 64 bytes.
+  struct FastHash {
+    size_t operator()(const DataPointIdentifier& dpid) const noexcept;
+  };
+
+  int resolve(const DataPointIdentifier& dpid, int hint) const
+  {
+    if (hint >= 0 && hint < (int)mIds.size() && mIds[hint] == dpid) {
+      return hint;
+    }
+    return getIndex(dpid);
+  }
+
+  std::unordered_map<DataPointIdentifier, int, FastHash> mIndices;
+  std::vector<DataPointIdentifier> mIds;
+  std::vector<DataPointValue> mValues;
+  std::vector<uint64_t> mTimes;
+  std::vector<uint32_t> mNUpdates;
+  std::vector<int> mBatchIndices; // indices of the last vector of data points resolved
+};
+
+} // namespace o2::dcs
+
+#endif
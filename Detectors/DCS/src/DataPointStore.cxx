@@ -0,0 +1,99 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "DetectorsDCS/DataPointStore.h"
+#include "DetectorsDCS/AliasExpander.h"
+#include <algorithm>
+#include <cstring>
+
+namespace o2::dcs
+{
+
+size_t DataPointStore::FastHash::operator()(const DataPointIdentifier& dpid) const noexcept
+{
+  static_assert(sizeof(DataPointIdentifier) == 8 * sizeof(uint64_t), "DataPointIdentifier is expected to be 64 bytes");
+  uint64_t words[8];
+  std::memcpy(words, &dpid, sizeof(words));
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (auto w : words) {
+    h ^= w + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+  }
+  return h;
+}
+
+void DataPointStore::init(const std::vector<DataPointIdentifier>& dpids)
+{
+  mIndices.clear();
+  mIds.clear();
+  mIndices.reserve(dpids.size());
+  mIds.reserve(dpids.size());
+  for (const auto& dpid : dpids) {
+    if (mIndices.emplace(dpid, (int)mIds.size()).second) {
+      mIds.push_back(dpid);
+    }
+  }
+  mValues.assign(mIds.size(), DataPointValue());
+  mTimes.assign(mIds.size(), 0);
+  mNUpdates.assign(mIds.size(), 0);
+  mBatchIndices.clear();
+}
+
+std::vector<DataPointIdentifier> DataPointStore::expandIdentifiers(const std::vector<std::string>& patterns, DeliveryType type)
+{
+  std::vector<DataPointIdentifier> dpids;
+  for (const auto& alias : expandAliases(patterns)) {
+    dpids.emplace_back(alias, type);
+  }
+  return dpids;
+}
+
+int DataPointStore::getIndex(const DataPointIdentifier& dpid) const
+{
+  auto it = mIndices.find(dpid);
+  return it == mIndices.end() ? InvalidIndex : it->second;
+}
+
+gsl::span<const int> DataPointStore::update(gsl::span<const DataPointCompositeObject> dps)
+{
+  // the previous indices are the hints for the same positions
+  mBatchIndices.resize(dps.size(), InvalidIndex);
+  int previous = InvalidIndex;
+  for (size_t i = 0; i < dps.size(); i++) {
+    const auto& dp = dps[i];
+    int index = InvalidIndex;
+    if (mBatchIndices[i] != InvalidIndex && mIds[mBatchIndices[i]] == dp.id) {
+      index = mBatchIndices[i];
+    } else {
+      index = resolve(dp.id, previous + 1);
+    }
+    mBatchIndices[i] = index;
+    previous = index;
+    if (index == InvalidIndex) {
+      continue;
+    }
+    auto time = dp.data.get_epoch_time();
+    if (time >= mTimes[index]) {
+      mValues[index] = dp.data;
+      mTimes[index] = time;
+    }
+    mNUpdates[index]++;
+  }
+  return {mBatchIndices.data(), dps.size()};
+}
+
+void DataPointStore::clearValues()
+{
+  std::fill(mValues.begin(), mValues.end(), DataPointValue());
+  std::fill(mTimes.begin(), mTimes.end(), 0);
+  std::fill(mNUpdates.begin(), mNUpdates.end(), 0);
+}
+
+} // namespace o2::dcs
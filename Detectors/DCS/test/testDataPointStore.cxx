@@ -0,0 +1,74 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test DCS DataPointStore
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include "DetectorsDCS/DataPointCreator.h"
+#include "DetectorsDCS/DataPointStore.h"
+
+using namespace o2::dcs;
+
+BOOST_AUTO_TEST_CASE(DataPointStoreIndicesFollowTheExpandedAliases)
+{
+  auto dpids = DataPointStore::expandIdentifiers({"tof_hv_vp_[00..02]", "tof_hv_vp_01"}, DeliveryType::RAW_DOUBLE);
+  BOOST_CHECK_EQUAL(dpids.size(), 4);
+  DataPointStore store(dpids);
+  BOOST_CHECK_EQUAL(store.size(), 3);
+  for (int i = 0; i < 3; i++) {
+    BOOST_CHECK_EQUAL(store.getIndex(dpids[i]), i);
+    BOOST_CHECK(store.getIdentifier(i) == dpids[i]);
+    BOOST_CHECK(store.hasValue(i) == false);
+  }
+  BOOST_CHECK_EQUAL(store.getIndex(DataPointIdentifier("tof_hv_vp_03", DeliveryType::RAW_DOUBLE)), DataPointStore::InvalidIndex);
+  BOOST_CHECK_EQUAL(store.getIndex(DataPointIdentifier("tof_hv_vp_00", DeliveryType::RAW_INT)), DataPointStore::InvalidIndex);
+}
+
+BOOST_AUTO_TEST_CASE(DataPointStoreKeepsTheLatestValue)
+{
+  DataPointStore store(DataPointStore::expandIdentifiers({"tof_hv_vp_[00..02]"}, DeliveryType::RAW_DOUBLE));
+  std::vector<DataPointCompositeObject> dps;
+  dps.emplace_back(createDataPointCompositeObject("tof_hv_vp_02", 2., 100, 0));
+  dps.emplace_back(createDataPointCompositeObject("tof_hv_vp_03", 3., 100, 0));
+  dps.emplace_back(createDataPointCompositeObject("tof_hv_vp_00", 0., 100, 0));
+  dps.emplace_back(createDataPointCompositeObject("tof_hv_vp_01", 1., 100, 0));
+  auto indices = store.update(dps);
+  std::vector<int> expected = {2, DataPointStore::InvalidIndex, 0, 1};
+  BOOST_TEST(std::vector<int>(indices.begin(), indices.end()) == expected, boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(store.getLastTime(2), 100000);
+  BOOST_CHECK_EQUAL(getValue<double>(DataPointCompositeObject(store.getIdentifier(1), store.getLastValue(1))), 1.);
+
+  // same order, with one late and one newer value
+  dps[0] = createDataPointCompositeObject("tof_hv_vp_02", 20., 99, 0);
+  dps[2] = createDataPointCompositeObject("tof_hv_vp_00", 10., 101, 0);
+  indices = store.update(dps);
+  BOOST_TEST(std::vector<int>(indices.begin(), indices.end()) == expected, boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(getValue<double>(DataPointCompositeObject(store.getIdentifier(2), store.getLastValue(2))), 2.);
+  BOOST_CHECK_EQUAL(getValue<double>(DataPointCompositeObject(store.getIdentifier(0), store.getLastValue(0))), 10.);
+  BOOST_CHECK_EQUAL(store.getNUpdates(2), 2);
+
+  // a different order and size resolves as well
+  std::vector<DataPointCompositeObject> others;
+  others.emplace_back(createDataPointCompositeObject("tof_hv_vp_00", 0., 102, 0));
+  others.emplace_back(createDataPointCompositeObject("tof_hv_vp_01", 1., 102, 0));
+  indices = store.update(others);
+  BOOST_CHECK_EQUAL(indices.size(), 2);
+  BOOST_CHECK_EQUAL(indices[0], 0);
+  BOOST_CHECK_EQUAL(indices[1], 1);
+
+  store.clearValues();
+  BOOST_CHECK(store.hasValue(0) == false);
+  BOOST_CHECK_EQUAL(store.getLastTime(0), 0);
+}
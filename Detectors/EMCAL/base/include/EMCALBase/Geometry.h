@@ -426,6 +426,12 @@ class Geometry
   /// \return Position (0 - phi, 1 - eta) of the cell inside teh supermodule
   std::tuple<int, int> GetCellPhiEtaIndexInSModule(int supermoduleID, int moduleID, int phiInModule, int etaInModule) const;
 
+  /// \brief Get eta-phi indexes of cell in SM, from the lookup table
+  /// \param absId cell absolute id. number
+  /// \return Position (0 - phi, 1 - eta) of the cell inside teh supermodule
+  /// \throw InvalidCellIDException if cell ID does not exist
+  std::tuple<int, int> GetCellPhiEtaIndexInSModule(Int_t absId) const;
+
   /// \brief Adapt cell indices in supermodule to online indexing
   /// \param supermoduleID super module number of the channel/cell
   /// \param iphi row/phi cell index, modified for DCal
@@ -610,6 +616,16 @@ class Geometry
   /// Used in order to fill the lookup table of cell indices
   std::tuple<int, int, int, int> CalculateCellIndex(Int_t absId) const;
 
+  /// \brief Calculate the position of the cell inside its SM, used to fill the lookup table for RelPosCellInSModule
+  /// \param absId cell absolute id. number
+  /// \return Point3D with x,y,z coordinates of cell with absId inside SM
+  math_utils::Point3D<double> CalculateRelPosCellInSModule(Int_t absId) const;
+
+  /// \brief Calculate the position of the cell in the global numbering scheme, used to fill the lookup table for GlobalRowColFromIndex
+  /// \param cellID Absolute cell ID
+  /// \return tuple with position in global numbering scheme (0 - row, 1 - column)
+  std::tuple<int, int> CalculateGlobalRowCol(int cellID) const;
+
   std::string mGeoName;                     ///< Geometry name string
   Int_t mKey110DEG;                         ///< For calculation abs cell id; 19-oct-05
   Int_t mnSupModInDCAL;                     ///< For calculation abs cell id; 06-nov-12
@@ -694,6 +710,9 @@ class Geometry
 
   mutable const TGeoHMatrix* SMODULEMATRIX[EMCAL_MODULES];      ///< Orientations of EMCAL super modules
   std::vector<std::tuple<int, int, int, int>> mCellIndexLookup; ///< Lookup table for cell indices
+  std::vector<std::tuple<int, int>> mCellPhiEtaIndexInSMLookup; ///< Lookup table for the eta-phi indices of the cells in their SM
+  std::vector<math_utils::Point3D<double>> mCellRelPosLookup;   ///< Lookup table for the positions of the cells in their SM
+  std::vector<std::tuple<int, int>> mCellGlobalRowColLookup;    ///< Lookup table for the positions of the cells in the global numbering scheme
 
  private:
   static Geometry* sGeom; ///< Pointer to the unique instance of the singleton
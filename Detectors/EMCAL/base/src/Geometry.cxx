@@ -85,7 +85,10 @@ Geometry::Geometry(const Geometry& geo)
     mILOSS(geo.mILOSS),
     mIHADR(geo.mIHADR),
     mSteelFrontThick(geo.mSteelFrontThick), // obsolete data member?
-    mCellIndexLookup(geo.mCellIndexLookup)
+    mCellIndexLookup(geo.mCellIndexLookup),
+    mCellPhiEtaIndexInSMLookup(geo.mCellPhiEtaIndexInSMLookup),
+    mCellRelPosLookup(geo.mCellRelPosLookup),
+    mCellGlobalRowColLookup(geo.mCellGlobalRowColLookup)
 {
   memcpy(mEnvelop, geo.mEnvelop, sizeof(Float_t) * 3);
   memcpy(mParSM, geo.mParSM, sizeof(Float_t) * 3);
@@ -161,6 +164,16 @@ Geometry::Geometry(const std::string_view name, const std::string_view mcname, c
   for (auto icell = 0; icell < mNCells; icell++) {
     mCellIndexLookup[icell] = CalculateCellIndex(icell);
   }
+  // the other per-cell lookup tables are based on the cell indices
+  mCellPhiEtaIndexInSMLookup.resize(mNCells);
+  mCellRelPosLookup.resize(mNCells);
+  mCellGlobalRowColLookup.resize(mNCells);
+  for (auto icell = 0; icell < mNCells; icell++) {
+    auto [supermodule, module, phiInModule, etaInModule] = mCellIndexLookup[icell];
+    mCellPhiEtaIndexInSMLookup[icell] = GetCellPhiEtaIndexInSModule(supermodule, module, phiInModule, etaInModule);
+    mCellRelPosLookup[icell] = CalculateRelPosCellInSModule(icell);
+    mCellGlobalRowColLookup[icell] = CalculateGlobalRowCol(icell);
+  }
 
   memset(SMODULEMATRIX, 0, sizeof(TGeoHMatrix*) * EMCAL_MODULES);
 
@@ -797,6 +810,11 @@ std::tuple<int, int> Geometry::GlobalRowColFromIndex(int cellID) const
   if (!CheckAbsCellId(cellID)) {
     throw InvalidCellIDException(cellID);
   }
+  return mCellGlobalRowColLookup[cellID];
+}
+
+std::tuple<int, int> Geometry::CalculateGlobalRowCol(int cellID) const
+{
   auto [supermodule, module, phiInModule, etaInModule] = GetCellIndex(cellID);
   auto [row, col] = GetCellPhiEtaIndexInSModule(supermodule, module, phiInModule, etaInModule);
   // add offsets (row / col per supermodule)
@@ -1031,6 +1049,14 @@ std::tuple<int, int, int, int> Geometry::GetCellIndex(Int_t absId) const
   return mCellIndexLookup[absId];
 }
 
+std::tuple<int, int> Geometry::GetCellPhiEtaIndexInSModule(Int_t absId) const
+{
+  if (!CheckAbsCellId(absId)) {
+    throw InvalidCellIDException(absId);
+  }
+  return mCellPhiEtaIndexInSMLookup[absId];
+}
+
 Int_t Geometry::GetSuperModuleNumber(Int_t absId) const { return std::get<0>(GetCellIndex(absId)); }
 
 std::tuple<int, int> Geometry::GetModulePhiEtaIndexInSModule(int supermoduleID, int moduleID) const
@@ -1092,6 +1118,14 @@ std::tuple<int, int> Geometry::ShiftOfflineToOnlineCellIndexes(Int_t supermodule
 }
 
 o2::math_utils::Point3D<double> Geometry::RelPosCellInSModule(Int_t absId) const
+{
+  if (!CheckAbsCellId(absId)) {
+    throw InvalidCellIDException(absId);
+  }
+  return mCellRelPosLookup[absId];
+}
+
+o2::math_utils::Point3D<double> Geometry::CalculateRelPosCellInSModule(Int_t absId) const
 {
   // Shift index taking into account the difference between standard SM
   // and SM of half (or one third) size in phi direction
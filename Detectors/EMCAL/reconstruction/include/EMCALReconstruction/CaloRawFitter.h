@@ -14,6 +14,7 @@
 #include <iosfwd>
 #include <array>
 #include <optional>
+#include <vector>
 #include <Rtypes.h>
 #include <gsl/span>
 #include "EMCALReconstruction/CaloFitResults.h"
@@ -75,6 +76,21 @@ class CaloRawFitter
                                   std::optional<unsigned int> altrocfg1,
                                   std::optional<unsigned int> altrocfg2) = 0;
 
+  /// \brief Evaluation of amplitude and time for a batch of channels
+  /// \param channels ALTRO bunches of each channel in the batch
+  /// \param altrocfg1 ALTRO config register 1 from RCU trailer
+  /// \param altrocfg2 ALTRO config register 2 from RCU trailer
+  /// \param[out] results Fit results, one entry per channel
+  /// \param[out] errors Fit error per channel, empty if the fit of the channel succeeded
+  ///
+  /// The default implementation calls evaluate for each channel. Fitters which
+  /// can process several channels at once (Gamma2) override it.
+  virtual void evaluateBatch(const gsl::span<const gsl::span<const Bunch>> channels,
+                             std::optional<unsigned int> altrocfg1,
+                             std::optional<unsigned int> altrocfg2,
+                             std::vector<CaloFitResults>& results,
+                             std::vector<std::optional<RawFitterError_t>>& errors);
+
   /// \brief Method to do the selection of what should possibly be fitted.
   /// \param bunchvector ALTRO bunches for the current channel
   /// \param altrocfg1 ALTRO config register 1 from RCU trailer
@@ -15,6 +15,7 @@
 #include <iosfwd>
 #include <array>
 #include <optional>
+#include <vector>
 #include <Rtypes.h>
 #include "EMCALReconstruction/CaloFitResults.h"
 #include "DataFormatsEMCAL/Constants.h"
@@ -62,10 +63,79 @@ class CaloRawFitterGamma2 final : public CaloRawFitter
                           std::optional<unsigned int> altrocfg1,
                           std::optional<unsigned int> altrocfg2) final;
 
+  /// \brief Evaluation Amplitude and TOF for a batch of channels
+  /// \param channels ALTRO bunches of each channel in the batch
+  /// \param altrocfg1 ALTRO config register 1 from RCU trailer
+  /// \param altrocfg2 ALTRO config register 2 from RCU trailer
+  /// \param[out] results Fit results, one entry per channel
+  /// \param[out] errors Fit error per channel, empty if the fit of the channel succeeded
+  ///
+  /// Same results as evaluate for each channel. The sample selection is done per channel,
+  /// the Newton iterations of the gamma-2 fit run for all channels at once on the fit
+  /// windows stored lane by lane, with at most mNiterationsMax + 1 iterations for all lanes.
+  void evaluateBatch(const gsl::span<const gsl::span<const Bunch>> channels,
+                     std::optional<unsigned int> altrocfg1,
+                     std::optional<unsigned int> altrocfg2,
+                     std::vector<CaloFitResults>& results,
+                     std::vector<std::optional<RawFitterError_t>>& errors) final;
+
  private:
+  /// \struct ChannelFit
+  /// \brief Intermediate state of the fit of one channel
+  struct ChannelFit {
+    float amp = 0;          ///< Amplitude (estimate, then fit result)
+    float time = 0;         ///< Time (estimate, then fit result)
+    float ampEstimate = 0;  ///< Amplitude estimate from the max. sample
+    float timeEstimate = 0; ///< Time estimate from the max. sample
+    float pedEstimate = 0;  ///< Pedestal
+    float chi2 = 0;         ///< Chi2 of the fit
+    short maxADC = 0;       ///< Max. ADC value
+    int first = 0;          ///< First time bin of the fit window
+    int nsamples = 0;       ///< Number of samples in the fit window
+    int ndf = 0;            ///< Number of degrees of freedom
+    int timebinOffset = 0;  ///< Offset of the bunch in time
+    bool doFit = false;     ///< Samples are suitable for the peak fit
+    bool fitDone = false;   ///< Peak fit converged
+    int lane = -1;          ///< Lane of the channel in a batch fit
+  };
+
+  /// \brief Status of a lane in the batch fit
+  enum class LaneStatus_t : char {
+    ACTIVE,    ///< Fit still iterating
+    CONVERGED, ///< Fit converged
+    FAILED     ///< Fit failed
+  };
+
   int mNiter = 0;           ///< number of iteraions
   int mNiterationsMax = 15; ///< max number of iteraions
 
+  std::vector<ChannelFit> mBatchFits;    //!<! Fit state of the channels in the current batch
+  std::vector<double> mLaneSamples;      //!<! Fit windows of the lanes, stored time bin by time bin
+  std::vector<int> mLaneNSamples;        //!<! Number of samples per lane
+  std::vector<float> mLaneAmp;           //!<! Amplitude per lane
+  std::vector<float> mLaneTime;          //!<! Time per lane
+  std::vector<float> mLaneChi2;          //!<! Chi2 per lane
+  std::vector<LaneStatus_t> mLaneStatus; //!<! Status per lane
+
+  /// \brief Select the samples of a channel and determine the start values of the fit
+  /// \param bunchlist ALTRO bunches for the current channel
+  /// \param altrocfg1 ALTRO config register 1 from RCU trailer
+  /// \param altrocfg2 ALTRO config register 2 from RCU trailer
+  /// \return Fit state of the channel, the fit window is left in mReversed
+  /// \throw RawFitterError_t in case the bunch selection failed
+  ChannelFit prepareFit(const gsl::span<const Bunch> bunchlist, std::optional<unsigned int> altrocfg1, std::optional<unsigned int> altrocfg2);
+
+  /// \brief Build the fit results of a channel after the peak fit
+  /// \param fit Fit state of the channel
+  /// \return Container with the fit results (amp, time, chi2, ...)
+  /// \throw RawFitterError_t::FIT_ERROR in case the amplitude is below the cut
+  CaloFitResults finalizeFit(ChannelFit& fit) const;
+
+  /// \brief Gamma-2 fit of all lanes of the current batch
+  ///
+  /// Same iterations as doFit_1peak, done for all lanes until every one converged or failed.
+  void doFit_batch();
+
   /// \brief Fits the raw signal time distribution
   /// \param firstTimeBin First timebin in the ALTRO bunch
   /// \param nSamples Number of time samples of the ALTRO bunch
@@ -15,6 +15,8 @@
 #define ALICEO2_EMCAL_CLUSTERIZER_H
 
 #include <array>
+#include <utility>
+#include <vector>
 #include <gsl/span>
 #include "Rtypes.h"
 #include "DataFormatsEMCAL/Cluster.h"
@@ -35,12 +37,14 @@ constexpr unsigned int NCOLS = 48 * 2 + 1;         // 2x  supermodule columns +
 using ClusterIndex = int;
 
 /// \class Clusterizer
-/// \brief Meta class for recursive clusterizer
+/// \brief Meta class for topological clusterizer
 /// \ingroup EMCALreconstruction
 /// \author Rudiger Haake (Yale)
 ///
 ///  Implementation of same algorithm version as in AliEMCALClusterizerv2,
-///  but optimized.
+///  but optimized. Clusters are grown by an iterative flood fill on a dense
+///  row/column grid, visiting the neighbours in the same order as the former
+///  recursion. Only the grid cells filled by an event are reset afterwards.
 
 template <class InputType>
 class Clusterizer
@@ -58,11 +62,6 @@ class Clusterizer
     int column;
   };
 
-  struct InputwithIndex {
-    InputType* mInput;
-    ClusterIndex mIndex;
-  };
-
  public:
   Clusterizer(double timeCut, double timeMin, double timeMax, double gradientCut, bool doEnergyGradientCut, double thresholdSeedE, double thresholdCellE);
   Clusterizer();
@@ -81,12 +80,15 @@ class Clusterizer
   Geometry* getGeometry() { return mEMCALGeometry; }
 
  private:
-  void getClusterFromNeighbours(std::vector<InputwithIndex>& clusterUnputs, int row, int column);
+  void getClusterFromNeighbours(const gsl::span<InputType const>& inputArray, int row, int column);
   void getTopologicalRowColumn(const InputType& input, int& row, int& column);
-  Geometry* mEMCALGeometry = nullptr;                             //!<! pointer to geometry for utilities
-  std::array<cellWithE, NROWS * NCOLS> mSeedList;                 //!<! seed array
-  std::array<std::array<InputwithIndex, NCOLS>, NROWS> mInputMap; //!<! topology arrays
-  std::array<std::array<bool, NCOLS>, NROWS> mCellMask;           //!<! topology arrays
+  void resetTopologicalMaps();
+  Geometry* mEMCALGeometry = nullptr;                //!<! pointer to geometry for utilities
+  std::array<cellWithE, NROWS * NCOLS> mSeedList;    //!<! seed array
+  std::array<ClusterIndex, NROWS * NCOLS> mInputMap; //!<! topology arrays, index of the cell/digit in the input array (-1 if empty)
+  std::array<bool, NROWS * NCOLS> mCellMask;         //!<! topology arrays
+  std::vector<int> mFilledCells;                     //!<! grid positions filled in the current event
+  std::vector<std::pair<int, int>> mNeighbourStack;  //!<! flood fill stack of (grid position, next neighbour direction)
 
   std::vector<Cluster> mFoundClusters;     ///<  vector of cluster objects
   std::vector<ClusterIndex> mInputIndices; ///<  vector of associated cell/digit tower ID, ordered by cluster
@@ -74,6 +74,21 @@ CaloRawFitter::CaloRawFitter(const char* name, const char* nameshort) : mMinTime
 {
 }
 
+void CaloRawFitter::evaluateBatch(const gsl::span<const gsl::span<const Bunch>> channels,
+                                  std::optional<unsigned int> altrocfg1, std::optional<unsigned int> altrocfg2,
+                                  std::vector<CaloFitResults>& results, std::vector<std::optional<RawFitterError_t>>& errors)
+{
+  results.assign(channels.size(), CaloFitResults());
+  errors.assign(channels.size(), std::nullopt);
+  for (std::size_t ich = 0; ich < channels.size(); ich++) {
+    try {
+      results[ich] = evaluate(channels[ich], altrocfg1, altrocfg2);
+    } catch (RawFitterError_t& e) {
+      errors[ich] = e;
+    }
+  }
+}
+
 void CaloRawFitter::setTimeConstraint(int min, int max)
 {
 
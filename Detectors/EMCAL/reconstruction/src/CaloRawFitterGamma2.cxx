@@ -15,6 +15,7 @@
 #include "FairLogger.h"
 #include <cfloat>
 #include <random>
+#include <algorithm>
 
 // ROOT sytem
 #include "TMath.h"
@@ -35,46 +36,131 @@ CaloRawFitterGamma2::CaloRawFitterGamma2() : CaloRawFitter("Chi Square ( Gamma2
 CaloFitResults CaloRawFitterGamma2::evaluate(const gsl::span<const Bunch> bunchlist,
                                              std::optional<unsigned int> altrocfg1, std::optional<unsigned int> altrocfg2)
 {
-  float time = 0;
-  float amp = 0;
-  float chi2 = 0;
-  int ndf = 0;
-  bool fitDone = false;
+  auto fit = prepareFit(bunchlist, altrocfg1, altrocfg2);
+
+  if (fit.doFit) {
+    mNiter = 0;
+    try {
+      fit.chi2 = doFit_1peak(fit.first, fit.nsamples, fit.amp, fit.time);
+      fit.fitDone = true;
+    } catch (RawFitterError_t& e) {
+      // Fit has failed, set values to estimates
+      // TODO: Check whether we want to include cases in which the peak fit failed
+      fit.amp = fit.ampEstimate;
+      fit.time = fit.timeEstimate;
+      fit.chi2 = 1.e9;
+    }
+  }
+  return finalizeFit(fit);
+}
+
+void CaloRawFitterGamma2::evaluateBatch(const gsl::span<const gsl::span<const Bunch>> channels,
+                                        std::optional<unsigned int> altrocfg1, std::optional<unsigned int> altrocfg2,
+                                        std::vector<CaloFitResults>& results, std::vector<std::optional<RawFitterError_t>>& errors)
+{
+  results.assign(channels.size(), CaloFitResults());
+  errors.assign(channels.size(), std::nullopt);
+  mBatchFits.resize(channels.size());
+
+  // sample selection and start values per channel, the fit windows are
+  // collected lane by lane and transposed in doFit_batch
+  mLaneSamples.clear();
+  mLaneNSamples.clear();
+  mLaneAmp.clear();
+  mLaneTime.clear();
+  for (std::size_t ich = 0; ich < channels.size(); ich++) {
+    try {
+      mBatchFits[ich] = prepareFit(channels[ich], altrocfg1, altrocfg2);
+    } catch (RawFitterError_t& e) {
+      errors[ich] = e;
+      continue;
+    }
+    auto& fit = mBatchFits[ich];
+    if (fit.doFit) {
+      fit.lane = mLaneNSamples.size();
+      mLaneNSamples.push_back(fit.nsamples);
+      mLaneAmp.push_back(fit.amp);
+      mLaneTime.push_back(fit.time);
+      for (int itbin = 0; itbin < constants::EMCAL_MAXTIMEBINS; itbin++) {
+        mLaneSamples.push_back(itbin < fit.nsamples ? getReversed(itbin) : 0.);
+      }
+    }
+  }
+
+  doFit_batch();
+
+  for (std::size_t ich = 0; ich < channels.size(); ich++) {
+    if (errors[ich]) {
+      continue;
+    }
+    auto& fit = mBatchFits[ich];
+    if (fit.doFit) {
+      if (mLaneStatus[fit.lane] == LaneStatus_t::CONVERGED) {
+        fit.amp = mLaneAmp[fit.lane];
+        fit.time = mLaneTime[fit.lane];
+        fit.chi2 = mLaneChi2[fit.lane];
+        fit.fitDone = true;
+      } else {
+        // Fit has failed, set values to estimates
+        fit.amp = fit.ampEstimate;
+        fit.time = fit.timeEstimate;
+        fit.chi2 = 1.e9;
+      }
+    }
+    try {
+      results[ich] = finalizeFit(fit);
+    } catch (RawFitterError_t& e) {
+      errors[ich] = e;
+    }
+  }
+}
+
+CaloRawFitterGamma2::ChannelFit CaloRawFitterGamma2::prepareFit(const gsl::span<const Bunch> bunchlist,
+                                                                std::optional<unsigned int> altrocfg1, std::optional<unsigned int> altrocfg2)
+{
+  ChannelFit fit;
 
   auto [nsamples, bunchIndex, ampEstimate,
         maxADC, timeEstimate, pedEstimate, first, last] = preFitEvaluateSamples(bunchlist, altrocfg1, altrocfg2, mAmpCut);
+  fit.ampEstimate = ampEstimate;
+  fit.timeEstimate = timeEstimate;
+  fit.pedEstimate = pedEstimate;
+  fit.maxADC = maxADC;
+  fit.nsamples = nsamples;
+  fit.first = first;
 
   if (bunchIndex >= 0 && ampEstimate >= mAmpCut) {
-    time = timeEstimate;
-    int timebinOffset = bunchlist[bunchIndex].getStartTime() - (bunchlist[bunchIndex].getBunchLength() - 1);
-    amp = ampEstimate;
+    fit.time = timeEstimate;
+    fit.timebinOffset = bunchlist[bunchIndex].getStartTime() - (bunchlist[bunchIndex].getBunchLength() - 1);
+    fit.amp = ampEstimate;
 
     if (nsamples > 2 && maxADC < constants::OVERFLOWCUT) {
-      std::tie(amp, time) = doParabolaFit(timeEstimate - 1);
-      mNiter = 0;
-      try {
-        chi2 = doFit_1peak(first, nsamples, amp, time);
-        fitDone = true;
-      } catch (RawFitterError_t& e) {
-        // Fit has failed, set values to estimates
-        // TODO: Check whether we want to include cases in which the peak fit failed
-        amp = ampEstimate;
-        time = timeEstimate;
-        chi2 = 1.e9;
-      }
-
-      time += timebinOffset;
-      timeEstimate += timebinOffset;
-      ndf = nsamples - 2;
+      std::tie(fit.amp, fit.time) = doParabolaFit(timeEstimate - 1);
+      fit.doFit = true;
     }
   }
+  return fit;
+}
+
+CaloFitResults CaloRawFitterGamma2::finalizeFit(ChannelFit& fit) const
+{
+  float amp = fit.amp;
+  float time = fit.time;
+  float timeEstimate = fit.timeEstimate;
+  bool fitDone = fit.fitDone;
+
+  if (fit.doFit) {
+    time += fit.timebinOffset;
+    timeEstimate += fit.timebinOffset;
+    fit.ndf = fit.nsamples - 2;
+  }
 
   if (fitDone) {
-    float ampAsymm = (amp - ampEstimate) / (amp + ampEstimate);
+    float ampAsymm = (amp - fit.ampEstimate) / (amp + fit.ampEstimate);
     float timeDiff = time - timeEstimate;
 
     if ((TMath::Abs(ampAsymm) > 0.1) || (TMath::Abs(timeDiff) > 2)) {
-      amp = ampEstimate;
+      amp = fit.ampEstimate;
       time = timeEstimate;
       fitDone = false;
     }
@@ -88,7 +174,7 @@ CaloFitResults CaloRawFitterGamma2::evaluate(const gsl::span<const Bunch> bunchl
     time = time * constants::EMCAL_TIMESAMPLE;
     time -= mL1Phase;
 
-    return CaloFitResults(maxADC, pedEstimate, mAlgo, amp, time, (int)time, chi2, ndf);
+    return CaloFitResults(fit.maxADC, fit.pedEstimate, mAlgo, amp, time, (int)time, fit.chi2, fit.ndf);
   }
   // Fit failed, rethrow error
   throw RawFitterError_t::FIT_ERROR;
@@ -158,6 +244,91 @@ float CaloRawFitterGamma2::doFit_1peak(int firstTimeBin, int nSamples, float& am
   return chi2;
 }
 
+void CaloRawFitterGamma2::doFit_batch()
+{
+  // Same Newton iterations as doFit_1peak, executed for all lanes in lock step.
+  // The fit windows are transposed such that the inner loop runs over lanes with
+  // unit stride, lanes which converged or failed are masked out of the sums.
+  const int nlanes = mLaneNSamples.size();
+  mLaneChi2.assign(nlanes, 0.);
+  mLaneStatus.assign(nlanes, LaneStatus_t::ACTIVE);
+  mNiter = 0;
+  if (!nlanes) {
+    return;
+  }
+  const int maxsamples = *std::max_element(mLaneNSamples.begin(), mLaneNSamples.end());
+  std::vector<double> samples(maxsamples * nlanes);
+  for (int lane = 0; lane < nlanes; lane++) {
+    for (int itbin = 0; itbin < maxsamples; itbin++) {
+      samples[itbin * nlanes + lane] = mLaneSamples[lane * constants::EMCAL_MAXTIMEBINS + itbin];
+    }
+  }
+  std::vector<double> c11(nlanes), c12(nlanes), c21(nlanes), c22(nlanes), d1(nlanes), d2(nlanes);
+  std::vector<float> chi2(nlanes);
+
+  // like in doFit_1peak the fit fails if it did not converge after mNiterationsMax + 1 iterations
+  int nactive = nlanes;
+  for (int iter = 0; iter <= mNiterationsMax && nactive; iter++) {
+    mNiter++;
+    std::fill(c11.begin(), c11.end(), 0.);
+    std::fill(c12.begin(), c12.end(), 0.);
+    std::fill(c21.begin(), c21.end(), 0.);
+    std::fill(c22.begin(), c22.end(), 0.);
+    std::fill(d1.begin(), d1.end(), 0.);
+    std::fill(d2.begin(), d2.end(), 0.);
+    std::fill(chi2.begin(), chi2.end(), 0.);
+
+    for (int itbin = 0; itbin < maxsamples; itbin++) {
+      const double* reversed = samples.data() + itbin * nlanes;
+      for (int lane = 0; lane < nlanes; lane++) {
+        float ampl = mLaneAmp[lane];
+        double ti = (itbin - mLaneTime[lane]) / constants::TAU;
+        bool use = mLaneStatus[lane] == LaneStatus_t::ACTIVE && itbin < mLaneNSamples[lane] && (ti + 1) >= 0;
+
+        double g_1i = (ti + 1) * TMath::Exp(-2 * ti);
+        double g_i = (ti + 1) * g_1i;
+        double gp_i = 2 * (g_i - g_1i);
+        double q1_i = (2 * ti + 1) * TMath::Exp(-2 * ti);
+        double q2_i = g_1i * g_1i * (4 * ti + 1);
+        double delta = ampl * g_i - reversed[lane];
+        c11[lane] += use ? (reversed[lane] - ampl * 2 * g_i) * gp_i : 0.;
+        c12[lane] += use ? g_i * g_i : 0.;
+        c21[lane] += use ? reversed[lane] * q1_i - ampl * q2_i : 0.;
+        c22[lane] += use ? g_i * g_1i : 0.;
+        d1[lane] += use ? delta * g_i : 0.;
+        d2[lane] += use ? delta * g_1i : 0.;
+        chi2[lane] += use ? (delta * delta) : 0.;
+      }
+    }
+
+    for (int lane = 0; lane < nlanes; lane++) {
+      if (mLaneStatus[lane] != LaneStatus_t::ACTIVE) {
+        continue;
+      }
+      double D = c11[lane] * c22[lane] - c12[lane] * c21[lane];
+      if (TMath::Abs(D) < DBL_EPSILON) {
+        mLaneStatus[lane] = LaneStatus_t::FAILED;
+        nactive--;
+        continue;
+      }
+      double dt = (d1[lane] * c22[lane] - d2[lane] * c12[lane]) / D * constants::TAU;
+      double dA = (d1[lane] * c21[lane] - d2[lane] * c11[lane]) / D;
+      mLaneTime[lane] += dt;
+      mLaneAmp[lane] += dA;
+      mLaneChi2[lane] = chi2[lane];
+      if (!(TMath::Abs(dA) > 1 || TMath::Abs(dt) > 0.01)) {
+        mLaneStatus[lane] = LaneStatus_t::CONVERGED;
+        nactive--;
+      }
+    }
+  }
+  for (auto& status : mLaneStatus) {
+    if (status == LaneStatus_t::ACTIVE) {
+      status = LaneStatus_t::FAILED;
+    }
+  }
+}
+
 std::tuple<float, float> CaloRawFitterGamma2::doParabolaFit(int maxTimeBin) const
 {
   float amp(0.), time(0.);
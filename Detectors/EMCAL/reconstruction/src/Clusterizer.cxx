@@ -24,6 +24,8 @@ using namespace o2::emcal;
 template <class InputType>
 Clusterizer<InputType>::Clusterizer(double timeCut, double timeMin, double timeMax, double gradientCut, bool doEnergyGradientCut, double thresholdSeedE, double thresholdCellE) : mSeedList(), mInputMap(), mCellMask(), mTimeCut(timeCut), mTimeMin(timeMin), mTimeMax(timeMax), mGradientCut(gradientCut), mDoEnergyGradientCut(doEnergyGradientCut), mThresholdSeedEnergy(thresholdSeedE), mThresholdCellEnergy(thresholdCellE)
 {
+  mInputMap.fill(-1);
+  mCellMask.fill(kFALSE);
 }
 
 ///
@@ -32,6 +34,8 @@ Clusterizer<InputType>::Clusterizer(double timeCut, double timeMin, double timeM
 template <class InputType>
 Clusterizer<InputType>::Clusterizer() : mSeedList(), mInputMap(), mCellMask(), mTimeCut(0), mTimeMin(0), mTimeMax(0), mGradientCut(0), mDoEnergyGradientCut(false), mThresholdSeedEnergy(0), mThresholdCellEnergy(0)
 {
+  mInputMap.fill(-1);
+  mCellMask.fill(kFALSE);
 }
 
 ///
@@ -50,44 +54,72 @@ void Clusterizer<InputType>::initialize(double timeCut, double timeMin, double t
 }
 
 ///
-/// Recursively search for neighbours (EMCAL)
+/// Search for neighbours (EMCAL)
 //____________________________________________________________________________
 template <class InputType>
-void Clusterizer<InputType>::getClusterFromNeighbours(std::vector<InputwithIndex>& clusterInputs, int row, int column)
+void Clusterizer<InputType>::getClusterFromNeighbours(const gsl::span<InputType const>& inputArray, int row, int column)
 {
-  // Recursion 0, add seed cell/digit to cluster
-  if (!clusterInputs.size()) {
-    clusterInputs.emplace_back(mInputMap[row][column]);
-  }
-
-  // Mark the current cell as clustered
-  mCellMask[row][column] = kTRUE;
-
-  // Now go recursively to the next 4 neighbours and add them to the cluster if they fulfill the conditions
+  // Flood fill with an explicit stack, equivalent to a depth-first recursion over
+  // the 4 neighbours: a neighbour fulfilling the conditions is marked and descended
+  // into immediately, and appended to the cluster once all of its own neighbours
+  // have been processed. The seed is appended first.
   constexpr int rowDiffs[4] = {-1, 0, 0, 1};
   constexpr int colDiffs[4] = {0, -1, 1, 0};
-  for (int dir = 0; dir < 4; dir++) {
-    if ((row + rowDiffs[dir] < 0) || (row + rowDiffs[dir] >= NROWS)) {
+
+  int seed = row * NCOLS + column;
+  mInputIndices.emplace_back(mInputMap[seed]);
+  mCellMask[seed] = kTRUE;
+  mNeighbourStack.clear();
+  mNeighbourStack.emplace_back(seed, 0);
+
+  while (mNeighbourStack.size()) {
+    auto& [current, dir] = mNeighbourStack.back();
+    if (dir == 4) {
+      // all neighbours processed, add the cell/digit to the current cluster -- if we end up here, it fulfills the condition
+      if (current != seed) {
+        mInputIndices.emplace_back(mInputMap[current]);
+      }
+      mNeighbourStack.pop_back();
       continue;
     }
-    if ((column + colDiffs[dir] < 0) || (column + colDiffs[dir] >= NCOLS)) {
+    int currentRow = current / NCOLS, currentColumn = current % NCOLS;
+    int neighbourRow = currentRow + rowDiffs[dir], neighbourColumn = currentColumn + colDiffs[dir];
+    dir++;
+    if ((neighbourRow < 0) || (neighbourRow >= NROWS)) {
       continue;
     }
-
-    if (mInputMap[row + rowDiffs[dir]][column + colDiffs[dir]].mInput) {
-      if (!mCellMask[row + rowDiffs[dir]][column + colDiffs[dir]]) {
-        if (mDoEnergyGradientCut && not(mInputMap[row + rowDiffs[dir]][column + colDiffs[dir]].mInput->getEnergy() > mInputMap[row][column].mInput->getEnergy() + mGradientCut)) {
-          if (not(TMath::Abs(mInputMap[row + rowDiffs[dir]][column + colDiffs[dir]].mInput->getTimeStamp() - mInputMap[row][column].mInput->getTimeStamp()) > mTimeCut)) {
-            getClusterFromNeighbours(clusterInputs, row + rowDiffs[dir], column + colDiffs[dir]);
-            // Add the cell/digit to the current cluster -- if we end up here, the selected cluster fulfills the condition
-            clusterInputs.emplace_back(mInputMap[row + rowDiffs[dir]][column + colDiffs[dir]]);
-          }
-        }
+    if ((neighbourColumn < 0) || (neighbourColumn >= NCOLS)) {
+      continue;
+    }
+    int neighbour = neighbourRow * NCOLS + neighbourColumn;
+    if (mInputMap[neighbour] < 0 || mCellMask[neighbour]) {
+      continue;
+    }
+    const auto& neighbourInput = inputArray[mInputMap[neighbour]];
+    const auto& currentInput = inputArray[mInputMap[current]];
+    if (mDoEnergyGradientCut && not(neighbourInput.getEnergy() > currentInput.getEnergy() + mGradientCut)) {
+      if (not(TMath::Abs(neighbourInput.getTimeStamp() - currentInput.getTimeStamp()) > mTimeCut)) {
+        // Mark the neighbour as clustered and continue from there
+        mCellMask[neighbour] = kTRUE;
+        mNeighbourStack.emplace_back(neighbour, 0);
       }
     }
   }
 }
 
+///
+/// Reset the grid positions filled in the last event
+//____________________________________________________________________________
+template <class InputType>
+void Clusterizer<InputType>::resetTopologicalMaps()
+{
+  for (auto position : mFilledCells) {
+    mInputMap[position] = -1;
+    mCellMask[position] = kFALSE;
+  }
+  mFilledCells.clear();
+}
+
 ///
 /// Get row (phi) and column (eta) of a cell/digit, values corresponding to topology
 ///
@@ -96,10 +128,9 @@ template <class InputType>
 void Clusterizer<InputType>::getTopologicalRowColumn(const InputType& input, int& row, int& column)
 {
   // Get SM number and relative row/column for SM
-  auto cellIndex = mEMCALGeometry->GetCellIndex(input.getTower());
-  int nSupMod = std::get<0>(cellIndex);
+  int nSupMod = mEMCALGeometry->GetSuperModuleNumber(input.getTower());
 
-  auto phiEtaIndex = mEMCALGeometry->GetCellPhiEtaIndexInSModule(nSupMod, std::get<1>(cellIndex), std::get<2>(cellIndex), std::get<3>(cellIndex));
+  auto phiEtaIndex = mEMCALGeometry->GetCellPhiEtaIndexInSModule(input.getTower());
   row = std::get<0>(phiEtaIndex);
   column = std::get<1>(phiEtaIndex);
 
@@ -139,12 +170,8 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
   // --> Recursive to neighboughs and create cluster
   // --> Seed cell and all neighbours belonging to cluster will be put in 2D bitmap
 
-  // Reset cell/digit maps and cell masks
-  // Loop over one array dim, then reset each array
-  for (auto iArr = 0; iArr < NROWS; iArr++) {
-    mCellMask[iArr].fill(kFALSE);
-    mInputMap[iArr].fill({nullptr, -1});
-  }
+  // Reset cell/digit maps and cell masks, only the positions filled in the previous event need to be cleared
+  resetTopologicalMaps();
 
   // Calibrate cells/digits and fill the maps/arrays
   int nCells = 0;
@@ -152,7 +179,7 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
   //for (auto dig : inputArray) {
   for (int iIndex = 0; iIndex < inputArray.size(); iIndex++) {
 
-    auto dig = inputArray[iIndex];
+    const auto& dig = inputArray[iIndex];
 
     Float_t inputEnergy = dig.getEnergy();
     Float_t time = dig.getTimeStamp();
@@ -168,8 +195,8 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
     // Put cell/digit to 2D map
     int row = 0, column = 0;
     getTopologicalRowColumn(dig, row, column);
-    mInputMap[row][column].mInput = &dig;   // mInputMap saves pointers to cells/digits, therefore use addr operator here
-    mInputMap[row][column].mIndex = iIndex; // mInputMap saves the position of cells/digits in the input array
+    mInputMap[row * NCOLS + column] = iIndex; // mInputMap saves the position of cells/digits in the input array
+    mFilledCells.emplace_back(row * NCOLS + column);
     mSeedList[nCells].energy = inputEnergy;
     mSeedList[nCells].row = row;
     mSeedList[nCells].column = column;
@@ -183,7 +210,7 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
   for (int i = nCells; i--;) {
     int row = mSeedList[i].row, column = mSeedList[i].column;
     // Continue if the cell is already masked (i.e. was already clustered)
-    if (mCellMask[row][column]) {
+    if (mCellMask[row * NCOLS + column]) {
       continue;
     }
     // Continue if energy constraints are not fulfilled
@@ -191,19 +218,13 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
       continue;
     }
 
-    // Seed is found, form cluster recursively
-    std::vector<InputwithIndex> clusterInputs;
-    getClusterFromNeighbours(clusterInputs, row, column);
-
-    // Add cells/digits for current cluster to cell/digit index vector
+    // Seed is found, form cluster, the cells/digits of the cluster are added to the cell/digit index vector
     int inputIndexStart = mInputIndices.size();
-    for (auto dig : clusterInputs) {
-      mInputIndices.emplace_back(dig.mIndex);
-    }
+    getClusterFromNeighbours(inputArray, row, column);
     int inputIndexSize = mInputIndices.size() - inputIndexStart;
 
     // Now form cluster object from cells/digits
-    mFoundClusters.emplace_back(mInputMap[row][column].mInput->getTimeStamp(), inputIndexStart, inputIndexSize); // Cluster object initialized w/ time of seed cell, start + size of associated cells
+    mFoundClusters.emplace_back(inputArray[mInputMap[row * NCOLS + column]].getTimeStamp(), inputIndexStart, inputIndexSize); // Cluster object initialized w/ time of seed cell, start + size of associated cells
   }
   LOG(DEBUG) << mFoundClusters.size() << "clusters found from " << nCells << " cells/digits (total=" << inputArray.size() << ")-> ehs " << ehs << " (minE " << mThresholdCellEnergy << ")";
 }
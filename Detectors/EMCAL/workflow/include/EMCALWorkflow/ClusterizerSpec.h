@@ -61,11 +61,17 @@ class ClusterizerSpec : public framework::Task
   /// Input digits: {"EMC", "DIGITS", 0, Lifetime::Timeframe}
   /// Output clusters: {"clusters", "CLUSTERS", 0, Lifetime::Timeframe}
   /// Output indices: {"clusterDigitIndices", "CLUSTERDIGITINDICES", 0, Lifetime::Timeframe}
+  ///
+  /// Trigger records are independent, with more than one thread they are clusterized
+  /// concurrently and the outputs are concatenated in the order of the trigger records.
   void run(framework::ProcessingContext& ctx) final;
   void endOfStream(framework::EndOfStreamContext& ec) final;
 
  private:
-  o2::emcal::Clusterizer<InputType> mClusterizer;                               ///< Clusterizer object
+  std::vector<o2::emcal::Clusterizer<InputType>> mClusterizers;                 ///< Clusterizer objects, one per thread
+  int mNThreads = 1;                                                            ///< Number of threads clusterizing trigger records in parallel
+  std::vector<std::vector<o2::emcal::Cluster>> mTriggerClusters;                ///< Clusters found per trigger record
+  std::vector<std::vector<o2::emcal::ClusterIndex>> mTriggerIndices;            ///< Cell/digit indices found per trigger record
   o2::emcal::Geometry* mGeometry = nullptr;                                     ///< Pointer to geometry object
   std::vector<o2::emcal::Cluster>* mOutputClusters = nullptr;                   ///< Container with output clusters (pointer)
   std::vector<o2::emcal::ClusterIndex>* mOutputCellDigitIndices = nullptr;      ///< Container with indices of cluster digits (pointer)
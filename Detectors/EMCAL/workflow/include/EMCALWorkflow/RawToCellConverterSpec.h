@@ -10,6 +10,8 @@
 // or submit itself to any jurisdiction.
 
 #include <vector>
+#include <optional>
+#include <tuple>
 
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/Task.h"
@@ -84,17 +86,21 @@ class RawToCellConverterSpec : public framework::Task
   bool isLostTimeframe(framework::ProcessingContext& ctx) const;
   void sendData(framework::ProcessingContext& ctx, const std::vector<o2::emcal::Cell>& cells, const std::vector<o2::emcal::TriggerRecord>& triggers, const std::vector<ErrorTypeFEE>& decodingErrors) const;
 
-  header::DataHeader::SubSpecificationType mSubspecification = 0; ///< Subspecification for output channels
-  int mNoiseThreshold = 0;                                        ///< Noise threshold in raw fit
-  int mNumErrorMessages = 0;                                      ///< Current number of error messages
-  int mErrorMessagesSuppressed = 0;                               ///< Counter of suppressed error messages
-  int mMaxErrorMessages = 100;                                    ///< Max. number of error messages
-  Geometry* mGeometry = nullptr;                                  ///!<! Geometry pointer
-  std::unique_ptr<MappingHandler> mMapper = nullptr;              ///!<! Mapper
-  std::unique_ptr<CaloRawFitter> mRawFitter;                      ///!<! Raw fitter
-  std::vector<Cell> mOutputCells;                                 ///< Container with output cells
-  std::vector<TriggerRecord> mOutputTriggerRecords;               ///< Container with output cells
-  std::vector<ErrorTypeFEE> mOutputDecoderErrors;                 ///< Container with decoder errors
+  header::DataHeader::SubSpecificationType mSubspecification = 0;         ///< Subspecification for output channels
+  int mNoiseThreshold = 0;                                                ///< Noise threshold in raw fit
+  int mNumErrorMessages = 0;                                              ///< Current number of error messages
+  int mErrorMessagesSuppressed = 0;                                       ///< Counter of suppressed error messages
+  int mMaxErrorMessages = 100;                                            ///< Max. number of error messages
+  Geometry* mGeometry = nullptr;                                          ///!<! Geometry pointer
+  std::unique_ptr<MappingHandler> mMapper = nullptr;                      ///!<! Mapper
+  std::unique_ptr<CaloRawFitter> mRawFitter;                              ///!<! Raw fitter
+  std::vector<gsl::span<const Bunch>> mChannelBunches;                    ///!<! Bunches of the channels of the current DDL
+  std::vector<std::tuple<int, ChannelType_t>> mChannelCells;              ///!<! Cell ID and channel type of the channels of the current DDL
+  std::vector<CaloFitResults> mFitResults;                                ///!<! Fit results of the channels of the current DDL
+  std::vector<std::optional<CaloRawFitter::RawFitterError_t>> mFitErrors; ///!<! Fit errors of the channels of the current DDL
+  std::vector<Cell> mOutputCells;                                         ///< Container with output cells
+  std::vector<TriggerRecord> mOutputTriggerRecords;                       ///< Container with output cells
+  std::vector<ErrorTypeFEE> mOutputDecoderErrors;                         ///< Container with decoder errors
 };
 
 /// \brief Creating DataProcessorSpec for the EMCAL Cell Converter Spec
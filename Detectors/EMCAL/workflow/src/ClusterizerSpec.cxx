@@ -8,6 +8,7 @@
 // In applying this license CERN does not waive the privileges and immunities
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
+#include <algorithm>
 #include <gsl/span>
 
 #include "FairLogger.h"
@@ -18,6 +19,10 @@
 #include "DataFormatsEMCAL/TriggerRecord.h"
 #include "EMCALWorkflow/ClusterizerSpec.h"
 #include "Framework/ControlService.h"
+#include "Framework/ConfigParamRegistry.h"
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::emcal::reco_workflow;
 
@@ -37,9 +42,21 @@ void ClusterizerSpec<InputType>::init(framework::InitContext& ctx)
     LOG(ERROR) << "Failure accessing geometry";
   }
 
-  // Initialize clusterizer and link geometry
-  mClusterizer.initialize(timeCut, timeMin, timeMax, gradientCut, doEnergyGradientCut, thresholdSeedEnergy, thresholdCellEnergy);
-  mClusterizer.setGeometry(mGeometry);
+#ifdef WITH_OPENMP
+  mNThreads = std::max(1, ctx.options().get<int>("nthreads"));
+#else
+  if (ctx.options().get<int>("nthreads") > 1) {
+    LOG(WARNING) << "Multithreading is not supported, imposing single thread";
+  }
+  mNThreads = 1;
+#endif
+
+  // Initialize clusterizers and link geometry
+  mClusterizers.resize(mNThreads);
+  for (auto& clusterizer : mClusterizers) {
+    clusterizer.initialize(timeCut, timeMin, timeMax, gradientCut, doEnergyGradientCut, thresholdSeedEnergy, thresholdCellEnergy);
+    clusterizer.setGeometry(mGeometry);
+  }
 
   mOutputClusters = new std::vector<o2::emcal::Cluster>();
   mOutputCellDigitIndices = new std::vector<o2::emcal::ClusterIndex>();
@@ -76,26 +93,43 @@ void ClusterizerSpec<InputType>::run(framework::ProcessingContext& ctx)
   mOutputTriggerRecord->clear();
   mOutputTriggerRecordIndices->clear();
 
-  int currentStartClusters = mOutputClusters->size();
-  int currentStartIndices = mOutputCellDigitIndices->size();
-  for (auto iTrgRcrd : InputTriggerRecord) {
+  // clusterize the trigger records, each thread with its own clusterizer
+  mTriggerClusters.resize(InputTriggerRecord.size());
+  mTriggerIndices.resize(InputTriggerRecord.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int itrg = 0; itrg < InputTriggerRecord.size(); itrg++) {
+#ifdef WITH_OPENMP
+    auto& clusterizer = mClusterizers[omp_get_thread_num()];
+#else
+    auto& clusterizer = mClusterizers[0];
+#endif
+    const auto& iTrgRcrd = InputTriggerRecord[itrg];
     if (Inputs.size() && iTrgRcrd.getNumberOfObjects()) {
-      mClusterizer.findClusters(gsl::span<const InputType>(&Inputs[iTrgRcrd.getFirstEntry()], iTrgRcrd.getNumberOfObjects())); // Find clusters on cells/digits (pass by ref)
+      clusterizer.findClusters(gsl::span<const InputType>(&Inputs[iTrgRcrd.getFirstEntry()], iTrgRcrd.getNumberOfObjects())); // Find clusters on cells/digits (pass by ref)
     } else {
-      mClusterizer.clear();
+      clusterizer.clear();
     }
     // Get found clusters + cell/digit indices for output
     // * A cluster contains a range that correspond to the vector of cell/digit indices
     // * The cell/digit index vector contains the indices of the clusterized cells/digits wrt to the original cell/digit array
+    mTriggerClusters[itrg] = *clusterizer.getFoundClusters();
+    mTriggerIndices[itrg] = *clusterizer.getFoundClustersInputIndices();
+  }
 
-    auto outputClustersTemp = mClusterizer.getFoundClusters();
-    auto outputCellDigitIndicesTemp = mClusterizer.getFoundClustersInputIndices();
+  int currentStartClusters = mOutputClusters->size();
+  int currentStartIndices = mOutputCellDigitIndices->size();
+  for (int itrg = 0; itrg < InputTriggerRecord.size(); itrg++) {
+    const auto& iTrgRcrd = InputTriggerRecord[itrg];
+    const auto& outputClustersTemp = mTriggerClusters[itrg];
+    const auto& outputCellDigitIndicesTemp = mTriggerIndices[itrg];
 
-    std::copy(outputClustersTemp->begin(), outputClustersTemp->end(), std::back_inserter(*mOutputClusters));
-    std::copy(outputCellDigitIndicesTemp->begin(), outputCellDigitIndicesTemp->end(), std::back_inserter(*mOutputCellDigitIndices));
+    std::copy(outputClustersTemp.begin(), outputClustersTemp.end(), std::back_inserter(*mOutputClusters));
+    std::copy(outputCellDigitIndicesTemp.begin(), outputCellDigitIndicesTemp.end(), std::back_inserter(*mOutputCellDigitIndices));
 
-    mOutputTriggerRecord->emplace_back(iTrgRcrd.getBCData(), currentStartClusters, outputClustersTemp->size());
-    mOutputTriggerRecordIndices->emplace_back(iTrgRcrd.getBCData(), currentStartIndices, outputCellDigitIndicesTemp->size());
+    mOutputTriggerRecord->emplace_back(iTrgRcrd.getBCData(), currentStartClusters, outputClustersTemp.size());
+    mOutputTriggerRecordIndices->emplace_back(iTrgRcrd.getBCData(), currentStartIndices, outputCellDigitIndicesTemp.size());
 
     currentStartClusters = mOutputClusters->size();
     currentStartIndices = mOutputCellDigitIndices->size();
@@ -137,11 +171,13 @@ o2::framework::DataProcessorSpec o2::emcal::reco_workflow::getClusterizerSpec(bo
     return o2::framework::DataProcessorSpec{"EMCALClusterizerSpec",
                                             inputs,
                                             outputs,
-                                            o2::framework::adaptFromTask<o2::emcal::reco_workflow::ClusterizerSpec<o2::emcal::Digit>>()};
+                                            o2::framework::adaptFromTask<o2::emcal::reco_workflow::ClusterizerSpec<o2::emcal::Digit>>(),
+                                            o2::framework::Options{{"nthreads", o2::framework::VariantType::Int, 1, {"Number of threads clusterizing trigger records in parallel"}}}};
   } else {
     return o2::framework::DataProcessorSpec{"EMCALClusterizerSpec",
                                             inputs,
                                             outputs,
-                                            o2::framework::adaptFromTask<o2::emcal::reco_workflow::ClusterizerSpec<o2::emcal::Cell>>()};
+                                            o2::framework::adaptFromTask<o2::emcal::reco_workflow::ClusterizerSpec<o2::emcal::Cell>>(),
+                                            o2::framework::Options{{"nthreads", o2::framework::VariantType::Int, 1, {"Number of threads clusterizing trigger records in parallel"}}}};
   }
 }
@@ -195,7 +195,9 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
       const auto& map = mMapper->getMappingForDDL(feeID);
       int iSM = feeID / 2;
 
-      // Loop over all the channels
+      // Loop over all the channels, collect the mapped ones and fit them all at once
+      mChannelBunches.clear();
+      mChannelCells.clear();
       for (auto& chan : decoder.getChannels()) {
 
         int iRow, iCol;
@@ -211,19 +213,16 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
 
         auto [phishift, etashift] = mGeometry->ShiftOnlineToOfflineCellIndexes(iSM, iRow, iCol);
         int CellID = mGeometry->GetAbsCellIdFromCellIndexes(iSM, phishift, etashift);
+        mChannelBunches.emplace_back(chan.getBunches());
+        mChannelCells.emplace_back(CellID, chantype);
+      }
 
-        // define the conatiner for the fit results, and perform the raw fitting using the stadnard raw fitter
-        CaloFitResults fitResults;
-        try {
-          fitResults = mRawFitter->evaluate(chan.getBunches(), 0, 0);
-          // Prevent negative entries - we should no longer get here as the raw fit usually will end in an error state
-          if (fitResults.getAmp() < 0) {
-            fitResults.setAmp(0.);
-          }
-          if (fitResults.getTime() < 0) {
-            fitResults.setTime(0.);
-          }
-        } catch (CaloRawFitter::RawFitterError_t& fiterror) {
+      // perform the raw fitting of all channels of the DDL
+      mRawFitter->evaluateBatch(mChannelBunches, 0, 0, mFitResults, mFitErrors);
+      for (std::size_t ich = 0; ich < mChannelCells.size(); ich++) {
+        auto& fitResults = mFitResults[ich];
+        if (mFitErrors[ich]) {
+          auto fiterror = *mFitErrors[ich];
           if (mNumErrorMessages < mMaxErrorMessages) {
             LOG(ERROR) << "Failure in raw fitting: " << CaloRawFitter::createErrorMessage(fiterror);
             mNumErrorMessages++;
@@ -234,7 +233,16 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
             mErrorMessagesSuppressed++;
           }
           mOutputDecoderErrors.emplace_back(feeID, -1, CaloRawFitter::getErrorNumber(fiterror));
+        } else {
+          // Prevent negative entries - we should no longer get here as the raw fit usually will end in an error state
+          if (fitResults.getAmp() < 0) {
+            fitResults.setAmp(0.);
+          }
+          if (fitResults.getTime() < 0) {
+            fitResults.setTime(0.);
+          }
         }
+        auto [CellID, chantype] = mChannelCells[ich];
         currentCellContainer->emplace_back(CellID, fitResults.getAmp() * CONVADCGEV, fitResults.getTime(), chantype);
       }
     }
@@ -331,14 +331,16 @@ void Digitizer::init()
   TF1 singlePhESpectrumFn("mSinglePhESpectrum",
                           &Digitizer::SinglePhESpectrum, 0, 30, 0);
   float const meansPhE = singlePhESpectrumFn.Mean(0, 30);
+  const AliasSampler singlePhESampler(singlePhESpectrumFn, 0, 30);
   mRndGainVar.initialize([&]() -> float {
-    return singlePhESpectrumFn.GetRandom(0, 30) / meansPhE;
+    return singlePhESampler.sample() / meansPhE;
   });
 
   TF1 signalShapeFn("signalShape", "crystalball", 0, 300);
   signalShapeFn.SetParameters(1, parameters.ShapeSigma, parameters.ShapeSigma, parameters.ShapeAlpha, parameters.ShapeN);
+  const AliasSampler signalShapeSampler(signalShapeFn, 0, 200);
   mRndSignalShape.initialize([&]() -> float {
-    return signalShapeFn.GetRandom(0, 200);
+    return signalShapeSampler.sample();
   });
 }
 //_______________________________________________________________________
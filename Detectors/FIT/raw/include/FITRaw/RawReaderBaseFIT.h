@@ -16,12 +16,18 @@
 //
 //Main purpuse is to decode FIT data blocks and push them to DigitBlockFIT for proccess
 //Base class only provides static linkID-moduleType conformity
+//Pages of a TF can be also collected by addPage() and decoded by processPages():
+//links are decoded in parallel, data blocks are accumulated into BC-indexed table and compacted into digits
 
 #ifndef ALICEO2_FIT_RAWREADERBASEFIT_H_
 #define ALICEO2_FIT_RAWREADERBASEFIT_H_
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <Rtypes.h>
+#include <CommonDataFormat/InteractionRecord.h>
+#include <CommonConstants/LHCConstants.h>
+#include <Framework/Logger.h>
 #include "FITRaw/RawReaderBase.h"
 
 #include "Headers/RAWDataHeader.h"
@@ -57,6 +63,240 @@ class RawReaderBaseFIT : public RawReaderBase<DigitBlockFITtype, DataBlockPMtype
       RawReaderBase_t::template processBinaryData<DataBlockPM_t>(payload, std::forward<T>(feeParameters)...);
     }
   }
+  //max size of BC table, TF with larger IR range is processed page by page
+  static constexpr int sMaxBCTable = o2::constants::lhc::LHCMaxBunches * 512;
+  //collect page for processPages()
+  void addPage(gsl::span<const uint8_t> payload, int linkID, int ep)
+  {
+    mPages.push_back({payload, linkID, ep, 0});
+  }
+  //deserialize all collected pages to raw data blocks and proccesss them to digits
+  //Output is identical to calling process() page by page
+  void processPages()
+  {
+    groupPagesByLinks();
+    //decoding, each link is decoded by single thread
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+    for (int iLink = 0; iLink < mNLinks; iLink++) {
+      auto& link = mLinks[iLink];
+      if (link.mIsTCM) {
+        decodeLink(link, link.mBlocksTCM);
+      } else {
+        decodeLink(link, link.mBlocksPM);
+      }
+    }
+    //IR range of TF
+    bool isEmpty = true;
+    InteractionRecord irMin, irMax;
+    for (int iLink = 0; iLink < mNLinks; iLink++) {
+      const auto& link = mLinks[iLink];
+      if (link.mBlockPage.empty()) {
+        continue;
+      }
+      if (isEmpty || link.mIRmin < irMin) {
+        irMin = link.mIRmin;
+      }
+      if (isEmpty || irMax < link.mIRmax) {
+        irMax = link.mIRmax;
+      }
+      isEmpty = false;
+    }
+    if (!isEmpty) {
+      const auto nBC = irMax.differenceInBC(irMin) + 1;
+      if (nBC > sMaxBCTable) {
+        LOG(WARNING) << "IR range " << irMin << " : " << irMax << " exceeds BC table size, processing pages sequentially";
+        processPagesSequentially();
+      } else {
+        fillDigits(irMin, int(nBC));
+      }
+    }
+    mPages.clear();
+  }
+  void setNThreads(int n)
+  {
+#ifdef WITH_OPENMP
+    mNThreads = n > 0 ? n : 1;
+#else
+    LOG(WARNING) << "Multithreading is not supported, imposing single thread";
+    mNThreads = 1;
+#endif
+  }
+  int getNThreads() const { return mNThreads; }
+
+ private:
+  struct RawPage {
+    gsl::span<const uint8_t> mPayload;
+    int mLinkID;
+    int mEP;
+    int mLink; //index in mLinks
+  };
+  struct LinkData {
+    int mLinkID = -1;
+    int mEP = -1;
+    bool mIsTCM = false;
+    std::vector<int> mPages; //page indexes in mPages, in stream order
+    std::vector<DataBlockPM_t> mBlocksPM;
+    std::vector<DataBlockTCM_t> mBlocksTCM;
+    std::vector<int> mBlockPage; //page index per data block
+    std::vector<int> mBlockBC;   //BC table position per data block
+    InteractionRecord mIRmin;
+    InteractionRecord mIRmax;
+  };
+  struct BlockRef {
+    int mPage;
+    int mLink;
+    int mBlock;
+  };
+  int mNThreads = 1;
+  int mNLinks = 0;
+  std::vector<RawPage> mPages;
+  std::vector<LinkData> mLinks;          //only first mNLinks are used in current TF
+  std::vector<int> mBCTable;             //number of data blocks per BC, write position after compaction
+  std::vector<int> mDigitOffsets;        //first BlockRef of each digit in mBlockRefs
+  std::vector<DigitBlockFIT_t*> mDigits; //digits of current TF in IR order
+  std::vector<BlockRef> mBlockRefs;      //data blocks grouped by digits
+
+  void groupPagesByLinks()
+  {
+    mNLinks = 0;
+    for (int iPage = 0; iPage < int(mPages.size()); iPage++) {
+      auto& page = mPages[iPage];
+      int iLink = 0;
+      while (iLink < mNLinks && (mLinks[iLink].mLinkID != page.mLinkID || mLinks[iLink].mEP != page.mEP)) {
+        iLink++;
+      }
+      if (iLink == mNLinks) {
+        if (mNLinks == int(mLinks.size())) {
+          mLinks.emplace_back();
+        }
+        auto& link = mLinks[mNLinks++];
+        link.mLinkID = page.mLinkID;
+        link.mEP = page.mEP;
+        link.mIsTCM = LookupTable_t::Instance().isTCM(page.mLinkID, page.mEP);
+        link.mPages.clear();
+      }
+      mLinks[iLink].mPages.push_back(iPage);
+      page.mLink = iLink;
+    }
+  }
+  template <typename DataBlockType>
+  void decodeLink(LinkData& link, std::vector<DataBlockType>& vecDataBlocks)
+  {
+    vecDataBlocks.clear();
+    link.mBlockPage.clear();
+    for (auto iPage : link.mPages) {
+      RawReaderBase_t::decodeBlocks(mPages[iPage].mPayload, vecDataBlocks);
+      link.mBlockPage.resize(vecDataBlocks.size(), iPage);
+    }
+    for (int iBlock = 0; iBlock < int(vecDataBlocks.size()); iBlock++) {
+      const auto intRec = vecDataBlocks[iBlock].getInteractionRecord();
+      if (iBlock == 0 || intRec < link.mIRmin) {
+        link.mIRmin = intRec;
+      }
+      if (iBlock == 0 || link.mIRmax < intRec) {
+        link.mIRmax = intRec;
+      }
+    }
+    link.mBlockBC.resize(vecDataBlocks.size());
+  }
+  template <typename DataBlockType>
+  void countBlocks(LinkData& link, const std::vector<DataBlockType>& vecDataBlocks, const InteractionRecord& irMin)
+  {
+    for (int iBlock = 0; iBlock < int(vecDataBlocks.size()); iBlock++) {
+      const int bc = vecDataBlocks[iBlock].getInteractionRecord().differenceInBC(irMin);
+      link.mBlockBC[iBlock] = bc;
+#ifdef WITH_OPENMP
+#pragma omp atomic
+#endif
+      mBCTable[bc]++;
+    }
+  }
+  //the only shared state is BC table, counts and write positions are updated atomically
+  void fillDigits(const InteractionRecord& irMin, int nBC)
+  {
+    mBCTable.assign(nBC, 0);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+    for (int iLink = 0; iLink < mNLinks; iLink++) {
+      auto& link = mLinks[iLink];
+      if (link.mIsTCM) {
+        countBlocks(link, link.mBlocksTCM, irMin);
+      } else {
+        countBlocks(link, link.mBlocksPM, irMin);
+      }
+    }
+    //compaction: one digit per non-empty BC, BC table is converted to write positions in mBlockRefs
+    auto& mapDigits = RawReaderBase_t::mMapDigits;
+    mDigits.clear();
+    mDigitOffsets.clear();
+    int nRefs = 0;
+    for (int bc = 0; bc < nBC; bc++) {
+      const int nBlocks = mBCTable[bc];
+      if (nBlocks == 0) {
+        continue;
+      }
+      const auto intRec = irMin + bc;
+      auto digitIter = mapDigits.try_emplace(mapDigits.end(), intRec, intRec);
+      mDigits.push_back(&digitIter->second);
+      mDigitOffsets.push_back(nRefs);
+      mBCTable[bc] = nRefs;
+      nRefs += nBlocks;
+    }
+    mDigitOffsets.push_back(nRefs);
+    mBlockRefs.resize(nRefs);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+    for (int iLink = 0; iLink < mNLinks; iLink++) {
+      const auto& link = mLinks[iLink];
+      for (int iBlock = 0; iBlock < int(link.mBlockBC.size()); iBlock++) {
+        int pos;
+#ifdef WITH_OPENMP
+#pragma omp atomic capture
+#endif
+        pos = mBCTable[link.mBlockBC[iBlock]]++;
+        mBlockRefs[pos] = {link.mBlockPage[iBlock], iLink, iBlock};
+      }
+    }
+    //filling digits, data blocks of each digit are processed in stream order
+    const int nDigits = mDigits.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(mNThreads)
+#endif
+    for (int iDigit = 0; iDigit < nDigits; iDigit++) {
+      auto refBegin = mBlockRefs.begin() + mDigitOffsets[iDigit], refEnd = mBlockRefs.begin() + mDigitOffsets[iDigit + 1];
+      std::sort(refBegin, refEnd, [](const BlockRef& a, const BlockRef& b) { return a.mPage < b.mPage || (a.mPage == b.mPage && a.mBlock < b.mBlock); });
+      for (auto ref = refBegin; ref != refEnd; ++ref) {
+        processBlock(*mDigits[iDigit], mLinks[ref->mLink], ref->mBlock);
+      }
+    }
+  }
+  //fallback for TF with too large IR range, data blocks are processed in page order
+  void processPagesSequentially()
+  {
+    auto& mapDigits = RawReaderBase_t::mMapDigits;
+    std::vector<int> nextBlock(mNLinks, 0);
+    for (int iPage = 0; iPage < int(mPages.size()); iPage++) {
+      auto& link = mLinks[mPages[iPage].mLink];
+      auto& iBlock = nextBlock[mPages[iPage].mLink];
+      for (; iBlock < int(link.mBlockPage.size()) && link.mBlockPage[iBlock] == iPage; iBlock++) {
+        const auto intRec = link.mIsTCM ? link.mBlocksTCM[iBlock].getInteractionRecord() : link.mBlocksPM[iBlock].getInteractionRecord();
+        auto [digitIter, isNew] = mapDigits.try_emplace(intRec, intRec);
+        processBlock(digitIter->second, link, iBlock);
+      }
+    }
+  }
+  void processBlock(DigitBlockFIT_t& digit, LinkData& link, int iBlock)
+  {
+    if (link.mIsTCM) {
+      digit.template processDigits<DataBlockTCM_t>(link.mBlocksTCM[iBlock], link.mLinkID, link.mEP);
+    } else {
+      digit.template processDigits<DataBlockPM_t>(link.mBlocksPM[iBlock], link.mLinkID, link.mEP);
+    }
+  }
 };
 } // namespace fit
 } // namespace o2
@@ -43,7 +43,12 @@ class FITDataReaderDPLSpec : public Task
   ~FITDataReaderDPLSpec() override = default;
   typedef RawReaderType RawReader_t;
   RawReader_t mRawReader;
-  void init(InitContext& ic) final { RawReader_t::LookupTable_t::Instance().printFullMap(); }
+  void init(InitContext& ic) final
+  {
+    RawReader_t::LookupTable_t::Instance().printFullMap();
+    mRawReader.setNThreads(ic.options().get<int>("nthreads"));
+    LOG(INFO) << "Raw decoding with " << mRawReader.getNThreads() << " threads";
+  }
   void run(ProcessingContext& pc) final
   {
     // if we see requested data type input with 0xDEADBEEF subspec and 0 payload this means that the "delayed message"
@@ -68,9 +73,10 @@ class FITDataReaderDPLSpec : public Task
       count++;
       auto rdhPtr = it.get_if<o2::header::RAWDataHeader>();
       gsl::span<const uint8_t> payload(it.data(), it.size());
-      mRawReader.process(payload, int(rdhPtr->linkID), int(rdhPtr->endPointID));
+      mRawReader.addPage(payload, int(rdhPtr->linkID), int(rdhPtr->endPointID));
     }
     LOG(INFO) << "Pages: " << count;
+    mRawReader.processPages();
     mRawReader.accumulateDigits();
     mRawReader.makeSnapshot(pc);
     mRawReader.clear();
@@ -95,7 +101,7 @@ framework::DataProcessorSpec getFITDataReaderDPLSpec(const RawReaderType& rawRea
     inputSpec,
     outputSpec,
     adaptFromTask<FITDataReaderDPLSpec<RawReaderType>>(rawReader),
-    Options{}};
+    Options{{"nthreads", VariantType::Int, 1, {"Number of threads for raw decoding"}}}};
 }
 
 } // namespace fit
@@ -81,6 +81,8 @@ class MatchCosmics
   void setITSDict(std::unique_ptr<o2::itsmft::TopologyDictionary>& dict) { mITSDict = std::move(dict); }
   void process(const o2::globaltracking::RecoContainer& data);
   void setUseMC(bool mc) { mUseMC = mc; }
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
   void init();
   void end();
 
@@ -115,7 +117,8 @@ class MatchCosmics
 
  private:
   void updateTimeDependentParams();
-  RejFlag checkPair(int i, int j);
+  RejFlag checkPair(int i, int j, float& chi2) const;
+  void findCandidates();
   void registerMatch(int i, int j, float chi2);
   void suppressMatch(int partner0, int partner1);
   void createSeeds(const o2::globaltracking::RecoContainer& data);
@@ -125,6 +128,9 @@ class MatchCosmics
   std::vector<o2::BaseCluster<float>> prepareITSClusters(const o2::globaltracking::RecoContainer& data) const;
 
   std::vector<TrackSeed> mSeeds;
+  std::vector<int> mSortID;      ///< seeds sorted in time bracket lower edge
+  std::vector<int> mTglBuckets;  ///< 1st entry of every tgl bucket in mBucketSeeds
+  std::vector<int> mBucketSeeds; ///< positions in mSortID of the seeds of every tgl bucket, in increasing tmin
   std::vector<MatchRecord> mRecords;
   std::vector<int> mWinners;
   std::unique_ptr<o2::gpu::TPCFastTransform> mTPCTransform; ///< TPC cluster transformation
@@ -137,6 +143,7 @@ class MatchCosmics
   bool mUseMC = true;
   float mITSROFrameLengthMUS = 0.;
   float mQ2PtCutoff = 1e9;
+  int mNThreads = 1; ///< number of OpenMP threads, the propagation loops use 1 with TGeo material queries (see Propagator::MatCorrType)
   const MatchCosmicsParams* mMatchParams = nullptr;
 
   std::vector<o2d::TrackCosmics> mCosmicTracks;
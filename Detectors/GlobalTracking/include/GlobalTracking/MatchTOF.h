@@ -34,6 +34,7 @@
 #include "TOFBase/Geo.h"
 #include "DataFormatsTOF/Cluster.h"
 #include "GlobalTracking/MatchTPCITS.h"
+#include "GlobalTracking/TimeBinnedIndex.h"
 #include "DataFormatsTPC/TrackTPC.h"
 #include "ReconstructionDataFormats/PID.h"
 #include "TPCFastTransform.h"
@@ -157,6 +158,8 @@ class MatchTOF
   }
 
   void setFIT(bool value = true) { mIsFIT = value; }
+  ///< set the number of threads matching the sectors in parallel
+  void setNThreads(int n);
   int findFITIndex(int bc);
 
   void checkRefitter();
@@ -187,6 +190,7 @@ class MatchTOF
   //  void addITSTPCTRDSeed(const o2::track::TrackParCov& _tr, o2::dataformats::GlobalTrackID srcGID, int tpcID);
   bool prepareTOFClusters();
 
+  void addStripCandidates(int sec, const int* detId, int itof0, double maxTime, int tag, std::vector<std::pair<int, int>>& candidates) const;
   void doMatching(int sec);
   void doMatchingForTPC(int sec);
   void selectBestMatches();
@@ -269,9 +273,15 @@ class MatchTOF
   std::array<std::vector<int>, o2::constants::math::NSectors> mTracksSectIndexCache[trkType::SIZE];
   ///< per sector indices of TOF cluster entry in mTOFClusWork
   std::array<std::vector<int>, o2::constants::math::NSectors> mTOFClusSectIndexCache;
+  ///< per sector time index of the entries of mTOFClusSectIndexCache
+  std::array<TimeBinnedIndex, o2::constants::math::NSectors> mTOFClusSectTimeIndex;
+  ///< per sector and strip positions in mTOFClusSectIndexCache of the TOF clusters (ordered in time)
+  std::array<std::array<std::vector<int>, Geo::NSTRIPXSECTOR>, o2::constants::math::NSectors> mTOFClusSectStripIndexCache;
 
   ///<array of track-TOFCluster pairs from the matching
   std::vector<o2::dataformats::MatchInfoTOFReco> mMatchedTracksPairs;
+  ///<per sector arrays of track-TOFCluster pairs, filled in parallel by the matching
+  std::array<std::vector<o2::dataformats::MatchInfoTOFReco>, o2::constants::math::NSectors> mMatchedTracksPairsSec;
 
   ///<array of TOFChannel calibration info
   std::vector<o2::dataformats::CalibInfoTOF> mCalibInfoTOF;
@@ -292,8 +302,11 @@ class MatchTOF
   UInt_t mDBGFlags = 0;
   std::string mDebugTreeFileName = "dbg_matchTOF.root"; ///< name for the debug tree file
 
+  int mNThreads = 1; ///< number of OMP threads
+
   ///----------- aux stuff --------------///
-  static constexpr float MAXSNP = 0.85; // max snp of ITS or TPC track at xRef to be matched
+  static constexpr float MAXSNP = 0.85;     // max snp of ITS or TPC track at xRef to be matched
+  static constexpr int TimeIndexBinBC = 40; // width of TOF clusters time index bins, in BCs
 
   TStopwatch mTimerTot;
   TStopwatch mTimerDBG;
@@ -171,6 +171,16 @@ struct MatchRecord {
   }
 };
 
+///< matching candidate found in a single sector, registered in the MatchRecords once all sectors are processed
+struct MatchCandidate {
+  int iITS = MinusOne;      ///< entry in mITSWork
+  int iTPC = MinusOne;      ///< entry in mTPCWork
+  float chi2 = -1.f;        ///< matching chi2
+  int matchedIC = MinusOne; ///< index of eventually matched InteractionCandidate
+  MatchCandidate(int its, int tpc, float chi2match, int candIC) : iITS(its), iTPC(tpc), chi2(chi2match), matchedIC(candIC) {}
+  MatchCandidate() = default;
+};
+
 ///< Link of the AfterBurner track: update at sertain cluster
 ///< original track in the currently loaded TPC reco output
 struct ABTrackLink : public o2::track::TrackParCov {
@@ -409,6 +419,7 @@ class MatchTPCITS
   int prepareInteractionTimes();
   int prepareTPCTracksAfterBurner();
   void addTPCSeed(const o2::track::TrackParCov& _tr, float t0, float terr, o2::dataformats::GlobalTrackID srcGID, int tpcID);
+  void propagateTPCSeeds();
 
   int preselectChipClusters(std::vector<int>& clVecOut, const ClusRange& clRange, const ITSChipClustersRefs& itsChipClRefs,
                             float trackY, float trackZ, float tolerY, float tolerZ) const;
@@ -418,7 +429,7 @@ class MatchTPCITS
   void doMatching(int sec);
 
   void refitWinners();
-  bool refitTrackTPCITS(int iTPC, int& iITS);
+  bool refitTrackTPCITS(int iTPC, int& iITS, o2::dataformats::TrackTPCITS& trfit);
   bool refitTPCInward(o2::track::TrackParCov& trcIn, float& chi2, float xTgt, int trcID, float timeTB) const;
 
   void selectBestMatches();
@@ -613,6 +624,9 @@ class MatchTPCITS
   ///< per sector indices of ITS track entry in mITSWork
   std::array<std::vector<int>, o2::constants::math::NSectors> mITSSectIndexCache;
 
+  ///< per sector matching candidates, filled concurrently by doMatching and registered sequentially
+  std::array<std::vector<MatchCandidate>, o2::constants::math::NSectors> mSectMatchCandidates;
+
   ///< indices of 1st TPC tracks with time above the ITS ROF time
   std::array<std::vector<int>, o2::constants::math::NSectors> mTPCTimeStart;
   ///< indices of 1st entries of ITS tracks starting at given ROframe
@@ -0,0 +1,99 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TimeBinnedIndex.h
+/// \brief Index of time-ordered entries in uniform time bins, for fast candidates pre-selection in the matchers
+
+#ifndef ALICEO2_GLOBTRACKING_TIMEBINNEDINDEX_H
+#define ALICEO2_GLOBTRACKING_TIMEBINNEDINDEX_H
+
+#include <vector>
+
+namespace o2
+{
+namespace globaltracking
+{
+
+///< For a set of entries (e.g. per sector cache of clusters or tracks indices) sorted in time, provides the
+///< 1st entry with time above the requested one w/o scanning all preceding entries.
+///< The times are not stored but provided by the getter getTime(i) of the i-th entry, which must be non-decreasing.
+class TimeBinnedIndex
+{
+ public:
+  static constexpr int MaxBinsPerEntry = 4; ///< the bin width is increased if needed to not exceed this number of bins per entry
+
+  ///< build index for nEntries entries with bins of binWidth (in the units of the entries time)
+  template <typename F>
+  void build(int nEntries, double binWidth, F&& getTime)
+  {
+    mBinStart.clear();
+    mNEntries = nEntries;
+    if (!nEntries || binWidth <= 0.) {
+      return;
+    }
+    mTMin = getTime(0);
+    double range = getTime(nEntries - 1) - mTMin;
+    double maxBins = double(MaxBinsPerEntry) * nEntries;
+    mBinWidthInv = range > binWidth * maxBins ? maxBins / range : 1. / binWidth;
+    int nBins = getBin(getTime(nEntries - 1)) + 1;
+    mBinStart.resize(nBins);
+    int entry = 0;
+    for (int ib = 0; ib < nBins; ib++) {
+      while (entry < nEntries && getBin(getTime(entry)) < ib) {
+        entry++;
+      }
+      mBinStart[ib] = entry;
+    }
+  }
+
+  ///< get 1st entry with time >= t, or number of entries if there is no such entry
+  template <typename F>
+  int getFirstEntry(double t, F&& getTime) const
+  {
+    int entry = 0;
+    if (!mBinStart.empty()) {
+      if (t <= mTMin) {
+        return 0;
+      }
+      double bin = (t - mTMin) * mBinWidthInv;
+      if (bin >= mBinStart.size()) {
+        return mNEntries;
+      }
+      entry = mBinStart[int(bin)];
+    }
+    while (entry < mNEntries && getTime(entry) < t) {
+      entry++;
+    }
+    return entry;
+  }
+
+  int getNEntries() const { return mNEntries; }
+  int getNBins() const { return mBinStart.size(); }
+
+  void clear()
+  {
+    mBinStart.clear();
+    mNEntries = 0;
+  }
+
+ private:
+  int getBin(double t) const { return (t - mTMin) * mBinWidthInv; }
+
+  std::vector<int> mBinStart; ///< 1st entry in every time bin
+  double mTMin = 0.;          ///< time of the 1st entry
+  double mBinWidthInv = 1.;   ///< inverse bin width
+  int mNEntries = 0;          ///< number of indexed entries
+};
+
+} // namespace globaltracking
+} // namespace o2
+
+#endif
@@ -34,6 +34,10 @@
 #include <algorithm>
 #include <numeric>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::globaltracking;
 
 using GTrackID = o2d::GlobalTrackID;
@@ -52,7 +56,11 @@ void MatchCosmics::process(const o2::globaltracking::RecoContainer& data)
   int ntr = mSeeds.size();
 
   // propagate to DCA to origin
+  int nThreadsProp = mMatchParams->matCorr == MatCorrType::USEMatCorrTGeo ? 1 : mNThreads;
   const o2::math_utils::Point3D<float> v{0., 0., 0};
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(nThreadsProp)
+#endif
   for (int i = 0; i < ntr; i++) {
     auto& trc = mSeeds[i];
     if (!o2::base::Propagator::Instance()->propagateToDCABxByBz(v, trc, mMatchParams->maxStep, mMatchParams->matCorr)) {
@@ -61,29 +69,114 @@ void MatchCosmics::process(const o2::globaltracking::RecoContainer& data)
   }
 
   // sort in time bracket lower edge
-  std::vector<int> sortID(ntr);
-  std::iota(sortID.begin(), sortID.end(), 0);
-  std::sort(sortID.begin(), sortID.end(), [this](int a, int b) { return mSeeds[a].tBracket.getMin() < mSeeds[b].tBracket.getMin(); });
-
-  for (int i = 0; i < ntr; i++) {
-    for (int j = i + 1; j < ntr; j++) {
-      if (checkPair(sortID[i], sortID[j]) == RejTime) {
-        break;
-      }
-    }
-  }
+  mSortID.resize(ntr);
+  std::iota(mSortID.begin(), mSortID.end(), 0);
+  std::sort(mSortID.begin(), mSortID.end(), [this](int a, int b) { return mSeeds[a].tBracket.getMin() < mSeeds[b].tBracket.getMin(); });
 
+  findCandidates();
   selectWinners();
   refitWinners(data);
 
   mTFCount++;
 }
 
+//________________________________________________________
+void MatchCosmics::findCandidates()
+{
+  // The legs of a cosmic track have opposite tgl: the seeds are indexed in buckets of tgl of the width of the max. tgl difference
+  // allowed by the crude cut, so that for every seed only the 2-3 buckets compatible with its -tgl are checked, each in increasing tmin.
+  // The pairs are checked concurrently and the accepted ones are registered in the order of the sequential search.
+  int ntr = mSortID.size();
+  float maxSigma2Tgl = 0.f, maxAbsTgl = 0.f;
+  for (const auto& seed : mSeeds) {
+    if (seed.matchID != Reject) {
+      maxSigma2Tgl = std::max(maxSigma2Tgl, seed.getSigmaTgl2());
+      maxAbsTgl = std::max(maxAbsTgl, std::abs(seed.getTgl()));
+    }
+  }
+  float tolTgl = 1.01f * std::sqrt((mMatchParams->systSigma2[o2::track::kTgl] + 2.f * maxSigma2Tgl) * mMatchParams->crudeNSigma2Cut[o2::track::kTgl]); // with margin for the rounding
+  float bucketWidth = std::max(tolTgl, 1e-3f);
+  int nBuckets = int(2.f * maxAbsTgl / bucketWidth) + 1;
+  auto getBucket = [maxAbsTgl, bucketWidth, nBuckets](float tgl) { return std::clamp(int((tgl + maxAbsTgl) / bucketWidth), 0, nBuckets - 1); };
+
+  mTglBuckets.clear();
+  mTglBuckets.resize(nBuckets + 1, 0);
+  for (int i = 0; i < ntr; i++) {
+    const auto& seed = mSeeds[mSortID[i]];
+    if (seed.matchID != Reject) {
+      mTglBuckets[getBucket(seed.getTgl()) + 1]++;
+    }
+  }
+  for (int ib = 0; ib < nBuckets; ib++) {
+    mTglBuckets[ib + 1] += mTglBuckets[ib];
+  }
+  mBucketSeeds.resize(mTglBuckets[nBuckets]);
+  std::vector<int> fillPos(mTglBuckets.begin(), mTglBuckets.end() - 1);
+  for (int i = 0; i < ntr; i++) {
+    const auto& seed = mSeeds[mSortID[i]];
+    if (seed.matchID != Reject) {
+      mBucketSeeds[fillPos[getBucket(seed.getTgl())]++] = i;
+    }
+  }
+
+  struct Candidate {
+    int pos0 = 0;     ///< position of 1st partner in mSortID
+    int pos1 = 0;     ///< position of 2nd partner in mSortID
+    float chi2 = 0.f; ///< matching chi2
+  };
+  // every thread collects the candidates of its own first partners, merged and sorted below independently of the threads
+  int nThreadsMatch = mMatchParams->matCorr == MatCorrType::USEMatCorrTGeo ? 1 : mNThreads;
+#ifdef _ALLOW_DEBUG_TREES_COSM
+  if (mDBGOut) { // the debug tree is filled by the pair checks
+    nThreadsMatch = 1;
+  }
+#endif
+  std::vector<std::vector<Candidate>> candidates(nThreadsMatch);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(nThreadsMatch)
+#endif
+  for (int i = 0; i < ntr; i++) {
+    const auto& seed0 = mSeeds[mSortID[i]];
+    if (seed0.matchID == Reject) {
+      continue;
+    }
+#ifdef WITH_OPENMP
+    int tid = omp_get_thread_num();
+#else
+    int tid = 0;
+#endif
+    int bMin = getBucket(-seed0.getTgl() - tolTgl), bMax = getBucket(-seed0.getTgl() + tolTgl);
+    for (int ib = bMin; ib <= bMax; ib++) {
+      auto last = mBucketSeeds.begin() + mTglBuckets[ib + 1];
+      for (auto it = std::upper_bound(mBucketSeeds.begin() + mTglBuckets[ib], last, i); it != last; ++it) { // seeds following seed0 in tmin
+        float chi2 = 0.f;
+        auto rej = checkPair(mSortID[i], mSortID[*it], chi2);
+        if (rej == RejTime) {
+          break;
+        }
+        if (rej == Accept) {
+          candidates[tid].push_back(Candidate{i, *it, chi2});
+        }
+      }
+    }
+  }
+  for (int tid = 1; tid < nThreadsMatch; tid++) {
+    candidates[0].insert(candidates[0].end(), candidates[tid].begin(), candidates[tid].end());
+  }
+  auto& accepted = candidates[0];
+  std::sort(accepted.begin(), accepted.end(), [](const Candidate& a, const Candidate& b) { return a.pos0 < b.pos0 || (a.pos0 == b.pos0 && a.pos1 < b.pos1); });
+  for (const auto& cand : accepted) {
+    int id0 = mSortID[cand.pos0], id1 = mSortID[cand.pos1];
+    registerMatch(id0, id1, cand.chi2);
+    registerMatch(id1, id0, cand.chi2); // the reverse reference can be also done in a separate loop
+  }
+  LOG(INFO) << "Registered " << accepted.size() << " match candidates from " << ntr << " seeds in " << nBuckets << " tgl buckets";
+}
+
 //________________________________________________________
 void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
 {
   LOG(INFO) << "Refitting " << mWinners.size() << " winner matches";
-  int count = 0;
   auto tpcTBinMUSInv = 1. / mTPCTBinMUS;
   if (!mTPCTransform) { // eventually, should be updated at every TF?
     mTPCTransform = o2::tpc::TPCFastTransformHelperO2::instance()->create(0);
@@ -140,7 +233,16 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
     return nclRefit == ncl ? ncl : -1;
   };
 
-  for (auto winRID : mWinners) {
+  // winners are refitted concurrently into dedicated slots, then stored in the order of the winners
+  int nWinners = mWinners.size();
+  std::vector<o2d::TrackCosmics> refitted(nWinners);
+  std::vector<int> refittedNClBtm(nWinners, MinusOne); // number of clusters of the bottom leg of every refitted winner, MinusOne if the refit failed
+  int nThreadsRefit = mMatchParams->matCorr == MatCorrType::USEMatCorrTGeo ? 1 : mNThreads;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreadsRefit)
+#endif
+  for (int iw = 0; iw < nWinners; iw++) {
+    int winRID = mWinners[iw];
     const auto& rec = mRecords[winRID];
     int poolEntryID[2] = {rec.id0, rec.id1};
     const o2::track::TrackParCov outerLegs[2] = {data.getTrackParamOut(mSeeds[rec.id0].origID), data.getTrackParamOut(mSeeds[rec.id1].origID)};
@@ -153,7 +255,7 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
       btm = 1;
       top = 0;
     }
-    LOG(DEBUG) << "Winner " << count++ << " Record " << winRID << " Partners:"
+    LOG(DEBUG) << "Winner " << iw << " Record " << winRID << " Partners:"
                << " B: " << mSeeds[poolEntryID[btm]].origID << "/" << mSeeds[poolEntryID[btm]].origID.getSourceName()
                << " U: " << mSeeds[poolEntryID[top]].origID << "/" << mSeeds[poolEntryID[top]].origID.getSourceName()
                << " | T:" << tOverlap.asString();
@@ -263,10 +365,19 @@ void MatchCosmics::refitWinners(const o2::globaltracking::RecoContainer& data)
       continue;
     }
     // create final track
-    mCosmicTracks.emplace_back(mSeeds[poolEntryID[btm]].origID, mSeeds[poolEntryID[top]].origID, trCosmBtm, trCosmTop, chi2, chi2Match, nclTot, t0, dt);
+    refitted[iw] = o2d::TrackCosmics(mSeeds[poolEntryID[btm]].origID, mSeeds[poolEntryID[top]].origID, trCosmBtm, trCosmTop, chi2, chi2Match, nclTot, t0, dt);
+    refittedNClBtm[iw] = nclBtm;
+  }
+  mCosmicTracks.reserve(nWinners);
+  for (int iw = 0; iw < nWinners; iw++) {
+    int nclBtm = refittedNClBtm[iw];
+    if (nclBtm == MinusOne) {
+      continue;
+    }
+    const auto& trc = mCosmicTracks.emplace_back(refitted[iw]);
     if (mUseMC) {
-      o2::MCCompLabel lbl[2] = {data.getTrackMCLabel(mSeeds[poolEntryID[btm]].origID), data.getTrackMCLabel(mSeeds[poolEntryID[top]].origID)};
-      auto& tlb = mCosmicTracksLbl.emplace_back((nclBtm > nclTot - nclBtm ? lbl[0] : lbl[1]));
+      o2::MCCompLabel lbl[2] = {data.getTrackMCLabel(trc.getRefBottom()), data.getTrackMCLabel(trc.getRefTop())};
+      auto& tlb = mCosmicTracksLbl.emplace_back((nclBtm > trc.getNClusters() - nclBtm ? lbl[0] : lbl[1]));
       tlb.setFakeFlag(lbl[0] != lbl[1]);
     }
   }
@@ -356,12 +467,12 @@ void MatchCosmics::suppressMatch(int partner0, int partner1)
 }
 
 //________________________________________________________
-MatchCosmics::RejFlag MatchCosmics::checkPair(int i, int j)
+MatchCosmics::RejFlag MatchCosmics::checkPair(int i, int j, float& chi2) const
 {
-  // if validated with given chi2, register match
+  // check the compatibility of the pair, if validated the matching chi2 is returned in chi2
   RejFlag rej = RejOther;
-  auto& seed0 = mSeeds[i];
-  auto& seed1 = mSeeds[j];
+  const auto& seed0 = mSeeds[i];
+  const auto& seed1 = mSeeds[j];
   if (seed0.matchID == Reject) {
     return rej;
   }
@@ -377,7 +488,7 @@ MatchCosmics::RejFlag MatchCosmics::checkPair(int i, int j)
   if (seed1.tBracket > seed0.tBracket) {
     return (rej = RejTime); // since the brackets are sorted in tmin, all following tbj will also exceed tbi
   }
-  float chi2 = 1.e9f;
+  chi2 = 1.e9f;
 
   // check
   // 1) crude check on tgl and q/pt (if B!=0). Note: back-to-back tracks will have mutually params (see TrackPar::invertParam)
@@ -436,9 +547,7 @@ MatchCosmics::RejFlag MatchCosmics::checkPair(int i, int j)
       break;
     }
     rej = Accept;
-    registerMatch(i, j, chi2);
-    registerMatch(j, i, chi2); // the reverse reference can be also done in a separate loop
-    LOG(DEBUG) << "Chi2 = " << chi2 << " NMatches " << mRecords.size();
+    LOG(DEBUG) << "Chi2 = " << chi2;
     break;
   }
 
@@ -556,6 +665,17 @@ std::vector<o2::BaseCluster<float>> MatchCosmics::prepareITSClusters(const o2::g
   return std::move(itscl);
 }
 
+//______________________________________________
+void MatchCosmics::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  LOG(WARNING) << "Multithreading is not supported, imposing single thread";
+  mNThreads = 1;
+#endif
+}
+
 //______________________________________________
 void MatchCosmics::end()
 {
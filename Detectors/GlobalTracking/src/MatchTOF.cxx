@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 #include <TTree.h>
 #include <cassert>
+#include <algorithm>
 
 #include "FairLogger.h"
 #include "Field/MagneticField.h"
@@ -37,6 +38,10 @@
 
 #include "GlobalTracking/MatchTOF.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 #include "TPCBase/ParameterGas.h"
 #include "TPCBase/ParameterElectronics.h"
 #include "TPCReconstruction/TPCFastTransformHelperO2.h"
@@ -85,8 +90,13 @@ void MatchTOF::run(const o2::globaltracking::RecoContainer& inp)
   LOGF(INFO, "Timing prepare tracks: Cpu: %.3e s Real: %.3e s in %d slots", mTimerTot.CpuTime(), mTimerTot.RealTime(), mTimerTot.Counter() - 1);
   mTimerTot.Start();
 
-  for (int sec = o2::constants::math::NSectors; sec--;) {
-    mMatchedTracksPairs.clear(); // new sector
+  // the sectors are matched independently (each track is cached in a single sector), possibly in parallel
+  Geo::Init(); // make sure the lazy initialization of the TOF geometry does not happen in the parallel region
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int sec = 0; sec < o2::constants::math::NSectors; sec++) {
+    mMatchedTracksPairsSec[sec].clear(); // new sector
     LOG(INFO) << "Doing matching for sector " << sec << "...";
     if (mIsITSTPCused || mIsTPCTRDused || mIsITSTPCTRDused) {
       doMatching(sec);
@@ -94,7 +104,13 @@ void MatchTOF::run(const o2::globaltracking::RecoContainer& inp)
     if (mIsTPCused) {
       doMatchingForTPC(sec);
     }
-    LOG(INFO) << "...done. Now check the best matches";
+  }
+
+  // the selection of the best matches is done sector by sector, in the same order as before
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    LOG(INFO) << "Checking the best matches for sector " << sec;
+    mMatchedTracksPairs.swap(mMatchedTracksPairsSec[sec]);
+    mMatchedTracksPairsSec[sec].clear();
     selectBestMatches();
   }
 
@@ -384,6 +400,26 @@ bool MatchTOF::prepareTOFClusters()
     });
   } // loop over TOF clusters of single sector
 
+  // index the time-ordered clusters of each sector in bins of BC groups
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    const auto& indexCache = mTOFClusSectIndexCache[sec];
+    mTOFClusSectTimeIndex[sec].build(indexCache.size(), Geo::BC_TIME_INPS * TimeIndexBinBC, [this, &indexCache](int i) { return mTOFClusWork[indexCache[i]].getTime(); });
+  }
+
+  // bucket the time-ordered clusters of each sector by strip
+  int indices[5];
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    const auto& indexCache = mTOFClusSectIndexCache[sec];
+    auto& stripCache = mTOFClusSectStripIndexCache[sec];
+    for (auto& clusters : stripCache) {
+      clusters.clear();
+    }
+    for (int itof = 0; itof < indexCache.size(); itof++) {
+      Geo::getVolumeIndices(mTOFClusWork[indexCache[itof]].getMainContributingChannel(), indices);
+      stripCache[Geo::getStripNumberPerSM(indices[1], indices[2])].push_back(itof);
+    }
+  }
+
   if (mMatchedClustersIndex) {
     delete[] mMatchedClustersIndex;
   }
@@ -393,6 +429,27 @@ bool MatchTOF::prepareTOFClusters()
   return true;
 }
 //______________________________________________
+void MatchTOF::addStripCandidates(int sec, const int* detId, int itof0, double maxTime, int tag, std::vector<std::pair<int, int>>& candidates) const
+{
+  ///< add to the candidates the TOF clusters of the sector sec, not before itof0 and not later than maxTime,
+  ///< belonging to the strip detId (as filled by Geo::getPadDxDyDz)
+  if (detId[0] != sec || detId[1] < 0 || detId[2] < 0) {
+    return;
+  }
+  int strip = Geo::getStripNumberPerSM(detId[1], detId[2]);
+  if (strip < 0) {
+    return;
+  }
+  const auto& cacheTOF = mTOFClusSectIndexCache[sec];
+  const auto& stripCache = mTOFClusSectStripIndexCache[sec][strip];
+  for (auto it = std::lower_bound(stripCache.begin(), stripCache.end(), itof0); it != stripCache.end(); ++it) {
+    if (mTOFClusWork[cacheTOF[*it]].getTime() > maxTime) { // no more TOF clusters can be matched to this track
+      break;
+    }
+    candidates.emplace_back(*it, tag);
+  }
+}
+//______________________________________________
 void MatchTOF::doMatching(int sec)
 {
   trkType type = trkType::CONSTR;
@@ -405,6 +462,10 @@ void MatchTOF::doMatching(int sec)
   if (!nTracks || !nTOFCls) {
     return;
   }
+  auto& matchedTracksPairs = mMatchedTracksPairsSec[sec]; // track-TOF cluster pairs found in this sector
+  const auto& timeIndexTOF = mTOFClusSectTimeIndex[sec];
+  auto getTOFTime = [this, &cacheTOF](int i) { return mTOFClusWork[cacheTOF[i]].getTime(); };
+  std::vector<std::pair<int, int>> stripCandidates; // (TOF cluster index in cacheTOF, propagation step) pairs to be checked
   int itof0 = 0;                          // starting index in TOF clusters for matching of the track
   int detId[2][5];                        // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the TOF det index
   float deltaPos[2][3];                   // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the residuals
@@ -541,21 +602,19 @@ void MatchTOF::doMatching(int sec)
     if (nStripsCrossedInPropagation == 0) {
       continue; // the track never hit a TOF strip during the propagation
     }
+    // for the next tracks that we will check, we will ignore the clusters with a time too small for this one
+    itof0 = std::max(itof0, timeIndexTOF.getFirstEntry(minTrkTime, getTOFTime));
+
+    // only the clusters of the crossed strips can match, look for them in time order
+    stripCandidates.clear();
+    for (int iPropagation = 0; iPropagation < nStripsCrossedInPropagation; iPropagation++) {
+      addStripCandidates(sec, detId[iPropagation], itof0, maxTrkTime, iPropagation, stripCandidates);
+    }
+    std::sort(stripCandidates.begin(), stripCandidates.end());
+
     bool foundCluster = false;
-    for (auto itof = itof0; itof < nTOFCls; itof++) {
-      //      printf("itof = %d\n", itof);
+    for (const auto& [itof, iPropagation] : stripCandidates) {
       auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
-      // compare the times of the track and the TOF clusters - remember that they both are ordered in time!
-      //Printf("trefTOF.getTime() = %f, maxTrkTime = %f, minTrkTime = %f", trefTOF.getTime(), maxTrkTime, minTrkTime);
-
-      if (trefTOF.getTime() < minTrkTime) { // this cluster has a time that is too small for the current track, we will get to the next one
-        //Printf("In trefTOF.getTime() < minTrkTime");
-        itof0 = itof + 1; // but for the next track that we will check, we will ignore this cluster (the time is anyway too small)
-        continue;
-      }
-      if (trefTOF.getTime() > maxTrkTime) { // no more TOF clusters can be matched to this track
-        break;
-      }
 
       int mainChannel = trefTOF.getMainContributingChannel();
       int indices[5];
@@ -598,36 +657,23 @@ void MatchTOF::doMatching(int sec)
         posCorr[2] *= ndifInv;
       }
 
-      int trackIdTOF;
-      int eventIdTOF;
-      int sourceIdTOF;
-      for (auto iPropagation = 0; iPropagation < nStripsCrossedInPropagation; iPropagation++) {
-        LOG(DEBUG) << "TOF Cluster [" << itof << ", " << cacheTOF[itof] << "]:      indices   = " << indices[0] << ", " << indices[1] << ", " << indices[2] << ", " << indices[3] << ", " << indices[4];
-        LOG(DEBUG) << "Propagated Track [" << itrk << ", " << cacheTrk[itrk] << "]: detId[" << iPropagation << "]  = " << detId[iPropagation][0] << ", " << detId[iPropagation][1] << ", " << detId[iPropagation][2] << ", " << detId[iPropagation][3] << ", " << detId[iPropagation][4];
-        float resX = deltaPos[iPropagation][0] - (indices[4] - detId[iPropagation][4]) * Geo::XPAD + posCorr[0]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
-        float resZ = deltaPos[iPropagation][2] - (indices[3] - detId[iPropagation][3]) * Geo::ZPAD + posCorr[2]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
-        float res = TMath::Sqrt(resX * resX + resZ * resZ);
-
-        LOG(DEBUG) << "resX = " << resX << ", resZ = " << resZ << ", res = " << res;
-        if (indices[0] != detId[iPropagation][0]) {
-          continue;
-        }
-        if (indices[1] != detId[iPropagation][1]) {
-          continue;
-        }
-        if (indices[2] != detId[iPropagation][2]) {
-          continue;
-        }
-        float chi2 = res; // TODO: take into account also the time!
-
-        if (res < mSpaceTolerance) { // matching ok!
-          LOG(DEBUG) << "MATCHING FOUND: We have a match! between track " << mTracksSectIndexCache[type][indices[0]][itrk] << " and TOF cluster " << mTOFClusSectIndexCache[indices[0]][itof];
-          foundCluster = true;
-          // set event indexes (to be checked)
-          evIdx eventIndexTOFCluster(trefTOF.getEntryInTree(), mTOFClusSectIndexCache[indices[0]][itof]);
-          evGIdx eventIndexTracks(mCurrTracksTreeEntry, {uint32_t(mTracksSectIndexCache[type][indices[0]][itrk]), o2::dataformats::GlobalTrackID::ITSTPC});
-          mMatchedTracksPairs.emplace_back(eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[iPropagation], eventIndexTracks, type); // TODO: check if this is correct!
-        }
+      // the cluster is in the strip crossed at this propagation step (same sector, plate and strip)
+      LOG(DEBUG) << "TOF Cluster [" << itof << ", " << cacheTOF[itof] << "]:      indices   = " << indices[0] << ", " << indices[1] << ", " << indices[2] << ", " << indices[3] << ", " << indices[4];
+      LOG(DEBUG) << "Propagated Track [" << itrk << ", " << cacheTrk[itrk] << "]: detId[" << iPropagation << "]  = " << detId[iPropagation][0] << ", " << detId[iPropagation][1] << ", " << detId[iPropagation][2] << ", " << detId[iPropagation][3] << ", " << detId[iPropagation][4];
+      float resX = deltaPos[iPropagation][0] - (indices[4] - detId[iPropagation][4]) * Geo::XPAD + posCorr[0]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
+      float resZ = deltaPos[iPropagation][2] - (indices[3] - detId[iPropagation][3]) * Geo::ZPAD + posCorr[2]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
+      float res = TMath::Sqrt(resX * resX + resZ * resZ);
+
+      LOG(DEBUG) << "resX = " << resX << ", resZ = " << resZ << ", res = " << res;
+      float chi2 = res; // TODO: take into account also the time!
+
+      if (res < mSpaceTolerance) { // matching ok!
+        LOG(DEBUG) << "MATCHING FOUND: We have a match! between track " << mTracksSectIndexCache[type][indices[0]][itrk] << " and TOF cluster " << mTOFClusSectIndexCache[indices[0]][itof];
+        foundCluster = true;
+        // set event indexes (to be checked)
+        evIdx eventIndexTOFCluster(trefTOF.getEntryInTree(), mTOFClusSectIndexCache[indices[0]][itof]);
+        evGIdx eventIndexTracks(mCurrTracksTreeEntry, {uint32_t(mTracksSectIndexCache[type][indices[0]][itrk]), o2::dataformats::GlobalTrackID::ITSTPC});
+        matchedTracksPairs.emplace_back(eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[iPropagation], eventIndexTracks, type); // TODO: check if this is correct!
       }
     }
   }
@@ -653,7 +699,11 @@ void MatchTOF::doMatchingForTPC(int sec)
   if (!nTracks || !nTOFCls) {
     return;
   }
-  int itof0 = 0; // starting index in TOF clusters for matching of the track
+  auto& matchedTracksPairs = mMatchedTracksPairsSec[sec]; // track-TOF cluster pairs found in this sector
+  std::vector<std::pair<int, int>> stripCandidates;       // (TOF cluster index in cacheTOF, propagation step) pairs to be checked
+  int itof0 = 0;                                          // starting index in TOF clusters for matching of the track
+  const auto& timeIndexTOF = mTOFClusSectTimeIndex[sec];
+  auto getTOFTime = [this, &cacheTOF](int i) { return mTOFClusWork[cacheTOF[i]].getTime(); };
   float deltaPosTemp[3];
   std::array<float, 3> pos;
   std::array<float, 3> posBeforeProp;
@@ -681,10 +731,10 @@ void MatchTOF::doMatchingForTPC(int sec)
 
     int side = mSideTPC[cacheTrk[itrk]];
     // look at BC candidates for the track
-    itof0 = 0;
     double minTrkTime = (trackWork.second.getTimeStamp() - trackWork.second.getTimeStampError()) * 1.E6; // minimum time in ps
     minTrkTime = int(minTrkTime / BCgranularity) * BCgranularity;                                        // align min to a BC
     double maxTrkTime = (trackWork.second.getTimeStamp() + mExtraTPCFwdTime[cacheTrk[itrk]]) * 1.E6;     // maximum time in ps
+    itof0 = timeIndexTOF.getFirstEntry(minTrkTime, getTOFTime);                                          // 1st TOF cluster not earlier than the track
 
     if (mIsCosmics) {
       for (double tBC = minTrkTime; tBC < maxTrkTime; tBC += BCgranularity) {
@@ -849,19 +899,17 @@ void MatchTOF::doMatchingForTPC(int sec)
       }
 
       bool foundCluster = false;
-      itof0 = 0;
-      for (auto itof = itof0; itof < nTOFCls; itof++) {
-        //      printf("itof = %d\n", itof);
-        auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
-        // compare the times of the track and the TOF clusters - remember that they both are ordered in time!
+      itof0 = timeIndexTOF.getFirstEntry(minTime, getTOFTime);
 
-        if (trefTOF.getTime() < minTime) { // this cluster has a time that is too small for the current track, we will get to the next one
-          itof0 = itof + 1;                // but for the next track that we will check, we will ignore this cluster (the time is anyway too small)
-          continue;
-        }
-        if (trefTOF.getTime() > maxTime) { // no more TOF clusters can be matched to this track
-          break;
-        }
+      // only the clusters of the crossed strips can match, look for them in time order
+      stripCandidates.clear();
+      for (int iPropagation = 0; iPropagation < nStripsCrossedInPropagation[ibc]; iPropagation++) {
+        addStripCandidates(sec, detId[ibc][iPropagation].data(), itof0, maxTime, iPropagation, stripCandidates);
+      }
+      std::sort(stripCandidates.begin(), stripCandidates.end());
+
+      for (const auto& [itof, iPropagation] : stripCandidates) {
+        auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
         unsigned long bcClus = trefTOF.getTime() * Geo::BC_TIME_INPS_INV;
 
         int mainChannel = trefTOF.getMainContributingChannel();
@@ -905,42 +953,28 @@ void MatchTOF::doMatchingForTPC(int sec)
           posCorr[2] *= ndifInv;
         }
 
-        int trackIdTOF;
-        int eventIdTOF;
-        int sourceIdTOF;
-        for (auto iPropagation = 0; iPropagation < nStripsCrossedInPropagation[ibc]; iPropagation++) {
-          LOG(DEBUG) << "TOF Cluster [" << itof << ", " << cacheTOF[itof] << "]:      indices   = " << indices[0] << ", " << indices[1] << ", " << indices[2] << ", " << indices[3] << ", " << indices[4];
-          LOG(DEBUG) << "Propagated Track [" << itrk << ", " << cacheTrk[itrk] << "]: detId[" << iPropagation << "]  = " << detId[ibc][iPropagation][0] << ", " << detId[ibc][iPropagation][1] << ", " << detId[ibc][iPropagation][2] << ", " << detId[ibc][iPropagation][3] << ", " << detId[ibc][iPropagation][4];
-          float resX = deltaPos[ibc][iPropagation][0] - (indices[4] - detId[ibc][iPropagation][4]) * Geo::XPAD + posCorr[0]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
-          float resZ = deltaPos[ibc][iPropagation][2] - (indices[3] - detId[ibc][iPropagation][3]) * Geo::ZPAD + posCorr[2]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
-          if (BCcand[ibc] > bcClus) {
-            resZ += (BCcand[ibc] - bcClus) * vdriftInBC * side; // add bc correction
-          } else {
-            resZ -= (bcClus - BCcand[ibc]) * vdriftInBC * side;
-          }
-          float res = TMath::Sqrt(resX * resX + resZ * resZ);
-
-          if (indices[0] != detId[ibc][iPropagation][0]) {
-            continue;
-          }
-          if (indices[1] != detId[ibc][iPropagation][1]) {
-            continue;
-          }
-          if (indices[2] != detId[ibc][iPropagation][2]) {
-            continue;
-          }
+        // the cluster is in the strip crossed at this propagation step (same sector, plate and strip)
+        LOG(DEBUG) << "TOF Cluster [" << itof << ", " << cacheTOF[itof] << "]:      indices   = " << indices[0] << ", " << indices[1] << ", " << indices[2] << ", " << indices[3] << ", " << indices[4];
+        LOG(DEBUG) << "Propagated Track [" << itrk << ", " << cacheTrk[itrk] << "]: detId[" << iPropagation << "]  = " << detId[ibc][iPropagation][0] << ", " << detId[ibc][iPropagation][1] << ", " << detId[ibc][iPropagation][2] << ", " << detId[ibc][iPropagation][3] << ", " << detId[ibc][iPropagation][4];
+        float resX = deltaPos[ibc][iPropagation][0] - (indices[4] - detId[ibc][iPropagation][4]) * Geo::XPAD + posCorr[0]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
+        float resZ = deltaPos[ibc][iPropagation][2] - (indices[3] - detId[ibc][iPropagation][3]) * Geo::ZPAD + posCorr[2]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
+        if (BCcand[ibc] > bcClus) {
+          resZ += (BCcand[ibc] - bcClus) * vdriftInBC * side; // add bc correction
+        } else {
+          resZ -= (bcClus - BCcand[ibc]) * vdriftInBC * side;
+        }
+        float res = TMath::Sqrt(resX * resX + resZ * resZ);
 
-          LOG(DEBUG) << "resX = " << resX << ", resZ = " << resZ << ", res = " << res;
-          float chi2 = mIsCosmics ? resX : res; // TODO: take into account also the time!
+        LOG(DEBUG) << "resX = " << resX << ", resZ = " << resZ << ", res = " << res;
+        float chi2 = mIsCosmics ? resX : res; // TODO: take into account also the time!
 
-          if (res < mSpaceTolerance) { // matching ok!
-            LOG(DEBUG) << "MATCHING FOUND: We have a match! between track " << mTracksSectIndexCache[trkType::UNCONS][indices[0]][itrk] << " and TOF cluster " << mTOFClusSectIndexCache[indices[0]][itof];
-            foundCluster = true;
-            // set event indexes (to be checked)
-            evIdx eventIndexTOFCluster(trefTOF.getEntryInTree(), mTOFClusSectIndexCache[indices[0]][itof]);
-            evGIdx eventIndexTracks(mCurrTracksTreeEntry, {uint32_t(mTracksSectIndexCache[trkType::UNCONS][indices[0]][itrk]), o2::dataformats::GlobalTrackID::TPC});
-            mMatchedTracksPairs.emplace_back(eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[ibc][iPropagation], eventIndexTracks, trkType::UNCONS, resZ / vdrift * side, trefTOF.getZ()); // TODO: check if this is correct!
-          }
+        if (res < mSpaceTolerance) { // matching ok!
+          LOG(DEBUG) << "MATCHING FOUND: We have a match! between track " << mTracksSectIndexCache[trkType::UNCONS][indices[0]][itrk] << " and TOF cluster " << mTOFClusSectIndexCache[indices[0]][itof];
+          foundCluster = true;
+          // set event indexes (to be checked)
+          evIdx eventIndexTOFCluster(trefTOF.getEntryInTree(), mTOFClusSectIndexCache[indices[0]][itof]);
+          evGIdx eventIndexTracks(mCurrTracksTreeEntry, {uint32_t(mTracksSectIndexCache[trkType::UNCONS][indices[0]][itrk]), o2::dataformats::GlobalTrackID::TPC});
+          matchedTracksPairs.emplace_back(eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[ibc][iPropagation], eventIndexTracks, trkType::UNCONS, resZ / vdrift * side, trefTOF.getZ()); // TODO: check if this is correct!
         }
       }
     }
@@ -948,6 +982,16 @@ void MatchTOF::doMatchingForTPC(int sec)
   return;
 }
 //______________________________________________
+void MatchTOF::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  LOG(WARNING) << "Multithreading is not supported, imposing single thread";
+  mNThreads = 1;
+#endif
+}
+//______________________________________________
 int MatchTOF::findFITIndex(int bc)
 {
   if (mFITRecPoints.size() == 0) {
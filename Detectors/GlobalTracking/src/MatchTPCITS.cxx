@@ -94,9 +94,25 @@ void MatchTPCITS::run(const o2::globaltracking::RecoContainer& inp)
   }
 
   mTimer[SWDoMatching].Start(false);
-  for (int sec = o2::constants::math::NSectors; sec--;) {
+  int nThreadsMatch = mNThreads;
+#ifdef _ALLOW_DEBUG_TREES_
+  if (mDBGOut) {
+    nThreadsMatch = 1; // debug streamer is not thread-safe
+  }
+#endif
+  // candidates of every sector are collected independently, then registered in the fixed sector order,
+  // so that the match records do not depend on the number of threads
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreadsMatch)
+#endif
+  for (int sec = 0; sec < o2::constants::math::NSectors; sec++) {
     doMatching(sec);
   }
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    for (const auto& cand : mSectMatchCandidates[sec]) {
+      registerMatchRecordTPC(cand.iITS, cand.iTPC, cand.chi2, cand.matchedIC); // register matching candidate
+    }
+  }
   mTimer[SWDoMatching].Stop();
   if (0) { // enabling this creates very verbose output
     mTimer[SWTot].Stop();
@@ -167,6 +183,7 @@ void MatchTPCITS::clear()
     mITSTimeStart[sec].clear();
     mTPCSectIndexCache[sec].clear();
     mTPCTimeStart[sec].clear();
+    mSectMatchCandidates[sec].clear();
   }
 
   if (mMCTruthON) {
@@ -378,7 +395,7 @@ void MatchTPCITS::addTPCSeed(const o2::track::TrackParCov& _tr, float t0, float
   } else {
     terr += tpcTimeBin2MUS(tpcOrig.hasBothSidesClusters() ? mParams->safeMarginTPCITSTimeBin : mTPCTimeEdgeTSafeMargin);
   }
-  auto& trc = mTPCWork.emplace_back(
+  mTPCWork.emplace_back(
     TrackLocTPC{_tr, {t0 - terr, t0 + terr}, extConstrained ? t0 : tpcTimeBin2MUS(tpcOrig.getTime0()),
                 // for A/C constrained tracks the terr is half-interval, for externally constrained tracks it is sigma*Nsigma
                 terr * (extConstrained ? mTPCExtConstrainedNSigmaInv : SQRT12DInv),
@@ -386,16 +403,46 @@ void MatchTPCITS::addTPCSeed(const o2::track::TrackParCov& _tr, float t0, float
                 srcGID,
                 MinusOne,
                 (extConstrained || tpcOrig.hasBothSidesClusters()) ? TrackLocTPC::Constrained : (tpcOrig.hasASideClustersOnly() ? TrackLocTPC::ASide : TrackLocTPC::CSide)});
-  // propagate to matching Xref
-  if (!propagateToRefX(trc)) {
-    mTPCWork.pop_back(); // discard track whose propagation to XMatchingRef failed
-    return;
-  }
+  // propagation to matching Xref and caching of the work track index are done in propagateTPCSeeds
   if (mMCTruthON) {
     mTPCLblWork.emplace_back(mTPCTrkLabels[tpcID]);
   }
-  // cache work track index
-  mTPCSectIndexCache[o2::math_utils::angle2Sector(trc.getAlpha())].push_back(mTPCWork.size() - 1);
+}
+
+//______________________________________________
+void MatchTPCITS::propagateTPCSeeds()
+{
+  // propagate the TPC seeds to matching Xref concurrently, then discard those whose propagation failed
+  // keeping the order of remaining ones, so that the work tracks do not depend on the number of threads
+  int nSeeds = mTPCWork.size();
+  std::vector<char> propagated(nSeeds);
+  // propagateToRefX touches only the seed it is given; TGeo material queries need a single thread (see Propagator::MatCorrType)
+  int nThreadsProp = mUseMatCorrFlag == MatCorrType::USEMatCorrTGeo ? 1 : mNThreads;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(nThreadsProp)
+#endif
+  for (int i = 0; i < nSeeds; i++) {
+    propagated[i] = propagateToRefX(mTPCWork[i]);
+  }
+  int nKept = 0;
+  for (int i = 0; i < nSeeds; i++) {
+    if (!propagated[i]) {
+      continue;
+    }
+    if (nKept != i) {
+      mTPCWork[nKept] = mTPCWork[i];
+      if (mMCTruthON) {
+        mTPCLblWork[nKept] = mTPCLblWork[i];
+      }
+    }
+    // cache work track index
+    mTPCSectIndexCache[o2::math_utils::angle2Sector(mTPCWork[nKept].getAlpha())].push_back(nKept);
+    nKept++;
+  }
+  mTPCWork.erase(mTPCWork.begin() + nKept, mTPCWork.end());
+  if (mMCTruthON) {
+    mTPCLblWork.erase(mTPCLblWork.begin() + nKept, mTPCLblWork.end());
+  }
 }
 
 //______________________________________________
@@ -448,6 +495,7 @@ bool MatchTPCITS::prepareTPCData()
     return true;
   };
   mRecoCont->createTracksVariadic(creator);
+  propagateTPCSeeds();
 
   float maxTime = 0;
   int nITSROFs = mITSROFTimes.size();
@@ -535,7 +583,7 @@ bool MatchTPCITS::prepareITSData()
   mITSClustersArray.reserve(clusITS.size());
   o2::its::ioutils::convertCompactClusters(clusITS, pattIt, mITSClustersArray, *mITSDict);
   if (mMCTruthON) {
-    mITSClsLabels = inp.mcITSClusters.get();
+    mITSClsLabels = inp.getITSClustersMCLabels();
   }
 
   // ITS tracks
@@ -677,7 +725,9 @@ bool MatchTPCITS::prepareFITData()
 //_____________________________________________________
 void MatchTPCITS::doMatching(int sec)
 {
-  ///< run matching for currently cached ITS data for given TPC sector
+  ///< run matching for currently cached ITS data for given TPC sector, storing the candidates in mSectMatchCandidates[sec]
+  ///< (may be called concurrently for different sectors)
+  auto& candidates = mSectMatchCandidates[sec];
   auto& cacheITS = mITSSectIndexCache[sec];   // array of cached ITS track indices for this sector
   auto& cacheTPC = mTPCSectIndexCache[sec];   // array of cached ITS track indices for this sector
   auto& timeStartTPC = mTPCTimeStart[sec];    // array of 1st TPC track with timeMax in ITS ROFrame
@@ -803,7 +853,7 @@ void MatchTPCITS::doMatching(int sec)
           continue;
         }
       }
-      registerMatchRecordTPC(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // register matching candidate
+      candidates.emplace_back(cacheITS[iits], cacheTPC[itpc], chi2, matchedIC); // store matching candidate
       nMatchesControl++;
     }
   }
@@ -1194,20 +1244,57 @@ void MatchTPCITS::refitWinners()
   mTimer[SWRefit].Start(false);
   LOG(INFO) << "Refitting winner matches";
   mWinnerChi2Refit.resize(mITSWork.size(), -1.f);
-  int iITS;
+  std::vector<int> winnersTPC;
+  winnersTPC.reserve(mTPCWork.size());
   for (int iTPC = 0; iTPC < (int)mTPCWork.size(); iTPC++) {
-    if (!refitTrackTPCITS(iTPC, iITS)) {
+    if (!isDisabledTPC(mTPCWork[iTPC])) {
+      winnersTPC.push_back(iTPC);
+    }
+  }
+  // winners are refitted concurrently into dedicated slots, then stored in the order of TPC work tracks
+  int nWinners = winnersTPC.size();
+  std::vector<o2::dataformats::TrackTPCITS> refitted(nWinners);
+  std::vector<int> refittedITS(nWinners, MinusOne);
+  // every refit fills only its own slot, but its propagations need a single thread with TGeo material queries (see Propagator::MatCorrType)
+  int nThreadsRefit = mUseMatCorrFlag == MatCorrType::USEMatCorrTGeo ? 1 : mNThreads;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreadsRefit)
+#endif
+  for (int iw = 0; iw < nWinners; iw++) {
+    int iITS;
+    if (refitTrackTPCITS(winnersTPC[iw], iITS, refitted[iw])) {
+      refittedITS[iw] = iITS;
+    }
+  }
+  mMatchedTracks.reserve(mMatchedTracks.size() + nWinners);
+  for (int iw = 0; iw < nWinners; iw++) {
+    int iITS = refittedITS[iw], iTPC = winnersTPC[iw];
+    if (iITS == MinusOne) {
       continue;
     }
-    mWinnerChi2Refit[iITS] = mMatchedTracks.back().getChi2Refit();
+    const auto& trfit = mMatchedTracks.emplace_back(refitted[iw]);
+    mWinnerChi2Refit[iITS] = trfit.getChi2Refit();
+    if (mMCTruthON) { // store MC info: we assign TPC track label and declare the match fake if the ITS and TPC labels are different (their fake flag is ignored)
+      auto& lbl = mOutLabels.emplace_back(mTPCLblWork[iTPC]);
+      lbl.setFakeFlag(mITSLblWork[iITS] != mTPCLblWork[iTPC]);
+    }
+    // if requested, fill the difference of ITS and TPC tracks tgl for vdrift calibation
+    if (mHistoDTgl) {
+      auto tglITS = mITSWork[iITS].getTgl();
+      if (std::abs(tglITS) < mHistoDTgl->getXMax()) {
+        auto dTgl = tglITS - mTPCWork[iTPC].getTgl();
+        mHistoDTgl->fill(tglITS, dTgl);
+      }
+    }
   }
   mTimer[SWRefit].Stop();
 }
 
 //______________________________________________
-bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
+bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS, o2::dataformats::TrackTPCITS& trfit)
 {
-  ///< refit in inward direction the pair of TPC and ITS tracks
+  ///< refit in inward direction the pair of TPC and ITS tracks, storing the result in trfit
+  ///< (does not modify the matcher state, may be called concurrently)
 
   const float maxStep = 2.f; // max propagation step (TODO: tune)
   const auto& tTPC = mTPCWork[iTPC];
@@ -1219,8 +1306,7 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
   const auto& tITS = mITSWork[iITS];
   const auto& itsTrOrig = mITSTracksArray[tITS.sourceID];
 
-  mMatchedTracks.emplace_back(tTPC, tITS); // create a copy of TPC track at xRef
-  auto& trfit = mMatchedTracks.back();
+  trfit = o2::dataformats::TrackTPCITS(tTPC, tITS); // create a copy of TPC track at xRef
   // in continuos mode the Z of TPC track is meaningless, unless it is CE crossing
   // track (currently absent, TODO)
   if (!mCompareTracksDZ) {
@@ -1266,7 +1352,6 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
   if (nclRefit != ncl) {
     LOGP(DEBUG, "Refit in ITS failed after ncl={}, match between TPC track #{} and ITS track #{}", nclRefit, tTPC.sourceID, tITS.sourceID);
     LOGP(DEBUG, "{:s}", trfit.asString());
-    mMatchedTracks.pop_back(); // destroy failed track
     return false;
   }
 
@@ -1291,7 +1376,6 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
     if (!tracOut.getXatLabR(o2::constants::geom::XTPCInnerRef, xtogo, mBz, o2::track::DirOutward) ||
         !propagator->PropagateToXBxByBz(tracOut, xtogo, MaxSnp, 10., mUseMatCorrFlag, &tofL)) {
       LOG(DEBUG) << "Propagation to inner TPC boundary X=" << xtogo << " failed, Xtr=" << tracOut.getX() << " snp=" << tracOut.getSnp();
-      mMatchedTracks.pop_back(); // destroy failed track
       return false;
     }
     if (mVDriftCalibOn) {
@@ -1302,13 +1386,11 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
     auto tImposed = timeC * mTPCTBinMUSInv;
     if (std::abs(tImposed - mTPCTracksArray[tTPC.sourceID].getTime0()) > 550) { // RS FIXME: should be removed once TOF fixes https://github.com/AliceO2Group/AliceO2/pull/6540#issuecomment-880060760
       LOG(ERROR) << "Impossible imposed timebin " << tImposed << " for TPC track with timebin0 " << mTPCTracksArray[tTPC.sourceID].getTime0() << " TB";
-      mMatchedTracks.pop_back(); // destroy failed track
       return false;
     }
     int retVal = mTPCRefitter->RefitTrackAsTrackParCov(tracOut, mTPCTracksArray[tTPC.sourceID].getClusterRef(), timeC * mTPCTBinMUSInv, &chi2Out, true, false); // outward refit
     if (retVal < 0) {
       LOG(DEBUG) << "Refit failed";
-      mMatchedTracks.pop_back(); // destroy failed track
       return false;
     }
     auto posEnd = tracOut.getXYZGlo();
@@ -1337,20 +1419,6 @@ bool MatchTPCITS::refitTrackTPCITS(int iTPC, int& iITS)
   trfit.setTimeMUS(timeC, timeErr);
   trfit.setRefTPC({unsigned(tTPC.sourceID), o2::dataformats::GlobalTrackID::TPC});
   trfit.setRefITS({unsigned(tITS.sourceID), o2::dataformats::GlobalTrackID::ITS});
-
-  if (mMCTruthON) { // store MC info: we assign TPC track label and declare the match fake if the ITS and TPC labels are different (their fake flag is ignored)
-    auto& lbl = mOutLabels.emplace_back(mTPCLblWork[iTPC]);
-    lbl.setFakeFlag(mITSLblWork[iITS] != mTPCLblWork[iTPC]);
-  }
-
-  // if requested, fill the difference of ITS and TPC tracks tgl for vdrift calibation
-  if (mHistoDTgl) {
-    auto tglITS = tITS.getTgl();
-    if (std::abs(tglITS) < mHistoDTgl->getXMax()) {
-      auto dTgl = tglITS - tTPC.getTgl();
-      mHistoDTgl->fill(tglITS, dTgl);
-    }
-  }
   //  trfit.print(); // DBG
 
   return true;
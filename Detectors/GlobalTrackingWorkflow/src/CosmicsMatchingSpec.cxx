@@ -112,6 +112,7 @@ void CosmicsMatchingSpec::init(InitContext& ic)
   mMatching.setDebugFlag(ic.options().get<int>("debug-tree-flags"));
 
   mMatching.setUseMC(mUseMC);
+  mMatching.setNThreads(std::max(1, ic.options().get<int>("nthreads")));
   mMatching.init();
   //
 }
@@ -159,7 +160,8 @@ DataProcessorSpec getCosmicsMatchingSpec(GTrackID::mask_t src, bool useMC)
     Options{
       {"its-dictionary-path", VariantType::String, "", {"Path of the cluster-topology dictionary file"}},
       {"material-lut-path", VariantType::String, "", {"Path of the material LUT file"}},
-      {"debug-tree-flags", VariantType::Int, 0, {"DebugFlagTypes bit-pattern for debug tree"}}}};
+      {"debug-tree-flags", VariantType::Int, 0, {"DebugFlagTypes bit-pattern for debug tree"}},
+      {"nthreads", VariantType::Int, 1, {"Number of threads matching and refitting the cosmic legs"}}}};
 }
 
 } // namespace globaltracking
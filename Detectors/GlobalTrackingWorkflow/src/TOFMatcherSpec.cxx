@@ -12,6 +12,7 @@
 /// @file   TOFMatcherSpec.cxx
 
 #include <vector>
+#include <algorithm>
 #include <string>
 #include "TStopwatch.h"
 #include "Framework/ConfigParamRegistry.h"
@@ -94,6 +95,7 @@ void TOFMatcherSpec::init(InitContext& ic)
   if (mStrict) {
     mMatcher.setHighPurity();
   }
+  mMatcher.setNThreads(std::max(1, ic.options().get<int>("nthreads")));
 }
 
 void TOFMatcherSpec::run(ProcessingContext& pc)
@@ -199,7 +201,8 @@ DataProcessorSpec getTOFMatcherSpec(GID::mask_t src, bool useMC, bool useFIT, bo
     outputs,
     AlgorithmSpec{adaptFromTask<TOFMatcherSpec>(dataRequest, useMC, useFIT, tpcRefit, strict)},
     Options{
-      {"material-lut-path", VariantType::String, "", {"Path of the material LUT file"}}}};
+      {"material-lut-path", VariantType::String, "", {"Path of the material LUT file"}},
+      {"nthreads", VariantType::Int, 1, {"Number of threads matching the TOF sectors in parallel"}}}};
 }
 
 } // namespace globaltracking
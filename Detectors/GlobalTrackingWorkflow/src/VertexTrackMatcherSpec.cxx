@@ -53,6 +53,7 @@ void VertexTrackMatcherSpec::init(InitContext& ic)
   mTimer.Reset();
 
   mMatcher.init();
+  mMatcher.setNThreads(std::max(1, ic.options().get<int>("nthreads")));
 }
 
 void VertexTrackMatcherSpec::run(ProcessingContext& pc)
@@ -98,7 +99,7 @@ DataProcessorSpec getVertexTrackMatcherSpec(GTrackID::mask_t src)
     dataRequest->inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<VertexTrackMatcherSpec>(dataRequest)},
-    Options{}};
+    Options{{"nthreads", VariantType::Int, 1, {"Number of threads matching the tracks to vertices"}}}};
 }
 
 } // namespace vertexing
@@ -47,6 +47,8 @@ class DataDecoderTask2 : public framework::Task
 
   ExecutionTimer mExTimer;
   std::vector<o2::hmpid::Trigger> mTriggers;
+  std::vector<o2::hmpid::Trigger> mOrderedTriggers; // buffers reused by orderTriggers()
+  std::vector<o2::hmpid::Digit> mOrderedDigits;
 };
 
 o2::framework::DataProcessorSpec getDecodingSpec2(bool askSTFDist);
@@ -284,10 +284,14 @@ void DataDecoderTask2::decodeRawFile(framework::ProcessingContext& pc)
 
 void DataDecoderTask2::orderTriggers()
 {
-  std::vector<o2::hmpid::Digit> dig;
+  // the output buffers are swapped with the decoder ones at the end,
+  // so that their capacity is reused in the next TF
+  auto& dig = mOrderedDigits;
   dig.clear();
-  std::vector<o2::hmpid::Trigger> trg;
+  dig.reserve(mDeco->mDigits.size());
+  auto& trg = mOrderedTriggers;
   trg.clear();
+  trg.reserve(mTriggers.size());
 
   // first arrange the triggers in chronological order
   std::sort(mTriggers.begin(), mTriggers.end());
@@ -302,9 +306,10 @@ void DataDecoderTask2::orderTriggers()
     count = 0;
     firstEntry = dig.size();
     while (k < mTriggers.size() && mTriggers[i].getTriggerID() == mTriggers[k].getTriggerID()) {
-      for (int j = mTriggers[k].getFirstEntry(); j <= mTriggers[k].getLastEntry(); j++) {
-        dig.push_back(mDeco->mDigits[j]);
-        count++;
+      if (mTriggers[k].getNumberOfObjects() > 0) {
+        auto first = mDeco->mDigits.begin() + mTriggers[k].getFirstEntry();
+        dig.insert(dig.end(), first, first + mTriggers[k].getNumberOfObjects());
+        count += mTriggers[k].getNumberOfObjects();
       }
       k++;
     }
@@ -433,6 +433,9 @@ void GeometryTGeo::fillMatrixCache(int mask)
     Build(mask);
     return;
   }
+  if (readMatrixCache(mask)) { // all requested matrices are available in the node-local cache
+    return;
+  }
 
   // build matrices
   if ((mask & o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G)) && !getCacheL2G().isFilled()) {
@@ -481,6 +484,7 @@ void GeometryTGeo::fillMatrixCache(int mask)
       cacheT2Gr.setMatrix(Rot2D(getSensorRefAlpha(i)), i);
     }
   }
+  writeMatrixCache();
 }
 
 //__________________________________________________________________________
@@ -15,6 +15,7 @@
 #define O2_ITS_NOISECALIBRATOR
 
 #include <string>
+#include <vector>
 
 #include "DataFormatsITSMFT/NoiseMap.h"
 #include "gsl/span"
@@ -43,6 +44,7 @@ class NoiseCalibrator
   ~NoiseCalibrator() = default;
 
   void setThreshold(unsigned int t) { mThreshold = t; }
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
 
   bool processTimeFrame(gsl::span<const o2::itsmft::CompClusterExt> const& clusters,
                         gsl::span<const unsigned char> const& patterns,
@@ -58,6 +60,8 @@ class NoiseCalibrator
   unsigned int mThreshold = 100;
   unsigned int mNumberOfStrobes = 0;
   bool m1pix = true;
+  int mNThreads = 1;
+  std::vector<std::vector<uint64_t>> mKeys; //! pixels fired in the TF, collected by each thread
 };
 
 } // namespace its
@@ -18,6 +18,11 @@
 #include "DataFormatsITSMFT/ClusterPattern.h"
 #include "DataFormatsITSMFT/CompCluster.h"
 #include "DataFormatsITSMFT/ROFRecord.h"
+#include <algorithm>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace o2
 {
@@ -30,10 +35,33 @@ bool NoiseCalibrator::processTimeFrame(gsl::span<const o2::itsmft::CompClusterEx
   static int nTF = 0;
   LOG(INFO) << "Processing TF# " << nTF++;
 
-  auto pattIt = patterns.begin();
-  for (const auto& rof : rofs) {
-    auto clustersInFrame = rof.getROFData(clusters);
-    for (const auto& c : clustersInFrame) {
+  // start of the patterns of each ROF, so that the ROFs can be processed concurrently
+  int nROFs = rofs.size();
+  std::vector<size_t> pattStart(nROFs);
+  size_t pattOffset = 0;
+  for (int irof = 0; irof < nROFs; irof++) {
+    pattStart[irof] = pattOffset;
+    for (const auto& c : rofs[irof].getROFData(clusters)) {
+      if (c.getPatternID() == o2::itsmft::CompCluster::InvalidPatternID) {
+        int nBits = patterns[pattOffset] * patterns[pattOffset + 1];
+        pattOffset += 2 + (nBits + 7) / 8;
+      }
+    }
+  }
+
+  // the fired pixels are collected by each thread, sorted and added to the map once per pixel
+  mKeys.resize(mNThreads);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int irof = 0; irof < nROFs; irof++) {
+#ifdef WITH_OPENMP
+    auto& keys = mKeys[omp_get_thread_num()];
+#else
+    auto& keys = mKeys[0];
+#endif
+    auto pattIt = patterns.begin() + pattStart[irof];
+    for (const auto& c : rofs[irof].getROFData(clusters)) {
       if (c.getPatternID() != o2::itsmft::CompCluster::InvalidPatternID) {
         // For the noise calibration, we use "pass1" clusters...
         continue;
@@ -48,7 +76,7 @@ bool NoiseCalibrator::processTimeFrame(gsl::span<const o2::itsmft::CompClusterEx
 
       // Fast 1-pixel calibration
       if ((rowSpan == 1) && (colSpan == 1)) {
-        mNoiseMap.increaseNoiseCount(id, row, col);
+        keys.push_back(o2::itsmft::NoiseMap::getKey(id, row, col));
         continue;
       }
       if (m1pix) {
@@ -63,7 +91,7 @@ bool NoiseCalibrator::processTimeFrame(gsl::span<const o2::itsmft::CompClusterEx
         int s = 128; // 0b10000000
         while (s > 0) {
           if ((tempChar & s) != 0) {
-            mNoiseMap.increaseNoiseCount(id, row + ir, col + ic);
+            keys.push_back(o2::itsmft::NoiseMap::getKey(id, row + ir, col + ic));
           }
           ic++;
           s >>= 1;
@@ -81,6 +109,16 @@ bool NoiseCalibrator::processTimeFrame(gsl::span<const o2::itsmft::CompClusterEx
       }
     }
   }
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(mNThreads)
+#endif
+  for (int ith = 0; ith < mNThreads; ith++) {
+    std::sort(mKeys[ith].begin(), mKeys[ith].end());
+  }
+  for (auto& keys : mKeys) {
+    mNoiseMap.increaseNoiseCounts(keys);
+    keys.clear();
+  }
   mNumberOfStrobes += rofs.size();
   return (mNumberOfStrobes * mProbabilityThreshold >= mThreshold) ? true : false;
 }
@@ -36,6 +36,9 @@ void NoiseCalibratorSpec::init(InitContext& ic)
   LOG(INFO) << "Setting the probability threshold to " << probT;
 
   mCalibrator = std::make_unique<CALIBRATOR>(onepix, probT);
+#ifndef TIME_SLOT_CALIBRATION
+  mCalibrator->setNThreads(ic.options().get<int>("nthreads"));
+#endif
 }
 
 void NoiseCalibratorSpec::run(ProcessingContext& pc)
@@ -99,7 +102,8 @@ DataProcessorSpec getNoiseCalibratorSpec()
     AlgorithmSpec{adaptFromTask<NoiseCalibratorSpec>()},
     Options{
       {"1pix-only", VariantType::Bool, false, {"Fast 1-pixel calibration only"}},
-      {"prob-threshold", VariantType::Float, 3.e-6f, {"Probability threshold for noisy pixels"}}}};
+      {"prob-threshold", VariantType::Float, 3.e-6f, {"Probability threshold for noisy pixels"}},
+      {"nthreads", VariantType::Int, 1, {"Number of threads for the accumulation of the fired pixels"}}}};
 }
 
 } // namespace its
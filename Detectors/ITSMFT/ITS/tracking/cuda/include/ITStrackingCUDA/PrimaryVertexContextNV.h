@@ -124,7 +124,7 @@ inline std::array<gpu::Vector<Cell>, constants::its2::CellsPerRoad - 1>& Primary
 
 inline void PrimaryVertexContextNV::updateDeviceContext()
 {
-  mGPUContextDevicePointer = gpu::UniquePointer<gpu::DeviceStoreNV>{mGPUContext};
+  mGPUContextDevicePointer.reset(mGPUContext);
 }
 
 inline void PrimaryVertexContextNV::initialise(const MemoryParameters& memParam, const TrackingParameters& trkParam,
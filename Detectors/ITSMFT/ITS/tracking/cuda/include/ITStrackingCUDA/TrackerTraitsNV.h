@@ -16,9 +16,13 @@
 #ifndef TRACKINGITSU_INCLUDE_TRACKERTRAITSNV_H_
 #define TRACKINGITSU_INCLUDE_TRACKERTRAITSNV_H_
 
+#include <array>
+
 #include "ITStracking/Configuration.h"
+#include "ITStracking/Constants.h"
 #include "ITStracking/Definitions.h"
 #include "ITStracking/TrackerTraits.h"
+#include "ITStrackingCUDA/Stream.h"
 
 namespace o2
 {
@@ -36,6 +40,9 @@ class TrackerTraitsNV : public TrackerTraits
   void computeLayerCells() final;
   void computeLayerTracklets() final;
   void refitTracks(const std::vector<std::vector<TrackingFrameInfo>>& tf, std::vector<TrackITSExt>& tracks) override;
+
+ private:
+  std::array<gpu::Stream, constants::its2::TrackletsPerRoad> mStreamArray; ///< created once, shared by the tracklet and cell finding
 };
 
 extern "C" TrackerTraits* createTrackerTraitsNV();
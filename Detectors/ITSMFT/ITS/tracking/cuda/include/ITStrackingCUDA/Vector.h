@@ -208,14 +208,15 @@ void Vector<T>::reset(const T* const source, const int size, const int initialSi
     mCapacity = size;
   }
 
+  if (mDeviceSize == nullptr) {
+    utils::host::gpuMalloc(reinterpret_cast<void**>(&mDeviceSize), sizeof(int));
+  }
+
   if (source != nullptr) {
     utils::host::gpuMemcpyHostToDevice(mArrayPointer, source, size * sizeof(T));
     utils::host::gpuMemcpyHostToDevice(mDeviceSize, &size, sizeof(int));
 
   } else {
-    if (mDeviceSize == nullptr) {
-      utils::host::gpuMalloc(reinterpret_cast<void**>(&mDeviceSize), sizeof(int));
-    }
     utils::host::gpuMemcpyHostToDevice(mDeviceSize, &initialSize, sizeof(int));
   }
 }
@@ -126,14 +126,14 @@ UniquePointer<DeviceStoreNV> DeviceStoreNV::initialise(const float3& primaryVert
                                                        const std::array<float, constants::its2::LayersNumber>& rmin,
                                                        const std::array<float, constants::its2::LayersNumber>& rmax)
 {
-  mPrimaryVertex = UniquePointer<float3>{primaryVertex};
+  // the device memory is kept from one call to the next and only grown when needed
+  mPrimaryVertex.reset(primaryVertex);
 
   for (int iLayer{0}; iLayer < constants::its2::LayersNumber; ++iLayer) {
     this->mRmin[iLayer] = rmin[iLayer];
     this->mRmax[iLayer] = rmax[iLayer];
 
-    this->mClusters[iLayer] =
-      Vector<Cluster>{&clusters[iLayer][0], static_cast<int>(clusters[iLayer].size())};
+    this->mClusters[iLayer].reset(clusters[iLayer].data(), static_cast<int>(clusters[iLayer].size()));
 
     if (iLayer < constants::its2::TrackletsPerRoad) {
       this->mTracklets[iLayer].reset(tracklets[iLayer].capacity());
@@ -328,7 +328,6 @@ void TrackerTraitsNV::computeLayerTracklets()
   // cudaMemcpyToSymbol(gpu::kTrkPar, &mTrkParams, sizeof(TrackingParameters));
   std::array<size_t, constants::its2::CellsPerRoad> tempSize;
   std::array<int, constants::its2::CellsPerRoad> trackletsNum;
-  std::array<gpu::Stream, constants::its2::TrackletsPerRoad> streamArray;
 
   for (int iLayer{0}; iLayer < constants::its2::CellsPerRoad; ++iLayer) {
 
@@ -355,13 +354,13 @@ void TrackerTraitsNV::computeLayerTracklets()
 
     if (iLayer == 0) {
 
-      gpu::layerTrackletsKernel<<<blocksGrid, threadsPerBlock, 0, streamArray[iLayer].get()>>>(primaryVertexContext->getDeviceContext(),
-                                                                                               iLayer, primaryVertexContext->getDeviceTracklets()[iLayer].getWeakCopy());
+      gpu::layerTrackletsKernel<<<blocksGrid, threadsPerBlock, 0, mStreamArray[iLayer].get()>>>(primaryVertexContext->getDeviceContext(),
+                                                                                                iLayer, primaryVertexContext->getDeviceTracklets()[iLayer].getWeakCopy());
 
     } else {
 
-      gpu::layerTrackletsKernel<<<blocksGrid, threadsPerBlock, 0, streamArray[iLayer].get()>>>(primaryVertexContext->getDeviceContext(),
-                                                                                               iLayer, primaryVertexContext->getTempTrackletArray()[iLayer - 1].getWeakCopy());
+      gpu::layerTrackletsKernel<<<blocksGrid, threadsPerBlock, 0, mStreamArray[iLayer].get()>>>(primaryVertexContext->getDeviceContext(),
+                                                                                                iLayer, primaryVertexContext->getTempTrackletArray()[iLayer - 1].getWeakCopy());
     }
 
     cudaError_t error = cudaGetLastError();
@@ -389,13 +388,13 @@ void TrackerTraitsNV::computeLayerTracklets()
     cub::DeviceScan::ExclusiveSum(static_cast<void*>(primaryVertexContext->getTempTableArray()[iLayer].get()), tempSize[iLayer],
                                   primaryVertexContext->getDeviceTrackletsPerClustersTable()[iLayer].get(),
                                   primaryVertexContext->getDeviceTrackletsLookupTable()[iLayer].get(),
-                                  primaryVertexContext->getClusters()[iLayer + 1].size(), streamArray[iLayer + 1].get());
+                                  primaryVertexContext->getClusters()[iLayer + 1].size(), mStreamArray[iLayer + 1].get());
 
     dim3 threadsPerBlock{gpu::utils::host::getBlockSize(trackletsNum[iLayer])};
     dim3 blocksGrid{gpu::utils::host::getBlocksGrid(threadsPerBlock, trackletsNum[iLayer])};
 
-    gpu::sortTrackletsKernel<<<blocksGrid, threadsPerBlock, 0, streamArray[iLayer + 1].get()>>>(primaryVertexContext->getDeviceContext(),
-                                                                                                iLayer + 1, primaryVertexContext->getTempTrackletArray()[iLayer].getWeakCopy());
+    gpu::sortTrackletsKernel<<<blocksGrid, threadsPerBlock, 0, mStreamArray[iLayer + 1].get()>>>(primaryVertexContext->getDeviceContext(),
+                                                                                                 iLayer + 1, primaryVertexContext->getTempTrackletArray()[iLayer].getWeakCopy());
 
     cudaError_t error = cudaGetLastError();
 
@@ -417,7 +416,6 @@ void TrackerTraitsNV::computeLayerCells()
   std::array<size_t, constants::its2::CellsPerRoad - 1> tempSize;
   std::array<int, constants::its2::CellsPerRoad - 1> trackletsNum;
   std::array<int, constants::its2::CellsPerRoad - 1> cellsNum;
-  std::array<gpu::Stream, constants::its2::CellsPerRoad> streamArray;
 
   for (int iLayer{0}; iLayer < constants::its2::CellsPerRoad - 1; ++iLayer) {
 
@@ -448,13 +446,13 @@ void TrackerTraitsNV::computeLayerCells()
 
     if (iLayer == 0) {
 
-      gpu::layerCellsKernel<<<blocksGrid, threadsPerBlock, 0, streamArray[iLayer].get()>>>(primaryVertexContext->getDeviceContext(),
-                                                                                           iLayer, primaryVertexContext->getDeviceCells()[iLayer].getWeakCopy());
+      gpu::layerCellsKernel<<<blocksGrid, threadsPerBlock, 0, mStreamArray[iLayer].get()>>>(primaryVertexContext->getDeviceContext(),
+                                                                                            iLayer, primaryVertexContext->getDeviceCells()[iLayer].getWeakCopy());
 
     } else {
 
-      gpu::layerCellsKernel<<<blocksGrid, threadsPerBlock, 0, streamArray[iLayer].get()>>>(primaryVertexContext->getDeviceContext(),
-                                                                                           iLayer, primaryVertexContext->getTempCellArray()[iLayer - 1].getWeakCopy());
+      gpu::layerCellsKernel<<<blocksGrid, threadsPerBlock, 0, mStreamArray[iLayer].get()>>>(primaryVertexContext->getDeviceContext(),
+                                                                                            iLayer, primaryVertexContext->getTempCellArray()[iLayer - 1].getWeakCopy());
     }
 
     cudaError_t error = cudaGetLastError();
@@ -481,13 +479,13 @@ void TrackerTraitsNV::computeLayerCells()
     cub::DeviceScan::ExclusiveSum(static_cast<void*>(primaryVertexContext->getTempTableArray()[iLayer].get()), tempSize[iLayer],
                                   primaryVertexContext->getDeviceCellsPerTrackletTable()[iLayer].get(),
                                   primaryVertexContext->getDeviceCellsLookupTable()[iLayer].get(), trackletsNum[iLayer],
-                                  streamArray[iLayer + 1].get());
+                                  mStreamArray[iLayer + 1].get());
 
     dim3 threadsPerBlock{gpu::utils::host::getBlockSize(trackletsNum[iLayer])};
     dim3 blocksGrid{gpu::utils::host::getBlocksGrid(threadsPerBlock, trackletsNum[iLayer])};
 
-    gpu::sortCellsKernel<<<blocksGrid, threadsPerBlock, 0, streamArray[iLayer + 1].get()>>>(primaryVertexContext->getDeviceContext(),
-                                                                                            iLayer + 1, primaryVertexContext->getTempCellArray()[iLayer].getWeakCopy());
+    gpu::sortCellsKernel<<<blocksGrid, threadsPerBlock, 0, mStreamArray[iLayer + 1].get()>>>(primaryVertexContext->getDeviceContext(),
+                                                                                             iLayer + 1, primaryVertexContext->getTempCellArray()[iLayer].getWeakCopy());
 
     cudaError_t error = cudaGetLastError();
 
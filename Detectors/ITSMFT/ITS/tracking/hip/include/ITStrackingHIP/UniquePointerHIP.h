@@ -60,6 +60,9 @@ class UniquePointer final
   UniquePointer(UniquePointer&&);
   UniquePointer& operator=(UniquePointer&&);
 
+  /// copy the object to the device, reusing the device memory if already allocated
+  void reset(const T&);
+
   GPUhd() T* get() noexcept;
   GPUhd() const T* get() const noexcept;
   GPUhd() T& operator*() noexcept;
@@ -103,18 +106,30 @@ UniquePointer<T>::~UniquePointer()
 template <typename T>
 UniquePointer<T>::UniquePointer(UniquePointer<T>&& other) : mDevicePointer{other.mDevicePointer}
 {
-  // Nothing to do
+  other.mDevicePointer = nullptr;
 }
 
 template <typename T>
 UniquePointer<T>& UniquePointer<T>::operator=(UniquePointer<T>&& other)
 {
-  mDevicePointer = other.mDevicePointer;
-  other.mDevicePointer = nullptr;
+  if (this != &other) {
+    destroy();
+    mDevicePointer = other.mDevicePointer;
+    other.mDevicePointer = nullptr;
+  }
 
   return *this;
 }
 
+template <typename T>
+void UniquePointer<T>::reset(const T& ref)
+{
+  if (mDevicePointer == nullptr) {
+    utils::host_hip::gpuMalloc(reinterpret_cast<void**>(&mDevicePointer), sizeof(T));
+  }
+  utils::host_hip::gpuMemcpyHostToDevice(mDevicePointer, &ref, sizeof(T));
+}
+
 template <typename T>
 void UniquePointer<T>::destroy()
 {
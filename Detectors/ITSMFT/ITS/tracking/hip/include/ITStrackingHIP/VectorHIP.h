@@ -209,6 +209,10 @@ void VectorHIP<T>::reset(const T* const source, const int size, const int initia
     mCapacity = size;
   }
 
+  if (mDeviceSize == nullptr) {
+    utils::host_hip::gpuMalloc(reinterpret_cast<void**>(&mDeviceSize), sizeof(int));
+  }
+
   if (source != nullptr) {
 
     utils::host_hip::gpuMemcpyHostToDevice(mArrayPointer, source, size * sizeof(T));
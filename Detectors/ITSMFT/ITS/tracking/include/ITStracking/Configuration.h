@@ -84,6 +84,8 @@ struct MemoryParameters {
   int MemoryOffset = 256;
   std::vector<float> CellsMemoryCoefficients = {2.3208e-08f, 2.104e-08f, 1.6432e-08f, 1.2412e-08f, 1.3543e-08f};
   std::vector<float> TrackletsMemoryCoefficients = {0.0016353f, 0.0013627f, 0.000984f, 0.00078135f, 0.00057934f, 0.00052217f};
+  /// Memory budget in bytes of the buffers of the CPU tracking of a ROF, 0 for no limit
+  size_t MaxMemory = 0;
 };
 
 inline int TrackingParameters::CellMinimumLevel()
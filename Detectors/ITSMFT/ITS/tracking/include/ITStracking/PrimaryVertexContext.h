@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <array>
 #include <iosfwd>
+#include <stdexcept>
 #include <vector>
 
 #include "ITStracking/Cell.h"
@@ -34,9 +35,32 @@ namespace o2
 namespace its
 {
 
+/// Thrown when the tracking buffers of a ROF would exceed the MemoryParameters::MaxMemory budget.
+/// The Tracker skips the iteration and flags the ROF instead of letting the buffers grow.
+class MemoryBudgetExceeded : public std::runtime_error
+{
+ public:
+  using std::runtime_error::runtime_error;
+};
+
 class PrimaryVertexContext
 {
  public:
+  /// Structure-of-arrays copy of the cluster fields read in the tight loops of the tracklet finding, in the same
+  /// (index table) order as the clusters of the layer. The arrays keep their capacity over the ROFs
+  struct ClustersSoA {
+    std::vector<float> zCoordinate;
+    std::vector<float> rCoordinate;
+    std::vector<float> phiCoordinate;
+
+    void resize(size_t n)
+    {
+      zCoordinate.resize(n);
+      rCoordinate.resize(n);
+      phiCoordinate.resize(n);
+    }
+  };
+
   PrimaryVertexContext() = default;
 
   virtual ~PrimaryVertexContext() = default;
@@ -48,6 +72,7 @@ class PrimaryVertexContext
                           const std::vector<std::vector<Cluster>>& cl, const std::array<float, 3>& pv, const int iteration);
   const float3& getPrimaryVertex() const { return mPrimaryVertex; }
   auto& getClusters() { return mClusters; }
+  const auto& getClustersSoA() const { return mClustersSoA; }
   auto& getCells() { return mCells; }
   auto& getCellsLookupTable() { return mCellsLookupTable; }
   auto& getCellsNeighbours() { return mCellsNeighbours; }
@@ -63,6 +88,9 @@ class PrimaryVertexContext
   auto& getTracklets() { return mTracklets; }
   auto& getTrackletsLookupTable() { return mTrackletsLookupTable; }
 
+  /// @return the memory in bytes allocated by the buffers of the context, from their capacity
+  size_t getMemoryUsage() const;
+
   void initialiseRoadLabels();
   void setRoadLabel(int i, const unsigned long long& lab, bool fake);
   const unsigned long long& getRoadLabel(int i) const;
@@ -71,10 +99,13 @@ class PrimaryVertexContext
   IndexTableUtils mIndexTableUtils;
 
  protected:
+  void checkMemoryBudget(const MemoryParameters& memParam, size_t bytes, const char* buffer, int layer) const;
+
   float3 mPrimaryVertex;
   std::vector<float> mMinR;
   std::vector<float> mMaxR;
   std::vector<std::vector<Cluster>> mClusters;
+  std::vector<ClustersSoA> mClustersSoA;
   std::vector<std::vector<bool>> mUsedClusters;
   std::vector<std::vector<Cell>> mCells;
   std::vector<std::vector<int>> mCellsLookupTable;
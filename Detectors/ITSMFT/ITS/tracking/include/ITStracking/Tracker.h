@@ -75,6 +75,22 @@ class Tracker
 
   void clustersToTracks(const ROframe&, std::ostream& = std::cout);
 
+  /// Phases after which the memory used by the PrimaryVertexContext is recorded
+  enum class MemoryPhase : int {
+    Context,
+    Tracklets,
+    Cells,
+    Neighbours,
+    Roads,
+    NPhases
+  };
+  static constexpr std::array<const char*, static_cast<int>(MemoryPhase::NPhases)> MemoryPhaseNames{"context", "tracklets", "cells", "neighbours", "roads"};
+  /// @return the peak memory usage in bytes after each phase since the last resetMemoryPeaks
+  const auto& getMemoryPeaks() const { return mMemoryPeaks; }
+  void resetMemoryPeaks() { mMemoryPeaks.fill(0); }
+  /// @return true if an iteration of the last clustersToTracks call was skipped for exceeding MemoryParameters::MaxMemory
+  bool isMemoryBudgetExceeded() const { return mMemoryBudgetExceeded; }
+
   void setROFrame(std::uint32_t f) { mROFrame = f; }
   std::uint32_t getROFrame() const { return mROFrame; }
   void setCorrType(const o2::base::PropagatorImpl<float>::MatCorrType& type) { mCorrType = type; }
@@ -87,6 +103,7 @@ class Tracker
                                     const TrackingFrameInfo& tf3);
   template <typename... T>
   void initialisePrimaryVertexContext(T&&... args);
+  void updateMemoryPeak(MemoryPhase phase);
   void computeTracklets();
   void computeCells();
   void findCellsNeighbours(int& iteration);
@@ -108,6 +125,9 @@ class Tracker
   std::vector<TrackingParameters> mTrkParams;
 
   bool mCUDA = false;
+  int mNThreads = 1;
+  bool mMemoryBudgetExceeded = false;
+  std::array<size_t, static_cast<int>(MemoryPhase::NPhases)> mMemoryPeaks{};
   o2::base::PropagatorImpl<float>::MatCorrType mCorrType = o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrLUT;
   float mBz = 5.f;
   std::uint32_t mROFrame = 0;
@@ -165,7 +185,11 @@ float Tracker::evaluateTask(void (Tracker::*task)(T...), const char* taskName, s
       if (taskName == nullptr) {
         ostream << diff << "\t";
       } else {
-        ostream << std::setw(2) << " - " << taskName << " completed in: " << diff << " ms" << std::endl;
+        ostream << std::setw(2) << " - " << taskName << " completed in: " << diff << " ms";
+        if (mNThreads > 1) {
+          ostream << " using " << mNThreads << " threads";
+        }
+        ostream << std::endl;
       }
     }
   } else {
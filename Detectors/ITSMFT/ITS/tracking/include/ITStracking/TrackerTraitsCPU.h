@@ -17,13 +17,16 @@
 #define TRACKINGITSU_INCLUDE_TRACKERTRAITSCPU_H_
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <iosfwd>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "ITStracking/TrackerTraits.h"
 #include "ITStracking/Configuration.h"
@@ -50,6 +53,30 @@ class TrackerTraitsCPU : public TrackerTraits
  protected:
   std::vector<std::vector<Tracklet>> mTracklets;
   std::vector<std::vector<Cell>> mCells;
+  std::vector<std::vector<uint8_t>> mSelectedClusters;                // per thread preselection flags of the next layer clusters in computeLayerTracklets
+  std::vector<std::vector<Tracklet>> mTrackletsBuffers;               // per chunk tracklets of the multi-threaded computeLayerTracklets
+  std::vector<std::vector<Cell>> mCellsBuffers;                       // per chunk cells of the multi-threaded computeLayerCells
+  std::vector<std::vector<std::pair<int, int>>> mFirstIndicesBuffers; // per chunk (entry, index of its 1st tracklet or cell) pairs
+
+ private:
+  /// Bytes of MemoryParameters::MaxMemory still available to the growth of the buffers, shared by the threads
+  class MemoryBudget
+  {
+   public:
+    explicit MemoryBudget(size_t bytes) : mAvailable{bytes} {}
+    /// Makes room for one more element in @a vec, @return false if the budget does not allow it
+    template <typename T>
+    bool reserveNext(std::vector<T>& vec);
+
+   private:
+    std::atomic<size_t> mAvailable;
+  };
+
+  size_t getAvailableMemory(const char* phase, int iLayer) const;
+  bool computeLayerTrackletsRange(int iLayer, int firstCluster, int lastCluster, std::vector<Tracklet>& tracklets,
+                                  std::vector<std::pair<int, int>>& firstTracklets, std::vector<uint8_t>& selectedClusters, MemoryBudget& budget);
+  bool computeLayerCellsRange(int iLayer, int firstTracklet, int lastTracklet, std::vector<Cell>& cells,
+                              std::vector<std::pair<int, int>>& firstCells, MemoryBudget& budget);
 };
 } // namespace its
 } // namespace o2
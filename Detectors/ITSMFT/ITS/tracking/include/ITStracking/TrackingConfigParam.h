@@ -32,6 +32,7 @@ struct VertexerParamConfig : public o2::conf::ConfigurableParamHelper<VertexerPa
   int clusterContributorsCut = 16;
   int phiSpan = -1;
   int zSpan = -1;
+  int nThreads = 1; // threads for the batched vertexing of the ROFs of a TF
 
   O2ParamDef(VertexerParamConfig, "ITSVertexerParam");
 };
@@ -40,6 +41,10 @@ struct TrackerParamConfig : public o2::conf::ConfigurableParamHelper<TrackerPara
 
   // Use TGeo for mat. budget
   bool useMatCorrTGeo = false;
+  // Number of threads for the tracklet and cell finding of the CPU tracker
+  int nThreads = 1;
+  // Memory budget in bytes of the CPU tracking of a ROF, the iterations exceeding it are skipped. 0 for no limit
+  size_t maxMemory = 0;
 
   O2ParamDef(TrackerParamConfig, "ITSCATrackerParam");
 };
@@ -21,6 +21,10 @@
 #include <iomanip>
 #include <array>
 #include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include <gsl/span>
 
 #include "ITStracking/ROframe.h"
 #include "ITStracking/Constants.h"
@@ -55,12 +59,18 @@ class Vertexer
   void setParameters(const VertexingParameters& verPar);
   void getGlobalConfiguration();
   VertexingParameters getVertParameters() const;
+  int getNThreads() const { return mNThreads; }
 
   uint32_t getROFrame() const { return mROframe; }
   std::vector<Vertex> exportVertices();
   VertexerTraits* getTraits() const { return mTraits; };
 
   float clustersToVertices(ROframe&, const bool useMc = false, std::ostream& = std::cout);
+  /// Finds the vertices of a batch of ROFs, the vertices of events[i] are stored in vertices[i].
+  /// With the CPU traits the ROFs are shared between nThreads copies of the traits, which keep the
+  /// IndexTableUtils and the buffers from one ROF to the next, otherwise they are processed one by one.
+  float clustersToVerticesBatch(gsl::span<ROframe> events, std::vector<std::vector<Vertex>>& vertices, int nThreads = 1,
+                                std::ostream& = std::cout);
   void filterMCTracklets();
   void validateTracklets();
 
@@ -88,8 +98,12 @@ class Vertexer
   // \debug
 
  private:
+  static void convertVertices(const std::vector<lightVertex>& lightVertices, std::vector<Vertex>& vertices);
+
   std::uint32_t mROframe = 0;
   VertexerTraits* mTraits = nullptr;
+  int mNThreads = 1;
+  std::vector<std::unique_ptr<VertexerTraits>> mBatchTraits; /// per thread copies of the CPU traits used by clustersToVerticesBatch
 };
 
 #ifdef _ALLOW_DEBUG_TREES_ITS_
@@ -139,14 +153,19 @@ inline void Vertexer::validateTracklets()
 inline std::vector<Vertex> Vertexer::exportVertices()
 {
   std::vector<Vertex> vertices;
-  for (auto& vertex : mTraits->getVertices()) {
+  convertVertices(mTraits->getVertices(), vertices);
+  return vertices;
+}
+
+inline void Vertexer::convertVertices(const std::vector<lightVertex>& lightVertices, std::vector<Vertex>& vertices)
+{
+  for (auto& vertex : lightVertices) {
     if (fair::Logger::Logging(fair::Severity::info)) {
       std::cout << "\t\tFound vertex with: " << std::setw(6) << vertex.mContributors << " contributors" << std::endl;
     }
     vertices.emplace_back(o2::math_utils::Point3D<float>(vertex.mX, vertex.mY, vertex.mZ), vertex.mRMS2, vertex.mContributors, vertex.mAvgDistance2);
     vertices.back().setTimeStamp(vertex.mTimeStamp);
   }
-  return vertices;
 }
 
 template <typename... T>
@@ -26,6 +26,7 @@
 #include "DataFormatsITSMFT/CompCluster.h"
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 #include "ITSBase/GeometryTGeo.h"
+#include "ITSMFTBase/SegmentationAlpide.h"
 #include "ITStracking/Constants.h"
 #include "ITStracking/json.h"
 #include "MathUtils/Utils.h"
@@ -56,15 +57,26 @@ void ioutils::convertCompactClusters(gsl::span<const itsmft::CompClusterExt> clu
                                      const itsmft::TopologyDictionary& dict)
 {
   GeometryTGeo* geom = GeometryTGeo::Instance();
+  // parameters of all topologies in one contiguous array, gathered by pattern ID
+  std::vector<itsmft::ClusterParams> paramsLocal;
+  const auto* params = dict.getClusterParams().data();
+  if ((int)dict.getClusterParams().size() != dict.getSize()) { // dictionary stored before the parameters were introduced
+    dict.getClusterParams(paramsLocal);
+    params = paramsLocal.data();
+  }
+  output.reserve(output.size() + clusters.size());
   for (auto& c : clusters) {
     auto pattID = c.getPatternID();
     o2::math_utils::Point3D<float> locXYZ;
     float sigmaY2 = ioutils::DefClusError2Row, sigmaZ2 = ioutils::DefClusError2Col, sigmaYZ = 0; //Dummy COG errors (about half pixel size)
     if (pattID != itsmft::CompCluster::InvalidPatternID) {
-      sigmaY2 = dict.getErr2X(pattID);
-      sigmaZ2 = dict.getErr2Z(pattID);
-      if (!dict.isGroup(pattID)) {
-        locXYZ = dict.getClusterCoordinates(c);
+      const auto& par = params[pattID];
+      sigmaY2 = par.mErr2X;
+      sigmaZ2 = par.mErr2Z;
+      if (!par.mIsGroup) {
+        o2::itsmft::SegmentationAlpide::detectorToLocalUnchecked(c.getRow(), c.getCol(), locXYZ);
+        locXYZ.SetX(locXYZ.X() + par.mXCOG);
+        locXYZ.SetZ(locXYZ.Z() + par.mZCOG);
       } else {
         o2::itsmft::ClusterPattern patt(pattIt);
         locXYZ = dict.getClusterCoordinates(c, patt);
@@ -15,6 +15,7 @@
 
 #include "ITStracking/PrimaryVertexContext.h"
 
+#include <fmt/format.h>
 #include <iostream>
 
 namespace o2
@@ -22,6 +23,42 @@ namespace o2
 namespace its
 {
 
+namespace
+{
+template <typename T>
+size_t getCapacityBytes(const std::vector<T>& vec)
+{
+  return vec.capacity() * sizeof(T);
+}
+
+size_t getCapacityBytes(const std::vector<bool>& vec)
+{
+  return vec.capacity() / 8;
+}
+
+template <typename T>
+size_t getCapacityBytes(const std::vector<std::vector<T>>& vec)
+{
+  size_t bytes = vec.capacity() * sizeof(std::vector<T>);
+  for (const auto& v : vec) {
+    bytes += getCapacityBytes(v);
+  }
+  return bytes;
+}
+} // namespace
+
+size_t PrimaryVertexContext::getMemoryUsage() const
+{
+  size_t bytes = getCapacityBytes(mMinR) + getCapacityBytes(mMaxR) + getCapacityBytes(mClusters) + getCapacityBytes(mUsedClusters) +
+                 getCapacityBytes(mCells) + getCapacityBytes(mCellsLookupTable) + getCapacityBytes(mCellsNeighbours) +
+                 getCapacityBytes(mRoads) + getCapacityBytes(mIndexTables) + getCapacityBytes(mTracklets) +
+                 getCapacityBytes(mTrackletsLookupTable) + getCapacityBytes(mRoadLabels);
+  for (const auto& soa : mClustersSoA) {
+    bytes += getCapacityBytes(soa.zCoordinate) + getCapacityBytes(soa.rCoordinate) + getCapacityBytes(soa.phiCoordinate);
+  }
+  return bytes;
+}
+
 void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const TrackingParameters& trkParam,
                                       const std::vector<std::vector<Cluster>>& cl, const std::array<float, 3>& pVtx, const int iteration)
 {
@@ -42,6 +79,7 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
     mMinR.resize(trkParam.NLayers, 10000.);
     mMaxR.resize(trkParam.NLayers, -1.);
     mClusters.resize(trkParam.NLayers);
+    mClustersSoA.resize(trkParam.NLayers);
     mUsedClusters.resize(trkParam.NLayers);
     mCells.resize(trkParam.CellsPerRoad());
     mCellsLookupTable.resize(trkParam.CellsPerRoad() - 1);
@@ -52,6 +90,7 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
     mIndexTableUtils.setTrackingParameters(trkParam);
 
     std::vector<int> clsPerBin(trkParam.PhiBins * trkParam.ZBins, 0);
+    std::vector<int> lutPerBin(clsPerBin.size());
     for (unsigned int iLayer{0}; iLayer < mClusters.size(); ++iLayer) {
 
       const auto& currentLayer{cl[iLayer]};
@@ -59,6 +98,7 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
 
       mClusters[iLayer].clear();
       mClusters[iLayer].resize(clustersNum);
+      mClustersSoA[iLayer].resize(clustersNum);
       mUsedClusters[iLayer].clear();
       mUsedClusters[iLayer].resize(clustersNum, false);
 
@@ -87,7 +127,6 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
         h.ind = clsPerBin[bin]++;
       }
 
-      std::vector<int> lutPerBin(clsPerBin.size());
       lutPerBin[0] = 0;
       for (unsigned int iB{1}; iB < lutPerBin.size(); ++iB) {
         lutPerBin[iB] = lutPerBin[iB - 1] + clsPerBin[iB - 1];
@@ -95,11 +134,16 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
 
       for (int iCluster{0}; iCluster < clustersNum; ++iCluster) {
         ClusterHelper& h = cHelper[iCluster];
-        Cluster& c = mClusters[iLayer][lutPerBin[h.bin] + h.ind];
+        const int index{lutPerBin[h.bin] + h.ind};
+        Cluster& c = mClusters[iLayer][index];
         c = currentLayer[iCluster];
         c.phiCoordinate = h.phi;
         c.rCoordinate = h.r;
         c.indexTableBinIndex = h.bin;
+        auto& soa = mClustersSoA[iLayer];
+        soa.zCoordinate[index] = c.zCoordinate;
+        soa.rCoordinate[index] = h.r;
+        soa.phiCoordinate[index] = h.phi;
       }
 
       if (iLayer > 0) {
@@ -125,6 +169,7 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
                   cl[iLayer + 2].size());
 
       if (cellsMemorySize > mCells[iLayer].capacity()) {
+        checkMemoryBudget(memParam, static_cast<size_t>(cellsMemorySize - mCells[iLayer].capacity()) * sizeof(Cell), "cells", iLayer);
         mCells[iLayer].reserve(cellsMemorySize);
       }
     }
@@ -150,6 +195,7 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
                                             cl[iLayer + 1].size());
 
       if (trackletsMemorySize > mTracklets[iLayer].capacity()) {
+        checkMemoryBudget(memParam, static_cast<size_t>(trackletsMemorySize - mTracklets[iLayer].capacity()) * sizeof(Tracklet), "tracklets", iLayer);
         mTracklets[iLayer].reserve(trackletsMemorySize);
       }
     }
@@ -161,5 +207,16 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
   }
 }
 
+void PrimaryVertexContext::checkMemoryBudget(const MemoryParameters& memParam, size_t bytes, const char* buffer, int layer) const
+{
+  if (memParam.MaxMemory) {
+    const size_t usage = getMemoryUsage();
+    if (usage + bytes > memParam.MaxMemory) {
+      throw MemoryBudgetExceeded(fmt::format("reserving {} B for the {} of L{} on top of {} B exceeds the budget of {} B",
+                                             bytes, buffer, layer, usage, memParam.MaxMemory));
+    }
+  }
+}
+
 } // namespace its
 } // namespace o2
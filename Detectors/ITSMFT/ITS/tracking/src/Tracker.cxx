@@ -24,6 +24,7 @@
 #include "ITStracking/TrackingConfigParam.h"
 
 #include "ReconstructionDataFormats/Track.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <dlfcn.h>
@@ -60,6 +61,7 @@ void Tracker::clustersToTracks(const ROframe& event, std::ostream& timeBenchmark
   const int verticesNum = event.getPrimaryVerticesNum();
   mTracks.clear();
   mTrackLabels.clear();
+  mMemoryBudgetExceeded = false;
 
   for (int iVertex = 0; iVertex < verticesNum; ++iVertex) {
 
@@ -76,15 +78,27 @@ void Tracker::clustersToTracks(const ROframe& event, std::ostream& timeBenchmark
       }
 
       mTraits->UpdateTrackingParameters(mTrkParams[iteration]);
+      mTraits->UpdateMemoryParameters(mMemParams[iteration]);
       /// Ugly hack -> Unifiy float3 definition in CPU and CUDA/HIP code
       int pass = iteration + iVertex; /// Do not reinitialise the context if we analyse pile-up events
       std::array<float, 3> pV = {event.getPrimaryVertex(iVertex).x, event.getPrimaryVertex(iVertex).y, event.getPrimaryVertex(iVertex).z};
-      total += evaluateTask(&Tracker::initialisePrimaryVertexContext, "Context initialisation",
-                            timeBenchmarkOutputStream, mMemParams[iteration], mTrkParams[iteration], event.getClusters(), pV, pass);
-      total += evaluateTask(&Tracker::computeTracklets, "Tracklet finding", timeBenchmarkOutputStream);
-      total += evaluateTask(&Tracker::computeCells, "Cell finding", timeBenchmarkOutputStream);
+      try {
+        total += evaluateTask(&Tracker::initialisePrimaryVertexContext, "Context initialisation",
+                              timeBenchmarkOutputStream, mMemParams[iteration], mTrkParams[iteration], event.getClusters(), pV, pass);
+        updateMemoryPeak(MemoryPhase::Context);
+        total += evaluateTask(&Tracker::computeTracklets, "Tracklet finding", timeBenchmarkOutputStream);
+        updateMemoryPeak(MemoryPhase::Tracklets);
+        total += evaluateTask(&Tracker::computeCells, "Cell finding", timeBenchmarkOutputStream);
+        updateMemoryPeak(MemoryPhase::Cells);
+      } catch (const MemoryBudgetExceeded& e) {
+        LOG(WARNING) << "ITS tracking iteration " << iteration << " of ROF " << mROFrame << " skipped: " << e.what();
+        mMemoryBudgetExceeded = true;
+        continue;
+      }
       total += evaluateTask(&Tracker::findCellsNeighbours, "Neighbour finding", timeBenchmarkOutputStream, iteration);
+      updateMemoryPeak(MemoryPhase::Neighbours);
       total += evaluateTask(&Tracker::findRoads, "Road finding", timeBenchmarkOutputStream, iteration);
+      updateMemoryPeak(MemoryPhase::Roads);
       total += evaluateTask(&Tracker::findTracks, "Track finding", timeBenchmarkOutputStream, event);
     }
     if (constants::DoTimeBenchmarks && fair::Logger::Logging(fair::Severity::info)) {
@@ -99,6 +113,12 @@ void Tracker::clustersToTracks(const ROframe& event, std::ostream& timeBenchmark
   }
 }
 
+void Tracker::updateMemoryPeak(MemoryPhase phase)
+{
+  auto& peak = mMemoryPeaks[static_cast<int>(phase)];
+  peak = std::max(peak, mPrimaryVertexContext->getMemoryUsage());
+}
+
 void Tracker::computeTracklets()
 {
   mTraits->computeLayerTracklets();
@@ -648,9 +668,16 @@ track::TrackParCov Tracker::buildTrackSeed(const Cluster& cluster1, const Cluste
 void Tracker::getGlobalConfiguration()
 {
   auto& tc = o2::its::TrackerParamConfig::Instance();
+  if (tc.maxMemory) {
+    for (auto& memPar : mMemParams) {
+      memPar.MaxMemory = tc.maxMemory;
+    }
+  }
   if (tc.useMatCorrTGeo) {
     setCorrType(o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrTGeo);
   }
+  mTraits->setNThreads(tc.nThreads);
+  mNThreads = mTraits->getNThreads();
 }
 
 } // namespace its
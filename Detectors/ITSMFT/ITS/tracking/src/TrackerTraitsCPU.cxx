@@ -22,96 +22,167 @@
 #include "ITStracking/Tracklet.h"
 #include <fmt/format.h>
 #include "ReconstructionDataFormats/Track.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
 
 #include "GPUCommonMath.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace its
 {
 
+namespace
+{
+/// Number of chunks the per-layer loops are split into: a few per thread for a better load balancing,
+/// while the chunks are always merged in their natural order to reproduce the serial output.
+int getNChunks(int nThreads, int nEntries)
+{
+  return nThreads > 1 ? std::max(1, std::min(nEntries, 4 * nThreads)) : 1;
+}
+
+/// Appends the chunks output to @a out in the chunks order, updating the lookup table with the index of the
+/// first element created by each entry of the chunk, if not set yet
+template <typename T>
+bool mergeChunks(std::vector<T>& out, std::vector<std::vector<T>>& chunks,
+                 const std::vector<std::vector<std::pair<int, int>>>& firstIndices, int nChunks, std::vector<int>* lookupTable,
+                 size_t availableMemory)
+{
+  size_t nTot = out.size();
+  for (int iChunk{0}; iChunk < nChunks; ++iChunk) {
+    nTot += chunks[iChunk].size();
+  }
+  if (nTot > out.capacity()) {
+    if ((nTot - out.capacity()) * sizeof(T) > availableMemory) {
+      return false;
+    }
+    out.reserve(nTot);
+  }
+  for (int iChunk{0}; iChunk < nChunks; ++iChunk) {
+    const int offset = out.size();
+    if (lookupTable) {
+      for (const auto& first : firstIndices[iChunk]) {
+        if ((*lookupTable)[first.first] == constants::its::UnusedIndex) {
+          (*lookupTable)[first.first] = offset + first.second;
+        }
+      }
+    }
+    for (const auto& entry : chunks[iChunk]) { // no range insert: Cell is not assignable
+      out.push_back(entry);
+    }
+    chunks[iChunk].clear();
+  }
+  return true;
+}
+} // namespace
+
+template <typename T>
+bool TrackerTraitsCPU::MemoryBudget::reserveNext(std::vector<T>& vec)
+{
+  if (vec.size() < vec.capacity()) {
+    return true;
+  }
+  size_t available = mAvailable.load();
+  size_t newCapacity;
+  do {
+    newCapacity = std::min(std::max<size_t>(2 * vec.capacity(), 64), vec.capacity() + available / sizeof(T));
+    if (newCapacity == vec.capacity()) {
+      return false;
+    }
+  } while (!mAvailable.compare_exchange_weak(available, available - (newCapacity - vec.capacity()) * sizeof(T)));
+  vec.reserve(newCapacity);
+  return true;
+}
+
+size_t TrackerTraitsCPU::getAvailableMemory(const char* phase, int iLayer) const
+{
+  if (!mMemParams.MaxMemory) {
+    return std::numeric_limits<size_t>::max();
+  }
+  size_t usage = mPrimaryVertexContext->getMemoryUsage();
+  for (const auto& buffer : mSelectedClusters) {
+    usage += buffer.capacity();
+  }
+  for (const auto& buffer : mTrackletsBuffers) {
+    usage += buffer.capacity() * sizeof(Tracklet);
+  }
+  for (const auto& buffer : mCellsBuffers) {
+    usage += buffer.capacity() * sizeof(Cell);
+  }
+  for (const auto& buffer : mFirstIndicesBuffers) {
+    usage += buffer.capacity() * sizeof(std::pair<int, int>);
+  }
+  if (usage >= mMemParams.MaxMemory) {
+    throw MemoryBudgetExceeded(fmt::format("{} of L{}: {} B used, budget {} B", phase, iLayer, usage, mMemParams.MaxMemory));
+  }
+  return mMemParams.MaxMemory - usage;
+}
+
 void TrackerTraitsCPU::computeLayerTracklets()
 {
   PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  const int nThreads = std::max(1, mNThreads);
+  if (int(mSelectedClusters.size()) < nThreads) {
+    mSelectedClusters.resize(nThreads);
+  }
   for (int iLayer{0}; iLayer < mTrkParams.TrackletsPerRoad(); ++iLayer) {
     if (primaryVertexContext->getClusters()[iLayer].empty() || primaryVertexContext->getClusters()[iLayer + 1].empty()) {
       continue;
     }
 
-    const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
     const int currentLayerClustersNum{static_cast<int>(primaryVertexContext->getClusters()[iLayer].size())};
-
-    for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
-      const Cluster& currentCluster{primaryVertexContext->getClusters()[iLayer][iCluster]};
-
-      if (primaryVertexContext->isClusterUsed(iLayer, currentCluster.clusterId)) {
-        continue;
+    auto& tracklets = primaryVertexContext->getTracklets()[iLayer];
+    std::vector<int>* lookupTable = iLayer > 0 ? &primaryVertexContext->getTrackletsLookupTable()[iLayer - 1] : nullptr;
+    const int nChunks = getNChunks(nThreads, currentLayerClustersNum);
+    bool withinBudget{true};
+
+    if (nChunks == 1) {
+      mFirstIndicesBuffers.resize(1);
+      mFirstIndicesBuffers[0].clear();
+      MemoryBudget budget{getAvailableMemory("tracklet finding", iLayer)};
+      withinBudget = computeLayerTrackletsRange(iLayer, 0, currentLayerClustersNum, tracklets, mFirstIndicesBuffers[0], mSelectedClusters[0], budget);
+      if (lookupTable) {
+        for (const auto& first : mFirstIndicesBuffers[0]) {
+          if ((*lookupTable)[first.first] == constants::its::UnusedIndex) {
+            (*lookupTable)[first.first] = first.second;
+          }
+        }
       }
-
-      const float tanLambda{(currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate};
-      const float zAtRmin{tanLambda * (mPrimaryVertexContext->getMinR(iLayer + 1) -
-                                       currentCluster.rCoordinate) +
-                          currentCluster.zCoordinate};
-      const float zAtRmax{tanLambda * (mPrimaryVertexContext->getMaxR(iLayer + 1) -
-                                       currentCluster.rCoordinate) +
-                          currentCluster.zCoordinate};
-
-      const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
-                                              mTrkParams.TrackletMaxDeltaZ[iLayer], mTrkParams.TrackletMaxDeltaPhi)};
-
-      if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
-        continue;
+    } else {
+      if (int(mTrackletsBuffers.size()) < nChunks) {
+        mTrackletsBuffers.resize(nChunks);
       }
-
-      int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
-
-      if (phiBinsNum < 0) {
-        phiBinsNum += mTrkParams.PhiBins;
+      if (int(mFirstIndicesBuffers.size()) < nChunks) {
+        mFirstIndicesBuffers.resize(nChunks);
       }
-
-      for (int iPhiBin{selectedBinsRect.y}, iPhiCount{0}; iPhiCount < phiBinsNum;
-           iPhiBin = ++iPhiBin == mTrkParams.PhiBins ? 0 : iPhiBin, iPhiCount++) {
-        const int firstBinIndex{primaryVertexContext->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
-        const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
-        const int firstRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][firstBinIndex];
-        const int maxRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][maxBinIndex];
-
-        for (int iNextLayerCluster{firstRowClusterIndex}; iNextLayerCluster < maxRowClusterIndex;
-             ++iNextLayerCluster) {
-
-          if (iNextLayerCluster >= (int)primaryVertexContext->getClusters()[iLayer + 1].size()) {
-            break;
-          }
-
-          const Cluster& nextCluster{primaryVertexContext->getClusters()[iLayer + 1][iNextLayerCluster]};
-
-          if (primaryVertexContext->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
-            continue;
-          }
-
-          const float deltaZ{o2::gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.rCoordinate - currentCluster.rCoordinate) +
-                                                         currentCluster.zCoordinate - nextCluster.zCoordinate)};
-          const float deltaPhi{o2::gpu::GPUCommonMath::Abs(currentCluster.phiCoordinate - nextCluster.phiCoordinate)};
-
-          if (deltaZ < mTrkParams.TrackletMaxDeltaZ[iLayer] &&
-              (deltaPhi < mTrkParams.TrackletMaxDeltaPhi ||
-               o2::gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < mTrkParams.TrackletMaxDeltaPhi)) {
-
-            if (iLayer > 0 &&
-                primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] == constants::its::UnusedIndex) {
-
-              primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] =
-                primaryVertexContext->getTracklets()[iLayer].size();
-            }
-
-            primaryVertexContext->getTracklets()[iLayer].emplace_back(iCluster, iNextLayerCluster, currentCluster,
-                                                                      nextCluster);
-          }
-        }
+      MemoryBudget budget{getAvailableMemory("tracklet finding", iLayer)};
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads) reduction(&& : withinBudget)
+#endif
+      for (int iChunk = 0; iChunk < nChunks; ++iChunk) {
+#ifdef WITH_OPENMP
+        const int iThread = omp_get_thread_num();
+#else
+        const int iThread = 0;
+#endif
+        const int firstCluster = (long(currentLayerClustersNum) * iChunk) / nChunks;
+        const int lastCluster = (long(currentLayerClustersNum) * (iChunk + 1)) / nChunks;
+        mTrackletsBuffers[iChunk].clear();
+        mFirstIndicesBuffers[iChunk].clear();
+        withinBudget = computeLayerTrackletsRange(iLayer, firstCluster, lastCluster, mTrackletsBuffers[iChunk], mFirstIndicesBuffers[iChunk], mSelectedClusters[iThread], budget) && withinBudget;
       }
+      withinBudget = withinBudget && mergeChunks(tracklets, mTrackletsBuffers, mFirstIndicesBuffers, nChunks, lookupTable, getAvailableMemory("tracklet finding", iLayer));
+    }
+    if (!withinBudget) {
+      throw MemoryBudgetExceeded(fmt::format("tracklet finding of L{} exceeds the budget of {} B", iLayer, mMemParams.MaxMemory));
     }
+
     if (iLayer > 0 && iLayer < mTrkParams.TrackletsPerRoad() - 1 &&
         primaryVertexContext->getTracklets()[iLayer].size() > primaryVertexContext->getCellsLookupTable()[iLayer - 1].size()) {
       throw std::runtime_error(fmt::format("not enough memory in the CellsLookupTable, increase the tracklet memory coefficients: {} tracklets on L{}, lookup table size {} on L{}",
@@ -127,123 +198,149 @@ void TrackerTraitsCPU::computeLayerTracklets()
 #endif
 }
 
-void TrackerTraitsCPU::computeLayerCells()
+bool TrackerTraitsCPU::computeLayerTrackletsRange(int iLayer, int firstCluster, int lastCluster, std::vector<Tracklet>& tracklets,
+                                                  std::vector<std::pair<int, int>>& firstTracklets, std::vector<uint8_t>& selectedClusters, MemoryBudget& budget)
 {
   PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
-  for (int iLayer{0}; iLayer < mTrkParams.CellsPerRoad(); ++iLayer) {
+  const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
+  const int nextLayerClustersNum{static_cast<int>(primaryVertexContext->getClusters()[iLayer + 1].size())};
+  const auto& nextLayerClusters = primaryVertexContext->getClustersSoA()[iLayer + 1];
+  const float maxDeltaZ{mTrkParams.TrackletMaxDeltaZ[iLayer]};
+  const float maxDeltaPhi{mTrkParams.TrackletMaxDeltaPhi};
 
-    if (primaryVertexContext->getTracklets()[iLayer + 1].empty() ||
-        primaryVertexContext->getTracklets()[iLayer].empty()) {
+  for (int iCluster{firstCluster}; iCluster < lastCluster; ++iCluster) {
+    const Cluster& currentCluster{primaryVertexContext->getClusters()[iLayer][iCluster]};
 
-      return;
+    if (primaryVertexContext->isClusterUsed(iLayer, currentCluster.clusterId)) {
+      continue;
     }
 
-    const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
-    const int currentLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer].size())};
+    const float tanLambda{(currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate};
+    const float zAtRmin{tanLambda * (mPrimaryVertexContext->getMinR(iLayer + 1) -
+                                     currentCluster.rCoordinate) +
+                        currentCluster.zCoordinate};
+    const float zAtRmax{tanLambda * (mPrimaryVertexContext->getMaxR(iLayer + 1) -
+                                     currentCluster.rCoordinate) +
+                        currentCluster.zCoordinate};
 
-    for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+    const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
+                                            mTrkParams.TrackletMaxDeltaZ[iLayer], mTrkParams.TrackletMaxDeltaPhi)};
+
+    if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
+      continue;
+    }
 
-      const Tracklet& currentTracklet{primaryVertexContext->getTracklets()[iLayer][iTracklet]};
-      const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
-      const int nextLayerFirstTrackletIndex{
-        primaryVertexContext->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
+    int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
 
-      if (nextLayerFirstTrackletIndex == constants::its::UnusedIndex) {
+    if (phiBinsNum < 0) {
+      phiBinsNum += mTrkParams.PhiBins;
+    }
 
+    bool firstTrackletFound{false};
+    for (int iPhiBin{selectedBinsRect.y}, iPhiCount{0}; iPhiCount < phiBinsNum;
+         iPhiBin = ++iPhiBin == mTrkParams.PhiBins ? 0 : iPhiBin, iPhiCount++) {
+      const int firstBinIndex{primaryVertexContext->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
+      const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
+      const int firstRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][firstBinIndex];
+      const int maxRowClusterIndex = std::min(primaryVertexContext->getIndexTables()[iLayer][maxBinIndex], nextLayerClustersNum);
+      const int nCandidates{maxRowClusterIndex - firstRowClusterIndex};
+      if (nCandidates <= 0) {
         continue;
       }
+      if (int(selectedClusters.size()) < nCandidates) {
+        selectedClusters.resize(nCandidates);
+      }
+
+      // branchless preselection on the contiguous range of the next layer clusters, can be auto-vectorized
+      const float* zNext = nextLayerClusters.zCoordinate.data() + firstRowClusterIndex;
+      const float* rNext = nextLayerClusters.rCoordinate.data() + firstRowClusterIndex;
+      const float* phiNext = nextLayerClusters.phiCoordinate.data() + firstRowClusterIndex;
+      uint8_t* selected = selectedClusters.data();
+      for (int iCandidate{0}; iCandidate < nCandidates; ++iCandidate) {
+        const float deltaZ{o2::gpu::GPUCommonMath::Abs(tanLambda * (rNext[iCandidate] - currentCluster.rCoordinate) +
+                                                       currentCluster.zCoordinate - zNext[iCandidate])};
+        const float deltaPhi{o2::gpu::GPUCommonMath::Abs(currentCluster.phiCoordinate - phiNext[iCandidate])};
+        selected[iCandidate] = (deltaZ < maxDeltaZ) & ((deltaPhi < maxDeltaPhi) | (o2::gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < maxDeltaPhi));
+      }
+
+      for (int iCandidate{0}; iCandidate < nCandidates; ++iCandidate) {
+        if (!selected[iCandidate]) {
+          continue;
+        }
+        const int iNextLayerCluster{firstRowClusterIndex + iCandidate};
+        const Cluster& nextCluster{primaryVertexContext->getClusters()[iLayer + 1][iNextLayerCluster]};
+
+        if (primaryVertexContext->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
+          continue;
+        }
+
+        if (!budget.reserveNext(tracklets) || (iLayer > 0 && !firstTrackletFound && !budget.reserveNext(firstTracklets))) {
+          return false;
+        }
+        if (iLayer > 0 && !firstTrackletFound) {
+          firstTracklets.emplace_back(iCluster, tracklets.size());
+          firstTrackletFound = true;
+        }
+
+        tracklets.emplace_back(iCluster, iNextLayerCluster, currentCluster, nextCluster);
+      }
+    }
+  }
+  return true;
+}
+
+void TrackerTraitsCPU::computeLayerCells()
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  const int nThreads = std::max(1, mNThreads);
+  for (int iLayer{0}; iLayer < mTrkParams.CellsPerRoad(); ++iLayer) {
+
+    if (primaryVertexContext->getTracklets()[iLayer + 1].empty() ||
+        primaryVertexContext->getTracklets()[iLayer].empty()) {
+
+      return;
+    }
 
-      const Cluster& firstCellCluster{primaryVertexContext->getClusters()[iLayer][currentTracklet.firstClusterIndex]};
-      const Cluster& secondCellCluster{
-        primaryVertexContext->getClusters()[iLayer + 1][currentTracklet.secondClusterIndex]};
-      const float firstCellClusterQuadraticRCoordinate{firstCellCluster.rCoordinate * firstCellCluster.rCoordinate};
-      const float secondCellClusterQuadraticRCoordinate{secondCellCluster.rCoordinate *
-                                                        secondCellCluster.rCoordinate};
-      const float3 firstDeltaVector{secondCellCluster.xCoordinate - firstCellCluster.xCoordinate,
-                                    secondCellCluster.yCoordinate - firstCellCluster.yCoordinate,
-                                    secondCellClusterQuadraticRCoordinate - firstCellClusterQuadraticRCoordinate};
-      const int nextLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer + 1].size())};
-
-      for (int iNextLayerTracklet{nextLayerFirstTrackletIndex};
-           iNextLayerTracklet < nextLayerTrackletsNum &&
-           primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet].firstClusterIndex ==
-             nextLayerClusterIndex;
-           ++iNextLayerTracklet) {
-
-        const Tracklet& nextTracklet{primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet]};
-        const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
-        const float deltaPhi{std::abs(currentTracklet.phiCoordinate - nextTracklet.phiCoordinate)};
-
-        if (deltaTanLambda < mTrkParams.CellMaxDeltaTanLambda &&
-            (deltaPhi < mTrkParams.CellMaxDeltaPhi ||
-             std::abs(deltaPhi - constants::math::TwoPi) < mTrkParams.CellMaxDeltaPhi)) {
-
-          const float averageTanLambda{0.5f * (currentTracklet.tanLambda + nextTracklet.tanLambda)};
-          const float directionZIntersection{-averageTanLambda * firstCellCluster.rCoordinate +
-                                             firstCellCluster.zCoordinate};
-          const float deltaZ{std::abs(directionZIntersection - primaryVertex.z)};
-
-          if (deltaZ < mTrkParams.CellMaxDeltaZ[iLayer]) {
-
-            const Cluster& thirdCellCluster{
-              primaryVertexContext->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex]};
-
-            const float thirdCellClusterQuadraticRCoordinate{thirdCellCluster.rCoordinate *
-                                                             thirdCellCluster.rCoordinate};
-
-            const float3 secondDeltaVector{thirdCellCluster.xCoordinate - firstCellCluster.xCoordinate,
-                                           thirdCellCluster.yCoordinate - firstCellCluster.yCoordinate,
-                                           thirdCellClusterQuadraticRCoordinate -
-                                             firstCellClusterQuadraticRCoordinate};
-
-            float3 cellPlaneNormalVector{math_utils::crossProduct(firstDeltaVector, secondDeltaVector)};
-
-            const float vectorNorm{std::sqrt(cellPlaneNormalVector.x * cellPlaneNormalVector.x +
-                                             cellPlaneNormalVector.y * cellPlaneNormalVector.y +
-                                             cellPlaneNormalVector.z * cellPlaneNormalVector.z)};
-
-            if (vectorNorm < constants::math::FloatMinThreshold ||
-                std::abs(cellPlaneNormalVector.z) < constants::math::FloatMinThreshold) {
-
-              continue;
-            }
-
-            const float inverseVectorNorm{1.0f / vectorNorm};
-            const float3 normalizedPlaneVector{cellPlaneNormalVector.x * inverseVectorNorm,
-                                               cellPlaneNormalVector.y * inverseVectorNorm,
-                                               cellPlaneNormalVector.z * inverseVectorNorm};
-            const float planeDistance{-normalizedPlaneVector.x * (secondCellCluster.xCoordinate - primaryVertex.x) -
-                                      (normalizedPlaneVector.y * secondCellCluster.yCoordinate - primaryVertex.y) -
-                                      normalizedPlaneVector.z * secondCellClusterQuadraticRCoordinate};
-            const float normalizedPlaneVectorQuadraticZCoordinate{normalizedPlaneVector.z * normalizedPlaneVector.z};
-            const float cellTrajectoryRadius{std::sqrt(
-              (1.0f - normalizedPlaneVectorQuadraticZCoordinate - 4.0f * planeDistance * normalizedPlaneVector.z) /
-              (4.0f * normalizedPlaneVectorQuadraticZCoordinate))};
-            const float2 circleCenter{-0.5f * normalizedPlaneVector.x / normalizedPlaneVector.z,
-                                      -0.5f * normalizedPlaneVector.y / normalizedPlaneVector.z};
-            const float distanceOfClosestApproach{std::abs(
-              cellTrajectoryRadius - std::sqrt(circleCenter.x * circleCenter.x + circleCenter.y * circleCenter.y))};
-
-            if (distanceOfClosestApproach >
-                mTrkParams.CellMaxDCA[iLayer]) {
-
-              continue;
-            }
-
-            const float cellTrajectoryCurvature{1.0f / cellTrajectoryRadius};
-            if (iLayer > 0 &&
-                primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] == constants::its::UnusedIndex) {
-
-              primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] =
-                primaryVertexContext->getCells()[iLayer].size();
-            }
-
-            primaryVertexContext->getCells()[iLayer].emplace_back(
-              currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
-              iTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
+    const int currentLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer].size())};
+    auto& cells = primaryVertexContext->getCells()[iLayer];
+    std::vector<int>* lookupTable = iLayer > 0 ? &primaryVertexContext->getCellsLookupTable()[iLayer - 1] : nullptr;
+    const int nChunks = getNChunks(nThreads, currentLayerTrackletsNum);
+    bool withinBudget{true};
+
+    if (nChunks == 1) {
+      mFirstIndicesBuffers.resize(1);
+      mFirstIndicesBuffers[0].clear();
+      MemoryBudget budget{getAvailableMemory("cell finding", iLayer)};
+      withinBudget = computeLayerCellsRange(iLayer, 0, currentLayerTrackletsNum, cells, mFirstIndicesBuffers[0], budget);
+      if (lookupTable) {
+        for (const auto& first : mFirstIndicesBuffers[0]) {
+          if ((*lookupTable)[first.first] == constants::its::UnusedIndex) {
+            (*lookupTable)[first.first] = first.second;
           }
         }
       }
+    } else {
+      if (int(mCellsBuffers.size()) < nChunks) {
+        mCellsBuffers.resize(nChunks);
+      }
+      if (int(mFirstIndicesBuffers.size()) < nChunks) {
+        mFirstIndicesBuffers.resize(nChunks);
+      }
+      MemoryBudget budget{getAvailableMemory("cell finding", iLayer)};
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads) reduction(&& : withinBudget)
+#endif
+      for (int iChunk = 0; iChunk < nChunks; ++iChunk) {
+        const int firstTracklet = (long(currentLayerTrackletsNum) * iChunk) / nChunks;
+        const int lastTracklet = (long(currentLayerTrackletsNum) * (iChunk + 1)) / nChunks;
+        mCellsBuffers[iChunk].clear();
+        mFirstIndicesBuffers[iChunk].clear();
+        withinBudget = computeLayerCellsRange(iLayer, firstTracklet, lastTracklet, mCellsBuffers[iChunk], mFirstIndicesBuffers[iChunk], budget) && withinBudget;
+      }
+      withinBudget = withinBudget && mergeChunks(cells, mCellsBuffers, mFirstIndicesBuffers, nChunks, lookupTable, getAvailableMemory("cell finding", iLayer));
+    }
+    if (!withinBudget) {
+      throw MemoryBudgetExceeded(fmt::format("cell finding of L{} exceeds the budget of {} B", iLayer, mMemParams.MaxMemory));
     }
   }
 #ifdef CA_DEBUG
@@ -255,6 +352,121 @@ void TrackerTraitsCPU::computeLayerCells()
 #endif
 }
 
+bool TrackerTraitsCPU::computeLayerCellsRange(int iLayer, int firstTracklet, int lastTracklet, std::vector<Cell>& cells,
+                                              std::vector<std::pair<int, int>>& firstCells, MemoryBudget& budget)
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
+
+  for (int iTracklet{firstTracklet}; iTracklet < lastTracklet; ++iTracklet) {
+
+    const Tracklet& currentTracklet{primaryVertexContext->getTracklets()[iLayer][iTracklet]};
+    const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
+    const int nextLayerFirstTrackletIndex{
+      primaryVertexContext->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
+
+    if (nextLayerFirstTrackletIndex == constants::its::UnusedIndex) {
+
+      continue;
+    }
+
+    const Cluster& firstCellCluster{primaryVertexContext->getClusters()[iLayer][currentTracklet.firstClusterIndex]};
+    const Cluster& secondCellCluster{
+      primaryVertexContext->getClusters()[iLayer + 1][currentTracklet.secondClusterIndex]};
+    const float firstCellClusterQuadraticRCoordinate{firstCellCluster.rCoordinate * firstCellCluster.rCoordinate};
+    const float secondCellClusterQuadraticRCoordinate{secondCellCluster.rCoordinate *
+                                                      secondCellCluster.rCoordinate};
+    const float3 firstDeltaVector{secondCellCluster.xCoordinate - firstCellCluster.xCoordinate,
+                                  secondCellCluster.yCoordinate - firstCellCluster.yCoordinate,
+                                  secondCellClusterQuadraticRCoordinate - firstCellClusterQuadraticRCoordinate};
+    const int nextLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer + 1].size())};
+    bool firstCellFound{false};
+
+    for (int iNextLayerTracklet{nextLayerFirstTrackletIndex};
+         iNextLayerTracklet < nextLayerTrackletsNum &&
+         primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet].firstClusterIndex ==
+           nextLayerClusterIndex;
+         ++iNextLayerTracklet) {
+
+      const Tracklet& nextTracklet{primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet]};
+      const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
+      const float deltaPhi{std::abs(currentTracklet.phiCoordinate - nextTracklet.phiCoordinate)};
+
+      if (deltaTanLambda < mTrkParams.CellMaxDeltaTanLambda &&
+          (deltaPhi < mTrkParams.CellMaxDeltaPhi ||
+           std::abs(deltaPhi - constants::math::TwoPi) < mTrkParams.CellMaxDeltaPhi)) {
+
+        const float averageTanLambda{0.5f * (currentTracklet.tanLambda + nextTracklet.tanLambda)};
+        const float directionZIntersection{-averageTanLambda * firstCellCluster.rCoordinate +
+                                           firstCellCluster.zCoordinate};
+        const float deltaZ{std::abs(directionZIntersection - primaryVertex.z)};
+
+        if (deltaZ < mTrkParams.CellMaxDeltaZ[iLayer]) {
+
+          const Cluster& thirdCellCluster{
+            primaryVertexContext->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex]};
+
+          const float thirdCellClusterQuadraticRCoordinate{thirdCellCluster.rCoordinate *
+                                                           thirdCellCluster.rCoordinate};
+
+          const float3 secondDeltaVector{thirdCellCluster.xCoordinate - firstCellCluster.xCoordinate,
+                                         thirdCellCluster.yCoordinate - firstCellCluster.yCoordinate,
+                                         thirdCellClusterQuadraticRCoordinate -
+                                           firstCellClusterQuadraticRCoordinate};
+
+          float3 cellPlaneNormalVector{math_utils::crossProduct(firstDeltaVector, secondDeltaVector)};
+
+          const float vectorNorm{std::sqrt(cellPlaneNormalVector.x * cellPlaneNormalVector.x +
+                                           cellPlaneNormalVector.y * cellPlaneNormalVector.y +
+                                           cellPlaneNormalVector.z * cellPlaneNormalVector.z)};
+
+          if (vectorNorm < constants::math::FloatMinThreshold ||
+              std::abs(cellPlaneNormalVector.z) < constants::math::FloatMinThreshold) {
+
+            continue;
+          }
+
+          const float inverseVectorNorm{1.0f / vectorNorm};
+          const float3 normalizedPlaneVector{cellPlaneNormalVector.x * inverseVectorNorm,
+                                             cellPlaneNormalVector.y * inverseVectorNorm,
+                                             cellPlaneNormalVector.z * inverseVectorNorm};
+          const float planeDistance{-normalizedPlaneVector.x * (secondCellCluster.xCoordinate - primaryVertex.x) -
+                                    (normalizedPlaneVector.y * secondCellCluster.yCoordinate - primaryVertex.y) -
+                                    normalizedPlaneVector.z * secondCellClusterQuadraticRCoordinate};
+          const float normalizedPlaneVectorQuadraticZCoordinate{normalizedPlaneVector.z * normalizedPlaneVector.z};
+          const float cellTrajectoryRadius{std::sqrt(
+            (1.0f - normalizedPlaneVectorQuadraticZCoordinate - 4.0f * planeDistance * normalizedPlaneVector.z) /
+            (4.0f * normalizedPlaneVectorQuadraticZCoordinate))};
+          const float2 circleCenter{-0.5f * normalizedPlaneVector.x / normalizedPlaneVector.z,
+                                    -0.5f * normalizedPlaneVector.y / normalizedPlaneVector.z};
+          const float distanceOfClosestApproach{std::abs(
+            cellTrajectoryRadius - std::sqrt(circleCenter.x * circleCenter.x + circleCenter.y * circleCenter.y))};
+
+          if (distanceOfClosestApproach >
+              mTrkParams.CellMaxDCA[iLayer]) {
+
+            continue;
+          }
+
+          const float cellTrajectoryCurvature{1.0f / cellTrajectoryRadius};
+          if (!budget.reserveNext(cells) || (iLayer > 0 && !firstCellFound && !budget.reserveNext(firstCells))) {
+            return false;
+          }
+          if (iLayer > 0 && !firstCellFound) {
+            firstCells.emplace_back(iTracklet, cells.size());
+            firstCellFound = true;
+          }
+
+          cells.emplace_back(
+            currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
+            iTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
+        }
+      }
+    }
+  }
+  return true;
+}
+
 void TrackerTraitsCPU::refitTracks(const std::vector<std::vector<TrackingFrameInfo>>& tf, std::vector<TrackITSExt>& tracks)
 {
   std::vector<const Cell*> cells;
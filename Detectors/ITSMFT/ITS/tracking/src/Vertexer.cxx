@@ -21,7 +21,13 @@
 #include "ITStracking/VertexerTraits.h"
 #include "ITStracking/TrackingConfigParam.h"
 
+#include <algorithm>
 #include <array>
+#include <typeinfo>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace o2
 {
@@ -50,6 +56,61 @@ float Vertexer::clustersToVertices(ROframe& event, const bool useMc, std::ostrea
   return total;
 }
 
+float Vertexer::clustersToVerticesBatch(gsl::span<ROframe> events, std::vector<std::vector<Vertex>>& vertices, int nThreads,
+                                        std::ostream& timeBenchmarkOutputStream)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  vertices.clear();
+  vertices.resize(events.size());
+  const int nEvents = events.size();
+  std::vector<std::vector<lightVertex>> lightVertices(nEvents);
+
+  // only the plain CPU traits can be replicated, the GPU ones and the debug streamers process the ROFs sequentially
+  bool useCopies = typeid(*mTraits) == typeid(VertexerTraits) && nThreads > 1 && nEvents > 1;
+#ifdef _ALLOW_DEBUG_TREES_ITS_
+  useCopies = false;
+#endif
+  if (useCopies) {
+    nThreads = std::min(nThreads, nEvents);
+    while (int(mBatchTraits.size()) < nThreads) {
+      mBatchTraits.emplace_back(std::make_unique<VertexerTraits>());
+    }
+    for (int iThread = 0; iThread < nThreads; iThread++) {
+      mBatchTraits[iThread]->updateVertexingParameters(mTraits->getVertexingParameters());
+    }
+  } else {
+    nThreads = 1;
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int iEvent = 0; iEvent < nEvents; iEvent++) {
+#ifdef WITH_OPENMP
+    const int iThread = omp_get_thread_num();
+#else
+    const int iThread = 0;
+#endif
+    VertexerTraits* traits = useCopies ? mBatchTraits[iThread].get() : mTraits;
+    traits->initialise(&events[iEvent]);
+    traits->computeTracklets();
+    traits->computeTrackletMatching();
+    traits->computeVertices();
+    lightVertices[iEvent] = traits->getVertices();
+  }
+
+  for (int iEvent = 0; iEvent < nEvents; iEvent++) {
+    convertVertices(lightVertices[iEvent], vertices[iEvent]);
+  }
+
+  std::chrono::duration<double, std::milli> diff_t{std::chrono::high_resolution_clock::now() - start};
+  if (constants::DoTimeBenchmarks && fair::Logger::Logging(fair::Severity::info)) {
+    timeBenchmarkOutputStream << std::setw(2) << " - "
+                              << "Vertexing of " << nEvents << " ROFs completed in: " << diff_t.count() << " ms using " << nThreads << " threads" << std::endl;
+  }
+  return diff_t.count();
+}
+
 void Vertexer::findVertices()
 {
   mTraits->computeVertices();
@@ -75,6 +136,7 @@ void Vertexer::getGlobalConfiguration()
   verPar.phiSpan = vc.phiSpan;
 
   mTraits->updateVertexingParameters(verPar);
+  mNThreads = vc.nThreads > 0 ? vc.nThreads : 1;
 }
 } // namespace its
 } // namespace o2
@@ -37,6 +37,7 @@
 
 #include "ITSReconstruction/FastMultEstConfig.h"
 #include "ITSReconstruction/FastMultEst.h"
+#include <Monitoring/Monitoring.h>
 #include <fmt/format.h>
 
 namespace o2
@@ -182,7 +183,6 @@ void TrackerDPL::run(ProcessingContext& pc)
   auto& irFrames = pc.outputs().make<std::vector<o2::dataformats::IRFrame>>(Output{"ITS", "IRFRAMES", 0, Lifetime::Timeframe});
 
   std::uint32_t roFrame = 0;
-  ROframe event(0, 7);
 
   bool continuous = mGRP->isDetContinuousReadOut("ITS");
   LOG(INFO) << "ITSTracker RO: continuous=" << continuous;
@@ -213,35 +213,63 @@ void TrackerDPL::run(ProcessingContext& pc)
     }
   };
 
+  // load all the ROFs of the TF in advance, so that their vertices are found in one batch
+  constexpr int EmptyROF = -2, RejectedROF = -1;
+  std::vector<int> rofEvents(rofs.size(), EmptyROF); // index of the event of every ROF in events if loaded
+  std::vector<ROframe> events;
+  events.reserve(rofs.size());
   gsl::span<const unsigned char>::iterator pattIt = patterns.begin();
-  for (auto& rof : rofs) {
+  for (size_t iRof = 0; iRof < rofs.size(); iRof++) {
+    const auto& rof = rofs[iRof];
+    auto& event = events.emplace_back(0, 7);
     int nclUsed = ioutils::loadROFrameData(rof, event, compClusters, pattIt, mDict, labels);
+    if (!nclUsed) {
+      events.pop_back();
+      continue;
+    }
+    LOG(INFO) << "ROframe: " << iRof << ", clusters loaded : " << nclUsed;
+    if (multEstConf.cutMultClusLow > 0 || multEstConf.cutMultClusHigh > 0) { // cut was requested
+      auto mult = multEst.process(rof.getROFData(compClusters));
+      if (mult < multEstConf.cutMultClusLow || mult > multEstConf.cutMultClusHigh) {
+        LOG(INFO) << "Estimated cluster mult. " << mult << " is outside of requested range "
+                  << multEstConf.cutMultClusLow << " : " << multEstConf.cutMultClusHigh << " | ROF " << rof.getBCData();
+        events.pop_back();
+        rofEvents[iRof] = RejectedROF;
+        continue;
+      }
+    }
+    rofEvents[iRof] = events.size() - 1;
+  }
+
+  int nROFsOverBudget = 0;
+  mTracker->resetMemoryPeaks();
+
+  std::vector<std::vector<Vertex>> vtxVecs;
+  if (mRunVertexer) {
+    mVertexer->clustersToVerticesBatch(events, vtxVecs, mVertexer->getNThreads());
+  }
+
+  for (size_t iRof = 0; iRof < rofs.size(); iRof++) {
+    auto& rof = rofs[iRof];
     // prepare in advance output ROFRecords, even if this ROF to be rejected
     int first = allTracks.size();
 
-    if (nclUsed) {
-      LOG(INFO) << "ROframe: " << roFrame << ", clusters loaded : " << nclUsed;
-
+    if (rofEvents[iRof] != EmptyROF) {
       // for vertices output
       auto& vtxROF = vertROFvec.emplace_back(rof); // register entry and number of vertices in the
       vtxROF.setFirstEntry(vertices.size());       // dedicated ROFRecord
       vtxROF.setNEntries(0);
 
-      if (multEstConf.cutMultClusLow > 0 || multEstConf.cutMultClusHigh > 0) { // cut was requested
-        auto mult = multEst.process(rof.getROFData(compClusters));
-        if (mult < multEstConf.cutMultClusLow || mult > multEstConf.cutMultClusHigh) {
-          LOG(INFO) << "Estimated cluster mult. " << mult << " is outside of requested range "
-                    << multEstConf.cutMultClusLow << " : " << multEstConf.cutMultClusHigh << " | ROF " << rof.getBCData();
-          rof.setFirstEntry(first);
-          rof.setNEntries(0);
-          continue;
-        }
+      if (rofEvents[iRof] == RejectedROF) {
+        rof.setFirstEntry(first);
+        rof.setNEntries(0);
+        continue;
       }
+      auto& event = events[rofEvents[iRof]];
 
       std::vector<Vertex> vtxVecLoc;
       if (mRunVertexer) {
-        mVertexer->clustersToVertices(event);
-        vtxVecLoc = mVertexer->exportVertices();
+        vtxVecLoc.swap(vtxVecs[rofEvents[iRof]]);
       }
 
       if (mRunVertexer && (multEstConf.cutMultVtxLow > 0 || multEstConf.cutMultVtxHigh > 0)) { // cut was requested
@@ -269,6 +297,10 @@ void TrackerDPL::run(ProcessingContext& pc)
       }
       mTracker->setROFrame(roFrame);
       mTracker->clustersToTracks(event);
+      if (mTracker->isMemoryBudgetExceeded()) {
+        LOG(WARNING) << "ITS tracking of ROF " << rof.getBCData() << " exceeded the memory budget, some iterations were skipped";
+        nROFsOverBudget++;
+      }
       tracks.swap(mTracker->getTracks());
       LOG(INFO) << "Found tracks: " << tracks.size();
       int number = tracks.size();
@@ -291,6 +323,11 @@ void TrackerDPL::run(ProcessingContext& pc)
   }
 
   LOG(INFO) << "ITSTracker pushed " << allTracks.size() << " tracks";
+  auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+  for (size_t iPhase = 0; iPhase < Tracker::MemoryPhaseNames.size(); iPhase++) {
+    monitoring.send(o2::monitoring::Metric{(uint64_t)mTracker->getMemoryPeaks()[iPhase], fmt::format("its-tracking-memory-peak-{}", Tracker::MemoryPhaseNames[iPhase])});
+  }
+  monitoring.send(o2::monitoring::Metric{nROFsOverBudget, "its-tracking-rofs-over-memory-budget"});
   if (mIsMC) {
     pc.outputs().snapshot(Output{"ITS", "TRACKSMCTR", 0, Lifetime::Timeframe}, allTrackLabels);
     pc.outputs().snapshot(Output{"ITS", "ITSTrackMC2ROF", 0, Lifetime::Timeframe}, mc2rofs);
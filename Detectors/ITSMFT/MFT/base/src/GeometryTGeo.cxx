@@ -415,6 +415,9 @@ void GeometryTGeo::fillMatrixCache(Int_t mask)
     Build(mask);
     return;
   }
+  if (readMatrixCache(mask)) { // all requested matrices are available in the node-local cache
+    return;
+  }
   // LOG(INFO) << "mask " << mask << " o2::math_utils::bit2Mask " << o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G) <<
   // FairLogger::endl;
   // build matrices
@@ -450,6 +453,7 @@ void GeometryTGeo::fillMatrixCache(Int_t mask)
       cacheT2G.setMatrix(Mat3D(mat), i);
     }
   }
+  writeMatrixCache();
 }
 
 //__________________________________________________________________________
@@ -19,6 +19,9 @@
 #include "MFTTracking/Cell.h"
 #include "MFTTracking/Constants.h"
 
+#include <cassert>
+#include <gsl/span>
+
 namespace o2
 {
 namespace mft
@@ -48,7 +51,8 @@ class Road
   template <typename... T>
   Cell& addCellInLayer(Int_t layer, T&&... args);
 
-  std::vector<Cell>& getCellsInLayer(Int_t);
+  gsl::span<Cell> getCellsInLayer(Int_t);
+  gsl::span<const Cell> getCellsInLayer(Int_t) const;
 
   void addLeftNeighbourToCell(const Int_t, const Int_t, const Int_t, const Int_t);
   void addRightNeighbourToCell(const Int_t, const Int_t, const Int_t, const Int_t);
@@ -64,27 +68,35 @@ class Road
  private:
   Int_t mRoadId;
   std::array<std::vector<Int_t>, constants::mft::LayersNumber> mClusterId;
-  std::array<std::vector<Cell>, (constants::mft::LayersNumber - 1)> mCell;
+  /// the cells of all layers in a single array: they are created
+  /// layer after layer, so the ones of a layer are contiguous
+  std::vector<Cell> mCells;
+  std::array<Int_t, (constants::mft::LayersNumber - 1)> mCellsBegin;
+  std::array<Int_t, (constants::mft::LayersNumber - 1)> mCellsEnd;
 };
 
 inline void Road::reset()
 {
   Int_t layer;
   for (layer = 0; layer < (constants::mft::LayersNumber - 1); ++layer) {
-    mCell[layer].clear();
     mClusterId[layer].clear();
   }
   mClusterId[layer].clear();
+  mCells.clear();
+  mCellsBegin.fill(0);
+  mCellsEnd.fill(0);
 }
 
 inline void Road::initialize()
 {
   Int_t layer;
   for (layer = 0; layer < (constants::mft::LayersNumber - 1); ++layer) {
-    mCell[layer].reserve(constants::mft::MaxCellsInRoad);
     mClusterId[layer].reserve(constants::mft::MaxPointsInRoad);
   }
   mClusterId[layer].reserve(constants::mft::MaxPointsInRoad);
+  mCells.reserve(constants::mft::MaxCellsInRoad * (constants::mft::LayersNumber - 1));
+  mCellsBegin.fill(0);
+  mCellsEnd.fill(0);
 }
 
 inline const Int_t Road::getNPointsInLayer(Int_t layer) const
@@ -108,53 +120,64 @@ inline void Road::getLength(Int_t& layer1, Int_t& layer2) const
 template <typename... T>
 Cell& Road::addCellInLayer(Int_t layer, T&&... values)
 {
-  mCell[layer].emplace_back(layer, std::forward<T>(values)...);
-  return mCell[layer].back();
+  if (mCellsBegin[layer] == mCellsEnd[layer]) {
+    mCellsBegin[layer] = mCellsEnd[layer] = mCells.size();
+  }
+  // the cells of a layer must be added all together
+  assert(mCellsEnd[layer] == mCells.size());
+  mCells.emplace_back(layer, std::forward<T>(values)...);
+  ++mCellsEnd[layer];
+  return mCells.back();
+}
+
+inline gsl::span<Cell> Road::getCellsInLayer(Int_t layer)
+{
+  return {mCells.data() + mCellsBegin[layer], static_cast<std::size_t>(mCellsEnd[layer] - mCellsBegin[layer])};
 }
 
-inline std::vector<Cell>& Road::getCellsInLayer(Int_t layer)
+inline gsl::span<const Cell> Road::getCellsInLayer(Int_t layer) const
 {
-  return mCell[layer];
+  return {mCells.data() + mCellsBegin[layer], static_cast<std::size_t>(mCellsEnd[layer] - mCellsBegin[layer])};
 }
 
 inline void Road::addLeftNeighbourToCell(const Int_t layer, const Int_t cellId, const Int_t layerL, const Int_t cellIdL)
 {
-  mCell[layer][cellId].addLeftNeighbour(layerL, cellIdL);
+  getCellsInLayer(layer)[cellId].addLeftNeighbour(layerL, cellIdL);
 }
 
 inline void Road::addRightNeighbourToCell(const Int_t layer, const Int_t cellId, const Int_t layerR, const Int_t cellIdR)
 {
-  mCell[layer][cellId].addRightNeighbour(layerR, cellIdR);
+  getCellsInLayer(layer)[cellId].addRightNeighbour(layerR, cellIdR);
 }
 
 inline void Road::incrementCellLevel(const Int_t layer, const Int_t cellId)
 {
-  mCell[layer][cellId].incrementLevel();
+  getCellsInLayer(layer)[cellId].incrementLevel();
 }
 
 inline void Road::updateCellLevel(const Int_t layer, const Int_t cellId)
 {
-  mCell[layer][cellId].updateLevel();
+  getCellsInLayer(layer)[cellId].updateLevel();
 }
 
 inline const Int_t Road::getCellLevel(const Int_t layer, const Int_t cellId) const
 {
-  return mCell[layer][cellId].getLevel();
+  return getCellsInLayer(layer)[cellId].getLevel();
 }
 
 inline const Bool_t Road::isCellUsed(const Int_t layer, const Int_t cellId) const
 {
-  return mCell[layer][cellId].isUsed();
+  return getCellsInLayer(layer)[cellId].isUsed();
 }
 
 inline void Road::setCellUsed(const Int_t layer, const Int_t cellId, const Bool_t suc)
 {
-  mCell[layer][cellId].setUsed(suc);
+  getCellsInLayer(layer)[cellId].setUsed(suc);
 }
 
 inline void Road::setCellLevel(const Int_t layer, const Int_t cellId, const Int_t level)
 {
-  mCell[layer][cellId].setLevel(level);
+  getCellsInLayer(layer)[cellId].setLevel(level);
 }
 
 } // namespace mft
@@ -53,6 +53,10 @@ class Tracker : public TrackerConfig
   auto& getTrackLabels() { return mTrackLabels; }
 
   void clustersToTracks(ROframe&, std::ostream& = std::cout);
+  void clustersToTracks(gsl::span<ROframe>);
+
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
 
   template <class T>
   void computeTracksMClabels(const T&);
@@ -64,15 +68,15 @@ class Tracker : public TrackerConfig
   void initConfig(const MFTTrackingParam& trkParam, bool printConfig = false);
 
  private:
-  void findTracks(ROframe&);
+  void findTracks(ROframe&, Road&);
   void findTracksLTF(ROframe&);
-  void findTracksCA(ROframe&);
+  void findTracksCA(ROframe&, Road&);
   void findTracksLTFfcs(ROframe&);
-  void findTracksCAfcs(ROframe&);
-  void computeCellsInRoad(ROframe&);
-  void runForwardInRoad();
-  void runBackwardInRoad(ROframe&);
-  void updateCellStatusInRoad();
+  void findTracksCAfcs(ROframe&, Road&);
+  void computeCellsInRoad(ROframe&, Road&);
+  const Int_t runForwardInRoad(Road&);
+  void runBackwardInRoad(ROframe&, Road&, const Int_t);
+  const Int_t updateCellStatusInRoad(Road&);
 
   bool fitTracks(ROframe&);
 
@@ -81,8 +85,8 @@ class Tracker : public TrackerConfig
   void getBinClusterRange(const ROframe&, const Int_t, const Int_t, Int_t&, Int_t&) const;
   const Float_t getCellDeviation(const Cell&, const Cell&) const;
   const Bool_t getCellsConnect(const Cell&, const Cell&) const;
-  void addCellToCurrentTrackCA(const Int_t, const Int_t, ROframe&);
-  void addCellToCurrentRoad(ROframe&, const Int_t, const Int_t, const Int_t, const Int_t, Int_t&);
+  void addCellToCurrentTrackCA(const Road&, const Int_t, const Int_t, ROframe&);
+  void addCellToCurrentRoad(ROframe&, Road&, const Int_t, const Int_t, const Int_t, const Int_t, Int_t&);
 
   Float_t mBz = 5.f;
   std::uint32_t mROFrame = 0;
@@ -92,10 +96,11 @@ class Tracker : public TrackerConfig
   std::vector<MCCompLabel> mTrackLabels;
   std::unique_ptr<o2::mft::TrackFitter> mTrackFitter = nullptr;
 
-  Int_t mMaxCellLevel = 0;
-
   bool mUseMC = false;
 
+  /// number of threads tracking the RO frames in parallel
+  int mNThreads = 1;
+
   std::array<std::array<std::array<std::vector<Int_t>, constants::index_table::MaxRPhiBins>, (constants::mft::LayersNumber - 1)>, (constants::mft::LayersNumber - 1)> mBinsS;
   std::array<std::array<std::array<std::vector<Int_t>, constants::index_table::MaxRPhiBins>, (constants::mft::LayersNumber - 1)>, (constants::mft::LayersNumber - 1)> mBins;
 
@@ -111,8 +116,9 @@ class Tracker : public TrackerConfig
     Int_t idInLayer;
   };
 
-  /// current road for CA algorithm
-  Road mRoad;
+  /// current road for CA algorithm, one per thread; the bin tables
+  /// above are only read while tracking, so they are shared
+  std::vector<Road> mRoads;
 
   /// Special version for TED shots and cosmics, with full scan of the clusters
   bool mFullClusterScan = false;
@@ -21,6 +21,10 @@
 
 #include "Framework/Logger.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace mft
@@ -30,6 +34,23 @@ namespace mft
 Tracker::Tracker(bool useMC) : mUseMC{useMC}
 {
   mTrackFitter = std::make_unique<o2::mft::TrackFitter>();
+  mRoads.resize(mNThreads);
+}
+
+//_________________________________________________________________________________________________
+void Tracker::setNThreads(int n)
+{
+  /// Set the number of threads used to track RO frames in parallel,
+  /// to be called before initialize()
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  if (n > 1) {
+    LOG(WARNING) << "MFT Tracker compiled without OpenMP support, using 1 thread";
+  }
+  mNThreads = 1;
+#endif
+  mRoads.resize(mNThreads);
 }
 
 //_________________________________________________________________________________________________
@@ -91,7 +112,9 @@ void Tracker::initConfig(const MFTTrackingParam& trkParam, bool printConfig)
 //_________________________________________________________________________________________________
 void Tracker::initialize(bool fullClusterScan)
 {
-  mRoad.initialize();
+  for (auto& road : mRoads) {
+    road.initialize();
+  }
 
   if (fullClusterScan) {
     mFullClusterScan = true;
@@ -193,19 +216,40 @@ void Tracker::clustersToTracks(ROframe& event, std::ostream& timeBenchmarkOutput
 {
   mTracks.clear();
   mTrackLabels.clear();
-  findTracks(event);
+  findTracks(event, mRoads[0]);
   fitTracks(event);
 }
 
 //_________________________________________________________________________________________________
-void Tracker::findTracks(ROframe& event)
+void Tracker::clustersToTracks(gsl::span<ROframe> events)
+{
+  /// Track independent RO frames in parallel: each thread works with its own
+  /// road, the bin tables and the track fitter are only read
+  mTracks.clear();
+  mTrackLabels.clear();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iEvent = 0; iEvent < (int)events.size(); ++iEvent) {
+#ifdef WITH_OPENMP
+    auto& road = mRoads[omp_get_thread_num()];
+#else
+    auto& road = mRoads[0];
+#endif
+    findTracks(events[iEvent], road);
+    fitTracks(events[iEvent]);
+  }
+}
+
+//_________________________________________________________________________________________________
+void Tracker::findTracks(ROframe& event, Road& road)
 {
   if (!mFullClusterScan) {
     findTracksLTF(event);
-    findTracksCA(event);
+    findTracksCA(event, road);
   } else {
     findTracksLTFfcs(event);
-    findTracksCAfcs(event);
+    findTracksCAfcs(event, road);
   }
 }
 
@@ -486,7 +530,7 @@ void Tracker::findTracksLTFfcs(ROframe& event)
 }
 
 //_________________________________________________________________________________________________
-void Tracker::findTracksCA(ROframe& event)
+void Tracker::findTracksCA(ROframe& event, Road& road)
 {
   // layers: 0, 1, 2, ..., 9
   // rules for combining first/last plane in a road:
@@ -592,18 +636,17 @@ void Tracker::findTracksCA(ROframe& event)
               continue;
             }
 
-            mRoad.reset();
+            road.reset();
             for (Int_t point = 0; point < nPoints; ++point) {
               auto layer = roadPoints[point].layer;
               auto clsInLayer = roadPoints[point].idInLayer;
-              mRoad.setPoint(layer, clsInLayer);
+              road.setPoint(layer, clsInLayer);
             }
-            mRoad.setRoadId(roadId);
+            road.setRoadId(roadId);
             ++roadId;
 
-            computeCellsInRoad(event);
-            runForwardInRoad();
-            runBackwardInRoad(event);
+            computeCellsInRoad(event, road);
+            runBackwardInRoad(event, road, runForwardInRoad(road));
 
           } // end clusters in layer2
         }   // end binRPhi
@@ -613,7 +656,7 @@ void Tracker::findTracksCA(ROframe& event)
 }
 
 //_________________________________________________________________________________________________
-void Tracker::findTracksCAfcs(ROframe& event)
+void Tracker::findTracksCAfcs(ROframe& event, Road& road)
 {
   // layers: 0, 1, 2, ..., 9
   // rules for combining first/last plane in a road:
@@ -708,18 +751,17 @@ void Tracker::findTracksCAfcs(ROframe& event)
             continue;
           }
 
-          mRoad.reset();
+          road.reset();
           for (Int_t point = 0; point < nPoints; ++point) {
             auto layer = roadPoints[point].layer;
             auto clsInLayer = roadPoints[point].idInLayer;
-            mRoad.setPoint(layer, clsInLayer);
+            road.setPoint(layer, clsInLayer);
           }
-          mRoad.setRoadId(roadId);
+          road.setRoadId(roadId);
           ++roadId;
 
-          computeCellsInRoad(event);
-          runForwardInRoad();
-          runBackwardInRoad(event);
+          computeCellsInRoad(event, road);
+          runBackwardInRoad(event, road, runForwardInRoad(road));
 
         } // end clusters in layer2
       }   // end clusters in layer1
@@ -728,7 +770,7 @@ void Tracker::findTracksCAfcs(ROframe& event)
 }
 
 //_________________________________________________________________________________________________
-void Tracker::computeCellsInRoad(ROframe& event)
+void Tracker::computeCellsInRoad(ROframe& event, Road& road)
 {
   Int_t layer1, layer1min, layer1max, layer2, layer2min, layer2max;
   Int_t nPtsInLayer1, nPtsInLayer2;
@@ -736,7 +778,7 @@ void Tracker::computeCellsInRoad(ROframe& event)
   Int_t cellId;
   Bool_t noCell;
 
-  mRoad.getLength(layer1min, layer1max);
+  road.getLength(layer1min, layer1max);
   --layer1max;
 
   for (layer1 = layer1min; layer1 <= layer1max; ++layer1) {
@@ -746,30 +788,30 @@ void Tracker::computeCellsInRoad(ROframe& event)
     layer2min = layer1 + 1;
     layer2max = std::min(layer1 + (constants::mft::DisksNumber - isDiskFace(layer1)), constants::mft::LayersNumber - 1);
 
-    nPtsInLayer1 = mRoad.getNPointsInLayer(layer1);
+    nPtsInLayer1 = road.getNPointsInLayer(layer1);
 
     for (Int_t point1 = 0; point1 < nPtsInLayer1; ++point1) {
 
-      clsInLayer1 = mRoad.getClustersIdInLayer(layer1)[point1];
+      clsInLayer1 = road.getClustersIdInLayer(layer1)[point1];
 
       layer2 = layer2min;
 
       noCell = kTRUE;
       while (noCell && (layer2 <= layer2max)) {
 
-        nPtsInLayer2 = mRoad.getNPointsInLayer(layer2);
+        nPtsInLayer2 = road.getNPointsInLayer(layer2);
         /*
         if (nPtsInLayer2 > 1) {
-          LOG(INFO) << "BV===== more than one point in road " << mRoad.getRoadId() << " in layer " << layer2 << " : " << nPtsInLayer2 << "\n";
+          LOG(INFO) << "BV===== more than one point in road " << road.getRoadId() << " in layer " << layer2 << " : " << nPtsInLayer2 << "\n";
         }
   */
         for (Int_t point2 = 0; point2 < nPtsInLayer2; ++point2) {
 
-          clsInLayer2 = mRoad.getClustersIdInLayer(layer2)[point2];
+          clsInLayer2 = road.getClustersIdInLayer(layer2)[point2];
 
           noCell = kFALSE;
           // create a cell
-          addCellToCurrentRoad(event, layer1, layer2, clsInLayer1, clsInLayer2, cellId);
+          addCellToCurrentRoad(event, road, layer1, layer2, clsInLayer1, clsInLayer2, cellId);
         } // end points in layer2
         ++layer2;
 
@@ -779,10 +821,10 @@ void Tracker::computeCellsInRoad(ROframe& event)
 }
 
 //_________________________________________________________________________________________________
-void Tracker::runForwardInRoad()
+const Int_t Tracker::runForwardInRoad(Road& road)
 {
   Int_t layerR, layerL, icellR, icellL;
-  Int_t iter = 0;
+  Int_t iter = 0, maxCellLevel = 0;
   Bool_t levelChange = kTRUE;
 
   while (levelChange) {
@@ -793,9 +835,10 @@ void Tracker::runForwardInRoad()
     // R = right, L = left
     for (layerL = 0; layerL < (constants::mft::LayersNumber - 2); ++layerL) {
 
-      for (icellL = 0; icellL < mRoad.getCellsInLayer(layerL).size(); ++icellL) {
+      auto cellsL = road.getCellsInLayer(layerL);
+      for (icellL = 0; icellL < cellsL.size(); ++icellL) {
 
-        Cell& cellL = mRoad.getCellsInLayer(layerL)[icellL];
+        Cell& cellL = cellsL[icellL];
 
         layerR = cellL.getSecondLayerId();
 
@@ -803,16 +846,17 @@ void Tracker::runForwardInRoad()
           continue;
         }
 
-        for (icellR = 0; icellR < mRoad.getCellsInLayer(layerR).size(); ++icellR) {
+        auto cellsR = road.getCellsInLayer(layerR);
+        for (icellR = 0; icellR < cellsR.size(); ++icellR) {
 
-          Cell& cellR = mRoad.getCellsInLayer(layerR)[icellR];
+          Cell& cellR = cellsR[icellR];
 
           if ((cellL.getLevel() == cellR.getLevel()) && getCellsConnect(cellL, cellR)) {
             if (iter == 1) {
-              mRoad.addRightNeighbourToCell(layerL, icellL, layerR, icellR);
-              mRoad.addLeftNeighbourToCell(layerR, icellR, layerL, icellL);
+              cellL.addRightNeighbour(layerR, icellR);
+              cellR.addLeftNeighbour(layerL, icellL);
             }
-            mRoad.incrementCellLevel(layerR, icellR);
+            cellR.incrementLevel();
             levelChange = kTRUE;
 
           } // end matching cells
@@ -820,15 +864,17 @@ void Tracker::runForwardInRoad()
       }     // end loop cellL
     }       // end loop layer
 
-    updateCellStatusInRoad();
+    maxCellLevel = std::max(maxCellLevel, updateCellStatusInRoad(road));
 
   } // end while (levelChange)
+
+  return maxCellLevel;
 }
 
 //_________________________________________________________________________________________________
-void Tracker::runBackwardInRoad(ROframe& event)
+void Tracker::runBackwardInRoad(ROframe& event, Road& road, const Int_t maxCellLevel)
 {
-  if (mMaxCellLevel == 1) {
+  if (maxCellLevel == 1) {
     return; // we have only isolated cells
   }
 
@@ -847,9 +893,9 @@ void Tracker::runBackwardInRoad(ROframe& event)
 
   for (Int_t layer = maxLayer; layer >= minLayer; --layer) {
 
-    for (cellId = 0; cellId < mRoad.getCellsInLayer(layer).size(); ++cellId) {
+    for (cellId = 0; cellId < road.getCellsInLayer(layer).size(); ++cellId) {
 
-      if (mRoad.isCellUsed(layer, cellId) || (mRoad.getCellLevel(layer, cellId) < (mMinTrackPointsCA - 1))) {
+      if (road.isCellUsed(layer, cellId) || (road.getCellLevel(layer, cellId) < (mMinTrackPointsCA - 1))) {
         continue;
       }
 
@@ -867,7 +913,7 @@ void Tracker::runBackwardInRoad(ROframe& event)
         layerRC = trackCells[nCells - 1].layer;
         cellIdRC = trackCells[nCells - 1].idInLayer;
 
-        const Cell& cellRC = mRoad.getCellsInLayer(layerRC)[cellIdRC];
+        const Cell& cellRC = road.getCellsInLayer(layerRC)[cellIdRC];
 
         addCellToNewTrack = kFALSE;
 
@@ -880,9 +926,9 @@ void Tracker::runBackwardInRoad(ROframe& event)
           layerL = leftNeighbour.first;
           cellIdL = leftNeighbour.second;
 
-          const Cell& cellL = mRoad.getCellsInLayer(layerL)[cellIdL];
+          const Cell& cellL = road.getCellsInLayer(layerL)[cellIdL];
 
-          if (mRoad.isCellUsed(layerL, cellIdL) || (mRoad.getCellLevel(layerL, cellIdL) != (mRoad.getCellLevel(layerRC, cellIdRC) - 1))) {
+          if (road.isCellUsed(layerL, cellIdL) || (road.getCellLevel(layerL, cellIdL) != (road.getCellLevel(layerRC, cellIdRC) - 1))) {
             continue;
           }
 
@@ -914,7 +960,7 @@ void Tracker::runBackwardInRoad(ROframe& event)
 
       layerC = trackCells[0].layer;
       cellIdC = trackCells[0].idInLayer;
-      const Cell& cellC = mRoad.getCellsInLayer(layerC)[cellIdC];
+      const Cell& cellC = road.getCellsInLayer(layerC)[cellIdC];
       hasDisk[cellC.getSecondLayerId() / 2] = kTRUE;
       for (icell = 0; icell < nCells; ++icell) {
         layerC = trackCells[icell].layer;
@@ -934,14 +980,14 @@ void Tracker::runBackwardInRoad(ROframe& event)
       }
 
       // add a new TrackCA
-      event.addTrackCA(mRoad.getRoadId());
+      event.addTrackCA(road.getRoadId());
       for (icell = 0; icell < nCells; ++icell) {
         layerC = trackCells[icell].layer;
         cellIdC = trackCells[icell].idInLayer;
-        addCellToCurrentTrackCA(layerC, cellIdC, event);
-        mRoad.setCellUsed(layerC, cellIdC, kTRUE);
+        addCellToCurrentTrackCA(road, layerC, cellIdC, event);
+        road.setCellUsed(layerC, cellIdC, kTRUE);
         // marked the used clusters
-        const Cell& cellC = mRoad.getCellsInLayer(layerC)[cellIdC];
+        const Cell& cellC = road.getCellsInLayer(layerC)[cellIdC];
         event.getClustersInLayer(cellC.getFirstLayerId())[cellC.getFirstClusterIndex()].setUsed(true);
         event.getClustersInLayer(cellC.getSecondLayerId())[cellC.getSecondClusterIndex()].setUsed(true);
       }
@@ -950,22 +996,23 @@ void Tracker::runBackwardInRoad(ROframe& event)
 }
 
 //_________________________________________________________________________________________________
-void Tracker::updateCellStatusInRoad()
+const Int_t Tracker::updateCellStatusInRoad(Road& road)
 {
-  Int_t layerMin, layerMax;
-  mRoad.getLength(layerMin, layerMax);
+  Int_t layerMin, layerMax, maxCellLevel = 0;
+  road.getLength(layerMin, layerMax);
   for (Int_t layer = layerMin; layer < layerMax; ++layer) {
-    for (Int_t icell = 0; icell < mRoad.getCellsInLayer(layer).size(); ++icell) {
-      mRoad.updateCellLevel(layer, icell);
-      mMaxCellLevel = std::max(mMaxCellLevel, mRoad.getCellLevel(layer, icell));
+    for (auto& cell : road.getCellsInLayer(layer)) {
+      cell.updateLevel();
+      maxCellLevel = std::max(maxCellLevel, cell.getLevel());
     }
   }
+  return maxCellLevel;
 }
 
 //_________________________________________________________________________________________________
-void Tracker::addCellToCurrentRoad(ROframe& event, const Int_t layer1, const Int_t layer2, const Int_t clsInLayer1, const Int_t clsInLayer2, Int_t& cellId)
+void Tracker::addCellToCurrentRoad(ROframe& event, Road& road, const Int_t layer1, const Int_t layer2, const Int_t clsInLayer1, const Int_t clsInLayer2, Int_t& cellId)
 {
-  Cell& cell = mRoad.addCellInLayer(layer1, layer2, clsInLayer1, clsInLayer2, cellId);
+  Cell& cell = road.addCellInLayer(layer1, layer2, clsInLayer1, clsInLayer2, cellId);
 
   Cluster& cluster1 = event.getClustersInLayer(layer1)[clsInLayer1];
   Cluster& cluster2 = event.getClustersInLayer(layer2)[clsInLayer2];
@@ -983,10 +1030,10 @@ void Tracker::addCellToCurrentRoad(ROframe& event, const Int_t layer1, const Int
 }
 
 //_________________________________________________________________________________________________
-void Tracker::addCellToCurrentTrackCA(const Int_t layer1, const Int_t cellId, ROframe& event)
+void Tracker::addCellToCurrentTrackCA(const Road& road, const Int_t layer1, const Int_t cellId, ROframe& event)
 {
   TrackCA& trackCA = event.getCurrentTrackCA();
-  const Cell& cell = mRoad.getCellsInLayer(layer1)[cellId];
+  const Cell& cell = road.getCellsInLayer(layer1)[cellId];
   const Int_t layer2 = cell.getSecondLayerId();
   const Int_t clsInLayer1 = cell.getFirstClusterIndex();
   const Int_t clsInLayer2 = cell.getSecondClusterIndex();
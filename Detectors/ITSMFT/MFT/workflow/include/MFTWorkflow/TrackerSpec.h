@@ -42,6 +42,9 @@ class TrackerDPL : public o2::framework::Task
   std::unique_ptr<o2::parameters::GRPObject> mGRP = nullptr;
   std::unique_ptr<o2::mft::Tracker> mTracker = nullptr;
   TStopwatch mTimer;
+
+  /// RO frames loaded per tracking thread before tracking them in parallel
+  static constexpr size_t ROFsPerThread = 4;
 };
 
 /// create a processor spec
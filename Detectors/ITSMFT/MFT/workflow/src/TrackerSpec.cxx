@@ -65,6 +65,7 @@ void TrackerDPL::init(InitContext& ic)
     double centerMFT[3] = {0, 0, -61.4}; // Field at center of MFT
     mTracker->setBz(field->getBz(centerMFT));
     mTracker->initConfig(trackingParam, true);
+    mTracker->setNThreads(ic.options().get<int>("nthreads"));
     mTracker->initialize(trackingParam.FullClusterScan);
   } else {
     throw std::runtime_error(o2::utils::Str::concat_string("Cannot retrieve GRP from the ", filename));
@@ -115,8 +116,14 @@ void TrackerDPL::run(ProcessingContext& pc)
   std::vector<o2::mft::TrackCA> tracksCA;
   auto& allTracksMFT = pc.outputs().make<std::vector<o2::mft::TrackMFT>>(Output{"MFT", "TRACKS", 0, Lifetime::Timeframe});
 
-  std::uint32_t roFrame = 0;
-  o2::mft::ROframe event(0);
+  // RO frames are tracked in parallel in chunks of this many
+  const size_t nROFsPerChunk = mTracker->getNThreads() * ROFsPerThread;
+  std::vector<o2::mft::ROframe> events;
+  events.reserve(nROFsPerChunk);
+  for (size_t i = 0; i < nROFsPerChunk; ++i) {
+    events.emplace_back(0);
+  }
+  std::vector<size_t> eventROFs(nROFsPerChunk);
 
   Bool_t continuous = mGRP->isDetContinuousReadOut("MFT");
   LOG(INFO) << "MFTTracker RO: continuous=" << continuous;
@@ -125,7 +132,7 @@ void TrackerDPL::run(ProcessingContext& pc)
   auto& trackingParam = MFTTrackingParam::Instance();
 
   // snippet to convert found tracks to final output tracks with separate cluster indices
-  auto copyTracks = [&event](auto& tracks, auto& allTracks, auto& allClusIdx) {
+  auto copyTracks = [](auto& tracks, auto& allTracks, auto& allClusIdx) {
     for (auto& trc : tracks) {
       trc.setExternalClusterIndexOffset(allClusIdx.size());
       int ncl = trc.getNumberOfPoints();
@@ -139,14 +146,24 @@ void TrackerDPL::run(ProcessingContext& pc)
 
   gsl::span<const unsigned char>::iterator pattIt = patterns.begin();
   if (continuous) {
-    for (auto& rof : rofs) {
-      int nclUsed = ioutils::loadROFrameData(rof, event, compClusters, pattIt, mDict, labels, mTracker.get());
-      if (nclUsed) {
-        event.setROFrameId(roFrame);
-        event.initialize(trackingParam.FullClusterScan);
-        LOG(INFO) << "ROframe: " << roFrame << ", clusters loaded : " << nclUsed;
-        mTracker->setROFrame(roFrame);
-        mTracker->clustersToTracks(event);
+    for (size_t firstROF = 0; firstROF < rofs.size(); firstROF += nROFsPerChunk) {
+      // the clusters (and their patterns) have to be read in order
+      size_t nEvents = 0;
+      for (size_t roFrame = firstROF; roFrame < std::min(firstROF + nROFsPerChunk, rofs.size()); ++roFrame) {
+        auto& event = events[nEvents];
+        int nclUsed = ioutils::loadROFrameData(rofs[roFrame], event, compClusters, pattIt, mDict, labels, mTracker.get());
+        if (nclUsed) {
+          event.setROFrameId(roFrame);
+          event.initialize(trackingParam.FullClusterScan);
+          LOG(INFO) << "ROframe: " << roFrame << ", clusters loaded : " << nclUsed;
+          eventROFs[nEvents++] = roFrame;
+        }
+      }
+      mTracker->clustersToTracks(gsl::span<o2::mft::ROframe>(events.data(), nEvents));
+
+      for (size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+        auto& event = events[iEvent];
+        auto& rof = rofs[eventROFs[iEvent]];
         tracksLTF.swap(event.getTracksLTF());
         tracksCA.swap(event.getTracksCA());
         nTracksLTF += tracksLTF.size();
@@ -169,7 +186,6 @@ void TrackerDPL::run(ProcessingContext& pc)
         copyTracks(tracksLTF, allTracksMFT, allClusIdx);
         copyTracks(tracksCA, allTracksMFT, allClusIdx);
       }
-      roFrame++;
     }
   }
 
@@ -216,7 +232,8 @@ DataProcessorSpec getTrackerSpec(bool useMC)
     AlgorithmSpec{adaptFromTask<TrackerDPL>(useMC)},
     Options{
       {"grp-file", VariantType::String, "o2sim_grp.root", {"Name of the output file"}},
-      {"mft-dictionary-path", VariantType::String, "", {"Path of the cluster-topology dictionary file"}}}};
+      {"mft-dictionary-path", VariantType::String, "", {"Path of the cluster-topology dictionary file"}},
+      {"nthreads", VariantType::Int, 1, {"Number of threads tracking the RO frames in parallel"}}}};
 }
 
 } // namespace mft
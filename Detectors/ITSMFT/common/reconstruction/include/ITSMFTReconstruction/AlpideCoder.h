@@ -13,6 +13,7 @@
 #define ALICEO2_ITSMFT_ALPIDE_CODER_H
 
 #include <Rtypes.h>
+#include <array>
 #include <cstdio>
 #include <cstdint>
 #include <vector>
@@ -117,6 +118,10 @@ class AlpideCoder
 
   static void setNoisyPixels(const NoiseMap* noise) { mNoisyPixels = noise; }
 
+  /// select the fast path for the decoding of the DATASHORT/DATALONG records (the results are identical to the standard path)
+  static void setFastDecoding(bool v) { mFastDecoding = v; }
+  static bool isFastDecoding() { return mFastDecoding; }
+
   /// decode alpide data for the next non-empty chip from the buffer
   template <class T, typename CG>
   static int decodeChip(ChipPixelData& chipData, T& buffer, CG cidGetter)
@@ -204,6 +209,13 @@ class AlpideCoder
 
       // hit info ?
       if ((expectInp & ExpectData)) {
+        if (mFastDecoding && isData(dataC)) {
+          if (decodeDataRecords(chipData, buffer, dataC, region, colDPrev, nRightCHits, rightColHits) == Error) {
+            return Error;
+          }
+          expectInp = ExpectChipTrailer | ExpectData | ExpectRegion;
+          continue;
+        }
         if (isData(dataC)) { // region header was seen, expect data
                              // note that here we are checking on the byte rather than the short, need complete to ushort
           dataS = dataC << 8;
@@ -330,6 +342,85 @@ class AlpideCoder
   void reset();
 
  private:
+  /// fired pixels of the DATASHORT/DATALONG record for given 2 lowest bits of the pixel address and the 8 bits pattern
+  /// of hits (bit 0 for the addressed pixel, bits 1:7 for the DATALONG hit map)
+  struct HitPatternLUT {
+    uint8_t nHits = 0;         // number of fired pixels
+    uint8_t rightMask = 0;     // bit i is set if i-th pixel is in the right column of the double column
+    uint8_t rowOffset[8] = {}; // row of i-th pixel wrt the row of the pixel address with 2 lowest bits suppressed
+  };
+  static constexpr int HitPatternLUTSize = 4 * 256;
+
+  /// fast path decoding of consecutive DATASHORT/DATALONG records, the 1st byte of which (b0) was already read:
+  /// the records are read directly from the buffer and the hits are expanded via the mHitPatternLUT.
+  /// Hits and errors are reported exactly as in the standard path of decodeChip
+  template <class T>
+  static int decodeDataRecords(ChipPixelData& chipData, T& buffer, uint8_t b0, uint16_t region,
+                               uint16_t& colDPrev, int& nRightCHits, uint16_t* rightColHits)
+  {
+    auto ptr = buffer.getPtr();
+    const auto end = buffer.getEnd();
+    while (true) {
+      if (ptr >= end) {
+        buffer.setPtr(end);
+#ifdef ALPIDE_DECODING_STAT
+        chipData.setError(ChipStat::TruncatedRegion);
+#endif
+        return unexpectedEOF("CHIPDATA");
+      }
+      uint16_t dataS = (uint16_t(b0) << 8) | (*ptr++);
+      uint16_t dColID = (dataS & MaskEncoder) >> 10;
+      uint16_t pixID = dataS & MaskPixID;
+      uint16_t colD = (region * NDColInReg + dColID) << 1;
+      if (colD != colDPrev) {
+        colDPrev++;
+        for (int ihr = 0; ihr < nRightCHits; ihr++) {
+          addHit(chipData, rightColHits[ihr], colDPrev);
+        }
+        colDPrev = colD;
+        nRightCHits = 0;
+      }
+      uint32_t pattern = 0x1; // addressed pixel
+      bool truncated = false;
+      if ((dataS & (~MaskDColID)) == DATALONG) {
+        if (ptr < end) {
+          uint8_t hitsPattern = *ptr++;
+#ifdef ALPIDE_DECODING_STAT
+          if (hitsPattern & (~MaskHitMap)) {
+            chipData.setError(ChipStat::WrongDataLongPattern);
+          }
+#endif
+          pattern |= (hitsPattern & MaskHitMap) << 1;
+        } else {
+          truncated = true; // the addressed pixel is still reported
+        }
+      }
+      const auto& lut = mHitPatternLUT[((pixID & 0x3) << 8) | pattern];
+      uint16_t rowBase = (pixID >> 2) << 1;
+      for (int ih = 0; ih < lut.nHits; ih++) {
+        uint16_t row = rowBase + lut.rowOffset[ih];
+        if (lut.rightMask & (0x1 << ih)) {
+          rightColHits[nRightCHits++] = row;
+        } else {
+          addHit(chipData, row, colD);
+        }
+      }
+      if (truncated) {
+        buffer.setPtr(end);
+#ifdef ALPIDE_DECODING_STAT
+        chipData.setError(ChipStat::TruncatedLondData);
+#endif
+        return unexpectedEOF("CHIP_DATA_LONG:Pattern");
+      }
+      if (ptr >= end || !isData(*ptr)) {
+        break;
+      }
+      b0 = *ptr++;
+    }
+    buffer.setPtr(ptr);
+    return 0;
+  }
+
   /// Output a non-noisy fired pixel
   static void addHit(ChipPixelData& chipData, short row, short col)
   {
@@ -425,6 +516,8 @@ class AlpideCoder
   //
 
   static const NoiseMap* mNoisyPixels;
+  static bool mFastDecoding;                                                  //! use decodeDataRecords for hits decoding
+  static const std::array<HitPatternLUT, HitPatternLUTSize> mHitPatternLUT; //! hits expansion table for the fast decoding
 
   // cluster map used for the ENCODING only
   std::vector<int> mFirstInRow;     //! entry of 1st pixel of each non-empty row in the mPix2Encode
@@ -82,6 +82,16 @@ class Clusterer
     ThreadStat() = default;
   };
 
+  /// block of consecutive chips processed by the thread, with the positions of its output in the final containers
+  struct MergeBlock {
+    int thread = 0;
+    int statIdx = 0;          // entry in the ClustererThread::stats
+    size_t clusOffset = 0;    // position of the 1st cluster of the block
+    size_t pattOffset = 0;    // position of the 1st pattern byte of the block
+    size_t labHeadOffset = 0; // position of the labels header of the 1st cluster of the block
+    size_t labOffset = 0;     // position of the 1st label of the block
+  };
+
   struct ClustererThread {
 
     Clusterer* parent = nullptr; // parent clusterer
@@ -217,6 +227,7 @@ class Clusterer
   int mMaxRowColDiffToMask = 0; ///< provide their difference in col/row is <= than this
 
   std::vector<std::unique_ptr<ClustererThread>> mThreads; // buffers for threads
+  std::vector<MergeBlock> mMergeBlocks;                   //! blocks of threads output with their positions in the final output
   std::vector<ChipPixelData> mChips;                      // currently processed ROF's chips data
   std::vector<ChipPixelData> mChipsOld;                   // previously processed ROF's chips data (for masking)
   std::vector<ChipPixelData*> mFiredChipsPtr;             // pointers on the fired chips data in the decoder cache
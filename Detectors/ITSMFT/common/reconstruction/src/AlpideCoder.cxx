@@ -17,6 +17,28 @@
 using namespace o2::itsmft;
 
 const NoiseMap* AlpideCoder::mNoisyPixels = nullptr;
+bool AlpideCoder::mFastDecoding = false;
+
+const std::array<AlpideCoder::HitPatternLUT, AlpideCoder::HitPatternLUTSize> AlpideCoder::mHitPatternLUT = []() {
+  // hit i of the record (if bit i of the pattern is set) has address pixID+i, for pixID = 4*q + r0 its row is 2*q + ((r0+i)>>1)
+  std::array<HitPatternLUT, HitPatternLUTSize> lut{};
+  for (int r0 = 0; r0 < 4; r0++) {
+    for (int pattern = 0; pattern < 256; pattern++) {
+      auto& entry = lut[(r0 << 8) | pattern];
+      for (int ih = 0; ih < 8; ih++) {
+        if (pattern & (0x1 << ih)) {
+          int addr = r0 + ih, row = addr >> 1;
+          bool rightC = (row & 0x1) ? !(addr & 0x1) : (addr & 0x1); // same as in decodeChip
+          if (rightC) {
+            entry.rightMask |= 0x1 << entry.nHits;
+          }
+          entry.rowOffset[entry.nHits++] = row;
+        }
+      }
+    }
+  }
+  return lut;
+}();
 
 //_____________________________________
 void AlpideCoder::print() const
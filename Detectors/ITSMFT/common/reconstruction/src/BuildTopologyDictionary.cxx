@@ -241,6 +241,8 @@ void BuildTopologyDictionary::groupRareTopologies()
       mDictionary.mGroupMap.insert(std::make_pair((int)(gr.mHash >> 32) & 0x00000000ffffffff, iKey));
     }
   }
+  mDictionary.buildPerfectHash();
+  mDictionary.fillClusterParams();
   std::cout << "Dictionay finalised" << std::endl;
   std::cout << "Number of keys: " << mDictionary.getSize() << std::endl;
   std::cout << "Number of common topologies: " << mDictionary.mCommonMap.size() << std::endl;
@@ -102,16 +102,13 @@ void Clusterer::process(int nThreads, PixelReader& reader, CompClusCont* compClu
 #ifdef _PERFORM_TIMING_
       mTimerMerge.Start(false);
 #endif
-      size_t nClTot = 0, nPattTot = 0;
+      // lay out the blocks of all threads in the chips order, then copy them concurrently to their final positions
+      mMergeBlocks.clear();
+      size_t nClTot = compClus->size(), nPattTot = patterns ? patterns->size() : 0;
+      size_t nLabHeadTot = labelsCl ? labelsCl->getIndexedSize() : 0, nLabTot = labelsCl ? labelsCl->getNElements() : 0;
       int chid = 0, thrStatIdx[nThreads];
       for (int ith = 0; ith < nThreads; ith++) {
         thrStatIdx[ith] = 0;
-        nClTot += mThreads[ith]->compClusters.size();
-        nPattTot += mThreads[ith]->patterns.size();
-      }
-      compClus->reserve(nClTot);
-      if (patterns) {
-        patterns->reserve(nPattTot);
       }
       while (chid < nFired) {
         for (int ith = 0; ith < nThreads; ith++) {
@@ -120,21 +117,42 @@ void Clusterer::process(int nThreads, PixelReader& reader, CompClusCont* compClu
           }
           const auto& stat = mThreads[ith]->stats[thrStatIdx[ith]];
           if (stat.firstChip == chid) {
-            thrStatIdx[ith]++;
             chid += stat.nChips; // next chip to look
-            const auto clbeg = mThreads[ith]->compClusters.begin() + stat.firstClus;
-            auto szold = compClus->size();
-            compClus->insert(compClus->end(), clbeg, clbeg + stat.nClus);
-            if (patterns) {
-              const auto ptbeg = mThreads[ith]->patterns.begin() + stat.firstPatt;
-              patterns->insert(patterns->end(), ptbeg, ptbeg + stat.nPatt);
-            }
+            mMergeBlocks.push_back(MergeBlock{ith, thrStatIdx[ith]++, nClTot, nPattTot, nLabHeadTot, nLabTot});
+            nClTot += stat.nClus;
+            nPattTot += stat.nPatt;
             if (labelsCl) {
-              labelsCl->mergeAtBack(mThreads[ith]->labels, stat.firstClus, stat.nClus);
+              nLabHeadTot += stat.nClus;
+              nLabTot += mThreads[ith]->labels.getNElements(stat.firstClus, stat.nClus);
             }
           }
         }
       }
+      compClus->resize(nClTot);
+      if (patterns) {
+        patterns->resize(nPattTot);
+      }
+      if (labelsCl) {
+        labelsCl->resizeForCopy(nLabHeadTot, nLabTot);
+      }
+      int nBlocks = mMergeBlocks.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int ib = 0; ib < nBlocks; ib++) {
+        const auto& blk = mMergeBlocks[ib];
+        const auto& thr = *mThreads[blk.thread];
+        const auto& stat = thr.stats[blk.statIdx];
+        const auto clbeg = thr.compClusters.begin() + stat.firstClus;
+        std::copy(clbeg, clbeg + stat.nClus, compClus->begin() + blk.clusOffset);
+        if (patterns) {
+          const auto ptbeg = thr.patterns.begin() + stat.firstPatt;
+          std::copy(ptbeg, ptbeg + stat.nPatt, patterns->begin() + blk.pattOffset);
+        }
+        if (labelsCl) {
+          labelsCl->copyAt(thr.labels, stat.firstClus, stat.nClus, blk.labHeadOffset, blk.labOffset);
+        }
+      }
       for (int ith = 0; ith < nThreads; ith++) {
         mThreads[ith]->patterns.clear();
         mThreads[ith]->compClusters.clear();
@@ -71,10 +71,9 @@ int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPatt
     }
   }
   // Big topology
-  unsigned long hash = ClusterTopology::getCompleteHash(nRow, nCol, patt);
-  auto ret = mDictionary.mCommonMap.find(hash);
-  if (ret != mDictionary.mCommonMap.end()) {
-    return ret->second;
+  int ID = mDictionary.getCommonTopologyID(ClusterTopology::getCompleteHash(nRow, nCol, patt));
+  if (ID >= 0) {
+    return ID;
   } else { // Big rare topology (inside groups)
     int index = groupFinder(nRow, nCol);
     return mDictionary.mGroupMap[index];
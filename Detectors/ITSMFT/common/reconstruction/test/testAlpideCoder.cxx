@@ -0,0 +1,122 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test AlpideCoder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+#include "ITSMFTReconstruction/AlpideCoder.h"
+#include "ITSMFTReconstruction/PayLoadCont.h"
+#include "ITSMFTReconstruction/PixelData.h"
+
+using namespace o2::itsmft;
+
+struct DecodedChip {
+  int ret = 0;
+  uint16_t chipID = 0;
+  uint32_t errors = 0;
+  std::vector<PixelData> pixels;
+};
+
+// decode all chips from the buffer copy, in the same way as RUDecodeData does
+std::vector<DecodedChip> decodeAll(const PayLoadCont& src, size_t size, bool fast)
+{
+  PayLoadCont buffer(src);
+  buffer.setEnd(buffer.getPtr() + size);
+  AlpideCoder::setFastDecoding(fast);
+  std::vector<DecodedChip> res;
+  ChipPixelData chipData;
+  int ret = 0, maxCalls = 1000;
+  while (((ret = AlpideCoder::decodeChip(chipData, buffer, [](uint16_t ch) { return ch; })) || chipData.isErrorSet()) && maxCalls--) {
+    auto& dec = res.emplace_back();
+    dec.ret = ret;
+    dec.chipID = chipData.getChipID();
+    dec.errors = chipData.getErrorFlags();
+    dec.pixels = chipData.getData();
+  }
+  AlpideCoder::setFastDecoding(false);
+  return res;
+}
+
+void compare(const std::vector<DecodedChip>& ref, const std::vector<DecodedChip>& fast)
+{
+  BOOST_REQUIRE_EQUAL(ref.size(), fast.size());
+  for (size_t i = 0; i < ref.size(); i++) {
+    BOOST_CHECK_EQUAL(ref[i].ret, fast[i].ret);
+    BOOST_CHECK_EQUAL(ref[i].chipID, fast[i].chipID);
+    BOOST_CHECK_EQUAL(ref[i].errors, fast[i].errors);
+    BOOST_REQUIRE_EQUAL(ref[i].pixels.size(), fast[i].pixels.size());
+    for (size_t ip = 0; ip < ref[i].pixels.size(); ip++) {
+      BOOST_CHECK(ref[i].pixels[ip] == fast[i].pixels[ip]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AlpideCoder_FastDecoding)
+{
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> rowDist(0, AlpideCoder::NRows - 1), colDist(0, AlpideCoder::NCols - 1), sizeDist(1, 4);
+  const int NChips = 9;
+  AlpideCoder coder;
+  PayLoadCont buffer(256 * 1024);
+  std::vector<std::vector<PixelData>> input(NChips);
+  for (int ich = 0; ich < NChips; ich++) {
+    ChipPixelData chipData;
+    if (ich % 3 != 2) { // every 3d chip is empty
+      std::set<std::pair<int, int>> fired; // row/col sorted
+      int nClus = 50 + ich * 100;
+      for (int icl = 0; icl < nClus; icl++) { // clusters of adjacent pixels to produce DATALONG records
+        int r0 = rowDist(gen), c0 = colDist(gen), nr = sizeDist(gen), nc = sizeDist(gen);
+        for (int r = r0; r < std::min(r0 + nr, AlpideCoder::NRows); r++) {
+          for (int c = c0; c < std::min(c0 + nc, AlpideCoder::NCols); c++) {
+            fired.emplace(r, c);
+          }
+        }
+      }
+      for (const auto& rc : fired) {
+        chipData.getData().emplace_back(rc.first, rc.second);
+      }
+      input[ich] = chipData.getData();
+    }
+    coder.encodeChip(buffer, chipData, ich, 100 + ich);
+  }
+
+  // full buffer: both decoders must restore the encoded pixels
+  auto resStd = decodeAll(buffer, buffer.getSize(), false);
+  auto resFast = decodeAll(buffer, buffer.getSize(), true);
+  compare(resStd, resFast);
+  int nonEmpty = 0;
+  for (int ich = 0; ich < NChips; ich++) {
+    if (input[ich].empty()) {
+      continue;
+    }
+    BOOST_REQUIRE(nonEmpty < int(resFast.size()));
+    auto& dec = resFast[nonEmpty++];
+    BOOST_CHECK_EQUAL(dec.chipID, ich);
+    BOOST_CHECK_EQUAL(dec.errors, 0);
+    auto expected = input[ich];
+    std::sort(expected.begin(), expected.end()); // decoder provides col/row sorted pixels
+    BOOST_REQUIRE_EQUAL(dec.pixels.size(), expected.size());
+    for (size_t ip = 0; ip < expected.size(); ip++) {
+      BOOST_CHECK(dec.pixels[ip] == expected[ip]);
+    }
+  }
+  BOOST_CHECK_EQUAL(nonEmpty, int(resFast.size()));
+
+  // truncated buffers: hits and errors before the truncation point must be identical
+  for (size_t sz = 1; sz < buffer.getSize(); sz += 1 + sz / 50) {
+    compare(decodeAll(buffer, sz, false), decodeAll(buffer, sz, true));
+  }
+}
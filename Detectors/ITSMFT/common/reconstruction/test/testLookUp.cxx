@@ -0,0 +1,93 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test LookUp
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "DataFormatsITSMFT/ClusterTopology.h"
+#include "DataFormatsITSMFT/TopologyDictionary.h"
+#include "ITSMFTReconstruction/BuildTopologyDictionary.h"
+#include "ITSMFTReconstruction/LookUp.h"
+
+using namespace o2::itsmft;
+
+BOOST_AUTO_TEST_CASE(LookUp_PerfectHash)
+{
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> spanDist(3, 8), byteDist(0, 255);
+  const int NTopologies = 1000, NCommon = 700;
+
+  // random big topologies (more than 8 pixels in the bounding box), accounted with decreasing frequency
+  std::vector<ClusterTopology> topologies;
+  std::unordered_map<unsigned long, int> seen;
+  BuildTopologyDictionary builder;
+  while (int(topologies.size()) < NTopologies) {
+    unsigned char patt[ClusterPattern::MaxPatternBytes] = {0};
+    int nRow = spanDist(gen), nCol = spanDist(gen), nBytes = (nRow * nCol + 7) / 8;
+    for (int i = 0; i < nBytes; i++) {
+      patt[i] = byteDist(gen);
+    }
+    patt[0] |= 0x80;
+    ClusterTopology topo(nRow, nCol, patt);
+    if (!seen.emplace(topo.getHash(), topologies.size()).second) {
+      continue;
+    }
+    topologies.push_back(topo);
+  }
+  for (int it = 0; it < NTopologies; it++) {
+    for (int ic = 0; ic < 1 + (NTopologies - it); ic++) {
+      builder.accountTopology(topologies[it]);
+    }
+  }
+  builder.setNCommon(NCommon);
+  builder.groupRareTopologies();
+  auto dict = builder.getDictionary();
+
+  // every common topology is found at its own position, the rest is not found
+  int nCommon = 0;
+  for (int id = 0; id < dict.getSize(); id++) {
+    if (!dict.isGroup(id)) {
+      nCommon++;
+      BOOST_CHECK_EQUAL(dict.getCommonTopologyID(dict.getHash(id)), id);
+    }
+  }
+  BOOST_CHECK_EQUAL(nCommon, NCommon);
+  std::uniform_int_distribution<unsigned long> hashDist;
+  for (int i = 0; i < 10000; i++) {
+    auto hash = hashDist(gen);
+    if (seen.find(hash) == seen.end()) {
+      BOOST_CHECK_EQUAL(dict.getCommonTopologyID(hash), -1);
+    }
+  }
+
+  // the dictionary read from the binary file must resolve the topologies in the same way
+  std::string dictFile = "testLookUpDictionary.bin";
+  builder.printDictionaryBinary(dictFile);
+  LookUp lookup(dictFile);
+  for (int it = 0; it < NTopologies; it++) {
+    const auto& topo = topologies[it];
+    auto patt = topo.getPattern();
+    int id = lookup.findGroupID(topo.getRowSpan(), topo.getColumnSpan(), patt.data() + 2); // skip row/column span bytes
+    BOOST_REQUIRE(id >= 0 && id < dict.getSize());
+    if (it < NCommon) {
+      BOOST_CHECK(!lookup.isGroup(id));
+      BOOST_CHECK_EQUAL(dict.getHash(id), topo.getHash());
+    } else {
+      BOOST_CHECK(lookup.isGroup(id));
+    }
+  }
+  std::remove(dictFile.c_str());
+}
@@ -20,7 +20,8 @@
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "ITSMFTBase/SegmentationAlpide.h"
 #include "ITSMFTSimulation/PreDigit.h"
-#include <map>
+#include "PCG/pcg_random.hpp"
+#include <unordered_map>
 #include <vector>
 
 namespace o2
@@ -31,58 +32,134 @@ class DigiParams;
 
 /// @class ChipDigitsContainer
 /// @brief Container for similated points connected to a given chip
+///
+/// The fired pixels are stored per readout frame in flat vectors, with a pixel index for the
+/// accumulation of the contributions. The frame slots are reused once their digits are emitted.
+/// Each chip has its own random generator stream, so that chips can be digitized in parallel.
 
 class ChipDigitsContainer
 {
  public:
+  /// Pre-digits of a single readout frame
+  struct ROFDigits {
+    UInt_t roFrame = 0;                       ///< readout frame of the slot
+    bool inUse = false;                       ///< the slot is assigned to roFrame
+    std::vector<o2::itsmft::PreDigit> digits; ///< fired pixels
+    std::vector<PreDigitLabelRef> extra;      ///< extra contributions to the fired pixels
+    std::unordered_map<UInt_t, int> index;    ///< position of the fired pixels in digits
+  };
+
   /// Default constructor
   ChipDigitsContainer(UShort_t idx = 0) : mChipIndex(idx){};
 
   /// Destructor
   ~ChipDigitsContainer() = default;
 
-  std::map<ULong64_t, o2::itsmft::PreDigit>& getPreDigits() { return mDigits; }
-  bool isEmpty() const { return mDigits.empty(); }
+  bool isEmpty() const { return mNROFsInUse == 0; }
 
   void setChipIndex(UShort_t ind) { mChipIndex = ind; }
   UShort_t getChipIndex() const { return mChipIndex; }
 
-  o2::itsmft::PreDigit* findDigit(ULong64_t key);
-  void addDigit(ULong64_t key, UInt_t roframe, UShort_t row, UShort_t col, int charge, o2::MCCompLabel lbl);
+  /// Seed the random generator of the chip, the chip index is used as stream ID
+  void setSeed(ULong64_t seed) { mRandom.seed(seed, mChipIndex); }
+  pcg32& getRandom() { return mRandom; }
+
+  ROFDigits* findROF(UInt_t roframe);
+  ROFDigits& getROF(UInt_t roframe);
+  void releaseROF(ROFDigits& rof);
+
+  o2::itsmft::PreDigit* findDigit(UInt_t roframe, UShort_t row, UShort_t col);
+  o2::itsmft::PreDigit* addDigit(ROFDigits& rof, UShort_t row, UShort_t col, int charge, o2::MCCompLabel lbl);
   void addNoise(UInt_t rofMin, UInt_t rofMax, const o2::itsmft::DigiParams* params, int maxRows = o2::itsmft::SegmentationAlpide::NRows, int maxCols = o2::itsmft::SegmentationAlpide::NCols);
 
-  /// Get global ordering key made of readout frame, column and row
-  static ULong64_t getOrderingKey(UInt_t roframe, UShort_t row, UShort_t col)
-  {
-    return (static_cast<ULong64_t>(roframe) << (8 * sizeof(UInt_t))) + (col << (8 * sizeof(Short_t))) + row;
-  }
+  /// Sort the digits of the frame in column, row order and return the number of digits above the threshold.
+  /// The pixel index of the frame is not valid anymore afterwards, the frame must be released once emitted.
+  int sortDigits(ROFDigits& rof, int threshold);
 
-  /// Get ROFrame from the ordering key
-  static UInt_t key2ROFrame(ULong64_t key)
+  /// Get pixel key, made of column and row, defining the order of the digits in the frame
+  static UInt_t getPixelKey(UShort_t row, UShort_t col)
   {
-    return static_cast<UInt_t>(key >> (8 * sizeof(UInt_t)));
+    return (static_cast<UInt_t>(col) << (8 * sizeof(Short_t))) + row;
   }
 
  protected:
-  UShort_t mChipIndex = 0;                           ///< chip index
-  std::map<ULong64_t, o2::itsmft::PreDigit> mDigits; ///< Map of fired pixels, possibly in multiple frames
+  UShort_t mChipIndex = 0;      ///< chip index
+  int mNROFsInUse = 0;          ///< number of frame slots in use
+  std::vector<ROFDigits> mROFs; //! fired pixels per readout frame, possibly in multiple frames
+  pcg32 mRandom;                //! random generator of the chip
 
-  ClassDefNV(ChipDigitsContainer, 1);
+  ClassDefNV(ChipDigitsContainer, 2);
 };
 
 //_______________________________________________________________________
-inline o2::itsmft::PreDigit* ChipDigitsContainer::findDigit(ULong64_t key)
+inline ChipDigitsContainer::ROFDigits* ChipDigitsContainer::findROF(UInt_t roframe)
+{
+  // finds the slot of the readout frame, if any
+  for (auto& rof : mROFs) {
+    if (rof.inUse && rof.roFrame == roframe) {
+      return &rof;
+    }
+  }
+  return nullptr;
+}
+
+//_______________________________________________________________________
+inline ChipDigitsContainer::ROFDigits& ChipDigitsContainer::getROF(UInt_t roframe)
+{
+  // finds the slot of the readout frame, assigning a free one if needed
+  ROFDigits* freeSlot = nullptr;
+  for (auto& rof : mROFs) {
+    if (rof.inUse) {
+      if (rof.roFrame == roframe) {
+        return rof;
+      }
+    } else if (!freeSlot) {
+      freeSlot = &rof;
+    }
+  }
+  if (!freeSlot) {
+    freeSlot = &mROFs.emplace_back();
+  }
+  freeSlot->roFrame = roframe;
+  freeSlot->inUse = true;
+  mNROFsInUse++;
+  return *freeSlot;
+}
+
+//_______________________________________________________________________
+inline void ChipDigitsContainer::releaseROF(ROFDigits& rof)
 {
-  // finds the digit corresponding to global key
-  auto digitentry = mDigits.find(key);
-  return digitentry != mDigits.end() ? &(digitentry->second) : nullptr;
+  // clears the slot, keeping its capacity for the next frames
+  rof.digits.clear();
+  rof.extra.clear();
+  rof.index.clear();
+  rof.inUse = false;
+  mNROFsInUse--;
 }
 
 //_______________________________________________________________________
-inline void ChipDigitsContainer::addDigit(ULong64_t key, UInt_t roframe, UShort_t row, UShort_t col,
-                                          int charge, o2::MCCompLabel lbl)
+inline o2::itsmft::PreDigit* ChipDigitsContainer::findDigit(UInt_t roframe, UShort_t row, UShort_t col)
 {
-  mDigits.emplace(std::make_pair(key, o2::itsmft::PreDigit(roframe, row, col, charge, lbl)));
+  // finds the digit corresponding to the frame and pixel
+  auto rof = findROF(roframe);
+  if (!rof) {
+    return nullptr;
+  }
+  auto digitentry = rof->index.find(getPixelKey(row, col));
+  return digitentry != rof->index.end() ? &(rof->digits[digitentry->second]) : nullptr;
+}
+
+//_______________________________________________________________________
+inline o2::itsmft::PreDigit* ChipDigitsContainer::addDigit(ROFDigits& rof, UShort_t row, UShort_t col,
+                                                           int charge, o2::MCCompLabel lbl)
+{
+  // adds the digit to the frame or returns the existing one
+  auto [digitentry, isNew] = rof.index.emplace(getPixelKey(row, col), rof.digits.size());
+  if (!isNew) {
+    return &(rof.digits[digitentry->second]);
+  }
+  rof.digits.emplace_back(rof.roFrame, row, col, charge, lbl);
+  return nullptr;
 }
 } // namespace itsmft
 } // namespace o2
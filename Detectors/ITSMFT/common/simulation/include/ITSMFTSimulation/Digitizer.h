@@ -15,7 +15,6 @@
 #define ALICEO2_ITSMFT_DIGITIZER_H
 
 #include <vector>
-#include <deque>
 #include <memory>
 
 #include "Rtypes.h" // for Digitizer::Class
@@ -44,8 +43,6 @@ namespace itsmft
 {
 class Digitizer : public TObject
 {
-  using ExtraDig = std::vector<PreDigitLabelRef>; ///< container for extra contributions to PreDigits
-
  public:
   Digitizer() = default;
   ~Digitizer() override = default;
@@ -88,22 +85,13 @@ class Digitizer : public TObject
     mEventROFrameMax = 0;
   }
 
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
  private:
-  void processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID, int srcID);
+  void processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, uint32_t& evROFMin, uint32_t& evROFMax, int evID, int srcID);
   void registerDigits(ChipDigitsContainer& chip, uint32_t roFrame, float tInROF, int nROF,
-                      uint16_t row, uint16_t col, int nEle, o2::MCCompLabel& lbl);
-
-  ExtraDig* getExtraDigBuffer(uint32_t roFrame)
-  {
-    if (mROFrameMin > roFrame) {
-      return nullptr; // nothing to do
-    }
-    int ind = roFrame - mROFrameMin;
-    while (ind >= int(mExtraBuff.size())) {
-      mExtraBuff.emplace_back(std::make_unique<ExtraDig>());
-    }
-    return mExtraBuff[ind].get();
-  }
+                      uint16_t row, uint16_t col, int nEle, o2::MCCompLabel& lbl, uint32_t& evROFMin, uint32_t& evROFMax);
 
   static constexpr float sec2ns = 1e9;
 
@@ -123,13 +111,15 @@ class Digitizer : public TObject
   const o2::itsmft::GeometryTGeo* mGeometry = nullptr; ///< ITS OR MFT upgrade geometry
 
   std::vector<o2::itsmft::ChipDigitsContainer> mChips; ///< Array of chips digits containers
-  std::deque<std::unique_ptr<ExtraDig>> mExtraBuff;    ///< burrer (per roFrame) for extra digits
+  std::vector<size_t> mChipDigitsOffset;               //! position of the chips digits of the frame in the output
+  std::vector<int> mHitChipStart;                      //! start of the hits of every chip in the sorted hits
+  int mNThreads = 1;                                   ///< number of threads for the chips digitization
 
   std::vector<o2::itsmft::Digit>* mDigits = nullptr;                       //! output digits
   std::vector<o2::itsmft::ROFRecord>* mROFRecords = nullptr;               //! output ROF records
   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mMCLabels = nullptr; //! output labels
 
-  ClassDefOverride(Digitizer, 2);
+  ClassDefOverride(Digitizer, 3);
 };
 } // namespace itsmft
 } // namespace o2
@@ -16,7 +16,8 @@
 
 #include "ITSMFTSimulation/ChipDigitsContainer.h"
 #include "ITSMFTSimulation/DigiParams.h"
-#include <TRandom.h>
+#include <algorithm>
+#include <random>
 
 using namespace o2::itsmft;
 using Segmentation = o2::itsmft::SegmentationAlpide;
@@ -33,17 +34,32 @@ void ChipDigitsContainer::addNoise(UInt_t rofMin, UInt_t rofMax, const o2::itsmf
 
   float mean = params->getNoisePerPixel() * Segmentation::NPixels;
   int nel = params->getChargeThreshold() * 1.1; // RS: TODO: need realistic spectrum of noise above the threshold
+  if (mean <= 0.f) {
+    return;
+  }
+  std::poisson_distribution<Int_t> poisson(mean);
 
   for (UInt_t rof = rofMin; rof <= rofMax; rof++) {
-    nhits = gRandom->Poisson(mean);
+    nhits = poisson(mRandom);
+    if (!nhits) {
+      continue;
+    }
+    auto& rofDigits = getROF(rof);
     for (Int_t i = 0; i < nhits; ++i) {
-      row = gRandom->Integer(maxRows);
-      col = gRandom->Integer(maxCols);
+      row = mRandom(maxRows);
+      col = mRandom(maxCols);
       // RS TODO: why the noise was added with 0 charge? It should be above the threshold!
-      auto key = getOrderingKey(rof, row, col);
-      if (!findDigit(key)) {
-        addDigit(key, rof, row, col, nel, o2::MCCompLabel(true));
-      }
+      addDigit(rofDigits, row, col, nel, o2::MCCompLabel(true));
     }
   }
 }
+
+//______________________________________________________________________
+int ChipDigitsContainer::sortDigits(ROFDigits& rof, int threshold)
+{
+  auto& digits = rof.digits;
+  std::sort(digits.begin(), digits.end(), [](const PreDigit& a, const PreDigit& b) {
+    return getPixelKey(a.row, a.col) < getPixelKey(b.row, b.col);
+  });
+  return std::count_if(digits.begin(), digits.end(), [threshold](const PreDigit& d) { return d.charge >= threshold; });
+}
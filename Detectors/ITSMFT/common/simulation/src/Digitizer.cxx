@@ -20,9 +20,11 @@
 #include "DetectorsRaw/HBFUtils.h"
 
 #include <TRandom.h>
+#include <atomic>
 #include <climits>
 #include <vector>
 #include <numeric>
+#include <random>
 #include "FairLogger.h" // for LOG
 
 using o2::itsmft::Digit;
@@ -37,9 +39,13 @@ void Digitizer::init()
 {
   const Int_t numOfChips = mGeometry->getNumberOfChips();
   mChips.resize(numOfChips);
+  // every chip has its own random stream, so that the result does not depend on the number of threads
+  ULong64_t seed = gRandom->Integer(0xffffffff);
   for (int i = numOfChips; i--;) {
     mChips[i].setChipIndex(i);
+    mChips[i].setSeed(seed);
   }
+  mChipDigitsOffset.resize(numOfChips + 1);
   if (!mParams.getAlpSimResponse()) {
     mAlpSimResp = std::make_unique<o2::itsmft::AlpideSimResponse>();
     mAlpSimResp->initData();
@@ -72,9 +78,27 @@ void Digitizer::process(const std::vector<Hit>* hits, int evID, int srcID)
             [hits](auto lhs, auto rhs) {
               return (*hits)[lhs].GetDetectorID() < (*hits)[rhs].GetDetectorID();
             });
-  for (int i : hitIdx) {
-    processHit((*hits)[i], mROFrameMax, evID, srcID);
+  // group the hits per chip: the chips are digitized independently
+  mHitChipStart.clear();
+  for (int i = 0; i < nHits; i++) {
+    if (!i || (*hits)[hitIdx[i]].GetDetectorID() != (*hits)[hitIdx[i - 1]].GetDetectorID()) {
+      mHitChipStart.push_back(i);
+    }
+  }
+  mHitChipStart.push_back(nHits);
+  int nChipsHit = mHitChipStart.size() - 1;
+  uint32_t maxFr = mROFrameMax, evROFMin = mEventROFrameMin, evROFMax = mEventROFrameMax;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads) reduction(max : maxFr, evROFMax) reduction(min : evROFMin)
+#endif
+  for (int ic = 0; ic < nChipsHit; ic++) {
+    for (int i = mHitChipStart[ic]; i < mHitChipStart[ic + 1]; i++) {
+      processHit((*hits)[hitIdx[i]], maxFr, evROFMin, evROFMax, evID, srcID);
+    }
   }
+  mROFrameMax = maxFr;
+  mEventROFrameMin = evROFMin;
+  mEventROFrameMax = evROFMax;
   // in the triggered mode store digits after every MC event
   // TODO: in the real triggered mode this will not be needed, this is actually for the
   // single event processing only
@@ -123,46 +147,72 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
   if (frameLast > mROFrameMax) {
     frameLast = mROFrameMax;
   }
-  // make sure all buffers for extra digits are created up to the maxFrame
-  getExtraDigBuffer(mROFrameMax);
 
   LOG(INFO) << "Filling " << mGeometry->getName() << " digits output for RO frames " << mROFrameMin << ":"
             << frameLast;
 
   o2::itsmft::ROFRecord rcROF;
+  int nChips = mChips.size();
+  int threshold = mParams.getChargeThreshold();
 
   // we have to write chips in RO increasing order, therefore have to loop over the frames here
   for (; mROFrameMin <= frameLast; mROFrameMin++) {
     rcROF.setROFrame(mROFrameMin);
     rcROF.setFirstEntry(mDigits->size()); // start of current ROF in digits
 
-    auto& extra = *(mExtraBuff.front().get());
-    for (auto& chip : mChips) {
+    // add the noise and sort the digits of the frame in every chip
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(mNThreads)
+#endif
+    for (int ich = 0; ich < nChips; ich++) {
+      auto& chip = mChips[ich];
       chip.addNoise(mROFrameMin, mROFrameMin, &mParams);
-      auto& buffer = chip.getPreDigits();
-      if (buffer.empty()) {
+      auto rof = chip.findROF(mROFrameMin);
+      mChipDigitsOffset[ich + 1] = rof ? chip.sortDigits(*rof, threshold) : 0;
+    }
+
+    // the digits are written directly at their final position in the output
+    mChipDigitsOffset[0] = mDigits->size();
+    for (int ich = 0; ich < nChips; ich++) {
+      mChipDigitsOffset[ich + 1] += mChipDigitsOffset[ich];
+    }
+    mDigits->resize(mChipDigitsOffset[nChips]);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(mNThreads)
+#endif
+    for (int ich = 0; ich < nChips; ich++) {
+      if (mChipDigitsOffset[ich + 1] == mChipDigitsOffset[ich]) {
         continue;
       }
-      auto itBeg = buffer.begin();
-      auto iter = itBeg;
-      ULong64_t maxKey = chip.getOrderingKey(mROFrameMin + 1, 0, 0) - 1; // fetch digits with key below that
-      for (; iter != buffer.end(); ++iter) {
-        if (iter->first > maxKey) {
-          break; // is the digit ROFrame from the key > the max requested frame
+      auto& chip = mChips[ich];
+      auto digID = mChipDigitsOffset[ich];
+      for (const auto& preDig : chip.findROF(mROFrameMin)->digits) {
+        if (preDig.charge >= threshold) {
+          (*mDigits)[digID++] = Digit(chip.getChipIndex(), preDig.row, preDig.col, preDig.charge);
         }
-        auto& preDig = iter->second; // preDigit
-        if (preDig.charge >= mParams.getChargeThreshold()) {
-          int digID = mDigits->size();
-          mDigits->emplace_back(chip.getChipIndex(), preDig.row, preDig.col, preDig.charge);
+      }
+    }
+
+    // labels are attached in the digits order
+    for (int ich = 0; ich < nChips; ich++) {
+      auto& chip = mChips[ich];
+      auto rof = chip.isEmpty() ? nullptr : chip.findROF(mROFrameMin);
+      if (!rof) {
+        continue;
+      }
+      auto digID = mChipDigitsOffset[ich];
+      for (auto& preDig : rof->digits) {
+        if (preDig.charge >= threshold) {
           mMCLabels->addElement(digID, preDig.labelRef.label);
           auto& nextRef = preDig.labelRef; // extra contributors are in extra array
           while (nextRef.next >= 0) {
-            nextRef = extra[nextRef.next];
+            nextRef = rof->extra[nextRef.next];
             mMCLabels->addElement(digID, nextRef.label);
           }
+          digID++;
         }
       }
-      buffer.erase(itBeg, iter);
+      chip.releaseROF(*rof);
     }
     // finalize ROF record
     rcROF.setNEntries(mDigits->size() - rcROF.getFirstEntry()); // number of digits
@@ -174,21 +224,17 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
     if (mROFRecords) {
       mROFRecords->push_back(rcROF);
     }
-    extra.clear(); // clear container for extra digits of the mROFrameMin ROFrame
-    // and move it as a new slot in the end
-    mExtraBuff.emplace_back(mExtraBuff.front().release());
-    mExtraBuff.pop_front();
   }
 }
 
 //_______________________________________________________________________
-void Digitizer::processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID, int srcID)
+void Digitizer::processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, uint32_t& evROFMin, uint32_t& evROFMax, int evID, int srcID)
 {
   // convert single hit to digits
   float timeInROF = hit.GetTime() * sec2ns;
   if (timeInROF > 20e3) {
     const int maxWarn = 10;
-    static int warnNo = 0;
+    static std::atomic<int> warnNo{0};
     if (warnNo < maxWarn) {
       LOG(WARNING) << "Ignoring hit with time_in_event = " << timeInROF << " ns"
                    << ((++warnNo < maxWarn) ? "" : " (suppressing further warnings)");
@@ -334,21 +380,22 @@ void Digitizer::processHit(const o2::itsmft::Hit& hit, uint32_t& maxFr, int evID
       if (!nEleResp) {
         continue;
       }
-      int nEle = gRandom->Poisson(nElectrons * nEleResp); // total charge in given pixel
+      float nEleMean = nElectrons * nEleResp;
+      int nEle = nEleMean > 0.f ? std::poisson_distribution<int>(nEleMean)(chip.getRandom()) : 0; // total charge in given pixel
       // ignore charge which have no chance to fire the pixel
       if (nEle < mParams.getMinChargeToAccount()) {
         continue;
       }
       uint16_t colIS = icol + colS;
       //
-      registerDigits(chip, roFrameAbs, timeInROF, nFrames, rowIS, colIS, nEle, lbl);
+      registerDigits(chip, roFrameAbs, timeInROF, nFrames, rowIS, colIS, nEle, lbl, evROFMin, evROFMax);
     }
   }
 }
 
 //________________________________________________________________________________
 void Digitizer::registerDigits(ChipDigitsContainer& chip, uint32_t roFrame, float tInROF, int nROF,
-                               uint16_t row, uint16_t col, int nEle, o2::MCCompLabel& lbl)
+                               uint16_t row, uint16_t col, int nEle, o2::MCCompLabel& lbl, uint32_t& evROFMin, uint32_t& evROFMax)
 {
   // Register digits for given pixel, accounting for the possible signal contribution to
   // multiple ROFrame. The signal starts at time tInROF wrt the start of provided roFrame
@@ -364,22 +411,20 @@ void Digitizer::registerDigits(ChipDigitsContainer& chip, uint32_t roFrame, floa
     if (nEleROF < mParams.getMinChargeToAccount()) {
       continue;
     }
-    if (roFr > mEventROFrameMax) {
-      mEventROFrameMax = roFr;
+    if (roFr > evROFMax) {
+      evROFMax = roFr;
     }
-    if (roFr < mEventROFrameMin) {
-      mEventROFrameMin = roFr;
+    if (roFr < evROFMin) {
+      evROFMin = roFr;
     }
-    auto key = chip.getOrderingKey(roFr, row, col);
-    PreDigit* pd = chip.findDigit(key);
-    if (!pd) {
-      chip.addDigit(key, roFr, row, col, nEleROF, lbl);
-    } else { // there is already a digit at this slot, account as PreDigitExtra contribution
+    auto& rofDigits = chip.getROF(roFr);
+    PreDigit* pd = chip.addDigit(rofDigits, row, col, nEleROF, lbl);
+    if (pd) { // there is already a digit at this slot, account as PreDigitExtra contribution
       pd->charge += nEleROF;
       if (pd->labelRef.label == lbl) { // don't store the same label twice
         continue;
       }
-      ExtraDig* extra = getExtraDigBuffer(roFr);
+      auto* extra = &rofDigits.extra;
       int& nxt = pd->labelRef.next;
       bool skip = false;
       while (nxt >= 0) {
@@ -398,3 +443,17 @@ void Digitizer::registerDigits(ChipDigitsContainer& chip, uint32_t roFrame, floa
     }
   }
 }
+
+//________________________________________________________________________________
+void Digitizer::setNThreads(int n)
+{
+  // set the number of threads for the digitization of the chips
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  if (n > 1) {
+    LOG(WARNING) << "Multithreading is not supported, imposing single thread";
+  }
+  mNThreads = 1;
+#endif
+}
@@ -61,11 +61,13 @@ void STFDecoder<Mapping>::init(InitContext& ic)
   mDecoder->setNThreads(mNThreads);
   mDecoder->setFormat(ic.options().get<bool>("old-format") ? GBTLink::OldFormat : GBTLink::NewFormat);
   mDecoder->setVerbosity(ic.options().get<int>("decoder-verbosity"));
+  AlpideCoder::setFastDecoding(ic.options().get<bool>("alpide-fast-decoding"));
   mDecoder->setFillCalibData(mDoCalibData);
   std::string noiseFile = o2::base::NameConf::getAlpideClusterDictionaryFileName(detID, mNoiseName, "root");
   if (o2::utils::Str::pathExists(noiseFile)) {
     TFile* f = TFile::Open(noiseFile.data(), "old");
     auto pnoise = (NoiseMap*)f->Get("Noise");
+    pnoise->buildMask(); // compact mask for the per-pixel check of the decoder
     AlpideCoder::setNoisyPixels(pnoise);
     LOG(INFO) << mSelfName << " loading noise map file: " << noiseFile;
   } else {
@@ -222,6 +224,7 @@ DataProcessorSpec getSTFDecoderITSSpec(bool doClusters, bool doPatterns, bool do
     Options{
       {"nthreads", VariantType::Int, 1, {"Number of decoding/clustering threads"}},
       {"old-format", VariantType::Bool, false, {"Use old format (1 trigger per CRU page)"}},
+      {"alpide-fast-decoding", VariantType::Bool, false, {"Use table-driven fast path for the ALPIDE hit records decoding"}},
       {"decoder-verbosity", VariantType::Int, 0, {"Verbosity level (-1: silent, 0: errors, 1: headers, 2: data)"}}}};
 }
 
@@ -258,6 +261,7 @@ DataProcessorSpec getSTFDecoderMFTSpec(bool doClusters, bool doPatterns, bool do
     Options{
       {"nthreads", VariantType::Int, 1, {"Number of decoding/clustering threads"}},
       {"old-format", VariantType::Bool, false, {"Use old format (1 trigger per CRU page)"}},
+      {"alpide-fast-decoding", VariantType::Bool, false, {"Use table-driven fast path for the ALPIDE hit records decoding"}},
       {"decoder-verbosity", VariantType::Int, 0, {"Verbosity level (-1: silent, 0: errors, 1: headers, 2: data)"}}}};
 }
 
@@ -27,6 +27,8 @@
 
 #include <TH2D.h>
 
+class TRandom;
+
 #include "DataFormatsMCH/Digit.h"
 #include "MCHBase/ClusterBlock.h"
 #include "MCHMappingInterface/Segmentation.h"
@@ -56,6 +58,9 @@ class ClusterFinderOriginal
   void deinit();
   void reset();
 
+  void useMathiesonLUT(bool useLUT);
+  void useOwnRandomGenerator(bool useOwn);
+
   void findClusters(gsl::span<const Digit> digits);
 
   /// return the list of reconstructed clusters
@@ -120,9 +125,15 @@ class ClusterFinderOriginal
   std::unique_ptr<MathiesonOriginal[]> mMathiesons; ///< Mathieson functions for station 1 and the others
   MathiesonOriginal* mMathieson = nullptr;          ///< pointer to the Mathieson function currently used
 
+  std::unique_ptr<TRandom> mRandom{}; ///< own random generator reseeded for every precluster, if any (gRandom otherwise)
+
   std::unique_ptr<ClusterOriginal> mPreCluster; ///< precluster currently processed
   std::vector<PadOriginal> mPixels;             ///< list of pixels for the current precluster
 
+  /// buffers of the pad limits relative to the pixels and of the resulting Mathieson integrals
+  mutable std::vector<float> mIntegralLimits[4]{};
+  mutable std::vector<float> mIntegrals{};
+
   const mapping::Segmentation* mSegmentation = nullptr; ///< pointer to the DE segmentation for the current precluster
 
   std::vector<ClusterStruct> mClusters{}; ///< list of reconstructed clusters
@@ -41,6 +41,8 @@ struct ClusterizerParam : public o2::conf::ConfigurableParamHelper<ClusterizerPa
   double defaultClusterResolution = 0.2; ///< default cluster resolution (cm)
   double badClusterResolution = 10.;     ///< bad (e.g. mono-cathode) cluster resolution (cm)
 
+  bool useMathiesonLUT = true; ///< compute the Mathieson integrals from tabulated primitives instead of the exact formula
+
   O2ParamDef(ClusterizerParam, "MCHClustering");
 };
 
@@ -32,6 +32,7 @@
 #include <TAxis.h>
 #include <TMath.h>
 #include <TRandom.h>
+#include <TRandom3.h>
 
 #include <FairMQLogger.h>
 
@@ -104,6 +105,8 @@ void ClusterFinderOriginal::init(bool run2Config)
     mMathiesons[1].setSqrtKx3AndDeriveKx2Kx4(ClusterizerParam::Instance().mathiesonSqrtKx3St2345);
     mMathiesons[1].setSqrtKy3AndDeriveKy2Ky4(ClusterizerParam::Instance().mathiesonSqrtKy3St2345);
   }
+
+  useMathiesonLUT(ClusterizerParam::Instance().useMathiesonLUT);
 }
 
 //_________________________________________________________________________________________________
@@ -121,6 +124,27 @@ void ClusterFinderOriginal::reset()
   mUsedDigits.clear();
 }
 
+//_________________________________________________________________________________________________
+void ClusterFinderOriginal::useMathiesonLUT(bool useLUT)
+{
+  /// compute the Mathieson integrals from tabulated primitives (faster) or with the exact formula
+  mMathiesons[0].useLUT(useLUT);
+  mMathiesons[1].useLUT(useLUT);
+}
+
+//_________________________________________________________________________________________________
+void ClusterFinderOriginal::useOwnRandomGenerator(bool useOwn)
+{
+  /// use an own random generator in the fit, reseeded for every precluster from its content, instead of gRandom
+  /// the results then no longer depend on the order in which the preclusters are processed,
+  /// e.g. when several cluster finders run in parallel, but they change with respect to the use of gRandom
+  if (useOwn) {
+    mRandom = std::make_unique<TRandom3>();
+  } else {
+    mRandom.reset();
+  }
+}
+
 //_________________________________________________________________________________________________
 void ClusterFinderOriginal::findClusters(gsl::span<const Digit> digits)
 {
@@ -135,6 +159,12 @@ void ClusterFinderOriginal::findClusters(gsl::span<const Digit> digits)
   // set the Mathieson function to be used
   mMathieson = (digits[0].getDetID() < 300) ? &mMathiesons[0] : &mMathiesons[1];
 
+  // reseed the own random generator, if any, from the precluster (0 would mean a random seed)
+  if (mRandom) {
+    uint32_t seed = (static_cast<uint32_t>(digits[0].getDetID()) << 20) ^ (static_cast<uint32_t>(digits[0].getPadID()) << 4) ^ digits.size();
+    mRandom->SetSeed(seed | 0x1);
+  }
+
   // reset the current precluster being processed
   resetPreCluster(digits);
 
@@ -962,19 +992,37 @@ void ClusterFinderOriginal::computeCoefficients(std::vector<double>& coef, std::
   coef.assign(mPreCluster->multiplicity() * mPixels.size(), 0.);
   prob.assign(mPixels.size(), 0.);
 
+  int nPixels = mPixels.size();
+  for (auto& limits : mIntegralLimits) {
+    limits.resize(nPixels);
+  }
+  mIntegrals.resize(nPixels);
+
   int iCoef(0);
   for (const auto& pad : *mPreCluster) {
 
     // ignore the pads that must not be considered
     if (pad.status() != PadOriginal::kZero) {
-      iCoef += mPixels.size();
+      iCoef += nPixels;
       continue;
     }
 
-    for (int i = 0; i < mPixels.size(); ++i) {
+    // charge (given by Mathieson integral) on pad, assuming the Mathieson is center at pixel,
+    // computed for all the pixels at once (same as chargeIntegration(...) for each of them)
+    for (int i = 0; i < nPixels; ++i) {
+      double xPad = pad.x() - mPixels[i].x();
+      double yPad = pad.y() - mPixels[i].y();
+      mIntegralLimits[0][i] = xPad - pad.dx();
+      mIntegralLimits[1][i] = yPad - pad.dy();
+      mIntegralLimits[2][i] = xPad + pad.dx();
+      mIntegralLimits[3][i] = yPad + pad.dy();
+    }
+    mMathieson->integrate(nPixels, mIntegralLimits[0].data(), mIntegralLimits[1].data(),
+                          mIntegralLimits[2].data(), mIntegralLimits[3].data(), mIntegrals.data());
+
+    for (int i = 0; i < nPixels; ++i) {
 
-      // charge (given by Mathieson integral) on pad, assuming the Mathieson is center at pixel.
-      coef[iCoef] = chargeIntegration(mPixels[i].x(), mPixels[i].y(), pad);
+      coef[iCoef] = mIntegrals[i];
 
       // update the pixel visibility
       prob[i] += coef[iCoef];
@@ -1620,7 +1668,7 @@ double ClusterFinderOriginal::fit(double currentParam[SNFitParamMax + 2],
       }
       if (nFail > 10) {
         currentParam[iDerivMax] -= shift[iDerivMax];
-        shift[iDerivMax] = 4. * shiftSave * (gRandom->Rndm(0) - 0.5);
+        shift[iDerivMax] = 4. * shiftSave * ((mRandom ? mRandom.get() : gRandom)->Rndm(0) - 0.5);
         currentParam[iDerivMax] += shift[iDerivMax];
       }
     }
@@ -16,6 +16,8 @@
 
 #include "MathiesonOriginal.h"
 
+#include <cmath>
+
 #include <TMath.h>
 
 namespace o2
@@ -32,6 +34,9 @@ void MathiesonOriginal::setSqrtKx3AndDeriveKx2Kx4(float sqrtKx3)
   mKx2 = TMath::Pi() / 2. * (1. - 0.5 * mSqrtKx3);
   float cx1 = mKx2 * mSqrtKx3 / 4. / TMath::ATan(static_cast<double>(mSqrtKx3));
   mKx4 = cx1 / mKx2 / mSqrtKx3;
+  if (mUseLUT) {
+    tabulate(mSqrtKx3, mLUTX);
+  }
 }
 
 //_________________________________________________________________________________________________
@@ -43,12 +48,82 @@ void MathiesonOriginal::setSqrtKy3AndDeriveKy2Ky4(float sqrtKy3)
   mKy2 = TMath::Pi() / 2. * (1. - 0.5 * mSqrtKy3);
   float cy1 = mKy2 * mSqrtKy3 / 4. / TMath::ATan(static_cast<double>(mSqrtKy3));
   mKy4 = cy1 / mKy2 / mSqrtKy3;
+  if (mUseLUT) {
+    tabulate(mSqrtKy3, mLUTY);
+  }
 }
 
 //_________________________________________________________________________________________________
+void MathiesonOriginal::useLUT(bool useLUT)
+{
+  /// compute the integrals from tabulated primitives of the Mathieson instead of the exact formula
+  /// the Mathieson parameters must be set before, the tables are updated if they change afterward
+  mUseLUT = useLUT;
+  if (mUseLUT) {
+    tabulate(mSqrtKx3, mLUTX);
+    tabulate(mSqrtKy3, mLUTY);
+  } else {
+    mLUTX.clear();
+    mLUTY.clear();
+  }
+}
+
 float MathiesonOriginal::integrate(float xMin, float yMin, float xMax, float yMax) const
 {
   /// integrate the Mathieson over x and y in the given area
+  return static_cast<float>(mUseLUT ? integrateLUT(xMin, yMin, xMax, yMax) : integrateExact(xMin, yMin, xMax, yMax));
+}
+
+void MathiesonOriginal::integrate(int n, const float* xMin, const float* yMin, const float* xMax, const float* yMax,
+                                  float* integrals) const
+{
+  /// integrate the Mathieson over x and y in n areas given as arrays of limits
+  /// the choice of the method is done once for all, to let the compiler optimize the loops
+  if (mUseLUT) {
+    for (int i = 0; i < n; ++i) {
+      integrals[i] = static_cast<float>(integrateLUT(xMin[i], yMin[i], xMax[i], yMax[i]));
+    }
+  } else {
+    for (int i = 0; i < n; ++i) {
+      integrals[i] = static_cast<float>(integrateExact(xMin[i], yMin[i], xMax[i], yMax[i]));
+    }
+  }
+}
+
+void MathiesonOriginal::tabulate(float sqrtK3, std::vector<double>& lut)
+{
+  /// tabulate the primitive atan(sqrt(K3) * tanh(w)) of the Mathieson, with w = K2 * distance / pitch,
+  /// and its derivative, for cubic Hermite interpolation between the nodes (precision ~1.e-10)
+  lut.resize(2 * (SLUTNBins + 1));
+  double step = 1. / SLUTInverseStep;
+  double k3 = static_cast<double>(sqrtK3) * sqrtK3;
+  for (int i = 0; i <= SLUTNBins; ++i) {
+    double tanhW = std::tanh(i * step);
+    lut[2 * i] = std::atan(sqrtK3 * tanhW);
+    lut[2 * i + 1] = step * sqrtK3 * (1. - tanhW * tanhW) / (1. + k3 * tanhW * tanhW); // derivative in units of the step
+  }
+}
+
+double MathiesonOriginal::interpolate(const std::vector<double>& lut, double w)
+{
+  /// return the tabulated primitive at w, using the symmetry of the function and its saturation above SLUTMax
+  double a = std::abs(w) * SLUTInverseStep;
+  if (a >= SLUTNBins) {
+    return std::copysign(lut[2 * SLUTNBins], w);
+  }
+  int i = static_cast<int>(a);
+  double t = a - i;
+  double t2 = t * t;
+  double t3 = t2 * t;
+  const double* node = &lut[2 * i];
+  double value = (2. * t3 - 3. * t2 + 1.) * node[0] + (t3 - 2. * t2 + t) * node[1] +
+                 (3. * t2 - 2. * t3) * node[2] + (t3 - t2) * node[3];
+  return std::copysign(value, w);
+}
+
+double MathiesonOriginal::integrateExact(float xMin, float yMin, float xMax, float yMax) const
+{
+  /// integrate the Mathieson over x and y in the given area using the exact formula
 
   xMin *= mInversePitch;
   xMax *= mInversePitch;
@@ -62,8 +137,21 @@ float MathiesonOriginal::integrate(float xMin, float yMin, float xMax, float yMa
   double uyMin = mSqrtKy3 * TMath::TanH(mKy2 * yMin);
   double uyMax = mSqrtKy3 * TMath::TanH(mKy2 * yMax);
 
-  return static_cast<float>(4. * mKx4 * (TMath::ATan(uxMax) - TMath::ATan(uxMin)) *
-                            mKy4 * (TMath::ATan(uyMax) - TMath::ATan(uyMin)));
+  return 4. * mKx4 * (TMath::ATan(uxMax) - TMath::ATan(uxMin)) *
+         mKy4 * (TMath::ATan(uyMax) - TMath::ATan(uyMin));
+}
+
+double MathiesonOriginal::integrateLUT(float xMin, float yMin, float xMax, float yMax) const
+{
+  /// integrate the Mathieson over x and y in the given area using the tabulated primitives
+
+  xMin *= mInversePitch;
+  xMax *= mInversePitch;
+  yMin *= mInversePitch;
+  yMax *= mInversePitch;
+
+  return 4. * mKx4 * (interpolate(mLUTX, mKx2 * xMax) - interpolate(mLUTX, mKx2 * xMin)) *
+         mKy4 * (interpolate(mLUTY, mKy2 * yMax) - interpolate(mLUTY, mKy2 * yMin));
 }
 
 } // namespace mch
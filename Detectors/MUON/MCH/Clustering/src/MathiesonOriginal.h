@@ -17,6 +17,8 @@
 #ifndef ALICEO2_MCH_MATHIESONORIGINAL_H_
 #define ALICEO2_MCH_MATHIESONORIGINAL_H_
 
+#include <vector>
+
 namespace o2
 {
 namespace mch
@@ -40,9 +42,24 @@ class MathiesonOriginal
   void setSqrtKx3AndDeriveKx2Kx4(float sqrtKx3);
   void setSqrtKy3AndDeriveKy2Ky4(float sqrtKy3);
 
+  void useLUT(bool useLUT);
+  /// return true if the integrals are computed from the tabulated primitives
+  bool isUsingLUT() const { return mUseLUT; }
+
   float integrate(float xMin, float yMin, float xMax, float yMax) const;
+  void integrate(int n, const float* xMin, const float* yMin, const float* xMax, const float* yMax, float* integrals) const;
 
  private:
+  static constexpr int SLUTNBins = 1536;                         ///< number of bins of the tabulated primitives
+  static constexpr double SLUTMax = 12.;                         ///< upper limit of the tabulated primitives (in K2 * distance / pitch)
+  static constexpr double SLUTInverseStep = SLUTNBins / SLUTMax; ///< inverse of the bin width of the tabulated primitives
+
+  static void tabulate(float sqrtK3, std::vector<double>& lut);
+  static double interpolate(const std::vector<double>& lut, double w);
+
+  double integrateExact(float xMin, float yMin, float xMax, float yMax) const;
+  double integrateLUT(float xMin, float yMin, float xMax, float yMax) const;
+
   float mSqrtKx3 = 0.;      ///< Mathieson Sqrt(Kx3)
   float mKx2 = 0.;          ///< Mathieson Kx2
   float mKx4 = 0.;          ///< Mathieson Kx4 = Kx1/Kx2/Sqrt(Kx3)
@@ -50,6 +67,10 @@ class MathiesonOriginal
   float mKy2 = 0.;          ///< Mathieson Ky2
   float mKy4 = 0.;          ///< Mathieson Ky4 = Ky1/Ky2/Sqrt(Ky3)
   float mInversePitch = 0.; ///< 1 / anode-cathode pitch
+
+  bool mUseLUT = false;        ///< compute the integrals from the tabulated primitives
+  std::vector<double> mLUTX{}; ///< tabulated primitive in x direction and its derivative, interleaved
+  std::vector<double> mLUTY{}; ///< tabulated primitive in y direction and its derivative, interleaved
 };
 
 } // namespace mch
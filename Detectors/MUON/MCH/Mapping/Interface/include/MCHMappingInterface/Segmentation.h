@@ -18,6 +18,10 @@
 #define O2_MCH_MAPPING_SEGMENTATION_H
 
 #include "MCHMappingInterface/CathodeSegmentation.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 namespace o2
 {
@@ -56,6 +60,12 @@ namespace mapping
 /// - all the pads belonging to a given dual sampa
 /// - all the pads within a given area (box)
 /// - all the pads that are neighbours of a given pad
+///
+/// The pad information, the (dual sampa, channel) to pad correspondence and a
+/// uniform grid of the pads (used to find them by position) are flattened into
+/// plain arrays when the Segmentation is constructed, so that the pad finding
+/// and information retrieval methods do not go through the (slower)
+/// CathodeSegmentation implementation.
 
 class Segmentation
 {
@@ -139,14 +149,47 @@ class Segmentation
   Segmentation& operator=(Segmentation seg);
 
  private:
+  /// Uniform grid covering one cathode, each cell holding the list (dePadIndex) of the pads it overlaps
+  struct PadGrid {
+    double xMin{0.};                ///< lower x edge of the grid
+    double yMin{0.};                ///< lower y edge of the grid
+    double inverseCellSizeX{0.};    ///< 1 / cell size in x direction
+    double inverseCellSizeY{0.};    ///< 1 / cell size in y direction
+    int nCellsX{0};                 ///< number of cells in x direction
+    int nCellsY{0};                 ///< number of cells in y direction
+    std::vector<int> cellFirstPad{}; ///< index of the first pad of each cell in cellPads (+ end of the last cell)
+    std::vector<int> cellPads{};     ///< pads overlapping each cell
+  };
+
+  static constexpr int SMaxNofCellsPerGrid = 1 << 17; ///< maximum number of cells of a cathode grid
+  static constexpr int SAmbiguousPad = -2;            ///< the grid cannot decide which pad is at a given position
+  static constexpr double SPadTolerance = 1.e-4;      ///< tolerance (cm) used by CathodeSegmentation::findPadByPosition
+  static constexpr double SEdgePrecision = 1.e-9;     ///< distance (cm) to a pad edge below which the grid is ambiguous
+
   int padC2DE(int catPadIndex, bool isBending) const;
   void catSegPad(int dePadIndex, const CathodeSegmentation*& catseg, int& padcuid) const;
 
+  void fillPadCache();
+  void fillPadGrid(PadGrid& grid, int firstPad, int lastPad);
+  int findPadByPositionInGrid(const PadGrid& grid, double x, double y) const;
+  int findPadByPosition(bool isBending, double x, double y) const;
+
  private:
   int mDetElemId;
   CathodeSegmentation mBending;
   CathodeSegmentation mNonBending;
   int mPadIndexOffset = 0;
+
+  std::vector<double> mPadPositionX{};     ///< pad x positions, per dePadIndex
+  std::vector<double> mPadPositionY{};     ///< pad y positions, per dePadIndex
+  std::vector<double> mPadSizeX{};         ///< pad sizes in x direction, per dePadIndex
+  std::vector<double> mPadSizeY{};         ///< pad sizes in y direction, per dePadIndex
+  std::vector<int> mPadDualSampaId{};      ///< pad dual sampa ids, per dePadIndex
+  std::vector<int> mPadDualSampaChannel{}; ///< pad dual sampa channels, per dePadIndex
+  std::vector<int> mDualSampaFirstPad{};   ///< offset of each dual sampa (per id) in mDualSampaPads, -1 if absent
+  std::vector<int> mDualSampaPads{};       ///< dePadIndex connected to each of the 64 channels of the dual sampas
+  PadGrid mBendingGrid{};                  ///< grid of the bending pads
+  PadGrid mNonBendingGrid{};               ///< grid of the non-bending pads
 };
 
 /// segmentation(int) is a convenience function that
@@ -18,6 +18,7 @@ namespace mapping
 
 inline Segmentation::Segmentation(int deid) : mDetElemId{deid}, mBending{CathodeSegmentation(deid, true)}, mNonBending{CathodeSegmentation(deid, false)}, mPadIndexOffset{mBending.nofPads()}
 {
+  fillPadCache();
 }
 
 inline bool Segmentation::operator==(const Segmentation& rhs) const
@@ -31,12 +32,24 @@ inline void swap(Segmentation& a, Segmentation& b)
 {
   using std::swap;
   swap(a.mDetElemId, b.mDetElemId);
+  swap(a.mBending, b.mBending);
+  swap(a.mNonBending, b.mNonBending);
   swap(a.mPadIndexOffset, b.mPadIndexOffset);
+  swap(a.mPadPositionX, b.mPadPositionX);
+  swap(a.mPadPositionY, b.mPadPositionY);
+  swap(a.mPadSizeX, b.mPadSizeX);
+  swap(a.mPadSizeY, b.mPadSizeY);
+  swap(a.mPadDualSampaId, b.mPadDualSampaId);
+  swap(a.mPadDualSampaChannel, b.mPadDualSampaChannel);
+  swap(a.mDualSampaFirstPad, b.mDualSampaFirstPad);
+  swap(a.mDualSampaPads, b.mDualSampaPads);
+  swap(a.mBendingGrid, b.mBendingGrid);
+  swap(a.mNonBendingGrid, b.mNonBendingGrid);
 }
 
 inline Segmentation::Segmentation(const Segmentation& seg) = default;
 
-inline Segmentation::Segmentation(const Segmentation&& seg) : mBending{std::move(seg.mBending)}, mNonBending{std::move(seg.mNonBending)}, mDetElemId{seg.mDetElemId}, mPadIndexOffset{seg.mPadIndexOffset}
+inline Segmentation::Segmentation(const Segmentation&& seg) : mBending{std::move(seg.mBending)}, mNonBending{std::move(seg.mNonBending)}, mDetElemId{seg.mDetElemId}, mPadIndexOffset{seg.mPadIndexOffset}, mPadPositionX{seg.mPadPositionX}, mPadPositionY{seg.mPadPositionY}, mPadSizeX{seg.mPadSizeX}, mPadSizeY{seg.mPadSizeY}, mPadDualSampaId{seg.mPadDualSampaId}, mPadDualSampaChannel{seg.mPadDualSampaChannel}, mDualSampaFirstPad{seg.mDualSampaFirstPad}, mDualSampaPads{seg.mDualSampaPads}, mBendingGrid{seg.mBendingGrid}, mNonBendingGrid{seg.mNonBendingGrid}
 {
 }
 
@@ -46,22 +59,180 @@ inline Segmentation& Segmentation::operator=(Segmentation seg)
   return *this;
 }
 
-inline int Segmentation::findPadByFEE(int dualSampaId, int dualSampaChannel) const
+inline void Segmentation::fillPadCache()
 {
-  bool isBending = dualSampaId < 1024;
-  int catPadIndex;
-  if (isBending) {
-    catPadIndex = mBending.findPadByFEE(dualSampaId, dualSampaChannel);
-    if (!mBending.isValid(catPadIndex)) {
-      return -1;
+  // flatten the pad information of both cathodes
+  int nPads = nofPads();
+  mPadPositionX.resize(nPads);
+  mPadPositionY.resize(nPads);
+  mPadSizeX.resize(nPads);
+  mPadSizeY.resize(nPads);
+  mPadDualSampaId.resize(nPads);
+  mPadDualSampaChannel.resize(nPads);
+  for (int dePadIndex = 0; dePadIndex < nPads; ++dePadIndex) {
+    const CathodeSegmentation* catSeg{nullptr};
+    int catPadIndex;
+    catSegPad(dePadIndex, catSeg, catPadIndex);
+    mPadPositionX[dePadIndex] = catSeg->padPositionX(catPadIndex);
+    mPadPositionY[dePadIndex] = catSeg->padPositionY(catPadIndex);
+    mPadSizeX[dePadIndex] = catSeg->padSizeX(catPadIndex);
+    mPadSizeY[dePadIndex] = catSeg->padSizeY(catPadIndex);
+    mPadDualSampaId[dePadIndex] = catSeg->padDualSampaId(catPadIndex);
+    mPadDualSampaChannel[dePadIndex] = catSeg->padDualSampaChannel(catPadIndex);
+  }
+
+  // invert the pad -> (dual sampa, channel) correspondence
+  int maxDualSampaId = -1;
+  for (auto dualSampaId : mPadDualSampaId) {
+    maxDualSampaId = std::max(maxDualSampaId, dualSampaId);
+  }
+  mDualSampaFirstPad.assign(maxDualSampaId + 1, -1);
+  for (int dePadIndex = 0; dePadIndex < nPads; ++dePadIndex) {
+    auto& firstPad = mDualSampaFirstPad[mPadDualSampaId[dePadIndex]];
+    if (firstPad < 0) {
+      firstPad = mDualSampaPads.size();
+      mDualSampaPads.resize(firstPad + 64, -1);
     }
-  } else {
-    catPadIndex = mNonBending.findPadByFEE(dualSampaId, dualSampaChannel);
-    if (!mNonBending.isValid(catPadIndex)) {
-      return -1;
+    mDualSampaPads[firstPad + mPadDualSampaChannel[dePadIndex]] = dePadIndex;
+  }
+
+  fillPadGrid(mBendingGrid, 0, mPadIndexOffset);
+  fillPadGrid(mNonBendingGrid, mPadIndexOffset, nPads);
+}
+
+inline void Segmentation::fillPadGrid(PadGrid& grid, int firstPad, int lastPad)
+{
+  if (firstPad >= lastPad) {
+    return;
+  }
+
+  // the pads are registered in all the cells overlapping their area enlarged by the search tolerance
+  const double margin = SPadTolerance + 1.e-6;
+  double xMin{std::numeric_limits<double>::max()};
+  double yMin{std::numeric_limits<double>::max()};
+  double xMax{std::numeric_limits<double>::lowest()};
+  double yMax{std::numeric_limits<double>::lowest()};
+  double cellSizeX{std::numeric_limits<double>::max()};
+  double cellSizeY{std::numeric_limits<double>::max()};
+  for (int dePadIndex = firstPad; dePadIndex < lastPad; ++dePadIndex) {
+    xMin = std::min(xMin, mPadPositionX[dePadIndex] - 0.5 * mPadSizeX[dePadIndex]);
+    xMax = std::max(xMax, mPadPositionX[dePadIndex] + 0.5 * mPadSizeX[dePadIndex]);
+    yMin = std::min(yMin, mPadPositionY[dePadIndex] - 0.5 * mPadSizeY[dePadIndex]);
+    yMax = std::max(yMax, mPadPositionY[dePadIndex] + 0.5 * mPadSizeY[dePadIndex]);
+    cellSizeX = std::min(cellSizeX, mPadSizeX[dePadIndex]);
+    cellSizeY = std::min(cellSizeY, mPadSizeY[dePadIndex]);
+  }
+  xMin -= margin;
+  yMin -= margin;
+  xMax += margin;
+  yMax += margin;
+
+  // cells of the size of the smallest pad (so that they overlap at most 2x2 pads),
+  // enlarged if needed to limit the memory footprint
+  double nCells = (xMax - xMin) / cellSizeX * (yMax - yMin) / cellSizeY;
+  if (nCells > SMaxNofCellsPerGrid) {
+    double scale = std::sqrt(nCells / SMaxNofCellsPerGrid);
+    cellSizeX *= scale;
+    cellSizeY *= scale;
+  }
+  grid.xMin = xMin;
+  grid.yMin = yMin;
+  grid.inverseCellSizeX = 1. / cellSizeX;
+  grid.inverseCellSizeY = 1. / cellSizeY;
+  grid.nCellsX = std::max(1, static_cast<int>(std::ceil((xMax - xMin) * grid.inverseCellSizeX)));
+  grid.nCellsY = std::max(1, static_cast<int>(std::ceil((yMax - yMin) * grid.inverseCellSizeY)));
+
+  auto cellIndex = [](double pos, double origin, double inverseCellSize, int nCells) {
+    return std::clamp(static_cast<int>(std::floor((pos - origin) * inverseCellSize)), 0, nCells - 1);
+  };
+  auto forEachCell = [&](int dePadIndex, auto&& func) {
+    int ix1 = cellIndex(mPadPositionX[dePadIndex] - 0.5 * mPadSizeX[dePadIndex] - margin, grid.xMin, grid.inverseCellSizeX, grid.nCellsX);
+    int ix2 = cellIndex(mPadPositionX[dePadIndex] + 0.5 * mPadSizeX[dePadIndex] + margin, grid.xMin, grid.inverseCellSizeX, grid.nCellsX);
+    int iy1 = cellIndex(mPadPositionY[dePadIndex] - 0.5 * mPadSizeY[dePadIndex] - margin, grid.yMin, grid.inverseCellSizeY, grid.nCellsY);
+    int iy2 = cellIndex(mPadPositionY[dePadIndex] + 0.5 * mPadSizeY[dePadIndex] + margin, grid.yMin, grid.inverseCellSizeY, grid.nCellsY);
+    for (int iy = iy1; iy <= iy2; ++iy) {
+      for (int ix = ix1; ix <= ix2; ++ix) {
+        func(iy * grid.nCellsX + ix);
+      }
+    }
+  };
+
+  // count the pads per cell, then fill the cells
+  grid.cellFirstPad.assign(grid.nCellsX * grid.nCellsY + 1, 0);
+  for (int dePadIndex = firstPad; dePadIndex < lastPad; ++dePadIndex) {
+    forEachCell(dePadIndex, [&grid](int cell) { ++grid.cellFirstPad[cell + 1]; });
+  }
+  for (int cell = 0; cell < grid.nCellsX * grid.nCellsY; ++cell) {
+    grid.cellFirstPad[cell + 1] += grid.cellFirstPad[cell];
+  }
+  grid.cellPads.resize(grid.cellFirstPad.back());
+  std::vector<int> cellNextPad(grid.cellFirstPad.begin(), grid.cellFirstPad.end() - 1);
+  for (int dePadIndex = firstPad; dePadIndex < lastPad; ++dePadIndex) {
+    forEachCell(dePadIndex, [&grid, &cellNextPad, dePadIndex](int cell) { grid.cellPads[cellNextPad[cell]++] = dePadIndex; });
+  }
+}
+
+inline int Segmentation::findPadByPositionInGrid(const PadGrid& grid, double x, double y) const
+{
+  /// same definition as CathodeSegmentation::findPadByPosition: among the pads intersecting
+  /// the box of half size SPadTolerance around (x,y), return the one whose center is the closest.
+  /// Return SAmbiguousPad if (x,y) is too close to a pad edge or equidistant from several pads
+
+  double fx = (x - grid.xMin) * grid.inverseCellSizeX;
+  double fy = (y - grid.yMin) * grid.inverseCellSizeY;
+  if (!(fx >= 0. && fx < grid.nCellsX && fy >= 0. && fy < grid.nCellsY)) {
+    return -1;
+  }
+  int cell = static_cast<int>(fy) * grid.nCellsX + static_cast<int>(fx);
+
+  int dePadIndex{-1};
+  double dmin{std::numeric_limits<double>::max()};
+  bool isTie{false};
+  for (int i = grid.cellFirstPad[cell]; i < grid.cellFirstPad[cell + 1]; ++i) {
+    int pad = grid.cellPads[i];
+    double px = mPadPositionX[pad] - x;
+    double py = mPadPositionY[pad] - y;
+    double overlap = std::min(SPadTolerance + 0.5 * mPadSizeX[pad] - std::abs(px), SPadTolerance + 0.5 * mPadSizeY[pad] - std::abs(py));
+    if (std::abs(overlap) < SEdgePrecision) {
+      return SAmbiguousPad;
+    }
+    if (overlap < 0.) {
+      continue;
+    }
+    double d = px * px + py * py;
+    if (d < dmin) {
+      dePadIndex = pad;
+      dmin = d;
+      isTie = false;
+    } else if (d == dmin) {
+      isTie = true;
     }
   }
-  return padC2DE(catPadIndex, isBending);
+
+  return isTie ? SAmbiguousPad : dePadIndex;
+}
+
+inline int Segmentation::findPadByPosition(bool isBending, double x, double y) const
+{
+  int dePadIndex = findPadByPositionInGrid(isBending ? mBendingGrid : mNonBendingGrid, x, y);
+  if (dePadIndex != SAmbiguousPad) {
+    return dePadIndex;
+  }
+  // let the cathode segmentation decide in the (rare) ambiguous cases
+  const auto& catSeg = isBending ? mBending : mNonBending;
+  int catPadIndex = catSeg.findPadByPosition(x, y);
+  return catSeg.isValid(catPadIndex) ? padC2DE(catPadIndex, isBending) : catPadIndex;
+}
+
+inline int Segmentation::findPadByFEE(int dualSampaId, int dualSampaChannel) const
+{
+  if (dualSampaChannel < 0 || dualSampaChannel > 63) {
+    throw std::out_of_range("dualSampaChannel should be between 0 and 63");
+  }
+  if (dualSampaId < 0 || dualSampaId >= static_cast<int>(mDualSampaFirstPad.size()) || mDualSampaFirstPad[dualSampaId] < 0) {
+    return -1;
+  }
+  return mDualSampaPads[mDualSampaFirstPad[dualSampaId] + dualSampaChannel];
 }
 
 inline bool Segmentation::isValid(int dePadIndex) const
@@ -94,21 +265,9 @@ inline void Segmentation::catSegPad(int dePadIndex, const CathodeSegmentation*&
 
 inline bool Segmentation::findPadPairByPosition(double x, double y, int& b, int& nb) const
 {
-  b = mBending.findPadByPosition(x, y);
-  nb = mNonBending.findPadByPosition(x, y);
-  if (!mBending.isValid(b)) {
-    if (mNonBending.isValid(nb)) {
-      nb = padC2DE(nb, false);
-    }
-    return false;
-  }
-  if (!mNonBending.isValid(nb)) {
-    b = padC2DE(b, true);
-    return false;
-  }
-  b = padC2DE(b, true);
-  nb = padC2DE(nb, false);
-  return true;
+  b = findPadByPosition(true, x, y);
+  nb = findPadByPosition(false, x, y);
+  return isValid(b) && isValid(nb);
 }
 
 template <typename CALLABLE>
@@ -172,50 +331,32 @@ inline std::string Segmentation::padAsString(int dePadIndex) const
 
 inline int Segmentation::padDualSampaId(int dePadIndex) const
 {
-  const CathodeSegmentation* catSeg{nullptr};
-  int catPadIndex;
-  catSegPad(dePadIndex, catSeg, catPadIndex);
-  return catSeg->padDualSampaId(catPadIndex);
+  return mPadDualSampaId[dePadIndex];
 }
 
 inline int Segmentation::padDualSampaChannel(int dePadIndex) const
 {
-  const CathodeSegmentation* catSeg{nullptr};
-  int catPadIndex;
-  catSegPad(dePadIndex, catSeg, catPadIndex);
-  return catSeg->padDualSampaChannel(catPadIndex);
+  return mPadDualSampaChannel[dePadIndex];
 }
 
 inline double Segmentation::padPositionX(int dePadIndex) const
 {
-  const CathodeSegmentation* catSeg{nullptr};
-  int catPadIndex;
-  catSegPad(dePadIndex, catSeg, catPadIndex);
-  return catSeg->padPositionX(catPadIndex);
+  return mPadPositionX[dePadIndex];
 }
 
 inline double Segmentation::padPositionY(int dePadIndex) const
 {
-  const CathodeSegmentation* catSeg{nullptr};
-  int catPadIndex;
-  catSegPad(dePadIndex, catSeg, catPadIndex);
-  return catSeg->padPositionY(catPadIndex);
+  return mPadPositionY[dePadIndex];
 }
 
 inline double Segmentation::padSizeX(int dePadIndex) const
 {
-  const CathodeSegmentation* catSeg{nullptr};
-  int catPadIndex;
-  catSegPad(dePadIndex, catSeg, catPadIndex);
-  return catSeg->padSizeX(catPadIndex);
+  return mPadSizeX[dePadIndex];
 }
 
 inline double Segmentation::padSizeY(int dePadIndex) const
 {
-  const CathodeSegmentation* catSeg{nullptr};
-  int catPadIndex;
-  catSegPad(dePadIndex, catSeg, catPadIndex);
-  return catSeg->padSizeY(catPadIndex);
+  return mPadSizeY[dePadIndex];
 }
 
 inline int Segmentation::detElemId() const { return mDetElemId; }
@@ -188,6 +188,47 @@ BOOST_AUTO_TEST_CASE(CheckPadOffsetsAfterCopy)
   });
 }
 
+BOOST_AUTO_TEST_CASE(FlatPadInformationMustMatchCathodeSegmentations)
+{
+  forOneDetectionElementOfEachSegmentationType([](int detElemId) {
+    Segmentation seg{detElemId};
+    BOOST_TEST_INFO_SCOPE(fmt::format("DeId {}", detElemId));
+    int nbad{0};
+    for (auto dePadIndex = 0; dePadIndex < seg.nofPads(); ++dePadIndex) {
+      bool isBending = seg.isBendingPad(dePadIndex);
+      const auto& catSeg = isBending ? seg.bending() : seg.nonBending();
+      int catPadIndex = isBending ? dePadIndex : dePadIndex - seg.bending().nofPads();
+      if (seg.padPositionX(dePadIndex) != catSeg.padPositionX(catPadIndex) ||
+          seg.padPositionY(dePadIndex) != catSeg.padPositionY(catPadIndex) ||
+          seg.padSizeX(dePadIndex) != catSeg.padSizeX(catPadIndex) ||
+          seg.padSizeY(dePadIndex) != catSeg.padSizeY(catPadIndex) ||
+          seg.padDualSampaId(dePadIndex) != catSeg.padDualSampaId(catPadIndex) ||
+          seg.padDualSampaChannel(dePadIndex) != catSeg.padDualSampaChannel(catPadIndex) ||
+          seg.findPadByFEE(seg.padDualSampaId(dePadIndex), seg.padDualSampaChannel(dePadIndex)) != dePadIndex) {
+        ++nbad;
+      }
+      // look for the pads at the center and corners of this pad, where several pads may compete
+      double x = seg.padPositionX(dePadIndex);
+      double y = seg.padPositionY(dePadIndex);
+      double dx = seg.padSizeX(dePadIndex) / 2.0;
+      double dy = seg.padSizeY(dePadIndex) / 2.0;
+      for (auto [px, py] : {std::make_pair(x, y), std::make_pair(x - dx, y - dy), std::make_pair(x + dx, y + dy)}) {
+        int b, nb;
+        seg.findPadPairByPosition(px, py, b, nb);
+        int catb = seg.bending().findPadByPosition(px, py);
+        int catnb = seg.nonBending().findPadByPosition(px, py);
+        if (seg.nonBending().isValid(catnb)) {
+          catnb += seg.bending().nofPads();
+        }
+        if (b != catb || nb != catnb) {
+          ++nbad;
+        }
+      }
+    }
+    BOOST_CHECK_EQUAL(nbad, 0);
+  });
+}
+
 struct SEG100 {
   Segmentation seg{100};
 };
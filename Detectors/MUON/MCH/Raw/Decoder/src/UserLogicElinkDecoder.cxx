@@ -19,7 +19,7 @@ void UserLogicElinkDecoder<SampleMode>::prepareAndSendCluster()
 {
   if (mDecodedDataHandlers.sampaChannelHandler) {
     SampaCluster sc(mClusterTime, mSampaHeader.bunchCrossingCounter(), mSamples);
-    sendCluster(sc);
+    sendCluster(std::move(sc));
   }
   mSamples.clear();
 }
@@ -33,7 +33,7 @@ void UserLogicElinkDecoder<ChargeSumMode>::prepareAndSendCluster()
   if (mDecodedDataHandlers.sampaChannelHandler) {
     uint32_t q = (((static_cast<uint32_t>(mSamples[1]) & 0x3FF) << 10) | (static_cast<uint32_t>(mSamples[0]) & 0x3FF));
     SampaCluster sc(mClusterTime, mSampaHeader.bunchCrossingCounter(), q, mClusterSize);
-    sendCluster(sc);
+    sendCluster(std::move(sc));
   }
   mSamples.clear();
 }
@@ -64,7 +64,7 @@ class UserLogicElinkDecoder
 
   void clear();
   bool hasError() const;
-  bool isHeaderComplete() const { return mHeaderParts.size() == 5; }
+  bool isHeaderComplete() const { return mNofHeaderParts == 5; }
   bool moreSampleToRead() const { return mSamplesToRead > 0; }
   bool moreWordsToRead() const { return mNof10BitWords > 0; }
   std::ostream& debugHeader() const;
@@ -73,7 +73,7 @@ class UserLogicElinkDecoder
   void completeHeader();
   void oneLess10BitWord();
   void prepareAndSendCluster();
-  void sendCluster(const SampaCluster& sc) const;
+  void sendCluster(SampaCluster&& sc) const;
   void sendHBPacket();
   void sendError(int8_t chip, uint32_t error) const;
   void setClusterSize(uint10_t value);
@@ -87,7 +87,8 @@ class UserLogicElinkDecoder
   DecodedDataHandlers mDecodedDataHandlers;
   State mState;
   std::vector<uint10_t> mSamples{};
-  std::vector<uint10_t> mHeaderParts{};
+  uint64_t mHeaderParts{0}; // 10-bit parts of the header read so far, the 1st one in the lowest bits
+  uint8_t mNofHeaderParts{0};
   SampaHeader mSampaHeader{};
   uint10_t mNof10BitWords{};
   uint10_t mClusterSize{};
@@ -107,6 +108,7 @@ UserLogicElinkDecoder<CHARGESUM>::UserLogicElinkDecoder(DsElecId dsId,
                                                         DecodedDataHandlers decodedDataHandlers)
   : mDsId{dsId}, mDecodedDataHandlers{decodedDataHandlers}, mState{State::WaitingSync}
 {
+  mSamples.reserve(CHARGESUM()() ? 2 : 128); // the capacity is kept by clear()
 }
 
 template <typename CHARGESUM>
@@ -125,12 +127,21 @@ void UserLogicElinkDecoder<CHARGESUM>::append(uint64_t data50, uint8_t error, bo
     return;
   }
 
-  auto data = data50;
+  // the 5 10-bit words are extracted at once, the samples which do not end a cluster are stored without
+  // going through the state machine, as they cannot change its state nor raise an error
+  const uint10_t data10[5] = {static_cast<uint10_t>(data50 & 0x3FF), static_cast<uint10_t>((data50 >> 10) & 0x3FF),
+                              static_cast<uint10_t>((data50 >> 20) & 0x3FF), static_cast<uint10_t>((data50 >> 30) & 0x3FF),
+                              static_cast<uint10_t>((data50 >> 40) & 0x3FF)};
 
   int i;
   for (i = 0; i < 5; i++) {
-    bool packetEnd = append10(static_cast<uint10_t>(data & 0x3FF));
-    data >>= 10;
+    if (mState == State::WaitingSample && mSamplesToRead > 1) {
+      --mSamplesToRead;
+      oneLess10BitWord();
+      mSamples.emplace_back(data10[i]);
+      continue;
+    }
+    bool packetEnd = append10(data10[i]);
 #ifdef ULDEBUG
     if (incomplete) {
       debugHeader() << (*this) << fmt::format(" --> incomplete {} packetEnd @i={}\n", incomplete, packetEnd, i);
@@ -272,7 +283,8 @@ template <typename CHARGESUM>
 void UserLogicElinkDecoder<CHARGESUM>::clear()
 {
   mSamples.clear();
-  mHeaderParts.clear();
+  mHeaderParts = 0;
+  mNofHeaderParts = 0;
   mNof10BitWords = 0;
   mClusterSize = 0;
   mErrorMessage = std::nullopt;
@@ -281,10 +293,7 @@ void UserLogicElinkDecoder<CHARGESUM>::clear()
 template <typename CHARGESUM>
 void UserLogicElinkDecoder<CHARGESUM>::completeHeader()
 {
-  uint64_t header{0};
-  for (auto i = 0; i < mHeaderParts.size(); i++) {
-    header += (static_cast<uint64_t>(mHeaderParts[i]) << (10 * i));
-  }
+  uint64_t header = mHeaderParts;
 
   mSampaHeader = SampaHeader(header);
   mNof10BitWords = mSampaHeader.nof10BitWords();
@@ -300,7 +309,8 @@ void UserLogicElinkDecoder<CHARGESUM>::completeHeader()
   debugHeader() << "\n";
 #endif
 
-  mHeaderParts.clear();
+  mHeaderParts = 0;
+  mNofHeaderParts = 0;
 }
 
 template <typename CHARGESUM>
@@ -332,7 +342,7 @@ void UserLogicElinkDecoder<CHARGESUM>::reset()
 }
 
 template <typename CHARGESUM>
-void UserLogicElinkDecoder<CHARGESUM>::sendCluster(const SampaCluster& sc) const
+void UserLogicElinkDecoder<CHARGESUM>::sendCluster(SampaCluster&& sc) const
 {
 #ifdef ULDEBUG
   debugHeader() << (*this) << " --> "
@@ -341,7 +351,7 @@ void UserLogicElinkDecoder<CHARGESUM>::sendCluster(const SampaCluster& sc) const
                                getDualSampaChannelId(mSampaHeader),
                                o2::mch::raw::asString(sc));
 #endif
-  mDecodedDataHandlers.sampaChannelHandler(mDsId, getDualSampaChannelId(mSampaHeader), sc);
+  mDecodedDataHandlers.sampaChannelHandler(mDsId, getDualSampaChannelId(mSampaHeader), std::move(sc)); // the samples are not copied again
 }
 
 template <typename CHARGESUM>
@@ -403,7 +413,7 @@ template <typename CHARGESUM>
 void UserLogicElinkDecoder<CHARGESUM>::setHeaderPart(uint10_t a)
 {
   oneLess10BitWord();
-  mHeaderParts.emplace_back(a);
+  mHeaderParts |= static_cast<uint64_t>(a) << (10 * mNofHeaderParts++);
 #ifdef ULDEBUG
   debugHeader() << (*this) << fmt::format(" --> readHeader {:08X}\n", a);
 #endif
@@ -446,9 +456,9 @@ template <typename T>
 std::ostream& operator<<(std::ostream& os, const o2::mch::raw::UserLogicElinkDecoder<T>& e)
 {
   os << fmt::format("{} n10={:4d} size={:4d} t={:4d} ", asString(e.mDsId), e.mNof10BitWords, e.mClusterSize, e.mClusterTime);
-  os << fmt::format("h({:2d})= ", e.mHeaderParts.size());
-  for (auto h : e.mHeaderParts) {
-    os << fmt::format("{:4d} ", h);
+  os << fmt::format("h({:2d})= ", e.mNofHeaderParts);
+  for (int i = 0; i < e.mNofHeaderParts; i++) {
+    os << fmt::format("{:4d} ", (e.mHeaderParts >> (10 * i)) & 0x3FF);
   }
   os << fmt::format("s({:2d})= ", e.mSamples.size());
   for (auto s : e.mSamples) {
@@ -72,7 +72,8 @@ class UserLogicEndpointDecoder : public PayloadDecoder<UserLogicEndpointDecoder<
   uint16_t mFeeId;
   std::function<std::optional<uint16_t>(FeeLinkId id)> mFee2SolarMapper;
   DecodedDataHandlers mDecodedDataHandlers;
-  std::map<uint16_t, std::array<ElinkDecoder, 40>> mElinkDecoders;
+  std::vector<std::array<ElinkDecoder, 40>> mElinkDecoders; // decoders of the GBT links seen so far
+  std::array<int8_t, 32> mElinkDecodersIndex;               // index in mElinkDecoders of the decoders of each GBT link, -1 if none
   int mNofGbtWordsSeens;
 };
 
@@ -89,6 +90,7 @@ UserLogicEndpointDecoder<CHARGESUM, VERSION>::UserLogicEndpointDecoder(uint16_t
     mDecodedDataHandlers(decodedDataHandlers),
     mNofGbtWordsSeens{0}
 {
+  mElinkDecodersIndex.fill(-1);
 }
 
 template <typename CHARGESUM, int VERSION>
@@ -140,8 +142,8 @@ size_t UserLogicEndpointDecoder<CHARGESUM, VERSION>::append(Payload buffer)
     }
 
     // Get the corresponding decoders array, or allocate it if does not exist yet
-    auto d = mElinkDecoders.find(gbt);
-    if (d == mElinkDecoders.end()) {
+    // (a direct lookup, as the linkID field has at most 5 bits)
+    if (mElinkDecodersIndex[gbt] < 0) {
 
       // Compute the (feeId, linkId) pair...
       FeeLinkId feeLinkId(mFeeId, gbt);
@@ -158,13 +160,13 @@ size_t UserLogicEndpointDecoder<CHARGESUM, VERSION>::append(Payload buffer)
         }
       }
 
-      mElinkDecoders.emplace(static_cast<uint16_t>(gbt),
-                             impl::makeArray<40>([=](size_t i) {
-                               DsElecId dselec{solarId.value(), static_cast<uint8_t>(i / 5), static_cast<uint8_t>(i % 5)};
-                               return ElinkDecoder(dselec, mDecodedDataHandlers);
-                             }));
-      d = mElinkDecoders.find(gbt);
+      mElinkDecodersIndex[gbt] = static_cast<int8_t>(mElinkDecoders.size());
+      mElinkDecoders.emplace_back(impl::makeArray<40>([=](size_t i) {
+        DsElecId dselec{solarId.value(), static_cast<uint8_t>(i / 5), static_cast<uint8_t>(i % 5)};
+        return ElinkDecoder(dselec, mDecodedDataHandlers);
+      }));
     }
+    auto& elinkDecoders = mElinkDecoders[mElinkDecodersIndex[gbt]];
 
     uint16_t dsid = ulword.dsID;
     if (dsid > 39) {
@@ -181,7 +183,7 @@ size_t UserLogicEndpointDecoder<CHARGESUM, VERSION>::append(Payload buffer)
     bool incomplete = ulword.incomplete > 0;
     uint64_t data50 = ulword.data;
 
-    d->second.at(dsid).append(data50, error, incomplete);
+    elinkDecoders.at(dsid).append(data50, error, incomplete);
     n += 8;
   }
   return n;
@@ -191,7 +193,7 @@ template <typename CHARGESUM, int VERSION>
 void UserLogicEndpointDecoder<CHARGESUM, VERSION>::reset()
 {
   for (auto& arrays : mElinkDecoders) {
-    for (auto& d : arrays.second) {
+    for (auto& d : arrays) {
       d.reset();
     }
   }
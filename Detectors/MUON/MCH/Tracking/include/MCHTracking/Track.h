@@ -19,6 +19,7 @@
 
 #include <list>
 #include <memory>
+#include <memory_resource>
 
 #include "MCHTracking/Cluster.h"
 #include "MCHTracking/TrackParam.h"
@@ -32,10 +33,15 @@ namespace mch
 class Track
 {
  public:
+  /// allocator used to store the track parameters at clusters, propagated by the std::pmr containers of tracks
+  using allocator_type = std::pmr::polymorphic_allocator<TrackParam>;
+
   Track() = default;
+  explicit Track(const allocator_type& alloc) : mParamAtClusters(alloc) {}
   ~Track() = default;
 
   Track(const Track& track);
+  Track(const Track& track, const allocator_type& alloc);
   Track& operator=(const Track& track) = delete;
   Track(Track&&) = delete;
   Track& operator=(Track&&) = delete;
@@ -67,7 +73,7 @@ class Track
   TrackParam& createParamAtCluster(const Cluster& cluster);
   void addParamAtCluster(const TrackParam& param);
   /// Remove the given track parameters from the internal list and return an iterator to the parameters that follow
-  auto removeParamAtCluster(std::list<TrackParam>::iterator& itParam) { return mParamAtClusters.erase(itParam); }
+  auto removeParamAtCluster(std::pmr::list<TrackParam>::iterator& itParam) { return mParamAtClusters.erase(itParam); }
 
   int getNClustersInCommon(const Track& track, int stMin = 0, int stMax = 4) const;
 
@@ -99,11 +105,11 @@ class Track
   void print() const;
 
  private:
-  std::list<TrackParam> mParamAtClusters{};    ///< list of track parameters at each cluster
-  std::unique_ptr<TrackParam> mCurrentParam{}; ///< current track parameters used during tracking
-  int mCurrentChamber = -1;                    ///< current chamber on which the current parameters are given
-  bool mConnected = false;                     ///< flag telling if this track shares cluster(s) with another
-  bool mRemovable = false;                     ///< flag telling if this track should be deleted
+  std::pmr::list<TrackParam> mParamAtClusters{}; ///< list of track parameters at each cluster
+  std::unique_ptr<TrackParam> mCurrentParam{};   ///< current track parameters used during tracking
+  int mCurrentChamber = -1;                      ///< current chamber on which the current parameters are given
+  bool mConnected = false;                       ///< flag telling if this track shares cluster(s) with another
+  bool mRemovable = false;                       ///< flag telling if this track should be deleted
 };
 
 } // namespace mch
@@ -21,6 +21,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <list>
+#include <memory_resource>
 #include <array>
 #include <vector>
 #include <utility>
@@ -48,11 +49,12 @@ class TrackFinder
 
   void init(float l3Current, float dipoleCurrent);
 
-  const std::list<Track>& findTracks(const std::unordered_map<int, std::list<Cluster>>& clusters);
+  const std::pmr::list<Track>& findTracks(const std::unordered_map<int, std::list<Cluster>>& clusters);
 
   /// set the debug level defining the verbosity
   void debug(int debugLevel) { mDebugLevel = debugLevel; }
 
+  void mergeStats(const TrackFinder& other);
   void printStats() const;
   void printTimers() const;
 
@@ -61,18 +63,18 @@ class TrackFinder
   void findTrackCandidatesInSt5();
   void findTrackCandidatesInSt4();
   void findMoreTrackCandidates();
-  std::list<Track>::iterator findTrackCandidates(int plane1, int plane2, bool skipUsedPairs, const std::list<Track>::iterator& itFirstTrack);
-
-  std::list<Track>::iterator followTrackInOverlapDE(const std::list<Track>::iterator& itTrack, int currentDE, int plane);
-  std::list<Track>::iterator followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                  int chamber, int lastChamber, bool canSkip,
-                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
-  std::list<Track>::iterator followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                  int plane1, int plane2, int lastChamber,
-                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
-  std::list<Track>::iterator addClustersAndFollowTrack(std::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
-                                                       const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
+  std::pmr::list<Track>::iterator findTrackCandidates(int plane1, int plane2, bool skipUsedPairs, const std::pmr::list<Track>::iterator& itFirstTrack);
+
+  std::pmr::list<Track>::iterator followTrackInOverlapDE(const std::pmr::list<Track>::iterator& itTrack, int currentDE, int plane);
+  std::pmr::list<Track>::iterator followTrackInChamber(std::pmr::list<Track>::iterator& itTrack,
+                                                       int chamber, int lastChamber, bool canSkip,
+                                                       std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+  std::pmr::list<Track>::iterator followTrackInChamber(std::pmr::list<Track>::iterator& itTrack,
+                                                       int plane1, int plane2, int lastChamber,
                                                        std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+  std::pmr::list<Track>::iterator addClustersAndFollowTrack(std::pmr::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
+                                                            const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
+                                                            std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
 
   void improveTracks();
 
@@ -86,15 +88,15 @@ class TrackFinder
 
   bool isAcceptable(const TrackParam& param) const;
 
-  void prepareForwardTracking(std::list<Track>::iterator& itTrack, bool runSmoother);
-  void prepareBackwardTracking(std::list<Track>::iterator& itTrack, bool refit);
+  void prepareForwardTracking(std::pmr::list<Track>::iterator& itTrack, bool runSmoother);
+  void prepareBackwardTracking(std::pmr::list<Track>::iterator& itTrack, bool refit);
   void setCurrentParam(Track& track, const TrackParam& param, int chamber, bool smoothed = false);
   bool propagateCurrentParam(Track& track, int chamber);
 
-  bool areUsed(const Cluster& cl1, const Cluster& cl2, const std::list<Track>::iterator& itFirstTrack, const std::list<Track>::iterator& itLastTrack);
-  void excludeClustersFromIdenticalTracks(const std::list<Track>::iterator& itTrack,
+  bool areUsed(const Cluster& cl1, const Cluster& cl2, const std::pmr::list<Track>::iterator& itFirstTrack, const std::pmr::list<Track>::iterator& itLastTrack);
+  void excludeClustersFromIdenticalTracks(const std::pmr::list<Track>::iterator& itTrack,
                                           std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters,
-                                          const std::list<Track>::iterator& itEndTrack);
+                                          const std::pmr::list<Track>::iterator& itEndTrack);
   void moveClusters(std::unordered_map<int, std::unordered_set<uint32_t>>& source, std::unordered_map<int, std::unordered_set<uint32_t>>& destination);
 
   bool isCompatible(const TrackParam& param, const Cluster& cluster, TrackParam& paramAtCluster);
@@ -103,7 +105,7 @@ class TrackFinder
 
   uint8_t requestedStationMask() const;
 
-  int getTrackIndex(const std::list<Track>::iterator& itCurrentTrack) const;
+  int getTrackIndex(const std::pmr::list<Track>::iterator& itCurrentTrack) const;
   void printTracks() const;
   void printTrack(const Track& track) const;
   void printTrackParam(const TrackParam& trackParam) const;
@@ -130,7 +132,9 @@ class TrackFinder
 
   std::array<std::vector<std::pair<const int, const std::list<Cluster>*>>, 32> mClusters{}; ///< array of pointers to the lists of clusters per DE
 
-  std::list<Track> mTracks{}; ///< list of reconstructed tracks
+  /// arena holding the track candidates and their parameters at clusters, reused from one event to the next
+  std::pmr::unsynchronized_pool_resource mTrackArena{};
+  std::pmr::list<Track> mTracks{&mTrackArena}; ///< list of reconstructed tracks
 
   double mChamberResolutionX2 = 0.;      ///< chamber resolution square (cm^2) in x direction
   double mChamberResolutionY2 = 0.;      ///< chamber resolution square (cm^2) in y direction
@@ -56,7 +56,7 @@ class TrackFitter
   void setChamberResolution(double ex, double ey);
 
   void fit(Track& track, bool smooth = true, bool finalize = true,
-           std::list<TrackParam>::reverse_iterator* itStartingParam = nullptr);
+           std::pmr::list<TrackParam>::reverse_iterator* itStartingParam = nullptr);
 
   void runKalmanFilter(TrackParam& trackParam);
 
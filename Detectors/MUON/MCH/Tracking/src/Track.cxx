@@ -38,6 +38,17 @@ Track::Track(const Track& track)
   /// Copy the track, except the current parameters and chamber, which are reset
 }
 
+//__________________________________________________________________________
+Track::Track(const Track& track, const allocator_type& alloc)
+  : mParamAtClusters(track.mParamAtClusters, alloc),
+    mCurrentParam(nullptr),
+    mCurrentChamber(-1),
+    mConnected(track.mConnected),
+    mRemovable(track.mRemovable)
+{
+  /// Copy the track using the given allocator, except the current parameters and chamber, which are reset
+}
+
 //__________________________________________________________________________
 TrackParam& Track::createParamAtCluster(const Cluster& cluster)
 {
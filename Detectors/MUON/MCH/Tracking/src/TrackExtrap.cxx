@@ -35,8 +35,8 @@ namespace mch
 bool TrackExtrap::sExtrapV2 = false;
 double TrackExtrap::sSimpleBValue = 0.;
 bool TrackExtrap::sFieldON = false;
-std::size_t TrackExtrap::sNCallExtrapToZCov = 0;
-std::size_t TrackExtrap::sNCallField = 0;
+std::atomic<std::size_t> TrackExtrap::sNCallExtrapToZCov{0};
+std::atomic<std::size_t> TrackExtrap::sNCallField{0};
 
 //__________________________________________________________________________
 void TrackExtrap::setField()
@@ -1233,8 +1233,8 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
 void TrackExtrap::printNCalls()
 {
   /// Print the number of times some methods are called
-  LOG(INFO) << "number of times extrapToZCov() is called = " << sNCallExtrapToZCov;
-  LOG(INFO) << "number of times Field() is called = " << sNCallField;
+  LOG(INFO) << "number of times extrapToZCov() is called = " << sNCallExtrapToZCov.load();
+  LOG(INFO) << "number of times Field() is called = " << sNCallField.load();
 }
 
 } // namespace mch
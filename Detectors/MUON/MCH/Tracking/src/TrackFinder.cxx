@@ -140,7 +140,7 @@ void TrackFinder::init(float l3Current, float dipoleCurrent)
 }
 
 //_________________________________________________________________________________________________
-const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, std::list<Cluster>>& clusters)
+const std::pmr::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, std::list<Cluster>>& clusters)
 {
   /// Run the track finder algorithm
 
@@ -600,7 +600,7 @@ void TrackFinder::findMoreTrackCandidates()
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::findTrackCandidates(int plane1, int plane2, bool skipUsedPairs, const std::list<Track>::iterator& itFirstTrack)
+std::pmr::list<Track>::iterator TrackFinder::findTrackCandidates(int plane1, int plane2, bool skipUsedPairs, const std::pmr::list<Track>::iterator& itFirstTrack)
 {
   /// Find all combinations of clusters between the 2 planes that could belong to a valid track
   /// If skipUsedPairs == true: skip combinations of clusters already part of a track starting from itFirstTrack
@@ -685,7 +685,7 @@ std::list<Track>::iterator TrackFinder::findTrackCandidates(int plane1, int plan
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<Track>::iterator& itTrack, int currentDE, int plane)
+std::pmr::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::pmr::list<Track>::iterator& itTrack, int currentDE, int plane)
 {
   /// Follow the track candidate "itTrack" in the DE of the "plane" overlapping "currentDE" and look for compatible clusters
   /// The tracking starts from the current parameters, which are supposed to be at a cluster on the same chamber
@@ -743,9 +743,9 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                             int chamber, int lastChamber, bool canSkip,
-                                                             std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+std::pmr::list<Track>::iterator TrackFinder::followTrackInChamber(std::pmr::list<Track>::iterator& itTrack,
+                                                                  int chamber, int lastChamber, bool canSkip,
+                                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
 {
   /// Follow the track candidate pointed to by "itTrack" to the given "chamber"
   /// The tracking starts from the current parameters, which must have already been set
@@ -835,9 +835,9 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                             int plane1, int plane2, int lastChamber,
-                                                             std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+std::pmr::list<Track>::iterator TrackFinder::followTrackInChamber(std::pmr::list<Track>::iterator& itTrack,
+                                                                  int plane1, int plane2, int lastChamber,
+                                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
 {
   /// Follow the track candidate pointed to by "itTrack" to the (half)chamber formed by "plane1" and "plane2"
   /// The tracking starts from the current parameters, which must have already been set
@@ -1034,9 +1034,9 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::addClustersAndFollowTrack(std::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
-                                                                  const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
-                                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+std::pmr::list<Track>::iterator TrackFinder::addClustersAndFollowTrack(std::pmr::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
+                                                                       const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
+                                                                       std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
 {
   /// If "nextChamber" >= 0: continue the tracking of "itTrack" up to "lastChamber", attach the two clusters
   /// to every new tracks found and return an iterator to the first of them (or mTracks.end() if none is found)
@@ -1350,7 +1350,7 @@ bool TrackFinder::isAcceptable(const TrackParam& param) const
 }
 
 //_________________________________________________________________________________________________
-void TrackFinder::prepareForwardTracking(std::list<Track>::iterator& itTrack, bool runSmoother)
+void TrackFinder::prepareForwardTracking(std::pmr::list<Track>::iterator& itTrack, bool runSmoother)
 {
   /// Prepare the current track parameters in view of continuing the tracking in the forward chambers
   /// Run the smoother to recompute the parameters at last cluster if requested
@@ -1365,7 +1365,7 @@ void TrackFinder::prepareForwardTracking(std::list<Track>::iterator& itTrack, bo
 }
 
 //_________________________________________________________________________________________________
-void TrackFinder::prepareBackwardTracking(std::list<Track>::iterator& itTrack, bool refit)
+void TrackFinder::prepareBackwardTracking(std::pmr::list<Track>::iterator& itTrack, bool refit)
 {
   /// Prepare the current track parameters in view of continuing the tracking in the backward chambers
   /// Refit the track to recompute the parameters at first cluster if requested
@@ -1424,7 +1424,7 @@ bool TrackFinder::propagateCurrentParam(Track& track, int chamber)
 }
 
 //_________________________________________________________________________________________________
-bool TrackFinder::areUsed(const Cluster& cl1, const Cluster& cl2, const std::list<Track>::iterator& itFirstTrack, const std::list<Track>::iterator& itLastTrack)
+bool TrackFinder::areUsed(const Cluster& cl1, const Cluster& cl2, const std::pmr::list<Track>::iterator& itFirstTrack, const std::pmr::list<Track>::iterator& itLastTrack)
 {
   /// Return true if the 2 clusters are already part of a track between itFirstTrack and mTracks.end()
 
@@ -1454,9 +1454,9 @@ bool TrackFinder::areUsed(const Cluster& cl1, const Cluster& cl2, const std::lis
 }
 
 //_________________________________________________________________________________________________
-void TrackFinder::excludeClustersFromIdenticalTracks(const std::list<Track>::iterator& itTrack,
+void TrackFinder::excludeClustersFromIdenticalTracks(const std::pmr::list<Track>::iterator& itTrack,
                                                      std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters,
-                                                     const std::list<Track>::iterator& itEndTrack)
+                                                     const std::pmr::list<Track>::iterator& itEndTrack)
 {
   /// Find tracks in the range [mTracks.begin(), itEndTrack[ that contain all the clusters of itTrack
   /// and add the clusters that these tracks have on station 5 in the excludedClusters list
@@ -1590,7 +1590,7 @@ uint8_t TrackFinder::requestedStationMask() const
 }
 
 //_________________________________________________________________________________________________
-int TrackFinder::getTrackIndex(const std::list<Track>::iterator& itCurrentTrack) const
+int TrackFinder::getTrackIndex(const std::pmr::list<Track>::iterator& itCurrentTrack) const
 {
   /// return the index of the track pointed to by the given iterator in the list of tracks
   /// return -1 if it points to mTracks.end()
@@ -1655,6 +1655,21 @@ void TrackFinder::print(Args... args) const
   }
 }
 
+//_________________________________________________________________________________________________
+void TrackFinder::mergeStats(const TrackFinder& other)
+{
+  /// add the counters and timers of another track finder (e.g. running in another thread)
+  mNCandidates += other.mNCandidates;
+  mNCallTryOneCluster += other.mNCallTryOneCluster;
+  mNCallTryOneClusterFast += other.mNCallTryOneClusterFast;
+  mTimeFindCandidates += other.mTimeFindCandidates;
+  mTimeFindMoreCandidates += other.mTimeFindMoreCandidates;
+  mTimeFollowTracks += other.mTimeFollowTracks;
+  mTimeImproveTracks += other.mTimeImproveTracks;
+  mTimeCleanTracks += other.mTimeCleanTracks;
+  mTimeRefineTracks += other.mTimeRefineTracks;
+}
+
 //_________________________________________________________________________________________________
 void TrackFinder::printStats() const
 {
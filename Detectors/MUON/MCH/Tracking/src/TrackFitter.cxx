@@ -54,7 +54,7 @@ void TrackFitter::initField(float l3Current, float dipoleCurrent)
 
 //_________________________________________________________________________________________________
 void TrackFitter::fit(Track& track, bool smooth, bool finalize,
-                      std::list<TrackParam>::reverse_iterator* itStartingParam)
+                      std::pmr::list<TrackParam>::reverse_iterator* itStartingParam)
 {
   /// Fit a track to its attached clusters
   /// Smooth the track if requested and the smoother enabled
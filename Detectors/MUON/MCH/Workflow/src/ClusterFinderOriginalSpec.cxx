@@ -18,13 +18,20 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <exception>
+#include <memory>
 #include <vector>
 #include <stdexcept>
 #include <string>
 
 #include <gsl/span>
 
+#include <TH1.h>
+#include <TROOT.h>
+
 #include "Framework/CallbackService.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/ControlService.h"
@@ -41,6 +48,10 @@
 #include "MCHBase/ClusterBlock.h"
 #include "MCHClustering/ClusterFinderOriginal.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace mch
@@ -63,12 +74,51 @@ class ClusterFinderOriginalTask
       o2::conf::ConfigurableParam::updateFromFile(config, "MCHClustering", true);
     }
     bool run2Config = ic.options().get<bool>("run2-config");
-    mClusterFinder.init(run2Config);
+
+    // one cluster finder per thread, each of them processing a precluster at a time
+    // with --threads, the fits use random generators reseeded per precluster, whatever the number of threads,
+    // so that the results do not depend on it (they differ from the original processing, which uses gRandom)
+    auto threads = ic.options().get<int>("threads");
+    bool ownRandom = threads > 0;
+    auto nThreads = std::max(1, threads);
+#ifndef WITH_OPENMP
+    if (nThreads > 1) {
+      LOG(WARNING) << "cluster finder compiled without OpenMP support, using 1 thread";
+      nThreads = 1;
+    }
+#endif
+    if (nThreads > 1) {
+      // the clustering uses temporary histograms, which must not be attached to a shared directory
+      ROOT::EnableThreadSafety();
+      TH1::AddDirectory(false);
+    }
+    for (int i = 0; i < nThreads; ++i) {
+      auto& clusterFinder = mClusterFinders.emplace_back(std::make_unique<ClusterFinderOriginal>());
+      clusterFinder->init(run2Config);
+      clusterFinder->useOwnRandomGenerator(ownRandom);
+    }
+
+    // reference clusterizer used to validate the results, running the original algorithm on a single thread
+    // with the same kind of random generator
+    if (ic.options().get<bool>("validate")) {
+      mReferenceClusterFinder = std::make_unique<ClusterFinderOriginal>();
+      mReferenceClusterFinder->init(run2Config);
+      mReferenceClusterFinder->useMathiesonLUT(false);
+      mReferenceClusterFinder->useOwnRandomGenerator(ownRandom);
+    }
 
     /// Print the timer and clear the clusterizer when the processing is over
     ic.services().get<CallbackService>().set(CallbackService::Id::Stop, [this]() {
       LOG(INFO) << "cluster finder duration = " << mTimeClusterFinder.count() << " s";
-      this->mClusterFinder.deinit();
+      if (mReferenceClusterFinder) {
+        LOG(INFO) << "validation: " << mNROFsDifferent << " interactions out of " << mNROFsValidated
+                  << " with a different number of clusters, " << mNClustersDifferent << " clusters out of " << mNClustersValidated
+                  << " with a position differing by more than " << SValidationPrecision << " cm";
+        this->mReferenceClusterFinder->deinit();
+      }
+      for (auto& clusterFinder : this->mClusterFinders) {
+        clusterFinder->deinit();
+      }
     });
   }
 
@@ -89,47 +139,124 @@ class ClusterFinderOriginalTask
     auto& clusters = pc.outputs().make<std::vector<ClusterStruct>>(OutputRef{"clusters"});
     auto& usedDigits = pc.outputs().make<std::vector<Digit>>(OutputRef{"clusterdigits"});
 
-    clusterROFs.reserve(preClusterROFs.size());
-    for (const auto& preClusterROF : preClusterROFs) {
+    // the preclusters are independent: they are clusterized concurrently, each thread with its own cluster finder,
+    // and their clusters and attached digits are stored in separate buffers, merged in the preclusters order
+    int nPreClusters = preClusters.size();
+    std::vector<std::vector<ClusterStruct>> preClusterClusters(nPreClusters);
+    std::vector<std::vector<Digit>> preClusterDigits(nPreClusters);
+    std::exception_ptr error{};
 
-      //LOG(INFO) << "processing interaction: " << preClusterROF.getBCData() << "...";
+    auto tStart = std::chrono::high_resolution_clock::now();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mClusterFinders.size())
+#endif
+    for (int iPreCluster = 0; iPreCluster < nPreClusters; ++iPreCluster) {
+#ifdef WITH_OPENMP
+      auto& clusterFinder = *mClusterFinders[omp_get_thread_num()];
+#else
+      auto& clusterFinder = *mClusterFinders.front();
+#endif
+      const auto& preCluster = preClusters[iPreCluster];
 
-      // clusterize every preclusters
-      auto tStart = std::chrono::high_resolution_clock::now();
-      mClusterFinder.reset();
-      for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries())) {
-        mClusterFinder.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
+      // clusterize the precluster, keeping the first error to rethrow it outside of the parallel region
+      try {
+        clusterFinder.reset();
+        clusterFinder.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
+        preClusterClusters[iPreCluster] = clusterFinder.getClusters();
+        preClusterDigits[iPreCluster] = clusterFinder.getUsedDigits();
+      } catch (...) {
+#ifdef WITH_OPENMP
+#pragma omp critical(mch_clusterfinder_error)
+#endif
+        if (!error) {
+          error = std::current_exception();
+        }
       }
-      auto tEnd = std::chrono::high_resolution_clock::now();
-      mTimeClusterFinder += tEnd - tStart;
+    }
+    auto tEnd = std::chrono::high_resolution_clock::now();
+    mTimeClusterFinder += tEnd - tStart;
+    if (error) {
+      std::rethrow_exception(error);
+    }
 
-      // fill the ouput messages
-      clusterROFs.emplace_back(preClusterROF.getBCData(), clusters.size(), mClusterFinder.getClusters().size());
-      writeClusters(clusters, usedDigits);
+    // fill the ouput messages
+    clusterROFs.reserve(preClusterROFs.size());
+    for (const auto& preClusterROF : preClusterROFs) {
+      auto firstCluster = clusters.size();
+      for (int iPreCluster = preClusterROF.getFirstIdx(); iPreCluster < preClusterROF.getFirstIdx() + preClusterROF.getNEntries(); ++iPreCluster) {
+        writeClusters(preClusterClusters[iPreCluster], preClusterDigits[iPreCluster], clusters.size() - firstCluster, clusters, usedDigits);
+      }
+      clusterROFs.emplace_back(preClusterROF.getBCData(), firstCluster, clusters.size() - firstCluster);
+    }
+
+    if (mReferenceClusterFinder) {
+      validate(preClusterROFs, preClusters, digits, clusterROFs, clusters);
     }
   }
 
  private:
+  static constexpr double SValidationPrecision = 1.e-3; ///< maximum accepted difference between cluster positions (cm)
+
   //_________________________________________________________________________________________________
-  void writeClusters(std::vector<ClusterStruct, o2::pmr::polymorphic_allocator<ClusterStruct>>& clusters,
+  void writeClusters(const std::vector<ClusterStruct>& newClusters, const std::vector<Digit>& newDigits, int clusterIndexOffset,
+                     std::vector<ClusterStruct, o2::pmr::polymorphic_allocator<ClusterStruct>>& clusters,
                      std::vector<Digit, o2::pmr::polymorphic_allocator<Digit>>& usedDigits) const
   {
-    /// fill the output messages with clusters and attached digits of the current event
+    /// fill the output messages with clusters and attached digits of the current precluster
     /// modify the references to the attached digits according to their position in the global vector
+    /// and the cluster unique IDs according to the position of the clusters in the current event
 
     auto clusterOffset = clusters.size();
-    clusters.insert(clusters.end(), mClusterFinder.getClusters().begin(), mClusterFinder.getClusters().end());
+    clusters.insert(clusters.end(), newClusters.begin(), newClusters.end());
 
     auto digitOffset = usedDigits.size();
-    usedDigits.insert(usedDigits.end(), mClusterFinder.getUsedDigits().begin(), mClusterFinder.getUsedDigits().end());
+    usedDigits.insert(usedDigits.end(), newDigits.begin(), newDigits.end());
 
     for (auto itCluster = clusters.begin() + clusterOffset; itCluster < clusters.end(); ++itCluster) {
       itCluster->firstDigit += digitOffset;
+      itCluster->uid = ClusterStruct::buildUniqueId(itCluster->getChamberId(), itCluster->getDEId(),
+                                                    itCluster->getClusterIndex() + clusterIndexOffset);
+    }
+  }
+
+  //_________________________________________________________________________________________________
+  void validate(gsl::span<const ROFRecord> preClusterROFs, gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits,
+                gsl::span<const ROFRecord> clusterROFs, gsl::span<const ClusterStruct> clusters)
+  {
+    /// compare the clusters of every event with those reconstructed with the original algorithm
+
+    for (int iROF = 0; iROF < preClusterROFs.size(); ++iROF) {
+
+      mReferenceClusterFinder->reset();
+      for (const auto& preCluster : preClusters.subspan(preClusterROFs[iROF].getFirstIdx(), preClusterROFs[iROF].getNEntries())) {
+        mReferenceClusterFinder->findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
+      }
+      const auto& refClusters = mReferenceClusterFinder->getClusters();
+      auto rofClusters = clusters.subspan(clusterROFs[iROF].getFirstIdx(), clusterROFs[iROF].getNEntries());
+
+      ++mNROFsValidated;
+      mNClustersValidated += refClusters.size();
+      if (rofClusters.size() != refClusters.size()) {
+        ++mNROFsDifferent;
+        mNClustersDifferent += refClusters.size();
+        continue;
+      }
+      for (int iCluster = 0; iCluster < refClusters.size(); ++iCluster) {
+        if (std::abs(rofClusters[iCluster].x - refClusters[iCluster].x) > SValidationPrecision ||
+            std::abs(rofClusters[iCluster].y - refClusters[iCluster].y) > SValidationPrecision) {
+          ++mNClustersDifferent;
+        }
+      }
     }
   }
 
-  ClusterFinderOriginal mClusterFinder{};             ///< clusterizer
-  std::chrono::duration<double> mTimeClusterFinder{}; ///< timer
+  std::vector<std::unique_ptr<ClusterFinderOriginal>> mClusterFinders{}; ///< clusterizers, one per thread
+  std::unique_ptr<ClusterFinderOriginal> mReferenceClusterFinder{};      ///< clusterizer used for validation, if any
+  std::chrono::duration<double> mTimeClusterFinder{};                    ///< timer
+  std::size_t mNROFsValidated = 0;                                       ///< number of validated events
+  std::size_t mNROFsDifferent = 0;                                       ///< number of events with a different number of clusters
+  std::size_t mNClustersValidated = 0;                                   ///< number of validated clusters
+  std::size_t mNClustersDifferent = 0;                                   ///< number of clusters found different
 };
 
 //_________________________________________________________________________________________________
@@ -145,7 +272,9 @@ o2::framework::DataProcessorSpec getClusterFinderOriginalSpec(const char* name)
             OutputSpec{{"clusterdigits"}, "MCH", "CLUSTERDIGITS", 0, Lifetime::Timeframe}},
     AlgorithmSpec{adaptFromTask<ClusterFinderOriginalTask>()},
     Options{{"config", VariantType::String, "", {"JSON or INI file with clustering parameters"}},
-            {"run2-config", VariantType::Bool, false, {"setup for run2 data"}}}};
+            {"run2-config", VariantType::Bool, false, {"setup for run2 data"}},
+            {"threads", VariantType::Int, 0, {"number of threads clusterizing the preclusters in parallel (0 = original processing)"}},
+            {"validate", VariantType::Bool, false, {"compare the clusters with those of the original algorithm"}}}};
 }
 
 } // end namespace mch
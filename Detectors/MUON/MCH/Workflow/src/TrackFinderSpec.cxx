@@ -16,12 +16,16 @@
 
 #include "TrackFinderSpec.h"
 
+#include <algorithm>
 #include <chrono>
+#include <exception>
 #include <unordered_map>
 #include <list>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <filesystem>
+#include <vector>
 
 #include <gsl/span>
 
@@ -46,6 +50,10 @@
 #include "MCHTracking/Track.h"
 #include "MCHTracking/TrackFinder.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace mch
@@ -83,14 +91,28 @@ class TrackFinderTask
     if (!config.empty()) {
       o2::conf::ConfigurableParam::updateFromFile(config, "MCHTracking", true);
     }
-    mTrackFinder.init(l3Current, dipoleCurrent);
 
+    // one track finder per thread, as they hold the tracks of the event being processed
+    auto nThreads = std::max(1, ic.options().get<int>("threads"));
+#ifndef WITH_OPENMP
+    if (nThreads > 1) {
+      LOG(WARNING) << "track finder compiled without OpenMP support, using 1 thread";
+      nThreads = 1;
+    }
+#endif
     auto debugLevel = ic.options().get<int>("debug");
-    mTrackFinder.debug(debugLevel);
+    for (int i = 0; i < nThreads; ++i) {
+      auto& trackFinder = mTrackFinders.emplace_back(std::make_unique<TrackFinder>());
+      trackFinder->init(l3Current, dipoleCurrent);
+      trackFinder->debug(debugLevel);
+    }
 
     auto stop = [this]() {
-      mTrackFinder.printStats();
-      mTrackFinder.printTimers();
+      for (auto itTrackFinder = std::next(mTrackFinders.begin()); itTrackFinder != mTrackFinders.end(); ++itTrackFinder) {
+        mTrackFinders.front()->mergeStats(**itTrackFinder);
+      }
+      mTrackFinders.front()->printStats();
+      mTrackFinders.front()->printTimers();
       LOG(INFO) << "tracking duration = " << mElapsedTime.count() << " s";
     };
     ic.services().get<CallbackService>().set(CallbackService::Id::Stop, stop);
@@ -112,8 +134,24 @@ class TrackFinderTask
     auto& mchTracks = pc.outputs().make<std::vector<TrackMCH>>(OutputRef{"tracks"});
     auto& usedClusters = pc.outputs().make<std::vector<ClusterStruct>>(OutputRef{"trackclusters"});
 
-    trackROFs.reserve(clusterROFs.size());
-    for (const auto& clusterROF : clusterROFs) {
+    // the events are independent: they are processed concurrently, each thread with its own track finder,
+    // and their tracks are stored in separate buffers, merged in the events order
+    int nROFs = clusterROFs.size();
+    std::vector<std::vector<TrackMCH>> rofTracks(nROFs);
+    std::vector<std::vector<ClusterStruct>> rofClusters(nROFs);
+    std::exception_ptr error{};
+
+    auto tStart = std::chrono::high_resolution_clock::now();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mTrackFinders.size())
+#endif
+    for (int iROF = 0; iROF < nROFs; ++iROF) {
+#ifdef WITH_OPENMP
+      auto& trackFinder = *mTrackFinders[omp_get_thread_num()];
+#else
+      auto& trackFinder = *mTrackFinders.front();
+#endif
+      const auto& clusterROF = clusterROFs[iROF];
 
       //LOG(INFO) << "processing interaction: " << clusterROF.getBCData() << "...";
 
@@ -123,25 +161,43 @@ class TrackFinderTask
         clusters[cluster.getDEId()].emplace_back(cluster);
       }
 
-      // run the track finder
-      auto tStart = std::chrono::high_resolution_clock::now();
-      const auto& tracks = mTrackFinder.findTracks(clusters);
-      auto tEnd = std::chrono::high_resolution_clock::now();
-      mElapsedTime += tEnd - tStart;
+      // run the track finder, keeping the first error to rethrow it outside of the parallel region
+      try {
+        const auto& tracks = trackFinder.findTracks(clusters);
+        writeTracks(tracks, rofTracks[iROF], rofClusters[iROF]);
+      } catch (...) {
+#ifdef WITH_OPENMP
+#pragma omp critical(mch_trackfinder_error)
+#endif
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+    auto tEnd = std::chrono::high_resolution_clock::now();
+    mElapsedTime += tEnd - tStart;
+    if (error) {
+      std::rethrow_exception(error);
+    }
 
-      // fill the ouput messages
-      trackROFs.emplace_back(clusterROF.getBCData(), mchTracks.size(), tracks.size());
-      writeTracks(tracks, mchTracks, usedClusters);
+    // fill the ouput messages
+    trackROFs.reserve(nROFs);
+    for (int iROF = 0; iROF < nROFs; ++iROF) {
+      trackROFs.emplace_back(clusterROFs[iROF].getBCData(), mchTracks.size(), rofTracks[iROF].size());
+      int clusterOffset = usedClusters.size();
+      for (auto& track : rofTracks[iROF]) {
+        track.setClusterRef(track.getFirstClusterIdx() + clusterOffset, track.getNClusters());
+        mchTracks.push_back(track);
+      }
+      usedClusters.insert(usedClusters.end(), rofClusters[iROF].begin(), rofClusters[iROF].end());
     }
   }
 
  private:
   //_________________________________________________________________________________________________
-  void writeTracks(const std::list<Track>& tracks,
-                   std::vector<TrackMCH, o2::pmr::polymorphic_allocator<TrackMCH>>& mchTracks,
-                   std::vector<ClusterStruct, o2::pmr::polymorphic_allocator<ClusterStruct>>& usedClusters) const
+  void writeTracks(const std::pmr::list<Track>& tracks, std::vector<TrackMCH>& mchTracks, std::vector<ClusterStruct>& usedClusters) const
   {
-    /// fill the output messages with tracks and attached clusters
+    /// fill the buffers of the current event with tracks and attached clusters
 
     for (const auto& track : tracks) {
 
@@ -155,8 +211,8 @@ class TrackFinderTask
     }
   }
 
-  TrackFinder mTrackFinder{};                   ///< track finder
-  std::chrono::duration<double> mElapsedTime{}; ///< timer
+  std::vector<std::unique_ptr<TrackFinder>> mTrackFinders{}; ///< track finders, one per thread
+  std::chrono::duration<double> mElapsedTime{};              ///< timer
 };
 
 //_________________________________________________________________________________________________
@@ -174,7 +230,8 @@ o2::framework::DataProcessorSpec getTrackFinderSpec(const char* name)
             {"dipoleCurrent", VariantType::Float, -6000.0f, {"Dipole current"}},
             {"grp-file", VariantType::String, o2::base::NameConf::getGRPFileName(), {"Name of the grp file"}},
             {"config", VariantType::String, "", {"JSON or INI file with tracking parameters"}},
-            {"debug", VariantType::Int, 0, {"debug level"}}}};
+            {"debug", VariantType::Int, 0, {"debug level"}},
+            {"threads", VariantType::Int, 1, {"number of threads processing the events in parallel"}}}};
 }
 
 } // namespace mch
@@ -17,12 +17,13 @@
 #ifndef O2_MID_CLUSTERIZER_H
 #define O2_MID_CLUSTERIZER_H
 
+#include <array>
 #include <functional>
-#include <unordered_map>
 #include <vector>
 #include <gsl/gsl>
 #include "DataFormatsMID/Cluster2D.h"
 #include "DataFormatsMID/ROFRecord.h"
+#include "MIDBase/DetectorParameters.h"
 #include "MIDBase/MpArea.h"
 #include "MIDClustering/PreCluster.h"
 #include "MIDClustering/PreClusterHelper.h"
@@ -54,14 +55,15 @@ class Clusterizer
   void makeCluster(const MpArea& areaBP, const MpArea& areaNBP, const int& icolumn, const int& deIndex);
   void makeCluster(const PreClustersDE::BP& pcBP, const PreClustersDE::BP& pcBPNeigh, const PreClustersDE::NBP& pcNBP, const int& deIndex);
 
-  const gsl::span<const PreCluster>* mPreClusters{nullptr}; ///! Input pre-clusters
-  std::unordered_map<int, PreClustersDE> mPreClustersDE{};  ///! Sorted pre-clusters
-  std::unordered_map<int, bool> mActiveDEs{};               ///! List of active detection elements for event
-  PreClusterHelper mPreClusterHelper{};                     ///! Helper for pre-clusters
-  std::vector<Cluster2D> mClusters{};                       ///< List of clusters
-  std::vector<ROFRecord> mROFRecords{};                     ///< List of cluster RO frame records
-  size_t mPreClusterOffset{0};                              //!< RO offset for pre-cluster
-  std::function<void(size_t, size_t)> mFunction;            ///! Function to keep track of input-output relation
+  const gsl::span<const PreCluster>* mPreClusters{nullptr};                   ///! Input pre-clusters
+  std::array<PreClustersDE, detparams::NDetectionElements> mPreClustersDE{}; ///! Sorted pre-clusters
+  std::array<bool, detparams::NDetectionElements> mIsActiveDE{};              ///! Flag for active detection elements in event
+  std::vector<int> mActiveDEs{};                                              ///! List of active detection elements for event
+  PreClusterHelper mPreClusterHelper{};                                       ///! Helper for pre-clusters
+  std::vector<Cluster2D> mClusters{};                                         ///< List of clusters
+  std::vector<ROFRecord> mROFRecords{};                                       ///< List of cluster RO frame records
+  size_t mPreClusterOffset{0};                                                //!< RO offset for pre-cluster
+  std::function<void(size_t, size_t)> mFunction;                              ///! Function to keep track of input-output relation
 };
 } // namespace mid
 } // namespace o2
@@ -17,9 +17,10 @@
 #ifndef O2_MID_PRECLUSTERIZER_H
 #define O2_MID_PRECLUSTERIZER_H
 
-#include <unordered_map>
+#include <array>
 #include <vector>
 #include <gsl/gsl>
+#include "MIDBase/DetectorParameters.h"
 #include "MIDBase/Mapping.h"
 #include "DataFormatsMID/ColumnData.h"
 #include "DataFormatsMID/ROFRecord.h"
@@ -45,8 +46,8 @@ class PreClusterizer
 
  private:
   struct PatternStruct {
-    int deId;                          ///< Detection element ID
-    int firedColumns;                  ///< Fired columns
+    int deId{0};                       ///< Detection element ID
+    int firedColumns{0};               ///< Fired columns
     std::array<ColumnData, 7> columns; ///< Array of strip patterns
   };
 
@@ -55,11 +56,11 @@ class PreClusterizer
   void preClusterizeBP(PatternStruct& de);
   void preClusterizeNBP(PatternStruct& de);
 
-  Mapping mMapping;                              ///< Mapping
-  std::unordered_map<int, PatternStruct> mMpDEs; ///< Internal mapping
-  std::unordered_map<int, bool> mActiveDEs;      ///< List of active detection elements for event
-  std::vector<PreCluster> mPreClusters;          ///< List of pre-clusters
-  std::vector<ROFRecord> mROFRecords;            ///< List of pre-clusters RO frame records
+  Mapping mMapping;                                                ///< Mapping
+  std::array<PatternStruct, detparams::NDetectionElements> mMpDEs; ///< Internal mapping
+  std::vector<int> mActiveDEs;                                     ///< List of active detection elements for event
+  std::vector<PreCluster> mPreClusters;                            ///< List of pre-clusters
+  std::vector<ROFRecord> mROFRecords;                              ///< List of pre-clusters RO frame records
 };
 } // namespace mid
 } // namespace o2
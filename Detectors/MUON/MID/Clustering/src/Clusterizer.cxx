@@ -44,7 +44,10 @@ bool Clusterizer::loadPreClusters(gsl::span<const PreCluster>& preClusters)
       }
     }
 
-    mActiveDEs[deIndex] = true;
+    if (!mIsActiveDE[deIndex]) {
+      mIsActiveDE[deIndex] = true;
+      mActiveDEs.emplace_back(deIndex);
+    }
   }
 
   return (preClusters.size() > 0);
@@ -63,9 +66,10 @@ void Clusterizer::process(gsl::span<const PreCluster> preClusters, bool accumula
     mClusters.clear();
   }
   if (loadPreClusters(preClusters)) {
-    // Loop only on fired detection elements
+    // Loop only on fired detection elements, in order of appearance
     for (auto& deIndex : mActiveDEs) {
-      makeClusters(mPreClustersDE[deIndex.first]);
+      makeClusters(mPreClustersDE[deIndex]);
+      mIsActiveDE[deIndex] = false;
     }
   }
 }
@@ -193,7 +197,7 @@ bool Clusterizer::init(std::function<void(size_t, size_t)> func)
   /// Initializes the class
 
   // prepare storage of clusters and PreClusters
-  mPreClustersDE.reserve(detparams::NDetectionElements);
+  mActiveDEs.reserve(detparams::NDetectionElements);
   mFunction = func;
 
   return true;
@@ -262,6 +266,9 @@ void Clusterizer::makeCluster(const PreClustersDE::BP& pcBP, const PreClustersDE
 void Clusterizer::reset()
 {
   /// Resets the clusters
+  for (auto& deIndex : mActiveDEs) {
+    mIsActiveDE[deIndex] = false;
+  }
   mActiveDEs.clear();
   mClusters.clear();
 }
@@ -42,7 +42,7 @@ void PreClusterizer::process(gsl::span<const ColumnData> stripPatterns, bool acc
     // Loop only on fired detection elements
     for (auto& deIndex : mActiveDEs) {
       // reset the precluster
-      PatternStruct& de = mMpDEs[deIndex.first];
+      PatternStruct& de = mMpDEs[deIndex];
 
       preClusterizeNBP(de);
       preClusterizeBP(de);
@@ -73,7 +73,6 @@ bool PreClusterizer::init()
 {
   /// Initializes the class
 
-  mMpDEs.reserve(detparams::NDetectionElements);
   mActiveDEs.reserve(detparams::NDetectionElements);
   return true;
 }
@@ -82,25 +81,21 @@ bool PreClusterizer::init()
 bool PreClusterizer::loadPatterns(gsl::span<const ColumnData>& stripPatterns)
 {
   /// Fills the mpDE structure with fired pads
+  /// The active detection elements are listed in order of appearance
 
   // Loop on stripPatterns
   for (auto& col : stripPatterns) {
     int deIndex = col.deId;
     assert(deIndex < detparams::NDetectionElements);
 
-    auto search = mMpDEs.find(deIndex);
-    PatternStruct* de = nullptr;
-    if (search == mMpDEs.end()) {
-      de = &mMpDEs[deIndex];
-      de->deId = col.deId;
-    } else {
-      de = &(search->second);
+    PatternStruct& de = mMpDEs[deIndex];
+    if (de.firedColumns == 0) {
+      de.deId = deIndex;
+      mActiveDEs.emplace_back(deIndex);
     }
 
-    mActiveDEs[deIndex] = true;
-
-    de->firedColumns |= (1 << col.columnId);
-    de->columns[col.columnId] = col;
+    de.firedColumns |= (1 << col.columnId);
+    de.columns[col.columnId] = col;
   }
 
   return (stripPatterns.size() > 0);
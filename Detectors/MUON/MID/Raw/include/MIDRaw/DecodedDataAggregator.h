@@ -16,9 +16,11 @@
 #ifndef O2_MID_DECODEDDATAAGGREGATOR_H
 #define O2_MID_DECODEDDATAAGGREGATOR_H
 
+#include <array>
+#include <utility>
 #include <vector>
-#include <map>
 #include <gsl/gsl>
+#include "MIDBase/DetectorParameters.h"
 #include "DataFormatsMID/ColumnData.h"
 #include "DataFormatsMID/ROFRecord.h"
 #include "MIDRaw/CrateMapper.h"
@@ -43,10 +45,11 @@ class DecodedDataAggregator
   void addData(const ROBoard& col, size_t firstEntry);
   ColumnData& FindColumnData(uint8_t deId, uint8_t columnId, size_t firstEntry);
 
-  std::map<uint64_t, std::vector<size_t>> mOrderIndexes; /// Map for time ordering the entries
-  std::vector<ColumnData> mData{};                       /// Vector of output column data
-  std::vector<ROFRecord> mROFRecords{};                  /// Vector of ROF records
-  CrateMapper mCrateMapper;                              /// Mapper to convert the RO info to ColumnData
+  std::vector<std::pair<uint64_t, size_t>> mOrderIndexes{};                /// Vector for time ordering the entries
+  std::array<size_t, detparams::NDetectionElements * 7> mColumnIndexes{}; /// Position of the column data in the output
+  std::vector<ColumnData> mData{};                                         /// Vector of output column data
+  std::vector<ROFRecord> mROFRecords{};                                    /// Vector of ROF records
+  CrateMapper mCrateMapper;                                                /// Mapper to convert the RO info to ColumnData
 };
 } // namespace mid
 } // namespace o2
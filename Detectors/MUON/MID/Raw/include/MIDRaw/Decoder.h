@@ -54,6 +54,24 @@ class Decoder
     mLinkDecoders.find(feeId)->second->process(payload, o2::raw::RDHUtils::getHeartBeatOrbit(rdh), mData, mROFRecords);
 #endif
   }
+  template <class RDH>
+  void addPage(gsl::span<const uint8_t> payload, const RDH& rdh)
+  {
+    /// Adds the page to the list of pages decoded by processPages
+    auto feeId = o2::raw::RDHUtils::getFEEID(rdh);
+#if defined(MID_RAW_VECTORS)
+    auto linkDecoder = mLinkDecoders[feeId].get();
+#else
+    auto linkDecoder = mLinkDecoders.find(feeId)->second.get();
+#endif
+    mPages.push_back({payload, o2::raw::RDHUtils::getHeartBeatOrbit(rdh), linkDecoder});
+  }
+  void processPages();
+
+  void setNThreads(int nThreads);
+  /// Gets the number of threads used in processPages
+  int getNThreads() const { return mNThreads; }
+
   /// Gets the vector of data
   const std::vector<ROBoard>& getData() const { return mData; }
 
@@ -70,8 +88,30 @@ class Decoder
 #endif
 
  private:
-  std::vector<ROBoard> mData{};         /// Vector of output data
-  std::vector<ROFRecord> mROFRecords{}; /// List of ROF records
+  struct Page {
+    gsl::span<const uint8_t> payload{}; /// Page payload
+    uint32_t orbit{0};                  /// Heart beat orbit
+    LinkDecoder* linkDecoder{nullptr};  /// Decoder of the GBT link
+    size_t link{0};                     /// Index of the link buffer
+    size_t firstData{0};                /// First decoded board in link buffer
+    size_t nData{0};                    /// Number of decoded boards
+    size_t firstROF{0};                 /// First ROF record in link buffer
+    size_t nROFs{0};                    /// Number of ROF records
+  };
+
+  struct LinkBuffer {
+    LinkDecoder* linkDecoder{nullptr}; /// Decoder of the GBT link
+    std::vector<size_t> pages{};       /// Indexes of the link pages
+    std::vector<ROBoard> data{};       /// Decoded data
+    std::vector<ROFRecord> rofs{};     /// Decoded ROF records
+  };
+
+  std::vector<ROBoard> mData{};           /// Vector of output data
+  std::vector<ROFRecord> mROFRecords{};   /// List of ROF records
+  std::vector<Page> mPages{};             /// Pages to be decoded by processPages
+  std::vector<LinkBuffer> mLinkBuffers{}; /// Decoding buffers per GBT link
+  size_t mNLinks{0};                      /// Number of links in the pages
+  int mNThreads{1};                       /// Number of threads
 };
 
 std::unique_ptr<Decoder> createDecoder(const o2::header::RDHAny& rdh, bool isDebugMode, const ElectronicsDelay& electronicsDelay, const CrateMasks& crateMasks, const FEEIdConfig& feeIdConfig);
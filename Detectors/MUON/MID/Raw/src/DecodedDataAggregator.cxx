@@ -16,6 +16,7 @@
 
 #include "MIDRaw/DecodedDataAggregator.h"
 
+#include <algorithm>
 #include "MIDBase/DetectorParameters.h"
 
 #include "MIDRaw/CrateParameters.h"
@@ -29,11 +30,13 @@ ColumnData& DecodedDataAggregator::FindColumnData(uint8_t deId, uint8_t columnId
 {
   /// Gets the matching column data
   /// Adds one if not found
-  for (auto colIt = mData.begin() + firstEntry; colIt != mData.end(); ++colIt) {
-    if (colIt->deId == deId && colIt->columnId == columnId) {
-      return *colIt;
-    }
+  /// The position of the last column data added for each column is kept in a table:
+  /// it is valid if it points to the same column in the current event
+  auto& idx = mColumnIndexes[deId * 7 + columnId];
+  if (idx >= firstEntry && idx < mData.size() && mData[idx].deId == deId && mData[idx].columnId == columnId) {
+    return mData[idx];
   }
+  idx = mData.size();
   mData.push_back({deId, columnId});
   return mData.back();
 }
@@ -67,17 +70,18 @@ void DecodedDataAggregator::process(gsl::span<const ROBoard> localBoards, gsl::s
   mData.clear();
   mROFRecords.clear();
 
-  // Fill the map with ordered events
+  // Order the events in time, keeping the input order for the same timestamp
   for (auto rofIt = rofRecords.begin(); rofIt != rofRecords.end(); ++rofIt) {
-    mOrderIndexes[rofIt->interactionRecord.toLong()].emplace_back(rofIt - rofRecords.begin());
+    mOrderIndexes.emplace_back(rofIt->interactionRecord.toLong(), rofIt - rofRecords.begin());
   }
+  std::sort(mOrderIndexes.begin(), mOrderIndexes.end());
 
-  const ROFRecord* rof = nullptr;
-  for (auto& item : mOrderIndexes) {
+  for (auto item = mOrderIndexes.begin(); item != mOrderIndexes.end();) {
     size_t firstEntry = mData.size();
-    for (auto& idx : item.second) {
+    const ROFRecord* rof = nullptr;
+    for (auto timestamp = item->first; item != mOrderIndexes.end() && item->first == timestamp; ++item) {
       // In principle all of these ROF records have the same timestamp
-      rof = &rofRecords[idx];
+      rof = &rofRecords[item->second];
       for (size_t iloc = rof->firstEntry; iloc < rof->firstEntry + rof->nEntries; ++iloc) {
         addData(localBoards[iloc], firstEntry);
       }
@@ -16,8 +16,10 @@
 
 #include "MIDRaw/Decoder.h"
 
+#include <algorithm>
 #include "Headers/RDHAny.h"
-#include "DPLUtils/RawParser.h"
+#include "DetectorsRaw/RDHPageWalker.h"
+#include "Framework/Logger.h"
 
 namespace o2
 {
@@ -49,15 +51,101 @@ void Decoder::process(gsl::span<const uint8_t> bytes)
 {
   /// Decodes the buffer
   clear();
-  o2::framework::RawParser parser(bytes.data(), bytes.size());
-  for (auto it = parser.begin(), end = parser.end(); it != end; ++it) {
-    if (it.size() == 0) {
+  o2::raw::RDHPageWalker walker(bytes.data(), bytes.size());
+  for (const auto& page : walker) {
+    if (page.payload.empty()) {
       continue;
     }
-    gsl::span<const uint8_t> payload(it.data(), it.size());
-    auto const* rdhPtr = reinterpret_cast<const o2::header::RDHAny*>(it.raw());
-    process(payload, *rdhPtr);
+    gsl::span<const uint8_t> payload(reinterpret_cast<const uint8_t*>(page.payload.data()), page.payload.size());
+    process(payload, *reinterpret_cast<const o2::header::RDHAny*>(page.rdh));
   }
+  if (!walker.isComplete()) {
+    LOG(ERROR) << "Inconsistent RDH found in the buffer: the following pages are skipped";
+  }
+}
+
+void Decoder::processPages()
+{
+  /// Decodes the pages added with addPage.
+  /// The GBT links are decoded in parallel in separate buffers.
+  /// The buffers are then merged following the order of the pages,
+  /// so that the output is the same as for the sequential decoding
+  clear();
+
+  // Group the pages per link
+  mNLinks = 0;
+  for (size_t ipage = 0; ipage < mPages.size(); ++ipage) {
+    auto& page = mPages[ipage];
+    size_t ilink = 0;
+    for (; ilink < mNLinks; ++ilink) {
+      if (mLinkBuffers[ilink].linkDecoder == page.linkDecoder) {
+        break;
+      }
+    }
+    if (ilink == mNLinks) {
+      if (mNLinks == mLinkBuffers.size()) {
+        mLinkBuffers.emplace_back();
+      }
+      mLinkBuffers[ilink].linkDecoder = page.linkDecoder;
+      mLinkBuffers[ilink].pages.clear();
+      ++mNLinks;
+    }
+    mLinkBuffers[ilink].pages.emplace_back(ipage);
+    page.link = ilink;
+  }
+
+  // Decode each link in its own buffer
+  int nLinks = mNLinks;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ilink = 0; ilink < nLinks; ++ilink) {
+    auto& link = mLinkBuffers[ilink];
+    link.data.clear();
+    link.rofs.clear();
+    for (auto& ipage : link.pages) {
+      auto& page = mPages[ipage];
+      page.firstData = link.data.size();
+      page.firstROF = link.rofs.size();
+      link.linkDecoder->process(page.payload, page.orbit, link.data, link.rofs);
+      page.nData = link.data.size() - page.firstData;
+      page.nROFs = link.rofs.size() - page.firstROF;
+    }
+  }
+
+  // Merge the buffers in the page order
+  size_t nData = 0, nROFs = 0;
+  for (size_t ilink = 0; ilink < mNLinks; ++ilink) {
+    nData += mLinkBuffers[ilink].data.size();
+    nROFs += mLinkBuffers[ilink].rofs.size();
+  }
+  mData.resize(nData);
+  mROFRecords.resize(nROFs);
+  size_t iData = 0, iROF = 0;
+  for (auto& page : mPages) {
+    auto& link = mLinkBuffers[page.link];
+    std::copy_n(link.data.begin() + page.firstData, page.nData, mData.begin() + iData);
+    for (size_t irof = page.firstROF; irof < page.firstROF + page.nROFs; ++irof) {
+      auto& rof = mROFRecords[iROF++];
+      rof = link.rofs[irof];
+      rof.firstEntry = rof.firstEntry - page.firstData + iData;
+    }
+    iData += page.nData;
+  }
+  mPages.clear();
+}
+
+void Decoder::setNThreads(int nThreads)
+{
+  /// Sets the number of threads used in processPages
+#ifdef WITH_OPENMP
+  mNThreads = nThreads > 0 ? nThreads : 1;
+#else
+  if (nThreads > 1) {
+    LOG(WARNING) << "Multithreading is not supported, imposing single thread";
+  }
+  mNThreads = 1;
+#endif
 }
 
 std::unique_ptr<Decoder> createDecoder(const o2::header::RDHAny& rdh, bool isDebugMode, const ElectronicsDelay& electronicsDelay, const CrateMasks& crateMasks, const FEEIdConfig& feeIdConfig)
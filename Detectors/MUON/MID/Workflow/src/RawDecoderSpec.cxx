@@ -18,6 +18,7 @@
 
 #include <chrono>
 #include "Framework/CallbackService.h"
+#include "Framework/ConfigParamRegistry.h"
 #include "Framework/Logger.h"
 #include "Framework/Output.h"
 #include "Framework/Task.h"
@@ -40,6 +41,7 @@ class RawDecoderDeviceDPL
 
   void init(of::InitContext& ic)
   {
+    mNThreads = ic.options().get<int>("mid-decoder-nthreads");
     auto stop = [this]() {
       if (mDecoder) {
         LOG(INFO) << "Capacities: ROFRecords: " << mDecoder->getROFRecords().capacity() << "  LocalBoards: " << mDecoder->getData().capacity();
@@ -71,14 +73,15 @@ class RawDecoderDeviceDPL
     if (!mDecoder) {
       auto const* rdhPtr = reinterpret_cast<const o2::header::RDHAny*>(parser.begin().raw());
       mDecoder = createDecoder(*rdhPtr, mIsDebugMode, mElectronicsDelay, mCrateMasks, mFeeIdConfig);
+      mDecoder->setNThreads(mNThreads);
     }
 
-    mDecoder->clear();
     for (auto it = parser.begin(), end = parser.end(); it != end; ++it) {
       auto const* rdhPtr = reinterpret_cast<const o2::header::RDHAny*>(it.raw());
       gsl::span<const uint8_t> payload(it.data(), it.size());
-      mDecoder->process(payload, *rdhPtr);
+      mDecoder->addPage(payload, *rdhPtr);
     }
+    mDecoder->processPages();
 
     mTimerAlgo += std::chrono::high_resolution_clock::now() - tAlgoStart;
 
@@ -96,6 +99,7 @@ class RawDecoderDeviceDPL
   CrateMasks mCrateMasks{};
   ElectronicsDelay mElectronicsDelay{};
   header::DataHeader::SubSpecificationType mSubSpec{0};
+  int mNThreads{1};                            ///< Number of decoding threads
   std::chrono::duration<double> mTimer{0};     ///< full timer
   std::chrono::duration<double> mTimerAlgo{0}; ///< algorithm timer
   unsigned int mNROFs{0};                      /// Total number of processed ROFs
@@ -111,7 +115,8 @@ of::DataProcessorSpec getRawDecoderSpec(bool isDebugMode, const FEEIdConfig& fee
     "MIDRawDecoder",
     {inputSpecs},
     {outputSpecs},
-    of::adaptFromTask<o2::mid::RawDecoderDeviceDPL>(isDebugMode, feeIdConfig, crateMasks, electronicsDelay, subSpecType)};
+    of::adaptFromTask<o2::mid::RawDecoderDeviceDPL>(isDebugMode, feeIdConfig, crateMasks, electronicsDelay, subSpecType),
+    of::Options{{"mid-decoder-nthreads", of::VariantType::Int, 1, {"Number of threads for the GBT links decoding"}}}};
 }
 
 of::DataProcessorSpec getRawDecoderSpec(bool isDebugMode)
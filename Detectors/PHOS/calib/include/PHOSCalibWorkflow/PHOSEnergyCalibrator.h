@@ -104,7 +104,9 @@ class PHOSEnergySlot
   float mPtMin = 1.5; /// minimal energy to fill inv. mass histo
   float mEminHGTime = 1.5;
   float mEminLGTime = 5.;
-  std::vector<uint32_t> mDigits; /// list of calibration digits to fill
+  std::vector<uint32_t> mDigits;                        /// list of calibration digits to fill
+  std::array<float, RingBuffer::kBufferSize> mPairMass; //! inv. mass of the pairs with the buffer entries
+  std::array<float, RingBuffer::kBufferSize> mPairPt2;  //! squared pt of the pairs with the buffer entries
 
   ClassDefNV(PHOSEnergySlot, 1);
 };
@@ -62,6 +62,8 @@ class PHOSTurnonSlot
   std::string mCCDBPath{"http://ccdb-test.cern.ch:8080"}; ///< CCDB server path
   std::bitset<NCHANNELS> mFiredTiles;                     //! Container for bad trigger cells, 1 means bad sell
   std::bitset<NCHANNELS> mNoisyTiles;                     //! Container for bad trigger cells, 1 means bad sell
+  std::vector<short> mTruTiles;                           //! List of trigger cells with TRU signal in event
+  std::vector<short> mFiredList;                          //! List of trigger cells fired by clusters in event
   std::unique_ptr<TurnOnHistos> mTurnOnHistos;            //! Collection of histos to fill
 
   ClassDefNV(PHOSTurnonSlot, 1);
@@ -92,6 +94,8 @@ class PHOSTurnonCalibrator final : public o2::calibration::TimeSlotCalibration<o
   bool mUseCCDB = false;
   long mRunStartTime = 0;                                 /// start time of the run (sec)
   std::string mCCDBPath{"http://ccdb-test.cern.ch:8080"}; /// CCDB path to retrieve current CCDB objects for comparison
+  std::vector<short> mTruTiles;                           //! List of trigger cells with TRU signal in event
+  std::vector<short> mFiredList;                          //! List of trigger cells fired by clusters in event
   std::unique_ptr<TurnOnHistos> mTurnOnHistos;            //! Collection of histos to fill
   std::unique_ptr<TriggerMap> mTriggerMap;
 
@@ -15,9 +15,8 @@
 /// @file   RingBuffer.h
 /// @brief  Device to collect energy and time PHOS energy and time calibration.
 
-#include <TLorentzVector.h>
-#include <TVector3.h>
 #include <array>
+#include <cmath>
 
 namespace o2
 {
@@ -25,13 +24,18 @@ namespace phos
 {
 
 // For real/mixed distribution calculation
+// The photons are stored as arrays of momentum components, so that the pair
+// kinematics of a new photon with all the stored ones is computed in one
+// vectorizable loop, see fillPairs()
 class RingBuffer
 {
  public:
+  static constexpr short kBufferSize = 100; ///< Total size of the buffer
+
   RingBuffer() = default;
   ~RingBuffer() = default;
 
-  short size()
+  short size() const
   {
     if (mFilled) {
       return kBufferSize;
@@ -39,27 +43,37 @@ class RingBuffer
       return mCurrent;
     }
   }
-  void addEntry(TLorentzVector& v)
+  void addEntry(float px, float py, float pz, float e)
   {
-    mBuffer[mCurrent] = v;
+    mPx[mCurrent] = px;
+    mPy[mCurrent] = py;
+    mPz[mCurrent] = pz;
+    mE[mCurrent] = e;
     mCurrent++;
     if (mCurrent >= kBufferSize) {
       mFilled = true;
       mCurrent -= kBufferSize;
     }
   }
-  const TLorentzVector& getEntry(short index) const
+
+  /// \brief Invariant mass and squared transverse momentum of the pairs of a photon with the stored entries
+  /// \param px, py, pz, e  photon momentum
+  /// \param mass, pt2  pair kinematics with the entry of the same index, for indexes below size()
+  void fillPairs(float px, float py, float pz, float e, std::array<float, kBufferSize>& mass, std::array<float, kBufferSize>& pt2) const
   {
-    //get entry from (mCurrent-1) corresponding to index=size()-1 down to size
-    if (mFilled) {
-      index += mCurrent;
+    const short n = size();
+    for (short i = 0; i < n; i++) {
+      const float sx = px + mPx[i], sy = py + mPy[i], sz = pz + mPz[i], se = e + mE[i];
+      const float m2 = se * se - sx * sx - sy * sy - sz * sz;
+      pt2[i] = sx * sx + sy * sy;
+      mass[i] = m2 > 0.f ? std::sqrt(m2) : 0.f;
     }
-    index = index % kBufferSize;
-    return mBuffer[index];
   }
+
   //mark that next added entry will be from next event
   void startNewEvent() { mStartCurrentEvent = mCurrent; }
 
+  /// \param index position in the buffer, as used in fillPairs()
   bool isCurrentEvent(short index) const
   {
     if (mCurrent >= mStartCurrentEvent) {
@@ -70,11 +84,13 @@ class RingBuffer
   }
 
  private:
-  static constexpr short kBufferSize = 100;        ///< Total size of the buffer
-  std::array<TLorentzVector, kBufferSize> mBuffer; ///< buffer
-  bool mFilled = false;                            ///< if buffer fully filled
-  short mCurrent = 0;                              ///< where next object will be added
-  short mStartCurrentEvent = 0;                    ///< start of current event
+  std::array<float, kBufferSize> mPx; ///< photon momenta
+  std::array<float, kBufferSize> mPy;
+  std::array<float, kBufferSize> mPz;
+  std::array<float, kBufferSize> mE;
+  bool mFilled = false;         ///< if buffer fully filled
+  short mCurrent = 0;           ///< where next object will be added
+  short mStartCurrentEvent = 0; ///< start of current event
 };
 } // namespace phos
 } // namespace o2
@@ -21,6 +21,7 @@
 
 #include <bitset>
 #include <array>
+#include <vector>
 #include "TObject.h"
 
 namespace o2
@@ -94,6 +95,24 @@ class TurnOnHistos
     }
   }
 
+  /// \brief Collects entries in good map
+  /// \param tiles list of channels fired in event, each channel at most once
+  void fillFiredMap(const std::vector<short>& tiles)
+  {
+    for (short i : tiles) {
+      mGoodMap[i]++;
+    }
+  }
+
+  /// \brief Collects entries in noisy map
+  /// \param tiles list of noisy channels in event, each channel at most once
+  void fillNoisyMap(const std::vector<short>& tiles)
+  {
+    for (short i : tiles) {
+      mNoisyMap[i]++;
+    }
+  }
+
   //getters now
   const std::array<float, Npt>& getTotSpectrum(short ddl) const { return mTotSp[ddl]; }
   const std::array<float, Npt>& getTrSpectrum(short ddl) const { return mTrSp[ddl]; }
@@ -112,7 +112,7 @@ void PHOSEnergySlot::fillTimeMassHisto(const Cluster& clu, const gsl::span<const
   }
 
   //Real and Mixed inv mass distributions
-  // prepare TLorentsVector
+  // prepare photon momentum
   float posX, posZ;
   clu.getLocalPosition(posX, posZ);
   TVector3 vec3;
@@ -122,33 +122,34 @@ void PHOSEnergySlot::fillTimeMassHisto(const Cluster& clu, const gsl::span<const
   short absId;
   mGeom->relPosToAbsId(clu.module(), posX, posZ, absId);
 
-  vec3 *= 1. / vec3.Mag();
-  TLorentzVector v(vec3.X() * e, vec3.Y() * e, vec3.Z() * e, e);
+  vec3 *= e / vec3.Mag();
+  // pair kinematics with all stored clusters at once
+  mBuffer->fillPairs(vec3.X(), vec3.Y(), vec3.Z(), e, mPairMass, mPairPt2);
+  const float ptMin2 = mPtMin * mPtMin;
   // Fill calibration histograms for all cells, even bad, but partners in inv, mass should be good
   bool isGood = checkCluster(clu);
   for (short ip = mBuffer->size(); ip--;) {
-    const TLorentzVector& vp = mBuffer->getEntry(ip);
-    TLorentzVector sum = v + vp;
+    const float m = mPairMass[ip];
     if (mBuffer->isCurrentEvent(ip)) { //same (real) event
       if (isGood) {
-        mHistos.fill(ETCalibHistos::kReInvMassNonlin, e, sum.M());
+        mHistos.fill(ETCalibHistos::kReInvMassNonlin, e, m);
       }
-      if (sum.Pt() > mPtMin) {
-        mHistos.fill(ETCalibHistos::kReInvMassPerCell, absId, sum.M());
+      if (mPairPt2[ip] > ptMin2) {
+        mHistos.fill(ETCalibHistos::kReInvMassPerCell, absId, m);
       }
     } else { //Mixed
       if (isGood) {
-        mHistos.fill(ETCalibHistos::kMiInvMassNonlin, e, sum.M());
+        mHistos.fill(ETCalibHistos::kMiInvMassNonlin, e, m);
       }
-      if (sum.Pt() > mPtMin) {
-        mHistos.fill(ETCalibHistos::kMiInvMassPerCell, absId, sum.M());
+      if (mPairPt2[ip] > ptMin2) {
+        mHistos.fill(ETCalibHistos::kMiInvMassPerCell, absId, m);
       }
     }
   }
 
   //Add to list ot partners only if cluster is good
   if (isGood) {
-    mBuffer->addEntry(v);
+    mBuffer->addEntry(vec3.X(), vec3.Y(), vec3.Z(), e);
   }
 }
 
@@ -200,7 +201,7 @@ void PHOSEnergyCalibrator::finalizeSlot(Slot& slot)
   //Add histos
   mHistos.merge(c->getCollectedHistos());
   //Add collected Digits
-  auto tmpD = c->getCollectedDigits();
+  auto& tmpD = c->getCollectedDigits();
   //Add to list or write to file directly?
   if (!mFout) { //not open yet?
     LOG(INFO) << "Writing CalibDigits to file " << mdigitsfilename.data();
@@ -103,25 +103,26 @@ void PHOSPedestalCalibDevice::calculatePedestals()
 {
   mPedestals.reset(new Pedestals());
 
+  //Mean of the Y distribution of a cell, summed directly over the bins instead of
+  //creating a projection histogram per cell and per distribution
+  auto meanY = [](const TH2F* h, int ix) {
+    const TAxis* ay = h->GetYaxis();
+    double sw = 0., swy = 0.;
+    for (int iy = ay->GetNbins(); iy > 0; iy--) {
+      double w = h->GetBinContent(ix, iy);
+      sw += w;
+      swy += w * ay->GetBinCenter(iy);
+    }
+    return sw > 0. ? static_cast<float>(swy / sw) : 0.f;
+  };
+
   //Calculate mean of pedestal distributions
   for (unsigned short i = mMeanHG->GetNbinsX(); i > 0; i--) {
-    TH1D* pr = mMeanHG->ProjectionY(Form("proj%d", i), i, i);
-    float a = pr->GetMean();
     short cellId = static_cast<short>(mMeanHG->GetXaxis()->GetBinCenter(i));
-    mPedestals->setHGPedestal(cellId, std::min(255, int(a)));
-    pr->Delete();
-    pr = mMeanLG->ProjectionY(Form("projLG%d", i), i, i);
-    a = pr->GetMean();
-    mPedestals->setLGPedestal(cellId, std::min(255, int(a)));
-    pr->Delete();
-    pr = mRMSHG->ProjectionY(Form("projRMS%d", i), i, i);
-    a = pr->GetMean();
-    mPedestals->setHGRMS(cellId, a);
-    pr->Delete();
-    pr = mRMSLG->ProjectionY(Form("projRMSLG%d", i), i, i);
-    a = pr->GetMean();
-    mPedestals->setLGRMS(cellId, a);
-    pr->Delete();
+    mPedestals->setHGPedestal(cellId, std::min(255, int(meanY(mMeanHG.get(), i))));
+    mPedestals->setLGPedestal(cellId, std::min(255, int(meanY(mMeanLG.get(), i))));
+    mPedestals->setHGRMS(cellId, meanY(mRMSHG.get(), i));
+    mPedestals->setLGRMS(cellId, meanY(mRMSLG.get(), i));
   }
 }
 
@@ -78,6 +78,9 @@ void PHOSRunbyrunSlot::fill(const gsl::span<const Cluster>& clusters, const gsl:
     }
   }
 
+  Geometry* geom = Geometry::GetInstance("Run3");
+  const float ptCut2 = mPtCut * mPtCut;
+  std::array<float, RingBuffer::kBufferSize> mass, pt2;
   for (auto& tr : trs) {
 
     int firstCluInEvent = tr.getFirstEntry();
@@ -92,27 +95,26 @@ void PHOSRunbyrunSlot::fill(const gsl::span<const Cluster>& clusters, const gsl:
       if (!checkCluster(clu)) {
         continue;
       }
-      // prepare TLorentsVector
+      // prepare photon momentum
       float posX, posZ;
       clu.getLocalPosition(posX, posZ);
       TVector3 vec3;
-      Geometry::GetInstance("Run3")->local2Global(clu.module(), posX, posZ, vec3);
+      geom->local2Global(clu.module(), posX, posZ, vec3);
       vec3 -= vertex;
       float e = clu.getEnergy();
-      vec3 *= 1. / vec3.Mag();
-      TLorentzVector v(vec3.X() * e, vec3.Y() * e, vec3.Z() * e, e);
+      vec3 *= e / vec3.Mag();
+      // pair kinematics with all stored clusters at once, then fill the pairs above the pt cut
+      mBuffer->fillPairs(vec3.X(), vec3.Y(), vec3.Z(), e, mass, pt2);
       for (short ip = mBuffer->size(); ip--;) {
-        const TLorentzVector& vp = mBuffer->getEntry(ip);
-        TLorentzVector sum = v + vp;
-        if (sum.Pt() > mPtCut) {
-          if (mBuffer->isCurrentEvent(ip)) {      //same (real) event
-            mReMi[2 * clu.module()](sum.M());     // put all high-pt pairs to bin 4-6 GeV
-          } else {                                //Mixed
-            mReMi[2 * clu.module() + 1](sum.M()); // put all high-pt pairs to bin 4-6 GeV
+        if (pt2[ip] > ptCut2) {
+          if (mBuffer->isCurrentEvent(ip)) {     //same (real) event
+            mReMi[2 * clu.module()](mass[ip]);    // put all high-pt pairs to bin 4-6 GeV
+          } else {                               //Mixed
+            mReMi[2 * clu.module() + 1](mass[ip]); // put all high-pt pairs to bin 4-6 GeV
           }
         }
       }
-      mBuffer->addEntry(v);
+      mBuffer->addEntry(vec3.X(), vec3.Y(), vec3.Z(), e);
     }
   }
 }
@@ -23,6 +23,7 @@
 #include "TGraphAsymmErrors.h"
 
 #include "FairLogger.h"
+#include <algorithm>
 #include <fstream> // std::ifstream
 
 using namespace o2::phos;
@@ -86,19 +87,23 @@ void PHOSTurnonSlot::scanClusters(const gsl::span<const Cell>& cells, const Trig
                                   const gsl::span<const Cluster>& clusters, const TriggerRecord& clutr)
 {
   //First fill map of expected tiles from TRU cells
-  mNoisyTiles.reset();
+  //The tiles set in the event are also kept as lists, so that the maps are
+  //filled and cleared per tile set instead of scanning all channels in each event
   int firstCellInEvent = celltr.getFirstEntry();
   int lastCellInEvent = firstCellInEvent + celltr.getNumberOfObjects();
   for (int i = firstCellInEvent; i < lastCellInEvent; i++) {
     const Cell& c = cells[i];
     if (c.getTRU()) {
-      mNoisyTiles.set(c.getTRUId());
+      short truId = c.getTRUId();
+      if (!mNoisyTiles.test(truId)) {
+        mNoisyTiles.set(truId);
+        mTruTiles.push_back(truId);
+      }
     }
   }
 
   //Copy to have good and noisy map
 
-  mFiredTiles.reset();
   char mod;
   float x, z;
   short ddl;
@@ -114,14 +119,39 @@ void PHOSTurnonSlot::scanClusters(const gsl::span<const Cell>& cells, const Trig
     if (clu.firedTrigger() & 1) { //Bit 1: 2x2, bit 2 4x4  //TODO: do we need separate 2x2 and 4x4 spectra? Switch?
       mTurnOnHistos->fillFiredSp(ddl, clu.getEnergy());
       //Fill trigger map
-      mFiredTiles.set(truId);
+      if (!mFiredTiles.test(truId)) {
+        mFiredTiles.set(truId);
+        mFiredList.push_back(truId);
+      }
     }
     // }
   }
-  //Fill final good and noisy maps
-  mTurnOnHistos->fillFiredMap(mFiredTiles);
-  mNoisyTiles ^= mFiredTiles;
-  mTurnOnHistos->fillNoisyMap(mFiredTiles);
+  //Fill final good and noisy maps: noisy are the tiles either with TRU signal or fired, not both
+  mTurnOnHistos->fillFiredMap(mFiredList);
+  size_t nTru = mTruTiles.size();
+  for (size_t i = 0; i < nTru; i++) {
+    if (mFiredTiles.test(mTruTiles[i])) {
+      mTruTiles[i] = -1;
+    }
+  }
+  for (short truId : mFiredList) {
+    if (!mNoisyTiles.test(truId)) {
+      mTruTiles.push_back(truId);
+    }
+  }
+  mTruTiles.erase(std::remove(mTruTiles.begin(), mTruTiles.end(), -1), mTruTiles.end());
+  mTurnOnHistos->fillNoisyMap(mTruTiles);
+
+  //Clear the tiles of this event
+  for (short truId : mTruTiles) {
+    mNoisyTiles.reset(truId);
+  }
+  for (short truId : mFiredList) {
+    mNoisyTiles.reset(truId);
+    mFiredTiles.reset(truId);
+  }
+  mTruTiles.clear();
+  mFiredList.clear();
 }
 //==============================================
 
@@ -135,9 +165,7 @@ void PHOSTurnonCalibrator::finalizeSlot(Slot& slot)
   PHOSTurnonSlot* c = slot.getContainer();
   LOG(INFO) << "Finalize slot " << slot.getTFStart() << " <= TF <= " << slot.getTFEnd();
   //Add histos
-  for (int mod = 0; mod < 8; mod++) {
-    mTurnOnHistos->merge(c->getCollectedHistos());
-  }
+  mTurnOnHistos->merge(c->getCollectedHistos());
   c->clear();
 }
 PHOSTurnonCalibrator::Slot& PHOSTurnonCalibrator::emplaceNewSlot(bool front, uint64_t tstart, uint64_t tend)
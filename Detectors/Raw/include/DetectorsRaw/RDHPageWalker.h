@@ -0,0 +1,216 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// @brief Header-only helpers to walk over the RDH pages of raw data buffers
+// and to group them per link
+
+#ifndef ALICEO2_RDHPAGEWALKER_H
+#define ALICEO2_RDHPAGEWALKER_H
+
+#include <cstddef>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+#include <gsl/span>
+#include "Framework/CompilerBuiltins.h"
+#include "DetectorsRaw/RDHUtils.h"
+
+namespace o2
+{
+namespace raw
+{
+
+/// Single RDH page of a raw data buffer
+struct RDHPage {
+  const void* rdh = nullptr;       // RDH at the start of the page
+  gsl::span<const char> payload{}; // payload of the page, following the RDH
+  size_t offset = 0;               // offset of the page in the buffer it belongs to
+  const char* raw() const { return reinterpret_cast<const char*>(rdh); }
+};
+
+/// Forward iteration over the RDH pages of a contiguous buffer.
+/// The consistency of each RDH with respect to the buffer is checked before it is provided:
+/// the iteration stops at the first page which is not consistent, which can be queried with isComplete().
+/// While a page is being processed the RDH of the next one is prefetched.
+///
+/// Usage:
+///   RDHPageWalker walker(buffer);
+///   for (const auto& page : walker) {
+///     process(page.rdh, page.payload);
+///   }
+///   if (!walker.isComplete()) {
+///     // corrupted or truncated buffer
+///   }
+class RDHPageWalker
+{
+ public:
+  class Iterator
+  {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = RDHPage;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const RDHPage*;
+    using reference = const RDHPage&;
+
+    Iterator() = default;
+    Iterator(const RDHPageWalker* walker, size_t offset) : mWalker(walker) { load(offset); }
+
+    reference operator*() const { return mPage; }
+    pointer operator->() const { return &mPage; }
+    Iterator& operator++()
+    {
+      load(mPage.offset + RDHUtils::getOffsetToNext(mPage.rdh));
+      return *this;
+    }
+    Iterator operator++(int)
+    {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    bool operator==(const Iterator& other) const { return mPage.rdh == other.mPage.rdh; }
+    bool operator!=(const Iterator& other) const { return mPage.rdh != other.mPage.rdh; }
+
+   private:
+    void load(size_t offset)
+    {
+      mPage = RDHPage{};
+      if (!mWalker->checkPage(offset)) {
+        return;
+      }
+      const char* ptr = mWalker->mBuffer.data() + offset;
+      auto headerSize = RDHUtils::getHeaderSize(ptr);
+      mPage.rdh = ptr;
+      mPage.payload = gsl::span<const char>(ptr + headerSize, RDHUtils::getMemorySize(ptr) - headerSize);
+      mPage.offset = offset;
+      auto next = offset + RDHUtils::getOffsetToNext(ptr);
+      if (next < mWalker->mBuffer.size()) {
+        O2_BUILTIN_PREFETCH(mWalker->mBuffer.data() + next, 0);
+      }
+    }
+
+    const RDHPageWalker* mWalker = nullptr;
+    RDHPage mPage{};
+  };
+
+  RDHPageWalker() = default;
+  RDHPageWalker(gsl::span<const char> buffer) : mBuffer(buffer) {}
+  RDHPageWalker(const void* buffer, size_t size) : mBuffer(reinterpret_cast<const char*>(buffer), size) {}
+
+  Iterator begin() const { return Iterator(this, 0); }
+  Iterator end() const { return Iterator(); }
+
+  /// checks if all the pages of the buffer are consistent
+  bool isComplete() const
+  {
+    size_t offset = 0;
+    while (checkPage(offset)) {
+      offset += RDHUtils::getOffsetToNext(mBuffer.data() + offset);
+    }
+    return offset == mBuffer.size();
+  }
+
+  /// checks if the RDH at offset is consistent with the buffer
+  bool checkPage(size_t offset) const
+  {
+    if (offset >= mBuffer.size() || mBuffer.size() - offset < sizeof(o2::header::RAWDataHeaderV4)) {
+      return false;
+    }
+    const char* ptr = mBuffer.data() + offset;
+    auto version = RDHUtils::getVersion(ptr);
+    if (version < RDHUtils::getVersion<o2::header::RAWDataHeaderV4>() || version > RDHUtils::getVersion<o2::header::RAWDataHeader>()) {
+      return false;
+    }
+    size_t headerSize = RDHUtils::getHeaderSize(ptr);
+    size_t memorySize = RDHUtils::getMemorySize(ptr);
+    size_t offsetToNext = RDHUtils::getOffsetToNext(ptr);
+    return headerSize > 0 && memorySize >= headerSize && offsetToNext >= memorySize && offsetToNext <= mBuffer.size() - offset;
+  }
+
+  gsl::span<const char> getBuffer() const { return mBuffer; }
+
+ private:
+  gsl::span<const char> mBuffer{};
+};
+
+/// Pages of one or more raw data buffers grouped per link, keyed by the link subspecification.
+/// The offsets of the pages are computed once when the buffers are added, the pages of every link
+/// are then provided in the order in which they appear in the buffers.
+/// Since the links are independent, they can be processed in parallel with forEachLink.
+class RDHLinkPages
+{
+ public:
+  struct Link {
+    LinkSubSpec_t subSpec = 0;  // subspecification of the link
+    std::vector<RDHPage> pages; // pages of the link
+  };
+
+  /// adds the pages of the buffer, returns false if the buffer is not fully consistent
+  bool addBuffer(gsl::span<const char> buffer)
+  {
+    RDHPageWalker walker(buffer);
+    size_t end = 0;
+    for (const auto& page : walker) {
+      findOrAddLink(RDHUtils::getSubSpec(page.rdh)).pages.push_back(page);
+      end = page.offset + RDHUtils::getOffsetToNext(page.rdh);
+    }
+    return end == buffer.size();
+  }
+
+  /// clears the pages, the link containers are kept to be reused
+  void clear()
+  {
+    for (size_t ilink = 0; ilink < mNLinks; ++ilink) {
+      mLinks[ilink].pages.clear();
+    }
+    mLinkIndex.clear();
+    mNLinks = 0;
+  }
+
+  size_t getNLinks() const { return mNLinks; }
+  const Link& getLink(size_t ilink) const { return mLinks[ilink]; }
+
+  /// calls func(const Link& link, size_t ilink) for every link, with nThreads threads if OpenMP is enabled
+  template <typename F>
+  void forEachLink(F&& func, int nThreads = 1) const
+  {
+    int nLinks = mNLinks;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads > 0 ? nThreads : 1)
+#endif
+    for (int ilink = 0; ilink < nLinks; ++ilink) {
+      func(mLinks[ilink], size_t(ilink));
+    }
+  }
+
+ private:
+  Link& findOrAddLink(LinkSubSpec_t subSpec)
+  {
+    auto [it, isNew] = mLinkIndex.emplace(subSpec, mNLinks);
+    if (isNew) {
+      if (mNLinks == mLinks.size()) {
+        mLinks.emplace_back();
+      }
+      mLinks[mNLinks++].subSpec = subSpec;
+    }
+    return mLinks[it->second];
+  }
+
+  std::vector<Link> mLinks;                             // links, only the first mNLinks are in use
+  std::unordered_map<LinkSubSpec_t, size_t> mLinkIndex; // index of the links in mLinks
+  size_t mNLinks = 0;                                   // number of links in use
+};
+
+} // namespace raw
+} // namespace o2
+
+#endif // ALICEO2_RDHPAGEWALKER_H
@@ -24,6 +24,9 @@
 #include <string_view>
 #include <functional>
 #include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <deque>
 
 #include <Rtypes.h>
 #include <TTree.h>
@@ -53,6 +56,7 @@ class RawFileWriter
 
   ///=====================================================================================
   /// output file handler with its own lock
+  /// optionally, the data is written by a dedicated thread, while the producers continue filling the links
   struct OutputFile {
     FILE* handler = nullptr;
     std::mutex fileMtx;
@@ -65,7 +69,21 @@ class RawFileWriter
       }
       return *this;
     }
+    ~OutputFile() { stopAsync(); }
     void write(const char* data, size_t size);
+    void startAsync(size_t maxQueued);
+    void stopAsync();
+    void close();
+
+   private:
+    void writeQueued();
+
+    std::thread writerThread;                 //! thread writing the queued buffers, if async
+    std::condition_variable queueCond;        //! signals changes of the queue
+    std::deque<std::vector<char>> queue;      //! buffers to write, in order of submission
+    std::vector<std::vector<char>> freeBufs;  //! written buffers, for reuse
+    size_t maxQueued = 0;                     //! max number of buffers waiting for writing
+    bool stopRequested = false;               //! writer thread should finish after writing the queue
   };
   ///=====================================================================================
   struct PayloadCache {
@@ -173,6 +191,7 @@ class RawFileWriter
   }
   ~RawFileWriter();
   void useCaching();
+  void useAsyncWrite(bool v = true, int maxQueued = 16) { mAsyncWriteQueue = v ? maxQueued : 0; }
   void doLazinessCheck(bool v) { mDoLazinessCheck = v; }
   void writeConfFile(std::string_view origin = "FLP", std::string_view description = "RAWDATA", std::string_view cfgname = "raw.cfg", bool fullPath = true) const;
   void close();
@@ -409,6 +428,7 @@ class RawFileWriter
   bool mUseRDHStop = true;                                                // detector uses STOP in RDH
   bool mCRUDetector = true;                                               // Detector readout via CRU ( RORC if false)
   bool mApplyCarryOverToLastPage = false;                                 // call CarryOver method also for last chunk and overwrite modified trailer
+  int mAsyncWriteQueue = 0;                                               // if > 0, files are written by their own threads, with at most this number of superpages waiting
 
   //>> caching --------------
   bool mCachingStage = false; // signal that current data should be cached
@@ -14,6 +14,7 @@
 /// @brief  Reader for (multiple) raw data files
 
 #include <algorithm>
+#include <cerrno>
 #include <cstring>
 #include <iostream>
 #include <iomanip>
@@ -30,6 +31,7 @@
 #include <Common/Configuration.h>
 #include <TStopwatch.h>
 #include <fcntl.h>
+#include <unistd.h>
 
 using namespace o2::raw;
 namespace o2h = o2::header;
@@ -134,8 +136,7 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
     if (blc.dataCache) {
       memcpy(buff + sz, blc.dataCache.get(), blc.size);
     } else {
-      auto fl = reader->mFiles[blc.fileID];
-      if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + sz, 1, blc.size, fl) != blc.size) {
+      if (!reader->readFileChunk(blc.fileID, blc.offset, blc.size, buff + sz)) {
         LOGF(ERROR, "Failed to read for the %s a bloc:", describe());
         blc.print();
         error = true;
@@ -288,8 +289,7 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
     if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
       memcpy(buff, blocks[nextBlock2Read].dataCache.get(), sz);
     } else {
-      auto fl = reader->mFiles[blocks[nextBlock2Read].fileID];
-      if (fseek(fl, blocks[nextBlock2Read].offset, SEEK_SET) || fread(buff, 1, sz, fl) != sz) {
+      if (!reader->readFileChunk(blocks[nextBlock2Read].fileID, blocks[nextBlock2Read].offset, sz, buff)) {
         LOGF(ERROR, "Failed to read for the %s a bloc:", describe());
         blocks[nextBlock2Read].print();
         error = true;
@@ -560,6 +560,27 @@ int RawFileReader::getLinkLocalID(const RDHAny& rdh, int fileID)
   return entryMap->second;
 }
 
+//_____________________________________________________________________
+bool RawFileReader::readFileChunk(int fileID, size_t offset, size_t size, char* buff) const
+{
+  // positional read of the file chunk: does not touch the shared file position, so that the
+  // data of different links can be read concurrently
+  int fd = fileno(mFiles[fileID]);
+  while (size) {
+    auto nr = pread(fd, buff, size, offset);
+    if (nr <= 0) {
+      if (nr < 0 && errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buff += nr;
+    offset += nr;
+    size -= nr;
+  }
+  return true;
+}
+
 //_____________________________________________________________________
 bool RawFileReader::preprocessFile(int ifl)
 {
@@ -77,6 +77,7 @@ class RawReaderSpecs : public o2f::Task
   size_t mSentSize = 0;
   size_t mSentMessages = 0;
   bool mPartPerSP = true;                                          // fill part per superpage
+  int mNThreads = 1;                                               // number of threads reading the links data
   std::string mRawChannelName = "";                                // name of optional non-DPL channel
   std::unique_ptr<o2::raw::RawFileReader> mReader;                 // matching engine
   std::unordered_map<std::string, std::pair<int, int>> mDropTFMap; // allows to drop certain fraction of TFs
@@ -90,7 +91,7 @@ class RawReaderSpecs : public o2f::Task
 
 //___________________________________________________________
 RawReaderSpecs::RawReaderSpecs(const ReaderInp& rinp)
-  : mLoop(rinp.loop < 0 ? INT_MAX : (rinp.loop < 1 ? 1 : rinp.loop)), mDelayUSec(rinp.delay_us), mMinTFID(rinp.minTF), mMaxTFID(rinp.maxTF), mPartPerSP(rinp.partPerSP), mReader(std::make_unique<o2::raw::RawFileReader>(rinp.inifile, 0, rinp.bufferSize)), mRawChannelName(rinp.rawChannelConfig)
+  : mLoop(rinp.loop < 0 ? INT_MAX : (rinp.loop < 1 ? 1 : rinp.loop)), mDelayUSec(rinp.delay_us), mMinTFID(rinp.minTF), mMaxTFID(rinp.maxTF), mPartPerSP(rinp.partPerSP), mNThreads(std::max(1, rinp.nThreads)), mReader(std::make_unique<o2::raw::RawFileReader>(rinp.inifile, 0, rinp.bufferSize)), mRawChannelName(rinp.rawChannelConfig)
 {
   mReader->setCheckErrors(rinp.errMap);
   mReader->setMaxTFToRead(rinp.maxTF);
@@ -225,6 +226,19 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
   o2::header::Stack dummyStack{o2h::DataHeader{}, o2::framework::DataProcessingHeader{0}}; // dummy stack to just to get stack size
   auto hstackSize = dummyStack.size();
 
+  // links selected for the TF are collected sequentially, then their data is read concurrently
+  // into pre-allocated messages and finally the parts are added in the links order
+  struct LinkTFJob {
+    int il = 0;
+    std::string channel;
+    FairMQTransportFactory* transport = nullptr;
+    o2h::DataHeader hdrTmpl;
+    std::vector<RawFileReader::PartStat> partsSP;
+    std::vector<std::pair<FairMQMessagePtr, FairMQMessagePtr>> messages;
+  };
+  std::vector<LinkTFJob> jobs;
+  jobs.reserve(nlinks);
+
   uint32_t firstOrbit = 0;
   for (int il = 0; il < nlinks; il++) {
     auto& link = mReader->getLink(il);
@@ -246,36 +260,62 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     hdrTmpl.splitPayloadParts = nParts;
     hdrTmpl.tfCounter = mTFCounter;
 
-    const auto fmqChannel = findOutputChannel(hdrTmpl);
+    auto fmqChannel = findOutputChannel(hdrTmpl);
     if (fmqChannel.empty()) { // no output channel
       continue;
     }
+    auto& job = jobs.emplace_back();
+    job.il = il;
+    job.transport = device->GetChannel(fmqChannel, 0).Transport();
+    job.channel = std::move(fmqChannel);
+    job.hdrTmpl = hdrTmpl;
+    if (mPartPerSP) {
+      job.partsSP.swap(partsSP);
+    }
+  }
 
-    auto fmqFactory = device->GetChannel(fmqChannel, 0).Transport();
+  mTimer[TimerIO].Start(false);
+  int nJobs = jobs.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ij = 0; ij < nJobs; ij++) {
+    auto& job = jobs[ij];
+    auto& link = mReader->getLink(job.il);
+    auto& hdrTmpl = job.hdrTmpl;
+    job.messages.reserve(hdrTmpl.splitPayloadParts);
     while (hdrTmpl.splitPayloadIndex < hdrTmpl.splitPayloadParts) {
-      hdrTmpl.payloadSize = mPartPerSP ? partsSP[hdrTmpl.splitPayloadIndex].size : link.getNextHBFSize();
-      auto hdMessage = fmqFactory->CreateMessage(hstackSize, fair::mq::Alignment{64});
-      auto plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
-      mTimer[TimerIO].Start(false);
-      auto bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+      hdrTmpl.payloadSize = mPartPerSP ? job.partsSP[hdrTmpl.splitPayloadIndex].size : link.getNextHBFSize();
+      auto hdMessage = job.transport->CreateMessage(hstackSize, fair::mq::Alignment{64});
+      auto plMessage = job.transport->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
+      auto bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &job.partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
       if (bread != hdrTmpl.payloadSize) {
-        LOG(ERROR) << "Link " << il << " read " << bread << " bytes instead of " << hdrTmpl.payloadSize
+        LOG(ERROR) << "Link " << job.il << " read " << bread << " bytes instead of " << hdrTmpl.payloadSize
                    << " expected in TF=" << mTFCounter << " part=" << hdrTmpl.splitPayloadIndex;
       }
-      mTimer[TimerIO].Stop();
       // check if the RDH to send corresponds to expected orbit
       if (hdrTmpl.splitPayloadIndex == 0) {
         auto ir = o2::raw::RDHUtils::getHeartBeatIR(plMessage->GetData());
         auto tfid = hbfU.getTF(ir);
-        firstOrbit = hdrTmpl.firstTForbit = hbfU.getIRTF(tfid).orbit; // will be picked for the following parts
+        hdrTmpl.firstTForbit = hbfU.getIRTF(tfid).orbit; // will be picked for the following parts
       }
       o2::header::Stack headerStack{hdrTmpl, o2::framework::DataProcessingHeader{mTFCounter}};
       memcpy(hdMessage->GetData(), headerStack.data(), headerStack.size());
       hdrTmpl.splitPayloadIndex++; // prepare for next
+      job.messages.emplace_back(std::move(hdMessage), std::move(plMessage));
+    }
+  }
+  mTimer[TimerIO].Stop();
 
-      addPart(std::move(hdMessage), std::move(plMessage), fmqChannel);
+  for (auto& job : jobs) {
+    const auto& link = mReader->getLink(job.il);
+    if (!job.messages.empty()) {
+      firstOrbit = job.hdrTmpl.firstTForbit;
+    }
+    for (auto& msg : job.messages) {
+      addPart(std::move(msg.first), std::move(msg.second), job.channel);
     }
-    LOGF(DEBUG, "Added %d parts for TF#%d(%d in iteration %d) of %s/%s/0x%u", hdrTmpl.splitPayloadParts, mTFCounter, tfID,
+    LOGF(DEBUG, "Added %d parts for TF#%d(%d in iteration %d) of %s/%s/0x%u", job.hdrTmpl.splitPayloadParts, mTFCounter, tfID,
          mLoopsDone, link.origin.as<std::string>(), link.description.as<std::string>(), link.subspec);
   }
 
@@ -18,6 +18,7 @@
 #include <sstream>
 #include <functional>
 #include <cassert>
+#include <algorithm>
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsRaw/RawFileWriter.h"
 #include "DetectorsRaw/HBFUtils.h"
@@ -65,8 +66,7 @@ void RawFileWriter::close()
   // close all files
   for (auto& flh : mFName2File) {
     LOG(INFO) << "Closing output file " << flh.first;
-    fclose(flh.second.handler);
-    flh.second.handler = nullptr;
+    flh.second.close();
   }
   mFName2File.clear();
   if (mDetLazyCheck.completeCount) {
@@ -145,6 +145,9 @@ RawFileWriter::LinkData& RawFileWriter::registerLink(uint16_t fee, uint16_t cru,
       LOG(ERROR) << "Failed to open output file " << outFileName;
       throw std::runtime_error(std::string("cannot open link output file ") + outFileName);
     }
+    if (mAsyncWriteQueue > 0) {
+      file.startAsync(mAsyncWriteQueue);
+    }
   }
   if (!linkData.fileName.empty()) { // this link was already declared and associated with a file
     if (linkData.fileName == outFileName) {
@@ -692,9 +695,82 @@ size_t RawFileWriter::LinkData::pushBack(const char* ptr, size_t sz, bool keepLa
 
 //____________________________________________
 void RawFileWriter::OutputFile::write(const char* data, size_t sz)
+{
+  std::unique_lock<std::mutex> lock(fileMtx);
+  if (!writerThread.joinable()) {
+    fwrite(data, 1, sz, handler); // flush to file
+    return;
+  }
+  // wait for a free slot in the queue, the copy is done w/o holding the lock
+  queueCond.wait(lock, [this]() { return queue.size() < maxQueued; });
+  std::vector<char> buf;
+  if (!freeBufs.empty()) {
+    buf.swap(freeBufs.back());
+    freeBufs.pop_back();
+  }
+  lock.unlock();
+  buf.assign(data, data + sz);
+  lock.lock();
+  queue.push_back(std::move(buf));
+  queueCond.notify_all();
+}
+
+//____________________________________________
+void RawFileWriter::OutputFile::startAsync(size_t maxq)
 {
   std::lock_guard<std::mutex> lock(fileMtx);
-  fwrite(data, 1, sz, handler); // flush to file
+  if (writerThread.joinable()) {
+    return;
+  }
+  maxQueued = std::max(maxq, size_t(1));
+  stopRequested = false;
+  writerThread = std::thread(&OutputFile::writeQueued, this);
+}
+
+//____________________________________________
+void RawFileWriter::OutputFile::writeQueued()
+{
+  // write the queued buffers in the order of submission until stop is requested and the queue is empty
+  std::unique_lock<std::mutex> lock(fileMtx);
+  while (true) {
+    queueCond.wait(lock, [this]() { return !queue.empty() || stopRequested; });
+    if (queue.empty()) {
+      break;
+    }
+    auto buf = std::move(queue.front());
+    queue.pop_front();
+    lock.unlock();
+    fwrite(buf.data(), 1, buf.size(), handler);
+    lock.lock();
+    freeBufs.push_back(std::move(buf));
+    queueCond.notify_all();
+  }
+}
+
+//____________________________________________
+void RawFileWriter::OutputFile::stopAsync()
+{
+  // write the pending data and stop the writer thread
+  if (!writerThread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(fileMtx);
+    stopRequested = true;
+  }
+  queueCond.notify_all();
+  writerThread.join();
+  freeBufs.clear();
+}
+
+//____________________________________________
+void RawFileWriter::OutputFile::close()
+{
+  stopAsync();
+  if (handler) {
+    fclose(handler);
+    handler = nullptr;
+  }
 }
 
 //____________________________________________
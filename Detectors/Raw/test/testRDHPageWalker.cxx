@@ -0,0 +1,115 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test RDHPageWalker class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <cstring>
+#include <iterator>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "DetectorsRaw/RDHPageWalker.h"
+#include "DetectorsRaw/RDHUtils.h"
+#include "Headers/RAWDataHeader.h"
+
+// @brief test of the RDH pages iteration and grouping per link
+
+namespace o2
+{
+namespace raw
+{
+using RDH = o2::header::RAWDataHeaderV6;
+
+// append a page with the given payload size and padding, the payload is filled with the page number
+void addPage(std::vector<char>& buffer, uint16_t feeId, int payloadSize, int padding, int pageCnt)
+{
+  RDH rdh;
+  RDHUtils::setFEEID(rdh, feeId);
+  RDHUtils::setMemorySize(rdh, sizeof(RDH) + payloadSize);
+  RDHUtils::setOffsetToNext(rdh, sizeof(RDH) + payloadSize + padding);
+  RDHUtils::setPageCounter(rdh, pageCnt);
+  auto pos = buffer.size();
+  buffer.resize(pos + sizeof(RDH) + payloadSize + padding, char(pageCnt));
+  std::memcpy(buffer.data() + pos, &rdh, sizeof(RDH));
+}
+
+BOOST_AUTO_TEST_CASE(RDHPageWalker_iteration)
+{
+  std::vector<char> buffer;
+  std::vector<int> payloadSizes{128, 0, 8128, 64, 16};
+  for (int ip = 0; ip < payloadSizes.size(); ip++) {
+    addPage(buffer, 0x10 + ip % 2, payloadSizes[ip], ip == 1 ? 0 : 32, ip);
+  }
+
+  RDHPageWalker walker(buffer);
+  BOOST_CHECK(walker.isComplete());
+  int ip = 0;
+  size_t offset = 0;
+  for (const auto& page : walker) {
+    BOOST_REQUIRE(ip < payloadSizes.size());
+    BOOST_CHECK(page.offset == offset);
+    BOOST_CHECK(page.raw() == buffer.data() + offset);
+    BOOST_CHECK(RDHUtils::getPageCounter(page.rdh) == ip);
+    BOOST_CHECK(page.payload.size() == payloadSizes[ip]);
+    for (auto c : page.payload) {
+      BOOST_CHECK(c == char(ip));
+    }
+    offset += RDHUtils::getOffsetToNext(page.rdh);
+    ip++;
+  }
+  BOOST_CHECK(ip == payloadSizes.size());
+
+  // truncated buffer: the last page is not provided
+  RDHPageWalker truncated(gsl::span<const char>(buffer.data(), buffer.size() - 1));
+  BOOST_CHECK(!truncated.isComplete());
+  BOOST_CHECK(std::distance(truncated.begin(), truncated.end()) == payloadSizes.size() - 1);
+
+  // empty buffer
+  RDHPageWalker empty(gsl::span<const char>(buffer.data(), 0));
+  BOOST_CHECK(empty.isComplete());
+  BOOST_CHECK(empty.begin() == empty.end());
+}
+
+BOOST_AUTO_TEST_CASE(RDHPageWalker_links)
+{
+  std::vector<char> buffer1, buffer2;
+  for (int ip = 0; ip < 6; ip++) {
+    addPage(buffer1, 0x20 + ip % 3, 64, 0, ip);
+  }
+  for (int ip = 6; ip < 8; ip++) {
+    addPage(buffer2, 0x21, 64, 0, ip);
+  }
+
+  RDHLinkPages linkPages;
+  for (int iter = 0; iter < 2; iter++) { // the second iteration checks the reuse after clear
+    linkPages.clear();
+    BOOST_CHECK(linkPages.addBuffer(buffer1));
+    BOOST_CHECK(linkPages.addBuffer(buffer2));
+    BOOST_REQUIRE(linkPages.getNLinks() == 3);
+    std::vector<std::vector<int>> expected{{0, 3}, {1, 4, 6, 7}, {2, 5}};
+    std::vector<std::vector<int>> found(linkPages.getNLinks());
+    linkPages.forEachLink([&found](const RDHLinkPages::Link& link, size_t ilink) {
+      for (const auto& page : link.pages) {
+        BOOST_CHECK(RDHUtils::getSubSpec(page.rdh) == link.subSpec);
+        found[ilink].push_back(RDHUtils::getPageCounter(page.rdh));
+      }
+    });
+    for (size_t ilink = 0; ilink < linkPages.getNLinks(); ilink++) {
+      BOOST_CHECK(linkPages.getLink(ilink).subSpec == 0x20 + ilink);
+      BOOST_CHECK(found[ilink] == expected[ilink]);
+    }
+  }
+
+  BOOST_CHECK(!linkPages.addBuffer(gsl::span<const char>(buffer1.data(), buffer1.size() - 1)));
+}
+
+} // namespace raw
+} // namespace o2
@@ -86,6 +86,7 @@ class Geo
 
   static constexpr int NCHANNELS = NSTRIPS * NPADS;
   static constexpr int N_ELECTRONIC_CHANNELS = 72 << 12;
+  static constexpr int N_ELECTRONIC_CHANNELS_X_SECTOR = N_ELECTRONIC_CHANNELS / NSECTORS; // 4 crates per sector
 
   static constexpr Float_t MAXHZTOF = 370.6;      // Max half z-size of TOF (cm)
   static constexpr Float_t ZLENA = MAXHZTOF * 2.; // length (cm) of the A module
@@ -277,8 +278,18 @@ class Geo
   static Int_t getTDCFromECH(int ech) { return (ech % 128) >> 3; }
   static Int_t getTDCChFromECH(int ech) { return (ech % 8); }
   static Int_t getECHFromIndexes(int crate, int trm, int chain, int tdc, int chan) { return (crate << 12) + ((trm - 3) << 8) + (chain << 7) + (tdc << 3) + chan; }
-  static Int_t getECHFromCH(int chan) { return CHAN_TO_ELCHAN[chan]; }
-  static Int_t getCHFromECH(int echan) { return ELCHAN_TO_CHAN[echan]; }
+  // the mapping is the same in every sector, the maps hold one sector only
+  static Int_t getECHFromCH(int chan)
+  {
+    int sector = chan / NPADSXSECTOR;
+    return CHAN_TO_ELCHAN[chan - sector * NPADSXSECTOR] + sector * N_ELECTRONIC_CHANNELS_X_SECTOR;
+  }
+  static Int_t getCHFromECH(int echan)
+  {
+    int sector = echan / N_ELECTRONIC_CHANNELS_X_SECTOR;
+    int chan = ELCHAN_TO_CHAN[echan - sector * N_ELECTRONIC_CHANNELS_X_SECTOR];
+    return chan < 0 ? -1 : chan + sector * NPADSXSECTOR;
+  }
 
   static void Init();
 
@@ -299,8 +310,8 @@ class Geo
   // cable length map
   static constexpr Float_t CABLEPROPAGATIONDELAY = 0.0513;           // Propagation delay [ns/cm]
   static const Float_t CABLELENGTH[kNCrate][10][kNChain][kNTdc / 3]; // not constexpr as we initialize it in CableLength.cxx at run time
-  static const Int_t CHAN_TO_ELCHAN[NCHANNELS];
-  static const Int_t ELCHAN_TO_CHAN[N_ELECTRONIC_CHANNELS];
+  static const Short_t CHAN_TO_ELCHAN[NPADSXSECTOR];                   // electronic index of the channels of sector 0
+  static const Short_t ELCHAN_TO_CHAN[N_ELECTRONIC_CHANNELS_X_SECTOR]; // channel index of the electronic channels of sector 0, -1 if not connected
 
   ClassDefNV(Geo, 1);
 };
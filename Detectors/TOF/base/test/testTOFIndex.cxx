@@ -93,3 +93,22 @@ BOOST_AUTO_TEST_CASE(testTOFIndex)
   }
   BOOST_TEST_CHECKPOINT("Ending");
 }
+
+BOOST_AUTO_TEST_CASE(testTOFElectronicIndex)
+{
+  // every channel is connected to one electronic channel and back
+  for (Int_t chan = 0; chan < Geo::NCHANNELS; chan++) {
+    Int_t echan = Geo::getECHFromCH(chan);
+    BOOST_REQUIRE(echan >= 0 && echan < Geo::N_ELECTRONIC_CHANNELS);
+    BOOST_REQUIRE(Geo::getCHFromECH(echan) == chan);
+  }
+  Int_t nConnected = 0;
+  for (Int_t echan = 0; echan < Geo::N_ELECTRONIC_CHANNELS; echan++) {
+    Int_t chan = Geo::getCHFromECH(echan);
+    if (chan >= 0) {
+      BOOST_REQUIRE(Geo::getECHFromCH(chan) == echan);
+      nConnected++;
+    }
+  }
+  BOOST_CHECK(nConnected == Geo::NCHANNELS);
+}
@@ -48,6 +48,8 @@ struct LHCClockDataHisto {
   void print() const;
   void fill(const gsl::span<const o2::dataformats::CalibInfoTOF> data);
   void merge(const LHCClockDataHisto* prev);
+  // empty histogram with the same binning, for the parallel filling
+  std::unique_ptr<LHCClockDataHisto> createSubContainer() const { return std::make_unique<LHCClockDataHisto>(nbins, range); }
 
   ClassDefNV(LHCClockDataHisto, 1);
 };
@@ -64,7 +66,7 @@ class LHCClockCalibrator final : public o2::calibration::TimeSlotCalibration<o2:
 
  public:
   LHCClockCalibrator(int minEnt = 500, int nb = 1000, float r = 24400, const std::string path = "http://ccdb-test.cern.ch:8080") : mMinEntries(minEnt), mNBins(nb), mRange(r) { mCalibTOFapi.setURL(path); }
-  ~LHCClockCalibrator() final = default;
+  ~LHCClockCalibrator() final { waitForFinalizations(); }
   bool hasEnoughData(const Slot& slot) const final { return slot.getContainer()->entries >= mMinEntries; }
   void initOutput() final;
   void finalizeSlot(Slot& slot) final;
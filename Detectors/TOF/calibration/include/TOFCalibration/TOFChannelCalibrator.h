@@ -21,6 +21,7 @@
 #include "CCDB/CcdbObjectInfo.h"
 #include "TOFCalibration/CalibTOFapi.h"
 
+#include <algorithm>
 #include <array>
 #include <boost/histogram.hpp>
 
@@ -51,6 +52,14 @@ class TOFChannelData
  public:
   static constexpr int NCOMBINSTRIP = o2::tof::Geo::NPADX + o2::tof::Geo::NPADS;
 
+  /// result of the gaussian fit of the t-texp distribution of one channel (or pair)
+  struct ChannelFit {
+    float mean = 0.;
+    float sigma = 0.;
+    float fractionUnderPeak = 0.; // fraction of the entries within 5 sigma of the mean
+    bool valid = false;
+  };
+
   TOFChannelData()
   {
     LOG(INFO) << "Default c-tor, not to be used";
@@ -84,6 +93,8 @@ class TOFChannelData
   float integral(int ch, int binxmin, int binxmax) const;
   float integral(int ch) const;
   bool hasEnoughData(int minEntries) const;
+  void getHistoValues(int ich, std::vector<float>& values) const;
+  void fitChannels(int minEntries, int nThreads, std::vector<ChannelFit>& fits) const;
 
   float getRange() const { return mRange; }
   void setRange(float r) { mRange = r; }
@@ -96,7 +107,7 @@ class TOFChannelData
   //const boostHisto getHisto() const { return &mHisto[0]; }
   // boostHisto* getHisto(int isect) const { return &mHisto[isect]; }
 
-  std::vector<int> getEntriesPerChannel() const { return mEntries; }
+  const std::vector<int>& getEntriesPerChannel() const { return mEntries; }
 
  private:
   float mRange = o2::tof::Geo::BC_TIME_INPS * 0.5;
@@ -194,6 +205,10 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
 
     float xp[NCOMBINSTRIP], exp[NCOMBINSTRIP], deltat[NCOMBINSTRIP], edeltat[NCOMBINSTRIP], fracUnderPeak[Geo::NPADS];
 
+    // the pairs are fitted all together in parallel, the strip offsets afterwards
+    std::vector<TOFChannelData::ChannelFit> fits;
+    c->fitChannels(mMinEntries, mNThreads, fits);
+
     for (int sector = 0; sector < Geo::NSECTORS; sector++) {
       int offsetsector = sector * Geo::NSTRIPXSECTOR * Geo::NPADS;
       for (int istrip = 0; istrip < Geo::NSTRIPXSECTOR; istrip++) {
@@ -203,80 +218,25 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
         memset(&fracUnderPeak[0], 0, sizeof(fracUnderPeak));
 
         for (int ipair = 0; ipair < NCOMBINSTRIP; ipair++) {
-          int chinsector = ipair + istrip * NCOMBINSTRIP;
-          int ich = chinsector + sector * Geo::NSTRIPXSECTOR * NCOMBINSTRIP;
-          auto entriesInPair = c->integral(ich);
-          if (entriesInPair < mMinEntries && entriesInPair != 0) {
-            LOG(DEBUG) << "pair " << ich << " will not be calibrated since it has only " << entriesInPair << " entries (min = " << mMinEntries << ")";
-            continue;
-          }
-          // make the slice of the 2D histogram so that we have the 1D of the current channel
-          std::vector<float> fitValues;
-          std::vector<float> histoValues;
-          std::vector<int> entriesPerChannel = c->getEntriesPerChannel();
-          if (entriesPerChannel.at(ich) == 0) {
-            continue; // skip always since a channel with 0 entries is normal, it will be flagged as problematic
-            if (mTest) {
-              LOG(INFO) << "Skipping channel " << ich << " because it has zero entries, but it should not be"; // should become error!
-              continue;
-            } else {
-              throw std::runtime_error("We found one channel with no entries, we cannot calibrate!");
-            }
-          }
-
-          // more efficient way
-          auto histo = c->getHisto(sector);
-          for (unsigned j = chinsector; j <= chinsector; ++j) {
-            for (unsigned i = 0; i < c->getNbins(); ++i) {
-              const auto& v = histo.at(i, j);
-              LOG(DEBUG) << "channel = " << ich << ", in sector = " << sector << " (where it is channel = " << chinsector << ") bin = " << i << " value = " << v;
-              histoValues.push_back(v);
-            }
-          }
-
-          double fitres = fitGaus(c->getNbins(), histoValues.data(), -(c->getRange()), c->getRange(), fitValues);
-
-          if (fitres >= 0) {
-            LOG(DEBUG) << "Pair " << ich << " :: Fit result " << fitres << " Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
-          } else {
-            //LOG(INFO) << "Pair " << ich << " :: Fit failed with result = " << fitres;
+          int ich = ipair + istrip * NCOMBINSTRIP + sector * Geo::NSTRIPXSECTOR * NCOMBINSTRIP;
+          const auto& fit = fits[ich];
+          if (!fit.valid) {
             continue;
           }
 
-          if (fitValues[2] < 0) {
-            fitValues[2] = -fitValues[2];
-          }
-
-          float intmin = fitValues[1] - 5 * fitValues[2]; // mean - 5*sigma
-          float intmax = fitValues[1] + 5 * fitValues[2]; // mean + 5*sigma
-
-          if (intmin < -mRange) {
-            intmin = -mRange;
-          }
-          if (intmax < -mRange) {
-            intmax = -mRange;
-          }
-          if (intmin > mRange) {
-            intmin = mRange;
-          }
-          if (intmax > mRange) {
-            intmax = mRange;
-          }
-
-          xp[goodpoints] = ipair + 0.5;      // pair index
-          exp[goodpoints] = 0.0;             // error on pair index (dummy since it is on the pair index)
-          deltat[goodpoints] = fitValues[1]; // delta between offsets from channels in pair (from the fit) - in ps
-          edeltat[goodpoints] = 20;          // TODO: for now put by default to 20 ps since it was seen to be reasonable; but it should come from the fit: who gives us the error from the fit ??????
+          xp[goodpoints] = ipair + 0.5;  // pair index
+          exp[goodpoints] = 0.0;         // error on pair index (dummy since it is on the pair index)
+          deltat[goodpoints] = fit.mean; // delta between offsets from channels in pair (from the fit) - in ps
+          edeltat[goodpoints] = 20;      // TODO: for now put by default to 20 ps since it was seen to be reasonable; but it should come from the fit: who gives us the error from the fit ??????
           goodpoints++;
           int ch1 = ipair % 96;
           int ch2 = ipair / 96 ? ch1 + 48 : ch1 + 1;
-          float fractionUnderPeak = entriesInPair > 0 ? c->integral(ich, intmin, intmax) / entriesInPair : 0;
           // we keep as fractionUnderPeak of the channel the largest one that is found in the 3 possible pairs with that channel (for both channels ch1 and ch2 in the pair)
-          if (fracUnderPeak[ch1] < fractionUnderPeak) {
-            fracUnderPeak[ch1] = fractionUnderPeak;
+          if (fracUnderPeak[ch1] < fit.fractionUnderPeak) {
+            fracUnderPeak[ch1] = fit.fractionUnderPeak;
           }
-          if (fracUnderPeak[ch2] < fractionUnderPeak) {
-            fracUnderPeak[ch2] = fractionUnderPeak;
+          if (fracUnderPeak[ch2] < fit.fractionUnderPeak) {
+            fracUnderPeak[ch2] = fit.fractionUnderPeak;
           }
         } // end loop pairs
 
@@ -316,73 +276,18 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
     std::map<std::string, std::string> md;
     TimeSlewing& ts = mCalibTOFapi->getSlewParamObj(); // we take the current CCDB object, since we want to simply update the offset
 
-    for (int ich = 0; ich < Geo::NCHANNELS; ich++) {
-      // make the slice of the 2D histogram so that we have the 1D of the current channel
-      int sector = ich / Geo::NPADSXSECTOR;
-      int chinsector = ich % Geo::NPADSXSECTOR;
-      auto entriesInChannel = c->integral(ich);
-      if (entriesInChannel < mMinEntries) {
-        LOG(DEBUG) << "channel " << ich << " will not be calibrated since it has only " << entriesInChannel << " entries (min = " << mMinEntries << ")";
-        continue;
-      }
-      std::vector<float> fitValues;
-      std::vector<float> histoValues;
-      std::vector<int> entriesPerChannel = c->getEntriesPerChannel();
-      if (entriesPerChannel.at(ich) == 0) {
-        continue; // skip always since a channel with 0 entries is normal, it will be flagged as problematic
-        if (mTest) {
-          LOG(DEBUG) << "Skipping channel " << ich << " because it has zero entries, but it should not be"; // should become error!
-          continue;
-        } else {
-          throw std::runtime_error("We found one channel with no entries, we cannot calibrate!");
-        }
-      }
-
-      // more efficient way
-      auto histo = c->getHisto(sector);
-      for (unsigned j = chinsector; j <= chinsector; ++j) {
-        for (unsigned i = 0; i < c->getNbins(); ++i) {
-          const auto& v = histo.at(i, j);
-          LOG(DEBUG) << "channel = " << ich << ", in sector = " << sector << " (where it is channel = " << chinsector << ") bin = " << i << " value = " << v;
-          histoValues.push_back(v);
-        }
-      }
-
-      double fitres = fitGaus(c->getNbins(), histoValues.data(), -(c->getRange()), c->getRange(), fitValues);
+    std::vector<TOFChannelData::ChannelFit> fits;
+    c->fitChannels(mMinEntries, mNThreads, fits);
 
-      if (fitres >= 0) {
-        LOG(DEBUG) << "Channel " << ich << " :: Fit result " << fitres << " Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
-      } else {
-        //        LOG(INFO) << "Channel " << ich << " :: Fit failed with result = " << fitres;
+    for (int ich = 0; ich < Geo::NCHANNELS; ich++) {
+      const auto& fit = fits[ich];
+      if (!fit.valid) {
         continue;
       }
-
-      if (fitValues[2] < 0) {
-        fitValues[2] = -fitValues[2];
-      }
-
-      float fractionUnderPeak;
-      float intmin = fitValues[1] - 5 * fitValues[2]; // mean - 5*sigma
-      float intmax = fitValues[1] + 5 * fitValues[2]; // mean + 5*sigma
-
-      if (intmin < -mRange) {
-        intmin = -mRange;
-      }
-      if (intmax < -mRange) {
-        intmax = -mRange;
-      }
-      if (intmin > mRange) {
-        intmin = mRange;
-      }
-      if (intmax > mRange) {
-        intmax = mRange;
-      }
-
-      fractionUnderPeak = entriesInChannel > 0 ? c->integral(ich, intmin, intmax) / entriesInChannel : 0;
       // now we need to store the results in the TimeSlewingObject
-      ts.setFractionUnderPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, fractionUnderPeak);
-      ts.setSigmaPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, abs(fitValues[2]));
-      ts.updateOffsetInfo(ich, fitValues[1]);
+      ts.setFractionUnderPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, fit.fractionUnderPeak);
+      ts.setSigmaPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, fit.sigma);
+      ts.updateOffsetInfo(ich, fit.mean);
     }
     auto clName = o2::utils::MemFileHelper::getClassName(ts);
     auto flName = o2::ccdb::CcdbApi::generateFileName(clName);
@@ -415,6 +320,9 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
   void setDoCalibWithCosmics(bool doCalibWithCosmics = true) { mCalibWithCosmics = doCalibWithCosmics; }
   bool doCalibWithCosmics() const { return mCalibWithCosmics; }
 
+  void setNThreads(int n) { mNThreads = std::max(1, n); }
+  int getNThreads() const { return mNThreads; }
+
  private:
   int mMinEntries = 0; // min number of entries to calibrate the TimeSlot
   int mNBins = 0;      // bins of the histogram with the t-text per channel
@@ -435,6 +343,8 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
 
   bool mCalibWithCosmics = false; // flag to indicate whether we are calibrating with cosmics
 
+  int mNThreads = 1; // number of threads fitting the channels
+
   ClassDefOverride(TOFChannelCalibrator, 1);
 };
 
@@ -20,6 +20,7 @@
 #include "Framework/Logger.h"
 #include "DetectorsDCS/DataPointCompositeObject.h"
 #include "DetectorsDCS/DataPointIdentifier.h"
+#include "DetectorsDCS/DataPointStore.h"
 #include "DetectorsDCS/DataPointValue.h"
 #include "DetectorsDCS/DeliveryType.h"
 #include "CCDB/CcdbObjectInfo.h"
@@ -116,16 +117,20 @@ class TOFDCSProcessor
 
   void clearDPsinfo()
   {
-    mDpsdoublesmap.clear();
+    for (auto& dvect : mDpsdoubles) {
+      dvect.clear();
+    }
+    mStore.clearValues();
     mTOFDCS.clear();
   }
 
  private:
-  std::unordered_map<DPID, TOFDCSinfo> mTOFDCS;                // this is the object that will go to the CCDB
-  std::unordered_map<DPID, bool> mPids;                        // contains all PIDs for the processor, the bool
-                                                               // will be true if the DP was processed at least once
-  std::unordered_map<DPID, std::vector<DPVAL>> mDpsdoublesmap; // this is the map that will hold the DPs for the
-                                                               // double type (voltages and currents)
+  int processDP(const DPCOM& dpcom, int index);
+
+  std::unordered_map<DPID, TOFDCSinfo> mTOFDCS; // this is the object that will go to the CCDB
+  o2::dcs::DataPointStore mStore;               // contains all PIDs for the processor, with their index
+  std::vector<std::vector<DPVAL>> mDpsdoubles;  // this holds the DPs for the double type (voltages and currents),
+                                                // per index of the PID in mStore
 
   std::array<std::array<TOFFEACinfo, NFEACS>, NDDLS> mFeacInfo;                       // contains the strip/pad info per FEAC
   std::array<std::bitset<8>, NDDLS> mPrevFEACstatus;                                  // previous FEAC status
@@ -11,11 +11,17 @@
 
 #include "TOFCalibration/TOFChannelCalibrator.h"
 #include "Framework/Logger.h"
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 #include <iostream>
 #include <sstream>
 #include <TStopwatch.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace tof
@@ -163,6 +169,95 @@ bool TOFChannelData::hasEnoughData(int minEntries) const
   return enough;
 }
 
+//_____________________________________________
+void TOFChannelData::getHistoValues(int ich, std::vector<float>& values) const
+{
+  // make the slice of the 2D histogram so that we have the 1D of the channel (or pair) "ich"
+
+  const auto& histo = mHisto[ich / mNElsPerSector];
+  int chinsector = ich % mNElsPerSector;
+  values.resize(mNBins);
+  for (int i = 0; i < mNBins; ++i) {
+    values[i] = histo.at(i, chinsector);
+  }
+}
+
+//_____________________________________________
+void TOFChannelData::fitChannels(int minEntries, int nThreads, std::vector<ChannelFit>& fits) const
+{
+  // fit with a gaussian the t-texp distribution of all channels (or pairs) with at least "minEntries" entries;
+  // channels with zero entries are normal (they will be flagged as problematic), so they are skipped.
+  // The fits are done in parallel with the analytic log-normal fit, the channels for which it does
+  // not converge are then fitted again, one at a time, with the (not thread safe) fit using ROOT
+
+  int nElements = Geo::NSECTORS * mNElsPerSector;
+  fits.clear();
+  fits.resize(nElements);
+  std::vector<char> toRefit(nElements, false);
+
+  // store the fit results, together with the fraction of entries in [mean - 5*sigma, mean + 5*sigma]
+  auto storeFit = [this](ChannelFit& fit, const std::vector<float>& values, float entries, float mean, float sigma) {
+    fit.mean = mean;
+    fit.sigma = std::abs(sigma);
+    float intmin = std::clamp(fit.mean - 5 * fit.sigma, -mRange, mRange);
+    float intmax = std::clamp(fit.mean + 5 * fit.sigma, -mRange, mRange);
+    int binxmax = std::min(findBin(intmax), mNBins - 1);
+    float underPeak = 0;
+    for (int i = std::max(findBin(intmin), 0); i <= binxmax; ++i) {
+      underPeak += values[i];
+    }
+    fit.fractionUnderPeak = underPeak / entries;
+    fit.valid = true;
+  };
+
+#ifndef WITH_OPENMP
+  if (nThreads > 1) {
+    LOG(WARNING) << "TOFChannelData compiled without OpenMP support, fitting with 1 thread";
+  }
+#endif
+
+  std::vector<float> histoValues;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(nThreads) firstprivate(histoValues)
+#endif
+  for (int ich = 0; ich < nElements; ich++) {
+    if (mEntries[ich] == 0) {
+      continue;
+    }
+    getHistoValues(ich, histoValues);
+    float entriesInChannel = std::accumulate(histoValues.begin(), histoValues.end(), 0.f);
+    if (entriesInChannel < minEntries) {
+      LOG(DEBUG) << "element " << ich << " will not be calibrated since it has only " << entriesInChannel << " entries (min = " << minEntries << ")";
+      continue;
+    }
+    std::array<double, 3> fitValues;
+    double fitres = o2::math_utils::fitGaus(mNBins, histoValues.data(), -mRange, mRange, fitValues);
+    if (fitres < 0) {
+      toRefit[ich] = true;
+      continue;
+    }
+    LOG(DEBUG) << "Element " << ich << " :: Fit result " << fitres << " Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
+    storeFit(fits[ich], histoValues, entriesInChannel, fitValues[1], fitValues[2]);
+  }
+
+  int nRefits = 0, nFailed = 0;
+  std::vector<float> fitValues;
+  for (int ich = 0; ich < nElements; ich++) {
+    if (!toRefit[ich]) {
+      continue;
+    }
+    nRefits++;
+    getHistoValues(ich, histoValues);
+    double fitres = fitGaus(mNBins, histoValues.data(), -mRange, mRange, fitValues);
+    if (fitres < 0) {
+      nFailed++;
+      continue;
+    }
+    storeFit(fits[ich], histoValues, std::accumulate(histoValues.begin(), histoValues.end(), 0.f), fitValues[1], fitValues[2]);
+  }
+  LOG(INFO) << "Fitted " << nElements << " elements with " << nThreads << " threads, " << nRefits << " fitted again with ROOT, " << nFailed << " failed";
+}
+
 //_____________________________________________
 void TOFChannelData::print() const
 {
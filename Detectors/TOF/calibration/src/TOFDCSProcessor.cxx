@@ -42,8 +42,10 @@ void TOFDCSProcessor::init(const std::vector<DPID>& pids)
   // fill the array of the DPIDs that will be used by TOF
   // pids should be provided by CCDB
 
+  mStore.init(pids);
+  mDpsdoubles.clear();
+  mDpsdoubles.resize(mStore.size());
   for (const auto& it : pids) {
-    mPids[it] = false;
     mTOFDCS[it].makeEmpty();
   }
 
@@ -69,32 +71,20 @@ int TOFDCSProcessor::process(const gsl::span<const DPCOM> dps)
     mStartTFset = true;
   }
 
-  std::unordered_map<DPID, DPVAL> mapin;
-  for (auto& it : dps) {
-    mapin[it.id] = it.data;
-  }
-  for (auto& it : mPids) {
-    const auto& el = mapin.find(it.first);
-    if (el == mapin.end()) {
-      LOG(DEBUG) << "DP " << it.first << " not found in map";
-    } else {
-      LOG(DEBUG) << "DP " << it.first << " found in map";
-    }
-  }
-
   mUpdateFeacStatus = false; // by default, we do not foresee a new entry in the CCDB for the FEAC
   mUpdateHVStatus = false;   // by default, we do not foresee a new entry in the CCDB for the HV
 
+  // the whole vector is resolved at once to the indices of the PIDs
+  auto indices = mStore.update(dps);
+
   // now we process all DPs, one by one
-  for (const auto& it : dps) {
+  for (size_t i = 0; i < dps.size(); ++i) {
     // we process only the DPs defined in the configuration
-    const auto& el = mPids.find(it.id);
-    if (el == mPids.end()) {
-      LOG(INFO) << "DP " << it.id << " not found in TOFDCSProcessor, we will not process it";
+    if (indices[i] == o2::dcs::DataPointStore::InvalidIndex) {
+      LOG(INFO) << "DP " << dps[i].id << " not found in TOFDCSProcessor, we will not process it";
       continue;
     }
-    processDP(it);
-    mPids[it.id] = true;
+    processDP(dps[i], indices[i]);
   }
 
   if (mUpdateFeacStatus) {
@@ -111,6 +101,18 @@ int TOFDCSProcessor::process(const gsl::span<const DPCOM> dps)
 //__________________________________________________________________
 
 int TOFDCSProcessor::processDP(const DPCOM& dpcom)
+{
+  auto index = mStore.getIndex(dpcom.id);
+  if (index == o2::dcs::DataPointStore::InvalidIndex) {
+    LOG(INFO) << "DP " << dpcom.id << " not found in TOFDCSProcessor, we will not process it";
+    return 0;
+  }
+  return processDP(dpcom, index);
+}
+
+//__________________________________________________________________
+
+int TOFDCSProcessor::processDP(const DPCOM& dpcom, int index)
 {
 
   // processing single DP
@@ -132,8 +134,8 @@ int TOFDCSProcessor::processDP(const DPCOM& dpcom)
     // now I need to access the correct element
     if (type == RAW_DOUBLE) {
       // for these DPs, we will store the first, last, mid value, plus the value where the maximum variation occurred
-      auto& dvect = mDpsdoublesmap[dpid];
-      LOG(DEBUG) << "mDpsdoublesmap[dpid].size() = " << dvect.size();
+      auto& dvect = mDpsdoubles[index];
+      LOG(DEBUG) << "mDpsdoubles[" << index << "].size() = " << dvect.size();
       auto etime = val.get_epoch_time();
       if (dvect.size() == 0 ||
           etime != dvect.back().get_epoch_time()) { // we check
@@ -331,12 +333,13 @@ void TOFDCSProcessor::updateDPsCCDB()
     double double_value;
   } converter0, converter1;
 
-  for (const auto& it : mPids) {
-    const auto& type = it.first.get_type();
+  for (int index = 0; index < (int)mStore.size(); ++index) {
+    const auto& dpid = mStore.getIdentifier(index);
+    const auto& type = dpid.get_type();
     if (type == o2::dcs::RAW_DOUBLE) {
-      auto& tofdcs = mTOFDCS[it.first];
-      if (it.second == true) { // we processed the DP at least 1x
-        auto& dpvect = mDpsdoublesmap[it.first];
+      auto& tofdcs = mTOFDCS[dpid];
+      const auto& dpvect = mDpsdoubles[index];
+      if (!dpvect.empty()) { // we processed the DP at least 1x
         tofdcs.firstValue.first = dpvect[0].get_epoch_time();
         converter0.raw_data = dpvect[0].payload_pt1;
         tofdcs.firstValue.second = converter0.double_value;
@@ -385,7 +388,7 @@ void TOFDCSProcessor::updateDPsCCDB()
         }
       }
       if (mVerbose) {
-        LOG(INFO) << "PID = " << it.first.get_alias();
+        LOG(INFO) << "PID = " << dpid.get_alias();
         tofdcs.print();
       }
     }
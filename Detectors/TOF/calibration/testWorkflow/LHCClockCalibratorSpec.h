@@ -45,6 +45,8 @@ class LHCClockCalibDevice : public o2::framework::Task
     mCalibrator = std::make_unique<o2::tof::LHCClockCalibrator>(minEnt, nb);
     mCalibrator->setSlotLength(slotL);
     mCalibrator->setMaxSlotsDelay(delay);
+    mCalibrator->setNFillThreads(ic.options().get<int>("fill-threads"));
+    mCalibrator->setMaxPendingFinalizations(ic.options().get<int>("max-pending-finalizations"));
   }
 
   void run(o2::framework::ProcessingContext& pc) final
@@ -53,6 +55,7 @@ class LHCClockCalibDevice : public o2::framework::Task
     auto data = pc.inputs().get<gsl::span<o2::dataformats::CalibInfoTOF>>("input");
     LOG(INFO) << "Processing TF " << tfcounter << " with " << data.size() << " tracks";
     mCalibrator->process(tfcounter, data);
+    auto lock = mCalibrator->lockOutput(); // the slots might be finalized in the background
     sendOutput(pc.outputs());
     const auto& infoVec = mCalibrator->getLHCphaseInfoVector();
     LOG(INFO) << "Created " << infoVec.size() << " objects for TF " << tfcounter;
@@ -115,7 +118,9 @@ DataProcessorSpec getLHCClockCalibDeviceSpec()
       {"tf-per-slot", VariantType::Int, 5, {"number of TFs per calibration time slot"}},
       {"max-delay", VariantType::Int, 3, {"number of slots in past to consider"}},
       {"min-entries", VariantType::Int, 500, {"minimum number of entries to fit single time slot"}},
-      {"nbins", VariantType::Int, 1000, {"number of bins for "}}}};
+      {"nbins", VariantType::Int, 1000, {"number of bins for "}},
+      {"fill-threads", VariantType::Int, 1, {"number of threads filling the histogram of each TF"}},
+      {"max-pending-finalizations", VariantType::Int, 0, {"number of slots which can be finalized in the background, 0 to finalize them synchronously"}}}};
 }
 
 } // namespace framework
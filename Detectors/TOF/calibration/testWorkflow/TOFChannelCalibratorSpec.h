@@ -75,6 +75,7 @@ class TOFChannelCalibDevice : public o2::framework::Task
 
     mCalibrator->setIsTest(isTest);
     mCalibrator->setDoCalibWithCosmics(mCosmics);
+    mCalibrator->setNThreads(ic.options().get<int>("nthreads"));
 
     // calibration objects set to zero
     mPhase.addLHCphase(0, 0);
@@ -251,7 +252,8 @@ DataProcessorSpec getTOFChannelCalibDeviceSpec(bool useCCDB, bool attachChannelO
       {"tf-per-slot", VariantType::Int64, INFINITE_TF_int64, {"number of TFs per calibration time slot"}},
       {"max-delay", VariantType::Int64, 0ll, {"number of slots in past to consider"}},
       {"update-interval", VariantType::Int64, 10ll, {"number of TF after which to try to finalize calibration"}},
-      {"delta-update-interval", VariantType::Int64, 10ll, {"number of TF after which to try to finalize calibration, if previous attempt failed"}}}};
+      {"delta-update-interval", VariantType::Int64, 10ll, {"number of TF after which to try to finalize calibration, if previous attempt failed"}},
+      {"nthreads", VariantType::Int, 1, {"number of threads fitting the channels when finalizing a slot"}}}};
 }
 
 } // namespace framework
@@ -68,6 +68,7 @@ class Compressor
 
   void checkSummary();
   void resetCounters();
+  void mergeCounters(const Compressor& other);
 
   void setDecoderCONET(bool val)
   {
@@ -101,6 +102,7 @@ class Compressor
   /** decoder private functions and data members **/
 
   bool decoderParanoid();
+  void decoderStoreHit(int ichain, const uint32_t* hit);
   inline void decoderRewind() { mDecoderPointer = reinterpret_cast<const uint32_t*>(mDecoderBuffer); };
   inline void decoderNext()
   {
@@ -151,9 +153,9 @@ class Compressor
   bool checkerCheck();
   void checkerCheckRDH();
 
-  uint32_t mEventCounter;
-  uint32_t mFatalCounter;
-  uint32_t mErrorCounter;
+  uint32_t mEventCounter = 0;
+  uint32_t mFatalCounter = 0;
+  uint32_t mErrorCounter = 0;
   bool mCheckerVerbose = false;
 
   struct DRMCounters_t {
@@ -53,6 +53,7 @@
 #define IS_TDC_ERROR(x) ((x & 0xF0000000) == 0x60000000)
 #define IS_FILLER(x) ((x & 0xFFFFFFFF) == 0x70000000)
 #define IS_TDC_HIT(x) ((x & 0x80000000) == 0x80000000)
+#define IS_TDC_HIT_PAIR(x) ((x & 0x8000000080000000) == 0x8000000080000000)
 #define IS_TDC_HIT_LEADING(x) ((x & 0xA0000000) == 0xA0000000)
 #define IS_TDC_HIT_TRAILING(x) ((x & 0xC0000000) == 0xC0000000)
 #define IS_DRM_TEST_WORD(x) ((x & 0xF000000F) == 0xE000000F)
@@ -686,13 +687,27 @@ bool Compressor<RDH, verbose, paranoid>::processTRMchain(int itrm, int ichain)
 
   /** loop over TRM Chain payload **/
   while (true) {
+    /** two TDC hits in a row detected, both words tested at once **/
+    if (!verbose && mDecoderNextWord == 1 && mDecoderPointer + 1 < mDecoderPointerMax) {
+      uint64_t words;
+      std::memcpy(&words, mDecoderPointer, sizeof(words));
+      if (IS_TDC_HIT_PAIR(words)) {
+        mDecoderSummary.hasHits[itrm][ichain] = true;
+        decoderStoreHit(ichain, mDecoderPointer);
+        decoderStoreHit(ichain, mDecoderPointer + 1);
+        decoderNext();
+        decoderNext();
+        if (paranoid && decoderParanoid()) {
+          return true;
+        }
+        continue;
+      }
+    }
+
     /** TDC hit detected **/
     if (IS_TDC_HIT(*mDecoderPointer)) {
       mDecoderSummary.hasHits[itrm][ichain] = true;
-      auto itdc = GET_TRMDATAHIT_TDCID(*mDecoderPointer);
-      auto ihit = mDecoderSummary.trmDataHits[ichain][itdc];
-      mDecoderSummary.trmDataHit[ichain][itdc][ihit] = mDecoderPointer;
-      mDecoderSummary.trmDataHits[ichain][itdc]++;
+      decoderStoreHit(ichain, mDecoderPointer);
       if (verbose && mDecoderVerbose) {
         auto trmDataHit = reinterpret_cast<const raw::TRMDataHit_t*>(mDecoderPointer);
         auto time = trmDataHit->time;
@@ -758,6 +773,17 @@ bool Compressor<RDH, verbose, paranoid>::processTRMchain(int itrm, int ichain)
   return false;
 }
 
+template <typename RDH, bool verbose, bool paranoid>
+void Compressor<RDH, verbose, paranoid>::decoderStoreHit(int ichain, const uint32_t* hit)
+{
+  /** decoder store hit **/
+
+  auto itdc = GET_TRMDATAHIT_TDCID(*hit);
+  auto ihit = mDecoderSummary.trmDataHits[ichain][itdc];
+  mDecoderSummary.trmDataHit[ichain][itdc][ihit] = hit;
+  mDecoderSummary.trmDataHits[ichain][itdc]++;
+}
+
 template <typename RDH, bool verbose, bool paranoid>
 bool Compressor<RDH, verbose, paranoid>::decoderParanoid()
 {
@@ -1338,6 +1364,33 @@ void Compressor<RDH, verbose, paranoid>::resetCounters()
   }
 }
 
+template <typename RDH, bool verbose, bool paranoid>
+void Compressor<RDH, verbose, paranoid>::mergeCounters(const Compressor& other)
+{
+  mEventCounter += other.mEventCounter;
+  mFatalCounter += other.mFatalCounter;
+  mErrorCounter += other.mErrorCounter;
+  mDRMCounters.Headers += other.mDRMCounters.Headers;
+  mDRMCounters.EventWordsMismatch += other.mDRMCounters.EventWordsMismatch;
+  mDRMCounters.clockStatus += other.mDRMCounters.clockStatus;
+  mDRMCounters.Fault += other.mDRMCounters.Fault;
+  mDRMCounters.RTOBit += other.mDRMCounters.RTOBit;
+  for (int itrm = 0; itrm < 10; ++itrm) {
+    mTRMCounters[itrm].Headers += other.mTRMCounters[itrm].Headers;
+    mTRMCounters[itrm].Empty += other.mTRMCounters[itrm].Empty;
+    mTRMCounters[itrm].EventCounterMismatch += other.mTRMCounters[itrm].EventCounterMismatch;
+    mTRMCounters[itrm].EventWordsMismatch += other.mTRMCounters[itrm].EventWordsMismatch;
+    mTRMCounters[itrm].EBit += other.mTRMCounters[itrm].EBit;
+    for (int ichain = 0; ichain < 2; ++ichain) {
+      mTRMChainCounters[itrm][ichain].Headers += other.mTRMChainCounters[itrm][ichain].Headers;
+      mTRMChainCounters[itrm][ichain].EventCounterMismatch += other.mTRMChainCounters[itrm][ichain].EventCounterMismatch;
+      mTRMChainCounters[itrm][ichain].BadStatus += other.mTRMChainCounters[itrm][ichain].BadStatus;
+      mTRMChainCounters[itrm][ichain].BunchIDMismatch += other.mTRMChainCounters[itrm][ichain].BunchIDMismatch;
+      mTRMChainCounters[itrm][ichain].TDCerror += other.mTRMChainCounters[itrm][ichain].TDCerror;
+    }
+  }
+}
+
 template <typename RDH, bool verbose, bool paranoid>
 void Compressor<RDH, verbose, paranoid>::checkSummary()
 {
@@ -24,6 +24,13 @@
 
 #include <fairmq/FairMQDevice.h>
 
+#include <algorithm>
+#include <vector>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::framework;
 
 namespace o2
@@ -41,14 +48,29 @@ void CompressorTask<RDH, verbose, paranoid>::init(InitContext& ic)
   auto encoderVerbose = ic.options().get<bool>("tof-compressor-encoder-verbose");
   auto checkerVerbose = ic.options().get<bool>("tof-compressor-checker-verbose");
   mOutputBufferSize = ic.options().get<int>("tof-compressor-output-buffer-size");
-
-  mCompressor.setDecoderCONET(decoderCONET);
-  mCompressor.setDecoderVerbose(decoderVerbose);
-  mCompressor.setEncoderVerbose(encoderVerbose);
-  mCompressor.setCheckerVerbose(checkerVerbose);
+  auto nThreads = std::max(1, ic.options().get<int>("tof-compressor-threads"));
+#ifndef WITH_OPENMP
+  if (nThreads > 1) {
+    LOG(WARNING) << "Compressor compiled without OpenMP support, using 1 thread";
+    nThreads = 1;
+  }
+#endif
+
+  /** one compressor per thread, each of them processing one link at a time **/
+  for (int ithread = 0; ithread < nThreads; ++ithread) {
+    auto& compressor = mCompressors.emplace_back(std::make_unique<Compressor<RDH, verbose, paranoid>>());
+    compressor->setDecoderCONET(decoderCONET);
+    compressor->setDecoderVerbose(decoderVerbose);
+    compressor->setEncoderVerbose(encoderVerbose);
+    compressor->setCheckerVerbose(checkerVerbose);
+  }
 
   auto finishFunction = [this]() {
-    mCompressor.checkSummary();
+    for (int ithread = 1; ithread < mCompressors.size(); ++ithread) {
+      mCompressors[0]->mergeCounters(*mCompressors[ithread]);
+      mCompressors[ithread]->resetCounters();
+    }
+    mCompressors[0]->checkSummary();
   };
 
   ic.services().get<CallbackService>().set(CallbackService::Id::Stop, finishFunction);
@@ -92,57 +114,85 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
     //  }
   }
 
-  /** loop over subspecs **/
+  /** prepare the output headers and messages of each subspec **/
+  int nSubspecs = subspecPartMap.size();
+  std::vector<const std::vector<o2::framework::DataRef>*> subspecParts;
+  std::vector<o2::header::DataHeader> headersOut;
+  std::vector<o2::framework::DataProcessingHeader> dataProcessingHeadersOut;
+  std::vector<FairMQMessagePtr> payloadMessages;
+  std::vector<long> bufferSizes;
+  subspecParts.reserve(nSubspecs);
+  headersOut.reserve(nSubspecs);
+  dataProcessingHeadersOut.reserve(nSubspecs);
+  payloadMessages.reserve(nSubspecs);
+  bufferSizes.reserve(nSubspecs);
   for (auto& subspecPartEntry : subspecPartMap) {
 
     auto subspec = subspecPartEntry.first;
-    auto parts = subspecPartEntry.second;
+    auto& parts = subspecPartEntry.second;
     auto& firstPart = parts.at(0);
 
     /** use the first part to define output headers **/
-    auto headerOut = *DataRefUtils::getHeader<o2::header::DataHeader*>(firstPart);
-    auto dataProcessingHeaderOut = *DataRefUtils::getHeader<o2::framework::DataProcessingHeader*>(firstPart);
+    auto& headerOut = headersOut.emplace_back(*DataRefUtils::getHeader<o2::header::DataHeader*>(firstPart));
+    dataProcessingHeadersOut.emplace_back(*DataRefUtils::getHeader<o2::framework::DataProcessingHeader*>(firstPart));
     headerOut.dataDescription = "CRAWDATA";
     headerOut.payloadSize = 0;
     headerOut.splitPayloadParts = 1;
 
     /** initialise output message **/
     auto bufferSize = mOutputBufferSize >= 0 ? mOutputBufferSize + subspecBufferSize[subspec] : std::abs(mOutputBufferSize);
-    auto payloadMessage = device->NewMessage(bufferSize);
-    auto bufferPointer = (char*)payloadMessage->GetData();
+    payloadMessages.emplace_back(device->NewMessage(bufferSize));
+    bufferSizes.push_back(bufferSize);
+    subspecParts.push_back(&parts);
+  }
+
+  /** loop over subspecs, each of them is compressed by one thread into its own output message **/
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mCompressors.size())
+#endif
+  for (int isubspec = 0; isubspec < nSubspecs; ++isubspec) {
+#ifdef WITH_OPENMP
+    auto& compressor = *mCompressors[omp_get_thread_num()];
+#else
+    auto& compressor = *mCompressors.front();
+#endif
+    auto& headerOut = headersOut[isubspec];
+    auto bufferPointer = (char*)payloadMessages[isubspec]->GetData();
+    auto bufferSize = bufferSizes[isubspec];
 
     /** loop over subspec parts **/
-    for (const auto& ref : parts) {
+    for (const auto& ref : *subspecParts[isubspec]) {
 
       /** input **/
       auto headerIn = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
-      auto dataProcessingHeaderIn = DataRefUtils::getHeader<o2::framework::DataProcessingHeader*>(ref);
       auto payloadIn = ref.payload;
       auto payloadInSize = headerIn->payloadSize;
 
       /** prepare compressor **/
-      mCompressor.setDecoderBuffer(payloadIn);
-      mCompressor.setDecoderBufferSize(payloadInSize);
-      mCompressor.setEncoderBuffer(bufferPointer);
-      mCompressor.setEncoderBufferSize(bufferSize);
+      compressor.setDecoderBuffer(payloadIn);
+      compressor.setDecoderBufferSize(payloadInSize);
+      compressor.setEncoderBuffer(bufferPointer);
+      compressor.setEncoderBufferSize(bufferSize);
 
       /** run **/
-      mCompressor.run();
-      auto payloadOutSize = mCompressor.getEncoderByteCounter();
+      compressor.run();
+      auto payloadOutSize = compressor.getEncoderByteCounter();
       bufferPointer += payloadOutSize;
       bufferSize -= payloadOutSize;
       headerOut.payloadSize += payloadOutSize;
     }
+  }
 
-    /** finalise output message **/
-    payloadMessage->SetUsedSize(headerOut.payloadSize);
-    o2::header::Stack headerStack{headerOut, dataProcessingHeaderOut};
+  /** finalise output messages and add them to the parts, in subspec order **/
+  for (int isubspec = 0; isubspec < nSubspecs; ++isubspec) {
+    payloadMessages[isubspec]->SetUsedSize(headersOut[isubspec].payloadSize);
+    o2::header::Stack headerStack{headersOut[isubspec], dataProcessingHeadersOut[isubspec]};
     auto headerMessage = device->NewMessage(headerStack.size());
     std::memcpy(headerMessage->GetData(), headerStack.data(), headerStack.size());
 
     /** add parts **/
     partsOut.AddPart(std::move(headerMessage));
-    partsOut.AddPart(std::move(payloadMessage));
+    partsOut.AddPart(std::move(payloadMessages[isubspec]));
   }
 
   /** send message **/
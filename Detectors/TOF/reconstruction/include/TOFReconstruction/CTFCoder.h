@@ -97,7 +97,11 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const ReadoutWindowData>& rofRe
   ec->getANSHeader().majorVersion = 0;
   ec->getANSHeader().minorVersion = 1;
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
-#define ENCODETOF(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)].get());
+#define ENCODETOF(part, slot, bits)                                                                  \
+  {                                                                                                  \
+    const auto [encoder, dict] = getEncoderForSlot(part, int(slot), bits);                           \
+    CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, encoder, dict); \
+  }
   // clang-format off
   ENCODETOF(cc.bcIncROF,     CTF::BLCbcIncROF,     0);
   ENCODETOF(cc.orbitIncROF,  CTF::BLCorbitIncROF,  0);
@@ -15,27 +15,107 @@
 #ifndef ALICEO2_TOF_EVENTTIMEMAKER_H
 #define ALICEO2_TOF_EVENTTIMEMAKER_H
 
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
 namespace o2
 {
 
 namespace tof
 {
 
+/// Parameters of the TOF event time computation
+struct eventTimeParams {
+  float minMomentum = 0.5f;         /// min. momentum of the tracks used (GeV/c)
+  float maxMomentum = 2.f;          /// max. momentum of the tracks used (GeV/c)
+  float tofResolution = 80.f;       /// resolution of the TOF signal (ps)
+  float momentumResolution = 0.02f; /// relative resolution of the momentum used for the expected times
+  float maxChi2Track = 9.f;         /// max. chi2 contribution of a track, the worse ones are removed
+  int maxSubsetSize = 8;            /// tracks per subset of the combinatorial search, 3^n hypotheses each (max. 10)
+  int minTracks = 2;                /// min. number of tracks for an event time
+};
+
+/// Track used for the event time: TOF signal and expected times for the pion, kaon and proton hypotheses
+struct eventTimeTrack {
+  static constexpr int NHypotheses = 3;
+  static constexpr float kCSPEED = 0.0299792458f; /// speed of light (cm/ps)
+  static constexpr std::array<float, NHypotheses> kMasses = {0.13957039f, 0.493677f, 0.93827209f};
+
+  eventTimeTrack() = default;
+  /// \param signal TOF signal (ps), \param p momentum (GeV/c), \param length track length (cm)
+  eventTimeTrack(float signal, float p, float length, const eventTimeParams& par) : mSignal(signal), mMomentum(p)
+  {
+    for (int h = 0; h < NHypotheses; h++) {
+      const float m2 = kMasses[h] * kMasses[h], p2 = p * p;
+      mExpTimes[h] = p > 0.f ? length * std::sqrt(p2 + m2) / (kCSPEED * p) : 0.f;
+      const float sigmaExp = mExpTimes[h] * m2 / (p2 + m2) * par.momentumResolution; // propagated from the momentum resolution
+      mExpSigma[h] = std::sqrt(par.tofResolution * par.tofResolution + sigmaExp * sigmaExp);
+    }
+  }
+
+  float mSignal = 0.f;                        /// TOF signal (ps)
+  float mMomentum = 0.f;                      /// momentum (GeV/c)
+  std::array<float, NHypotheses> mExpTimes{}; /// expected times (ps)
+  std::array<float, NHypotheses> mExpSigma{}; /// resolution of signal - expected time (ps)
+};
+
+/// Event time of a collision, with the hypotheses assigned to the tracks
 struct eventTimeContainer {
+  eventTimeContainer() = default;
   eventTimeContainer(const float& e) : eventTime{e} {};
-  float eventTime = 0.f;
+  float eventTime = 0.f;          /// event time (ps)
+  float eventTimeError = 0.f;     /// error of the event time (ps), 0 if it was not computed
+  float chi2 = 0.f;               /// chi2 of the tracks for the event time
+  int nUsedTracks = 0;            /// number of tracks used
+  std::vector<int8_t> hypotheses; /// hypothesis assigned to each input track, -1 if not used
+  double sumW = 0.;               /// sum of the weights of the used tracks
+  std::vector<float> trackW;      /// weight of each input track, 0 if not used
+  std::vector<float> trackDT;     /// signal - expected time of each input track for the assigned hypothesis
+
+  bool isValid() const { return nUsedTracks > 0; }
+
+  /// event time without the contribution of track i, to avoid the bias of its own PID (ps)
+  float getEventTimeWithoutTrack(int i) const
+  {
+    if (!isValid() || !trackW[i]) {
+      return eventTime;
+    }
+    double w = sumW - trackW[i];
+    return w > 0. ? (eventTime * sumW - trackW[i] * trackDT[i]) / w : 0.f;
+  }
+  /// error of the event time without the track i (ps), 0 if there is no other track
+  float getEventTimeErrorWithoutTrack(int i) const
+  {
+    double w = isValid() ? sumW - trackW[i] : 0.;
+    return w > 0. ? 1. / std::sqrt(w) : 0.f;
+  }
 };
 
+/// Event time from the tracks of a collision: the tracks are split in subsets of at most
+/// maxSubsetSize tracks, in each subset the hypotheses of the tracks minimizing the chi2 are found
+/// by going through all the combinations in Gray code order, so that each one is obtained from the
+/// previous one by changing a single hypothesis, i.e. in constant time. The cost is then linear in the
+/// number of tracks instead of exponential. The event time is the weighted mean of all the used tracks.
+eventTimeContainer computeEventTime(const std::vector<eventTimeTrack>& tracks, const eventTimeParams& par = {});
+
+/// Event times of all the collisions of a TF, computed concurrently with nThreads
+void computeEventTimes(const std::vector<std::vector<eventTimeTrack>>& collisions, std::vector<eventTimeContainer>& results,
+                       const eventTimeParams& par = {}, int nThreads = 1);
+
+/// Event time from the AOD tracks of a collision
 template <typename tTracks>
-eventTimeContainer evTimeMaker(const tTracks& tracks)
+eventTimeContainer evTimeMaker(const tTracks& tracks, const eventTimeParams& par = {})
 {
+  std::vector<eventTimeTrack> evTracks;
   for (auto track : tracks) {
-    track.tofSignal();
+    evTracks.emplace_back(track.tofSignal(), track.tofExpMom(), track.length(), par);
   }
-  return eventTimeContainer{0};
+  return computeEventTime(evTracks, par);
 }
 
 } // namespace tof
 } // namespace o2
 
-#endif /* ALICEO2_TOF_EVENTTIMEMAKER_H */
\ No newline at end of file
+#endif /* ALICEO2_TOF_EVENTTIMEMAKER_H */
@@ -13,6 +13,7 @@
 /// \brief Implementation of the TOF event time maker
 
 #include "TOFReconstruction/EventTimeMaker.h"
+#include <algorithm>
 
 namespace o2
 {
@@ -20,5 +21,191 @@ namespace o2
 namespace tof
 {
 
+namespace
+{
+constexpr int MaxSubsetSize = 10;
+
+/// weight and signal - expected time of a track for each hypothesis
+struct trackTerms {
+  std::array<double, eventTimeTrack::NHypotheses> w;
+  std::array<double, eventTimeTrack::NHypotheses> dt;
+};
+
+/// finds the hypotheses of the tracks of a subset minimizing the chi2 = S2 - S1^2 / S0,
+/// with S0 = sum(w), S1 = sum(w * dt), S2 = sum(w * dt^2), going through the combinations in
+/// reflected Gray code order (Knuth's loopless algorithm H), so that each step changes one hypothesis
+/// \return the chi2 of the best combination, stored in best
+double findBestHypotheses(const std::vector<trackTerms>& terms, const std::vector<int>& subset, std::array<int8_t, MaxSubsetSize>& best)
+{
+  constexpr int NH = eventTimeTrack::NHypotheses;
+  const int n = subset.size();
+  std::array<int8_t, MaxSubsetSize> a{}, o{};
+  std::array<int, MaxSubsetSize + 1> f{};
+  double s0 = 0., s1 = 0., s2 = 0.;
+  for (int j = 0; j < n; j++) {
+    const auto& t = terms[subset[j]];
+    s0 += t.w[0];
+    s1 += t.w[0] * t.dt[0];
+    s2 += t.w[0] * t.dt[0] * t.dt[0];
+    o[j] = 1;
+    f[j] = j;
+  }
+  f[n] = n;
+  double bestChi2 = s2 - s1 * s1 / s0;
+  best = a;
+  while (true) {
+    int j = f[0];
+    f[0] = 0;
+    if (j == n) {
+      break;
+    }
+    const auto& t = terms[subset[j]];
+    int hOld = a[j], hNew = a[j] + o[j];
+    a[j] = hNew;
+    s0 += t.w[hNew] - t.w[hOld];
+    s1 += t.w[hNew] * t.dt[hNew] - t.w[hOld] * t.dt[hOld];
+    s2 += t.w[hNew] * t.dt[hNew] * t.dt[hNew] - t.w[hOld] * t.dt[hOld] * t.dt[hOld];
+    if (hNew == 0 || hNew == NH - 1) {
+      o[j] = -o[j];
+      f[j] = f[j + 1];
+      f[j + 1] = j + 1;
+    }
+    double chi2 = s2 - s1 * s1 / s0;
+    if (chi2 < bestChi2) {
+      bestChi2 = chi2;
+      best = a;
+    }
+  }
+  return bestChi2;
+}
+} // namespace
+
+eventTimeContainer computeEventTime(const std::vector<eventTimeTrack>& tracks, const eventTimeParams& par)
+{
+  eventTimeContainer res;
+  const int nTracks = tracks.size();
+  res.hypotheses.assign(nTracks, -1);
+  res.trackW.assign(nTracks, 0.f);
+  res.trackDT.assign(nTracks, 0.f);
+
+  std::vector<trackTerms> terms(nTracks);
+  std::vector<int> selected;
+  for (int i = 0; i < nTracks; i++) {
+    const auto& tr = tracks[i];
+    if (tr.mSignal <= 0.f || tr.mMomentum < par.minMomentum || tr.mMomentum > par.maxMomentum) {
+      continue;
+    }
+    for (int h = 0; h < eventTimeTrack::NHypotheses; h++) {
+      terms[i].w[h] = 1. / (double(tr.mExpSigma[h]) * tr.mExpSigma[h]);
+      terms[i].dt[h] = tr.mSignal - tr.mExpTimes[h];
+    }
+    selected.push_back(i);
+  }
+  if (int(selected.size()) < std::max(1, par.minTracks)) {
+    return res;
+  }
+
+  // subsets of similar size of at most subsetSize tracks
+  const int subsetSize = std::clamp(par.maxSubsetSize, 1, MaxSubsetSize);
+  const int nSelected = selected.size(), nSubsets = (nSelected + subsetSize - 1) / subsetSize;
+  std::vector<int> subset;
+  std::array<int8_t, MaxSubsetSize> best;
+  for (int is = 0; is < nSubsets; is++) {
+    subset.assign(selected.begin() + is * nSelected / nSubsets, selected.begin() + (is + 1) * nSelected / nSubsets);
+    // the worst track is removed and the search is redone as long as it exceeds the max. chi2 contribution
+    while (!subset.empty()) {
+      findBestHypotheses(terms, subset, best);
+      double s0 = 0., s1 = 0.;
+      for (size_t j = 0; j < subset.size(); j++) {
+        const auto& t = terms[subset[j]];
+        s0 += t.w[best[j]];
+        s1 += t.w[best[j]] * t.dt[best[j]];
+      }
+      const double t0 = s1 / s0;
+      int worst = -1;
+      double worstChi2 = par.maxChi2Track;
+      for (size_t j = 0; j < subset.size(); j++) {
+        const auto& t = terms[subset[j]];
+        const double d = t.dt[best[j]] - t0, chi2 = t.w[best[j]] * d * d;
+        if (chi2 > worstChi2) {
+          worstChi2 = chi2;
+          worst = j;
+        }
+      }
+      if (worst < 0 || subset.size() == 1) {
+        break;
+      }
+      subset.erase(subset.begin() + worst);
+    }
+    for (size_t j = 0; j < subset.size(); j++) {
+      const int i = subset[j];
+      res.hypotheses[i] = best[j];
+      res.trackW[i] = terms[i].w[best[j]];
+      res.trackDT[i] = terms[i].dt[best[j]];
+    }
+  }
+
+  // weighted mean of the used tracks
+  double s0 = 0., s1 = 0.;
+  for (int i : selected) {
+    if (res.hypotheses[i] >= 0) {
+      s0 += res.trackW[i];
+      s1 += res.trackW[i] * res.trackDT[i];
+      res.nUsedTracks++;
+    }
+  }
+  // the hypotheses were chosen within the subsets, the ones more compatible with the mean of all tracks are taken
+  if (nSubsets > 1 && s0 > 0.) {
+    const double t0 = s1 / s0;
+    s0 = s1 = 0.;
+    for (int i : selected) {
+      if (res.hypotheses[i] < 0) {
+        continue;
+      }
+      const auto& t = terms[i];
+      int hBest = res.hypotheses[i];
+      for (int h = 0; h < eventTimeTrack::NHypotheses; h++) {
+        if (t.w[h] * (t.dt[h] - t0) * (t.dt[h] - t0) < t.w[hBest] * (t.dt[hBest] - t0) * (t.dt[hBest] - t0)) {
+          hBest = h;
+        }
+      }
+      res.hypotheses[i] = hBest;
+      res.trackW[i] = t.w[hBest];
+      res.trackDT[i] = t.dt[hBest];
+      s0 += res.trackW[i];
+      s1 += res.trackW[i] * res.trackDT[i];
+    }
+  }
+  if (res.nUsedTracks < std::max(1, par.minTracks)) {
+    res.nUsedTracks = 0;
+    res.hypotheses.assign(nTracks, -1);
+    res.trackW.assign(nTracks, 0.f);
+    return res;
+  }
+  res.sumW = s0;
+  res.eventTime = s1 / s0;
+  res.eventTimeError = 1. / std::sqrt(s0);
+  for (int i : selected) {
+    if (res.hypotheses[i] >= 0) {
+      const double d = res.trackDT[i] - res.eventTime;
+      res.chi2 += res.trackW[i] * d * d;
+    }
+  }
+  return res;
+}
+
+void computeEventTimes(const std::vector<std::vector<eventTimeTrack>>& collisions, std::vector<eventTimeContainer>& results,
+                       const eventTimeParams& par, int nThreads)
+{
+  const int nCollisions = collisions.size();
+  results.resize(nCollisions);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int ic = 0; ic < nCollisions; ic++) {
+    results[ic] = computeEventTime(collisions[ic], par);
+  }
+}
+
 } // namespace tof
-} // namespace o2
\ No newline at end of file
+} // namespace o2
@@ -37,6 +37,8 @@ void EntropyEncoderSpec::init(o2::framework::InitContext& ic)
   if (!dictPath.empty() && dictPath != "none") {
     mCTFCoder.createCoders(dictPath, o2::ctf::CTFCoderBase::OpType::Encoder);
   }
+  mCTFCoder.setAdaptiveDictionaryThreshold(ic.options().get<float>("ctf-adaptive-dict-threshold"));
+  mCTFCoder.setCompactDictionary(ic.options().get<float>("ctf-dict-compact-coverage"), ic.options().get<int>("ctf-dict-compact-range-bits"));
 }
 
 void EntropyEncoderSpec::run(ProcessingContext& pc)
@@ -75,7 +77,10 @@ DataProcessorSpec getEntropyEncoderSpec()
     inputs,
     Outputs{{o2::header::gDataOriginTOF, "CTFDATA", 0, Lifetime::Timeframe}},
     AlgorithmSpec{adaptFromTask<EntropyEncoderSpec>()},
-    Options{{"ctf-dict", VariantType::String, o2::base::NameConf::getCTFDictFileName(), {"File of CTF encoding dictionary"}}}};
+    Options{{"ctf-dict", VariantType::String, o2::base::NameConf::getCTFDictFileName(), {"File of CTF encoding dictionary"}},
+            {"ctf-adaptive-dict-threshold", VariantType::Float, 0.f, {"KL divergence (bits/symbol) above which the encoders reused across TFs are rebuilt, <=0: build per TF"}},
+            {"ctf-dict-compact-coverage", VariantType::Float, 0.f, {"If > 0, the per-TF dictionaries of wide alphabets cover only the symbol range holding this fraction of the data, the others are stored as literals"}},
+            {"ctf-dict-compact-range-bits", VariantType::Int, o2::ctf::CTFCoderBase::DefaultCompactRangeBits, {"Range in bits of the alphabet above which the per-TF dictionaries are compacted"}}}};
 }
 
 } // namespace tof
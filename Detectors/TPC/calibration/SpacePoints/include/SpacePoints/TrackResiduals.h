@@ -142,6 +142,13 @@ class TrackResiduals
   // -------------------------------------- settings --------------------------------------------------
   /// Sets a flag to print the memory usage at certain points in the program for performance studies.
   void setPrintMemoryUsage() { mPrintMem = true; }
+  /// Keep the local residuals in memory instead of writing them to the intermediate per sector trees.
+  /// processSectorResiduals() then uses the residuals from memory.
+  void setStoreLocalResidualsInMemory(bool flag = true) { mStoreLocalResidualsInMemory = flag; }
+  bool getStoreLocalResidualsInMemory() const { return mStoreLocalResidualsInMemory; }
+  /// Sets the number of threads used to process the voxels of a sector
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
   /// Sets the kernel type used for smoothing.
   /// \param kernel Kernel type (Epanechnikov / Gaussian)
   /// \param bwX Bin width in X
@@ -169,6 +176,10 @@ class TrackResiduals
   /// Write trees with local residuals to file
   void writeLocalResidualTreesToFile();
 
+  /// Stores the content of mLocalResid for given sector, either in memory or in the local residuals tree
+  /// \param iSec Sector of the residual
+  void storeLocalResidual(int iSec);
+
   /// Loads residual data from track interpolation and fills voxel data structures local residuals
   void convertToLocalResiduals();
 
@@ -531,8 +542,10 @@ class TrackResiduals
   std::unique_ptr<TFile> mFileOut{}; ///< output debug file
   std::unique_ptr<TTree> mTreeOut{}; ///< tree holding debug output
   // status flags
-  bool mIsInitialized{}; ///< initialize only once
-  bool mPrintMem{};      ///< turn on to print memory usage at certain points
+  bool mIsInitialized{};               ///< initialize only once
+  bool mPrintMem{};                    ///< turn on to print memory usage at certain points
+  bool mStoreLocalResidualsInMemory{}; ///< keep local residuals in memory instead of writing them to trees
+  int mNThreads{1};                    ///< number of threads used for the voxel processing
   // binning
   int mNXBins{param::NPadRows};            ///< number of bins in radial direction
   int mNY2XBins{param::NY2XBins};          ///< number of y/x bins per sector
@@ -554,10 +567,11 @@ class TrackResiduals
   float mMaxZ2X{1.f};                      ///< max z/x value
   std::array<bool, VoxDim> mUniformBins{true, true, true}; ///< if binning is uniform for each dimension
   // local residual data, extracted from track interpolation
-  std::array<std::unique_ptr<TFile>, SECTORSPERSIDE * SIDES> mTmpFile{}; ///< I/O file
-  std::array<std::unique_ptr<TTree>, SECTORSPERSIDE * SIDES> mTmpTree{}; ///< I/O tree per sector
-  LocalResid mLocalResid{};                                              ///< data exchange structure for filling mTmpTree
-  LocalResid* mLocalResidPtr{&mLocalResid};                              ///< pointer to mLocalResid
+  std::array<std::unique_ptr<TFile>, SECTORSPERSIDE * SIDES> mTmpFile{};         ///< I/O file
+  std::array<std::unique_ptr<TTree>, SECTORSPERSIDE * SIDES> mTmpTree{};         ///< I/O tree per sector
+  LocalResid mLocalResid{};                                                      ///< data exchange structure for filling mTmpTree
+  LocalResid* mLocalResidPtr{&mLocalResid};                                      ///< pointer to mLocalResid
+  std::array<std::vector<LocalResid>, SECTORSPERSIDE * SIDES> mLocalResiduals{}; ///< local residuals per sector, if kept in memory
   // settings
   std::string mLocalResFileName{"deltasSect"};   ///< filename for local residuals input
   std::string mLocalResTreeName{"treeSec"};      ///< name for tree with local residuals
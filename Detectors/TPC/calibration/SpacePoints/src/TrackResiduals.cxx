@@ -28,6 +28,7 @@
 #include <cmath>
 #include <cstring>
 #include <algorithm>
+#include <numeric>
 
 // for debugging
 #include "TStopwatch.h"
@@ -532,8 +533,7 @@ void TrackResiduals::fillLocalResidualsTrees()
     mLocalResid.dy = static_cast<short>(mArrDY[iCl] * 0x7fff / param::MaxResid);
     mLocalResid.dz = static_cast<short>(mArrDZ[iCl] * 0x7fff / param::MaxResid);
     mLocalResid.tgSlp = static_cast<short>(mArrTgSlp[iCl] * 0x7fff / param::MaxTgSlp);
-    // fill tree
-    mTmpTree[secId]->Fill();
+    storeLocalResidual(secId);
     // TODO: fill statistics distribution within the voxel
   }
 }
@@ -691,6 +691,12 @@ void TrackResiduals::prepareDeltaTreeBranches()
 
 void TrackResiduals::prepareLocalResidualTrees()
 {
+  if (mStoreLocalResidualsInMemory) {
+    for (auto& residuals : mLocalResiduals) {
+      residuals.clear();
+    }
+    return;
+  }
   // prepare tree structure
   for (int iSec = 0; iSec < SECTORSPERSIDE * SIDES; ++iSec) {
     mTmpFile[iSec] = std::make_unique<TFile>(Form("%s%d.root", mLocalResFileName.c_str(), iSec), "recreate");
@@ -714,6 +720,15 @@ void TrackResiduals::writeLocalResidualTreesToFile()
   }
 }
 
+void TrackResiduals::storeLocalResidual(int iSec)
+{
+  if (mStoreLocalResidualsInMemory) {
+    mLocalResiduals[iSec].push_back(mLocalResid);
+  } else {
+    mTmpTree[iSec]->Fill();
+  }
+}
+
 void TrackResiduals::convertToLocalResiduals()
 {
   // When using data generated with o2 without distortions the residuals can easily be converted
@@ -763,7 +778,7 @@ void TrackResiduals::convertToLocalResiduals()
       mLocalResid.dz = mClRes[clIdx].dz;
       mLocalResid.tgSlp = mClRes[clIdx].phi;
       mLocalResid.bvox = bvox;
-      mTmpTree[sec]->Fill();
+      storeLocalResidual(sec);
       // TODO calculate mean position of clusters in each voxel (can be updated each time a new measurement is found inside voxel)
     }
   }
@@ -794,27 +809,38 @@ void TrackResiduals::processSectorResiduals(int iSec)
   if (!mIsInitialized) {
     init();
   }
-  // open file and retrieve data tree (only local files are supported at the moment)
-  std::string filename = mLocalResFileName + std::to_string(iSec) + ".root";
-  std::unique_ptr<TFile> flin = std::make_unique<TFile>(filename.c_str());
-  if (!flin || flin->IsZombie()) {
-    LOG(error) << "failed to open " << filename.c_str();
-    return;
-  }
-  std::string treename = mLocalResTreeName + std::to_string(iSec);
-  std::unique_ptr<TTree> tree((TTree*)flin->Get(treename.c_str()));
-  if (!tree) {
-    LOG(error) << "did not find the data tree " << treename.c_str();
-    return;
-  }
-  // read compact delte trees created with AliRoot or o2
+  // local residuals kept in memory are already compressed and do not need to be read from file
+  const auto& memResiduals = mLocalResiduals[iSec];
+  std::unique_ptr<TFile> flin;
+  std::unique_ptr<TTree> tree;
   LocResStruct trkRes;
   auto* pTrkRes = &trkRes;
-  tree->SetBranchAddress(mLocalResBranchName.c_str(), &pTrkRes);
-  auto nPoints = tree->GetEntries();
+  Long64_t nPoints = 0;
+  if (mStoreLocalResidualsInMemory) {
+    nPoints = memResiduals.size();
+  } else {
+    // open file and retrieve data tree (only local files are supported at the moment)
+    std::string filename = mLocalResFileName + std::to_string(iSec) + ".root";
+    flin = std::make_unique<TFile>(filename.c_str());
+    if (!flin || flin->IsZombie()) {
+      LOG(error) << "failed to open " << filename.c_str();
+      return;
+    }
+    std::string treename = mLocalResTreeName + std::to_string(iSec);
+    tree.reset((TTree*)flin->Get(treename.c_str()));
+    if (!tree) {
+      LOG(error) << "did not find the data tree " << treename.c_str();
+      return;
+    }
+    // read compact delte trees created with AliRoot or o2
+    tree->SetBranchAddress(mLocalResBranchName.c_str(), &pTrkRes);
+    nPoints = tree->GetEntries();
+  }
   if (!nPoints) {
     LOG(warning) << "no entries found for sector " << iSec;
-    flin->Close();
+    if (flin) {
+      flin->Close();
+    }
     return;
   }
   if (nPoints > mMaxPointsPerSector) {
@@ -839,38 +865,49 @@ void TrackResiduals::processSectorResiduals(int iSec)
   }
 
   // read input data into internal vectors
-  for (int i = 0; i < nPoints; ++i) {
-    tree->GetEntry(i);
-#ifdef LOCAL_RESIDUAL_FORMAT_OLD
-    if (fabs(trkRes.tgSlp) >= param::MaxTgSlp) {
-      continue;
+  if (mStoreLocalResidualsInMemory) {
+    for (int i = 0; i < nPoints; ++i) {
+      const auto& res = memResiduals[i];
+      if (fabs(res.tgSlp * param::MaxTgSlp / 0x7fff) >= param::MaxTgSlp) {
+        continue;
+      }
+      dyData[nAccepted] = res.dy * param::MaxResid / 0x7fff;
+      dzData[nAccepted] = res.dz * param::MaxResid / 0x7fff;
+      tgSlpData[nAccepted] = res.tgSlp * param::MaxTgSlp / 0x7fff;
+      binData[nAccepted] = getGlbVoxBin(res.bvox[VoxX], res.bvox[VoxF], res.bvox[VoxZ]);
+      nAccepted++;
     }
-    dyData[nAccepted] = trkRes.dy;
-    dzData[nAccepted] = trkRes.dz;
-    tgSlpData[nAccepted] = trkRes.tgSlp;
+  } else {
+    for (int i = 0; i < nPoints; ++i) {
+      tree->GetEntry(i);
+#ifdef LOCAL_RESIDUAL_FORMAT_OLD
+      if (fabs(trkRes.tgSlp) >= param::MaxTgSlp) {
+        continue;
+      }
+      dyData[nAccepted] = trkRes.dy;
+      dzData[nAccepted] = trkRes.dz;
+      tgSlpData[nAccepted] = trkRes.tgSlp;
 #else
-    if (fabs(trkRes.tgSlp * param::MaxTgSlp / 0x7fff) >= param::MaxTgSlp) {
-      continue;
-    }
-    dyData[nAccepted] = trkRes.dy * param::MaxResid / 0x7fff;
-    dzData[nAccepted] = trkRes.dz * param::MaxResid / 0x7fff;
-    tgSlpData[nAccepted] = trkRes.tgSlp * param::MaxTgSlp / 0x7fff;
+      if (fabs(trkRes.tgSlp * param::MaxTgSlp / 0x7fff) >= param::MaxTgSlp) {
+        continue;
+      }
+      dyData[nAccepted] = trkRes.dy * param::MaxResid / 0x7fff;
+      dzData[nAccepted] = trkRes.dz * param::MaxResid / 0x7fff;
+      tgSlpData[nAccepted] = trkRes.tgSlp * param::MaxTgSlp / 0x7fff;
 #endif
-    binData[nAccepted] = getGlbVoxBin(trkRes.bvox[VoxX], trkRes.bvox[VoxF], trkRes.bvox[VoxZ]);
-    nAccepted++;
+      binData[nAccepted] = getGlbVoxBin(trkRes.bvox[VoxX], trkRes.bvox[VoxF], trkRes.bvox[VoxZ]);
+      nAccepted++;
+    }
+    tree.release();
+    flin->Close();
   }
 
-  tree.release();
-  flin->Close();
-
   if (mPrintMem) {
     printMem();
   }
 
   LOG(info) << "Done reading input data (accepted " << nAccepted << " points)";
 
-  std::vector<size_t> binIndices(nAccepted);
-
   dyData.resize(nAccepted);
   dzData.resize(nAccepted);
   tgSlpData.resize(nAccepted);
@@ -892,47 +929,55 @@ void TrackResiduals::processSectorResiduals(int iSec)
   }
 #endif
 
-  // sort in voxel increasing order
-  o2::math_utils::SortData(binData, binIndices);
+  // sort in voxel increasing order. Since the number of voxels is known this is done with a counting sort,
+  // which also provides the range of points for each voxel
+  std::vector<size_t> voxOffsets(mNVoxPerSector + 1, 0);
+  for (unsigned int i = 0; i < nAccepted; ++i) {
+    ++voxOffsets[binData[i] + 1];
+  }
+  std::partial_sum(voxOffsets.begin(), voxOffsets.end(), voxOffsets.begin());
+  std::vector<size_t> binIndices(nAccepted);
+  {
+    std::vector<size_t> voxFill(voxOffsets.begin(), voxOffsets.end() - 1);
+    for (unsigned int i = 0; i < nAccepted; ++i) {
+      binIndices[voxFill[binData[i]]++] = i;
+    }
+  }
   if (mPrintMem) {
     printMem();
   }
 
-  // vectors holding the data for one voxel at a time
-  std::vector<float> dyVec;
-  std::vector<float> dzVec;
-  std::vector<float> tgVec;
-  // assuming we will always have around 1000 entries per voxel
-  dyVec.reserve(1e3);
-  dzVec.reserve(1e3);
-  tgVec.reserve(1e3);
-  int currVoxBin = -1;
-  unsigned int nPointsInVox = 0;
-  unsigned int nProcessed = 0;
-  while (nProcessed < nAccepted) {
-    // read all points, voxel by voxel
-    int idx = binIndices[nProcessed];
-    if (currVoxBin != binData[idx]) {
-      if (nPointsInVox) {
-        VoxRes& resVox = secData[currVoxBin];
-        processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
+  // the voxels are independent from each other and are processed in parallel
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(mNThreads)
+#endif
+  {
+    // vectors holding the data for one voxel at a time
+    std::vector<float> dyVec;
+    std::vector<float> dzVec;
+    std::vector<float> tgVec;
+    // assuming we will always have around 1000 entries per voxel
+    dyVec.reserve(1e3);
+    dzVec.reserve(1e3);
+    tgVec.reserve(1e3);
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (int iVox = 0; iVox < mNVoxPerSector; ++iVox) {
+      if (voxOffsets[iVox] == voxOffsets[iVox + 1]) {
+        continue;
       }
-      currVoxBin = binData[idx];
-      nPointsInVox = 0;
       dyVec.clear();
       dzVec.clear();
       tgVec.clear();
+      for (size_t iPoint = voxOffsets[iVox]; iPoint < voxOffsets[iVox + 1]; ++iPoint) {
+        const auto idx = binIndices[iPoint];
+        dyVec.push_back(dyData[idx]);
+        dzVec.push_back(dzData[idx]);
+        tgVec.push_back(tgSlpData[idx]);
+      }
+      processVoxelResiduals(dyVec, dzVec, tgVec, secData[iVox]);
     }
-    dyVec.push_back(dyData[idx]);
-    dzVec.push_back(dzData[idx]);
-    tgVec.push_back(tgSlpData[idx]);
-    ++nPointsInVox;
-    ++nProcessed;
-  }
-  if (nPointsInVox) {
-    // process last voxel
-    VoxRes& resVox = secData[currVoxBin];
-    processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
   }
   LOG(info) << "extracted residuals for sector " << iSec;
 
@@ -948,34 +993,29 @@ void TrackResiduals::processSectorResiduals(int iSec)
   //return;
 
   // process dispersions
-  dyVec.clear();
-  tgVec.clear();
-  currVoxBin = -1;
-  nProcessed = 0;
-  nPointsInVox = 0;
-  while (nProcessed < nAccepted) {
-    int idx = binIndices[nProcessed];
-    if (currVoxBin != binData[idx]) {
-      if (nPointsInVox) {
-        VoxRes& resVox = secData[currVoxBin];
-        if (!getXBinIgnored(iSec, resVox.bvox[VoxX])) {
-          processVoxelDispersions(tgVec, dyVec, resVox);
-        }
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(mNThreads)
+#endif
+  {
+    std::vector<float> dyVec;
+    std::vector<float> tgVec;
+    dyVec.reserve(1e3);
+    tgVec.reserve(1e3);
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (int iVox = 0; iVox < mNVoxPerSector; ++iVox) {
+      VoxRes& resVox = secData[iVox];
+      if (voxOffsets[iVox] == voxOffsets[iVox + 1] || getXBinIgnored(iSec, resVox.bvox[VoxX])) {
+        continue;
       }
-      currVoxBin = binData[idx];
-      nPointsInVox = 0;
       dyVec.clear();
       tgVec.clear();
-    }
-    dyVec.push_back(dyData[idx]);
-    tgVec.push_back(tgSlpData[idx]);
-    ++nPointsInVox;
-    ++nProcessed;
-  }
-  if (nPointsInVox) {
-    // process last voxel
-    VoxRes& resVox = secData[currVoxBin];
-    if (!getXBinIgnored(iSec, resVox.bvox[VoxX])) {
+      for (size_t iPoint = voxOffsets[iVox]; iPoint < voxOffsets[iVox + 1]; ++iPoint) {
+        const auto idx = binIndices[iPoint];
+        dyVec.push_back(dyData[idx]);
+        tgVec.push_back(tgSlpData[idx]);
+      }
       processVoxelDispersions(tgVec, dyVec, resVox);
     }
   }
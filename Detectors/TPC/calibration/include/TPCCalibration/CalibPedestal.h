@@ -15,6 +15,7 @@
 /// \file   CalibPedestal.h
 /// \author Jens Wiechula, Jens.Wiechula@ikf.uni-frankfurt.de
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -94,6 +95,8 @@ class CalibPedestal : public CalibRawBase
     mLastTimeBin = last;
   }
   /// Analyse the buffered adc values and calculate noise and pedestal
+  /// For StatisticsType::MeanStdDevOnline only the running sums are evaluated,
+  /// so it can be called at any time without a final pass over ADC spectra
   void analyse();
 
   /// Get the pedestal calibration object
@@ -119,6 +122,7 @@ class CalibPedestal : public CalibRawBase
   void endEvent() final{};
 
   /// generate a control histogram
+  /// \return nullptr if no ADC spectra are stored for this roc (e.g. for StatisticsType::MeanStdDevOnline)
   TH2* createControlHistogram(ROC roc);
 
  private:
@@ -131,7 +135,30 @@ class CalibPedestal : public CalibRawBase
   CalPad mPedestal;               ///< CalDet object with pedestal information
   CalPad mNoise;                  ///< CalDet object with noise
 
-  std::vector<std::unique_ptr<vectorType>> mADCdata; //!< ADC data to calculate noise and pedestal
+  /// Running sums of the ADC values of all pads in a readout chamber, stored as structure of arrays.
+  /// The ADC values are integers, such that the sums are exact.
+  struct RunningSums {
+    std::vector<uint32_t> entries; ///< number of ADC values per pad
+    std::vector<uint64_t> sum;     ///< sum of the ADC values per pad
+    std::vector<uint64_t> sum2;    ///< sum of the squared ADC values per pad
+
+    void resize(size_t numberOfPads)
+    {
+      entries.assign(numberOfPads, 0);
+      sum.assign(numberOfPads, 0);
+      sum2.assign(numberOfPads, 0);
+    }
+
+    void fill(size_t pad, uint32_t adcValue)
+    {
+      ++entries[pad];
+      sum[pad] += adcValue;
+      sum2[pad] += uint64_t(adcValue) * adcValue;
+    }
+  };
+
+  std::vector<std::unique_ptr<vectorType>> mADCdata;      //!< ADC data to calculate noise and pedestal
+  std::vector<std::unique_ptr<RunningSums>> mRunningSums; //!< running sums for StatisticsType::MeanStdDevOnline
 
   /// return the value vector for a readout chamber
   ///
@@ -139,6 +166,12 @@ class CalibPedestal : public CalibRawBase
   /// \param create if to create the vector if it does not exist
   vectorType* getVector(ROC roc, bool create = kFALSE);
 
+  /// return the running sums for a readout chamber
+  ///
+  /// \param roc readout chamber
+  /// \param create if to create the sums if they do not exist
+  RunningSums* getRunningSums(ROC roc, bool create = kFALSE);
+
   /// dummy reset
   void resetEvent() final {}
 };
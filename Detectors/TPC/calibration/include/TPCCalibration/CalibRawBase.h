@@ -115,6 +115,10 @@ class CalibRawBase
   /// \param debugLevel debug level
   void setDebugLevel(int debugLevel = 1) { mDebugLevel = debugLevel; }
 
+  /// Set the number of threads used by the CRU raw readers to decode the links
+  /// \param nThreads number of threads
+  void setNThreads(int nThreads) { mRawReaderCRUManager.setNThreads(nThreads); }
+
   /// Rewind the events
   void rewindEvents();
 
@@ -87,6 +87,15 @@ class FastHisto
     mBinCont[index] += weight;
   }
 
+  /// this function adds the bin contents, including underflow and overflow, of a histogram with the same binning
+  /// \param other histogram which is added
+  void add(const FastHisto& other)
+  {
+    for (size_t i = 0; i < mBinCont.size(); i++) {
+      mBinCont[i] += other.mBinCont[i];
+    }
+  }
+
   /// this function prints out the histogram
   /// \param type printing type e.g 'vertical printing: type=0', 'horizontal printing: type=1'
   /// \param prec sets the precision of the x axis label
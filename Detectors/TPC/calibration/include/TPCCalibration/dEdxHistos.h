@@ -18,6 +18,7 @@
 
 #include <array>
 #include <gsl/span>
+#include <memory>
 #include <string_view>
 
 // o2 includes
@@ -52,6 +53,9 @@ class dEdxHistos
   /// Add counts from other container
   void merge(const dEdxHistos* other);
 
+  /// Empty container with the same binning and cuts, filled by a separate thread and merged to this one
+  std::unique_ptr<dEdxHistos> createSubContainer() const;
+
   /// Print the number of entries in each histogram
   void print() const;
 
@@ -12,6 +12,8 @@
 /// \file   CalibPedestal.cxx
 /// \author Jens Wiechula, Jens.Wiechula@ikf.uni-frankfurt.de
 
+#include <algorithm>
+#include <cmath>
 #include <fmt/format.h>
 
 #include "TH2F.h"
@@ -37,10 +39,12 @@ CalibPedestal::CalibPedestal(PadSubset padSubset)
     mStatisticsType(StatisticsType::GausFitFast),
     mPedestal("Pedestals", padSubset),
     mNoise("Noise", padSubset),
-    mADCdata()
+    mADCdata(),
+    mRunningSums()
 
 {
   mADCdata.resize(ROC::MaxROC);
+  mRunningSums.resize(ROC::MaxROC);
 }
 //______________________________________________________________________________
 void CalibPedestal::init()
@@ -68,6 +72,11 @@ Int_t CalibPedestal::updateROC(const Int_t roc, const Int_t row, const Int_t pad
   }
 
   const GlobalPadNumber padInROC = mMapper.getPadNumberInROC(PadROCPos(roc, row, pad));
+  if (mStatisticsType == StatisticsType::MeanStdDevOnline) {
+    getRunningSums(ROC(roc), kTRUE)->fill(padInROC, adcValue);
+    return 0;
+  }
+
   Int_t bin = padInROC * mNumberOfADCs + (adcValue - mADCMin);
   vectorType& adcVec = *getVector(ROC(roc), kTRUE);
   ++(adcVec[bin]);
@@ -95,11 +104,59 @@ CalibPedestal::vectorType* CalibPedestal::getVector(ROC roc, bool create /*=kFAL
   return vec;
 }
 
+//______________________________________________________________________________
+CalibPedestal::RunningSums* CalibPedestal::getRunningSums(ROC roc, bool create /*=kFALSE*/)
+{
+  auto sums = mRunningSums[roc].get();
+  if (sums || !create) {
+    return sums;
+  }
+
+  const size_t numberOfPads = (roc.rocType() == RocType::IROC) ? mMapper.getPadsInIROC() : mMapper.getPadsInOROC();
+
+  mRunningSums[roc] = std::make_unique<RunningSums>();
+  sums = mRunningSums[roc].get();
+  sums->resize(numberOfPads);
+
+  return sums;
+}
+
 //______________________________________________________________________________
 void CalibPedestal::analyse()
 {
   ROC roc;
 
+  if (mStatisticsType == StatisticsType::MeanStdDevOnline) {
+    for (auto& sumsPtr : mRunningSums) {
+      const auto sums = sumsPtr.get();
+      if (!sums) {
+        ++roc;
+        continue;
+      }
+
+      CalROC& calROCPedestal = mPedestal.getCalArray(roc);
+      CalROC& calROCNoise = mNoise.getCalArray(roc);
+
+      const size_t numberOfPads = sums->entries.size();
+      for (size_t ichannel = 0; ichannel < numberOfPads; ++ichannel) {
+        const auto entries = sums->entries[ichannel];
+        float pedestal{};
+        float noise{};
+        if (entries) {
+          const double mean = double(sums->sum[ichannel]) / entries;
+          pedestal = mean;
+          noise = std::sqrt(std::max(0., double(sums->sum2[ichannel]) / entries - mean * mean));
+        }
+
+        calROCPedestal.setValue(ichannel, pedestal);
+        calROCNoise.setValue(ichannel, noise);
+      }
+
+      ++roc;
+    }
+    return;
+  }
+
   std::vector<float> fitValues;
 
   for (auto& vecPtr : mADCdata) {
@@ -159,6 +216,11 @@ void CalibPedestal::resetData()
     }
     vec->clear();
   }
+  for (auto& sumsPtr : mRunningSums) {
+    if (sumsPtr) {
+      sumsPtr->resize(sumsPtr->entries.size());
+    }
+  }
 }
 
 //______________________________________________________________________________
@@ -177,6 +239,9 @@ void CalibPedestal::dumpToFile(const std::string filename, uint32_t type /* = 0*
 //______________________________________________________________________________
 TH2* CalibPedestal::createControlHistogram(ROC roc)
 {
+  if (!mADCdata[roc.getRoc()]) {
+    return nullptr;
+  }
   auto* data = mADCdata[roc.getRoc()]->data();
 
   const size_t numberOfPads = (roc.rocType() == RocType::IROC) ? mMapper.getPadsInIROC() : mMapper.getPadsInOROC();
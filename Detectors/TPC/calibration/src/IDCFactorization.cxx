@@ -314,15 +314,20 @@ void o2::tpc::IDCFactorization::calcIDCZero()
   mIDCZero.resize(Side::A, nIDCsSide);
   mIDCZero.resize(Side::C, nIDCsSide);
 
+  // the IDCs of one CRU are stored per integration interval contiguously and map to a contiguous range in the IDC0 storage
 #pragma omp parallel for num_threads(sNThreads)
   for (unsigned int cru = 0; cru < mIDCs.size(); ++cru) {
     const o2::tpc::CRU cruTmp(cru);
     const unsigned int region = cruTmp.region();
-    const auto factorIndexGlob = mRegionOffs[region] + mNIDCsPerSector * cruTmp.sector();
+    const unsigned int nIDCsCRU = mNIDCsPerCRU[region];
+    float* idcZero = mIDCZero.mIDCZero[cruTmp.side()].data() + (mRegionOffs[region] + mNIDCsPerSector * cruTmp.sector()) % nIDCsSide;
     for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
-      for (unsigned int idcs = 0; idcs < mIDCs[cru][timeframe].size(); ++idcs) {
-        const unsigned int indexGlob = (idcs % mNIDCsPerCRU[region]) + factorIndexGlob;
-        mIDCZero.fillValueIDCZero(mIDCs[cru][timeframe][idcs], cruTmp.side(), indexGlob % nIDCsSide);
+      const auto& idcsTF = mIDCs[cru][timeframe];
+      for (unsigned int offs = 0; offs < idcsTF.size(); offs += nIDCsCRU) {
+        const float* idcs = idcsTF.data() + offs;
+        for (unsigned int idx = 0; idx < nIDCsCRU; ++idx) {
+          idcZero[idx] += idcs[idx];
+        }
       }
     }
   }
@@ -340,21 +345,37 @@ void o2::tpc::IDCFactorization::calcIDCOne()
   mIDCOne.resize(Side::C, integrationIntervals);
   const unsigned int crusPerSide = Mapper::NREGIONS * SECTORSPERSIDE;
 
+  // all CRUs of one side contribute to the same IDC1 values: the contributions are accumulated per CRU and summed afterwards
+  std::vector<std::vector<float>> idcOneCRU(mIDCs.size());
+
 #pragma omp parallel for num_threads(sNThreads)
   for (unsigned int cru = 0; cru < mIDCs.size(); ++cru) {
     const o2::tpc::CRU cruTmp(cru);
     const unsigned int region = cruTmp.region();
-    const auto factorIDCOne = crusPerSide * mNIDCsPerCRU[region];
-    const auto side = cruTmp.side();
-    const auto factorIndexGlob = mRegionOffs[region] + mNIDCsPerSector * cruTmp.sector();
-    unsigned int integrationIntervallast = 0;
+    const unsigned int nIDCsCRU = mNIDCsPerCRU[region];
+    const auto factorIDCOne = crusPerSide * nIDCsCRU;
+    const float* idcZero = mIDCZero.mIDCZero[cruTmp.side()].data() + (mRegionOffs[region] + mNIDCsPerSector * cruTmp.sector()) % nIDCsSide;
+    auto& idcOne = idcOneCRU[cru];
+    idcOne.resize(integrationIntervals);
+    unsigned int integrationInterval = 0;
     for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
-      for (unsigned int idcs = 0; idcs < mIDCs[cru][timeframe].size(); ++idcs) {
-        const unsigned int integrationInterval = idcs / mNIDCsPerCRU[region] + integrationIntervallast;
-        const unsigned int indexGlob = (idcs % mNIDCsPerCRU[region]) + factorIndexGlob;
-        mIDCOne.mIDCOne[side][integrationInterval] += mIDCs[cru][timeframe][idcs] / (factorIDCOne * mIDCZero.mIDCZero[side][indexGlob % nIDCsSide]);
+      const auto& idcsTF = mIDCs[cru][timeframe];
+      for (unsigned int offs = 0; offs < idcsTF.size(); offs += nIDCsCRU, ++integrationInterval) {
+        const float* idcs = idcsTF.data() + offs;
+        float sum = 0;
+        for (unsigned int idx = 0; idx < nIDCsCRU; ++idx) {
+          sum += idcs[idx] / (factorIDCOne * idcZero[idx]);
+        }
+        idcOne[integrationInterval] = sum;
       }
-      integrationIntervallast += mIDCs[cru][timeframe].size() / mNIDCsPerCRU[region];
+    }
+  }
+
+  for (unsigned int cru = 0; cru < mIDCs.size(); ++cru) {
+    auto& idcOneSide = mIDCOne.mIDCOne[o2::tpc::CRU(cru).side()];
+    const auto& idcOne = idcOneCRU[cru];
+    for (unsigned int interval = 0; interval < integrationIntervals; ++interval) {
+      idcOneSide[interval] += idcOne[interval];
     }
   }
 }
@@ -373,33 +394,30 @@ void o2::tpc::IDCFactorization::calcIDCDelta()
     const o2::tpc::CRU cruTmp(cru);
     const unsigned int region = cruTmp.region();
     const auto side = cruTmp.side();
-    const auto factorIndexGlob = mRegionOffs[region] + mNIDCsPerSector * cruTmp.sector();
-    unsigned int integrationIntervallast = 0;
-    unsigned int integrationIntervallastLocal = 0;
+    const unsigned int nIDCsCRU = mNIDCsPerCRU[region];
+    const unsigned int offsIDCZero = (mRegionOffs[region] + mNIDCsPerSector * cruTmp.sector()) % nIDCsSide;
+    const float* idcZero = mIDCZero.mIDCZero[side].data() + offsIDCZero;
+    unsigned int integrationIntervalGlobal = 0;
+    unsigned int integrationIntervalLocal = 0;
     unsigned int lastChunk = 0;
 
     for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
       const unsigned int chunk = getChunk(timeframe);
       if (lastChunk != chunk) {
-        integrationIntervallastLocal = 0;
+        integrationIntervalLocal = 0;
       }
 
-      for (unsigned int idcs = 0; idcs < mIDCs[cru][timeframe].size(); ++idcs) {
-        const unsigned int intervallocal = idcs / mNIDCsPerCRU[region];
-        const unsigned int integrationIntervalGlobal = intervallocal + integrationIntervallast;
-        const unsigned int integrationIntervalLocal = intervallocal + integrationIntervallastLocal;
-        const unsigned int indexGlob = (idcs % mNIDCsPerCRU[region]) + factorIndexGlob;
-        const unsigned int indexGlobMod = indexGlob % nIDCsSide;
-        const auto idcZero = mIDCZero.mIDCZero[side][indexGlobMod];
+      const auto& idcsTF = mIDCs[cru][timeframe];
+      for (unsigned int offs = 0; offs < idcsTF.size(); offs += nIDCsCRU, ++integrationIntervalGlobal, ++integrationIntervalLocal) {
+        const float* idcs = idcsTF.data() + offs;
         const auto idcOne = mIDCOne.mIDCOne[side][integrationIntervalGlobal];
-        const auto mult = idcZero * idcOne;
-        const auto val = (mult > 0) ? mIDCs[cru][timeframe][idcs] / mult : 0;
-        mIDCDelta[chunk].setIDCDelta(side, indexGlobMod + integrationIntervalLocal * nIDCsSide, val - 1.f);
+        float* idcDelta = mIDCDelta[chunk].getIDCDelta(side).data() + offsIDCZero + integrationIntervalLocal * nIDCsSide;
+        for (unsigned int idx = 0; idx < nIDCsCRU; ++idx) {
+          const auto mult = idcZero[idx] * idcOne;
+          const auto val = (mult > 0) ? idcs[idx] / mult : 0;
+          idcDelta[idx] = val - 1.f;
+        }
       }
-
-      const unsigned int intervals = mIDCs[cru][timeframe].size() / mNIDCsPerCRU[region];
-      integrationIntervallast += intervals;
-      integrationIntervallastLocal += intervals;
       lastChunk = chunk;
     }
   }
@@ -73,28 +73,39 @@ void o2::tpc::IDCFourierTransform<Type>::calcFourierCoefficientsNaive(const o2::
   // see: https://en.wikipedia.org/wiki/Discrete_Fourier_transform#Definitiona
   const bool add = mFourierCoefficients.getNCoefficientsPerTF() % 2;
   const unsigned int lastCoeff = mFourierCoefficients.getNCoefficientsPerTF() / 2;
+  const std::vector<float> idcOneExpanded{this->getExpandedIDCOne(side)}; // 1D-IDC values which will be used for the FFT
+
+  // the phase coeff * index * 2pi / rangeIDC is periodic in rangeIDC: precalculate the cos and sin values once
+  const unsigned int rangeIDC = this->mRangeIDC;
+  std::vector<float> cosTerm(rangeIDC);
+  std::vector<float> sinTerm(rangeIDC);
+  for (unsigned int index = 0; index < rangeIDC; ++index) {
+    const float term = o2::constants::math::TwoPI * index / rangeIDC;
+    cosTerm[index] = std::cos(term);
+    sinTerm[index] = std::sin(term);
+  }
+  const unsigned int nCoeff = lastCoeff + add;
 
 #pragma omp parallel for num_threads(sNThreads)
   for (unsigned int interval = 0; interval < this->getNIntervals(); ++interval) {
-    const std::vector<float>& idcOneExpanded{this->getExpandedIDCOne(side)}; // 1D-IDC values which will be used for the FFT
-    for (unsigned int coeff = 0; coeff < lastCoeff; ++coeff) {
-      const unsigned int indexDataReal = mFourierCoefficients.getIndex(interval, 2 * coeff); // index for storing real fourier coefficient
-      const unsigned int indexDataImag = indexDataReal + 1;                                  // index for storing complex fourier coefficient
-      const float term0 = o2::constants::math::TwoPI * coeff / this->mRangeIDC;
-      for (unsigned int index = 0; index < this->mRangeIDC; ++index) {
-        const float term = term0 * index;
-        const float idc0 = idcOneExpanded[index + offsetIndex[interval]];
-        mFourierCoefficients(side, indexDataReal) += idc0 * std::cos(term);
-        mFourierCoefficients(side, indexDataImag) -= idc0 * std::sin(term);
+    const float* idcs = idcOneExpanded.data() + offsetIndex[interval];
+    for (unsigned int coeff = 0; coeff < nCoeff; ++coeff) {
+      float real = 0;
+      float imag = 0;
+      const unsigned int step = coeff % rangeIDC;
+      unsigned int phase = 0; // (coeff * index) % rangeIDC
+      for (unsigned int index = 0; index < rangeIDC; ++index) {
+        real += idcs[index] * cosTerm[phase];
+        imag -= idcs[index] * sinTerm[phase];
+        phase += step;
+        if (phase >= rangeIDC) {
+          phase -= rangeIDC;
+        }
       }
-    }
-    if (add) {
-      const unsigned int indexDataReal = mFourierCoefficients.getIndex(interval, 2 * lastCoeff); // index for storing real fourier coefficient
-      const float term0 = o2::constants::math::TwoPI * lastCoeff / this->mRangeIDC;
-      for (unsigned int index = 0; index < this->mRangeIDC; ++index) {
-        const float term = term0 * index;
-        const float idc0 = idcOneExpanded[index + offsetIndex[interval]];
-        mFourierCoefficients(side, indexDataReal) += idc0 * std::cos(term);
+      const unsigned int indexDataReal = mFourierCoefficients.getIndex(interval, 2 * coeff); // index for storing real fourier coefficient
+      mFourierCoefficients(side, indexDataReal) = real;
+      if (coeff < lastCoeff) {
+        mFourierCoefficients(side, indexDataReal + 1) = imag; // index for storing complex fourier coefficient
       }
     }
   }
@@ -13,6 +13,7 @@
 
 #include <array>
 #include <cstddef>
+#include <memory>
 #include <string_view>
 #include <utility>
 
@@ -53,14 +54,18 @@ void dEdxHistos::fill(const gsl::span<const TrackTPC> tracks)
 void dEdxHistos::merge(const dEdxHistos* other)
 {
   for (size_t i = 0; i < mHist.size(); i++) {
-    const auto binCount = mHist[i].getNBins();
-    for (size_t bin = 0; bin < binCount; bin++) {
-      float bin_content = other->getHists()[i].getBinContent(bin);
-      mHist[i].fillBin(bin, bin_content);
-    }
+    mHist[i].add(other->getHists()[i]);
+    mEntries[i] += other->mEntries[i];
   }
 }
 
+std::unique_ptr<dEdxHistos> dEdxHistos::createSubContainer() const
+{
+  auto sub = std::make_unique<dEdxHistos>(mHist[0].getNBins(), mCuts);
+  sub->setApplyCuts(mApplyCuts);
+  return sub;
+}
+
 void dEdxHistos::print() const
 {
   LOG(INFO) << "Total number of entries: " << mEntries[0] << " in A side, " << mEntries[1] << " in C side";
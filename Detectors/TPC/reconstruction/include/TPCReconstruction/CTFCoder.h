@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <functional>
 #include <string>
 #include <cassert>
 #include <tuple>
@@ -139,6 +140,9 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   bool getCombineColumns() const { return mCombineColumns; }
   void setCombineColumns(bool v) { mCombineColumns = v; }
 
+  int getNThreads() const { return mNThreads; }
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+
  private:
   void checkDataDictionaryConsistency(const CTFHeader& h);
 
@@ -149,6 +153,7 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   void buildCoder(ctf::CTFCoderBase::OpType coderType, const CTF::container_t& ctf, CTF::Slots slot);
 
   bool mCombineColumns = false; // combine correlated columns
+  int mNThreads = 1;            // number of threads for the entropy encoding of the blocks
 
   ClassDefNV(CTFCoder, 1);
 };
@@ -218,9 +223,21 @@ void CTFCoder::encode(VEC& buff, const CompressedClusters& ccl)
   ec->getANSHeader().majorVersion = 0;
   ec->getANSHeader().minorVersion = 1;
 
-  auto encodeTPC = [&buff, &optField, &coders = mCoders](auto begin, auto end, CTF::Slots slot, size_t probabilityBits) {
-    // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
+  // with several threads the blocks are entropy-coded concurrently to standalone buffers and then stored in slot order
+  const bool parallelEncoding = mNThreads > 1;
+  std::vector<CTF::PreparedBlock> prepared(parallelEncoding ? CTF::getNBlocks() : 0);
+  std::vector<std::function<void()>> encodingJobs;
+  const auto ansHeader = ec->getANSHeader();
+
+  auto encodeTPC = [&buff, &optField, &coders = mCoders, &prepared, &encodingJobs, &ansHeader, parallelEncoding](auto begin, auto end, CTF::Slots slot, size_t probabilityBits) {
     const auto slotVal = static_cast<int>(slot);
+    if (parallelEncoding) {
+      encodingJobs.emplace_back([&prepared, &optField, &ansHeader, coder = coders[slotVal].get(), begin, end, slotVal, probabilityBits]() {
+        prepared[slotVal] = CTF::prepare(begin, end, probabilityBits, optField[slotVal], ansHeader, coder);
+      });
+      return;
+    }
+    // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
     CTF::get(buff.data())->encode(begin, end, slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal].get());
   };
 
@@ -286,6 +303,17 @@ void CTFCoder::encode(VEC& buff, const CompressedClusters& ccl)
 
   encodeTPC(ccl.nTrackClusters, ccl.nTrackClusters + ccl.nTracks, CTF::BLCnTrackClusters, 0);
   encodeTPC(ccl.nSliceRowClusters, ccl.nSliceRowClusters + ccl.nSliceRows, CTF::BLCnSliceRowClusters, 0);
+
+  if (parallelEncoding) {
+    const int nJobs = encodingJobs.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+    for (int i = 0; i < nJobs; i++) {
+      encodingJobs[i]();
+    }
+    CTF::get(buff.data())->store(prepared, &buff);
+  }
   CTF::get(buff.data())->print(getPrefix());
 }
 
@@ -63,6 +63,10 @@
 /// y-axis: global pad number
 /// In this example, the fourth timeslice is the interesting one. Here, local maxima and clusters are found. After this slice has been processed, the first slice will be dropped and another slice will be added at the last position (seventh position).
 /// Afterwards, the algorithm looks for clusters in the middle time slice.
+/// The memory of the dropped slice is reused for the new one, only the cells
+/// which were filled are reset, such that the map is updated incrementally.
+/// Since the search for a given central slice only depends on the slices around it,
+/// the time range of a sector can be split into chunks which are processed independently.
 ///
 /// How to use (see macro: findKrBoxCluster.C):
 /// Create KrBoxClusterFinder object
@@ -86,7 +90,6 @@
 #include <tuple>
 #include <vector>
 #include <array>
-#include <deque>
 #include <gsl/span>
 
 namespace o2
@@ -179,6 +182,11 @@ class KrBoxClusterFinder
     loopOverSector(gsl::span(eventSector.data(), eventSector.size()), sector);
   }
 
+  /// Only search for clusters with their maximum in the time bins [firstTimeBin, lastTimeBin).
+  /// The digits of the full sector, sorted in time, must be given.
+  /// Processing consecutive ranges gives the same clusters as processing the full sector at once.
+  void loopOverSector(const gsl::span<const Digit> eventSector, const int sector, int firstTimeBin, int lastTimeBin);
+
  private:
   // These variables can be varied
   // They were choses such that the box in each readout chamber is approx. the same size
@@ -244,19 +252,52 @@ class KrBoxClusterFinder
   /// x-axis: Timeslice number
   /// y-axis: Pad number
   /// Time slice four is the interesting one. In there, local maxima are found and clusters are built from it. After it is processed, timeslice number 1 will be dropped and another timeslice will be put at the end of the set.
-  std::deque<TimeSliceSector> mSetOfTimeSlices{};
-
-  /// count the number of ADC values in each slice which satisfy the condition for the minumum Qmax
-  std::deque<int> mNumADCwithMinQmax{};
 
-  void createInitialMap(const gsl::span<const Digit> eventSector);
-  void popFirstTimeSliceFromMap()
+  /// It is a ring buffer, dropping the first timeslice moves its memory to the end of the set.
+  class SetOfTimeSlices
   {
-    mSetOfTimeSlices.pop_front();
-    mNumADCwithMinQmax.pop_front();
-  }
-  void fillADCValueInLastSlice(int cru, int rowInSector, int padInRow, float adcValue);
-  void addTimeSlice(const gsl::span<const Digit> eventSector, const int timeSlice);
+   public:
+    /// set the number of timeslices and clear all of them
+    void reset(size_t nSlices);
+
+    TimeSliceSector& operator[](size_t i) { return mSlices[slot(i)]; }
+    const TimeSliceSector& operator[](size_t i) const { return mSlices[slot(i)]; }
+    size_t size() const { return mSlices.size(); }
+
+    /// set the ADC value of a cell of the timeslice i
+    void fill(size_t i, int row, int pad, float adcValue)
+    {
+      const auto iSlot = slot(i);
+      mSlices[iSlot][row][pad] = adcValue;
+      mFilledCells[iSlot].emplace_back(row * MaxPads + pad);
+    }
+
+    /// count the number of ADC values in each slice which satisfy the condition for the minumum Qmax
+    int& numADCwithMinQmax(size_t i) { return mNumADCwithMinQmax[slot(i)]; }
+
+    /// drop the first timeslice and add an empty one at the end
+    void rotate();
+
+   private:
+    size_t slot(size_t i) const
+    {
+      const auto iSlot = mFirst + i;
+      return iSlot < mSlices.size() ? iSlot : iSlot - mSlices.size();
+    }
+    void clearSlot(size_t iSlot);
+
+    std::vector<TimeSliceSector> mSlices{};
+    std::vector<std::vector<unsigned short>> mFilledCells{}; ///< cells (row * MaxPads + pad) of each slice which are not zero
+    std::vector<int> mNumADCwithMinQmax{};
+    size_t mFirst = 0; ///< slot of the first timeslice
+  };
+  SetOfTimeSlices mSetOfTimeSlices{}; //!
+
+  void createInitialMap(const gsl::span<const Digit> eventSector, const int firstTimeSlice = 0);
+  void popFirstTimeSliceFromMap() { mSetOfTimeSlices.rotate(); }
+  void fillADCValueInSlice(int iSlice, int cru, int rowInSector, int padInRow, float adcValue);
+  /// fill the digits of the time bin timeSlice into the timeslice iSlice of the set
+  void addTimeSlice(const gsl::span<const Digit> eventSector, const int timeSlice, const int iSlice);
 
   /// For each ROC, the maximum cluster size has to be chosen
   void setMaxClusterSize(int row);
@@ -89,19 +89,29 @@ class ADCRawData
  public:
   using DataVector = std::vector<uint32_t>;
 
-  /// default ctor. Resesrve 520 time bins per stream
-  ADCRawData()
+  /// default ctor. The buffers are preallocated for numTimeBins time bins per stream
+  ADCRawData(uint32_t numTimeBins = 520) { allocate(numTimeBins); }
+
+  /// preallocate the buffers for numTimeBins time bins of the 16 channels per stream
+  void allocate(uint32_t numTimeBins)
   {
     for (auto& data : mADCRaw) {
-      data.reserve(520 * 16);
+      if (data.size() < numTimeBins * 16) {
+        data.resize(numTimeBins * 16);
+      }
     }
   }
 
   /// add a stream
   void add(int stream, uint32_t v0, uint32_t v1)
   {
-    mADCRaw[stream].emplace_back(v0);
-    mADCRaw[stream].emplace_back(v1);
+    auto& data = mADCRaw[stream];
+    auto& nValues = mNumValues[stream];
+    if (nValues + 2 > data.size()) {
+      data.resize(std::max(size_t(32), 2 * data.size()));
+    }
+    data[nValues++] = v0;
+    data[nValues++] = v1;
   };
 
   /// select the stream for which data should be processed
@@ -112,15 +122,15 @@ class ADCRawData
   /// limit.
   void setNumTimebins(uint32_t numTB)
   {
-    if (numTB >= mADCRaw[mOutputStream].size()) {
-      mNumTimeBins = mADCRaw[mOutputStream].size();
+    if (numTB >= mNumValues[mOutputStream]) {
+      mNumTimeBins = mNumValues[mOutputStream];
     } else {
       mNumTimeBins = numTB;
     }
   };
 
   /// number of time bin for selected stream
-  uint32_t getNumTimebins() const { return mADCRaw[mOutputStream].size(); };
+  uint32_t getNumTimebins() const { return mNumValues[mOutputStream]; };
 
   /// write data to ostream
   void streamTo(std::ostream& output) const;
@@ -132,8 +142,8 @@ class ADCRawData
     return output;
   }
 
-  /// get the data vector for a specific stream
-  const DataVector& getDataVector(int stream) const { return mADCRaw[stream]; }
+  /// get the data of a specific stream, 16 channels per time bin
+  gsl::span<const uint32_t> getDataVector(int stream) const { return gsl::span<const uint32_t>(mADCRaw[stream].data(), mNumValues[stream]); }
 
   /// overloading output stream operator to output ADCRawData
   friend std::ostream& operator<<(std::ostream& output, const ADCRawData& rawData);
@@ -143,15 +153,13 @@ class ADCRawData
   {
     mOutputStream = 0;
     mNumTimeBins = 0;
-    for (auto& data : mADCRaw) {
-      data.clear();
-    }
+    mNumValues.fill(0);
   }
 
   bool hasData() const
   {
-    for (auto& data : mADCRaw) {
-      if (data.size()) {
+    for (auto nValues : mNumValues) {
+      if (nValues) {
         return true;
       }
     }
@@ -159,10 +167,11 @@ class ADCRawData
   }
 
  private:
-  uint32_t mOutputStream{0};           // variable to set the output stream for the << operator
-  uint32_t mNumTimeBins{0};            // variable to set the number of timebins for the << operator
-  std::array<DataVector, 5> mADCRaw{}; // array of 5 vectors to hold the raw ADC data for each stream
-};                                     // class ADCRawData
+  uint32_t mOutputStream{0};            // variable to set the output stream for the << operator
+  uint32_t mNumTimeBins{0};             // variable to set the number of timebins for the << operator
+  std::array<DataVector, 5> mADCRaw{};  // array of 5 preallocated buffers to hold the raw ADC data for each stream
+  std::array<uint32_t, 5> mNumValues{}; // number of ADC values filled in each buffer
+};                                      // class ADCRawData
 
 //==============================================================================
 /// \class SyncPosition
@@ -570,6 +579,9 @@ class RawReaderCRU
     }
   }
 
+  /// destructor, unmapping the input file
+  ~RawReaderCRU();
+
   /**
    * Exception class for decoder error
    */
@@ -605,6 +617,12 @@ class RawReaderCRU
   /// set the reader number in the manager
   void setReaderNumber(uint32_t readerNumber) { mReaderNumber = readerNumber; }
 
+  /// set the number of threads used to decode the GBT data of different links
+  void setNThreads(int n);
+
+  /// get the number of threads
+  int getNThreads() const { return mNThreads; }
+
   /// set filling of ADC data map
   void setFillADCdataMap(bool fill) { mFillADCdataMap = fill; }
 
@@ -634,9 +652,13 @@ class RawReaderCRU
 
   /// Process data from memory for a single link
   /// The data must be collected before, merged over 8k packets
-  int processMemory(const std::vector<std::byte>& data, ADCRawData& rawData);
+  int processMemory(const std::vector<std::byte>& data, ADCRawData& rawData, int link);
 
   /// process links
+  ///
+  /// In case of GBT data the links are decoded concurrently with mNThreads (if the input file
+  /// could be memory mapped). The decoded data are filled to the ADC map and passed to the
+  /// ADC data callback in the order of the links.
   void processLinks(const uint32_t linkMask = 0);
 
   /// find sync positions for all links
@@ -709,6 +731,9 @@ class RawReaderCRU
     return mFileHandle;
   }
 
+  /// input file mapped to memory, empty if it could not be mapped
+  gsl::span<const std::byte> getMappedFile();
+
   //===========================================================================
   //===| Nested helper classes |===============================================
   //
@@ -809,6 +834,8 @@ class RawReaderCRU
   bool mFillADCdataMap = true;                              ///< fill the ADC data map
   bool mForceCRU = false;                                   ///< force CRU: overwrite value from RDH
   bool mFileIsScanned = false;                              ///< if file was already scanned
+  bool mMapFailed = false;                                  ///< if the memory mapping of the input file failed
+  int mNThreads = 1;                                        ///< number of threads to decode the links
   std::array<uint32_t, MaxNumberOfLinks> mPacketsPerLink;   ///< array to keep track of the number of packets per link
   std::bitset<MaxNumberOfLinks> mLinkPresent;               ///< info if link is present in data; information retrieved from scanning the RDH headers
   PacketDescriptorMapArray mPacketDescriptorMaps;           ///< array to hold vectors thhe packet descriptors
@@ -821,8 +848,17 @@ class RawReaderCRU
 
   std::ifstream mFileHandle; ///< file handle for input file
 
+  const std::byte* mMappedData{nullptr}; //!< input file mapped to memory
+  size_t mMappedSize{0};                 //!< size of the mapping
+
+  std::vector<std::vector<std::byte>> mLinkGBTData; //!< GBT data collected per link, kept to reuse the memory
+  std::vector<ADCRawData> mLinkRawData;             //!< decoded data per link, kept to reuse the memory
+
   /// collect raw GBT data
-  void collectGBTData(std::vector<std::byte>& data);
+  void collectGBTData(int link, std::vector<std::byte>& data);
+
+  /// collect and decode the GBT data of a link
+  void decodeLink(int link, std::vector<std::byte>& data, ADCRawData& rawData);
 
   /// fill adc data to output map
   void fillADCdataMap(const ADCRawData& rawData);
@@ -976,6 +1012,7 @@ class RawReaderCRUManager
   {
     mRawReadersCRU.emplace_back(std::make_unique<RawReaderCRU>(inputFileName, numTimeBins, 0, stream, debugLevel, verbosity, outputFilePrefix, mRawReadersCRU.size()));
     mRawReadersCRU.back()->setManager(this);
+    mRawReadersCRU.back()->setNThreads(mNThreads);
     return *mRawReadersCRU.back().get();
   }
 
@@ -1072,6 +1109,15 @@ class RawReaderCRUManager
   /// get LinkZSCallback
   LinkZSCallback getLinkZSCallback() { return mLinkZSCallback; }
 
+  /// set the number of threads of all readers to decode their links
+  void setNThreads(int n)
+  {
+    mNThreads = n;
+    for (auto& reader : mRawReadersCRU) {
+      reader->setNThreads(n);
+    }
+  }
+
   /// process event calling mADCDataCallback to process values
   void processEvent(uint32_t eventNumber, EndReaderCallback endReader = nullptr);
 
@@ -1083,6 +1129,7 @@ class RawReaderCRUManager
   RAWDataType mRawDataType{RAWDataType::GBT};                  ///< raw data type
   bool mDetectDataType{true};                                  ///< try to detect data types
   bool mIsInitialized{false};                                  ///< if init was called already
+  int mNThreads{1};                                            ///< number of threads of the readers
   ADCDataCallback mADCDataCallback{nullptr};                   ///< callback function for filling the ADC data
   LinkZSCallback mLinkZSCallback{nullptr};                     ///< callback for decoded linkZS data
 
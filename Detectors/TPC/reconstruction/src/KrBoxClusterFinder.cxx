@@ -20,10 +20,25 @@
 #include "Framework/Logger.h"
 
 #include <TFile.h>
+#include <algorithm>
 #include <vector>
 
 using namespace o2::tpc;
 
+namespace
+{
+/// check if any of the n charges is above the threshold
+/// written without early exit such that the compiler can vectorize it
+bool hasChargeAbove(const float* charges, int n, float threshold)
+{
+  bool above = false;
+  for (int i = 0; i < n; ++i) {
+    above |= charges[i] > threshold;
+  }
+  return above;
+}
+} // namespace
+
 // If a gain map already exists in form of a CalDet file, it can be specified here
 void KrBoxClusterFinder::loadGainMapFromFile(const std::string_view calDetFileName, const std::string_view gainMapName)
 {
@@ -38,20 +53,51 @@ void KrBoxClusterFinder::loadGainMapFromFile(const std::string_view calDetFileNa
   LOGP(info, "Loaded gain map object '{}' from file '{}'", calDetFileName, gainMapName);
 }
 
-void KrBoxClusterFinder::createInitialMap(const gsl::span<const Digit> eventSector)
+void KrBoxClusterFinder::SetOfTimeSlices::reset(size_t nSlices)
 {
-  mSetOfTimeSlices.clear();
-  mNumADCwithMinQmax.clear();
+  if (mSlices.size() != nSlices) {
+    mSlices.assign(nSlices, TimeSliceSector{});
+    mFilledCells.assign(nSlices, {});
+    mNumADCwithMinQmax.assign(nSlices, 0);
+  } else {
+    for (size_t iSlot = 0; iSlot < nSlices; ++iSlot) {
+      clearSlot(iSlot);
+    }
+  }
+  mFirst = 0;
+}
 
-  for (int iTimeSlice = 0; iTimeSlice <= 2 * mMaxClusterSizeTime; ++iTimeSlice) {
-    addTimeSlice(eventSector, iTimeSlice);
+void KrBoxClusterFinder::SetOfTimeSlices::rotate()
+{
+  // the first slice becomes the last one, only the cells which were filled have to be reset
+  clearSlot(mFirst);
+  mFirst = slot(1);
+}
+
+void KrBoxClusterFinder::SetOfTimeSlices::clearSlot(size_t iSlot)
+{
+  auto& timeSlice = mSlices[iSlot];
+  for (const auto cell : mFilledCells[iSlot]) {
+    timeSlice[cell / MaxPads][cell % MaxPads] = 0;
   }
+  mFilledCells[iSlot].clear();
+  mNumADCwithMinQmax[iSlot] = 0;
 }
 
-void KrBoxClusterFinder::fillADCValueInLastSlice(int cru, int rowInSector, int padInRow, float adcValue)
+void KrBoxClusterFinder::createInitialMap(const gsl::span<const Digit> eventSector, const int firstTimeSlice)
 {
-  auto& timeSlice = mSetOfTimeSlices.back();
+  mSetOfTimeSlices.reset(2 * mMaxClusterSizeTime + 1);
+
+  // skip the digits before the first time slice, they are sorted in time
+  mFirstDigit = std::lower_bound(eventSector.begin(), eventSector.end(), firstTimeSlice, [](const Digit& digit, int time) { return digit.getTimeStamp() < time; }) - eventSector.begin();
 
+  for (int iTimeSlice = 0; iTimeSlice <= 2 * mMaxClusterSizeTime; ++iTimeSlice) {
+    addTimeSlice(eventSector, firstTimeSlice + iTimeSlice, iTimeSlice);
+  }
+}
+
+void KrBoxClusterFinder::fillADCValueInSlice(int iSlice, int cru, int rowInSector, int padInRow, float adcValue)
+{
   // Correct for pad offset:
   const int padsInRow = mMapperInstance.getNumberOfPadsInRowSector(rowInSector);
   const int corPad = padInRow - (padsInRow / 2) + (MaxPads / 2);
@@ -59,7 +105,7 @@ void KrBoxClusterFinder::fillADCValueInLastSlice(int cru, int rowInSector, int p
   // Get correction factor from gain map:
   const auto correctionFactorCalDet = mGainMap.get();
   if (!correctionFactorCalDet) {
-    timeSlice[rowInSector][corPad] = adcValue;
+    mSetOfTimeSlices.fill(iSlice, rowInSector, corPad, adcValue);
     return;
   }
 
@@ -74,13 +120,12 @@ void KrBoxClusterFinder::fillADCValueInLastSlice(int cru, int rowInSector, int p
     adcValue /= correctionFactor;
   }
 
-  timeSlice[rowInSector][corPad] = adcValue;
+  mSetOfTimeSlices.fill(iSlice, rowInSector, corPad, adcValue);
 }
 
-void KrBoxClusterFinder::addTimeSlice(const gsl::span<const Digit> eventSector, const int timeSlice)
+void KrBoxClusterFinder::addTimeSlice(const gsl::span<const Digit> eventSector, const int timeSlice, const int iSlice)
 {
-  mSetOfTimeSlices.emplace_back();
-  auto& nADCminQmax = mNumADCwithMinQmax.emplace_back();
+  auto& nADCminQmax = mSetOfTimeSlices.numADCwithMinQmax(iSlice);
 
   for (; mFirstDigit < eventSector.size(); ++mFirstDigit) {
     const auto& digit = eventSector[mFirstDigit];
@@ -99,28 +144,38 @@ void KrBoxClusterFinder::addTimeSlice(const gsl::span<const Digit> eventSector,
       ++nADCminQmax;
     }
 
-    fillADCValueInLastSlice(cru, rowInSector, padInRow, adcValue);
+    fillADCValueInSlice(iSlice, cru, rowInSector, padInRow, adcValue);
   }
 }
 
 void KrBoxClusterFinder::loopOverSector(const gsl::span<const Digit> eventSector, const int sector)
 {
-  mFirstDigit = 0;
+  loopOverSector(eventSector, sector, mMaxClusterSizeTime, mMaxTimes - mMaxClusterSizeTime);
+}
+
+void KrBoxClusterFinder::loopOverSector(const gsl::span<const Digit> eventSector, const int sector, int firstTimeBin, int lastTimeBin)
+{
+  firstTimeBin = std::max(firstTimeBin, mMaxClusterSizeTime);
+  lastTimeBin = std::min(lastTimeBin, int(mMaxTimes) - mMaxClusterSizeTime);
   mSector = sector;
+  if (firstTimeBin >= lastTimeBin) {
+    return;
+  }
+
+  createInitialMap(eventSector, firstTimeBin - mMaxClusterSizeTime);
+  for (int iTimeSlice = firstTimeBin; iTimeSlice < lastTimeBin; ++iTimeSlice) {
+    // don't spend unnecessary time looping till mMaxTimes if there is no more data
+    // (checked before the slice is processed, such that any time range gives the same result as the full one)
+    if (iTimeSlice > mMaxClusterSizeTime && mFirstDigit >= eventSector.size()) {
+      break;
+    }
 
-  createInitialMap(eventSector);
-  for (int iTimeSlice = mMaxClusterSizeTime; iTimeSlice < mMaxTimes - mMaxClusterSizeTime; ++iTimeSlice) {
     // only search for a local maximum if the central time slice has at least one ADC above the charge threshold
-    if (mNumADCwithMinQmax[mMaxClusterSizeTime]) {
+    if (mSetOfTimeSlices.numADCwithMinQmax(mMaxClusterSizeTime)) {
       findLocalMaxima(true, iTimeSlice);
     }
     popFirstTimeSliceFromMap();
-    addTimeSlice(eventSector, iTimeSlice + mMaxClusterSizeTime + 1);
-
-    // don't spend unnecessary time looping till mMaxTimes if there is no more data
-    if (mFirstDigit >= eventSector.size()) {
-      break;
-    }
+    addTimeSlice(eventSector, iTimeSlice + mMaxClusterSizeTime + 1, 2 * mMaxClusterSizeTime);
   }
 }
 
@@ -235,9 +290,15 @@ std::vector<std::tuple<int, int, int>> KrBoxClusterFinder::findLocalMaxima(bool
 
     const auto& mapPad = mapRow[iRow];
     const int padsInRow = mMapperInstance.getNumberOfPadsInRowSector(iRow);
+    const int firstPad = MaxPads / 2 - padsInRow / 2;
+
+    // skip rows without any charge above the threshold of the cluster maximum
+    if (!hasChargeAbove(&mapPad[firstPad], 2 * (padsInRow / 2), mQThresholdMax)) {
+      continue;
+    }
 
     // Only loop over existing pads:
-    for (int iPad = MaxPads / 2 - padsInRow / 2; iPad < MaxPads / 2 + padsInRow / 2; iPad++) { // mapPad.size()
+    for (int iPad = firstPad; iPad < MaxPads / 2 + padsInRow / 2; iPad++) { // mapPad.size()
 
       const float qMax = mapPad[iPad];
 
@@ -301,22 +362,15 @@ std::vector<std::tuple<int, int, int>> KrBoxClusterFinder::findLocalMaxima(bool
       // -> only the maximum with the smalest indices will be accepted
       bool thisIsMax = true;
 
+      // the box always fits in the set of timeslices, only rows and pads have to be limited to the map
+      const int rowLow = std::max(iRow - mMaxClusterSizeRow, 0);
+      const int rowHigh = std::min(iRow + mMaxClusterSizeRow, int(MaxRows) - 1);
+      const int padLow = std::max(iPad - mMaxClusterSizePad, 0);
+      const int padHigh = std::min(iPad + mMaxClusterSizePad, int(MaxPads) - 1);
       for (int j = -mMaxClusterSizeTime; (j <= mMaxClusterSizeTime) && thisIsMax; j++) {
-        if ((iTime + j >= mMaxTimes) || (iTime + j < 0)) {
-          continue;
-        }
-        for (int k = -mMaxClusterSizeRow; (k <= mMaxClusterSizeRow) && thisIsMax; k++) {
-          if ((iRow + k >= MaxRows) || (iRow + k < 0)) {
-            continue;
-          }
-          for (int i = -mMaxClusterSizePad; (i <= mMaxClusterSizePad) && thisIsMax; i++) {
-            if ((iPad + i >= MaxPads) || (iPad + i < 0)) {
-              continue;
-            }
-            if (mSetOfTimeSlices[iTime + j][iRow + k][iPad + i] > qMax) {
-              thisIsMax = false;
-            }
-          }
+        const auto& timeSlice = mSetOfTimeSlices[iTime + j];
+        for (int k = rowLow; (k <= rowHigh) && thisIsMax; k++) {
+          thisIsMax = !hasChargeAbove(&timeSlice[k][padLow], padHigh - padLow + 1, qMax);
         }
       }
 
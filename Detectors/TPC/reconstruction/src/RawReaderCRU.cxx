@@ -15,6 +15,10 @@
 
 #include <fmt/format.h>
 #include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "TSystem.h"
 #include "TObjArray.h"
 
@@ -202,6 +206,50 @@ void RawReaderCRUEventSync::streamTo(std::ostream& output) const
   }
 }
 
+//==============================================================================
+RawReaderCRU::~RawReaderCRU()
+{
+  if (mMappedData) {
+    munmap(const_cast<std::byte*>(mMappedData), mMappedSize);
+  }
+}
+
+void RawReaderCRU::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  if (n > 1) {
+    LOG(WARNING) << "Multithreading is not supported, imposing single thread";
+  }
+  mNThreads = 1;
+#endif
+}
+
+gsl::span<const std::byte> RawReaderCRU::getMappedFile()
+{
+  if (!mMappedData && !mMapFailed) {
+    // the file is only read, the pages are loaded on first access and shared by the threads decoding the links
+    int fd = open(mInputFileName.c_str(), O_RDONLY);
+    struct stat st;
+    void* data = nullptr;
+    if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+      data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    if (fd >= 0) {
+      close(fd); // the mapping stays valid
+    }
+    if (data == MAP_FAILED || !data) {
+      LOGP(warning, "Failed to map file {}, reading it via file stream", mInputFileName);
+      mMapFailed = true;
+    } else {
+      mMappedData = reinterpret_cast<const std::byte*>(data);
+      mMappedSize = st.st_size;
+    }
+  }
+  return gsl::span<const std::byte>(mMappedData, mMappedSize);
+}
+
 //==============================================================================
 int RawReaderCRU::scanFile()
 {
@@ -530,7 +578,7 @@ int RawReaderCRU::processPacket(GBTFrame& gFrame, uint32_t startPos, uint32_t si
   return 0;
 }
 
-int RawReaderCRU::processMemory(const std::vector<std::byte>& data, ADCRawData& rawData)
+int RawReaderCRU::processMemory(const std::vector<std::byte>& data, ADCRawData& rawData, int link)
 {
   GBTFrame gFrame;
 
@@ -573,7 +621,7 @@ int RawReaderCRU::processMemory(const std::vector<std::byte>& data, ADCRawData&
       if (syncPos.synched()) {
         file << mEventNumber << "\t"
              << mCRU.number() << "\t"
-             << mLink << "\t"
+             << link << "\t"
              << s << "\t"
              << syncPos.getPacketNumber() << "\t"
              << syncPos.getFrameNumber() << "\t"
@@ -732,6 +780,21 @@ void RawReaderCRU::processDataMemory()
     std::cout << "Num packets : " << mPacketsPerLink[mLink] << std::endl;
   }
 
+  ADCRawData rawData(mNumTimeBins);
+  std::vector<std::byte> data;
+  decodeLink(mLink, data, rawData);
+
+  // ===| fill ADC data to the output structure |===
+  if (mFillADCdataMap) {
+    fillADCdataMap(rawData);
+  }
+  if (mManager->mADCDataCallback) {
+    runADCDataCallback(rawData);
+  }
+}
+
+void RawReaderCRU::decodeLink(int link, std::vector<std::byte>& data, ADCRawData& rawData)
+{
   size_t dataSize = 4000 * 16;
   //if (mDataType == DataType::HBScaling) {
   //dataSize =
@@ -741,38 +804,41 @@ void RawReaderCRU::processDataMemory()
   //dataSize = 4000 * 16;
   //}
 
-  std::vector<std::byte> data;
+  data.clear();
   data.reserve(dataSize);
-  collectGBTData(data);
-
-  ADCRawData rawData;
-  processMemory(data, rawData);
+  collectGBTData(link, data);
 
-  // ===| fill ADC data to the output structure |===
-  if (mFillADCdataMap) {
-    fillADCdataMap(rawData);
-  }
-  if (mManager->mADCDataCallback) {
-    runADCDataCallback(rawData);
-  }
+  rawData.reset();
+  rawData.allocate(mNumTimeBins);
+  processMemory(data, rawData, link);
 }
 
-void RawReaderCRU::collectGBTData(std::vector<std::byte>& data)
+void RawReaderCRU::collectGBTData(int link, std::vector<std::byte>& data)
 {
   const auto& linkInfoArray = mManager->mEventSync.getLinkInfoArrayForEvent(mEventNumber, mCRU);
-  auto& file = getFileHandle();
+  const auto mappedFile = getMappedFile();
 
   size_t presentDataPosition = 0;
 
   // loop over the packets for each link and process them
   //for (const auto& packet : mPacketDescriptorMaps[link]) {
-  for (auto packetNumber : linkInfoArray[mLink].PacketPositions) {
-    const auto& packet = mPacketDescriptorMaps[mLink][packetNumber];
+  for (auto packetNumber : linkInfoArray[link].PacketPositions) {
+    const auto& packet = mPacketDescriptorMaps[link][packetNumber];
 
     const auto payloadStart = packet.getPayloadOffset();
     const auto payloadSize = size_t(packet.getPayloadSize());
+    if (mappedFile.size()) {
+      if (payloadStart + payloadSize > mappedFile.size()) {
+        LOGP(error, "File truncated at {}, size {} would exceed file size of {}", payloadStart, payloadSize, mappedFile.size());
+        break;
+      }
+      data.insert(data.end(), mappedFile.data() + payloadStart, mappedFile.data() + payloadStart + payloadSize);
+      continue;
+    }
+
     data.insert(data.end(), payloadSize, (std::byte)0);
     // jump to the start position of the packet
+    auto& file = getFileHandle();
     file.seekg(payloadStart, std::ios::beg);
 
     // read data
@@ -829,20 +895,62 @@ void RawReaderCRU::processLinks(const uint32_t linkMask)
     // loop over the MaxNumberOfLinks potential links in the data
     // only if data from the link is present and selected
     // for decoding it will be decoded.
+    std::vector<int> links;
     for (int lnk = 0; lnk < MaxNumberOfLinks; lnk++) {
       // all links have been selected
       if (((linkMask == 0) || ((linkMask >> lnk) & 1)) && checkLinkPresent(lnk) == true) {
-        // set the active link variable and process the data
+        links.emplace_back(lnk);
+      }
+    }
+
+    if (mManager->mRawDataType != RAWDataType::GBT) {
+      for (const auto lnk : links) {
         if (mDebugLevel) {
           fmt::print("Processing link {}\n", lnk);
         }
         setLink(lnk);
-        if (mManager->mRawDataType == RAWDataType::GBT) {
-          //processDataFile();
-          processDataMemory();
-        } else {
-          processLinkZS();
-        }
+        processLinkZS();
+      }
+      return;
+    }
+
+    // the GBT frames of the links are independent and decoded concurrently, the decoded data
+    // are filled afterwards in the order of the links, as the output is not thread safe.
+    // Reading from the file stream or writing debug output imposes a single thread
+    const int nLinks = links.size();
+    const bool singleThread = !getMappedFile().size() || mVerbosity;
+    if (singleThread) {
+      getFileHandle();
+    }
+    if (mDebugLevel) {
+      for (const auto lnk : links) {
+        fmt::print("Processing link {}\n", lnk);
+      }
+    }
+    if (mLinkRawData.size() < size_t(nLinks)) {
+      mLinkRawData.resize(nLinks);
+      mLinkGBTData.resize(nLinks);
+    }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(singleThread ? 1 : mNThreads)
+#endif
+    for (int ilnk = 0; ilnk < nLinks; ilnk++) {
+      const int lnk = links[ilnk];
+      if (mVerbosity) {
+        std::cout << "Processing data for link " << lnk << std::endl;
+        std::cout << "Num packets : " << mPacketsPerLink[lnk] << std::endl;
+      }
+      decodeLink(lnk, mLinkGBTData[ilnk], mLinkRawData[ilnk]);
+    }
+
+    for (int ilnk = 0; ilnk < nLinks; ilnk++) {
+      // set the active link variable and fill the data
+      setLink(links[ilnk]);
+      if (mFillADCdataMap) {
+        fillADCdataMap(mLinkRawData[ilnk]);
+      }
+      if (mManager->mADCDataCallback) {
+        runADCDataCallback(mLinkRawData[ilnk]);
       }
     }
 
@@ -29,6 +29,8 @@
 #include "Riostream.h"
 #include "FairLogger.h"
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <iostream>
 #include <iomanip>
@@ -197,5 +199,55 @@ BOOST_AUTO_TEST_CASE(FastTransform_test_setSpaceChargeCorrection)
   BOOST_CHECK_MESSAGE(fabs(maxDeviation) < 1.e-2, "test of inverse correction map failed, max difference " << maxDeviation << " cm is too large");
 }
 
+BOOST_AUTO_TEST_CASE(FastTransform_test_TransformRow)
+{
+  auto correctionGlobal = [&](int roc, const double XYZ[3], double dXdYdZ[3]) {
+    dXdYdZ[0] = 0.1 + 0.001 * XYZ[1];
+    dXdYdZ[1] = 0.2 + 0.002 * XYZ[2];
+    dXdYdZ[2] = 0.3 + 0.001 * XYZ[0];
+  };
+  TPCFastTransformHelperO2::instance()->setSpaceChargeCorrection(correctionGlobal);
+  std::unique_ptr<TPCFastTransform> fastTransform(TPCFastTransformHelperO2::instance()->create(0));
+  const TPCFastTransformGeo& geo = fastTransform->getGeometry();
+
+  double maxDiff = 0;
+  int nDiffThreads = 0;
+  for (int correction = 0; correction < 2; correction++) {
+    if (correction) {
+      fastTransform->setApplyCorrectionOn();
+    } else {
+      fastTransform->setApplyCorrectionOff();
+    }
+    for (int slice = 0; slice < geo.getNumberOfSlices(); slice += 7) {
+      float lastTimeBin = fastTransform->getMaxDriftTime(slice, 0.f);
+      for (int row = 0; row < geo.getNumberOfRows(); row += 5) {
+        std::vector<float> pads, times;
+        for (float pad = 0; pad <= geo.getRowInfo(row).maxPad; pad += 3.3) {
+          for (float time = 0; time < lastTimeBin; time += 47.1) {
+            pads.push_back(pad);
+            times.push_back(time);
+          }
+        }
+        int n = pads.size();
+        std::vector<float> x(n), y(n), z(n);
+        fastTransform->TransformRow(slice, row, pads.data(), times.data(), x.data(), y.data(), z.data(), n, 2.f);
+        // Same thing, as it would be split among the threads of a GPU kernel
+        std::vector<float> xt(n), yt(n), zt(n);
+        for (int iThread = 0; iThread < 3; iThread++) {
+          fastTransform->TransformRow(slice, row, pads.data(), times.data(), xt.data(), yt.data(), zt.data(), n, 2.f, iThread, 3);
+        }
+        for (int i = 0; i < n; i++) {
+          float x0, y0, z0;
+          fastTransform->Transform(slice, row, pads[i], times[i], x0, y0, z0, 2.f);
+          maxDiff = std::max({maxDiff, double(std::fabs(x[i] - x0)), double(std::fabs(y[i] - y0)), double(std::fabs(z[i] - z0))});
+          nDiffThreads += (xt[i] != x[i]) || (yt[i] != y[i]) || (zt[i] != z[i]);
+        }
+      }
+    }
+  }
+  BOOST_CHECK_MESSAGE(maxDiff < 1.e-4, "TransformRow differs from Transform by " << maxDiff << " cm");
+  BOOST_CHECK_EQUAL(nDiffThreads, 0);
+}
+
 } // namespace tpc
 } // namespace o2
@@ -17,6 +17,8 @@
 #define ALICEO2_TPC_DigitContainer_H_
 
 #include <deque>
+#include <memory>
+#include <vector>
 #include "TPCBase/CRU.h"
 #include "DataFormatsTPC/Defs.h"
 #include "TPCSimulation/DigitTime.h"
@@ -81,11 +83,15 @@ class DigitContainer
   size_t size() const { return mTimeBins.size(); }
 
  private:
-  TimeBin mFirstTimeBin = 0;       ///< First time bin to consider
-  TimeBin mEffectiveTimeBin = 0;   ///< Effective time bin of that digit
-  TimeBin mTmaxTriggered = 0;      ///< Maximum time bin in case of triggered mode (hard cut at average drift speed with additional margin)
-  TimeBin mOffset;                 ///< Size of the container for one event
-  std::deque<DigitTime> mTimeBins; ///< Time bin Container for the ADC value
+  TimeBin mFirstTimeBin = 0;                             ///< First time bin to consider
+  TimeBin mEffectiveTimeBin = 0;                         ///< Effective time bin of that digit
+  TimeBin mTmaxTriggered = 0;                            ///< Maximum time bin in case of triggered mode (hard cut at average drift speed with additional margin)
+  TimeBin mOffset;                                       ///< Size of the container for one event
+  std::deque<std::unique_ptr<DigitTime>> mTimeBins;      ///< Time bin Container for the ADC value
+  std::vector<std::unique_ptr<DigitTime>> mTimeBinsPool; ///< Already flushed time bins, recycled to avoid allocations
+
+  /// Get a clean time bin, either from the pool or newly allocated
+  std::unique_ptr<DigitTime> getTimeBin();
 };
 
 inline DigitContainer::DigitContainer()
@@ -97,7 +103,19 @@ inline DigitContainer::DigitContainer()
 
   // always have 50 % contingency for the size of the container depending on the input
   mOffset = static_cast<TimeBin>(1.5 * detParam.TPClength / gasParam.DriftV / eleParam.ZbinWidth);
-  mTimeBins.resize(mOffset);
+  for (TimeBin i = 0; i < mOffset; ++i) {
+    mTimeBins.emplace_back(std::make_unique<DigitTime>());
+  }
+}
+
+inline std::unique_ptr<DigitTime> DigitContainer::getTimeBin()
+{
+  if (mTimeBinsPool.empty()) {
+    return std::make_unique<DigitTime>();
+  }
+  auto time = std::move(mTimeBinsPool.back());
+  mTimeBinsPool.pop_back();
+  return time;
 }
 
 inline void DigitContainer::reset()
@@ -105,14 +123,14 @@ inline void DigitContainer::reset()
   mFirstTimeBin = 0;
   mEffectiveTimeBin = 0;
   for (auto& time : mTimeBins) {
-    time.reset();
+    time->reset();
   }
 }
 
 inline void DigitContainer::reserve(TimeBin eventTimeBin)
 {
-  if (mTimeBins.size() < mOffset + eventTimeBin - mFirstTimeBin) {
-    mTimeBins.resize(mOffset + eventTimeBin - mFirstTimeBin);
+  while (mTimeBins.size() < mOffset + eventTimeBin - mFirstTimeBin) {
+    mTimeBins.emplace_back(getTimeBin());
   }
 }
 
@@ -120,7 +138,7 @@ inline void DigitContainer::addDigit(const MCCompLabel& label, const CRU& cru, T
                                      float signal)
 {
   mEffectiveTimeBin = timeBin - mFirstTimeBin;
-  mTimeBins[mEffectiveTimeBin].addDigit(label, cru, globalPad, signal);
+  mTimeBins[mEffectiveTimeBin]->addDigit(label, cru, globalPad, signal);
 }
 
 } // namespace tpc
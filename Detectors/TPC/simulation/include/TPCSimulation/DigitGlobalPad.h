@@ -118,6 +118,7 @@ inline void DigitGlobalPad::addDigit(const MCCompLabel& label, float signal,
 inline void DigitGlobalPad::reset()
 {
   mChargePad = 0;
+  mID = -1;
 }
 
 inline bool DigitGlobalPad::compareMClabels(const MCCompLabel& label1, const MCCompLabel& label2) const
@@ -16,6 +16,9 @@
 #ifndef ALICEO2_TPC_DigitTime_H_
 #define ALICEO2_TPC_DigitTime_H_
 
+#include <algorithm>
+#include <vector>
+
 #include "TPCBase/Mapper.h"
 #include "TPCSimulation/DigitGlobalPad.h"
 #include "SimulationDataFormat/LabelContainer.h"
@@ -44,7 +47,7 @@ class DigitTime
   /// Destructor
   ~DigitTime() = default;
 
-  /// Resets the container
+  /// Resets the container, only the pads which received a signal are touched
   void reset();
 
   /// Get common mode for a given GEM stack
@@ -80,9 +83,9 @@ class DigitTime
   std::array<float, GEMSTACKSPERSECTOR> mCommonMode;                 ///< Common mode container - 4 GEM ROCs per sector
   std::array<DigitGlobalPad, Mapper::getPadsInSector()> mGlobalPads; ///< Pad Container for the ADC value
   int mDigitCounter = 0;                                             ///< counts the number of digits in this timebin
+  std::vector<GlobalPadNumber> mOccupiedPads;                        ///< pads which received a signal in this time bin
 
   o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false> mLabels;
-  // std::deque<int> mOccupiedPads; // iterable container of occupied pads
 };
 
 inline DigitTime::DigitTime() : mCommonMode(), mGlobalPads()
@@ -97,7 +100,7 @@ inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, Global
   if (paddigit.getID() == -1) {
     // this means we have a new digit
     paddigit.setID(mDigitCounter++);
-    // could also register this pad in a vector of digits
+    mOccupiedPads.emplace_back(globalPad);
   }
   paddigit.addDigit(label, signal, mLabels);
   mCommonMode[cru.gemStack()] += signal;
@@ -105,9 +108,12 @@ inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, Global
 
 inline void DigitTime::reset()
 {
-  for (auto& pad : mGlobalPads) {
-    pad.reset();
+  for (auto globalPad : mOccupiedPads) {
+    mGlobalPads[globalPad].reset();
   }
+  mOccupiedPads.clear();
+  mLabels.clear();
+  mDigitCounter = 0;
   mCommonMode.fill(0.f);
 }
 
@@ -125,19 +131,20 @@ inline void DigitTime::fillOutputContainer(std::vector<Digit>& output, dataforma
                                            float commonMode)
 {
   static Mapper& mapper = Mapper::instance();
-  GlobalPadNumber globalPad = 0;
   for (size_t i = 0; i < mCommonMode.size(); ++i) {
     const float cm = getCommonMode(GEMstack(i));
     if (cm > 0.) {
       commonModeOutput.push_back({cm, timeBin, static_cast<unsigned char>(i)});
     }
   }
-  for (auto& pad : mGlobalPads) {
+  // only the occupied pads are visited, sorted to keep the digits ordered by pad number
+  std::sort(mOccupiedPads.begin(), mOccupiedPads.end());
+  for (auto globalPad : mOccupiedPads) {
+    auto& pad = mGlobalPads[globalPad];
     if (pad.getChargePad() > 0.) {
       const CRU cru = mapper.getCRU(sector, globalPad);
       pad.fillOutputContainer<MODE>(output, mcTruth, cru, timeBin, globalPad, mLabels, getCommonMode(cru));
     }
-    ++globalPad;
   }
 }
 } // namespace tpc
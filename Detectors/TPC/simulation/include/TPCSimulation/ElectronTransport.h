@@ -22,11 +22,31 @@
 #include "TPCBase/Mapper.h"
 #include "MathUtils/RandomRing.h"
 
+#include <vector>
+
 namespace o2
 {
 namespace tpc
 {
 
+/// \struct DriftedElectrons
+/// Positions and drift times of a group of electrons after the drift, as structure of arrays
+struct DriftedElectrons {
+  std::vector<float> x;         ///< x position after the drift
+  std::vector<float> y;         ///< y position after the drift
+  std::vector<float> z;         ///< z position after the drift
+  std::vector<float> driftTime; ///< drift time taking into account diffusion in z direction
+
+  void resize(size_t n)
+  {
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+    driftTime.resize(n);
+  }
+  size_t size() const { return x.size(); }
+};
+
 /// \class ElectronTransport
 /// This class handles the electron transport in the active volume of the TPC.
 /// In particular, in deals with the diffusion of the charge cloud while drifting towards the readout chambers and the
@@ -53,6 +73,13 @@ class ElectronTransport
   /// \return GlobalPosition3D with position of the electrons after the drift taking into account diffusion
   GlobalPosition3D getElectronDrift(GlobalPosition3D posEle, float& driftTime);
 
+  /// Drift of a group of electrons with the same start position in electric field taking into account diffusion
+  /// The random values are taken in bulk, the result is the same as for nElectrons calls of getElectronDrift
+  /// \param posEle GlobalPosition3D with start position of the electrons
+  /// \param nElectrons Number of electrons
+  /// \param drifted Positions and drift times of the electrons after the drift
+  void getElectronDrift(GlobalPosition3D posEle, int nElectrons, DriftedElectrons& drifted);
+
   /// Drift of electrons in electric field taking into account diffusion with 3 sigma of the width
   /// \param posEle GlobalPosition3D with start position of the electrons
   /// \return GlobalPosition3D with position of the electrons after the drift taking into account diffusion with
@@ -79,6 +106,8 @@ class ElectronTransport
   math_utils::RandomRing<> mRandomGaus;
   /// Circular random buffer containing flat random values to take into account electron attachment during drift
   math_utils::RandomRing<> mRandomFlat;
+  /// Buffer for the Gaussian random values of a group of electrons
+  std::vector<float> mGausBuffer;
 
   const ParameterDetector* mDetParam; ///< Caching of the parameter class to avoid multiple CDB calls
   const ParameterGas* mGasParam;      ///< Caching of the parameter class to avoid multiple CDB calls
@@ -64,6 +64,7 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
   const auto amplificationMode = gemParam.AmplMode;
   static std::vector<float> signalArray;
   signalArray.resize(nShapedPoints);
+  static DriftedElectrons driftedElectrons;
 
   /// Reserve space in the digit container for the current event
   mDigitContainer.reserve(sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset));
@@ -92,15 +93,17 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
       /// The energy loss stored corresponds to nElectrons
       const int nPrimaryElectrons = static_cast<int>(eh.GetEnergyLoss());
       const float hitTime = eh.GetTime() * 0.001; /// in us
-      float driftTime = 0.f;
 
       /// TODO: add primary ions to space-charge density
 
+      /// Drift and Diffusion of all electrons of the hit
+      electronTransport.getElectronDrift(posEle, nPrimaryElectrons, driftedElectrons);
+
       /// Loop over electrons
       for (int iEle = 0; iEle < nPrimaryElectrons; ++iEle) {
 
-        /// Drift and Diffusion
-        const GlobalPosition3D posEleDiff = electronTransport.getElectronDrift(posEle, driftTime);
+        const float driftTime = driftedElectrons.driftTime[iEle];
+        const GlobalPosition3D posEleDiff(driftedElectrons.x[iEle], driftedElectrons.y[iEle], driftedElectrons.z[iEle]);
         const float eleTime = driftTime + hitTime; /// in us
         if (eleTime > maxEleTime) {
           LOG(WARNING) << "Skipping electron with driftTime " << driftTime << " from hit at time " << hitTime;
@@ -66,6 +66,40 @@ GlobalPosition3D ElectronTransport::getElectronDrift(GlobalPosition3D posEle, fl
   return posEleDiffusion;
 }
 
+void ElectronTransport::getElectronDrift(GlobalPosition3D posEle, int nElectrons, DriftedElectrons& drifted)
+{
+  /// For drift lengths shorter than 1 mm, the drift length is set to that value
+  float driftl = mDetParam->TPClength - std::abs(posEle.Z());
+  if (driftl < 0.01) {
+    driftl = 0.01;
+  }
+  driftl = std::sqrt(driftl);
+  const float sigT = driftl * mGasParam->DiffT;
+  const float sigL = driftl * mGasParam->DiffL;
+
+  /// The random values are taken in the same order as by the single electron drift (x, y, z per electron)
+  const size_t n = nElectrons > 0 ? nElectrons : 0;
+  drifted.resize(n);
+  mGausBuffer.resize(3 * n);
+  mRandomGaus.getNextValues(mGausBuffer.data(), mGausBuffer.size());
+
+  const float x = posEle.X(), y = posEle.Y(), z = posEle.Z();
+  const float* gaus = mGausBuffer.data();
+  float* xOut = drifted.x.data();
+  float* yOut = drifted.y.data();
+  float* zOut = drifted.z.data();
+  float* timeOut = drifted.driftTime.data();
+  for (size_t i = 0; i < n; ++i) {
+    xOut[i] = (gaus[3 * i] * sigT) + x;
+    yOut[i] = (gaus[3 * i + 1] * sigT) + y;
+    const float zDiff = (gaus[3 * i + 2] * sigL) + z;
+    /// In case of a sign change in z, the old z position is kept and the drift time is elongated, as for a single electron
+    const bool sideChange = z / zDiff < 0.f;
+    timeOut[i] = getDriftTime(zDiff, sideChange ? -1.f : 1.f);
+    zOut[i] = sideChange ? z : zDiff;
+  }
+}
+
 bool ElectronTransport::isCompletelyOutOfSectorCoarseElectronDrift(GlobalPosition3D posEle, const Sector& sector) const
 {
   /// For drift lengths shorter than 1 mm, the drift length is set to that value
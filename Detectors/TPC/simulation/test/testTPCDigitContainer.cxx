@@ -167,5 +167,43 @@ BOOST_AUTO_TEST_CASE(DigitContainer_test2)
     BOOST_CHECK_CLOSE(commonMode[i].getCommonMode(), chargeSum[i] / nPads, 1E-6);
   }
 }
+
+/// \brief Test of the DigitContainer
+/// The container is filled and flushed twice for the same voxel, the time bins recycled after the first flush
+/// must not carry over any charge or MC label to the second one
+BOOST_AUTO_TEST_CASE(DigitContainer_test3)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  o2::conf::ConfigurableParam::updateFromString("TPCEleParam.DigiMode=3"); // propagate the ADC values, otherwise the computation get complicated
+  const Mapper& mapper = Mapper::instance();
+  DigitContainer digitContainer;
+  digitContainer.reset();
+
+  const CRU cru(0);
+  const TimeBin time = 231;
+  const GlobalPadNumber globalPad = mapper.getPadNumberInROC(PadROCPos(cru.roc(), PadPos(12, 1)));
+  const std::vector<int> MCtrack = {22, 3};
+  const std::vector<int> nEle = {60, 100};
+
+  for (int iter = 0; iter < MCtrack.size(); ++iter) {
+    digitContainer.reset();
+    digitContainer.reserve(0);
+    digitContainer.addDigit(MCCompLabel(MCtrack[iter], 1, 0, false), cru, time, globalPad, nEle[iter]);
+
+    std::vector<Digit> digitsArray;
+    dataformats::MCTruthContainer<MCCompLabel> mcTruthArray;
+    std::vector<o2::tpc::CommonMode> commonMode;
+    digitContainer.fillOutputContainer(digitsArray, mcTruthArray, commonMode, 0, 0, true, true);
+
+    BOOST_CHECK(digitsArray.size() == 1);
+    BOOST_CHECK(digitContainer.size() == 0);
+    BOOST_CHECK_CLOSE(digitsArray[0].getChargeFloat(), nEle[iter], 1E-6);
+    BOOST_CHECK(digitsArray[0].getTimeStamp() == time);
+    const auto& mcArray = mcTruthArray.getLabels(0);
+    BOOST_CHECK(mcArray.size() == 1);
+    BOOST_CHECK(mcArray[0].getTrackID() == MCtrack[iter]);
+  }
+}
 } // namespace tpc
 } // namespace o2
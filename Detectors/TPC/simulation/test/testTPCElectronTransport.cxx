@@ -121,6 +121,32 @@ BOOST_AUTO_TEST_CASE(ElectronDiffusion_test2)
   BOOST_CHECK_CLOSE(gausZ.GetParameter(2), gasParam.DiffL, 0.5);
 }
 
+/// \brief Test of the bulk getElectronDrift function
+/// The bulk drift must give the same electrons as the drift of single electrons.
+/// The bulk drift traverses the ring of Gaussian random values completely (three
+/// values per electron), so that the single electrons start from the same values.
+/// The start position is close to the central electrode to include side changes.
+///
+/// Precision: 0.0001 %.
+BOOST_AUTO_TEST_CASE(ElectronDiffusion_bulk)
+{
+  static ElectronTransport& electronTransport = ElectronTransport::instance();
+  const GlobalPosition3D posEle(10.f, 10.f, 0.2f);
+  const int nElectrons = 400000; // size of the random ring
+  DriftedElectrons drifted;
+  electronTransport.getElectronDrift(posEle, nElectrons, drifted);
+  BOOST_CHECK_EQUAL(drifted.size(), size_t(nElectrons));
+
+  float driftTime = 0.f;
+  for (int i = 0; i < 10000; ++i) {
+    const GlobalPosition3D posEleDiff = electronTransport.getElectronDrift(posEle, driftTime);
+    BOOST_CHECK_CLOSE(drifted.x[i], posEleDiff.X(), 1e-4);
+    BOOST_CHECK_CLOSE(drifted.y[i], posEleDiff.Y(), 1e-4);
+    BOOST_CHECK_CLOSE(drifted.z[i], posEleDiff.Z(), 1e-4);
+    BOOST_CHECK_CLOSE(drifted.driftTime[i], driftTime, 1e-4);
+  }
+}
+
 /// \brief Test of the isElectronAttachment function
 /// We let the electrons drift for 100 us and compare the fraction
 /// of lost electrons to the expected value
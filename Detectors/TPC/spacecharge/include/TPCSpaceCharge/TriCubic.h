@@ -40,6 +40,8 @@ namespace tpc
 /// In this method in a first step 64 coefficients are computed by using a predefined 64*64 matrix.
 /// These coefficients have to be computed for each cell in the grid, but are only computed when querying a point in a given cell.
 /// The calculated coefficient is then stored for only the last cell and will be reused if the next query point lies in the same cell.
+/// Optionally the coefficients of all cells can be precomputed (precomputeCoefficients()). This costs 64 values of memory per grid vertex,
+/// but avoids computing the coefficients whenever the query moves to another cell.
 ///
 /// Additionally the classical one dimensional approach of interpolating values is implemented. This algorithm is faster when interpolating only a few values inside each cube.
 ///
@@ -160,6 +162,30 @@ class TriCubicInterpolator
     return evalDerivative(relPos[0], relPos[1], relPos[2], derz, derr, derphi);
   }
 
+  /// interpolate values for a batch of points
+  /// \param z z coordinates
+  /// \param r r coordinates
+  /// \param phi phi coordinates
+  /// \param values output array for the interpolated values
+  /// \param nPoints number of points
+  /// \param type interpolation algorithm
+  void operator()(const DataT* z, const DataT* r, const DataT* phi, DataT* values, const size_t nPoints, const InterpolationType type = InterpolationType::Sparse) const
+  {
+    for (size_t i = 0; i < nPoints; ++i) {
+      values[i] = operator()(z[i], r[i], phi[i], type);
+    }
+  }
+
+  /// precompute the coefficients of all the cells of the grid, which are then used by the dense interpolation and the derivatives.
+  /// This needs 64 values of type DataT per grid vertex (e.g. 1.5 GB for double precision and a 129*129*180 grid)
+  void precomputeCoefficients();
+
+  /// release the precomputed coefficients
+  void clearPrecomputedCoefficients() { mCoefficientsTable.reset(); }
+
+  /// \return returns true if the coefficients of all the cells are precomputed
+  bool hasPrecomputedCoefficients() const { return mCoefficientsTable != nullptr; }
+
   /// set which type of extrapolation is used at the grid boundaries (linear or parabol can be used with periodic phi axis and non periodic z and r axis).
   /// \param extrapolationType sets type of extrapolation. See enum ExtrapolationType for different types
   void setExtrapolationType(const ExtrapolationType extrapolationType) { mExtrapolationType = extrapolationType; }
@@ -260,6 +286,7 @@ class TriCubicInterpolator
   std::unique_ptr<Vector<DataT, FDim>[]> mLastInd = std::make_unique<Vector<DataT, FDim>[]>(sNThreads);  ///< stores the index for the cell, where the coefficients are already evaluated (only the coefficients for the last cell are stored)
   std::unique_ptr<bool[]> mInitialized = std::make_unique<bool[]>(sNThreads);                            ///< sets the flag if the coefficients are evaluated at least once
   ExtrapolationType mExtrapolationType = ExtrapolationType::Parabola;                                    ///< sets which type of extrapolation for missing points at boundary is used. Linear and Parabola is only supported for perdiodic phi axis and non periodic z and r axis
+  std::unique_ptr<Vector<DataT, 64>[]> mCoefficientsTable;                                               ///< optional precomputed coefficients of all cells, stored in the same order as the grid data
 
   //                 DEFINITION OF enum GridPos
   //========================================================
@@ -321,6 +348,16 @@ class TriCubicInterpolator
   // this is the 'slow' part of the code and might be optimized
   void calcCoefficients(const unsigned int iz, const unsigned int ir, const unsigned int iphi) const;
 
+  /// \return returns the coefficients of the last queried cell, either precomputed or computed for the current thread
+  const Vector<DataT, 64>& getCoefficients() const
+  {
+    if (!mCoefficientsTable) {
+      return mCoefficients[sThreadnum];
+    }
+    const auto& ind = mLastInd[sThreadnum];
+    return mCoefficientsTable[DataContainer::getDataIndex(static_cast<size_t>(ind[FZ]), static_cast<size_t>(ind[FR]), static_cast<size_t>(ind[FPHI]))];
+  }
+
   DataT interpolateDense(const Vector<DataT, 3>& pos) const;
 
   // interpolate value at given coordinate - this method doesnt compute and stores the coefficients and is faster when quering only a few values per cube
@@ -389,13 +426,14 @@ template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 DataT TriCubicInterpolator<DataT, Nz, Nr, Nphi>::evalDerivative(const DataT dz, const DataT dr, const DataT dphi, const size_t derz, const size_t derr, const size_t derphi) const
 {
   //TODO optimize this
+  const auto& coefficients = getCoefficients();
   DataT ret{};
   for (size_t i = derz; i < 4; i++) {
     for (size_t j = derr; j < 4; j++) {
       for (size_t k = derphi; k < 4; k++) {
 
         const size_t index = i + j * 4 + 16 * k;
-        DataT cont = mCoefficients[sThreadnum][index] * std::pow(dz, i - derz) * std::pow(dr, j - derr) * std::pow(dphi, k - derphi);
+        DataT cont = coefficients[index] * std::pow(dz, i - derz) * std::pow(dr, j - derr) * std::pow(dphi, k - derphi);
         for (size_t w = 0; w < derz; w++) {
           cont *= (i - w);
         }
@@ -518,6 +556,26 @@ void TriCubicInterpolator<DataT, Nz, Nr, Nphi>::calcCoefficients(const unsigned
   mCoefficients[sThreadnum] = sMatrixA * matrixPar;
 }
 
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void TriCubicInterpolator<DataT, Nz, Nr, Nphi>::precomputeCoefficients()
+{
+  auto table = std::make_unique<Vector<DataT, 64>[]>(DataContainer::getNDataPoints());
+#pragma omp parallel for num_threads(sNThreads)
+  for (size_t iphi = 0; iphi < Nphi; ++iphi) {
+    for (size_t ir = 0; ir < Nr - 1; ++ir) {
+      for (size_t iz = 0; iz < Nz - 1; ++iz) {
+        calcCoefficients(iz, ir, iphi);
+        table[DataContainer::getDataIndex(iz, ir, iphi)] = mCoefficients[sThreadnum];
+      }
+    }
+  }
+  // the per thread coefficients do not correspond any more to the last queried cell
+  for (int i = 0; i < sNThreads; ++i) {
+    mInitialized[i] = false;
+  }
+  mCoefficientsTable = std::move(table);
+}
+
 template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 DataT TriCubicInterpolator<DataT, Nz, Nr, Nphi>::interpolateDense(const Vector<DataT, 3>& pos) const
 {
@@ -551,7 +609,7 @@ DataT TriCubicInterpolator<DataT, Nz, Nr, Nphi>::interpolateDense(const Vector<D
      valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3], valZ[3]}};
 
   // result = f(z,r,phi) = \sum_{i,j,k=0}^3 a_{ijk}    * z^{i}   * r^{j}   * phi^{k}
-  const DataT result = sum(mCoefficients[sThreadnum] * vecValX * vecValY * vecValZ);
+  const DataT result = sum(getCoefficients() * vecValX * vecValY * vecValZ);
   return result;
 }
 
@@ -608,9 +666,9 @@ const Vector<DataT, 3> TriCubicInterpolator<DataT, Nz, Nr, Nphi>::processInp(con
 
   const Vector<DataT, FDim> index{floor(posRel)};
 
-  if (!sparse && (!mInitialized[sThreadnum] || !(mLastInd[sThreadnum] == index))) {
+  if (!sparse && !mCoefficientsTable && (!mInitialized[sThreadnum] || !(mLastInd[sThreadnum] == index))) {
     initInterpolator(index[FZ], index[FR], index[FPHI]);
-  } else if (sparse) {
+  } else if (sparse || mCoefficientsTable) {
     mLastInd[sThreadnum][FZ] = index[FZ];
     mLastInd[sThreadnum][FR] = index[FR];
     mLastInd[sThreadnum][FPHI] = index[FPHI];
@@ -981,6 +981,7 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::interp3D(Vector& matricesCurrentV, cons
 {
   // Do restrict 2 D for each slice
   if (newPhiSlice == 2 * oldPhiSlice) {
+#pragma omp parallel for num_threads(sNThreads) // each iteration only writes the slices m and m + 1
     for (int m = 0; m < newPhiSlice; m += 2) {
       // assuming no symmetry
       int mm = m * 0.5;
@@ -1087,6 +1088,7 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::addInterp3D(Vector& matricesCurrentV, c
 {
   // Do restrict 2 D for each slice
   if (newPhiSlice == 2 * oldPhiSlice) {
+#pragma omp parallel for num_threads(sNThreads) // each iteration only writes the slices m and m + 1
     for (int m = 0; m < newPhiSlice; m += 2) {
       // assuming no symmetry
       int mm = m * 0.5;
@@ -1195,8 +1197,13 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::relax3D(Vector& matricesCurrentV, const
   // Gauss-Seidel (Read Black}
   if (MGParameters::relaxType == RelaxType::GaussSeidel) {
     // for each slice
+    // in each pass only the points of one colour are updated, reading only the points of the other colour,
+    // so the phi slices are independent. The only exception is the periodic case with an odd number of slices,
+    // for which the first and the last slices have the same colour and are neighbours
+    const bool parallelPhi = (symmetry != 0) || (iPhi % 2 == 0);
     for (int iPass = 1; iPass <= 2; ++iPass) {
       const int msw = (iPass % 2) ? 1 : 2;
+#pragma omp parallel for num_threads(sNThreads) if (parallelPhi)
       for (int m = 0; m < iPhi; ++m) {
         const int jsw = ((msw + m) % 2) ? 1 : 2;
         int mp1 = m + 1;
@@ -1361,8 +1368,9 @@ template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 void PoissonSolver<DataT, Nz, Nr, Nphi>::restrict3D(Vector& matricesCurrentCharge, const Vector& residue, const int tnRRow, const int tnZColumn, const int newPhiSlice, const int oldPhiSlice) const
 {
   if (2 * newPhiSlice == oldPhiSlice) {
-    int mm = 0;
-    for (int m = 0; m < newPhiSlice; m++, mm += 2) {
+#pragma omp parallel for num_threads(sNThreads) // each iteration only writes the slice m
+    for (int m = 0; m < newPhiSlice; m++) {
+      const int mm = 2 * m;
       // assuming no symmetry
       int mp1 = mm + 1;
       int mm1 = mm - 1;
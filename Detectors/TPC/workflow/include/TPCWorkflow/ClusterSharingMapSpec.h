@@ -28,7 +28,11 @@ class ClusterSharingMapSpec : public o2::framework::Task
 {
  public:
   ~ClusterSharingMapSpec() override = default;
+  void init(framework::InitContext& ic) final;
   void run(framework::ProcessingContext& pc) final;
+
+ private:
+  int mNThreads = 1;
 };
 
 o2::framework::DataProcessorSpec getClusterSharingMapSpec()
@@ -46,7 +50,8 @@ o2::framework::DataProcessorSpec getClusterSharingMapSpec()
     inputs,
     outputs,
     o2::framework::AlgorithmSpec{o2::framework::adaptFromTask<ClusterSharingMapSpec>()},
-    o2::framework::Options{}};
+    o2::framework::Options{
+      {"nthreads", o2::framework::VariantType::Int, 1, {"number of threads filling the sharing map"}}}};
 }
 
 } // namespace tpc
@@ -20,6 +20,11 @@
 #include <vector>
 #include <fmt/format.h>
 #include <limits>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #include "Framework/Task.h"
 #include "Framework/ControlService.h"
 #include "Framework/Logger.h"
@@ -46,7 +51,9 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
   TPCFactorizeIDCSpec(const std::vector<uint32_t>& crus, const unsigned int timeframes, const unsigned int timeframesDeltaIDC, std::array<unsigned char, Mapper::NREGIONS> groupPads,
                       std::array<unsigned char, Mapper::NREGIONS> groupRows, std::array<unsigned char, Mapper::NREGIONS> groupLastRowsThreshold,
                       std::array<unsigned char, Mapper::NREGIONS> groupLastPadsThreshold, const IDCDeltaCompression compression, const bool debug = false, const bool senddebug = false)
-    : mCRUs{crus}, mIDCFactorization{groupPads, groupRows, groupLastRowsThreshold, groupLastPadsThreshold, timeframes, timeframesDeltaIDC}, mCompressionDeltaIDC{compression}, mDebug{debug}, mSendOutDebug{senddebug} {};
+    : mCRUs{crus}, mIDCFactorization{std::make_unique<IDCFactorization>(groupPads, groupRows, groupLastRowsThreshold, groupLastPadsThreshold, timeframes, timeframesDeltaIDC)}, mCompressionDeltaIDC{compression}, mDebug{debug}, mSendOutDebug{senddebug} {};
+
+  ~TPCFactorizeIDCSpec() override { stopWorker(); }
 
   void init(o2::framework::InitContext& ic) final
   {
@@ -58,9 +65,20 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
     // write struct containing grouping parameters to access grouped IDCs to CCDB
     if (mWriteToDB && mUpdateGroupingPar) {
       // validity for grouping parameters is from first TF to some really large TF (until it is updated) TODO do somewhere else?!
-      mDBapi.storeAsTFileAny<o2::tpc::ParameterIDCGroupCCDB>(&mIDCFactorization.getGroupingParameter(), "TPC/Calib/IDC/GROUPINGPAR", mMetadata, getFirstTF(), std::numeric_limits<uint32_t>::max());
+      mDBapi.storeAsTFileAny<o2::tpc::ParameterIDCGroupCCDB>(&mIDCFactorization->getGroupingParameter(), "TPC/Calib/IDC/GROUPINGPAR", mMetadata, getFirstTF(), std::numeric_limits<uint32_t>::max());
       mUpdateGroupingPar = false; // write grouping parameters only once
     }
+
+    // the factorization and the storage of the aggregation intervals can be done by a worker thread, while the next interval is aggregated
+    mMaxPendingIntervals = std::max(0, ic.options().get<int>("max-pending-intervals"));
+    if (mMaxPendingIntervals && mSendOutDebug) {
+      LOGP(warning, "sending the factorized IDCs requires the factorization in the processing thread, ignoring max-pending-intervals={}", mMaxPendingIntervals);
+      mMaxPendingIntervals = 0;
+    }
+    if (mMaxPendingIntervals) {
+      LOGP(info, "factorizing in a worker thread with up to {} pending aggregation intervals", mMaxPendingIntervals);
+      mWorker = std::thread(&TPCFactorizeIDCSpec::processIntervals, this);
+    }
   }
 
   void run(o2::framework::ProcessingContext& pc) final
@@ -74,31 +92,35 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
       const DataRef ref = pc.inputs().getByPos(i);
       auto const* tpcCRUHeader = o2::framework::DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
       const int cru = tpcCRUHeader->subSpecification - mLaneId * CRU::MaxCRU;
-      mIDCFactorization.setIDCs(pc.inputs().get<std::vector<float>>(ref), cru, mProcessedTFs); // aggregate IDCs
+      mIDCFactorization->setIDCs(pc.inputs().get<std::vector<float>>(ref), cru, mProcessedTFs); // aggregate IDCs
     }
     ++mProcessedTFs;
 
-    if (!(mProcessedTFs % ((mIDCFactorization.getNTimeframes() + 5) / 5))) {
+    if (!(mProcessedTFs % ((mIDCFactorization->getNTimeframes() + 5) / 5))) {
       LOGP(info, "aggregated TFs: {}", mProcessedTFs);
     }
 
-    if (mProcessedTFs == mIDCFactorization.getNTimeframes()) {
-      mTFRange[1] = getCurrentTF(pc);    // set the TF for last aggregated TF
-      mProcessedTFs = 0;                 // reset processed TFs for next aggregation interval
-      mIDCFactorization.factorizeIDCs(); // calculate DeltaIDC, 0D-IDC, 1D-IDC
+    if (mProcessedTFs == mIDCFactorization->getNTimeframes()) {
+      mTFRange[1] = getCurrentTF(pc); // set the TF for last aggregated TF
+      mProcessedTFs = 0;              // reset processed TFs for next aggregation interval
 
-      if (mDebug) {
-        LOGP(info, "dumping aggregated and factorized IDCs and FT to file");
-        mIDCFactorization.dumpToFile(fmt::format("IDCFactorized_{:02}.root", getCurrentTF(pc)).data());
+      if (mMaxPendingIntervals) {
+        queueInterval();
+      } else {
+        mIDCFactorization->factorizeIDCs(); // calculate DeltaIDC, 0D-IDC, 1D-IDC
+        if (mSendOutDebug) {
+          sendOutputDebug(pc.outputs(), *mIDCFactorization);
+        }
+        storeInterval(*mIDCFactorization, mTFRange);
+        // reseting aggregated IDCs. This is done for safety, but if all data is received in the next aggregation interval it isnt necessary... remove it?
+        mIDCFactorization->reset();
       }
-
-      // storing to CCDB
-      sendOutput(pc.outputs());
     }
   }
 
   void endOfStream(o2::framework::EndOfStreamContext& ec) final
   {
+    stopWorker(); // the pending aggregation intervals are factorized and stored before quitting
     ec.services().get<ControlService>().readyToQuit(QuitRequest::Me);
   }
 
@@ -107,18 +129,32 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
   static constexpr header::DataDescription getDataDescriptionIDCDelta() { return header::DataDescription{"IDCDELTA"}; }
 
  private:
-  const std::vector<uint32_t> mCRUs{};              ///< CRUs to process in this instance
-  int mProcessedTFs{0};                             ///< number of processed time frames to keep track of when the writing to CCDB will be done
-  IDCFactorization mIDCFactorization{};             ///< object aggregating the IDCs and performing the factorization of the IDCs
-  const IDCDeltaCompression mCompressionDeltaIDC{}; ///< compression type for IDC Delta
-  const bool mDebug{false};                         ///< dump IDCs to tree for debugging
-  const bool mSendOutDebug{false};                  ///< flag if the output will be send (for debugging)
-  o2::ccdb::CcdbApi mDBapi;                         ///< API for storing the IDCs in the CCDB
-  std::map<std::string, std::string> mMetadata;     ///< meta data of the stored object in CCDB
-  bool mWriteToDB{};                                ///< flag if writing to CCDB will be done
-  std::array<uint32_t, 2> mTFRange{};               ///< storing of first and last TF used when setting the validity of the objects when writing to CCDB
-  bool mUpdateGroupingPar{true};                    ///< flag to set if grouping parameters should be updated or not
-  int mLaneId{0};                                   ///< the id of the current process within the parallel pipeline
+  /// aggregated IDCs of one aggregation interval waiting for the factorization
+  struct PendingInterval {
+    std::unique_ptr<IDCFactorization> idcs{}; ///< aggregated IDCs
+    std::array<uint32_t, 2> tfRange{};        ///< first and last TF of the aggregation interval
+  };
+
+  const std::vector<uint32_t> mCRUs{};                    ///< CRUs to process in this instance
+  int mProcessedTFs{0};                                   ///< number of processed time frames to keep track of when the writing to CCDB will be done
+  std::unique_ptr<IDCFactorization> mIDCFactorization{};  ///< object aggregating the IDCs and performing the factorization of the IDCs
+  const IDCDeltaCompression mCompressionDeltaIDC{};       ///< compression type for IDC Delta
+  const bool mDebug{false};                               ///< dump IDCs to tree for debugging
+  const bool mSendOutDebug{false};                        ///< flag if the output will be send (for debugging)
+  o2::ccdb::CcdbApi mDBapi;                               ///< API for storing the IDCs in the CCDB
+  std::map<std::string, std::string> mMetadata;           ///< meta data of the stored object in CCDB
+  bool mWriteToDB{};                                      ///< flag if writing to CCDB will be done
+  std::array<uint32_t, 2> mTFRange{};                     ///< storing of first and last TF used when setting the validity of the objects when writing to CCDB
+  bool mUpdateGroupingPar{true};                          ///< flag to set if grouping parameters should be updated or not
+  int mLaneId{0};                                         ///< the id of the current process within the parallel pipeline
+  unsigned int mMaxPendingIntervals{0};                   ///< max. number of aggregation intervals waiting for the worker thread (0: factorization in the processing thread)
+  std::deque<PendingInterval> mPendingIntervals{};        ///< aggregation intervals waiting for the factorization, in the order of the TFs
+  std::vector<std::unique_ptr<IDCFactorization>> mFree{}; ///< objects of already stored aggregation intervals, reused for the aggregation
+  std::mutex mMutex;                                      ///< protects mPendingIntervals, mFree and mStopWorker
+  std::condition_variable mCondPending;                   ///< signals a pending aggregation interval or the stop to the worker thread
+  std::condition_variable mCondFree;                      ///< signals a stored aggregation interval to the processing thread
+  std::thread mWorker;                                    ///< thread factorizing and storing the pending aggregation intervals
+  bool mStopWorker{false};                                ///< flag to stop the worker thread once all pending intervals are stored
 
   /// \return returns TF of current processed data
   uint32_t getCurrentTF(o2::framework::ProcessingContext& pc) const { return o2::framework::DataRefUtils::getHeader<o2::header::DataHeader*>(pc.inputs().getFirstValid(true))->tfCounter; }
@@ -126,58 +162,111 @@ class TPCFactorizeIDCSpec : public o2::framework::Task
   /// \return returns first TF for validity range when storing to CCDB
   uint32_t getFirstTF() const { return mTFRange[0]; }
 
-  /// \return returns last TF for validity range when storing to CCDB
-  uint32_t getLastTF() const { return mTFRange[1]; }
-
   /// \return returns first TF for validity range when storing to IDCDelta CCDB
-  unsigned int getFirstTFDeltaIDC(const unsigned int iChunk) const { return getFirstTF() + iChunk * mIDCFactorization.getTimeFramesDeltaIDC(); }
+  static unsigned int getFirstTFDeltaIDC(const IDCFactorization& idcs, const std::array<uint32_t, 2>& tfRange, const unsigned int iChunk) { return tfRange[0] + iChunk * idcs.getTimeFramesDeltaIDC(); }
 
   /// \return returns last TF for validity range when storing to IDCDelta CCDB
-  unsigned int getLastTFDeltaIDC(const unsigned int iChunk) const { return (iChunk == mIDCFactorization.getNChunks() - 1) ? (mIDCFactorization.getNTimeframes() - 1 + getFirstTF()) : (getFirstTFDeltaIDC(iChunk) + mIDCFactorization.getTimeFramesDeltaIDC() - 1); }
+  static unsigned int getLastTFDeltaIDC(const IDCFactorization& idcs, const std::array<uint32_t, 2>& tfRange, const unsigned int iChunk) { return (iChunk == idcs.getNChunks() - 1) ? (idcs.getNTimeframes() - 1 + tfRange[0]) : (getFirstTFDeltaIDC(idcs, tfRange, iChunk) + idcs.getTimeFramesDeltaIDC() - 1); }
+
+  /// hand the aggregated IDCs over to the worker thread and continue the aggregation with a free object
+  void queueInterval()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    // the aggregation waits only if the worker thread is more than mMaxPendingIntervals aggregation intervals behind
+    if (mPendingIntervals.size() >= mMaxPendingIntervals) {
+      LOGP(warning, "{} aggregation intervals are waiting for the factorization, waiting before aggregating TFs after {}", mPendingIntervals.size(), mTFRange[1]);
+      mCondFree.wait(lock, [this] { return mPendingIntervals.size() < mMaxPendingIntervals; });
+    }
+    const auto& par = mIDCFactorization->getGroupingParameter();
+    auto next = mFree.empty() ? std::make_unique<IDCFactorization>(par.GroupPads, par.GroupRows, par.GroupLastRowsThreshold, par.GroupLastPadsThreshold, mIDCFactorization->getNTimeframes(), mIDCFactorization->getTimeFramesDeltaIDC()) : std::move(mFree.back());
+    if (!mFree.empty()) {
+      mFree.pop_back();
+    }
+    mPendingIntervals.push_back(PendingInterval{std::move(mIDCFactorization), mTFRange});
+    mIDCFactorization = std::move(next);
+    LOGP(info, "queued the factorization of TFs {}-{}, {} aggregation intervals pending", mTFRange[0], mTFRange[1], mPendingIntervals.size());
+    lock.unlock();
+    mCondPending.notify_one();
+  }
+
+  /// worker thread: factorize and store the pending aggregation intervals in the order of the TFs
+  void processIntervals()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+      mCondPending.wait(lock, [this] { return !mPendingIntervals.empty() || mStopWorker; });
+      if (mPendingIntervals.empty()) {
+        break;
+      }
+      auto& interval = mPendingIntervals.front(); // stays in place until stored: push_back does not invalidate references to the front of a deque
+      lock.unlock();
+      interval.idcs->factorizeIDCs();
+      storeInterval(*interval.idcs, interval.tfRange);
+      interval.idcs->reset();
+      lock.lock();
+      mFree.push_back(std::move(interval.idcs));
+      mPendingIntervals.pop_front();
+      mCondFree.notify_one();
+    }
+  }
+
+  /// factorize and store the pending aggregation intervals and stop the worker thread
+  void stopWorker()
+  {
+    if (!mWorker.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStopWorker = true;
+    }
+    mCondPending.notify_one();
+    mWorker.join();
+  }
 
   /// send output to next device for debugging
-  void sendOutputDebug(DataAllocator& output)
+  static void sendOutputDebug(DataAllocator& output, const IDCFactorization& idcs)
   {
-    output.snapshot(Output{gDataOriginTPC, TPCFactorizeIDCSpec::getDataDescriptionIDC0()}, mIDCFactorization.getIDCZero());
-    output.snapshot(Output{gDataOriginTPC, TPCFactorizeIDCSpec::getDataDescriptionIDC1()}, mIDCFactorization.getIDCOne());
-    for (unsigned int iChunk = 0; iChunk < mIDCFactorization.getNChunks(); ++iChunk) {
-      output.snapshot(Output{gDataOriginTPC, TPCFactorizeIDCSpec::getDataDescriptionIDCDelta(), o2::header::DataHeader::SubSpecificationType{iChunk}, Lifetime::Timeframe}, mIDCFactorization.getIDCDeltaUncompressed(iChunk));
+    output.snapshot(Output{gDataOriginTPC, TPCFactorizeIDCSpec::getDataDescriptionIDC0()}, idcs.getIDCZero());
+    output.snapshot(Output{gDataOriginTPC, TPCFactorizeIDCSpec::getDataDescriptionIDC1()}, idcs.getIDCOne());
+    for (unsigned int iChunk = 0; iChunk < idcs.getNChunks(); ++iChunk) {
+      output.snapshot(Output{gDataOriginTPC, TPCFactorizeIDCSpec::getDataDescriptionIDCDelta(), o2::header::DataHeader::SubSpecificationType{iChunk}, Lifetime::Timeframe}, idcs.getIDCDeltaUncompressed(iChunk));
     }
   }
 
-  void sendOutput(DataAllocator& output)
+  /// dump the factorized IDCs for debugging and store them to the CCDB
+  void storeInterval(const IDCFactorization& idcs, const std::array<uint32_t, 2>& tfRange)
   {
-    if (mSendOutDebug) {
-      sendOutputDebug(output);
+    if (mDebug) {
+      LOGP(info, "dumping aggregated and factorized IDCs and FT to file");
+      idcs.dumpToFile(fmt::format("IDCFactorized_{:02}.root", tfRange[1]).data());
     }
 
     if (mWriteToDB) {
-      const long timeStampStart = getFirstTF();
-      const long timeStampEnd = getLastTF();
-      mDBapi.storeAsTFileAny<o2::tpc::IDCZero>(&mIDCFactorization.getIDCZero(), "TPC/Calib/IDC/IDC0", mMetadata, timeStampStart, timeStampEnd);
-      mDBapi.storeAsTFileAny<o2::tpc::IDCOne>(&mIDCFactorization.getIDCOne(), "TPC/Calib/IDC/IDC1", mMetadata, timeStampStart, timeStampEnd);
+      const long timeStampStart = tfRange[0];
+      const long timeStampEnd = tfRange[1];
+      mDBapi.storeAsTFileAny<o2::tpc::IDCZero>(&idcs.getIDCZero(), "TPC/Calib/IDC/IDC0", mMetadata, timeStampStart, timeStampEnd);
+      mDBapi.storeAsTFileAny<o2::tpc::IDCOne>(&idcs.getIDCOne(), "TPC/Calib/IDC/IDC1", mMetadata, timeStampStart, timeStampEnd);
 
-      for (unsigned int iChunk = 0; iChunk < mIDCFactorization.getNChunks(); ++iChunk) {
+      for (unsigned int iChunk = 0; iChunk < idcs.getNChunks(); ++iChunk) {
         switch (mCompressionDeltaIDC) {
           case IDCDeltaCompression::MEDIUM:
           default: {
-            auto idcDeltaMediumCompressed = mIDCFactorization.getIDCDeltaMediumCompressed(iChunk);
-            mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<short>>(&idcDeltaMediumCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTFDeltaIDC(iChunk), getLastTFDeltaIDC(iChunk));
+            auto idcDeltaMediumCompressed = idcs.getIDCDeltaMediumCompressed(iChunk);
+            mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<short>>(&idcDeltaMediumCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTFDeltaIDC(idcs, tfRange, iChunk), getLastTFDeltaIDC(idcs, tfRange, iChunk));
             break;
           }
           case IDCDeltaCompression::HIGH: {
-            auto idcDeltaHighCompressed = mIDCFactorization.getIDCDeltaHighCompressed(iChunk);
-            mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<char>>(&idcDeltaHighCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTFDeltaIDC(iChunk), getLastTFDeltaIDC(iChunk));
+            auto idcDeltaHighCompressed = idcs.getIDCDeltaHighCompressed(iChunk);
+            mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<char>>(&idcDeltaHighCompressed, "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTFDeltaIDC(idcs, tfRange, iChunk), getLastTFDeltaIDC(idcs, tfRange, iChunk));
             break;
           }
           case IDCDeltaCompression::NO:
-            mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<float>>(&mIDCFactorization.getIDCDeltaUncompressed(iChunk), "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTFDeltaIDC(iChunk), getLastTFDeltaIDC(iChunk));
+            mDBapi.storeAsTFileAny<o2::tpc::IDCDelta<float>>(&idcs.getIDCDeltaUncompressed(iChunk), "TPC/Calib/IDC/IDCDELTA", mMetadata, getFirstTFDeltaIDC(idcs, tfRange, iChunk), getLastTFDeltaIDC(idcs, tfRange, iChunk));
             break;
         }
       }
     }
-    // reseting aggregated IDCs. This is done for safety, but if all data is received in the next aggregation interval it isnt necessary... remove it?
-    mIDCFactorization.reset();
   }
 };
 
@@ -212,7 +301,8 @@ DataProcessorSpec getTPCFactorizeIDCSpec(const int lane, const std::vector<uint3
     outputSpecs,
     AlgorithmSpec{adaptFromTask<TPCFactorizeIDCSpec>(crus, timeframes, timeframesDeltaIDC, groupPads, groupRows, groupLastRowsThreshold, groupLastPadsThreshold, compression, debug, senddebug)},
     Options{{"ccdb-uri", VariantType::String, "http://ccdb-test.cern.ch:8080", {"URI for the CCDB access."}},
-            {"update-not-grouping-parameter", VariantType::Bool, false, {"Do NOT Update/Writing grouping parameters to CCDB."}}}}; // end DataProcessorSpec
+            {"update-not-grouping-parameter", VariantType::Bool, false, {"Do NOT Update/Writing grouping parameters to CCDB."}},
+            {"max-pending-intervals", VariantType::Int, 0, {"Factorize and store the IDCs in a worker thread, with up to this number of aggregation intervals waiting (0: factorization in the processing thread)."}}}}; // end DataProcessorSpec
 
   spec.rank = lane;
   return spec;
@@ -55,6 +55,7 @@ class CalibdEdxDevice : public Task
 
     mCalibrator->setSlotLength(slotLength);
     mCalibrator->setMaxSlotsDelay(maxDelay);
+    mCalibrator->setNFillThreads(ic.options().get<int>("fill-threads"));
 
     if (dumpData) {
       mCalibrator->enableDebugOutput("calib_dEdx.root");
@@ -130,6 +131,7 @@ DataProcessorSpec getCalibdEdxSpec()
       {"tf-per-slot", VariantType::Int, 100, {"number of TFs per calibration time slot"}},
       {"max-delay", VariantType::Int, 3, {"number of slots in past to consider"}},
       {"min-entries", VariantType::Int, 100, {"minimum number of entries to fit single time slot"}},
+      {"fill-threads", VariantType::Int, 1, {"number of threads filling the histograms of each TF"}},
       {"apply-cuts", VariantType::Bool, false, {"enable tracks filter using cut values passed as options"}},
       {"min-momentum", VariantType::Float, 0.4f, {"minimum momentum cut"}},
       {"max-momentum", VariantType::Float, 0.6f, {"maximum momentum cut"}},
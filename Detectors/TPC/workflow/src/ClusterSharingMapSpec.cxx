@@ -13,6 +13,7 @@
 /// @brief Device to produce TPC clusters sharing map
 /// \author ruben.shahoyan@cern.ch
 
+#include <algorithm>
 #include <gsl/span>
 #include <TStopwatch.h>
 #include <vector>
@@ -24,6 +25,11 @@
 using namespace o2::framework;
 using namespace o2::tpc;
 
+void ClusterSharingMapSpec::init(InitContext& ic)
+{
+  mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+}
+
 void ClusterSharingMapSpec::run(ProcessingContext& pc)
 {
   TStopwatch timer;
@@ -33,7 +39,7 @@ void ClusterSharingMapSpec::run(ProcessingContext& pc)
   const auto& clustersTPC = getWorkflowTPCInput(pc);
 
   auto& bufVec = pc.outputs().make<std::vector<unsigned char>>(Output{o2::header::gDataOriginTPC, "CLSHAREDMAP", 0}, clustersTPC->clusterIndex.nClustersTotal);
-  o2::gpu::GPUO2InterfaceRefit::fillSharedClustersMap(&clustersTPC->clusterIndex, tracksTPC, tracksTPCClRefs.data(), bufVec.data());
+  o2::gpu::GPUO2InterfaceRefit::fillSharedClustersMap(&clustersTPC->clusterIndex, tracksTPC, tracksTPCClRefs.data(), bufVec.data(), mNThreads);
 
   timer.Stop();
   LOGF(INFO, "Timing for TPC clusters sharing map creation: Cpu: %.3e Real: %.3e s", timer.CpuTime(), timer.RealTime());
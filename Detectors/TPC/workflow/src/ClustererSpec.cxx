@@ -16,6 +16,7 @@
 
 #include "TPCWorkflow/ClustererSpec.h"
 #include "Framework/ControlService.h"
+#include "Framework/ConfigParamRegistry.h"
 #include "Framework/InputRecordWalker.h"
 #include "Headers/DataHeader.h"
 #include "DataFormatsTPC/Digit.h"
@@ -29,7 +30,8 @@
 #include <vector>
 #include <map>
 #include <numeric>   // std::accumulate
-#include <algorithm> // std::copy
+#include <algorithm> // std::copy, std::max
+#include <array>
 
 using namespace o2::framework;
 using namespace o2::header;
@@ -48,10 +50,12 @@ DataProcessorSpec getClustererSpec(bool sendMC)
 
   constexpr static size_t NSectors = o2::tpc::Sector::MAXSECTOR;
   struct ProcessAttributes {
-    std::vector<o2::tpc::ClusterHardwareContainer8kb> clusterArray;
-    MCLabelContainer mctruthArray;
+    // each sector has its own output containers, such that the sectors can be clustered in parallel
+    std::array<std::vector<o2::tpc::ClusterHardwareContainer8kb>, NSectors> clusterArray;
+    std::array<MCLabelContainer, NSectors> mctruthArray;
     std::array<std::shared_ptr<o2::tpc::HwClusterer>, NSectors> clusterers;
     int verbosity = 1;
+    int nThreads = 1;
     bool sendMC = false;
   };
 
@@ -62,18 +66,34 @@ DataProcessorSpec getClustererSpec(bool sendMC)
     // parameter to the clusterer processing function.
     auto processAttributes = std::make_shared<ProcessAttributes>();
     processAttributes->sendMC = sendMC;
+    processAttributes->nThreads = std::max(1, ic.options().get<int>("nthreads"));
+#ifndef WITH_OPENMP
+    if (processAttributes->nThreads > 1) {
+      LOG(WARNING) << "OpenMP is not available, the sectors are clustered sequentially";
+      processAttributes->nThreads = 1;
+    }
+#endif
+
+    struct SectorInput {
+      DataRef dataref;
+      DataRef mclabelref;
+      const o2::tpc::TPCSectorHeader* sectorHeader = nullptr;
+      o2::header::DataHeader::SubSpecificationType fanSpec = 0;
+      gsl::span<const o2::tpc::Digit> digits;
+      ConstMCLabelContainerView mcLabels;
+    };
 
-    auto processSectorFunction = [processAttributes](ProcessingContext& pc, DataRef const& dataref, DataRef const& mclabelref) {
-      auto& clusterArray = processAttributes->clusterArray;
-      auto& mctruthArray = processAttributes->mctruthArray;
+    // retrieve the input of a sector, forward the control information (sector < 0) and create the clusterer if needed
+    // @return false if there is nothing to be clustered
+    auto prepareSectorFunction = [processAttributes](ProcessingContext& pc, SectorInput& input) {
       auto& clusterers = processAttributes->clusterers;
       auto& verbosity = processAttributes->verbosity;
-      auto const* sectorHeader = DataRefUtils::getHeader<o2::tpc::TPCSectorHeader*>(dataref);
+      auto const* sectorHeader = DataRefUtils::getHeader<o2::tpc::TPCSectorHeader*>(input.dataref);
       if (sectorHeader == nullptr) {
         LOG(ERROR) << "sector header missing on header stack";
-        return;
+        return false;
       }
-      auto const* dataHeader = DataRefUtils::getHeader<o2::header::DataHeader*>(dataref);
+      auto const* dataHeader = DataRefUtils::getHeader<o2::header::DataHeader*>(input.dataref);
       o2::header::DataHeader::SubSpecificationType fanSpec = dataHeader->subSpecification;
 
       const auto sector = sectorHeader->sector();
@@ -82,72 +102,78 @@ DataProcessorSpec getClustererSpec(bool sendMC)
         // FIXME define and use flags in TPCSectorHeader
         o2::tpc::TPCSectorHeader header{sector};
         pc.outputs().snapshot(Output{gDataOriginTPC, "CLUSTERHW", fanSpec, Lifetime::Timeframe, {header}}, fanSpec);
-        if (DataRefUtils::isValid(mclabelref)) {
+        if (DataRefUtils::isValid(input.mclabelref)) {
           pc.outputs().snapshot(Output{gDataOriginTPC, "CLUSTERHWMCLBL", fanSpec, Lifetime::Timeframe, {header}}, fanSpec);
         }
-        return;
+        return false;
       }
-      ConstMCLabelContainerView inMCLabels;
-      if (DataRefUtils::isValid(mclabelref)) {
-        inMCLabels = pc.inputs().get<gsl::span<char>>(mclabelref);
+      input.sectorHeader = sectorHeader;
+      input.fanSpec = fanSpec;
+      if (DataRefUtils::isValid(input.mclabelref)) {
+        input.mcLabels = pc.inputs().get<gsl::span<char>>(input.mclabelref);
       }
-      auto inDigits = pc.inputs().get<gsl::span<o2::tpc::Digit>>(dataref);
-      if (verbosity > 0 && inMCLabels.getBuffer().size()) {
-        LOG(INFO) << "received " << inDigits.size() << " digits, "
-                  << inMCLabels.getIndexedSize() << " MC label objects"
-                  << " input MC label size " << DataRefUtils::getPayloadSize(mclabelref);
+      input.digits = pc.inputs().get<gsl::span<o2::tpc::Digit>>(input.dataref);
+      if (verbosity > 0 && input.mcLabels.getBuffer().size()) {
+        LOG(INFO) << "received " << input.digits.size() << " digits, "
+                  << input.mcLabels.getIndexedSize() << " MC label objects"
+                  << " input MC label size " << DataRefUtils::getPayloadSize(input.mclabelref);
       }
       if (!clusterers[sector]) {
-        // create the clusterer for this sector, take the same target arrays for all clusterers
-        // as they are not invoked in parallel
+        // create the clusterer for this sector, writing to the containers of this sector
         // the cost of creating the clusterer should be small so we do it in the processing
-        clusterers[sector] = std::make_shared<o2::tpc::HwClusterer>(&clusterArray, sector, &mctruthArray);
+        clusterers[sector] = std::make_shared<o2::tpc::HwClusterer>(&processAttributes->clusterArray[sector], sector, &processAttributes->mctruthArray[sector]);
         clusterers[sector]->init();
       }
-      auto& clusterer = clusterers[sector];
-
       if (verbosity > 0) {
-        LOG(INFO) << "processing " << inDigits.size() << " digit object(s) of sector " << sectorHeader->sector()
-                  << " input size " << DataRefUtils::getPayloadSize(dataref);
+        LOG(INFO) << "processing " << input.digits.size() << " digit object(s) of sector " << sectorHeader->sector()
+                  << " input size " << DataRefUtils::getPayloadSize(input.dataref);
       }
+      return true;
+    };
+
+    // the clustering touches only the clusterer and the output containers of the sector
+    auto processSectorFunction = [processAttributes](SectorInput const& input) {
+      auto& clusterer = processAttributes->clusterers[input.sectorHeader->sector()];
       // process the digits and MC labels, the bool parameter controls whether to clear all
       // internal data or not. Have to clear it inside the process method as not only the containers
       // are cleared but also the cluster counter. Clearing the containers externally leaves the
       // cluster counter unchanged and leads to an inconsistency between cluster container and
       // MC label container (the latter just grows with every call).
-      clusterer->process(inDigits, inMCLabels, true /* clear output containers and cluster counter */);
+      clusterer->process(input.digits, input.mcLabels, true /* clear output containers and cluster counter */);
       const std::vector<o2::tpc::Digit> emptyDigits;
       ConstMCLabelContainerView emptyLabels;
       clusterer->finishProcess(emptyDigits, emptyLabels, false); // keep here the false, otherwise the clusters are lost of they are not stored in the meantime
-      if (verbosity > 0) {
+    };
+
+    auto sendSectorFunction = [processAttributes](ProcessingContext& pc, SectorInput const& input) {
+      const auto sector = input.sectorHeader->sector();
+      auto& clusterArray = processAttributes->clusterArray[sector];
+      auto& mctruthArray = processAttributes->mctruthArray[sector];
+      if (processAttributes->verbosity > 0) {
         LOG(INFO) << "clusterer produced "
                   << std::accumulate(clusterArray.begin(), clusterArray.end(), size_t(0), [](size_t l, auto const& r) { return l + r.getContainer()->numberOfClusters; })
                   << " cluster(s)"
-                  << " for sector " << sectorHeader->sector()
+                  << " for sector " << sector
                   << " total size " << sizeof(ClusterHardwareContainer8kb) * clusterArray.size();
-        if (DataRefUtils::isValid(mclabelref)) {
-          LOG(INFO) << "clusterer produced " << mctruthArray.getIndexedSize() << " MC label object(s) for sector " << sectorHeader->sector();
+        if (DataRefUtils::isValid(input.mclabelref)) {
+          LOG(INFO) << "clusterer produced " << mctruthArray.getIndexedSize() << " MC label object(s) for sector " << sector;
         }
       }
       // FIXME: that should be a case for pmr, want to send the content of the vector as a binary
       // block by using move semantics
-      auto outputPages = pc.outputs().make<ClusterHardwareContainer8kb>(Output{gDataOriginTPC, "CLUSTERHW", fanSpec, Lifetime::Timeframe, {*sectorHeader}}, clusterArray.size());
+      auto outputPages = pc.outputs().make<ClusterHardwareContainer8kb>(Output{gDataOriginTPC, "CLUSTERHW", input.fanSpec, Lifetime::Timeframe, {*input.sectorHeader}}, clusterArray.size());
       std::copy(clusterArray.begin(), clusterArray.end(), outputPages.begin());
-      if (DataRefUtils::isValid(mclabelref)) {
+      if (DataRefUtils::isValid(input.mclabelref)) {
         ConstMCLabelContainer mcflat;
         mctruthArray.flatten_to(mcflat);
-        pc.outputs().snapshot(Output{gDataOriginTPC, "CLUSTERHWMCLBL", fanSpec, Lifetime::Timeframe, {*sectorHeader}}, mcflat);
+        pc.outputs().snapshot(Output{gDataOriginTPC, "CLUSTERHWMCLBL", input.fanSpec, Lifetime::Timeframe, {*input.sectorHeader}}, mcflat);
       }
     };
 
-    auto processingFct = [processAttributes, processSectorFunction](ProcessingContext& pc) {
-      struct SectorInputDesc {
-        DataRef dataref;
-        DataRef mclabelref;
-      };
+    auto processingFct = [processAttributes, prepareSectorFunction, processSectorFunction, sendSectorFunction](ProcessingContext& pc) {
       // loop over all inputs and their parts and associate data with corresponding mc truth data
       // by the subspecification
-      std::map<int, SectorInputDesc> inputs;
+      std::map<int, SectorInput> inputs;
       std::vector<InputSpec> filter = {
         {"check", ConcreteDataTypeMatcher{gDataOriginTPC, "DIGITS"}, Lifetime::Timeframe},
         {"check", ConcreteDataTypeMatcher{gDataOriginTPC, "DIGITSMCTR"}, Lifetime::Timeframe},
@@ -166,11 +192,24 @@ DataProcessorSpec getClustererSpec(bool sendMC)
           inputs[sector].mclabelref = inputRef;
         }
       }
-      for (auto const& input : inputs) {
+      std::vector<SectorInput*> sectorInputs;
+      for (auto& input : inputs) {
         if (processAttributes->sendMC && !DataRefUtils::isValid(input.second.mclabelref)) {
           throw std::runtime_error("missing the required MC label data for sector " + std::to_string(input.first));
         }
-        processSectorFunction(pc, input.second.dataref, input.second.mclabelref);
+        if (prepareSectorFunction(pc, input.second)) {
+          sectorInputs.push_back(&input.second);
+        }
+      }
+      const int nSectorInputs = sectorInputs.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(processAttributes->nThreads) if (processAttributes->nThreads > 1)
+#endif
+      for (int i = 0; i < nSectorInputs; i++) {
+        processSectorFunction(*sectorInputs[i]);
+      }
+      for (auto const* input : sectorInputs) {
+        sendSectorFunction(pc, *input);
       }
     };
     return processingFct;
@@ -203,7 +242,8 @@ DataProcessorSpec getClustererSpec(bool sendMC)
   return DataProcessorSpec{processorName,
                            {createInputSpecs(sendMC)},
                            {createOutputSpecs(sendMC)},
-                           AlgorithmSpec(initFunction)};
+                           AlgorithmSpec(initFunction),
+                           Options{{"nthreads", VariantType::Int, 1, {"Number of threads to cluster the TPC sectors in parallel"}}}};
 }
 
 } // namespace tpc
@@ -9,7 +9,13 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <vector>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 #include "Framework/Task.h"
 #include "Framework/InputRecordWalker.h"
@@ -34,15 +40,27 @@ namespace tpc
 class KrBoxClusterFinderDevice : public o2::framework::Task
 {
  public:
-  KrBoxClusterFinderDevice() : mClusterFinder{std::make_unique<KrBoxClusterFinder>()} {}
-
   void init(o2::framework::InitContext& ic) final
   {
-    mClusterFinder->init();
+    mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+    mTimeChunks = std::max(1, ic.options().get<int>("time-chunks"));
+#ifndef WITH_OPENMP
+    if (mNThreads > 1) {
+      LOG(WARNING) << "OpenMP is not available, the sectors are processed sequentially";
+      mNThreads = 1;
+    }
+#endif
+    // one cluster finder per thread, each of them holds its own set of time slices
+    for (int i = 0; i < mNThreads; ++i) {
+      auto& clusterFinder = mClusterFinders.emplace_back(std::make_unique<KrBoxClusterFinder>());
+      clusterFinder->init();
+    }
   }
 
   void run(o2::framework::ProcessingContext& pc) final
   {
+    std::vector<int> sectors;
+    std::vector<gsl::span<const o2::tpc::Digit>> digits;
     for (auto const& inputRef : InputRecordWalker(pc.inputs())) {
       auto const* sectorHeader = DataRefUtils::getHeader<TPCSectorHeader*>(inputRef);
       if (sectorHeader == nullptr) {
@@ -50,16 +68,57 @@ class KrBoxClusterFinderDevice : public o2::framework::Task
         continue;
       }
 
-      const int sector = sectorHeader->sector();
-      auto inDigits = pc.inputs().get<gsl::span<o2::tpc::Digit>>(inputRef);
+      sectors.emplace_back(sectorHeader->sector());
+      digits.emplace_back(pc.inputs().get<gsl::span<o2::tpc::Digit>>(inputRef));
+    }
 
-      mClusterFinder->loopOverSector(inDigits, sector);
+    // split the time range of each sector in chunks, the digits are sorted in time
+    struct Chunk {
+      size_t input;
+      int firstTimeBin;
+      int lastTimeBin;
+      std::vector<o2::tpc::KrCluster> clusters;
+    };
+    std::vector<Chunk> chunks;
+    for (size_t i = 0; i < sectors.size(); ++i) {
+      const int lastTimeBin = digits[i].empty() ? 0 : digits[i].back().getTimeStamp() + 1;
+      const int chunkSize = (lastTimeBin + mTimeChunks - 1) / mTimeChunks;
+      for (int iChunk = 0; iChunk < mTimeChunks; ++iChunk) {
+        const bool isLast = (iChunk == mTimeChunks - 1) || (chunkSize == 0);
+        chunks.push_back({i, iChunk * chunkSize, isLast ? std::numeric_limits<int>::max() : (iChunk + 1) * chunkSize, {}});
+        if (isLast) {
+          break;
+        }
+      }
+    }
 
-      snapshotClusters(pc.outputs(), mClusterFinder->getClusters(), sector);
+    const int nChunks = chunks.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads) if (mNThreads > 1)
+#endif
+    for (int iChunk = 0; iChunk < nChunks; ++iChunk) {
+#ifdef WITH_OPENMP
+      auto& clusterFinder = *mClusterFinders[omp_get_thread_num()];
+#else
+      auto& clusterFinder = *mClusterFinders[0];
+#endif
+      auto& chunk = chunks[iChunk];
+      clusterFinder.loopOverSector(digits[chunk.input], sectors[chunk.input], chunk.firstTimeBin, chunk.lastTimeBin);
+      chunk.clusters.swap(clusterFinder.getClusters());
+      clusterFinder.resetClusters();
+    }
 
-      LOGP(info, "processed sector {} with {} digits and {} reconstructed clusters", sector, inDigits.size(), mClusterFinder->getClusters().size());
+    // the chunks are consecutive in time, merging them gives the clusters in the same order as a single pass
+    std::vector<o2::tpc::KrCluster> clusters;
+    auto chunk = chunks.begin();
+    for (size_t i = 0; i < sectors.size(); ++i) {
+      clusters.clear();
+      for (; chunk != chunks.end() && chunk->input == i; ++chunk) {
+        clusters.insert(clusters.end(), chunk->clusters.begin(), chunk->clusters.end());
+      }
+      snapshotClusters(pc.outputs(), clusters, sectors[i]);
 
-      mClusterFinder->resetClusters();
+      LOGP(info, "processed sector {} with {} digits and {} reconstructed clusters", sectors[i], digits[i].size(), clusters.size());
     }
 
     ++mProcessedTFs;
@@ -67,7 +126,9 @@ class KrBoxClusterFinderDevice : public o2::framework::Task
   }
 
  private:
-  std::unique_ptr<KrBoxClusterFinder> mClusterFinder;
+  std::vector<std::unique_ptr<KrBoxClusterFinder>> mClusterFinders;
+  int mNThreads{1};   ///< number of threads processing sectors and time chunks in parallel
+  int mTimeChunks{1}; ///< number of chunks in time each sector is split in
   uint32_t mProcessedTFs{0};
 
   //____________________________________________________________________________
@@ -95,8 +156,11 @@ o2::framework::DataProcessorSpec getKryptonClustererSpec()
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<device>()},
-    Options{} // end Options
-  };          // end DataProcessorSpec
+    Options{
+      {"nthreads", VariantType::Int, 1, {"Number of threads to process sectors and time chunks in parallel"}},
+      {"time-chunks", VariantType::Int, 1, {"Number of chunks in time each sector is split in for the parallel processing"}},
+    } // end Options
+  };  // end DataProcessorSpec
 }
 } // namespace tpc
 } // namespace o2
@@ -423,7 +423,8 @@ framework::WorkflowSpec getWorkflow(CompletionPolicyData* policyData, std::vecto
     cfg.zsOnTheFly = zsOnTheFly;
     cfg.outputTracks = produceTracks;
     cfg.outputCompClusters = produceCompClusters;
-    cfg.outputCompClustersFlat = runClusterEncoder;
+    // with the tracker running, the CTF is created from its compressed clusters without a separate encoder
+    cfg.outputCTF = runClusterEncoder;
     cfg.outputCAClusters = isEnabled(OutputType::Clusters) && (caClusterer || decompressTPC);
     cfg.outputQA = isEnabled(OutputType::QA);
     cfg.outputSharedClusterMap = (isEnabled(OutputType::Clusters) || inputType == InputType::Clusters) && isEnabled(OutputType::Tracks) && !isEnabled(OutputType::NoSharedClusterMap);
@@ -438,8 +439,8 @@ framework::WorkflowSpec getWorkflow(CompletionPolicyData* policyData, std::vecto
   // tracker process
   //
   // selected by output type 'encoded-clusters'
-  if (runClusterEncoder) {
-    specs.emplace_back(o2::tpc::getEntropyEncoderSpec(!runTracker && inputType != InputType::CompClustersFlat));
+  if (runClusterEncoder && !runTracker) {
+    specs.emplace_back(o2::tpc::getEntropyEncoderSpec(inputType != InputType::CompClustersFlat));
   }
 
   //////////////////////////////////////////////////////////////////////////////////////////////
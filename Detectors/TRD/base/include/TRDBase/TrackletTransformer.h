@@ -15,6 +15,9 @@
 #include "TRDBase/Geometry.h"
 #include "DataFormatsTRD/Tracklet64.h"
 #include "DataFormatsTRD/CalibratedTracklet.h"
+#include "DataFormatsTRD/Constants.h"
+#include <array>
+#include <gsl/span>
 
 namespace o2
 {
@@ -51,6 +54,9 @@ class TrackletTransformer
 
   CalibratedTracklet transformTracklet(Tracklet64 tracklet);
 
+  /// transform the tracklets in bulk, output must have the size of the input
+  void transformTracklets(gsl::span<const Tracklet64> tracklets, gsl::span<CalibratedTracklet> output) const;
+
   double getTimebin(double x);
 
  private:
@@ -65,6 +71,16 @@ class TrackletTransformer
   float mt0Correction;
   float mLorentzAngle;
   float mDriftVRatio;
+
+  /// pad plane quantities and T2L matrix of a chamber, precomputed to avoid the geometry lookups per tracklet
+  struct ChamberTransform {
+    const o2::math_utils::Transform3D* matrixT2L = nullptr; // nullptr if the chamber is not in the geometry
+    double padWidth = 0.;
+    std::array<float, constants::NROWC1> z{}; // z of the pad rows, as from calculateZ
+  };
+  std::array<ChamberTransform, constants::MAXCHAMBER> mChambers;
+
+  CalibratedTracklet transformTrackletFast(const Tracklet64& tracklet) const;
 };
 
 } // namespace trd
@@ -35,7 +35,58 @@ TrackletTransformer::TrackletTransformer()
   mt0Correction = -0.279;
   mLorentzAngle = 0.14;
   mDriftVRatio = 1.1;
+
+  for (int det = 0; det < MAXCHAMBER; ++det) {
+    auto& chamber = mChambers[det];
+    loadPadPlane(2 * det);
+    chamber.padWidth = mPadPlane->getWidthIPad();
+    for (int row = 0; row < mPadPlane->getNrows() && row < NROWC1; ++row) {
+      chamber.z[row] = calculateZ(row);
+    }
+    if (mGeo->chamberInGeometry(det)) {
+      chamber.matrixT2L = &mGeo->getMatrixT2L(det);
+    }
+  }
+}
+
+namespace
+{
+// the position and slope calculated in TRAPsim are signed integers
+inline int signedPosition(int position)
+{
+  if (position & (1 << (NBITSTRKLPOS - 1))) {
+    return -((~(position - 1)) & ((1 << NBITSTRKLPOS) - 1));
+  }
+  return position & ((1 << NBITSTRKLPOS) - 1);
+}
+
+inline int signedSlope(int slope)
+{
+  if (slope & (1 << (NBITSTRKLSLOPE - 1))) {
+    return -((~(slope - 1)) & ((1 << NBITSTRKLSLOPE) - 1));
+  }
+  return slope & ((1 << NBITSTRKLSLOPE) - 1);
+}
+
+inline float trackletY(double padWidth, int hcid, int column, int position)
+{
+  int side = hcid % 2;
+  // shift such that positionUnsigned = 1 << (NBITSTRKLPOS - 1) corresponds to the MCM center
+  int positionUnsigned = signedPosition(position) + (1 << (NBITSTRKLPOS - 1));
+  // slightly modified TDP eq 16.1 (appended -1 to the end to account for MCM shared pads)
+  double pad = float(positionUnsigned - (1 << (NBITSTRKLPOS - 1))) * GRANULARITYTRKLPOS + NCOLMCM * (4 * side + column) + 10. - 1.;
+  return padWidth * (pad - 72);
+}
+
+inline float trackletDy(double padWidth, float xCathode, int slope)
+{
+  // temporary dummy value in cm/microsecond
+  float vDrift = 1.5464f;
+  // dy = slope * nTimeBins * padWidth * GRANULARITYTRKLSLOPE;
+  // nTimeBins should be number of timebins in drift region. 1 timebin is 100 nanosecond
+  return signedSlope(slope) * ((xCathode / vDrift) * 10.) * padWidth * GRANULARITYTRKLSLOPE;
 }
+} // namespace
 
 void TrackletTransformer::loadPadPlane(int hcid)
 {
@@ -47,23 +98,7 @@ void TrackletTransformer::loadPadPlane(int hcid)
 
 float TrackletTransformer::calculateY(int hcid, int column, int position)
 {
-  double padWidth = mPadPlane->getWidthIPad();
-  int side = hcid % 2;
-
-  // the position calculated in TRAPsim is a signed integer
-  int positionUnsigned = 0;
-  if (position & (1 << (NBITSTRKLPOS - 1))) {
-    positionUnsigned = -((~(position - 1)) & ((1 << NBITSTRKLPOS) - 1));
-  } else {
-    positionUnsigned = position & ((1 << NBITSTRKLPOS) - 1);
-  }
-  positionUnsigned += 1 << (NBITSTRKLPOS - 1); // shift such that positionUnsigned = 1 << (NBITSTRKLPOS - 1) corresponds to the MCM center
-
-  // slightly modified TDP eq 16.1 (appended -1 to the end to account for MCM shared pads)
-  double pad = float(positionUnsigned - (1 << (NBITSTRKLPOS - 1))) * GRANULARITYTRKLPOS + NCOLMCM * (4 * side + column) + 10. - 1.;
-  float y = padWidth * (pad - 72);
-
-  return y;
+  return trackletY(mPadPlane->getWidthIPad(), hcid, column, position);
 }
 
 float TrackletTransformer::calculateZ(int padrow)
@@ -77,21 +112,7 @@ float TrackletTransformer::calculateZ(int padrow)
 
 float TrackletTransformer::calculateDy(int slope, double lorentzAngle, double driftVRatio)
 {
-  double padWidth = mPadPlane->getWidthIPad();
-
-  // temporary dummy value in cm/microsecond
-  float vDrift = 1.5464f;
-
-  int slopeSigned = 0;
-  if (slope & (1 << (NBITSTRKLSLOPE - 1))) {
-    slopeSigned = -((~(slope - 1)) & ((1 << NBITSTRKLSLOPE) - 1));
-  } else {
-    slopeSigned = slope & ((1 << NBITSTRKLSLOPE) - 1);
-  }
-
-  // dy = slope * nTimeBins * padWidth * GRANULARITYTRKLSLOPE;
-  // nTimeBins should be number of timebins in drift region. 1 timebin is 100 nanosecond
-  double rawDy = slopeSigned * ((mXCathode / vDrift) * 10.) * padWidth * GRANULARITYTRKLSLOPE;
+  double rawDy = trackletDy(mPadPlane->getWidthIPad(), mXCathode, slope);
 
   // NOTE: check what drift height is used in calibration code to ensure consistency
   // NOTE: check sign convention of Lorentz angle
@@ -122,29 +143,42 @@ std::array<float, 3> TrackletTransformer::transformL2T(int hcid, std::array<doub
 
 CalibratedTracklet TrackletTransformer::transformTracklet(Tracklet64 tracklet)
 {
-  uint64_t hcid = tracklet.getHCID();
-  uint64_t padrow = tracklet.getPadRow();
-  uint64_t column = tracklet.getColumn();
-  uint64_t position = tracklet.getPosition();
-  uint64_t slope = tracklet.getSlope();
+  auto calibratedTracklet = transformTrackletFast(tracklet);
+
+  LOG(debug) << "x: " << calibratedTracklet.getX() << " | "
+             << "y: " << calibratedTracklet.getY() << " | "
+             << "z: " << calibratedTracklet.getZ();
+
+  return calibratedTracklet;
+}
+
+CalibratedTracklet TrackletTransformer::transformTrackletFast(const Tracklet64& tracklet) const
+{
+  int hcid = tracklet.getHCID();
+  int detector = hcid / 2;
+  const auto& chamber = mChambers[detector];
 
   // calculate raw local chamber space point
-  loadPadPlane(hcid);
-  float x = getXDrift();
-  float y = calculateY(hcid, column, position);
-  float z = calculateZ(padrow);
+  float x = mXDrift;
+  float y = trackletY(chamber.padWidth, hcid, tracklet.getColumn(), tracklet.getPosition());
+  float z = chamber.z[tracklet.getPadRow()];
 
-  float dy = calculateDy(slope, mLorentzAngle, mDriftVRatio);
-  float calibratedX = calibrateX(x, mt0Correction);
+  float dy = trackletDy(chamber.padWidth, mXCathode, tracklet.getSlope());
+  float calibratedX = double(x) + double(mt0Correction); // as calibrateX
   // NOTE: Correction to y position based on x calibration NOT YET implemented. Need t0.
 
-  std::array<float, 3> sectorSpacePoint = transformL2T(hcid, std::array<double, 3>{calibratedX, y, z});
+  const auto& transformationMatrix = chamber.matrixT2L ? *chamber.matrixT2L : mGeo->getMatrixT2L(detector);
+  ROOT::Math::Impl::Transform3D<double>::Point localPoint(calibratedX, y, z);
+  auto gobalPoint = transformationMatrix ^ localPoint;
 
-  LOG(debug) << "x: " << sectorSpacePoint[0] << " | "
-             << "y: " << sectorSpacePoint[1] << " | "
-             << "z: " << sectorSpacePoint[2];
+  return CalibratedTracklet((float)gobalPoint.x(), (float)gobalPoint.y(), (float)gobalPoint.z(), dy);
+}
 
-  return CalibratedTracklet(sectorSpacePoint[0], sectorSpacePoint[1], sectorSpacePoint[2], dy);
+void TrackletTransformer::transformTracklets(gsl::span<const Tracklet64> tracklets, gsl::span<CalibratedTracklet> output) const
+{
+  for (size_t i = 0; i < tracklets.size(); ++i) {
+    output[i] = transformTrackletFast(tracklets[i]);
+  }
 }
 
 double TrackletTransformer::getTimebin(double x)
@@ -82,6 +82,7 @@ class CruRawReader
   void setVerbose(bool verbose) { mVerbose = verbose; }
   void setDataVerbose(bool verbose) { mDataVerbose = verbose; }
   void setHeaderVerbose(bool verbose) { mHeaderVerbose = verbose; }
+  void setNThreads(int n);
   inline uint32_t getDecoderByteCounter() const { return reinterpret_cast<const char*>(mDataPointer) - mDataBuffer; };
   bool buildBlobOutput(char* outputbuffer); // should probably go into a writer object.
   // benchmarks
@@ -105,8 +106,10 @@ class CruRawReader
   }
   void clear()
   {
-    mTrackletsParser.clear();
-    mDigitsParser.clear();
+    for (int link = 0; link < constants::NLINKSPERHALFCRU; ++link) {
+      mTrackletsParsers[link].clear();
+      mDigitsParsers[link].clear();
+    }
   }
 
  protected:
@@ -114,6 +117,9 @@ class CruRawReader
   bool processHBFsa(int datasizealreadyread = 0, bool verbose = false);
   bool buildCRUPayLoad();
   int processHalfCRU(int cruhbfstartoffset);
+  void parseLink(int link, std::array<uint32_t, o2::trd::constants::HBFBUFFERMAX>* data, std::array<uint32_t, o2::trd::constants::HBFBUFFERMAX>::iterator linkstart,
+                 std::array<uint32_t, o2::trd::constants::HBFBUFFERMAX>::iterator linkend);
+  bool splitHalfCRULinks();
   bool processCRULink();
   bool skipRDH();
 
@@ -132,10 +138,18 @@ class CruRawReader
   bool mByteSwap{false};
   bool mFixDigitEndCorruption{false};
   int mTrackletHCHeaderState{0};
+  int mNThreads{1}; // number of threads decoding the links of a half cru concurrently
 
   const char* mDataBuffer = nullptr;
   static const uint32_t mMaxHBFBufferSize = o2::trd::constants::HBFBUFFERMAX;
   std::array<uint32_t, o2::trd::constants::HBFBUFFERMAX> mHBFPayload; //this holds the O2 payload held with in the HBFs to pass to parsing.
+  // private copies of the links of the current half cru, each followed by guard words, so links can be parsed (and byteswapped in place) concurrently.
+  static constexpr int mLinkGuardWords = 8; // the parsers look ahead past the end of a link, give them one cru word of the following data.
+  std::array<uint32_t, o2::trd::constants::HBFBUFFERMAX> mLinkPayloads;
+  std::array<uint32_t, constants::NLINKSPERHALFCRU> mLinkPayloadStart; // offset of each link in mLinkPayloads
+  std::array<uint32_t, constants::NLINKSPERHALFCRU> mLinkHBFStart;     // offset of each link in mHBFPayload
+  std::array<int, constants::NLINKSPERHALFCRU> mLinkTrackletWordsRead; // words consumed by the tracklet parser per link
+  std::array<int, constants::NLINKSPERHALFCRU> mLinkDigitWordsRead;    // words consumed by the digit parser per link
   uint32_t mHalfCRUPayLoadRead{0};                                    // the words current read in for the currnt cru payload.
   uint32_t mO2PayLoadRead{0};                                         // the words current read in for the currnt cru payload.
   int mCurrentHalfCRULinkHeaderPoisition = 0;
@@ -186,8 +200,9 @@ class CruRawReader
   // we parse rdh to rdh but data is cru to cru.
   //the relevant parsers. Not elegant but we need both so pointers to base classes and sending them in with templates or some other such mechanism seems impossible, or its just late and I cant think.
   //TODO think of a more elegant way of incorporating the parsers.
-  TrackletsParser mTrackletsParser;
-  DigitsParser mDigitsParser;
+  // one pair per link of a half cru, each link output stays in its own parser until joined in link order.
+  std::array<TrackletsParser, constants::NLINKSPERHALFCRU> mTrackletsParsers;
+  std::array<DigitsParser, constants::NLINKSPERHALFCRU> mDigitsParsers;
   //used to surround the outgoing data with a coherent rdh coming from the incoming stream.
   o2::header::RDHAny* mOpenRDH;
   o2::header::RDHAny* mCloseRDH;
@@ -96,6 +96,7 @@ class EventStorage
   void addTracklet(InteractionRecord& ir, Tracklet64& tracklet);
   void addTracklets(InteractionRecord& ir, std::vector<Tracklet64>& tracklets);
   void addTracklets(InteractionRecord& ir, std::vector<Tracklet64>::iterator& start, std::vector<Tracklet64>::iterator& end);
+  EventRecord& getEventRecord(InteractionRecord& ir); // find the record for this ir, adding it if unseen
   void unpackData(std::vector<TriggerRecord>& triggers, std::vector<Tracklet64>& tracklets, std::vector<Digit>& digits);
   void sendData(o2::framework::ProcessingContext& pc, bool displaytracklets = false);
   //this could replace by keeing a running total on addition TODO
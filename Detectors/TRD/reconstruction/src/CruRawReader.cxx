@@ -35,6 +35,7 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 #include <iostream>
@@ -163,15 +164,7 @@ int CruRawReader::processHalfCRU(int cruhbfstartoffset)
   // process a halfcru
   uint32_t currentlinkindex = 0;
   uint32_t currentlinkoffset = 0;
-  uint32_t currentlinksize = 0;
-  uint32_t currentlinksize32 = 0;
   uint32_t linksizeAccum32 = 0;
-  uint32_t sumtrackletwords = 0;
-  uint32_t sumdigitwords = 0;
-  uint32_t sumlinklengths = 0;
-  int trackletwordsread = 0; // this will read up to the tracnklet end marker.
-  int digitwordsread = 0;
-  uint32_t cruwordsread = 9;
   //reject halfcru if it starts with padding words.
   //this should only hit that instance where the cru payload is a "blank event" of o2::trd::constants::CRUPADDING32
   if (mHBFPayload[cruhbfstartoffset] == o2::trd::constants::CRUPADDING32 && mHBFPayload[cruhbfstartoffset + 1] == o2::trd::constants::CRUPADDING32) {
@@ -193,8 +186,6 @@ int CruRawReader::processHalfCRU(int cruhbfstartoffset)
                                                mCurrentHalfCRULinkLengths.end(),
                                                decltype(mCurrentHalfCRULinkLengths)::value_type(0));
   mTotalHalfCRUDataLength = mTotalHalfCRUDataLength256 * 32; //convert to bytes.
-  std::array<uint32_t, 1024>::iterator currentlinkstart = mHBFPayload.begin() + cruhbfstartoffset;
-  std::array<uint32_t, 1024>::iterator linkstart, linkend;
   int dataoffsetstart32 = sizeof(mCurrentHalfCRUHeader) / 4 + cruhbfstartoffset; // in uint32
   //CHECK 1 does rdh endpoint match cru header end point.
   if (mCRUEndpoint != mCurrentHalfCRUHeader.EndPoint) {
@@ -220,95 +211,142 @@ int CruRawReader::processHalfCRU(int cruhbfstartoffset)
   //FEEID has supermodule/layer/stack/side in it.
   //CRU has
   mHBFoffset32 += sizeof(mCurrentHalfCRUHeader) / 4;
-  linkstart = mHBFPayload.begin() + dataoffsetstart32;
-  linkend = mHBFPayload.begin() + dataoffsetstart32;
-  //loop over links
   for (currentlinkindex = 0; currentlinkindex < constants::NLINKSPERHALFCRU; currentlinkindex++) {
-    currentlinksize = mCurrentHalfCRULinkLengths[currentlinkindex];
-    currentlinksize32 = currentlinksize * 8; //x8 to go from 256 bits to 32 bit;
-    linkstart = mHBFPayload.begin() + dataoffsetstart32 + linksizeAccum32;
-    linkend = linkstart + currentlinksize32;
-    linksizeAccum32 += currentlinksize32;
-    int supermodule = ((TRDFeeID*)&mFEEID)->supermodule;
-    int endpoint = ((TRDFeeID*)&mFEEID)->endpoint;
-    int side = ((TRDFeeID*)&mFEEID)->side;
-    //stack layer and side map to ori
-    int stack, layer, halfchamberside;
-    int oriindex = currentlinkindex + constants::NLINKSPERHALFCRU * endpoint; // endpoint denotes the pci side, upper or lower for the pair of 15 fibres.
-    FeeParam::unpackORI(oriindex, side, stack, layer, halfchamberside);
-    int currentdetector = stack * constants::NLAYER + layer + supermodule * constants::NLAYER * constants::NSTACK;
-    if (mVerbose) {
-      LOG(info) << "******* LINK # " << currentlinkindex << " and  unpackORI(" << oriindex << "," << side << "," << stack << "," << layer << "," << halfchamberside << ") and an FEEID:" << std::hex << mFEEID << " det:" << std::dec << currentdetector;
+    mLinkHBFStart[currentlinkindex] = dataoffsetstart32 + linksizeAccum32;
+    linksizeAccum32 += mCurrentHalfCRULinkLengths[currentlinkindex] * 8; //x8 to go from 256 bits to 32 bit;
+  }
+  // the links are independent, each parser only touches its own link (and looks ahead a couple of words).
+  // With more than one thread give each link a private copy so they can be parsed and byteswapped concurrently.
+  bool parallel = mNThreads > 1 && splitHalfCRULinks();
+  if (parallel) {
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+    for (int link = 0; link < constants::NLINKSPERHALFCRU; link++) {
+      auto linkbegin = mLinkPayloads.begin() + mLinkPayloadStart[link];
+      parseLink(link, &mLinkPayloads, linkbegin, linkbegin + mCurrentHalfCRULinkLengths[link] * 8);
     }
-    // tracklet first then digit ??
-    // tracklets end with tracklet end marker(0x10001000 0x10001000), digits end with digit endmarker (0x0 0x0)
-    if (linkstart != linkend) { // if link is not empty
-
-      if (mVerbose) {
-        LOG(info) << "parse tracklets ";
-      }
-      bool cleardigits = false; //linkstart and linkend already have the multiple cruheaderoffsets built in
-      if (mVerbose) {
-        LOG(info) << "mem copy with offset of : " << cruhbfstartoffset << " parsing tracklets with linkstart: " << linkstart << " ending at : " << linkend;
-      }
-      trackletwordsread = mTrackletsParser.Parse(&mHBFPayload, linkstart, linkend, mFEEID, halfchamberside, currentdetector, stack, layer, cleardigits, mByteSwap, mTrackletHCHeaderState, mVerbose, mHeaderVerbose, mDataVerbose); // this will read up to the tracklet end marker.
-      if (mVerbose) {
-        LOG(info) << "trackletwordsread:" << trackletwordsread << "  mem copy with offset of : " << cruhbfstartoffset << " parsing with linkstart: " << linkstart << " ending at : " << linkend;
-      }
-      linkstart += trackletwordsread;
-      //now we have a tracklethcheader and a digithcheader.
-      mHBFoffset32 += trackletwordsread;
-      mTotalTrackletsFound += mTrackletsParser.getTrackletsFound();
-      digitwordsread = 0;
-      if (mVerbose) {
-        LOG(info) << "parse digits";
-      }
-      //linkstart and linkend already have the multiple cruheaderoffsets built in
-      digitwordsread = mDigitsParser.Parse(&mHBFPayload, linkstart, linkend, currentdetector, cleardigits, mByteSwap, mVerbose, mHeaderVerbose, mDataVerbose);
-      if (digitwordsread != std::distance(linkstart, linkend)) {
-        //we have the data corruption problem of a pile of stuff at the end of a link, jump over it.
-        if (mFixDigitEndCorruption) {
-          digitwordsread = std::distance(linkstart, linkend);
-        } else {
-          LOG(warn) << "read digits but data still left on the link digitwordsread:" << digitwordsread << " and link length:" << std::distance(linkstart, linkend);
-        }
-      }
-      mTotalDigitsFound += mDigitsParser.getDigitsFound();
-      if (mVerbose) {
-        LOG(info) << "digitwordsread : " << digitwordsread << " mem copy with offset of : " << cruhbfstartoffset << " parsing digits with linkstart: " << linkstart << " ending at : " << linkend;
-      }
-      sumlinklengths += mCurrentHalfCRULinkLengths[currentlinkindex];
-      sumtrackletwords = trackletwordsread;
-      sumdigitwords = digitwordsread;
-      mHBFoffset32 += digitwordsread; // all 3 in 32bit units
-    } else {
-      if (mVerbose) {
-        LOG(info) << "link start and end are the same, link appears to be empty for link currentlinkdex";
+    if (mByteSwap) {
+      // leave mHBFPayload as the serial parsing would, the words of each link byteswapped in place.
+      for (int link = 0; link < constants::NLINKSPERHALFCRU; link++) {
+        std::copy_n(mLinkPayloads.begin() + mLinkPayloadStart[link], mCurrentHalfCRULinkLengths[link] * 8, mHBFPayload.begin() + mLinkHBFStart[link]);
       }
     }
-  } //for loop over link index.
+  } else {
+    for (int link = 0; link < constants::NLINKSPERHALFCRU; link++) {
+      auto linkbegin = mHBFPayload.begin() + mLinkHBFStart[link];
+      parseLink(link, &mHBFPayload, linkbegin, linkbegin + mCurrentHalfCRULinkLengths[link] * 8);
+    }
+  }
   // we have read in all the digits and tracklets for this event.
-  //digits and tracklets are sitting inside the parsing classes.
-  //extract the vectors and copy them to tracklets and digits here, building the indexing(triggerrecords)
+  //digits and tracklets are sitting inside the per link parsers.
+  //join them in link order straight into the event record for this trigger,
   //as this is for a single cru half chamber header all the tracklets and digits are for the same trigger defined by the bc and orbit in the rdh which we hold in mIR
   mIR.bc = mCurrentHalfCRUHeader.BunchCrossing; // correct mIR to have the physics trigger bunchcrossing *NOT* the heartbeat trigger bunch crossing.
+  auto& event = mEventRecords.getEventRecord(mIR);
+  for (int link = 0; link < constants::NLINKSPERHALFCRU; link++) {
+    if (mCurrentHalfCRULinkLengths[link] == 0) {
+      continue;
+    }
+    mHBFoffset32 += mLinkTrackletWordsRead[link] + mLinkDigitWordsRead[link]; // all in 32bit units
+    mTotalTrackletsFound += mTrackletsParsers[link].getTrackletsFound();
+    mTotalDigitsFound += mDigitsParsers[link].getDigitsFound();
+    auto& tracklets = mTrackletsParsers[link].getTracklets();
+    auto trackletsbegin = tracklets.begin();
+    auto trackletsend = tracklets.end();
+    event.addTracklets(trackletsbegin, trackletsend);
+    auto& digits = mDigitsParsers[link].getDigits();
+    auto digitsbegin = digits.begin();
+    auto digitsend = digits.end();
+    event.addDigits(digitsbegin, digitsend);
+    if (mVerbose) {
+      LOG(info) << "inserting from link " << link << " tracklets of size : " << tracklets.size() << " and digits of size : " << digits.size();
+    }
+  }
+  clear();
+  if (mVerbose) {
+    LOG(info) << "Event tracklets after event : " << mEventRecords.sumTracklets() << " and digits : " << mEventRecords.sumDigits();
+  }
+  int lasttrigger = 0, lastdigit = 0, lasttracklet = 0;
+  //if we get here all is ok.
+  return 1;
+}
+
+bool CruRawReader::splitHalfCRULinks()
+{
+  // copy each link of the current half cru into its own slice of mLinkPayloads followed by guard words taken from the data after it,
+  // so the look ahead of the parsers sees the same words as in place, but never a word another thread is byteswapping.
+  uint32_t slicestart = 0;
+  for (int link = 0; link < constants::NLINKSPERHALFCRU; link++) {
+    uint32_t linksize32 = mCurrentHalfCRULinkLengths[link] * 8;
+    if (slicestart + linksize32 + mLinkGuardWords > mMaxHBFBufferSize || mLinkHBFStart[link] + linksize32 > mMaxHBFBufferSize) {
+      return false; // does not fit, parse in place.
+    }
+    mLinkPayloadStart[link] = slicestart;
+    uint32_t copysize = std::min(linksize32 + mLinkGuardWords, mMaxHBFBufferSize - mLinkHBFStart[link]);
+    std::copy_n(mHBFPayload.begin() + mLinkHBFStart[link], copysize, mLinkPayloads.begin() + slicestart);
+    std::fill(mLinkPayloads.begin() + slicestart + copysize, mLinkPayloads.begin() + slicestart + linksize32 + mLinkGuardWords, 0);
+    slicestart += linksize32 + mLinkGuardWords;
+  }
+  return true;
+}
 
-  mEventRecords.addTracklets(mIR, mTrackletsParser.getTracklets());
+void CruRawReader::parseLink(int link, std::array<uint32_t, o2::trd::constants::HBFBUFFERMAX>* data, std::array<uint32_t, o2::trd::constants::HBFBUFFERMAX>::iterator linkstart,
+                             std::array<uint32_t, o2::trd::constants::HBFBUFFERMAX>::iterator linkend)
+{
+  // parse the tracklets and then the digits of a single link, the output stays in the parsers of this link.
+  mLinkTrackletWordsRead[link] = 0;
+  mLinkDigitWordsRead[link] = 0;
+  int supermodule = ((TRDFeeID*)&mFEEID)->supermodule;
+  int endpoint = ((TRDFeeID*)&mFEEID)->endpoint;
+  int side = ((TRDFeeID*)&mFEEID)->side;
+  //stack layer and side map to ori
+  int stack, layer, halfchamberside;
+  int oriindex = link + constants::NLINKSPERHALFCRU * endpoint; // endpoint denotes the pci side, upper or lower for the pair of 15 fibres.
+  FeeParam::unpackORI(oriindex, side, stack, layer, halfchamberside);
+  int currentdetector = stack * constants::NLAYER + layer + supermodule * constants::NLAYER * constants::NSTACK;
   if (mVerbose) {
-    LOG(info) << "inserting tracklets from parser of size : " << mTrackletsParser.getTracklets().size() << " mEventRecordsTracklets is now :" << mEventRecords.sumTracklets();
+    LOG(info) << "******* LINK # " << link << " and  unpackORI(" << oriindex << "," << side << "," << stack << "," << layer << "," << halfchamberside << ") and an FEEID:" << std::hex << mFEEID << " det:" << std::dec << currentdetector;
   }
-  mTrackletsParser.clear();
-  mEventRecords.addDigits(mIR, std::begin(mDigitsParser.getDigits()), std::end(mDigitsParser.getDigits()));
+  // tracklet first then digit ??
+  // tracklets end with tracklet end marker(0x10001000 0x10001000), digits end with digit endmarker (0x0 0x0)
+  if (linkstart == linkend) {
+    if (mVerbose) {
+      LOG(info) << "link start and end are the same, link appears to be empty for link currentlinkdex";
+    }
+    return;
+  }
+  bool cleardigits = false;
+  int trackletwordsread = mTrackletsParsers[link].Parse(data, linkstart, linkend, mFEEID, halfchamberside, currentdetector, stack, layer, cleardigits, mByteSwap, mTrackletHCHeaderState, mVerbose, mHeaderVerbose, mDataVerbose); // this will read up to the tracklet end marker.
   if (mVerbose) {
-    LOG(info) << "inserting digits from parser of size : " << mDigitsParser.getDigits().size();
+    LOG(info) << "trackletwordsread:" << trackletwordsread << " parsing with linkstart: " << linkstart << " ending at : " << linkend;
+  }
+  linkstart += trackletwordsread;
+  //now we have a tracklethcheader and a digithcheader.
+  int digitwordsread = mDigitsParsers[link].Parse(data, linkstart, linkend, currentdetector, cleardigits, mByteSwap, mVerbose, mHeaderVerbose, mDataVerbose);
+  if (digitwordsread != std::distance(linkstart, linkend)) {
+    //we have the data corruption problem of a pile of stuff at the end of a link, jump over it.
+    if (mFixDigitEndCorruption) {
+      digitwordsread = std::distance(linkstart, linkend);
+    } else {
+      LOG(warn) << "read digits but data still left on the link digitwordsread:" << digitwordsread << " and link length:" << std::distance(linkstart, linkend);
+    }
   }
-  mDigitsParser.clear();
   if (mVerbose) {
-    LOG(info) << "Event digits after eventi # : " << mEventRecords.sumDigits() << " having added : via sum=" << mDigitsParser.getDigits().size() << " digitsfound is " << mDigitsParser.getDigitsFound();
+    LOG(info) << "digitwordsread : " << digitwordsread << " parsing digits with linkstart: " << linkstart << " ending at : " << linkend;
   }
-  int lasttrigger = 0, lastdigit = 0, lasttracklet = 0;
-  //if we get here all is ok.
-  return 1;
+  mLinkTrackletWordsRead[link] = trackletwordsread;
+  mLinkDigitWordsRead[link] = digitwordsread;
+}
+
+void CruRawReader::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  LOG(warn) << "Multithreading is not supported, imposing single thread";
+  mNThreads = 1;
+#endif
 }
 
 bool CruRawReader::buildCRUPayLoad()
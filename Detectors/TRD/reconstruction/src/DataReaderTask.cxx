@@ -35,6 +35,7 @@ namespace o2::trd
 void DataReaderTask::init(InitContext& ic)
 {
   LOG(INFO) << "o2::trd::DataReadTask init";
+  mReader.setNThreads(mNThreads);
 
   auto finishFunction = [this]() {
     mReader.checkSummary();
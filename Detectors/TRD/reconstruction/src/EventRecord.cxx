@@ -152,6 +152,17 @@ void EventStorage::addTracklets(InteractionRecord& ir, std::vector<Tracklet64>::
     //  LOG(info) << "x unknown ir adding " << std::distance(start,end)<< " tracklets";
   }
 }
+EventRecord& EventStorage::getEventRecord(InteractionRecord& ir)
+{
+  for (auto& event : mEventRecords) {
+    if (ir == event.getBCData()) {
+      return event;
+    }
+  }
+  // unseen ir so add it
+  mEventRecords.push_back(ir);
+  return mEventRecords.back();
+}
 void EventStorage::unpackData(std::vector<TriggerRecord>& triggers, std::vector<Tracklet64>& tracklets, std::vector<Digit>& digits)
 {
   int digitcount = 0;
@@ -353,6 +353,58 @@ class TrapSimulator
   // Parameter classes
   FeeParam* mFeeParam{FeeParam::instance()}; // FEE parameters, a singleton
   TrapConfig* mTrapConfig{nullptr};          // TRAP config
+
+  // TRAP register and DMEM values of this MCM needed by the processing chain (filters, ZS, hit detection and fit),
+  // fetched from the TrapConfig once per init() instead of at every sample
+  struct TrapRegisters {
+    // pedestal filter
+    unsigned short fpnp{0}; // pedestal at the output
+    unsigned short fptc{0}; // time constant, 0..3
+    unsigned short fpby{0}; // bypass, active low
+    // gain filter
+    std::array<unsigned short, constants::NADCMCM> fgf{}; // gain correction factors
+    std::array<unsigned short, constants::NADCMCM> fga{}; // additive corrections
+    unsigned short fgby{0};                               // bypass, active low
+    unsigned short fgta{0};                               // threshold A
+    unsigned short fgtb{0};                               // threshold B
+    // tail filter, weight and multipliers already extended as in the TRAP
+    unsigned short alphaLong{0};
+    unsigned short lambdaLong{0};
+    unsigned short lambdaShort{0};
+    unsigned short ftby{0}; // bypass, active low
+    // zero suppression
+    int ebis{0};
+    int ebit{0};
+    int ebil{0};
+    int ebin{0};
+    // hit detection and fit windows
+    int tpfp{0};
+    int tpht{0};
+    int tpvt{0};
+    int tpvby{0};
+    int tpfs{0};
+    int tpfe{0};
+    int tpqs0{0};
+    int tpqe0{0};
+    int tpqs1{0};
+    int tpqe1{0};
+    int tpcl{0};
+    int tpct{0};
+    std::array<int, 128> tpl{}; // position correction LUT
+    // DMEM
+    unsigned int deflCorr{0};
+    unsigned int ndrift{0};
+    unsigned int yCorr{0};
+    unsigned int timeOffset{0};
+    unsigned int lutNBinsQ0{0};
+    unsigned int lutLength{0};
+    unsigned int lutCorrQ0{0};
+    unsigned int lutCorrQ1{0};
+    std::array<unsigned int, mgkDmemAddrDeflCutEnd - mgkDmemAddrDeflCutStart + 1> deflCut{}; // (min, max) deflection per channel
+  };
+  TrapRegisters mRegs; //! not persistent, reloaded from the TRAP config
+
+  void loadTrapRegisters(); // fill mRegs for the current MCM from the TRAP config
   //  CalOnlineGainTables mGainTable;
 
   static const int NOfAdcPerMcm = constants::NADCMCM;
@@ -51,6 +51,7 @@
 #include <ostream>
 #include <fstream>
 #include <numeric>
+#include <algorithm>
 
 using namespace o2::trd;
 using namespace std;
@@ -93,9 +94,69 @@ void TrapSimulator::init(TrapConfig* trapconfig, int det, int robPos, int mcmPos
 
   mNHits = 0;
 
+  loadTrapRegisters();
   reset();
 }
 
+void TrapSimulator::loadTrapRegisters()
+{
+  // Fetch the configuration values for this MCM which are needed by the processing chain.
+  // They can be individual per MCM in the TrapConfig, so they are loaded again at every init().
+
+  auto reg = [this](TrapConfig::TrapReg_t r) { return mTrapConfig->getTrapReg(r, mDetector, mRobPos, mMcmPos); };
+  auto dmem = [this](int addr) { return mTrapConfig->getDmemUnsigned(addr, mDetector, mRobPos, mMcmPos); };
+
+  mRegs.fpnp = reg(TrapConfig::kFPNP);
+  mRegs.fptc = reg(TrapConfig::kFPTC);
+  mRegs.fpby = reg(TrapConfig::kFPBY);
+
+  for (int adc = 0; adc < NADCMCM; adc++) {
+    mRegs.fgf[adc] = reg(TrapConfig::TrapReg_t(TrapConfig::kFGF0 + adc));
+    mRegs.fga[adc] = reg(TrapConfig::TrapReg_t(TrapConfig::kFGA0 + adc));
+  }
+  mRegs.fgby = reg(TrapConfig::kFGBY);
+  mRegs.fgta = reg(TrapConfig::kFGTA);
+  mRegs.fgtb = reg(TrapConfig::kFGTB);
+
+  mRegs.alphaLong = 0x3ff & reg(TrapConfig::kFTAL);
+  mRegs.lambdaLong = (1 << 10) | (1 << 9) | (reg(TrapConfig::kFTLL) & 0x1FF);
+  mRegs.lambdaShort = (0 << 10) | (1 << 9) | (reg(TrapConfig::kFTLS) & 0x1FF);
+  mRegs.ftby = reg(TrapConfig::kFTBY);
+
+  mRegs.ebis = reg(TrapConfig::kEBIS);
+  mRegs.ebit = reg(TrapConfig::kEBIT);
+  mRegs.ebil = reg(TrapConfig::kEBIL);
+  mRegs.ebin = reg(TrapConfig::kEBIN);
+
+  mRegs.tpfp = reg(TrapConfig::kTPFP);
+  mRegs.tpht = reg(TrapConfig::kTPHT);
+  mRegs.tpvt = reg(TrapConfig::kTPVT);
+  mRegs.tpvby = reg(TrapConfig::kTPVBY);
+  mRegs.tpfs = reg(TrapConfig::kTPFS);
+  mRegs.tpfe = reg(TrapConfig::kTPFE);
+  mRegs.tpqs0 = reg(TrapConfig::kTPQS0);
+  mRegs.tpqe0 = reg(TrapConfig::kTPQE0);
+  mRegs.tpqs1 = reg(TrapConfig::kTPQS1);
+  mRegs.tpqe1 = reg(TrapConfig::kTPQE1);
+  mRegs.tpcl = reg(TrapConfig::kTPCL);
+  mRegs.tpct = reg(TrapConfig::kTPCT);
+  for (int i = 0; i < mRegs.tpl.size(); i++) {
+    mRegs.tpl[i] = reg(TrapConfig::TrapReg_t(TrapConfig::kTPL00 + i));
+  }
+
+  mRegs.deflCorr = dmem(mgkDmemAddrDeflCorr);
+  mRegs.ndrift = dmem(mgkDmemAddrNdrift);
+  mRegs.yCorr = dmem(mgkDmemAddrYcorr);
+  mRegs.timeOffset = dmem(mgkDmemAddrTimeOffset);
+  mRegs.lutNBinsQ0 = dmem(mgkDmemAddrLUTnbins);
+  mRegs.lutLength = dmem(mgkDmemAddrLUTLength);
+  mRegs.lutCorrQ0 = dmem(mgkDmemAddrLUTcor0);
+  mRegs.lutCorrQ1 = dmem(mgkDmemAddrLUTcor1);
+  for (int i = 0; i < mRegs.deflCut.size(); i++) {
+    mRegs.deflCut[i] = dmem(mgkDmemAddrDeflCutStart + i);
+  }
+}
+
 void TrapSimulator::reset()
 {
   // Resets the data values and internal filter registers
@@ -807,8 +868,8 @@ void TrapSimulator::setBaselines()
     if ((mADCFilled & (1 << adc)) == 0) { // adc is empty by construction of mADCFilled.
       LOG(debug) << "past if Setting baselines for adc: " << adc << " of " << mDetector << ":" << mRobPos << ":" << mMcmPos;
       for (int timebin = 0; timebin < mNTimeBin; timebin++) {
-        mADCR[adc * mNTimeBin + timebin] = mTrapConfig->getTrapReg(TrapConfig::kFPNP, mDetector, mRobPos, mMcmPos) + (mgAddBaseline << mgkAddDigits);
-        mADCF[adc * mNTimeBin + timebin] = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos) + (mgAddBaseline << mgkAddDigits);
+        mADCR[adc * mNTimeBin + timebin] = mRegs.fpnp + (mgAddBaseline << mgkAddDigits);
+        mADCF[adc * mNTimeBin + timebin] = mRegs.tpfp + (mgAddBaseline << mgkAddDigits);
       }
     }
   }
@@ -829,8 +890,8 @@ void TrapSimulator::setDataPedestal(int adc)
   }
 
   for (int it = 0; it < mNTimeBin; it++) {
-    mADCR[adc * mNTimeBin + it] = mTrapConfig->getTrapReg(TrapConfig::kFPNP, mDetector, mRobPos, mMcmPos) + (mgAddBaseline << mgkAddDigits);
-    mADCF[adc * mNTimeBin + it] = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos) + (mgAddBaseline << mgkAddDigits);
+    mADCR[adc * mNTimeBin + it] = mRegs.fpnp + (mgAddBaseline << mgkAddDigits);
+    mADCF[adc * mNTimeBin + it] = mRegs.tpfp + (mgAddBaseline << mgkAddDigits);
   }
 }
 
@@ -1120,7 +1181,7 @@ void TrapSimulator::filterPedestalInit(int baseline)
   // been constant for a long time (compared to the time constant).
   //  LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
 
-  unsigned short fptc = mTrapConfig->getTrapReg(TrapConfig::kFPTC, mDetector, mRobPos, mMcmPos); // 0..3, 0 - fastest, 3 - slowest
+  unsigned short fptc = mRegs.fptc; // 0..3, 0 - fastest, 3 - slowest
 
   for (int adc = 0; adc < NADCMCM; adc++) {
     mInternalFilterRegisters[adc].mPedAcc = (baseline << 2) * (1 << mgkFPshifts[fptc]);
@@ -1133,11 +1194,10 @@ unsigned short TrapSimulator::filterPedestalNextSample(int adc, int timebin, uns
   // Returns the output of the pedestal filter given the input value.
   // The output depends on the internal registers and, thus, the
   // history of the filter.
-  LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__;
 
-  unsigned short fpnp = mTrapConfig->getTrapReg(TrapConfig::kFPNP, mDetector, mRobPos, mMcmPos); // 0..511 -> 0..127.75, pedestal at the output
-  unsigned short fptc = mTrapConfig->getTrapReg(TrapConfig::kFPTC, mDetector, mRobPos, mMcmPos); // 0..3, 0 - fastest, 3 - slowest
-  unsigned short fpby = mTrapConfig->getTrapReg(TrapConfig::kFPBY, mDetector, mRobPos, mMcmPos); // 0..1 bypass, active low
+  unsigned short fpnp = mRegs.fpnp; // 0..511 -> 0..127.75, pedestal at the output
+  unsigned short fptc = mRegs.fptc; // 0..3, 0 - fastest, 3 - slowest
+  unsigned short fpby = mRegs.fpby; // 0..1 bypass, active low
 
   unsigned short accumulatorShifted;
   unsigned short inpAdd;
@@ -1151,12 +1211,8 @@ unsigned short TrapSimulator::filterPedestalNextSample(int adc, int timebin, uns
     mInternalFilterRegisters[adc].mPedAcc = (mInternalFilterRegisters[adc].mPedAcc + correction) & 0x7FFFFFFF; // 31 bits
   }
 
-  // LOG(debug) << "LEAVE: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
   if (fpby == 0) {
-    LOG(debug) << "LEAVE: (about to)" << __FILE__ << ":" << __func__ << ":" << __LINE__;
-    if (fpby == 0) {
-      return value;
-    }
+    return value;
   }
 
   if (inpAdd <= accumulatorShifted) {
@@ -1181,16 +1237,30 @@ void TrapSimulator::filterPedestal()
   // It has only an effect if previous samples have been fed to
   // find the pedestal. Currently, the simulation assumes that
   // the input has been stable for a sufficiently long time.
-  // LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
+  //
+  // The channels are independent and the accumulator is only updated
+  // in the first time bin, so for the following time bins the filter
+  // is a plain element-wise operation on the channel samples.
 
-  for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
-    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-      int oldadc = mADCF[iAdc * mNTimeBin + iTimeBin];
-      mADCF[iAdc * mNTimeBin + iTimeBin] = filterPedestalNextSample(iAdc, iTimeBin, mADCR[iAdc * mNTimeBin + iTimeBin]);
-      //    LOG(debug) << "mADCF : time : " << iTimeBin << " adc : " << iAdc << " change : " << oldadc << " -> " << mADCF[iAdc * mNTimeBin + iTimeBin];
+  if (mNTimeBin <= 0) {
+    return;
+  }
+  const int fpnp = mRegs.fpnp;
+  const int shift = mgkFPshifts[mRegs.fptc];
+  const bool bypass = (mRegs.fpby == 0);
+
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    const int* adcR = &mADCR[iAdc * mNTimeBin];
+    int* adcF = &mADCF[iAdc * mNTimeBin];
+    adcF[0] = filterPedestalNextSample(iAdc, 0, adcR[0]);
+    const int accumulatorShifted = (mInternalFilterRegisters[iAdc].mPedAcc >> shift) & 0x3FF; // 10 bits
+    for (int iTimeBin = 1; iTimeBin < mNTimeBin; iTimeBin++) {
+      const unsigned short value = adcR[iTimeBin];
+      const int inpAdd = (unsigned short)(value + fpnp);
+      const int out = inpAdd <= accumulatorShifted ? 0 : std::min(inpAdd - accumulatorShifted, 0xFFF);
+      adcF[iTimeBin] = bypass ? value : out;
     }
   }
-  // LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
 }
 
 void TrapSimulator::filterGainInit()
@@ -1212,38 +1282,28 @@ unsigned short TrapSimulator::filterGainNextSample(int adc, unsigned short value
   // BEGIN_LATEX O_{i}(t) = #gamma_{i} * I_{i}(t) + a_{i} END_LATEX
   // The output depends on the internal registers and, thus, the
   // history of the filter.
-  //  if(mDetector==75&& mRobPos==5 && mMcmPos==15) LOG(debug) << "ENTER: " << __FILE__ << ":" << __func__ << ":" << __LINE__ << " with adc = " << adc << " value = " << value;
-
-  unsigned short mgby = mTrapConfig->getTrapReg(TrapConfig::kFGBY, mDetector, mRobPos, mMcmPos);                             // bypass, active low
-  unsigned short mgf = mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGF0 + adc), mDetector, mRobPos, mMcmPos); // 0x700 + (0 & 0x1ff);
-  unsigned short mga = mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGA0 + adc), mDetector, mRobPos, mMcmPos); // 40;
-  unsigned short mgta = mTrapConfig->getTrapReg(TrapConfig::kFGTA, mDetector, mRobPos, mMcmPos);                             // 20;
-  unsigned short mgtb = mTrapConfig->getTrapReg(TrapConfig::kFGTB, mDetector, mRobPos, mMcmPos);                             // 2060;
-  //  mgf=256;
-  //  mga=8;
-  //  mgta=20;
-  //  mgtb=2060;
+
+  unsigned short mgby = mRegs.fgby;    // bypass, active low
+  unsigned short mgf = mRegs.fgf[adc]; // 0x700 + (0 & 0x1ff);
+  unsigned short mga = mRegs.fga[adc]; // 40;
+  unsigned short mgta = mRegs.fgta;    // 20;
+  unsigned short mgtb = mRegs.fgtb;    // 2060;
 
   unsigned int mgfExtended = 0x700 + mgf; // The corr factor which is finally applied has to be extended by 0x700 (hex) or 0.875 (dec)
   // because fgf=0 correspons to 0.875 and fgf=511 correspons to 1.125 - 2^(-11)
   // (see TRAP User Manual for details)
-  //if(mDetector==75&& mRobPos==5 && mMcmPos==15) LOG(debug) << "ENTER: " << __FILE__ << ":" << __func__ << ":" << __LINE__ << " with adc = " << adc << " value = " << value << " Trapconfig values :"  << mgby <<":"<<mgf<<":"<<mga<<":"<<mgta<<":"<<mgtb << ":"<< mgfExtended;
   unsigned int corr; // corrected value
 
-  //  if(mDetector==75&& mRobPos==5 && mMcmPos==15) LOG(debug) << "after declaring corr adc = " << adc << " value = " << value;
   value &= 0xFFF;
   corr = (value * mgfExtended) >> 11;
   corr = corr > 0xfff ? 0xfff : corr;
-  //  if(mDetector==75&& mRobPos==5 && mMcmPos==15) LOG(debug) <<__LINE__ <<  " adc = " << adc << " value = " << value << " corr  : " << corr;
   corr = addUintClipping(corr, mga, 12);
-  //  if(mDetector==75&& mRobPos==5 && mMcmPos==15) LOG(debug) <<__LINE__ <<  " adc = " << adc << " value = " << value << " corr  : " << corr;
 
   // Update threshold counters
   // not really useful as they are cleared with every new event
   if (!((mInternalFilterRegisters[adc].mGainCounterA == 0x3FFFFFF) || (mInternalFilterRegisters[adc].mGainCounterB == 0x3FFFFFF)))
   // stop when full
   {
-    //  if(mDetector==75&& mRobPos==5 && mMcmPos==15) LOG(debug) <<__LINE__ <<  " adc = " << adc << " value = " << value << " corr  : " << corr  << " mgtb : " << mgtb;
     if (corr >= mgtb) {
       mInternalFilterRegisters[adc].mGainCounterB++;
     } else if (corr >= mgta) {
@@ -1251,7 +1311,6 @@ unsigned short TrapSimulator::filterGainNextSample(int adc, unsigned short value
     }
   }
 
-  //  if(mDetector==75&& mRobPos==5 && mMcmPos==15) LOG(debug) <<__LINE__ <<  " adc = " << adc << " value = " << value << " corr  : " << corr  << " mgby : " << mgby;
   //  if (mgby == 1)
   //    return corr;
   //  else
@@ -1276,9 +1335,9 @@ void TrapSimulator::filterTailInit(int baseline)
   // sufficiently long time.
 
   // exponents and weight calculated from configuration
-  unsigned short alphaLong = 0x3ff & mTrapConfig->getTrapReg(TrapConfig::kFTAL, mDetector, mRobPos, mMcmPos);                            // the weight of the long component
-  unsigned short lambdaLong = (1 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLL, mDetector, mRobPos, mMcmPos) & 0x1FF);  // the multiplier
-  unsigned short lambdaShort = (0 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLS, mDetector, mRobPos, mMcmPos) & 0x1FF); // the multiplier
+  unsigned short alphaLong = mRegs.alphaLong;     // the weight of the long component
+  unsigned short lambdaLong = mRegs.lambdaLong;   // the multiplier
+  unsigned short lambdaShort = mRegs.lambdaShort; // the multiplier
 
   float lambdaL = lambdaLong * 1.0 / (1 << 11);
   float lambdaS = lambdaShort * 1.0 / (1 << 11);
@@ -1291,23 +1350,21 @@ void TrapSimulator::filterTailInit(int baseline)
   float ql, qs;
 
   if (baseline < 0) {
-    baseline = mTrapConfig->getTrapReg(TrapConfig::kFPNP, mDetector, mRobPos, mMcmPos);
+    baseline = mRegs.fpnp;
   }
 
   ql = lambdaL * (1 - lambdaS) * alphaL;
   qs = lambdaS * (1 - lambdaL) * (1 - alphaL);
 
-  for (int adc = 0; adc < NADCMCM; adc++) {
-    int value = baseline & 0xFFF;
-    int corr = (value * mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGF0 + adc), mDetector, mRobPos, mMcmPos)) >> 11;
-    corr = corr > 0xfff ? 0xfff : corr;
-    corr = addUintClipping(corr, mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGA0 + adc), mDetector, mRobPos, mMcmPos), 12);
-
-    float kt = kdc * baseline;
-    unsigned short aout = baseline - (unsigned short)kt;
+  // the generator amplitudes do not depend on the channel
+  float kt = kdc * baseline;
+  unsigned short aout = baseline - (unsigned short)kt;
+  unsigned short amplLong = (unsigned short)(aout * ql / (ql + qs));
+  unsigned short amplShort = (unsigned short)(aout * qs / (ql + qs));
 
-    mInternalFilterRegisters[adc].mTailAmplLong = (unsigned short)(aout * ql / (ql + qs));
-    mInternalFilterRegisters[adc].mTailAmplShort = (unsigned short)(aout * qs / (ql + qs));
+  for (int adc = 0; adc < NADCMCM; adc++) {
+    mInternalFilterRegisters[adc].mTailAmplLong = amplLong;
+    mInternalFilterRegisters[adc].mTailAmplShort = amplShort;
   }
 }
 
@@ -1318,9 +1375,9 @@ unsigned short TrapSimulator::filterTailNextSample(int adc, unsigned short value
   // history of the filter.
 
   // exponents and weight calculated from configuration
-  unsigned short alphaLong = 0x3ff & mTrapConfig->getTrapReg(TrapConfig::kFTAL, mDetector, mRobPos, mMcmPos);                            // the weight of the long component
-  unsigned short lambdaLong = (1 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLL, mDetector, mRobPos, mMcmPos) & 0x1FF);  // the multiplier of the long component
-  unsigned short lambdaShort = (0 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLS, mDetector, mRobPos, mMcmPos) & 0x1FF); // the multiplier of the short component
+  unsigned short alphaLong = mRegs.alphaLong;     // the weight of the long component
+  unsigned short lambdaLong = mRegs.lambdaLong;   // the multiplier of the long component
+  unsigned short lambdaShort = mRegs.lambdaShort; // the multiplier of the short component
 
   // intermediate signals
   unsigned int aDiff;
@@ -1354,7 +1411,7 @@ unsigned short TrapSimulator::filterTailNextSample(int adc, unsigned short value
   mInternalFilterRegisters[adc].mTailAmplShort = tmp & 0xFFF;
 
   // the output of the filter
-  if (mTrapConfig->getTrapReg(TrapConfig::kFTBY, mDetector, mRobPos, mMcmPos) == 0) { // bypass mode, active low
+  if (mRegs.ftby == 0) { // bypass mode, active low
     return value;
   } else {
     return aDiff;
@@ -1364,12 +1421,47 @@ unsigned short TrapSimulator::filterTailNextSample(int adc, unsigned short value
 void TrapSimulator::filterTail()
 {
   // Apply tail cancellation filter to all data.
+  //
+  // The filter is recursive in time but the channels are independent,
+  // so all the channels of the MCM are processed together time bin by
+  // time bin, with the generator amplitudes kept in local arrays. The
+  // arithmetic is the same as in filterTailNextSample().
+
+  const unsigned int alphaLong = mRegs.alphaLong;
+  const unsigned int lambdaLong = mRegs.lambdaLong;
+  const unsigned int lambdaShort = mRegs.lambdaShort;
+  const bool bypass = (mRegs.ftby == 0);
+
+  std::array<unsigned int, NADCMCM> amplLong, amplShort;
+  std::array<unsigned int, NADCMCM> samples;
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    amplLong[iAdc] = mInternalFilterRegisters[iAdc].mTailAmplLong;
+    amplShort[iAdc] = mInternalFilterRegisters[iAdc].mTailAmplShort;
+  }
 
   for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
     for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-      mADCF[iAdc * mNTimeBin + iTimeBin] = filterTailNextSample(iAdc, mADCF[iAdc * mNTimeBin + iTimeBin]);
+      samples[iAdc] = (unsigned short)mADCF[iAdc * mNTimeBin + iTimeBin];
+    }
+    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+      const unsigned int value = samples[iAdc];
+      const unsigned int inpVolt = value & 0xFFF;                                   // 12 bits
+      const unsigned int aQ = std::min(amplLong[iAdc] + amplShort[iAdc], 0xFFFu); // present generator outputs
+      const unsigned int aDiff = inpVolt > aQ ? inpVolt - aQ : 0;
+      const unsigned int alInpv = (aDiff * alphaLong) >> 11;
+      amplLong[iAdc] = ((std::min(amplLong[iAdc] + alInpv, 0xFFFu) * lambdaLong) >> 11) & 0xFFF;
+      amplShort[iAdc] = ((std::min(amplShort[iAdc] + (aDiff - alInpv), 0xFFFu) * lambdaShort) >> 11) & 0xFFF;
+      samples[iAdc] = bypass ? value : aDiff;
+    }
+    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+      mADCF[iAdc * mNTimeBin + iTimeBin] = samples[iAdc];
     }
   }
+
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    mInternalFilterRegisters[iAdc].mTailAmplLong = amplLong[iAdc];
+    mInternalFilterRegisters[iAdc].mTailAmplShort = amplShort[iAdc];
+  }
 }
 
 void TrapSimulator::zeroSupressionMapping()
@@ -1386,10 +1478,10 @@ void TrapSimulator::zeroSupressionMapping()
     return;
   }
 
-  int eBIS = mTrapConfig->getTrapReg(TrapConfig::kEBIS, mDetector, mRobPos, mMcmPos);
-  int eBIT = mTrapConfig->getTrapReg(TrapConfig::kEBIT, mDetector, mRobPos, mMcmPos);
-  int eBIL = mTrapConfig->getTrapReg(TrapConfig::kEBIL, mDetector, mRobPos, mMcmPos);
-  int eBIN = mTrapConfig->getTrapReg(TrapConfig::kEBIN, mDetector, mRobPos, mMcmPos);
+  int eBIS = mRegs.ebis;
+  int eBIT = mRegs.ebit;
+  int eBIL = mRegs.ebil;
+  int eBIN = mRegs.ebin;
 
   for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
     mZSMap[iAdc] = -1;
@@ -1471,13 +1563,13 @@ void TrapSimulator::addHitToFitreg(int adc, unsigned short timebin, unsigned sho
     LOG(error) << " adc channel into addHitToFitReg is out of bounds for mFitReg : " << adc;
   }
 
-  if ((timebin >= mTrapConfig->getTrapReg(TrapConfig::kTPQS0, mDetector, mRobPos, mMcmPos)) &&
-      (timebin < mTrapConfig->getTrapReg(TrapConfig::kTPQE0, mDetector, mRobPos, mMcmPos))) {
+  if ((timebin >= mRegs.tpqs0) &&
+      (timebin < mRegs.tpqe0)) {
     mFitReg[adc].mQ0 += qtot;
   }
 
-  if ((timebin >= mTrapConfig->getTrapReg(TrapConfig::kTPQS1, mDetector, mRobPos, mMcmPos)) &&
-      (timebin < mTrapConfig->getTrapReg(TrapConfig::kTPQE1, mDetector, mRobPos, mMcmPos))) {
+  if ((timebin >= mRegs.tpqs1) &&
+      (timebin < mRegs.tpqe1)) {
     mFitReg[adc].mQ1 += qtot;
   }
   // Q2 is simply the addition of times from 3 to 5, for now consts in the header file till they come from a config.
@@ -1485,8 +1577,8 @@ void TrapSimulator::addHitToFitreg(int adc, unsigned short timebin, unsigned sho
     mFitReg[adc].mQ2 += qtot;
   }
 
-  if ((timebin >= mTrapConfig->getTrapReg(TrapConfig::kTPFS, mDetector, mRobPos, mMcmPos)) &&
-      (timebin < mTrapConfig->getTrapReg(TrapConfig::kTPFE, mDetector, mRobPos, mMcmPos))) {
+  if ((timebin >= mRegs.tpfs) &&
+      (timebin < mRegs.tpfe)) {
     mFitReg[adc].mSumX += timebin;
     mFitReg[adc].mSumX2 += timebin * timebin;
     mFitReg[adc].mNhits++;
@@ -1522,11 +1614,12 @@ void TrapSimulator::calcFitreg()
   // has to be called before even if all filters are bypassed.
   //??? to be clarified:
   LOG(debug) << "ENTERING : " << __FILE__ << ":" << __func__ << ":" << __LINE__ << " :: " << getDetector() << ":" << getRobPos() << ":" << getMcmPos() << " -------------------- mNHits : " << mNHits;
-  unsigned int adcMask = 0xffffffff;
+  const bool bypassQuality = (mRegs.tpvby == 0);
+  const int tpvt = mRegs.tpvt;
+  const int tpht = mRegs.tpht;
 
-  bool hitQual;
   int adcLeft, adcCentral, adcRight;
-  unsigned short timebin, adcch, timebin1, timebin2, qtotTemp;
+  unsigned short timebin, adcch, timebin1, timebin2;
   short ypos, fromLeft, fromRight, found;
   std::array<unsigned short, 20> qTotal{}; //[19 + 1]; // the last is dummy
   std::array<unsigned short, 6> marked{}, qMarked{};
@@ -1537,21 +1630,21 @@ void TrapSimulator::calcFitreg()
     timebin2 = mNTimeBin;
   } else {
     // find first timebin to be looked at
-    timebin1 = mTrapConfig->getTrapReg(TrapConfig::kTPFS, mDetector, mRobPos, mMcmPos);
-    if (mTrapConfig->getTrapReg(TrapConfig::kTPQS0, mDetector, mRobPos, mMcmPos) < timebin1) {
-      timebin1 = mTrapConfig->getTrapReg(TrapConfig::kTPQS0, mDetector, mRobPos, mMcmPos);
+    timebin1 = mRegs.tpfs;
+    if (mRegs.tpqs0 < timebin1) {
+      timebin1 = mRegs.tpqs0;
     }
-    if (mTrapConfig->getTrapReg(TrapConfig::kTPQS1, mDetector, mRobPos, mMcmPos) < timebin1) {
-      timebin1 = mTrapConfig->getTrapReg(TrapConfig::kTPQS1, mDetector, mRobPos, mMcmPos);
+    if (mRegs.tpqs1 < timebin1) {
+      timebin1 = mRegs.tpqs1;
     }
 
     // find last timebin to be looked at
-    timebin2 = mTrapConfig->getTrapReg(TrapConfig::kTPFE, mDetector, mRobPos, mMcmPos);
-    if (mTrapConfig->getTrapReg(TrapConfig::kTPQE0, mDetector, mRobPos, mMcmPos) > timebin2) {
-      timebin2 = mTrapConfig->getTrapReg(TrapConfig::kTPQE0, mDetector, mRobPos, mMcmPos);
+    timebin2 = mRegs.tpfe;
+    if (mRegs.tpqe0 > timebin2) {
+      timebin2 = mRegs.tpqe0;
     }
-    if (mTrapConfig->getTrapReg(TrapConfig::kTPQE1, mDetector, mRobPos, mMcmPos) > timebin2) {
-      timebin2 = mTrapConfig->getTrapReg(TrapConfig::kTPQE1, mDetector, mRobPos, mMcmPos);
+    if (mRegs.tpqe1 > timebin2) {
+      timebin2 = mRegs.tpqe1;
     }
   }
 
@@ -1568,50 +1661,18 @@ void TrapSimulator::calcFitreg()
   for (timebin = timebin1; timebin < timebin2; timebin++) {
     // first find the hit candidates and store the total cluster charge in qTotal array
     // in case of not hit store 0 there.
-    for (adcch = 0; adcch < NADCMCM - 2; adcch++) {
-      if (((adcMask >> adcch) & 7) == 7) //??? all 3 channels are present in case of ZS
-      {
-        adcLeft = mADCF[adcch * mNTimeBin + timebin];
-        adcCentral = mADCF[(adcch + 1) * mNTimeBin + timebin];
-        adcRight = mADCF[(adcch + 2) * mNTimeBin + timebin];
-
-        if (mTrapConfig->getTrapReg(TrapConfig::kTPVBY, mDetector, mRobPos, mMcmPos) == 0) {
-          // bypass the cluster verification
-          hitQual = true;
-        } else {
-          hitQual = ((adcLeft * adcRight) <
-                     ((mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos) * adcCentral * adcCentral) >> 10));
-          if (hitQual) {
-            LOG(debug) << "cluster quality cut passed with " << adcLeft << ", " << adcCentral << ", "
-                       << adcRight << " - threshold " << mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos)
-                       << " -> " << mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos) * adcCentral * adcCentral;
-          }
-        }
-
-        // The accumulated charge is with the pedestal!!!
-        qtotTemp = adcLeft + adcCentral + adcRight;
-        if ((qtotTemp > 130)) {
-          LOG(debug) << "qtotTemp>130 "
-                     << "qtot=" << qtotTemp
-                     << " qleft=" << adcLeft
-                     << " qcent=" << adcCentral
-                     << " qright=" << adcRight
-                     << " for " << mDetector << ":" << mRobPos << ":" << mMcmPos << ":adcleft:" << adcch << ":t" << timebin;
-        }
-
-        if ((hitQual) &&
-            (qtotTemp >= mTrapConfig->getTrapReg(TrapConfig::kTPHT, mDetector, mRobPos, mMcmPos)) &&
-            (adcLeft <= adcCentral) &&
-            (adcCentral > adcRight)) {
-          qTotal[adcch] = qtotTemp;
-        } else {
-          qTotal[adcch] = 0;
-        }
-      } else {
-        qTotal[adcch] = 0; //jkl
-      }
-      //     if (qTotal[adcch] != 0)
-      //     LOG(debug) << "ch " << setw(2) << adcch << "   qTotal " << qTotal[adcch];
+    // All the channels of the MCM are checked at once (all 3 channels are always present, there is no ZS at this stage),
+    // without branches so that the loop maps to SIMD lanes.
+    const int* adcF = &mADCF[timebin];
+    for (int ch = 0; ch < NADCMCM - 2; ch++) {
+      const int adcL = adcF[ch * mNTimeBin];
+      const int adcC = adcF[(ch + 1) * mNTimeBin];
+      const int adcR = adcF[(ch + 2) * mNTimeBin];
+      // the cluster verification can be bypassed
+      const bool quality = bypassQuality || ((adcL * adcR) < ((tpvt * adcC * adcC) >> 10));
+      // The accumulated charge is with the pedestal!!!
+      const unsigned short qtot = adcL + adcC + adcR;
+      qTotal[ch] = (quality && (qtot >= tpht) && (adcL <= adcC) && (adcC > adcR)) ? qtot : 0;
     }
 
     fromLeft = -1;
@@ -1694,10 +1755,10 @@ void TrapSimulator::calcFitreg()
         // hit detected, in TRAP we have 4 units and a hit-selection, here we proceed all channels!
         // subtract the pedestal TPFP, clipping instead of wrapping
 
-        int regTPFP = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos); //TODO put this together with the others as members of trapsim, which is initiliased by det,rob,mcm.
+        int regTPFP = mRegs.tpfp;
         LOG(debug) << "Hit found, time=" << timebin << ", adcch=" << adcch << "/" << adcch + 1 << "/"
                    << adcch + 2 << ", adc values=" << adcLeft << "/" << adcCentral << "/"
-                   << adcRight << ", regTPFP=" << regTPFP << ", TPHT=" << mTrapConfig->getTrapReg(TrapConfig::kTPHT, mDetector, mRobPos, mMcmPos);
+                   << adcRight << ", regTPFP=" << regTPFP << ", TPHT=" << mRegs.tpht;
         if (adcLeft < regTPFP) {
           adcLeft = 0;
         } else {
@@ -1727,8 +1788,7 @@ void TrapSimulator::calcFitreg()
         // make the correction using the position LUT
         LOG(debug) << "ypos raw is " << ypos << "  adcrigh-adcleft/adccentral " << adcRight << "-" << adcLeft << "/" << adcCentral << "==" << (adcRight - adcLeft) / adcCentral << " 128 * numerator : " << 128 * (adcRight - adcLeft) / adcCentral;
         LOG(debug) << "ypos before lut correction : " << ypos;
-        ypos = ypos + mTrapConfig->getTrapReg((TrapConfig::TrapReg_t)(TrapConfig::kTPL00 + (ypos & 0x7F)),
-                                              mDetector, mRobPos, mMcmPos);
+        ypos = ypos + mRegs.tpl[ypos & 0x7F];
         LOG(debug) << "ypos after lut correction : " << ypos;
         if (adcLeft > adcRight) {
           ypos = -ypos;
@@ -1767,8 +1827,8 @@ void TrapSimulator::trackletSelection()
 
   ntracks = 0;
   for (adcIdx = 0; adcIdx < 18; adcIdx++) { // ADCs
-    if ((mFitReg[adcIdx].mNhits >= mTrapConfig->getTrapReg(TrapConfig::kTPCL, mDetector, mRobPos, mMcmPos)) &&
-        (mFitReg[adcIdx].mNhits + mFitReg[adcIdx + 1].mNhits >= mTrapConfig->getTrapReg(TrapConfig::kTPCT, mDetector, mRobPos, mMcmPos))) {
+    if ((mFitReg[adcIdx].mNhits >= mRegs.tpcl) &&
+        (mFitReg[adcIdx].mNhits + mFitReg[adcIdx + 1].mNhits >= mRegs.tpct)) {
       trackletCandch[ntracks] = adcIdx;
       trackletCandhits[ntracks] = mFitReg[adcIdx].mNhits + mFitReg[adcIdx + 1].mNhits;
       //   LOG(debug) << ntracks << " " << trackletCandch[ntracks] << " " << trackletCandhits[ntracks];
@@ -1884,7 +1944,7 @@ void TrapSimulator::fitTracklet()
   // add corrections for mis-alignment
   if (FeeParam::instance()->getUseMisalignCorr()) {
     LOG(debug) << "using mis-alignment correction";
-    yoffs += (int)mTrapConfig->getDmemUnsigned(mgkDmemAddrYcorr, mDetector, mRobPos, mMcmPos);
+    yoffs += (int)mRegs.yCorr;
   }
 
   yoffs = yoffs << decPlaces; // holds position of ADC channel 1
@@ -1894,8 +1954,8 @@ void TrapSimulator::fitTracklet()
   // the slope is given in units of 1/1000 pads/timebin
   unsigned long scaleD = (unsigned long)(PADGRANULARITYTRKLSLOPE / 256. * shift);
   LOG(debug) << "scaleY : " << scaleY << "  scaleD=" << scaleD << " shift:" << std::hex << shift << std::dec;
-  int deflCorr = (int)mTrapConfig->getDmemUnsigned(mgkDmemAddrDeflCorr, mDetector, mRobPos, mMcmPos);
-  int ndrift = (int)mTrapConfig->getDmemUnsigned(mgkDmemAddrNdrift, mDetector, mRobPos, mMcmPos);
+  int deflCorr = (int)mRegs.deflCorr;
+  int ndrift = (int)mRegs.ndrift;
 
   // local variables for calculation
   long mult, temp, denom;
@@ -1928,7 +1988,7 @@ void TrapSimulator::fitTracklet()
       LOG(debug) << "after mult is : " << mult << " and in hex : 0x" << std::hex << mult << std::dec;
 
       // time offset for fit sums
-      const int t0 = FeeParam::instance()->getUseTimeOffset() ? (int)mTrapConfig->getDmemUnsigned(mgkDmemAddrTimeOffset, mDetector, mRobPos, mMcmPos) : 0;
+      const int t0 = FeeParam::instance()->getUseTimeOffset() ? (int)mRegs.timeOffset : 0;
 
       LOG(debug) << "using time offset of t0 = " << t0;
 
@@ -1991,7 +2051,7 @@ void TrapSimulator::fitTracklet()
       LOG(debug) << "position = " << position;
       LOG(debug) << "slope = " << slope;
 
-      LOG(debug) << "Det: " << setw(3) << mDetector << ", ROB: " << mRobPos << ", MCM: " << setw(2) << mMcmPos << setw(-1) << ": deflection: " << slope << ", min: " << (int)mTrapConfig->getDmemUnsigned(mgkDmemAddrDeflCutStart + 2 * mFitPtr[cpu], mDetector, mRobPos, mMcmPos) << " max : " << (int)mTrapConfig->getDmemUnsigned(mgkDmemAddrDeflCutStart + 1 + 2 * mFitPtr[cpu], mDetector, mRobPos, mMcmPos);
+      LOG(debug) << "Det: " << setw(3) << mDetector << ", ROB: " << mRobPos << ", MCM: " << setw(2) << mMcmPos << setw(-1) << ": deflection: " << slope << ", min: " << (int)mRegs.deflCut[2 * mFitPtr[cpu]] << " max : " << (int)mRegs.deflCut[1 + 2 * mFitPtr[cpu]];
 
       LOG(debug) << "Fit sums: x = " << sumX << ", X = " << sumX2 << ", y = " << sumY << ", Y = " << sumY2 << ", Z = " << sumXY << ", q0 = " << q0 << ", q1 = " << q1;
 
@@ -2012,8 +2072,8 @@ void TrapSimulator::fitTracklet()
 
       bool rejected = false;
       // deflection range table from DMEM
-      if ((slope < ((int)mTrapConfig->getDmemUnsigned(mgkDmemAddrDeflCutStart + 2 * mFitPtr[cpu], mDetector, mRobPos, mMcmPos))) ||
-          (slope > ((int)mTrapConfig->getDmemUnsigned(mgkDmemAddrDeflCutStart + 1 + 2 * mFitPtr[cpu], mDetector, mRobPos, mMcmPos)))) {
+      if ((slope < ((int)mRegs.deflCut[2 * mFitPtr[cpu]])) ||
+          (slope > ((int)mRegs.deflCut[1 + 2 * mFitPtr[cpu]]))) {
         rejected = true;
       }
 
@@ -2054,12 +2114,12 @@ void TrapSimulator::fitTracklet()
           }
 
           // counting contributing hits
-          if (mHits[iHit].mTimebin >= mTrapConfig->getTrapReg(TrapConfig::kTPQS0, mDetector, mRobPos, mMcmPos) &&
-              mHits[iHit].mTimebin < mTrapConfig->getTrapReg(TrapConfig::kTPQE0, mDetector, mRobPos, mMcmPos)) {
+          if (mHits[iHit].mTimebin >= mRegs.tpqs0 &&
+              mHits[iHit].mTimebin < mRegs.tpqe0) {
             nHits[0]++;
           }
-          if (mHits[iHit].mTimebin >= mTrapConfig->getTrapReg(TrapConfig::kTPQS1, mDetector, mRobPos, mMcmPos) &&
-              mHits[iHit].mTimebin < mTrapConfig->getTrapReg(TrapConfig::kTPQE1, mDetector, mRobPos, mMcmPos)) {
+          if (mHits[iHit].mTimebin >= mRegs.tpqs1 &&
+              mHits[iHit].mTimebin < mRegs.tpqe1) {
             nHits[1]++;
           }
           if (mHits[iHit].mTimebin >= 3 && //TODO this needs to come from trapconfig, its not there yet.
@@ -2158,14 +2218,14 @@ int TrapSimulator::getPID(int q0, int q1)
   unsigned long long addrQ0;
   unsigned long long addr;
 
-  unsigned int nBinsQ0 = mTrapConfig->getDmemUnsigned(mgkDmemAddrLUTnbins, mDetector, mRobPos, mMcmPos); // number of bins in q0 / 4 !!
-  unsigned int pidTotalSize = mTrapConfig->getDmemUnsigned(mgkDmemAddrLUTLength, mDetector, mRobPos, mMcmPos);
+  unsigned int nBinsQ0 = mRegs.lutNBinsQ0; // number of bins in q0 / 4 !!
+  unsigned int pidTotalSize = mRegs.lutLength;
   if (nBinsQ0 == 0 || pidTotalSize == 0) { // make sure we don't run into trouble if the value for Q0 is not configured
     return 0;                              // Q1 not configured is ok for 1D LUT
   }
 
-  unsigned long corrQ0 = mTrapConfig->getDmemUnsigned(mgkDmemAddrLUTcor0, mDetector, mRobPos, mMcmPos);
-  unsigned long corrQ1 = mTrapConfig->getDmemUnsigned(mgkDmemAddrLUTcor1, mDetector, mRobPos, mMcmPos);
+  unsigned long corrQ0 = mRegs.lutCorrQ0;
+  unsigned long corrQ1 = mRegs.lutCorrQ1;
   if (corrQ0 == 0) { // make sure we don't run into trouble if one of the values is not configured
     return 0;
   }
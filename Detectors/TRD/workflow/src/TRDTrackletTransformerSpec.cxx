@@ -91,18 +91,15 @@ void TRDTrackletTransformerSpec::run(o2::framework::ProcessingContext& pc)
         continue;
       } else {
         const auto& trigRec = trigRecs[iTrig];
-        for (int iTrklt = trigRec.getFirstTracklet(); iTrklt < trigRec.getFirstTracklet() + trigRec.getNumberOfTracklets(); ++iTrklt) {
-          calibratedTracklets[iTrklt] = mTransformer.transformTracklet(tracklets[iTrklt]);
-          ++nTrackletsTransformed;
-        }
+        mTransformer.transformTracklets(tracklets.subspan(trigRec.getFirstTracklet(), trigRec.getNumberOfTracklets()),
+                                        gsl::span<CalibratedTracklet>(calibratedTracklets).subspan(trigRec.getFirstTracklet(), trigRec.getNumberOfTracklets()));
+        nTrackletsTransformed += trigRec.getNumberOfTracklets();
       }
     }
   } else {
     // transform all tracklets
-    for (int iTrklt = 0; iTrklt < tracklets.size(); ++iTrklt) {
-      calibratedTracklets[iTrklt] = mTransformer.transformTracklet(tracklets[iTrklt]);
-      ++nTrackletsTransformed;
-    }
+    mTransformer.transformTracklets(tracklets, calibratedTracklets);
+    nTrackletsTransformed = tracklets.size();
   }
 
   LOGF(INFO, "Found %lu tracklets. Applied filter for ITS IR frames: %i. Transformed %i tracklets.", tracklets.size(), mTrigRecFilterActive, nTrackletsTransformed);
@@ -0,0 +1,132 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FastTracker.h
+/// \brief Parameterised fast simulation of the ALICE 3 tracking
+
+//******************************************************************
+// ALICE 3 fast tracker
+//
+// The generated particles are followed on their helix through a
+// description of the TRK barrel layers and of the FT3 disks, and the
+// layers they cross give, through the Gluckstern formula and the
+// multiple scattering in the crossed material, the expected track
+// resolution and the probability to collect enough hits. These are
+// tabulated once per particle species in bins of pt and eta, so that
+// the smearing of a particle is a lookup and a few random numbers.
+//
+// The smearing is const and only uses the random generator it is
+// given, so that the events can be smeared concurrently.
+//
+//******************************************************************
+#ifndef ALICE3_FASTTRACKER_H
+#define ALICE3_FASTTRACKER_H
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+#include "MathUtils/Cartesian.h"
+#include "ReconstructionDataFormats/Track.h"
+#include "ReconstructionDataFormats/PID.h"
+
+namespace o2
+{
+namespace upgrades_utils
+{
+
+/// A layer of the fast tracker: a barrel cylinder or a disk perpendicular to the beam
+struct FastLayer {
+  bool disk = false;      /// disk (true) or barrel layer (false)
+  float r = 0.f;          /// radius of the barrel layer (cm)
+  float z = 0.f;          /// z of the disk, half length of the barrel layer (cm)
+  float rMin = 0.f;       /// inner radius of the disk (cm)
+  float rMax = 0.f;       /// outer radius of the disk (cm)
+  float x2X0 = 0.f;       /// material budget at normal incidence
+  float resolution = 0.f; /// point resolution (cm)
+  float efficiency = 1.f; /// hit efficiency
+};
+
+/// Tabulated response of the tracker for a particle species, pt and eta
+struct FastLUTEntry {
+  float efficiency = 0.f; /// probability to reconstruct the track
+  float sigmaY = 0.f;     /// resolution of the local Y at the vertex (cm)
+  float sigmaZ = 0.f;     /// resolution of the local Z at the vertex (cm)
+  float sigmaSnp = 0.f;   /// resolution of sin(phi)
+  float sigmaTgl = 0.f;   /// resolution of tan(lambda)
+  float sigmaPtRel = 0.f; /// relative resolution of q/pt
+};
+
+class FastTracker
+{
+ public:
+  /// the species for which the response is tabulated
+  static constexpr int NSpecies = o2::track::PID::Proton + 1;
+
+  void setBz(float bz) { mBz = bz; }
+  float getBz() const { return mBz; }
+  void setMinHits(int n) { mMinHits = n; }
+  int getMinHits() const { return mMinHits; }
+
+  void addBarrelLayer(float r, float length, float x2X0, float resolution, float efficiency = 1.f);
+  void addDisk(float z, float rMin, float rMax, float x2X0, float resolution, float efficiency = 1.f);
+  const std::vector<FastLayer>& getLayers() const { return mLayers; }
+  void clearLayers() { mLayers.clear(); }
+
+  /// adds the 12 TRK barrel layers and the 2 x 10 FT3 disks of the default geometries
+  void addALICE3Layers(float resolution = 5.e-4f);
+
+  /// reads the layers from a text file, one layer per line:
+  /// "barrel r length x2X0 resolution [efficiency]" or "disk z rMin rMax x2X0 resolution [efficiency]"
+  bool readLayers(const std::string& fileName);
+
+  /// tabulates the response in nPt logarithmic pt bins and nEta eta bins
+  void buildLUT(int nPt = 100, float ptMin = 0.01f, float ptMax = 100.f, int nEta = 80, float etaMax = 4.f);
+
+  /// response computed from the layers at the given pt and eta, for a particle from the nominal vertex
+  FastLUTEntry computeResponse(o2::track::PID::ID species, float pt, float eta) const;
+
+  /// tabulated response, for pt and eta outside the table the closest bin is used
+  const FastLUTEntry& getResponse(o2::track::PID::ID species, float pt, float eta) const;
+
+  /// species and charge of a particle of the given PDG code
+  /// \return false if the particle is not tracked (neutral, short lived or not tabulated)
+  static bool getSpecies(int pdg, o2::track::PID::ID& species, int& charge);
+
+  /// smears a generated particle at the vertex
+  /// \param xyz, pxpypz  production point and momentum of the particle
+  /// \param vertex       collision vertex to which the track is propagated
+  /// \return false if the track is not reconstructed
+  bool smear(int pdg, const std::array<float, 3>& xyz, const std::array<float, 3>& pxpypz,
+             const o2::math_utils::Point3D<float>& vertex, std::mt19937_64& generator,
+             o2::track::TrackParCov& track) const;
+
+ private:
+  int getPtBin(float pt) const;
+  int getEtaBin(float eta) const;
+
+  std::vector<FastLayer> mLayers;
+  float mBz = 5.f;  /// magnetic field (kG)
+  int mMinHits = 4; /// minimum number of hits of a reconstructed track
+
+  int mNPt = 0;
+  float mLogPtMin = 0.f;
+  float mLogPtStep = 1.f;
+  int mNEta = 0;
+  float mEtaMax = 0.f;
+  float mEtaStep = 1.f;
+  std::vector<FastLUTEntry> mLUT; /// [species][pt][eta]
+};
+
+} // namespace upgrades_utils
+} // namespace o2
+
+#endif
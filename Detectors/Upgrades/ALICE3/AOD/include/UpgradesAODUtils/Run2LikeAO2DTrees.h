@@ -0,0 +1,232 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file Run2LikeAO2DTrees.h
+
+//******************************************************************
+// AO2D helper trees
+//
+// This header creates the trees of a Run 2-like converted AO2D file
+// and their branches, attached to the structures of Run2LikeAO2D.h.
+// It is shared by the ALICE 3 converters so that they all write the
+// same layout. It is kept in the header since the branches point to
+// the structures of the binary which includes it.
+//
+//******************************************************************
+#ifndef RUN2LIKE_AOD_TREES_H
+#define RUN2LIKE_AOD_TREES_H
+#include <TTree.h>
+#include "UpgradesAODUtils/Run2LikeAO2D.h"
+
+namespace o2
+{
+namespace upgrades_utils
+{
+
+/// create the trees selected by gSaveTree in the current directory, nullptr for the others
+inline void createTrees(TTree* fTree[kTrees], int fBasketSizeEvents = 1000000, int fBasketSizeTracks = 10000000)
+{
+  for (Int_t ii = 0; ii < kTrees; ii++) {
+    fTree[ii] = nullptr;
+    if (gSaveTree[ii]) {
+      fTree[ii] = new TTree(gTreeName[ii], gTreeTitle[ii]);
+      fTree[ii]->SetAutoFlush(0);
+    }
+  }
+
+  if (gSaveTree[kEvents]) {
+    fTree[kEvents]->Branch("fBCsID", &collision.fBCsID, "fBCsID/I");
+    fTree[kEvents]->Branch("fPosX", &collision.fPosX, "fPosX/F");
+    fTree[kEvents]->Branch("fPosY", &collision.fPosY, "fPosY/F");
+    fTree[kEvents]->Branch("fPosZ", &collision.fPosZ, "fPosZ/F");
+    fTree[kEvents]->Branch("fCovXX", &collision.fCovXX, "fCovXX/F");
+    fTree[kEvents]->Branch("fCovXY", &collision.fCovXY, "fCovXY/F");
+    fTree[kEvents]->Branch("fCovXZ", &collision.fCovXZ, "fCovXZ/F");
+    fTree[kEvents]->Branch("fCovYY", &collision.fCovYY, "fCovYY/F");
+    fTree[kEvents]->Branch("fCovYZ", &collision.fCovYZ, "fCovYZ/F");
+    fTree[kEvents]->Branch("fCovZZ", &collision.fCovZZ, "fCovZZ/F");
+    fTree[kEvents]->Branch("fChi2", &collision.fChi2, "fChi2/F");
+    fTree[kEvents]->Branch("fNumContrib", &collision.fN, "fNumContrib/i");
+    fTree[kEvents]->Branch("fCollisionTime", &collision.fCollisionTime, "fCollisionTime/F");
+    fTree[kEvents]->Branch("fCollisionTimeRes", &collision.fCollisionTimeRes, "fCollisionTimeRes/F");
+    fTree[kEvents]->Branch("fCollisionTimeMask", &collision.fCollisionTimeMask, "fCollisionTimeMask/b");
+    fTree[kEvents]->SetBasketSize("*", fBasketSizeEvents);
+  }
+
+  if (gSaveTree[kTracks]) {
+    fTree[kTracks]->Branch("fCollisionsID", &tracks.fCollisionsID, "fCollisionsID/I");
+    fTree[kTracks]->Branch("fTrackType", &tracks.fTrackType, "fTrackType/b");
+    //    fTree[kTracks]->Branch("fTOFclsIndex", &tracks.fTOFclsIndex, "fTOFclsIndex/I");
+    //    fTree[kTracks]->Branch("fNTOFcls", &tracks.fNTOFcls, "fNTOFcls/I");
+    fTree[kTracks]->Branch("fX", &tracks.fX, "fX/F");
+    fTree[kTracks]->Branch("fAlpha", &tracks.fAlpha, "fAlpha/F");
+    fTree[kTracks]->Branch("fY", &tracks.fY, "fY/F");
+    fTree[kTracks]->Branch("fZ", &tracks.fZ, "fZ/F");
+    fTree[kTracks]->Branch("fSnp", &tracks.fSnp, "fSnp/F");
+    fTree[kTracks]->Branch("fTgl", &tracks.fTgl, "fTgl/F");
+    fTree[kTracks]->Branch("fSigned1Pt", &tracks.fSigned1Pt, "fSigned1Pt/F");
+    // Modified covariance matrix
+    fTree[kTracks]->Branch("fSigmaY", &tracks.fSigmaY, "fSigmaY/F");
+    fTree[kTracks]->Branch("fSigmaZ", &tracks.fSigmaZ, "fSigmaZ/F");
+    fTree[kTracks]->Branch("fSigmaSnp", &tracks.fSigmaSnp, "fSigmaSnp/F");
+    fTree[kTracks]->Branch("fSigmaTgl", &tracks.fSigmaTgl, "fSigmaTgl/F");
+    fTree[kTracks]->Branch("fSigma1Pt", &tracks.fSigma1Pt, "fSigma1Pt/F");
+    fTree[kTracks]->Branch("fRhoZY", &tracks.fRhoZY, "fRhoZY/B");
+    fTree[kTracks]->Branch("fRhoSnpY", &tracks.fRhoSnpY, "fRhoSnpY/B");
+    fTree[kTracks]->Branch("fRhoSnpZ", &tracks.fRhoSnpZ, "fRhoSnpZ/B");
+    fTree[kTracks]->Branch("fRhoTglY", &tracks.fRhoTglY, "fRhoTglY/B");
+    fTree[kTracks]->Branch("fRhoTglZ", &tracks.fRhoTglZ, "fRhoTglZ/B");
+    fTree[kTracks]->Branch("fRhoTglSnp", &tracks.fRhoTglSnp, "fRhoTglSnp/B");
+    fTree[kTracks]->Branch("fRho1PtY", &tracks.fRho1PtY, "fRho1PtY/B");
+    fTree[kTracks]->Branch("fRho1PtZ", &tracks.fRho1PtZ, "fRho1PtZ/B");
+    fTree[kTracks]->Branch("fRho1PtSnp", &tracks.fRho1PtSnp, "fRho1PtSnp/B");
+    fTree[kTracks]->Branch("fRho1PtTgl", &tracks.fRho1PtTgl, "fRho1PtTgl/B");
+    //
+    fTree[kTracks]->Branch("fTPCInnerParam", &tracks.fTPCinnerP, "fTPCInnerParam/F");
+    fTree[kTracks]->Branch("fFlags", &tracks.fFlags, "fFlags/i");
+    fTree[kTracks]->Branch("fITSClusterMap", &tracks.fITSClusterMap, "fITSClusterMap/b");
+    fTree[kTracks]->Branch("fTPCNClsFindable", &tracks.fTPCNClsFindable, "fTPCNClsFindable/b");
+    fTree[kTracks]->Branch("fTPCNClsFindableMinusFound", &tracks.fTPCNClsFindableMinusFound, "fTPCNClsFindableMinusFound/B");
+    fTree[kTracks]->Branch("fTPCNClsFindableMinusCrossedRows", &tracks.fTPCNClsFindableMinusCrossedRows, "fTPCNClsFindableMinusCrossedRows/B");
+    fTree[kTracks]->Branch("fTPCNClsShared", &tracks.fTPCNClsShared, "fTPCNClsShared/b");
+    fTree[kTracks]->Branch("fTRDPattern", &tracks.fTRDPattern, "fTRDPattern/b");
+    fTree[kTracks]->Branch("fITSChi2NCl", &tracks.fITSChi2NCl, "fITSChi2NCl/F");
+    fTree[kTracks]->Branch("fTPCChi2NCl", &tracks.fTPCChi2NCl, "fTPCChi2NCl/F");
+    fTree[kTracks]->Branch("fTRDChi2", &tracks.fTRDChi2, "fTRDChi2/F");
+    fTree[kTracks]->Branch("fTOFChi2", &tracks.fTOFChi2, "fTOFChi2/F");
+    fTree[kTracks]->Branch("fTPCSignal", &tracks.fTPCSignal, "fTPCSignal/F");
+    fTree[kTracks]->Branch("fTRDSignal", &tracks.fTRDSignal, "fTRDSignal/F");
+    fTree[kTracks]->Branch("fTOFSignal", &tracks.fTOFSignal, "fTOFSignal/F");
+    fTree[kTracks]->Branch("fLength", &tracks.fLength, "fLength/F");
+    fTree[kTracks]->Branch("fTOFExpMom", &tracks.fTOFExpMom, "fTOFExpMom/F");
+    fTree[kTracks]->Branch("fTrackEtaEMCAL", &tracks.fTrackEtaEMCAL, "fTrackEtaEMCAL/F");
+    fTree[kTracks]->Branch("fTrackPhiEMCAL", &tracks.fTrackPhiEMCAL, "fTrackPhiEMCAL/F");
+    fTree[kTracks]->SetBasketSize("*", fBasketSizeTracks);
+  }
+
+  if (gSaveTree[kMcTrackLabel]) {
+    fTree[kMcTrackLabel]->Branch("fLabel", &mctracklabel.fLabel, "fLabel/i");
+    fTree[kMcTrackLabel]->Branch("fLabelMask", &mctracklabel.fLabelMask, "fLabelMask/s");
+    fTree[kMcTrackLabel]->SetBasketSize("*", fBasketSizeTracks);
+  }
+
+  if (gSaveTree[kMcCollision]) {
+    fTree[kMcCollision]->Branch("fBCsID", &mccollision.fBCsID, "fBCsID/I");
+    fTree[kMcCollision]->Branch("fGeneratorsID", &mccollision.fGeneratorsID, "fGeneratorsID/S");
+    fTree[kMcCollision]->Branch("fPosX", &mccollision.fPosX, "fPosX/F");
+    fTree[kMcCollision]->Branch("fPosY", &mccollision.fPosY, "fPosY/F");
+    fTree[kMcCollision]->Branch("fPosZ", &mccollision.fPosZ, "fPosZ/F");
+    fTree[kMcCollision]->Branch("fT", &mccollision.fT, "fT/F");
+    fTree[kMcCollision]->Branch("fWeight", &mccollision.fWeight, "fWeight/F");
+    fTree[kMcCollision]->Branch("fImpactParameter", &mccollision.fImpactParameter, "fImpactParameter/F");
+    fTree[kMcCollision]->SetBasketSize("*", fBasketSizeEvents);
+  }
+
+  if (gSaveTree[kMcParticle]) {
+    fTree[kMcParticle]->Branch("fMcCollisionsID", &mcparticle.fMcCollisionsID, "fMcCollisionsID/I");
+    fTree[kMcParticle]->Branch("fPdgCode", &mcparticle.fPdgCode, "fPdgCode/I");
+    fTree[kMcParticle]->Branch("fStatusCode", &mcparticle.fStatusCode, "fStatusCode/I");
+    fTree[kMcParticle]->Branch("fFlags", &mcparticle.fFlags, "fFlags/b");
+    fTree[kMcParticle]->Branch("fMother0", &mcparticle.fMother0, "fMother0/I");
+    fTree[kMcParticle]->Branch("fMother1", &mcparticle.fMother1, "fMother1/I");
+    fTree[kMcParticle]->Branch("fDaughter0", &mcparticle.fDaughter0, "fDaughter0/I");
+    fTree[kMcParticle]->Branch("fDaughter1", &mcparticle.fDaughter1, "fDaughter1/I");
+    fTree[kMcParticle]->Branch("fWeight", &mcparticle.fWeight, "fWeight/F");
+
+    fTree[kMcParticle]->Branch("fPx", &mcparticle.fPx, "fPx/F");
+    fTree[kMcParticle]->Branch("fPy", &mcparticle.fPy, "fPy/F");
+    fTree[kMcParticle]->Branch("fPz", &mcparticle.fPz, "fPz/F");
+    fTree[kMcParticle]->Branch("fE", &mcparticle.fE, "fE/F");
+
+    fTree[kMcParticle]->Branch("fVx", &mcparticle.fVx, "fVx/F");
+    fTree[kMcParticle]->Branch("fVy", &mcparticle.fVy, "fVy/F");
+    fTree[kMcParticle]->Branch("fVz", &mcparticle.fVz, "fVz/F");
+    fTree[kMcParticle]->Branch("fVt", &mcparticle.fVt, "fVt/F");
+    fTree[kMcParticle]->SetBasketSize("*", fBasketSizeTracks);
+  }
+
+  if (gSaveTree[kMcCollisionLabel]) {
+    fTree[kMcCollisionLabel]->Branch("fLabel", &mccollisionlabel.fLabel, "fLabel/i");
+    fTree[kMcCollisionLabel]->Branch("fLabelMask", &mccollisionlabel.fLabelMask, "fLabelMask/s");
+    fTree[kMcCollisionLabel]->SetBasketSize("*", fBasketSizeEvents);
+  }
+
+  if (gSaveTree[kBC]) {
+    fTree[kBC]->Branch("fRunNumber", &bc.fRunNumber, "fRunNumber/I");
+    fTree[kBC]->Branch("fGlobalBC", &bc.fGlobalBC, "fGlobalBC/l");
+    fTree[kBC]->Branch("fTriggerMask", &bc.fTriggerMask, "fTriggerMask/l");
+    fTree[kBC]->SetBasketSize("*", fBasketSizeEvents);
+  }
+
+  if (gSaveTree[kFDD]) {
+    fTree[kFDD]->Branch("fBCsID", &fdd.fBCsID, "fBCsID/I");
+    fTree[kFDD]->Branch("fAmplitudeA", fdd.fAmplitudeA, "fAmplitudeA[4]/F");
+    fTree[kFDD]->Branch("fAmplitudeC", fdd.fAmplitudeC, "fAmplitudeC[4]/F");
+    fTree[kFDD]->Branch("fTimeA", &fdd.fTimeA, "fTimeA/F");
+    fTree[kFDD]->Branch("fTimeC", &fdd.fTimeC, "fTimeC/F");
+    fTree[kFDD]->Branch("fTriggerMask", &fdd.fTriggerMask, "fTriggerMask/b");
+    fTree[kFDD]->SetBasketSize("*", fBasketSizeEvents);
+  }
+
+  // Associate branches for V0A
+  if (gSaveTree[kFV0A]) {
+    fTree[kFV0A]->Branch("fBCsID", &fv0a.fBCsID, "fBCsID/I");
+    fTree[kFV0A]->Branch("fAmplitude", fv0a.fAmplitude, "fAmplitude[48]/F");
+    fTree[kFV0A]->Branch("fTime", &fv0a.fTime, "fTime/F");
+    fTree[kFV0A]->Branch("fTriggerMask", &fv0a.fTriggerMask, "fTriggerMask/b");
+    fTree[kFV0A]->SetBasketSize("*", fBasketSizeEvents);
+  }
+
+  // Associate branches for V0C
+  if (gSaveTree[kFV0C]) {
+    fTree[kFV0C]->Branch("fBCsID", &fv0c.fBCsID, "fBCsID/I");
+    fTree[kFV0C]->Branch("fAmplitude", fv0c.fAmplitude, "fAmplitude[32]/F");
+    fTree[kFV0C]->Branch("fTime", &fv0c.fTime, "fTime/F");
+    fTree[kFV0C]->SetBasketSize("*", fBasketSizeEvents);
+  }
+
+  // Associate branches for FT0
+  if (gSaveTree[kFT0]) {
+    fTree[kFT0]->Branch("fBCsID", &ft0.fBCsID, "fBCsID/I");
+    fTree[kFT0]->Branch("fAmplitudeA", ft0.fAmplitudeA, "fAmplitudeA[96]/F");
+    fTree[kFT0]->Branch("fAmplitudeC", ft0.fAmplitudeC, "fAmplitudeC[112]/F");
+    fTree[kFT0]->Branch("fTimeA", &ft0.fTimeA, "fTimeA/F");
+    fTree[kFT0]->Branch("fTimeC", &ft0.fTimeC, "fTimeC/F");
+    fTree[kFT0]->Branch("fTriggerMask", &ft0.fTriggerMask, "fTriggerMask/b");
+    fTree[kFT0]->SetBasketSize("*", fBasketSizeEvents);
+  }
+
+  if (gSaveTree[kZdc]) {
+    fTree[kZdc]->Branch("fBCsID", &zdc.fBCsID, "fBCsID/I");
+    fTree[kZdc]->Branch("fEnergyZEM1", &zdc.fEnergyZEM1, "fEnergyZEM1/F");
+    fTree[kZdc]->Branch("fEnergyZEM2", &zdc.fEnergyZEM2, "fEnergyZEM2/F");
+    fTree[kZdc]->Branch("fEnergyCommonZNA", &zdc.fEnergyCommonZNA, "fEnergyCommonZNA/F");
+    fTree[kZdc]->Branch("fEnergyCommonZNC", &zdc.fEnergyCommonZNC, "fEnergyCommonZNC/F");
+    fTree[kZdc]->Branch("fEnergyCommonZPA", &zdc.fEnergyCommonZPA, "fEnergyCommonZPA/F");
+    fTree[kZdc]->Branch("fEnergyCommonZPC", &zdc.fEnergyCommonZPC, "fEnergyCommonZPC/F");
+    fTree[kZdc]->Branch("fEnergySectorZNA", &zdc.fEnergySectorZNA, "fEnergySectorZNA[4]/F");
+    fTree[kZdc]->Branch("fEnergySectorZNC", &zdc.fEnergySectorZNC, "fEnergySectorZNC[4]/F");
+    fTree[kZdc]->Branch("fEnergySectorZPA", &zdc.fEnergySectorZPA, "fEnergySectorZPA[4]/F");
+    fTree[kZdc]->Branch("fEnergySectorZPC", &zdc.fEnergySectorZPC, "fEnergySectorZPC[4]/F");
+    fTree[kZdc]->Branch("fTimeZEM1", &zdc.fTimeZEM1, "fTimeZEM1/F");
+    fTree[kZdc]->Branch("fTimeZEM2", &zdc.fTimeZEM2, "fTimeZEM2/F");
+    fTree[kZdc]->Branch("fTimeZNA", &zdc.fTimeZNA, "fTimeZNA/F");
+    fTree[kZdc]->Branch("fTimeZNC", &zdc.fTimeZNC, "fTimeZNC/F");
+    fTree[kZdc]->Branch("fTimeZPA", &zdc.fTimeZPA, "fTimeZPA/F");
+    fTree[kZdc]->Branch("fTimeZPC", &zdc.fTimeZPC, "fTimeZPC/F");
+    fTree[kZdc]->SetBasketSize("*", fBasketSizeEvents);
+  }
+}
+
+} // namespace upgrades_utils
+} // namespace o2
+
+#endif
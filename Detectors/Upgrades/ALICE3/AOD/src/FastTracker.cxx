@@ -0,0 +1,355 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FastTracker.cxx
+
+#include "UpgradesAODUtils/FastTracker.h"
+#include "CommonConstants/MathConstants.h"
+#include "FairLogger.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace o2
+{
+namespace upgrades_utils
+{
+
+using o2::track::PID;
+
+//_________________________________________________________________________________________________
+void FastTracker::addBarrelLayer(float r, float length, float x2X0, float resolution, float efficiency)
+{
+  FastLayer& layer = mLayers.emplace_back();
+  layer.r = r;
+  layer.z = 0.5f * length;
+  layer.x2X0 = x2X0;
+  layer.resolution = resolution;
+  layer.efficiency = efficiency;
+}
+
+//_________________________________________________________________________________________________
+void FastTracker::addDisk(float z, float rMin, float rMax, float x2X0, float resolution, float efficiency)
+{
+  FastLayer& layer = mLayers.emplace_back();
+  layer.disk = true;
+  layer.z = z;
+  layer.rMin = rMin;
+  layer.rMax = rMax;
+  layer.x2X0 = x2X0;
+  layer.resolution = resolution;
+  layer.efficiency = efficiency;
+}
+
+//_________________________________________________________________________________________________
+void FastTracker::addALICE3Layers(float resolution)
+{
+  // TRK barrel layers as built by o2::trk::Detector::configITS, {r, length, sensor thickness} (cm)
+  constexpr float X0Silicon = 9.37f;
+  const std::vector<std::array<float, 3>> barrel{
+    {0.5f, 30.f, 100.e-4f},
+    {1.2f, 30.f, 100.e-4f},
+    {2.5f, 30.f, 100.e-4f},
+    {3.75f, 124.f, 100.e-4f},
+    {7.f, 124.f, 100.e-3f},
+    {12.f, 124.f, 100.e-3f},
+    {20.f, 124.f, 100.e-3f},
+    {30.f, 124.f, 100.e-3f},
+    {45.f, 264.f, 100.e-3f},
+    {60.f, 264.f, 100.e-3f},
+    {80.f, 264.f, 100.e-3f},
+    {100.f, 264.f, 100.e-3f}};
+  for (const auto& layer : barrel) {
+    addBarrelLayer(layer[0], layer[1], layer[2] / X0Silicon, resolution);
+  }
+
+  // FT3 disks as built by o2::ft3::Detector::buildFT3V1, on both sides, {z, r_in, r_out, x2X0}
+  const float layersx2X0 = 1.e-2;
+  const std::vector<std::array<float, 4>> disks{
+    {16.f, .5f, 3.f, 0.1f * layersx2X0},
+    {20.f, .5f, 3.f, 0.1f * layersx2X0},
+    {24.f, .5f, 3.f, 0.1f * layersx2X0},
+    {77.f, 3.5f, 35.f, layersx2X0},
+    {100.f, 3.5f, 35.f, layersx2X0},
+    {122.f, 3.5f, 35.f, layersx2X0},
+    {150.f, 3.5f, 100.f, layersx2X0},
+    {180.f, 3.5f, 100.f, layersx2X0},
+    {220.f, 3.5f, 100.f, layersx2X0},
+    {279.f, 3.5f, 100.f, layersx2X0}};
+  for (auto side : {-1.f, 1.f}) {
+    for (const auto& disk : disks) {
+      addDisk(side * disk[0], disk[1], disk[2], disk[3], resolution);
+    }
+  }
+}
+
+//_________________________________________________________________________________________________
+bool FastTracker::readLayers(const std::string& fileName)
+{
+  // One line per layer, lines starting with # are comments
+  // barrel r length x2X0 resolution [efficiency]
+  // disk z r_in r_out x2X0 resolution [efficiency]
+
+  std::ifstream ifs(fileName.c_str());
+  if (!ifs.good()) {
+    LOG(ERROR) << "Could not open the layer description " << fileName;
+    return false;
+  }
+  mLayers.clear();
+  std::string line;
+  while (std::getline(ifs, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream iss(line);
+    std::string type;
+    float efficiency = 1.f;
+    iss >> type;
+    if (type == "barrel") {
+      float r, length, x2X0, resolution;
+      if (!(iss >> r >> length >> x2X0 >> resolution)) {
+        LOG(ERROR) << "Invalid barrel layer: " << line;
+        return false;
+      }
+      iss >> efficiency;
+      addBarrelLayer(r, length, x2X0, resolution, efficiency);
+    } else if (type == "disk") {
+      float z, rMin, rMax, x2X0, resolution;
+      if (!(iss >> z >> rMin >> rMax >> x2X0 >> resolution)) {
+        LOG(ERROR) << "Invalid disk: " << line;
+        return false;
+      }
+      iss >> efficiency;
+      addDisk(z, rMin, rMax, x2X0, resolution, efficiency);
+    } else {
+      LOG(ERROR) << "Unknown layer type " << type << " in " << fileName;
+      return false;
+    }
+  }
+  LOG(INFO) << "Loaded " << mLayers.size() << " fast tracker layers from " << fileName;
+  return true;
+}
+
+//_________________________________________________________________________________________________
+FastLUTEntry FastTracker::computeResponse(PID::ID species, float pt, float eta) const
+{
+  // First guess of the tracking response, to be replaced by tables from the full
+  // simulation where available:
+  // - the particle is followed on its helix from the nominal vertex and every layer it
+  //   crosses before curling back contributes a hit with the efficiency of the layer
+  // - the pt resolution is the Gluckstern formula over the transverse lever arm of the
+  //   crossed layers, with the multiple scattering in their material added in quadrature
+  // - the resolutions at the vertex are the extrapolation from the two innermost hits,
+  //   with the multiple scattering in the innermost one
+
+  struct Crossing {
+    float r;          // transverse radius of the hit
+    float x2X0;       // material budget along the particle direction
+    float resolution; // point resolution
+    float efficiency; // hit efficiency
+  };
+
+  FastLUTEntry entry;
+  const float mass = PID::getMass(species);
+  const float p = pt * std::cosh(eta);
+  const float beta = p / std::sqrt(p * p + mass * mass);
+  const float tgl = std::sinh(eta);
+  const float sinTheta = 1.f / std::cosh(eta);
+  const float cosTheta = std::abs(std::tanh(eta));
+  const float bendingRadius = std::abs(pt / (o2::constants::math::B2C * mBz));
+
+  std::vector<Crossing> crossings;
+  for (const auto& layer : mLayers) {
+    if (!layer.disk) {
+      if (layer.r > 2.f * bendingRadius) {
+        continue;
+      }
+      const float pathT = 2.f * bendingRadius * std::asin(layer.r / (2.f * bendingRadius));
+      if (std::abs(pathT * tgl) > layer.z) {
+        continue;
+      }
+      crossings.push_back({layer.r, layer.x2X0 / sinTheta, layer.resolution, layer.efficiency});
+    } else {
+      if (layer.z * tgl <= 0.f) {
+        continue;
+      }
+      const float pathT = layer.z / tgl;
+      if (pathT > o2::constants::math::PI * bendingRadius) {
+        continue;
+      }
+      const float r = 2.f * bendingRadius * std::sin(pathT / (2.f * bendingRadius));
+      if (r < layer.rMin || r > layer.rMax) {
+        continue;
+      }
+      crossings.push_back({r, layer.x2X0 / cosTheta, layer.resolution, layer.efficiency});
+    }
+  }
+  std::sort(crossings.begin(), crossings.end(), [](const Crossing& a, const Crossing& b) { return a.r < b.r; });
+  const int nCrossings = crossings.size();
+  if (nCrossings < std::max(mMinHits, 3) || crossings.back().r - crossings.front().r <= 0.f) {
+    return entry;
+  }
+
+  // probability to have at least mMinHits of the independent hits
+  std::vector<double> nHitsProbability(nCrossings + 1, 0.);
+  nHitsProbability[0] = 1.;
+  for (int i = 0; i < nCrossings; i++) {
+    const double efficiency = crossings[i].efficiency;
+    for (int n = i + 1; n > 0; n--) {
+      nHitsProbability[n] = nHitsProbability[n] * (1. - efficiency) + nHitsProbability[n - 1] * efficiency;
+    }
+    nHitsProbability[0] *= 1. - efficiency;
+  }
+  double efficiency = 0.;
+  for (int n = mMinHits; n <= nCrossings; n++) {
+    efficiency += nHitsProbability[n];
+  }
+  entry.efficiency = efficiency;
+
+  float sumResolution2 = 0.f, sumX2X0 = 0.f;
+  for (const auto& crossing : crossings) {
+    sumResolution2 += crossing.resolution * crossing.resolution;
+    sumX2X0 += crossing.x2X0;
+  }
+  const float leverArm = crossings.back().r - crossings.front().r;
+  const float ptLeverArm = std::abs(o2::constants::math::B2C * mBz) * leverArm; // pt of a bending radius equal to the lever arm
+  const float sigmaPtMeasurement = std::sqrt(sumResolution2 / nCrossings) * pt / (ptLeverArm * leverArm) * std::sqrt(720.f / (nCrossings + 4));
+  const float sigmaPtScattering = 0.0136f * std::sqrt(1.43f * sumX2X0) / (beta * ptLeverArm);
+  entry.sigmaPtRel = std::hypot(sigmaPtMeasurement, sigmaPtScattering);
+
+  const auto& first = crossings[0];
+  const auto& second = crossings[1];
+  const float distance = second.r - first.r;
+  const float theta0 = first.x2X0 > 0.f ? 0.0136f / (beta * p) * std::sqrt(first.x2X0) * (1.f + 0.038f * std::log(first.x2X0)) : 0.f;
+  const float sigma1 = first.resolution, sigma2 = second.resolution;
+  const float extrapolation2 = (second.r * second.r * sigma1 * sigma1 + first.r * first.r * sigma2 * sigma2) / (distance * distance);
+  const float direction2 = (sigma1 * sigma1 + sigma2 * sigma2) / (distance * distance);
+  entry.sigmaY = std::sqrt(extrapolation2 + std::pow(first.r * theta0 / sinTheta, 2));
+  entry.sigmaZ = std::sqrt(extrapolation2 + std::pow(first.r * theta0 / (sinTheta * sinTheta), 2));
+  entry.sigmaSnp = std::sqrt(direction2 + std::pow(theta0 / sinTheta, 2));
+  entry.sigmaTgl = std::sqrt(direction2 + std::pow(theta0 / (sinTheta * sinTheta), 2));
+  return entry;
+}
+
+//_________________________________________________________________________________________________
+void FastTracker::buildLUT(int nPt, float ptMin, float ptMax, int nEta, float etaMax)
+{
+  mNPt = nPt;
+  mLogPtMin = std::log(ptMin);
+  mLogPtStep = (std::log(ptMax) - mLogPtMin) / nPt;
+  mNEta = nEta;
+  mEtaMax = etaMax;
+  mEtaStep = 2.f * etaMax / nEta;
+  mLUT.resize(NSpecies * nPt * nEta);
+  for (int species = 0; species < NSpecies; species++) {
+    for (int iPt = 0; iPt < nPt; iPt++) {
+      const float pt = std::exp(mLogPtMin + (iPt + 0.5f) * mLogPtStep);
+      for (int iEta = 0; iEta < nEta; iEta++) {
+        const float eta = -etaMax + (iEta + 0.5f) * mEtaStep;
+        mLUT[(species * nPt + iPt) * nEta + iEta] = computeResponse(species, pt, eta);
+      }
+    }
+  }
+  LOG(INFO) << "Fast tracker response tabulated for " << mLayers.size() << " layers, Bz = " << mBz << " kG, in "
+            << nPt << " pt bins in [" << ptMin << ", " << ptMax << "] GeV/c and " << nEta << " eta bins in |eta| < " << etaMax;
+}
+
+//_________________________________________________________________________________________________
+int FastTracker::getPtBin(float pt) const
+{
+  const int bin = std::floor((std::log(pt) - mLogPtMin) / mLogPtStep);
+  return std::clamp(bin, 0, mNPt - 1);
+}
+
+//_________________________________________________________________________________________________
+int FastTracker::getEtaBin(float eta) const
+{
+  const int bin = std::floor((eta + mEtaMax) / mEtaStep);
+  return std::clamp(bin, 0, mNEta - 1);
+}
+
+//_________________________________________________________________________________________________
+const FastLUTEntry& FastTracker::getResponse(PID::ID species, float pt, float eta) const
+{
+  return mLUT[(species * mNPt + getPtBin(pt)) * mNEta + getEtaBin(eta)];
+}
+
+//_________________________________________________________________________________________________
+bool FastTracker::getSpecies(int pdg, PID::ID& species, int& charge)
+{
+  switch (std::abs(pdg)) {
+    case 11:
+      species = PID::Electron;
+      charge = pdg > 0 ? -1 : 1;
+      return true;
+    case 13:
+      species = PID::Muon;
+      charge = pdg > 0 ? -1 : 1;
+      return true;
+    case 211:
+      species = PID::Pion;
+      charge = pdg > 0 ? 1 : -1;
+      return true;
+    case 321:
+      species = PID::Kaon;
+      charge = pdg > 0 ? 1 : -1;
+      return true;
+    case 2212:
+      species = PID::Proton;
+      charge = pdg > 0 ? 1 : -1;
+      return true;
+    default:
+      return false;
+  }
+}
+
+//_________________________________________________________________________________________________
+bool FastTracker::smear(int pdg, const std::array<float, 3>& xyz, const std::array<float, 3>& pxpypz,
+                        const o2::math_utils::Point3D<float>& vertex, std::mt19937_64& generator,
+                        o2::track::TrackParCov& track) const
+{
+  PID::ID species;
+  int charge;
+  if (!getSpecies(pdg, species, charge)) {
+    return false;
+  }
+  const float pt = std::hypot(pxpypz[0], pxpypz[1]);
+  if (pt <= 0.f) {
+    return false;
+  }
+  const auto& response = getResponse(species, pt, std::asinh(pxpypz[2] / pt));
+  if (response.efficiency <= 0.f || std::uniform_real_distribution<float>(0.f, 1.f)(generator) > response.efficiency) {
+    return false;
+  }
+
+  o2::track::TrackPar param(xyz, pxpypz, charge, false, species);
+  if (!param.propagateParamToDCA(vertex, mBz)) {
+    return false;
+  }
+  const float sigmas[o2::track::kNParams] = {response.sigmaY, response.sigmaZ, response.sigmaSnp, response.sigmaTgl,
+                                             response.sigmaPtRel * std::abs(param.getQ2Pt())};
+  std::normal_distribution<float> gaus(0.f, 1.f);
+  o2::track::TrackParCov::params_t params;
+  o2::track::TrackParCov::covMat_t cov{};
+  for (int i = 0; i < o2::track::kNParams; i++) {
+    params[i] = param.getParam(i) + sigmas[i] * gaus(generator);
+    cov[o2::track::DiagMap[i]] = sigmas[i] * sigmas[i];
+  }
+  if (std::abs(params[o2::track::kSnp]) >= o2::constants::math::Almost1) {
+    return false;
+  }
+  track = o2::track::TrackParCov(param.getX(), param.getAlpha(), params, cov, charge, species);
+  return true;
+}
+
+} // namespace upgrades_utils
+} // namespace o2
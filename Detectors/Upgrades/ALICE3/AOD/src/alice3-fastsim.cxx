@@ -0,0 +1,337 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file alice3-fastsim.cxx
+
+//******************************************************************
+// ALICE 3 fast simulation to AO2D
+//
+// This tool reads the generated particles of o2sim_Kine.root, smears
+// them with the parameterised response of the ALICE 3 tracker (see
+// FastTracker.h) and saves the tracks, the collisions and the MC
+// information in an AO2D.root file that mimics Run 2-converted data,
+// like ALICE3toAO2D.C does for the full simulation.
+//
+// The events are read in batches and the events of a batch are
+// smeared in parallel, each with a random generator seeded from the
+// seed and the event number, so that the output does not depend on
+// the number of threads.
+//
+//******************************************************************
+
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <TFile.h>
+#include <TTree.h>
+#include <TTimeStamp.h>
+#include "FairLogger.h"
+#include "Framework/DataTypes.h"
+#include "SimulationDataFormat/MCEventHeader.h"
+#include "SimulationDataFormat/MCTrack.h"
+#include "UpgradesAODUtils/FastTracker.h"
+#include "UpgradesAODUtils/Run2LikeAO2D.h"
+#include "UpgradesAODUtils/Run2LikeAO2DTrees.h"
+
+namespace bpo = boost::program_options;
+using namespace o2::upgrades_utils;
+
+namespace
+{
+
+/// generated event, as read from the kinematics
+struct GeneratedEvent {
+  std::vector<o2::MCTrack> particles;
+  float x = 0.f, y = 0.f, z = 0.f, t = 0.f, b = 0.f;
+};
+
+/// reconstructed event, with the indices of the particles of its tracks
+struct SmearedEvent {
+  o2::math_utils::Point3D<float> vertex;
+  std::vector<o2::track::TrackParCov> tracks;
+  std::vector<int> labels;
+};
+
+void smearEvent(const FastTracker& tracker, const GeneratedEvent& generated, float vertexResolution,
+                std::mt19937_64& generator, SmearedEvent& smeared)
+{
+  smeared.tracks.clear();
+  smeared.labels.clear();
+  const o2::math_utils::Point3D<float> vertex{generated.x, generated.y, generated.z};
+  std::normal_distribution<float> gaus(0.f, vertexResolution);
+  smeared.vertex.SetCoordinates(generated.x + gaus(generator), generated.y + gaus(generator), generated.z + gaus(generator));
+  o2::track::TrackParCov track;
+  for (int i = 0; i < (int)generated.particles.size(); i++) {
+    const auto& particle = generated.particles[i];
+    // only the particles left by the generator to the transport reach the detector
+    if (!particle.isPrimary() || !particle.getToBeDone()) {
+      continue;
+    }
+    const std::array<float, 3> xyz{(float)particle.Vx(), (float)particle.Vy(), (float)particle.Vz()};
+    const std::array<float, 3> pxpypz{(float)particle.Px(), (float)particle.Py(), (float)particle.Pz()};
+    if (tracker.smear(particle.GetPdgCode(), xyz, pxpypz, vertex, generator, track)) {
+      smeared.tracks.push_back(track);
+      smeared.labels.push_back(i);
+    }
+  }
+}
+
+void fillEvent(TTree* fTree[kTrees], const GeneratedEvent& generated, const SmearedEvent& smeared, Long_t eventNumber, Long_t offsetLabel)
+{
+  //---> Collision data
+  collision.fBCsID = eventNumber;
+  fdd.fBCsID = collision.fBCsID;
+  ft0.fBCsID = collision.fBCsID;
+  fv0a.fBCsID = collision.fBCsID;
+  fv0c.fBCsID = collision.fBCsID;
+  zdc.fBCsID = collision.fBCsID;
+  collision.fPosX = smeared.vertex.X();
+  collision.fPosY = smeared.vertex.Y();
+  collision.fPosZ = smeared.vertex.Z();
+  collision.fChi2 = 1.f;
+  collision.fN = smeared.tracks.size();
+  collision.fCollisionTime = 10;
+  collision.fCollisionTimeRes = 1e-6;
+  ft0.fTimeA = 10;
+  ft0.fTimeC = 10;
+
+  //---> MC collision data
+  mccollision.fBCsID = eventNumber;
+  mccollision.fPosX = generated.x;
+  mccollision.fPosY = generated.y;
+  mccollision.fPosZ = generated.z;
+  mccollision.fT = generated.t;
+  mccollision.fWeight = 1;
+  mccollision.fImpactParameter = generated.b;
+  mccollisionlabel.fLabel = eventNumber;
+  mccollisionlabel.fLabelMask = 0;
+
+  //---> Dummy trigger mask to ensure nobody rejects this
+  bc.fTriggerMask = 0;
+  for (Int_t iii = 0; iii < 60; iii++) {
+    bc.fTriggerMask |= 1ull << iii;
+  }
+  bc.fRunNumber = 246087;
+
+  //---> Track data
+  for (size_t i = 0; i < smeared.tracks.size(); i++) {
+    const auto& track = smeared.tracks[i];
+    tracks.fCollisionsID = eventNumber;
+    tracks.fTrackType = o2::aod::track::TrackTypeEnum::Run2Track;
+    tracks.fFlags = o2::aod::track::TrackFlagsRun2Enum::ITSrefit | o2::aod::track::TrackFlagsRun2Enum::TPCrefit | o2::aod::track::TrackFlagsRun2Enum::GoldenChi2;
+    tracks.fX = track.getX();
+    tracks.fY = track.getY();
+    tracks.fZ = track.getZ();
+    tracks.fAlpha = track.getAlpha();
+    tracks.fSnp = track.getSnp();
+    tracks.fTgl = track.getTgl();
+    tracks.fSigned1Pt = track.getQ2Pt();
+    // diagonal elements of the covariance matrix, the smearing is uncorrelated
+    tracks.fSigmaY = std::sqrt(track.getSigmaY2());
+    tracks.fSigmaZ = std::sqrt(track.getSigmaZ2());
+    tracks.fSigmaSnp = std::sqrt(track.getSigmaSnp2());
+    tracks.fSigmaTgl = std::sqrt(track.getSigmaTgl2());
+    tracks.fSigma1Pt = std::sqrt(track.getSigma1Pt2());
+    tracks.fTPCinnerP = track.getP();
+    tracks.fITSChi2NCl = 1.0;
+    tracks.fTPCChi2NCl = 1.0;
+    tracks.fTPCNClsFindable = (UChar_t)(120);
+    tracks.fITSClusterMap = 0x3;
+    fTree[kTracks]->Fill();
+
+    mctracklabel.fLabel = smeared.labels[i] + offsetLabel;
+    mctracklabel.fLabelMask = 0;
+    fTree[kMcTrackLabel]->Fill();
+  }
+
+  //---> MC stack information for de-referencing
+  for (const auto& part : generated.particles) {
+    mcparticle.fMcCollisionsID = eventNumber;
+    mcparticle.fPdgCode = part.GetPdgCode();
+    mcparticle.fStatusCode = part.isPrimary();
+    mcparticle.fFlags = 0;
+    if (part.isSecondary()) {
+      mcparticle.fFlags |= MCParticleFlags::ProducedInTransport;
+    }
+    mcparticle.fMother0 = part.getMotherTrackId();
+    if (mcparticle.fMother0 > -1) {
+      mcparticle.fMother0 += offsetLabel;
+    }
+    mcparticle.fMother1 = -1;
+    mcparticle.fDaughter0 = part.getFirstDaughterTrackId();
+    if (mcparticle.fDaughter0 > -1) {
+      mcparticle.fDaughter0 += offsetLabel;
+    }
+    mcparticle.fDaughter1 = part.getLastDaughterTrackId();
+    if (mcparticle.fDaughter1 > -1) {
+      mcparticle.fDaughter1 += offsetLabel;
+    }
+    mcparticle.fWeight = 1;
+    mcparticle.fPx = part.Px();
+    mcparticle.fPy = part.Py();
+    mcparticle.fPz = part.Pz();
+    mcparticle.fE = part.GetEnergy();
+    mcparticle.fVx = part.Vx();
+    mcparticle.fVy = part.Vy();
+    mcparticle.fVz = part.Vz();
+    mcparticle.fVt = part.T();
+    fTree[kMcParticle]->Fill();
+  }
+
+  fTree[kEvents]->Fill();
+  fTree[kMcCollision]->Fill();
+  fTree[kMcCollisionLabel]->Fill();
+  fTree[kBC]->Fill();
+  fTree[kFDD]->Fill();
+  fTree[kFV0A]->Fill();
+  fTree[kFV0C]->Fill();
+  fTree[kFT0]->Fill();
+  fTree[kZdc]->Fill();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  bpo::variables_map vm;
+  bpo::options_description options("Usage:\n  " + std::string(argv[0]) +
+                                   " <options>\n"
+                                   "  Smears the generated particles with the ALICE 3 fast tracker and writes them as AO2D\n"
+                                   "Options");
+  auto add_option = options.add_options();
+  add_option("help,h", "Print this help message");
+  add_option("input,i", bpo::value<std::string>()->default_value("o2sim_Kine.root"), "kinematics file");
+  add_option("output,o", bpo::value<std::string>()->default_value("AO2D.root"), "AO2D output file");
+  add_option("layers", bpo::value<std::string>()->default_value(""), "layer description file, default: TRK and FT3 default geometries");
+  add_option("bz", bpo::value<float>()->default_value(5.f), "magnetic field (kG)");
+  add_option("resolution", bpo::value<float>()->default_value(5.e-4f), "point resolution of the default layers (cm)");
+  add_option("vertex-resolution", bpo::value<float>()->default_value(10.e-4f), "resolution of the collision vertex (cm)");
+  add_option("min-hits", bpo::value<int>()->default_value(4), "minimum number of hits of a track");
+  add_option("nevents,n", bpo::value<long>()->default_value(-1), "number of events, -1 for all");
+  add_option("batch", bpo::value<int>()->default_value(1000), "number of events read and smeared together");
+  add_option("threads,j", bpo::value<int>()->default_value(1), "number of smearing threads");
+  add_option("seed", bpo::value<unsigned long>()->default_value(1), "random seed");
+
+  try {
+    bpo::store(bpo::parse_command_line(argc, argv, options), vm);
+    bpo::notify(vm);
+  } catch (bpo::error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl
+              << std::endl;
+    std::cerr << options << std::endl;
+    return 1;
+  }
+  if (vm.count("help")) {
+    std::cout << options << std::endl;
+    return 0;
+  }
+
+  FastTracker tracker;
+  tracker.setBz(vm["bz"].as<float>());
+  tracker.setMinHits(vm["min-hits"].as<int>());
+  const auto layers = vm["layers"].as<std::string>();
+  if (layers.empty()) {
+    tracker.addALICE3Layers(vm["resolution"].as<float>());
+  } else if (!tracker.readLayers(layers)) {
+    return 1;
+  }
+  tracker.buildLUT();
+
+  std::unique_ptr<TFile> input(TFile::Open(vm["input"].as<std::string>().c_str()));
+  TTree* mcTree = input && !input->IsZombie() ? input->Get<TTree>("o2sim") : nullptr;
+  if (!mcTree) {
+    LOG(ERROR) << "No o2sim tree in " << vm["input"].as<std::string>();
+    return 1;
+  }
+  mcTree->SetBranchStatus("*", 0);
+  mcTree->SetBranchStatus("MCTrack*", 1);
+  mcTree->SetBranchStatus("MCEventHeader.", 1);
+  std::vector<o2::MCTrack>* mcArr = nullptr;
+  mcTree->SetBranchAddress("MCTrack", &mcArr);
+  auto mcHead = new o2::dataformats::MCEventHeader;
+  mcTree->SetBranchAddress("MCEventHeader.", &mcHead);
+
+  long nEvents = mcTree->GetEntries();
+  if (vm["nevents"].as<long>() >= 0 && vm["nevents"].as<long>() < nEvents) {
+    nEvents = vm["nevents"].as<long>();
+  }
+  const int batchSize = std::max(vm["batch"].as<int>(), 1);
+  const int nThreads = std::max(vm["threads"].as<int>(), 1);
+  const float vertexResolution = vm["vertex-resolution"].as<float>();
+  const auto seed = vm["seed"].as<unsigned long>();
+#ifndef WITH_OPENMP
+  if (nThreads > 1) {
+    LOG(WARNING) << "Fast simulation compiled without OpenMP, the events are smeared with 1 thread";
+  }
+#endif
+
+  // Setup output
+  UInt_t fCompress = 101;
+  std::unique_ptr<TFile> output(TFile::Open(vm["output"].as<std::string>().c_str(), "RECREATE", "O2 AOD", fCompress));
+  TTimeStamp ts0(2020, 11, 1, 0, 0, 0);
+  TTimeStamp ts1;
+  UInt_t tfId = ts1.GetSec() - ts0.GetSec();
+  TDirectory* fOutputDir = output->mkdir(Form("DF_%d", tfId));
+  fOutputDir->cd();
+  TTree* fTree[kTrees];
+  createTrees(fTree);
+  collision.fCovXX = vertexResolution * vertexResolution;
+  collision.fCovYY = vertexResolution * vertexResolution;
+  collision.fCovZZ = vertexResolution * vertexResolution;
+
+  LOG(INFO) << "Smearing " << nEvents << " events in batches of " << batchSize << " with " << nThreads << " threads";
+  auto start = std::chrono::steady_clock::now();
+  std::vector<GeneratedEvent> generated(batchSize);
+  std::vector<SmearedEvent> smeared(batchSize);
+  Long_t offsetLabel = 0;
+  long nTracks = 0;
+  for (long first = 0; first < nEvents; first += batchSize) {
+    const int nBatch = std::min<long>(batchSize, nEvents - first);
+    for (int i = 0; i < nBatch; i++) {
+      mcTree->GetEntry(first + i);
+      auto& event = generated[i];
+      event.particles.swap(*mcArr);
+      event.x = mcHead->GetX();
+      event.y = mcHead->GetY();
+      event.z = mcHead->GetZ();
+      event.t = mcHead->GetT();
+      event.b = mcHead->GetB();
+    }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+    for (int i = 0; i < nBatch; i++) {
+      std::seed_seq sequence{seed, (unsigned long)(first + i)};
+      std::mt19937_64 generator(sequence);
+      smearEvent(tracker, generated[i], vertexResolution, generator, smeared[i]);
+    }
+    for (int i = 0; i < nBatch; i++) {
+      fillEvent(fTree, generated[i], smeared[i], first + i, offsetLabel);
+      offsetLabel += generated[i].particles.size();
+      nTracks += smeared[i].tracks.size();
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  fOutputDir->cd();
+  for (Int_t ii = 0; ii < kTrees; ii++) {
+    if (fTree[ii]) {
+      fTree[ii]->Write();
+    }
+  }
+  output->Close();
+  LOG(INFO) << "Saved " << nEvents << " events with " << nTracks << " tracks in " << elapsed.count() << " s";
+  return 0;
+}
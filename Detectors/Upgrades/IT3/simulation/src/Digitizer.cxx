@@ -43,8 +43,10 @@ void Digitizer::init()
 
   const Int_t numOfChips = mGeometry->getNumberOfChips() + SegmentationSuperAlpide::NLayers;
   mChips.resize(numOfChips);
+  ULong64_t seed = gRandom->Integer(0xffffffff);
   for (int i = numOfChips; i--;) {
     mChips[i].setChipIndex(i);
+    mChips[i].setSeed(seed);
   }
   if (!mParams.getAlpSimResponse()) {
     mAlpSimResp = std::make_unique<o2::itsmft::AlpideSimResponse>();
@@ -126,9 +128,6 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
   if (frameLast > mROFrameMax) {
     frameLast = mROFrameMax;
   }
-  // make sure all buffers for extra digits are created up to the maxFrame
-  getExtraDigBuffer(mROFrameMax);
-
   LOG(INFO) << "Filling " << mGeometry->getName() << " digits output for RO frames " << mROFrameMin << ":"
             << frameLast;
 
@@ -139,7 +138,6 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
     rcROF.setROFrame(mROFrameMin);
     rcROF.setFirstEntry(mDigits->size()); // start of current ROF in digits
 
-    auto& extra = *(mExtraBuff.front().get());
     for (int iChip{0}; iChip < mChips.size(); ++iChip) {
       auto& chip = mChips[iChip];
       if (iChip < SegmentationSuperAlpide::NLayers) {
@@ -147,30 +145,24 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
       } else {
         chip.addNoise(mROFrameMin, mROFrameMin, &mParams);
       }
-      auto& buffer = chip.getPreDigits();
-      if (buffer.empty()) {
+      auto rof = chip.findROF(mROFrameMin);
+      if (!rof) {
         continue;
       }
-      auto itBeg = buffer.begin();
-      auto iter = itBeg;
-      ULong64_t maxKey = chip.getOrderingKey(mROFrameMin + 1, 0, 0) - 1; // fetch digits with key below that
-      for (; iter != buffer.end(); ++iter) {
-        if (iter->first > maxKey) {
-          break; // is the digit ROFrame from the key > the max requested frame
-        }
-        auto& preDig = iter->second; // preDigit
+      chip.sortDigits(*rof, mParams.getChargeThreshold());
+      for (auto& preDig : rof->digits) {
         if (preDig.charge >= mParams.getChargeThreshold()) {
           int digID = mDigits->size();
           mDigits->emplace_back(chip.getChipIndex(), preDig.row, preDig.col, preDig.charge);
           mMCLabels->addElement(digID, preDig.labelRef.label);
           auto& nextRef = preDig.labelRef; // extra contributors are in extra array
           while (nextRef.next >= 0) {
-            nextRef = extra[nextRef.next];
+            nextRef = rof->extra[nextRef.next];
             mMCLabels->addElement(digID, nextRef.label);
           }
         }
       }
-      buffer.erase(itBeg, iter);
+      chip.releaseROF(*rof);
     }
     // finalize ROF record
     rcROF.setNEntries(mDigits->size() - rcROF.getFirstEntry()); // number of digits
@@ -182,10 +174,6 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
     if (mROFRecords) {
       mROFRecords->push_back(rcROF);
     }
-    extra.clear(); // clear container for extra digits of the mROFrameMin ROFrame
-    // and move it as a new slot in the end
-    mExtraBuff.emplace_back(mExtraBuff.front().release());
-    mExtraBuff.pop_front();
   }
 }
 
@@ -417,16 +405,14 @@ void Digitizer::registerDigits(o2::itsmft::ChipDigitsContainer& chip, uint32_t r
     if (roFr < mEventROFrameMin) {
       mEventROFrameMin = roFr;
     }
-    auto key = chip.getOrderingKey(roFr, row, col);
-    PreDigit* pd = chip.findDigit(key);
-    if (!pd) {
-      chip.addDigit(key, roFr, row, col, nEleROF, lbl);
-    } else { // there is already a digit at this slot, account as PreDigitExtra contribution
+    auto& rofDigits = chip.getROF(roFr);
+    PreDigit* pd = chip.addDigit(rofDigits, row, col, nEleROF, lbl);
+    if (pd) { // there is already a digit at this slot, account as PreDigitExtra contribution
       pd->charge += nEleROF;
       if (pd->labelRef.label == lbl) { // don't store the same label twice
         continue;
       }
-      ExtraDig* extra = getExtraDigBuffer(roFr);
+      auto* extra = &rofDigits.extra;
       int& nxt = pd->labelRef.next;
       bool skip = false;
       while (nxt >= 0) {
@@ -18,6 +18,8 @@
 
 #include "MathUtils/Primitive2D.h"
 #include "ReconstructionDataFormats/Track.h"
+#include <cstdint>
+#include <vector>
 
 namespace o2
 {
@@ -266,6 +268,50 @@ struct CrossInfo {
   ClassDefNV(CrossInfo, 1);
 };
 
+///__________________________________________________________________________
+//< circle parameters of many tracks in SoA layout, for the batched pre-selection of the track pairs:
+//< the screening loop is branch-free, so that the compiler can vectorize it
+struct TrackAuxParSoA {
+  static constexpr float RelTolerance = 1e-4; // conservative margin on the circles distance, to not depend on the rounding
+  std::vector<float> xC, yC, rC;
+
+  size_t size() const { return rC.size(); }
+  void clear()
+  {
+    xC.clear();
+    yC.clear();
+    rC.clear();
+  }
+  void reserve(size_t n)
+  {
+    xC.reserve(n);
+    yC.reserve(n);
+    rC.reserve(n);
+  }
+  void add(const TrackAuxPar& trax)
+  {
+    xC.push_back(trax.xC);
+    yC.push_back(trax.yC);
+    rC.push_back(trax.rC);
+  }
+
+  ///< set accept[i - first] for the entries [first : last) to 0 if the pair of this entry with trax is certainly
+  ///< rejected by CrossInfo::set as having the circles more than maxDistXY apart, to 1 otherwise
+  void screen(const TrackAuxPar& trax, int first, int last, float maxDistXY, uint8_t* accept) const
+  {
+    const float x0 = trax.xC, y0 = trax.yC, r0 = trax.rC, maxDist = maxDistXY * (1.f + RelTolerance) + RelTolerance;
+    const bool line0 = !(r0 > o2::constants::math::Almost0);
+    const float* __restrict xc = xC.data();
+    const float* __restrict yc = yC.data();
+    const float* __restrict rc = rC.data();
+    for (int i = first; i < last; i++) {
+      float dx = xc[i] - x0, dy = yc[i] - y0, dist = std::sqrt(dx * dx + dy * dy);
+      bool tooFar = dist - (r0 + rc[i]) > maxDist;
+      accept[i - first] = line0 | !(rc[i] > o2::constants::math::Almost0) | !tooFar; // straight lines are not screened
+    }
+  }
+};
+
 } // namespace track
 } // namespace o2
 
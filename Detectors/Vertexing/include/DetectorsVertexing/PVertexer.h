@@ -97,9 +97,19 @@ class PVertexer
     mITSROFrameLengthMUS = v;
   }
 
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
  private:
   static constexpr int DBS_UNDEF = -2, DBS_NOISE = -1, DBS_INCHECK = -10;
 
+  ///< vertices found in a single time cluster, merged to the global output in the clusters order
+  struct VerticesBuffer {
+    std::vector<PVertex> vertices;
+    std::vector<uint32_t> trackIDs;
+    std::vector<V2TRef> v2tRefs;
+  };
+
   SeedHistoTZ buildHistoTZ(const VertexingInput& input);
   int runVertexing(gsl::span<o2d::GlobalTrackID> gids, const gsl::span<o2::InteractionRecord> bcData,
                    std::vector<PVertex>& vertices, std::vector<o2d::VtxTrackIndex>& vertexTrackIDs, std::vector<V2TRef>& v2tRefs,
@@ -123,11 +133,13 @@ class PVertexer
 
   int findVertices(const VertexingInput& input, std::vector<PVertex>& vertices, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs);
   void reAttach(std::vector<PVertex>& vertices, std::vector<int>& timeSort, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs);
+  void appendVertices(const VerticesBuffer& buff, std::vector<PVertex>& vertices, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs);
 
   std::pair<int, int> getBestIR(const PVertex& vtx, const gsl::span<o2::InteractionRecord> bcData, int& currEntry) const;
 
   int dbscan_RangeQuery(int idxs, std::vector<int>& cand, std::vector<int>& status);
   void dbscan_clusterize();
+  void dbscan_clusterize(int first, int last, std::vector<int>& status, std::vector<TimeZCluster>& clusters);
   void doDBScanDump(const VertexingInput& input, gsl::span<const o2::MCCompLabel> lblTracks);
   void doVtxDump(std::vector<PVertex>& vertices, std::vector<uint32_t> trackIDsLoc, std::vector<V2TRef>& v2tRefsLoc, gsl::span<const o2::MCCompLabel> lblTracks);
 
@@ -142,6 +154,7 @@ class PVertexer
   float mITSROFrameLengthMUS = 0;           ///< ITS readout time span in \mus
   float mBz = 0.;                          ///< mag.field at beam line
   bool mValidateWithIR = false;            ///< require vertex validation with InteractionRecords (if available)
+  int mNThreads = 1;                       ///< number of OpenMP threads
 
   o2::InteractionRecord mStartIR{0, 0}; ///< IR corresponding to the start of the TF
 
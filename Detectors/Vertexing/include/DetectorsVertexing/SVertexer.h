@@ -67,6 +67,21 @@ class SVertexer
     VBracket vBracket;
   };
 
+  ///< counters of V0 candidate pairs rejection at different stages, for the cuts tuning
+  struct PairStats {
+    size_t nPairs = 0;       ///< pairs with compatible vertices
+    size_t nPreFiltered = 0; ///< pairs rejected by the circles distance pre-filter
+    size_t nNoPCA = 0;       ///< pairs for which the DCA fitter found no PCA candidate
+    size_t nV0s = 0;         ///< accepted V0s
+    void add(const PairStats& other)
+    {
+      nPairs += other.nPairs;
+      nPreFiltered += other.nPreFiltered;
+      nNoPCA += other.nNoPCA;
+      nV0s += other.nV0s;
+    }
+  };
+
   SVertexer(bool enabCascades = true) : mEnableCascades(enabCascades) {}
 
   void setEnableCascades(bool v) { mEnableCascades = v; }
@@ -77,6 +92,7 @@ class SVertexer
   void setMeanVertex(const o2d::VertexBase& v) { mMeanVertex = v; }
   void setNThreads(int n);
   int getNThreads() const { return mNThreads; }
+  const PairStats& getPairStats() const { return mPairStats; } ///< V0 pairs counters of the last processed TF
 
   template <typename V0CONT, typename V0REFCONT, typename CASCCONT, typename CASCREFCONT>
   void extractSecondaryVertices(V0CONT& v0s, V0REFCONT& vtx2V0Refs, CASCCONT& cascades, CASCREFCONT& vtx2CascRefs);
@@ -98,6 +114,10 @@ class SVertexer
   std::vector<std::vector<Cascade>> mCascadesTmp;
   std::array<std::vector<TrackCand>, 2> mTracksPool{}; // pools of positive and negative seeds sorted in min VtxID
   std::array<std::vector<int>, 2> mVtxFirstTrack{};    // 1st pos. and neg. track of the pools for each vertex
+  o2::track::TrackAuxParSoA mTracksAuxNeg;            // circle parameters of negative seeds for the V0 pairs screening
+  std::vector<std::vector<uint8_t>> mV0ScreenBuff;     // per thread flags of screened negative seeds
+  std::vector<PairStats> mPairStatsTmp;                // per thread V0 pairs counters
+  PairStats mPairStats;                                // V0 pairs counters of the TF
   o2d::VertexBase mMeanVertex{{0., 0., 0.}, {0.1 * 0.1, 0., 0.1 * 0.1, 0., 0., 6. * 6.}};
   const SVertexerParams* mSVParams = nullptr;
   std::array<SVertexHypothesis, NHypV0> mV0Hyps;
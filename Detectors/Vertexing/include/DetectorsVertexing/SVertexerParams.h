@@ -34,6 +34,8 @@ struct SVertexerParams : public o2::conf::ConfigurableParamHelper<SVertexerParam
   float minRelChi2Change = 0.9; ///< stop when chi2 changes by less than this value
   float maxDZIni = 5.;          ///< don't consider as a seed (circles intersection) if Z distance exceeds this
   float maxRIni = 150;          ///< don't consider as a seed (circles intersection) if its R exceeds this
+  float maxDXYIni = 4.;         ///< don't consider as a seed (circles intersection) if XY distance between the circles exceeds this
+  bool usePairPreFilter = true; ///< apply batched circles distance screening of V0 pairs before the DCA fitter
   bool useAbsDCA = true; ///< use abs dca minimization
   //
   float minRToMeanVertex = 0.5;           ///< min radial distance of V0 from beam line (mean vertex)
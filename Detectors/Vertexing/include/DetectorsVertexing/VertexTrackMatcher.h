@@ -17,6 +17,9 @@
 #define ALICEO2_VERTEX_TRACK_MATCHER_
 
 #include "gsl/span"
+#include <array>
+#include <unordered_map>
+#include <vector>
 #include "ReconstructionDataFormats/PrimaryVertex.h"
 #include "ReconstructionDataFormats/VtxTrackIndex.h"
 #include "ReconstructionDataFormats/VtxTrackRef.h"
@@ -38,7 +41,6 @@ class VertexTrackMatcher
   using VTIndex = o2::dataformats::VtxTrackIndex;
   using VRef = o2::dataformats::VtxTrackRef;
   using PVertex = const o2::dataformats::PrimaryVertex;
-  using TmpMap = std::vector<std::vector<VTIndex>>;
   using TimeEst = o2::dataformats::TimeStampWithError<float, float>;
   using TBracket = o2::math_utils::Bracketf_t;
 
@@ -50,23 +52,41 @@ class VertexTrackMatcher
     TBracket tBracket{}; ///< bracketing time in ns
     int origID = -1;     ///< vertex origin id
   };
+  struct TrackVtxMatch {
+    int first = 0;  ///< 1st matching vertex in the list of vertices sorted in tmin
+    int last = 0;   ///< last matching vertex + 1 in the same list
+    int nMatch = 0; ///< number of matching vertices in [first, last)
+  };
 
   void init();
   void process(const o2::globaltracking::RecoContainer& recoData,
                std::vector<VTIndex>& trackIndex, // Global ID's for associated tracks
                std::vector<VRef>& vtxRefs);      // references on these tracks
 
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
  private:
   void updateTimeDependentParams();
   void extractTracks(const o2::globaltracking::RecoContainer& data, const std::unordered_map<GIndex, bool>& vcont);
+  void indexVertices();
+  TrackVtxMatch matchTrack(const TrackTBracket& tro) const;
+
+  std::vector<TrackTBracket> mTBrackets;             ///< non-contributor tracks sorted in source then in tmin
+  std::array<int, GIndex::NSources + 1> mSrcStart{}; ///< 1st entry of each source in mTBrackets
+  std::vector<TrackVtxMatch> mTrackMatches;          ///< matching vertices of each entry of mTBrackets
+  std::vector<VtxTBracket> mVtxOrdBrack;             ///< vertex indices and brackets sorted in tmin
+  std::vector<int> mVtxBuckets;                      ///< 1st entry of mVtxOrdBrack with tmin >= mVtxTRef + ib * mVtxBucketWidth
+  float mVtxTRef = 0.f;                              ///< tmin of the 1st vertex
+  float mVtxBucketWidth = 1.f;                       ///< time span of vertex bucket in \mus
+  float mMaxVtxSpan = 0.f;                           ///< max. time span of the vertices in \mus
+  int mNThreads = 1;                                 ///< number of OpenMP threads
 
-  std::vector<TrackTBracket> mTBrackets;
   float mITSROFrameLengthMUS = 0;       ///< ITS RO frame in mus
   float mMFTROFrameLengthMUS = 0;       ///< MFT RO frame in mus
   float mMaxTPCDriftTimeMUS = 0;
   float mTPCBin2MUS = 0;
   const o2::vertexing::PVertexerParams* mPVParams = nullptr;
-
 };
 
 } // namespace vertexing
@@ -18,10 +18,15 @@
 #include "Math/SMatrix.h"
 #include "Math/SVector.h"
 #include <unordered_map>
+#include <iterator>
 #include <TStopwatch.h>
 #include "CommonUtils/StringUtils.h" // RS REM
 #include <TH2F.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::vertexing;
 
 constexpr float PVertexer::kAlmost0F;
@@ -40,7 +45,17 @@ int PVertexer::runVertexing(const gsl::span<o2d::GlobalTrackID> gids, const gsl:
   std::vector<float> validationTimes;
   std::vector<o2::MCEventLabel> lblVtxLoc;
 
-  for (auto tc : mTimeZClusters) {
+  // time clusters have no tracks in common, their vertices are found concurrently and merged in the clusters order
+  int nClus = mTimeZClusters.size(), nThreads = mNThreads;
+#ifdef _PV_DEBUG_TREE_
+  nThreads = 1; // debug dump is not thread-safe
+#endif
+  std::vector<VerticesBuffer> clusVertices(nClus);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int ic = 0; ic < nClus; ic++) {
+    auto& tc = mTimeZClusters[ic];
     VertexingInput inp;
     inp.idRange = gsl::span<int>(tc.trackIDs);
     inp.scaleSigma2 = mPVParams->iniScale2;
@@ -48,7 +63,11 @@ int PVertexer::runVertexing(const gsl::span<o2d::GlobalTrackID> gids, const gsl:
 #ifdef _PV_DEBUG_TREE_
     doDBScanDump(inp, lblTracks);
 #endif
-    findVertices(inp, verticesLoc, trackIDs, v2tRefsLoc);
+    auto& buff = clusVertices[ic];
+    findVertices(inp, buff.vertices, buff.trackIDs, buff.v2tRefs);
+  }
+  for (const auto& buff : clusVertices) {
+    appendVertices(buff, verticesLoc, trackIDs, v2tRefsLoc);
   }
 
   // sort in time
@@ -181,6 +200,23 @@ int PVertexer::findVertices(const VertexingInput& input, std::vector<PVertex>& v
   return nfound;
 }
 
+//______________________________________________
+void PVertexer::appendVertices(const VerticesBuffer& buff, std::vector<PVertex>& vertices, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs)
+{
+  // append vertices found for single time cluster to the global output, updating the references
+  int vtxOffset = vertices.size(), trcOffset = trackIDs.size();
+  vertices.insert(vertices.end(), buff.vertices.begin(), buff.vertices.end());
+  trackIDs.insert(trackIDs.end(), buff.trackIDs.begin(), buff.trackIDs.end());
+  for (const auto& ref : buff.v2tRefs) {
+    v2tRefs.emplace_back(ref.getFirstEntry() + trcOffset, ref.getEntries());
+  }
+  if (vtxOffset) {
+    for (auto id : buff.trackIDs) {
+      mTracksPool[id].vtxID += vtxOffset;
+    }
+  }
+}
+
 //______________________________________________
 bool PVertexer::findVertex(const VertexingInput& input, PVertex& vtx)
 {
@@ -442,10 +478,14 @@ void PVertexer::reAttach(std::vector<PVertex>& vertices, std::vector<int>& timeS
       trc.bin = -1;
     }
   }
-  // refit vertices with reattached tracks
+  // refit vertices with reattached tracks: every track is attached to at most 1 vertex, so the refits are independent
   v2tRefs.clear();
   trackIDs.clear();
   std::vector<PVertex> verticesUpd;
+  std::vector<char> refitOK(nvtOrig, 0);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
   for (int ivt = 0; ivt < nvtOrig; ivt++) {
     auto& clusZT = mTimeZClusters[ivt];
     auto& vtx = vertices[ivt];
@@ -460,7 +500,14 @@ void PVertexer::reAttach(std::vector<PVertex>& vertices, std::vector<int>& timeS
       vtx.setNContributors(0);
       continue;
     }
-    finalizeVertex(inp, vtx, verticesUpd, v2tRefs, trackIDs);
+    refitOK[ivt] = 1;
+  }
+  for (int ivt = 0; ivt < nvtOrig; ivt++) {
+    if (refitOK[ivt]) {
+      VertexingInput inp;
+      inp.idRange = gsl::span<int>(mTimeZClusters[ivt].trackIDs);
+      finalizeVertex(inp, vertices[ivt], verticesUpd, v2tRefs, trackIDs);
+    }
   }
   // reorder in time since the time-stamp of vertices might have been changed
   vertices.swap(verticesUpd);
@@ -822,10 +869,52 @@ void PVertexer::dbscan_clusterize()
   int ntr = mTracksPool.size();
   std::vector<int> status(ntr, DBS_UNDEF);
   TStopwatch timer;
+
+  // tracks separated in time by more than dbscanDeltaT cannot be neighbours: split the time-sorted pool
+  // into independent segments, clusterize them concurrently and store the clusters in the segments order
+  std::vector<std::pair<int, int>> segments;
+  int segStart = 0;
+  for (int it = 1; it <= ntr; it++) {
+    if (it == ntr || mTracksPool[it].timeEst.getTimeStamp() - mTracksPool[it - 1].timeEst.getTimeStamp() > mPVParams->dbscanDeltaT) {
+      segments.emplace_back(segStart, it);
+      segStart = it;
+    }
+  }
+  int nSeg = segments.size();
+  std::vector<std::vector<TimeZCluster>> segClusters(nSeg);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iseg = 0; iseg < nSeg; iseg++) {
+    dbscan_clusterize(segments[iseg].first, segments[iseg].second, status, segClusters[iseg]);
+  }
+  for (auto& clusters : segClusters) {
+    std::move(clusters.begin(), clusters.end(), std::back_inserter(mTimeZClusters));
+  }
+
+  for (auto& clus : mTimeZClusters) {
+    if (clus.trackIDs.size() < mPVParams->minTracksPerVtx) {
+      clus.trackIDs.clear();
+      continue;
+    }
+    float tMean = 0;
+    for (const auto tid : clus.trackIDs) {
+      tMean += mTracksPool[tid].timeEst.getTimeStamp();
+    }
+    clus.timeEst.setTimeStamp(tMean / clus.trackIDs.size());
+  }
+  timer.Stop();
+  LOG(INFO) << "Found " << mTimeZClusters.size() << " seeding clusters from DBSCAN in " << nSeg << " time segments in " << timer.CpuTime() << " CPU s";
+}
+
+//_____________________________________________________
+void PVertexer::dbscan_clusterize(int first, int last, std::vector<int>& status, std::vector<TimeZCluster>& clusters)
+{
+  // clusterize tracks [first : last) of the pool, which have no neighbours outside of this range
   int clID = -1;
 
   std::vector<int> nbVec;
-  for (int it = 0; it < ntr; it++) {
+  for (int it = first; it < last; it++) {
     if (status[it] != DBS_UNDEF) {
       continue;
     }
@@ -840,7 +929,7 @@ void PVertexer::dbscan_clusterize()
       minNeighbours = std::max(minNeighbours, int(nnb0 * mPVParams->dbscanAdaptCoef));
     }
     status[it] = ++clID;
-    auto& clusVec = mTimeZClusters.emplace_back().trackIDs; // new cluster
+    auto& clusVec = clusters.emplace_back().trackIDs; // new cluster
     clusVec.push_back(it);
 
     for (int j = 0; j < nnb0; j++) {
@@ -872,20 +961,6 @@ void PVertexer::dbscan_clusterize()
       }
     }
   }
-
-  for (auto& clus : mTimeZClusters) {
-    if (clus.trackIDs.size() < mPVParams->minTracksPerVtx) {
-      clus.trackIDs.clear();
-      continue;
-    }
-    float tMean = 0;
-    for (const auto tid : clus.trackIDs) {
-      tMean += mTracksPool[tid].timeEst.getTimeStamp();
-    }
-    clus.timeEst.setTimeStamp(tMean / clus.trackIDs.size());
-  }
-  timer.Stop();
-  LOG(INFO) << "Found " << mTimeZClusters.size() << " seeding clusters from DBSCAN in " << timer.CpuTime() << " CPU s";
 }
 
 //___________________________________________________________________
@@ -1013,3 +1088,14 @@ void PVertexer::doVtxDump(std::vector<PVertex>& vertices, std::vector<uint32_t>
   }
 #endif
 }
+
+//___________________________________________________________________
+void PVertexer::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  LOG(WARNING) << "Multithreading is not supported, imposing single thread";
+  mNThreads = 1;
+#endif
+}
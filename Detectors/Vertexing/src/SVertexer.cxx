@@ -39,6 +39,9 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData) // ac
   int ntrP = mTracksPool[POS].size(), ntrN = mTracksPool[NEG].size(), iThread = 0;
   mV0sTmp[0].clear();
   mCascadesTmp[0].clear();
+  for (auto& stat : mPairStatsTmp) {
+    stat = PairStats{};
+  }
 
 #ifdef WITH_OPENMP
   omp_set_num_threads(mNThreads);
@@ -47,15 +50,32 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData) // ac
 #endif
   for (int itp = 0; itp < ntrP; itp++) {
     auto& seedP = mTracksPool[POS][itp];
-    for (int itn = mVtxFirstTrack[NEG][seedP.vBracket.getMin()]; itn < ntrN; itn++) { // start from the 1st negative track of lowest-ID vertex of positive
-      auto& seedN = mTracksPool[NEG][itn];
-      if (seedN.vBracket > seedP.vBracket) { // all vertices compatible with seedN are in future wrt that of seedP
-        break;
-      }
+    int itnFirst = mVtxFirstTrack[NEG][seedP.vBracket.getMin()], itnLast = itnFirst; // start from the 1st negative track of lowest-ID vertex of positive
+    while (itnLast < ntrN && !(mTracksPool[NEG][itnLast].vBracket > seedP.vBracket)) { // stop at 1st seedN with all compatible vertices in future wrt that of seedP
+      itnLast++;
+    }
 #ifdef WITH_OPENMP
-      iThread = omp_get_thread_num();
+    iThread = omp_get_thread_num();
 #endif
-      checkV0(seedP, seedN, itp, itn, iThread);
+    auto& stat = mPairStatsTmp[iThread];
+    stat.nPairs += itnLast - itnFirst;
+    if (!mSVParams->usePairPreFilter) {
+      for (int itn = itnFirst; itn < itnLast; itn++) {
+        stat.nV0s += checkV0(seedP, mTracksPool[NEG][itn], itp, itn, iThread);
+      }
+      continue;
+    }
+    // batched screening of the pairs whose circles are too far to be accepted by the fitter
+    auto& accept = mV0ScreenBuff[iThread];
+    accept.resize(itnLast - itnFirst);
+    o2::track::TrackAuxPar traxP(seedP, mFitterV0[iThread].getBz());
+    mTracksAuxNeg.screen(traxP, itnFirst, itnLast, mFitterV0[iThread].getMaxDXYIni(), accept.data());
+    for (int itn = itnFirst; itn < itnLast; itn++) {
+      if (accept[itn - itnFirst]) {
+        stat.nV0s += checkV0(seedP, mTracksPool[NEG][itn], itp, itn, iThread);
+      } else {
+        stat.nPreFiltered++;
+      }
     }
   }
 #ifdef WITH_OPENMP
@@ -69,6 +89,12 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData) // ac
     mCascadesTmp[i].clear();
   }
 #endif
+  mPairStats = PairStats{};
+  for (const auto& stat : mPairStatsTmp) {
+    mPairStats.add(stat);
+  }
+  LOG(INFO) << "V0 pairs: " << mPairStats.nPairs << " checked, " << mPairStats.nPreFiltered << " rejected by pre-filter, "
+            << mPairStats.nNoPCA << " w/o PCA, " << mPairStats.nV0s << " accepted";
   LOG(INFO) << "DONE : " << mV0sTmp[0].size() << " " << mCascadesTmp[0].size();
 }
 
@@ -120,12 +146,15 @@ void SVertexer::setupThreads()
   mV0sTmp.resize(mNThreads);
   mCascadesTmp.resize(mNThreads);
   mFitterV0.resize(mNThreads);
+  mV0ScreenBuff.resize(mNThreads);
+  mPairStatsTmp.resize(mNThreads);
   auto bz = o2::base::Propagator::Instance()->getNominalBz();
   for (auto& fitter : mFitterV0) {
     fitter.setBz(bz);
     fitter.setUseAbsDCA(mSVParams->useAbsDCA);
     fitter.setPropagateToPCA(false);
     fitter.setMaxR(mSVParams->maxRIni);
+    fitter.setMaxDXYIni(mSVParams->maxDXYIni);
     fitter.setMinParamChange(mSVParams->minParamChange);
     fitter.setMinRelChi2Change(mSVParams->minRelChi2Change);
     fitter.setMaxDZIni(mSVParams->maxDZIni);
@@ -137,6 +166,7 @@ void SVertexer::setupThreads()
     fitter.setUseAbsDCA(mSVParams->useAbsDCA);
     fitter.setPropagateToPCA(false);
     fitter.setMaxR(mSVParams->maxRIniCasc);
+    fitter.setMaxDXYIni(mSVParams->maxDXYIni);
     fitter.setMinParamChange(mSVParams->minParamChange);
     fitter.setMinRelChi2Change(mSVParams->minRelChi2Change);
     fitter.setMaxDZIni(mSVParams->maxDZIni);
@@ -199,6 +229,23 @@ void SVertexer::buildT2V(const o2::globaltracking::RecoContainer& recoData) // a
         vtxFirstT[t.vBracket.getMin()] = i;
       }
     }
+    // vertices w/o tracks of this charge refer to the 1st track of the following vertices
+    int nextFirst = tracksPool.size();
+    for (int iv = nv; iv--;) {
+      if (vtxFirstT[iv] == -1) {
+        vtxFirstT[iv] = nextFirst;
+      } else {
+        nextFirst = vtxFirstT[iv];
+      }
+    }
+  }
+
+  // circle parameters of negative seeds for the screening of V0 candidates
+  mTracksAuxNeg.clear();
+  mTracksAuxNeg.reserve(mTracksPool[NEG].size());
+  float bz = mFitterV0.empty() ? o2::base::Propagator::Instance()->getNominalBz() : mFitterV0[0].getBz();
+  for (const auto& trc : mTracksPool[NEG]) {
+    mTracksAuxNeg.add(o2::track::TrackAuxPar(trc, bz));
   }
 
   LOG(INFO) << "Collected " << mTracksPool[POS].size() << " positive and " << mTracksPool[NEG].size() << " negative seeds";
@@ -210,6 +257,7 @@ bool SVertexer::checkV0(TrackCand& seedP, TrackCand& seedN, int iP, int iN, int
   auto& fitterV0 = mFitterV0[ithread];
   int nCand = fitterV0.process(seedP, seedN);
   if (nCand == 0) { // discard this pair
+    mPairStatsTmp[ithread].nNoPCA++;
     return false;
   }
   const auto& v0XYZ = fitterV0.getPCACandidate();
@@ -23,6 +23,7 @@
 #include "ITSMFTBase/DPLAlpideParam.h"
 #include <unordered_map>
 #include <numeric>
+#include <algorithm>
 
 using namespace o2::vertexing;
 
@@ -67,112 +68,199 @@ void VertexTrackMatcher::process(const o2::globaltracking::RecoContainer& recoDa
   auto v2tfitIDs = recoData.getPrimaryVertexContributors();
   auto v2tfitRefs = recoData.getPrimaryVertexContributorsRefs();
 
-  int nv = vertices.size(), nv1 = nv + 1;
-  TmpMap tmpMap(nv1);
-  auto& orphans = tmpMap.back(); // in the last element we store unassigned track indices
+  constexpr int NSrc = GIndex::NSources;
+  int nv = vertices.size(), nv1 = nv + 1; // in the last vertex slot we store unassigned track indices
+  std::vector<int> counts(nv1 * NSrc, 0); // number of entries for every vertex and source
 
   // register vertex contributors
   std::unordered_map<GIndex, bool> vcont;
-  std::vector<VtxTBracket> vtxOrdBrack; // vertex indices and brackets sorted in tmin
-  float maxVtxSpan = 0;
+  mVtxOrdBrack.clear();
+  mMaxVtxSpan = 0;
   for (int iv = 0; iv < nv; iv++) {
     int idMin = v2tfitRefs[iv].getFirstEntry(), idMax = idMin + v2tfitRefs[iv].getEntries();
-    auto& vtxIds = tmpMap[iv]; // global IDs of contibuting tracks
-    vtxIds.reserve(v2tfitRefs[iv].getEntries());
     for (int id = idMin; id < idMax; id++) {
       auto gid = v2tfitIDs[id];
-      vtxIds.emplace_back(gid).setPVContributor();
+      counts[iv * NSrc + gid.getSource()]++;
       vcont[gid] = true;
     }
     const auto& vtx = vertices[iv];
-    const auto& vto = vtxOrdBrack.emplace_back(VtxTBracket{
+    const auto& vto = mVtxOrdBrack.emplace_back(VtxTBracket{
       {float((vtx.getIRMin().differenceInBC(recoData.startIR) - 0.5f) * o2::constants::lhc::LHCBunchSpacingMUS),
        float((vtx.getIRMax().differenceInBC(recoData.startIR) + 0.5f) * o2::constants::lhc::LHCBunchSpacingMUS)},
       iv});
-    if (vto.tBracket.delta() > maxVtxSpan) {
-      maxVtxSpan = vto.tBracket.delta();
+    if (vto.tBracket.delta() > mMaxVtxSpan) {
+      mMaxVtxSpan = vto.tBracket.delta();
     }
   }
-  // sort vertices in tmin
-  std::sort(vtxOrdBrack.begin(), vtxOrdBrack.end(), [](const VtxTBracket& a, const VtxTBracket& b) { return a.tBracket.getMin() < b.tBracket.getMin(); });
+  indexVertices();
 
   extractTracks(recoData, vcont); // extract all track t-brackets, excluding those tracks which contribute to vertex (already attached)
 
-  int ivStart = 0, nAssigned = 0, nAmbiguous = 0;
-  std::vector<int> vtxList; // list of vertices which match to checked track
-  for (const auto& tro : mTBrackets) {
-    vtxList.clear();
-    for (int iv = ivStart; iv < nv; iv++) {
-      const auto& vto = vtxOrdBrack[iv];
-      auto res = tro.tBracket.isOutside(vto.tBracket);
-      if (res == TBracket::Below) {                                       // vertex preceeds the track
-        if (tro.tBracket.getMin() > vto.tBracket.getMin() + maxVtxSpan) { // all following vertices will be preceeding all following tracks times
-          ivStart = ++iv;
-          break;
-        }
-        continue; // following vertex with longer span might still match this track
-      }
-      if (res == TBracket::Above) { // track preceeds the vertex, so will preceed also all following vertices
-        break;
-      }
-      // track matches to vertex, register
-      vtxList.push_back(vto.origID); // flag matching vertex
-    }
-    if (tro.origID.getSource() == GIndex::Source::MFT) { // MFT tracks are treated differently: tracks with unresolved ambiguities are marked as orphans -> unassigned
-      if (vtxList.size() == 1) {
-        nAssigned++;
-        tmpMap[vtxList[0]].emplace_back(tro.origID).setAmbiguous();
-      } else {
-        orphans.emplace_back(tro.origID); // register as unassigned MFT track
-      }
-      if (vtxList.size() > 1) { // did track match to multiple vertices?
-        nAmbiguous++;           // Should count MFT tracks here even if they end up on the orphans/unassigned table?
-      }
-    } else {
-      if (vtxList.size()) {
-        nAssigned++;
-        for (auto v : vtxList) {
-          tmpMap[v].emplace_back(tro.origID).setAmbiguous();
-        }
-        if (vtxList.size() > 1) { // did track match to multiple vertices?
-          nAmbiguous++;
-        }
-      } else {
-        orphans.emplace_back(tro.origID); // register unassigned track
+  // 1st pass: find the matching vertices of every track and count the entries of every vertex and source
+  int ntr = mTBrackets.size(), nAssigned = 0, nAmbiguous = 0;
+  mTrackMatches.resize(ntr);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 256) num_threads(mNThreads) reduction(+ \
+                                                                                 : nAssigned, nAmbiguous)
+#endif
+  for (int itr = 0; itr < ntr; itr++) {
+    const auto& tro = mTBrackets[itr];
+    int src = tro.origID.getSource();
+    auto& match = mTrackMatches[itr];
+    match = matchTrack(tro);
+    if (match.nMatch > 1) { // did track match to multiple vertices?
+      nAmbiguous++;         // Should count MFT tracks here even if they end up on the orphans/unassigned table?
+    }
+    // MFT tracks are treated differently: tracks with unresolved ambiguities are marked as orphans -> unassigned
+    if (match.nMatch == 0 || (src == GIndex::Source::MFT && match.nMatch > 1)) {
+      match.nMatch = 0;
+#ifdef WITH_OPENMP
+#pragma omp atomic
+#endif
+      counts[nv * NSrc + src]++;
+      continue;
+    }
+    nAssigned++;
+    for (int iv = match.first; iv < match.last; iv++) {
+      const auto& vto = mVtxOrdBrack[iv];
+      if (tro.tBracket.isOutside(vto.tBracket) == TBracket::Inside) {
+#ifdef WITH_OPENMP
+#pragma omp atomic
+#endif
+        counts[vto.origID * NSrc + src]++;
       }
     }
   }
 
-  // build final vector of global indices
+  // build the references: entries of every vertex are sorted in source, unassigned tracks are in the last table with VtxID = -1
   trackIndex.clear();
   vtxRefs.clear();
-
+  vtxRefs.resize(nv1);
+  int nEntries = 0;
   for (int iv = 0; iv < nv1; iv++) {
-    auto& trvec = tmpMap[iv];
-    // sort entries in each vertex track indices list according to the source
-    std::sort(trvec.begin(), trvec.end(), [](VTIndex a, VTIndex b) { return a.getSource() < b.getSource(); });
-
-    auto entry0 = trackIndex.size(); // start of entries for this vertex
-    auto& vr = vtxRefs.emplace_back();
-    vr.setVtxID(iv < nv ? iv : -1); // flag table for unassigned tracks by VtxID = -1
-    int oldSrc = -1;
-    for (const auto gid0 : trvec) {
-      int src = gid0.getSource();
-      while (oldSrc < src) {
-        oldSrc++;
-        vr.setFirstEntryOfSource(oldSrc, trackIndex.size()); // register start of new source
-      }
-      trackIndex.push_back(gid0);
+    auto& vr = vtxRefs[iv];
+    vr.setVtxID(iv < nv ? iv : -1);
+    for (int src = 0; src < NSrc; src++) {
+      vr.setFirstEntryOfSource(src, nEntries);
+      int n = counts[iv * NSrc + src];
+      counts[iv * NSrc + src] = nEntries; // from now on the counts are the fill positions
+      nEntries += n;
     }
-    while (++oldSrc < GIndex::NSources) {
-      vr.setFirstEntryOfSource(oldSrc, trackIndex.size());
+    vr.setEnd(nEntries);
+  }
+
+  // 2nd pass: fill the entries, first the contributors of each vertex, then the tracks of each source in parallel,
+  // every source fills only its own slots of every vertex, so that the output does not depend on the threads
+  trackIndex.resize(nEntries);
+  for (int iv = 0; iv < nv; iv++) {
+    int idMin = v2tfitRefs[iv].getFirstEntry(), idMax = idMin + v2tfitRefs[iv].getEntries();
+    for (int id = idMin; id < idMax; id++) {
+      auto gid = v2tfitIDs[id];
+      auto& vid = trackIndex[counts[iv * NSrc + gid.getSource()]++];
+      vid = gid;
+      vid.setPVContributor();
+    }
+  }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int src = 0; src < NSrc; src++) {
+    for (int itr = mSrcStart[src]; itr < mSrcStart[src + 1]; itr++) {
+      const auto& tro = mTBrackets[itr];
+      const auto& match = mTrackMatches[itr];
+      if (match.nMatch == 0) {
+        trackIndex[counts[nv * NSrc + src]++] = tro.origID; // register unassigned track
+        continue;
+      }
+      for (int iv = match.first; iv < match.last; iv++) {
+        const auto& vto = mVtxOrdBrack[iv];
+        if (tro.tBracket.isOutside(vto.tBracket) == TBracket::Inside) {
+          auto& vid = trackIndex[counts[vto.origID * NSrc + src]++];
+          vid = tro.origID;
+          vid.setAmbiguous();
+        }
+      }
     }
-    vr.setEnd(trackIndex.size());
+  }
+  for (const auto& vr : vtxRefs) {
     LOG(INFO) << vr;
   }
   LOG(INFO) << "Assigned " << nAssigned << " (" << nAmbiguous << " ambigously) out of " << mTBrackets.size() << " non-contributor tracks + " << vcont.size() << " contributors";
 }
 
+//________________________________________________________
+void VertexTrackMatcher::indexVertices()
+{
+  // sort vertices in tmin and index them in buckets of tmin, with on average 1 vertex per bucket
+  std::sort(mVtxOrdBrack.begin(), mVtxOrdBrack.end(), [](const VtxTBracket& a, const VtxTBracket& b) { return a.tBracket.getMin() < b.tBracket.getMin(); });
+  int nv = mVtxOrdBrack.size();
+  mVtxBuckets.clear();
+  if (!nv) {
+    return;
+  }
+  mVtxTRef = mVtxOrdBrack.front().tBracket.getMin();
+  float span = mVtxOrdBrack.back().tBracket.getMin() - mVtxTRef;
+  mVtxBucketWidth = std::max(span / nv, 1e-3f);
+  int nBuckets = int(span / mVtxBucketWidth) + 1;
+  mVtxBuckets.resize(nBuckets + 1);
+  for (int ib = 0, iv = 0; ib < nBuckets; ib++) {
+    float tb = mVtxTRef + ib * mVtxBucketWidth;
+    while (iv < nv && mVtxOrdBrack[iv].tBracket.getMin() < tb) {
+      iv++;
+    }
+    mVtxBuckets[ib] = iv;
+  }
+  mVtxBuckets[nBuckets] = nv;
+}
+
+//________________________________________________________
+VertexTrackMatcher::TrackVtxMatch VertexTrackMatcher::matchTrack(const TrackTBracket& tro) const
+{
+  // find the vertices matching to the track: only those with tmin in [tro.tmin - maxVtxSpan, tro.tmax] may match
+  TrackVtxMatch match;
+  int nv = mVtxOrdBrack.size();
+  float tmin = tro.tBracket.getMin() - mMaxVtxSpan;
+  int iv = 0;
+  if (tmin > mVtxTRef) {
+    int ib = int((tmin - mVtxTRef) / mVtxBucketWidth);
+    if (ib >= int(mVtxBuckets.size()) - 1) {
+      return match;
+    }
+    iv = mVtxBuckets[ib];
+    while (iv > 0 && mVtxOrdBrack[iv - 1].tBracket.getMin() >= tmin) { // protection against the rounding of bucket boundaries
+      iv--;
+    }
+    while (iv < nv && mVtxOrdBrack[iv].tBracket.getMin() < tmin) {
+      iv++;
+    }
+  }
+  for (; iv < nv; iv++) {
+    const auto& vto = mVtxOrdBrack[iv];
+    auto res = tro.tBracket.isOutside(vto.tBracket);
+    if (res == TBracket::Above) { // track preceeds the vertex, so will preceed also all following vertices
+      break;
+    }
+    if (res == TBracket::Inside) { // track matches to vertex, register
+      if (!match.nMatch++) {
+        match.first = iv;
+      }
+      match.last = iv + 1;
+    }
+  }
+  return match;
+}
+
+//________________________________________________________
+void VertexTrackMatcher::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  LOG(WARNING) << "Multithreading is not supported, imposing single thread";
+  mNThreads = 1;
+#endif
+}
+
 //________________________________________________________
 void VertexTrackMatcher::extractTracks(const o2::globaltracking::RecoContainer& data, const std::unordered_map<GIndex, bool>& vcont)
 {
@@ -202,8 +290,17 @@ void VertexTrackMatcher::extractTracks(const o2::globaltracking::RecoContainer&
 
   data.createTracksVariadic(creator);
 
-  // sort in increasing min.time
-  std::sort(mTBrackets.begin(), mTBrackets.end(), [](const TrackTBracket& a, const TrackTBracket& b) { return a.tBracket.getMin() < b.tBracket.getMin(); });
+  // sort in source and then in increasing min.time
+  std::sort(mTBrackets.begin(), mTBrackets.end(), [](const TrackTBracket& a, const TrackTBracket& b) {
+    return a.origID.getSource() < b.origID.getSource() || (a.origID.getSource() == b.origID.getSource() && a.tBracket.getMin() < b.tBracket.getMin());
+  });
+  mSrcStart.fill(0);
+  for (const auto& tro : mTBrackets) {
+    mSrcStart[tro.origID.getSource() + 1]++;
+  }
+  for (int src = 0; src < GIndex::NSources; src++) {
+    mSrcStart[src + 1] += mSrcStart[src];
+  }
 
   LOG(INFO) << "collected " << mTBrackets.size() << " non-contributor and " << vcont.size() << " contributor seeds";
 }
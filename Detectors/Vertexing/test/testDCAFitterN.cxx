@@ -387,5 +387,47 @@ BOOST_AUTO_TEST_CASE(DCAFitterNProngs)
   outStream.Close();
 }
 
+BOOST_AUTO_TEST_CASE(TrackAuxParSoAScreening)
+{
+  // the batched screening must never reject the pair accepted by the fitter crossing check
+  constexpr int NTest = 2000;
+  TGenPhaseSpace genPHS;
+  constexpr double pion = 0.13957;
+  constexpr double k0 = 0.49761;
+  std::vector<double> k0dec = {pion, pion};
+  std::vector<o2::track::TrackParCov> vctracks, tracksP, tracksN;
+  Vec3D vtxGen;
+  float bz = 5.0, maxDXY = 4.;
+  for (int iev = 0; iev < NTest; iev++) {
+    generate(vtxGen, vctracks, bz, genPHS, k0, k0dec, {1, iev % 10 ? 1 : 0}); // add some straight tracks
+    tracksP.push_back(vctracks[0]);
+    tracksN.push_back(vctracks[1]);
+  }
+  o2::track::TrackAuxParSoA auxN;
+  for (const auto& trc : tracksN) {
+    auxN.add(o2::track::TrackAuxPar(trc, bz));
+  }
+  BOOST_CHECK(auxN.size() == tracksN.size());
+  std::vector<uint8_t> accept(tracksN.size());
+  int nCross = 0, nAccepted = 0, nMissed = 0, nPairs = tracksP.size() * tracksN.size();
+  for (const auto& trcP : tracksP) {
+    o2::track::TrackAuxPar traxP(trcP, bz);
+    auxN.screen(traxP, 0, tracksN.size(), maxDXY, accept.data());
+    for (size_t in = 0; in < tracksN.size(); in++) {
+      o2::track::TrackAuxPar traxN(tracksN[in], bz);
+      o2::track::CrossInfo cross;
+      bool crossing = cross.set(traxP, trcP, traxN, tracksN[in], maxDXY) > 0;
+      nCross += crossing;
+      nAccepted += accept[in];
+      if (crossing && !accept[in]) {
+        nMissed++;
+      }
+    }
+  }
+  LOG(INFO) << "Screening accepted " << nAccepted << " pairs out of " << nPairs << ", " << nCross << " pass the crossing check";
+  BOOST_CHECK(nMissed == 0);
+  BOOST_CHECK(nAccepted < nPairs); // some pairs must be screened out
+}
+
 } // namespace vertexing
 } // namespace o2
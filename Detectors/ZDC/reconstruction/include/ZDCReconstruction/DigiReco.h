@@ -34,6 +34,8 @@ namespace o2
 {
 namespace zdc
 {
+using O2_ZDC_DIGIRECO_FLT = float;
+
 class DigiReco
 {
  public:
@@ -85,6 +87,9 @@ class DigiReco
   void processTrigger(int itdc, int ibeg, int iend);                          /// Replay of trigger algorithm on acquired data
   void interpolate(int itdc, int ibeg, int iend);                             /// Interpolation of samples to evaluate signal amplitude and arrival time
   void assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float amp); /// Set reconstructed TDC values
+  void fillSamples(int itdc, int ibeg, int iend);                             /// Copy TDC channel samples of a bunch range in padded array
+  void integrate(int ibun, const float* pbun, const bool* fired);             /// Baseline subtraction and charge integration of all channels
+  const float* getPedestal(int ibun) const;                                   /// Pedestals of bunch orbit (nullptr if missing)
   bool mIsContinuous = true;                                                  /// continuous (self-triggered) or externally-triggered readout
   int mNBCAHead = 0;                                                          /// when storing triggered BC, store also mNBCAHead BCs
   const ZDCTDCParam* mTDCParam = nullptr;                                     /// TDC calibration object
@@ -94,6 +99,9 @@ class DigiReco
   const RecoConfigZDC* mRecoConfigZDC = nullptr;                              /// CCDB configuration parameters
   int32_t mVerbosity = DbgMinimal;
   Double_t mTS[NTS];                                /// Tapered sinc function
+  static constexpr int mNTSTaps = 2 * TSL;          /// Number of sinc samples used for each interpolated point
+  Double_t mTSTaps[mNTSTaps][TSN];                  /// Tapered sinc function ordered by sample and interpolated point
+  O2_ZDC_DIGIRECO_FLT mTSSum[TSN];                  /// Normalization of interpolated points
   bool mTreeDbg = false;                            /// Write reconstructed data in debug output file
   std::unique_ptr<TFile> mDbg = nullptr;            /// Debug output file
   std::unique_ptr<TTree> mTDbg = nullptr;           /// Debug tree
@@ -108,6 +116,18 @@ class DigiReco
   int mNLonely = 0;
   int mNLastLonely = 0;
   int16_t tdc_shift[NTDCChannels] = {0}; /// TDC correction (units of 1/96 ns)
+  // Reconstruction parameters, copied from RecoParamZDC once per run
+  int mTSh[NTDCChannels] = {0};                 /// Trigger shift
+  int mTTh[NTDCChannels] = {0};                 /// Trigger threshold
+  bool mBitSet[NTDCChannels] = {0};             /// Set bits in coincidence
+  int mTCh[NTDCChannels] = {0};                 /// Hardware channel of TDC channel
+  float mTDCSearch[NTDCChannels] = {0};         /// Search zone for a TDC signal
+  int mBegInt[NChannels] = {0};                 /// Beginning of signal integration range
+  int mEndInt[NChannels] = {0};                 /// End of signal integration range
+  float mEnergyCalib[NChannels] = {0};          /// Energy calibration coefficients
+  std::vector<float> mPed;                      /// Orbit pedestals, NChannels values per orbit
+  std::vector<int> mBCPed;                      /// Index of orbit pedestals for each bunch (-1 if missing)
+  std::vector<O2_ZDC_DIGIRECO_FLT> mTDCSamples; /// Samples of current TDC channel and bunch range, with TSL copies of first and last sample
   constexpr static uint16_t mMask[NTimeBinsPerBC] = {0x0001, 0x002, 0x004, 0x008, 0x0010, 0x0020, 0x0040, 0x0080, 0x0100, 0x0200, 0x0400, 0x0800};
 };
 } // namespace zdc
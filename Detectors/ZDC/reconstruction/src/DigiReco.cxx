@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <algorithm>
 #include <TMath.h>
 #include "Framework/Logger.h"
 #include "ZDCReconstruction/DigiReco.h"
@@ -18,8 +19,6 @@ namespace o2
 {
 namespace zdc
 {
-using O2_ZDC_DIGIRECO_FLT = float;
-
 void DigiReco::init()
 {
   LOG(INFO) << "Initialization of ZDC reconstruction";
@@ -48,6 +47,18 @@ void DigiReco::init()
     mTS[n + tsi] = fs * fg;
     mTS[n - tsi] = mTS[n + tsi]; // Function is even
   }
+  // Samples of tapered sinc function used for each interpolated point and their sum
+  for (int im = 1; im < TSN; im++) {
+    int it = 0;
+    mTSSum[im] = 0;
+    for (int is = TSN - im; is < NTS; is += TSN, it++) {
+      mTSTaps[it][im] = mTS[is];
+      mTSSum[im] += mTS[is];
+    }
+    if (it != mNTSTaps) {
+      LOG(FATAL) << "Interpolation uses " << it << " samples instead of " << mNTSTaps;
+    }
+  }
 
   if (mTreeDbg) {
     // Open debug file
@@ -204,6 +215,25 @@ void DigiReco::init()
     }
     LOG(INFO) << ChannelNames[ich] << " integration: signal=[" << ropt.beg_int[ich] << ":" << ropt.end_int[ich] << "] pedestal=[" << ropt.beg_ped_int[ich] << ":" << ropt.end_ped_int[ich] << "]";
   }
+
+  // Copy of final reconstruction parameters used in the processing
+  for (int itdc = 0; itdc < NTDCChannels; itdc++) {
+    mTSh[itdc] = ropt.tsh[itdc];
+    mTTh[itdc] = ropt.tth[itdc];
+    mBitSet[itdc] = ropt.bitset[itdc];
+    mTCh[itdc] = ropt.tch[itdc];
+    mTDCSearch[itdc] = ropt.tdc_search[itdc];
+  }
+  for (int ich = 0; ich < NChannels; ich++) {
+    mBegInt[ich] = ropt.beg_int[ich];
+    mEndInt[ich] = ropt.end_int[ich];
+    mEnergyCalib[ich] = ropt.energy_calib[ich];
+  }
+}
+
+const float* DigiReco::getPedestal(int ibun) const
+{
+  return mBCPed[ibun] < 0 ? nullptr : &mPed[mBCPed[ibun] * NChannels];
 }
 
 int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, const gsl::span<const o2::zdc::BCData>& bcdata, const gsl::span<const o2::zdc::ChannelData>& chdata)
@@ -222,7 +252,23 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
       LOG(INFO) << "mOrbitData[" << mOrbitData[iorb].ir.orbit << "] = " << iorb;
     }
   }
+  mPed.resize(norb * NChannels);
+  for (int iorb = 0; iorb < norb; iorb++) {
+    for (int ich = 0; ich < NChannels; ich++) {
+      mPed[iorb * NChannels + ich] = mOrbitData[iorb].asFloat(ich);
+    }
+  }
   mNBC = mBCData.size();
+  // Orbit pedestals of each bunch, bunches are ordered and the lookup is done once per orbit
+  mBCPed.resize(mNBC);
+  for (int ibc = 0; ibc < mNBC; ibc++) {
+    if (ibc > 0 && mBCData[ibc].ir.orbit == mBCData[ibc - 1].ir.orbit) {
+      mBCPed[ibc] = mBCPed[ibc - 1];
+    } else {
+      auto it = mOrbit.find(mBCData[ibc].ir.orbit);
+      mBCPed[ibc] = it != mOrbit.end() ? it->second : -1;
+    }
+  }
   mReco.clear();
   mReco.resize(mNBC);
   // Initialization of reco structure
@@ -313,9 +359,6 @@ int DigiReco::reconstruct(int ibeg, int iend)
     LOG(INFO) << __func__ << "(" << ibeg << "," << iend << "): " << mReco[ibeg].ir.orbit << "." << mReco[ibeg].ir.bc << " - " << mReco[iend].ir.orbit << "." << mReco[iend].ir.bc;
   }
 
-  // Get reconstruction parameters
-  auto& ropt = RecoParamZDC::Instance();
-
   // Apply differential discrimination with triple condition
   for (int itdc = 0; itdc < NTDCChannels; itdc++) {
     // Check if channel has valid data for consecutive bunches in current bunch range
@@ -352,13 +395,11 @@ int DigiReco::reconstruct(int ibeg, int iend)
   for (int ibun = ibeg; ibun <= iend; ibun++) {
     // Look for offset
     float pbun[NChannels];
-    auto orbit = mBCData[ibun].ir.orbit;
-    std::map<uint32_t, int>::iterator it = mOrbit.find(orbit);
-    if (it != mOrbit.end()) {
+    const float* ped = getPedestal(ibun);
+    if (ped) {
       // Subtract pedestal
-      auto& orbitdata = mOrbitData[it->second];
       for (int ich = 0; ich < NChannels; ich++) {
-        pbun[ich] = orbitdata.asFloat(ich);
+        pbun[ich] = ped[ich];
       }
     } else {
       LOG(ERROR) << "Missing pedestal for bunch " << ibun;
@@ -391,12 +432,12 @@ int DigiReco::reconstruct(int ibeg, int iend)
         LOG(INFO) << "tdc " << i << " [" << ChannelNames[TDCSignal[itdc]] << "] " << rec.tdcAmp[itdc][i] << " @ " << rec.tdcVal[itdc][i];
 #endif
         // There is a TDC value in the search zone around main-main position
-        if (std::abs(rec.tdcVal[itdc][i]) < ropt.tdc_search[itdc]) {
+        if (std::abs(rec.tdcVal[itdc][i]) < mTDCSearch[itdc]) {
           rec.pattern[itdc] = 1;
         }
 #ifdef O2_ZDC_DEBUG
         else {
-          LOG(INFO) << rec.tdcVal[itdc][i] << " " << ropt.tdc_search[itdc];
+          LOG(INFO) << rec.tdcVal[itdc][i] << " " << mTDCSearch[itdc];
         }
 #endif
       }
@@ -411,12 +452,12 @@ int DigiReco::reconstruct(int ibeg, int iend)
     // Check if coincidence of common PM and sum of towers is satisfied
     bool fired[NChannels] = {0};
     // Side A
-    if ((rec.pattern[TDCZNAC] || ropt.bitset[TDCZNAC]) && (rec.pattern[TDCZNAS] || ropt.bitset[TDCZNAS])) {
+    if ((rec.pattern[TDCZNAC] || mBitSet[TDCZNAC]) && (rec.pattern[TDCZNAS] || mBitSet[TDCZNAS])) {
       for (int ich = IdZNAC; ich <= IdZNASum; ich++) {
         fired[ich] = true;
       }
     }
-    if ((rec.pattern[TDCZPAC] || ropt.bitset[TDCZPAC]) && (rec.pattern[TDCZPAS] || ropt.bitset[TDCZPAS])) {
+    if ((rec.pattern[TDCZPAC] || mBitSet[TDCZPAC]) && (rec.pattern[TDCZPAS] || mBitSet[TDCZPAS])) {
       for (int ich = IdZPAC; ich <= IdZPASum; ich++) {
         fired[ich] = true;
       }
@@ -425,12 +466,12 @@ int DigiReco::reconstruct(int ibeg, int iend)
     fired[IdZEM1] = rec.pattern[TDCZEM1];
     fired[IdZEM2] = rec.pattern[TDCZEM2];
     // Side C
-    if ((rec.pattern[TDCZNCC] || ropt.bitset[TDCZNCC]) && (rec.pattern[TDCZNCS] || ropt.bitset[TDCZNCS])) {
+    if ((rec.pattern[TDCZNCC] || mBitSet[TDCZNCC]) && (rec.pattern[TDCZNCS] || mBitSet[TDCZNCS])) {
       for (int ich = IdZNCC; ich <= IdZNCSum; ich++) {
         fired[ich] = true;
       }
     }
-    if ((rec.pattern[TDCZPCC] || ropt.bitset[TDCZPCC]) && (rec.pattern[TDCZPCS] || ropt.bitset[TDCZPCS])) {
+    if ((rec.pattern[TDCZPCC] || mBitSet[TDCZPCC]) && (rec.pattern[TDCZPCS] || mBitSet[TDCZPCS])) {
       for (int ich = IdZPCC; ich <= IdZPCSum; ich++) {
         fired[ich] = true;
       }
@@ -445,26 +486,7 @@ int DigiReco::reconstruct(int ibeg, int iend)
              fired[IdZNCC], fired[IdZNC1], fired[IdZNC2], fired[IdZNC3], fired[IdZNC4], fired[IdZNCSum],
              fired[IdZPCC], fired[IdZPC1], fired[IdZPC2], fired[IdZPC3], fired[IdZPC4], fired[IdZPCSum]);
     }
-    for (int ich = 0; ich < NChannels; ich++) {
-      // Check if the corresponding TDC is fired
-      if (fired[ich]) {
-        // Check if channel data are present in payload
-        auto ref = mReco[ibun].ref[ich];
-        if (ref < ZDCRefInitVal) {
-          float sum = 0;
-          for (int is = ropt.beg_int[ich]; is <= ropt.end_int[ich]; is++) {
-            // TODO: fallback if offset is missing
-            // TODO: fallback if channel has pile-up
-            // TODO: manage signal positioned across boundary
-            sum += (pbun[ich] - float(mChData[ref].data[is]));
-          }
-#ifdef O2_ZDC_DEBUG
-          printf("CH %2d %s: %f\n", ich, ChannelNames[ich].data(), sum);
-#endif
-          rec.ezdc[ich] = sum * ropt.energy_calib[ich];
-        }
-      }
-    }
+    integrate(ibun, pbun, fired);
     if (mTreeDbg) {
       mRec = rec;
       mTDbg->Fill();
@@ -473,18 +495,76 @@ int DigiReco::reconstruct(int ibeg, int iend)
   return 0;
 }
 
+void DigiReco::integrate(int ibun, const float* pbun, const bool* fired)
+{
+  // Samples are arranged with channel as inner index and all channels are integrated together.
+  // The summation order for each channel is the same as the sample-by-sample integration
+  // TODO: fallback if offset is missing
+  // TODO: fallback if channel has pile-up
+  // TODO: manage signal positioned across boundary
+  auto& rec = mReco[ibun];
+  bool present[NChannels];
+  float sam[NTimeBinsPerBC][NChannels];
+  float sum[NChannels];
+  for (int ich = 0; ich < NChannels; ich++) {
+    // Check if the corresponding TDC is fired and if channel data are present in payload
+    auto ref = rec.ref[ich];
+    present[ich] = fired[ich] && ref < ZDCRefInitVal;
+    for (int is = 0; is < NTimeBinsPerBC; is++) {
+      sam[is][ich] = present[ich] ? float(mChData[ref].data[is]) : 0.f;
+    }
+    sum[ich] = 0;
+  }
+  for (int is = 0; is < NTimeBinsPerBC; is++) {
+    for (int ich = 0; ich < NChannels; ich++) {
+      bool inrange = present[ich] && is >= mBegInt[ich] && is <= mEndInt[ich];
+      sum[ich] += inrange ? (pbun[ich] - sam[is][ich]) : 0.f;
+    }
+  }
+  for (int ich = 0; ich < NChannels; ich++) {
+    if (present[ich]) {
+#ifdef O2_ZDC_DEBUG
+      printf("CH %2d %s: %f\n", ich, ChannelNames[ich].data(), sum[ich]);
+#endif
+      rec.ezdc[ich] = sum[ich] * mEnergyCalib[ich];
+    }
+  }
+}
+
+void DigiReco::fillSamples(int itdc, int ibeg, int iend)
+{
+  // Samples of TDC channel for consecutive bunches, the array is padded with TSL copies
+  // of first and last sample to have constant extrapolation outside the acquired range
+  int nsam = (iend - ibeg + 1) * NTimeBinsPerBC;
+  mTDCSamples.resize(nsam + 2 * TSL);
+  auto* sam = &mTDCSamples[TSL];
+  for (int ibun = ibeg; ibun <= iend; ibun++) {
+    auto ref = mReco[ibun].ref[TDCSignal[itdc]];
+    // Check data consistency before using samples
+    if (ref == ZDCRefInitVal) {
+      LOG(FATAL) << "Missing information for bunch crossing";
+      return;
+    }
+    for (int is = 0; is < NTimeBinsPerBC; is++) {
+      *sam++ = mChData[ref].data[is];
+    }
+  }
+  std::fill(mTDCSamples.begin(), mTDCSamples.begin() + TSL, mTDCSamples[TSL]);
+  std::fill(mTDCSamples.end() - TSL, mTDCSamples.end(), mTDCSamples[TSL + nsam - 1]);
+}
+
 void DigiReco::processTrigger(int itdc, int ibeg, int iend)
 {
 #ifdef O2_ZDC_DEBUG
   LOG(INFO) << __func__ << "(itdc=" << itdc << "[" << ChannelNames[TDCSignal[itdc]] << "] ," << ibeg << "," << iend << "): " << mReco[ibeg].ir.orbit << "." << mReco[ibeg].ir.bc << " - " << mReco[iend].ir.orbit << "." << mReco[iend].ir.bc;
 #endif
-  // Get reconstruction parameters
-  auto& ropt = RecoParamZDC::Instance();
+  fillSamples(itdc, ibeg, iend);
+  const auto* sam = &mTDCSamples[TSL];
 
   int nbun = iend - ibeg + 1;
   int maxs2 = NTimeBinsPerBC * nbun - 1;
-  int shift = ropt.tsh[itdc];
-  int thr = ropt.tth[itdc];
+  int shift = mTSh[itdc];
+  int thr = mTTh[itdc];
 
   int is1 = 0, is2 = 1;
   int isfired[3] = {0};
@@ -494,26 +574,16 @@ void DigiReco::processTrigger(int itdc, int ibeg, int iend)
     for (int i = 1; i < 3; i++) {
       isfired[i] = isfired[i - 1];
     }
-    // Bunches and samples that are used in the difference
-    int b1 = ibeg + is1 / NTimeBinsPerBC;
-    int b2 = ibeg + is2 / NTimeBinsPerBC;
-    int s1 = is1 % NTimeBinsPerBC;
-    int s2 = is2 % NTimeBinsPerBC;
-    auto ref_m = mReco[b1].ref[TDCSignal[itdc]];
-    auto ref_s = mReco[b2].ref[TDCSignal[itdc]];
-    // Check data consistency before computing difference
-    if (ref_m == ZDCRefInitVal || ref_s == ZDCRefInitVal) {
-      LOG(FATAL) << "Missing information for bunch crossing";
-      return;
-    }
     // TODO: More checks that bunch crossings are indeed consecutive
-    int diff = mChData[ref_m].data[s1] - mChData[ref_s].data[s2];
+    int diff = int(sam[is1]) - int(sam[is2]);
     // Triple trigger condition
     if (diff > thr) {
       isfired[0] = 1;
       if (isfired[1] == 1 && isfired[2] == 1) {
         // Fired bit is assigned to the second sample, i.e. to the one that can identify the
         // signal peak position
+        int b2 = ibeg + is2 / NTimeBinsPerBC;
+        int s2 = is2 % NTimeBinsPerBC;
         mReco[b2].fired[itdc] |= mMask[s2];
 #ifdef O2_ZDC_DEBUG
         LOG(INFO) << itdc << " " << ChannelNames[TDCSignal[itdc]] << " Fired @ " << mReco[b2].ir.orbit << "." << mReco[b2].ir.bc << ".s" << s2;
@@ -549,25 +619,13 @@ void DigiReco::interpolate(int itdc, int ibeg, int iend)
   constexpr int nsp = 5;                         // Number of points to be searched
 
   // At this level there should be no need to check if the TDC channel is connected
-  // since a fatal should have been raised already
-  for (int ibun = ibeg; ibun <= iend; ibun++) {
-    auto ref = mReco[ibun].ref[TDCSignal[itdc]];
-    if (ref == ZDCRefInitVal) {
-      LOG(FATAL) << "Missing information for bunch crossing";
-    }
-  }
+  // since a fatal should have been raised already. Samples have been copied by fillSamples()
+  const auto* sam = &mTDCSamples[TSL];
 
-  // Get reconstruction parameters
-  auto& ropt = RecoParamZDC::Instance();
+  int ich = mTCh[itdc]; // Hardware channel corresponding to TDC channel
 
-  int imod = ropt.tmod[itdc]; // Module corresponding to TDC channel
-  int ich = ropt.tch[itdc];   // Hardware channel corresponding to TDC channel
-
-  auto ref_beg = mReco[ibeg].ref[TDCSignal[itdc]];
-  auto ref_end = mReco[iend].ref[TDCSignal[itdc]];
-
-  O2_ZDC_DIGIRECO_FLT first_sample = mChData[ref_beg].data[0];
-  O2_ZDC_DIGIRECO_FLT last_sample = mChData[ref_end].data[NTimeBinsPerBC - 1];
+  O2_ZDC_DIGIRECO_FLT first_sample = sam[0];
+  O2_ZDC_DIGIRECO_FLT last_sample = sam[nsam - 1];
 
   // Constant extrapolation at the beginning and at the end of the array
   // Assign value of first sample
@@ -580,43 +638,29 @@ void DigiReco::interpolate(int itdc, int ibeg, int iend)
     mReco[iend].inter[itdc][isam] = last_sample;
   }
   // Interpolation between acquired points (n.b. loop from 0 to nint)
-  for (int i = 0; i < nint; i++) {
-    // Identification of the point to be assigned (need to add tsnh to identify the point)
-    int ibun = ibeg + (i + tsnh) / nsbun;
-    int isam = (i + tsnh) % nsbun;
-    int im = i % TSN;
-    if (im == 0) {
-      // This is an acquired point
-      int ip = (i / TSN) % NTimeBinsPerBC;
-      int ib = ibeg + (i / TSN) / NTimeBinsPerBC;
-      if (ib != ibun) {
-        LOG(FATAL) << "ib=" << ib << " ibun=" << ibun;
-        return;
-      }
-      mReco[ibun].inter[itdc][isam] = mChData[mReco[ibun].ref[TDCSignal[itdc]]].data[ip];
-    } else {
-      // Do the actual interpolation
-      O2_ZDC_DIGIRECO_FLT y = 0;
-      int ip = i / TSN;
-      O2_ZDC_DIGIRECO_FLT sum = 0;
-      for (int is = TSN - im, ii = ip - TSL + 1; is < NTS; is += TSN, ii++) {
-        // Default is first point in the array
-        O2_ZDC_DIGIRECO_FLT yy = first_sample;
-        if (ii > 0) {
-          if (ii < nsam) {
-            int ip = ii % NTimeBinsPerBC;
-            int ib = ibeg + ii / NTimeBinsPerBC;
-            yy = mChData[mReco[ib].ref[TDCSignal[itdc]]].data[ip];
-          } else {
-            // Last acquired point
-            yy = last_sample;
-          }
-        }
-        sum += mTS[is];
-        y += yy * mTS[is];
-      }
-      y = y / sum;
-      mReco[ibun].inter[itdc][isam] = y;
+  // All points between acquired samples ip and ip+1 are computed together: each point
+  // accumulates the same products in the same order as a point-by-point evaluation
+  // Outside the acquired range the first and last samples are used (padding of mTDCSamples)
+  O2_ZDC_DIGIRECO_FLT y[TSN];
+  for (int ip = 0; ip < nsam - 1; ip++) {
+    const auto* yy = &sam[ip - TSL + 1];
+    for (int im = 0; im < TSN; im++) {
+      y[im] = 0;
+    }
+    for (int it = 0; it < mNTSTaps; it++) {
+      for (int im = 1; im < TSN; im++) {
+        y[im] += yy[it] * mTSTaps[it][im];
+      }
+    }
+    // This is an acquired point
+    y[0] = sam[ip];
+    for (int im = 1; im < TSN; im++) {
+      y[im] = y[im] / mTSSum[im];
+    }
+    // Identification of the points to be assigned (need to add tsnh to identify the point)
+    for (int im = 0; im < TSN; im++) {
+      int i = ip * TSN + im + tsnh;
+      mReco[ibeg + i / nsbun].inter[itdc][i % nsbun] = y[im];
     }
   }
   // Looking for a local maximum in a searching zone
@@ -736,12 +780,10 @@ void DigiReco::interpolate(int itdc, int ibeg, int iend)
         int ibun = ibeg + isam_amp / nsbun;
         int tdc = isam_amp % nsbun;
         // Look for offset
-        auto orbit = mBCData[ibun].ir.orbit;
-        std::map<uint32_t, int>::iterator it = mOrbit.find(orbit);
-        if (it != mOrbit.end()) {
+        const float* ped = getPedestal(ibun);
+        if (ped) {
           // Subtract pedestal
-          auto& orbitdata = mOrbitData[it->second];
-          amp = orbitdata.asFloat(ich) - amp;
+          amp = ped[ich] - amp;
         } else {
           LOG(ERROR) << "Missing pedestal";
           amp = std::numeric_limits<float>::infinity();
@@ -768,12 +810,10 @@ void DigiReco::interpolate(int itdc, int ibeg, int iend)
       int ibun = ibeg + isam_amp / nsbun;
       int tdc = isam_amp % nsbun;
       // Look for offset
-      auto orbit = mBCData[ibun].ir.orbit;
-      std::map<uint32_t, int>::iterator it = mOrbit.find(orbit);
-      if (it != mOrbit.end()) {
+      const float* ped = getPedestal(ibun);
+      if (ped) {
         // Subtract pedestal
-        auto& orbitdata = mOrbitData[it->second];
-        amp = orbitdata.asFloat(ich) - amp;
+        amp = ped[ich] - amp;
       } else {
         LOG(ERROR) << "Missing pedestal";
         amp = std::numeric_limits<float>::infinity();
@@ -14,6 +14,7 @@
 /// \author julian.myrcha@cern.ch
 
 #include "EventVisualisationBase/FileWatcher.h"
+#include "EventVisualisationDataConverter/VisualisationEvent.h"
 #include "FairLogger.h"
 
 #include <list>
@@ -35,7 +36,7 @@ deque<string> FileWatcher::load(string path)
   LOG(INFO) << "FileWatcher::load(" << path << ")";
   deque<string> result;
   for (const auto& entry : std::filesystem::directory_iterator(path)) {
-    if (entry.path().extension() == ".json") {
+    if (entry.path().extension() == ".json" || entry.path().extension() == VisualisationEvent::sBinaryExtension) {
       result.push_back(entry.path().filename());
     }
   }
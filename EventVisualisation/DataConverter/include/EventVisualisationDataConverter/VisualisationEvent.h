@@ -22,6 +22,7 @@
 #include "EventVisualisationDataConverter/VisualisationCluster.h"
 #include <forward_list>
 #include <ctime>
+#include <iosfwd>
 
 namespace o2
 {
@@ -46,6 +47,20 @@ class VisualisationEvent
   void toFile(std::string fileName);
   static std::string fileNameIndexed(const std::string fileName, const int index);
 
+  /// Compact columnar binary representation of the tracks and clusters,
+  /// for the events too large to be exchanged efficiently as json.
+  /// Each column (track sources, track point counts, point coordinates,
+  /// cluster coordinates) is stored as a block, optionally compressed.
+  static constexpr const char* sBinaryExtension = ".evb";
+  // Writes the binary representation to the stream, column after column
+  void toBinary(std::ostream& out, bool compress = false) const;
+  // Reads the binary representation in memory, returns false if it is malformed
+  bool fromBinary(const char* data, size_t size);
+  void toBinaryFile(const std::string& fileName, bool compress = false) const;
+  // Reads the binary file via memory mapping
+  bool fromBinaryFile(const std::string& fileName);
+  static bool isBinaryFile(const std::string& fileName);
+
   //VisualisationEvent() {}
 
   /// constructor parametrisation (Value Object) for VisualisationEvent class
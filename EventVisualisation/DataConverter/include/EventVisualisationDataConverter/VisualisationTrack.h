@@ -47,6 +47,8 @@ class VisualisationTrack
   VisualisationTrack(rapidjson::Value& tree);
   // create JSON representation of the track
   rapidjson::Value jsonTree(rapidjson::Document::AllocatorType& allocator);
+  // create track from the columns of its binary representation
+  VisualisationTrack(ETrackSource source, const float* x, const float* y, const float* z, size_t count);
 
   /// constructor parametrisation (Value Object) for VisualisationTrack class
   ///
@@ -92,6 +94,8 @@ class VisualisationTrack
   int getCharge() const { return mCharge; }
   // PID (particle identification code) getter
   int getPID() const { return mPID; }
+  // Data source getter
+  ETrackSource getSource() const { return mSource; }
 
   size_t getPointCount() const { return mPolyX.size(); }
   std::array<double, 3> getPoint(size_t i) const { return std::array<double, 3>{mPolyX[i], mPolyY[i], mPolyZ[i]}; }
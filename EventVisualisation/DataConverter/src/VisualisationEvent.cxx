@@ -20,11 +20,22 @@
 #include "rapidjson/writer.h"
 #include "rapidjson/stringbuffer.h"
 
+#include <Compression.h>
+#include <RZip.h>
+
 #include <string>
 #include <sstream>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace std;
 using namespace rapidjson;
@@ -34,6 +45,116 @@ namespace o2
 namespace event_visualisation
 {
 
+namespace
+{
+/// Layout of the binary representation: the header is followed by the
+/// columns, each one in a block starting with a BinaryBlock and padded
+/// to 8 bytes, so that the uncompressed columns can be used in place.
+struct BinaryHeader {
+  char magic[4] = {'O', '2', 'V', 'E'};
+  uint32_t version = 1;
+  uint32_t nTracks = 0;
+  uint32_t nClusters = 0;
+  uint64_t nPoints = 0;
+};
+
+struct BinaryBlock {
+  uint64_t size = 0;       /// size of the column
+  uint64_t storedSize = 0; /// size stored in the block, == size if not compressed
+};
+
+/// ROOT compresses at most this many bytes per call
+constexpr size_t MaxZipBlockSize = 0xffffff;
+
+size_t padded(size_t size)
+{
+  return (size + 7) & ~size_t(7);
+}
+
+/// @return the size of the compressed column, 0 if it was not worth it
+size_t zipColumn(const char* source, size_t size, std::vector<char>& target)
+{
+  target.resize(size);
+  size_t written = 0;
+  for (size_t offset = 0; offset < size; offset += MaxZipBlockSize) {
+    int blockSize = std::min(size - offset, MaxZipBlockSize);
+    int available = std::min(size - written, size_t{INT_MAX});
+    int compressed = 0;
+    R__zipMultipleAlgorithm(1, &blockSize, const_cast<char*>(source + offset), &available, target.data() + written, &compressed,
+                            ROOT::RCompressionSetting::EAlgorithm::kZSTD);
+    if (compressed <= 0) {
+      return 0;
+    }
+    written += compressed;
+  }
+  return written < size ? written : 0;
+}
+
+bool unzipColumn(const char* source, size_t storedSize, char* target, size_t size)
+{
+  auto* in = reinterpret_cast<unsigned char*>(const_cast<char*>(source));
+  auto* out = reinterpret_cast<unsigned char*>(target);
+  size_t read = 0, written = 0;
+  while (read < storedSize) {
+    int blockSize = 0, unzippedSize = 0, unzipped = 0;
+    if (storedSize - read < 9 || R__unzip_header(&blockSize, in + read, &unzippedSize) != 0 ||
+        blockSize <= 0 || (size_t)blockSize > storedSize - read || unzippedSize <= 0 || (size_t)unzippedSize > size - written) {
+      return false;
+    }
+    R__unzip(&blockSize, in + read, &unzippedSize, out + written, &unzipped);
+    if (unzipped != unzippedSize) {
+      return false;
+    }
+    read += blockSize;
+    written += unzipped;
+  }
+  return written == size;
+}
+
+template <typename T>
+void writeColumn(std::ostream& out, const std::vector<T>& column, bool compress, std::vector<char>& buffer)
+{
+  BinaryBlock block;
+  block.size = column.size() * sizeof(T);
+  const char* data = reinterpret_cast<const char*>(column.data());
+  size_t zipped = compress ? zipColumn(data, block.size, buffer) : 0;
+  if (zipped) {
+    data = buffer.data();
+  }
+  block.storedSize = zipped ? zipped : block.size;
+  out.write(reinterpret_cast<const char*>(&block), sizeof(block));
+  out.write(data, block.storedSize);
+  static const char padding[8] = {0};
+  out.write(padding, padded(block.storedSize) - block.storedSize);
+}
+
+/// Reads the next column of n elements, as a pointer in the data when it
+/// is stored uncompressed, or in the buffer otherwise
+template <typename T>
+const T* readColumn(const char* data, size_t size, size_t& offset, size_t n, std::vector<char>& buffer)
+{
+  BinaryBlock block;
+  if (offset > size || size - offset < sizeof(block)) {
+    return nullptr;
+  }
+  std::memcpy(&block, data + offset, sizeof(block));
+  offset += sizeof(block);
+  if (block.size != n * sizeof(T) || block.storedSize > size - offset) {
+    return nullptr;
+  }
+  const char* column = data + offset;
+  offset += padded(block.storedSize);
+  if (block.storedSize != block.size) {
+    buffer.resize(padded(block.size));
+    if (!unzipColumn(column, block.storedSize, buffer.data(), block.size)) {
+      return nullptr;
+    }
+    column = buffer.data();
+  }
+  return reinterpret_cast<const T*>(column);
+}
+} // namespace
+
 /// Ctor -- set the minimalistic event up
 VisualisationEvent::VisualisationEvent(VisualisationEventVO vo)
 {
@@ -120,8 +241,142 @@ std::string VisualisationEvent::fileNameIndexed(const std::string fileName, cons
   return buffer.str();
 }
 
+void VisualisationEvent::toBinary(std::ostream& out, bool compress) const
+{
+  BinaryHeader header;
+  header.nTracks = mTracks.size();
+  header.nClusters = mClusters.size();
+  for (const auto& track : mTracks) {
+    header.nPoints += track.getPointCount();
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  std::vector<char> buffer;
+  {
+    std::vector<int32_t> sources;
+    std::vector<uint32_t> counts;
+    sources.reserve(header.nTracks);
+    counts.reserve(header.nTracks);
+    for (const auto& track : mTracks) {
+      sources.push_back(track.getSource());
+      counts.push_back(track.getPointCount());
+    }
+    writeColumn(out, sources, compress, buffer);
+    writeColumn(out, counts, compress, buffer);
+  }
+  // points as float, as in json
+  std::vector<float> column;
+  column.reserve(std::max<size_t>(header.nPoints, header.nClusters));
+  for (int dim = 0; dim < 3; dim++) {
+    column.clear();
+    for (const auto& track : mTracks) {
+      for (size_t i = 0; i < track.getPointCount(); i++) {
+        column.push_back(track.getPoint(i)[dim]);
+      }
+    }
+    writeColumn(out, column, compress, buffer);
+  }
+  for (int dim = 0; dim < 3; dim++) {
+    column.clear();
+    for (const auto& cluster : mClusters) {
+      column.push_back(dim == 0 ? cluster.X() : (dim == 1 ? cluster.Y() : cluster.Z()));
+    }
+    writeColumn(out, column, compress, buffer);
+  }
+}
+
+bool VisualisationEvent::fromBinary(const char* data, size_t size)
+{
+  mTracks.clear();
+  mClusters.clear();
+
+  const BinaryHeader reference;
+  BinaryHeader header;
+  if (size < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, reference.magic, sizeof(header.magic)) != 0 || header.version != reference.version) {
+    return false;
+  }
+  size_t offset = sizeof(header);
+  std::vector<char> sourcesBuffer, countsBuffer, buffers[3];
+  auto sources = readColumn<int32_t>(data, size, offset, header.nTracks, sourcesBuffer);
+  auto counts = readColumn<uint32_t>(data, size, offset, header.nTracks, countsBuffer);
+  const float* xyz[3];
+  for (int dim = 0; dim < 3; dim++) {
+    xyz[dim] = readColumn<float>(data, size, offset, header.nPoints, buffers[dim]);
+    if (!xyz[dim]) {
+      return false;
+    }
+  }
+  if (!sources || !counts) {
+    return false;
+  }
+  mTracks.reserve(header.nTracks);
+  uint64_t first = 0;
+  for (uint32_t i = 0; i < header.nTracks; i++) {
+    if (counts[i] > header.nPoints - first) {
+      mTracks.clear();
+      return false;
+    }
+    mTracks.emplace_back((ETrackSource)sources[i], xyz[0] + first, xyz[1] + first, xyz[2] + first, counts[i]);
+    first += counts[i];
+  }
+  for (int dim = 0; dim < 3; dim++) {
+    xyz[dim] = readColumn<float>(data, size, offset, header.nClusters, buffers[dim]);
+    if (!xyz[dim]) {
+      mTracks.clear();
+      return false;
+    }
+  }
+  mClusters.reserve(header.nClusters);
+  for (uint32_t i = 0; i < header.nClusters; i++) {
+    double coordinates[3] = {xyz[0][i], xyz[1][i], xyz[2][i]};
+    mClusters.emplace_back(coordinates);
+  }
+  return true;
+}
+
+void VisualisationEvent::toBinaryFile(const std::string& fileName, bool compress) const
+{
+  std::ofstream out(fileName, std::ios::binary);
+  toBinary(out, compress);
+  out.close();
+}
+
+bool VisualisationEvent::fromBinaryFile(const std::string& fileName)
+{
+  int fd = open(fileName.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    return false;
+  }
+  size_t size = st.st_size;
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // the mapping stays valid
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  bool ok = fromBinary(static_cast<const char*>(data), size);
+  munmap(data, size);
+  return ok;
+}
+
+bool VisualisationEvent::isBinaryFile(const std::string& fileName)
+{
+  const std::string extension = sBinaryExtension;
+  return fileName.size() >= extension.size() && fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0;
+}
+
 bool VisualisationEvent::fromFile(std::string fileName)
 {
+  if (isBinaryFile(fileName)) {
+    return fromBinaryFile(fileName);
+  }
   if (FILE* file = fopen(fileName.c_str(), "r")) {
     fclose(file); // file exists
   } else {
@@ -113,6 +113,14 @@ VisualisationTrack::VisualisationTrack(rapidjson::Value& tree)
   }
 }
 
+VisualisationTrack::VisualisationTrack(ETrackSource source, const float* x, const float* y, const float* z, size_t count)
+{
+  this->mSource = source;
+  mPolyX.assign(x, x + count);
+  mPolyY.assign(y, y + count);
+  mPolyZ.assign(z, z + count);
+}
+
 rapidjson::Value VisualisationTrack::jsonTree(rapidjson::Document::AllocatorType& allocator)
 {
   rapidjson::Value tree(rapidjson::kObjectType);
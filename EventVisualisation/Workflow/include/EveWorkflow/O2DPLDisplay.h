@@ -46,8 +46,9 @@ class O2DPLDisplaySpec : public o2::framework::Task
   O2DPLDisplaySpec(bool useMC, o2::dataformats::GlobalTrackID::mask_t trkMask,
                    o2::dataformats::GlobalTrackID::mask_t clMask,
                    std::shared_ptr<o2::globaltracking::DataRequest> dataRequest, std::string jsonPath,
-                   std::chrono::milliseconds timeInterval, int numberOfFiles, int numberOfTracks, bool eveHostNameMatch)
-    : mUseMC(useMC), mTrkMask(trkMask), mClMask(clMask), mDataRequest(dataRequest), mJsonPath(jsonPath), mTimeInteval(timeInterval), mNumberOfFiles(numberOfFiles), mNumberOfTracks(numberOfTracks), mEveHostNameMatch(eveHostNameMatch)
+                   std::chrono::milliseconds timeInterval, int numberOfFiles, int numberOfTracks, bool eveHostNameMatch,
+                   bool binaryOutput = false, bool compressOutput = false)
+    : mUseMC(useMC), mTrkMask(trkMask), mClMask(clMask), mDataRequest(dataRequest), mJsonPath(jsonPath), mTimeInteval(timeInterval), mNumberOfFiles(numberOfFiles), mNumberOfTracks(numberOfTracks), mEveHostNameMatch(eveHostNameMatch), mBinaryOutput(binaryOutput), mCompressOutput(compressOutput)
   {
     this->mTimeStamp = std::chrono::high_resolution_clock::now() - timeInterval; // first run meets condition
   }
@@ -63,6 +64,8 @@ class O2DPLDisplaySpec : public o2::framework::Task
   std::chrono::milliseconds mTimeInteval; // minimal interval between files in miliseconds
   int mNumberOfFiles;                     // maximun number of files in folder - newer replaces older
   int mNumberOfTracks;                    // maximun number of track in single file (0 means no limit)
+  bool mBinaryOutput;                     // store the events in the binary format rather than json
+  bool mCompressOutput;                   // compress the columns of the binary files
   std::chrono::time_point<std::chrono::high_resolution_clock> mTimeStamp;
 
   o2::dataformats::GlobalTrackID::mask_t mTrkMask;
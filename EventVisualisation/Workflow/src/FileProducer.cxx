@@ -14,6 +14,7 @@
 /// \author julian.myrcha@cern.ch
 
 #include "EveWorkflow/FileProducer.h"
+#include "EventVisualisationDataConverter/VisualisationEvent.h"
 
 #include <deque>
 #include <iostream>
@@ -37,7 +38,7 @@ std::deque<std::string> FileProducer::load(const std::string& path)
   deque<string> result;
 
   for (const auto& entry : std::filesystem::directory_iterator(path)) {
-    if (entry.path().extension() == ".json") {
+    if (entry.path().extension() == ".json" || entry.path().extension() == VisualisationEvent::sBinaryExtension) {
       result.push_back(entry.path().filename());
     }
   }
@@ -52,6 +52,7 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
     {"number-of_files", VariantType::Int, 300, {"maximum number of json files in folder"}},
     {"number-of_tracks", VariantType::Int, -1, {"maximum number of track stored in json file (-1 means no limit)"}},
     {"time-interval", VariantType::Int, 5000, {"time interval in milliseconds between stored files"}},
+    {"output-format", VariantType::String, "json", {"format of the stored files: json, binary or binary-compressed"}},
     {"enable-mc", o2::framework::VariantType::Bool, false, {"enable visualization of MC data"}},
     {"disable-mc", o2::framework::VariantType::Bool, false, {"disable visualization of MC data"}}, // for compatibility, overrides enable-mc
     {"display-clusters", VariantType::String, "ITS,TPC,TRD,TOF", {"comma-separated list of clusters to display"}},
@@ -183,8 +184,13 @@ void O2DPLDisplaySpec::run(ProcessingContext& pc)
     }
   }
 
-  FileProducer producer(this->mJsonPath, this->mNumberOfFiles);
-  vEvent.toFile(producer.newFileName());
+  if (this->mBinaryOutput) {
+    FileProducer producer(this->mJsonPath, this->mNumberOfFiles, std::string("tracks{}") + VisualisationEvent::sBinaryExtension);
+    vEvent.toBinaryFile(producer.newFileName(), this->mCompressOutput);
+  } else {
+    FileProducer producer(this->mJsonPath, this->mNumberOfFiles);
+    vEvent.toFile(producer.newFileName());
+  }
 }
 
 void O2DPLDisplaySpec::endOfStream(EndOfStreamContext& ec)
@@ -206,6 +212,12 @@ WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
   std::chrono::milliseconds timeInterval(cfgc.options().get<int>("time-interval"));
   int numberOfFiles = cfgc.options().get<int>("number-of_files");
   int numberOfTracks = cfgc.options().get<int>("number-of_tracks");
+  auto outputFormat = cfgc.options().get<std::string>("output-format");
+  if (outputFormat != "json" && outputFormat != "binary" && outputFormat != "binary-compressed") {
+    throw std::runtime_error("Unknown output-format " + outputFormat);
+  }
+  bool binaryOutput = outputFormat != "json";
+  bool compressOutput = outputFormat == "binary-compressed";
 
   GlobalTrackID::mask_t srcTrk = GlobalTrackID::getSourcesMask(cfgc.options().get<std::string>("display-tracks"));
   GlobalTrackID::mask_t srcCl = GlobalTrackID::getSourcesMask(cfgc.options().get<std::string>("display-clusters"));
@@ -224,7 +236,7 @@ WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
     "o2-eve-display",
     dataRequest->inputs,
     {},
-    AlgorithmSpec{adaptFromTask<O2DPLDisplaySpec>(useMC, srcTrk, srcCl, dataRequest, jsonFolder, timeInterval, numberOfFiles, numberOfTracks, eveHostNameMatch)}});
+    AlgorithmSpec{adaptFromTask<O2DPLDisplaySpec>(useMC, srcTrk, srcCl, dataRequest, jsonFolder, timeInterval, numberOfFiles, numberOfTracks, eveHostNameMatch, binaryOutput, compressOutput)}});
 
   return std::move(specs);
 }
@@ -32,6 +32,11 @@
 #include <TGrid.h>
 #include <TFile.h>
 #include <TTreeCache.h>
+#include <TTreeCacheUnzip.h>
+#include <TTreeReader.h>
+#include <TTreeReaderValue.h>
+#include <TLeaf.h>
+#include <TROOT.h>
 
 #include <arrow/ipc/reader.h>
 #include <arrow/ipc/writer.h>
@@ -39,6 +44,10 @@
 #include <arrow/table.h>
 #include <arrow/util/key_value_metadata.h>
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <sstream>
 #include <thread>
 
 using namespace o2;
@@ -102,6 +111,121 @@ std::vector<std::string> getColumnNames(header::DataHeader dh)
   return std::vector<std::string>({});
 }
 
+// add the branches of tree to t2t and fill the table, tree is deleted
+void readTree(TreeToTable& t2t, TTree* tree, header::DataHeader const& dh, size_t& sizeCompressed, size_t& sizeUncompressed)
+{
+  auto colnames = getColumnNames(dh);
+  t2t.setLabel(tree->GetName());
+  if (colnames.size() == 0) {
+    sizeCompressed += tree->GetZipBytes();
+    sizeUncompressed += tree->GetTotBytes();
+    t2t.addAllColumns(tree);
+  } else {
+    for (auto& colname : colnames) {
+      TBranch* branch = tree->GetBranch(colname.c_str());
+      sizeCompressed += branch->GetZipBytes("*");
+      sizeUncompressed += branch->GetTotBytes("*");
+      t2t.addColumn(colname.c_str());
+    }
+  }
+  t2t.fill(tree);
+  delete tree;
+}
+
+// get the tree of a time frame, or the table if the input file is in the Arrow format
+bool getInput(DataInputDirector& didir, header::DataHeader const& dh, int counter, int numTF, TTree*& tree, std::shared_ptr<arrow::Table>& table)
+{
+  if (didir.isArrowFile(dh, counter)) {
+    table = didir.getArrowTable(dh, counter, numTF);
+    return table != nullptr;
+  }
+  tree = didir.getDataTree(dh, counter, numTF);
+  return tree != nullptr;
+}
+
+// tables of a time frame which are read while the previous time frame is being processed
+struct PrefetchedTimeFrame {
+  int fileCounter = -1;
+  int numTF = -1;
+  std::vector<std::unique_ptr<TreeToTable>> tables; // one per requested table, nullptr for the tables of other readers
+  size_t sizeCompressed = 0;
+  size_t sizeUncompressed = 0;
+
+  bool matches(int fcnt, int ntf) const
+  {
+    return fileCounter == fcnt && numTF == ntf;
+  }
+
+  void clear()
+  {
+    tables.clear();
+    fileCounter = -1;
+    numTF = -1;
+  }
+};
+
+// selective reading: the time frames are read only if at least one of their collisions passed one of the
+// event filters, which is decided reading only the decision columns of the tree of the filter table
+struct TimeFrameFilter {
+  std::string treeName;             // tree of the filter table, e.g. O2nucleifilters, empty if all time frames are read
+  std::vector<std::string> columns; // decision columns, all the boolean branches of the tree if empty
+  std::atomic<size_t> nSkipped{0};  // time frames skipped
+  std::atomic<size_t> nSelected{0}; // time frames selected, also in the background
+
+  // the configuration is <tree name>[:<column>,<column>,...]
+  TimeFrameFilter(std::string const& config)
+  {
+    auto pos = config.find(':');
+    treeName = config.substr(0, pos);
+    if (pos != std::string::npos) {
+      std::stringstream ss(config.substr(pos + 1));
+      std::string column;
+      while (std::getline(ss, column, ',')) {
+        if (!column.empty()) {
+          columns.push_back(column);
+        }
+      }
+    }
+  }
+
+  bool isActive() const { return !treeName.empty(); }
+
+  // true if any decision of the time frame is set, or if its filter table is missing
+  bool isSelected(FileAndFolder const& fileAndFolder)
+  {
+    auto name = fileAndFolder.folderName + "/" + treeName;
+    std::unique_ptr<TTree> tree((TTree*)fileAndFolder.file->Get(name.c_str()));
+    if (!tree) {
+      LOGP(WARNING, "Filter table {} not found in {}, the time frame is read", name, fileAndFolder.file->GetName());
+      return true;
+    }
+    TTreeReader reader(tree.get());
+    std::vector<std::unique_ptr<TTreeReaderValue<bool>>> decisions;
+    if (columns.empty()) {
+      auto branches = tree->GetListOfBranches();
+      for (int ib = 0; ib < branches->GetEntries(); ++ib) {
+        auto branch = (TBranch*)branches->At(ib);
+        auto leaf = branch->GetLeaf(branch->GetName());
+        if (leaf && std::string_view(leaf->GetTypeName()) == "Bool_t") {
+          decisions.emplace_back(std::make_unique<TTreeReaderValue<bool>>(reader, branch->GetName()));
+        }
+      }
+    } else {
+      for (auto& column : columns) {
+        decisions.emplace_back(std::make_unique<TTreeReaderValue<bool>>(reader, column.c_str()));
+      }
+    }
+    while (reader.Next()) {
+      for (auto& decision : decisions) {
+        if (**decision) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+};
+
 using o2::monitoring::Metric;
 using o2::monitoring::Monitoring;
 using o2::monitoring::tags::Key;
@@ -180,6 +304,27 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
     // get the run time watchdog
     auto* watchdog = new RuntimeWatchdog(options.get<int64_t>("time-limit"));
 
+    // decompress the baskets with a pool of threads
+    auto nThreads = options.get<int>("aod-reader-threads");
+    if (nThreads > 0) {
+      LOGP(INFO, "Decompressing the baskets with {} threads", nThreads);
+      ROOT::EnableImplicitMT(nThreads);
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+    }
+
+    // read the next time frame while the current one is processed
+    auto prefetch = options.get<bool>("aod-prefetch");
+    if (prefetch) {
+      ROOT::EnableThreadSafety();
+    }
+    auto prefetched = std::make_shared<std::future<PrefetchedTimeFrame>>();
+
+    // read only the time frames with selected collisions
+    auto filter = std::make_shared<TimeFrameFilter>(options.get<std::string>("aod-reader-filter"));
+    if (filter->isActive()) {
+      LOGP(INFO, "Reading only the time frames with collisions selected by {}", options.get<std::string>("aod-reader-filter"));
+    }
+
     // selected the TFN input and
     // create list of requested tables
     header::DataHeader TFNumberHeader;
@@ -201,6 +346,9 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
                            fileCounter,
                            numTF,
                            watchdog,
+                           prefetch,
+                           prefetched,
+                           filter,
                            didir](Monitoring& monitoring, DataAllocator& outputs, ControlService& control, DeviceSpec const& device) {
       // Each parallel reader device.inputTimesliceId reads the files fileCounter*device.maxInputTimeslices+device.inputTimesliceId
       // the TF to read is numTF
@@ -224,6 +372,16 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       static auto currentFileStartedAt = uv_hrtime();
       static uint64_t currentFileIOTime = 0;
 
+      // wait for the time frame read in the background, it is used only if it is the one to be read now
+      PrefetchedTimeFrame next;
+      if (prefetched->valid()) {
+        next = prefetched->get();
+      }
+      bool usePrefetched = next.matches(fcnt, ntf);
+      if (!usePrefetched) {
+        next.clear();
+      }
+
       // check if RuntimeLimit is reached
       if (!watchdog->update()) {
         LOGP(INFO, "Run time exceeds run time limit of {} seconds. Exiting gracefully...", watchdog->runTimeLimit);
@@ -238,7 +396,36 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
 
       auto ioStart = uv_hrtime();
 
-      for (auto& route : requestedTables) {
+      // skip the time frames w/o selected collisions, moving to the next file at the end of the current one,
+      // the end of the input is then handled as usual when the tables are read
+      if (filter->isActive() && !usePrefetched) {
+        auto route = std::find_if(requestedTables.begin(), requestedTables.end(), [&device](OutputRoute const& r) { return (device.inputTimesliceId % r.maxTimeslices) == r.timeslice; });
+        if (route != requestedTables.end()) {
+          auto concrete = DataSpecUtils::asConcreteDataMatcher(route->matcher);
+          auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
+          while (!didir->atEnd(fcnt) && !didir->isArrowFile(dh, fcnt)) {
+            auto fileAndFolder = didir->getFileFolder(dh, fcnt, ntf);
+            if (fileAndFolder.file) {
+              if (filter->isSelected(fileAndFolder)) {
+                filter->nSelected++;
+                break;
+              }
+              filter->nSkipped++;
+              ntf++;
+              continue;
+            }
+            dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
+            currentFile = nullptr;
+            currentFileStartedAt = uv_hrtime();
+            currentFileIOTime = 0;
+            fcnt += device.maxInputTimeslices;
+            ntf = 0;
+          }
+        }
+      }
+
+      for (size_t ir = 0; ir < requestedTables.size(); ++ir) {
+        auto& route = requestedTables[ir];
         if ((device.inputTimesliceId % route.maxTimeslices) != route.timeslice) {
           continue;
         }
@@ -247,9 +434,10 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
         auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
 
-        // create a TreeToTable object
-        TTree* tr = didir->getDataTree(dh, fcnt, ntf);
-        if (!tr) {
+        // get the tree or, for Arrow files, the table
+        TTree* tr = nullptr;
+        std::shared_ptr<arrow::Table> table;
+        if (!usePrefetched && !getInput(*didir, dh, fcnt, ntf, tr, table)) {
           if (first) {
             // dump metrics of file which is done for reading
             dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
@@ -261,6 +449,9 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
             fcnt += device.maxInputTimeslices;
             if (didir->atEnd(fcnt)) {
               LOGP(INFO, "No input files left to read for reader {}!", device.inputTimesliceId);
+              if (filter->isActive()) {
+                LOGP(INFO, "{} time frames read and {} skipped by the filter {}", filter->nSelected.load(), filter->nSkipped.load(), filter->treeName);
+              }
               didir->closeInputFiles();
               control.endOfStream();
               control.readyToQuit(QuitRequest::Me);
@@ -268,8 +459,7 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
             }
             // get first folder of next file
             ntf = 0;
-            tr = didir->getDataTree(dh, fcnt, ntf);
-            if (!tr) {
+            if (!getInput(*didir, dh, fcnt, ntf, tr, table)) {
               LOGP(FATAL, "Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin, fcnt, ntf);
               throw std::runtime_error("Processing is stopped!");
             }
@@ -287,26 +477,17 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
 
         // create table output
         auto o = Output(dh);
-        auto& t2t = outputs.make<TreeToTable>(o);
-
-        // add branches to read
-        // fill the table
-        auto colnames = getColumnNames(dh);
-        t2t.setLabel(tr->GetName());
-        if (colnames.size() == 0) {
-          totalSizeCompressed += tr->GetZipBytes();
-          totalSizeUncompressed += tr->GetTotBytes();
-          t2t.addAllColumns(tr);
+        if (usePrefetched) {
+          outputs.adopt(o, next.tables[ir].release());
+        } else if (table) {
+          // the memory mapped table is sent without conversion
+          outputs.adopt(o, table);
         } else {
-          for (auto& colname : colnames) {
-            TBranch* branch = tr->GetBranch(colname.c_str());
-            totalSizeCompressed += branch->GetZipBytes("*");
-            totalSizeUncompressed += branch->GetTotBytes("*");
-            t2t.addColumn(colname.c_str());
-          }
+          // add branches to read
+          // fill the table
+          auto& t2t = outputs.make<TreeToTable>(o);
+          readTree(t2t, tr, dh, totalSizeCompressed, totalSizeUncompressed);
         }
-        t2t.fill(tr);
-        delete tr;
 
         // needed for metrics dumping (upon next file read, or terminate due to watchdog)
         if (currentFile == nullptr) {
@@ -316,6 +497,10 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
 
         first = false;
       }
+      if (usePrefetched) {
+        totalSizeCompressed += next.sizeCompressed;
+        totalSizeUncompressed += next.sizeUncompressed;
+      }
       monitoring.send(Metric{(uint64_t)ntf, "tf-sent"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
       monitoring.send(Metric{(uint64_t)totalSizeUncompressed / 1000, "aod-bytes-read-uncompressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
       monitoring.send(Metric{(uint64_t)totalSizeCompressed / 1000, "aod-bytes-read-compressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
@@ -324,6 +509,44 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       *fileCounter = (fcnt - device.inputTimesliceId) / device.maxInputTimeslices;
       *numTF = ntf;
       currentFileIOTime += (uv_hrtime() - ioStart);
+
+      // read the tables of the next time frame of the same file in the background,
+      // the time frame is discarded if any of its tables is missing
+      if (prefetch) {
+        auto inputTimesliceId = device.inputTimesliceId;
+        *prefetched = std::async(std::launch::async, [requestedTables, didir, filter, inputTimesliceId, fcnt, ntf]() {
+          PrefetchedTimeFrame tf;
+          tf.fileCounter = fcnt;
+          tf.numTF = ntf + 1;
+          tf.tables.resize(requestedTables.size());
+          bool checkFilter = filter->isActive();
+          for (size_t ir = 0; ir < requestedTables.size(); ++ir) {
+            auto& route = requestedTables[ir];
+            if ((inputTimesliceId % route.maxTimeslices) != route.timeslice) {
+              continue;
+            }
+            auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
+            auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
+            if (checkFilter) { // a time frame to skip is not prefetched, it is skipped by the next call
+              auto fileAndFolder = didir->getFileFolder(dh, fcnt, ntf + 1);
+              if (!fileAndFolder.file || !filter->isSelected(fileAndFolder)) {
+                tf.clear();
+                break;
+              }
+              filter->nSelected++;
+              checkFilter = false;
+            }
+            TTree* tr = didir->getDataTree(dh, fcnt, ntf + 1);
+            if (!tr) {
+              tf.clear();
+              break;
+            }
+            tf.tables[ir] = std::make_unique<TreeToTable>();
+            readTree(*tf.tables[ir], tr, dh, tf.sizeCompressed, tf.sizeUncompressed);
+          }
+          return tf;
+        });
+      }
     });
   })};
 
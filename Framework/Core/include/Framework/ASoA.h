@@ -26,6 +26,7 @@
 #include <arrow/compute/kernel.h>
 #include <arrow/compute/api_aggregate.h>
 #include <gandiva/selection_vector.h>
+#include <gsl/span>
 #include <cassert>
 #include <fmt/format.h>
 #include <typeinfo>
@@ -149,6 +150,8 @@ struct Flat {
 /// FIXME: the ChunkingPolicy for now is fixed to Flat and is a mere boolean
 /// which is used to switch off slow "chunking aware" parts. This is ok for
 /// now, but most likely we should move the whole chunk navigation logic there.
+/// Columns made of a single chunk, the usual case for the tables which are read,
+/// are detected when the iterator is bound and take the Flat path as well.
 template <typename T, typename ChunkingPolicy = Chunked>
 class ColumnIterator : ChunkingPolicy
 {
@@ -163,7 +166,8 @@ class ColumnIterator : ChunkingPolicy
     : mColumn{column},
       mCurrentPos{nullptr},
       mFirstIndex{0},
-      mCurrentChunk{0}
+      mCurrentChunk{0},
+      mSingleChunk{column->num_chunks() == 1}
   {
     auto array = getCurrentArray();
     mCurrent = reinterpret_cast<T const*>(array->values()->data()) + array->offset();
@@ -226,7 +230,7 @@ class ColumnIterator : ChunkingPolicy
   decltype(auto) operator*() const
   {
     if constexpr (ChunkingPolicy::chunked) {
-      if (O2_BUILTIN_UNLIKELY(((mCurrent + (*mCurrentPos >> SCALE_FACTOR)) >= mLast))) {
+      if (!mSingleChunk && O2_BUILTIN_UNLIKELY(((mCurrent + (*mCurrentPos >> SCALE_FACTOR)) >= mLast))) {
         nextChunk();
       }
     }
@@ -245,7 +249,7 @@ class ColumnIterator : ChunkingPolicy
   {
     // If we get outside range of the current chunk, go to the next.
     if constexpr (ChunkingPolicy::chunked) {
-      while (O2_BUILTIN_UNLIKELY((mCurrent + (*mCurrentPos >> SCALE_FACTOR)) >= mLast)) {
+      while (!mSingleChunk && O2_BUILTIN_UNLIKELY((mCurrent + (*mCurrentPos >> SCALE_FACTOR)) >= mLast)) {
         nextChunk();
       }
     }
@@ -256,7 +260,7 @@ class ColumnIterator : ChunkingPolicy
   ColumnIterator<T>& checkNextChunk()
   {
     if constexpr (ChunkingPolicy::chunked) {
-      if (O2_BUILTIN_LIKELY((mCurrent + (*mCurrentPos >> SCALE_FACTOR)) <= mLast)) {
+      if (mSingleChunk || O2_BUILTIN_LIKELY((mCurrent + (*mCurrentPos >> SCALE_FACTOR)) <= mLast)) {
         return *this;
       }
       nextChunk();
@@ -270,6 +274,7 @@ class ColumnIterator : ChunkingPolicy
   arrow::ChunkedArray const* mColumn;
   mutable int mFirstIndex;
   mutable int mCurrentChunk;
+  bool mSingleChunk = false;
 
  private:
   /// get pointer to mCurrentChunk chunk
@@ -1111,6 +1116,22 @@ class Table
     return size();
   }
 
+  /// Call f(gsl::span<Cs::type const>...) for consecutive ranges of rows in which
+  /// all the requested columns are contiguous in memory, so that the loops over
+  /// them can be vectorized. For tables made of a single chunk f is called once.
+  /// Usage:
+  ///   tracks.for_each_batch<aod::track::Pt, aod::track::Eta>([&](auto pt, auto eta) {
+  ///     for (size_t i = 0; i < pt.size(); ++i) { ... }
+  ///   });
+  template <typename... Cs, typename F>
+  void for_each_batch(F&& f) const
+  {
+    static_assert(sizeof...(Cs) > 0, "At least one column is required");
+    static_assert((framework::has_type_v<Cs, persistent_columns_t> && ...), "Only the persistent columns of the table can be provided as batches");
+    static_assert((... && (std::is_arithmetic_v<typename Cs::type> && !std::is_same_v<typename Cs::type, bool>)), "Only columns of arithmetic types other than bool can be provided as batches");
+    doForEachBatch<Cs...>(std::forward<F>(f), std::index_sequence_for<Cs...>{});
+  }
+
   /// Bind the columns which refer to other tables
   /// to the associated tables.
   template <typename... TA>
@@ -1175,6 +1196,34 @@ class Table
   /// Offset of the table within a larger table.
   uint64_t mOffset;
 
+  template <typename... Cs, typename F, size_t... Is>
+  void doForEachBatch(F&& f, std::index_sequence<Is...>) const
+  {
+    constexpr size_t N = sizeof...(Cs);
+    arrow::ChunkedArray* columns[N] = {getIndexFromLabel(mTable.get(), Cs::columnLabel())...};
+    // per column, the current chunk and the position inside it
+    int chunks[N] = {};
+    int64_t positions[N] = {};
+    const int64_t nRows = size();
+    for (int64_t row = 0; row < nRows;) {
+      int64_t length = nRows - row;
+      for (size_t ci = 0; ci < N; ++ci) {
+        while (positions[ci] == columns[ci]->chunk(chunks[ci])->length()) {
+          ++chunks[ci];
+          positions[ci] = 0;
+        }
+        length = std::min(length, columns[ci]->chunk(chunks[ci])->length() - positions[ci]);
+      }
+      f(gsl::span<typename Cs::type const>{
+        std::static_pointer_cast<arrow_array_for_t<typename Cs::type>>(columns[Is]->chunk(chunks[Is]))->raw_values() + positions[Is],
+        static_cast<size_t>(length)}...);
+      for (size_t ci = 0; ci < N; ++ci) {
+        positions[ci] += length;
+      }
+      row += length;
+    }
+  }
+
  private:
   template <typename T>
   arrow::ChunkedArray* lookupColumn()
@@ -1923,6 +1972,10 @@ class FilteredPolicy : public T
   using iterator = decltype(make_it<FilteredPolicy<T>>(originals{}));
   using const_iterator = iterator;
 
+  /// The batches would ignore the selection, iterate over the filtered table instead
+  template <typename... Cs, typename F>
+  void for_each_batch(F&& f) const = delete;
+
   FilteredPolicy(std::vector<std::shared_ptr<arrow::Table>>&& tables, SelectionVector&& selection, uint64_t offset = 0)
     : T{std::move(tables), offset},
       mSelectedRows{std::forward<SelectionVector>(selection)}
@@ -1939,9 +1992,7 @@ class FilteredPolicy : public T
 
   FilteredPolicy(std::vector<std::shared_ptr<arrow::Table>>&& tables, gandiva::NodePtr const& tree, uint64_t offset = 0)
     : T{std::move(tables), offset},
-      mSelectedRows{copySelection(framework::expressions::createSelection(this->asArrowTable(),
-                                                                          framework::expressions::createFilter(this->asArrowTable()->schema(),
-                                                                                                               framework::expressions::makeCondition(tree))))}
+      mSelectedRows{copySelection(framework::expressions::createSelection(this->asArrowTable(), tree))}
   {
     resetRanges();
   }
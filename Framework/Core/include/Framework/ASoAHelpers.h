@@ -14,9 +14,11 @@
 
 #include "Framework/ASoA.h"
 #include "Framework/Kernels.h"
+#include "Framework/GroupingIndexCache.h"
 #include "Framework/RuntimeError.h"
 #include <arrow/table.h>
 
+#include <cstring>
 #include <iterator>
 #include <tuple>
 #include <utility>
@@ -102,29 +104,53 @@ std::vector<std::pair<uint64_t, uint64_t>> doGroupTable(const std::shared_ptr<ar
   return groupedIndices;
 }
 
+// Grouped table indices shared by the copies of a combinations policy,
+// so that copying the combinations iterators does not copy the indices
+struct GroupedIndices {
+  using IndicesType = std::vector<std::pair<uint64_t, uint64_t>>;
+
+  GroupedIndices() : mIndices(std::make_shared<IndicesType const>()) {}
+  GroupedIndices(std::shared_ptr<IndicesType const> indices) : mIndices(std::move(indices)) {}
+
+  auto begin() const { return mIndices->begin(); }
+  auto end() const { return mIndices->end(); }
+  auto size() const { return mIndices->size(); }
+  auto const& operator[](size_t i) const { return (*mIndices)[i]; }
+
+  std::shared_ptr<IndicesType const> mIndices;
+};
+
+// The grouping of a table is computed once per dataframe
+// and reused by all the combinations of the same table
 template <typename T, typename T2>
-auto groupTable(const T& table, const std::string& categoryColumnName, int minCatSize, const T2& outsider)
+GroupedIndices groupTable(const T& table, const std::string& categoryColumnName, int minCatSize, const T2& outsider)
 {
+  static_assert(sizeof(T2) <= sizeof(uint64_t), "Combinations: outsider value must fit in 64 bits");
+  uint64_t outsiderBits = 0;
+  std::memcpy(&outsiderBits, &outsider, sizeof(T2));
+
   auto arrowTable = table.asArrowTable();
-  auto columnIndex = arrowTable->schema()->GetFieldIndex(categoryColumnName);
-  auto dataType = arrowTable->column(columnIndex)->type();
-  if (dataType->id() == arrow::Type::UINT64) {
-    return doGroupTable<uint64_t, arrow::UInt64Array>(arrowTable, categoryColumnName, minCatSize, outsider);
-  }
-  if (dataType->id() == arrow::Type::INT64) {
-    return doGroupTable<int64_t, arrow::Int64Array>(arrowTable, categoryColumnName, minCatSize, outsider);
-  }
-  if (dataType->id() == arrow::Type::UINT32) {
-    return doGroupTable<uint32_t, arrow::UInt32Array>(arrowTable, categoryColumnName, minCatSize, outsider);
-  }
-  if (dataType->id() == arrow::Type::INT32) {
-    return doGroupTable<int32_t, arrow::Int32Array>(arrowTable, categoryColumnName, minCatSize, outsider);
-  }
-  if (dataType->id() == arrow::Type::FLOAT) {
-    return doGroupTable<float, arrow::FloatArray>(arrowTable, categoryColumnName, minCatSize, outsider);
-  }
-  // FIXME: Should we support other types as well?
-  throw o2::framework::runtime_error("Combinations: category column must be of integral type");
+  return o2::framework::CategoryIndexCache::instance().get(categoryColumnName, arrowTable, minCatSize, outsiderBits, [&]() {
+    auto columnIndex = arrowTable->schema()->GetFieldIndex(categoryColumnName);
+    auto dataType = arrowTable->column(columnIndex)->type();
+    if (dataType->id() == arrow::Type::UINT64) {
+      return doGroupTable<uint64_t, arrow::UInt64Array>(arrowTable, categoryColumnName, minCatSize, outsider);
+    }
+    if (dataType->id() == arrow::Type::INT64) {
+      return doGroupTable<int64_t, arrow::Int64Array>(arrowTable, categoryColumnName, minCatSize, outsider);
+    }
+    if (dataType->id() == arrow::Type::UINT32) {
+      return doGroupTable<uint32_t, arrow::UInt32Array>(arrowTable, categoryColumnName, minCatSize, outsider);
+    }
+    if (dataType->id() == arrow::Type::INT32) {
+      return doGroupTable<int32_t, arrow::Int32Array>(arrowTable, categoryColumnName, minCatSize, outsider);
+    }
+    if (dataType->id() == arrow::Type::FLOAT) {
+      return doGroupTable<float, arrow::FloatArray>(arrowTable, categoryColumnName, minCatSize, outsider);
+    }
+    // FIXME: Should we support other types as well?
+    throw o2::framework::runtime_error("Combinations: category column must be of integral type");
+  });
 }
 
 // Synchronize categories so as groupedIndices contain elements only of categories common to all tables
@@ -307,13 +333,14 @@ struct CombinationsBlockIndexPolicyBase : public CombinationsIndexPolicyBase<Ts.
       return;
     }
 
+    // Synchronize categories across tables on copies of the shared indices
+    std::array<std::vector<std::pair<uint64_t, uint64_t>>, k> groupedIndices;
     int tableIndex = 0;
-    ((this->mGroupedIndices[tableIndex++] = groupTable(tables, categoryColumnName, 1, outsider)), ...);
-
-    // Synchronize categories across tables
-    syncCategories(this->mGroupedIndices);
+    ((groupedIndices[tableIndex++] = *groupTable(tables, categoryColumnName, 1, outsider).mIndices), ...);
+    syncCategories(groupedIndices);
 
     for (int i = 0; i < k; i++) {
+      this->mGroupedIndices[i] = GroupedIndices(std::make_shared<std::vector<std::pair<uint64_t, uint64_t>> const>(std::move(groupedIndices[i])));
       if (this->mGroupedIndices[i].size() == 0) {
         this->mIsEnd = true;
         return;
@@ -325,7 +352,7 @@ struct CombinationsBlockIndexPolicyBase : public CombinationsIndexPolicyBase<Ts.
     });
   }
 
-  std::array<std::vector<std::pair<uint64_t, uint64_t>>, sizeof...(Ts)> mGroupedIndices;
+  std::array<GroupedIndices, sizeof...(Ts)> mGroupedIndices;
   IndicesType mCurrentIndices;
   IndicesType mBeginIndices;
   uint64_t mSlidingWindowSize;
@@ -563,7 +590,7 @@ struct CombinationsBlockSameIndexPolicyBase : public CombinationsIndexPolicyBase
     std::get<0>(this->mCurrentIndices) = 0;
   }
 
-  std::vector<std::pair<uint64_t, uint64_t>> mGroupedIndices;
+  GroupedIndices mGroupedIndices;
   IndicesType mCurrentIndices;
   uint64_t mSlidingWindowSize;
 };
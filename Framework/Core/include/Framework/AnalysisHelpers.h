@@ -20,6 +20,8 @@
 #include "Framework/OutputObjHeader.h"
 #include "Framework/StringHelpers.h"
 #include "Framework/Output.h"
+#include "Framework/GroupingIndexCache.h"
+#include <numeric>
 #include <string>
 #include "Framework/Logger.h"
 
@@ -176,6 +178,16 @@ struct TableTransform {
   }
 };
 
+/// Expression-based column generator for the extension of @a atable, the join
+/// of the @a sources tables. The extension of the tables of a dataframe is
+/// computed once and shared through the DerivedTableCache by all the tasks of
+/// the device which spawn it.
+template <typename... C>
+std::shared_ptr<arrow::Table> spawnExtension(framework::pack<C...> columns, std::vector<std::shared_ptr<arrow::Table>> const& sources, std::shared_ptr<arrow::Table> const& atable, const char* name)
+{
+  return DerivedTableCache::instance().get(std::string{"spawn:"} + name, sources, [&]() { return spawner(columns, atable.get(), name); });
+}
+
 /// This helper struct allows you to declare extended tables which should be
 /// created by the task (as opposed to those pre-defined by data model)
 template <typename T>
@@ -206,137 +218,131 @@ struct Spawns : TableTransform<typename aod::MetadataTrait<framework::pack_head_
   std::shared_ptr<extension_t> extension = nullptr;
 };
 
+/// Rows of a table grouped by their index to the Key table, in order of
+/// appearance. They are computed with a single pass over the table so that
+/// the rows matching a given key are found without searching the table.
+struct RowsByKey {
+  /// group the rows of @a table, the indices to Key must be in [0, nKeys)
+  template <typename Key, typename T>
+  static RowsByKey make(T const& table, int32_t nKeys)
+  {
+    RowsByKey result;
+    std::vector<std::pair<int32_t, int32_t>> keys; // (key, row)
+    keys.reserve(table.size());
+    for (auto& row : table) {
+      keys.emplace_back(row.template getId<Key>(), row.globalIndex());
+    }
+    result.mOffsets.assign(nKeys + 1, 0);
+    for (auto& [key, row] : keys) {
+      if (key >= 0 && key < nKeys) {
+        ++result.mOffsets[key + 1];
+      }
+    }
+    std::partial_sum(result.mOffsets.begin(), result.mOffsets.end(), result.mOffsets.begin());
+    result.mNext.assign(result.mOffsets.begin(), result.mOffsets.end() - 1);
+    result.mRows.resize(result.mOffsets.back());
+    for (auto& [key, row] : keys) {
+      if (key >= 0 && key < nKeys) {
+        result.mRows[result.mNext[key]++] = row;
+      }
+    }
+    result.mNext.assign(result.mOffsets.begin(), result.mOffsets.end() - 1);
+    return result;
+  }
+
+  /// the first row of @a key which was not yet consumed, -1 if there is none
+  int32_t next(int32_t key)
+  {
+    if (key < 0 || key >= static_cast<int32_t>(mNext.size()) || mNext[key] == mOffsets[key + 1]) {
+      return -1;
+    }
+    return mRows[mNext[key]++];
+  }
+
+ private:
+  std::vector<int32_t> mOffsets; // rows of key k are mRows[mOffsets[k]] ... mRows[mOffsets[k + 1] - 1]
+  std::vector<int32_t> mNext;    // first row not yet consumed for each key
+  std::vector<int32_t> mRows;
+};
+
+/// The arrow tables an index table is built from, which identify it in the DerivedTableCache
+template <typename Key, typename... T>
+std::vector<std::shared_ptr<arrow::Table>> indexSources(Key const& key, std::tuple<T...> const& tables)
+{
+  return std::apply([&key](auto const&... x) { return std::vector<std::shared_ptr<arrow::Table>>{key.asArrowTable(), x.asArrowTable()...}; }, tables);
+}
+
 /// Policy to control index building
 /// Exclusive index: each entry in a row has a valid index
 struct IndexExclusive {
   /// Generic builder for in index table
   template <typename... Cs, typename Key, typename T1, typename... T>
-  static auto indexBuilder(const char* label, framework::pack<Cs...>, Key const&, std::tuple<T1, T...> tables)
+  static auto indexBuilder(const char* label, framework::pack<Cs...>, Key const& key, std::tuple<T1, T...> tables)
   {
     static_assert(sizeof...(Cs) == sizeof...(T) + 1, "Number of columns does not coincide with number of supplied tables");
-    using tables_t = framework::pack<T...>;
-    using first_t = T1;
-    auto tail = tuple_tail(tables);
-    TableBuilder builder;
-    auto cursor = framework::FFL(builder.cursor<o2::soa::Table<Cs...>>());
-
-    std::array<int32_t, sizeof...(T)> values;
-    iterator_tuple_t<std::decay_t<T>...> iterators = std::apply(
-      [](auto&&... x) {
-        return std::make_tuple(x.begin()...);
-      },
-      tail);
-
-    using rest_it_t = decltype(pack_from_tuple(iterators));
-
-    int32_t idx = -1;
-    auto setValue = [&](auto& x) -> bool {
-      using type = std::decay_t<decltype(x)>;
-      constexpr auto position = framework::has_type_at_v<type>(rest_it_t{});
-
-      lowerBound<Key>(idx, x);
-      if (x == soa::RowViewSentinel{static_cast<uint64_t>(x.mMaxRow)}) {
-        return false;
-      } else if (x.template getId<Key>() != idx) {
-        return false;
-      } else {
-        values[position] = x.globalIndex();
-        ++x;
-        return true;
-      }
-    };
-
-    auto first = std::get<first_t>(tables);
-    for (auto& row : first) {
-      idx = row.template getId<Key>();
-
-      if (std::apply(
-            [](auto&... x) {
-              return ((x == soa::RowViewSentinel{static_cast<uint64_t>(x.mMaxRow)}) && ...);
-            },
-            iterators)) {
-        break;
-      }
-
-      auto result = std::apply(
-        [&](auto&... x) {
-          std::array<bool, sizeof...(T)> results{setValue(x)...};
-          return (results[framework::has_type_at_v<std::decay_t<decltype(x)>>(rest_it_t{})] && ...);
-        },
-        iterators);
-
-      if (result) {
-        cursor(0, row.globalIndex(), values[framework::has_type_at_v<T>(tables_t{})]...);
+    return DerivedTableCache::instance().get(std::string{"exclusive:"} + label, indexSources(key, tables), [&]() {
+      TableBuilder builder;
+      auto cursor = framework::FFL(builder.cursor<o2::soa::Table<Cs...>>());
+
+      const int32_t nKeys = key.offset() + key.size();
+      auto rows = std::apply([nKeys](auto const&... x) { return std::make_tuple(RowsByKey::make<Key>(x, nKeys)...); }, tuple_tail(tables));
+
+      std::array<int32_t, sizeof...(T)> values;
+      auto& first = std::get<0>(tables);
+      for (auto& row : first) {
+        auto idx = row.template getId<Key>();
+        // every table must have a row for the key
+        std::apply(
+          [&](auto&... x) {
+            size_t position = 0;
+            ((values[position++] = x.next(idx)), ...);
+          },
+          rows);
+        if (std::all_of(values.begin(), values.end(), [](int32_t v) { return v >= 0; })) {
+          std::apply([&](auto... v) { cursor(0, row.globalIndex(), v...); }, values);
+        }
       }
-    }
-    builder.setLabel(label);
-    return builder.finalize();
+      builder.setLabel(label);
+      return builder.finalize();
+    });
   }
 };
 /// Sparse index: values in a row can be (-1), index table is isomorphic (joinable)
 /// to T1
 struct IndexSparse {
   template <typename... Cs, typename Key, typename T1, typename... T>
-  static auto indexBuilder(const char* label, framework::pack<Cs...>, Key const&, std::tuple<T1, T...> tables)
+  static auto indexBuilder(const char* label, framework::pack<Cs...>, Key const& key, std::tuple<T1, T...> tables)
   {
     static_assert(sizeof...(Cs) == sizeof...(T) + 1, "Number of columns does not coincide with number of supplied tables");
-    using tables_t = framework::pack<T...>;
-    using first_t = T1;
-    auto tail = tuple_tail(tables);
-    TableBuilder builder;
-    auto cursor = framework::FFL(builder.cursor<o2::soa::Table<Cs...>>());
-
-    std::array<int32_t, sizeof...(T)> values;
-
-    iterator_tuple_t<std::decay_t<T>...> iterators = std::apply(
-      [](auto&&... x) {
-        return std::make_tuple(x.begin()...);
-      },
-      tail);
-
-    using rest_it_t = decltype(pack_from_tuple(iterators));
-
-    auto setValue = [&](auto& x, int idx) -> bool {
-      using type = std::decay_t<decltype(x)>;
-      constexpr auto position = framework::has_type_at_v<type>(rest_it_t{});
-
-      if constexpr (std::is_same_v<framework::pack_element_t<position, framework::pack<std::decay_t<T>...>>, Key>) {
-        values[position] = idx;
-        return true;
-      } else {
-        lowerBound<Key>(idx, x);
-        if (x == soa::RowViewSentinel{static_cast<uint64_t>(x.mMaxRow)}) {
-          values[position] = -1;
-          return false;
-        } else if (x.template getId<Key>() != idx) {
-          values[position] = -1;
-          return false;
+    return DerivedTableCache::instance().get(std::string{"sparse:"} + label, indexSources(key, tables), [&]() {
+      TableBuilder builder;
+      auto cursor = framework::FFL(builder.cursor<o2::soa::Table<Cs...>>());
+
+      const int32_t nKeys = key.offset() + key.size();
+      auto rows = std::apply([nKeys](auto const&... x) { return std::make_tuple(RowsByKey::make<Key>(x, nKeys)...); }, tuple_tail(tables));
+      // the index to the Key table itself is the key
+      constexpr std::array<bool, sizeof...(T)> isKey{std::is_same_v<std::decay_t<T>, Key>...};
+
+      std::array<int32_t, sizeof...(T)> values;
+      auto& first = std::get<0>(tables);
+      for (auto& row : first) {
+        int32_t idx = -1;
+        if constexpr (std::is_same_v<std::decay_t<T1>, Key>) {
+          idx = row.globalIndex();
         } else {
-          values[position] = x.globalIndex();
-          ++x;
-          return true;
+          idx = row.template getId<Key>();
         }
+        std::apply(
+          [&](auto&... x) {
+            size_t position = 0;
+            ((values[position] = isKey[position] ? idx : x.next(idx), ++position), ...);
+          },
+          rows);
+        std::apply([&](auto... v) { cursor(0, row.globalIndex(), v...); }, values);
       }
-    };
-
-    auto first = std::get<first_t>(tables);
-    for (auto& row : first) {
-      auto idx = -1;
-      if constexpr (std::is_same_v<first_t, Key>) {
-        idx = row.globalIndex();
-      } else {
-        idx = row.template getId<Key>();
-      }
-      std::apply(
-        [&](auto&... x) {
-          (setValue(x, idx), ...);
-        },
-        iterators);
-
-      cursor(0, row.globalIndex(), values[framework::has_type_at_v<T>(tables_t{})]...);
-    }
-    builder.setLabel(label);
-    return builder.finalize();
+      builder.setLabel(label);
+      return builder.finalize();
+    });
   }
 };
 
@@ -252,13 +252,15 @@ struct OutputManager<Spawns<T>> {
 
   static bool prepare(ProcessingContext& pc, Spawns<T>& what)
   {
-    auto original_table = soa::ArrowHelpers::joinTables(extractOriginals(what.sources_pack(), pc));
+    auto originals = extractOriginals(what.sources_pack(), pc);
+    auto original_table = soa::ArrowHelpers::joinTables(std::vector<std::shared_ptr<arrow::Table>>(originals));
     if (original_table->schema()->fields().empty() == true) {
       using base_table_t = typename Spawns<T>::base_table_t;
       original_table = makeEmptyTable<base_table_t>(aod::MetadataTrait<typename Spawns<T>::extension_t>::metadata::tableLabel());
+      originals = {original_table};
     }
 
-    what.extension = std::make_shared<typename Spawns<T>::extension_t>(o2::framework::spawner(what.pack(), original_table.get(), aod::MetadataTrait<typename Spawns<T>::extension_t>::metadata::tableLabel()));
+    what.extension = std::make_shared<typename Spawns<T>::extension_t>(o2::framework::spawnExtension(what.pack(), originals, original_table, aod::MetadataTrait<typename Spawns<T>::extension_t>::metadata::tableLabel()));
     what.table = std::make_shared<typename T::table_t>(soa::ArrowHelpers::joinTables({what.extension->asArrowTable(), original_table}));
     return true;
   }
@@ -24,6 +24,7 @@
 #include "Framework/Logger.h"
 #include "Framework/StructToTuple.h"
 #include "Framework/FunctionalHelpers.h"
+#include "Framework/GroupingIndexCache.h"
 #include "Framework/Traits.h"
 #include "Framework/VariantHelpers.h"
 #include "Framework/RuntimeError.h"
@@ -32,6 +33,10 @@
 #include <arrow/compute/kernel.h>
 #include <arrow/table.h>
 #include <gandiva/node.h>
+#include <TROOT.h>
+#include <exception>
+#include <functional>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <memory>
@@ -283,25 +288,16 @@ struct AnalysisDataProcessorBuilder {
           groupSelection = &gt.getSelectedRows();
         }
         auto indexColumnName = getLabelFromType();
-        /// prepare slices and offsets for all associated tables that have index
-        /// to grouping table
+        /// get the grouping of all associated tables that have index
+        /// to grouping table, shared with the other users of the same dataframe
         ///
         auto splitter = [&](auto&& x) {
           using xt = std::decay_t<decltype(x)>;
           constexpr auto index = framework::has_type_at_v<std::decay_t<decltype(x)>>(associated_pack_t{});
           if (x.size() != 0 && hasIndexTo<std::decay_t<G>>(typename xt::persistent_columns_t{})) {
-            auto result = o2::framework::sliceByColumn(indexColumnName.c_str(),
-                                                       x.asArrowTable(),
-                                                       static_cast<int32_t>(gt.tableSize()),
-                                                       &groups[index],
-                                                       &offsets[index],
-                                                       &sizes[index]);
-            if (result.ok() == false) {
-              throw runtime_error("Cannot split collection");
-            }
-            if (groups[index].size() > gt.tableSize()) {
-              throw runtime_error_f("Splitting collection resulted in a larger group number (%d) than there is rows in the grouping table (%d).", groups[index].size(), gt.tableSize());
-            };
+            groups[index] = GroupingIndexCache::instance().get(indexColumnName.c_str(),
+                                                               x.asArrowTable(),
+                                                               static_cast<int32_t>(gt.tableSize()));
           }
         };
 
@@ -317,7 +313,6 @@ struct AnalysisDataProcessorBuilder {
             constexpr auto index = framework::has_type_at_v<std::decay_t<decltype(x)>>(associated_pack_t{});
             selections[index] = &x.getSelectedRows();
             starts[index] = selections[index]->begin();
-            offsets[index].push_back(std::get<xt>(at).tableSize());
           }
         };
         std::apply(
@@ -402,25 +397,25 @@ struct AnalysisDataProcessorBuilder {
           } else {
             pos = position;
           }
+          auto offset = groups[index]->offsets[pos];
+          auto size = groups[index]->sizes[pos];
+          auto groupedElementsTable = std::get<A1>(*mAt).asArrowTable()->Slice(offset, size);
           if constexpr (soa::is_soa_filtered_t<std::decay_t<A1>>::value) {
-            auto groupedElementsTable = arrow::util::get<std::shared_ptr<arrow::Table>>(((groups[index])[pos]).value);
-
             // for each grouping element we need to slice the selection vector
-            auto start_iterator = std::lower_bound(starts[index], selections[index]->end(), (offsets[index])[pos]);
-            auto stop_iterator = std::lower_bound(start_iterator, selections[index]->end(), (offsets[index])[pos] + (sizes[index])[pos]);
+            auto start_iterator = std::lower_bound(starts[index], selections[index]->end(), offset);
+            auto stop_iterator = std::lower_bound(start_iterator, selections[index]->end(), offset + size);
             starts[index] = stop_iterator;
             soa::SelectionVector slicedSelection{start_iterator, stop_iterator};
             std::transform(slicedSelection.begin(), slicedSelection.end(), slicedSelection.begin(),
                            [&](int64_t idx) {
-                             return idx - static_cast<int64_t>((offsets[index])[pos]);
+                             return idx - static_cast<int64_t>(offset);
                            });
 
-            std::decay_t<A1> typedTable{{groupedElementsTable}, std::move(slicedSelection), (offsets[index])[pos]};
+            std::decay_t<A1> typedTable{{groupedElementsTable}, std::move(slicedSelection), offset};
             typedTable.bindInternalIndicesTo(&std::get<A1>(*mAt));
             return typedTable;
           } else {
-            auto groupedElementsTable = arrow::util::get<std::shared_ptr<arrow::Table>>(((groups[index])[pos]).value);
-            std::decay_t<A1> typedTable{{groupedElementsTable}, (offsets[index])[pos]};
+            std::decay_t<A1> typedTable{{groupedElementsTable}, offset};
             typedTable.bindInternalIndicesTo(&std::get<A1>(*mAt));
             return typedTable;
           }
@@ -434,9 +429,7 @@ struct AnalysisDataProcessorBuilder {
       typename grouping_t::iterator mGroupingElement;
       uint64_t position = 0;
       soa::SelectionVector const* groupSelection = nullptr;
-      std::array<std::vector<arrow::Datum>, sizeof...(A)> groups;
-      std::array<std::vector<uint64_t>, sizeof...(A)> offsets;
-      std::array<std::vector<int>, sizeof...(A)> sizes;
+      std::array<std::shared_ptr<GroupingIndex const>, sizeof...(A)> groups;
       std::array<soa::SelectionVector const*, sizeof...(A)> selections;
       std::array<soa::SelectionVector::const_iterator, sizeof...(A)> starts;
     };
@@ -460,8 +453,12 @@ struct AnalysisDataProcessorBuilder {
     (invokeProcess<o2::framework::has_type_at_v<T>(pack<T...>{})>(task, inputs, std::get<T>(processTuple), infos), ...);
   }
 
+  /// Invoke the process function of the task on the current dataframe.
+  /// If @a workers are provided (the task itself being the first one), the groups of a grouped
+  /// process function are split in contiguous ranges processed in parallel, one per worker task.
   template <typename Task, typename R, typename C, typename Grouping, typename... Associated>
-  static void invokeProcess(Task& task, InputRecord& inputs, R (C::*processingFunction)(Grouping, Associated...), std::vector<ExpressionInfo> const& infos)
+  static void invokeProcess(Task& task, InputRecord& inputs, R (C::*processingFunction)(Grouping, Associated...), std::vector<ExpressionInfo> const& infos,
+                            std::vector<std::shared_ptr<Task>> const* workers = nullptr)
   {
     using G = std::decay_t<Grouping>;
     auto groupingTable = AnalysisDataProcessorBuilder::bindGroupingTable(inputs, processingFunction, infos);
@@ -509,15 +506,21 @@ struct AnalysisDataProcessorBuilder {
         },
         associatedTables);
 
-      auto binder = [&](auto&& x) {
-        x.bindExternalIndices(&groupingTable, &std::get<std::decay_t<Associated>>(associatedTables)...);
+      auto partitionBinder = [](Task& tsk, auto&& x) {
         homogeneous_apply_refs([&x](auto& t) {
           PartitionManager<std::decay_t<decltype(t)>>::setPartition(t, x);
           PartitionManager<std::decay_t<decltype(t)>>::bindExternalIndices(t, &x);
           PartitionManager<std::decay_t<decltype(t)>>::getBoundToExternalIndices(t, x);
           return true;
         },
-                               task);
+                               tsk);
+      };
+      auto sliceBinder = [&](Task& tsk, auto&& x) {
+        x.bindExternalIndices(&groupingTable, &std::get<std::decay_t<Associated>>(associatedTables)...);
+        partitionBinder(tsk, x);
+      };
+      auto binder = [&](auto&& x) {
+        sliceBinder(task, x);
       };
       groupingTable.bindExternalIndices(&std::get<std::decay_t<Associated>>(associatedTables)...);
 
@@ -530,25 +533,82 @@ struct AnalysisDataProcessorBuilder {
 
       if constexpr (soa::is_soa_iterator_t<std::decay_t<G>>::value) {
         // grouping case
-        auto slicer = GroupSlicer(groupingTable, associatedTables);
-        for (auto& slice : slicer) {
-          auto associatedSlices = slice.associatedTables();
-
-          std::apply(
-            [&](auto&&... x) {
-              (binder(x), ...);
+        // process the groups [first, last) with the given task
+        auto processGroups = [&](Task& tsk, int64_t first, int64_t last) {
+          auto slicer = GroupSlicer(groupingTable, associatedTables);
+          for (auto& slice : slicer) {
+            if (static_cast<int64_t>(slice.position) < first) {
+              continue;
+            }
+            if (static_cast<int64_t>(slice.position) >= last) {
+              break;
+            }
+            auto associatedSlices = slice.associatedTables();
+
+            std::apply(
+              [&](auto&&... x) {
+                (sliceBinder(tsk, x), ...);
+              },
+              associatedSlices);
+
+            // bind partitions and grouping table
+            homogeneous_apply_refs([&groupingTable](auto& x) {
+              PartitionManager<std::decay_t<decltype(x)>>::bindExternalIndices(x, &groupingTable);
+              PartitionManager<std::decay_t<decltype(x)>>::getBoundToExternalIndices(x, groupingTable);
+              return true;
             },
-            associatedSlices);
+                                   tsk);
 
-          // bind partitions and grouping table
-          homogeneous_apply_refs([&groupingTable](auto& x) {
-            PartitionManager<std::decay_t<decltype(x)>>::bindExternalIndices(x, &groupingTable);
-            PartitionManager<std::decay_t<decltype(x)>>::getBoundToExternalIndices(x, groupingTable);
-            return true;
-          },
-                                 task);
+            invokeProcessWithArgsGeneric(tsk, processingFunction, slice.groupingElement(), associatedSlices);
+          }
+        };
 
-          invokeProcessWithArgsGeneric(task, processingFunction, slice.groupingElement(), associatedSlices);
+        int64_t nGroups = groupingTable.size();
+        int nWorkers = workers ? std::min<int64_t>(workers->size(), nGroups) : 1;
+        if (nWorkers < 2) {
+          processGroups(task, 0, nGroups);
+        } else {
+          std::vector<std::thread> threads;
+          std::vector<std::exception_ptr> errors(nWorkers);
+          for (int iw = 0; iw < nWorkers; ++iw) {
+            threads.emplace_back([&, iw]() {
+              try {
+                auto& tsk = *(*workers)[iw];
+                if (&tsk != &task) {
+                  // the worker partitions must be bound to the full tables as done above for the task
+                  homogeneous_apply_refs([&groupingTable](auto& x) {
+                    PartitionManager<std::decay_t<decltype(x)>>::setPartition(x, groupingTable);
+                    PartitionManager<std::decay_t<decltype(x)>>::bindInternalIndices(x, &groupingTable);
+                    return true;
+                  },
+                                         tsk);
+                  std::apply(
+                    [&](auto&... t) {
+                      (homogeneous_apply_refs(
+                         [&](auto& p) {
+                           PartitionManager<std::decay_t<decltype(p)>>::bindInternalIndices(p, &t);
+                           return true;
+                         },
+                         tsk),
+                       ...);
+                      (partitionBinder(tsk, t), ...);
+                    },
+                    associatedTables);
+                }
+                processGroups(tsk, nGroups * iw / nWorkers, nGroups * (iw + 1) / nWorkers);
+              } catch (...) {
+                errors[iw] = std::current_exception();
+              }
+            });
+          }
+          for (auto& thread : threads) {
+            thread.join();
+          }
+          for (auto& error : errors) {
+            if (error) {
+              std::rethrow_exception(error);
+            }
+          }
         }
       } else {
         // non-grouping case
@@ -625,6 +685,63 @@ class has_init
 
 template <class T>
 inline constexpr bool has_init_v = has_init<T>::value;
+
+/// A task declaring `static constexpr bool parallelGroups = true;` is stateless with respect to
+/// the groups it processes: its groups can be split across worker copies of the task.
+template <typename T>
+class has_parallel_groups
+{
+  template <typename C>
+  static std::bool_constant<C::parallelGroups> test(decltype(&C::parallelGroups));
+  template <typename C>
+  static std::false_type test(...);
+
+ public:
+  static constexpr bool value = decltype(test<T>(nullptr))::value;
+};
+
+template <class T>
+inline constexpr bool has_parallel_groups_v = has_parallel_groups<T>::value;
+
+/// The worker copies of a task only produce histograms in their HistogramRegistries,
+/// which are merged into the ones of the task at the end of the stream
+template <typename T>
+bool canProcessGroupsInParallel(T& task)
+{
+  if constexpr (has_run_v<T>) {
+    return false;
+  }
+  auto allowed = homogeneous_apply_refs([](auto& x) {
+    using D = std::decay_t<decltype(x)>;
+    return !(is_base_of_template<Produces, D>::value || is_base_of_template<Spawns, D>::value ||
+             is_base_of_template<Builds, D>::value || is_base_of_template<OutputObj, D>::value);
+  },
+                                        task);
+  return std::all_of(allowed.begin(), allowed.end(), [](bool a) { return a; });
+}
+
+template <typename T>
+void mergeWorkers(std::vector<std::shared_ptr<T>>& workers)
+{
+  auto getRegistries = [](T& task) {
+    std::vector<HistogramRegistry*> registries;
+    homogeneous_apply_refs([&registries](auto& x) {
+      if constexpr (std::is_same_v<std::decay_t<decltype(x)>, HistogramRegistry>) {
+        registries.push_back(&x);
+      }
+      return true;
+    },
+                           task);
+    return registries;
+  };
+  auto target = getRegistries(*workers[0]);
+  for (size_t iw = 1; iw < workers.size(); ++iw) {
+    auto source = getRegistries(*workers[iw]);
+    for (size_t ir = 0; ir < target.size(); ++ir) {
+      target[ir]->merge(*source[ir]);
+    }
+  }
+}
 } // namespace
 
 struct SetDefaultProcesses {
@@ -738,6 +855,13 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
   /// make sure options and configurables are set before expression infos are created
   homogeneous_apply_refs([&options, &hash](auto& x) { return OptionManager<std::decay_t<decltype(x)>>::appendOption(options, x); }, *task.get());
 
+  /// worker tasks for the parallel processing of the groups
+  std::function<std::shared_ptr<T>()> makeWorker;
+  if constexpr (has_parallel_groups_v<T>) {
+    options.push_back(ConfigParamSpec{"analysis-workers", VariantType::Int, 1, {"Number of threads processing the groups of a dataframe in parallel"}});
+    makeWorker = [args...]() { return std::get<1>(getTaskNameSetProcesses<T>(args...)); };
+  }
+
   /// parse process functions defined by corresponding configurables
   if constexpr (has_process_v<T>) {
     AnalysisDataProcessorBuilder::inputsFromArgs(&T::process, "default", true, inputs, expressionInfos);
@@ -779,12 +903,14 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
 
   homogeneous_apply_refs([&outputs, &hash](auto& x) { return OutputManager<std::decay_t<decltype(x)>>::appendOutput(outputs, x, hash); }, *task.get());
 
-  auto algo = AlgorithmSpec::InitCallback{[task = task, expressionInfos](InitContext& ic) mutable {
+  auto algo = AlgorithmSpec::InitCallback{[task = task, expressionInfos, makeWorker](InitContext& ic) mutable {
     homogeneous_apply_refs([&ic](auto&& x) { return OptionManager<std::decay_t<decltype(x)>>::prepare(ic, x); }, *task.get());
     homogeneous_apply_refs([&ic](auto&& x) { return ServiceManager<std::decay_t<decltype(x)>>::prepare(ic, x); }, *task.get());
 
+    auto workers = std::make_shared<std::vector<std::shared_ptr<T>>>(1, task);
     auto& callbacks = ic.services().get<CallbackService>();
-    auto endofdatacb = [task](EndOfStreamContext& eosContext) {
+    auto endofdatacb = [task, workers](EndOfStreamContext& eosContext) {
+      mergeWorkers(*workers);
       homogeneous_apply_refs([&eosContext](auto&& x) { return OutputManager<std::decay_t<decltype(x)>>::postRun(eosContext, x); }, *task.get());
       eosContext.services().get<ControlService>().readyToQuit(QuitRequest::Me);
     };
@@ -808,19 +934,46 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
       task->init(ic);
     }
 
-    return [task, expressionInfos](ProcessingContext& pc) {
+    if constexpr (has_parallel_groups_v<T>) {
+      auto nWorkers = ic.options().get<int>("analysis-workers");
+      if (nWorkers > 1 && !canProcessGroupsInParallel(*task.get())) {
+        LOG(WARNING) << "Task has outputs other than histogram registries, its groups cannot be processed in parallel";
+        nWorkers = 1;
+      }
+      for (int iw = 1; iw < nWorkers; ++iw) {
+        auto worker = makeWorker();
+        homogeneous_apply_refs([&ic](auto&& x) { return OptionManager<std::decay_t<decltype(x)>>::prepare(ic, x); }, *worker.get());
+        homogeneous_apply_refs([&ic](auto&& x) { return ServiceManager<std::decay_t<decltype(x)>>::prepare(ic, x); }, *worker.get());
+        homogeneous_apply_refs(
+          [&ic](auto& x) -> bool { return FilterManager<std::decay_t<decltype(x)>>::updatePlaceholders(x, ic); },
+          *worker.get());
+        homogeneous_apply_refs(
+          [&ic](auto& x) -> bool { PartitionManager<std::decay_t<decltype(x)>>::updatePlaceholders(x, ic); return true; },
+          *worker.get());
+        if constexpr (has_init_v<T>) {
+          worker->init(ic);
+        }
+        workers->push_back(worker);
+      }
+      if (nWorkers > 1) {
+        ROOT::EnableThreadSafety();
+        LOG(INFO) << "Processing the groups of the dataframes with " << nWorkers << " threads";
+      }
+    }
+
+    return [task, expressionInfos, workers](ProcessingContext& pc) {
       homogeneous_apply_refs([&pc](auto&& x) { return OutputManager<std::decay_t<decltype(x)>>::prepare(pc, x); }, *task.get());
       if constexpr (has_run_v<T>) {
         task->run(pc);
       }
       if constexpr (has_process_v<T>) {
-        AnalysisDataProcessorBuilder::invokeProcess(*(task.get()), pc.inputs(), &T::process, expressionInfos);
+        AnalysisDataProcessorBuilder::invokeProcess(*(task.get()), pc.inputs(), &T::process, expressionInfos, workers.get());
       }
       homogeneous_apply_refs(
-        [&pc, &expressionInfos, &task](auto& x) {
+        [&pc, &expressionInfos, &task, &workers](auto& x) {
           if constexpr (is_base_of_template<ProcessConfigurable, std::decay_t<decltype(x)>>::value) {
             if (x.value == true) {
-              AnalysisDataProcessorBuilder::invokeProcess(*task.get(), pc.inputs(), x.process, expressionInfos);
+              AnalysisDataProcessorBuilder::invokeProcess(*task.get(), pc.inputs(), x.process, expressionInfos, workers.get());
               return true;
             }
           }
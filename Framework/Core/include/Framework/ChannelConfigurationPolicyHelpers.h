@@ -54,6 +54,9 @@ struct ChannelConfigurationPolicyHelpers {
   static InputChannelModifier pullInput(FairMQChannelConfigSpec const& spec);
   /// Makes the passed output channel bind and push
   static OutputChannelModifier pushOutput(FairMQChannelConfigSpec const& spec);
+  /// Makes the passed output channel bind and push, compressing large
+  /// payloads with @a compression when they go through the network.
+  static OutputChannelModifier compressedPushOutput(FairMQChannelConfigSpec const& spec, ChannelCompression compression);
   /// Makes the passed input channel connect and request
   static InputChannelModifier reqInput(FairMQChannelConfigSpec const& spec);
   /// Makes the passed output channel bind and reply
@@ -38,6 +38,15 @@ enum struct ChannelProtocol {
   IPC
 };
 
+/// How payloads are compressed before being sent on a channel.
+/// Compression is only applied when the channel does not go
+/// through shared memory, i.e. when it actually crosses nodes.
+enum struct ChannelCompression {
+  None,
+  LZ4,
+  ZSTD
+};
+
 /// This describes an input channel. Since they are point to
 /// point connections, there is not much to say about them.
 /// Notice that this should be considered read only once it
@@ -72,6 +81,7 @@ struct OutputChannelSpec {
   size_t recvBufferSize = 1000;
   size_t sendBufferSize = 1000;
   std::string ipcPrefix = ".";
+  ChannelCompression compression = ChannelCompression::None;
 };
 
 } // namespace o2::framework
@@ -52,6 +52,9 @@ struct CompletionPolicy {
   using Matcher = std::function<bool(DeviceSpec const& device)>;
   using InputSetElement = DataRef;
   using Callback = std::function<CompletionOp(InputSpan const&)>;
+  /// Callback which decides only based on how many of the @a total inputs
+  /// of a record (i.e. of a slot) are already @a present.
+  using CountCallback = std::function<CompletionOp(size_t present, size_t total)>;
 
   /// Name of the policy itself.
   std::string name = "";
@@ -60,6 +63,11 @@ struct CompletionPolicy {
   Matcher matcher = nullptr;
   /// Actual policy which decides what to do with a partial InputRecord.
   Callback callback = nullptr;
+  /// Optional equivalent of callback which only needs the number of
+  /// inputs which have arrived. If set, the DataRelayer uses it in place
+  /// of callback, so that checking a slot does not depend on the number
+  /// of inputs.
+  CountCallback callbackFromCount = nullptr;
 
   /// Helper to create the default configuration.
   static std::vector<CompletionPolicy> createDefaultPolicies();
@@ -70,6 +78,9 @@ struct CompletionPolicy {
   /// Constructor for emplace_back
   CompletionPolicy(std::string _name, Matcher _matcher, Callback _callback)
     : name(_name), matcher(_matcher), callback(_callback) {}
+  /// Constructor for policies which can be evaluated from the input count
+  CompletionPolicy(std::string _name, Matcher _matcher, Callback _callback, CountCallback _callbackFromCount)
+    : name(_name), matcher(_matcher), callback(_callback), callbackFromCount(_callbackFromCount) {}
 };
 
 std::ostream& operator<<(std::ostream& oss, CompletionPolicy::CompletionOp const& val);
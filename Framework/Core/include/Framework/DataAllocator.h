@@ -376,6 +376,13 @@ class DataAllocator
   void snapshot(const Output& spec, const char* payload, size_t payloadSize,
                 o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
 
+  /// Send the payload of an existing message to the output specified by @a spec, with a new
+  /// header stack. If the message and the output channel use the same transport, the payload
+  /// is shared with the new message (reference counted in case of shared memory), otherwise
+  /// it is copied.
+  void forward(const Output& spec, const FairMQMessage& payload,
+               o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
+
   /// make an object of type T and route to output specified by OutputRef
   /// The object is owned by the framework, returned reference can be used to fill the object.
   ///
@@ -387,6 +394,30 @@ class DataAllocator
     return make<T>(getOutputByBind(std::move(ref)), std::forward<Args>(args)...);
   }
 
+  /// make a std::vector of messageable type T, owned by the framework, reserving
+  /// @a capacity elements of the underlying message upfront. The vector is allocated
+  /// directly in the output message, so as long as it does not grow beyond @a capacity
+  /// it is filled in place without reallocating and copying. When the message is sent
+  /// its used size is set to the actual size of the vector, giving back the unused tail
+  /// of the reserved buffer to the shared memory region.
+  template <typename T>
+  auto& makeWithCapacity(const Output& spec, size_t capacity)
+  {
+    static_assert(is_specialization<T, std::vector>::value && has_messageable_value_type<T>::value,
+                  "makeWithCapacity only supports std::vector of messageable types");
+    auto& container = make<T>(spec);
+    container.reserve(capacity);
+    return container;
+  }
+
+  /// make a std::vector of messageable type T with reserved @a capacity and route it to
+  /// the output specified by OutputRef, see above.
+  template <typename T>
+  auto& makeWithCapacity(OutputRef&& ref, size_t capacity)
+  {
+    return makeWithCapacity<T>(getOutputByBind(std::move(ref)), capacity);
+  }
+
   /// adopt an object of type T and route to output specified by OutputRef
   /// Framework takes ownership of the object
   ///
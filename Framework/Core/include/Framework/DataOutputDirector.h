@@ -19,8 +19,25 @@
 
 #include "rapidjson/fwd.h"
 
+#include <map>
+#include <memory>
+#include <set>
+
 class TFile;
 
+namespace arrow
+{
+class Table;
+namespace io
+{
+class OutputStream;
+}
+namespace ipc
+{
+class RecordBatchWriter;
+}
+} // namespace arrow
+
 namespace o2::framework
 {
 using namespace rapidjson;
@@ -31,6 +48,7 @@ struct DataOutputDescriptor {
   /// columns to save, and the file name
 
   std::string tablename = "";
+  std::string tablestring = ""; // origin/description/subSpec the descriptor was built from
   std::string treename = "";
   std::vector<std::string> colnames;
   std::unique_ptr<data_matcher::DataDescriptorMatcher> matcher;
@@ -75,6 +93,13 @@ struct DataOutputDirector {
   void setNumberTimeFramesToMerge(int ntfmerge) { mnumberTimeFramesToMerge = ntfmerge > 0 ? ntfmerge : 1; }
   std::string getFileMode() { return mfileMode; }
   void setFileMode(std::string filemode) { mfileMode = filemode; }
+  std::string getFileFormat() { return mfileFormat; }
+  void setFileFormat(std::string fileformat);
+  bool isArrowFormat() { return mfileFormat == "arrow"; }
+  // the trees of an output file are distributed over nparts files, which are written concurrently
+  // must be set before setFilenameBase
+  int getNumberOfParts() { return mnumberOfParts; }
+  void setNumberOfParts(int nparts) { mnumberOfParts = nparts > 0 ? nparts : 1; }
 
   // get matching DataOutputDescriptors
   std::vector<DataOutputDescriptor*> getDataOutputDescriptors(header::DataHeader dh);
@@ -83,6 +108,12 @@ struct DataOutputDirector {
   // get the matching TFile
   FileAndFolder getFileFolder(DataOutputDescriptor* dodesc, uint64_t folderNumber);
 
+  // get the name base of the (part) file a DataOutputDescriptor is written to
+  std::string getPartFilenameBase(DataOutputDescriptor* dodesc);
+
+  // write a table in the Arrow format: <filename>.arrow/DF_<folderNumber>/<treename>.arrow
+  void writeArrowTable(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::shared_ptr<arrow::Table> const& table);
+
   void closeDataFiles();
 
   void setFilenameBase(std::string dfn);
@@ -95,10 +126,25 @@ struct DataOutputDirector {
   std::vector<DataOutputDescriptor*> mDataOutputDescriptors;
   std::vector<std::string> mtreeFilenames;
   std::vector<std::string> mfilenameBases;
+  std::vector<std::string> mpartFilenameBases; // file name base of each DataOutputDescriptor, differs from its filename base for the parts > 0
   std::vector<TFile*> mfilePtrs;
   bool mdebugmode = false;
   int mnumberTimeFramesToMerge = 1;
+  int mnumberOfParts = 1;
   std::string mfileMode = "RECREATE";
+  std::string mfileFormat = "root";
+
+  struct ArrowFile {
+    std::shared_ptr<arrow::io::OutputStream> stream;
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+  };
+  std::map<std::string, ArrowFile> marrowFiles; // open Arrow files, key is <folder>/<treename>
+  std::map<std::string, int> marrowFileParts;   // number of files written per <folder>/<treename>
+  std::set<std::string> marrowDirectories;      // <file>.arrow directories written in this job, cleared first in RECREATE mode
+  void closeArrowFile(ArrowFile& arrowFile);
+
+  // write <filename>_index.json, the InputDirector configuration to read the parts of a file as one
+  void writePartsIndex(std::string const& filenameBase);
 
   std::tuple<std::string, std::string, int> readJsonDocument(Document* doc);
   const std::tuple<std::string, std::string, int> memptyanswer = std::make_tuple(std::string(""), std::string(""), -1);
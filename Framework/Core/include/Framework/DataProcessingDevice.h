@@ -166,6 +166,7 @@ class DataProcessingDevice : public FairMQDevice
   std::vector<uv_work_t> mHandles;                               /// Handles to use to schedule work.
   std::vector<TaskStreamInfo> mStreams;                          /// Information about the task running in the associated mHandle.
   ComputingQuotaEvaluator& mQuotaEvaluator;                      /// The component which evaluates if the offer can be used to run a task
+  uv_timer_t* mRateLimitTimer = nullptr;                         /// Wakes up the loop when a new timeslice is allowed by the rate limit.
 };
 
 } // namespace o2::framework
@@ -36,6 +36,7 @@ struct DataProcessingStats {
   std::atomic<int> lastProcessedSize = 0;
   std::atomic<int> totalProcessedSize = 0;
   std::atomic<int> totalSigusr1 = 0;
+  std::atomic<uint64_t> processedTimeslices = 0; /// How many timeslices were consumed so far
 
   std::atomic<uint64_t> lastSlowMetricSentTimestamp = 0; /// The timestamp of the last time we sent slow metrics
   std::atomic<uint64_t> lastMetricFlushedTimestamp = 0;  /// The timestamp of the last time we actually flushed metrics
@@ -11,6 +11,8 @@
 #ifndef FRAMEWORK_DATAREF_H
 #define FRAMEWORK_DATAREF_H
 
+class FairMQMessage;
+
 namespace o2
 {
 namespace framework
@@ -24,6 +26,9 @@ struct DataRef {
   const InputSpec* spec = nullptr;
   const char* header = nullptr;
   const char* payload = nullptr;
+  // the message holding the payload, when the payload comes from one.
+  // It allows to forward the payload without copying it.
+  const FairMQMessage* payloadMessage = nullptr;
 };
 
 } // namespace framework
@@ -20,8 +20,11 @@
 #include "Framework/TimesliceIndex.h"
 #include "Framework/Tracing.h"
 
+#include <atomic>
 #include <cstddef>
 #include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 class FairMQMessage;
@@ -54,7 +57,9 @@ class DataRelayer
  public:
   /// DataRelayer is thread safe because we have a lock around
   /// each method and there is no particular order in which
-  /// methods need to be called.
+  /// methods need to be called. The only exception is the
+  /// per-entry CacheEntryStatus, which is kept in atomics so that
+  /// status transitions do not need to contend for the lock.
   constexpr static ServiceKind service_kind = ServiceKind::Global;
   enum RelayChoice {
     WillRelay,     /// Ownership of the data has been taken
@@ -73,6 +78,15 @@ class DataRelayer
     CompletionPolicy::CompletionOp op;
   };
 
+  /// A route which can match a given (origin, description, subSpec).
+  struct RouteCandidate {
+    /// The position of the route in the distinct routes index
+    size_t position;
+    /// Whether the route matches exactly that triple, so that only the
+    /// timeslice needs to be checked rather than the full matcher.
+    bool concrete;
+  };
+
   DataRelayer(CompletionPolicy const&,
               std::vector<InputRoute> const& routes,
               monitoring::Monitoring&,
@@ -113,6 +127,10 @@ class DataRelayer
 
   /// Returns how many timeslices we can handle in parallel
   size_t getParallelTimeslices() const;
+  /// @return how many timeslices are currently waiting in the relayer
+  size_t getInflightTimeslices();
+  /// @return how many bytes of messages are currently held in the relayer
+  size_t getInflightBytes();
 
   /// Tune the maximum number of in flight timeslices this can handle.
   void setPipelineLength(size_t s);
@@ -130,7 +148,8 @@ class DataRelayer
   TimesliceId getTimesliceForSlot(TimesliceSlot slot);
 
   /// Mark a given slot as done so that the GUI
-  /// can reflect that.
+  /// can reflect that. Only the entries which are in @a oldStatus
+  /// are moved to @a newStatus. This does not take the relayer lock.
   void updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStatus, CacheEntryStatus newStatus);
   /// Get the firstTFOrbit associate to a given slot.
   uint32_t getFirstTFOrbitForSlot(TimesliceSlot slot);
@@ -139,6 +158,14 @@ class DataRelayer
   /// Remove all pending messages
   void clear();
 
+  /// Keep track of when the inputs of one timeslice out of @a every
+  /// arrive, 0 to disable it. See TimesliceTraceHelpers::isTraced.
+  void setTracing(size_t every);
+  /// @return true if the timeslice in @a slot is being traced
+  bool isTraced(TimesliceSlot slot);
+  /// @return when the first and the last input of a traced slot were relayed
+  std::pair<uint64_t, uint64_t> getArrivalTimesForSlot(TimesliceSlot slot);
+
  private:
   monitoring::Monitoring& mMetrics;
 
@@ -155,8 +182,35 @@ class DataRelayer
   CompletionPolicy mCompletionPolicy;
   std::vector<size_t> mDistinctRoutesIndex;
   std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
+  /// The concrete matcher of each route, if it has one.
+  std::vector<std::optional<ConcreteDataMatcher>> mConcreteMatchers;
+  struct ConcreteDataMatcherHash {
+    size_t operator()(ConcreteDataMatcher const& m) const
+    {
+      return std::hash<uint64_t>{}((uint64_t)m.origin.itg[0] << 32 | m.subSpec) ^
+             std::hash<uint64_t>{}(m.description.itg[0]) ^ (std::hash<uint64_t>{}(m.description.itg[1]) << 1);
+    }
+  };
+  /// The routes which can match each (origin, description, subSpec) seen so far,
+  /// so that in steady state only those need to be checked.
+  std::unordered_map<ConcreteDataMatcher, std::vector<RouteCandidate>, ConcreteDataMatcherHash> mRouteCandidates;
   std::vector<data_matcher::VariableContext> mVariableContextes;
-  std::vector<CacheEntryStatus> mCachedStateMetrics;
+  /// The status of each entry in mCache. Transitions are done via
+  /// compare and swap so that they can happen outside of mMutex.
+  std::vector<std::atomic<CacheEntryStatus>> mCachedStateMetrics;
+  /// The slot which received the last relayed message. Consecutive
+  /// messages usually belong to the same timeslice, so we start
+  /// the matching from there.
+  TimesliceSlot mLastRelayedSlot{TimesliceSlot::INVALID};
+  /// How many of the inputs of each slot are present. This is kept
+  /// up to date while relaying, so that the completion policies which
+  /// provide a CompletionPolicy::callbackFromCount do not need to look
+  /// at all the inputs.
+  std::vector<size_t> mPresentInputs;
+  /// When the first and the last input of each slot were relayed,
+  /// only for the traced timeslices.
+  std::vector<std::pair<uint64_t, uint64_t>> mArrivalTimes;
+  size_t mTraceEvery = 0;
 
   static std::vector<std::string> sMetricsNames;
   static std::vector<std::string> sVariablesMetricsNames;
@@ -16,6 +16,7 @@
 #include "Framework/DeviceState.h"
 
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 // For pid_t
@@ -26,6 +27,8 @@
 namespace o2::framework
 {
 
+class DeviceMetricsRing;
+
 struct DeviceInfo {
   /// The pid of the device associated to this device
   pid_t pid;
@@ -74,6 +77,9 @@ struct DeviceInfo {
   short tracyPort;
   /// Timestamp of the last signal received
   size_t lastSignal;
+  /// Shared memory ring where the device sends its numeric metrics,
+  /// if any.
+  std::shared_ptr<DeviceMetricsRing> metricsRing;
 };
 
 } // namespace o2::framework
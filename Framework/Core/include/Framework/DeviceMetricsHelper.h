@@ -41,6 +41,12 @@ struct DeviceMetricsHelper {
   static bool processMetric(ParsedMetricMatch& results,
                             DeviceMetricsInfo& info,
                             NewMetricCallback newMetricCallback = nullptr);
+
+  /// Stores the value of a parsed metric in the metric at @a metricIndex,
+  /// which must already exist. The name in @a results is not used.
+  static bool storeMetric(ParsedMetricMatch const& results,
+                          DeviceMetricsInfo& info,
+                          size_t metricIndex);
   /// @return the index in metrics for the information of given metric
   static size_t metricIdxByName(const std::string& name,
                                 const DeviceMetricsInfo& info);
@@ -89,6 +95,7 @@ struct DeviceMetricsHelper {
       size_t pos = metric.pos++ % store[metric.storeIdx].size();
       metrics.timestamps[metricIndex][pos] = timestamp;
       store[metric.storeIdx][pos] = value;
+      metrics.rollups[metricIndex].add(timestamp, (float)value);
       metric.filledMetrics++;
     };
   }
@@ -13,8 +13,10 @@
 #define O2_FRAMEWORK_DEVICEMETRICSINFO_H_
 
 #include "Framework/RuntimeError.h"
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -70,6 +72,40 @@ struct ParsedMetricMatch {
   char const* endStringValue;
 };
 
+/// Minimum, maximum and average of the values of a metric in a time bin.
+struct MetricRollupBin {
+  uint32_t index = 0; // timestamp / bin width of the bin
+  uint32_t count = 0; // number of values in the bin
+  float min = 0.f;
+  float max = 0.f;
+  float avg = 0.f;
+};
+
+/// Down-sampled history of a numeric metric, with bins of 1 s, 10 s and
+/// 1 min, updated with every value, so that time windows longer than the
+/// raw buffers are still available and can be displayed with few points.
+/// The bins are allocated while they are filled, and then reused as a
+/// circular buffer.
+struct MetricRollups {
+  static constexpr size_t LEVELS = 3;
+  static constexpr std::array<size_t, LEVELS> BIN_WIDTHS = {1000, 10000, 60000}; // ms
+  static constexpr std::array<size_t, LEVELS> MAX_BINS = {300, 360, 720};        // 5 min, 1 h, 12 h
+
+  std::array<std::vector<MetricRollupBin>, LEVELS> bins;
+  std::array<size_t, LEVELS> filledBins{}; // How many bins were started at each level
+
+  void add(size_t timestamp, float value);
+  /// @return how many bins of @a level are available
+  size_t availableBins(size_t level) const { return std::min(filledBins[level], MAX_BINS[level]); }
+  /// @return the @a i-th available bin of @a level, starting from the oldest
+  MetricRollupBin const& bin(size_t level, size_t i) const
+  {
+    return bins[level][(filledBins[level] - availableBins(level) + i) % MAX_BINS[level]];
+  }
+  /// @return the start of the oldest available bin of @a level, in ms
+  size_t firstTimestamp(size_t level) const { return availableBins(level) ? bin(level, 0).index * BIN_WIDTHS[level] : -1; }
+};
+
 /// This struct hold information about device metrics when running
 /// in standalone mode. It's position in the holding vector is
 /// the same as the DeviceSpec in its own vector.
@@ -89,6 +125,7 @@ struct DeviceMetricsInfo {
   std::vector<MetricLabelIndex> metricLabelsAlphabeticallySortedIdx;
   std::vector<MetricInfo> metrics;
   std::vector<bool> changed;
+  std::vector<MetricRollups> rollups; // Down-sampled history of each metric, empty for strings
 };
 
 } // namespace o2::framework
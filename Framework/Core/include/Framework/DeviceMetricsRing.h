@@ -0,0 +1,101 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DEVICEMETRICSRING_H_
+#define O2_FRAMEWORK_DEVICEMETRICSRING_H_
+
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Binary channel for the numeric metrics of a device, alternative to
+/// the "[METRIC] " text lines parsed by the driver.
+///
+/// It is a lock free single producer / single consumer ring buffer of
+/// (metric index, timestamp, value) records, in a shared memory segment
+/// created by the driver for each device it spawns and inherited by the
+/// device via the file descriptor in DPL_METRICS_RING_FD. Metric names are
+/// registered only once in a table in the same segment, so that the driver
+/// does not need to parse nor to look them up for every value.
+///
+/// Whatever does not fit (strings, a full ring or too many metrics)
+/// is still sent as text, so the ring is only an optimisation.
+class DeviceMetricsRing
+{
+ public:
+  /// Environment variable with the file descriptor of the ring of a device
+  static constexpr const char* FD_ENV = "DPL_METRICS_RING_FD";
+  /// Maximum number of metrics which can be registered
+  static constexpr size_t MAX_METRICS = 1024;
+
+  struct Record {
+    uint32_t metricIndex;
+    MetricType type;
+    uint64_t timestamp;
+    union {
+      int64_t intValue;
+      double floatValue;
+      uint64_t uint64Value;
+    };
+  };
+
+  /// Creates a new ring for @a capacity records (rounded up to a power of 2).
+  /// @return nullptr if the shared memory segment cannot be created.
+  static std::unique_ptr<DeviceMetricsRing> create(size_t capacity);
+  /// Maps the ring created by the driver in the segment @a fd.
+  /// @return nullptr if @a fd does not contain a valid ring.
+  static std::unique_ptr<DeviceMetricsRing> attach(int fd);
+
+  ~DeviceMetricsRing();
+  DeviceMetricsRing(DeviceMetricsRing const&) = delete;
+  DeviceMetricsRing& operator=(DeviceMetricsRing const&) = delete;
+
+  /// The file descriptor of the segment, -1 once the producer has attached.
+  int fd() const { return mFd; }
+  size_t capacity() const;
+
+  /// Producer side: registers a new metric.
+  /// @return the index to use in push, -1 if the table is full.
+  int registerMetric(std::string_view name);
+  /// Producer side: @return false if the ring is full.
+  bool push(Record const& record);
+
+  /// Consumer side: moves all the records available in the ring to @a info,
+  /// creating the metrics the first time they are seen.
+  /// @return the number of records processed.
+  size_t consume(DeviceMetricsInfo& info,
+                 DeviceMetricsHelper::NewMetricCallback newMetricCallback = nullptr);
+
+ private:
+  struct Header;
+
+  DeviceMetricsRing(void* address, size_t size, int fd);
+  Record* records() const;
+
+  Header* mHeader = nullptr;
+  size_t mSize = 0;
+  int mFd = -1;
+  /// Producer side: last position read by the consumer, as seen by the producer
+  uint64_t mCachedTail = 0;
+  /// Consumer side: index in DeviceMetricsInfo of each registered metric
+  std::vector<size_t> mInfoIndex;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DEVICEMETRICSRING_H_
@@ -68,6 +68,13 @@ struct DeviceState {
   /// ComputingQuotaOffers which should be removed
   /// from the queue.
   std::vector<ComputingQuotaConsumer> offerConsumers;
+  /// Minimum interval between two timeslices, in microseconds, requested
+  /// by the driver to avoid overloading the devices downstream.
+  /// 0 means no limit.
+  uint64_t timesliceInterval = 0;
+  /// When the next timeslice is allowed to be processed, in microseconds
+  /// of uv_hrtime.
+  uint64_t nextTimesliceAllowed = 0;
 
   // The libuv event loop which serves this device.
   uv_loop_t* loop = nullptr;
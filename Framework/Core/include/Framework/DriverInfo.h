@@ -25,6 +25,7 @@
 #include "Framework/DispatchPolicy.h"
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/LogParsingHelpers.h"
+#include "Framework/TimesliceTraceHelpers.h"
 #include "DataProcessorInfo.h"
 #include "ResourcePolicy.h"
 
@@ -146,6 +147,14 @@ struct DriverInfo {
   unsigned short resourcesMonitoringInterval = 0;
   /// Metrics gathering dump to disk interval
   unsigned short resourcesMonitoringDumpInterval = 0;
+  /// Number of records of the shared memory ring for the metrics
+  /// of each device. 0 means metrics are only sent as text.
+  size_t metricsRingSize = 0;
+  /// Trace one timeslice out of this many through the whole
+  /// topology. 0 means timeslice tracing is disabled.
+  size_t timesliceTracing = 0;
+  /// What happened to the traced timeslices in each device
+  std::vector<TimesliceTraceHop> timesliceTraces;
   /// Port used by the websocket control. 0 means not initialised.
   unsigned short port = 0;
   /// Last port used for tracy
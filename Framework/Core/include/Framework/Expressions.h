@@ -411,6 +411,12 @@ using Selection = std::shared_ptr<gandiva::SelectionVector>;
 Selection createSelection(std::shared_ptr<arrow::Table> const& table, Filter const& expression);
 /// Function for creating gandiva selection from prepared gandiva expressions tree
 Selection createSelection(std::shared_ptr<arrow::Table> const& table, std::shared_ptr<gandiva::Filter> gfilter);
+/// Function for creating gandiva selection from gandiva expression tree. The selection of a given
+/// (canonical) tree on given table data is computed once and shared by all the users in the process,
+/// e.g. all the tasks of the device applying the same filter to the same dataframe.
+Selection createSelection(std::shared_ptr<arrow::Table> const& table, gandiva::NodePtr const& tree);
+/// Number of selections currently shared by createSelection
+size_t getSharedSelectionsCount();
 
 struct ColumnOperationSpec;
 using Operations = std::vector<ColumnOperationSpec>;
@@ -0,0 +1,143 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_FRAMEWORK_GROUPINGINDEXCACHE_H_
+#define O2_FRAMEWORK_GROUPINGINDEXCACHE_H_
+
+#include "Framework/Kernels.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace arrow
+{
+class Buffer;
+class Table;
+} // namespace arrow
+
+namespace o2::framework
+{
+/// Process-wide cache of the GroupingIndex of the tables by their index columns.
+/// The grouping of a given table by a given index column is computed once per
+/// dataframe and reused by every process() call and every task of the device
+/// which groups the same table by the same column.
+/// An entry is identified by the column name, the number of groups and the
+/// memory of the column values (with the offset of the first chunk and the
+/// number of chunks), which the entry keeps referenced. Entries
+/// for which the cache holds the only reference to that memory belong to a
+/// dataframe which is gone and are dropped.
+class GroupingIndexCache
+{
+ public:
+  static GroupingIndexCache& instance();
+
+  /// Get the grouping of @a input by the column @a key for @a fullSize groups,
+  /// building it if it is not yet cached. Throws if the grouping cannot be built.
+  std::shared_ptr<GroupingIndex const> get(char const* key, std::shared_ptr<arrow::Table> const& input, int32_t fullSize);
+
+  void clear();
+  size_t size() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    int32_t fullSize;
+    int64_t offset; // offset of the first chunk in its arrays
+    int nChunks;
+    int64_t nRows;
+    std::shared_ptr<arrow::Buffer> values; // values of the first chunk of the column
+    std::shared_ptr<GroupingIndex const> index;
+  };
+
+  mutable std::mutex mMutex;
+  std::vector<Entry> mEntries;
+};
+
+/// Process-wide cache of the category indices of the block combinations:
+/// pairs of (category, row) sorted by category. They follow the same rules
+/// as the GroupingIndexCache, so the categories of a table are sorted once
+/// per dataframe and shared by all the combinations of that table.
+class CategoryIndexCache
+{
+ public:
+  using CategoryIndex = std::vector<std::pair<uint64_t, uint64_t>>;
+
+  static CategoryIndexCache& instance();
+
+  /// Get the category index of @a input by the column @a key, excluding the
+  /// rows with the @a outsider value (given by its bit pattern) and the
+  /// categories with less than @a minCatSize rows. If it is not yet cached, it
+  /// is created with @a build. Throws if the column does not exist.
+  std::shared_ptr<CategoryIndex const> get(std::string const& key, std::shared_ptr<arrow::Table> const& input, int minCatSize, uint64_t outsider, std::function<CategoryIndex()> const& build);
+
+  void clear();
+  size_t size() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    int minCatSize;
+    uint64_t outsider;
+    int64_t offset; // offset of the first chunk in its arrays
+    int nChunks;
+    int64_t nRows;
+    std::shared_ptr<arrow::Buffer> values; // values of the first chunk of the column
+    std::shared_ptr<CategoryIndex const> index;
+  };
+
+  mutable std::mutex mMutex;
+  std::vector<Entry> mEntries;
+};
+
+/// Process-wide cache of the tables derived from the tables of a dataframe:
+/// the index tables declared with Builds<> and DECLARE_SOA_INDEX_TABLE, and
+/// the extension tables of Spawns<>. A derived table is built once per
+/// dataframe from its source tables and shared by all the tasks of the device
+/// which derive the same table. The source tables are identified by the memory
+/// of the first chunk of their first column (with its offset and the number of
+/// chunks), which the entry keeps referenced.
+class DerivedTableCache
+{
+ public:
+  static DerivedTableCache& instance();
+
+  /// Get the derived table @a label of the @a sources tables. If it is not yet
+  /// cached, it is created with @a build.
+  std::shared_ptr<arrow::Table> get(std::string const& label, std::vector<std::shared_ptr<arrow::Table>> const& sources, std::function<std::shared_ptr<arrow::Table>()> const& build);
+
+  void clear();
+  size_t size() const;
+
+ private:
+  struct Source {
+    void const* values; // values of the first chunk of the first column
+    int64_t offset;
+    int nChunks;
+    int64_t nRows;
+    bool operator==(Source const& other) const { return values == other.values && offset == other.offset && nChunks == other.nChunks && nRows == other.nRows; }
+  };
+  struct Entry {
+    std::string label;
+    std::vector<Source> sources;
+    std::vector<std::shared_ptr<arrow::Buffer>> buffers; // memory of the sources, without repetitions
+    std::shared_ptr<arrow::Table> index;
+  };
+
+  mutable std::mutex mMutex;
+  std::vector<Entry> mEntries;
+};
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_GROUPINGINDEXCACHE_H_
@@ -26,6 +26,9 @@
 #include <TDataMember.h>
 #include <TDataType.h>
 
+#include <gsl/span>
+
+#include <cmath>
 #include <deque>
 
 class TList;
@@ -64,6 +67,52 @@ struct HistFiller {
   static int getBaseElementSize(T* ptr);
 };
 
+//**************************************************************************************************
+/**
+ * Dense buffer for the batched filling of TH1, TH2 and TH3 histograms with fixed bins.
+ * The bins are found without branches with the same arithmetic as TAxis::FindBin; contents, errors
+ * and statistics are accumulated in the buffer and added to the ROOT histogram by flush().
+ */
+//**************************************************************************************************
+struct HistBuffer {
+  // create the buffer of a histogram, nullptr if its axes are not fixed and non-extendable
+  static std::shared_ptr<HistBuffer> create(TH1* hist);
+
+  // whether the buffer can be filled with this number of columns (positions and optionally weights)
+  bool accepts(size_t nColumns) const { return nColumns == mDim || nColumns == mDim + 1; }
+
+  // fill with one column per dimension, the last column holds the weights if there is one more
+  void fill(gsl::span<const gsl::span<const float>> columns);
+
+  // add the buffered content to the histogram and reset the buffer
+  void flush();
+
+ private:
+  template <int D>
+  void fillImpl(gsl::span<const gsl::span<const float>> columns, bool weighted);
+
+  int findBin(int dim, double x) const
+  {
+    // -1 for underflow and mNBins for overflow, NaN is sent to the overflow
+    double pos = std::fmax(-1., std::fmin(mNBins[dim] * (x - mMin[dim]) / mRange[dim], mNBins[dim]));
+    return static_cast<int>(pos + 1.);
+  }
+
+  TH1* mHist = nullptr;
+  size_t mDim = 0;
+  std::array<int, 3> mNBins{};
+  std::array<double, 3> mMin{};
+  std::array<double, 3> mRange{};
+  std::array<int, 3> mStride{};
+  bool mStatOverflows = false;
+  bool mFilled = false;
+  bool mNonUnitWeights = false;
+  double mEntries = 0.;
+  std::array<double, 11> mStats{}; // same layout as TH1::GetStats
+  std::vector<double> mSumw;
+  std::vector<double> mSumw2;
+};
+
 //**************************************************************************************************
 /**
  * HistogramRegistry for storing and filling histograms of any type.
@@ -123,6 +172,14 @@ class HistogramRegistry
   template <typename... Cs, typename T>
   void fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill hist with arrays of values, one per dimension (if weight was requested it must be the last array)
+  // TH1, TH2 and TH3 with fixed bins are filled through a buffer which is added to the histogram when it is retrieved or sent
+  template <typename... Ts>
+  void fillBatch(const HistName& histName, const Ts&... positionAndWeight);
+
+  // add the buffered content to the histograms
+  void flush();
+
   // get rough estimate for size of histogram stored in registry
   double getSize(const HistName& histName, double fillFraction = 1.);
 
@@ -132,6 +189,9 @@ class HistogramRegistry
   // print summary of the histograms stored in registry
   void print(bool showAxisDetails = false);
 
+  // add the content of the histograms of a registry with identical layout (e.g. the one of a worker task)
+  void merge(HistogramRegistry& other);
+
   // lookup distance counter for benchmarking
   mutable uint32_t lookup = 0;
 
@@ -150,6 +210,17 @@ class HistogramRegistry
   template <typename T>
   uint32_t getHistIndex(const T& histName);
 
+  // fill the histogram at position idx with arrays of values
+  void fillBuffered(uint32_t idx, gsl::span<const gsl::span<const float>> columns);
+
+  // add the buffered content to the histogram at position idx
+  void flush(uint32_t idx)
+  {
+    if (mRegistryBuffer[idx]) {
+      mRegistryBuffer[idx]->flush();
+    }
+  }
+
   constexpr uint32_t imask(uint32_t i) const
   {
     return i & REGISTRY_BITMASK;
@@ -177,6 +248,7 @@ class HistogramRegistry
   static constexpr uint32_t MAX_REGISTRY_SIZE{REGISTRY_BITMASK + 1};
   std::array<uint32_t, MAX_REGISTRY_SIZE> mRegistryKey{};
   std::array<HistPtr, MAX_REGISTRY_SIZE> mRegistryValue{};
+  std::array<std::shared_ptr<HistBuffer>, MAX_REGISTRY_SIZE> mRegistryBuffer{};
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -331,7 +403,9 @@ constexpr HistogramRegistry::HistName::HistName(const ConstStr<chars...>& hashed
 template <typename T>
 std::shared_ptr<T>& HistogramRegistry::get(const HistName& histName)
 {
-  if (auto histPtr = std::get_if<std::shared_ptr<T>>(&mRegistryValue[getHistIndex(histName)])) {
+  auto idx = getHistIndex(histName);
+  flush(idx);
+  if (auto histPtr = std::get_if<std::shared_ptr<T>>(&mRegistryValue[idx])) {
     return *histPtr;
   } else {
     throw runtime_error_f(R"(Histogram type specified in get<>(HIST("%s")) does not match the actual type of the histogram!)", histName.str);
@@ -388,5 +462,13 @@ void HistogramRegistry::fill(const HistName& histName, const T& table, const o2:
   std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[getHistIndex(histName)]);
 }
 
+template <typename... Ts>
+void HistogramRegistry::fillBatch(const HistName& histName, const Ts&... positionAndWeight)
+{
+  static_assert(sizeof...(Ts) >= 1 && sizeof...(Ts) <= 5, "Batch filling supports up to 5 arrays of values.");
+  std::array<gsl::span<const float>, sizeof...(Ts)> columns{gsl::span<const float>(positionAndWeight)...};
+  fillBuffered(getHistIndex(histName), columns);
+}
+
 } // namespace o2::framework
 #endif // FRAMEWORK_HISTOGRAMREGISTRY_H_
@@ -18,6 +18,7 @@
 #include "Framework/TableConsumer.h"
 #include "Framework/Traits.h"
 #include "Framework/RuntimeError.h"
+#include "Framework/TypeIdHelpers.h"
 #include "Headers/DataHeader.h"
 
 #include "CommonUtils/BoostSerializer.h"
@@ -42,6 +43,21 @@ namespace framework
 struct InputSpec;
 struct InputSpan;
 
+/// Compiling with DPL_WARN_INPUT_COPIES defined makes every InputRecord::get
+/// which copies a non serialised payload into an owned container emit a
+/// warning, pointing to where a gsl::span over the payload could be used instead.
+#ifdef DPL_WARN_INPUT_COPIES
+template <typename T>
+[[deprecated("the payload is copied into a new container, use gsl::span<T::value_type const> to access it without copy")]] constexpr void payloadCopiedTo()
+{
+}
+#else
+template <typename T>
+constexpr void payloadCopiedTo()
+{
+}
+#endif
+
 /// @class InputRecord
 /// @brief The input API of the Data Processing Layer
 /// This class holds the inputs which are valid for processing. The user can get an
@@ -302,6 +318,7 @@ class InputRecord
         if (method == o2::header::gSerializationMethodNone) {
           // TODO: construct a vector spectator
           // this is a quick solution now which makes a copy of the plain vector data
+          payloadCopiedTo<T>();
           auto* start = reinterpret_cast<typename T::value_type const*>(ref.payload);
           auto* end = start + header->payloadSize / sizeof(typename T::value_type);
           T result(start, end);
@@ -368,6 +385,7 @@ class InputRecord
         } else if constexpr (is_specialization<ValueT, std::vector>::value && has_messageable_value_type<ValueT>::value) {
           // TODO: construct a vector spectator
           // this is a quick solution now which makes a copy of the plain vector data
+          payloadCopiedTo<ValueT>();
           auto* start = reinterpret_cast<typename ValueT::value_type const*>(ref.payload);
           auto* end = start + header->payloadSize / sizeof(typename ValueT::value_type);
           auto container = std::make_unique<ValueT>(start, end);
@@ -377,17 +395,18 @@ class InputRecord
         throw runtime_error("unsupported code path");
       } else if (method == o2::header::gSerializationMethodROOT) {
         // This supports the common case of retrieving a root object and getting pointer.
-        // Notice that this will return a copy of the actual contents of the buffer, because
-        // the buffer is actually serialised, for this reason we return a unique_ptr<T>.
-        // FIXME: does it make more sense to keep ownership of all the deserialised
-        // objects in a single place so that we can avoid duplicate deserializations?
+        // The buffer is actually serialised, so we need to deserialise it. The
+        // deserialised object is kept by the record, so that all the users of
+        // the same message get the same object, without deserialising it again.
         // explicitely specify serialization method to ROOT-serialized because type T
         // is messageable and a different method would be deduced in DataRefUtils
-        // return type with owning Deleter instance, forwarding to default_deleter
-        std::unique_ptr<ValueT const, Deleter<ValueT const>> result(DataRefUtils::as<ROOTSerialized<ValueT>>(ref).release());
+        // return type with non-owning Deleter instance
+        auto const* object = cachedObject<ValueT>(ref, [&ref]() { return DataRefUtils::as<ROOTSerialized<ValueT>>(ref); });
+        std::unique_ptr<ValueT const, Deleter<ValueT const>> result(object, Deleter<ValueT const>(false));
         return result;
       } else if (method == o2::header::gSerializationMethodCCDB) {
-        std::unique_ptr<ValueT const, Deleter<ValueT const>> result(DataRefUtils::as<CCDBSerialized<ValueT>>(ref).release());
+        auto const* object = cachedObject<ValueT>(ref, [&ref]() { return DataRefUtils::as<CCDBSerialized<ValueT>>(ref); });
+        std::unique_ptr<ValueT const, Deleter<ValueT const>> result(object, Deleter<ValueT const>(false));
         return result;
       } else {
         throw runtime_error("Attempt to extract object from message with unsupported serialization type");
@@ -412,8 +431,9 @@ class InputRecord
       } else if (method == o2::header::gSerializationMethodROOT) {
         // explicitely specify serialization method to ROOT-serialized because type T
         // is messageable and a different method would be deduced in DataRefUtils
-        // return type with owning Deleter instance, forwarding to default_deleter
-        std::unique_ptr<T const, Deleter<T const>> result(DataRefUtils::as<ROOTSerialized<T>>(ref).release());
+        // return type with non-owning Deleter instance, the object is kept by the record
+        auto const* object = cachedObject<T>(ref, [&ref]() { return DataRefUtils::as<ROOTSerialized<T>>(ref); });
+        std::unique_ptr<T const, Deleter<T const>> result(object, Deleter<T const>(false));
         return result;
       } else {
         throw runtime_error("Attempt to extract object from message with unsupported serialization type");
@@ -632,8 +652,32 @@ class InputRecord
   }
 
  private:
+  /// @return the object of type T deserialised from the payload of @a ref, invoking
+  /// @a deserialize only the first time it is requested from this record.
+  template <typename T, typename F>
+  T const* cachedObject(DataRef const& ref, F&& deserialize) const
+  {
+    auto typeId = TypeIdHelpers::uniqueId<T>();
+    for (auto& cached : mDeserializedObjects) {
+      if (cached.payload == ref.payload && cached.typeId == typeId) {
+        return static_cast<T const*>(cached.object.get());
+      }
+    }
+    std::shared_ptr<T const> object{deserialize()};
+    mDeserializedObjects.push_back(DeserializedObject{ref.payload, typeId, object});
+    return object.get();
+  }
+
+  struct DeserializedObject {
+    char const* payload;
+    uint32_t typeId;
+    std::shared_ptr<void const> object;
+  };
+
   std::vector<InputRoute> const& mInputsSchema;
   InputSpan& mSpan;
+  /// Objects deserialised from the inputs, valid as long as the record.
+  mutable std::vector<DeserializedObject> mDeserializedObjects;
 };
 
 } // namespace framework
@@ -21,6 +21,7 @@
 #include <arrow/util/variant.h>
 
 #include <string>
+#include <vector>
 
 namespace o2::framework
 {
@@ -104,6 +105,62 @@ auto sliceByColumn(
 
   return arrow::Status::OK();
 }
+
+/// Compact description of the grouping of a table by a sorted index column:
+/// the rows with index value i are the @a sizes[i] rows starting at @a offsets[i].
+/// Rows with a negative index value (unassigned) are not part of any group.
+struct GroupingIndex {
+  std::vector<uint64_t> offsets;
+  std::vector<int> sizes;
+};
+
+/// Build the GroupingIndex of @a input by the column @a key, for @a fullSize groups,
+/// with a single pass over the column values.
+template <typename T>
+arrow::Status makeGroupingIndex(
+  char const* key,
+  std::shared_ptr<arrow::Table> const& input,
+  T fullSize,
+  GroupingIndex& index)
+{
+  using array_t = arrow::NumericArray<typename detail::ConversionTraits<T>::ArrowType>;
+  auto column = input->GetColumnByName(key);
+  if (!column) {
+    return arrow::Status::KeyError("Missing column ", key);
+  }
+  index.offsets.assign(fullSize, 0);
+  index.sizes.assign(fullSize, 0);
+  // the offset of a group is its first row, so that the unassigned (negative) rows can be anywhere
+  uint64_t row = 0;
+  uint64_t lastEnd = 0;
+  for (auto chunk = 0; chunk < column->num_chunks(); ++chunk) {
+    auto values = std::static_pointer_cast<array_t>(column->chunk(chunk));
+    auto const* raw = values->raw_values();
+    for (auto i = 0; i < values->length(); ++i, ++row) {
+      auto v = raw[i];
+      if (v < 0) {
+        continue;
+      }
+      if (v >= fullSize) {
+        return arrow::Status::IndexError("Index ", v, " exceeds the number of groups ", fullSize);
+      }
+      if (index.sizes[v]++ == 0) {
+        index.offsets[v] = row;
+      }
+      lastEnd = row + 1;
+    }
+  }
+  // empty groups are placed where the next group starts, or after the last assigned row
+  uint64_t next = lastEnd;
+  for (int64_t i = int64_t(fullSize) - 1; i >= 0; --i) {
+    if (index.sizes[i]) {
+      next = index.offsets[i];
+    } else {
+      index.offsets[i] = next;
+    }
+  }
+  return arrow::Status::OK();
+}
 } // namespace o2::framework
 
 #endif // O2_FRAMEWORK_KERNELS_H_
@@ -11,6 +11,7 @@
 #ifndef O2_FRAMEWORK_MESSAGECONTEXT_H_
 #define O2_FRAMEWORK_MESSAGECONTEXT_H_
 
+#include "Framework/ChannelSpec.h"
 #include "Framework/DispatchControl.h"
 #include "Framework/FairMQDeviceProxy.h"
 #include "Framework/RuntimeError.h"
@@ -543,12 +544,39 @@ class MessageContext
   /// mMessages then in mScheduledMessages
   o2::header::DataHeader* findMessageHeader(const Output& spec);
 
+  /// Outputs with a payload up to @a threshold bytes which go to the same
+  /// channel are coalesced in a single message when sent. 0 disables it.
+  void setCoalescingThreshold(size_t threshold)
+  {
+    mCoalescingThreshold = threshold;
+  }
+
+  size_t coalescingThreshold() const
+  {
+    return mCoalescingThreshold;
+  }
+
+  /// Large payloads sent on @a channel are compressed with @a compression,
+  /// unless the channel goes through shared memory.
+  void setChannelCompression(std::string const& channel, ChannelCompression compression)
+  {
+    mChannelCompression[channel] = compression;
+  }
+
+  ChannelCompression channelCompression(std::string const& channel) const
+  {
+    auto it = mChannelCompression.find(channel);
+    return it == mChannelCompression.end() ? ChannelCompression::None : it->second;
+  }
+
  private:
   FairMQDeviceProxy mProxy;
   Messages mMessages;
   Messages mScheduledMessages;
   DispatchControl mDispatchControl;
   std::unordered_map<std::string, std::unique_ptr<std::string>> mChannelRefs;
+  size_t mCoalescingThreshold = 0;
+  std::unordered_map<std::string, ChannelCompression> mChannelCompression;
 };
 } // namespace o2::framework
 #endif // O2_FRAMEWORK_MESSAGECONTEXT_H_
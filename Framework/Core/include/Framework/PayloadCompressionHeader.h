@@ -0,0 +1,57 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_PAYLOADCOMPRESSIONHEADER_H_
+#define O2_FRAMEWORK_PAYLOADCOMPRESSIONHEADER_H_
+
+#include "Headers/DataHeader.h"
+
+#include <cstdint>
+
+namespace o2::framework
+{
+
+//__________________________________________________________________________________________________
+/// @struct PayloadCompressionHeader
+/// @brief a BaseHeader marking a payload which was compressed by the sender
+///
+/// Outputs going to a channel configured with a ChannelCompression carry this
+/// header in their stack when their payload was compressed. The payloadSize of
+/// the DataHeader is the one of the compressed payload, the original one is
+/// kept here. The receiving device decompresses the payload and removes this
+/// header before relaying it, so that the InputRecord never sees it.
+///
+/// @ingroup aliceo2_dataformats_dataheader
+struct PayloadCompressionHeader : public header::BaseHeader {
+  constexpr static const o2::header::HeaderType sHeaderType = "DPLCompr";
+  static const uint32_t sVersion = 1;
+
+  /// The ChannelCompression used for the payload
+  uint32_t algorithm;
+  /// The size of the payload before compression
+  uint64_t uncompressedSize;
+
+  PayloadCompressionHeader(uint32_t a = 0, uint64_t s = 0)
+    : BaseHeader(sizeof(PayloadCompressionHeader), sHeaderType, header::gSerializationMethodNone, sVersion),
+      algorithm{a},
+      uncompressedSize{s}
+  {
+  }
+
+  PayloadCompressionHeader(const PayloadCompressionHeader&) = default;
+  static const PayloadCompressionHeader* Get(const BaseHeader* baseHeader)
+  {
+    return (baseHeader->description == PayloadCompressionHeader::sHeaderType) ? static_cast<const PayloadCompressionHeader*>(baseHeader) : nullptr;
+  }
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_PAYLOADCOMPRESSIONHEADER_H_
@@ -13,6 +13,8 @@
 #define o2_framework_ReadoutAdapter_H_DEFINED
 
 #include "ExternalFairMQDeviceProxy.h"
+#include "Headers/DataHeader.h"
+#include <functional>
 
 namespace o2
 {
@@ -25,6 +27,24 @@ namespace framework
 /// is an enumeration of the pages received.
 InjectorFunction readoutAdapter(OutputSpec const& spec);
 
+/// A callback function to get the subSpecification of a raw page from its RDH
+using RDHSubSpecSelector = std::function<header::DataHeader::SubSpecificationType(void const* rdh)>;
+
+/// Default subSpecification of a raw page, the FEE id of the RDH, which is what
+/// DataDistribution uses with RDH version 6.
+header::DataHeader::SubSpecificationType rdhFeeIdSubSpec(void const* rdh);
+
+/// An adapter function for data sent by Readout, which splits the superpages
+/// per link. The RDHs of each superpage are walked once to find the spans of
+/// consecutive raw pages of the same link, which are published with the
+/// origin and description of @a spec and the subSpecification given by
+/// @a subSpecSelector. A superpage with the pages of a single link is adopted
+/// as it is, without copying, the spans of a superpage mixing several links
+/// are copied to new messages. All the superpages received together are in
+/// the same timeslice and the parts for one channel are sent in a single
+/// multipart message.
+InjectorFunction readoutLinkAdapter(OutputSpec const& spec, RDHSubSpecSelector subSpecSelector = rdhFeeIdSubSpec);
+
 } // namespace framework
 } // namespace o2
 
@@ -15,22 +15,41 @@
 #include "Framework/ComputingQuotaOffer.h"
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace o2::framework
 {
 struct DeviceSpec;
 
+/// Where on the node a device should run. The device is pinned to
+/// these resources when it starts.
+struct DeviceAffinity {
+  /// The cpus the device can run on, in the same format as taskset -c
+  /// (e.g. "0-15,32-47"). If empty and a NUMA node is specified, all
+  /// the cpus of the NUMA node.
+  std::string cpus = "";
+  /// The NUMA node memory should be allocated on by default, including
+  /// the pages of the shared memory touched first by this device.
+  /// -1 means no preference.
+  int numaNode = -1;
+  /// The only GPU visible to the device. -1 means all of them.
+  int gpu = -1;
+};
+
 /// A policy which specify how a device matched by
 /// @a matcher should react to a given offer by specifying
 /// a given @a request.
 struct ResourcePolicy {
   using Matcher = std::function<bool(DeviceSpec const& device)>;
+  using Affinity = std::function<DeviceAffinity(DeviceSpec const& device)>;
 
   static std::vector<ResourcePolicy> createDefaultPolicies();
 
   std::string name;
   Matcher matcher;
   ComputingQuotaRequest request;
+  /// Optional placement of the matching devices on the node
+  Affinity affinity = nullptr;
 };
 
 } // namespace o2::framework
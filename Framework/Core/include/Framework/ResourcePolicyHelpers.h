@@ -23,6 +23,8 @@ struct ResourcePolicyHelpers {
   static ResourcePolicy trivialTask(char const* taskMatcher);
   static ResourcePolicy cpuBoundTask(char const* taskMatcher, int maxCPUs = 1);
   static ResourcePolicy sharedMemoryBoundTask(char const* taskMatcher, int maxMemory);
+  /// @return @a policy where the matching devices are placed according to @a affinity
+  static ResourcePolicy withAffinity(ResourcePolicy policy, ResourcePolicy::Affinity affinity);
 };
 
 } // namespace o2::framework
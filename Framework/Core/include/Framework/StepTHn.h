@@ -22,6 +22,8 @@
 
 #include "Framework/Logger.h"
 
+#include <algorithm>
+
 class TArray;
 class TArrayF;
 class TArrayD;
@@ -37,6 +39,9 @@ class StepTHn : public TNamed
   template <typename... Ts>
   void Fill(int iStep, const Ts&... valuesAndWeight);
   void Fill(int iStep, int nParams, double positionAndWeight[]);
+  /// fill nEntries entries at once, values contains the mNVars coordinates of one entry after the other,
+  /// weights (if not null) the weight of each entry
+  void FillN(int iStep, int nEntries, const double* values, const double* weights = nullptr);
 
   THnBase* getTHn(Int_t step, Bool_t sparse = kFALSE)
   {
@@ -48,8 +53,16 @@ class StepTHn : public TNamed
   Int_t getNSteps() { return mNSteps; }
   Int_t getNVar() { return mNVars; }
 
-  TArray* getValues(Int_t step) { return mValues[step]; }
-  TArray* getSumw2(Int_t step) { return mSumw2[step]; }
+  /// the storage of every step is split in chunks of bins, which are only allocated once a bin in them is filled
+  /// the chunk size can only be changed before filling
+  void setChunkSize(Long64_t chunkSize);
+  Long64_t getChunkSize() const { return mChunkSize; }
+  Int_t getNChunks() const { return mNChunks; }
+
+  TArray* getValues(Int_t step, Int_t chunk = 0) { return mValues[step * mNChunks + chunk]; }
+  TArray* getSumw2(Int_t step, Int_t chunk = 0) { return mSumw2[step * mNChunks + chunk]; }
+
+  static constexpr Long64_t DefaultChunkSize = 1 << 16; // bins per storage chunk
 
   StepTHn(const StepTHn& c);
   StepTHn& operator=(const StepTHn& corr);
@@ -62,17 +75,21 @@ class StepTHn : public TNamed
 
  protected:
   void init();
-  virtual TArray* createArray(const TArray* src = nullptr) const = 0;
+  virtual TArray* createArray(Long64_t nBins, const TArray* src = nullptr) const = 0;
   void createTarget(Int_t step, Bool_t sparse);
   void deleteContainers();
+  Long64_t getChunkBins(Int_t chunk) const { return std::min(mChunkSize, mNBins - chunk * mChunkSize); }
 
   Long64_t getGlobalBinIndex(const Int_t* binIdx);
 
-  Long64_t mNBins;  // number of total bins
-  Int_t mNVars;     // number of variables
-  Int_t mNSteps;    // number of selection steps
-  TArray** mValues; //[mNSteps] data container
-  TArray** mSumw2;  //[mNSteps] data container
+  Long64_t mNBins;     // number of total bins
+  Int_t mNVars;        // number of variables
+  Int_t mNSteps;       // number of selection steps
+  Long64_t mChunkSize; // number of bins per storage chunk
+  Int_t mNChunks;      // number of storage chunks per step
+  Int_t mNArrays;      // number of storage chunks of all steps
+  TArray** mValues;    //[mNArrays] data container, chunk c of step s at s * mNChunks + c
+  TArray** mSumw2;     //[mNArrays] data container
 
   THnBase** mTarget; //! target histogram
 
@@ -83,7 +100,7 @@ class StepTHn : public TNamed
 
   THnSparse* mPrototype; // not filled used as prototype histogram for axis functionality etc.
 
-  ClassDef(StepTHn, 1) // THn like container
+  ClassDef(StepTHn, 2) // THn like container
 };
 
 template <class TemplateArray>
@@ -96,16 +113,17 @@ class StepTHnT : public StepTHn
   ~StepTHnT() override = default;
 
  protected:
-  TArray* createArray(const TArray* src = nullptr) const override
+  TArray* createArray(Long64_t nBins, const TArray* src = nullptr) const override
   {
     if (src == nullptr) {
-      return new TemplateArray(mNBins);
+      return new TemplateArray(nBins);
     } else {
       return new TemplateArray(*((TemplateArray*)src));
     }
   }
 
   Long64_t Merge(TCollection* list) override;
+  void addToChunks(TArray** arrays, Int_t step, Long64_t firstBin, const TemplateArray& source);
 
   ClassDef(StepTHnT, 1) // THn like container
 };
@@ -30,6 +30,8 @@
 #include <arrow/table.h>
 #include <arrow/builder.h>
 
+#include <gsl/span>
+
 #include <vector>
 #include <string>
 #include <memory>
@@ -577,6 +579,68 @@ auto constexpr to_tuple(T&& object) noexcept
   }
 }
 
+/// Columnar filler of the arithmetic columns of a TableBuilder.
+/// reserve(n) returns one span per column with room for the next n rows,
+/// which are written in place and then appended to the columns with
+/// commit(n) (n at most the reserved size). The spans are backed by per
+/// column scratch buffers, which are reused for all the batches, so that
+/// every batch costs one bulk copy per column instead of one append per
+/// value.
+template <typename HOLDERS, typename... ARGS>
+class BulkFiller
+{
+ public:
+  BulkFiller(HOLDERS* holders) : mHolders{holders} {}
+
+  std::tuple<gsl::span<ARGS>...> reserve(size_t n)
+  {
+    return reserveHelper(n, std::index_sequence_for<ARGS...>{});
+  }
+
+  void commit(size_t n)
+  {
+    if (!commitHelper(n, std::index_sequence_for<ARGS...>{})) {
+      throw runtime_error("Unable to append to column");
+    }
+  }
+
+ private:
+  template <size_t... Is>
+  std::tuple<gsl::span<ARGS>...> reserveHelper(size_t n, std::index_sequence<Is...>)
+  {
+    bool ok = ((std::get<Is>(mScratch).size() >= n || (std::get<Is>(mScratch).resize(n), true)) && ...);
+    ok = ok && (std::get<Is>(*mHolders).builder->Reserve(n).ok() && ...);
+    if (!ok) {
+      throw runtime_error("Unable to reserve columns");
+    }
+    return {gsl::span<ARGS>(reinterpret_cast<ARGS*>(std::get<Is>(mScratch).data()), n)...};
+  }
+
+  template <size_t... Is>
+  bool commitHelper(size_t n, std::index_sequence<Is...>)
+  {
+    return (append(std::get<Is>(*mHolders), std::get<Is>(mScratch).data(), n).ok() && ...);
+  }
+
+  template <typename HOLDER, typename T>
+  static arrow::Status append(HOLDER& holder, T const* values, size_t n)
+  {
+    if constexpr (std::is_same_v<T, uint8_t>) { // also the scratch of bool columns
+      return holder.builder->AppendValues(reinterpret_cast<const uint8_t*>(values), n, nullptr);
+    } else {
+      using ValueType = typename std::decay_t<decltype(*holder.builder)>::value_type;
+      return holder.builder->AppendValues(reinterpret_cast<const ValueType*>(values), n, nullptr);
+    }
+  }
+
+  /// std::vector<bool> is not contiguous, booleans are stored as bytes as in the BooleanBuilder input
+  template <typename T>
+  using Scratch = std::vector<std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>>;
+
+  HOLDERS* mHolders;
+  std::tuple<Scratch<ARGS>...> mScratch;
+};
+
 /// Helper class which creates a lambda suitable for building
 /// an arrow table from a tuple. This can be used, for example
 /// to build an arrow::Table from a TDataFrame.
@@ -743,6 +807,29 @@ class TableBuilder
     };
   }
 
+  /// Columnar filling of arithmetic columns, see BulkFiller. nRows
+  /// is the number of rows reserved upfront.
+  template <typename... ARGS>
+  auto bulkFill(std::vector<std::string> const& columnNames, size_t nRows = 0)
+  {
+    static_assert((std::is_arithmetic_v<ARGS> && ...), "Only arithmetic columns can be filled in bulk");
+    constexpr int nColumns = sizeof...(ARGS);
+    validate(nColumns, columnNames);
+    mArrays.resize(nColumns);
+    makeBuilders<ARGS...>(columnNames, nRows);
+    makeFinalizer<ARGS...>();
+    return BulkFiller<HoldersTuple<ARGS...>, ARGS...>{(HoldersTuple<ARGS...>*)mHolders};
+  }
+
+  /// Same as above, for the persistent columns of a o2::soa::Table
+  template <typename T>
+  auto bulkCursor(size_t nRows = 0)
+  {
+    using persistent_columns_pack = typename T::table_t::persistent_columns_t;
+    constexpr auto persistent_size = pack_size(persistent_columns_pack{});
+    return bulkCursorHelper<typename soa::PackToTable<persistent_columns_pack>::table>(nRows, std::make_index_sequence<persistent_size>());
+  }
+
   /// Reserve method to expand the columns as needed.
   template <typename... ARGS>
   auto reserve(o2::framework::pack<ARGS...> pack, int s)
@@ -781,6 +868,13 @@ class TableBuilder
     return this->template persist<E>(columnNames);
   }
 
+  template <typename T, size_t... Is>
+  auto bulkCursorHelper(size_t nRows, std::index_sequence<Is...>)
+  {
+    std::vector<std::string> columnNames{pack_element_t<Is, typename T::columns>::columnLabel()...};
+    return this->template bulkFill<typename pack_element_t<Is, typename T::columns>::type...>(columnNames, nRows);
+  }
+
   bool (*mFinalizer)(std::shared_ptr<arrow::Schema> schema, std::vector<std::shared_ptr<arrow::Array>>& arrays, void* holders);
   void* mHolders;
   arrow::MemoryPool* mMemoryPool;
@@ -32,6 +32,9 @@ namespace o2::framework
 //    t2t.addAllBranches();
 //  . t2t.process();
 //
+// When ROOT implicit multi-threading is enabled, the baskets of the branches
+// are compressed in parallel by TTree::Fill.
+//
 // .............................................................................
 class BranchIterator
 {
@@ -133,7 +136,8 @@ class TreeToTable
   // add all branches in @a tree as columns
   bool addAllColumns(TTree* tree);
 
-  // do the looping with the TTreeReader
+  // copy the branches of fixed-size values basket by basket with the bulk
+  // reading API, and the other branches entry by entry with the TTreeReader
   void fill(TTree* tree);
 
   // create the table
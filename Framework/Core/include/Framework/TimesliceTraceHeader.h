@@ -0,0 +1,56 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_TIMESLICETRACEHEADER_H_
+#define O2_FRAMEWORK_TIMESLICETRACEHEADER_H_
+
+#include "Headers/DataHeader.h"
+
+#include <cstdint>
+
+namespace o2::framework
+{
+
+//__________________________________________________________________________________________________
+/// @struct TimesliceTraceHeader
+/// @brief a BaseHeader with the tracing information of a timeslice
+///
+/// When timeslice tracing is enabled (--timeslice-tracing), the outputs of the
+/// traced timeslices carry this header in their stack, next to the
+/// DataProcessingHeader, so that every device knows when the timeslice
+/// entered the topology and how many devices it went through before.
+///
+/// @ingroup aliceo2_dataformats_dataheader
+struct TimesliceTraceHeader : public header::BaseHeader {
+  constexpr static const o2::header::HeaderType sHeaderType = "DPLTrace";
+  static const uint32_t sVersion = 1;
+
+  /// When the timeslice entered the topology, in microseconds of the steady clock
+  uint64_t origin;
+  /// How many devices processed the timeslice before the one creating the message
+  uint32_t hops;
+
+  TimesliceTraceHeader(uint64_t o = 0, uint32_t h = 0)
+    : BaseHeader(sizeof(TimesliceTraceHeader), sHeaderType, header::gSerializationMethodNone, sVersion),
+      origin{o},
+      hops{h}
+  {
+  }
+
+  TimesliceTraceHeader(const TimesliceTraceHeader&) = default;
+  static const TimesliceTraceHeader* Get(const BaseHeader* baseHeader)
+  {
+    return (baseHeader->description == TimesliceTraceHeader::sHeaderType) ? static_cast<const TimesliceTraceHeader*>(baseHeader) : nullptr;
+  }
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_TIMESLICETRACEHEADER_H_
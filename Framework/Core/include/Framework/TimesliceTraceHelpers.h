@@ -0,0 +1,77 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_TIMESLICETRACEHELPERS_H_
+#define O2_FRAMEWORK_TIMESLICETRACEHELPERS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// What happened to a traced timeslice in a given device. All the times are
+/// in microseconds of the steady clock, which is the same for all the
+/// devices on a node.
+struct TimesliceTraceHop {
+  /// The device, as index in the workflow. Filled by the driver.
+  size_t device = 0;
+  uint64_t timeslice = 0;
+  /// When the timeslice entered the topology
+  uint64_t origin = 0;
+  /// How many devices processed the timeslice before this one
+  uint32_t hops = 0;
+  /// When the first and the last input of the timeslice were relayed.
+  /// The difference is the time spent waiting for the completion policy.
+  uint64_t firstInput = 0;
+  uint64_t lastInput = 0;
+  /// When the computation started and ended. The time between the
+  /// last input and the start is spent queueing in the DataRelayer.
+  uint64_t start = 0;
+  uint64_t end = 0;
+  /// When the outputs were sent (including the time being backpressured)
+  uint64_t sent = 0;
+};
+
+/// Helpers to follow a timeslice along the whole topology. Each device
+/// reports a "[TRACE] " line for each traced timeslice, the driver collects
+/// them and exports them in the Chrome trace format, which can be
+/// opened with chrome://tracing or https://ui.perfetto.dev.
+struct TimesliceTraceHelpers {
+  /// The current time, in microseconds of the steady clock
+  static uint64_t now();
+
+  /// @return true if @a timeslice must be traced when tracing one timeslice out of @a every.
+  /// All the devices make the same choice, so a traced timeslice is traced everywhere.
+  static bool isTraced(size_t every, uint64_t timeslice)
+  {
+    return every != 0 && (timeslice % every) == 0;
+  }
+
+  /// @return the "[TRACE] " line describing @a hop
+  static std::string formatTrace(TimesliceTraceHop const& hop);
+  /// Parses a line created by formatTrace.
+  /// @return false if @a s is not a trace line
+  static bool parseTrace(std::string_view const s, TimesliceTraceHop& hop);
+
+  /// Writes @a hops in the Chrome trace event format. @a deviceNames are the names
+  /// of the devices, indexed by TimesliceTraceHop::device.
+  static void dumpChromeTrace(std::ostream& out,
+                              std::vector<TimesliceTraceHop> const& hops,
+                              std::vector<std::string> const& deviceNames);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_TIMESLICETRACEHELPERS_H_
@@ -21,6 +21,10 @@ struct TimingInfo {
   size_t timeslice; /// the timeslice associated to current processing
   uint32_t firstTFOrbit = -1; /// the orbit the TF begins
   uint32_t tfCounter = -1;    // the counter associated to a TF
+  /// When the current timeslice is traced: when it entered the topology
+  /// and through how many devices it went, see TimesliceTraceHeader.
+  uint64_t traceOrigin = 0; // 0 when the timeslice is not traced
+  uint32_t traceHops = 0;
 };
 
 #endif // O2_FRAMEWORK_TIMINGINFO_H_
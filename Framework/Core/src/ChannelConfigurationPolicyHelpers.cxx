@@ -84,6 +84,14 @@ ChannelConfigurationPolicyHelpers::OutputChannelModifier ChannelConfigurationPol
   };
 }
 
+ChannelConfigurationPolicyHelpers::OutputChannelModifier ChannelConfigurationPolicyHelpers::compressedPushOutput(FairMQChannelConfigSpec const& spec, ChannelCompression compression)
+{
+  return [push = pushOutput(spec), compression](OutputChannelSpec& channel) {
+    push(channel);
+    channel.compression = compression;
+  };
+}
+
 ChannelConfigurationPolicyHelpers::InputChannelModifier ChannelConfigurationPolicyHelpers::pairInput(FairMQChannelConfigSpec const& spec)
 {
   return [spec](InputChannelSpec& channel) {
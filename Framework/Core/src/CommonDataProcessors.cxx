@@ -37,6 +37,7 @@
 
 #include "TFile.h"
 #include "TTree.h"
+#include "TROOT.h"
 
 #include <ROOT/RSnapshotOptions.hxx>
 #include <ROOT/RDataFrame.hxx>
@@ -285,6 +286,18 @@ DataProcessorSpec
     auto& callbacks = ic.services().get<CallbackService>();
     callbacks.set(CallbackService::Id::EndOfStream, endofdatacb);
 
+    // compress the baskets of the branches in parallel when filling the trees
+    auto nThreads = ic.options().get<int>("aod-writer-threads");
+    if (nThreads > 0) {
+      LOGP(INFO, "Compressing the baskets with {} threads", nThreads);
+      ROOT::EnableImplicitMT(nThreads);
+    }
+    // the parts of the output files are written by one thread each
+    if (dod->getNumberOfParts() > 1 && !dod->isArrowFormat()) {
+      LOGP(INFO, "Writing the trees of each output file in {} parts concurrently", dod->getNumberOfParts());
+      ROOT::EnableThreadSafety();
+    }
+
     // prepare map<uint64_t, uint64_t>(startTime, tfNumber)
     std::map<uint64_t, uint64_t> tfNumbers;
 
@@ -309,6 +322,15 @@ DataProcessorSpec
         tfNumbers.insert(std::pair<uint64_t, uint64_t>(startTime, tfNumber));
       }
 
+      // the trees are filled once all tables are collected, the files in parallel if there are several parts
+      struct TreeToWrite {
+        DataOutputDescriptor* d;
+        std::shared_ptr<arrow::Table> table;
+        FileAndFolder fileAndFolder;
+      };
+      std::vector<TreeToWrite> trees;
+      std::vector<std::unique_ptr<TableConsumer>> consumers; // keep the tables valid until written
+
       // loop over the DataRefs which are contained in pc.inputs()
       for (const auto& ref : pc.inputs()) {
         if (!ref.spec) {
@@ -353,38 +375,85 @@ DataProcessorSpec
         // a table can be saved in multiple ways
         // e.g. different selections of columns to different files
         for (auto d : ds) {
-          auto fileAndFolder = dod->getFileFolder(d, tfNumber);
-          auto treename = fileAndFolder.folderName + d->treename;
-          TableToTree ta2tr(table,
-                            fileAndFolder.file,
-                            treename.c_str());
-
-          if (d->colnames.size() > 0) {
-            for (auto cn : d->colnames) {
-              auto idx = table->schema()->GetFieldIndex(cn);
-              auto col = table->column(idx);
-              auto field = table->schema()->field(idx);
-              if (idx != -1) {
-                ta2tr.addBranch(col, field);
+          if (dod->isArrowFormat()) {
+            auto output = table;
+            if (d->colnames.size() > 0) {
+              std::vector<std::shared_ptr<arrow::Field>> fields;
+              std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+              for (auto cn : d->colnames) {
+                auto idx = table->schema()->GetFieldIndex(cn);
+                if (idx != -1) {
+                  fields.emplace_back(table->schema()->field(idx));
+                  columns.emplace_back(table->column(idx));
+                }
               }
+              output = arrow::Table::Make(std::make_shared<arrow::Schema>(fields, table->schema()->metadata()), columns, table->num_rows());
+            }
+            dod->writeArrowTable(d, tfNumber, output);
+            continue;
+          }
+
+          trees.push_back({d, table, dod->getFileFolder(d, tfNumber)});
+        }
+        consumers.emplace_back(std::move(s));
+      }
+
+      auto writeTree = [](TreeToWrite const& tree) {
+        auto d = tree.d;
+        auto const& table = tree.table;
+        auto treename = tree.fileAndFolder.folderName + d->treename;
+        TableToTree ta2tr(table,
+                          tree.fileAndFolder.file,
+                          treename.c_str());
+
+        if (d->colnames.size() > 0) {
+          for (auto cn : d->colnames) {
+            auto idx = table->schema()->GetFieldIndex(cn);
+            auto col = table->column(idx);
+            auto field = table->schema()->field(idx);
+            if (idx != -1) {
+              ta2tr.addBranch(col, field);
             }
-          } else {
-            ta2tr.addAllBranches();
           }
-          ta2tr.process();
+        } else {
+          ta2tr.addAllBranches();
         }
+        ta2tr.process();
+      };
+
+      // the trees of a file are written by the same thread, in the order of the inputs
+      std::map<TFile*, std::vector<size_t>> treesPerFile;
+      for (size_t i = 0; i < trees.size(); i++) {
+        treesPerFile[trees[i].fileAndFolder.file].push_back(i);
+      }
+      if (dod->getNumberOfParts() < 2 || treesPerFile.size() < 2) {
+        for (auto const& tree : trees) {
+          writeTree(tree);
+        }
+        return;
+      }
+      std::vector<std::thread> writers;
+      for (auto const& fileTrees : treesPerFile) {
+        writers.emplace_back([&trees, &writeTree, &indices = fileTrees.second]() {
+          for (auto i : indices) {
+            writeTree(trees[i]);
+          }
+        });
+      }
+      for (auto& writer : writers) {
+        writer.join();
       }
     });
   }; // end of writerFunction
 
   // the command line options relevant for the writer are global
-  // see runDataProcessing.h
+  // see runDataProcessing.h, only the number of threads is set per device
   DataProcessorSpec spec{
     "internal-dpl-aod-writer",
     outputInputs,
     Outputs{},
     AlgorithmSpec(writerFunction),
-    {}};
+    {ConfigParamSpec{"aod-writer-threads", VariantType::Int, 0, {"Number of threads compressing the baskets, 0 to disable"}}}};
 
   return spec;
 }
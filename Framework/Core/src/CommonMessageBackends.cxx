@@ -47,10 +47,16 @@ o2::framework::ServiceSpec CommonMessageBackends::fairMQBackendSpec()
 {
   return ServiceSpec{
     .name = "fairmq-backend",
-    .init = [](ServiceRegistry& services, DeviceState&, fair::mq::ProgOptions&) -> ServiceHandle {
+    .init = [](ServiceRegistry& services, DeviceState&, fair::mq::ProgOptions& options) -> ServiceHandle {
       auto& device = services.get<RawDeviceService>();
       auto context = new MessageContext(FairMQDeviceProxy{device.device()});
       auto& spec = services.get<DeviceSpec const>();
+      context->setCoalescingThreshold(std::stoull(options.GetProperty<std::string>("dpl-coalesce-outputs", "0")));
+      for (auto& channel : spec.outputChannels) {
+        if (channel.compression != ChannelCompression::None) {
+          context->setChannelCompression(channel.name, channel.compression);
+        }
+      }
 
       auto dispatcher = [&device](FairMQParts&& parts, std::string const& channel, unsigned int index) {
         DataProcessor::doSend(*device.device(), std::move(parts), channel.c_str(), index);
@@ -32,6 +32,7 @@
 #include "HTTPParser.h"
 #include "../src/DataProcessingStatus.h"
 #include "ArrowSupport.h"
+#include "RateLimitingSupport.h"
 #include "DPLMonitoringBackend.h"
 
 #include <Configuration/ConfigurationInterface.h>
@@ -472,6 +473,11 @@ auto flushMetrics(ServiceRegistry& registry, DataProcessingStats& stats) -> void
     monitoring.send({value, fmt::format("data_relayer/{}", si)});
   }
   relayer.sendContextState();
+  // Used by the driver to adapt the rate at which the readers inject timeslices.
+  monitoring.send(Metric{(uint64_t)relayer.getInflightTimeslices(), "inputs/relayed/inflight"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{(uint64_t)relayer.getInflightBytes(), "inputs/relayed/inflight_bytes"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{(uint64_t)relayer.getParallelTimeslices(), "inputs/relayed/capacity"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{stats.processedTimeslices.load(), "processed_timeslices"}.addTag(Key::Subsystem, Value::DPL));
   monitoring.flushBuffer();
   stats.lastMetricFlushedTimestamp.store(stats.beginIterationTimestamp.load());
   O2_SIGNPOST_END(MonitoringStatus::ID, MonitoringStatus::FLUSH, 0, 0, O2_SIGNPOST_RED);
@@ -520,6 +526,7 @@ std::vector<ServiceSpec> CommonServices::defaultServices(int numThreads)
     dataProcessingStats(),
     CommonMessageBackends::fairMQBackendSpec(),
     ArrowSupport::arrowBackendSpec(),
+    RateLimitingSupport::adaptiveRateLimitingSpec(),
     CommonMessageBackends::stringBackendSpec(),
     CommonMessageBackends::rawBufferBackendSpec()};
   if (numThreads) {
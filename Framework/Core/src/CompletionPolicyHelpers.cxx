@@ -77,18 +77,21 @@ CompletionPolicy CompletionPolicyHelpers::defineByName(std::string const& name,
   auto callback = [op](InputSpan const&) -> CompletionPolicy::CompletionOp {
     return op;
   };
+  auto countCallback = [op](size_t, size_t) -> CompletionPolicy::CompletionOp {
+    return op;
+  };
   switch (op) {
     case CompletionPolicy::CompletionOp::Consume:
-      return CompletionPolicy{"always-consume", matcher, callback};
+      return CompletionPolicy{"always-consume", matcher, callback, countCallback};
       break;
     case CompletionPolicy::CompletionOp::Process:
-      return CompletionPolicy{"always-process", matcher, callback};
+      return CompletionPolicy{"always-process", matcher, callback, countCallback};
       break;
     case CompletionPolicy::CompletionOp::Wait:
-      return CompletionPolicy{"always-wait", matcher, callback};
+      return CompletionPolicy{"always-wait", matcher, callback, countCallback};
       break;
     case CompletionPolicy::CompletionOp::Discard:
-      return CompletionPolicy{"always-discard", matcher, callback};
+      return CompletionPolicy{"always-discard", matcher, callback, countCallback};
       break;
   }
   O2_BUILTIN_UNREACHABLE();
@@ -104,7 +107,10 @@ CompletionPolicy CompletionPolicyHelpers::consumeWhenAll(const char* name, Compl
     }
     return CompletionPolicy::CompletionOp::Consume;
   };
-  return CompletionPolicy{name, matcher, callback};
+  auto countCallback = [](size_t present, size_t total) -> CompletionPolicy::CompletionOp {
+    return present == total ? CompletionPolicy::CompletionOp::Consume : CompletionPolicy::CompletionOp::Wait;
+  };
+  return CompletionPolicy{name, matcher, callback, countCallback};
 }
 
 CompletionPolicy CompletionPolicyHelpers::consumeWhenAny(const char* name, CompletionPolicy::Matcher matcher)
@@ -117,7 +123,10 @@ CompletionPolicy CompletionPolicyHelpers::consumeWhenAny(const char* name, Compl
     }
     return CompletionPolicy::CompletionOp::Wait;
   };
-  return CompletionPolicy{name, matcher, callback};
+  auto countCallback = [](size_t present, size_t) -> CompletionPolicy::CompletionOp {
+    return present > 0 ? CompletionPolicy::CompletionOp::Consume : CompletionPolicy::CompletionOp::Wait;
+  };
+  return CompletionPolicy{name, matcher, callback, countCallback};
 }
 
 CompletionPolicy CompletionPolicyHelpers::processWhenAny(const char* name, CompletionPolicy::Matcher matcher)
@@ -136,7 +145,15 @@ CompletionPolicy CompletionPolicyHelpers::processWhenAny(const char* name, Compl
     }
     return CompletionPolicy::CompletionOp::Process;
   };
-  return CompletionPolicy{name, matcher, callback};
+  auto countCallback = [](size_t present, size_t total) -> CompletionPolicy::CompletionOp {
+    if (present == total) {
+      return CompletionPolicy::CompletionOp::Consume;
+    } else if (present == 0) {
+      return CompletionPolicy::CompletionOp::Wait;
+    }
+    return CompletionPolicy::CompletionOp::Process;
+  };
+  return CompletionPolicy{name, matcher, callback, countCallback};
 }
 
 } // namespace framework
@@ -10,10 +10,13 @@
 // or submit itself to any jurisdiction.
 
 #include "DPLMonitoringBackend.h"
+#include "Framework/DeviceMetricsRing.h"
 #include "Framework/DriverClient.h"
 #include "Framework/ServiceRegistry.h"
 #include <fmt/format.h>
+#include <cstdlib>
 #include <sstream>
+#include <fcntl.h>
 
 namespace o2::framework
 {
@@ -35,8 +38,18 @@ inline unsigned long DPLMonitoringBackend::convertTimestamp(const std::chrono::t
 DPLMonitoringBackend::DPLMonitoringBackend(ServiceRegistry& registry)
   : mRegistry{registry}
 {
+  // The descriptor is only for us: make sure it is neither reused by
+  // whatever we might exec nor inherited via the environment.
+  if (char* ringFd = getenv(DeviceMetricsRing::FD_ENV)) {
+    int fd = atoi(ringFd);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    unsetenv(DeviceMetricsRing::FD_ENV);
+    mRing = DeviceMetricsRing::attach(fd);
+  }
 }
 
+DPLMonitoringBackend::~DPLMonitoringBackend() = default;
+
 void DPLMonitoringBackend::addGlobalTag(std::string_view name, std::string_view value)
 {
   // FIXME: tags are ignored by DPL in any case...
@@ -50,8 +63,52 @@ void DPLMonitoringBackend::send(std::vector<o2::monitoring::Metric>&& metrics)
   }
 }
 
+bool DPLMonitoringBackend::sendToRing(o2::monitoring::Metric const& metric)
+{
+  if (metric.getValuesSize() != 1) {
+    return false;
+  }
+  DeviceMetricsRing::Record record;
+  bool isNumeric = std::visit(overloaded{
+                                [&record](int value) {
+                                  record.type = MetricType::Int;
+                                  record.intValue = value;
+                                  return true;
+                                },
+                                [&record](double value) {
+                                  record.type = MetricType::Float;
+                                  record.floatValue = value;
+                                  return true;
+                                },
+                                [&record](uint64_t value) {
+                                  record.type = MetricType::Uint64;
+                                  record.uint64Value = value;
+                                  return true;
+                                },
+                                [](auto const&) { return false; }},
+                              metric.getValues().front().second);
+  if (!isNumeric) {
+    return false;
+  }
+  record.timestamp = convertTimestamp(metric.getTimestamp());
+
+  std::lock_guard<std::mutex> lock(mRingMutex);
+  auto mi = mRingMetrics.find(metric.getName());
+  if (mi == mRingMetrics.end()) {
+    mi = mRingMetrics.emplace(metric.getName(), mRing->registerMetric(metric.getName())).first;
+  }
+  if (mi->second < 0) {
+    return false;
+  }
+  record.metricIndex = mi->second;
+  return mRing->push(record);
+}
+
 void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
 {
+  if (mRing && sendToRing(metric)) {
+    return;
+  }
   std::ostringstream mStream;
   mStream << "[METRIC] " << metric.getName();
   for (auto& value : metric.getValues()) {
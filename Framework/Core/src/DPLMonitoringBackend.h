@@ -12,14 +12,21 @@
 #define O2_FRAMEWORK_DPLMONITORINGBACKEND_H_
 
 #include "Monitoring/Backend.h"
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace o2::framework
 {
 
 struct ServiceRegistry;
+class DeviceMetricsRing;
 
 /// \brief Prints metrics to standard output via std::cout
+///
+/// Numeric metrics are written instead to the shared memory ring provided
+/// by the driver, when there is one and it is not full.
 class DPLMonitoringBackend final : public o2::monitoring::Backend
 {
  public:
@@ -27,7 +34,7 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   DPLMonitoringBackend(ServiceRegistry& registry);
 
   /// Default destructor
-  ~DPLMonitoringBackend() override = default;
+  ~DPLMonitoringBackend() override;
 
   /// Prints metric
   /// \param metric           reference to metric object
@@ -48,9 +55,16 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   /// \return             timestamp as unsigned long (miliseconds from epoch)
   unsigned long convertTimestamp(const std::chrono::time_point<std::chrono::system_clock>& timestamp);
 
+  /// Writes a single valued numeric metric to the metrics ring
+  /// \return             false if the metric must be sent as text
+  bool sendToRing(const o2::monitoring::Metric& metric);
+
   std::string mTagString;    ///< Global tagset (common for each metric)
   const std::string mPrefix; ///< Metric prefix
   ServiceRegistry& mRegistry;
+  std::unique_ptr<DeviceMetricsRing> mRing;             ///< Binary channel to the driver, if any
+  std::unordered_map<std::string, int> mRingMetrics;    ///< Index in the ring of each metric, -1 if it did not fit
+  std::mutex mRingMutex;                                ///< The ring has a single producer
 };
 
 } // namespace o2::framework
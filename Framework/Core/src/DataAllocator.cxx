@@ -16,6 +16,7 @@
 #include "Framework/ArrowContext.h"
 #include "Framework/DataSpecUtils.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/TimesliceTraceHeader.h"
 #include "Headers/Stack.h"
 #include "FairMQResizableBuffer.h"
 
@@ -107,6 +108,10 @@ FairMQMessagePtr DataAllocator::headerMessageFromOutput(Output const& spec,
   auto& context = mRegistry->get<MessageContext>();
 
   auto channelAlloc = o2::pmr::getTransportAllocator(context.proxy().getTransport(channel, 0));
+  if (mTimingInfo->traceOrigin) {
+    TimesliceTraceHeader trace{mTimingInfo->traceOrigin, mTimingInfo->traceHops};
+    return o2::pmr::getMessage(o2::header::Stack{channelAlloc, dh, dph, trace, spec.metaHeader});
+  }
   return o2::pmr::getMessage(o2::header::Stack{channelAlloc, dh, dph, spec.metaHeader});
 }
 
@@ -256,6 +261,23 @@ void DataAllocator::snapshot(const Output& spec, const char* payload, size_t pay
   addPartToContext(std::move(payloadMessage), spec, serializationMethod);
 }
 
+void DataAllocator::forward(const Output& spec, const FairMQMessage& payload,
+                            o2::header::SerializationMethod serializationMethod)
+{
+  std::string const& channel = matchDataHeader(spec, mTimingInfo->timeslice);
+  auto* transport = mRegistry->get<MessageContext>().proxy().getTransport(channel);
+  FairMQMessagePtr payloadMessage;
+  if (transport->GetType() == payload.GetType()) {
+    payloadMessage = transport->CreateMessage();
+    payloadMessage->Copy(payload);
+  } else {
+    payloadMessage = transport->CreateMessage(payload.GetSize(), fair::mq::Alignment{64});
+    memcpy(payloadMessage->GetData(), payload.GetData(), payload.GetSize());
+  }
+
+  addPartToContext(std::move(payloadMessage), spec, serializationMethod);
+}
+
 Output DataAllocator::getOutputByBind(OutputRef&& ref)
 {
   if (ref.label.empty()) {
@@ -20,6 +20,13 @@
 #include "TGrid.h"
 #include "TObjString.h"
 
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/table.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include <filesystem>
+
 namespace o2
 {
 namespace framework
@@ -91,29 +98,48 @@ bool DataInputDescriptor::setFile(int counter)
   }
 
   // open file
+  // the Arrow IPC files are memory mapped when the tables are read
   auto filename = mfilenames[counter]->fileName;
-  if (mcurrentFile) {
-    if (mcurrentFile->GetName() != filename) {
-      closeInputFile();
-      mcurrentFile = TFile::Open(filename.c_str());
+  if (isArrowFile(counter)) {
+    closeInputFile();
+    if (!std::filesystem::is_directory(filename)) {
+      throw std::runtime_error(fmt::format("Couldn't open file \"{}\"!", filename));
     }
   } else {
-    mcurrentFile = TFile::Open(filename.c_str());
-  }
-  if (!mcurrentFile) {
-    throw std::runtime_error(fmt::format("Couldn't open file \"{}\"!", filename));
+    if (mcurrentFile) {
+      if (mcurrentFile->GetName() != filename) {
+        closeInputFile();
+        mcurrentFile = TFile::Open(filename.c_str());
+      }
+    } else {
+      mcurrentFile = TFile::Open(filename.c_str());
+    }
+    if (!mcurrentFile) {
+      throw std::runtime_error(fmt::format("Couldn't open file \"{}\"!", filename));
+    }
+    mcurrentFile->SetReadaheadSize(50 * 1024 * 1024);
   }
-  mcurrentFile->SetReadaheadSize(50 * 1024 * 1024);
 
   // get the directory names
   if (mfilenames[counter]->numberOfTimeFrames <= 0) {
     std::regex TFRegex = std::regex("DF_[0-9]+");
-    TList* keyList = mcurrentFile->GetListOfKeys();
+    std::vector<std::string> folderNames;
+    if (mcurrentFile) {
+      for (auto key : *mcurrentFile->GetListOfKeys()) {
+        folderNames.emplace_back(((TObjString*)key)->GetString().Data());
+      }
+    } else {
+      for (auto const& entry : std::filesystem::directory_iterator(filename)) {
+        if (entry.is_directory()) {
+          folderNames.emplace_back(entry.path().filename().string());
+        }
+      }
+    }
 
     // extract TF numbers and sort accordingly
-    for (auto key : *keyList) {
-      if (std::regex_match(((TObjString*)key)->GetString().Data(), TFRegex)) {
-        auto folderNumber = std::stoul(std::string(((TObjString*)key)->GetString().Data()).substr(3));
+    for (auto const& folderName : folderNames) {
+      if (std::regex_match(folderName, TFRegex)) {
+        auto folderNumber = std::stoul(folderName.substr(3));
         mfilenames[counter]->listOfTimeFrameNumbers.emplace_back(folderNumber);
       }
     }
@@ -170,6 +196,66 @@ int DataInputDescriptor::getTimeFramesInFile(int counter)
   return mfilenames.at(counter)->numberOfTimeFrames;
 }
 
+bool DataInputDescriptor::isArrowFile(int counter)
+{
+  if (counter >= getNumberInputfiles()) {
+    return false;
+  }
+  std::string extension(".arrow");
+  auto const& filename = mfilenames[counter]->fileName;
+  return filename.size() > extension.size() && filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+std::shared_ptr<arrow::Table> DataInputDescriptor::getArrowTable(int counter, int numTF, std::string const& treename)
+{
+  // open file
+  if (!setFile(counter)) {
+    return nullptr;
+  }
+
+  // no TF left
+  if (numTF >= mfilenames[counter]->numberOfTimeFrames) {
+    return nullptr;
+  }
+
+  // a table can be split in several parts <treename>.arrow, <treename>.1.arrow, ...
+  // the record batches of the memory mapped files are used without copying
+  auto folderName = mfilenames[counter]->fileName + "/" + (mfilenames[counter]->listOfTimeFrameKeys)[numTF] + "/";
+  std::shared_ptr<arrow::Schema> schema;
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int part = 0;; ++part) {
+    auto fileName = folderName + treename + (part == 0 ? "" : "." + std::to_string(part)) + ".arrow";
+    if (part > 0 && !std::filesystem::exists(fileName)) {
+      break;
+    }
+    auto file = arrow::io::MemoryMappedFile::Open(fileName, arrow::io::FileMode::READ);
+    if (!file.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't open Arrow file "{}": {})", fileName, file.status().ToString()));
+    }
+    auto reader = arrow::ipc::RecordBatchFileReader::Open(file.ValueOrDie());
+    if (!reader.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't read Arrow file "{}": {})", fileName, reader.status().ToString()));
+    }
+    auto fileReader = reader.ValueOrDie();
+    if (!schema) {
+      schema = fileReader->schema();
+    }
+    for (int ib = 0; ib < fileReader->num_record_batches(); ++ib) {
+      auto batch = fileReader->ReadRecordBatch(ib);
+      if (!batch.ok()) {
+        throw std::runtime_error(fmt::format(R"(Couldn't read record batch {} of Arrow file "{}": {})", ib, fileName, batch.status().ToString()));
+      }
+      batches.emplace_back(batch.ValueOrDie());
+    }
+  }
+
+  auto table = arrow::Table::FromRecordBatches(schema, batches);
+  if (!table.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't create table "{}" from "{}": {})", treename, folderName, table.status().ToString()));
+  }
+  return table.ValueOrDie()->ReplaceSchemaMetadata(std::make_shared<arrow::KeyValueMetadata>(std::vector{std::string{"label"}}, std::vector{treename}));
+}
+
 void DataInputDescriptor::closeInputFile()
 {
   if (mcurrentFile) {
@@ -583,6 +669,36 @@ TTree* DataInputDirector::getDataTree(header::DataHeader dh, int counter, int nu
   return tree;
 }
 
+bool DataInputDirector::isArrowFile(header::DataHeader dh, int counter)
+{
+  auto didesc = getDataInputDescriptor(dh);
+  // if NOT match then use defaultDataInputDescriptor
+  if (!didesc) {
+    didesc = mdefaultDataInputDescriptor;
+  }
+
+  return didesc->isArrowFile(counter);
+}
+
+std::shared_ptr<arrow::Table> DataInputDirector::getArrowTable(header::DataHeader dh, int counter, int numTF)
+{
+  std::string treename;
+
+  auto didesc = getDataInputDescriptor(dh);
+  if (didesc) {
+    // if match then use filename and treename from DataInputDescriptor
+    treename = didesc->treename;
+  } else {
+    // if NOT match then use
+    //  . filename from defaultDataInputDescriptor
+    //  . treename from DataHeader
+    didesc = mdefaultDataInputDescriptor;
+    treename = aod::datamodel::getTreeName(dh);
+  }
+
+  return didesc->getArrowTable(counter, numTF, treename);
+}
+
 void DataInputDirector::closeInputFiles()
 {
   mdefaultDataInputDescriptor->closeInputFile();
@@ -14,6 +14,15 @@
 #include "rapidjson/document.h"
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/filereadstream.h"
+#include "rapidjson/stringbuffer.h"
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/table.h>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
 
 namespace o2
 {
@@ -48,6 +57,7 @@ DataOutputDescriptor::DataOutputDescriptor(std::string inString)
     return;
   }
   auto tableString = iter1->str();
+  tablestring = tableString;
   matcher = DataDescriptorQueryBuilder::buildNode(tableString);
 
   // get the table name
@@ -140,9 +150,12 @@ void DataOutputDirector::reset()
 {
   mDataOutputDescriptors.clear();
   mfilenameBases.clear();
+  mpartFilenameBases.clear();
   mtreeFilenames.clear();
   closeDataFiles();
   mfilePtrs.clear();
+  marrowFileParts.clear();
+  marrowDirectories.clear();
   mfilenameBase = std::string("");
 };
 
@@ -314,6 +327,16 @@ std::tuple<std::string, std::string, int> DataOutputDirector::readJsonDocument(D
     }
   }
 
+  itemName = "resfileformat";
+  if (dodirItem.HasMember(itemName)) {
+    if (dodirItem[itemName].IsString()) {
+      setFileFormat(dodirItem[itemName].GetString());
+    } else {
+      LOGP(ERROR, "Check the JSON document! Item \"{}\" must be a string!", itemName);
+      return memptyanswer;
+    }
+  }
+
   itemName = "ntfmerge";
   if (dodirItem.HasMember(itemName)) {
     if (dodirItem[itemName].IsNumber()) {
@@ -434,8 +457,8 @@ FileAndFolder DataOutputDirector::getFileFolder(DataOutputDescriptor* dodesc, ui
   // initialisation
   FileAndFolder fileAndFolder;
 
-  // search dodesc->filename in mfilenameBases and return corresponding filePtr
-  auto it = std::find(mfilenameBases.begin(), mfilenameBases.end(), dodesc->getFilenameBase());
+  // search the (part) filename of dodesc in mfilenameBases and return corresponding filePtr
+  auto it = std::find(mfilenameBases.begin(), mfilenameBases.end(), getPartFilenameBase(dodesc));
   if (it != mfilenameBases.end()) {
     int ind = std::distance(mfilenameBases.begin(), it);
     if (!mfilePtrs[ind]->IsOpen()) {
@@ -456,19 +479,172 @@ FileAndFolder DataOutputDirector::getFileFolder(DataOutputDescriptor* dodesc, ui
   return fileAndFolder;
 }
 
+std::string DataOutputDirector::getPartFilenameBase(DataOutputDescriptor* dodesc)
+{
+  auto it = std::find(mDataOutputDescriptors.begin(), mDataOutputDescriptors.end(), dodesc);
+  if (it != mDataOutputDescriptors.end() && mpartFilenameBases.size() == mDataOutputDescriptors.size()) {
+    return mpartFilenameBases[std::distance(mDataOutputDescriptors.begin(), it)];
+  }
+  return dodesc->getFilenameBase();
+}
+
+void DataOutputDirector::setFileFormat(std::string fileformat)
+{
+  if (fileformat != "root" && fileformat != "arrow") {
+    LOGP(ERROR, "Unknown file format \"{}\", the supported formats are root and arrow!", fileformat);
+    return;
+  }
+  mfileFormat = fileformat;
+}
+
+void DataOutputDirector::writeArrowTable(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::shared_ptr<arrow::Table> const& table)
+{
+  auto directory = dodesc->getFilenameBase() + ".arrow/";
+  auto folderName = directory + "DF_" + std::to_string(folderNumber) + "/";
+  auto key = folderName + dodesc->treename;
+
+  // the parts of an earlier job would be read together with the new ones, so a recreated output starts from an empty directory
+  if (marrowDirectories.insert(directory).second && mfileMode == "RECREATE") {
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+    if (ec) {
+      throw std::runtime_error(fmt::format(R"(Couldn't remove the existing output "{}": {})", directory, ec.message()));
+    }
+  }
+
+  // the files of the other folders of this output are complete
+  // if a folder is written again the table is continued in a new part <treename>.<part>.arrow
+  for (auto it = marrowFiles.begin(); it != marrowFiles.end();) {
+    if (it->first.rfind(directory, 0) == 0 && it->first.rfind(folderName, 0) != 0) {
+      closeArrowFile(it->second);
+      it = marrowFiles.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto& arrowFile = marrowFiles[key];
+  if (!arrowFile.writer) {
+    auto part = marrowFileParts[key]++;
+    auto fileName = key + (part == 0 ? "" : "." + std::to_string(part)) + ".arrow";
+    if (part == 0 && (mfileMode == "NEW" || mfileMode == "CREATE") && std::filesystem::exists(fileName)) {
+      throw std::runtime_error(fmt::format(R"(File "{}" already exists!)", fileName));
+    }
+    std::filesystem::create_directories(folderName);
+    auto stream = arrow::io::FileOutputStream::Open(fileName);
+    if (!stream.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't create file "{}": {})", fileName, stream.status().ToString()));
+    }
+    arrowFile.stream = stream.ValueOrDie();
+#if ARROW_VERSION_MAJOR < 3
+    auto writer = arrow::ipc::NewFileWriter(arrowFile.stream.get(), table->schema());
+#else
+    auto writer = arrow::ipc::MakeFileWriter(arrowFile.stream.get(), table->schema());
+#endif
+    if (!writer.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't create writer for file "{}": {})", fileName, writer.status().ToString()));
+    }
+    arrowFile.writer = writer.ValueOrDie();
+  }
+
+  auto status = arrowFile.writer->WriteTable(*table);
+  if (!status.ok()) {
+    throw std::runtime_error(fmt::format(R"(Unable to write table "{}": {})", key, status.ToString()));
+  }
+}
+
+void DataOutputDirector::closeArrowFile(ArrowFile& arrowFile)
+{
+  if (arrowFile.writer) {
+    auto status = arrowFile.writer->Close();
+    if (!status.ok()) {
+      LOGP(ERROR, "Unable to close Arrow file: {}", status.ToString());
+    }
+  }
+  if (arrowFile.stream) {
+    auto status = arrowFile.stream->Close();
+    if (!status.ok()) {
+      LOGP(ERROR, "Unable to close Arrow file: {}", status.ToString());
+    }
+  }
+  arrowFile.writer.reset();
+  arrowFile.stream.reset();
+}
+
 void DataOutputDirector::closeDataFiles()
 {
+  // the files which were split in parts and written need an index
+  std::set<std::string> splitFilenameBases;
+  if (mnumberOfParts > 1 && mpartFilenameBases.size() == mDataOutputDescriptors.size()) {
+    for (size_t i = 0; i < mDataOutputDescriptors.size(); i++) {
+      auto it = std::find(mfilenameBases.begin(), mfilenameBases.end(), mpartFilenameBases[i]);
+      if (it != mfilenameBases.end() && mfilePtrs[std::distance(mfilenameBases.begin(), it)]->IsOpen()) {
+        splitFilenameBases.insert(mDataOutputDescriptors[i]->getFilenameBase());
+      }
+    }
+  }
+
   for (auto filePtr : mfilePtrs) {
     if (filePtr) {
       filePtr->Close();
     }
   }
+  for (auto& [key, arrowFile] : marrowFiles) {
+    closeArrowFile(arrowFile);
+  }
+  marrowFiles.clear();
+
+  for (auto const& fnb : splitFilenameBases) {
+    writePartsIndex(fnb);
+  }
+}
+
+void DataOutputDirector::writePartsIndex(std::string const& filenameBase)
+{
+  // the trees of the part 0 are in <filename>.root, the default input file
+  // the other trees are found with an InputDescriptor each
+  StringBuffer buffer;
+  PrettyWriter<StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("InputDirector");
+  writer.StartObject();
+  writer.Key("resfiles");
+  writer.String((filenameBase + ".root").c_str());
+  writer.Key("InputDescriptors");
+  writer.StartArray();
+  for (size_t i = 0; i < mDataOutputDescriptors.size(); i++) {
+    auto dodesc = mDataOutputDescriptors[i];
+    if (dodesc->getFilenameBase() != filenameBase || mpartFilenameBases[i] == filenameBase) {
+      continue;
+    }
+    writer.StartObject();
+    writer.Key("table");
+    writer.String(dodesc->tablestring.c_str());
+    writer.Key("treename");
+    writer.String(dodesc->treename.c_str());
+    writer.Key("resfiles");
+    writer.String((mpartFilenameBases[i] + ".root").c_str());
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+  writer.EndObject();
+
+  auto fileName = filenameBase + "_index.json";
+  std::ofstream indexFile(fileName);
+  indexFile << buffer.GetString() << "\n";
+  if (!indexFile.good()) {
+    LOGP(ERROR, "Unable to write the index \"{}\" of the parts of \"{}.root\"!", fileName, filenameBase);
+    return;
+  }
+  LOGP(INFO, "The trees of \"{}.root\" are distributed over several files, use --aod-reader-json {} to read them", filenameBase, fileName);
 }
 
 void DataOutputDirector::printOut()
 {
   LOGP(INFO, "DataOutputDirector");
   LOGP(INFO, "  Default file name    : {}", mfilenameBase);
+  LOGP(INFO, "  File format          : {}", mfileFormat);
   LOGP(INFO, "  Number of files      : {}", mfilenameBases.size());
 
   LOGP(INFO, "  DataOutputDescriptors: {}", mDataOutputDescriptors.size());
@@ -493,9 +669,15 @@ void DataOutputDirector::setFilenameBase(std::string dfn)
   mfilePtrs.clear();
 
   // loop over DataOutputDescritors
+  // with several parts, the trees of a file are distributed round-robin over <filename>.root, <filename>_1.root, ...
+  mpartFilenameBases.clear();
+  std::map<std::string, int> numberOfTrees;
   for (auto dodesc : mDataOutputDescriptors) {
-    mfilenameBases.emplace_back(dodesc->getFilenameBase());
-    mtreeFilenames.emplace_back(dodesc->treename + dodesc->getFilenameBase());
+    auto fnb = dodesc->getFilenameBase();
+    auto part = isArrowFormat() ? 0 : numberOfTrees[fnb]++ % mnumberOfParts;
+    mpartFilenameBases.emplace_back(part == 0 ? fnb : fnb + "_" + std::to_string(part));
+    mfilenameBases.emplace_back(mpartFilenameBases.back());
+    mtreeFilenames.emplace_back(dodesc->treename + fnb);
   }
 
   // the combination [tree name/file name] must be unique
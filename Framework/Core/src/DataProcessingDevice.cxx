@@ -34,6 +34,8 @@
 #include "Framework/InputSpan.h"
 #include "Framework/Signpost.h"
 #include "Framework/SourceInfoHeader.h"
+#include "Framework/TimesliceTraceHeader.h"
+#include "Framework/TimesliceTraceHelpers.h"
 #include "Framework/Logger.h"
 #include "Framework/DriverClient.h"
 #include "Framework/Monitoring.h"
@@ -41,6 +43,8 @@
 #include "DataProcessingStatus.h"
 #include "DataProcessingHelpers.h"
 #include "DataRelayerHelpers.h"
+#include "MessageCoalescingHelpers.h"
+#include "MessageCompressionHelpers.h"
 
 #include "ScopedExit.h"
 
@@ -55,6 +59,7 @@
 #include <TClonesArray.h>
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -470,6 +475,11 @@ void DataProcessingDevice::InitTask()
   // channel, we can still start an enumeration.
   mWasActive = true;
 
+  // Tracing of the timeslices through the topology. Only the relayer
+  // needs to know which ones are traced.
+  auto traceEvery = std::stoul(fConfig->GetProperty<std::string>("timeslice-tracing", "0"));
+  mRelayer->setTracing(traceEvery);
+
   // We should be ready to run here. Therefore we copy all the
   // required parts in the DataProcessorContext. Eventually we should
   // do so on a per thread basis, with fine grained locks.
@@ -509,6 +519,13 @@ void DataProcessingDevice::PreRun()
 
 void DataProcessingDevice::PostRun()
 {
+  // The rate limit timer is created again if needed on the next run.
+  // Its memory can only be released once the loop is done with it.
+  if (mRateLimitTimer) {
+    uv_timer_stop(mRateLimitTimer);
+    uv_close((uv_handle_t*)mRateLimitTimer, [](uv_handle_t* handle) { free(handle); });
+    mRateLimitTimer = nullptr;
+  }
   mServiceRegistry.get<CallbackService>()(CallbackService::Id::Stop);
   mServiceRegistry.preExitCallbacks();
 }
@@ -563,6 +580,22 @@ bool DataProcessingDevice::ConditionalRun()
     handleRegionCallbacks(mServiceRegistry, mPendingRegionInfos);
   }
 
+  // The driver asked to slow down the injection of new timeslices. Do nothing
+  // until the next one is allowed, making sure we wake up by then.
+  if (mState.loop && mState.timesliceInterval) {
+    auto now = uv_hrtime() / 1000;
+    if (now < mState.nextTimesliceAllowed) {
+      if (mRateLimitTimer == nullptr) {
+        mRateLimitTimer = (uv_timer_t*)malloc(sizeof(uv_timer_t));
+        uv_timer_init(mState.loop, mRateLimitTimer);
+      }
+      uv_timer_start(
+        mRateLimitTimer, [](uv_timer_t*) {}, (mState.nextTimesliceAllowed - now) / 1000 + 1, 0);
+      mWasActive = false;
+      return true;
+    }
+  }
+
   assert(mStreams.size() == mHandles.size());
   /// Decide which task to use
   TaskStreamRef streamRef{-1};
@@ -881,6 +914,21 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
     registry.get<DataProcessingStats>().errorCount++;
   };
 
+  // Payloads which were compressed by the sender are decompressed, and
+  // their PayloadCompressionHeader removed, then outputs which were
+  // coalesced by the sender are split back in their original
+  // (header, payload) pairs, so that the rest does not need to know about
+  // them. The order matters, since the coalesced payloads can be compressed.
+  auto unpackParts = [&info, &reportError]() {
+    auto* transport = info.channel->Transport();
+    for (auto dropped = MessageCompressionHelpers::decompressParts(info.parts, *transport); dropped > 0; --dropped) {
+      reportError("Unable to decompress payload");
+    }
+    for (auto dropped = MessageCoalescingHelpers::splitParts(info.parts, *transport); dropped > 0; --dropped) {
+      reportError("Unable to split coalesced payload");
+    }
+  };
+
   auto handleValidMessages = [&info, &context = context, &relayer = *context.relayer, &reportError](std::vector<InputType> const& types) {
     static WaitBackpressurePolicy policy;
     auto& parts = info.parts;
@@ -943,6 +991,7 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
   // messages). Notice also that we need to act diffently depending on the
   // actual CompletionOp we want to perform. In particular forwarding inputs
   // also gets rid of them from the cache.
+  unpackParts();
   auto inputTypes = getInputTypes();
   if (bool(inputTypes) == false) {
     reportError("Parts should come in couples. Dropping it.");
@@ -970,6 +1019,29 @@ auto calculateInputRecordLatency(InputRecord const& record, uint64_t currentTime
   return result;
 };
 
+/// When a traced timeslice entered the topology and through how many
+/// devices it went, from the headers of its inputs.
+auto traceInputRecord(InputRecord const& record, TimesliceTraceHop& trace) -> void
+{
+  uint64_t origin = -1;
+  uint32_t hops = 0;
+  for (auto& item : record) {
+    if (item.header == nullptr) {
+      continue;
+    }
+    if (auto* th = o2::header::get<TimesliceTraceHeader*>(item.header)) {
+      origin = std::min(origin, th->origin);
+      hops = std::max(hops, th->hops + 1);
+    } else if (auto* dph = o2::header::get<DataProcessingHeader*>(item.header)) {
+      // Produced by something which is not tracing, we only know when.
+      origin = std::min(origin, dph->creation * 1000);
+      hops = std::max(hops, 1u);
+    }
+  }
+  trace.origin = origin != (uint64_t)-1 ? origin : (trace.firstInput ? trace.firstInput : TimesliceTraceHelpers::now());
+  trace.hops = hops;
+}
+
 auto calculateTotalInputRecordSize(InputRecord const& record) -> int
 {
   size_t totalInputSize = 0;
@@ -1036,7 +1108,8 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       if (currentSetOfInputs[i].size() > partindex) {
         return DataRef{nullptr,
                        static_cast<char const*>(currentSetOfInputs[i].at(partindex).header->GetData()),
-                       static_cast<char const*>(currentSetOfInputs[i].at(partindex).payload->GetData())};
+                       static_cast<char const*>(currentSetOfInputs[i].at(partindex).payload->GetData()),
+                       currentSetOfInputs[i].at(partindex).payload.get()};
       }
       return DataRef{nullptr, nullptr, nullptr};
     };
@@ -1061,6 +1134,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     timingInfo->timeslice = timeslice.value;
     timingInfo->tfCounter = relayer->getFirstTFCounterForSlot(i);
     timingInfo->firstTFOrbit = relayer->getFirstTFOrbitForSlot(i);
+    timingInfo->traceOrigin = 0;
   };
 
   // When processing them, timers will have to be cleaned up
@@ -1225,8 +1299,21 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     }
 
     prepareAllocatorForCurrentTimeSlice(TimesliceSlot{action.slot});
+    // The arrival times need to be retrieved before the inputs
+    // are taken out of the relayer.
+    TimesliceTraceHop trace;
+    bool isTraced = action.op != CompletionPolicy::CompletionOp::Discard && context.relayer->isTraced(action.slot);
+    if (isTraced) {
+      trace.timeslice = context.timingInfo->timeslice;
+      std::tie(trace.firstInput, trace.lastInput) = context.relayer->getArrivalTimesForSlot(action.slot);
+    }
     InputSpan span = getInputSpan(action.slot);
     InputRecord record{context.deviceContext->spec->inputs, span};
+    if (isTraced) {
+      traceInputRecord(record, trace);
+      context.timingInfo->traceOrigin = trace.origin;
+      context.timingInfo->traceHops = trace.hops;
+    }
     ProcessingContext processContext{record, *context.registry, *context.allocator};
     {
       ZoneScopedN("service pre processing");
@@ -1243,6 +1330,9 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
 
     uint64_t tStart = uv_hrtime();
     preUpdateStats(action, record, tStart);
+    if (isTraced) {
+      trace.start = TimesliceTraceHelpers::now();
+    }
 
     static bool noCatch = getenv("O2_NO_CATCHALL_EXCEPTIONS") && strcmp(getenv("O2_NO_CATCHALL_EXCEPTIONS"), "0");
 
@@ -1283,9 +1373,17 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     }
 
     postUpdateStats(action, record, tStart);
+    if (isTraced) {
+      trace.end = TimesliceTraceHelpers::now();
+    }
     // We forward inputs only when we consume them. If we simply Process them,
     // we keep them for next message arriving.
     if (action.op == CompletionPolicy::CompletionOp::Consume) {
+      context.registry->get<DataProcessingStats>().processedTimeslices++;
+      auto* state = context.deviceContext->state;
+      if (state->timesliceInterval) {
+        state->nextTimesliceAllowed = std::max(state->nextTimesliceAllowed, uv_hrtime() / 1000) + state->timesliceInterval;
+      }
       context.registry->postDispatchingCallbacks(processContext);
       if (context.deviceContext->spec->forwards.empty() == false) {
         forwardInputs(action.slot, record);
@@ -1296,6 +1394,11 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     } else if (action.op == CompletionPolicy::CompletionOp::Process) {
       cleanTimers(action.slot, record);
     }
+    if (isTraced) {
+      trace.sent = TimesliceTraceHelpers::now();
+      context.registry->get<DriverClient>().tell(TimesliceTraceHelpers::formatTrace(trace));
+      context.timingInfo->traceOrigin = 0;
+    }
   }
   // We now broadcast the end of stream if it was requested
   if (context.deviceContext->state->streaming == StreamingState::EndOfStreaming) {
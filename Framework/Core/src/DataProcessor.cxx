@@ -16,6 +16,8 @@
 #include "Framework/TMessageSerializer.h"
 #include "Framework/ServiceRegistry.h"
 #include "FairMQResizableBuffer.h"
+#include "MessageCoalescingHelpers.h"
+#include "MessageCompressionHelpers.h"
 #include "CommonUtils/BoostSerializer.h"
 #include "Headers/DataHeader.h"
 #include "Headers/DataHeaderHelpers.h"
@@ -53,6 +55,16 @@ void DataProcessor::doSend(FairMQDevice& device, MessageContext& context, Servic
     }
   }
   for (auto& [channel, parts] : outputs) {
+    auto* transport = device.GetChannel(*channel, 0).Transport();
+    if (context.coalescingThreshold()) {
+      MessageCoalescingHelpers::coalesceParts(parts, *transport, context.coalescingThreshold());
+    }
+    // Compressing what goes through shared memory would only cost time.
+    // The receiver decompresses before splitting, so coalesced parts can be compressed as well.
+    auto compression = context.channelCompression(*channel);
+    if (compression != ChannelCompression::None && transport->GetType() != fair::mq::Transport::SHM) {
+      MessageCompressionHelpers::compressParts(parts, *transport, compression);
+    }
     device.Send(parts, *channel, 0);
   }
 }
@@ -22,6 +22,7 @@
 #include "Framework/Logger.h"
 #include "Framework/PartRef.h"
 #include "Framework/TimesliceIndex.h"
+#include "Framework/TimesliceTraceHelpers.h"
 #include "Framework/Signpost.h"
 #include "Framework/RoutingIndices.h"
 #include "DataProcessingStatus.h"
@@ -33,6 +34,7 @@
 
 #include <fmt/format.h>
 #include <gsl/span>
+#include <algorithm>
 #include <numeric>
 #include <string>
 
@@ -44,6 +46,8 @@ namespace o2::framework
 {
 
 constexpr int INVALID_INPUT = -1;
+/// How many different (origin, description, subSpec) we keep the routes for.
+constexpr size_t MAX_ROUTE_CANDIDATES_CACHE = 4096;
 
 // 16 is just some reasonable numer
 // The number should really be tuned at runtime for each processor.
@@ -57,7 +61,8 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     mMetrics{metrics},
     mCompletionPolicy{policy},
     mDistinctRoutesIndex{DataRelayerHelpers::createDistinctRouteIndex(routes)},
-    mInputMatchers{DataRelayerHelpers::createInputMatchers(routes)}
+    mInputMatchers{DataRelayerHelpers::createInputMatchers(routes)},
+    mConcreteMatchers{DataRelayerHelpers::createConcreteMatchers(routes)}
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
 
@@ -144,6 +149,7 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
         part.parts.resize(1);
       }
       expirator.handler(services, part[0], timestamp.value, variables);
+      mPresentInputs[ti]++;
       activity.expiredSlots++;
 
       mTimesliceIndex.markAsDirty(slot, true);
@@ -157,15 +163,27 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
 /// This does the mapping between a route and a InputSpec. The
 /// reason why these might diffent is that when you have timepipelining
 /// you have one route per timeslice, even if the type is the same.
+/// Only the @a candidates for the data need to be checked. For the concrete
+/// ones we already know that origin, description and subSpec match, so we
+/// only need to check the timeslice, as the full matcher would do.
 size_t matchToContext(void* data,
                       std::vector<DataDescriptorMatcher> const& matchers,
                       std::vector<size_t> const& index,
+                      std::vector<DataRelayer::RouteCandidate> const& candidates,
                       VariableContext& context)
 {
-  for (size_t ri = 0, re = index.size(); ri < re; ++ri) {
-    auto& matcher = matchers[index[ri]];
-
-    if (matcher.match(reinterpret_cast<char const*>(data), context)) {
+  static const StartTimeValueMatcher startTimeMatcher{ContextRef{0}};
+  auto const* dh = o2::header::get<DataHeader*>(data);
+  auto const* dph = o2::header::get<DataProcessingHeader*>(data);
+  for (auto& candidate : candidates) {
+    auto ri = candidate.position;
+    bool matched = false;
+    if (candidate.concrete && dh && dph) {
+      matched = startTimeMatcher.match(*dh, *dph, context);
+    } else {
+      matched = matchers[index[ri]].match(reinterpret_cast<char const*>(data), context);
+    }
+    if (matched) {
       context.commit();
       return ri;
     }
@@ -221,17 +239,44 @@ DataRelayer::RelayChoice
 
   // IMPLEMENTATION DETAILS
   //
+  // The routes which can match the incoming data only depend on its
+  // (origin, description, subSpec), so we look them up only once.
+  auto getRouteCandidates = [&candidatesCache = mRouteCandidates,
+                             &concreteMatchers = mConcreteMatchers,
+                             &distinctRoutes = mDistinctRoutesIndex,
+                             &firstPart]() -> std::vector<RouteCandidate> const& {
+    static const std::vector<RouteCandidate> noCandidates;
+    auto const* dh = o2::header::get<DataHeader*>(firstPart->GetData());
+    if (dh == nullptr) {
+      return noCandidates;
+    }
+    ConcreteDataMatcher key{dh->dataOrigin, dh->dataDescription, dh->subSpecification};
+    auto cached = candidatesCache.find(key);
+    if (cached != candidatesCache.end()) {
+      return cached->second;
+    }
+    // Wildcard routes can see an unbounded number of different subSpecs,
+    // do not let the cache grow forever.
+    if (candidatesCache.size() > MAX_ROUTE_CANDIDATES_CACHE) {
+      candidatesCache.clear();
+    }
+    auto candidates = DataRelayerHelpers::createRouteCandidates(key, distinctRoutes, concreteMatchers);
+    return candidatesCache.emplace(key, std::move(candidates)).first->second;
+  };
+  auto const& candidates = getRouteCandidates();
+
   // This returns the identifier for the given input. We use a separate
   // function because while it's trivial now, the actual matchmaking will
   // become more complicated when we will start supporting ranges.
   auto getInputTimeslice = [&matchers = mInputMatchers,
                             &distinctRoutes = mDistinctRoutesIndex,
+                            &candidates,
                             &firstPart,
                             &index](VariableContext& context)
     -> std::tuple<int, TimesliceId> {
     /// FIXME: for the moment we only use the first context and reset
     /// between one invokation and the other.
-    auto input = matchToContext(firstPart->GetData(), matchers, distinctRoutes, context);
+    auto input = matchToContext(firstPart->GetData(), matchers, distinctRoutes, candidates, context);
 
     if (input == INVALID_INPUT) {
       return {
@@ -257,6 +302,7 @@ DataRelayer::RelayChoice
   // hence the first if.
   auto pruneCache = [&cache,
                      &cachedStateMetrics = mCachedStateMetrics,
+                     &presentInputs = mPresentInputs,
                      &numInputTypes,
                      &index,
                      &metrics](TimesliceSlot slot) {
@@ -270,11 +316,15 @@ DataRelayer::RelayChoice
       cache[ai].clear();
       cachedStateMetrics[ai] = CacheEntryStatus::EMPTY;
     }
+    presentInputs[slot.index] = 0;
   };
 
   // Actually save the header / payload in the slot
   auto saveInSlot = [&firstPart,
                      &cachedStateMetrics = mCachedStateMetrics,
+                     &presentInputs = mPresentInputs,
+                     &arrivalTimes = mArrivalTimes,
+                     traceEvery = mTraceEvery,
                      &restOfParts,
                      &restOfPartsSize,
                      &cache,
@@ -283,6 +333,16 @@ DataRelayer::RelayChoice
     auto cacheIdx = numInputTypes * slot.index + input;
     std::vector<PartRef>& parts = cache[cacheIdx].parts;
     cachedStateMetrics[cacheIdx] = CacheEntryStatus::PENDING;
+    if (TimesliceTraceHelpers::isTraced(traceEvery, timeslice.value)) {
+      auto now = TimesliceTraceHelpers::now();
+      if (presentInputs[slot.index] == 0) {
+        arrivalTimes[slot.index].first = now;
+      }
+      arrivalTimes[slot.index].second = now;
+    }
+    if (parts.empty()) {
+      presentInputs[slot.index]++;
+    }
     // TODO: make sure that multiple parts can only be added within the same call of
     // DataRelayer::relay
     PartRef entry{std::move(firstPart), std::move(restOfParts[0])};
@@ -326,9 +386,16 @@ DataRelayer::RelayChoice
 
   bool needsCleaning = false;
   // First look for matching slots which already have some
-  // partial match.
-  for (size_t ci = 0; ci < index.size(); ++ci) {
-    slot = TimesliceSlot{ci};
+  // partial match. Parts of the same timeslice tend to arrive
+  // together, so we start from the slot which got the last message
+  // and wrap around. At most one valid slot can match a given timeslice,
+  // so the starting point does not change the result.
+  size_t startSlot = 0;
+  if (TimesliceSlot::isValid(mLastRelayedSlot) && mLastRelayedSlot.index < index.size()) {
+    startSlot = mLastRelayedSlot.index;
+  }
+  for (size_t si = 0; si < index.size(); ++si) {
+    slot = TimesliceSlot{(startSlot + si) % index.size()};
     if (index.isValid(slot) == false) {
       continue;
     }
@@ -363,6 +430,7 @@ DataRelayer::RelayChoice
     saveInSlot(timeslice, input, slot);
     index.publishSlot(slot);
     index.markAsDirty(slot, true);
+    mLastRelayedSlot = slot;
     mStats.relayedMessages++;
     return WillRelay;
   }
@@ -443,6 +511,7 @@ DataRelayer::RelayChoice
       saveInSlot(timeslice, input, slot);
       index.publishSlot(slot);
       index.markAsDirty(slot, true);
+      mLastRelayedSlot = slot;
       return WillRelay;
   }
   O2_BUILTIN_UNREACHABLE();
@@ -499,20 +568,27 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
     if (mTimesliceIndex.isDirty(slot) == false) {
       continue;
     }
-    auto partial = getPartialRecord(li);
-    auto getter = [&partial](size_t idx, size_t part) {
-      if (partial[idx].size() > 0 && partial[idx].at(part).header && partial[idx].at(part).payload) {
-        return DataRef{nullptr,
-                       reinterpret_cast<const char*>(partial[idx].at(part).header->GetData()),
-                       reinterpret_cast<const char*>(partial[idx].at(part).payload->GetData())};
-      }
-      return DataRef{};
-    };
-    auto nPartsGetter = [&partial](size_t idx) {
-      return partial[idx].size();
-    };
-    InputSpan span{getter, nPartsGetter, static_cast<size_t>(partial.size())};
-    auto action = mCompletionPolicy.callback(span);
+    CompletionPolicy::CompletionOp action;
+    if (mCompletionPolicy.callbackFromCount) {
+      // The policy only needs to know how many inputs are there,
+      // which we keep track of while relaying.
+      action = mCompletionPolicy.callbackFromCount(mPresentInputs[li], numInputTypes);
+    } else {
+      auto partial = getPartialRecord(li);
+      auto getter = [&partial](size_t idx, size_t part) {
+        if (partial[idx].size() > 0 && partial[idx].at(part).header && partial[idx].at(part).payload) {
+          return DataRef{nullptr,
+                         reinterpret_cast<const char*>(partial[idx].at(part).header->GetData()),
+                         reinterpret_cast<const char*>(partial[idx].at(part).payload->GetData())};
+        }
+        return DataRef{};
+      };
+      auto nPartsGetter = [&partial](size_t idx) {
+        return partial[idx].size();
+      };
+      InputSpan span{getter, nPartsGetter, static_cast<size_t>(partial.size())};
+      action = mCompletionPolicy.callback(span);
+    }
     switch (action) {
       case CompletionPolicy::CompletionOp::Consume:
       case CompletionPolicy::CompletionOp::Process:
@@ -530,16 +606,15 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
 
 void DataRelayer::updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStatus, CacheEntryStatus newStatus)
 {
-  std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
+  // No need to lock: the status of each entry is atomic and we only
+  // move the entries which are still in the old status.
   const auto numInputTypes = mDistinctRoutesIndex.size();
-  auto& index = mTimesliceIndex;
 
   auto markInputDone = [&cachedStateMetrics = mCachedStateMetrics,
-                        &index, &numInputTypes](TimesliceSlot s, size_t arg, CacheEntryStatus oldStatus, CacheEntryStatus newStatus) {
+                        &numInputTypes](TimesliceSlot s, size_t arg, CacheEntryStatus oldStatus, CacheEntryStatus newStatus) {
     auto cacheId = s.index * numInputTypes + arg;
-    if (cachedStateMetrics[cacheId] == oldStatus) {
-      cachedStateMetrics[cacheId] = newStatus;
-    }
+    auto expected = oldStatus;
+    cachedStateMetrics[cacheId].compare_exchange_strong(expected, newStatus);
   };
 
   for (size_t ai = 0, ae = numInputTypes; ai != ae; ++ai) {
@@ -584,11 +659,12 @@ std::vector<o2::framework::MessageSet> DataRelayer::getInputsForTimeslice(Timesl
   // timeslice, so I can simply do that. I keep the assertion there because in principle
   // we should have dispatched the timeslice already!
   // FIXME: what happens when we have enough timeslices to hit the invalid one?
-  auto invalidateCacheFor = [&numInputTypes, &cachedStateMetrics = mCachedStateMetrics, &index, &cache](TimesliceSlot s) {
+  auto invalidateCacheFor = [&numInputTypes, &presentInputs = mPresentInputs, &index, &cache](TimesliceSlot s) {
     for (size_t ai = s.index * numInputTypes, ae = ai + numInputTypes; ai != ae; ++ai) {
       assert(std::accumulate(cache[ai].begin(), cache[ai].end(), true, [](bool result, auto const& element) { return result && element.header.get() == nullptr && element.payload.get() == nullptr; }));
       cache[ai].clear();
     }
+    presentInputs[s.index] = 0;
     index.markAsInvalid(s);
   };
 
@@ -609,6 +685,7 @@ void DataRelayer::clear()
   for (auto& cache : mCache) {
     cache.clear();
   }
+  std::fill(mPresentInputs.begin(), mPresentInputs.end(), 0);
   for (size_t s = 0; s < mTimesliceIndex.size(); ++s) {
     mTimesliceIndex.markAsInvalid(TimesliceSlot{s});
   }
@@ -620,6 +697,25 @@ size_t
   return mCache.size() / mDistinctRoutesIndex.size();
 }
 
+size_t DataRelayer::getInflightTimeslices()
+{
+  std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
+  return std::count_if(mPresentInputs.begin(), mPresentInputs.end(), [](size_t count) { return count != 0; });
+}
+
+size_t DataRelayer::getInflightBytes()
+{
+  std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
+  size_t result = 0;
+  for (auto& messageSet : mCache) {
+    for (auto& part : messageSet) {
+      result += part.header ? part.header->GetSize() : 0;
+      result += part.payload ? part.payload->GetSize() : 0;
+    }
+  }
+  return result;
+}
+
 /// Tune the maximum number of in flight timeslices this can handle.
 /// Notice that in case we have time pipelining we need to count
 /// the actual number of different types, without taking into account
@@ -639,10 +735,15 @@ void DataRelayer::publishMetrics()
 
   auto numInputTypes = mDistinctRoutesIndex.size();
   mCache.resize(numInputTypes * mTimesliceIndex.size());
+  mPresentInputs.resize(mTimesliceIndex.size(), 0);
+  mArrivalTimes.resize(mTimesliceIndex.size(), {0, 0});
   mMetrics.send({(int)numInputTypes, "data_relayer/h"});
   mMetrics.send({(int)mTimesliceIndex.size(), "data_relayer/w"});
   sMetricsNames.resize(mCache.size());
-  mCachedStateMetrics.resize(mCache.size());
+  // Atomics cannot be moved, so we recreate the whole status vector.
+  // The metrics below are reset as well, so we do not lose anything.
+  mCachedStateMetrics = std::vector<std::atomic<CacheEntryStatus>>(mCache.size());
+  mLastRelayedSlot = TimesliceSlot{TimesliceSlot::INVALID};
   for (size_t i = 0; i < sMetricsNames.size(); ++i) {
     sMetricsNames[i] = std::string("data_relayer/") + std::to_string(i);
   }
@@ -672,6 +773,27 @@ DataRelayerStats const& DataRelayer::getStats() const
   return mStats;
 }
 
+void DataRelayer::setTracing(size_t every)
+{
+  std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
+  mTraceEvery = every;
+}
+
+bool DataRelayer::isTraced(TimesliceSlot slot)
+{
+  if (mTraceEvery == 0) {
+    return false;
+  }
+  std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
+  return TimesliceTraceHelpers::isTraced(mTraceEvery, mTimesliceIndex.getTimesliceForSlot(slot).value);
+}
+
+std::pair<uint64_t, uint64_t> DataRelayer::getArrivalTimesForSlot(TimesliceSlot slot)
+{
+  std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
+  return mArrivalTimes[slot.index];
+}
+
 uint32_t DataRelayer::getFirstTFOrbitForSlot(TimesliceSlot slot)
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
@@ -693,11 +815,13 @@ void DataRelayer::sendContextState()
                                mMetrics, sVariablesMetricsNames);
   }
   for (size_t si = 0; si < mCachedStateMetrics.size(); ++si) {
-    mMetrics.send({static_cast<int>(mCachedStateMetrics[si]), sMetricsNames[si]});
+    auto status = mCachedStateMetrics[si].load();
+    mMetrics.send({static_cast<int>(status), sMetricsNames[si]});
     // Anything which is done is actually already empty,
-    // so after we report it we mark it as such.
-    if (mCachedStateMetrics[si] == CacheEntryStatus::DONE) {
-      mCachedStateMetrics[si] = CacheEntryStatus::EMPTY;
+    // so after we report it we mark it as such, unless
+    // in the meanwhile it has been reused.
+    if (status == CacheEntryStatus::DONE) {
+      mCachedStateMetrics[si].compare_exchange_strong(status, CacheEntryStatus::EMPTY);
     }
   }
 }
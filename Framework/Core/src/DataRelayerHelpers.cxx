@@ -69,4 +69,35 @@ std::vector<DataDescriptorMatcher>
   return result;
 }
 
+std::vector<std::optional<ConcreteDataMatcher>>
+  DataRelayerHelpers::createConcreteMatchers(std::vector<InputRoute> const& routes)
+{
+  std::vector<std::optional<ConcreteDataMatcher>> result;
+  for (auto& route : routes) {
+    if (auto pval = std::get_if<ConcreteDataMatcher>(&route.matcher.matcher)) {
+      result.emplace_back(*pval);
+    } else {
+      result.emplace_back(std::nullopt);
+    }
+  }
+  return result;
+}
+
+std::vector<DataRelayer::RouteCandidate>
+  DataRelayerHelpers::createRouteCandidates(ConcreteDataMatcher const& matcher,
+                                            std::vector<size_t> const& distinctRoutes,
+                                            std::vector<std::optional<ConcreteDataMatcher>> const& concreteMatchers)
+{
+  std::vector<DataRelayer::RouteCandidate> result;
+  for (size_t ri = 0; ri < distinctRoutes.size(); ++ri) {
+    auto& concrete = concreteMatchers[distinctRoutes[ri]];
+    if (!concrete) {
+      result.push_back({ri, false});
+    } else if (*concrete == matcher) {
+      result.push_back({ri, true});
+    }
+  }
+  return result;
+}
+
 } // namespace o2::framework
@@ -12,6 +12,8 @@
 #define O2_FRAMEWORK_DATARELAYERHELPERS_H_
 
 #include "Framework/InputRoute.h"
+#include "Framework/DataRelayer.h"
+#include <optional>
 #include <vector>
 
 namespace o2::framework
@@ -23,6 +25,13 @@ struct DataRelayerHelpers {
   static std::vector<size_t> createDistinctRouteIndex(std::vector<InputRoute> const&);
   /// This converts from InputRoute to the associated DataDescriptorMatcher.
   static std::vector<data_matcher::DataDescriptorMatcher> createInputMatchers(std::vector<InputRoute> const&);
+  /// @return for each route the ConcreteDataMatcher it exactly matches, if any.
+  static std::vector<std::optional<ConcreteDataMatcher>> createConcreteMatchers(std::vector<InputRoute> const&);
+  /// @return the routes in @a distinctRoutes which can match data described by @a matcher,
+  /// i.e. the concrete ones matching it exactly and all the others, in the same order.
+  static std::vector<DataRelayer::RouteCandidate> createRouteCandidates(ConcreteDataMatcher const& matcher,
+                                                                        std::vector<size_t> const& distinctRoutes,
+                                                                        std::vector<std::optional<ConcreteDataMatcher>> const& concreteMatchers);
 };
 
 } // namespace o2::framework
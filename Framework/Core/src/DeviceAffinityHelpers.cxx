@@ -0,0 +1,132 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "DeviceAffinityHelpers.h"
+#include "Framework/Logger.h"
+#include "Framework/RuntimeError.h"
+
+#include <fmt/format.h>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace o2::framework
+{
+
+std::vector<int> DeviceAffinityHelpers::parseCPUList(std::string_view s)
+{
+  std::vector<int> result;
+  auto parseNumber = [&s](char const*& cur, char const* end) -> int {
+    int value = 0;
+    auto [ptr, ec] = std::from_chars(cur, end, value);
+    if (ec != std::errc() || value < 0) {
+      throw runtime_error_f("Malformed cpu list: %s", std::string(s).c_str());
+    }
+    cur = ptr;
+    return value;
+  };
+  // The sysfs files end with a newline.
+  while (!s.empty() && isspace(s.back())) {
+    s.remove_suffix(1);
+  }
+  char const* cur = s.data();
+  char const* end = s.data() + s.size();
+  while (cur != end) {
+    int first = parseNumber(cur, end);
+    int last = first;
+    if (cur != end && *cur == '-') {
+      last = parseNumber(++cur, end);
+    }
+    if (last < first) {
+      throw runtime_error_f("Malformed cpu list: %s", std::string(s).c_str());
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      result.push_back(cpu);
+    }
+    if (cur != end) {
+      if (*cur != ',' || cur + 1 == end) {
+        throw runtime_error_f("Malformed cpu list: %s", std::string(s).c_str());
+      }
+      ++cur;
+    }
+  }
+  return result;
+}
+
+std::string DeviceAffinityHelpers::cpusForNode(int node)
+{
+  std::ifstream cpulist(fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+  std::string result;
+  std::getline(cpulist, result);
+  return result;
+}
+
+void DeviceAffinityHelpers::apply(DeviceAffinity const& affinity)
+{
+  // Only the GPU runtime needs to know, so this works everywhere.
+  if (affinity.gpu >= 0) {
+    auto gpu = std::to_string(affinity.gpu);
+    setenv("CUDA_VISIBLE_DEVICES", gpu.c_str(), 1);
+    setenv("HIP_VISIBLE_DEVICES", gpu.c_str(), 1);
+    LOGP(INFO, "Only GPU {} is visible to this device", affinity.gpu);
+  }
+#ifdef __linux__
+  auto cpus = affinity.cpus;
+  if (cpus.empty() && affinity.numaNode >= 0) {
+    cpus = cpusForNode(affinity.numaNode);
+    if (cpus.empty()) {
+      LOGP(ERROR, "Unable to find the cpus of NUMA node {}", affinity.numaNode);
+    }
+  }
+  if (!cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : parseCPUList(cpus)) {
+      if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &set);
+      }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+      LOGP(ERROR, "Unable to pin the device to cpus {}: {}", cpus, strerror(errno));
+    } else {
+      LOGP(INFO, "Device pinned to cpus {}", cpus);
+    }
+  }
+  if (affinity.numaNode >= 0) {
+    // We use the syscall directly, to avoid depending on libnuma.
+    // The node is only preferred, so that we do not get killed
+    // in case it runs out of memory.
+    constexpr int MPOL_PREFERRED_MODE = 1;
+    constexpr size_t BITS = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> nodemask(affinity.numaNode / BITS + 1, 0);
+    nodemask[affinity.numaNode / BITS] = 1UL << (affinity.numaNode % BITS);
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, nodemask.data(), nodemask.size() * BITS + 1) != 0) {
+      LOGP(ERROR, "Unable to allocate memory preferably on NUMA node {}: {}", affinity.numaNode, strerror(errno));
+    } else {
+      LOGP(INFO, "Memory will preferably be allocated on NUMA node {}", affinity.numaNode);
+    }
+  }
+#else
+  if (!affinity.cpus.empty() || affinity.numaNode >= 0) {
+    LOGP(WARNING, "Pinning devices to cpus or NUMA nodes is only supported on Linux");
+  }
+#endif
+}
+
+} // namespace o2::framework
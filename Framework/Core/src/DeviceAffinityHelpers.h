@@ -0,0 +1,36 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DEVICEAFFINITYHELPERS_H_
+#define O2_FRAMEWORK_DEVICEAFFINITYHELPERS_H_
+
+#include "Framework/ResourcePolicy.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace o2::framework
+{
+
+struct DeviceAffinityHelpers {
+  /// Parse a list of cpus in the taskset -c / sysfs cpulist format, e.g. "0-3,8,10-11".
+  /// Throws in case the list is malformed.
+  static std::vector<int> parseCPUList(std::string_view s);
+  /// @return the cpulist of a given NUMA @a node, empty if not available
+  static std::string cpusForNode(int node);
+  /// Pin the current process according to @a affinity. This needs to happen
+  /// before the device starts any thread or touches any memory it
+  /// wants on the right NUMA node.
+  static void apply(DeviceAffinity const& affinity);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DEVICEAFFINITYHELPERS_H_
@@ -162,6 +162,7 @@ size_t DeviceMetricsHelper::bookMetricInfo(DeviceMetricsInfo& info, char const*
   info.maxDomain.push_back(std::numeric_limits<size_t>::lowest());
   info.minDomain.push_back(std::numeric_limits<size_t>::max());
   info.changed.push_back(true);
+  info.rollups.emplace_back();
 
   info.metricLabels.push_back(metricLabel);
 
@@ -175,17 +176,12 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
   // get the type
   size_t metricIndex = -1;
 
-  StringMetric stringValue;
   switch (match.type) {
     case MetricType::Float:
     case MetricType::Int:
     case MetricType::Uint64:
+    case MetricType::String:
       break;
-    case MetricType::String: {
-      auto lastChar = std::min(match.endStringValue - match.beginStringValue, StringMetric::MAX_SIZE - 1);
-      memcpy(stringValue.data, match.beginStringValue, lastChar);
-      stringValue.data[lastChar] = '\0';
-    } break;
     default:
       return false;
       break;
@@ -240,6 +236,7 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
     info.maxDomain.push_back(std::numeric_limits<size_t>::lowest());
     info.minDomain.push_back(std::numeric_limits<size_t>::max());
     info.changed.push_back(false);
+    info.rollups.emplace_back();
 
     // Add the index by name in the correct position
     // this will require moving the tail of the index,
@@ -267,6 +264,13 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
   }
   assert(metricIndex != -1);
   // We are now guaranteed our metric is present at metricIndex.
+  return storeMetric(match, info, metricIndex);
+}
+
+bool DeviceMetricsHelper::storeMetric(ParsedMetricMatch const& match,
+                                      DeviceMetricsInfo& info,
+                                      size_t metricIndex)
+{
   MetricInfo& metricInfo = info.metrics[metricIndex];
 
   //  auto mod = info.timestamps[metricIndex].size();
@@ -276,6 +280,7 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
   switch (metricInfo.type) {
     case MetricType::Int: {
       info.intMetrics[metricInfo.storeIdx][metricInfo.pos] = match.intValue;
+      info.rollups[metricIndex].add(match.timestamp, match.intValue);
       info.max[metricIndex] = std::max(info.max[metricIndex], (float)match.intValue);
       info.min[metricIndex] = std::min(info.min[metricIndex], (float)match.intValue);
       // Save the timestamp for the current metric we do it here
@@ -286,6 +291,10 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
       ++metricInfo.filledMetrics;
     } break;
     case MetricType::String: {
+      StringMetric stringValue;
+      auto lastChar = std::min(match.endStringValue - match.beginStringValue, StringMetric::MAX_SIZE - 1);
+      memcpy(stringValue.data, match.beginStringValue, lastChar);
+      stringValue.data[lastChar] = '\0';
       info.stringMetrics[metricInfo.storeIdx][metricInfo.pos] = stringValue;
       // Save the timestamp for the current metric we do it here
       // so that we do not update timestamps for broken metrics
@@ -295,6 +304,7 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
     } break;
     case MetricType::Float: {
       info.floatMetrics[metricInfo.storeIdx][metricInfo.pos] = match.floatValue;
+      info.rollups[metricIndex].add(match.timestamp, match.floatValue);
       info.max[metricIndex] = std::max(info.max[metricIndex], match.floatValue);
       info.min[metricIndex] = std::min(info.min[metricIndex], match.floatValue);
       // Save the timestamp for the current metric we do it here
@@ -305,6 +315,7 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
     } break;
     case MetricType::Uint64: {
       info.uint64Metrics[metricInfo.storeIdx][metricInfo.pos] = match.uint64Value;
+      info.rollups[metricIndex].add(match.timestamp, match.uint64Value);
       info.max[metricIndex] = std::max(info.max[metricIndex], (float)match.uint64Value);
       info.min[metricIndex] = std::min(info.min[metricIndex], (float)match.uint64Value);
       // Save the timestamp for the current metric we do it here
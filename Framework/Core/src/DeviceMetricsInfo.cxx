@@ -45,4 +45,29 @@ std::ostream& operator<<(std::ostream& oss, MetricType const& val)
   return oss;
 }
 
+void MetricRollups::add(size_t timestamp, float value)
+{
+  for (size_t level = 0; level < LEVELS; ++level) {
+    auto index = static_cast<uint32_t>(timestamp / BIN_WIDTHS[level]);
+    auto& levelBins = bins[level];
+    auto& filled = filledBins[level];
+    // Values older than the current bin, which can only happen when they are
+    // not received in order, are accounted in the current bin.
+    if (filled == 0 || index > levelBins[(filled - 1) % MAX_BINS[level]].index) {
+      MetricRollupBin newBin{index, 0, value, value, 0.f};
+      if (levelBins.size() < MAX_BINS[level]) {
+        levelBins.push_back(newBin);
+      } else {
+        levelBins[filled % MAX_BINS[level]] = newBin;
+      }
+      ++filled;
+    }
+    auto& current = levelBins[(filled - 1) % MAX_BINS[level]];
+    ++current.count;
+    current.min = std::min(current.min, value);
+    current.max = std::max(current.max, value);
+    current.avg += (value - current.avg) / current.count;
+  }
+}
+
 } // namespace o2::framework
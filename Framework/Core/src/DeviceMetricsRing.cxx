@@ -0,0 +1,213 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/DeviceMetricsRing.h"
+#include "Framework/Logger.h"
+#include <fmt/format.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2::framework
+{
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The metrics ring requires lock free atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "The metrics ring requires lock free atomics");
+
+/// The layout of the shared memory segment. The producer only writes
+/// head, the metric labels and the records, the consumer only writes tail.
+/// Each position is on its own cache line, to avoid false sharing.
+struct DeviceMetricsRing::Header {
+  static constexpr uint32_t MAGIC = 0x444d5231; // "DMR1"
+  uint32_t magic;
+  uint32_t recordSize;
+  uint64_t capacity;
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+  alignas(64) std::atomic<uint32_t> metricsCount;
+  MetricLabel labels[MAX_METRICS];
+};
+
+DeviceMetricsRing::DeviceMetricsRing(void* address, size_t size, int fd)
+  : mHeader{reinterpret_cast<Header*>(address)},
+    mSize{size},
+    mFd{fd}
+{
+}
+
+DeviceMetricsRing::~DeviceMetricsRing()
+{
+  munmap(mHeader, mSize);
+  if (mFd >= 0) {
+    close(mFd);
+  }
+}
+
+std::unique_ptr<DeviceMetricsRing> DeviceMetricsRing::create(size_t capacity)
+{
+  static int ringsCreated = 0;
+  size_t actualCapacity = 1;
+  while (actualCapacity < capacity) {
+    actualCapacity <<= 1;
+  }
+  size_t size = sizeof(Header) + actualCapacity * sizeof(Record);
+
+  // The segment is unlinked right away, it only lives as long as
+  // the file descriptors and the mappings of the driver and the device.
+  auto name = fmt::format("/dpl-metrics-{}-{}", getpid(), ringsCreated++);
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    LOGP(ERROR, "Unable to create the metrics ring {}: {}", name, strerror(errno));
+    return nullptr;
+  }
+  shm_unlink(name.c_str());
+  if (ftruncate(fd, size) != 0) {
+    LOGP(ERROR, "Unable to allocate {} bytes for the metrics ring: {}", size, strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+  void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    LOGP(ERROR, "Unable to map the metrics ring: {}", strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+  auto header = new (address) Header();
+  header->magic = Header::MAGIC;
+  header->recordSize = sizeof(Record);
+  header->capacity = actualCapacity;
+  return std::unique_ptr<DeviceMetricsRing>(new DeviceMetricsRing(address, size, fd));
+}
+
+std::unique_ptr<DeviceMetricsRing> DeviceMetricsRing::attach(int fd)
+{
+  struct stat sb;
+  if (fstat(fd, &sb) != 0 || sb.st_size < sizeof(Header)) {
+    LOGP(ERROR, "Invalid metrics ring file descriptor {}", fd);
+    return nullptr;
+  }
+  size_t size = sb.st_size;
+  void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    LOGP(ERROR, "Unable to map the metrics ring: {}", strerror(errno));
+    return nullptr;
+  }
+  auto header = reinterpret_cast<Header*>(address);
+  if (header->magic != Header::MAGIC || header->recordSize != sizeof(Record) ||
+      sizeof(Header) + header->capacity * sizeof(Record) != size) {
+    LOGP(ERROR, "Metrics ring file descriptor {} does not contain a valid ring", fd);
+    munmap(address, size);
+    return nullptr;
+  }
+  // The mapping is all we need from now on.
+  close(fd);
+  return std::unique_ptr<DeviceMetricsRing>(new DeviceMetricsRing(address, size, -1));
+}
+
+size_t DeviceMetricsRing::capacity() const
+{
+  return mHeader->capacity;
+}
+
+DeviceMetricsRing::Record* DeviceMetricsRing::records() const
+{
+  return reinterpret_cast<Record*>(reinterpret_cast<char*>(mHeader) + sizeof(Header));
+}
+
+int DeviceMetricsRing::registerMetric(std::string_view name)
+{
+  auto index = mHeader->metricsCount.load(std::memory_order_relaxed);
+  if (index >= MAX_METRICS) {
+    return -1;
+  }
+  auto& label = mHeader->labels[index];
+  auto size = std::min(name.size(), MetricLabel::MAX_METRIC_LABEL_SIZE - 1);
+  memcpy(label.label, name.data(), size);
+  label.label[size] = '\0';
+  label.size = size;
+  // The label is visible to the consumer before any record using it.
+  mHeader->metricsCount.store(index + 1, std::memory_order_release);
+  return index;
+}
+
+bool DeviceMetricsRing::push(Record const& record)
+{
+  auto head = mHeader->head.load(std::memory_order_relaxed);
+  auto capacity = mHeader->capacity;
+  if (head - mCachedTail >= capacity) {
+    mCachedTail = mHeader->tail.load(std::memory_order_acquire);
+    if (head - mCachedTail >= capacity) {
+      return false;
+    }
+  }
+  records()[head & (capacity - 1)] = record;
+  mHeader->head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+size_t DeviceMetricsRing::consume(DeviceMetricsInfo& info,
+                                  DeviceMetricsHelper::NewMetricCallback newMetricCallback)
+{
+  auto tail = mHeader->tail.load(std::memory_order_relaxed);
+  auto head = mHeader->head.load(std::memory_order_acquire);
+  if (head == tail) {
+    return 0;
+  }
+  auto capacity = mHeader->capacity;
+  auto* ring = records();
+  ParsedMetricMatch match{};
+
+  for (auto pos = tail; pos != head; ++pos) {
+    Record const& record = ring[pos & (capacity - 1)];
+    if (record.metricIndex >= MAX_METRICS) {
+      continue;
+    }
+    match.timestamp = record.timestamp;
+    match.type = record.type;
+    switch (record.type) {
+      case MetricType::Int:
+        match.intValue = record.intValue;
+        break;
+      case MetricType::Float:
+        match.floatValue = record.floatValue;
+        break;
+      case MetricType::Uint64:
+        match.uint64Value = record.uint64Value;
+        break;
+      default:
+        continue;
+    }
+    if (record.metricIndex >= mInfoIndex.size()) {
+      mInfoIndex.resize(record.metricIndex + 1, -1);
+    }
+    auto& infoIndex = mInfoIndex[record.metricIndex];
+    if (infoIndex != (size_t)-1) {
+      DeviceMetricsHelper::storeMetric(match, info, infoIndex);
+      continue;
+    }
+    // First time we see this metric: do the lookup by name (and create it, if needed) only once.
+    MetricLabel const& label = mHeader->labels[record.metricIndex];
+    match.beginKey = label.label;
+    match.endKey = label.label + label.size;
+    if (DeviceMetricsHelper::processMetric(match, info, newMetricCallback)) {
+      infoIndex = DeviceMetricsHelper::metricIdxByName(label.label, info);
+    }
+  }
+  mHeader->tail.store(head, std::memory_order_release);
+  return head - tail;
+}
+
+} // namespace o2::framework
@@ -1289,6 +1289,8 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
     ("monitoring-backend", bpo::value<std::string>(), "monitoring connection string")                                                         //
     ("infologger-mode", bpo::value<std::string>(), "O2_INFOLOGGER_MODE override")                                                             //
     ("infologger-severity", bpo::value<std::string>(), "minimun FairLogger severity which goes to info logger")                               //
+    ("timeslice-tracing", bpo::value<std::string>(), "trace one timeslice out of the given number through the topology (0: disabled)")        //
+    ("dpl-coalesce-outputs", bpo::value<std::string>(), "coalesce outputs up to the given bytes to the same channel (0: disabled)")           //
     ("child-driver", bpo::value<std::string>(), "external driver to start childs with (e.g. valgrind)");                                      //
 
   return forwardedDeviceOptions;
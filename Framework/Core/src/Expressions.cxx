@@ -21,6 +21,7 @@
 #include <unordered_map>
 #include <set>
 #include <algorithm>
+#include <mutex>
 
 using namespace o2::framework;
 
@@ -452,10 +453,69 @@ Selection createSelection(std::shared_ptr<arrow::Table> const& table, std::share
   return selection;
 }
 
+namespace
+{
+/// Selections shared between the users of the same table data. An entry is identified by the
+/// canonical form of the expression tree, the schema and the memory of the first column of the
+/// table, which the entry keeps referenced. Entries for which the cache holds the only reference
+/// to that memory belong to a dataframe which is gone and are dropped.
+struct SharedSelection {
+  std::string condition;
+  std::string schema;
+  int64_t nRows;
+  int64_t offset;
+  std::shared_ptr<arrow::Buffer> values;
+  Selection selection;
+};
+
+std::mutex sharedSelectionsMutex;
+std::vector<SharedSelection> sharedSelections;
+} // namespace
+
+Selection createSelection(std::shared_ptr<arrow::Table> const& table, gandiva::NodePtr const& tree)
+{
+  std::shared_ptr<arrow::Buffer> values;
+  int64_t offset = 0;
+  if (table->num_columns() > 0 && table->column(0)->num_chunks() > 0) {
+    auto const& data = table->column(0)->chunk(0)->data();
+    if (data->buffers.size() > 1) {
+      values = data->buffers[1];
+      offset = data->offset;
+    }
+  }
+  if (!values) {
+    return createSelection(table, createFilter(table->schema(), makeCondition(tree)));
+  }
+
+  auto condition = tree->ToString();
+  auto schema = table->schema()->ToString();
+  std::lock_guard<std::mutex> lock(sharedSelectionsMutex);
+  // drop the selections of the dataframes which are gone, several selections can reference the same memory
+  std::unordered_map<arrow::Buffer const*, long> cacheReferences;
+  for (auto& entry : sharedSelections) {
+    ++cacheReferences[entry.values.get()];
+  }
+  sharedSelections.erase(std::remove_if(sharedSelections.begin(), sharedSelections.end(), [&cacheReferences](SharedSelection const& e) { return e.values.use_count() == cacheReferences[e.values.get()]; }), sharedSelections.end());
+  for (auto& entry : sharedSelections) {
+    if (entry.values->data() == values->data() && entry.offset == offset && entry.nRows == table->num_rows() && entry.condition == condition && entry.schema == schema) {
+      return entry.selection;
+    }
+  }
+  auto selection = createSelection(table, createFilter(table->schema(), makeCondition(tree)));
+  sharedSelections.push_back(SharedSelection{std::move(condition), std::move(schema), table->num_rows(), offset, values, selection});
+  return selection;
+}
+
+size_t getSharedSelectionsCount()
+{
+  std::lock_guard<std::mutex> lock(sharedSelectionsMutex);
+  return sharedSelections.size();
+}
+
 Selection createSelection(std::shared_ptr<arrow::Table> const& table,
                           Filter const& expression)
 {
-  return createSelection(table, createFilter(table->schema(), createOperations(std::move(expression))));
+  return createSelection(table, createExpressionTree(createOperations(std::move(expression)), table->schema()));
 }
 
 auto createProjection(std::shared_ptr<arrow::Table> const& table, std::shared_ptr<gandiva::Projector> const& gprojector)
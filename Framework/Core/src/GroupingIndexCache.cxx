@@ -0,0 +1,203 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/GroupingIndexCache.h"
+#include "Framework/RuntimeError.h"
+
+#include <arrow/buffer.h>
+#include <arrow/table.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace o2::framework
+{
+namespace
+{
+/// drop the entries of the dataframes which are gone: their memory is only
+/// referenced by the entries of the cache, possibly by several of them
+template <typename E>
+void dropUnreferenced(std::vector<E>& entries)
+{
+  std::unordered_map<arrow::Buffer const*, long> cacheReferences;
+  for (auto& entry : entries) {
+    ++cacheReferences[entry.values.get()];
+  }
+  entries.erase(std::remove_if(entries.begin(), entries.end(), [&cacheReferences](E const& e) { return e.values.use_count() == cacheReferences[e.values.get()]; }), entries.end());
+}
+} // namespace
+
+GroupingIndexCache& GroupingIndexCache::instance()
+{
+  static GroupingIndexCache cache;
+  return cache;
+}
+
+std::shared_ptr<GroupingIndex const> GroupingIndexCache::get(char const* key, std::shared_ptr<arrow::Table> const& input, int32_t fullSize)
+{
+  auto column = input->GetColumnByName(key);
+  if (!column) {
+    throw runtime_error_f("Cannot find column %s to split collection", key);
+  }
+  std::shared_ptr<arrow::Buffer> values;
+  int64_t offset = 0;
+  if (column->num_chunks() > 0) {
+    values = column->chunk(0)->data()->buffers[1];
+    offset = column->chunk(0)->offset();
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  dropUnreferenced(mEntries);
+
+  if (values) {
+    for (auto& entry : mEntries) {
+      // different slices of the same memory differ by their offset or number of chunks
+      if (entry.values->data() == values->data() && entry.offset == offset && entry.nChunks == column->num_chunks() && entry.nRows == column->length() &&
+          entry.fullSize == fullSize && entry.key == key) {
+        return entry.index;
+      }
+    }
+  }
+
+  auto index = std::make_shared<GroupingIndex>();
+  auto result = makeGroupingIndex(key, input, fullSize, *index);
+  if (result.ok() == false) {
+    throw runtime_error_f("Cannot split collection: %s", result.ToString().c_str());
+  }
+  if (values) {
+    mEntries.push_back(Entry{key, fullSize, offset, column->num_chunks(), column->length(), values, index});
+  }
+  return index;
+}
+
+void GroupingIndexCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.clear();
+}
+
+size_t GroupingIndexCache::size() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries.size();
+}
+
+CategoryIndexCache& CategoryIndexCache::instance()
+{
+  static CategoryIndexCache cache;
+  return cache;
+}
+
+std::shared_ptr<CategoryIndexCache::CategoryIndex const> CategoryIndexCache::get(std::string const& key, std::shared_ptr<arrow::Table> const& input, int minCatSize, uint64_t outsider, std::function<CategoryIndex()> const& build)
+{
+  auto column = input->GetColumnByName(key);
+  if (!column) {
+    throw runtime_error_f("Combinations: cannot find category column %s", key.c_str());
+  }
+  std::shared_ptr<arrow::Buffer> values;
+  int64_t offset = 0;
+  if (column->num_chunks() > 0) {
+    values = column->chunk(0)->data()->buffers[1];
+    offset = column->chunk(0)->offset();
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  dropUnreferenced(mEntries);
+
+  if (values) {
+    for (auto& entry : mEntries) {
+      // different slices of the same memory differ by their offset or number of chunks
+      if (entry.values->data() == values->data() && entry.offset == offset && entry.nChunks == column->num_chunks() && entry.nRows == column->length() &&
+          entry.minCatSize == minCatSize && entry.outsider == outsider && entry.key == key) {
+        return entry.index;
+      }
+    }
+  }
+
+  auto index = std::make_shared<CategoryIndex const>(build());
+  if (values) {
+    mEntries.push_back(Entry{key, minCatSize, outsider, offset, column->num_chunks(), column->length(), values, index});
+  }
+  return index;
+}
+
+void CategoryIndexCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.clear();
+}
+
+size_t CategoryIndexCache::size() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries.size();
+}
+
+DerivedTableCache& DerivedTableCache::instance()
+{
+  static DerivedTableCache cache;
+  return cache;
+}
+
+std::shared_ptr<arrow::Table> DerivedTableCache::get(std::string const& label, std::vector<std::shared_ptr<arrow::Table>> const& sources, std::function<std::shared_ptr<arrow::Table>()> const& build)
+{
+  std::vector<Source> identities;
+  std::vector<std::shared_ptr<arrow::Buffer>> buffers;
+  for (auto& source : sources) {
+    if (!source || source->num_columns() == 0 || source->column(0)->num_chunks() == 0 || !source->column(0)->chunk(0)->data()->buffers[1]) {
+      // the empty tables cannot be identified, the index is not cached
+      return build();
+    }
+    auto chunk = source->column(0)->chunk(0);
+    auto values = chunk->data()->buffers[1];
+    identities.push_back(Source{values->data(), chunk->offset(), source->column(0)->num_chunks(), source->num_rows()});
+    if (std::none_of(buffers.begin(), buffers.end(), [&values](auto const& b) { return b == values; })) {
+      buffers.push_back(values);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  // drop the entries of the dataframes which are gone: the memory of one of
+  // their sources is only referenced by the cache
+  std::unordered_map<arrow::Buffer const*, long> cacheReferences;
+  for (auto& entry : mEntries) {
+    for (auto& buffer : entry.buffers) {
+      ++cacheReferences[buffer.get()];
+    }
+  }
+  mEntries.erase(std::remove_if(mEntries.begin(), mEntries.end(), [&cacheReferences](Entry const& e) {
+                   return std::any_of(e.buffers.begin(), e.buffers.end(), [&cacheReferences](auto const& b) { return b.use_count() == cacheReferences[b.get()]; });
+                 }),
+                 mEntries.end());
+
+  for (auto& entry : mEntries) {
+    if (entry.label == label && entry.sources == identities) {
+      return entry.index;
+    }
+  }
+
+  auto index = build();
+  mEntries.push_back(Entry{label, std::move(identities), std::move(buffers), index});
+  return index;
+}
+
+void DerivedTableCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.clear();
+}
+
+size_t DerivedTableCache::size() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries.size();
+}
+} // namespace o2::framework
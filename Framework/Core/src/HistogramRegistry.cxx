@@ -12,6 +12,7 @@
 #include "Framework/HistogramRegistry.h"
 #include <regex>
 #include <TList.h>
+#include <TArrayD.h>
 
 namespace o2::framework
 {
@@ -110,9 +111,30 @@ void HistogramRegistry::add(char const* const name, char const* const title, His
   insert({name, title, {histType, axes}, callSumw2});
 }
 
+// add the content of the histograms of a registry with identical layout
+void HistogramRegistry::merge(HistogramRegistry& other)
+{
+  flush();
+  other.flush();
+  for (auto i = 0u; i < MAX_REGISTRY_SIZE; ++i) {
+    TObject* source = nullptr;
+    std::visit([&](const auto& sharedPtr) { source = sharedPtr.get(); }, other.mRegistryValue[i]);
+    if (!source) {
+      continue;
+    }
+    if (mRegistryKey[i] != other.mRegistryKey[i]) {
+      LOGF(FATAL, R"(Cannot merge histogram "%s" in HistogramRegistry "%s": registries have different layouts.)", source->GetName(), mName);
+    }
+    TList list;
+    list.Add(source);
+    std::visit([&](const auto& sharedPtr) { sharedPtr->Merge(&list); }, mRegistryValue[i]);
+  }
+}
+
 // store a copy of an existing histogram (or group of histograms) under a different name
 void HistogramRegistry::addClone(const std::string& source, const std::string& target)
 {
+  flush();
   auto doInsertClone = [&](const auto& sharedPtr) {
     if (!sharedPtr.get()) {
       return;
@@ -159,7 +181,9 @@ bool HistogramRegistry::contains(const HistName& histName)
 double HistogramRegistry::getSize(const HistName& histName, double fillFraction)
 {
   double size{};
-  std::visit([&fillFraction, &size](auto&& hist) { size = HistFiller::getSize(hist, fillFraction); }, mRegistryValue[getHistIndex(histName)]);
+  auto idx = getHistIndex(histName);
+  flush(idx);
+  std::visit([&fillFraction, &size](auto&& hist) { size = HistFiller::getSize(hist, fillFraction); }, mRegistryValue[idx]);
   return size;
 }
 
@@ -167,6 +191,7 @@ double HistogramRegistry::getSize(const HistName& histName, double fillFraction)
 double HistogramRegistry::getSize(double fillFraction)
 {
   double size{};
+  flush();
   for (auto j = 0u; j < MAX_REGISTRY_SIZE; ++j) {
     std::visit([&fillFraction, &size](auto&& hist) { if(hist) { size += HistFiller::getSize(hist, fillFraction);} }, mRegistryValue[j]);
   }
@@ -176,6 +201,7 @@ double HistogramRegistry::getSize(double fillFraction)
 // print some useful meta-info about the stored histograms
 void HistogramRegistry::print(bool showAxisDetails)
 {
+  flush();
   std::vector<double> fillFractions{0.1, 0.25, 0.5};
   std::vector<double> totalSizes(fillFractions.size());
 
@@ -265,6 +291,7 @@ void HistogramRegistry::print(bool showAxisDetails)
 // create output structure will be propagated to file-sink
 TList* HistogramRegistry::operator*()
 {
+  flush();
   TList* list = new TList();
   list->SetName(mName.data());
 
@@ -385,4 +412,194 @@ void HistogramRegistry::registerName(const std::string& name)
   mRegisteredNames.push_back(name);
 }
 
+// fill the histogram at position idx with arrays of values, through the buffer when the histogram has one
+void HistogramRegistry::fillBuffered(uint32_t idx, gsl::span<const gsl::span<const float>> columns)
+{
+  const size_t nEntries = columns[0].size();
+  for (auto& column : columns) {
+    if (column.size() != nEntries) {
+      LOGF(FATAL, R"(Cannot fill histogram in HistogramRegistry "%s": arrays of values have different lengths.)", mName);
+    }
+  }
+  if (!mRegistryBuffer[idx]) {
+    std::visit([&](const auto& sharedPtr) {
+      using T = typename std::decay_t<decltype(sharedPtr)>::element_type;
+      if constexpr (std::is_same_v<T, TH1> || std::is_same_v<T, TH2> || std::is_same_v<T, TH3>) {
+        mRegistryBuffer[idx] = HistBuffer::create(sharedPtr.get());
+      }
+    },
+               mRegistryValue[idx]);
+  }
+  if (mRegistryBuffer[idx] && mRegistryBuffer[idx]->accepts(columns.size())) {
+    mRegistryBuffer[idx]->fill(columns);
+    return;
+  }
+  // histograms without buffer are filled entry by entry
+  flush(idx);
+  std::visit([&](auto& hist) {
+    if constexpr (std::is_same_v<typename std::decay_t<decltype(hist)>::element_type, StepTHn>) {
+      LOGF(FATAL, "Batch filling is not (yet?) supported for StepTHn.");
+    } else {
+      for (size_t i = 0; i < nEntries; ++i) {
+        switch (columns.size()) {
+          case 1:
+            HistFiller::fillHistAny(hist, columns[0][i]);
+            break;
+          case 2:
+            HistFiller::fillHistAny(hist, columns[0][i], columns[1][i]);
+            break;
+          case 3:
+            HistFiller::fillHistAny(hist, columns[0][i], columns[1][i], columns[2][i]);
+            break;
+          case 4:
+            HistFiller::fillHistAny(hist, columns[0][i], columns[1][i], columns[2][i], columns[3][i]);
+            break;
+          default:
+            HistFiller::fillHistAny(hist, columns[0][i], columns[1][i], columns[2][i], columns[3][i], columns[4][i]);
+            break;
+        }
+      }
+    }
+  },
+             mRegistryValue[idx]);
+}
+
+// add the buffered content to all the histograms
+void HistogramRegistry::flush()
+{
+  for (auto i = 0u; i < MAX_REGISTRY_SIZE; ++i) {
+    flush(i);
+  }
+}
+
+std::shared_ptr<HistBuffer> HistBuffer::create(TH1* hist)
+{
+  if (!hist || hist->GetBuffer()) {
+    return nullptr;
+  }
+  auto buffer = std::make_shared<HistBuffer>();
+  buffer->mHist = hist;
+  buffer->mDim = hist->GetDimension();
+  if (buffer->mDim < 1 || buffer->mDim > 3) {
+    return nullptr;
+  }
+  const TAxis* axes[3] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+  int stride = 1;
+  for (size_t dim = 0; dim < buffer->mDim; ++dim) {
+    // variable bins and extendable axes are left to ROOT
+    if (axes[dim]->GetXbins()->fN != 0 || axes[dim]->CanExtend()) {
+      return nullptr;
+    }
+    buffer->mNBins[dim] = axes[dim]->GetNbins();
+    buffer->mMin[dim] = axes[dim]->GetXmin();
+    buffer->mRange[dim] = axes[dim]->GetXmax() - axes[dim]->GetXmin();
+    buffer->mStride[dim] = stride;
+    stride *= buffer->mNBins[dim] + 2;
+  }
+  buffer->mStatOverflows = hist->GetStatOverflowsBehaviour();
+  buffer->mSumw.assign(hist->GetNcells(), 0.);
+  buffer->mSumw2.assign(hist->GetNcells(), 0.);
+  return buffer;
+}
+
+void HistBuffer::fill(gsl::span<const gsl::span<const float>> columns)
+{
+  const bool weighted = columns.size() > mDim;
+  switch (mDim) {
+    case 1:
+      fillImpl<1>(columns, weighted);
+      break;
+    case 2:
+      fillImpl<2>(columns, weighted);
+      break;
+    default:
+      fillImpl<3>(columns, weighted);
+      break;
+  }
+  mEntries += columns[0].size();
+  mFilled = true;
+}
+
+template <int D>
+void HistBuffer::fillImpl(gsl::span<const gsl::span<const float>> columns, bool weighted)
+{
+  const size_t nEntries = columns[0].size();
+  const float* weights = weighted ? columns[D].data() : nullptr;
+  const float* values[D];
+  for (int dim = 0; dim < D; ++dim) {
+    values[dim] = columns[dim].data();
+  }
+  auto& s = mStats;
+  for (size_t i = 0; i < nEntries; ++i) {
+    const double w = weights ? weights[i] : 1.;
+    double x[D];
+    int bin = 0;
+    bool inRange = true;
+    for (int dim = 0; dim < D; ++dim) {
+      x[dim] = values[dim][i];
+      const int b = findBin(dim, x[dim]);
+      bin += b * mStride[dim];
+      inRange &= (b >= 1) & (b <= mNBins[dim]);
+    }
+    mSumw[bin] += w;
+    mSumw2[bin] += w * w;
+    mNonUnitWeights |= (w != 1.);
+    // only the entries within the axis ranges enter the statistics, as in TH1::Fill
+    inRange |= mStatOverflows;
+    const double ws = inRange ? w : 0.;
+    for (int dim = 0; dim < D; ++dim) {
+      x[dim] = inRange ? x[dim] : 0.;
+    }
+    s[0] += ws;
+    s[1] += ws * w;
+    s[2] += ws * x[0];
+    s[3] += ws * x[0] * x[0];
+    if constexpr (D > 1) {
+      s[4] += ws * x[1];
+      s[5] += ws * x[1] * x[1];
+      s[6] += ws * x[0] * x[1];
+    }
+    if constexpr (D > 2) {
+      s[7] += ws * x[2];
+      s[8] += ws * x[2] * x[2];
+      s[9] += ws * x[0] * x[2];
+      s[10] += ws * x[1] * x[2];
+    }
+  }
+}
+
+void HistBuffer::flush()
+{
+  if (!mFilled) {
+    return;
+  }
+  std::array<double, 11> stats{};
+  mHist->GetStats(stats.data());
+  // same condition under which TH1::Fill creates the sum of squares of weights
+  if (mNonUnitWeights && mHist->GetSumw2N() == 0 && !mHist->TestBit(TH1::kIsNotW)) {
+    mHist->Sumw2();
+  }
+  TArrayD* sumw2 = mHist->GetSumw2N() ? mHist->GetSumw2() : nullptr;
+  for (size_t bin = 0; bin < mSumw.size(); ++bin) {
+    if (mSumw2[bin] != 0.) {
+      mHist->AddBinContent(bin, mSumw[bin]);
+      if (sumw2) {
+        sumw2->fArray[bin] += mSumw2[bin];
+      }
+    }
+  }
+  for (size_t i = 0; i < stats.size(); ++i) {
+    stats[i] += mStats[i];
+  }
+  mHist->PutStats(stats.data());
+  mHist->SetEntries(mHist->GetEntries() + mEntries);
+
+  std::fill(mSumw.begin(), mSumw.end(), 0.);
+  std::fill(mSumw2.begin(), mSumw2.end(), 0.);
+  mStats.fill(0.);
+  mEntries = 0.;
+  mNonUnitWeights = false;
+  mFilled = false;
+}
+
 } // namespace o2::framework
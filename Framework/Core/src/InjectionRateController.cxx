@@ -0,0 +1,64 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "InjectionRateController.h"
+#include <algorithm>
+
+namespace o2::framework
+{
+
+bool InjectionRateController::update(double pressure, double observedRate)
+{
+  if (cooldown > 0) {
+    cooldown--;
+  }
+  if (pressure >= highWatermark) {
+    if (cooldown > 0) {
+      return false;
+    }
+    double current = observedRate;
+    if (rate == 0) {
+      // Nothing is being injected, so limiting it would not help.
+      if (observedRate <= 0) {
+        return false;
+      }
+      unlimitedRate = observedRate;
+    } else if (observedRate <= 0 || observedRate > rate) {
+      // Do not cut based on a rate which readers are not actually reaching.
+      current = rate;
+    }
+    auto newRate = std::max(current * decreaseFactor, minRate);
+    cooldown = holdoff;
+    if (newRate == rate) {
+      return false;
+    }
+    rate = newRate;
+    return true;
+  }
+  if (pressure < lowWatermark && rate != 0) {
+    rate += increaseStep * unlimitedRate;
+    // We are back to where we started, no need for a limit anymore.
+    if (rate >= unlimitedRate) {
+      rate = 0;
+    }
+    return true;
+  }
+  return false;
+}
+
+uint64_t InjectionRateController::interval() const
+{
+  if (rate == 0) {
+    return 0;
+  }
+  return (uint64_t)(1000000. / rate);
+}
+
+} // namespace o2::framework
@@ -0,0 +1,61 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_INJECTIONRATECONTROLLER_H_
+#define O2_FRAMEWORK_INJECTIONRATECONTROLLER_H_
+
+#include <cstdint>
+
+namespace o2::framework
+{
+
+/// An AIMD controller for the rate at which the readers of a topology
+/// inject new timeslices. The input is the pressure on the rest of the
+/// topology, i.e. how full the most loaded resource is (the relayer of
+/// a device, or the shared memory budget), 1 meaning completely full.
+/// When the pressure goes above the high watermark the rate is cut
+/// multiplicatively, when it goes below the low watermark it grows
+/// back linearly, until the limit is not needed anymore.
+struct InjectionRateController {
+  /// Above this pressure the rate is cut
+  double highWatermark = 0.8;
+  /// Below this pressure the rate is increased
+  double lowWatermark = 0.5;
+  /// Fraction of the rate which is kept when cutting it
+  double decreaseFactor = 0.5;
+  /// Fraction of the unlimited rate which is added at each increase
+  double increaseStep = 0.05;
+  /// The rate never goes below this, in timeslices per second
+  double minRate = 0.01;
+  /// How many updates to wait after a cut before cutting again,
+  /// to give the time to the topology to drain.
+  int holdoff = 3;
+
+  /// The current limit, in timeslices per second. 0 means no limit.
+  double rate = 0;
+  /// The rate at which the readers were going when they were limited
+  /// for the first time.
+  double unlimitedRate = 0;
+  /// Updates to wait before cutting again
+  int cooldown = 0;
+
+  /// Update the limit given the current @a pressure and the @a observedRate
+  /// at which the readers injected timeslices since the last update.
+  /// @return true if the limit changed.
+  bool update(double pressure, double observedRate);
+
+  /// @return the minimum interval between two timeslices in
+  /// microseconds, 0 if there is no limit.
+  uint64_t interval() const;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_INJECTIONRATECONTROLLER_H_
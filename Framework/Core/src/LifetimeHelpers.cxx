@@ -27,6 +27,7 @@
 #include <fairmq/FairMQDevice.h>
 
 #include <cstdlib>
+#include <memory>
 
 using namespace o2::header;
 using namespace fair;
@@ -202,10 +203,14 @@ ExpirationHandler::Handler
     o2::vector<char> payloadBuffer{transport->GetMemoryResource()};
     payloadBuffer.reserve(10000); // we begin with messages of 10KB
 
-    CURL* curl = curl_easy_init();
+    // The handle is shared by all the conditions of the device and it is only reset between
+    // the fetches, so that the connection to the server is kept open and reused.
+    static thread_local std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> handle{curl_easy_init(), &curl_easy_cleanup};
+    CURL* curl = handle.get();
     if (curl == nullptr) {
       throw runtime_error("fetchFromCCDBCache: Unable to initialise CURL");
     }
+    curl_easy_reset(curl);
     CURLcode res;
     if (overrideTimestampMilliseconds) {
       timestamp = overrideTimestampMilliseconds;
@@ -239,8 +244,6 @@ ExpirationHandler::Handler
       throw runtime_error_f("fetchFromCCDBCache: HTTP error %d while fetching %s from CCDB", responseCode, url.c_str());
     }
 
-    curl_easy_cleanup(curl);
-
     DataHeader dh;
     dh.dataOrigin = matcher->origin;
     dh.dataDescription = matcher->description;
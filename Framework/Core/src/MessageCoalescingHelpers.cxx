@@ -0,0 +1,172 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "MessageCoalescingHelpers.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/Logger.h"
+#include "Framework/RuntimeError.h"
+#include "Headers/Stack.h"
+#include "MemoryResources/MemoryResources.h"
+#include <cstring>
+
+namespace o2::framework
+{
+
+namespace
+{
+constexpr size_t align8(size_t s)
+{
+  return (s + 7) & ~size_t{7};
+}
+} // namespace
+
+bool MessageCoalescingHelpers::isCoalesced(o2::header::DataHeader const& dh)
+{
+  return dh.dataOrigin == Origin && dh.dataDescription == Description;
+}
+
+size_t MessageCoalescingHelpers::coalescedSize(std::vector<Part> const& parts)
+{
+  size_t size = sizeof(uint64_t) + parts.size() * sizeof(IndexEntry);
+  for (auto& part : parts) {
+    size += align8(part.headerSize) + align8(part.payloadSize);
+  }
+  return size;
+}
+
+void MessageCoalescingHelpers::coalesce(std::vector<Part> const& parts, char* buffer)
+{
+  uint64_t count = parts.size();
+  memcpy(buffer, &count, sizeof(count));
+  auto* index = buffer + sizeof(uint64_t);
+  size_t offset = sizeof(uint64_t) + parts.size() * sizeof(IndexEntry);
+  for (size_t pi = 0; pi < parts.size(); ++pi) {
+    auto& part = parts[pi];
+    IndexEntry entry{offset, part.headerSize, offset + align8(part.headerSize), part.payloadSize};
+    memcpy(index + pi * sizeof(IndexEntry), &entry, sizeof(IndexEntry));
+    memcpy(buffer + entry.headerOffset, part.header, part.headerSize);
+    memcpy(buffer + entry.payloadOffset, part.payload, part.payloadSize);
+    offset = entry.payloadOffset + align8(part.payloadSize);
+  }
+}
+
+std::vector<MessageCoalescingHelpers::Part> MessageCoalescingHelpers::split(void const* buffer, size_t size)
+{
+  auto* data = reinterpret_cast<char const*>(buffer);
+  uint64_t count = 0;
+  if (size < sizeof(count)) {
+    throw runtime_error_f("Coalesced payload too small: %zu bytes", size);
+  }
+  memcpy(&count, data, sizeof(count));
+  if (count > (size - sizeof(count)) / sizeof(IndexEntry)) {
+    throw runtime_error_f("Coalesced payload of %zu bytes cannot contain %llu parts", size, (unsigned long long)count);
+  }
+  std::vector<Part> parts;
+  parts.reserve(count);
+  for (size_t pi = 0; pi < count; ++pi) {
+    IndexEntry entry;
+    memcpy(&entry, data + sizeof(count) + pi * sizeof(IndexEntry), sizeof(IndexEntry));
+    if (entry.headerOffset > size || entry.headerSize > size - entry.headerOffset ||
+        entry.payloadOffset > size || entry.payloadSize > size - entry.payloadOffset) {
+      throw runtime_error_f("Part %zu is outside the coalesced payload", pi);
+    }
+    parts.push_back(Part{data + entry.headerOffset, entry.headerSize, data + entry.payloadOffset, entry.payloadSize});
+  }
+  return parts;
+}
+
+void MessageCoalescingHelpers::coalesceParts(FairMQParts& parts, FairMQTransportFactory& transport, size_t threshold)
+{
+  std::vector<Part> small;
+  std::vector<size_t> smallIndices;
+  for (size_t pi = 0; pi + 1 < parts.Size(); pi += 2) {
+    auto* dh = o2::header::get<o2::header::DataHeader*>(parts.At(pi)->GetData());
+    if (dh == nullptr || dh->splitPayloadParts > 1 || parts.At(pi + 1)->GetSize() > threshold) {
+      continue;
+    }
+    small.push_back({parts.At(pi)->GetData(), parts.At(pi)->GetSize(), parts.At(pi + 1)->GetData(), parts.At(pi + 1)->GetSize()});
+    smallIndices.push_back(pi);
+  }
+  if (small.size() < 2) {
+    return;
+  }
+  auto* dph = o2::header::get<DataProcessingHeader*>(parts.At(smallIndices[0])->GetData());
+  if (dph == nullptr) {
+    return;
+  }
+  auto size = coalescedSize(small);
+  o2::header::DataHeader dh{Description, Origin, static_cast<o2::header::DataHeader::SubSpecificationType>(small.size()), size};
+  dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+
+  auto channelAlloc = o2::pmr::getTransportAllocator(&transport);
+  FairMQParts coalesced;
+  coalesced.AddPart(o2::pmr::getMessage(o2::header::Stack{channelAlloc, dh, *dph}));
+  auto payload = transport.CreateMessage(size);
+  coalesce(small, reinterpret_cast<char*>(payload->GetData()));
+  coalesced.AddPart(std::move(payload));
+  // The big ones go as they are, after the coalesced one.
+  size_t next = 0;
+  for (size_t pi = 0; pi + 1 < parts.Size(); pi += 2) {
+    if (next < smallIndices.size() && smallIndices[next] == pi) {
+      ++next;
+      continue;
+    }
+    coalesced.AddPart(std::move(parts.At(pi)));
+    coalesced.AddPart(std::move(parts.At(pi + 1)));
+  }
+  parts = std::move(coalesced);
+}
+
+size_t MessageCoalescingHelpers::splitParts(FairMQParts& parts, FairMQTransportFactory& transport)
+{
+  auto isCoalescedPart = [&parts](size_t pi) {
+    auto dh = o2::header::get<o2::header::DataHeader*>(parts.At(pi)->GetData());
+    return pi + 1 < parts.Size() && dh && isCoalesced(*dh);
+  };
+  bool hasCoalesced = false;
+  for (size_t pi = 0; pi < parts.Size() && !hasCoalesced; pi += 2) {
+    hasCoalesced = isCoalescedPart(pi);
+  }
+  if (hasCoalesced == false) {
+    return 0;
+  }
+  size_t dropped = 0;
+  FairMQParts result;
+  for (size_t pi = 0; pi < parts.Size(); pi += 2) {
+    if (isCoalescedPart(pi) == false) {
+      result.AddPart(std::move(parts.At(pi)));
+      if (pi + 1 < parts.Size()) {
+        result.AddPart(std::move(parts.At(pi + 1)));
+      }
+      continue;
+    }
+    std::vector<Part> split;
+    try {
+      split = MessageCoalescingHelpers::split(parts.At(pi + 1)->GetData(), parts.At(pi + 1)->GetSize());
+    } catch (RuntimeErrorRef& ref) {
+      LOGP(error, "Dropping malformed coalesced message: {}", error_from_ref(ref).what);
+      ++dropped;
+      continue;
+    }
+    // They are small by construction, so we simply copy them.
+    for (auto& part : split) {
+      auto header = transport.CreateMessage(part.headerSize);
+      memcpy(header->GetData(), part.header, part.headerSize);
+      auto payload = transport.CreateMessage(part.payloadSize);
+      memcpy(payload->GetData(), part.payload, part.payloadSize);
+      result.AddPart(std::move(header));
+      result.AddPart(std::move(payload));
+    }
+  }
+  parts = std::move(result);
+  return dropped;
+}
+
+} // namespace o2::framework
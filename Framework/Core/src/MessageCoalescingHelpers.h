@@ -0,0 +1,73 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_MESSAGECOALESCINGHELPERS_H_
+#define O2_FRAMEWORK_MESSAGECOALESCINGHELPERS_H_
+
+#include "Headers/DataHeader.h"
+#include <fairmq/FairMQParts.h>
+#include <fairmq/FairMQTransportFactory.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Small outputs going through the same channel can be coalesced in a single
+/// (header, payload) pair, to avoid paying the per message overhead for each
+/// of them. The header of such a pair is a DataHeader DPL/COALESCED, whose
+/// subSpecification is the number of parts it contains. The payload starts
+/// with an index of the coalesced parts, followed by their header stacks and
+/// payloads, each aligned to 8 bytes. The receiving device splits them again
+/// before relaying, so that the InputRecord sees the original parts.
+struct MessageCoalescingHelpers {
+  static constexpr o2::header::DataOrigin Origin{"DPL"};
+  static constexpr o2::header::DataDescription Description{"COALESCED"};
+
+  /// Entry of the index at the beginning of a coalesced payload.
+  /// Offsets are relative to the beginning of the payload.
+  struct IndexEntry {
+    uint64_t headerOffset;
+    uint64_t headerSize;
+    uint64_t payloadOffset;
+    uint64_t payloadSize;
+  };
+
+  /// A view on the header stack and the payload of one part.
+  struct Part {
+    void const* header;
+    size_t headerSize;
+    void const* payload;
+    size_t payloadSize;
+  };
+
+  /// @return true if @a dh is the header of coalesced parts
+  static bool isCoalesced(o2::header::DataHeader const& dh);
+  /// @return the size of the payload needed to coalesce @a parts
+  static size_t coalescedSize(std::vector<Part> const& parts);
+  /// Write @a parts in @a buffer, which must be at least coalescedSize(parts) big.
+  static void coalesce(std::vector<Part> const& parts, char* buffer);
+  /// @return views on the parts coalesced in the payload @a buffer of @a size bytes.
+  /// Throws in case the payload is malformed.
+  static std::vector<Part> split(void const* buffer, size_t size);
+
+  /// Replace the (header, payload) pairs in @a parts whose payload is at most
+  /// @a threshold bytes with a single coalesced pair, created with @a transport.
+  static void coalesceParts(FairMQParts& parts, FairMQTransportFactory& transport, size_t threshold);
+  /// Replace the coalesced pairs in @a parts with copies of the parts they
+  /// contain, created with @a transport. Malformed ones are dropped.
+  /// @return the number of coalesced pairs which were dropped
+  static size_t splitParts(FairMQParts& parts, FairMQTransportFactory& transport);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_MESSAGECOALESCINGHELPERS_H_
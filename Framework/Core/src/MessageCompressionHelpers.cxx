@@ -0,0 +1,196 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "MessageCompressionHelpers.h"
+#include "Framework/Logger.h"
+#include "Framework/PayloadCompressionHeader.h"
+#include "Framework/RuntimeError.h"
+#include "Headers/DataHeader.h"
+#include "Headers/Stack.h"
+#include "MemoryResources/MemoryResources.h"
+#include <Compression.h>
+#include <RZip.h>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace o2::framework
+{
+
+namespace
+{
+/// ROOT compresses at most this many bytes per block
+constexpr size_t MAX_BLOCK_SIZE = 0xffffff;
+/// Size of the header ROOT puts in front of each compressed block
+constexpr size_t BLOCK_HEADER_SIZE = 9;
+/// We want speed rather than ratio
+constexpr int COMPRESSION_LEVEL = 1;
+
+ROOT::RCompressionSetting::EAlgorithm::EValues asROOTAlgorithm(ChannelCompression algorithm)
+{
+  switch (algorithm) {
+    case ChannelCompression::LZ4:
+      return ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+    case ChannelCompression::ZSTD:
+      return ROOT::RCompressionSetting::EAlgorithm::kZSTD;
+    case ChannelCompression::None:
+      break;
+  }
+  throw runtime_error("Unsupported ChannelCompression");
+}
+} // namespace
+
+size_t MessageCompressionHelpers::compress(ChannelCompression algorithm, char const* source, size_t size, char* target, size_t targetSize)
+{
+  auto rootAlgorithm = asROOTAlgorithm(algorithm);
+  size_t written = 0;
+  for (size_t offset = 0; offset < size; offset += MAX_BLOCK_SIZE) {
+    int blockSize = std::min(size - offset, MAX_BLOCK_SIZE);
+    int available = std::min(targetSize - written, size_t{INT_MAX});
+    int compressed = 0;
+    R__zipMultipleAlgorithm(COMPRESSION_LEVEL, &blockSize, const_cast<char*>(source + offset), &available, target + written, &compressed, rootAlgorithm);
+    // Either it did not fit or ROOT decided it was not worth it.
+    if (compressed <= 0) {
+      return 0;
+    }
+    written += compressed;
+  }
+  return written < targetSize ? written : 0;
+}
+
+void MessageCompressionHelpers::decompress(char const* source, size_t size, char* target, size_t targetSize)
+{
+  auto* in = reinterpret_cast<unsigned char*>(const_cast<char*>(source));
+  auto* out = reinterpret_cast<unsigned char*>(target);
+  size_t read = 0;
+  size_t written = 0;
+  while (read < size) {
+    int blockSize = 0;
+    int uncompressedSize = 0;
+    if (size - read < BLOCK_HEADER_SIZE || R__unzip_header(&blockSize, in + read, &uncompressedSize) != 0) {
+      throw runtime_error_f("Malformed compressed block at offset %zu", read);
+    }
+    if (blockSize <= 0 || (size_t)blockSize > size - read || uncompressedSize <= 0 || (size_t)uncompressedSize > targetSize - written) {
+      throw runtime_error_f("Compressed block at offset %zu does not fit the payload", read);
+    }
+    int decompressed = 0;
+    R__unzip(&blockSize, in + read, &uncompressedSize, out + written, &decompressed);
+    if (decompressed != uncompressedSize) {
+      throw runtime_error_f("Unable to decompress block at offset %zu", read);
+    }
+    read += blockSize;
+    written += decompressed;
+  }
+  if (written != targetSize) {
+    throw runtime_error_f("Decompressed payload is %zu bytes rather than %zu", written, targetSize);
+  }
+}
+
+size_t MessageCompressionHelpers::strippedSize(std::byte const* stack)
+{
+  size_t size = 0;
+  for (auto* header = o2::header::BaseHeader::get(stack); header; header = header->next()) {
+    if (PayloadCompressionHeader::Get(header) == nullptr) {
+      size += header->size();
+    }
+  }
+  return size;
+}
+
+void MessageCompressionHelpers::strip(std::byte const* stack, std::byte* target)
+{
+  o2::header::BaseHeader* last = nullptr;
+  for (auto* header = o2::header::BaseHeader::get(stack); header; header = header->next()) {
+    if (PayloadCompressionHeader::Get(header)) {
+      continue;
+    }
+    memcpy(target, header->data(), header->size());
+    last = reinterpret_cast<o2::header::BaseHeader*>(target);
+    last->flagsNextHeader = true;
+    target += header->size();
+  }
+  if (last) {
+    last->flagsNextHeader = false;
+  }
+}
+
+void MessageCompressionHelpers::compressParts(FairMQParts& parts, FairMQTransportFactory& transport, ChannelCompression compression)
+{
+  using o2::header::DataHeader;
+  auto channelAlloc = o2::pmr::getTransportAllocator(&transport);
+  for (size_t pi = 0; pi + 1 < parts.Size(); pi += 2) {
+    auto& header = parts.At(pi);
+    auto& payload = parts.At(pi + 1);
+    auto* dh = o2::header::get<DataHeader*>(header->GetData());
+    if (dh == nullptr || dh->splitPayloadParts > 1 || payload->GetSize() < MinimumSize ||
+        o2::header::get<PayloadCompressionHeader*>(header->GetData())) {
+      continue;
+    }
+    auto compressed = transport.CreateMessage(payload->GetSize());
+    auto size = compress(compression, reinterpret_cast<char const*>(payload->GetData()), payload->GetSize(),
+                         reinterpret_cast<char*>(compressed->GetData()), compressed->GetSize());
+    if (size == 0) {
+      continue;
+    }
+    compressed->SetUsedSize(size);
+    PayloadCompressionHeader compressionHeader{static_cast<uint32_t>(compression), payload->GetSize()};
+    auto newHeader = o2::pmr::getMessage(o2::header::Stack{channelAlloc, reinterpret_cast<std::byte*>(header->GetData()), compressionHeader});
+    const_cast<DataHeader*>(o2::header::get<DataHeader*>(newHeader->GetData()))->payloadSize = size;
+    header = std::move(newHeader);
+    payload = std::move(compressed);
+  }
+}
+
+size_t MessageCompressionHelpers::decompressParts(FairMQParts& parts, FairMQTransportFactory& transport)
+{
+  using o2::header::DataHeader;
+  auto isCompressed = [&parts](size_t pi) {
+    return pi + 1 < parts.Size() && o2::header::get<PayloadCompressionHeader*>(parts.At(pi)->GetData());
+  };
+  bool hasCompressed = false;
+  for (size_t pi = 0; pi < parts.Size() && !hasCompressed; pi += 2) {
+    hasCompressed = isCompressed(pi);
+  }
+  if (hasCompressed == false) {
+    return 0;
+  }
+  size_t dropped = 0;
+  FairMQParts result;
+  for (size_t pi = 0; pi < parts.Size(); pi += 2) {
+    if (isCompressed(pi) == false) {
+      result.AddPart(std::move(parts.At(pi)));
+      if (pi + 1 < parts.Size()) {
+        result.AddPart(std::move(parts.At(pi + 1)));
+      }
+      continue;
+    }
+    auto* stack = reinterpret_cast<std::byte const*>(parts.At(pi)->GetData());
+    auto* ch = o2::header::get<PayloadCompressionHeader*>(stack);
+    auto& payload = parts.At(pi + 1);
+    auto uncompressed = transport.CreateMessage(ch->uncompressedSize);
+    try {
+      decompress(reinterpret_cast<char const*>(payload->GetData()), payload->GetSize(),
+                 reinterpret_cast<char*>(uncompressed->GetData()), uncompressed->GetSize());
+    } catch (RuntimeErrorRef& ref) {
+      LOGP(error, "Dropping payload which cannot be decompressed: {}", error_from_ref(ref).what);
+      ++dropped;
+      continue;
+    }
+    auto header = transport.CreateMessage(strippedSize(stack));
+    strip(stack, reinterpret_cast<std::byte*>(header->GetData()));
+    const_cast<DataHeader*>(o2::header::get<DataHeader*>(header->GetData()))->payloadSize = uncompressed->GetSize();
+    result.AddPart(std::move(header));
+    result.AddPart(std::move(uncompressed));
+  }
+  parts = std::move(result);
+  return dropped;
+}
+
+} // namespace o2::framework
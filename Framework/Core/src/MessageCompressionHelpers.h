@@ -0,0 +1,59 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_MESSAGECOMPRESSIONHELPERS_H_
+#define O2_FRAMEWORK_MESSAGECOMPRESSIONHELPERS_H_
+
+#include "Framework/ChannelSpec.h"
+#include <fairmq/FairMQParts.h>
+#include <fairmq/FairMQTransportFactory.h>
+#include <cstddef>
+
+namespace o2::framework
+{
+
+/// Large payloads going to channels which cross nodes can be compressed with
+/// a fast codec. The header stack of such a payload gets a
+/// PayloadCompressionHeader with the original size. Compression is done
+/// with ROOT's RZip in blocks, so that payloads of any size are supported.
+struct MessageCompressionHelpers {
+  /// Payloads smaller than this are not worth compressing
+  static constexpr size_t MinimumSize = 64 * 1024;
+
+  /// Compress the @a size bytes at @a source with @a algorithm in @a target,
+  /// which has space for @a targetSize bytes.
+  /// @return the size of the compressed payload, or 0 if the payload could
+  /// not be compressed in less than @a targetSize bytes.
+  static size_t compress(ChannelCompression algorithm, char const* source, size_t size, char* target, size_t targetSize);
+  /// Decompress the @a size bytes at @a source in @a target, which must be
+  /// exactly as big as the original payload, i.e. @a targetSize bytes.
+  /// Throws in case the payload is malformed.
+  static void decompress(char const* source, size_t size, char* target, size_t targetSize);
+
+  /// @return the size of the header stack at @a stack without its PayloadCompressionHeader
+  static size_t strippedSize(std::byte const* stack);
+  /// Copy the header stack at @a stack in @a target, without its PayloadCompressionHeader.
+  /// @a target must be at least strippedSize(stack) big.
+  static void strip(std::byte const* stack, std::byte* target);
+
+  /// Compress with @a compression the payloads in @a parts which are at least
+  /// MinimumSize big, in messages created with @a transport. Payloads which
+  /// do not get smaller are left as they are.
+  static void compressParts(FairMQParts& parts, FairMQTransportFactory& transport, ChannelCompression compression);
+  /// Replace the compressed payloads in @a parts with their decompressed
+  /// version, created with @a transport, and strip their PayloadCompressionHeader.
+  /// Those which cannot be decompressed are dropped.
+  /// @return the number of payloads which were dropped
+  static size_t decompressParts(FairMQParts& parts, FairMQTransportFactory& transport);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_MESSAGECOMPRESSIONHELPERS_H_
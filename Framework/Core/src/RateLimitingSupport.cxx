@@ -0,0 +1,197 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "RateLimitingSupport.h"
+#include "InjectionRateController.h"
+#include "Framework/CommonServices.h"
+#include "Framework/DeviceInfo.h"
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceSpec.h"
+#include "Framework/DevicesManager.h"
+#include "Framework/Logger.h"
+#include "Framework/ServiceRegistry.h"
+#include "Framework/ServiceRegistryHelpers.h"
+
+#include <boost/program_options/variables_map.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+
+// Make sure we can use aggregated initialisers.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+namespace o2::framework
+{
+
+struct AdaptiveRateLimitConfig {
+  bool enabled = false;
+  /// Shared memory which can be held by the timeslices in flight,
+  /// in bytes. 0 means it is not taken into account.
+  int64_t maxSharedMemory = 0;
+};
+
+namespace
+{
+/// How often the controller is updated, in milliseconds. The metrics
+/// it uses are sent by the devices once per second.
+constexpr size_t UPDATE_PERIOD = 1000;
+
+struct RateLimitingIndices {
+  size_t inflight = 0;
+  size_t inflightBytes = 0;
+  size_t capacity = 0;
+  size_t processedTimeslices = 0;
+};
+
+std::vector<RateLimitingIndices> createRateLimitingIndices(std::vector<DeviceMetricsInfo>& allDevicesMetrics)
+{
+  std::vector<RateLimitingIndices> results;
+  for (auto& info : allDevicesMetrics) {
+    RateLimitingIndices indices;
+    indices.inflight = DeviceMetricsHelper::bookNumericMetric<uint64_t>(info, "inputs/relayed/inflight");
+    indices.inflightBytes = DeviceMetricsHelper::bookNumericMetric<uint64_t>(info, "inputs/relayed/inflight_bytes");
+    indices.capacity = DeviceMetricsHelper::bookNumericMetric<uint64_t>(info, "inputs/relayed/capacity");
+    indices.processedTimeslices = DeviceMetricsHelper::bookNumericMetric<uint64_t>(info, "processed_timeslices");
+    results.push_back(indices);
+  }
+  return results;
+}
+
+/// @return the last value of the uint64_t metric at @a index, 0 if never received.
+uint64_t lastValue(DeviceMetricsInfo const& metrics, size_t index)
+{
+  if (index >= metrics.metrics.size()) {
+    return 0;
+  }
+  auto const& info = metrics.metrics[index];
+  if (info.filledMetrics == 0) {
+    return 0;
+  }
+  auto const& data = metrics.uint64Metrics.at(info.storeIdx);
+  return data.at((info.pos - 1) % data.size());
+}
+
+/// Readers are the devices which inject new timeslices in the topology,
+/// i.e. the ones which do not get any data from other devices.
+bool isReader(DeviceSpec const& spec)
+{
+  return std::all_of(spec.inputs.begin(), spec.inputs.end(), [](InputRoute const& route) {
+    auto lifetime = route.matcher.lifetime;
+    return lifetime == Lifetime::Timer || lifetime == Lifetime::Enumeration ||
+           lifetime == Lifetime::Signal || lifetime == Lifetime::Condition;
+  });
+}
+} // namespace
+
+o2::framework::ServiceSpec RateLimitingSupport::adaptiveRateLimitingSpec()
+{
+  return ServiceSpec{
+    .name = "adaptive-rate-limiting",
+    .init = [](ServiceRegistry&, DeviceState&, fair::mq::ProgOptions&) -> ServiceHandle {
+      return ServiceHandle{0, nullptr};
+    },
+    .configure = CommonServices::noConfiguration(),
+    .metricHandling = [](ServiceRegistry& registry,
+                         std::vector<DeviceMetricsInfo>& allDeviceMetrics,
+                         std::vector<DeviceSpec>& specs,
+                         std::vector<DeviceInfo>& infos,
+                         DeviceMetricsInfo& driverMetrics,
+                         size_t timestamp) {
+      auto& config = registry.get<AdaptiveRateLimitConfig>();
+      if (config.enabled == false) {
+        return;
+      }
+      // This is invoked once for each device which has the service,
+      // so we need to make sure we only update once per period.
+      static size_t lastUpdate = 0;
+      static uint64_t lastProcessed = 0;
+      static InjectionRateController controller;
+      static auto rateMetric = DeviceMetricsHelper::createNumericMetric<float>(driverMetrics, "adaptive-rate-limit");
+      static auto pressureMetric = DeviceMetricsHelper::createNumericMetric<float>(driverMetrics, "adaptive-rate-pressure");
+      static std::vector<RateLimitingIndices> allIndices = createRateLimitingIndices(allDeviceMetrics);
+      if (timestamp < lastUpdate + UPDATE_PERIOD) {
+        return;
+      }
+
+      double pressure = 0;
+      uint64_t totalInflightBytes = 0;
+      uint64_t processed = 0;
+      size_t readers = 0;
+      for (size_t di = 0; di < specs.size() && di < allDeviceMetrics.size(); ++di) {
+        auto& metrics = allDeviceMetrics[di];
+        auto& indices = allIndices[di];
+        totalInflightBytes += lastValue(metrics, indices.inflightBytes);
+        if (isReader(specs[di])) {
+          processed += lastValue(metrics, indices.processedTimeslices);
+          readers++;
+          continue;
+        }
+        auto capacity = lastValue(metrics, indices.capacity);
+        if (capacity) {
+          pressure = std::max(pressure, (double)lastValue(metrics, indices.inflight) / capacity);
+        }
+      }
+      if (config.maxSharedMemory) {
+        pressure = std::max(pressure, (double)totalInflightBytes / config.maxSharedMemory);
+      }
+      // The first time we only take the reference for the rate.
+      if (lastUpdate == 0 || readers == 0) {
+        lastUpdate = timestamp;
+        lastProcessed = processed;
+        return;
+      }
+      // The limit is per reader, so is the rate.
+      double observedRate = (double)(processed - std::min(processed, lastProcessed)) * 1000. / (timestamp - lastUpdate) / readers;
+      lastUpdate = timestamp;
+      lastProcessed = processed;
+      pressureMetric(driverMetrics, pressure, timestamp);
+
+      if (controller.update(pressure, observedRate) == false) {
+        return;
+      }
+      rateMetric(driverMetrics, controller.rate, timestamp);
+      if (controller.rate) {
+        LOGP(INFO, "Pressure on the topology at {:.2f}, limiting readers to {:.2f} timeslices/s (were at {:.2f})", pressure, controller.rate, observedRate);
+      } else {
+        LOGP(INFO, "Pressure on the topology at {:.2f}, readers are not limited anymore", pressure);
+      }
+      auto& manager = registry.get<DevicesManager>();
+      auto command = fmt::format("/rate-limit {}", controller.interval());
+      for (size_t di = 0; di < specs.size(); ++di) {
+        if (isReader(specs[di])) {
+          manager.queueMessage(specs[di].id.c_str(), command.c_str());
+        }
+      }
+    },
+    .driverInit = [](ServiceRegistry& registry, boost::program_options::variables_map const& vm) {
+      // Until we guarantee this is called only once...
+      static bool once = false;
+      if (once) {
+        return;
+      }
+      once = true;
+      auto config = new AdaptiveRateLimitConfig{};
+      if (vm.count("adaptive-rate-limiting")) {
+        config->enabled = std::stoll(vm["adaptive-rate-limiting"].as<std::string>()) != 0;
+      }
+      if (vm.count("adaptive-rate-limiting-shm")) {
+        config->maxSharedMemory = std::stoll(vm["adaptive-rate-limiting-shm"].as<std::string>()) * 1000000;
+      }
+      if (config->enabled) {
+        LOGP(INFO, "Adaptive rate limiting of the readers enabled, shared memory budget {}MB", config->maxSharedMemory / 1000000);
+      }
+      registry.registerService(ServiceRegistryHelpers::handleForService<AdaptiveRateLimitConfig>(config));
+    },
+    .kind = ServiceKind::Global};
+}
+
+} // namespace o2::framework
+#pragma GCC diagnostic pop
@@ -0,0 +1,28 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_RATELIMITINGSUPPORT_H_
+#define O2_FRAMEWORK_RATELIMITINGSUPPORT_H_
+
+#include "Framework/ServiceSpec.h"
+
+namespace o2::framework
+{
+
+/// ServiceSpecs to limit the rate at which timeslices enter a topology
+struct RateLimitingSupport {
+  /// Create the spec for the driver side controller which adapts the
+  /// rate of the readers to how loaded the rest of the topology is.
+  static ServiceSpec adaptiveRateLimitingSpec();
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_RATELIMITINGSUPPORT_H_
@@ -13,6 +13,15 @@
 #include "Framework/DataProcessingHeader.h"
 #include "Framework/DataSpecUtils.h"
 #include "Headers/DataHeader.h"
+#include "Headers/RAWDataHeader.h"
+#include "Headers/Stack.h"
+#include "Framework/Logger.h"
+
+#include <fairmq/FairMQDevice.h>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace o2
 {
@@ -45,5 +54,109 @@ InjectorFunction readoutAdapter(OutputSpec const& spec)
   };
 }
 
+namespace
+{
+/// consecutive raw pages of one link in a superpage
+struct RawPageSpan {
+  DataHeader::SubSpecificationType subSpec;
+  size_t offset;
+  size_t size;
+};
+
+/// walk the RDHs of the superpage and collect the spans of pages of the same link,
+/// returns false if the superpage is not a sequence of raw pages
+bool findRawPageSpans(const char* data, size_t size, RDHSubSpecSelector const& subSpecSelector, std::vector<RawPageSpan>& spans)
+{
+  spans.clear();
+  size_t offset = 0;
+  while (offset + sizeof(o2::header::RDHLowest) <= size) {
+    // the header size and the offset to the next page are at the same position in all the versions
+    auto rdh = reinterpret_cast<const o2::header::RDHLowest*>(data + offset);
+    size_t next = rdh->offsetToNext;
+    if (rdh->version < 4 || rdh->headerSize != sizeof(o2::header::RDHLowest) || next < rdh->headerSize || offset + next > size) {
+      return false;
+    }
+    auto subSpec = subSpecSelector(rdh);
+    if (spans.empty() || spans.back().subSpec != subSpec) {
+      spans.push_back({subSpec, offset, 0});
+    }
+    spans.back().size += next;
+    offset += next;
+  }
+  return offset == size;
+}
+} // namespace
+
+DataHeader::SubSpecificationType rdhFeeIdSubSpec(void const* rdh)
+{
+  auto version = reinterpret_cast<const o2::header::RDHLowest*>(rdh)->version;
+  if (version > 4) {
+    return reinterpret_cast<const o2::header::RAWDataHeaderV5*>(rdh)->feeId;
+  }
+  return reinterpret_cast<const o2::header::RAWDataHeaderV4*>(rdh)->feeId;
+}
+
+InjectorFunction readoutLinkAdapter(OutputSpec const& spec, RDHSubSpecSelector subSpecSelector)
+{
+  auto counter = std::make_shared<uint64_t>(0);
+  auto spans = std::make_shared<std::vector<RawPageSpan>>();
+
+  return [spec, subSpecSelector, counter, spans](FairMQDevice& device, FairMQParts& parts, ChannelRetriever channelRetriever) {
+    ConcreteDataTypeMatcher dataType = DataSpecUtils::asConcreteDataTypeMatcher(spec);
+    DataProcessingHeader dph{*counter, 0};
+    (*counter) += 1UL;
+
+    std::unordered_map<std::string, FairMQParts> outputs;
+    auto getChannel = [&](DataHeader::SubSpecificationType subSpec) -> std::string {
+      auto channelName = channelRetriever(OutputSpec{dataType.origin, dataType.description, subSpec}, dph.startTime);
+      if (channelName.empty()) {
+        LOG(WARNING) << "can not find matching channel for " << DataSpecUtils::describe(OutputSpec{dataType.origin, dataType.description, subSpec});
+      }
+      return channelName;
+    };
+    auto addPart = [&](std::string const& channelName, DataHeader::SubSpecificationType subSpec, FairMQMessagePtr&& payload) {
+      DataHeader dh;
+      dh.dataOrigin = dataType.origin;
+      dh.dataDescription = dataType.description;
+      dh.subSpecification = subSpec;
+      dh.payloadSize = payload->GetSize();
+      dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+      auto channelAlloc = o2::pmr::getTransportAllocator(device.fChannels.at(channelName).at(0).Transport());
+      auto& channelParts = outputs[channelName];
+      channelParts.AddPart(o2::pmr::getMessage(o2::header::Stack{dh, dph}, channelAlloc));
+      channelParts.AddPart(std::move(payload));
+    };
+
+    for (size_t i = 0; i < parts.Size(); ++i) {
+      auto& superpage = parts.At(i);
+      if (!findRawPageSpans(reinterpret_cast<const char*>(superpage->GetData()), superpage->GetSize(), subSpecSelector, *spans)) {
+        LOG(ERROR) << "superpage " << i << " of size " << superpage->GetSize() << " is not a sequence of raw pages, dropping it";
+        continue;
+      }
+      if (spans->size() == 1) {
+        // a single link, the superpage is forwarded as it is
+        auto channelName = getChannel(spans->front().subSpec);
+        if (!channelName.empty()) {
+          addPart(channelName, spans->front().subSpec, std::move(superpage));
+        }
+        continue;
+      }
+      for (auto const& span : *spans) {
+        auto channelName = getChannel(span.subSpec);
+        if (channelName.empty()) {
+          continue;
+        }
+        auto payload = device.fChannels.at(channelName).at(0).Transport()->CreateMessage(span.size);
+        memcpy(payload->GetData(), reinterpret_cast<const char*>(superpage->GetData()) + span.offset, span.size);
+        addPart(channelName, span.subSpec, std::move(payload));
+      }
+    }
+
+    for (auto& [channelName, channelParts] : outputs) {
+      sendOnChannel(device, channelParts, channelName);
+    }
+  };
+}
+
 } // namespace framework
 } // namespace o2
@@ -55,4 +55,10 @@ ResourcePolicy ResourcePolicyHelpers::sharedMemoryBoundTask(char const* s, int r
       return accumulated.sharedMemory >= requestedSharedMemory ? OfferScore::Enough : OfferScore::More; }};
 }
 
+ResourcePolicy ResourcePolicyHelpers::withAffinity(ResourcePolicy policy, ResourcePolicy::Affinity affinity)
+{
+  policy.affinity = affinity;
+  return policy;
+}
+
 } // namespace o2::framework
@@ -15,6 +15,7 @@
 // this storage container is optimized for small memory usage
 //   under/over flow bins do not exist
 //   sumw2 structure is float only and only create when the weight != 1
+//   the bins of every step are stored in chunks, which are only allocated once a bin in them is filled
 //
 // Templated version allows also the use of double as storage container
 
@@ -25,6 +26,10 @@
 #include "TArrayD.h"
 #include "THn.h"
 #include "TMath.h"
+#include "TBuffer.h"
+#include "TClass.h"
+
+#include <vector>
 
 ClassImp(StepTHn);
 templateClassImp(StepTHnT);
@@ -32,6 +37,9 @@ templateClassImp(StepTHnT);
 StepTHn::StepTHn() : mNBins(0),
                      mNVars(0),
                      mNSteps(0),
+                     mChunkSize(DefaultChunkSize),
+                     mNChunks(0),
+                     mNArrays(0),
                      mValues(nullptr),
                      mSumw2(nullptr),
                      mTarget(nullptr),
@@ -48,6 +56,9 @@ StepTHn::StepTHn(const Char_t* name, const Char_t* title, const Int_t nSteps, co
                                                                                                    mNBins(0),
                                                                                                    mNVars(nAxes),
                                                                                                    mNSteps(nSteps),
+                                                                                                   mChunkSize(DefaultChunkSize),
+                                                                                                   mNChunks(0),
+                                                                                                   mNArrays(0),
                                                                                                    mValues(nullptr),
                                                                                                    mSumw2(nullptr),
                                                                                                    mTarget(nullptr),
@@ -63,8 +74,7 @@ StepTHn::StepTHn(const Char_t* name, const Char_t* title, const Int_t nSteps, co
   // Therefore you can easily create many steps which are only filled under certain analysis settings.
   // For each step a <nAxes> dimensional histogram is created.
   // The axis have <nBins[i]> bins. The bin edges are given in <binEdges[i]>. If there are only two bin edges, equidistant binning is set.
-
-  init();
+  // The storage is initialized by the derived constructors, once the number of bins is known.
 }
 
 // root-like constructor
@@ -75,6 +85,7 @@ StepTHnT<TemplateArray>::StepTHnT(const char* name, const char* title, const int
   for (Int_t i = 0; i < mNVars; i++) {
     mNBins *= nBins[i];
   }
+  init();
   mPrototype = new THnSparseT<TemplateArray>(Form("%s_sparse", name), title, nAxes, nBins, xmin, xmax);
 }
 
@@ -86,6 +97,7 @@ StepTHnT<TemplateArray>::StepTHnT(const Char_t* name, const Char_t* title, const
   for (Int_t i = 0; i < mNVars; i++) {
     mNBins *= nBins[i];
   }
+  init();
   mPrototype = new THnSparseT<TemplateArray>(Form("%s_sparse", name), title, nAxes, nBins);
 
   for (Int_t i = 0; i < mNVars; i++) {
@@ -103,22 +115,65 @@ StepTHnT<TemplateArray>::StepTHnT(const Char_t* name, const Char_t* title, const
 
 void StepTHn::init()
 {
-  // initialize
+  // initialize the storage, the chunks themselves are allocated when they are filled
 
-  mValues = new TArray*[mNSteps];
-  mSumw2 = new TArray*[mNSteps];
+  if (mChunkSize <= 0 || mChunkSize > mNBins) {
+    mChunkSize = mNBins;
+  }
+  mNChunks = mChunkSize > 0 ? (mNBins + mChunkSize - 1) / mChunkSize : 0;
+  mNArrays = mNSteps * mNChunks;
 
-  for (Int_t i = 0; i < mNSteps; i++) {
+  mValues = new TArray*[mNArrays];
+  mSumw2 = new TArray*[mNArrays];
+
+  for (Int_t i = 0; i < mNArrays; i++) {
     mValues[i] = nullptr;
     mSumw2[i] = nullptr;
   }
 }
 
+void StepTHn::setChunkSize(Long64_t chunkSize)
+{
+  // change the number of bins per storage chunk, only possible as long as nothing is filled
+
+  for (Int_t i = 0; i < mNArrays; i++) {
+    if (mValues[i] || mSumw2[i]) {
+      LOGF(error, "Cannot change the chunk size of %s after it was filled", GetName());
+      return;
+    }
+  }
+  delete[] mValues;
+  delete[] mSumw2;
+  mChunkSize = chunkSize;
+  init();
+}
+
+void StepTHn::Streamer(TBuffer& buffer)
+{
+  // stream the object, the dense storage of version 1 corresponds to a single chunk per step
+
+  if (buffer.IsReading()) {
+    UInt_t start = 0, count = 0;
+    Version_t version = buffer.ReadVersion(&start, &count);
+    StepTHn::Class()->ReadBuffer(buffer, this, version, start, count);
+    if (version < 2) {
+      mChunkSize = mNBins;
+      mNChunks = 1;
+      mNArrays = mNSteps;
+    }
+  } else {
+    StepTHn::Class()->WriteBuffer(buffer, this);
+  }
+}
+
 StepTHn::StepTHn(const StepTHn& c) : mNBins(c.mNBins),
                                      mNVars(c.mNVars),
                                      mNSteps(c.mNSteps),
-                                     mValues(new TArray*[c.mNSteps]),
-                                     mSumw2(new TArray*[c.mNSteps]),
+                                     mChunkSize(c.mChunkSize),
+                                     mNChunks(c.mNChunks),
+                                     mNArrays(c.mNArrays),
+                                     mValues(nullptr),
+                                     mSumw2(nullptr),
                                      mTarget(nullptr),
                                      mAxisCache(nullptr),
                                      mNbinsCache(nullptr),
@@ -153,7 +208,7 @@ void StepTHn::deleteContainers()
 {
   // delete data containers
 
-  for (Int_t i = 0; i < mNSteps; i++) {
+  for (Int_t i = 0; i < mNArrays; i++) {
     if (mValues && mValues[i]) {
       delete mValues[i];
       mValues[i] = nullptr;
@@ -163,7 +218,9 @@ void StepTHn::deleteContainers()
       delete mSumw2[i];
       mSumw2[i] = nullptr;
     }
+  }
 
+  for (Int_t i = 0; i < mNSteps; i++) {
     if (mTarget && mTarget[i]) {
       delete mTarget[i];
       mTarget[i] = nullptr;
@@ -193,18 +250,19 @@ void StepTHn::Copy(TObject& c) const
   target.mNBins = mNBins;
   target.mNVars = mNVars;
   target.mNSteps = mNSteps;
+  target.mChunkSize = mChunkSize;
 
   target.init();
 
-  for (Int_t i = 0; i < mNSteps; i++) {
+  for (Int_t i = 0; i < mNArrays; i++) {
     if (mValues[i]) {
-      target.mValues[i] = createArray(mValues[i]);
+      target.mValues[i] = createArray(0, mValues[i]);
     } else {
       target.mValues[i] = nullptr;
     }
 
     if (mSumw2[i]) {
-      target.mSumw2[i] = createArray(mSumw2[i]);
+      target.mSumw2[i] = createArray(0, mSumw2[i]);
     } else {
       target.mSumw2[i] = nullptr;
     }
@@ -239,29 +297,20 @@ Long64_t StepTHnT<TemplateArray>::Merge(TCollection* list)
     if (entry == nullptr) {
       continue;
     }
+    if (entry->mNBins != mNBins || entry->mNSteps != mNSteps) {
+      LOGF(error, "Cannot merge %s with %lld bins and %d steps into %s with %lld bins and %d steps", entry->GetName(), entry->mNBins, entry->mNSteps, GetName(), mNBins, mNSteps);
+      continue;
+    }
 
+    // chunks which are not allocated in the entry are skipped
     for (Int_t i = 0; i < mNSteps; i++) {
-      if (entry->mValues[i]) {
-        if (!mValues[i]) {
-          mValues[i] = createArray();
+      for (Int_t c = 0; c < entry->mNChunks; c++) {
+        Long64_t firstBin = c * entry->mChunkSize;
+        if (entry->mValues[i * entry->mNChunks + c]) {
+          addToChunks(mValues, i, firstBin, *dynamic_cast<TemplateArray*>(entry->mValues[i * entry->mNChunks + c]));
         }
-
-        auto source = dynamic_cast<TemplateArray*>(entry->mValues[i])->GetArray();
-        auto target = dynamic_cast<TemplateArray*>(mValues[i])->GetArray();
-        for (Long64_t l = 0; l < mNBins; l++) {
-          target[l] += source[l];
-        }
-      }
-
-      if (entry->mSumw2[i]) {
-        if (!mSumw2[i]) {
-          mSumw2[i] = createArray();
-        }
-
-        auto source = dynamic_cast<TemplateArray*>(entry->mSumw2[i])->GetArray();
-        auto target = dynamic_cast<TemplateArray*>(mSumw2[i])->GetArray();
-        for (Long64_t l = 0; l < mNBins; l++) {
-          target[l] += source[l];
+        if (entry->mSumw2[i * entry->mNChunks + c]) {
+          addToChunks(mSumw2, i, firstBin, *dynamic_cast<TemplateArray*>(entry->mSumw2[i * entry->mNChunks + c]));
         }
       }
     }
@@ -272,6 +321,30 @@ Long64_t StepTHnT<TemplateArray>::Merge(TCollection* list)
   return count + 1;
 }
 
+template <class TemplateArray>
+void StepTHnT<TemplateArray>::addToChunks(TArray** arrays, Int_t step, Long64_t firstBin, const TemplateArray& source)
+{
+  // adds the source array, which starts at the global bin firstBin, to the chunks of the given step
+  // the source may have a different chunk size (e.g. a single chunk per step)
+
+  const auto sourceBins = source.GetArray();
+  for (Long64_t l = 0; l < source.GetSize();) {
+    Long64_t bin = firstBin + l;
+    Int_t chunk = bin / mChunkSize;
+    Long64_t offset = bin - chunk * mChunkSize;
+    auto& array = arrays[step * mNChunks + chunk];
+    if (!array) {
+      array = createArray(getChunkBins(chunk));
+    }
+    auto targetBins = static_cast<TemplateArray*>(array)->GetArray();
+    Long64_t n = std::min<Long64_t>(source.GetSize() - l, array->GetSize() - offset);
+    for (Long64_t m = 0; m < n; m++) {
+      targetBins[offset + m] += sourceBins[l + m];
+    }
+    l += n;
+  }
+}
+
 Long64_t StepTHn::getGlobalBinIndex(const Int_t* binIdx)
 {
   // calculates global bin index
@@ -291,7 +364,14 @@ void StepTHn::createTarget(Int_t step, Bool_t sparse)
 {
   // fills the information stored in the buffer in this class into the target THn
 
-  if (!mValues[step]) {
+  bool empty = true;
+  for (Int_t c = 0; c < mNChunks; c++) {
+    if (mValues[step * mNChunks + c]) {
+      empty = false;
+      break;
+    }
+  }
+  if (empty) {
     LOGF(fatal, "Histogram request for step %d which is empty.", step);
     return;
   }
@@ -307,13 +387,6 @@ void StepTHn::createTarget(Int_t step, Bool_t sparse)
     return;
   }
 
-  TArray* source = mValues[step];
-  // if mSumw2 is not stored, the sqrt of the number of bin entries in source is filled below; otherwise we use mSumw2
-  TArray* sourceSumw2 = source;
-  if (mSumw2[step]) {
-    sourceSumw2 = mSumw2[step];
-  }
-
   if (sparse) {
     mTarget[step] = THnSparse::CreateSparse(Form("%s_%d", GetName(), step), Form("%s_%d", GetTitle(), step), mPrototype);
   } else {
@@ -325,49 +398,45 @@ void StepTHn::createTarget(Int_t step, Bool_t sparse)
   Int_t* binIdx = new Int_t[mNVars];
   Int_t* nBins = new Int_t[mNVars];
   for (Int_t j = 0; j < mNVars; j++) {
-    binIdx[j] = 1;
     nBins[j] = target->GetAxis(j)->GetNbins();
   }
 
   Long64_t count = 0;
 
-  while (1) {
-    //       for (Int_t j=0; j<mNVars; j++)
-    //         printf("%d ", binIdx[j]);
-
-    Long64_t globalBin = getGlobalBinIndex(binIdx);
-    //       Printf(" --> %lld", globalBin);
+  // only the allocated chunks are visited
+  for (Int_t c = 0; c < mNChunks; c++) {
+    TArray* source = mValues[step * mNChunks + c];
+    if (!source) {
+      continue;
+    }
+    // if mSumw2 is not stored, the sqrt of the number of bin entries in source is filled below; otherwise we use mSumw2
+    TArray* sourceSumw2 = mSumw2[step * mNChunks + c] ? mSumw2[step * mNChunks + c] : source;
 
-    // TODO probably slow
-    double value = source->GetAt(globalBin);
-    if (value != 0) {
+    for (Long64_t l = 0; l < source->GetSize(); l++) {
+      double value = source->GetAt(l);
+      if (value == 0) {
+        continue;
+      }
+      // axis bin indices of the global bin, the last axis runs fastest
+      Long64_t globalBin = c * mChunkSize + l;
+      for (Int_t j = mNVars - 1; j >= 0; j--) {
+        binIdx[j] = globalBin % nBins[j] + 1;
+        globalBin /= nBins[j];
+      }
       target->SetBinContent(binIdx, value);
-      target->SetBinError(binIdx, TMath::Sqrt(sourceSumw2->GetAt(globalBin)));
+      target->SetBinError(binIdx, TMath::Sqrt(sourceSumw2->GetAt(l)));
 
       count++;
     }
 
-    binIdx[mNVars - 1]++;
-
-    for (Int_t j = mNVars - 1; j > 0; j--) {
-      if (binIdx[j] > nBins[j]) {
-        binIdx[j] = 1;
-        binIdx[j - 1]++;
-      }
-    }
-
-    if (binIdx[0] > nBins[0]) {
-      break;
-    }
+    delete mValues[step * mNChunks + c];
+    mValues[step * mNChunks + c] = nullptr;
   }
 
-  LOGF(info, "Step %d: copied %lld entries out of %lld bins", step, count, getGlobalBinIndex(binIdx));
+  LOGF(info, "Step %d: copied %lld entries out of %lld bins", step, count, mNBins);
 
   delete[] binIdx;
   delete[] nBins;
-
-  delete mValues[step];
-  mValues[step] = nullptr;
 }
 
 void StepTHn::Fill(int iStep, int nParams, double positionAndWeight[])
@@ -427,23 +496,41 @@ void StepTHn::Fill(int iStep, int nParams, double positionAndWeight[])
     //     Printf("%lld", bin);
   }
 
-  if (!mValues[iStep]) {
-    mValues[iStep] = createArray();
-    LOGF(info, "Created values container for step %d", iStep);
+  Int_t chunk = bin / mChunkSize;
+  bin -= chunk * mChunkSize;
+  Int_t index = iStep * mNChunks + chunk;
+
+  if (!mValues[index]) {
+    mValues[index] = createArray(getChunkBins(chunk));
+    LOGF(debug, "Created values container for step %d, chunk %d", iStep, chunk);
   }
 
   if (weight != 1.) {
     // initialize with already filled entries (which have been filled with weight == 1), in this case mSumw2 := mValues
-    if (!mSumw2[iStep]) {
-      mSumw2[iStep] = createArray();
-      LOGF(info, "Created sumw2 container for step %d", iStep);
+    if (!mSumw2[index]) {
+      mSumw2[index] = createArray(getChunkBins(chunk));
+      LOGF(debug, "Created sumw2 container for step %d, chunk %d", iStep, chunk);
     }
   }
 
   // TODO probably slow; add StepTHnT::add ?
-  mValues[iStep]->SetAt(mValues[iStep]->GetAt(bin) + weight, bin);
-  if (mSumw2[iStep]) {
-    mSumw2[iStep]->SetAt(mSumw2[iStep]->GetAt(bin) + weight, bin);
+  mValues[index]->SetAt(mValues[index]->GetAt(bin) + weight, bin);
+  if (mSumw2[index]) {
+    mSumw2[index]->SetAt(mSumw2[index]->GetAt(bin) + weight, bin);
+  }
+}
+
+void StepTHn::FillN(int iStep, int nEntries, const double* values, const double* weights)
+{
+  // fill nEntries entries, the coordinates of the entries follow each other in values
+
+  std::vector<double> positionAndWeight(mNVars + 1);
+  for (int i = 0; i < nEntries; i++) {
+    std::copy(values + i * mNVars, values + (i + 1) * mNVars, positionAndWeight.begin());
+    if (weights) {
+      positionAndWeight[mNVars] = weights[i];
+    }
+    Fill(iStep, weights ? mNVars + 1 : mNVars, positionAndWeight.data());
   }
 }
 
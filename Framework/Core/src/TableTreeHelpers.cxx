@@ -14,6 +14,8 @@
 
 #include "arrow/type_traits.h"
 #include <arrow/util/key_value_metadata.h>
+#include <TBranch.h>
+#include <TBufferFile.h>
 
 namespace o2::framework
 {
@@ -82,6 +84,13 @@ class ColumnIterator
   int64_t mNumberElements;
   const char* mColumnName;
 
+  // branches of fixed-size values are read in bulk, one basket at a time,
+  // instead of entry by entry with a TTreeReaderValue/Array
+  TBranch* mBranch = nullptr;
+  bool mBulk = false;
+  Long64_t mNextEntry = 0;
+  TBufferFile mBulkBuffer{TBuffer::kWrite, 32 * 1024};
+
   std::shared_ptr<arrow::Field> mField;
   std::shared_ptr<arrow::Array> mArray;
 
@@ -95,6 +104,12 @@ class ColumnIterator
   // copy the TTreeReaderValue to the arrow::TBuilder
   void push();
 
+  // is the branch read in bulk
+  bool isBulk() const { return mBulk; }
+
+  // copy the baskets of the branch up to entry end to the arrow::TBuilder
+  void pushBulk(Long64_t end);
+
   // reserve enough space to push s elements without reallocating
   void reserve(size_t s);
 
@@ -474,6 +489,8 @@ ColumnIterator::ColumnIterator(TTreeReader& reader, const char* colname)
   if (pos0 > 0 && pos1 > 0) {
     mNumberElements = atoi(branchTitle.substr(pos0 + 1, pos1 - pos0 - 1).c_str());
   }
+  mBranch = br;
+  mBulk = br->SupportsBulkRead();
 
   // initialize the TTreeReaderValue<T> / TTreeReaderArray<T>
   //            the corresponding arrow::TBuilder
@@ -485,47 +502,47 @@ ColumnIterator::ColumnIterator(TTreeReader& reader, const char* colname)
   if (mNumberElements == 1) {
     switch (mElementType) {
       case EDataType::kBool_t:
-        mReaderValue_o = new TTreeReaderValue<bool>(reader, mColumnName);
+        mReaderValue_o = mBulk ? nullptr : new TTreeReaderValue<bool>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(bool, 1, mTableBuilder_o);
         break;
       case EDataType::kUChar_t:
-        mReaderValue_ub = new TTreeReaderValue<uint8_t>(reader, mColumnName);
+        mReaderValue_ub = mBulk ? nullptr : new TTreeReaderValue<uint8_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(uint8_t, 1, mTableBuilder_ub);
         break;
       case EDataType::kUShort_t:
-        mReaderValue_us = new TTreeReaderValue<uint16_t>(reader, mColumnName);
+        mReaderValue_us = mBulk ? nullptr : new TTreeReaderValue<uint16_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(uint16_t, 1, mTableBuilder_us);
         break;
       case EDataType::kUInt_t:
-        mReaderValue_ui = new TTreeReaderValue<uint32_t>(reader, mColumnName);
+        mReaderValue_ui = mBulk ? nullptr : new TTreeReaderValue<uint32_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(uint32_t, 1, mTableBuilder_ui);
         break;
       case EDataType::kULong64_t:
-        mReaderValue_ul = new TTreeReaderValue<ULong64_t>(reader, mColumnName);
+        mReaderValue_ul = mBulk ? nullptr : new TTreeReaderValue<ULong64_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(uint64_t, 1, mTableBuilder_ul);
         break;
       case EDataType::kChar_t:
-        mReaderValue_b = new TTreeReaderValue<int8_t>(reader, mColumnName);
+        mReaderValue_b = mBulk ? nullptr : new TTreeReaderValue<int8_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(int8_t, 1, mTableBuilder_b);
         break;
       case EDataType::kShort_t:
-        mReaderValue_s = new TTreeReaderValue<int16_t>(reader, mColumnName);
+        mReaderValue_s = mBulk ? nullptr : new TTreeReaderValue<int16_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(int16_t, 1, mTableBuilder_s);
         break;
       case EDataType::kInt_t:
-        mReaderValue_i = new TTreeReaderValue<int32_t>(reader, mColumnName);
+        mReaderValue_i = mBulk ? nullptr : new TTreeReaderValue<int32_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(int32_t, 1, mTableBuilder_i);
         break;
       case EDataType::kLong64_t:
-        mReaderValue_l = new TTreeReaderValue<int64_t>(reader, mColumnName);
+        mReaderValue_l = mBulk ? nullptr : new TTreeReaderValue<int64_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(int64_t, 1, mTableBuilder_l);
         break;
       case EDataType::kFloat_t:
-        mReaderValue_f = new TTreeReaderValue<float>(reader, mColumnName);
+        mReaderValue_f = mBulk ? nullptr : new TTreeReaderValue<float>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(float, 1, mTableBuilder_f);
         break;
       case EDataType::kDouble_t:
-        mReaderValue_d = new TTreeReaderValue<double>(reader, mColumnName);
+        mReaderValue_d = mBulk ? nullptr : new TTreeReaderValue<double>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(double, 1, mTableBuilder_d);
         break;
       default:
@@ -535,47 +552,47 @@ ColumnIterator::ColumnIterator(TTreeReader& reader, const char* colname)
   } else {
     switch (mElementType) {
       case EDataType::kBool_t:
-        mReaderArray_o = new TTreeReaderArray<bool>(reader, mColumnName);
+        mReaderArray_o = mBulk ? nullptr : new TTreeReaderArray<bool>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(bool, mNumberElements, mTableBuilder_o);
         break;
       case EDataType::kUChar_t:
-        mReaderArray_ub = new TTreeReaderArray<uint8_t>(reader, mColumnName);
+        mReaderArray_ub = mBulk ? nullptr : new TTreeReaderArray<uint8_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(uint8_t, mNumberElements, mTableBuilder_ub);
         break;
       case EDataType::kUShort_t:
-        mReaderArray_us = new TTreeReaderArray<uint16_t>(reader, mColumnName);
+        mReaderArray_us = mBulk ? nullptr : new TTreeReaderArray<uint16_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(uint16_t, mNumberElements, mTableBuilder_us);
         break;
       case EDataType::kUInt_t:
-        mReaderArray_ui = new TTreeReaderArray<uint32_t>(reader, mColumnName);
+        mReaderArray_ui = mBulk ? nullptr : new TTreeReaderArray<uint32_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(uint32_t, mNumberElements, mTableBuilder_ui);
         break;
       case EDataType::kULong64_t:
-        mReaderArray_ul = new TTreeReaderArray<uint64_t>(reader, mColumnName);
+        mReaderArray_ul = mBulk ? nullptr : new TTreeReaderArray<uint64_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(uint64_t, mNumberElements, mTableBuilder_ul);
         break;
       case EDataType::kChar_t:
-        mReaderArray_b = new TTreeReaderArray<int8_t>(reader, mColumnName);
+        mReaderArray_b = mBulk ? nullptr : new TTreeReaderArray<int8_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(int8_t, mNumberElements, mTableBuilder_b);
         break;
       case EDataType::kShort_t:
-        mReaderArray_s = new TTreeReaderArray<int16_t>(reader, mColumnName);
+        mReaderArray_s = mBulk ? nullptr : new TTreeReaderArray<int16_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(int16_t, mNumberElements, mTableBuilder_s);
         break;
       case EDataType::kInt_t:
-        mReaderArray_i = new TTreeReaderArray<int32_t>(reader, mColumnName);
+        mReaderArray_i = mBulk ? nullptr : new TTreeReaderArray<int32_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(int32_t, mNumberElements, mTableBuilder_i);
         break;
       case EDataType::kLong64_t:
-        mReaderArray_l = new TTreeReaderArray<int64_t>(reader, mColumnName);
+        mReaderArray_l = mBulk ? nullptr : new TTreeReaderArray<int64_t>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(int64_t, mNumberElements, mTableBuilder_l);
         break;
       case EDataType::kFloat_t:
-        mReaderArray_f = new TTreeReaderArray<float>(reader, mColumnName);
+        mReaderArray_f = mBulk ? nullptr : new TTreeReaderArray<float>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(float, mNumberElements, mTableBuilder_f);
         break;
       case EDataType::kDouble_t:
-        mReaderArray_d = new TTreeReaderArray<double>(reader, mColumnName);
+        mReaderArray_d = mBulk ? nullptr : new TTreeReaderArray<double>(reader, mColumnName);
         MAKE_FIELD_AND_BUILDER(double, mNumberElements, mTableBuilder_d);
         break;
       default:
@@ -765,6 +782,66 @@ void ColumnIterator::push()
   }
 }
 
+void ColumnIterator::pushBulk(Long64_t end)
+{
+  arrow::Status stat;
+
+  while (mNextEntry < end) {
+    // the buffer holds the values of all the entries of the next basket,
+    // already converted to the host byte order
+    auto n = mBranch->GetBulkRead().GetBulkEntries(mNextEntry, mBulkBuffer);
+    if (n <= 0) {
+      LOGP(FATAL, "Can not read entry {} of branch {}", mNextEntry, mColumnName);
+      return;
+    }
+    mNextEntry += n;
+
+    auto data = mBulkBuffer.GetCurrent();
+    auto nValues = n * mNumberElements;
+    if (mNumberElements > 1) {
+      stat = mTableBuilder_list->AppendValues(n);
+    }
+    switch (mElementType) {
+      case EDataType::kBool_t:
+        stat &= mTableBuilder_o->AppendValues(reinterpret_cast<const uint8_t*>(data), nValues);
+        break;
+      case EDataType::kUChar_t:
+        stat &= mTableBuilder_ub->AppendValues(reinterpret_cast<const uint8_t*>(data), nValues);
+        break;
+      case EDataType::kUShort_t:
+        stat &= mTableBuilder_us->AppendValues(reinterpret_cast<const uint16_t*>(data), nValues);
+        break;
+      case EDataType::kUInt_t:
+        stat &= mTableBuilder_ui->AppendValues(reinterpret_cast<const uint32_t*>(data), nValues);
+        break;
+      case EDataType::kULong64_t:
+        stat &= mTableBuilder_ul->AppendValues(reinterpret_cast<const uint64_t*>(data), nValues);
+        break;
+      case EDataType::kChar_t:
+        stat &= mTableBuilder_b->AppendValues(reinterpret_cast<const int8_t*>(data), nValues);
+        break;
+      case EDataType::kShort_t:
+        stat &= mTableBuilder_s->AppendValues(reinterpret_cast<const int16_t*>(data), nValues);
+        break;
+      case EDataType::kInt_t:
+        stat &= mTableBuilder_i->AppendValues(reinterpret_cast<const int32_t*>(data), nValues);
+        break;
+      case EDataType::kLong64_t:
+        stat &= mTableBuilder_l->AppendValues(reinterpret_cast<const int64_t*>(data), nValues);
+        break;
+      case EDataType::kFloat_t:
+        stat &= mTableBuilder_f->AppendValues(reinterpret_cast<const float*>(data), nValues);
+        break;
+      case EDataType::kDouble_t:
+        stat &= mTableBuilder_d->AppendValues(reinterpret_cast<const double*>(data), nValues);
+        break;
+      default:
+        LOGP(FATAL, "Type {} not handled!", mElementType);
+        break;
+    }
+  }
+}
+
 void ColumnIterator::finish()
 {
   arrow::Status stat;
@@ -860,14 +937,34 @@ void TreeToTable::fill(TTree* tree)
   tree->StopCacheLearningPhase();
   auto numEntries = treeReader.GetEntries(true);
   if (numEntries > 0) {
+    bool hasEntryColumns = false;
     for (auto&& column : columnIterators) {
       column->reserve(numEntries);
+      hasEntryColumns |= !column->isBulk();
     }
-    // copy all values from the tree to the table builders
-    treeReader.Restart();
-    while (treeReader.Next()) {
+
+    // copy the columns which are read in bulk basket by basket, one cluster
+    // after the other so that the baskets of a cluster are fetched only once
+    auto clusterIterator = tree->GetClusterIterator(0);
+    Long64_t clusterStart;
+    while ((clusterStart = clusterIterator()) < numEntries) {
+      auto clusterEnd = clusterIterator.GetNextEntry();
       for (auto&& column : columnIterators) {
-        column->push();
+        if (column->isBulk()) {
+          column->pushBulk(clusterEnd);
+        }
+      }
+    }
+
+    // copy the values of the other columns entry by entry
+    if (hasEntryColumns) {
+      treeReader.Restart();
+      while (treeReader.Next()) {
+        for (auto&& column : columnIterators) {
+          if (!column->isBulk()) {
+            column->push();
+          }
+        }
       }
     }
   }
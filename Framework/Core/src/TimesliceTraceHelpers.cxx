@@ -0,0 +1,132 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/TimesliceTraceHelpers.h"
+#include <fmt/format.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <ostream>
+
+namespace o2::framework
+{
+
+namespace
+{
+constexpr char const* TRACE_PREFIX = "[TRACE] ";
+constexpr size_t TRACE_PREFIX_SIZE = 8;
+
+std::string escapeJSON(std::string const& s)
+{
+  std::string result;
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result;
+}
+} // namespace
+
+uint64_t TimesliceTraceHelpers::now()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string TimesliceTraceHelpers::formatTrace(TimesliceTraceHop const& hop)
+{
+  return fmt::format("{}{} {} {} {} {} {} {} {}", TRACE_PREFIX, hop.timeslice, hop.origin, hop.hops,
+                     hop.firstInput, hop.lastInput, hop.start, hop.end, hop.sent);
+}
+
+bool TimesliceTraceHelpers::parseTrace(std::string_view const s, TimesliceTraceHop& hop)
+{
+  // The text driver client sends the line via the logger, so
+  // the prefix is not necessarily at the beginning.
+  auto begin = s.find(TRACE_PREFIX);
+  if (begin == std::string_view::npos) {
+    return false;
+  }
+  // The line is not null terminated, so we need a copy for strtoull.
+  std::string line{s.substr(begin + TRACE_PREFIX_SIZE)};
+  char const* cur = line.c_str();
+  uint64_t* fields[] = {&hop.timeslice, &hop.origin, nullptr, &hop.firstInput, &hop.lastInput, &hop.start, &hop.end, &hop.sent};
+  for (auto* field : fields) {
+    char* ep = nullptr;
+    auto value = strtoull(cur, &ep, 10);
+    if (ep == cur || (*ep != '\0' && !isspace(*ep))) {
+      return false;
+    }
+    if (field) {
+      *field = value;
+    } else {
+      hop.hops = value;
+    }
+    cur = ep;
+  }
+  return true;
+}
+
+void TimesliceTraceHelpers::dumpChromeTrace(std::ostream& out,
+                                            std::vector<TimesliceTraceHop> const& hops,
+                                            std::vector<std::string> const& deviceNames)
+{
+  // Times are relative to the first thing which happened, to keep them readable.
+  uint64_t t0 = std::numeric_limits<uint64_t>::max();
+  for (auto& hop : hops) {
+    t0 = std::min({t0, hop.origin, hop.firstInput ? hop.firstInput : hop.start});
+  }
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  out << R"({"name":"process_name","ph":"M","pid":0,"args":{"name":"DPL workflow"}})";
+  for (size_t di = 0; di < deviceNames.size(); ++di) {
+    out << fmt::format(",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}", di, escapeJSON(deviceNames[di]));
+    out << fmt::format(",\n{{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"sort_index\":{}}}}}", di, di);
+  }
+
+  auto span = [&out, t0](char const* name, TimesliceTraceHop const& hop, uint64_t begin, uint64_t end) {
+    if (begin == 0 || end < begin) {
+      return;
+    }
+    out << fmt::format(",\n{{\"name\":\"{}\",\"cat\":\"timeslice\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":0,\"tid\":{},"
+                       "\"args\":{{\"timeslice\":{},\"hops\":{},\"since_origin_us\":{}}}}}",
+                       name, begin - t0, end - begin, hop.device, hop.timeslice, hop.hops, end - std::min(hop.origin, end));
+  };
+
+  // The whole life of each timeslice, from when it entered the topology to the
+  // last output sent for it, as an async event.
+  std::map<uint64_t, std::pair<uint64_t, uint64_t>> lifetimes;
+  for (auto& hop : hops) {
+    span("inputs", hop, hop.firstInput, hop.lastInput);
+    span("queued", hop, hop.lastInput, hop.start);
+    span("compute", hop, hop.start, hop.end);
+    span("send", hop, hop.end, hop.sent);
+    auto [it, isNew] = lifetimes.emplace(hop.timeslice, std::make_pair(hop.origin, hop.sent));
+    if (!isNew) {
+      it->second.first = std::min(it->second.first, hop.origin);
+      it->second.second = std::max(it->second.second, hop.sent);
+    }
+  }
+  for (auto& [timeslice, lifetime] : lifetimes) {
+    auto name = fmt::format("timeslice {}", timeslice);
+    out << fmt::format(",\n{{\"name\":\"{}\",\"cat\":\"latency\",\"ph\":\"b\",\"id\":{},\"ts\":{},\"pid\":0,\"tid\":0}}", name, timeslice, lifetime.first - t0);
+    out << fmt::format(",\n{{\"name\":\"{}\",\"cat\":\"latency\",\"ph\":\"e\",\"id\":{},\"ts\":{},\"pid\":0,\"tid\":0,\"args\":{{\"latency_us\":{}}}}}",
+                       name, timeslice, std::max(lifetime.first, lifetime.second) - t0, std::max(lifetime.first, lifetime.second) - lifetime.first);
+  }
+  out << "\n]}\n";
+}
+
+} // namespace o2::framework
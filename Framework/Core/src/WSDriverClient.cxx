@@ -111,6 +111,29 @@ void on_connect(uv_connect_t* connection, int status)
     state->pendingOffers.push_back(offer);
   });
 
+  // The minimum interval, in microseconds, between two timeslices which
+  // this device is allowed to inject in the topology. 0 means no limit.
+  client->observe("/rate-limit", [state = context->state](std::string_view cmd) {
+    static constexpr int prefixSize = std::string_view{"/rate-limit "}.size();
+    if (prefixSize > cmd.size()) {
+      LOG(ERROR) << "Malformed rate limit";
+      return;
+    }
+    cmd.remove_prefix(prefixSize);
+    uint64_t interval;
+    auto intervalError = std::from_chars(cmd.data(), cmd.data() + cmd.size(), interval);
+    if (intervalError.ec != std::errc()) {
+      LOG(ERROR) << "Malformed rate limit";
+      return;
+    }
+    if (interval) {
+      LOGP(info, "Injection of new timeslices limited to one every {}us", interval);
+    } else {
+      LOGP(info, "Injection of new timeslices not limited anymore");
+    }
+    state->timesliceInterval = interval;
+  });
+
   client->observe("/quit", [state = context->state](std::string_view offer) {
     state->quitRequested = true;
   });
@@ -41,11 +41,17 @@ std::vector<ConfigParamSpec> WorkflowCustomizationHelpers::requiredWorkflowOptio
                                        // options for AOD rate limiting
                                        ConfigParamSpec{"aod-memory-rate-limit", VariantType::Int64, 0LL, {"Rate limit AOD processing based on memory"}},
 
+                                       // options for the adaptive rate limiting of the readers
+                                       ConfigParamSpec{"adaptive-rate-limiting", VariantType::Int64, 0LL, {"Adapt the rate of the readers to the load of the rest of the topology (0: disabled)"}},
+                                       ConfigParamSpec{"adaptive-rate-limiting-shm", VariantType::Int64, 0LL, {"Shared memory (MB) the timeslices in flight can hold before slowing down the readers (0: unlimited)"}},
+
                                        // options for AOD writer
                                        ConfigParamSpec{"aod-writer-json", VariantType::String, "", {"Name of the json configuration file"}},
                                        ConfigParamSpec{"aod-writer-resfile", VariantType::String, "", {"Default name of the output file"}},
                                        ConfigParamSpec{"aod-writer-resmode", VariantType::String, "RECREATE", {"Creation mode of the result files: NEW, CREATE, RECREATE, UPDATE"}},
+                                       ConfigParamSpec{"aod-writer-format", VariantType::String, "", {"Format of the result files: root (default), arrow"}},
                                        ConfigParamSpec{"aod-writer-ntfmerge", VariantType::Int, -1, {"Number of time frames to merge into one file"}},
+                                       ConfigParamSpec{"aod-writer-nparts", VariantType::Int, 1, {"Number of files the trees of an output file are distributed over, written concurrently"}},
                                        ConfigParamSpec{"aod-writer-keep", VariantType::String, "", {"Comma separated list of ORIGIN/DESCRIPTION/SUBSPECIFICATION:treename:col1/col2/..:filename"}},
 
                                        ConfigParamSpec{"fairmq-rate-logging", VariantType::Int, 0, {"Rate logging for FairMQ channels"}},
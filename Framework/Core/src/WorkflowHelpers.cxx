@@ -265,6 +265,9 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
     {ConfigParamSpec{"aod-file", VariantType::String, {"Input AOD file"}},
      ConfigParamSpec{"aod-reader-json", VariantType::String, {"json configuration file"}},
      ConfigParamSpec{"time-limit", VariantType::Int64, 0ll, {"Maximum run time limit in seconds"}},
+     ConfigParamSpec{"aod-reader-threads", VariantType::Int, 0, {"Number of threads decompressing the baskets, 0 to disable"}},
+     ConfigParamSpec{"aod-prefetch", VariantType::Bool, false, {"Read the next time frame while the current one is processed"}},
+     ConfigParamSpec{"aod-reader-filter", VariantType::String, "", {"Read only the time frames with selected collisions: <filter tree>[:<decision column>,...]"}},
      ConfigParamSpec{"orbit-offset-enumeration", VariantType::Int64, 0ll, {"initial value for the orbit"}},
      ConfigParamSpec{"orbit-multiplier-enumeration", VariantType::Int64, 0ll, {"multiplier to get the orbit from the counter"}},
      ConfigParamSpec{"start-value-enumeration", VariantType::Int64, 0ll, {"initial value for the enumeration"}},
@@ -999,6 +1002,15 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
       ntfmerge = ntfm;
     }
   }
+  if (options.isSet("aod-writer-nparts")) {
+    dod->setNumberOfParts(options.get<int>("aod-writer-nparts"));
+  }
+  if (options.isSet("aod-writer-format")) {
+    auto fileformat = options.get<std::string>("aod-writer-format");
+    if (!fileformat.empty()) {
+      dod->setFileFormat(fileformat);
+    }
+  }
   // parse the keepString
   if (options.isSet("aod-writer-keep")) {
     auto keepString = options.get<std::string>("aod-writer-keep");
@@ -25,6 +25,7 @@
 #include "Framework/DeviceInfo.h"
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRing.h"
 #include "Framework/DeviceConfigInfo.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/DeviceState.h"
@@ -56,6 +57,7 @@
 #include "ComputingResourceHelpers.h"
 #include "DataProcessingStatus.h"
 #include "DDSConfigHelpers.h"
+#include "DeviceAffinityHelpers.h"
 #include "O2ControlHelpers.h"
 #include "DeviceSpecHelpers.h"
 #include "GraphvizHelpers.h"
@@ -90,6 +92,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <csignal>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <regex>
@@ -503,6 +506,24 @@ void updateMetricsNames(DriverInfo& driverInfo, std::vector<DeviceMetricsInfo> c
   driverInfo.availableMetrics.swap(result);
 }
 
+/// Keep track of what happened to a traced timeslice in device @a di.
+/// The number of hops kept is bounded, to avoid eating all the memory
+/// when the tracing is enabled for too many timeslices.
+void collectTimesliceTrace(DriverInfo& driverInfo, size_t di, TimesliceTraceHop& hop)
+{
+  constexpr size_t MAX_TIMESLICE_TRACES = 1 << 20;
+  if (driverInfo.timesliceTraces.size() >= MAX_TIMESLICE_TRACES) {
+    static bool warned = false;
+    if (!warned) {
+      LOGP(WARN, "Too many traced timeslices, dropping the others. Consider increasing --timeslice-tracing.");
+      warned = true;
+    }
+    return;
+  }
+  hop.device = di;
+  driverInfo.timesliceTraces.push_back(hop);
+}
+
 /// An handler for a websocket message stream.
 struct ControlWebSocketHandler : public WebSocketHandler {
   ControlWebSocketHandler(DriverServerContext& context)
@@ -550,6 +571,7 @@ struct ControlWebSocketHandler : public WebSocketHandler {
     std::smatch match;
     ParsedConfigMatch configMatch;
     ParsedMetricMatch metricMatch;
+    TimesliceTraceHop hop;
 
     auto doParseConfig = [](std::string const& token, ParsedConfigMatch& configMatch, DeviceInfo& info) -> bool {
       auto ts = "                 " + token;
@@ -567,6 +589,8 @@ struct ControlWebSocketHandler : public WebSocketHandler {
       DeviceMetricsHelper::processMetric(metricMatch, (*mContext.metrics)[mIndex], newMetricCallback);
       didProcessMetric = true;
       didHaveNewMetric |= hasNewMetric;
+    } else if (TimesliceTraceHelpers::parseTrace(token, hop)) {
+      collectTimesliceTrace(*mContext.driver, mIndex, hop);
     } else if (ControlServiceHelpers::parseControl(token, match) && mContext.infos) {
       ControlServiceHelpers::processCommand(*mContext.infos, mPid, match[1].str(), match[2].str());
     } else if (doParseConfig(token, configMatch, (*mContext.infos)[mIndex]) && mContext.infos) {
@@ -646,50 +670,48 @@ void ws_connect_callback(uv_stream_t* server, int status)
 }
 
 struct StreamConfigContext {
-  std::string configuration;
+  std::shared_ptr<std::string const> configuration;
+  size_t offset;
   int fd;
 };
 
-void stream_config(uv_work_t* req)
+void close_config_stream(uv_handle_t* handle)
 {
-  StreamConfigContext* context = (StreamConfigContext*)req->data;
-  size_t result = write(context->fd, context->configuration.data(), context->configuration.size());
-  if (result != context->configuration.size()) {
-    LOG(ERROR) << "Unable to pass configuration to children";
+  StreamConfigContext* context = (StreamConfigContext*)handle->data;
+  if (close(context->fd) == -1) { // Not allowing further communication...
+    LOGP(ERROR, "Error while closing child stdin: {}", strerror(errno));
   }
-  {
-    auto error = fsync(context->fd);
-    switch (error) {
-      case EBADF:
-        LOGP(ERROR, "EBADF while flushing child stdin");
-        break;
-      case EINVAL:
-        LOGP(ERROR, "EINVAL while flushing child stdin");
-        break;
-      case EINTR:
-        LOGP(ERROR, "EINTR while flushing child stdin");
-        break;
-      case EIO:
-        LOGP(ERROR, "EIO while flushing child stdin");
-        break;
-      default:;
-    }
+  delete context;
+  free(handle);
+}
+
+/// Write to the stdin of a child as much of the configuration as it accepts
+/// without blocking. This way all the children get their configuration
+/// concurrently, regardless of the order in which they are ready to read it,
+/// rather than a few at the time from the worker threads.
+void stream_config(uv_poll_t* handle, int status, int events)
+{
+  StreamConfigContext* context = (StreamConfigContext*)handle->data;
+  auto const& configuration = *context->configuration;
+  if (status < 0) {
+    LOGP(ERROR, "Unable to pass configuration to children: {}", uv_strerror(status));
   }
-  {
-    auto error = close(context->fd); // Not allowing further communication...
-    switch (error) {
-      case EBADF:
-        LOGP(ERROR, "EBADF while closing child stdin");
-        break;
-      case EINTR:
-        LOGP(ERROR, "EINTR while closing child stdin");
-        break;
-      case EIO:
-        LOGP(ERROR, "EIO while closing child stdin");
-        break;
-      default:;
+  while (status >= 0 && context->offset < configuration.size()) {
+    auto result = write(context->fd, configuration.data() + context->offset, configuration.size() - context->offset);
+    if (result == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    }
+    if (result == -1 && errno == EINTR) {
+      continue;
+    }
+    if (result == -1) {
+      LOGP(ERROR, "Unable to pass configuration to children: {}", strerror(errno));
+      break;
     }
+    context->offset += result;
   }
+  uv_poll_stop(handle);
+  uv_close((uv_handle_t*)handle, close_config_stream);
 }
 
 struct DeviceRef {
@@ -731,7 +753,7 @@ void handleSignals()
 }
 
 void handleChildrenStdio(uv_loop_t* loop,
-                         std::string const& forwardedStdin,
+                         std::shared_ptr<std::string const> const& forwardedStdin,
                          std::vector<DeviceInfo>& deviceInfos,
                          std::vector<DeviceStdioContext>& childFds,
                          std::vector<uv_poll_t*>& handles)
@@ -744,13 +766,20 @@ void handleChildrenStdio(uv_loop_t* loop,
     close(childstdout[1]);
     close(childstderr[1]);
 
-    uv_work_t* req = (uv_work_t*)malloc(sizeof(uv_work_t));
-    req->data = new StreamConfigContext{forwardedStdin, childstdin[1]};
-    uv_queue_work(loop, req, stream_config, nullptr);
+    // All the children share the same configuration, which we write
+    // from the event loop, without blocking on the slow readers.
+    int resultCode = fcntl(childstdin[1], F_SETFL, O_NONBLOCK);
+    if (resultCode == -1) {
+      LOGP(ERROR, "Error while setting the socket to non-blocking: {}", strerror(errno));
+    }
+    auto configHandle = (uv_poll_t*)malloc(sizeof(uv_poll_t));
+    configHandle->data = new StreamConfigContext{forwardedStdin, 0, childstdin[1]};
+    uv_poll_init(loop, configHandle, childstdin[1]);
+    uv_poll_start(configHandle, UV_WRITABLE, stream_config);
 
     // Setting them to non-blocking to avoid haing the driver hang when
     // reading from child.
-    int resultCode = fcntl(childstdout[0], F_SETFL, O_NONBLOCK);
+    resultCode = fcntl(childstdout[0], F_SETFL, O_NONBLOCK);
     if (resultCode == -1) {
       LOGP(ERROR, "Error while setting the socket to non-blocking: {}", strerror(errno));
     }
@@ -806,6 +835,12 @@ void spawnDevice(DeviceRef ref,
       service.preFork(serviceRegistry, varmap);
     }
   }
+  // The ring for the numeric metrics is created before forking,
+  // so that the child can inherit it.
+  std::shared_ptr<DeviceMetricsRing> metricsRing;
+  if (driverInfo.metricsRingSize) {
+    metricsRing = DeviceMetricsRing::create(driverInfo.metricsRingSize);
+  }
   // If we have a framework id, it means we have already been respawned
   // and that we are in a child. If not, we need to fork and re-exec, adding
   // the framework-id as one of the options.
@@ -842,6 +877,11 @@ void spawnDevice(DeviceRef ref,
 
     auto portS = std::to_string(driverInfo.tracyPort);
     setenv("TRACY_PORT", portS.c_str(), 1);
+    // Only the ring of this device survives the exec.
+    if (metricsRing) {
+      fcntl(metricsRing->fd(), F_SETFD, 0);
+      setenv(DeviceMetricsRing::FD_ENV, std::to_string(metricsRing->fd()).c_str(), 1);
+    }
     for (auto& service : spec.services) {
       if (service.postForkChild != nullptr) {
         service.postForkChild(serviceRegistry);
@@ -898,6 +938,7 @@ void spawnDevice(DeviceRef ref,
   info.queriesViewIndex = Metric2DViewIndex{"data_queries", 0, 0, {}};
   info.tracyPort = driverInfo.tracyPort;
   info.lastSignal = uv_hrtime() - 10000000;
+  info.metricsRing = metricsRing;
 
   deviceInfos.emplace_back(info);
   // Let's add also metrics information for the given device
@@ -929,6 +970,7 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
   std::smatch match;
   ParsedMetricMatch metricMatch;
   ParsedConfigMatch configMatch;
+  TimesliceTraceHop hop;
   const std::string delimiter("\n");
   bool hasNewMetric = false;
   LogProcessingState result;
@@ -940,6 +982,21 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
     assert(specs.size() == infos.size());
     DeviceSpec const& spec = specs[di];
 
+    auto updateMetricsViews =
+      Metric2DViewIndex::getUpdater({&info.dataRelayerViewIndex,
+                                     &info.variablesViewIndex,
+                                     &info.queriesViewIndex});
+
+    auto newMetricCallback = [&updateMetricsViews, &driverInfo, &metricsInfos, &hasNewMetric](std::string const& name, MetricInfo const& metric, int value, size_t metricIndex) {
+      updateMetricsViews(name, metric, value, metricIndex);
+      hasNewMetric = true;
+    };
+
+    // Numeric metrics which were sent via shared memory, in one go.
+    if (info.metricsRing && info.metricsRing->consume(metrics, newMetricCallback)) {
+      result.didProcessMetric = true;
+    }
+
     if (info.unprinted.empty()) {
       continue;
     }
@@ -951,16 +1008,6 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
     info.history.resize(info.historySize);
     info.historyLevel.resize(info.historySize);
 
-    auto updateMetricsViews =
-      Metric2DViewIndex::getUpdater({&info.dataRelayerViewIndex,
-                                     &info.variablesViewIndex,
-                                     &info.queriesViewIndex});
-
-    auto newMetricCallback = [&updateMetricsViews, &driverInfo, &metricsInfos, &hasNewMetric](std::string const& name, MetricInfo const& metric, int value, size_t metricIndex) {
-      updateMetricsViews(name, metric, value, metricIndex);
-      hasNewMetric = true;
-    };
-
     while ((pos = s.find(delimiter)) != std::string::npos) {
       std::string token{s.substr(0, pos)};
       auto logLevel = LogParsingHelpers::parseTokenLevel(token);
@@ -975,6 +1022,8 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
         // the DataRelayer view.
         DeviceMetricsHelper::processMetric(metricMatch, metrics, newMetricCallback);
         result.didProcessMetric = true;
+      } else if (logLevel == LogParsingHelpers::LogLevel::Info && TimesliceTraceHelpers::parseTrace(token, hop)) {
+        collectTimesliceTrace(driverInfo, di, hop);
       } else if (logLevel == LogParsingHelpers::LogLevel::Info && ControlServiceHelpers::parseControl(token, match)) {
         ControlServiceHelpers::processCommand(infos, info.pid, match[1].str(), match[2].str());
         result.didProcessControl = true;
@@ -1090,6 +1139,11 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
   fair::Logger::SetConsoleColor(false);
   DeviceSpec const& spec = runningWorkflow.devices[ref.index];
   LOG(INFO) << "Spawing new device " << spec.id << " in process with pid " << getpid();
+  // Pin the device as early as possible, so that all its threads and
+  // memory allocations end up in the right place.
+  if (spec.resourcePolicy.affinity) {
+    DeviceAffinityHelpers::apply(spec.resourcePolicy.affinity(spec));
+  }
 
   fair::mq::DeviceRunner runner{argc, argv};
 
@@ -1102,7 +1156,9 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
       ("driver-client-backend", bpo::value<std::string>()->default_value(defaultDriverClient), "backend for device -> driver communicataon: stdout://: use stdout, ws://: use websockets") //
       ("infologger-severity", bpo::value<std::string>()->default_value(""), "minimum FairLogger severity to send to InfoLogger")                                                           //
       ("configuration,cfg", bpo::value<std::string>()->default_value("command-line"), "configuration backend")                                                                             //
-      ("infologger-mode", bpo::value<std::string>()->default_value(""), "O2_INFOLOGGER_MODE override");
+      ("infologger-mode", bpo::value<std::string>()->default_value(""), "O2_INFOLOGGER_MODE override")                                                                                    //
+      ("timeslice-tracing", bpo::value<std::string>()->default_value("0"), "trace one timeslice out of the given number through the topology (0: disabled)")                              //
+      ("dpl-coalesce-outputs", bpo::value<std::string>()->default_value("0"), "coalesce outputs up to the given bytes to the same channel (0: disabled)");
     r.fConfig.AddToCmdLineOptions(optsDesc, true);
   });
 
@@ -1196,6 +1252,12 @@ void single_step_callback(uv_timer_s* ctx)
   killChildren(*infos, SIGUSR1);
 }
 
+/// Nothing to do: waking up the loop is enough for the metrics rings
+/// to be consumed when no other event is there.
+void metricsRingCallback(uv_timer_t*)
+{
+}
+
 void dumpMetricsCallback(uv_timer_t* handle)
 {
   DriverServerContext* context = (DriverServerContext*)handle->data;
@@ -1375,6 +1437,9 @@ int runStateMachine(DataProcessorSpecs const& workflow,
   uv_timer_t metricDumpTimer;
   metricDumpTimer.data = &serverContext;
 
+  uv_timer_t metricsRingTimer;
+  uv_timer_init(loop, &metricsRingTimer);
+
   while (true) {
     // If control forced some transition on us, we push it to the queue.
     if (driverControl.forcedTransitions.empty() == false) {
@@ -1679,8 +1744,10 @@ int runStateMachine(DataProcessorSpecs const& workflow,
             "--aod-memory-rate-limit",
             "--aod-writer-json",
             "--aod-writer-ntfmerge",
+            "--aod-writer-nparts",
             "--aod-writer-resfile",
             "--aod-writer-resmode",
+            "--aod-writer-format",
             "--aod-writer-keep",
             "--driver-client-backend",
             "--fairmq-ipc-prefix",
@@ -1719,8 +1786,10 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         //        a larger scale. In principle one could try to do a delta and only
         //        restart the data processors which need to be restarted.
         LOG(INFO) << "Redeployment of configuration asked.";
-        std::ostringstream forwardedStdin;
-        WorkflowSerializationHelpers::dump(forwardedStdin, workflow, dataProcessorInfos, commandInfo);
+        std::ostringstream forwardedStdinStream;
+        WorkflowSerializationHelpers::dump(forwardedStdinStream, workflow, dataProcessorInfos, commandInfo);
+        // Serialised once, and shared by all the children.
+        auto forwardedStdin = std::make_shared<std::string const>(forwardedStdinStream.str());
         infos.reserve(runningWorkflow.devices.size());
 
         // This is guaranteed to be a single CPU.
@@ -1742,7 +1811,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         prepareStdio(childFds);
         for (int di = 0; di < runningWorkflow.devices.size(); ++di) {
           if (runningWorkflow.devices[di].resource.hostname != driverInfo.deployHostname) {
-            spawnRemoteDevice(forwardedStdin.str(),
+            spawnRemoteDevice(*forwardedStdin,
                               runningWorkflow.devices[di], controls[di], deviceExecutions[di], infos);
           } else {
             DeviceRef ref{di};
@@ -1754,7 +1823,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           }
         }
         handleSignals();
-        handleChildrenStdio(loop, forwardedStdin.str(), infos, childFds, pollHandles);
+        handleChildrenStdio(loop, forwardedStdin, infos, childFds, pollHandles);
         for (auto& callback : postScheduleCallbacks) {
           callback(serviceRegistry, varmap);
         }
@@ -1768,6 +1837,9 @@ int runStateMachine(DataProcessorSpecs const& workflow,
                          driverInfo.resourcesMonitoringDumpInterval * 1000,
                          driverInfo.resourcesMonitoringDumpInterval * 1000);
         }
+        if (driverInfo.metricsRingSize) {
+          uv_timer_start(&metricsRingTimer, metricsRingCallback, 100, 100);
+        }
         LOG(INFO) << "Redeployment of configuration done.";
       } break;
       case DriverState::RUNNING:
@@ -1889,6 +1961,15 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           LOG(INFO) << "Dumping performance metrics to performanceMetrics.json file";
           dumpMetricsCallback(&metricDumpTimer);
         }
+        if (driverInfo.timesliceTracing) {
+          std::vector<std::string> deviceNames;
+          for (auto& spec : runningWorkflow.devices) {
+            deviceNames.push_back(spec.name);
+          }
+          LOGP(INFO, "Dumping {} timeslice trace entries to dpl-timeslice-trace.json", driverInfo.timesliceTraces.size());
+          std::ofstream traceFile("dpl-timeslice-trace.json");
+          TimesliceTraceHelpers::dumpChromeTrace(traceFile, driverInfo.timesliceTraces, deviceNames);
+        }
         // This is a clean exit. Before we do so, if required,
         // we dump the configuration of all the devices so that
         // we can reuse it. Notice we do not dump anything if
@@ -2152,9 +2233,12 @@ void initialiseDriverControl(bpo::variables_map const& varmap,
     //        so that it can understand what it needs to do. This is obviously
     //        a bad idea. In the future we should have the client be pushed
     //        it's own configuration by the driver.
+    // The child gets its own command line from the driver, so there is no
+    // need to merge the configuration and prepare the arguments of every
+    // other device in the topology, which for large topologies was the
+    // bulk of the startup time of each child.
     control.forcedTransitions = {
       DriverState::DO_CHILD,                //
-      DriverState::MERGE_CONFIGS,           //
       DriverState::IMPORT_CURRENT_WORKFLOW, //
       DriverState::MATERIALISE_WORKFLOW     //
     };
@@ -2308,6 +2392,7 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
     ("run", bpo::value<bool>()->zero_tokens()->default_value(false), "run workflow merged so far")                                                        //                                                                                                                                        //
     ("no-IPC", bpo::value<bool>()->zero_tokens()->default_value(false), "disable IPC topology optimization")                                              //                                                                                                                                        //
     ("o2-control,o2", bpo::value<std::string>()->default_value(""), "dump O2 Control workflow configuration under the specified name")                    //
+    ("metrics-ring-size", bpo::value<size_t>()->default_value(8192), "records in the shared memory ring for the metrics of each device, 0 to disable")   //
     ("resources-monitoring", bpo::value<unsigned short>()->default_value(0), "enable cpu/memory monitoring for provided interval in seconds")             //
     ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds"); //
   // some of the options must be forwarded by default to the device
@@ -2528,6 +2613,10 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
   driverInfo.resources = varmap["resources"].as<std::string>();
   driverInfo.resourcesMonitoringInterval = varmap["resources-monitoring"].as<unsigned short>();
   driverInfo.resourcesMonitoringDumpInterval = varmap["resources-monitoring-dump-interval"].as<unsigned short>();
+  driverInfo.metricsRingSize = varmap["metrics-ring-size"].as<size_t>();
+  if (varmap.count("timeslice-tracing")) {
+    driverInfo.timesliceTracing = std::stoul(varmap["timeslice-tracing"].as<std::string>());
+  }
 
   // FIXME: should use the whole dataProcessorInfos, actually...
   driverInfo.processorInfo = dataProcessorInfos;
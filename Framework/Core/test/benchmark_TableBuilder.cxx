@@ -13,6 +13,7 @@
 #include "Framework/TableConsumer.h"
 
 #include <benchmark/benchmark.h>
+#include <algorithm>
 
 using namespace o2::framework;
 
@@ -95,6 +96,28 @@ static void BM_TableBuilderScalarBulk(benchmark::State& state)
 
 BENCHMARK(BM_TableBuilderScalarBulk)->Range(256, 1 << 20);
 
+static void BM_TableBuilderScalarBulkFill(benchmark::State& state)
+{
+  using namespace o2::framework;
+  constexpr size_t batchSize = 1024;
+  for (auto _ : state) {
+    TableBuilder builder;
+    auto filler = builder.bulkFill<float>({"x"}, state.range(0));
+    for (size_t i = 0; i < state.range(0); i += batchSize) {
+      auto n = std::min(batchSize, size_t(state.range(0)) - i);
+      auto [x] = filler.reserve(n);
+      for (size_t j = 0; j < n; ++j) {
+        x[j] = 0.f;
+      }
+      filler.commit(n);
+    }
+    auto table = builder.finalize();
+  }
+}
+
+BENCHMARK(BM_TableBuilderScalarBulkFill)->Arg(1 << 21);
+BENCHMARK(BM_TableBuilderScalarBulkFill)->Range(8, 8 << 16);
+
 static void BM_TableBuilderSimple(benchmark::State& state)
 {
   using namespace o2::framework;
@@ -149,6 +172,29 @@ static void BM_TableBuilderSoA(benchmark::State& state)
 
 BENCHMARK(BM_TableBuilderSoA)->Range(8, 8 << 16);
 
+static void BM_TableBuilderSoABulkFill(benchmark::State& state)
+{
+  using namespace o2::framework;
+  constexpr size_t batchSize = 1024;
+  for (auto _ : state) {
+    TableBuilder builder;
+    auto filler = builder.bulkCursor<TestVectors>(state.range(0));
+    for (size_t i = 0; i < state.range(0); i += batchSize) {
+      auto n = std::min(batchSize, size_t(state.range(0)) - i);
+      auto [x, y, z] = filler.reserve(n);
+      for (size_t j = 0; j < n; ++j) {
+        x[j] = 0.f;
+        y[j] = 0.f;
+        z[j] = 0.f;
+      }
+      filler.commit(n);
+    }
+    auto table = builder.finalize();
+  }
+}
+
+BENCHMARK(BM_TableBuilderSoABulkFill)->Range(8, 8 << 16);
+
 static void BM_TableBuilderComplex(benchmark::State& state)
 {
   using namespace o2::framework;
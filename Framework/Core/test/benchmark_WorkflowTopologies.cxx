@@ -0,0 +1,314 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// Topology level benchmark of the framework: synthetic workflows with a given shape
+// are run for a fixed number of messages, the sink measures the throughput, the latency
+// from the producer to the sink and the CPU time of the driver, and writes the results
+// to a JSON file to be compared between releases:
+//
+//   o2-bench-framework-benchmark-WorkflowTopologies --run --topology pipeline --depth 8 --msgSize 1024 \
+//     --nMessages 100000 --output-json pipeline.json
+//
+// Topologies:
+// - pipeline: producer -> depth stages -> sink
+// - fan-out:  producer with width outputs -> width parallel workers -> sink
+// - fan-in:   width producers -> sink
+
+#include "Framework/ConfigParamSpec.h"
+#include "Framework/CompletionPolicy.h"
+#include "Framework/CompletionPolicyHelpers.h"
+#include <vector>
+
+void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
+{
+  using o2::framework::ConfigParamSpec;
+  using o2::framework::VariantType;
+  workflowOptions.push_back(ConfigParamSpec{"topology", VariantType::String, "pipeline", {"shape of the workflow: pipeline, fan-out, fan-in"}});
+  workflowOptions.push_back(ConfigParamSpec{"depth", VariantType::Int, 4, {"number of stages of the pipeline"}});
+  workflowOptions.push_back(ConfigParamSpec{"width", VariantType::Int, 4, {"number of branches of fan-out, number of producers of fan-in"}});
+  workflowOptions.push_back(ConfigParamSpec{"msgSize", VariantType::Int, 1024, {"message size in bytes (min 8)"}});
+  workflowOptions.push_back(ConfigParamSpec{"nMessages", VariantType::Int, 10000, {"number of messages sent on every output of the producers"}});
+  workflowOptions.push_back(ConfigParamSpec{"output-json", VariantType::String, "", {"file for the results in JSON format, only logged if empty"}});
+}
+
+// the sink processes every message as it comes, so that the latency is not affected
+// by the synchronization of the inputs
+void customize(std::vector<o2::framework::CompletionPolicy>& policies)
+{
+  using o2::framework::CompletionPolicy;
+  using o2::framework::CompletionPolicyHelpers;
+  policies.push_back(CompletionPolicyHelpers::defineByName("bench-sink", CompletionPolicy::CompletionOp::Consume));
+}
+
+#include "Framework/runDataProcessing.h"
+#include "Framework/ControlService.h"
+#include "Framework/CallbackService.h"
+#include "Framework/DataRefUtils.h"
+#include "Framework/EndOfStreamContext.h"
+#include "Framework/Logger.h"
+#include <fmt/format.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+using namespace o2::framework;
+
+using benchclock = std::chrono::steady_clock;
+
+namespace
+{
+/// the messages carry the time of their creation in the first bytes, the steady clock
+/// is common to all the processes of the workflow on the host
+uint64_t now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(benchclock::now().time_since_epoch()).count();
+}
+
+/// CPU time (user + system) in s of the process with the given pid, -1 if not available
+double processCPUTime(pid_t pid)
+{
+  std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+  std::string line;
+  if (!std::getline(stat, line)) {
+    return -1.;
+  }
+  // the command name can contain spaces, the fields are counted from its closing parenthesis
+  auto pos = line.rfind(')');
+  if (pos == std::string::npos) {
+    return -1.;
+  }
+  std::istringstream fields(line.substr(pos + 2));
+  std::string field;
+  unsigned long utime = 0, stime = 0;
+  for (int i = 3; i <= 15 && fields >> field; i++) {
+    if (i == 14) {
+      utime = std::stoul(field);
+    } else if (i == 15) {
+      stime = std::stoul(field);
+    }
+  }
+  return double(utime + stime) / sysconf(_SC_CLK_TCK);
+}
+
+struct BenchmarkConfig {
+  std::string topology;
+  int depth = 4;
+  int width = 4;
+  size_t msgSize = 1024;
+  int nMessages = 10000;
+  std::string outputJSON;
+  int nHops = 1;      // number of transfers of a message from the producer to the sink
+  int nProducers = 1; // number of producers
+  int nOutputs = 1;   // number of outputs of every producer
+};
+
+struct SinkState {
+  size_t received = 0;
+  size_t bytes = 0;
+  std::vector<float> latencies; // us
+  uint64_t firstTime = 0;
+  uint64_t lastTime = 0;
+  double driverCPUStart = 0.;
+  double sinkCPUStart = 0.;
+};
+
+Output makeOutput(int branch, int hop)
+{
+  return Output{"TST", "BENCH", o2::header::DataHeader::SubSpecificationType((branch << 8) + hop), Lifetime::Timeframe};
+}
+
+InputSpec makeInput(std::string binding, int branch, int hop)
+{
+  return InputSpec{std::move(binding), "TST", "BENCH", o2::header::DataHeader::SubSpecificationType((branch << 8) + hop), Lifetime::Timeframe};
+}
+
+OutputSpec makeOutputSpec(int branch, int hop)
+{
+  return OutputSpec{"TST", "BENCH", o2::header::DataHeader::SubSpecificationType((branch << 8) + hop), Lifetime::Timeframe};
+}
+
+DataProcessorSpec defineProducer(std::string name, BenchmarkConfig const& config, std::vector<int> branches)
+{
+  Outputs outputs;
+  for (auto branch : branches) {
+    outputs.emplace_back(makeOutputSpec(branch, 0));
+  }
+  return DataProcessorSpec{
+    name,
+    Inputs{},
+    std::move(outputs),
+    AlgorithmSpec{[config, branches, counter = std::make_shared<int>(0)](ProcessingContext& ctx) {
+      if (*counter < config.nMessages) {
+        for (auto branch : branches) {
+          auto& data = ctx.outputs().make<char>(makeOutput(branch, 0), config.msgSize);
+          uint64_t t = now();
+          memcpy(data.data(), &t, sizeof(t));
+        }
+        (*counter)++;
+      }
+      if (*counter == config.nMessages) {
+        ctx.services().get<ControlService>().endOfStream();
+        ctx.services().get<ControlService>().readyToQuit(QuitRequest::Me);
+      }
+    }}};
+}
+
+/// forwards the message to the next hop, copying the payload
+DataProcessorSpec defineStage(std::string name, int branch, int hop)
+{
+  return DataProcessorSpec{
+    name,
+    Inputs{makeInput("in", branch, hop)},
+    Outputs{makeOutputSpec(branch, hop + 1)},
+    AlgorithmSpec{[branch, hop](ProcessingContext& ctx) {
+      auto in = ctx.inputs().get<gsl::span<char>>("in");
+      auto& out = ctx.outputs().make<char>(makeOutput(branch, hop + 1), in.size());
+      memcpy(out.data(), in.data(), in.size());
+    }}};
+}
+
+void writeResults(BenchmarkConfig const& config, SinkState& state)
+{
+  const double wallTime = (state.lastTime - state.firstTime) * 1e-9;
+  auto& lat = state.latencies;
+  std::sort(lat.begin(), lat.end());
+  auto quantile = [&lat](double q) { return lat.empty() ? 0.f : lat[std::min(lat.size() - 1, size_t(q * lat.size()))]; };
+  double sum = 0;
+  for (auto l : lat) {
+    sum += l;
+  }
+  const double meanLatency = lat.empty() ? 0. : sum / lat.size();
+  const double driverCPUEnd = processCPUTime(getppid()), sinkCPUEnd = processCPUTime(getpid());
+  const double driverCPU = state.driverCPUStart < 0 || driverCPUEnd < 0 ? -1. : driverCPUEnd - state.driverCPUStart;
+  const double sinkCPU = state.sinkCPUStart < 0 || sinkCPUEnd < 0 ? -1. : sinkCPUEnd - state.sinkCPUStart;
+  const double msgRate = wallTime > 0 ? state.received / wallTime : 0.;
+  const double dataRate = wallTime > 0 ? state.bytes / wallTime / (1024. * 1024.) : 0.;
+
+  auto json = fmt::format(
+    "{{\n"
+    "  \"topology\": \"{}\",\n"
+    "  \"depth\": {},\n"
+    "  \"width\": {},\n"
+    "  \"msgSize\": {},\n"
+    "  \"nMessages\": {},\n"
+    "  \"nHops\": {},\n"
+    "  \"received\": {},\n"
+    "  \"expected\": {},\n"
+    "  \"wallTime_s\": {:.6f},\n"
+    "  \"msgRate_Hz\": {:.2f},\n"
+    "  \"dataRate_MBps\": {:.2f},\n"
+    "  \"latency_us\": {{\"mean\": {:.2f}, \"p50\": {:.2f}, \"p90\": {:.2f}, \"p99\": {:.2f}, \"max\": {:.2f}}},\n"
+    "  \"hopLatency_us\": {:.2f},\n"
+    "  \"driverCPU_s\": {:.3f},\n"
+    "  \"sinkCPU_s\": {:.3f}\n"
+    "}}\n",
+    config.topology, config.depth, config.width, config.msgSize, config.nMessages, config.nHops,
+    state.received, size_t(config.nMessages) * config.nProducers * config.nOutputs,
+    wallTime, msgRate, dataRate,
+    meanLatency, quantile(0.5), quantile(0.9), quantile(0.99), lat.empty() ? 0.f : lat.back(),
+    meanLatency / config.nHops, driverCPU, sinkCPU);
+  LOG(INFO) << "Benchmark results:\n"
+            << json;
+  if (!config.outputJSON.empty()) {
+    std::ofstream out(config.outputJSON);
+    out << json;
+    if (!out) {
+      LOG(ERROR) << "Failed to write the benchmark results to " << config.outputJSON;
+    }
+  }
+}
+
+DataProcessorSpec defineSink(BenchmarkConfig const& config, Inputs inputs)
+{
+  return DataProcessorSpec{
+    "bench-sink",
+    std::move(inputs),
+    Outputs{},
+    AlgorithmSpec{adaptStateful([config](CallbackService& callbacks) {
+      auto state = std::make_shared<SinkState>();
+      state->latencies.reserve(size_t(config.nMessages) * config.nProducers * config.nOutputs);
+      callbacks.set(CallbackService::Id::Start, [state]() {
+        state->driverCPUStart = processCPUTime(getppid());
+        state->sinkCPUStart = processCPUTime(getpid());
+      });
+      callbacks.set(CallbackService::Id::EndOfStream, [config, state](EndOfStreamContext& ctx) {
+        writeResults(config, *state);
+        ctx.services().get<ControlService>().readyToQuit(QuitRequest::All);
+      });
+      return adaptStateless([state](InputRecord& inputs) {
+        for (auto const& ref : inputs) {
+          if (!DataRefUtils::isValid(ref)) {
+            continue;
+          }
+          auto t = now();
+          auto data = inputs.get<gsl::span<char>>(ref);
+          uint64_t created = 0;
+          memcpy(&created, data.data(), sizeof(created));
+          if (!state->received || created < state->firstTime) {
+            state->firstTime = created;
+          }
+          state->lastTime = t;
+          state->latencies.push_back((t - created) * 1e-3);
+          state->received++;
+          state->bytes += data.size();
+        }
+      });
+    })}};
+}
+} // namespace
+
+WorkflowSpec defineDataProcessing(ConfigContext const& context)
+{
+  BenchmarkConfig config;
+  config.topology = context.options().get<std::string>("topology");
+  config.depth = std::max(0, context.options().get<int>("depth"));
+  config.width = std::max(1, context.options().get<int>("width"));
+  config.msgSize = std::max(sizeof(uint64_t), size_t(context.options().get<int>("msgSize")));
+  config.nMessages = std::max(1, context.options().get<int>("nMessages"));
+  config.outputJSON = context.options().get<std::string>("output-json");
+
+  WorkflowSpec workflow;
+  Inputs sinkInputs;
+  if (config.topology == "pipeline") {
+    config.nHops = config.depth + 1;
+    workflow.emplace_back(defineProducer("bench-producer", config, {0}));
+    for (int hop = 0; hop < config.depth; hop++) {
+      workflow.emplace_back(defineStage(fmt::format("bench-stage-{}", hop), 0, hop));
+    }
+    sinkInputs.emplace_back(makeInput("in", 0, config.depth));
+  } else if (config.topology == "fan-out") {
+    config.nHops = 2;
+    config.nOutputs = config.width;
+    std::vector<int> branches(config.width);
+    for (int branch = 0; branch < config.width; branch++) {
+      branches[branch] = branch;
+      workflow.emplace_back(defineStage(fmt::format("bench-worker-{}", branch), branch, 0));
+      sinkInputs.emplace_back(makeInput(fmt::format("in{}", branch), branch, 1));
+    }
+    workflow.emplace_back(defineProducer("bench-producer", config, branches));
+  } else if (config.topology == "fan-in") {
+    config.nHops = 1;
+    config.nProducers = config.width;
+    for (int branch = 0; branch < config.width; branch++) {
+      workflow.emplace_back(defineProducer(fmt::format("bench-producer-{}", branch), config, {branch}));
+      sinkInputs.emplace_back(makeInput(fmt::format("in{}", branch), branch, 0));
+    }
+  } else {
+    throw std::runtime_error("invalid argument for option --topology : '" + config.topology + "', expected pipeline, fan-out or fan-in");
+  }
+  workflow.emplace_back(defineSink(config, std::move(sinkInputs)));
+  return workflow;
+}
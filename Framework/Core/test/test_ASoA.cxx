@@ -357,6 +357,15 @@ BOOST_AUTO_TEST_CASE(TestConcatTables)
 
   expressions::Selection selection_f = expressions::createSelection(tableA, testf);
 
+  // the selections of identical trees on the same data are shared
+  auto shared1 = expressions::createSelection(tableA, node_or);
+  auto shared2 = expressions::createSelection(tableA, gandiva::TreeExprBuilder::MakeOr({equals_to_1, equals_to_3}));
+  BOOST_CHECK_EQUAL(shared1.get(), shared2.get());
+  BOOST_CHECK_EQUAL(shared1->GetNumSlots(), 2);
+  auto other = expressions::createSelection(tableA, equals_to_1);
+  BOOST_CHECK(other.get() != shared1.get());
+  BOOST_CHECK_EQUAL(other->GetNumSlots(), 1);
+
   TestA testA{tableA};
   FilteredTest filtered{{testA.asArrowTable()}, selection_f};
   BOOST_CHECK_EQUAL(2, filtered.size());
@@ -781,3 +790,69 @@ BOOST_AUTO_TEST_CASE(TestAdvancedIndices)
     ++i;
   }
 }
+
+BOOST_AUTO_TEST_CASE(TestForEachBatch)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, int32_t>({"x", "y"});
+  for (auto i = 0; i < 16; ++i) {
+    rowWriter(0, i, 2 * i);
+  }
+  auto table = builder.finalize();
+
+  // a single chunk is provided in one batch
+  Points points{table};
+  int nBatches = 0;
+  int32_t next = 0;
+  points.for_each_batch<test::X, test::Y>([&](auto xs, auto ys) {
+    static_assert(std::is_same_v<decltype(xs), gsl::span<int32_t const>>);
+    BOOST_REQUIRE_EQUAL(xs.size(), ys.size());
+    for (size_t i = 0; i < xs.size(); ++i) {
+      BOOST_CHECK_EQUAL(xs[i], next);
+      BOOST_CHECK_EQUAL(ys[i], 2 * next);
+      ++next;
+    }
+    ++nBatches;
+  });
+  BOOST_CHECK_EQUAL(nBatches, 1);
+  BOOST_CHECK_EQUAL(next, 16);
+
+  // columns with different chunk boundaries are provided in the ranges common to all of them
+  std::vector<std::shared_ptr<arrow::Array>> xChunks{table->column(0)->chunk(0)->Slice(0, 5), table->column(0)->chunk(0)->Slice(5, 0), table->column(0)->chunk(0)->Slice(5)};
+  std::vector<std::shared_ptr<arrow::Array>> yChunks{table->column(1)->chunk(0)->Slice(0, 12), table->column(1)->chunk(0)->Slice(12)};
+  auto chunked = arrow::Table::Make(table->schema(), {std::make_shared<arrow::ChunkedArray>(xChunks), std::make_shared<arrow::ChunkedArray>(yChunks)});
+  Points chunkedPoints{chunked};
+  std::vector<size_t> sizes;
+  next = 0;
+  chunkedPoints.for_each_batch<test::X, test::Y>([&](auto xs, auto ys) {
+    for (size_t i = 0; i < xs.size(); ++i) {
+      BOOST_CHECK_EQUAL(xs[i], next);
+      BOOST_CHECK_EQUAL(ys[i], 2 * next);
+      ++next;
+    }
+    sizes.push_back(xs.size());
+  });
+  BOOST_CHECK(sizes == (std::vector<size_t>{5, 7, 4}));
+  BOOST_CHECK_EQUAL(next, 16);
+}
+
+BOOST_AUTO_TEST_CASE(TestSpawnExtension)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, int32_t>({"x", "y"});
+  for (auto i = 0; i < 8; ++i) {
+    rowWriter(0, i, 10 * i);
+  }
+  auto table = builder.finalize();
+
+  auto extension = spawnExtension(o2::framework::pack<test::ESum>{}, {table}, table, "points");
+  BOOST_REQUIRE_EQUAL(extension->num_rows(), 8);
+  // the extension of the same table is computed once
+  BOOST_CHECK_EQUAL(spawnExtension(o2::framework::pack<test::ESum>{}, {table}, table, "points").get(), extension.get());
+
+  using ExtendedPoints = Join<Points, o2::soa::Table<test::ESum>>;
+  ExtendedPoints extended{0, table, extension};
+  for (auto& row : extended) {
+    BOOST_CHECK_EQUAL(row.esum(), 11 * row.x());
+  }
+}
@@ -1347,4 +1347,12 @@ BOOST_AUTO_TEST_CASE(CombinationsHelpers)
     count++;
   }
   BOOST_CHECK_EQUAL(count, expectedStrictlyUpperTriples.size());
+
+  // The grouping of testAux is computed once and shared by the combinations
+  auto groupedPairs = groupTable(testAux, "y", 2, -1);
+  BOOST_CHECK_EQUAL(groupedPairs.size(), 10);
+  BOOST_CHECK(groupTable(testAux, "y", 2, -1).mIndices == groupedPairs.mIndices);
+  auto groupedTriples = groupTable(testAux, "y", 3, -1);
+  BOOST_CHECK_EQUAL(groupedTriples.size(), 6);
+  BOOST_CHECK(groupedTriples.mIndices != groupedPairs.mIndices);
 }
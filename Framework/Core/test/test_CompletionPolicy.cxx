@@ -62,3 +62,32 @@ BOOST_AUTO_TEST_CASE(TestCompletionPolicy_callback)
     policy.callback(inputs);
   }
 }
+
+BOOST_AUTO_TEST_CASE(TestCompletionPolicy_countCallback)
+{
+  using CompletionOp = CompletionPolicy::CompletionOp;
+  auto all = CompletionPolicyHelpers::consumeWhenAll();
+  BOOST_REQUIRE(all.callbackFromCount);
+  BOOST_CHECK_EQUAL(all.callbackFromCount(0, 3), CompletionOp::Wait);
+  BOOST_CHECK_EQUAL(all.callbackFromCount(2, 3), CompletionOp::Wait);
+  BOOST_CHECK_EQUAL(all.callbackFromCount(3, 3), CompletionOp::Consume);
+
+  auto any = CompletionPolicyHelpers::consumeWhenAny();
+  BOOST_REQUIRE(any.callbackFromCount);
+  BOOST_CHECK_EQUAL(any.callbackFromCount(0, 3), CompletionOp::Wait);
+  BOOST_CHECK_EQUAL(any.callbackFromCount(1, 3), CompletionOp::Consume);
+
+  auto process = CompletionPolicyHelpers::processWhenAny();
+  BOOST_REQUIRE(process.callbackFromCount);
+  BOOST_CHECK_EQUAL(process.callbackFromCount(0, 3), CompletionOp::Wait);
+  BOOST_CHECK_EQUAL(process.callbackFromCount(1, 3), CompletionOp::Process);
+  BOOST_CHECK_EQUAL(process.callbackFromCount(3, 3), CompletionOp::Consume);
+
+  auto byName = CompletionPolicyHelpers::defineByName("foo", CompletionOp::Discard);
+  BOOST_REQUIRE(byName.callbackFromCount);
+  BOOST_CHECK_EQUAL(byName.callbackFromCount(1, 3), CompletionOp::Discard);
+
+  // Custom policies keep using the InputSpan
+  auto origin = CompletionPolicyHelpers::defineByNameOrigin("foo", "TST", CompletionOp::Consume);
+  BOOST_CHECK(!origin.callbackFromCount);
+}
@@ -51,6 +51,7 @@ void doTypeChecks()
   static_assert(std::is_lvalue_reference<decltype(allocator.make<int>(output))>::value);
   static_assert(std::is_lvalue_reference<decltype(allocator.make<std::string>(output, "test"))>::value);
   static_assert(std::is_lvalue_reference<decltype(allocator.make<std::vector<int>>(output))>::value);
+  static_assert(std::is_lvalue_reference<decltype(allocator.makeWithCapacity<std::vector<int>>(output, 10))>::value);
 }
 
 namespace test
@@ -308,6 +309,8 @@ DataProcessorSpec getSinkSpec()
     auto object13 = pc.inputs().get<TNamed*>("input13");
     ASSERT_ERROR(strcmp(object13->GetName(), "a_name") == 0);
     ASSERT_ERROR(strcmp(object13->GetTitle(), "a_title") == 0);
+    // the object is deserialised only once per record
+    ASSERT_ERROR(pc.inputs().get<TNamed*>("input13").get() == object13.get());
 
     LOG(INFO) << "extracting Root-serialized Non-TObject from input14";
     auto object14 = pc.inputs().get<o2::test::Polymorphic*>("input14");
@@ -12,11 +12,15 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 
+#include <filesystem>
 #include <fstream>
 #include <boost/test/unit_test.hpp>
+#include <arrow/table.h>
 
 #include "Headers/DataHeader.h"
 #include "Framework/DataInputDirector.h"
+#include "Framework/DataOutputDirector.h"
+#include "Framework/TableBuilder.h"
 
 BOOST_AUTO_TEST_CASE(TestDatainputDirector)
 {
@@ -108,3 +112,52 @@ BOOST_AUTO_TEST_CASE(TestDatainputDirector)
   BOOST_CHECK(didesc);
   BOOST_CHECK_EQUAL(didesc->getNumberInputfiles(), 3);
 }
+
+BOOST_AUTO_TEST_CASE(TestArrowFiles)
+{
+  using namespace o2::header;
+  using namespace o2::framework;
+
+  // write the tables of two time frames in the Arrow format,
+  // the time frame which is written again is continued in a second file
+  std::filesystem::remove_all("arrowresults.arrow");
+  DataOutputDirector dod;
+  dod.readString("AOD/UNO/0:O2uno::arrowresults");
+  dod.setFilenameBase("AnalysisResults");
+  dod.setFileFormat("arrow");
+  BOOST_CHECK(dod.isArrowFormat());
+
+  auto dh = DataHeader(DataDescription{"UNO"},
+                       DataOrigin{"AOD"},
+                       DataHeader::SubSpecificationType{0});
+  auto ds = dod.getDataOutputDescriptors(dh);
+  BOOST_REQUIRE_EQUAL(ds.size(), 1);
+  for (uint64_t tfNumber : {3, 1, 3}) {
+    TableBuilder builder;
+    auto rowWriter = builder.persist<int, float>({"fX", "fY"});
+    for (int i = 0; i < 10 * int(tfNumber); ++i) {
+      rowWriter(0, i, float(tfNumber));
+    }
+    dod.writeArrowTable(ds[0], tfNumber, builder.finalize());
+  }
+  dod.closeDataFiles();
+
+  // read them back
+  DataInputDirector didir("arrowresults.arrow");
+  BOOST_CHECK(didir.isArrowFile(dh, 0));
+  BOOST_CHECK_EQUAL(didir.getTimeFrameNumber(dh, 0, 0), 1);
+  BOOST_CHECK_EQUAL(didir.getTimeFrameNumber(dh, 0, 1), 3);
+  BOOST_CHECK_EQUAL(didir.getTimeFramesInFile(dh, 0), 2);
+  BOOST_CHECK(didir.getDataTree(dh, 0, 0) == nullptr);
+
+  auto table = didir.getArrowTable(dh, 0, 0);
+  BOOST_REQUIRE(table);
+  BOOST_CHECK_EQUAL(table->num_columns(), 2);
+  BOOST_CHECK_EQUAL(table->num_rows(), 10);
+  table = didir.getArrowTable(dh, 0, 1);
+  BOOST_REQUIRE(table);
+  BOOST_CHECK_EQUAL(table->num_rows(), 60);
+  BOOST_CHECK_EQUAL(table->schema()->metadata()->Get("label").ValueOrDie(), "O2uno");
+  BOOST_CHECK(didir.getArrowTable(dh, 0, 2) == nullptr);
+  didir.closeInputFiles();
+}
@@ -125,3 +125,28 @@ BOOST_AUTO_TEST_CASE(TestDataOutputDirector)
   BOOST_CHECK_EQUAL(ds[1]->treename, std::string("due"));
   BOOST_CHECK_EQUAL(ds[1]->colnames.size(), 1);
 }
+
+BOOST_AUTO_TEST_CASE(TestDataOutputDirectorParts)
+{
+  using namespace o2::header;
+  using namespace o2::framework;
+
+  DataOutputDirector dod;
+  dod.readString("AOD/UNO/0,AOD/DUE/0,AOD/TRE/0,AOD/QUATTRO/0::c1:fn1");
+  dod.setNumberOfParts(2);
+  dod.setFilenameBase("myresultfile");
+
+  auto uno = dod.getDataOutputDescriptors(DataHeader(DataDescription{"UNO"}, DataOrigin{"AOD"}, DataHeader::SubSpecificationType{0}));
+  auto due = dod.getDataOutputDescriptors(DataHeader(DataDescription{"DUE"}, DataOrigin{"AOD"}, DataHeader::SubSpecificationType{0}));
+  auto tre = dod.getDataOutputDescriptors(DataHeader(DataDescription{"TRE"}, DataOrigin{"AOD"}, DataHeader::SubSpecificationType{0}));
+  auto quattro = dod.getDataOutputDescriptors(DataHeader(DataDescription{"QUATTRO"}, DataOrigin{"AOD"}, DataHeader::SubSpecificationType{0}));
+  BOOST_REQUIRE(uno.size() == 1 && due.size() == 1 && tre.size() == 1 && quattro.size() == 1);
+
+  // the trees of a file are distributed round-robin over the parts
+  BOOST_CHECK_EQUAL(dod.getPartFilenameBase(uno[0]), std::string("myresultfile"));
+  BOOST_CHECK_EQUAL(dod.getPartFilenameBase(due[0]), std::string("myresultfile_1"));
+  BOOST_CHECK_EQUAL(dod.getPartFilenameBase(tre[0]), std::string("myresultfile"));
+  BOOST_CHECK_EQUAL(dod.getPartFilenameBase(quattro[0]), std::string("fn1"));
+  BOOST_CHECK_EQUAL(uno[0]->getFilenameBase(), std::string("myresultfile"));
+  BOOST_CHECK_EQUAL(due[0]->getFilenameBase(), std::string("myresultfile"));
+}
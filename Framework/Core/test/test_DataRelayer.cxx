@@ -593,3 +593,100 @@ BOOST_AUTO_TEST_CASE(SplitParts)
   BOOST_CHECK_NE(header2.get(), nullptr);
   BOOST_CHECK_NE(payload2.get(), nullptr);
 }
+
+// Parts belonging to different timeslices arriving interleaved must still end
+// up in their own slot, regardless of which slot was used last.
+BOOST_AUTO_TEST_CASE(TestInterleavedTimeslices)
+{
+  Monitoring metrics;
+  InputSpec spec1{"clusters", "TPC", "CLUSTERS"};
+  InputSpec spec2{"clusters_its", "ITS", "CLUSTERS"};
+
+  std::vector<InputRoute> inputs = {
+    InputRoute{spec1, 0, "Fake1", 0},
+    InputRoute{spec2, 1, "Fake2", 0}};
+
+  TimesliceIndex index;
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAll();
+  DataRelayer relayer(policy, inputs, metrics, index);
+  relayer.setPipelineLength(4);
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+
+  auto createMessage = [&transport, &relayer](DataHeader& dh, size_t time) {
+    DataProcessingHeader dph{time, 1};
+    Stack stack{dh, dph};
+    FairMQMessagePtr header = transport->CreateMessage(stack.size());
+    FairMQMessagePtr payload = transport->CreateMessage(1000);
+    memcpy(header->GetData(), stack.data(), stack.size());
+    BOOST_CHECK_EQUAL(relayer.relay(header, payload), DataRelayer::WillRelay);
+  };
+
+  DataHeader dh1;
+  dh1.dataDescription = "CLUSTERS";
+  dh1.dataOrigin = "TPC";
+  dh1.subSpecification = 0;
+  dh1.splitPayloadIndex = 0;
+  dh1.splitPayloadParts = 1;
+
+  DataHeader dh2;
+  dh2.dataDescription = "CLUSTERS";
+  dh2.dataOrigin = "ITS";
+  dh2.subSpecification = 0;
+  dh2.splitPayloadIndex = 0;
+  dh2.splitPayloadParts = 1;
+
+  createMessage(dh1, 0);
+  createMessage(dh1, 1);
+  createMessage(dh2, 0);
+  std::vector<RecordAction> ready;
+  relayer.getReadyToProcess(ready);
+  BOOST_REQUIRE_EQUAL(ready.size(), 1);
+  BOOST_CHECK_EQUAL(relayer.getTimesliceForSlot(ready[0].slot).value, 0);
+  auto result = relayer.getInputsForTimeslice(ready[0].slot);
+  BOOST_REQUIRE_EQUAL(result.size(), 2);
+  BOOST_REQUIRE_EQUAL(result.at(0).size(), 1);
+  BOOST_REQUIRE_EQUAL(result.at(1).size(), 1);
+  relayer.updateCacheStatus(ready[0].slot, CacheEntryStatus::RUNNING, CacheEntryStatus::DONE);
+
+  createMessage(dh2, 1);
+  ready.clear();
+  relayer.getReadyToProcess(ready);
+  BOOST_REQUIRE_EQUAL(ready.size(), 1);
+  BOOST_CHECK_EQUAL(relayer.getTimesliceForSlot(ready[0].slot).value, 1);
+  result = relayer.getInputsForTimeslice(ready[0].slot);
+  BOOST_REQUIRE_EQUAL(result.size(), 2);
+  BOOST_REQUIRE_EQUAL(result.at(0).size(), 1);
+  BOOST_REQUIRE_EQUAL(result.at(1).size(), 1);
+}
+
+// Only the routes which can match a given (origin, description, subSpec)
+// need to be checked, in the same order as the full list.
+BOOST_AUTO_TEST_CASE(TestRouteCandidates)
+{
+  std::vector<InputRoute> inputs = {
+    InputRoute{InputSpec{"clusters", "TPC", "CLUSTERS", 0}, 0, "Fake", 0},
+    InputRoute{InputSpec{"any", ConcreteDataTypeMatcher{"TPC", "CLUSTERS"}}, 1, "Fake", 0},
+    InputRoute{InputSpec{"tracks", "TPC", "TRACKS", 0}, 2, "Fake", 0},
+    InputRoute{InputSpec{"clusters1", "TPC", "CLUSTERS", 1}, 3, "Fake", 0}};
+
+  auto distinctRoutes = DataRelayerHelpers::createDistinctRouteIndex(inputs);
+  auto concreteMatchers = DataRelayerHelpers::createConcreteMatchers(inputs);
+  BOOST_REQUIRE_EQUAL(concreteMatchers.size(), 4);
+  BOOST_CHECK(concreteMatchers[0].has_value());
+  BOOST_CHECK(concreteMatchers[1].has_value() == false);
+
+  auto candidates = DataRelayerHelpers::createRouteCandidates(ConcreteDataMatcher{"TPC", "CLUSTERS", 1}, distinctRoutes, concreteMatchers);
+  BOOST_REQUIRE_EQUAL(candidates.size(), 2);
+  BOOST_CHECK_EQUAL(candidates[0].position, 1);
+  BOOST_CHECK(candidates[0].concrete == false);
+  BOOST_CHECK_EQUAL(candidates[1].position, 3);
+  BOOST_CHECK(candidates[1].concrete);
+
+  candidates = DataRelayerHelpers::createRouteCandidates(ConcreteDataMatcher{"TPC", "TRACKS", 0}, distinctRoutes, concreteMatchers);
+  BOOST_REQUIRE_EQUAL(candidates.size(), 2);
+  BOOST_CHECK_EQUAL(candidates[0].position, 1);
+  BOOST_CHECK_EQUAL(candidates[1].position, 2);
+  BOOST_CHECK(candidates[1].concrete);
+}
@@ -0,0 +1,30 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework DeviceAffinityHelpers
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "../src/DeviceAffinityHelpers.h"
+#include "Framework/RuntimeError.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestParseCPUList)
+{
+  BOOST_CHECK(DeviceAffinityHelpers::parseCPUList("").empty());
+  BOOST_CHECK(DeviceAffinityHelpers::parseCPUList("3") == std::vector<int>({3}));
+  BOOST_CHECK(DeviceAffinityHelpers::parseCPUList("0-3,8,10-11\n") == std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+  BOOST_CHECK_THROW(DeviceAffinityHelpers::parseCPUList("0-"), o2::framework::RuntimeErrorRef);
+  BOOST_CHECK_THROW(DeviceAffinityHelpers::parseCPUList("3-1"), o2::framework::RuntimeErrorRef);
+  BOOST_CHECK_THROW(DeviceAffinityHelpers::parseCPUList("1,"), o2::framework::RuntimeErrorRef);
+  BOOST_CHECK_THROW(DeviceAffinityHelpers::parseCPUList("a"), o2::framework::RuntimeErrorRef);
+}
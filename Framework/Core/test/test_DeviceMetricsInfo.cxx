@@ -223,3 +223,37 @@ BOOST_AUTO_TEST_CASE(TestHelpers)
   BOOST_CHECK_EQUAL(metric2, 0);
   BOOST_CHECK_EQUAL(metric3, 1);
 }
+
+BOOST_AUTO_TEST_CASE(TestMetricRollups)
+{
+  using namespace o2::framework;
+  DeviceMetricsInfo info;
+  auto cursor = DeviceMetricsHelper::createNumericMetric<int>(info, "akey");
+  // one value every 100 ms for 25 min, longer than the raw buffers and the 1 s rollups hold
+  size_t t0 = 1600000000000;
+  for (int i = 0; i < 15000; ++i) {
+    cursor(info, i % 10, t0 + i * 100);
+  }
+  auto const& rollups = info.rollups[0];
+  BOOST_CHECK_EQUAL(rollups.filledBins[0], 1500);
+  BOOST_CHECK_EQUAL(rollups.availableBins(0), MetricRollups::MAX_BINS[0]);
+  BOOST_CHECK_EQUAL(rollups.availableBins(1), 150);
+  BOOST_CHECK_EQUAL(rollups.availableBins(2), 26);
+  BOOST_CHECK_EQUAL(rollups.firstTimestamp(0), t0 + (1500 - MetricRollups::MAX_BINS[0]) * 1000);
+  BOOST_CHECK_EQUAL(rollups.firstTimestamp(2), t0 - t0 % 60000);
+  auto const& last = rollups.bin(0, rollups.availableBins(0) - 1);
+  BOOST_CHECK_EQUAL(last.index, (t0 + 14999 * 100) / 1000);
+  BOOST_CHECK_EQUAL(last.count, 10);
+  BOOST_CHECK_EQUAL(last.min, 0);
+  BOOST_CHECK_EQUAL(last.max, 9);
+  BOOST_CHECK_CLOSE(last.avg, 4.5, 0.01);
+
+  // the values parsed from the text metrics are rolled up as well
+  ParsedMetricMatch match;
+  BOOST_CHECK(DeviceMetricsHelper::parseMetric("[METRIC] bkey,0 12 1789372894 hostname=test.cern.ch", match));
+  BOOST_CHECK(DeviceMetricsHelper::processMetric(match, info));
+  auto bkey = DeviceMetricsHelper::metricIdxByName("bkey", info);
+  BOOST_CHECK_EQUAL(info.rollups.size(), 2);
+  BOOST_CHECK_EQUAL(info.rollups[bkey].availableBins(0), 1);
+  BOOST_CHECK_EQUAL(info.rollups[bkey].bin(0, 0).max, 12);
+}
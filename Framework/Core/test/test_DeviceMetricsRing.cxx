@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework DeviceMetricsRing
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRing.h"
+#include <boost/test/unit_test.hpp>
+#include <unistd.h>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestDeviceMetricsRing)
+{
+  auto consumer = DeviceMetricsRing::create(5);
+  BOOST_REQUIRE(consumer.get() != nullptr);
+  BOOST_CHECK_EQUAL(consumer->capacity(), 8);
+  // The producer lives in another process, here it is simply another mapping.
+  auto producer = DeviceMetricsRing::attach(dup(consumer->fd()));
+  BOOST_REQUIRE(producer.get() != nullptr);
+
+  DeviceMetricsInfo info;
+  BOOST_CHECK_EQUAL(consumer->consume(info), 0);
+
+  int akey = producer->registerMetric("akey");
+  int bkey = producer->registerMetric("bkey");
+  BOOST_CHECK_EQUAL(akey, 0);
+  BOOST_CHECK_EQUAL(bkey, 1);
+
+  DeviceMetricsRing::Record record;
+  record.metricIndex = akey;
+  record.type = MetricType::Int;
+  record.timestamp = 1789372894;
+  record.intValue = 12;
+  BOOST_CHECK(producer->push(record));
+  record.metricIndex = bkey;
+  record.type = MetricType::Float;
+  record.timestamp = 1789372895;
+  record.floatValue = 16.5;
+  BOOST_CHECK(producer->push(record));
+  record.metricIndex = akey;
+  record.type = MetricType::Int;
+  record.timestamp = 1789372896;
+  record.intValue = 13;
+  BOOST_CHECK(producer->push(record));
+
+  size_t newMetrics = 0;
+  auto newMetricCallback = [&newMetrics](std::string const&, MetricInfo const&, int, size_t) { ++newMetrics; };
+  BOOST_CHECK_EQUAL(consumer->consume(info, newMetricCallback), 3);
+  BOOST_CHECK_EQUAL(newMetrics, 2);
+  BOOST_REQUIRE_EQUAL(info.metrics.size(), 2);
+  auto ai = DeviceMetricsHelper::metricIdxByName("akey", info);
+  auto bi = DeviceMetricsHelper::metricIdxByName("bkey", info);
+  BOOST_REQUIRE_LT(ai, 2);
+  BOOST_REQUIRE_LT(bi, 2);
+  BOOST_CHECK_EQUAL(info.metrics[ai].type, MetricType::Int);
+  BOOST_CHECK_EQUAL(info.metrics[ai].filledMetrics, 2);
+  BOOST_CHECK_EQUAL(info.intMetrics[info.metrics[ai].storeIdx][0], 12);
+  BOOST_CHECK_EQUAL(info.intMetrics[info.metrics[ai].storeIdx][1], 13);
+  BOOST_CHECK_EQUAL(info.timestamps[ai][1], 1789372896);
+  BOOST_CHECK_EQUAL(info.metrics[bi].type, MetricType::Float);
+  BOOST_CHECK_EQUAL(info.floatMetrics[info.metrics[bi].storeIdx][0], 16.5);
+  BOOST_CHECK_EQUAL(info.minDomain[bi], 1789372895);
+  BOOST_CHECK_EQUAL(consumer->consume(info), 0);
+
+  // A metric which is also sent as text ends up in the same place.
+  std::string metric = "[METRIC] akey,0 14 1789372897 hostname=test.cern.ch";
+  ParsedMetricMatch match;
+  BOOST_REQUIRE(DeviceMetricsHelper::parseMetric(metric, match));
+  BOOST_REQUIRE(DeviceMetricsHelper::processMetric(match, info));
+  BOOST_CHECK_EQUAL(info.metrics.size(), 2);
+  BOOST_CHECK_EQUAL(info.intMetrics[info.metrics[ai].storeIdx][2], 14);
+
+  // Once the ring is full, pushing fails until the consumer catches up.
+  record.metricIndex = akey;
+  record.type = MetricType::Int;
+  for (size_t i = 0; i < producer->capacity(); ++i) {
+    record.intValue = 100 + i;
+    BOOST_CHECK(producer->push(record));
+  }
+  BOOST_CHECK(producer->push(record) == false);
+  BOOST_CHECK_EQUAL(consumer->consume(info), producer->capacity());
+  BOOST_CHECK_EQUAL(info.metrics[ai].filledMetrics, 3 + producer->capacity());
+  BOOST_CHECK_EQUAL(info.intMetrics[info.metrics[ai].storeIdx][2 + producer->capacity()], 107);
+  BOOST_CHECK(producer->push(record));
+
+  // Only a limited number of metrics can be registered.
+  for (size_t i = 2; i < DeviceMetricsRing::MAX_METRICS; ++i) {
+    BOOST_CHECK_EQUAL(producer->registerMetric("key" + std::to_string(i)), i);
+  }
+  BOOST_CHECK_EQUAL(producer->registerMetric("onetoomany"), -1);
+}
+
+BOOST_AUTO_TEST_CASE(TestDeviceMetricsRingInvalid)
+{
+  int fds[2];
+  BOOST_REQUIRE_EQUAL(pipe(fds), 0);
+  BOOST_CHECK(DeviceMetricsRing::attach(fds[0]).get() == nullptr);
+  close(fds[0]);
+  close(fds[1]);
+}
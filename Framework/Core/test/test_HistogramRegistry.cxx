@@ -14,6 +14,7 @@
 
 #include "Framework/HistogramRegistry.h"
 #include <boost/test/unit_test.hpp>
+#include <TList.h>
 #include <iostream>
 
 using namespace o2;
@@ -129,3 +130,94 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryStepTHn)
 
   registry.print();
 }
+
+BOOST_AUTO_TEST_CASE(StepTHnChunks)
+{
+  int nBins[2] = {10, 20};
+  double xmin[2] = {0., 0.};
+  double xmax[2] = {10., 20.};
+  StepTHnF hist("chunked", "chunked", 2, 2, nBins, xmin, xmax);
+  hist.setChunkSize(16);
+  BOOST_CHECK_EQUAL(hist.getNChunks(), 13);
+
+  hist.Fill(0, 0.5, 0.5);
+  hist.Fill(0, 9.5, 19.5, 2.);
+  double values[] = {3.5, 7.5, 3.5, 7.5};
+  hist.FillN(1, 2, values);
+
+  // only the chunks with filled bins are allocated
+  BOOST_CHECK(hist.getValues(0, 0) != nullptr);
+  BOOST_CHECK(hist.getValues(0, 1) == nullptr);
+  BOOST_CHECK(hist.getValues(0, 12) != nullptr);
+  BOOST_CHECK(hist.getValues(1, 4) != nullptr);
+
+  // the clone is streamed, the merge adds the chunks
+  std::unique_ptr<StepTHnF> clone(static_cast<StepTHnF*>(hist.Clone()));
+  TList list;
+  list.Add(clone.get());
+  BOOST_CHECK_EQUAL(hist.Merge(&list), 2);
+
+  int bin0[2] = {1, 1};
+  int bin1[2] = {10, 20};
+  int bin2[2] = {4, 8};
+  BOOST_CHECK_CLOSE(hist.getTHn(0)->GetBinContent(bin0), 2., 1e-6);
+  BOOST_CHECK_CLOSE(hist.getTHn(0)->GetBinContent(bin1), 4., 1e-6);
+  BOOST_CHECK_CLOSE(hist.getTHn(1)->GetBinContent(bin2), 4., 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(HistogramRegistryBatchFill)
+{
+  HistogramRegistry registry{
+    "registry", {
+                  {"x", "x", {HistType::kTH1F, {{20, -5.0f, 5.0f}}}},                             //
+                  {"xBatch", "x", {HistType::kTH1F, {{20, -5.0f, 5.0f}}}},                        //
+                  {"xyw", "xy", {HistType::kTH2D, {{10, -2.0f, 2.0f}, {8, -3.0f, 3.0f}}}},        //
+                  {"xywBatch", "xy", {HistType::kTH2D, {{10, -2.0f, 2.0f}, {8, -3.0f, 3.0f}}}},   //
+                  {"xVar", "x", {HistType::kTH1F, {AxisSpec{std::vector<double>{-5.0, -1.0, 0.0, 0.5, 5.0}}}}}, //
+                  {"xyProf", "xy", {HistType::kTProfile, {{10, -2.0f, 2.0f}}}}                    //
+                }                                                                                 //
+  };
+
+  std::vector<float> x, y, w;
+  for (int i = 0; i < 1000; ++i) {
+    x.push_back(-6.f + 0.012f * i);
+    y.push_back(3.5f - 0.007f * i);
+    w.push_back(0.5f + 0.001f * i);
+  }
+  for (size_t i = 0; i < x.size(); ++i) {
+    registry.fill(HIST("x"), x[i]);
+    registry.fill(HIST("xyw"), x[i], y[i], w[i]);
+  }
+  // filled in two batches, the first one is added to the histogram before the second one
+  size_t half = x.size() / 2;
+  registry.fillBatch(HIST("xBatch"), gsl::span<const float>(x.data(), half));
+  registry.fillBatch(HIST("xywBatch"), gsl::span<const float>(x.data(), half), gsl::span<const float>(y.data(), half), gsl::span<const float>(w.data(), half));
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("xBatch"))->GetEntries(), half);
+  registry.fillBatch(HIST("xBatch"), gsl::span<const float>(x.data() + half, x.size() - half));
+  registry.fillBatch(HIST("xywBatch"), gsl::span<const float>(x.data() + half, x.size() - half), gsl::span<const float>(y.data() + half, x.size() - half), gsl::span<const float>(w.data() + half, x.size() - half));
+
+  auto& h1 = registry.get<TH1>(HIST("x"));
+  auto& h1Batch = registry.get<TH1>(HIST("xBatch"));
+  BOOST_CHECK_EQUAL(h1->GetEntries(), h1Batch->GetEntries());
+  BOOST_CHECK_CLOSE(h1->GetMean(), h1Batch->GetMean(), 1e-6);
+  BOOST_CHECK_CLOSE(h1->GetStdDev(), h1Batch->GetStdDev(), 1e-6);
+  for (int bin = 0; bin <= h1->GetNbinsX() + 1; ++bin) {
+    BOOST_CHECK_EQUAL(h1->GetBinContent(bin), h1Batch->GetBinContent(bin));
+  }
+
+  auto& h2 = registry.get<TH2>(HIST("xyw"));
+  auto& h2Batch = registry.get<TH2>(HIST("xywBatch"));
+  BOOST_CHECK_EQUAL(h2->GetEntries(), h2Batch->GetEntries());
+  BOOST_CHECK_CLOSE(h2->GetMean(2), h2Batch->GetMean(2), 1e-6);
+  BOOST_CHECK_CLOSE(h2->GetCorrelationFactor(), h2Batch->GetCorrelationFactor(), 1e-6);
+  for (int bin = 0; bin < h2->GetNcells(); ++bin) {
+    BOOST_CHECK_CLOSE(h2->GetBinContent(bin), h2Batch->GetBinContent(bin), 1e-9);
+    BOOST_CHECK_CLOSE(h2->GetBinError(bin), h2Batch->GetBinError(bin), 1e-9);
+  }
+
+  // histograms without fixed bins are filled entry by entry
+  registry.fillBatch(HIST("xVar"), x);
+  registry.fillBatch(HIST("xyProf"), x, y);
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("xVar"))->GetEntries(), x.size());
+  BOOST_CHECK_EQUAL(registry.get<TProfile>(HIST("xyProf"))->GetEntries(), x.size());
+}
@@ -132,4 +132,27 @@ BOOST_AUTO_TEST_CASE(TestIndexBuilder)
     BOOST_REQUIRE(row.categoryId() == cs[i]);
     ++i;
   }
+
+  // the index of the same tables is built once
+  auto t7 = IndexSparse::indexBuilder("test2", typename IDX2s::persistent_columns_t{}, st1, std::tie(st2, st1, st3, st4));
+  BOOST_CHECK_EQUAL(t7.get(), t6.get());
+
+  // the tables do not need to be sorted by the key
+  TableBuilder b5;
+  auto w5 = b5.cursor<Flags>();
+  for (auto i : {8, 0, 5, 2, 1}) {
+    w5(0, i, static_cast<bool>(i % 2));
+  }
+  auto t8 = b5.finalize();
+  Flags st5{t8};
+  auto t9 = IndexSparse::indexBuilder("test2", typename IDX2s::persistent_columns_t{}, st1, std::tie(st2, st1, st5, st4));
+  BOOST_CHECK(t9.get() != t6.get());
+  IDXs idxu{t9};
+  std::array<int, 7> fu{1, 4, 3, -1, -1, 0, -1};
+  i = 0;
+  for (auto const& row : idxu) {
+    BOOST_REQUIRE(row.flagId() == fu[i]);
+    BOOST_REQUIRE(row.categoryId() == cs[i]);
+    ++i;
+  }
 }
@@ -0,0 +1,73 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework InjectionRateController
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "../src/InjectionRateController.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestInjectionRateController)
+{
+  InjectionRateController controller;
+  // Nothing to do while the topology keeps up.
+  BOOST_CHECK(controller.update(0.2, 100) == false);
+  BOOST_CHECK_EQUAL(controller.interval(), 0);
+  // Pressure without anything being injected does not limit anything.
+  BOOST_CHECK(controller.update(0.9, 0) == false);
+  BOOST_CHECK_EQUAL(controller.rate, 0);
+
+  // Too much pressure: the rate gets halved.
+  BOOST_CHECK(controller.update(0.9, 100));
+  BOOST_CHECK_EQUAL(controller.rate, 50);
+  BOOST_CHECK_EQUAL(controller.interval(), 20000);
+  // We give the topology some time before cutting again.
+  for (int i = 0; i < controller.holdoff - 1; ++i) {
+    BOOST_CHECK(controller.update(0.9, 50) == false);
+  }
+  BOOST_CHECK(controller.update(0.9, 50));
+  BOOST_CHECK_EQUAL(controller.rate, 25);
+  // In between the watermarks we just keep the rate.
+  BOOST_CHECK(controller.update(0.6, 25) == false);
+  // Once it drains, we increase linearly, until the limit is not needed anymore.
+  BOOST_CHECK(controller.update(0.1, 25));
+  BOOST_CHECK_EQUAL(controller.rate, 30);
+  for (int i = 0; i < 13; ++i) {
+    BOOST_CHECK(controller.update(0.1, controller.rate));
+  }
+  BOOST_CHECK_EQUAL(controller.rate, 95);
+  BOOST_CHECK(controller.update(0.1, 95));
+  BOOST_CHECK_EQUAL(controller.rate, 0);
+  BOOST_CHECK_EQUAL(controller.interval(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestInjectionRateControllerMinimum)
+{
+  InjectionRateController controller;
+  controller.holdoff = 0;
+  BOOST_CHECK(controller.update(1, 0.04));
+  BOOST_CHECK_EQUAL(controller.rate, 0.02);
+  BOOST_CHECK(controller.update(1, 0.02));
+  BOOST_CHECK_EQUAL(controller.rate, controller.minRate);
+  // Already at the minimum, nothing changes.
+  BOOST_CHECK(controller.update(1, 0.01) == false);
+  // Readers which are slower than the limit are cut from their actual rate,
+  // faster ones (e.g. not honouring the limit) from the limit itself.
+  InjectionRateController other;
+  other.holdoff = 0;
+  BOOST_CHECK(other.update(1, 100));
+  BOOST_CHECK(other.update(1, 10));
+  BOOST_CHECK_EQUAL(other.rate, 5);
+  BOOST_CHECK(other.update(1, 100));
+  BOOST_CHECK_EQUAL(other.rate, 2.5);
+}
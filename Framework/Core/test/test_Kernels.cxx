@@ -14,6 +14,7 @@
 #define BOOST_TEST_DYN_LINK
 
 #include "Framework/Kernels.h"
+#include "Framework/GroupingIndexCache.h"
 #include "Framework/TableBuilder.h"
 #include "Framework/Pack.h"
 #include <boost/test/unit_test.hpp>
@@ -78,3 +79,125 @@ BOOST_AUTO_TEST_CASE(TestSlicingFramework)
     BOOST_REQUIRE_EQUAL(slices[i].table()->num_rows(), sizes[i]);
   }
 }
+
+BOOST_AUTO_TEST_CASE(TestGroupingIndex)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, int32_t>({"x", "y"});
+
+  rowWriter(0, -1, 3);
+  rowWriter(0, 1, 4);
+  rowWriter(0, 1, 5);
+  rowWriter(0, 1, 6);
+  rowWriter(0, 1, 7);
+  rowWriter(0, 2, 7);
+  rowWriter(0, 4, 8);
+  rowWriter(0, 5, 9);
+  rowWriter(0, 5, 10);
+  auto table = builder.finalize();
+
+  GroupingIndex index;
+  auto status = makeGroupingIndex<int32_t>("x", table, 12, index);
+  BOOST_REQUIRE(status.ok());
+  BOOST_REQUIRE_EQUAL(index.sizes.size(), 12);
+  std::array<int, 12> sizes{0, 4, 1, 0, 1, 2, 0, 0, 0, 0, 0, 0};
+  std::array<uint64_t, 12> offsets{1, 1, 5, 6, 6, 7, 9, 9, 9, 9, 9, 9};
+  for (auto i = 0u; i < index.sizes.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(index.sizes[i], sizes[i]);
+    BOOST_REQUIRE_EQUAL(index.offsets[i], offsets[i]);
+  }
+  BOOST_REQUIRE(makeGroupingIndex<int32_t>("x", table, 5, index).ok() == false);
+
+  // the unassigned rows can also be at the end
+  TableBuilder builderTrailing;
+  auto rowWriterTrailing = builderTrailing.persist<int32_t, int32_t>({"x", "y"});
+  rowWriterTrailing(0, 1, 4);
+  rowWriterTrailing(0, 1, 5);
+  rowWriterTrailing(0, 2, 7);
+  rowWriterTrailing(0, 4, 8);
+  rowWriterTrailing(0, -1, 3);
+  rowWriterTrailing(0, -1, 3);
+  auto tableTrailing = builderTrailing.finalize();
+  GroupingIndex indexTrailing;
+  BOOST_REQUIRE(makeGroupingIndex<int32_t>("x", tableTrailing, 6, indexTrailing).ok());
+  std::array<int, 6> sizesTrailing{0, 2, 1, 0, 1, 0};
+  std::array<uint64_t, 6> offsetsTrailing{0, 0, 2, 3, 3, 4};
+  for (auto i = 0u; i < indexTrailing.sizes.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(indexTrailing.sizes[i], sizesTrailing[i]);
+    BOOST_REQUIRE_EQUAL(indexTrailing.offsets[i], offsetsTrailing[i]);
+  }
+
+  auto& cache = GroupingIndexCache::instance();
+  cache.clear();
+  auto cached = cache.get("x", table, 12);
+  BOOST_REQUIRE(cached->sizes == index.sizes);
+  BOOST_REQUIRE_EQUAL(cache.get("x", table, 12).get(), cached.get());
+  // a different table object on the same memory shares the grouping
+  auto view = arrow::Table::Make(table->schema(), table->columns());
+  BOOST_REQUIRE_EQUAL(cache.get("x", view, 12).get(), cached.get());
+  BOOST_REQUIRE_EQUAL(cache.size(), 1);
+  // slices of the same memory with the same length have their own grouping
+  {
+    auto first = table->Slice(1, 4);
+    auto second = table->Slice(5, 4);
+    auto groupedFirst = cache.get("x", first, 12);
+    auto groupedSecond = cache.get("x", second, 12);
+    BOOST_REQUIRE_NE(groupedFirst.get(), groupedSecond.get());
+    BOOST_REQUIRE_EQUAL(groupedFirst->sizes[1], 4);
+    BOOST_REQUIRE_EQUAL(groupedSecond->sizes[1], 0);
+    BOOST_REQUIRE_EQUAL(groupedSecond->sizes[5], 2);
+    BOOST_REQUIRE_EQUAL(cache.size(), 3);
+  }
+  // the entry is dropped once the table is gone
+  table.reset();
+  view.reset();
+  TableBuilder builder2;
+  auto rowWriter2 = builder2.persist<int32_t, int32_t>({"x", "y"});
+  rowWriter2(0, 3, 1);
+  auto table2 = builder2.finalize();
+  BOOST_REQUIRE_EQUAL(cache.get("x", table2, 12)->sizes[3], 1);
+  BOOST_REQUIRE_EQUAL(cache.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestCachesChunks)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, int32_t>({"x", "y"});
+  for (int i = 0; i < 4; ++i) {
+    rowWriter(0, 1, i);
+  }
+  auto table = builder.finalize();
+  TableBuilder builder2;
+  auto rowWriter2 = builder2.persist<int32_t, int32_t>({"x", "y"});
+  rowWriter2(0, 2, 0);
+  rowWriter2(0, 2, 1);
+  auto table2 = builder2.finalize();
+
+  // same memory, offset and length of the first chunk, but the rows after it come from another table
+  auto x = table->GetColumnByName("x")->chunk(0);
+  auto y = table->GetColumnByName("y")->chunk(0);
+  auto x2 = table2->GetColumnByName("x")->chunk(0);
+  auto y2 = table2->GetColumnByName("y")->chunk(0);
+  auto single = arrow::Table::Make(table->schema(), {std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{x}),
+                                                     std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{y})});
+  auto split = arrow::Table::Make(table->schema(), {std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{x->Slice(0, 2), x2}),
+                                                    std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{y->Slice(0, 2), y2})});
+  BOOST_REQUIRE_EQUAL(split->num_rows(), single->num_rows());
+
+  auto& groupings = GroupingIndexCache::instance();
+  groupings.clear();
+  BOOST_REQUIRE_EQUAL(groupings.get("x", single, 3)->sizes[2], 0);
+  BOOST_REQUIRE_EQUAL(groupings.get("x", split, 3)->sizes[2], 2);
+  BOOST_REQUIRE_EQUAL(groupings.size(), 2);
+
+  auto& categories = CategoryIndexCache::instance();
+  categories.clear();
+  int builds = 0;
+  auto build = [&builds]() { ++builds; return CategoryIndexCache::CategoryIndex{}; };
+  categories.get("x", single, 1, 0, build);
+  categories.get("x", single, 1, 0, build);
+  BOOST_REQUIRE_EQUAL(builds, 1);
+  categories.get("x", split, 1, 0, build);
+  BOOST_REQUIRE_EQUAL(builds, 2);
+  BOOST_REQUIRE_EQUAL(categories.size(), 2);
+}
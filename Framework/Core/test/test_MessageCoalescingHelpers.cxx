@@ -0,0 +1,124 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework MessageCoalescingHelpers
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "../src/MessageCoalescingHelpers.h"
+#include "../src/MessageCompressionHelpers.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/PayloadCompressionHeader.h"
+#include "Framework/RuntimeError.h"
+#include "Headers/Stack.h"
+#include <boost/test/unit_test.hpp>
+#include <fairmq/FairMQTransportFactory.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestCoalesceAndSplit)
+{
+  std::string h0 = "header0";
+  std::string p0 = "a payload";
+  std::string h1 = "the second header";
+  std::string p1 = "";
+  std::string h2 = "h2";
+  std::string p2(100, 'x');
+  std::vector<MessageCoalescingHelpers::Part> parts{
+    {h0.data(), h0.size(), p0.data(), p0.size()},
+    {h1.data(), h1.size(), p1.data(), p1.size()},
+    {h2.data(), h2.size(), p2.data(), p2.size()},
+  };
+  auto size = MessageCoalescingHelpers::coalescedSize(parts);
+  BOOST_CHECK_EQUAL(size, 8 + 3 * 32 + 8 + 16 + 24 + 0 + 8 + 104);
+  std::vector<char> buffer(size);
+  MessageCoalescingHelpers::coalesce(parts, buffer.data());
+
+  auto split = MessageCoalescingHelpers::split(buffer.data(), buffer.size());
+  BOOST_REQUIRE_EQUAL(split.size(), 3);
+  for (size_t pi = 0; pi < parts.size(); ++pi) {
+    BOOST_CHECK_EQUAL(split[pi].headerSize, parts[pi].headerSize);
+    BOOST_CHECK_EQUAL(split[pi].payloadSize, parts[pi].payloadSize);
+    BOOST_CHECK(memcmp(split[pi].header, parts[pi].header, parts[pi].headerSize) == 0);
+    BOOST_CHECK(memcmp(split[pi].payload, parts[pi].payload, parts[pi].payloadSize) == 0);
+    BOOST_CHECK_EQUAL(((char const*)split[pi].header - buffer.data()) % 8, 0);
+    BOOST_CHECK_EQUAL(((char const*)split[pi].payload - buffer.data()) % 8, 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestSplitMalformed)
+{
+  std::vector<MessageCoalescingHelpers::Part> parts{{"h", 1, "p", 1}};
+  std::vector<char> buffer(MessageCoalescingHelpers::coalescedSize(parts));
+  MessageCoalescingHelpers::coalesce(parts, buffer.data());
+  BOOST_CHECK_THROW(MessageCoalescingHelpers::split(buffer.data(), 4), RuntimeErrorRef);
+  BOOST_CHECK_THROW(MessageCoalescingHelpers::split(buffer.data(), buffer.size() - 8), RuntimeErrorRef);
+  uint64_t count = 1000;
+  memcpy(buffer.data(), &count, sizeof(count));
+  BOOST_CHECK_THROW(MessageCoalescingHelpers::split(buffer.data(), buffer.size()), RuntimeErrorRef);
+  count = 0;
+  memcpy(buffer.data(), &count, sizeof(count));
+  BOOST_CHECK(MessageCoalescingHelpers::split(buffer.data(), sizeof(count)).empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestIsCoalesced)
+{
+  o2::header::DataHeader dh{"COALESCED", "DPL", 3};
+  BOOST_CHECK(MessageCoalescingHelpers::isCoalesced(dh));
+  o2::header::DataHeader other{"CLUSTERS", "TPC", 0};
+  BOOST_CHECK(MessageCoalescingHelpers::isCoalesced(other) == false);
+}
+
+BOOST_AUTO_TEST_CASE(TestCoalescedAndCompressed)
+{
+  // Enough small parts to get a coalesced payload which is big enough to be compressed,
+  // as it happens with both --dpl-coalesce-outputs and a compressed channel.
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  constexpr size_t nParts = 8;
+  constexpr size_t threshold = 16 * 1024;
+  FairMQParts parts;
+  for (size_t pi = 0; pi < nParts; ++pi) {
+    o2::header::DataHeader dh{"CLUSTERS", "TPC", static_cast<o2::header::DataHeader::SubSpecificationType>(pi), threshold};
+    o2::header::Stack stack{dh, DataProcessingHeader{1, 0}};
+    auto header = transport->CreateMessage(stack.size());
+    memcpy(header->GetData(), stack.data(), stack.size());
+    auto payload = transport->CreateMessage(threshold);
+    memset(payload->GetData(), 'a' + pi, threshold);
+    parts.AddPart(std::move(header));
+    parts.AddPart(std::move(payload));
+  }
+
+  MessageCoalescingHelpers::coalesceParts(parts, *transport, threshold);
+  BOOST_REQUIRE_EQUAL(parts.Size(), 2);
+  BOOST_REQUIRE(parts.At(1)->GetSize() >= MessageCompressionHelpers::MinimumSize);
+  MessageCompressionHelpers::compressParts(parts, *transport, ChannelCompression::LZ4);
+  BOOST_REQUIRE_EQUAL(parts.Size(), 2);
+  BOOST_REQUIRE(o2::header::get<PayloadCompressionHeader*>(parts.At(0)->GetData()));
+  auto* cdh = o2::header::get<o2::header::DataHeader*>(parts.At(0)->GetData());
+  BOOST_REQUIRE(cdh);
+  BOOST_CHECK(MessageCoalescingHelpers::isCoalesced(*cdh));
+
+  // The receiver must decompress before splitting.
+  BOOST_CHECK_EQUAL(MessageCompressionHelpers::decompressParts(parts, *transport), 0);
+  BOOST_CHECK_EQUAL(MessageCoalescingHelpers::splitParts(parts, *transport), 0);
+  BOOST_REQUIRE_EQUAL(parts.Size(), 2 * nParts);
+  for (size_t pi = 0; pi < nParts; ++pi) {
+    auto* dh = o2::header::get<o2::header::DataHeader*>(parts.At(2 * pi)->GetData());
+    BOOST_REQUIRE(dh);
+    BOOST_CHECK_EQUAL(dh->subSpecification, pi);
+    BOOST_CHECK(o2::header::get<PayloadCompressionHeader*>(parts.At(2 * pi)->GetData()) == nullptr);
+    BOOST_REQUIRE_EQUAL(parts.At(2 * pi + 1)->GetSize(), threshold);
+    auto* payload = reinterpret_cast<char const*>(parts.At(2 * pi + 1)->GetData());
+    BOOST_CHECK(std::all_of(payload, payload + threshold, [pi](char c) { return c == char('a' + pi); }));
+  }
+}
@@ -0,0 +1,83 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework MessageCompressionHelpers
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "../src/MessageCompressionHelpers.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/PayloadCompressionHeader.h"
+#include "Framework/RuntimeError.h"
+#include "Headers/DataHeader.h"
+#include "Headers/Stack.h"
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <vector>
+
+using namespace o2::framework;
+using DataHeader = o2::header::DataHeader;
+
+BOOST_AUTO_TEST_CASE(TestCompressionRoundTrip)
+{
+  for (auto algorithm : {ChannelCompression::LZ4, ChannelCompression::ZSTD}) {
+    // Bigger than a single block, so that we check they are chained correctly.
+    std::vector<char> payload(40000000);
+    for (size_t i = 0; i < payload.size(); ++i) {
+      payload[i] = (i / 1000) % 7;
+    }
+    std::vector<char> compressed(payload.size());
+    auto size = MessageCompressionHelpers::compress(algorithm, payload.data(), payload.size(), compressed.data(), compressed.size());
+    BOOST_REQUIRE(size > 0);
+    BOOST_CHECK(size < payload.size() / 10);
+    std::vector<char> uncompressed(payload.size());
+    MessageCompressionHelpers::decompress(compressed.data(), size, uncompressed.data(), uncompressed.size());
+    BOOST_CHECK(uncompressed == payload);
+
+    // The original size must be the right one.
+    std::vector<char> tooSmall(payload.size() - 1);
+    BOOST_CHECK_THROW(MessageCompressionHelpers::decompress(compressed.data(), size, tooSmall.data(), tooSmall.size()), RuntimeErrorRef);
+    BOOST_CHECK_THROW(MessageCompressionHelpers::decompress(compressed.data(), size / 2, uncompressed.data(), uncompressed.size()), RuntimeErrorRef);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestCompressionIncompressible)
+{
+  std::mt19937 gen(42);
+  std::vector<char> payload(MessageCompressionHelpers::MinimumSize);
+  for (auto& c : payload) {
+    c = gen();
+  }
+  std::vector<char> compressed(payload.size());
+  BOOST_CHECK_EQUAL(MessageCompressionHelpers::compress(ChannelCompression::LZ4, payload.data(), payload.size(), compressed.data(), compressed.size()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestStripCompressionHeader)
+{
+  DataHeader dh{"CLUSTERS", "TPC", 1, 100};
+  DataProcessingHeader dph{1, 0};
+  PayloadCompressionHeader ch{static_cast<uint32_t>(ChannelCompression::LZ4), 1000};
+  o2::header::Stack stack{dh, ch, dph};
+  auto* data = reinterpret_cast<std::byte const*>(stack.data());
+  BOOST_REQUIRE(o2::header::get<PayloadCompressionHeader*>(data));
+
+  auto size = MessageCompressionHelpers::strippedSize(data);
+  BOOST_CHECK_EQUAL(size, stack.size() - sizeof(PayloadCompressionHeader));
+  std::vector<std::byte> stripped(size);
+  MessageCompressionHelpers::strip(data, stripped.data());
+  BOOST_CHECK(o2::header::get<PayloadCompressionHeader*>(stripped.data()) == nullptr);
+  auto* sdh = o2::header::get<DataHeader*>(stripped.data());
+  BOOST_REQUIRE(sdh);
+  BOOST_CHECK_EQUAL(sdh->subSpecification, 1);
+  auto* sdph = o2::header::get<DataProcessingHeader*>(stripped.data());
+  BOOST_REQUIRE(sdph);
+  BOOST_CHECK_EQUAL(sdph->startTime, 1);
+  BOOST_CHECK(sdph->flagsNextHeader == false);
+}
@@ -185,6 +185,40 @@ BOOST_AUTO_TEST_CASE(TestTableBuilderBulk)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TestTableBuilderBulkFill)
+{
+  using namespace o2::framework;
+  TableBuilder builder;
+  auto filler = builder.bulkFill<int, float, bool>({"x", "y", "b"}, 4);
+  // two batches, the second one larger than the initial reservation
+  for (int batch = 0; batch < 2; ++batch) {
+    auto [x, y, b] = filler.reserve(8);
+    BOOST_REQUIRE_EQUAL(x.size(), 8);
+    for (int i = 0; i < 3 + batch * 5; ++i) {
+      x[i] = batch * 3 + i;
+      y[i] = 0.5f * (batch * 3 + i);
+      b[i] = (batch * 3 + i) % 2;
+    }
+    filler.commit(3 + batch * 5);
+  }
+
+  auto table = builder.finalize();
+  BOOST_REQUIRE_EQUAL(table->num_columns(), 3);
+  BOOST_REQUIRE_EQUAL(table->num_rows(), 11);
+  BOOST_REQUIRE_EQUAL(table->schema()->field(0)->type()->id(), arrow::int32()->id());
+  BOOST_REQUIRE_EQUAL(table->schema()->field(1)->type()->id(), arrow::float32()->id());
+  BOOST_REQUIRE_EQUAL(table->schema()->field(2)->type()->id(), arrow::boolean()->id());
+
+  auto px = std::dynamic_pointer_cast<arrow::NumericArray<arrow::Int32Type>>(table->column(0)->chunk(0));
+  auto py = std::dynamic_pointer_cast<arrow::NumericArray<arrow::FloatType>>(table->column(1)->chunk(0));
+  auto pb = std::dynamic_pointer_cast<arrow::BooleanArray>(table->column(2)->chunk(0));
+  for (int i = 0; i < 11; ++i) {
+    BOOST_CHECK_EQUAL(px->Value(i), i);
+    BOOST_CHECK_EQUAL(py->Value(i), 0.5f * i);
+    BOOST_CHECK_EQUAL(pb->Value(i), i % 2 == 1);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(TestTableBuilderMore)
 {
   using namespace o2::framework;
@@ -0,0 +1,78 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework TimesliceTraceHelpers
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/TimesliceTraceHelpers.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestTimesliceTraceRoundTrip)
+{
+  TimesliceTraceHop hop;
+  hop.timeslice = 42;
+  hop.origin = 1000;
+  hop.hops = 2;
+  hop.firstInput = 1100;
+  hop.lastInput = 1200;
+  hop.start = 1300;
+  hop.end = 1500;
+  hop.sent = 1550;
+  auto line = TimesliceTraceHelpers::formatTrace(hop);
+  BOOST_CHECK_EQUAL(line, "[TRACE] 42 1000 2 1100 1200 1300 1500 1550");
+
+  TimesliceTraceHop parsed;
+  BOOST_REQUIRE(TimesliceTraceHelpers::parseTrace(line, parsed));
+  BOOST_CHECK_EQUAL(parsed.timeslice, 42);
+  BOOST_CHECK_EQUAL(parsed.origin, 1000);
+  BOOST_CHECK_EQUAL(parsed.hops, 2);
+  BOOST_CHECK_EQUAL(parsed.firstInput, 1100);
+  BOOST_CHECK_EQUAL(parsed.lastInput, 1200);
+  BOOST_CHECK_EQUAL(parsed.start, 1300);
+  BOOST_CHECK_EQUAL(parsed.end, 1500);
+  BOOST_CHECK_EQUAL(parsed.sent, 1550);
+
+  // What the text driver client sends goes via the logger.
+  TimesliceTraceHop logged;
+  BOOST_REQUIRE(TimesliceTraceHelpers::parseTrace("[13:22:01][INFO] " + line, logged));
+  BOOST_CHECK_EQUAL(logged.sent, 1550);
+
+  TimesliceTraceHop invalid;
+  BOOST_CHECK(TimesliceTraceHelpers::parseTrace("[METRIC] akey,0 12 1789372894 hostname=test.cern.ch", invalid) == false);
+  BOOST_CHECK(TimesliceTraceHelpers::parseTrace("[TRACE] 42 1000 2 1100", invalid) == false);
+  BOOST_CHECK(TimesliceTraceHelpers::parseTrace("[TRACE] 42 1000 2 1100 1200 1300 1500 15a0", invalid) == false);
+}
+
+BOOST_AUTO_TEST_CASE(TestTimesliceTraceSampling)
+{
+  BOOST_CHECK(TimesliceTraceHelpers::isTraced(0, 0) == false);
+  BOOST_CHECK(TimesliceTraceHelpers::isTraced(1, 7));
+  BOOST_CHECK(TimesliceTraceHelpers::isTraced(10, 20));
+  BOOST_CHECK(TimesliceTraceHelpers::isTraced(10, 21) == false);
+}
+
+BOOST_AUTO_TEST_CASE(TestTimesliceTraceChromeExport)
+{
+  std::vector<TimesliceTraceHop> hops(2);
+  hops[0] = {0, 10, 1000, 0, 1000, 1000, 1010, 1100, 1105};
+  hops[1] = {1, 10, 1000, 1, 1110, 1120, 1130, 1300, 1310};
+  std::ostringstream out;
+  TimesliceTraceHelpers::dumpChromeTrace(out, hops, {"reader", "processor \"A\""});
+  auto trace = out.str();
+  BOOST_CHECK(trace.find(R"("name":"thread_name","ph":"M","pid":0,"tid":1,"args":{"name":"processor \"A\""})") != std::string::npos);
+  BOOST_CHECK(trace.find(R"("name":"compute","cat":"timeslice","ph":"X","ts":130,"dur":170,"pid":0,"tid":1)") != std::string::npos);
+  BOOST_CHECK(trace.find(R"("name":"queued","cat":"timeslice","ph":"X","ts":120,"dur":10,"pid":0,"tid":1)") != std::string::npos);
+  BOOST_CHECK(trace.find(R"("name":"timeslice 10","cat":"latency","ph":"b","id":10,"ts":0)") != std::string::npos);
+  BOOST_CHECK(trace.find(R"("args":{"latency_us":310})") != std::string::npos);
+}
@@ -49,6 +49,8 @@ struct MultiplotData {
   MetricType type;
   const char* legend = nullptr;
   int axis = 0;
+  MetricRollups const* rollups = nullptr; // down-sampled history, used when the raw values do not cover the plot
+  size_t oldestTimestamp = 0;             // timestamp of the oldest raw value
 };
 
 } // namespace o2::framework::gui
@@ -164,6 +166,68 @@ struct HistoData {
   char const* legend = nullptr;
 };
 
+/// Rollup bins of a metric to plot, at the resolution selected for the visible time window
+struct RollupPlotData {
+  MetricRollups const* rollups = nullptr;
+  size_t level = 0;
+};
+
+ImPlotPoint rollupGetter(void* hData, int idx)
+{
+  auto rollupData = reinterpret_cast<RollupPlotData*>(hData);
+  auto width = MetricRollups::BIN_WIDTHS[rollupData->level];
+  auto const& bin = rollupData->rollups->bin(rollupData->level, idx);
+  return ImPlotPoint(double(bin.index) * width + width / 2, bin.avg);
+}
+
+/// @return the timestamp of the oldest raw value of a metric, 0 if there is none
+size_t oldestRawTimestamp(DeviceMetricsInfo const& info, size_t metricIndex)
+{
+  auto const& timestamps = info.timestamps[metricIndex];
+  auto const& metric = info.metrics[metricIndex];
+  size_t filled = std::min(metric.filledMetrics, timestamps.size());
+  return filled ? timestamps[(metric.pos % timestamps.size() + timestamps.size() - filled) % timestamps.size()] : 0;
+}
+
+/// @return the rollup level to draw a metric in the visible time window [xMin, xMax] (ms), -1 to draw
+/// the raw values, if they go back far enough. Otherwise the finest level which covers the window
+/// without too many bins in it is used or, if none does, the one with the longest history.
+int selectRollupLevel(MetricRollups const& rollups, size_t oldestTimestamp, double xMin, double xMax)
+{
+  constexpr double MAX_BINS_IN_WINDOW = 1000;
+  if (oldestTimestamp <= xMin || rollups.availableBins(0) == 0) {
+    return -1;
+  }
+  for (size_t level = 0; level < MetricRollups::LEVELS; ++level) {
+    if (rollups.firstTimestamp(level) <= xMin && (xMax - xMin) / MetricRollups::BIN_WIDTHS[level] <= MAX_BINS_IN_WINDOW) {
+      return level;
+    }
+  }
+  return MetricRollups::LEVELS - 1;
+}
+
+/// What to plot for a metric in the current plot
+struct PlotSeries {
+  ImPlotPoint (*getter)(void*, int);
+  void* data;
+  int count;
+};
+
+/// Selects the raw values of a metric or its rollups at the resolution matching the visible
+/// time window of the current plot, so that only the points needed are drawn.
+PlotSeries selectSeries(MultiplotData* data, ImPlotPoint (*rawGetter)(void*, int), RollupPlotData& rollupData)
+{
+  if (data->rollups && data->type != MetricType::String) {
+    auto limits = ImPlot::GetPlotLimits();
+    int level = selectRollupLevel(*data->rollups, data->oldestTimestamp, limits.X.Min, limits.X.Max);
+    if (level >= 0) {
+      rollupData = RollupPlotData{data->rollups, size_t(level)};
+      return PlotSeries{rollupGetter, &rollupData, int(data->rollups->availableBins(level))};
+    }
+  }
+  return PlotSeries{rawGetter, data, int(data->size)};
+}
+
 enum struct MetricsDisplayStyle : int {
   Lines = 0,
   Histos = 1,
@@ -252,6 +316,18 @@ void displaySparks(
     }
     if (ImPlot::BeginPlot("##sparks", "time", "value", ImVec2(700, 100), 0, rtx_axis, rty_axis)) {
       ImPlot::SetPlotYAxis(state.axis);
+      auto limits = ImPlot::GetPlotLimits();
+      int level = -1;
+      if (index.metricIndex < metricsInfo.rollups.size() && metric.type != MetricType::String) {
+        level = selectRollupLevel(metricsInfo.rollups[index.metricIndex], oldestRawTimestamp(metricsInfo, index.metricIndex), limits.X.Min, limits.X.Max);
+      }
+      if (level >= 0) {
+        RollupPlotData rollupData{&metricsInfo.rollups[index.metricIndex], size_t(level)};
+        ImPlot::PlotLineG("##plot", rollupGetter, &rollupData, rollupData.rollups->availableBins(level), 0);
+        ImPlot::EndPlot();
+        ImGui::PopID();
+        continue;
+      }
       switch (metric.type) {
         case MetricType::Int: {
           data.points = (void*)metricsInfo.intMetrics[metric.storeIdx].data();
@@ -340,6 +416,10 @@ void displayDeviceMetrics(const char* label,
         data.legend = state[gmi].legend.c_str();
         data.type = metric.type;
         data.axis = state[gmi].axis;
+        if (mi < metricsInfos[di].rollups.size()) {
+          data.rollups = &metricsInfos[di].rollups[mi];
+          data.oldestTimestamp = oldestRawTimestamp(metricsInfos[di], mi);
+        }
         minValue[data.axis] = std::min(minValue[data.axis], metricsInfos[di].min[mi]);
         maxValue[data.axis] = std::max(maxValue[data.axis], metricsInfos[di].max[mi]);
         minDomain = std::min(minDomain, metricsInfos[di].minDomain[mi]);
@@ -385,6 +465,7 @@ void displayDeviceMetrics(const char* label,
   for (size_t ui = 0; ui < userData.size(); ++ui) {
     metricsToDisplay.push_back(&(userData[ui]));
   }
+  std::vector<RollupPlotData> rollupData(userData.size());
 
   auto getterXY = [](void* hData, int idx) -> ImPlotPoint {
     auto histoData = reinterpret_cast<const MultiplotData*>(hData);
@@ -423,7 +504,8 @@ void displayDeviceMetrics(const char* label,
           ImGui::PushID(pi);
           auto data = (const MultiplotData*)metricsToDisplay[pi];
           const char* label = ((MultiplotData*)metricsToDisplay[pi])->legend;
-          ImPlot::PlotBarsG(label, getterXY, metricsToDisplay[pi], data->size, 1, 0);
+          auto series = selectSeries((MultiplotData*)metricsToDisplay[pi], getterXY, rollupData[pi]);
+          ImPlot::PlotBarsG(label, series.getter, series.data, series.count, 1, 0);
           ImGui::PopID();
         }
         ImPlot::EndPlot();
@@ -440,7 +522,8 @@ void displayDeviceMetrics(const char* label,
           auto data = (const MultiplotData*)metricsToDisplay[pi];
           const char* label = data->legend;
           ImPlot::SetPlotYAxis(data->axis);
-          ImPlot::PlotLineG(data->legend, getterXY, metricsToDisplay[pi], data->size, 0);
+          auto series = selectSeries((MultiplotData*)metricsToDisplay[pi], getterXY, rollupData[pi]);
+          ImPlot::PlotLineG(data->legend, series.getter, series.data, series.count, 0);
           ImGui::PopID();
         }
         ImPlot::EndPlot();
@@ -453,7 +536,8 @@ void displayDeviceMetrics(const char* label,
           // FIXME: display a message for other metrics
           if (data->type == MetricType::Uint64) {
             ImGui::PushID(pi);
-            ImPlot::PlotScatterG(((MultiplotData*)metricsToDisplay[pi])->legend, getterXY, metricsToDisplay[pi], data->size, 0);
+            auto series = selectSeries((MultiplotData*)metricsToDisplay[pi], getterXY, rollupData[pi]);
+            ImPlot::PlotScatterG(((MultiplotData*)metricsToDisplay[pi])->legend, series.getter, series.data, series.count, 0);
             ImGui::PopID();
           }
         }
@@ -25,7 +25,7 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
   workflowOptions.push_back(
     ConfigParamSpec{"3-layer-pipelining", VariantType::Int, 1, {timeHelp}});
 
-  std::string inputHelp("Type of input to be used: readout / stfb");
+  std::string inputHelp("Type of input to be used: readout / readout-links / stfb");
   workflowOptions.push_back(
     ConfigParamSpec{"input-type", VariantType::String, "readout", {inputHelp}});
 }
@@ -47,7 +47,7 @@ using DataHeader = o2::header::DataHeader;
 DataProcessorSpec templateProcessor(std::string const& inputType)
 {
   std::vector<InputSpec> inputs;
-  if (inputType == "readout") {
+  if (inputType == "readout" || inputType == "readout-links") {
     inputs.emplace_back("x", ConcreteDataTypeMatcher{"ITS", "RAWDATA"}, Lifetime::Timeframe);
   } else {
     inputs.emplace_back("x", ConcreteDataTypeMatcher{"FLP", "RAWDATA"}, Lifetime::Timeframe);
@@ -91,8 +91,8 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
   size_t jobs = config.options().get<int>("2-layer-jobs");
   size_t stages = config.options().get<int>("3-layer-pipelining");
   std::string inputType = config.options().get<std::string>("input-type");
-  if (inputType != "readout" && inputType != "stfb") {
-    throw std::runtime_error("Unknown input type " + inputType + ". Available options are `readout' and `stfb'.");
+  if (inputType != "readout" && inputType != "readout-links" && inputType != "stfb") {
+    throw std::runtime_error("Unknown input type " + inputType + ". Available options are `readout', `readout-links' and `stfb'.");
   }
 
   /// The proxy is the component which is responsible to connect to readout and
@@ -109,6 +109,9 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
     // we keep the hardcoded value of ITS RAWDATA as it was before
     // note that this will translate into ConcreteDataMatcher with subspec 0
     readoutProxyOutput.emplace_back("ITS", "RAWDATA");
+  } else if (inputType == "readout-links") {
+    // the superpages are split per link, using the FEE id as subspec
+    readoutProxyOutput.emplace_back(ConcreteDataTypeMatcher{"ITS", "RAWDATA"});
   } else {
     // need one output per job in the 2nd level, but use subSpec-agnostic matcher
     // if there is only one job
@@ -125,7 +128,9 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
     "readout-proxy",
     std::move(readoutProxyOutput),
     "type=pair,method=connect,address=ipc:///tmp/readout-pipe-0,rateLogging=1,transport=shmem",
-    inputType == "readout" ? readoutAdapter({"ITS", "RAWDATA"}) : dplModelAdaptor({ConcreteDataTypeMatcher{"FLP", "RAWDATA"}, {"FLP", "DISTSUBTIMEFRAME", 0}}));
+    inputType == "readout"         ? readoutAdapter({"ITS", "RAWDATA"})
+    : inputType == "readout-links" ? readoutLinkAdapter(OutputSpec{ConcreteDataTypeMatcher{"ITS", "RAWDATA"}})
+                                   : dplModelAdaptor({ConcreteDataTypeMatcher{"FLP", "RAWDATA"}, {"FLP", "DISTSUBTIMEFRAME", 0}}));
 
   // This is an example of how we can parallelize by subSpec.
   // templatedProcessor will be instanciated N times and the lambda function
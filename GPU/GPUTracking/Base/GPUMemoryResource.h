@@ -79,7 +79,7 @@ class GPUMemoryResource
                         ALLOCATION_GLOBAL = 2 };
 
 #ifndef GPUCA_GPUCODE
-  GPUMemoryResource(GPUProcessor* proc, void* (GPUProcessor::*setPtr)(void*), MemoryType type, const char* name = "") : mProcessor(proc), mPtr(nullptr), mPtrDevice(nullptr), mSetPointers(setPtr), mName(name), mSize(0), mOverrideSize(0), mReuse(-1), mType(type)
+  GPUMemoryResource(GPUProcessor* proc, void* (GPUProcessor::*setPtr)(void*), MemoryType type, const char* name = "") : mProcessor(proc), mPtr(nullptr), mPtrDevice(nullptr), mSetPointers(setPtr), mName(name), mSize(0), mOverrideSize(0), mReuse(-1), mType(type), mPtrKept(nullptr), mSizeKept(0), mKeepAllocation(false)
   {
   }
   GPUMemoryResource(const GPUMemoryResource&) CON_DEFAULT;
@@ -106,6 +106,9 @@ class GPUMemoryResource
   size_t mOverrideSize;
   int mReuse;
   MemoryType mType;
+  void* mPtrKept;       // individual allocation kept between events, reused while it is large enough
+  size_t mSizeKept;
+  bool mKeepAllocation;
 };
 } // namespace gpu
 } // namespace GPUCA_NAMESPACE
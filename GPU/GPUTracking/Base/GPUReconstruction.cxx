@@ -418,8 +418,8 @@ int GPUReconstruction::Exit()
       if (mMemoryResources[i].mReuse >= 0) {
         continue;
       }
-      operator delete(mMemoryResources[i].mPtrDevice GPUCA_OPERATOR_NEW_ALIGNMENT);
-      mMemoryResources[i].mPtr = mMemoryResources[i].mPtrDevice = nullptr;
+      operator delete((mMemoryResources[i].mKeepAllocation ? mMemoryResources[i].mPtrKept : mMemoryResources[i].mPtrDevice) GPUCA_OPERATOR_NEW_ALIGNMENT);
+      mMemoryResources[i].mPtr = mMemoryResources[i].mPtrDevice = mMemoryResources[i].mPtrKept = nullptr;
     }
   }
   mMemoryResources.clear();
@@ -546,7 +546,7 @@ void GPUReconstruction::AllocateRegisteredMemoryInternal(GPUMemoryResource* res,
   if (mProcessingSettings.memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_INDIVIDUAL && (control == nullptr || control->useInternal())) {
     if (!(res->mType & GPUMemoryResource::MEMORY_EXTERNAL)) {
       if (res->mPtrDevice && res->mReuse < 0) {
-        operator delete(res->mPtrDevice GPUCA_OPERATOR_NEW_ALIGNMENT);
+        FreeIndividualAllocation(res);
       }
       res->mSize = std::max((size_t)res->SetPointers((void*)1) - 1, res->mOverrideSize);
       if (res->mReuse >= 0) {
@@ -555,8 +555,17 @@ void GPUReconstruction::AllocateRegisteredMemoryInternal(GPUMemoryResource* res,
           throw std::bad_alloc();
         }
         res->mPtrDevice = mMemoryResources[res->mReuse].mPtrDevice;
+      } else if (res->mKeepAllocation && res->mSizeKept >= res->mSize) {
+        res->mPtrDevice = res->mPtrKept;
       } else {
+        if (res->mKeepAllocation) {
+          operator delete(res->mPtrKept GPUCA_OPERATOR_NEW_ALIGNMENT);
+        }
         res->mPtrDevice = operator new(res->mSize + GPUCA_BUFFER_ALIGNMENT GPUCA_OPERATOR_NEW_ALIGNMENT);
+        if (res->mKeepAllocation) {
+          res->mPtrKept = res->mPtrDevice;
+          res->mSizeKept = res->mSize;
+        }
       }
       res->mPtr = GPUProcessor::alignPointer<GPUCA_BUFFER_ALIGNMENT>(res->mPtrDevice);
       res->SetPointers(res->mPtr);
@@ -733,12 +742,19 @@ void GPUReconstruction::FreeRegisteredMemory(GPUMemoryResource* res)
     std::cout << "Freeing " << res->mName << ": size " << res->mSize << " (reused " << res->mReuse << ")\n";
   }
   if (mProcessingSettings.memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_INDIVIDUAL && res->mReuse < 0) {
-    operator delete(res->mPtrDevice GPUCA_OPERATOR_NEW_ALIGNMENT);
+    FreeIndividualAllocation(res);
   }
   res->mPtr = nullptr;
   res->mPtrDevice = nullptr;
 }
 
+void GPUReconstruction::FreeIndividualAllocation(GPUMemoryResource* res)
+{
+  if (!res->mKeepAllocation) { // Kept allocations are released in Exit, or when they must grow
+    operator delete(res->mPtrDevice GPUCA_OPERATOR_NEW_ALIGNMENT);
+  }
+}
+
 void GPUReconstruction::ReturnVolatileDeviceMemory()
 {
   if (mVolatileMemoryStart) {
@@ -779,7 +795,7 @@ void GPUReconstruction::PopNonPersistentMemory(RecoStep step, unsigned long tag)
   for (unsigned int i = std::get<2>(mNonPersistentMemoryStack.back()); i < mNonPersistentIndividualAllocations.size(); i++) {
     GPUMemoryResource* res = mNonPersistentIndividualAllocations[i];
     if (res->mReuse < 0) {
-      operator delete(res->mPtrDevice GPUCA_OPERATOR_NEW_ALIGNMENT);
+      FreeIndividualAllocation(res);
     }
     res->mPtr = nullptr;
     res->mPtrDevice = nullptr;
@@ -813,6 +829,11 @@ void GPUReconstruction::SetMemoryExternalInput(short res, void* ptr)
   mMemoryResources[res].mPtr = ptr;
 }
 
+void GPUReconstruction::SetMemoryKeepAllocation(short res)
+{
+  mMemoryResources[res].mKeepAllocation = mProcessingSettings.memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_INDIVIDUAL;
+}
+
 void GPUReconstruction::ClearAllocatedMemory(bool clearOutputs)
 {
   for (unsigned int i = 0; i < mMemoryResources.size(); i++) {
@@ -836,6 +857,12 @@ void GPUReconstruction::UpdateMaxMemoryUsed()
   mDeviceMemoryUsedMax = std::max<size_t>(mDeviceMemoryUsedMax, ptrDiff(mDeviceMemoryPool, mDeviceMemoryBase) + ptrDiff((char*)mDeviceMemoryBase + mDeviceMemorySize, mDeviceMemoryPoolEnd));
 }
 
+void GPUReconstruction::WriteTimingsCSVHeader(FILE* fp)
+{
+  // event: event counter, category: task / step / dma / general / total / memory, type: K (kernel) / C (CPU) for tasks, time in us per event, bytes per event
+  fprintf(fp, "event,category,type,name,count,time_us,bytes\n");
+}
+
 void GPUReconstruction::PrintMemoryMax()
 {
   printf("Maximum Memory Allocation: Host %'lld / Device %'lld\n", (long long int)mHostMemoryUsedMax, (long long int)mDeviceMemoryUsedMax);
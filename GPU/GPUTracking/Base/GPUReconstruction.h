@@ -218,6 +218,7 @@ class GPUReconstruction
   void PrintMemoryOverview();
   void PrintMemoryMax();
   void SetMemoryExternalInput(short res, void* ptr);
+  void SetMemoryKeepAllocation(short res);
   GPUMemorySizeScalers* MemoryScalers() { return mMemoryScalers.get(); }
 
   // Helpers to fetch processors from other shared libraries
@@ -266,10 +267,13 @@ class GPUReconstruction
   virtual void PrintKernelOccupancies() {}
   double GetStatKernelTime() { return mStatKernelTime; }
   double GetStatWallTime() { return mStatWallTime; }
+  void SetTimingsCSVOutput(FILE* fp) { mTimingsCSVOutput = fp; } // Write the timings of each event also in CSV format to fp (requires debugLevel >= 1), see WriteTimingsCSVHeader
+  static void WriteTimingsCSVHeader(FILE* fp);
 
  protected:
   void AllocateRegisteredMemoryInternal(GPUMemoryResource* res, GPUOutputControl* control, GPUReconstruction* recPool);
   void FreeRegisteredMemory(GPUMemoryResource* res);
+  void FreeIndividualAllocation(GPUMemoryResource* res);
   GPUReconstruction(const GPUSettingsDeviceBackend& cfg); // Constructor
   int InitPhaseBeforeDevice();
   virtual void UpdateSettings() {}
@@ -368,6 +372,7 @@ class GPUReconstruction
   unsigned int mNEventsProcessed = 0;
   double mStatKernelTime = 0.;
   double mStatWallTime = 0.;
+  FILE* mTimingsCSVOutput = nullptr; // Machine readable output of the timings, not owned
   std::shared_ptr<GPUROOTDumpCore> mROOTDump;
 
   int mMaxThreads = 0;    // Maximum number of threads that may be running, on CPU or GPU
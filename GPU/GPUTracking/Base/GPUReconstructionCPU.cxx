@@ -221,6 +221,11 @@ int GPUReconstructionCPU::RunChains()
   if (GetProcessingSettings().debugLevel >= 1) {
     double kernelTotal = 0;
     std::vector<double> kernelStepTimes(GPUDataTypes::N_RECO_STEPS);
+    auto writeCSV = [this](const char* category, char type, const char* name, unsigned int count, double timeUs, size_t bytes) {
+      if (mTimingsCSVOutput) {
+        fprintf(mTimingsCSVOutput, "%u,%s,%c,\"%s\",%u,%.1f,%lu\n", mNEventsProcessed, category, type, name, count, timeUs, (unsigned long)bytes);
+      }
+    };
 
     for (unsigned int i = 0; i < mTimers.size(); i++) {
       double time = 0;
@@ -247,6 +252,7 @@ int GPUReconstructionCPU::RunChains()
         snprintf(bandwidth, 256, " (%6.3f GB/s - %'14lu bytes)", mTimers[i]->memSize / time * 1e-9, (unsigned long)(mTimers[i]->memSize / mStatNEvents));
       }
       printf("Execution Time: Task (%c %8ux): %50s Time: %'10d us%s\n", type, mTimers[i]->count, mTimers[i]->name.c_str(), (int)(time * 1000000 / mStatNEvents), bandwidth);
+      writeCSV("task", type, mTimers[i]->name.c_str(), mTimers[i]->count, time * 1000000 / mStatNEvents, mStatNEvents ? mTimers[i]->memSize / mStatNEvents : 0);
       if (mProcessingSettings.resetTimers) {
         mTimers[i]->count = 0;
         mTimers[i]->memSize = 0;
@@ -255,14 +261,18 @@ int GPUReconstructionCPU::RunChains()
     for (int i = 0; i < GPUDataTypes::N_RECO_STEPS; i++) {
       if (kernelStepTimes[i] != 0. || mTimersRecoSteps[i].timerTotal.GetElapsedTime() != 0.) {
         printf("Execution Time: Step              : %11s %38s Time: %'10d us ( Total Time : %'14d us)\n", "Tasks", GPUDataTypes::RECO_STEP_NAMES[i], (int)(kernelStepTimes[i] * 1000000 / mStatNEvents), (int)(mTimersRecoSteps[i].timerTotal.GetElapsedTime() * 1000000 / mStatNEvents));
+        writeCSV("step", 'K', GPUDataTypes::RECO_STEP_NAMES[i], 1, kernelStepTimes[i] * 1000000 / mStatNEvents, 0);
+        writeCSV("step", 'T', GPUDataTypes::RECO_STEP_NAMES[i], 1, mTimersRecoSteps[i].timerTotal.GetElapsedTime() * 1000000 / mStatNEvents, 0);
       }
       if (mTimersRecoSteps[i].bytesToGPU) {
         printf("Execution Time: Step (D %8ux): %11s %38s Time: %'10d us (%6.3f GB/s - %'14lu bytes - %'14lu per call)\n", mTimersRecoSteps[i].countToGPU, "DMA to GPU", GPUDataTypes::RECO_STEP_NAMES[i], (int)(mTimersRecoSteps[i].timerToGPU.GetElapsedTime() * 1000000 / mStatNEvents),
                mTimersRecoSteps[i].bytesToGPU / mTimersRecoSteps[i].timerToGPU.GetElapsedTime() * 1e-9, mTimersRecoSteps[i].bytesToGPU / mStatNEvents, mTimersRecoSteps[i].bytesToGPU / mTimersRecoSteps[i].countToGPU);
+        writeCSV("dma", 'G', GPUDataTypes::RECO_STEP_NAMES[i], mTimersRecoSteps[i].countToGPU, mTimersRecoSteps[i].timerToGPU.GetElapsedTime() * 1000000 / mStatNEvents, mTimersRecoSteps[i].bytesToGPU / mStatNEvents);
       }
       if (mTimersRecoSteps[i].bytesToHost) {
         printf("Execution Time: Step (D %8ux): %11s %38s Time: %'10d us (%6.3f GB/s - %'14lu bytes - %'14lu per call)\n", mTimersRecoSteps[i].countToHost, "DMA to Host", GPUDataTypes::RECO_STEP_NAMES[i], (int)(mTimersRecoSteps[i].timerToHost.GetElapsedTime() * 1000000 / mStatNEvents),
                mTimersRecoSteps[i].bytesToHost / mTimersRecoSteps[i].timerToHost.GetElapsedTime() * 1e-9, mTimersRecoSteps[i].bytesToHost / mStatNEvents, mTimersRecoSteps[i].bytesToHost / mTimersRecoSteps[i].countToHost);
+        writeCSV("dma", 'H', GPUDataTypes::RECO_STEP_NAMES[i], mTimersRecoSteps[i].countToHost, mTimersRecoSteps[i].timerToHost.GetElapsedTime() * 1000000 / mStatNEvents, mTimersRecoSteps[i].bytesToHost / mStatNEvents);
       }
       if (mProcessingSettings.resetTimers) {
         mTimersRecoSteps[i].bytesToGPU = mTimersRecoSteps[i].bytesToHost = 0;
@@ -276,11 +286,19 @@ int GPUReconstructionCPU::RunChains()
     for (int i = 0; i < GPUDataTypes::N_GENERAL_STEPS; i++) {
       if (mTimersGeneralSteps[i].GetElapsedTime() != 0.) {
         printf("Execution Time: General Step      : %50s Time: %'10d us\n", GPUDataTypes::GENERAL_STEP_NAMES[i], (int)(mTimersGeneralSteps[i].GetElapsedTime() * 1000000 / mStatNEvents));
+        writeCSV("general", 'C', GPUDataTypes::GENERAL_STEP_NAMES[i], 1, mTimersGeneralSteps[i].GetElapsedTime() * 1000000 / mStatNEvents, 0);
       }
     }
     mStatKernelTime = kernelTotal * 1000000 / mStatNEvents;
     printf("Execution Time: Total   : %50s Time: %'10d us\n", "Total Kernel", (int)mStatKernelTime);
     printf("Execution Time: Total   : %50s Time: %'10d us\n", "Total Wall", (int)mStatWallTime);
+    writeCSV("total", 'K', "Total Kernel", 1, mStatKernelTime, 0);
+    writeCSV("total", 'W', "Total Wall", 1, mStatWallTime, 0);
+    writeCSV("memory", 'H', "Host Memory Used Max", 1, 0., mHostMemoryUsedMax);
+    writeCSV("memory", 'D', "Device Memory Used Max", 1, 0., mDeviceMemoryUsedMax);
+    if (mTimingsCSVOutput) {
+      fflush(mTimingsCSVOutput);
+    }
   } else if (GetProcessingSettings().debugLevel >= 0) {
     GPUInfo("Total Wall Time: %d us", (int)mStatWallTime);
   }
@@ -179,7 +179,18 @@ void GPUReconstructionConvert::ZSstreamOut(unsigned short* bufIn, unsigned int&
 {
   unsigned int byte = 0, bits = 0;
   unsigned int mask = (1 << nBits) - 1;
-  for (unsigned int i = 0; i < lenIn; i++) {
+  unsigned int i = 0;
+  if (nBits <= 16 && (nBits & 1) == 0) {
+    // Groups of 4 values fill exactly nBits / 2 bytes, pack them at once (10 bit: 5 bytes, 12 bit: 6 bytes)
+    const unsigned int nBytes = nBits / 2;
+    for (; i + 4 <= lenIn; i += 4) {
+      const unsigned long long int group = (unsigned long long int)(bufIn[i] & mask) | ((unsigned long long int)(bufIn[i + 1] & mask) << nBits) | ((unsigned long long int)(bufIn[i + 2] & mask) << (2 * nBits)) | ((unsigned long long int)(bufIn[i + 3] & mask) << (3 * nBits));
+      for (unsigned int j = 0; j < nBytes; j++) {
+        bufOut[lenOut++] = (unsigned char)(group >> (8 * j));
+      }
+    }
+  }
+  for (; i < lenIn; i++) {
     byte |= (bufIn[i] & mask) << bits;
     bits += nBits;
     while (bits >= 8) {
@@ -260,22 +271,23 @@ void GPUReconstructionConvert::RunZSEncoder(const S& in, std::unique_ptr<unsigne
     } else {
       std::copy(ZSEncoderGetDigits(in, i), ZSEncoderGetDigits(in, i) + ZSEncoderGetNDigits(in, i), tmpBuffer.begin());
     }
-    std::sort(tmpBuffer.begin(), tmpBuffer.end(), [&param](const T a, const T b) {
-      int endpointa = param.tpcGeometry.GetRegion(ZSEncoderGetRow(a));
-      int endpointb = param.tpcGeometry.GetRegion(ZSEncoderGetRow(b));
-      endpointa = 2 * endpointa + (ZSEncoderGetRow(a) >= param.tpcGeometry.GetRegionStart(endpointa) + param.tpcGeometry.GetRegionRows(endpointa) / 2);
-      endpointb = 2 * endpointb + (ZSEncoderGetRow(b) >= param.tpcGeometry.GetRegionStart(endpointb) + param.tpcGeometry.GetRegionRows(endpointb) / 2);
-      if (endpointa != endpointb) {
-        return endpointa <= endpointb;
+    {
+      // Sort by endpoint, time, row and pad, packed into a single 64 bit key per digit
+      std::vector<std::pair<unsigned long long int, unsigned int>> sortKeys(tmpBuffer.size());
+      for (unsigned int k = 0; k < tmpBuffer.size(); k++) {
+        const int row = ZSEncoderGetRow(tmpBuffer[k]);
+        const int region = param.tpcGeometry.GetRegion(row);
+        const unsigned long long int endpoint = 2 * region + (row >= param.tpcGeometry.GetRegionStart(region) + param.tpcGeometry.GetRegionRows(region) / 2);
+        const unsigned long long int time = (unsigned int)ZSEncoderGetTime(tmpBuffer[k]) ^ 0x80000000u; // Keep negative time bins in front
+        sortKeys[k] = {(endpoint << 48) | (time << 16) | ((unsigned long long int)row << 8) | (unsigned long long int)ZSEncoderGetPad(tmpBuffer[k]), k};
       }
-      if (ZSEncoderGetTime(a) != ZSEncoderGetTime(b)) {
-        return ZSEncoderGetTime(a) <= ZSEncoderGetTime(b);
+      std::sort(sortKeys.begin(), sortKeys.end());
+      std::vector<T> sortedBuffer(tmpBuffer.size());
+      for (unsigned int k = 0; k < sortKeys.size(); k++) {
+        sortedBuffer[k] = tmpBuffer[sortKeys[k].second];
       }
-      if (ZSEncoderGetRow(a) != ZSEncoderGetRow(b)) {
-        return ZSEncoderGetRow(a) <= ZSEncoderGetRow(b);
-      }
-      return ZSEncoderGetPad(a) < ZSEncoderGetPad(b);
-    });
+      tmpBuffer.swap(sortedBuffer);
+    }
     int lastEndpoint = -1, lastRow = GPUCA_ROW_COUNT, lastTime = -1;
     long hbf = -1, nexthbf = 0;
     std::array<long long int, TPCZSHDR::TPC_ZS_PAGE_SIZE / sizeof(long long int)>* page = nullptr;
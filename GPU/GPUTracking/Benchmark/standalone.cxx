@@ -210,6 +210,9 @@ int ReadConfiguration(int argc, char** argv)
     printf("Double pipeline mode needs at least 3 runs per event and external output\n");
     return 1;
   }
+  if (configStandalone.timingsCSV[0] && configStandalone.proc.debugLevel < 1) {
+    configStandalone.proc.debugLevel = 1;
+  }
   if (configStandalone.TF.bunchSim && configStandalone.TF.nMerge) {
     printf("Cannot run --MERGE and --SIMBUNCHES togeterh\n");
     return 1;
@@ -764,6 +767,23 @@ int main(int argc, char** argv)
     return 1;
   }
 
+  std::unique_ptr<FILE, int (*)(FILE*)> timingsCSV(nullptr, fclose);
+  if (configStandalone.timingsCSV[0]) {
+    timingsCSV.reset(fopen(configStandalone.timingsCSV, "w"));
+    if (timingsCSV == nullptr) {
+      printf("Error opening %s for the timing output\n", configStandalone.timingsCSV);
+      return 1;
+    }
+    GPUReconstruction::WriteTimingsCSVHeader(timingsCSV.get());
+    rec->SetTimingsCSVOutput(timingsCSV.get());
+    if (configStandalone.testSyncAsync) {
+      recAsync->SetTimingsCSVOutput(timingsCSV.get());
+    }
+    if (configStandalone.proc.doublePipeline) {
+      recPipeline->SetTimingsCSVOutput(timingsCSV.get());
+    }
+  }
+
   std::unique_ptr<std::thread> pipelineThread;
   if (configStandalone.proc.doublePipeline) {
     pipelineThread.reset(new std::thread([]() { rec->RunPipelineWorker(); }));
@@ -149,10 +149,13 @@ AddOption(trackletSelectorInPipeline, char, -1, "", 0, "Run tracklet selector in
 AddOption(fullMergerOnGPU, bool, true, "", 0, "Perform full TPC track merging on GPU instead of only refit")
 AddOption(delayedOutput, bool, true, "", 0, "Delay output to be parallel to track fit")
 AddOption(mergerSortTracks, char, -1, "", 0, "Sort track indizes for GPU track fit")
+AddOption(mergerKeepMemory, bool, false, "", 0, "Keep the individual memory allocations of the TPC merger between time frames, reallocating only when they must grow")
 AddOption(alternateBorderSort, char, -1, "", 0, "Alternative implementation for sorting of border tracks")
 AddOption(tpcCompressionGatherMode, char, -1, "", 0, "TPC Compressed Clusters Gather Mode (0: DMA transfer gather gpu to host, 1: serial DMA to host and gather by copy on CPU, 2. gather via GPU kernal DMA access, 3. gather on GPU via kernel, dma afterwards")
 AddOption(tpcCompressionGatherModeKernel, char, -1, "", 0, "TPC Compressed Clusters Gather Mode Kernel (0: unbufferd, 1-3: buffered, 4: multi-block)")
 AddOption(tpccfGatherKernel, bool, true, "", 0, "Use a kernel instead of the DMA engine to gather the clusters")
+AddOption(tpccfFragmentLength, unsigned short, 0, "", 0, "Length in time bins of the fragments processed by the TPC clusterizer, determines the size of the charge and peak maps (0 = maximum of 4000)")
+AddOption(tpccfDeterministicRowOrder, bool, false, "", 0, "Sort the clusters into the rows by a scan instead of atomics, giving the same cluster order on all backends")
 AddOption(doublePipeline, bool, false, "", 0, "Double pipeline mode")
 AddOption(doublePipelineClusterizer, bool, true, "", 0, "Include the input data of the clusterizer in the double-pipeline")
 AddOption(prefetchTPCpageScan, char, 0, "", 0, "Prefetch Data for TPC page scan in CPU cache")
@@ -364,6 +367,7 @@ AddOption(memoryStat, bool, false, "", 0, "Print memory statistics")
 AddOption(testSyncAsync, bool, false, "syncAsync", 0, "Test first synchronous and then asynchronous processing")
 AddOption(testSync, bool, false, "sync", 0, "Test settings for synchronous phase")
 AddOption(timeFrameTime, bool, false, "tfTime", 0, "Print some debug information about time frame processing time")
+AddOption(timingsCSV, const char*, "", "", 0, "Write the timings of all tasks and steps of each processed event in CSV format to this file (implies debug level >= 1)")
 AddOption(controlProfiler, bool, false, "", 0, "Issues GPU profiler stop and start commands to profile only the relevant processing part")
 AddOption(preloadEvents, bool, false, "", 0, "Preload events into host memory before start processing")
 AddOption(recoSteps, int, -1, "", 0, "Bitmask for RecoSteps")
@@ -398,6 +402,7 @@ AddOption(dump, int, 0, "", 0, "Dump events for standalone benchmark: 1 = dump e
 AddOption(display, bool, false, "", 0, "Enable standalone gpu tracking visualizaion")
 AddOption(dEdxFile, std::string, "", "", 0, "File name of dEdx Splines file")
 AddOption(transformationFile, std::string, "", "", 0, "File name of TPC fast transformation map")
+AddOption(transformationCacheFile, std::string, "", "", 0, "File caching the TPC fast transformation map created at startup (w/o transformationFile), created if not present")
 AddOption(matLUTFile, std::string, "", "", 0, "File name of material LUT file")
 AddOption(gainCalibFile, std::string, "", "", 0, "File name of TPC pad gain calibration")
 AddOption(allocateOutputOnTheFly, bool, true, "", 0, "Allocate shm output buffers on the fly, instead of using preallocated buffer with upper bound size")
@@ -25,11 +25,25 @@
 #include "TPCdEdxCalibrationSplines.h"
 #include <iostream>
 #include <fstream>
+#include <thread>
 
 using namespace o2::gpu;
 
 #include "DataFormatsTPC/ClusterNative.h"
 
+namespace o2::gpu
+{
+struct GPUO2Interface_processingContext {
+  std::unique_ptr<GPUReconstruction> mRec;
+  GPUChainTracking* mChain = nullptr;
+  std::unique_ptr<GPUTrackingOutputs> mOutputRegions;
+};
+
+struct GPUO2Interface_Internals {
+  std::unique_ptr<std::thread> pipelineThread;
+};
+} // namespace o2::gpu
+
 GPUO2Interface::GPUO2Interface() = default;
 
 GPUO2Interface::~GPUO2Interface() { Deinitialize(); }
@@ -40,35 +54,49 @@ int GPUO2Interface::Initialize(const GPUO2InterfaceConfiguration& config)
     return (1);
   }
   mConfig.reset(new GPUO2InterfaceConfiguration(config));
+  mNContexts = mConfig->configProcessing.doublePipeline ? 2 : 1;
+  mCtx.reset(new GPUO2Interface_processingContext[mNContexts]);
+  mInternals.reset(new GPUO2Interface_Internals);
   mContinuous = mConfig->configGRP.continuousMaxTimeBin != 0;
-  mRec.reset(GPUReconstruction::CreateInstance(mConfig->configDeviceBackend));
-  if (mRec == nullptr) {
-    GPUError("Error obtaining instance of GPUReconstruction");
-    return 1;
-  }
-  mChain = mRec->AddChain<GPUChainTracking>(mConfig->configInterface.maxTPCHits, mConfig->configInterface.maxTRDTracklets);
-  mChain->mConfigDisplay = &mConfig->configDisplay;
-  mChain->mConfigQA = &mConfig->configQA;
   if (mConfig->configWorkflow.inputs.isSet(GPUDataTypes::InOutType::TPCRaw)) {
     mConfig->configGRP.needsClusterer = 1;
   }
-  mRec->SetSettings(&mConfig->configGRP, &mConfig->configReconstruction, &mConfig->configProcessing, &mConfig->configWorkflow);
-  mChain->SetCalibObjects(mConfig->configCalib);
-  mOutputRegions.reset(new GPUTrackingOutputs);
-  if (mConfig->configInterface.outputToExternalBuffers) {
-    for (unsigned int i = 0; i < mOutputRegions->count(); i++) {
-      mChain->SetSubOutputControl(i, &mOutputRegions->asArray()[i]);
+  for (unsigned int i = 0; i < mNContexts; i++) {
+    // the second context for the double pipeline is a slave of the first one, sharing the GPU memory and processors
+    GPUSettingsDeviceBackend deviceBackend = mConfig->configDeviceBackend;
+    deviceBackend.master = i ? mCtx[0].mRec.get() : nullptr;
+    mCtx[i].mRec.reset(GPUReconstruction::CreateInstance(deviceBackend));
+    if (mCtx[i].mRec == nullptr) {
+      GPUError("Error obtaining instance of GPUReconstruction");
+      return 1;
+    }
+  }
+  for (unsigned int i = 0; i < mNContexts; i++) {
+    mCtx[i].mChain = mCtx[i].mRec->AddChain<GPUChainTracking>(mConfig->configInterface.maxTPCHits, mConfig->configInterface.maxTRDTracklets);
+    mCtx[i].mChain->mConfigDisplay = &mConfig->configDisplay;
+    mCtx[i].mChain->mConfigQA = &mConfig->configQA;
+    mCtx[i].mRec->SetSettings(&mConfig->configGRP, &mConfig->configReconstruction, &mConfig->configProcessing, &mConfig->configWorkflow);
+    mCtx[i].mChain->SetCalibObjects(mConfig->configCalib);
+    mCtx[i].mOutputRegions.reset(new GPUTrackingOutputs);
+    if (mConfig->configInterface.outputToExternalBuffers) {
+      for (unsigned int j = 0; j < mCtx[i].mOutputRegions->count(); j++) {
+        mCtx[i].mChain->SetSubOutputControl(j, &mCtx[i].mOutputRegions->asArray()[j]);
+      }
+      GPUOutputControl dummy;
+      dummy.set([](size_t size) -> void* {throw std::runtime_error("invalid output memory request, no common output buffer set"); return nullptr; });
+      mCtx[i].mRec->SetOutputControl(dummy);
     }
-    GPUOutputControl dummy;
-    dummy.set([](size_t size) -> void* {throw std::runtime_error("invalid output memory request, no common output buffer set"); return nullptr; });
-    mRec->SetOutputControl(dummy);
   }
 
-  if (mRec->Init()) {
+  // Initializing the master initializes the slaves as well
+  if (mCtx[0].mRec->Init()) {
     return (1);
   }
-  if (!mRec->IsGPU() && mRec->GetProcessingSettings().memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_INDIVIDUAL) {
-    mRec->MemoryScalers()->factor *= 2;
+  if (!mCtx[0].mRec->IsGPU() && mCtx[0].mRec->GetProcessingSettings().memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_INDIVIDUAL) {
+    mCtx[0].mRec->MemoryScalers()->factor *= 2;
+  }
+  if (mConfig->configProcessing.doublePipeline) {
+    mInternals->pipelineThread.reset(new std::thread([this]() { mCtx[0].mRec->RunPipelineWorker(); }));
   }
   mInitialized = true;
   return (0);
@@ -77,32 +105,42 @@ int GPUO2Interface::Initialize(const GPUO2InterfaceConfiguration& config)
 void GPUO2Interface::Deinitialize()
 {
   if (mInitialized) {
-    mRec->Finalize();
-    mRec.reset();
+    if (mConfig->configProcessing.doublePipeline) {
+      mCtx[0].mRec->TerminatePipelineWorker();
+      mInternals->pipelineThread->join();
+    }
+    mCtx[0].mRec->Finalize();
+    for (unsigned int i = mNContexts; i--;) {
+      mCtx[i].mRec.reset();
+    }
   }
+  mCtx.reset();
+  mInternals.reset();
+  mNContexts = 0;
   mInitialized = false;
 }
 
-int GPUO2Interface::RunTracking(GPUTrackingInOutPointers* data, GPUInterfaceOutputs* outputs)
+int GPUO2Interface::RunTracking(GPUTrackingInOutPointers* data, GPUInterfaceOutputs* outputs, unsigned int iThread)
 {
-  if (!mInitialized) {
+  if (!mInitialized || iThread >= mNContexts) {
     return (1);
   }
+  auto& ctx = mCtx[iThread];
   if (mConfig->configInterface.dumpEvents) {
     static int nEvent = 0;
-    mChain->ClearIOPointers();
-    mChain->mIOPtrs = *data;
+    ctx.mChain->ClearIOPointers();
+    ctx.mChain->mIOPtrs = *data;
 
     char fname[1024];
     sprintf(fname, "event.%d.dump", nEvent);
-    mChain->DumpData(fname);
+    ctx.mChain->DumpData(fname);
     if (nEvent == 0) {
-      mRec->DumpSettings();
+      ctx.mRec->DumpSettings();
 #ifdef GPUCA_BUILD_QA
       if (mConfig->configProcessing.runMC) {
-        mChain->ForceInitQA();
+        ctx.mChain->ForceInitQA();
         sprintf(fname, "mc.%d.dump", nEvent);
-        mChain->GetQA()->DumpO2MCData(fname);
+        ctx.mChain->GetQA()->DumpO2MCData(fname);
       }
 #endif
     }
@@ -112,53 +150,53 @@ int GPUO2Interface::RunTracking(GPUTrackingInOutPointers* data, GPUInterfaceOutp
     }
   }
 
-  mChain->mIOPtrs = *data;
+  ctx.mChain->mIOPtrs = *data;
   if (mConfig->configInterface.outputToExternalBuffers) {
-    for (unsigned int i = 0; i < mOutputRegions->count(); i++) {
+    for (unsigned int i = 0; i < ctx.mOutputRegions->count(); i++) {
       if (outputs->asArray()[i].allocator) {
-        mOutputRegions->asArray()[i].set(outputs->asArray()[i].allocator);
+        ctx.mOutputRegions->asArray()[i].set(outputs->asArray()[i].allocator);
       } else if (outputs->asArray()[i].ptrBase) {
-        mOutputRegions->asArray()[i].set(outputs->asArray()[i].ptrBase, outputs->asArray()[i].size);
+        ctx.mOutputRegions->asArray()[i].set(outputs->asArray()[i].ptrBase, outputs->asArray()[i].size);
       } else {
-        mOutputRegions->asArray()[i].reset();
+        ctx.mOutputRegions->asArray()[i].reset();
       }
     }
   }
 
-  int retVal = mRec->RunChains();
+  int retVal = ctx.mRec->RunChains();
   if (retVal == 2) {
     retVal = 0; // 2 signals end of event display, ignore
   }
   if (retVal) {
-    mRec->ClearAllocatedMemory();
+    ctx.mRec->ClearAllocatedMemory();
     return retVal;
   }
   if (mConfig->configQA.shipToQC) {
-    outputs->qa.hist1 = &mChain->GetQA()->getHistograms1D();
-    outputs->qa.hist2 = &mChain->GetQA()->getHistograms2D();
-    outputs->qa.hist3 = &mChain->GetQA()->getHistograms1Dd();
+    outputs->qa.hist1 = &ctx.mChain->GetQA()->getHistograms1D();
+    outputs->qa.hist2 = &ctx.mChain->GetQA()->getHistograms2D();
+    outputs->qa.hist3 = &ctx.mChain->GetQA()->getHistograms1Dd();
   }
-  *data = mChain->mIOPtrs;
+  *data = ctx.mChain->mIOPtrs;
 
   return 0;
 }
 
-void GPUO2Interface::Clear(bool clearOutputs) { mRec->ClearAllocatedMemory(clearOutputs); }
+void GPUO2Interface::Clear(bool clearOutputs, unsigned int iThread) { mCtx[iThread].mRec->ClearAllocatedMemory(clearOutputs); }
 
 void GPUO2Interface::GetClusterErrors2(int row, float z, float sinPhi, float DzDs, short clusterState, float& ErrY2, float& ErrZ2) const
 {
-  mRec->GetParam().GetClusterErrors2(row, z, sinPhi, DzDs, ErrY2, ErrZ2);
-  mRec->GetParam().UpdateClusterError2ByState(clusterState, ErrY2, ErrZ2);
+  mCtx[0].mRec->GetParam().GetClusterErrors2(row, z, sinPhi, DzDs, ErrY2, ErrZ2);
+  mCtx[0].mRec->GetParam().UpdateClusterError2ByState(clusterState, ErrY2, ErrZ2);
 }
 
 int GPUO2Interface::registerMemoryForGPU(const void* ptr, size_t size)
 {
-  return mRec->registerMemoryForGPU(ptr, size);
+  return mCtx[0].mRec->registerMemoryForGPU(ptr, size);
 }
 
 int GPUO2Interface::unregisterMemoryForGPU(const void* ptr)
 {
-  return mRec->unregisterMemoryForGPU(ptr);
+  return mCtx[0].mRec->unregisterMemoryForGPU(ptr);
 }
 
 std::unique_ptr<TPCPadGainCalib> GPUO2Interface::getPadGainCalibDefault()
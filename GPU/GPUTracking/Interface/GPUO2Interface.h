@@ -45,6 +45,8 @@ class GPUChainTracking;
 struct GPUO2InterfaceConfiguration;
 struct GPUInterfaceOutputs;
 struct GPUTrackingOutputs;
+struct GPUO2Interface_processingContext;
+struct GPUO2Interface_Internals;
 
 class GPUO2Interface
 {
@@ -55,8 +57,12 @@ class GPUO2Interface
   int Initialize(const GPUO2InterfaceConfiguration& config);
   void Deinitialize();
 
-  int RunTracking(GPUTrackingInOutPointers* data, GPUInterfaceOutputs* outputs = nullptr);
-  void Clear(bool clearOutputs);
+  // In double-pipeline mode (configProcessing.doublePipeline) there are two processing contexts, sharing the GPU.
+  // RunTracking can then be called concurrently from two threads with iThread = 0 and 1, and the GPU processing of one TF
+  // overlaps the input transfer and the output finalization of the other one.
+  int RunTracking(GPUTrackingInOutPointers* data, GPUInterfaceOutputs* outputs = nullptr, unsigned int iThread = 0);
+  void Clear(bool clearOutputs, unsigned int iThread = 0);
+  unsigned int getNContexts() const { return mNContexts; }
 
   bool GetParamContinuous() { return (mContinuous); }
   void GetClusterErrors2(int row, float z, float sinPhi, float DzDs, short clusterState, float& ErrY2, float& ErrZ2) const;
@@ -76,11 +82,11 @@ class GPUO2Interface
 
   bool mInitialized = false;
   bool mContinuous = false;
+  unsigned int mNContexts = 0;
 
-  std::unique_ptr<GPUReconstruction> mRec;              //!
-  GPUChainTracking* mChain = nullptr;                   //!
-  std::unique_ptr<GPUO2InterfaceConfiguration> mConfig; //!
-  std::unique_ptr<GPUTrackingOutputs> mOutputRegions;   //!
+  std::unique_ptr<GPUO2Interface_processingContext[]> mCtx; //!
+  std::unique_ptr<GPUO2InterfaceConfiguration> mConfig;     //!
+  std::unique_ptr<GPUO2Interface_Internals> mInternals;     //!
 };
 } // namespace o2::gpu
 
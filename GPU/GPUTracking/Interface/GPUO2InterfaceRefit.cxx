@@ -22,20 +22,42 @@
 using namespace o2::gpu;
 using namespace o2::tpc;
 
-void GPUO2InterfaceRefit::fillSharedClustersMap(const ClusterNativeAccess* cl, const gsl::span<const TrackTPC> trks, const TPCClRefElem* trackRef, unsigned char* shmap)
+void GPUO2InterfaceRefit::fillSharedClustersMap(const ClusterNativeAccess* cl, const gsl::span<const TrackTPC> trks, const TPCClRefElem* trackRef, unsigned char* shmap, int nThreads)
 {
   if (!cl || !shmap) {
     throw std::runtime_error("Must provide clusters access and preallocated recepient for shared map");
   }
   memset(shmap, 0, sizeof(char) * cl->nClustersTotal);
-  for (unsigned int i = 0; i < trks.size(); i++) {
+  // bit 0 marks a cluster used by a track, bit 1 a cluster used by more than one, set atomically as the tracks are processed concurrently
+  const int nTracks = trks.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static, 256) num_threads(nThreads)
+#endif
+  for (int i = 0; i < nTracks; i++) {
     for (unsigned int j = 0; j < trks[i].getNClusterReferences(); j++) {
       size_t idx = &trks[i].getCluster(trackRef, j, *cl) - cl->clustersLinear;
-      shmap[idx] = shmap[idx] ? 2 : 1;
+      unsigned char used;
+#ifdef WITH_OPENMP
+#pragma omp atomic capture
+#endif
+      {
+        used = shmap[idx];
+        shmap[idx] |= 1;
+      }
+      if (used) {
+#ifdef WITH_OPENMP
+#pragma omp atomic update
+#endif
+        shmap[idx] |= 2;
+      }
     }
   }
-  for (unsigned int i = 0; i < cl->nClustersTotal; i++) {
-    shmap[i] = (shmap[i] > 1 ? GPUTPCGMMergedTrackHit::flagShared : 0) | cl->clustersLinear[i].getFlags();
+  const int nClusters = cl->nClustersTotal;
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nThreads)
+#endif
+  for (int i = 0; i < nClusters; i++) {
+    shmap[i] = ((shmap[i] & 2) ? GPUTPCGMMergedTrackHit::flagShared : 0) | cl->clustersLinear[i].getFlags();
   }
 }
 
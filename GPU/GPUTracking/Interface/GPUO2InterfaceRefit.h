@@ -80,7 +80,8 @@ class GPUO2InterfaceRefit
   void setTrackReferenceX(float v);
   void setIgnoreErrorsAtTrackEnds(bool v);
 
-  static void fillSharedClustersMap(const o2::tpc::ClusterNativeAccess* cl, const gsl::span<const o2::tpc::TrackTPC> trks, const o2::tpc::TPCClRefElem* trackRef, unsigned char* shmap);
+  // Flags of the clusters, with GPUTPCGMMergedTrackHit::flagShared set for the ones used by more than one track, the tracks are processed by nThreads threads
+  static void fillSharedClustersMap(const o2::tpc::ClusterNativeAccess* cl, const gsl::span<const o2::tpc::TrackTPC> trks, const o2::tpc::TPCClRefElem* trackRef, unsigned char* shmap, int nThreads = 1);
 
  private:
   std::unique_ptr<GPUTrackingRefit> mRefit;
@@ -0,0 +1,40 @@
+#!/bin/bash
+# Run the standalone benchmark on a fixed set of recorded datasets and configurations, writing one timing CSV per combination.
+# Usage: benchmark.sh <output dir> <dataset> [dataset ...]
+#   The datasets are directory names below ./events, as for the -e option of ca, and must be created with the same O2 version.
+#   Environment: CA_BIN (default ./ca), CA_RUNS (iterations per event, default 5), CA_OPTIONS (additional options for all runs)
+# Compare two output directories with: for i in baseline/*.csv; do compareTimings.py $i current/${i##*/}; done
+
+if [ $# -lt 2 ]; then
+  echo "Usage: $0 <output dir> <dataset> [dataset ...]"
+  exit 1
+fi
+
+CA_BIN=${CA_BIN:-./ca}
+CA_RUNS=${CA_RUNS:-5}
+OUTPUT_DIR=$1
+shift
+
+# Name and options of each configuration
+CONFIGS=(
+  "default:"
+  "trackingOnly:--runCompression 0 --runTRD 0"
+  "doublePipeline:--PROCdoublePipeline 1"
+)
+
+mkdir -p "$OUTPUT_DIR" || exit 1
+RETVAL=0
+for DATASET in "$@"; do
+  for CONFIG in "${CONFIGS[@]}"; do
+    NAME=${CONFIG%%:*}
+    OPTIONS=${CONFIG#*:}
+    OUTFILE="$OUTPUT_DIR/${DATASET//\//_}_${NAME}.csv"
+    echo "Running dataset $DATASET with configuration $NAME"
+    $CA_BIN -e "$DATASET" --runs $CA_RUNS --timingsCSV "$OUTFILE" $OPTIONS $CA_OPTIONS > "${OUTFILE%.csv}.log" 2>&1
+    if [ $? != 0 ]; then
+      echo "Error running $CA_BIN for dataset $DATASET with configuration $NAME, see ${OUTFILE%.csv}.log"
+      RETVAL=1
+    fi
+  done
+done
+exit $RETVAL
@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+# Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+# See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+# All rights not expressly granted are reserved.
+#
+# This software is distributed under the terms of the GNU General Public
+# License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+#
+# In applying this license CERN does not waive the privileges and immunities
+# granted to it by virtue of its status as an Intergovernmental Organization
+# or submit itself to any jurisdiction.
+
+# Compare the timings written by the standalone benchmark with --timingsCSV against a baseline.
+# Usage: compareTimings.py <baseline.csv> <current.csv> [max relative slowdown, default 0.1] [skip first N events, default 1]
+# Times and bytes are averaged over the events of each file. Exits with 1 if any entry is slower than allowed.
+
+import csv
+import sys
+
+
+def load(filename, skip):
+    sums = {}
+    with open(filename) as f:
+        for row in csv.DictReader(f):
+            if int(row["event"]) < skip:
+                continue
+            key = (row["category"], row["type"], row["name"])
+            entry = sums.setdefault(key, [0, 0., 0.])
+            entry[0] += 1
+            entry[1] += float(row["time_us"])
+            entry[2] += float(row["bytes"])
+    return {key: (val[1] / val[0], val[2] / val[0]) for key, val in sums.items()}
+
+
+if len(sys.argv) < 3:
+    sys.stderr.write("Usage: %s <baseline.csv> <current.csv> [max relative slowdown] [skip first N events]\n" % sys.argv[0])
+    sys.exit(2)
+
+maxSlowdown = float(sys.argv[3]) if len(sys.argv) > 3 else 0.1
+skip = int(sys.argv[4]) if len(sys.argv) > 4 else 1
+baseline = load(sys.argv[1], skip)
+current = load(sys.argv[2], skip)
+
+nRegressions = 0
+print("%-8s %-1s %-50s %14s %14s %8s" % ("category", "", "name", "baseline", "current", "change"))
+for key in sorted(set(baseline) | set(current)):
+    if key not in baseline or key not in current:
+        print("%-8s %-1s %-50s %s" % (key[0], key[1], key[2], "only in current" if key in current else "only in baseline"))
+        continue
+    index = 1 if key[0] == "memory" else 0  # memory entries are compared in bytes, the others in time
+    base = baseline[key][index]
+    cur = current[key][index]
+    change = (cur - base) / base if base > 0 else 0.
+    regression = change > maxSlowdown and (key[0] != "task" or base > 10)  # ignore jitter of very short tasks
+    nRegressions += regression
+    print("%-8s %-1s %-50s %14.1f %14.1f %+7.1f%%%s" % (key[0], key[1], key[2], base, cur, change * 100, "  <-- REGRESSION" if regression else ""))
+
+print("%d regressions (allowed slowdown %.1f%%)" % (nRegressions, maxSlowdown * 100))
+sys.exit(1 if nRegressions else 0)
@@ -72,7 +72,14 @@ GPUdii() void GPUTPCCFClusterizer::computeClustersImpl(int nBlocks, int nThreads
     &pc,
     labelAcc);
 
-  if (idx >= clusternum || fragment.isOverlap(pos.time())) {
+  bool deterministicRowOrder = clusterByRow != nullptr && clusterer.mPclusterByIdx != nullptr;
+  if (idx >= clusternum) {
+    return;
+  }
+  if (fragment.isOverlap(pos.time())) {
+    if (deterministicRowOrder) {
+      clusterer.mPclusterRowByIdx[idx] = GPUCA_ROW_COUNT;
+    }
     return;
   }
   pc.finalize(pos, charge, fragment.start);
@@ -84,6 +91,15 @@ GPUdii() void GPUTPCCFClusterizer::computeClustersImpl(int nBlocks, int nThreads
 
   if (clusterPosInRow && !aboveQTotCutoff) {
     clusterPosInRow[idx] = maxClusterPerRow;
+    if (deterministicRowOrder) {
+      clusterer.mPclusterRowByIdx[idx] = GPUCA_ROW_COUNT;
+    }
+    return;
+  }
+
+  if (deterministicRowOrder) { // Sorted into the rows by GPUTPCCFStreamCompaction::compactClusters, MC labels are committed in the onlyMC pass
+    clusterer.mPclusterByIdx[idx] = myCluster;
+    clusterer.mPclusterRowByIdx[idx] = pos.row();
     return;
   }
 
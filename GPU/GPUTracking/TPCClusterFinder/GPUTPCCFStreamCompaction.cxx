@@ -172,6 +172,38 @@ GPUdii() void GPUTPCCFStreamCompaction::compactImpl(int nBlocks, int nThreads, i
   }
 }
 
+// Sorts the clusters into the rows in the order of the peaks, one block per row.
+// The scan over the whole peak list keeps the order deterministic without atomics.
+template <>
+GPUdii() void GPUTPCCFStreamCompaction::Thread<GPUTPCCFStreamCompaction::compactClusters>(int nBlocks, int nThreads, int iBlock, int iThread, GPUSharedMemory& smem, processorType& clusterer)
+{
+  const unsigned int nElems = clusterer.mPmemory->counters.nClusters;
+  const unsigned int maxClusterPerRow = clusterer.mNMaxClusterPerRow;
+  for (unsigned int row = iBlock; row < GPUCA_ROW_COUNT; row += nBlocks) {
+    unsigned int offset = clusterer.mPclusterInRow[row]; // Rows are filled incrementally over the fragments
+    for (unsigned int iBase = 0; iBase < nElems; iBase += nThreads) {
+      const unsigned int idx = iBase + iThread;
+      const int pred = idx < nElems && clusterer.mPclusterRowByIdx[idx] == row;
+      const int scanRes = work_group_scan_inclusive_add(pred);
+      if (pred) {
+        const unsigned int index = offset + scanRes - 1;
+        if (index < maxClusterPerRow) {
+          clusterer.mPclusterByRow[maxClusterPerRow * row + index] = clusterer.mPclusterByIdx[idx];
+        } else {
+          clusterer.raiseError(GPUErrors::ERROR_CF_ROW_CLUSTER_OVERFLOW, index, maxClusterPerRow);
+        }
+        if (clusterer.mPclusterPosInRow) {
+          clusterer.mPclusterPosInRow[idx] = index;
+        }
+      }
+      offset += work_group_broadcast(scanRes, nThreads - 1);
+    }
+    if (iThread == 0) {
+      clusterer.mPclusterInRow[row] = CAMath::Min(offset, maxClusterPerRow);
+    }
+  }
+}
+
 GPUdii() int GPUTPCCFStreamCompaction::compactionElems(processorType& clusterer, int stage)
 {
   return (stage) ? clusterer.mPmemory->counters.nPeaks : clusterer.mPmemory->counters.nPositions;
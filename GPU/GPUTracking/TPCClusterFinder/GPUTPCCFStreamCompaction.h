@@ -33,6 +33,7 @@ class GPUTPCCFStreamCompaction : public GPUKernelTemplate
     scanTop = 2,
     scanDown = 3,
     compactDigits = 4,
+    compactClusters = 5,
   };
 
   struct GPUSharedMemory : public GPUKernelTemplate::GPUSharedMemoryScan64<int, GPUCA_THREAD_COUNT_SCAN> {
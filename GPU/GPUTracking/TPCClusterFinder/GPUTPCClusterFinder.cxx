@@ -22,6 +22,7 @@
 
 #include "ChargePos.h"
 #include "Array2D.h"
+#include "GPUTPCCFCheckPadBaseline.h"
 
 using namespace GPUCA_NAMESPACE::gpu;
 using namespace o2::tpc;
@@ -86,10 +87,17 @@ void* GPUTPCClusterFinder::SetPointersScratch(void* mem)
     mPclusterPosInRow = nullptr;
   }
   computePointerWithAlignment(mem, mPisPeak, mNMaxDigitsFragment);
-  computePointerWithAlignment(mem, mPchargeMap, TPCMapMemoryLayout<decltype(*mPchargeMap)>::items());
-  computePointerWithAlignment(mem, mPpeakMap, TPCMapMemoryLayout<decltype(*mPpeakMap)>::items());
+  computePointerWithAlignment(mem, mPchargeMap, TPCMapMemoryLayout<decltype(*mPchargeMap)>::items(getFragmentLength()));
+  computePointerWithAlignment(mem, mPpeakMap, TPCMapMemoryLayout<decltype(*mPpeakMap)>::items(getFragmentLength()));
   computePointerWithAlignment(mem, mPbuf, mBufSize * mNBufs);
   computePointerWithAlignment(mem, mPclusterByRow, GPUCA_ROW_COUNT * mNMaxClusterPerRow);
+  if (mRec->GetProcessingSettings().tpccfDeterministicRowOrder) {
+    computePointerWithAlignment(mem, mPclusterByIdx, mNMaxClusters);
+    computePointerWithAlignment(mem, mPclusterRowByIdx, mNMaxClusters);
+  } else {
+    mPclusterByIdx = nullptr;
+    mPclusterRowByIdx = nullptr;
+  }
   return mem;
 }
 
@@ -149,12 +157,22 @@ unsigned int GPUTPCClusterFinder::getNSteps(size_t items) const
   return c;
 }
 
+unsigned int GPUTPCClusterFinder::getFragmentLength() const
+{
+  unsigned int len = mRec->GetProcessingSettings().tpccfFragmentLength;
+  if (len == 0 || len >= TPC_MAX_FRAGMENT_LEN) {
+    return TPC_MAX_FRAGMENT_LEN;
+  }
+  len = std::max<unsigned int>(len, 8 * CfFragment::OverlapTimebins);
+  return len / GPUTPCCFCheckPadBaseline::NumOfCachedTimebins * GPUTPCCFCheckPadBaseline::NumOfCachedTimebins; // The pad baseline check processes blocks of NumOfCachedTimebins
+}
+
 void GPUTPCClusterFinder::PrepareMC()
 {
   assert(mNMaxClusterPerRow > 0);
 
   clearMCMemory();
-  mPindexMap = new uint[TPCMapMemoryLayout<decltype(*mPindexMap)>::items()];
+  mPindexMap = new uint[TPCMapMemoryLayout<decltype(*mPindexMap)>::items(getFragmentLength())];
   mPlabelsByRow = new GPUTPCClusterMCInterim[GPUCA_ROW_COUNT * mNMaxClusterPerRow];
   mPlabelsInRow = new uint[GPUCA_ROW_COUNT];
 }
@@ -91,6 +91,7 @@ class GPUTPCClusterFinder : public GPUProcessor
   void* SetPointersZSOffset(void* mem);
 
   unsigned int getNSteps(size_t items) const;
+  unsigned int getFragmentLength() const;
   void SetNMaxDigits(size_t nDigits, size_t nPages, size_t nDigitsFragment);
 
   void PrepareMC();
@@ -113,6 +114,8 @@ class GPUTPCClusterFinder : public GPUProcessor
   uint* mPindexMap = nullptr;
   uint* mPclusterInRow = nullptr;
   tpc::ClusterNative* mPclusterByRow = nullptr;
+  tpc::ClusterNative* mPclusterByIdx = nullptr; // clusters by peak index, only used with tpccfDeterministicRowOrder
+  unsigned char* mPclusterRowByIdx = nullptr;   // row of the cluster of each peak, GPUCA_ROW_COUNT if discarded
   GPUTPCClusterMCInterim* mPlabelsByRow = nullptr;
   int* mPbuf = nullptr;
   Memory* mPmemory = nullptr;
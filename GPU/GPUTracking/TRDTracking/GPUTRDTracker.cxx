@@ -203,8 +203,14 @@ void GPUTRDTracker_t<TRDTRK, PROP>::PrepareTracking(GPUChainTracking* chainTrack
   // Prepare tracklet index array and if requested calculate space points
   // in part duplicated from DoTracking() method to allow for calling
   // this function on the host prior to GPU processing
+  // When processing per time frame the collisions are independent (separate
+  // index arrays and tracklet ranges), so they are prepared in parallel
   //--------------------------------------------------------------------
-  for (unsigned int iColl = 0; iColl < GetConstantMem()->ioPtrs.nTRDTriggerRecords; ++iColl) {
+  const int nColl = GetConstantMem()->ioPtrs.nTRDTriggerRecords;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mRec->GetProcessingSettings().ompThreads) if (mProcessPerTimeFrame)
+#endif
+  for (int iColl = 0; iColl < nColl; ++iColl) {
     if (GetConstantMem()->ioPtrs.trdTrigRecMask[iColl] == 0) {
       // this trigger is masked as there is no ITS information available for it
       continue;
@@ -213,7 +219,7 @@ void GPUTRDTracker_t<TRDTRK, PROP>::PrepareTracking(GPUChainTracking* chainTrack
     int idxOffset = 0;
     if (mProcessPerTimeFrame) {
       idxOffset = GetConstantMem()->ioPtrs.trdTrackletIdxFirst[iColl];
-      nTrklts = (iColl < GetConstantMem()->ioPtrs.nTRDTriggerRecords - 1) ? GetConstantMem()->ioPtrs.trdTrackletIdxFirst[iColl + 1] - GetConstantMem()->ioPtrs.trdTrackletIdxFirst[iColl] : GetConstantMem()->ioPtrs.nTRDTracklets - GetConstantMem()->ioPtrs.trdTrackletIdxFirst[iColl];
+      nTrklts = (iColl < nColl - 1) ? GetConstantMem()->ioPtrs.trdTrackletIdxFirst[iColl + 1] - GetConstantMem()->ioPtrs.trdTrackletIdxFirst[iColl] : GetConstantMem()->ioPtrs.nTRDTracklets - GetConstantMem()->ioPtrs.trdTrackletIdxFirst[iColl];
     } else {
       nTrklts = GetConstantMem()->ioPtrs.nTRDTracklets;
     }
@@ -239,7 +245,6 @@ void GPUTRDTracker_t<TRDTRK, PROP>::PrepareTracking(GPUChainTracking* chainTrack
     if (mGenerateSpacePoints) {
       if (!CalculateSpacePoints(iColl)) {
         GPUError("Space points for at least one chamber could not be calculated (for interaction %i)", iColl);
-        break;
       }
     }
   }
@@ -263,7 +268,8 @@ void GPUTRDTracker_t<TRDTRK, PROP>::DoTracking(GPUChainTracking* chainTracking)
     chainTracking->DoTRDGPUTracking();
   } else {
 #ifdef WITH_OPENMP
-#pragma omp parallel for num_threads(mRec->GetProcessingSettings().ompThreads)
+    // the number of layers a track is followed through varies a lot, hence the dynamic scheduling
+#pragma omp parallel for schedule(dynamic, 16) num_threads(mRec->GetProcessingSettings().ompThreads)
     for (int iTrk = 0; iTrk < mNTracks; ++iTrk) {
       if (omp_get_num_threads() > mMaxThreads) {
         GPUError("Number of parallel threads too high, aborting tracking");
@@ -49,6 +49,12 @@ class GPUbenchmark final
   std::vector<float> benchmarkAsync(void (*kernel)(int, T...),
                                     int nStreams, int nLaunches, int blocks, int threads, T&... args);
 
+  // Single stream pinned host <-> device transfers of one chunk
+  float benchmarkTransferSync(Test test, int nLaunches, int chunkId);
+
+  // Multi-streams pinned host <-> device transfers, one chunk per stream
+  std::vector<float> benchmarkTransferAsync(Test test, int nStreams, int nLaunches);
+
   // Main interface
   void globalInit();     // Allocate scratch buffers and compute runtime parameters
   void run();            // Execute all specified callbacks
@@ -65,6 +71,12 @@ class GPUbenchmark final
   void copyInit();
   void copyFinalize();
 
+  void patternInit();
+  void patternFinalize();
+
+  void transferInit();
+  void transferFinalize();
+
   // Kernel calling wrappers
   void readSequential(SplitLevel sl);
   void readConcurrent(SplitLevel sl, int nRegions = 2);
@@ -75,6 +87,14 @@ class GPUbenchmark final
   void copySequential(SplitLevel sl);
   void copyConcurrent(SplitLevel sl, int nRegions = 2);
 
+  // Access patterns of the reconstruction (ScatterWrite, GridRead, RandomRead), always multi block
+  void patternSequential(Test test);
+  void patternConcurrent(Test test);
+
+  // Pinned host memory transfers (HostToDevice, DeviceToHost)
+  void transferSequential(Test test);
+  void transferConcurrent(Test test);
+
  private:
   gpuState<chunk_type> mState;
   std::shared_ptr<ResultWriter> mResultWriter;
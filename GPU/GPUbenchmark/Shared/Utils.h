@@ -37,7 +37,12 @@
 enum class Test {
   Read,
   Write,
-  Copy
+  Copy,
+  ScatterWrite, // scattered writes on a tiled 2D map, as GPUTPCCFChargeMapFiller
+  GridRead,     // reads of the neighbouring bins of a hit grid, as the slice tracker
+  RandomRead,   // reads of records at random positions, as the merger accessing tracks
+  HostToDevice, // DMA transfers from pinned host memory
+  DeviceToHost  // DMA transfers to pinned host memory
 };
 
 enum class Mode {
@@ -59,6 +64,7 @@ struct benchmarkOpts {
   benchmarkOpts() = default;
 
   int deviceId = 0;
+  std::vector<int> deviceIds = {0}; // devices to run on concurrently, deviceId is set for each of them
   std::vector<Test> tests = {Test::Read, Test::Write, Test::Copy};
   std::vector<Mode> modes = {Mode::Sequential, Mode::Concurrent};
   std::vector<SplitLevel> pools = {SplitLevel::Blocks, SplitLevel::Threads};
@@ -118,6 +124,9 @@ struct gpuState {
   std::vector<T> hostWriteResultsVector;      // Results of the write test (single variable) on host
   T* deviceCopyInputsPtr;                     // Inputs of the copy test (single variable) on GPU
   std::vector<T> hostCopyInputsVector;        // Inputs of the copy test (single variable) on host
+  T* devicePatternResultsPtr;                 // Results of the access pattern tests (single variable) on GPU
+  std::vector<T> hostPatternResultsVector;    // Results of the access pattern tests (single variable) on host
+  T* hostPinnedPtr;                           // Pinned host buffer of one chunk for the transfer tests
 
   // Static info
   size_t totalMemory;
@@ -13,6 +13,8 @@
 /// \author mconcas@cern.ch
 /// \brief configuration widely inspired/copied by SimConfig
 #include "Shared/Kernels.h"
+#include <TROOT.h>
+#include <thread>
 
 bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
 {
@@ -21,11 +23,12 @@ bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
   bpo::options_description options("Benchmark options");
   options.add_options()(
     "help,h", "Print help message.")(
-    "device,d", bpo::value<int>()->default_value(0), "Id of the device to run test on, EPN targeted.")(
-    "test,t", bpo::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{"read", "write", "copy"}, "read, write, copy"), "Tests to be performed.")(
+    "device,d", bpo::value<std::vector<int>>()->multitoken()->default_value(std::vector<int>{0}, "0"), "Id of the device(s) to run test on, EPN targeted. Multiple devices are benchmarked concurrently.")(
+    "test,t", bpo::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{"read", "write", "copy"}, "read, write, copy"), "Tests to be performed: read, write, copy, scatter (charge map filling), grid (hit grid lookups), random (random track access), h2d, d2h (pinned host transfers).")(
     "mode,m", bpo::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{"seq", "con"}, "seq, con"), "Mode: sequential or concurrent.")(
     "pool,p", bpo::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{"sb, mb"}, "sb, mb"), "Pool strategy: single or multi blocks.")(
     "chunkSize,c", bpo::value<float>()->default_value(1.f), "Size of scratch partitions (GB).")(
+    "regions,r", bpo::value<int>()->default_value(2), "Number of memory regions.")(
     "freeMemFraction,f", bpo::value<float>()->default_value(0.95f), "Fraction of free memory to be allocated (min: 0.f, max: 1.f).")(
     "launches,l", bpo::value<int>()->default_value(10), "Number of iterations in reading kernels.")(
     "nruns,n", bpo::value<int>()->default_value(1), "Number of times each test is run.");
@@ -45,7 +48,8 @@ bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
     return false;
   }
 
-  conf.deviceId = vm["device"].as<int>();
+  conf.deviceIds = vm["device"].as<std::vector<int>>();
+  conf.deviceId = conf.deviceIds.front();
   conf.freeMemoryFractionToAllocate = vm["freeMemFraction"].as<float>();
   conf.chunkReservedGB = vm["chunkSize"].as<float>();
   conf.nRegions = vm["regions"].as<int>();
@@ -60,6 +64,16 @@ bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
       conf.tests.push_back(Test::Write);
     } else if (test == "copy") {
       conf.tests.push_back(Test::Copy);
+    } else if (test == "scatter") {
+      conf.tests.push_back(Test::ScatterWrite);
+    } else if (test == "grid") {
+      conf.tests.push_back(Test::GridRead);
+    } else if (test == "random") {
+      conf.tests.push_back(Test::RandomRead);
+    } else if (test == "h2d") {
+      conf.tests.push_back(Test::HostToDevice);
+    } else if (test == "d2h") {
+      conf.tests.push_back(Test::DeviceToHost);
     } else {
       std::cerr << "Unkonwn test: " << test << std::endl;
       exit(1);
@@ -104,17 +118,33 @@ int main(int argc, const char* argv[])
     return -1;
   }
 
-  std::shared_ptr<ResultWriter> writer = std::make_shared<ResultWriter>(std::to_string(opts.deviceId) + "_benchmark_results.root");
+  // One writer per device, the devices run concurrently in order to measure the contention on the shared host resources
+  auto runDevice = [](o2::benchmark::benchmarkOpts devOpts) {
+    std::shared_ptr<ResultWriter> writer = std::make_shared<ResultWriter>(std::to_string(devOpts.deviceId) + "_benchmark_results.root");
 
-  o2::benchmark::GPUbenchmark<char> bm_char{opts, writer};
-  bm_char.run();
-  o2::benchmark::GPUbenchmark<int> bm_int{opts, writer};
-  bm_int.run();
-  o2::benchmark::GPUbenchmark<size_t> bm_size_t{opts, writer};
-  bm_size_t.run();
+    o2::benchmark::GPUbenchmark<char> bm_char{devOpts, writer};
+    bm_char.run();
+    o2::benchmark::GPUbenchmark<int> bm_int{devOpts, writer};
+    bm_int.run();
+    o2::benchmark::GPUbenchmark<size_t> bm_size_t{devOpts, writer};
+    bm_size_t.run();
 
-  // save results
-  writer.get()->saveToFile();
+    // save results
+    writer.get()->saveToFile();
+  };
+
+  if (opts.deviceIds.size() > 1) {
+    ROOT::EnableThreadSafety();
+  }
+  std::vector<std::thread> threads;
+  for (auto deviceId : opts.deviceIds) {
+    auto devOpts = opts;
+    devOpts.deviceId = deviceId;
+    threads.emplace_back(runDevice, devOpts);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
 
   return 0;
 }
@@ -17,6 +17,7 @@
 #include "hip/hip_runtime.h"
 #endif
 #include <cstdio>
+#include <cstring>
 
 // Memory partitioning legend
 //
@@ -72,6 +73,25 @@ __host__ __device__ inline chunk_type* getPartPtrOnScratch(chunk_type* scratchPt
   return reinterpret_cast<chunk_type*>(reinterpret_cast<char*>(scratchPtr) + static_cast<size_t>(GB * chunkReservedGB) * partNumber);
 }
 
+// Cheap integer hash (splitmix64 finalizer) to generate scattered positions
+__host__ __device__ inline size_t hashIndex(size_t i)
+{
+  i ^= i >> 33;
+  i *= 0xff51afd7ed558ccdULL;
+  i ^= i >> 33;
+  i *= 0xc4ceb9fe1a85ec53ULL;
+  i ^= i >> 33;
+  return i;
+}
+
+// Parameters of the reconstruction access patterns
+constexpr size_t PatternMapNPads = 256;      // pads per row of the charge map, padded to a power of 2
+constexpr size_t PatternMapOccupancy = 4;    // one digit every 4 pads on average
+constexpr int PatternGridNY = 32;            // y bins of the hit grid of a row
+constexpr int PatternGridNZ = 32;            // z bins of the hit grid of a row
+constexpr int PatternGridBinSize = 4;        // hits per bin
+constexpr size_t PatternRecordSize = 64;     // bytes per record of the random access test, similar to a merged track
+
 //////////////////
 // Kernels go here
 // Reading
@@ -168,8 +188,117 @@ __global__ void copyChunkMBKernel(
   }
 }
 
+// Access patterns
+template <class chunk_type>
+__global__ void scatterWriteChunkKernel(
+  int chunkId,
+  chunk_type* results,
+  chunk_type* scratch,
+  size_t chunkSize,
+  float chunkReservedGB = 1.f)
+{
+  // The chunk is a (pad, time) map stored in 4x4 tiles. Digits come ordered in time, with scattered pads.
+  chunk_type* ptr = getPartPtrOnScratch(scratch, chunkReservedGB, chunkId);
+  const size_t nTimeBins = chunkSize / PatternMapNPads / 4 * 4;
+  const size_t nDigits = nTimeBins * PatternMapNPads / PatternMapOccupancy;
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < nDigits; i += blockDim.x * gridDim.x) {
+    const size_t time = i * PatternMapOccupancy / PatternMapNPads;
+    const size_t pad = hashIndex(i) % PatternMapNPads;
+    ptr[((time / 4) * (PatternMapNPads / 4) + pad / 4) * 16 + (time % 4) * 4 + pad % 4] = 1;
+  }
+}
+
+template <class chunk_type>
+__global__ void gridReadChunkKernel(
+  int chunkId,
+  chunk_type* results,
+  chunk_type* scratch,
+  size_t chunkSize,
+  float chunkReservedGB = 1.f)
+{
+  // The chunk is a sequence of rows of binned hits. Every hit reads the 3x3 neighbouring bins in the next row.
+  constexpr size_t rowSize = PatternGridNY * PatternGridNZ * PatternGridBinSize;
+  const chunk_type* ptr = getPartPtrOnScratch(scratch, chunkReservedGB, chunkId);
+  const size_t nHits = (chunkSize / rowSize - 1) * rowSize;
+  chunk_type sink{0};
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < nHits; i += blockDim.x * gridDim.x) {
+    const int bin = (i % rowSize) / PatternGridBinSize;
+    const int iy = bin % PatternGridNY;
+    const int iz = bin / PatternGridNY;
+    const int yMin = iy > 0 ? iy - 1 : 0;
+    const int yMax = iy < PatternGridNY - 1 ? iy + 1 : iy;
+    const int zMin = iz > 0 ? iz - 1 : 0;
+    const int zMax = iz < PatternGridNZ - 1 ? iz + 1 : iz;
+    const chunk_type* nextRow = ptr + (i / rowSize + 1) * rowSize;
+    for (int jz = zMin; jz <= zMax; jz++) {
+      const chunk_type* binPtr = nextRow + (jz * PatternGridNY + yMin) * PatternGridBinSize;
+      for (int k = 0; k < (yMax - yMin + 1) * PatternGridBinSize; k++) { // bins adjacent in y are contiguous
+        sink += binPtr[k];
+      }
+    }
+  }
+  if (sink == static_cast<chunk_type>(1)) {
+    results[chunkId] = sink;
+  }
+}
+
+template <class chunk_type>
+__global__ void randomReadChunkKernel(
+  int chunkId,
+  chunk_type* results,
+  chunk_type* scratch,
+  size_t chunkSize,
+  float chunkReservedGB = 1.f)
+{
+  // Every thread reads a full record at a random position of the chunk
+  constexpr size_t recordSize = PatternRecordSize / sizeof(chunk_type);
+  const chunk_type* ptr = getPartPtrOnScratch(scratch, chunkReservedGB, chunkId);
+  const size_t nRecords = chunkSize / recordSize;
+  chunk_type sink{0};
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < nRecords; i += blockDim.x * gridDim.x) {
+    const chunk_type* record = ptr + (hashIndex(i) % nRecords) * recordSize;
+    for (size_t k = 0; k < recordSize; k++) {
+      sink += record[k];
+    }
+  }
+  if (sink == static_cast<chunk_type>(1)) {
+    results[chunkId] = sink;
+  }
+}
+
 } // namespace gpu
 
+template <class chunk_type>
+auto getPatternKernel(Test test)
+{
+  switch (test) {
+    case Test::ScatterWrite:
+      return &gpu::scatterWriteChunkKernel<chunk_type>;
+    case Test::GridRead:
+      return &gpu::gridReadChunkKernel<chunk_type>;
+    default:
+      return &gpu::randomReadChunkKernel<chunk_type>;
+  }
+}
+
+std::string getTestName(Test test)
+{
+  switch (test) {
+    case Test::ScatterWrite:
+      return "scatter";
+    case Test::GridRead:
+      return "grid";
+    case Test::RandomRead:
+      return "random";
+    case Test::HostToDevice:
+      return "h2d";
+    case Test::DeviceToHost:
+      return "d2h";
+    default:
+      return "unknown";
+  }
+}
+
 void printDeviceProp(int deviceId)
 {
   const int w1 = 34;
@@ -350,6 +479,72 @@ std::vector<float> GPUbenchmark<chunk_type>::benchmarkAsync(void (*kernel)(int,
   return results;
 }
 
+template <class chunk_type>
+float GPUbenchmark<chunk_type>::benchmarkTransferSync(Test test, int nLaunches, int chunkId)
+{
+  cudaEvent_t start, stop;
+  GPUCHECK(cudaSetDevice(mOptions.deviceId));
+  GPUCHECK(cudaEventCreate(&start));
+  GPUCHECK(cudaEventCreate(&stop));
+
+  auto devicePtr = mState.partAddrOnHost[chunkId];
+  auto size = mState.getPartitionCapacity() * sizeof(chunk_type);
+  GPUCHECK(cudaEventRecord(start));
+  for (auto iLaunch{0}; iLaunch < nLaunches; ++iLaunch) {
+    if (test == Test::HostToDevice) {
+      GPUCHECK(cudaMemcpyAsync(devicePtr, mState.hostPinnedPtr, size, cudaMemcpyHostToDevice, 0));
+    } else {
+      GPUCHECK(cudaMemcpyAsync(mState.hostPinnedPtr, devicePtr, size, cudaMemcpyDeviceToHost, 0));
+    }
+  }
+  GPUCHECK(cudaEventRecord(stop));
+
+  GPUCHECK(cudaEventSynchronize(stop));
+  float milliseconds{0.f};
+  GPUCHECK(cudaEventElapsedTime(&milliseconds, start, stop));
+  GPUCHECK(cudaEventDestroy(start));
+  GPUCHECK(cudaEventDestroy(stop));
+
+  return milliseconds;
+}
+
+template <class chunk_type>
+std::vector<float> GPUbenchmark<chunk_type>::benchmarkTransferAsync(Test test, int nStreams, int nLaunches)
+{
+  std::vector<cudaEvent_t> starts(nStreams), stops(nStreams);
+  std::vector<cudaStream_t> streams(nStreams);
+  std::vector<float> results(nStreams);
+  GPUCHECK(cudaSetDevice(mOptions.deviceId));
+  for (auto iStream{0}; iStream < nStreams; ++iStream) { // one stream per chunk
+    GPUCHECK(cudaStreamCreate(&(streams.at(iStream))));
+    GPUCHECK(cudaEventCreate(&(starts[iStream])));
+    GPUCHECK(cudaEventCreate(&(stops[iStream])));
+  }
+
+  auto size = mState.getPartitionCapacity() * sizeof(chunk_type);
+  for (auto iStream{0}; iStream < nStreams; ++iStream) { // all streams share the same pinned host buffer
+    GPUCHECK(cudaEventRecord(starts[iStream], streams[iStream]));
+    for (auto iLaunch{0}; iLaunch < nLaunches; ++iLaunch) {
+      if (test == Test::HostToDevice) {
+        GPUCHECK(cudaMemcpyAsync(mState.partAddrOnHost[iStream], mState.hostPinnedPtr, size, cudaMemcpyHostToDevice, streams[iStream]));
+      } else {
+        GPUCHECK(cudaMemcpyAsync(mState.hostPinnedPtr, mState.partAddrOnHost[iStream], size, cudaMemcpyDeviceToHost, streams[iStream]));
+      }
+    }
+    GPUCHECK(cudaEventRecord(stops[iStream], streams[iStream]));
+  }
+
+  for (auto iStream{0}; iStream < nStreams; ++iStream) {
+    GPUCHECK(cudaEventSynchronize(stops[iStream]));
+    GPUCHECK(cudaEventElapsedTime(&(results.at(iStream)), starts[iStream], stops[iStream]));
+    GPUCHECK(cudaEventDestroy(starts[iStream]));
+    GPUCHECK(cudaEventDestroy(stops[iStream]));
+    GPUCHECK(cudaStreamDestroy(streams[iStream]));
+  }
+
+  return results;
+}
+
 template <class chunk_type>
 void GPUbenchmark<chunk_type>::printDevices()
 {
@@ -369,9 +564,9 @@ void GPUbenchmark<chunk_type>::globalInit()
   size_t free;
 
   // Fetch and store features
+  GPUCHECK(cudaSetDevice(mOptions.deviceId));
   GPUCHECK(cudaGetDeviceProperties(&props, mOptions.deviceId));
   GPUCHECK(cudaMemGetInfo(&free, &mState.totalMemory));
-  GPUCHECK(cudaSetDevice(mOptions.deviceId));
 
   mState.chunkReservedGB = mOptions.chunkReservedGB;
   mState.iterations = mOptions.kernelLaunches;
@@ -804,6 +999,129 @@ void GPUbenchmark<chunk_type>::copyFinalize()
   std::cout << "    └ done." << std::endl;
 }
 
+/// Access patterns
+template <class chunk_type>
+void GPUbenchmark<chunk_type>::patternInit()
+{
+  std::cout << ">>> Initializing access pattern benchmarks with \e[1m" << mOptions.nTests << "\e[0m runs and \e[1m" << mOptions.kernelLaunches << "\e[0m kernel launches" << std::endl;
+  mState.hostPatternResultsVector.resize(mState.getMaxChunks());
+  GPUCHECK(cudaSetDevice(mOptions.deviceId));
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&(mState.devicePatternResultsPtr)), mState.getMaxChunks() * sizeof(chunk_type)));
+}
+
+template <class chunk_type>
+void GPUbenchmark<chunk_type>::patternSequential(Test test)
+{
+  mResultWriter.get()->addBenchmarkEntry("seq_" + getTestName(test) + "_MB", getType<chunk_type>(), mState.getMaxChunks());
+  auto kernel = getPatternKernel<chunk_type>(test);
+  auto nBlocks{mState.nMultiprocessors};
+  auto nThreads{std::min(mState.nMaxThreadsPerDimension, mState.nMaxThreadsPerBlock)};
+  auto capacity{mState.getPartitionCapacity()};
+
+  for (auto measurement{0}; measurement < mOptions.nTests; ++measurement) {
+    std::cout << std::setw(2) << "    ├ (" << getType<chunk_type>() << ") Seq " << getTestName(test) << ", mult block (" << measurement + 1 << "/" << mOptions.nTests << "):";
+    for (auto iChunk{0}; iChunk < mState.getMaxChunks(); ++iChunk) {
+      auto result = benchmarkSync(kernel,
+                                  mState.getNKernelLaunches(),
+                                  nBlocks,
+                                  nThreads,
+                                  iChunk,
+                                  mState.devicePatternResultsPtr,
+                                  mState.scratchPtr,
+                                  capacity,
+                                  mState.chunkReservedGB);
+      mResultWriter.get()->storeBenchmarkEntry(iChunk, result);
+    }
+    mResultWriter.get()->snapshotBenchmark();
+    std::cout << "\033[1;32m complete\033[0m" << std::endl;
+  }
+}
+
+template <class chunk_type>
+void GPUbenchmark<chunk_type>::patternConcurrent(Test test)
+{
+  mResultWriter.get()->addBenchmarkEntry("conc_" + getTestName(test) + "_MB", getType<chunk_type>(), mState.getMaxChunks());
+  auto kernel = getPatternKernel<chunk_type>(test);
+  auto nBlocks{mState.nMultiprocessors};
+  auto nThreads{std::min(mState.nMaxThreadsPerDimension, mState.nMaxThreadsPerBlock)};
+  auto capacity{mState.getPartitionCapacity()};
+
+  for (auto measurement{0}; measurement < mOptions.nTests; ++measurement) {
+    std::cout << "    ├ (" << getType<chunk_type>() << ") Conc " << getTestName(test) << ", mult block (" << measurement + 1 << "/" << mOptions.nTests << "):";
+    auto results = benchmarkAsync(kernel,
+                                  mState.getMaxChunks(), // nStreams
+                                  mState.getNKernelLaunches(),
+                                  nBlocks,
+                                  nThreads,
+                                  mState.devicePatternResultsPtr, // kernel arguments (chunkId is passed by wrapper)
+                                  mState.scratchPtr,
+                                  capacity,
+                                  mState.chunkReservedGB);
+    for (auto iResult{0}; iResult < results.size(); ++iResult) {
+      mResultWriter.get()->storeBenchmarkEntry(iResult, results[iResult]);
+    }
+    mResultWriter.get()->snapshotBenchmark();
+    std::cout << "\033[1;32m complete\033[0m" << std::endl;
+  }
+}
+
+template <class chunk_type>
+void GPUbenchmark<chunk_type>::patternFinalize()
+{
+  GPUCHECK(cudaSetDevice(mOptions.deviceId));
+  GPUCHECK(cudaMemcpy(mState.hostPatternResultsVector.data(), mState.devicePatternResultsPtr, mState.getMaxChunks() * sizeof(chunk_type), cudaMemcpyDeviceToHost));
+  GPUCHECK(cudaFree(mState.devicePatternResultsPtr));
+  std::cout << "    └ done." << std::endl;
+}
+
+/// Transfers
+template <class chunk_type>
+void GPUbenchmark<chunk_type>::transferInit()
+{
+  std::cout << ">>> Initializing transfer benchmarks with \e[1m" << mOptions.nTests << "\e[0m runs and \e[1m" << mOptions.kernelLaunches << "\e[0m transfers" << std::endl;
+  GPUCHECK(cudaSetDevice(mOptions.deviceId));
+  GPUCHECK(cudaMallocHost(reinterpret_cast<void**>(&(mState.hostPinnedPtr)), mState.getPartitionCapacity() * sizeof(chunk_type)));
+  memset(mState.hostPinnedPtr, 1, mState.getPartitionCapacity() * sizeof(chunk_type)); // fault in all pages before measuring
+}
+
+template <class chunk_type>
+void GPUbenchmark<chunk_type>::transferSequential(Test test)
+{
+  mResultWriter.get()->addBenchmarkEntry("seq_" + getTestName(test) + "_DMA", getType<chunk_type>(), mState.getMaxChunks());
+  for (auto measurement{0}; measurement < mOptions.nTests; ++measurement) {
+    std::cout << std::setw(2) << "    ├ (" << getType<chunk_type>() << ") Seq " << getTestName(test) << " transfer (" << measurement + 1 << "/" << mOptions.nTests << "):";
+    for (auto iChunk{0}; iChunk < mState.getMaxChunks(); ++iChunk) {
+      auto result = benchmarkTransferSync(test, mState.getNKernelLaunches(), iChunk);
+      mResultWriter.get()->storeBenchmarkEntry(iChunk, result);
+    }
+    mResultWriter.get()->snapshotBenchmark();
+    std::cout << "\033[1;32m complete\033[0m" << std::endl;
+  }
+}
+
+template <class chunk_type>
+void GPUbenchmark<chunk_type>::transferConcurrent(Test test)
+{
+  mResultWriter.get()->addBenchmarkEntry("conc_" + getTestName(test) + "_DMA", getType<chunk_type>(), mState.getMaxChunks());
+  for (auto measurement{0}; measurement < mOptions.nTests; ++measurement) {
+    std::cout << "    ├ (" << getType<chunk_type>() << ") Conc " << getTestName(test) << " transfer (" << measurement + 1 << "/" << mOptions.nTests << "):";
+    auto results = benchmarkTransferAsync(test, mState.getMaxChunks(), mState.getNKernelLaunches());
+    for (auto iResult{0}; iResult < results.size(); ++iResult) {
+      mResultWriter.get()->storeBenchmarkEntry(iResult, results[iResult]);
+    }
+    mResultWriter.get()->snapshotBenchmark();
+    std::cout << "\033[1;32m complete\033[0m" << std::endl;
+  }
+}
+
+template <class chunk_type>
+void GPUbenchmark<chunk_type>::transferFinalize()
+{
+  GPUCHECK(cudaSetDevice(mOptions.deviceId));
+  GPUCHECK(cudaFreeHost(mState.hostPinnedPtr));
+  std::cout << "    └ done." << std::endl;
+}
+
 template <class chunk_type>
 void GPUbenchmark<chunk_type>::globalFinalize()
 {
@@ -859,7 +1177,45 @@ void GPUbenchmark<chunk_type>::run()
 
           break;
         }
+        default: // tests without split levels, run below
+          break;
+      }
+    }
+  }
+
+  for (auto& test : mOptions.tests) {
+    switch (test) {
+      case Test::ScatterWrite:
+      case Test::GridRead:
+      case Test::RandomRead: {
+        patternInit();
+        if (std::find(mOptions.modes.begin(), mOptions.modes.end(), Mode::Sequential) != mOptions.modes.end()) {
+          patternSequential(test);
+        }
+        if (std::find(mOptions.modes.begin(), mOptions.modes.end(), Mode::Concurrent) != mOptions.modes.end()) {
+          patternConcurrent(test);
+        }
+
+        patternFinalize();
+
+        break;
+      }
+      case Test::HostToDevice:
+      case Test::DeviceToHost: {
+        transferInit();
+        if (std::find(mOptions.modes.begin(), mOptions.modes.end(), Mode::Sequential) != mOptions.modes.end()) {
+          transferSequential(test);
+        }
+        if (std::find(mOptions.modes.begin(), mOptions.modes.end(), Mode::Concurrent) != mOptions.modes.end()) {
+          transferConcurrent(test);
+        }
+
+        transferFinalize();
+
+        break;
       }
+      default:
+        break;
     }
   }
 
@@ -134,6 +134,9 @@ class Spline1DContainer : public FlatObject
   template <SafetyLevel SafeT = SafetyLevel::kSafe>
   GPUd() int getLeftKnotIndexForU(DataT u) const;
 
+  /// Check if the knots are uniformly distributed, i.e. they are placed at u = 0,1,2,..,Umax
+  GPUd() bool isUniform() const { return mUmax == mNumberOfKnots - 1; }
+
   /// Get spline parameters
   GPUd() DataT* getParameters() { return mParameters; }
 
@@ -228,6 +231,14 @@ GPUdi() int Spline1DContainer<DataT>::getLeftKnotIndexForU(DataT u) const
   /// Get i: u is in [knot_i, knot_{i+1}) segment
   /// when u is otside of [0, mUmax], return a corresponding edge segment
   int iu = (int)u;
+  if (isUniform()) {
+    // for the uniform knots the knot index is the integer U itself, no need to read the map.
+    // U == Umax is mapped to the last segment, as in the map
+    if (SafeT == SafetyLevel::kSafe) {
+      iu = (iu < 0) ? 0 : iu;
+    }
+    return (iu < mUmax) ? iu : mUmax - 1;
+  }
   if (SafeT == SafetyLevel::kSafe) {
     iu = (iu < 0) ? 0 : (iu > mUmax ? mUmax : iu);
   }
@@ -22,6 +22,7 @@
 
 #if !defined(GPUCA_GPUCODE)
 #include <iostream>
+#include <cmath>
 #endif
 
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE) // code invisible on GPU and in the standalone compilation
@@ -189,6 +190,34 @@ void Spline2DContainer<DataT>::recreate(int nYdim,
   }
 }
 
+template <typename DataT>
+void Spline2DContainer<DataT>::quantizeParameters(int nYdim, const DataT Parameters[], short Q[], DataT Scales[]) const
+{
+  /// Quantize the spline parameters to 16 bits, see the declaration
+
+  const int nPar = 4 * nYdim;
+  const int nKnots = getNumberOfKnots();
+
+  for (int i = 0; i < nPar; i++) {
+    double maxAbs = 0.;
+    for (int iKnot = 0; iKnot < nKnots; iKnot++) {
+      double p = fabs((double)Parameters[iKnot * nPar + i]);
+      if (maxAbs < p) {
+        maxAbs = p;
+      }
+    }
+    Scales[i] = (maxAbs > 0.) ? maxAbs / 32767. : 1.;
+  }
+
+  for (int iKnot = 0; iKnot < nKnots; iKnot++) {
+    for (int i = 0; i < nPar; i++) {
+      double q = round(Parameters[iKnot * nPar + i] / (double)Scales[i]);
+      q = (q < -32767.) ? -32767. : (q > 32767. ? 32767. : q);
+      Q[iKnot * nPar + i] = (short)q;
+    }
+  }
+}
+
 #endif // GPUCA_GPUCODE
 
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE) // code invisible on GPU and in the standalone compilation
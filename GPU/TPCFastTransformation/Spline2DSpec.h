@@ -99,6 +99,12 @@ class Spline2DContainer : public FlatObject
   /// Size of the parameter array in bytes
   GPUd() size_t getSizeOfParameters() const { return sizeof(DataT) * this->getNumberOfParameters(); }
 
+  /// Size of the array of 16-bit quantized parameters in bytes
+  GPUd() size_t getSizeOfQuantizedParameters() const { return sizeof(short) * this->getNumberOfParameters(); }
+
+  /// Number of scales of the quantized parameters, one per parameter of a knot
+  GPUd() int getNumberOfQuantizationScales() const { return 4 * mYdim; }
+
   /// Get a number of knots
   GPUd() int getNumberOfKnots() const { return mGridX1.getNumberOfKnots() * mGridX2.getNumberOfKnots(); }
 
@@ -176,6 +182,20 @@ class Spline2DContainer : public FlatObject
   void setActualBufferAddress(char* actualFlatBufferPtr);
   void setFutureBufferAddress(char* futureFlatBufferPtr);
 
+  /// _____________  16-bit quantization of the parameters  ____________
+
+#if !defined(GPUCA_GPUCODE)
+  /// Quantize nYdim-dimensional spline parameters to 16 bits.
+  /// Each of the 4*nYdim parameters of a knot gets its own scale, chosen from the largest value over all the knots.
+  /// The parameters are then restored as Parameters[i] = Q[i] * Scales[i % (4*nYdim)].
+  ///
+  /// \param Parameters  [in]  parameters of size calcNumberOfParameters(nYdim)
+  /// \param Q           [out] quantized parameters of the same size
+  /// \param Scales      [out] scales, 4*nYdim values
+  ///
+  void quantizeParameters(int nYdim, const DataT Parameters[], short Q[], DataT Scales[]) const;
+#endif
+
  protected:
 #if !defined(GPUCA_GPUCODE)
   /// Constructor for a regular spline
@@ -245,6 +265,30 @@ class Spline2DSpec<DataT, YdimT, 0>
   GPUd() void interpolateU(int inpYdim, GPUgeneric() const DataT Parameters[],
                            DataT u1, DataT u2, GPUgeneric() DataT S[/*inpYdim*/]) const
   {
+    interpolateParametersU<SafeT>(inpYdim, Parameters, nullptr, u1, u2, S);
+  }
+
+  /// Get interpolated value for an inpYdim-dimensional S(u1,u2) using 16-bit quantized spline parameters.
+  /// The parameters and their scales are created by quantizeParameters()
+  template <SafetyLevel SafeT = SafetyLevel::kSafe>
+  GPUd() void interpolateU(int inpYdim, GPUgeneric() const short Parameters[], GPUgeneric() const DataT Scales[],
+                           DataT u1, DataT u2, GPUgeneric() DataT S[/*inpYdim*/]) const
+  {
+    interpolateParametersU<SafeT>(inpYdim, Parameters, Scales, u1, u2, S);
+  }
+
+ protected:
+  /// Get i-th parameter of a knot
+  GPUd() static DataT getParameter(GPUgeneric() const DataT par[], GPUgeneric() const DataT* /*Scales*/, int i) { return par[i]; }
+
+  /// Get i-th parameter of a knot, dequantized
+  GPUd() static DataT getParameter(GPUgeneric() const short par[], GPUgeneric() const DataT Scales[], int i) { return Scales[i] * par[i]; }
+
+  /// The interpolation for the float parameters or the quantized ones
+  template <SafetyLevel SafeT, typename ParT>
+  GPUd() void interpolateParametersU(int inpYdim, GPUgeneric() const ParT Parameters[], GPUgeneric() const DataT Scales[],
+                                     DataT u1, DataT u2, GPUgeneric() DataT S[/*inpYdim*/]) const
+  {
 
     const auto nYdimTmp = SplineUtil::getNdim<YdimT>(inpYdim);
     const int nYdim = nYdimTmp.get();
@@ -264,10 +308,10 @@ class Spline2DSpec<DataT, YdimT, 0>
     const typename TBase::Knot& knotU = mGridX1.template getKnot<SafetyLevel::kNotSafe>(iu);
     const typename TBase::Knot& knotV = mGridX2.template getKnot<SafetyLevel::kNotSafe>(iv);
 
-    const DataT* par00 = Parameters + (nu * iv + iu) * nYdim4; // values { {Y1,Y2,Y3}, {Y1,Y2,Y3}'v, {Y1,Y2,Y3}'u, {Y1,Y2,Y3}''vu } at {u0, v0}
-    const DataT* par10 = par00 + nYdim4;                       // values { ... } at {u1, v0}
-    const DataT* par01 = par00 + nYdim4 * nu;                  // values { ... } at {u0, v1}
-    const DataT* par11 = par01 + nYdim4;                       // values { ... } at {u1, v1}
+    const ParT* par00 = Parameters + (nu * iv + iu) * nYdim4; // values { {Y1,Y2,Y3}, {Y1,Y2,Y3}'v, {Y1,Y2,Y3}'u, {Y1,Y2,Y3}''vu } at {u0, v0}
+    const ParT* par10 = par00 + nYdim4;                       // values { ... } at {u1, v0}
+    const ParT* par01 = par00 + nYdim4 * nu;                  // values { ... } at {u0, v1}
+    const ParT* par11 = par01 + nYdim4;                       // values { ... } at {u1, v1}
 
     DataT Su0[maxYdim4]; // values { {Y1,Y2,Y3,Y1'v,Y2'v,Y3'v}(v0), {Y1,Y2,Y3,Y1'v,Y2'v,Y3'v}(v1) }, at u0
     DataT Du0[maxYdim4]; // derivatives {}'_u  at u0
@@ -275,17 +319,17 @@ class Spline2DSpec<DataT, YdimT, 0>
     DataT Du1[maxYdim4]; // derivatives {}'_u  at u1
 
     for (int i = 0; i < nYdim2; i++) {
-      Su0[i] = par00[i];
-      Su0[nYdim2 + i] = par01[i];
+      Su0[i] = getParameter(par00, Scales, i);
+      Su0[nYdim2 + i] = getParameter(par01, Scales, i);
 
-      Du0[i] = par00[nYdim2 + i];
-      Du0[nYdim2 + i] = par01[nYdim2 + i];
+      Du0[i] = getParameter(par00, Scales, nYdim2 + i);
+      Du0[nYdim2 + i] = getParameter(par01, Scales, nYdim2 + i);
 
-      Su1[i] = par10[i];
-      Su1[nYdim2 + i] = par11[i];
+      Su1[i] = getParameter(par10, Scales, i);
+      Su1[nYdim2 + i] = getParameter(par11, Scales, i);
 
-      Du1[i] = par10[nYdim2 + i];
-      Du1[nYdim2 + i] = par11[nYdim2 + i];
+      Du1[i] = getParameter(par10, Scales, nYdim2 + i);
+      Du1[nYdim2 + i] = getParameter(par11, Scales, nYdim2 + i);
     }
 
     DataT parU[maxYdim4]; // interpolated values { {Y1,Y2,Y3,Y1'v,Y2'v,Y3'v}(v0), {Y1,Y2,Y3,Y1'v,Y2'v,Y3'v}(v1) } at u
@@ -305,6 +349,70 @@ class Spline2DSpec<DataT, YdimT, 0>
     gridX2.interpolateU(nYdim, knotV, Sv0, Dv0, Sv1, Dv1, v, S);
   }
 
+#if !defined(__CINT__) && !defined(__ROOTCINT__) && !defined(GPUCA_GPUCODE) && !defined(GPUCA_NO_VC) && defined(__cplusplus) && __cplusplus >= 201703L
+  /// SIMD version of interpolateParametersU() for YdimT > 0.
+  /// All the Y dimensions are interpolated together: first along U1 for the two rows of knots,
+  /// where each row is a vector of the values and the V-derivatives {Y1,Y2,Y3,Y1'v,Y2'v,Y3'v}, then along U2.
+  template <SafetyLevel SafeT, typename ParT>
+  void interpolateParametersUvec(GPUgeneric() const ParT Parameters[], GPUgeneric() const DataT Scales[],
+                                 DataT u1, DataT u2, GPUgeneric() DataT S[/*YdimT*/]) const
+  {
+    static_assert(YdimT > 0, "the SIMD interpolation needs the number of Y dimensions at the compile time");
+
+    typedef Vc::SimdArray<DataT, 2 * YdimT> TRow; // {Y, Y'v} for all the dimensions
+    typedef Vc::SimdArray<DataT, YdimT> TY;       // Y for all the dimensions
+
+    const float& u = u1;
+    const float& v = u2;
+    int nu = mGridX1.getNumberOfKnots();
+    int iu = mGridX1.template getLeftKnotIndexForU<SafeT>(u);
+    int iv = mGridX2.template getLeftKnotIndexForU<SafeT>(v);
+
+    const typename TBase::Knot& knotU = mGridX1.template getKnot<SafetyLevel::kNotSafe>(iu);
+    const typename TBase::Knot& knotV = mGridX2.template getKnot<SafetyLevel::kNotSafe>(iv);
+
+    const ParT* par00 = Parameters + (nu * iv + iu) * 4 * YdimT;
+    const ParT* par10 = par00 + 4 * YdimT;
+    const ParT* par01 = par00 + 4 * YdimT * nu;
+    const ParT* par11 = par01 + 4 * YdimT;
+
+    // {Y, Y'v} and their U-derivatives at the 4 knots
+    TRow s00(par00, Vc::Unaligned), d00(par00 + 2 * YdimT, Vc::Unaligned);
+    TRow s10(par10, Vc::Unaligned), d10(par10 + 2 * YdimT, Vc::Unaligned);
+    TRow s01(par01, Vc::Unaligned), d01(par01 + 2 * YdimT, Vc::Unaligned);
+    TRow s11(par11, Vc::Unaligned), d11(par11 + 2 * YdimT, Vc::Unaligned);
+
+    if (Scales) {
+      const TRow scaleS(Scales, Vc::Unaligned), scaleD(Scales + 2 * YdimT, Vc::Unaligned);
+      s00 *= scaleS;
+      s10 *= scaleS;
+      s01 *= scaleS;
+      s11 *= scaleS;
+      d00 *= scaleD;
+      d10 *= scaleD;
+      d01 *= scaleD;
+      d11 *= scaleD;
+    }
+
+    typedef Spline1DSpec<DataT, 1, 0> TGrid;
+    const TGrid& gridX1 = reinterpret_cast<const TGrid&>(mGridX1);
+    const TGrid& gridX2 = reinterpret_cast<const TGrid&>(mGridX2);
+
+    DataT parU[4 * YdimT]; // { {Y, Y'v}(v0), {Y, Y'v}(v1) } at u
+    TRow rowV0, rowV1;
+    gridX1.interpolateU(1, knotU, &s00, &d00, &s10, &d10, u, &rowV0);
+    gridX1.interpolateU(1, knotU, &s01, &d01, &s11, &d11, u, &rowV1);
+    rowV0.store(parU, Vc::Unaligned);
+    rowV1.store(parU + 2 * YdimT, Vc::Unaligned);
+
+    TY sv0(parU, Vc::Unaligned), dv0(parU + YdimT, Vc::Unaligned);
+    TY sv1(parU + 2 * YdimT, Vc::Unaligned), dv1(parU + 3 * YdimT, Vc::Unaligned);
+    TY res;
+    gridX2.interpolateU(1, knotV, &sv0, &dv0, &sv1, &dv1, v, &res);
+    res.store(S, Vc::Unaligned);
+  }
+#endif
+
  protected:
   using TBase::mGridX1;
   using TBase::mGridX2;
@@ -381,6 +489,38 @@ class Spline2DSpec<DataT, YdimT, 1>
     TBase::template interpolateU<SafeT>(YdimT, Parameters, u1, u2, S);
   }
 
+  /// Get interpolated value for an YdimT-dimensional S(u1,u2) using 16-bit quantized spline parameters.
+  template <SafetyLevel SafeT = SafetyLevel::kSafe>
+  GPUd() void interpolateU(GPUgeneric() const short Parameters[], GPUgeneric() const DataT Scales[],
+                           DataT u1, DataT u2, GPUgeneric() DataT S[/*nYdim*/]) const
+  {
+    TBase::template interpolateU<SafeT>(YdimT, Parameters, Scales, u1, u2, S);
+  }
+
+  /// Same as interpolateU(), but all the Y dimensions are interpolated together with SIMD instructions, when available
+  template <SafetyLevel SafeT = SafetyLevel::kSafe>
+  GPUd() void interpolateUvec(GPUgeneric() const DataT Parameters[],
+                              DataT u1, DataT u2, GPUgeneric() DataT S[/*nYdim*/]) const
+  {
+#if !defined(__CINT__) && !defined(__ROOTCINT__) && !defined(GPUCA_GPUCODE) && !defined(GPUCA_NO_VC) && defined(__cplusplus) && __cplusplus >= 201703L
+    TBase::template interpolateParametersUvec<SafeT>(Parameters, nullptr, u1, u2, S);
+#else
+    TBase::template interpolateU<SafeT>(YdimT, Parameters, u1, u2, S);
+#endif
+  }
+
+  /// Same as interpolateU() for the quantized parameters, with SIMD instructions when available
+  template <SafetyLevel SafeT = SafetyLevel::kSafe>
+  GPUd() void interpolateUvec(GPUgeneric() const short Parameters[], GPUgeneric() const DataT Scales[],
+                              DataT u1, DataT u2, GPUgeneric() DataT S[/*nYdim*/]) const
+  {
+#if !defined(__CINT__) && !defined(__ROOTCINT__) && !defined(GPUCA_GPUCODE) && !defined(GPUCA_NO_VC) && defined(__cplusplus) && __cplusplus >= 201703L
+    TBase::template interpolateParametersUvec<SafeT>(Parameters, Scales, u1, u2, S);
+#else
+    TBase::template interpolateU<SafeT>(YdimT, Parameters, Scales, u1, u2, S);
+#endif
+  }
+
   using TBase::getNumberOfKnots;
 
   /// _______________  Suppress some parent class methods   ________________________
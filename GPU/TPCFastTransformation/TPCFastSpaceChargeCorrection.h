@@ -274,7 +274,7 @@ GPUdi() int TPCFastSpaceChargeCorrection::getCorrection(int slice, int row, floa
   su *= spline.getGridX1().getUmax();
   sv *= spline.getGridX2().getUmax();
   float dxuv[3];
-  spline.interpolateU(splineData, su, sv, dxuv);
+  spline.interpolateUvec(splineData, su, sv, dxuv);
   dx = dxuv[0];
   du = dxuv[1];
   dv = dxuv[2];
@@ -131,6 +131,12 @@ class TPCFastTransform : public FlatObject
   ///
   GPUd() void Transform(int slice, int row, float pad, float time, float& x, float& y, float& z, float vertexTime = 0) const;
 
+  /// Same as Transform() for n clusters of the same slice and row.
+  /// The slice and row constants are computed only once, and the parts of the transformation
+  /// which do not depend on the correction map are done in simple loops, which can be vectorised.
+  /// In a GPU kernel, each of the nThreads threads transforms the clusters iThread, iThread + nThreads, ...
+  GPUd() void TransformRow(int slice, int row, const float* GPUrestrict() pad, const float* GPUrestrict() time, float* GPUrestrict() x, float* GPUrestrict() y, float* GPUrestrict() z, int n, float vertexTime = 0, int iThread = 0, int nThreads = 1) const;
+
   /// Transformation in the time frame
   GPUd() void TransformInTimeFrame(int slice, int row, float pad, float time, float& x, float& y, float& z, float maxTimeBin) const;
 
@@ -383,6 +389,59 @@ GPUdi() void TPCFastTransform::Transform(int slice, int row, float pad, float ti
   z += dzTOF;
 }
 
+GPUdi() void TPCFastTransform::TransformRow(int slice, int row, const float* GPUrestrict() pad, const float* GPUrestrict() time, float* GPUrestrict() x, float* GPUrestrict() y, float* GPUrestrict() z, int n, float vertexTime, int iThread, int nThreads) const
+{
+  /// _______________ Cluster transformation for a whole row _______________________
+  ///
+  /// Gives the same results as Transform() for each cluster.
+  /// u and v are kept in y and z until they are converted to the local c.s.
+  ///
+
+  const TPCFastTransformGeo& geo = getGeometry();
+  const TPCFastTransformGeo::RowInfo& rowInfo = geo.getRowInfo(row);
+  const TPCFastTransformGeo::SliceInfo& sliceInfo = geo.getSliceInfo(slice);
+  const bool sideC = (slice >= geo.getNumberOfSlicesA());
+
+  const float rowX = rowInfo.x;
+  const double padOffset = 0.5 * rowInfo.maxPad;
+  const float padWidth = rowInfo.padWidth;
+  const float cosAlpha = sideC ? -sliceInfo.cosAlpha : sliceInfo.cosAlpha; // pads are mirrorred on C-side
+  const float xSinAlpha = rowX * sliceInfo.sinAlpha;
+
+  for (int i = iThread; i < n; i += nThreads) {
+    float u = (pad[i] - padOffset) * padWidth;
+    float yLab = u * cosAlpha + xSinAlpha;
+    x[i] = rowX;
+    y[i] = u;
+    z[i] = (time[i] - mT0 - vertexTime) * (mVdrift + mVdriftCorrY * yLab) + mLdriftCorr; // drift length cm
+  }
+
+  if (mApplyCorrection) {
+    const TPCFastSpaceChargeCorrection::SplineType& spline = mCorrection.getSpline(slice, row);
+    const float* splineData = mCorrection.getSplineData(slice, row);
+    const float scaleU = spline.getGridX1().getUmax();
+    const float scaleV = spline.getGridX2().getUmax();
+    for (int i = iThread; i < n; i += nThreads) {
+      float su = 0, sv = 0;
+      geo.convUVtoScaledUV(slice, row, y[i], z[i], su, sv);
+      float dxuv[3];
+      spline.interpolateU(splineData, su * scaleU, sv * scaleV, dxuv);
+      x[i] += dxuv[0];
+      y[i] += dxuv[1];
+      z[i] += dxuv[2];
+    }
+  }
+
+  for (int i = iThread; i < n; i += nThreads) {
+    float ly = 0, lz = 0;
+    geo.convUVtoLocal(slice, y[i], z[i], ly, lz);
+    float dzTOF = 0;
+    getTOFcorrection(slice, row, x[i], ly, lz, dzTOF);
+    y[i] = ly;
+    z[i] = lz + dzTOF;
+  }
+}
+
 GPUdi() void TPCFastTransform::TransformInTimeFrame(int slice, int row, float pad, float time, float& x, float& y, float& z, float maxTimeBin) const
 {
   /// _______________ Special cluster transformation for a time frame _______________________
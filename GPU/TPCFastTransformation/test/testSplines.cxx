@@ -19,6 +19,8 @@
 #include <boost/test/unit_test.hpp>
 #include "Spline1D.h"
 #include "Spline2D.h"
+#include <cmath>
+#include <vector>
 
 namespace o2::gpu
 {
@@ -33,4 +35,34 @@ BOOST_AUTO_TEST_CASE(Spline_test1)
   int err2 = o2::gpu::Spline2D<float>::test(0);
   BOOST_CHECK_MESSAGE(err2 == 0, "test of GPU/TPCFastTransform/Spline2D failed with the error code " << err2);
 }
+
+/// @brief The SIMD and the quantized interpolations follow the default one
+BOOST_AUTO_TEST_CASE(Spline_test2)
+{
+  auto F = [&](double x1, double x2, double f[]) {
+    f[0] = sin(x1) * cos(x2);
+    f[1] = 1. + x1 * x2;
+    f[2] = 0.01 * x1 * x1 - x2;
+  };
+  o2::gpu::Spline2D<float, 3> spline(7, 5);
+  BOOST_CHECK(spline.getGridX1().isUniform() && spline.getGridX2().isUniform());
+  spline.approximateFunction(0., 3., -1., 1., F);
+
+  std::vector<short> q(spline.getNumberOfParameters());
+  std::vector<float> scales(spline.getNumberOfQuantizationScales());
+  spline.quantizeParameters(3, spline.getParameters(), q.data(), scales.data());
+
+  for (float u = -0.5; u <= spline.getGridX1().getUmax() + 0.5; u += 0.13) {
+    for (float v = -0.5; v <= spline.getGridX2().getUmax() + 0.5; v += 0.17) {
+      float s[3], sVec[3], sQ[3];
+      spline.interpolateU(spline.getParameters(), u, v, s);
+      spline.interpolateUvec(spline.getParameters(), u, v, sVec);
+      spline.interpolateUvec(q.data(), scales.data(), u, v, sQ);
+      for (int dim = 0; dim < 3; dim++) {
+        BOOST_CHECK_SMALL(sVec[dim] - s[dim], 1.e-5f);
+        BOOST_CHECK_SMALL(sQ[dim] - s[dim], 1.e-3f);
+      }
+    }
+  }
+}
 } // namespace o2::gpu
@@ -22,6 +22,7 @@
 #include <memory>
 #include <cstring>
 #include <cassert>
+#include <vector>
 #endif
 
 #include "GPUCommonDef.h"
@@ -289,6 +290,34 @@ class FlatObject
   /// read a child class object from the file
   template <class T, class TFile>
   static T* readFromFile(TFile& inpf, const char* name);
+
+  /// Header of a flat image of an object: a bit-wise copy of the child class object, followed by its flat buffer.
+  /// Unlike the ROOT streaming, an image is restored with a single copy and a relocation of the buffer.
+  struct FlatImageHeader {
+    static constexpr char sMagic[8] = {'F', 'L', 'A', 'T', 'I', 'M', 'G', '\0'};
+    static constexpr unsigned int sVersion = 1;
+    char magic[8] = {'F', 'L', 'A', 'T', 'I', 'M', 'G', '\0'};
+    unsigned int version = sVersion;
+    unsigned int headerSize = sizeof(FlatImageHeader);
+    unsigned long long objectSize = 0;   ///< size of the class object
+    unsigned long long bufferOffset = 0; ///< offset of the flat buffer from the beginning of the image
+    unsigned long long bufferSize = 0;   ///< size of the flat buffer
+    char className[104] = {0};           ///< ROOT class name of the object
+  };
+
+  /// create a flat image of a child class object
+  template <class T>
+  static std::vector<char> createFlatImage(const T& obj);
+
+  /// restore a child class object from its flat image, nullptr is returned if the image does not correspond to T.
+  /// The flat buffer is copied to buffer, which has to hold at least FlatImageHeader::bufferSize bytes
+  /// aligned to getBufferAlignmentBytes(), and stays owned by the caller (i.e. for a buffer in shared memory).
+  /// If buffer is nullptr, the object owns a new internal buffer.
+  template <class T>
+  static T* readFromFlatImage(const char* image, size_t size, char* buffer = nullptr);
+
+  /// read the header of a flat image, returns false if the image is not consistent
+  static bool readFlatImageHeader(const char* image, size_t size, FlatImageHeader& header);
 #endif
 
 #if !defined(GPUCA_GPUCODE) // code invisible on GPU
@@ -514,6 +543,71 @@ inline T* FlatObject::readFromFile(TFile& inpf, const char* name)
   pobj->setActualBufferAddress(pobj->mFlatBufferContainer);
   return pobj;
 }
+
+template <class T>
+inline std::vector<char> FlatObject::createFlatImage(const T& obj)
+{
+  /// create the flat image of the object
+  assert(obj.isConstructed());
+
+  FlatImageHeader header;
+  strncpy(header.className, T::Class_Name(), sizeof(header.className) - 1);
+  header.objectSize = sizeof(T);
+  header.bufferOffset = alignSize(sizeof(FlatImageHeader) + sizeof(T), getBufferAlignmentBytes());
+  header.bufferSize = obj.mFlatBufferSize;
+
+  std::vector<char> image(header.bufferOffset + header.bufferSize, 0);
+  std::memcpy(image.data(), &header, sizeof(FlatImageHeader));
+  std::memcpy(image.data() + sizeof(FlatImageHeader), (const void*)&obj, sizeof(T));
+  std::memcpy(image.data() + header.bufferOffset, obj.mFlatBufferPtr, obj.mFlatBufferSize);
+  return image;
+}
+
+inline bool FlatObject::readFlatImageHeader(const char* image, size_t size, FlatImageHeader& header)
+{
+  if (image == nullptr || size < sizeof(FlatImageHeader)) {
+    return false;
+  }
+  std::memcpy(&header, image, sizeof(FlatImageHeader));
+  return std::memcmp(header.magic, FlatImageHeader::sMagic, sizeof(header.magic)) == 0 && header.version == FlatImageHeader::sVersion &&
+         header.headerSize == sizeof(FlatImageHeader) && header.bufferOffset >= sizeof(FlatImageHeader) + header.objectSize &&
+         header.bufferOffset + header.bufferSize == size;
+}
+
+template <class T>
+inline T* FlatObject::readFromFlatImage(const char* image, size_t size, char* buffer)
+{
+  /// restore the object from its flat image
+  FlatImageHeader header;
+  if (!readFlatImageHeader(image, size, header)) {
+    LOG(ERROR) << "Failed to read a flat image: inconsistent header";
+    return nullptr;
+  }
+  if (header.objectSize != sizeof(T) || strncmp(header.className, T::Class_Name(), sizeof(header.className)) != 0) {
+    LOG(ERROR) << "Failed to read a flat image: it contains a " << header.className << " instead of a " << T::Class_Name();
+    return nullptr;
+  }
+  if (buffer != nullptr && reinterpret_cast<size_t>(buffer) % getBufferAlignmentBytes() != 0) {
+    LOG(ERROR) << "Failed to read a flat image: the provided buffer is not aligned";
+    return nullptr;
+  }
+
+  bool isBufferInternal = buffer == nullptr;
+  if (isBufferInternal) {
+    buffer = new char[header.bufferSize];
+  }
+  std::memcpy(buffer, image + header.bufferOffset, header.bufferSize);
+
+  // the object is bit-wise ported, then its pointers are relocated to the new buffer
+  T* pobj = new T();
+  std::memcpy((void*)pobj, image + sizeof(FlatImageHeader), sizeof(T));
+  pobj->FlatObject::clearInternalBufferPtr();
+  pobj->setActualBufferAddress(buffer);
+  if (isBufferInternal) {
+    pobj->FlatObject::adoptInternalBuffer(buffer);
+  }
+  return pobj;
+}
 #endif // GPUCA_GPUCODE || GPUCA_STANDALONE
 
 #ifndef GPUCA_GPUCODE_DEVICE
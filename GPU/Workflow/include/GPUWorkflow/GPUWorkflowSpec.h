@@ -41,6 +41,7 @@ struct Config {
   bool outputTracks = false;
   bool outputCompClusters = false;
   bool outputCompClustersFlat = false;
+  bool outputCTF = false; // entropy-encode the compressed clusters to the TPC CTF within the processor
   bool outputCAClusters = false;
   bool outputQA = false;
   bool outputSharedClusterMap = false;
@@ -34,6 +34,7 @@
 #include "DataFormatsTPC/WorkflowHelper.h"
 #include "TPCReconstruction/TPCTrackingDigitsPreCheck.h"
 #include "TPCReconstruction/TPCFastTransformHelperO2.h"
+#include "TPCReconstruction/CTFCoder.h"
 #include "DataFormatsTPC/Digit.h"
 #include "TPCFastTransform.h"
 #include "TPCdEdxCalibrationSplines.h"
@@ -72,6 +73,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <unistd.h>
 #include <chrono>
 #include "GPUReconstructionConvert.h"
 #include "DetectorsRaw/RDHUtils.h"
@@ -112,6 +114,7 @@ DataProcessorSpec getGPURecoWorkflowSpec(gpuworkflow::CompletionPolicyData* poli
     std::unique_ptr<GPUO2InterfaceConfiguration> config;
     int qaTaskMask = 0;
     std::unique_ptr<GPUO2InterfaceQA> qa;
+    std::unique_ptr<o2::tpc::CTFCoder> ctfCoder;
     std::vector<int> clusterOutputIds;
     unsigned long outputBufferSize = 0;
     unsigned long tpcSectorMask = 0;
@@ -203,14 +206,14 @@ DataProcessorSpec getGPURecoWorkflowSpec(gpuworkflow::CompletionPolicyData* poli
       }
 
       // Configure the "GPU workflow" i.e. which steps we run on the GPU (or CPU)
-      if (specconfig.outputTracks || specconfig.outputCompClusters || specconfig.outputCompClustersFlat) {
+      if (specconfig.outputTracks || specconfig.outputCompClusters || specconfig.outputCompClustersFlat || specconfig.outputCTF) {
         config.configWorkflow.steps.set(GPUDataTypes::RecoStep::TPCConversion,
                                         GPUDataTypes::RecoStep::TPCSliceTracking,
                                         GPUDataTypes::RecoStep::TPCMerging);
         config.configWorkflow.outputs.set(GPUDataTypes::InOutType::TPCMergedTracks);
         config.configWorkflow.steps.setBits(GPUDataTypes::RecoStep::TPCdEdx, !confParam.synchronousProcessing);
       }
-      if (specconfig.outputCompClusters || specconfig.outputCompClustersFlat) {
+      if (specconfig.outputCompClusters || specconfig.outputCompClustersFlat || specconfig.outputCTF) {
         config.configWorkflow.steps.setBits(GPUDataTypes::RecoStep::TPCCompression, true);
         config.configWorkflow.outputs.setBits(GPUDataTypes::InOutType::TPCCompressedClusters, true);
       }
@@ -233,6 +236,17 @@ DataProcessorSpec getGPURecoWorkflowSpec(gpuworkflow::CompletionPolicyData* poli
       if (specconfig.outputSharedClusterMap) {
         config.configProcessing.outputSharedClusterMap = true;
       }
+      if (specconfig.outputCTF) {
+        // The compressed clusters are entropy-encoded right here from the buffers the GPU chain filled,
+        // the dictionaries are loaded once
+        processAttributes->ctfCoder = std::make_unique<o2::tpc::CTFCoder>();
+        processAttributes->ctfCoder->setCombineColumns(!ic.options().get<bool>("no-ctf-columns-combining"));
+        processAttributes->ctfCoder->setNThreads(ic.options().get<int>("ctf-nthreads"));
+        std::string dictPath = ic.options().get<std::string>("ctf-dict");
+        if (!dictPath.empty() && dictPath != "none") {
+          processAttributes->ctfCoder->createCoders(dictPath, o2::ctf::CTFCoderBase::OpType::Encoder);
+        }
+      }
       config.configProcessing.createO2Output = specconfig.outputTracks ? 2 : 0; // Skip GPU-formatted output if QA is not requested
 
       // Create and forward data objects for TPC transformation, material LUT, ...
@@ -240,7 +254,25 @@ DataProcessorSpec getGPURecoWorkflowSpec(gpuworkflow::CompletionPolicyData* poli
         processAttributes->fastTransform = nullptr;
         config.configCalib.fastTransform = TPCFastTransform::loadFromFile(confParam.transformationFile.c_str());
       } else {
-        processAttributes->fastTransform = std::move(TPCFastTransformHelperO2::instance()->create(0));
+        const auto& cacheFile = confParam.transformationCacheFile;
+        if (cacheFile.size() && std::filesystem::exists(cacheFile)) {
+          LOG(INFO) << "Loading the TPC fast transformation from the cache " << cacheFile;
+          processAttributes->fastTransform.reset(TPCFastTransform::loadFromFile(cacheFile));
+        }
+        if (!processAttributes->fastTransform) {
+          processAttributes->fastTransform = std::move(TPCFastTransformHelperO2::instance()->create(0));
+          if (cacheFile.size() && processAttributes->fastTransform) {
+            // several workflows may start at the same time, so the cache is written under a temporary name and renamed
+            std::string tmpFile = cacheFile + ".tmp" + std::to_string(getpid());
+            std::error_code ec;
+            if (processAttributes->fastTransform->writeToFile(tmpFile) == 0 && (std::filesystem::rename(tmpFile, cacheFile, ec), !ec)) {
+              LOG(INFO) << "Stored the TPC fast transformation in the cache " << cacheFile;
+            } else {
+              LOG(WARN) << "Could not store the TPC fast transformation in the cache " << cacheFile;
+              std::filesystem::remove(tmpFile, ec);
+            }
+          }
+        }
         config.configCalib.fastTransform = processAttributes->fastTransform.get();
       }
       if (config.configCalib.fastTransform == nullptr) {
@@ -684,6 +716,19 @@ DataProcessorSpec getGPURecoWorkflowSpec(gpuworkflow::CompletionPolicyData* poli
         pc.outputs().snapshot(Output{gDataOriginTPC, "COMPCLUSTERS", 0}, ROOTSerialized<CompressedClustersROOT const>(compressedClusters));
       }
 
+      if (specconfig.outputCTF) {
+        CompressedClusters compressedClusters;
+        if (ptrs.tpcCompressedClusters) {
+          compressedClusters = *ptrs.tpcCompressedClusters;
+        }
+        auto& buffer = pc.outputs().make<std::vector<o2::ctf::BufferType>>(Output{gDataOriginTPC, "CTFDATA", 0, Lifetime::Timeframe});
+        processAttributes->ctfCoder->encode(buffer, compressedClusters);
+        auto encodedBlocks = o2::tpc::CTF::get(buffer.data());
+        encodedBlocks->compactify();
+        buffer.resize(encodedBlocks->size());
+        LOG(INFO) << "Created encoded data of size " << encodedBlocks->size() << " for TPC";
+      }
+
       if (processAttributes->clusterOutputIds.size() > 0) {
         ClusterNativeAccess const& accessIndex = *ptrs.clustersNative;
         if (specconfig.sendClustersPerSector) {
@@ -806,6 +851,9 @@ DataProcessorSpec getGPURecoWorkflowSpec(gpuworkflow::CompletionPolicyData* poli
     if (specconfig.outputCompClustersFlat) {
       outputSpecs.emplace_back(gDataOriginTPC, "COMPCLUSTERSFLAT", 0, Lifetime::Timeframe);
     }
+    if (specconfig.outputCTF) {
+      outputSpecs.emplace_back(gDataOriginTPC, "CTFDATA", 0, Lifetime::Timeframe);
+    }
     if (specconfig.outputCAClusters) {
       for (auto const& sector : tpcsectors) {
         processAttributes->clusterOutputIds.emplace_back(sector);
@@ -838,9 +886,20 @@ DataProcessorSpec getGPURecoWorkflowSpec(gpuworkflow::CompletionPolicyData* poli
     return std::move(outputSpecs);
   };
 
+  auto createOptions = [&specconfig]() {
+    Options options;
+    if (specconfig.outputCTF) {
+      options.emplace_back(ConfigParamSpec{"ctf-dict", VariantType::String, o2::base::NameConf::getCTFDictFileName(), {"File of CTF encoding dictionary"}});
+      options.emplace_back(ConfigParamSpec{"no-ctf-columns-combining", VariantType::Bool, false, {"Do not combine correlated columns in CTF"}});
+      options.emplace_back(ConfigParamSpec{"ctf-nthreads", VariantType::Int, 1, {"Number of threads for the entropy encoding of the CTF blocks"}});
+    }
+    return options;
+  };
+
   return DataProcessorSpec{processorName, // process id
                            {createInputSpecs()},
                            {createOutputSpecs()},
-                           AlgorithmSpec(initFunction)};
+                           AlgorithmSpec(initFunction),
+                           createOptions()};
 }
 } // namespace o2::gpu
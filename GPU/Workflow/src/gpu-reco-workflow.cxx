@@ -39,7 +39,7 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
 
   std::vector<ConfigParamSpec> options{
     {"input-type", VariantType::String, "digits", {"digitizer, digits, zsraw, zsonthefly, clustersnative, compressed-clusters-root, compressed-clusters-ctf, trd-tracklets"}},
-    {"output-type", VariantType::String, "tracks", {"clustersnative, tracks, compressed-clusters-ctf, qa, no-shared-cluster-map"}},
+    {"output-type", VariantType::String, "tracks", {"clustersnative, tracks, compressed-clusters-ctf, encoded-clusters, qa, no-shared-cluster-map"}},
     {"disable-root-input", VariantType::Bool, true, {"disable root-files input reader"}},
     {"disable-mc", VariantType::Bool, false, {"disable sending of MC information"}},
     {"ignore-dist-stf", VariantType::Bool, false, {"do not subscribe to FLP/DISTSUBTIMEFRAME/0 message (no lost TF recovery)"}},
@@ -73,6 +73,7 @@ enum struct ioType { Digits,
                      ZSRawOTF,
                      CompClustROOT,
                      CompClustCTF,
+                     EncodedClusters,
                      Tracks,
                      QA,
                      TRDTracklets,
@@ -91,6 +92,7 @@ static const std::unordered_map<std::string, ioType> OutputMap{
   {"clusters", ioType::Clusters},
   {"tracks", ioType::Tracks},
   {"compressed-clusters-ctf", ioType::CompClustCTF},
+  {"encoded-clusters", ioType::EncodedClusters},
   {"qa", ioType::QA},
   {"no-shared-cluster-map", ioType::NoSharedMap}};
 
@@ -128,6 +130,7 @@ WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
   cfg.outputTracks = isEnabled(outputTypes, ioType::Tracks);
   cfg.outputCompClusters = isEnabled(outputTypes, ioType::CompClustROOT);
   cfg.outputCompClustersFlat = isEnabled(outputTypes, ioType::CompClustCTF);
+  cfg.outputCTF = isEnabled(outputTypes, ioType::EncodedClusters);
   cfg.outputCAClusters = isEnabled(outputTypes, ioType::Clusters);
   cfg.outputQA = isEnabled(outputTypes, ioType::QA);
   cfg.outputSharedClusterMap = (cfg.outputCAClusters || cfg.caClusterer || isEnabled(inputTypes, ioType::Clusters)) && cfg.outputTracks && !isEnabled(outputTypes, ioType::NoSharedMap);
@@ -0,0 +1,122 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_EVENTGEN_EVENTREADAHEAD_H_
+#define ALICEO2_EVENTGEN_EVENTREADAHEAD_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace o2
+{
+namespace eventgen
+{
+
+/*****************************************************************/
+/*****************************************************************/
+
+// this class reads the events of an input file on a background
+// thread, into a bounded queue, so that the decompression and the
+// parsing of the next events overlap with the use of the current one.
+// The reader function is only ever called from the background thread.
+
+template <typename T>
+class EventReadAhead
+{
+
+ public:
+  /** the reader fills the next event, returns false at the end of the input **/
+  using Reader = std::function<bool(T& event)>;
+
+  /** constructor, starts reading up to depth events ahead **/
+  EventReadAhead(Reader reader, size_t depth) : mReader(std::move(reader)), mDepth(depth > 0 ? depth : 1)
+  {
+    mThread = std::thread(&EventReadAhead::readEvents, this);
+  }
+  /** destructor, stops the reading **/
+  ~EventReadAhead()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCondition.notify_all();
+    mThread.join();
+  }
+
+  /** moves the next event to event, waiting for it to be read if needed
+      @return false if there are no more events **/
+  bool next(T& event)
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this]() { return !mEvents.empty() || mDone; });
+    if (mEvents.empty()) {
+      return false;
+    }
+    event = std::move(mEvents.front());
+    mEvents.pop_front();
+    lock.unlock();
+    mCondition.notify_all();
+    return true;
+  }
+
+ private:
+  EventReadAhead(const EventReadAhead&) = delete;
+  EventReadAhead& operator=(const EventReadAhead&) = delete;
+
+  void readEvents()
+  {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return mStop || mEvents.size() < mDepth; });
+        if (mStop) {
+          break;
+        }
+      }
+      T event{};
+      if (!mReader(event)) {
+        break;
+      }
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEvents.push_back(std::move(event));
+      }
+      mCondition.notify_all();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mDone = true;
+    }
+    mCondition.notify_all();
+  }
+
+  Reader mReader;
+  size_t mDepth;
+  std::deque<T> mEvents;
+  bool mStop = false;
+  bool mDone = false;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::thread mThread;
+
+}; /** class EventReadAhead **/
+
+/*****************************************************************/
+/*****************************************************************/
+
+} // namespace eventgen
+} // namespace o2
+
+#endif /* ALICEO2_EVENTGEN_EVENTREADAHEAD_H_ */
@@ -69,6 +69,21 @@ class Generator : public FairGenerator
 	**/
   Bool_t ReadEvent(FairPrimaryGenerator* primGen) final;
 
+  /** Runs the generate-and-trigger loop for the next event, without
+      handing the particles to the FairPrimaryGenerator: the next call to
+      ReadEvent uses them. Since it only draws from the random numbers of
+      the generator (see setEventSeed), it can be called ahead of ReadEvent,
+      concurrently for distinct instances.
+	*@return kTRUE if successful, kFALSE if not
+	**/
+  Bool_t prepareEvent();
+
+  /** Reseeds the random number generator owned by the generator, so that
+      the next event only depends on the seed.
+	*@return kFALSE if the generator has no random number generator of its own
+	**/
+  virtual Bool_t setEventSeed(UInt_t seed) { return kFALSE; };
+
   /** methods to override **/
   virtual Bool_t generateEvent() = 0;
   virtual Bool_t importParticles() = 0;
@@ -122,7 +137,8 @@ class Generator : public FairGenerator
   // a trigger was ok nor not
   std::function<void(std::vector<TParticle> const& p, int eventCount)> mTriggerOkHook = [](std::vector<TParticle> const& p, int eventCount) {};
   std::function<void(std::vector<TParticle> const& p, int eventCount)> mTriggerFalseHook = [](std::vector<TParticle> const& p, int eventCount) {};
-  int mReadEventCounter = 0; // counting the number of times
+  int mReadEventCounter = 0;   // counting the number of times
+  bool mEventPrepared = false; //! whether the particles of the next event were prepared already
 
   /** conversion data members **/
   double mMomentumUnit = 1.;        // [GeV/c]
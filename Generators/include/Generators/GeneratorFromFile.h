@@ -16,6 +16,9 @@
 
 #include "FairGenerator.h"
 #include "Generators/Generator.h"
+#include "SimulationDataFormat/MCTrack.h"
+#include <memory>
+#include <vector>
 
 class TBranch;
 class TFile;
@@ -25,6 +28,9 @@ namespace o2
 {
 namespace eventgen
 {
+template <typename T>
+class EventReadAhead;
+
 /// This class implements a generic FairGenerator which
 /// reads the particles from an external file
 /// at the moment, this only supports reading from an AliRoot kinematics file
@@ -65,8 +71,9 @@ class GeneratorFromFile : public FairGenerator
 class GeneratorFromO2Kine : public o2::eventgen::Generator
 {
  public:
-  GeneratorFromO2Kine() = default;
+  GeneratorFromO2Kine();
   GeneratorFromO2Kine(const char* name);
+  ~GeneratorFromO2Kine() override;
 
   bool Init() override;
 
@@ -92,6 +99,8 @@ class GeneratorFromO2Kine : public o2::eventgen::Generator
   int mEventsAvailable = 0;
   bool mSkipNonTrackable = true; //! whether to pass non-trackable (decayed particles) to the MC stack
   bool mContinueMode = false;    //! whether we want to continue simulation of previously inhibited tracks
+  std::vector<o2::MCTrack> mTracks; //! the tracks of the current event
+  std::unique_ptr<EventReadAhead<std::vector<o2::MCTrack>>> mReadAhead; //! reads the next events on a background thread
   ClassDefOverride(GeneratorFromO2Kine, 1);
 };
 
@@ -31,6 +31,7 @@ namespace eventgen
 struct GeneratorFromO2KineParam : public o2::conf::ConfigurableParamHelper<GeneratorFromO2KineParam> {
   bool skipNonTrackable = true;
   bool continueMode = false;
+  int readAhead = 0; // number of events read ahead on a background thread, 0 to read them on demand
   O2ParamDef(GeneratorFromO2KineParam, "GeneratorFromO2Kine");
 };
 
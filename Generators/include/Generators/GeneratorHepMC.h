@@ -16,6 +16,8 @@
 
 #include "Generators/Generator.h"
 #include <fstream>
+#include <memory>
+#include <vector>
 
 #ifdef GENERATORS_WITH_HEPMC3_DEPRECATED
 namespace HepMC
@@ -38,6 +40,9 @@ namespace o2
 namespace eventgen
 {
 
+template <typename T>
+class EventReadAhead;
+
 /*****************************************************************/
 /*****************************************************************/
 
@@ -62,6 +67,8 @@ class GeneratorHepMC : public Generator
   /** setters **/
   void setVersion(Int_t val) { mVersion = val; };
   void setFileName(std::string val) { mFileName = val; };
+  void setStartEvent(Int_t val) { mStartEvent = val; };
+  void setReadAhead(Int_t val) { mReadAhead = val; };
 
  protected:
   /** copy constructor **/
@@ -75,17 +82,25 @@ class GeneratorHepMC : public Generator
 #else
   const HepMC3::FourVector getBoostedVector(const HepMC3::FourVector& vector, Double_t boost);
 #endif
+  Bool_t seekStartEvent();
+#ifndef GENERATORS_WITH_HEPMC3_DEPRECATED
+  Bool_t readEvent(HepMC3::GenEvent& event);
+#endif
 
   /** HepMC interface **/
   std::ifstream mStream; //!
   std::string mFileName;
   Int_t mVersion;
+  Int_t mStartEvent = 0;
+  Int_t mReadAhead = 0;
+  std::vector<std::streampos> mEventOffsets; //! positions of the events in the file
 #ifdef GENERATORS_WITH_HEPMC3_DEPRECATED
   HepMC::Reader* mReader;  //!
   HepMC::GenEvent* mEvent; //!
 #else
   HepMC3::Reader* mReader;  //!
   HepMC3::GenEvent* mEvent; //!
+  std::unique_ptr<EventReadAhead<std::unique_ptr<HepMC3::GenEvent>>> mEventReadAhead; //! reads the next events on a background thread
 #endif
 
   ClassDefOverride(GeneratorHepMC, 1);
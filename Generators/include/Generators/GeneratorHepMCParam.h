@@ -32,6 +32,7 @@ namespace eventgen
 struct GeneratorHepMCParam : public o2::conf::ConfigurableParamHelper<GeneratorHepMCParam> {
   std::string fileName = "";
   int version = 2;
+  int readAhead = 0; // number of events read ahead on a background thread, 0 to read them on demand
   O2ParamDef(GeneratorHepMCParam, "HepMC");
 };
 
@@ -42,6 +42,11 @@ class GeneratorPythia8 : public Generator
   /** methods to override **/
   Bool_t generateEvent() override;
   Bool_t importParticles() override { return importParticles(mPythia.event); };
+  Bool_t setEventSeed(UInt_t seed) override
+  {
+    mPythia.rndm.init(seed % 900000000); // maximal seed accepted by Pythia8
+    return kTRUE;
+  };
 
   /** setters **/
   void setConfig(std::string val) { mConfig = val; };
@@ -61,6 +61,37 @@ Bool_t
 {
   /** read event **/
 
+  /** generate particles unless done already **/
+  if (!mEventPrepared && !prepareEvent()) {
+    return kFALSE;
+  }
+  mEventPrepared = false;
+
+  /** add tracks **/
+  if (!addTracks(primGen)) {
+    return kFALSE;
+  }
+
+  /** update header **/
+  auto header = primGen->GetEvent();
+  auto o2header = dynamic_cast<o2::dataformats::MCEventHeader*>(header);
+  if (!header) {
+    LOG(FATAL) << "MC event header is not a 'o2::dataformats::MCEventHeader' object";
+    return kFALSE;
+  }
+  updateHeader(o2header);
+
+  /** success **/
+  return kTRUE;
+}
+
+/*****************************************************************/
+
+Bool_t
+  Generator::prepareEvent()
+{
+  /** prepare event **/
+
   /** endless generate-and-trigger loop **/
   while (true) {
     mReadEventCounter++;
@@ -87,21 +118,8 @@ Bool_t
     }
   }
 
-  /** add tracks **/
-  if (!addTracks(primGen)) {
-    return kFALSE;
-  }
-
-  /** update header **/
-  auto header = primGen->GetEvent();
-  auto o2header = dynamic_cast<o2::dataformats::MCEventHeader*>(header);
-  if (!header) {
-    LOG(FATAL) << "MC event header is not a 'o2::dataformats::MCEventHeader' object";
-    return kFALSE;
-  }
-  updateHeader(o2header);
-
   /** success **/
+  mEventPrepared = true;
   return kTRUE;
 }
 
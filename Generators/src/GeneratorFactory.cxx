@@ -156,6 +156,8 @@ void GeneratorFactory::setPrimaryGenerator(o2::conf::SimConfig const& conf, Fair
     auto hepmcGen = new o2::eventgen::GeneratorHepMC();
     hepmcGen->setFileName(param.fileName);
     hepmcGen->setVersion(param.version);
+    hepmcGen->setStartEvent(conf.getStartEvent());
+    hepmcGen->setReadAhead(param.readAhead);
     primGen->AddGenerator(hepmcGen);
 #endif
 #ifdef GENERATORS_WITH_PYTHIA6
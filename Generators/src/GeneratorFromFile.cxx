@@ -11,6 +11,7 @@
 
 #include "Generators/GeneratorFromFile.h"
 #include "Generators/GeneratorFromO2KineParam.h"
+#include "Generators/EventReadAhead.h"
 #include "SimulationDataFormat/MCTrack.h"
 #include "SimulationDataFormat/MCEventHeader.h"
 #include <FairLogger.h>
@@ -20,6 +21,7 @@
 #include <TFile.h>
 #include <TMCProcess.h>
 #include <TParticle.h>
+#include <TROOT.h>
 #include <TTree.h>
 #include <sstream>
 
@@ -160,6 +162,8 @@ Bool_t GeneratorFromFile::ReadEvent(FairPrimaryGenerator* primGen)
 
 // based on O2 kinematics
 
+GeneratorFromO2Kine::GeneratorFromO2Kine() = default;
+
 GeneratorFromO2Kine::GeneratorFromO2Kine(const char* name)
 {
   mEventFile = TFile::Open(name);
@@ -181,6 +185,8 @@ GeneratorFromO2Kine::GeneratorFromO2Kine(const char* name)
   LOG(ERROR) << "Problem reading events from file " << name;
 }
 
+GeneratorFromO2Kine::~GeneratorFromO2Kine() = default;
+
 bool GeneratorFromO2Kine::Init()
 {
 
@@ -191,12 +197,31 @@ bool GeneratorFromO2Kine::Init()
   mSkipNonTrackable = param.skipNonTrackable;
   mContinueMode = param.continueMode;
 
+  // decompress and deserialize the next events on a background thread,
+  // starting from the start event, the branch is only read from there
+  if (param.readAhead > 0 && mEventBranch) {
+    ROOT::EnableThreadSafety();
+    auto reader = [this, entry = mEventCounter](std::vector<o2::MCTrack>& tracks) mutable -> bool {
+      if (entry >= mEventsAvailable) {
+        return false;
+      }
+      auto tracksPtr = &tracks;
+      mEventBranch->SetAddress(&tracksPtr);
+      mEventBranch->GetEntry(entry++);
+      mEventBranch->ResetAddress();
+      return true;
+    };
+    mReadAhead = std::make_unique<EventReadAhead<std::vector<o2::MCTrack>>>(reader, param.readAhead);
+  }
+
   return true;
 }
 
 void GeneratorFromO2Kine::SetStartEvent(int start)
 {
-  if (start < mEventsAvailable) {
+  if (mReadAhead) {
+    LOG(ERROR) << "start event can not be changed once the events are read ahead\n";
+  } else if (start < mEventsAvailable) {
     mEventCounter = start;
   } else {
     LOG(ERROR) << "start event bigger than available events\n";
@@ -212,11 +237,21 @@ bool GeneratorFromO2Kine::importParticles()
   if (mEventCounter < mEventsAvailable) {
     int particlecounter = 0;
 
-    std::vector<o2::MCTrack>* tracks = nullptr;
-    mEventBranch->SetAddress(&tracks);
-    mEventBranch->GetEntry(mEventCounter);
+    // the entries are read directly into the vector, which keeps its storage between events
+    if (mReadAhead) {
+      if (!mReadAhead->next(mTracks)) {
+        LOG(ERROR) << "GeneratorFromO2Kine: Failed to read event " << mEventCounter << "\n";
+        return false;
+      }
+    } else {
+      auto tracksPtr = &mTracks;
+      mEventBranch->SetAddress(&tracksPtr);
+      mEventBranch->GetEntry(mEventCounter);
+      mEventBranch->ResetAddress();
+    }
+    mParticles.reserve(mParticles.size() + mTracks.size());
 
-    for (auto& t : *tracks) {
+    for (auto& t : mTracks) {
 
       // in case we do not want to continue, take only primaries
       if (!mContinueMode && !t.isPrimary()) {
@@ -245,17 +280,13 @@ bool GeneratorFromO2Kine::importParticles()
 
       LOG(DEBUG) << "Putting primary " << pdg;
 
-      mParticles.push_back(TParticle(pdg, wanttracking, m1, m2, d1, d2, px, py, pz, e, vx, vy, vz, vt));
+      mParticles.emplace_back(pdg, wanttracking, m1, m2, d1, d2, px, py, pz, e, vx, vy, vz, vt);
       mParticles.back().SetUniqueID((unsigned int)t.getProcess()); // we should propagate the process ID
 
       particlecounter++;
     }
     mEventCounter++;
 
-    if (tracks) {
-      delete tracks;
-    }
-
     LOG(INFO) << "Event generator put " << particlecounter << " on stack";
     return true;
   } else {
@@ -13,6 +13,7 @@
 
 #include "Generators/GeneratorHepMC.h"
 #include "Generators/GeneratorHepMCParam.h"
+#include "Generators/EventReadAhead.h"
 #include "HepMC3/ReaderAscii.h"
 #include "HepMC3/ReaderAsciiHepMC2.h"
 #include "HepMC3/GenEvent.h"
@@ -25,6 +26,7 @@
 #include "FairLogger.h"
 #include "FairPrimaryGenerator.h"
 #include <cmath>
+#include <string>
 
 namespace o2
 {
@@ -62,6 +64,7 @@ GeneratorHepMC::~GeneratorHepMC()
 {
   /** default destructor **/
 
+  mEventReadAhead.reset();
   if (mStream.is_open()) {
     mStream.close();
   }
@@ -80,14 +83,83 @@ Bool_t GeneratorHepMC::generateEvent()
 {
   /** generate event **/
 
+  /** take the event read ahead **/
+  if (mEventReadAhead) {
+    std::unique_ptr<HepMC3::GenEvent> event;
+    if (!mEventReadAhead->next(event)) {
+      return kFALSE;
+    }
+    delete mEvent;
+    mEvent = event.release();
+    mInterface = reinterpret_cast<void*>(mEvent);
+    return kTRUE;
+  }
+
+  /** read event **/
+  return readEvent(*mEvent);
+}
+
+/*****************************************************************/
+
+Bool_t GeneratorHepMC::readEvent(HepMC3::GenEvent& event)
+{
+  /** read event **/
+
   /** clear and read event **/
-  mEvent->clear();
-  mReader->read_event(*mEvent);
+  event.clear();
+  mReader->read_event(event);
   if (mReader->failed()) {
     return kFALSE;
   }
   /** set units to desired output **/
-  mEvent->set_units(HepMC3::Units::GEV, HepMC3::Units::MM);
+  event.set_units(HepMC3::Units::GEV, HepMC3::Units::MM);
+
+  /** success **/
+  return kTRUE;
+}
+
+/*****************************************************************/
+
+Bool_t GeneratorHepMC::seekStartEvent()
+{
+  /** seek start event **/
+
+  /** the HepMC2 reader opens the file itself, skip the events one by one **/
+  if (!mStream.is_open()) {
+    for (int i = 0; i < mStartEvent; ++i) {
+      if (!readEvent(*mEvent)) {
+        LOG(FATAL) << "Cannot skip to event " << mStartEvent << ", only " << i << " events in the input file" << std::endl;
+        return kFALSE;
+      }
+    }
+    return kTRUE;
+  }
+
+  /** index the positions of the events, which start with a line 'E' **/
+  mEventOffsets.clear();
+  std::streampos position = 0;
+  std::string line;
+  mStream.clear();
+  mStream.seekg(0);
+  while (std::getline(mStream, line)) {
+    if (!line.empty() && line[0] == 'E' && (line.size() == 1 || line[1] == ' ')) {
+      mEventOffsets.push_back(position);
+    }
+    position += line.size() + 1;
+  }
+  if (mEventOffsets.size() <= static_cast<size_t>(mStartEvent)) {
+    LOG(FATAL) << "Cannot skip to event " << mStartEvent << ", only " << mEventOffsets.size() << " events in the input file" << std::endl;
+    return kFALSE;
+  }
+
+  /** the reader processes the lines before the first event, then jump to the start event **/
+  mStream.clear();
+  mStream.seekg(0);
+  if (!readEvent(*mEvent)) {
+    return kFALSE;
+  }
+  mStream.clear();
+  mStream.seekg(mEventOffsets[mStartEvent]);
 
   /** success **/
   return kTRUE;
@@ -100,7 +172,8 @@ Bool_t GeneratorHepMC::importParticles()
   /** import particles **/
 
   /** loop over particles **/
-  auto particles = mEvent->particles();
+  const auto& particles = mEvent->particles();
+  mParticles.reserve(mParticles.size() + particles.size());
   for (int i = 0; i < particles.size(); ++i) {
 
     /** get particle information **/
@@ -133,7 +206,7 @@ Bool_t GeneratorHepMC::importParticles()
     auto d2 = children.empty() ? -1 : children.back()->id() - 1;
 
     /** add to particle vector **/
-    mParticles.push_back(TParticle(pdg, st, m1, m2, d1, d2, px, py, pz, et, vx, vy, vz, vt));
+    mParticles.emplace_back(pdg, st, m1, m2, d1, d2, px, py, pz, et, vx, vy, vz, vt);
 
   } /** end of loop over particles **/
 
@@ -172,8 +245,26 @@ Bool_t GeneratorHepMC::Init()
       return kFALSE;
   }
 
+  if (mReader->failed()) {
+    return kFALSE;
+  }
+
+  /** skip to the start event **/
+  if (mStartEvent > 0 && !seekStartEvent()) {
+    return kFALSE;
+  }
+
+  /** read and parse the next events on a background thread **/
+  if (mReadAhead > 0) {
+    auto reader = [this](std::unique_ptr<HepMC3::GenEvent>& event) -> bool {
+      event = std::make_unique<HepMC3::GenEvent>();
+      return readEvent(*event);
+    };
+    mEventReadAhead = std::make_unique<EventReadAhead<std::unique_ptr<HepMC3::GenEvent>>>(reader, mReadAhead);
+  }
+
   /** success **/
-  return !mReader->failed();
+  return kTRUE;
 }
 
 /*****************************************************************/
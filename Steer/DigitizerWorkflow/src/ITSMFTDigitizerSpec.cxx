@@ -18,6 +18,7 @@
 #include "Framework/Task.h"
 #include "Headers/DataHeader.h"
 #include "Steer/HitProcessingManager.h" // for DigitizationContext
+#include "Steer/HitPrefetcher.h"
 #include "DataFormatsITSMFT/Digit.h"
 #include "SimulationDataFormat/ConstMCTruthContainer.h"
 #include "DetectorsBase/BaseDPLDigitizer.h"
@@ -68,6 +69,7 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
     mDigitizer.setGeometry(geom);
 
     mDisableQED = ic.options().get<bool>("disable-qed");
+    mHitsPrefetch = ic.options().get<int>("hits-prefetch");
 
     // init digitizer
     mDigitizer.init();
@@ -147,6 +149,8 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
     }; // and accumulate lambda
 
     auto& eventParts = context->getEventParts(withQED);
+    // each event part is read once, even if it contributes to several collisions
+    o2::steer::HitPrefetcher<o2::itsmft::Hit> hitPrefetcher(mSimChains, {o2::detectors::SimTraits::DETECTORBRANCHNAMES[mID][0]}, eventParts, mHitsPrefetch);
     // loop over all composite collisions given from context (aka loop over all the interaction records)
     for (int collID = 0; collID < timesview.size(); ++collID) {
       const auto& irt = timesview[collID];
@@ -158,13 +162,12 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
       for (auto& part : eventParts[collID]) {
 
         // get the hits for this event and this source
-        mHits.clear();
-        context->retrieveHits(mSimChains, o2::detectors::SimTraits::DETECTORBRANCHNAMES[mID][0].c_str(), part.sourceID, part.entryID, &mHits);
+        auto hits = hitPrefetcher.getHits(part);
 
-        if (mHits.size() > 0) {
+        if (hits->size() > 0) {
           LOG(DEBUG) << "For collision " << collID << " eventID " << part.entryID
-                     << " found " << mHits.size() << " hits ";
-          mDigitizer.process(&mHits, part.entryID, part.sourceID); // call actual digitization procedure
+                     << " found " << hits->size() << " hits ";
+          mDigitizer.process(hits.get(), part.entryID, part.sourceID); // call actual digitization procedure
         }
       }
       mMC2ROFRecordsAccum.emplace_back(collID, -1, mDigitizer.getEventROFrameMin(), mDigitizer.getEventROFrameMax());
@@ -202,14 +205,13 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
   bool mWithMCTruth = true;
   bool mFinished = false;
   bool mDisableQED = false;
+  int mHitsPrefetch = 0; // number of event parts whose hits are read ahead in the background
   o2::detectors::DetID mID;
   o2::header::DataOrigin mOrigin = o2::header::gDataOriginInvalid;
   o2::itsmft::Digitizer mDigitizer;
   std::vector<o2::itsmft::Digit> mDigits;
   std::vector<o2::itsmft::ROFRecord> mROFRecords;
   std::vector<o2::itsmft::ROFRecord> mROFRecordsAccum;
-  std::vector<o2::itsmft::Hit> mHits;
-  std::vector<o2::itsmft::Hit>* mHitsP = &mHits;
   o2::dataformats::MCTruthContainer<o2::MCCompLabel> mLabels;
   o2::dataformats::MCTruthContainer<o2::MCCompLabel> mLabelsAccum;
   std::vector<o2::itsmft::MC2ROFRecord> mMC2ROFRecordsAccum;
@@ -254,6 +256,7 @@ class ITSDPLDigitizerTask : public ITSMFTDPLDigitizerTask
     digipar.setNoisePerPixel(dopt.noisePerPixel);     // noise level
     digipar.setTimeOffset(dopt.timeOffset);
     digipar.setNSimSteps(dopt.nSimSteps);
+    mDigitizer.setNThreads(dopt.nThreads);
   }
 };
 
@@ -297,6 +300,7 @@ class MFTDPLDigitizerTask : public ITSMFTDPLDigitizerTask
     digipar.setNoisePerPixel(dopt.noisePerPixel);     // noise level
     digipar.setTimeOffset(dopt.timeOffset);
     digipar.setNSimSteps(dopt.nSimSteps);
+    mDigitizer.setNThreads(dopt.nThreads);
   }
 };
 
@@ -332,7 +336,8 @@ DataProcessorSpec getITSDigitizerSpec(int channel, bool mctruth)
                            makeOutChannels(detOrig, mctruth),
                            AlgorithmSpec{adaptFromTask<ITSDPLDigitizerTask>(mctruth)},
                            Options{
-                             {"disable-qed", o2::framework::VariantType::Bool, false, {"disable QED handling"}}
+                             {"disable-qed", o2::framework::VariantType::Bool, false, {"disable QED handling"}},
+                             {"hits-prefetch", o2::framework::VariantType::Int, 4, {"number of event parts whose hits are read ahead in the background (0: read on demand)"}}
                              //  { "configKeyValues", VariantType::String, "", { parHelper.str().c_str() } }
                            }};
 }
@@ -352,7 +357,8 @@ DataProcessorSpec getMFTDigitizerSpec(int channel, bool mctruth)
                                             static_cast<SubSpecificationType>(channel), Lifetime::Timeframe}},
                            makeOutChannels(detOrig, mctruth),
                            AlgorithmSpec{adaptFromTask<MFTDPLDigitizerTask>(mctruth)},
-                           Options{{"disable-qed", o2::framework::VariantType::Bool, false, {"disable QED handling"}}}};
+                           Options{{"disable-qed", o2::framework::VariantType::Bool, false, {"disable QED handling"}},
+                                   {"hits-prefetch", o2::framework::VariantType::Int, 4, {"number of event parts whose hits are read ahead in the background (0: read on demand)"}}}};
 }
 
 } // end namespace itsmft
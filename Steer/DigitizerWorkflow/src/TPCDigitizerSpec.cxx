@@ -26,6 +26,7 @@
 #include "Headers/DataHeader.h"
 #include "TStopwatch.h"
 #include "Steer/HitProcessingManager.h" // for DigitizationContext
+#include "Steer/HitPrefetcher.h"
 #include "TChain.h"
 #include <SimulationDataFormat/MCCompLabel.h>
 #include <SimulationDataFormat/ConstMCTruthContainer.h>
@@ -118,6 +119,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     mWithMCTruth = o2::conf::DigiParams::Instance().mctruth;
     auto useDistortions = ic.options().get<int>("distortionType");
     auto triggeredMode = ic.options().get<bool>("TPCtriggered");
+    mHitsPrefetch = ic.options().get<int>("hits-prefetch");
 
     if (useDistortions > 0) {
       if (useDistortions == 1) {
@@ -379,6 +381,9 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     TStopwatch timer;
     timer.Start();
 
+    // each event part is read once for both branches of the sector, even if it contributes to several collisions
+    o2::steer::HitPrefetcher<o2::tpc::HitGroup> hitPrefetcher(mSimChains, {getBranchNameLeft(sector), getBranchNameRight(sector)}, eventParts, mHitsPrefetch);
+
     // loop over all composite collisions given from context
     // (aka loop over all the interaction records)
     for (int collID = 0; collID < irecords.size(); ++collID) {
@@ -397,10 +402,9 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
         const int sourceID = part.sourceID;
 
         // get the hits for this event and this source
-        std::vector<o2::tpc::HitGroup> hitsLeft;
-        std::vector<o2::tpc::HitGroup> hitsRight;
-        context->retrieveHits(mSimChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft);
-        context->retrieveHits(mSimChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight);
+        auto hits = hitPrefetcher.getEntry(part);
+        const auto& hitsLeft = *hits[0];
+        const auto& hitsRight = *hits[1];
         LOG(DEBUG) << "TPC: Found " << hitsLeft.size() << " hit groups left and " << hitsRight.size() << " hit groups right in collision " << collID << " eventID " << part.entryID;
 
         mDigitizer.process(hitsLeft, eventID, sourceID);
@@ -446,6 +450,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
   size_t mFlushCounter = 0;
   int mLaneId = 0; // the id of the current process within the parallel pipeline
   int mSector = 0;
+  int mHitsPrefetch = 0; // number of event parts whose hits are read ahead in the background
   bool mWriteGRP = false;
   bool mWithMCTruth = true;
   bool mInternalWriter = false;
@@ -484,7 +489,8 @@ o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP,
     Options{{"distortionType", VariantType::Int, 0, {"Distortion type to be used. 0 = no distortions (default), 1 = realistic distortions (not implemented yet), 2 = constant distortions"}},
             {"initialSpaceChargeDensity", VariantType::String, "", {"Path to root file containing TH3 with initial space-charge density and name of the TH3 (comma separated)"}},
             {"readSpaceCharge", VariantType::String, "", {"Path to root file containing pre-calculated space-charge object and name of the object (comma separated)"}},
-            {"TPCtriggered", VariantType::Bool, false, {"Impose triggered RO mode (default: continuous)"}}}};
+            {"TPCtriggered", VariantType::Bool, false, {"Impose triggered RO mode (default: continuous)"}},
+            {"hits-prefetch", VariantType::Int, 4, {"number of event parts whose hits are read ahead in the background (0: read on demand)"}}}};
 }
 
 o2::framework::WorkflowSpec getTPCDigitizerSpec(int nLanes, std::vector<int> const& sectors, bool mctruth, bool internalwriter)
@@ -0,0 +1,73 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_STEER_GEOMETRYCACHE_H
+#define O2_STEER_GEOMETRYCACHE_H
+
+#include <map>
+#include <string>
+
+namespace o2
+{
+namespace steer
+{
+
+/// Cache of the complete (ideal) simulation geometry, together with the material and medium tables
+/// of the MaterialManager and the module owning each volume.
+///
+/// The first o2-sim run with a cache file writes it once the geometry is constructed. The following
+/// runs with the same configuration (modules, engine and all configurable parameters) load the
+/// geometry from it instead of calling the ConstructGeometry of every module and import it to VMC.
+/// The cache file is also a valid geometry file for GeometryManager::loadGeometry.
+class GeometryCache
+{
+ public:
+  enum class Mode { None,  ///< no cache in use
+                    Write, ///< the geometry is constructed and written to the cache
+                    Load   ///< the geometry is loaded from the cache
+  };
+
+  static GeometryCache& Instance()
+  {
+    static GeometryCache cache;
+    return cache;
+  }
+
+  /// decide, from the cache file and the current configuration, if the geometry will be loaded
+  /// from the cache or written to it; to be called once the configuration is final
+  void init(std::string const& filename);
+
+  Mode getMode() const { return mMode; }
+  bool isLoading() const { return mMode == Mode::Load; }
+  bool isWriting() const { return mMode == Mode::Write; }
+  const std::string& getFileName() const { return mFileName; }
+
+  /// load the geometry into gGeoManager and restore the material tables; fills the name of the
+  /// module owning each volume (by volume number)
+  void load(std::map<int, std::string>& volumeModules) const;
+
+  /// write the current geometry, material tables and volume owners to the cache file
+  void write(std::map<int, std::string> const& volumeModules) const;
+
+ private:
+  GeometryCache() = default;
+
+  std::string makeKey() const;
+
+  std::string mFileName;
+  std::string mKey; // description of the configuration the cached geometry is valid for
+  Mode mMode = Mode::None;
+};
+
+} // namespace steer
+} // namespace o2
+
+#endif
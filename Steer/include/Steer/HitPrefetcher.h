@@ -0,0 +1,215 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_HITPREFETCHER_H
+#define O2_HITPREFETCHER_H
+
+#include "SimulationDataFormat/DigitizationContext.h"
+#include <TChain.h>
+#include <TBranch.h>
+#include <TROOT.h>
+#include <FairLogger.h>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace o2
+{
+namespace steer
+{
+
+/// Provides the hits of the event parts of a digitization context, in the order of the collisions
+///
+/// Each event part (source and entry) is read only once from the sim chains, for all the given hit
+/// branches, even if it contributes to several collisions (pile-up); its hits are kept until its last
+/// use. With a lookahead > 0 the hits of the next event parts are read by a background thread while
+/// the current ones are digitized.
+///
+/// Usage:
+///   HitPrefetcher<o2::itsmft::Hit> prefetcher(chains, {brname}, context->getEventParts(withQED), lookahead);
+///   for (auto& collision : eventParts) {
+///     for (auto& part : collision) {
+///       auto hits = prefetcher.getHits(part); // the hits of branch 0, shared_ptr to a const vector
+///       ...
+///     }
+///   }
+template <typename T>
+class HitPrefetcher
+{
+ public:
+  using HitVector = std::vector<T>;
+  using Entry = std::vector<std::shared_ptr<const HitVector>>; // the hits of an event part for each branch
+
+  HitPrefetcher(std::vector<TChain*> const& chains, std::vector<std::string> const& branches,
+                std::vector<std::vector<EventPart>> const& eventParts, int lookahead = 0)
+    : mChains(chains), mBranches(branches), mLookahead(lookahead)
+  {
+    for (auto& collision : eventParts) {
+      for (auto& part : collision) {
+        const auto key = makeKey(part);
+        auto [it, isNew] = mLastUse.emplace(key, mSequence.size());
+        if (isNew) {
+          mLoadOrder.emplace_back(key, mSequence.size());
+        } else {
+          it->second = mSequence.size();
+        }
+        mSequence.push_back(key);
+      }
+    }
+    if (mLookahead > 0 && mLoadOrder.size() > 0) {
+      ROOT::EnableThreadSafety();
+      mThread = std::thread([this]() { prefetch(); });
+    }
+  }
+
+  ~HitPrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCondition.notify_all();
+    if (mThread.joinable()) {
+      mThread.join();
+    }
+  }
+
+  HitPrefetcher(HitPrefetcher const&) = delete;
+  HitPrefetcher& operator=(HitPrefetcher const&) = delete;
+
+  /// the hits of an event part for a branch (index in the branches given at construction)
+  /// the event parts are expected to be requested in the order of the collisions
+  std::shared_ptr<const HitVector> getHits(EventPart const& part, int branch = 0) { return getEntry(part)[branch]; }
+
+  /// the hits of an event part for all branches
+  Entry getEntry(EventPart const& part)
+  {
+    const auto key = makeKey(part);
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (!advance(key)) {
+      // not in the sequence (or requested out of order): just read it
+      lock.unlock();
+      return load(key);
+    }
+    auto it = mLoaded.find(key);
+    if (it == mLoaded.end() && mThread.joinable()) {
+      // being read (or about to be) by the background thread
+      mCondition.wait(lock, [this, key]() { return mLoaded.count(key) > 0; });
+      it = mLoaded.find(key);
+    }
+    if (it == mLoaded.end()) {
+      lock.unlock();
+      auto entry = load(key);
+      lock.lock();
+      it = mLoaded.emplace(key, std::move(entry)).first;
+    }
+    return it->second;
+  }
+
+ private:
+  static uint64_t makeKey(EventPart const& part) { return (uint64_t(uint32_t(part.sourceID)) << 32) | uint32_t(part.entryID); }
+
+  // moves the position of the consumer to the next use of key and releases the event parts not used anymore;
+  // returns false if there is no next use
+  bool advance(uint64_t key)
+  {
+    auto pos = mPosition;
+    while (pos < mSequence.size() && mSequence[pos] != key) {
+      ++pos;
+    }
+    if (pos == mSequence.size()) {
+      return false;
+    }
+    mPosition = pos;
+    for (auto it = mLoaded.begin(); it != mLoaded.end();) {
+      auto lastUse = mLastUse.find(it->first);
+      if (lastUse != mLastUse.end() && lastUse->second < mPosition) {
+        it = mLoaded.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    mCondition.notify_all();
+    return true;
+  }
+
+  Entry load(uint64_t key)
+  {
+    const int source = key >> 32;
+    const int entryID = key & 0xffffffff;
+    Entry entry;
+    // the chains are read by one thread at a time
+    std::lock_guard<std::mutex> lock(mReadMutex);
+    for (auto& brname : mBranches) {
+      auto hits = std::make_shared<HitVector>();
+      auto br = source < mChains.size() && mChains[source] ? mChains[source]->GetBranch(brname.c_str()) : nullptr;
+      if (br) {
+        auto hitsptr = hits.get();
+        br->SetAddress(&hitsptr);
+        br->GetEntry(entryID);
+        br->ResetAddress();
+      } else {
+        LOG(ERROR) << "No branch found with name " << brname;
+      }
+      entry.emplace_back(std::move(hits));
+    }
+    return entry;
+  }
+
+  // reads the event parts in the order of their first use, at most mLookahead event parts ahead of the consumer
+  void prefetch()
+  {
+    for (auto& [key, firstUse] : mLoadOrder) {
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this, firstUse = firstUse]() { return mStop || firstUse < mPosition + mLookahead; });
+        if (mStop) {
+          return;
+        }
+        if (mLoaded.count(key) || mLastUse[key] < mPosition) {
+          continue; // already read by the consumer or not needed anymore
+        }
+      }
+      auto entry = load(key);
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLoaded.emplace(key, std::move(entry));
+      }
+      mCondition.notify_all();
+    }
+  }
+
+  std::vector<TChain*> const& mChains;
+  std::vector<std::string> mBranches;
+  size_t mLookahead = 0;
+
+  std::vector<uint64_t> mSequence;                      // the event parts in the order of use
+  std::vector<std::pair<uint64_t, size_t>> mLoadOrder;  // the distinct event parts with their first use
+  std::unordered_map<uint64_t, size_t> mLastUse;        // the last use of each event part
+  std::unordered_map<uint64_t, Entry> mLoaded;          // the event parts read and still needed
+  size_t mPosition = 0;                                 // the position of the consumer in mSequence
+
+  std::mutex mMutex;
+  std::mutex mReadMutex;
+  std::condition_variable mCondition;
+  std::thread mThread;
+  bool mStop = false;
+};
+
+} // namespace steer
+} // namespace o2
+
+#endif
@@ -33,6 +33,8 @@ class InteractionSampler
   static constexpr float Sec2NanoSec = 1.e9; // s->ns conversion
   const o2::InteractionTimeRecord& generateCollisionTime();
   void generateCollisionTimes(std::vector<o2::InteractionTimeRecord>& dest);
+  /// append n interaction records to dest, same sequence as from n calls of generateCollisionTime
+  void appendCollisionTimes(std::vector<o2::InteractionTimeRecord>& dest, size_t n);
 
   void init();
 
@@ -96,10 +98,9 @@ class InteractionSampler
 inline void InteractionSampler::generateCollisionTimes(std::vector<o2::InteractionTimeRecord>& dest)
 {
   // fill vector with interaction records
+  const size_t n = dest.capacity();
   dest.clear();
-  for (int i = dest.capacity(); i--;) {
-    dest.push_back(generateCollisionTime());
-  }
+  appendCollisionTimes(dest, n);
 }
 
 //_________________________________________________
@@ -15,6 +15,8 @@
 #include "SimulationDataFormat/MCEventHeader.h"
 #include "SimulationDataFormat/TrackReference.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
+#include <gsl/span>
+#include <list>
 #include <vector>
 
 class TChain;
@@ -76,9 +78,26 @@ class MCKinematicsReader
   /// variant returning all tracks for source and event at once
   std::vector<MCTrack> const& getTracks(int source, int event) const;
 
+  /// variant returning a view on all tracks for source and event; no copy is done if the
+  /// kinematics of the source are served from an indexed kinematics file
+  gsl::span<MCTrack const> getTracksView(int source, int event) const;
+
   /// API to ask releasing tracks (freeing memory) for source + event
   void releaseTracksForSourceAndEvent(int source, int event);
 
+  /// limits the number of events whose tracks are kept in memory (0 = no limit, the default);
+  /// when the limit is reached the least recently used event is released, which invalidates
+  /// references to its tracks obtained before
+  void setMaxCachedEvents(size_t n);
+
+  /// tells if the kinematics of a source are served from a memory-mapped indexed kinematics file
+  bool isIndexed(int source) const { return mMapped[source].tracks != nullptr; }
+
+  /// writes the flat, indexed copy of the kinematics of a simulation production (given by its prefix),
+  /// which is memory-mapped by readers for random access without any tree read
+  /// returns true if successful
+  static bool writeIndexedKinematics(std::string_view prefix);
+
   /// variant returning all tracks for source and event at once
   std::vector<MCTrack> const& getTracks(int event) const;
 
@@ -110,6 +129,26 @@ class MCKinematicsReader
   }
 
  private:
+  // the layout of an indexed kinematics file: the header, the offsets of the events
+  // (nEvents + 1 entries, in units of tracks) followed by the flat MCTrack records of all events
+  struct IndexedKinematicsHeader {
+    char magic[8] = {'O', '2', 'K', 'I', 'N', 'I', 'D', 'X'};
+    uint32_t version = 1;
+    uint32_t trackSize = sizeof(MCTrack);
+    uint64_t nEvents = 0;
+  };
+
+  struct MappedKinematics {
+    void* data = nullptr;               // the mapping of the whole file
+    size_t size = 0;                    // the size of the mapping
+    size_t nEvents = 0;                 // the number of events
+    uint64_t const* offsets = nullptr;  // the offset of the first track of each event
+    MCTrack const* tracks = nullptr;    // the tracks of all events
+  };
+
+  void mapIndexedKinematics(int source, std::string const& prefix);
+  void touchCachedEvent(int source, int eventID) const;
+  void releaseTracks(int source, int eventID) const;
   void initTracksForSource(int source) const;
   void loadTracksForSourceAndEvent(int source, int eventID) const;
   void loadHeadersForSource(int source) const;
@@ -126,6 +165,13 @@ class MCKinematicsReader
   mutable std::vector<std::vector<o2::dataformats::MCEventHeader>> mHeaders;                                 // the in-memory header container
   mutable std::vector<std::vector<o2::dataformats::MCTruthContainer<o2::TrackReference>>> mIndexedTrackRefs; // the in-memory track ref container
 
+  std::vector<MappedKinematics> mMapped; //! the memory-mapped indexed kinematics, if available, for each source
+
+  // least recently used bookkeeping of the events in mTracks (only if mMaxCachedEvents > 0)
+  size_t mMaxCachedEvents = 0;
+  mutable std::list<std::pair<int, int>> mCachedEvents;                                     //! source and event, most recently used first
+  mutable std::vector<std::vector<std::list<std::pair<int, int>>::iterator>> mCachedEventPos; //! position of each event in mCachedEvents
+
   bool mInitialized = false; // whether initialized
 };
 
@@ -139,6 +185,10 @@ inline MCTrack const* MCKinematicsReader::getTrack(o2::MCCompLabel const& label)
 
 inline MCTrack const* MCKinematicsReader::getTrack(int source, int event, int track) const
 {
+  auto const& mapped = mMapped[source];
+  if (mapped.tracks) {
+    return mapped.tracks + mapped.offsets[event] + track;
+  }
   return &getTracks(source, event)[track];
 }
 
@@ -154,10 +204,22 @@ inline std::vector<MCTrack> const& MCKinematicsReader::getTracks(int source, int
   }
   if (mTracks[source][event] == nullptr) {
     loadTracksForSourceAndEvent(source, event);
+  } else if (mMaxCachedEvents > 0) {
+    touchCachedEvent(source, event);
   }
   return *mTracks[source][event];
 }
 
+inline gsl::span<MCTrack const> MCKinematicsReader::getTracksView(int source, int event) const
+{
+  auto const& mapped = mMapped[source];
+  if (mapped.tracks) {
+    return gsl::span<MCTrack const>(mapped.tracks + mapped.offsets[event], mapped.offsets[event + 1] - mapped.offsets[event]);
+  }
+  auto const& tracks = getTracks(source, event);
+  return gsl::span<MCTrack const>(tracks.data(), tracks.size());
+}
+
 inline std::vector<MCTrack> const& MCKinematicsReader::getTracks(int event) const
 {
   return getTracks(0, event);
@@ -199,6 +261,9 @@ inline size_t MCKinematicsReader::getNSources() const
 
 inline size_t MCKinematicsReader::getNEvents(int source) const
 {
+  if (mMapped[source].tracks) {
+    return mMapped[source].nEvents;
+  }
   if (mTracks[source].size() == 0) {
     initTracksForSource(source);
   }
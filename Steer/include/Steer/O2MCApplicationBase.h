@@ -23,6 +23,7 @@
 #include "Rtypes.h" // for Int_t, Bool_t, Double_t, etc
 #include <TVirtualMC.h>
 #include "SimConfig/SimParams.h"
+#include "Steer/StepStatistics.h"
 
 namespace o2
 {
@@ -61,6 +62,7 @@ class O2MCApplicationBase : public FairMCApplication
   std::map<int, std::string> mModIdToName{};      // mapping of module id to name
   std::map<int, std::string> mSensitiveVolumes{}; // collection of all sensitive volumes with
                                                   // keeping track of volumeIds and volume names
+  StepStatistics mStepStatistics;                 //! sampled per-volume and per-particle step statistics
 
   /// some common parts of finishEvent
   void finishEventCommon();
@@ -0,0 +1,83 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_STEER_STEPSTATISTICS_H
+#define O2_STEER_STEPSTATISTICS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TVirtualMC;
+
+namespace o2
+{
+namespace steer
+{
+
+/// Sampled statistics of the transport steps per volume and per particle species, a light
+/// alternative to the full logging of the MCStepLogger to find the geometry and step size hot spots.
+///
+/// Every n-th step is attributed to its volume and particle, together with the wall time until the
+/// next step, i.e. the time spent by the engine and the sensitive detectors for the step starting there.
+/// The counts are accumulated online in tables owned by the MC application, thus per worker thread,
+/// and only a summary of the most expensive volumes and particles is reported at the end of an event.
+class StepStatistics
+{
+ public:
+  /// \param sampling every sampling-th step is recorded, 0 switches the statistics off
+  /// \param volumes  comma separated names of the volumes to which the statistics is restricted, all if empty
+  void init(TVirtualMC* mc, int sampling, const std::string& volumes);
+  bool isInitialized() const { return mInitialized; }
+  bool isActive() const { return mSampling > 0; }
+
+  /// to be called at each step
+  void step(TVirtualMC* mc)
+  {
+    if (mPendingVolume >= 0) {
+      closePending();
+    }
+    if (++mCounter >= mSampling) {
+      mCounter = 0;
+      sample(mc);
+    }
+  }
+
+  /// logs the nPrint volumes and particles with the largest time, extrapolated from the sampled steps
+  void report(TVirtualMC* mc, int nPrint) const;
+  void reset();
+
+ private:
+  struct Entry {
+    uint64_t nSteps = 0; ///< sampled steps
+    double time = 0.;    ///< time of the sampled steps (s)
+  };
+
+  void sample(TVirtualMC* mc);
+  void closePending();
+
+  bool mInitialized = false;
+  int mSampling = 0;
+  int mCounter = 0;
+  std::vector<char> mSelectedVolumes;         ///< per volume ID, empty if all are selected
+  std::vector<Entry> mVolumes;                ///< per volume ID
+  std::unordered_map<int, Entry> mParticles;  ///< per PDG code
+  int mPendingVolume = -1;                    ///< volume of the sampled step waiting for its time
+  int mPendingPDG = 0;                        ///< PDG code of the sampled step waiting for its time
+  std::chrono::steady_clock::time_point mPendingStart;
+};
+
+} // namespace steer
+} // namespace o2
+
+#endif
@@ -20,6 +20,8 @@
 #include <cmath>
 #include <TRandom.h>
 #include <numeric>
+#include <algorithm>
+#include <iterator>
 #include <FairLogger.h>
 
 //
@@ -210,7 +212,8 @@ int main(int argc, char* argv[])
   // do some cross checking on this
   std::vector<o2::steer::InteractionSampler> samplers;
 
-  std::vector<std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>>> collisions;
+  using Collision = std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>>;
+  std::vector<Collision> collisions;
 
   // now we generate the collision structure (interaction type by interaction type)
   bool usetimeframelength = options.timeframelengthinMS > 0;
@@ -224,18 +227,24 @@ int main(int argc, char* argv[])
         sampler.setBunchFilling(options.bcpatternfile);
       }
       sampler.init();
-      o2::InteractionTimeRecord record;
-      int count = 0;
-      do {
-        record = sampler.generateCollisionTime();
-        std::vector<o2::steer::EventPart> parts;
-        parts.emplace_back(id, count);
-
-        std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>> insertvalue(record, parts);
-        auto iter = std::lower_bound(collisions.begin(), collisions.end(), insertvalue, [](std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>> const& a, std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>> const& b) { return a.first < b.first; });
-        collisions.insert(iter, insertvalue);
-        count++;
-      } while ((usetimeframelength && record.getTimeNS() < options.timeframelengthinMS * 1000 * 1000) || (ispecs[id].mcnumberasked > 0 && count < ispecs[id].mcnumberasked));
+
+      // the records of this interaction are generated in time order
+      std::vector<o2::InteractionTimeRecord> records;
+      if (ispecs[id].mcnumberasked > 0) {
+        sampler.appendCollisionTimes(records, ispecs[id].mcnumberasked);
+      }
+      if (usetimeframelength) {
+        const double tmaxNS = options.timeframelengthinMS * 1000 * 1000;
+        const auto nexpected = size_t(sampler.getInteractionRate() * options.timeframelengthinMS * 1e-3 * 1.1) + 1;
+        records.reserve(std::max(records.size(), nexpected));
+        while (records.empty() || records.back().getTimeNS() < tmaxNS) {
+          records.push_back(sampler.generateCollisionTime());
+        }
+      }
+      if (records.empty()) {
+        records.push_back(sampler.generateCollisionTime());
+      }
+      const int count = records.size();
 
       // we support randomization etc on non-injected/embedded interactions
       // and we can apply them here
@@ -258,14 +267,20 @@ int main(int argc, char* argv[])
           e = e % ispecs[id].mcnumberavail;
         }
       }
-      // make these transformations final:
-      for (auto& col : collisions) {
-        for (auto& part : col.second) {
-          if (part.sourceID == id) {
-            part.entryID = eventindices[part.entryID];
-          }
+
+      // merge with the collisions of the previous interactions (both are sorted in time), instead of
+      // inserting the collisions one by one
+      std::vector<Collision> merged;
+      merged.reserve(collisions.size() + count);
+      auto prev = collisions.begin();
+      for (int i = 0; i < count; ++i) {
+        while (prev != collisions.end() && prev->first < records[i]) {
+          merged.push_back(std::move(*prev++));
         }
+        merged.emplace_back(records[i], std::vector<o2::steer::EventPart>{o2::steer::EventPart(id, eventindices[i])});
       }
+      std::move(prev, collisions.end(), std::back_inserter(merged));
+      collisions.swap(merged);
 
     } else {
       // we are in some lock/sync mode and modify existing collisions
@@ -319,14 +334,19 @@ int main(int argc, char* argv[])
   auto& parts = digicontext.getEventParts();
   // we can fill this container
   auto& records = digicontext.getEventRecords();
-  // copy over information
+  // move over information
   size_t maxParts = 0;
+  const auto ncollisions = collisions.size();
+  records.reserve(ncollisions);
+  parts.reserve(ncollisions);
   for (auto& p : collisions) {
     records.push_back(p.first);
-    parts.push_back(p.second);
     maxParts = std::max(p.second.size(), maxParts);
+    parts.push_back(std::move(p.second));
   }
-  digicontext.setNCollisions(collisions.size());
+  collisions.clear();
+  collisions.shrink_to_fit();
+  digicontext.setNCollisions(ncollisions);
   digicontext.setMaxNumberParts(maxParts);
   std::vector<std::string> prefixes;
   for (auto& p : ispecs) {
@@ -0,0 +1,147 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Steer/GeometryCache.h"
+#include "SimConfig/SimConfig.h"
+#include "CommonUtils/ConfigurableParam.h"
+#include "DetectorsBase/MaterialManager.h"
+#include <TFile.h>
+#include <TGeoManager.h>
+#include <TObjString.h>
+#include <FairLogger.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <unistd.h>
+
+namespace o2
+{
+namespace steer
+{
+
+namespace
+{
+const char* const KeyName = "o2sim_geometry_cache_key";
+const char* const MaterialsName = "o2sim_geometry_cache_materials";
+const char* const VolumesName = "o2sim_geometry_cache_volumes";
+
+std::string readString(TFile& file, const char* name)
+{
+  auto str = std::unique_ptr<TObjString>(dynamic_cast<TObjString*>(file.Get(name)));
+  return str ? str->GetString().Data() : "";
+}
+} // namespace
+
+//_________________________________________________
+std::string GeometryCache::makeKey() const
+{
+  // the geometry depends on the modules, the engine (which creates the media) and the configurable parameters
+  auto& confref = o2::conf::SimConfig::Instance();
+  std::stringstream key;
+  key << "modules";
+  for (auto& m : confref.getActiveDetectors()) {
+    key << " " << m;
+  }
+  key << "\nengine " << confref.getMCEngine() << "\n";
+
+  std::string ininame = mFileName + "." + std::to_string(getpid()) + ".ini";
+  o2::conf::ConfigurableParam::writeINI(ininame);
+  auto inipath = o2::conf::ConfigurableParam::getOutputDir() + ininame;
+  std::ifstream ini(inipath);
+  key << ini.rdbuf();
+  ini.close();
+  std::remove(inipath.c_str());
+  return key.str();
+}
+
+//_________________________________________________
+void GeometryCache::init(std::string const& filename)
+{
+  mFileName = filename;
+  mMode = Mode::None;
+  if (mFileName.empty()) {
+    return;
+  }
+  mKey = makeKey();
+  mMode = Mode::Write;
+  if (!std::filesystem::exists(mFileName)) {
+    LOG(INFO) << "Geometry cache " << mFileName << " does not exist, it will be written";
+    return;
+  }
+  TFile file(mFileName.c_str());
+  if (file.IsZombie()) {
+    LOG(WARNING) << "Failed to open geometry cache " << mFileName << ", it will be rewritten";
+    return;
+  }
+  if (readString(file, KeyName) != mKey) {
+    LOG(WARNING) << "Geometry cache " << mFileName << " was written for a different configuration, it will be rewritten";
+    return;
+  }
+  LOG(INFO) << "Geometry will be loaded from cache " << mFileName;
+  mMode = Mode::Load;
+}
+
+//_________________________________________________
+void GeometryCache::load(std::map<int, std::string>& volumeModules) const
+{
+  if (!TGeoManager::Import(mFileName.c_str())) {
+    LOG(FATAL) << "Failed to load geometry from cache " << mFileName;
+  }
+  TFile file(mFileName.c_str());
+  std::istringstream materials(readString(file, MaterialsName));
+  if (!o2::base::MaterialManager::Instance().readTables(materials)) {
+    LOG(FATAL) << "Failed to restore material tables from geometry cache " << mFileName;
+  }
+  std::istringstream volumes(readString(file, VolumesName));
+  int number;
+  std::string module;
+  while (volumes >> number >> std::quoted(module)) {
+    volumeModules[number] = module;
+  }
+  LOG(INFO) << "Loaded geometry with " << gGeoManager->GetListOfVolumes()->GetEntries() << " volumes from cache " << mFileName;
+}
+
+//_________________________________________________
+void GeometryCache::write(std::map<int, std::string> const& volumeModules) const
+{
+  // written to a temporary file first, so that concurrent jobs never see an incomplete cache
+  auto tmpname = mFileName + ".tmp" + std::to_string(getpid()) + ".root";
+  gGeoManager->Export(tmpname.c_str());
+  {
+    TFile file(tmpname.c_str(), "UPDATE");
+    if (file.IsZombie()) {
+      LOG(ERROR) << "Failed to write geometry cache " << mFileName;
+      return;
+    }
+    std::stringstream materials;
+    o2::base::MaterialManager::Instance().writeTables(materials);
+    std::stringstream volumes;
+    for (auto& v : volumeModules) {
+      volumes << v.first << " " << std::quoted(v.second) << "\n";
+    }
+    TObjString(mKey.c_str()).Write(KeyName);
+    TObjString(materials.str().c_str()).Write(MaterialsName);
+    TObjString(volumes.str().c_str()).Write(VolumesName);
+    file.Close();
+  }
+  if (std::rename(tmpname.c_str(), mFileName.c_str()) != 0) {
+    LOG(ERROR) << "Failed to move geometry cache to " << mFileName;
+    std::remove(tmpname.c_str());
+    return;
+  }
+  LOG(INFO) << "Wrote geometry cache " << mFileName;
+}
+
+} // namespace steer
+} // namespace o2
@@ -39,13 +39,8 @@ void InteractionSampler::init()
     LOG(INFO) << "Deducing mu=" << mMuBC << " per BC from IR=" << mIntRate << " with " << nBCSet << " BCs";
   }
 
-  mInteractingBCs.clear();
-  mInteractingBCs.reserve(nBCSet);
-  for (int i = 0; i < o2::constants::lhc::LHCMaxBunches; i++) {
-    if (mBCFilling.testBC(i)) {
-      mInteractingBCs.push_back(i);
-    }
-  }
+  // table of filled BCs: the BC jumps are counted in filled BCs, so the next interacting BC is found w/o scanning the pattern
+  mInteractingBCs = mBCFilling.getFilledBCs();
 
   auto mu = mMuBC;
   // prob. of not having interaction in N consecutive BCs is P(N) = mu*exp(-(N-1)*mu), hence its cumulative distribution
@@ -111,6 +106,28 @@ const o2::InteractionTimeRecord& InteractionSampler::generateCollisionTime()
   return mIR;
 }
 
+//_________________________________________________
+void InteractionSampler::appendCollisionTimes(std::vector<o2::InteractionTimeRecord>& dest, size_t n)
+{
+  // append n interaction records, taking all collisions of an interacting BC at once
+  if (mIntRate < 0) {
+    init();
+  }
+  dest.reserve(dest.size() + n);
+  while (n) {
+    if (mIntBCCache < 1) {
+      mIntBCCache = simulateInteractingBC();
+    }
+    size_t ncoll = std::min(size_t(mIntBCCache), n);
+    for (size_t i = ncoll; i--;) {
+      dest.emplace_back(mIR, mTimeInBC.back());
+      mTimeInBC.pop_back();
+    }
+    mIntBCCache -= ncoll;
+    n -= ncoll;
+  }
+}
+
 //_________________________________________________
 int InteractionSampler::simulateInteractingBC()
 {
@@ -0,0 +1,54 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <boost/program_options.hpp>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "Steer/MCKinematicsReader.h"
+
+// A utility to write the flat, indexed copies of the kinematics of simulation productions,
+// which are memory-mapped by the MCKinematicsReader for random access to tracks
+
+int main(int argc, char* argv[])
+{
+  namespace bpo = boost::program_options;
+  bpo::options_description options(
+    "A utility to write indexed kinematics files (<prefix>_Kine.idx) next to the kinematics of simulation productions.\n\n"
+    "Allowed options");
+
+  std::vector<std::string> prefixes;
+  options.add_options()(
+    "prefix,p", bpo::value<std::vector<std::string>>(&prefixes)->multitoken()->default_value(std::vector<std::string>{"o2sim"}, "o2sim"),
+    "Prefixes of the simulation productions")(
+    "help,h", "Produce help message.");
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv).options(options).run(), vm);
+    bpo::notify(vm);
+    if (vm.count("help")) {
+      std::cout << options << std::endl;
+      return 0;
+    }
+  } catch (const bpo::error& e) {
+    std::cerr << e.what() << "\n\n";
+    std::cerr << "Error parsing options; Available options:\n";
+    std::cerr << options << std::endl;
+    return 1;
+  }
+
+  bool ok = true;
+  for (auto const& prefix : prefixes) {
+    ok &= o2::steer::MCKinematicsReader::writeIndexedKinematics(prefix);
+  }
+  return ok ? 0 : 1;
+}
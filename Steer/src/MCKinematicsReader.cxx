@@ -14,7 +14,17 @@
 #include "SimulationDataFormat/MCEventHeader.h"
 #include "SimulationDataFormat/TrackReference.h"
 #include <TChain.h>
+#include <TFile.h>
+#include <TTree.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
 #include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "FairLogger.h"
 
 using namespace o2::steer;
@@ -26,6 +36,13 @@ MCKinematicsReader::~MCKinematicsReader()
   }
   mInputChains.clear();
 
+  for (auto& mapped : mMapped) {
+    if (mapped.data) {
+      munmap(mapped.data, mapped.size);
+    }
+  }
+  mMapped.clear();
+
   if (mDigitizationContext) {
     delete mDigitizationContext;
   }
@@ -50,8 +67,154 @@ void MCKinematicsReader::initIndexedTrackRefs(std::vector<o2::TrackReference>& r
   }
 }
 
+void MCKinematicsReader::mapIndexedKinematics(int source, std::string const& prefix)
+{
+  auto& mapped = mMapped[source];
+  const auto indexname = o2::base::NameConf::getMCKinematicsIndexFileName(prefix);
+  const auto kinename = o2::base::NameConf::getMCKinematicsFileName(prefix);
+  std::error_code ec;
+  if (!std::filesystem::exists(indexname, ec)) {
+    return;
+  }
+  if (std::filesystem::exists(kinename, ec) && std::filesystem::last_write_time(indexname, ec) < std::filesystem::last_write_time(kinename, ec)) {
+    LOG(WARN) << "Indexed kinematics " << indexname << " is older than " << kinename << "; not using it";
+    return;
+  }
+
+  int fd = open(indexname.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    LOG(WARN) << "Failed to open indexed kinematics " << indexname;
+    return;
+  }
+  size_t size = st.st_size;
+  void* data = size >= sizeof(IndexedKinematicsHeader) ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+  close(fd); // the mapping stays valid
+  if (data == MAP_FAILED || !data) {
+    LOG(WARN) << "Failed to map indexed kinematics " << indexname;
+    return;
+  }
+
+  // check that the file is complete and was written for the present MCTrack layout
+  const IndexedKinematicsHeader reference;
+  IndexedKinematicsHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  const size_t offsetsSize = (header.nEvents + 1) * sizeof(uint64_t);
+  bool ok = std::memcmp(header.magic, reference.magic, sizeof(header.magic)) == 0 && header.version == reference.version &&
+            header.trackSize == reference.trackSize && size >= sizeof(header) + offsetsSize;
+  auto offsets = ok ? reinterpret_cast<uint64_t const*>((char const*)data + sizeof(header)) : nullptr;
+  ok = ok && size == sizeof(header) + offsetsSize + offsets[header.nEvents] * sizeof(MCTrack);
+  if (!ok) {
+    LOG(WARN) << "Indexed kinematics " << indexname << " is not compatible; not using it";
+    munmap(data, size);
+    return;
+  }
+  mapped.data = data;
+  mapped.size = size;
+  mapped.nEvents = header.nEvents;
+  mapped.offsets = offsets;
+  mapped.tracks = reinterpret_cast<MCTrack const*>((char const*)data + sizeof(header) + offsetsSize);
+  LOG(INFO) << "Using indexed kinematics " << indexname << " with " << mapped.nEvents << " events for source " << source;
+}
+
+bool MCKinematicsReader::writeIndexedKinematics(std::string_view prefix)
+{
+  const auto indexname = o2::base::NameConf::getMCKinematicsIndexFileName(prefix);
+  const auto kinename = o2::base::NameConf::getMCKinematicsFileName(prefix);
+  std::unique_ptr<TFile> file(TFile::Open(kinename.c_str()));
+  if (!file || file->IsZombie()) {
+    LOG(ERROR) << "Failed to open kinematics file " << kinename;
+    return false;
+  }
+  auto tree = (TTree*)file->Get("o2sim");
+  auto br = tree ? tree->GetBranch("MCTrack") : nullptr;
+  if (!br) {
+    LOG(ERROR) << "MCTrack branch not found in " << kinename;
+    return false;
+  }
+
+  // the tracks are streamed event by event; the offsets are written once all of them are known
+  // and the file is only renamed to its final name when complete
+  const auto tmpname = indexname + ".tmp";
+  std::ofstream out(tmpname, std::ios::binary | std::ios::trunc);
+  IndexedKinematicsHeader header;
+  header.nEvents = br->GetEntries();
+  std::vector<uint64_t> offsets(header.nEvents + 1, 0);
+  out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  out.write(reinterpret_cast<char const*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+  std::vector<MCTrack>* tracks = nullptr;
+  br->SetAddress(&tracks);
+  for (uint64_t event = 0; event < header.nEvents; ++event) {
+    br->GetEntry(event);
+    const size_t ntracks = tracks ? tracks->size() : 0;
+    if (ntracks) {
+      out.write(reinterpret_cast<char const*>(tracks->data()), ntracks * sizeof(MCTrack));
+    }
+    offsets[event + 1] = offsets[event] + ntracks;
+  }
+  br->ResetAddress();
+  delete tracks;
+  out.seekp(sizeof(header));
+  out.write(reinterpret_cast<char const*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+  out.close();
+  std::error_code ec;
+  if (out) {
+    std::filesystem::rename(tmpname, indexname, ec);
+  }
+  if (!out || ec) {
+    LOG(ERROR) << "Failed to write indexed kinematics " << indexname;
+    std::filesystem::remove(tmpname, ec);
+    return false;
+  }
+  LOG(INFO) << "Wrote indexed kinematics " << indexname << " with " << header.nEvents << " events and " << offsets.back() << " tracks";
+  return true;
+}
+
+void MCKinematicsReader::setMaxCachedEvents(size_t n)
+{
+  mMaxCachedEvents = n;
+  if (n == 0) {
+    mCachedEvents.clear();
+    mCachedEventPos.clear();
+    return;
+  }
+  // the events loaded so far enter the bookkeeping in arbitrary order
+  mCachedEventPos.resize(mTracks.size());
+  for (int source = 0; source < mTracks.size(); ++source) {
+    mCachedEventPos[source].resize(mTracks[source].size(), mCachedEvents.end());
+    for (int event = 0; event < mTracks[source].size(); ++event) {
+      if (mTracks[source][event] && mCachedEventPos[source][event] == mCachedEvents.end()) {
+        mCachedEvents.emplace_front(source, event);
+        mCachedEventPos[source][event] = mCachedEvents.begin();
+      }
+    }
+  }
+  while (mCachedEvents.size() > mMaxCachedEvents) {
+    auto [source, event] = mCachedEvents.back();
+    releaseTracks(source, event);
+  }
+}
+
+void MCKinematicsReader::touchCachedEvent(int source, int event) const
+{
+  auto& pos = mCachedEventPos[source][event];
+  if (pos == mCachedEvents.end()) {
+    mCachedEvents.emplace_front(source, event);
+    pos = mCachedEvents.begin();
+  } else {
+    mCachedEvents.splice(mCachedEvents.begin(), mCachedEvents, pos);
+  }
+}
+
 void MCKinematicsReader::initTracksForSource(int source) const
 {
+  if (mMapped[source].tracks) {
+    mTracks[source].resize(mMapped[source].nEvents, nullptr);
+    return;
+  }
   auto chain = mInputChains[source];
   if (chain) {
     // todo: get name from NameConfig
@@ -62,8 +225,10 @@ void MCKinematicsReader::initTracksForSource(int source) const
 
 void MCKinematicsReader::loadTracksForSourceAndEvent(int source, int event) const
 {
-  auto chain = mInputChains[source];
-  if (chain) {
+  auto const& mapped = mMapped[source];
+  if (mapped.tracks) {
+    mTracks[source][event] = new std::vector<o2::MCTrack>(mapped.tracks + mapped.offsets[event], mapped.tracks + mapped.offsets[event + 1]);
+  } else if (auto chain = mInputChains[source]) {
     // todo: get name from NameConfig
     auto br = chain->GetBranch("MCTrack");
     if (br) {
@@ -75,13 +240,34 @@ void MCKinematicsReader::loadTracksForSourceAndEvent(int source, int event) cons
       delete loadtracks;
     }
   }
+  if (mMaxCachedEvents > 0 && mTracks[source][event]) {
+    if (mCachedEventPos.size() <= source) {
+      mCachedEventPos.resize(source + 1);
+    }
+    mCachedEventPos[source].resize(mTracks[source].size(), mCachedEvents.end());
+    touchCachedEvent(source, event);
+    // release the least recently used events, the current one being the most recent
+    while (mCachedEvents.size() > mMaxCachedEvents) {
+      auto [lrusource, lruevent] = mCachedEvents.back();
+      releaseTracks(lrusource, lruevent);
+    }
+  }
 }
 
 void MCKinematicsReader::releaseTracksForSourceAndEvent(int source, int eventID)
+{
+  releaseTracks(source, eventID);
+}
+
+void MCKinematicsReader::releaseTracks(int source, int eventID) const
 {
   if (mTracks.at(source).at(eventID) != nullptr) {
     delete mTracks[source][eventID];
     mTracks[source][eventID] = nullptr;
+    if (source < mCachedEventPos.size() && eventID < mCachedEventPos[source].size() && mCachedEventPos[source][eventID] != mCachedEvents.end()) {
+      mCachedEvents.erase(mCachedEventPos[source][eventID]);
+      mCachedEventPos[source][eventID] = mCachedEvents.end();
+    }
   }
 }
 
@@ -153,6 +339,12 @@ bool MCKinematicsReader::initFromDigitContext(std::string_view name)
   mTracks.resize(mInputChains.size());
   mHeaders.resize(mInputChains.size());
   mIndexedTrackRefs.resize(mInputChains.size());
+  mMapped.resize(mInputChains.size());
+  // tracks are served from the indexed kinematics files where available
+  const auto& prefixes = mDigitizationContext->getSimPrefixes();
+  for (int source = 0; source < prefixes.size() && source < mMapped.size(); ++source) {
+    mapIndexedKinematics(source, prefixes[source]);
+  }
 
   // actual loading will be done only if someone asks
   // the first time for a particular source ...
@@ -171,6 +363,8 @@ bool MCKinematicsReader::initFromKinematics(std::string_view name)
   mTracks.resize(1);
   mHeaders.resize(1);
   mIndexedTrackRefs.resize(1);
+  mMapped.resize(1);
+  mapIndexedKinematics(0, std::string(name));
   mInitialized = true;
 
   return true;
@@ -28,6 +28,8 @@
 #include <FairVolume.h>
 #include <DetectorsCommonDataFormats/NameConf.h>
 #include "SimConfig/SimUserDecay.h"
+#include "Steer/GeometryCache.h"
+#include "DetectorsBase/MaterialManager.h"
 
 namespace o2
 {
@@ -52,6 +54,9 @@ void TypedVectorAttach(const char* name, FairMQChannel& channel, FairMQParts& pa
 void O2MCApplicationBase::Stepping()
 {
   mStepCounter++;
+  if (mStepStatistics.isActive()) {
+    mStepStatistics.step(fMC);
+  }
   if (mCutParams.stepFiltering) {
     // we can kill tracks here based on our
     // custom detector specificities
@@ -107,8 +112,36 @@ void O2MCApplicationBase::ConstructGeometry()
       }
     }
   }
-  gGeoManager->SetUniqueID(dmask.to_ulong());
-  FairMCApplication::ConstructGeometry();
+  auto& geomcache = GeometryCache::Instance();
+  if (geomcache.isLoading()) {
+    // the modules do not construct their geometry: it is loaded from the cache and imported to VMC
+    std::map<int, std::string> volumeModules;
+    geomcache.load(volumeModules);
+    std::map<std::string, int> modNameToId;
+    for (auto& m : mModIdToName) {
+      modNameToId[m.second] = m.first;
+    }
+    for (auto& v : volumeModules) {
+      auto mod = modNameToId.find(v.second);
+      if (mod != modNameToId.end()) {
+        fModVolMap.insert(std::pair<Int_t, Int_t>(v.first, mod->second));
+      }
+    }
+    gGeoManager->SetUniqueID(dmask.to_ulong());
+    // hide the modules while FairRoot finalizes the (empty) construction
+    const bool owner = fModules->IsOwner();
+    fModules->SetOwner(kFALSE);
+    TObjArray modules(*fModules);
+    fModules->Clear();
+    FairMCApplication::ConstructGeometry();
+    for (int i = 0; i < modules.GetEntries(); ++i) {
+      fModules->Add(modules.At(i));
+    }
+    fModules->SetOwner(owner);
+  } else {
+    gGeoManager->SetUniqueID(dmask.to_ulong());
+    FairMCApplication::ConstructGeometry();
+  }
 
   std::ofstream voltomodulefile("MCStepLoggerVolMap.dat");
   // construct the volume name to module name mapping useful for StepAnalysis
@@ -122,6 +155,10 @@ void O2MCApplicationBase::ConstructGeometry()
 
 void O2MCApplicationBase::InitGeometry()
 {
+  if (GeometryCache::Instance().isLoading()) {
+    // the media are now known to the engine
+    o2::base::MaterialManager::Instance().applySpecialCutsAndProcesses();
+  }
   FairMCApplication::InitGeometry();
   // now the sensitive volumes are set up in fVolMap and we can query them
   for (auto e : fVolMap) {
@@ -137,9 +174,13 @@ void O2MCApplicationBase::InitGeometry()
 
 bool O2MCApplicationBase::MisalignGeometry()
 {
-  for (auto det : listActiveDetectors) {
-    if (dynamic_cast<o2::base::Detector*>(det)) {
-      ((o2::base::Detector*)det)->addAlignableVolumes();
+  auto& geomcache = GeometryCache::Instance();
+  // a cached geometry has the alignable volumes already
+  if (!geomcache.isLoading()) {
+    for (auto det : listActiveDetectors) {
+      if (dynamic_cast<o2::base::Detector*>(det)) {
+        ((o2::base::Detector*)det)->addAlignableVolumes();
+      }
     }
   }
 
@@ -152,6 +193,13 @@ bool O2MCApplicationBase::MisalignGeometry()
   auto& confref = o2::conf::SimConfig::Instance();
   auto geomfile = o2::base::NameConf::getGeomFileName(confref.getOutPrefix());
   gGeoManager->Export(geomfile.c_str());
+  if (geomcache.isWriting()) {
+    std::map<int, std::string> volumeModules;
+    for (auto& v : fModVolMap) {
+      volumeModules[v.first] = mModIdToName[v.second];
+    }
+    geomcache.write(volumeModules);
+  }
 
   // apply alignment for included detectors AFTER exporting ideal geometry
   auto& aligner = o2::base::Aligner::Instance();
@@ -164,6 +212,7 @@ bool O2MCApplicationBase::MisalignGeometry()
 void O2MCApplicationBase::finishEventCommon()
 {
   LOG(INFO) << "This event/chunk did " << mStepCounter << " steps";
+  mStepStatistics.report(fMC, o2::conf::SimStepStatParams::Instance().nPrint);
 
   auto header = static_cast<o2::dataformats::MCEventHeader*>(fMCEventHeader);
   header->getMCEventStats().setNSteps(mStepCounter);
@@ -197,6 +246,11 @@ void O2MCApplicationBase::BeginEvent()
   static_cast<o2::data::Stack*>(GetStack())->setMCEventStats(&header->getMCEventStats());
 
   mStepCounter = 0;
+  if (!mStepStatistics.isInitialized()) {
+    const auto& statParams = o2::conf::SimStepStatParams::Instance();
+    mStepStatistics.init(fMC, statParams.sampling, statParams.volumes);
+  }
+  mStepStatistics.reset();
 }
 
 void O2MCApplicationBase::AddParticles()
@@ -0,0 +1,115 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Steer/StepStatistics.h"
+#include "Framework/Logger.h"
+#include <TVirtualMC.h>
+#include <algorithm>
+#include <sstream>
+
+using namespace o2::steer;
+
+void StepStatistics::init(TVirtualMC* mc, int sampling, const std::string& volumes)
+{
+  mInitialized = true;
+  mSampling = std::max(0, sampling);
+  mSelectedVolumes.clear();
+  mVolumes.assign(mc ? mc->NofVolumes() + 1 : 0, Entry{});
+  if (!isActive()) {
+    return;
+  }
+  std::stringstream names(volumes);
+  std::string name;
+  while (std::getline(names, name, ',')) {
+    if (name.empty()) {
+      continue;
+    }
+    int id = mc->VolId(name.c_str());
+    if (id <= 0) {
+      LOG(WARNING) << "StepStatistics: unknown volume " << name;
+      continue;
+    }
+    mSelectedVolumes.resize(mVolumes.size(), 0);
+    mSelectedVolumes[id] = 1;
+  }
+  LOG(INFO) << "StepStatistics: sampling 1 out of " << mSampling << " steps"
+            << (mSelectedVolumes.empty() ? std::string() : " in the volumes " + volumes);
+}
+
+void StepStatistics::sample(TVirtualMC* mc)
+{
+  int copy;
+  int id = mc->CurrentVolID(copy);
+  if (id < 0 || (!mSelectedVolumes.empty() && (id >= int(mSelectedVolumes.size()) || !mSelectedVolumes[id]))) {
+    return;
+  }
+  if (id >= int(mVolumes.size())) {
+    mVolumes.resize(id + 1);
+  }
+  mPendingVolume = id;
+  mPendingPDG = mc->TrackPid();
+  mPendingStart = std::chrono::steady_clock::now();
+}
+
+void StepStatistics::closePending()
+{
+  double dt = std::chrono::duration<double>(std::chrono::steady_clock::now() - mPendingStart).count();
+  auto& vol = mVolumes[mPendingVolume];
+  vol.nSteps++;
+  vol.time += dt;
+  auto& part = mParticles[mPendingPDG];
+  part.nSteps++;
+  part.time += dt;
+  mPendingVolume = -1;
+}
+
+void StepStatistics::reset()
+{
+  std::fill(mVolumes.begin(), mVolumes.end(), Entry{});
+  mParticles.clear();
+  mPendingVolume = -1;
+  mCounter = 0;
+}
+
+void StepStatistics::report(TVirtualMC* mc, int nPrint) const
+{
+  if (!isActive()) {
+    return;
+  }
+  double totTime = 0.;
+  uint64_t totSteps = 0;
+  std::vector<std::pair<int, Entry>> volumes;
+  for (int id = 0; id < int(mVolumes.size()); id++) {
+    if (mVolumes[id].nSteps) {
+      volumes.emplace_back(id, mVolumes[id]);
+      totTime += mVolumes[id].time;
+      totSteps += mVolumes[id].nSteps;
+    }
+  }
+  std::vector<std::pair<int, Entry>> particles(mParticles.begin(), mParticles.end());
+  auto byTime = [](const std::pair<int, Entry>& a, const std::pair<int, Entry>& b) { return a.second.time > b.second.time; };
+  auto nv = std::min(size_t(nPrint), volumes.size()), np = std::min(size_t(nPrint), particles.size());
+  std::partial_sort(volumes.begin(), volumes.begin() + nv, volumes.end(), byTime);
+  std::partial_sort(particles.begin(), particles.begin() + np, particles.end(), byTime);
+
+  LOG(INFO) << "StepStatistics: " << totSteps * mSampling << " steps (extrapolated from " << totSteps
+            << " sampled) in " << totTime * mSampling << " s";
+  auto print = [this, totTime](const char* what, const std::string& name, const Entry& e) {
+    LOGP(INFO, "StepStatistics: {} {:>24} steps {:>12} time {:10.3f} s ({:5.1f}%)", what, name, e.nSteps * mSampling,
+         e.time * mSampling, totTime > 0. ? 100. * e.time / totTime : 0.);
+  };
+  for (size_t i = 0; i < nv; i++) {
+    print("VolName", mc ? mc->VolName(volumes[i].first) : std::to_string(volumes[i].first), volumes[i].second);
+  }
+  for (size_t i = 0; i < np; i++) {
+    print("PDG", std::to_string(particles[i].first), particles[i].second);
+  }
+}
@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test HitPrefetcher class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "Steer/HitPrefetcher.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace steer
+{
+
+BOOST_AUTO_TEST_CASE(HitPrefetcherTest)
+{
+  // make mockup sim files, the "hits" of each entry encode the source and entry
+  auto makefile = [](std::string name, int source, int n) {
+    TFile file(name.c_str(), "RECREATE");
+    TTree tree("o2sim", "");
+    std::vector<int> hits;
+    auto ptr = &hits;
+    tree.Branch("Hits", &ptr);
+    for (int entry = 0; entry < n; ++entry) {
+      hits.assign(entry % 3, 1000 * source + entry);
+      tree.Fill();
+    }
+    tree.Write();
+    file.Close();
+  };
+  makefile("hitprefetcher_0.root", 0, 10);
+  makefile("hitprefetcher_1.root", 1, 5);
+  std::vector<TChain*> chains{new TChain("o2sim"), new TChain("o2sim")};
+  chains[0]->AddFile("hitprefetcher_0.root");
+  chains[1]->AddFile("hitprefetcher_1.root");
+
+  // collisions with background events used several times
+  std::vector<std::vector<EventPart>> eventParts;
+  for (int coll = 0; coll < 30; ++coll) {
+    eventParts.push_back({EventPart(0, (coll * 7) % 10)});
+    if (coll % 6 == 0) {
+      eventParts.back().emplace_back(1, coll / 6);
+    }
+  }
+
+  for (int lookahead : {0, 4}) {
+    HitPrefetcher<int> prefetcher(chains, {"Hits"}, eventParts, lookahead);
+    for (auto& collision : eventParts) {
+      for (auto& part : collision) {
+        auto hits = prefetcher.getHits(part);
+        BOOST_CHECK(hits->size() == part.entryID % 3);
+        for (auto h : *hits) {
+          BOOST_CHECK(h == 1000 * part.sourceID + part.entryID);
+        }
+      }
+    }
+    // parts outside of the sequence are read on demand
+    BOOST_CHECK(prefetcher.getHits(EventPart(0, 2))->size() == 2);
+  }
+
+  for (auto chain : chains) {
+    delete chain;
+  }
+}
+
+} // namespace steer
+} // namespace o2
@@ -16,6 +16,7 @@
 #include <boost/test/unit_test.hpp>
 #include "CommonDataFormat/InteractionRecord.h"
 #include "Steer/InteractionSampler.h"
+#include <TRandom.h>
 
 namespace o2
 {
@@ -85,4 +86,27 @@ BOOST_AUTO_TEST_CASE(InteractionSampler)
   sampler1.print();
   sampler1.getBunchFilling().print();
 }
+
+BOOST_AUTO_TEST_CASE(InteractionSamplerBulk)
+{
+  // the bulk generation must give the same records as the generation one by one
+  using Sampler = o2::steer::InteractionSampler;
+  const int ntest = 10000;
+  Sampler sampler1, sampler2;
+  sampler1.setMuPerBC(0.5); // lot of in-bunch pile-up, so that the bulk requests end inside a BC
+  sampler2.setMuPerBC(0.5);
+  gRandom->SetSeed(1234);
+  sampler1.init();
+  gRandom->SetSeed(1234);
+  sampler2.init();
+
+  std::vector<o2::InteractionTimeRecord> records;
+  for (int n = 1; records.size() < ntest; n += 7) {
+    sampler2.appendCollisionTimes(records, n);
+  }
+  for (const auto& rec : records) {
+    auto rec1 = sampler1.generateCollisionTime();
+    BOOST_CHECK(rec1 == rec);
+  }
+}
 } // namespace o2
@@ -0,0 +1,81 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MCKinematicsReader class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "Steer/MCKinematicsReader.h"
+#include "DetectorsCommonDataFormats/NameConf.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace steer
+{
+
+BOOST_AUTO_TEST_CASE(MCKinematicsReaderTest)
+{
+  // make a mockup kinematics file with a different number of tracks per event
+  const std::string prefix = "kinereadertest";
+  const std::vector<int> ntracks{3, 0, 5};
+  std::remove(o2::base::NameConf::getMCKinematicsIndexFileName(prefix).c_str());
+  {
+    TFile file(o2::base::NameConf::getMCKinematicsFileName(prefix).c_str(), "RECREATE");
+    TTree tree("o2sim", "");
+    std::vector<MCTrack> tracks;
+    auto ptr = &tracks;
+    tree.Branch("MCTrack", &ptr);
+    for (int event = 0; event < ntracks.size(); ++event) {
+      tracks.clear();
+      for (int track = 0; track < ntracks[event]; ++track) {
+        tracks.emplace_back(100 * event + track, -1, -1, -1, -1, 0., 0., 1., 0., 0., 0., 0., 0);
+      }
+      tree.Fill();
+    }
+    tree.Write();
+    file.Close();
+  }
+
+  auto check = [&ntracks](MCKinematicsReader const& reader) {
+    BOOST_CHECK(reader.getNEvents(0) == ntracks.size());
+    for (int event = ntracks.size() - 1; event >= 0; --event) {
+      BOOST_CHECK(reader.getTracks(0, event).size() == ntracks[event]);
+      BOOST_CHECK(reader.getTracksView(0, event).size() == ntracks[event]);
+      for (int track = 0; track < ntracks[event]; ++track) {
+        BOOST_CHECK(reader.getTrack(event, track)->GetPdgCode() == 100 * event + track);
+      }
+    }
+  };
+
+  // tracks read from the tree, keeping at most one event in memory
+  {
+    MCKinematicsReader reader(prefix, MCKinematicsReader::Mode::kMCKine);
+    BOOST_CHECK(!reader.isIndexed(0));
+    reader.setMaxCachedEvents(1);
+    check(reader);
+  }
+
+  // tracks served from the indexed kinematics
+  BOOST_CHECK(MCKinematicsReader::writeIndexedKinematics(prefix));
+  {
+    MCKinematicsReader reader(prefix, MCKinematicsReader::Mode::kMCKine);
+    BOOST_CHECK(reader.isIndexed(0));
+    check(reader);
+  }
+}
+
+} // namespace steer
+} // namespace o2
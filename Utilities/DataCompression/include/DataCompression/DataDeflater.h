@@ -25,6 +25,7 @@
 #include <cerrno>
 #include <stdexcept>
 #include <cassert>
+#include <functional>
 
 namespace o2
 {
@@ -122,6 +123,13 @@ class DataDeflater
       // TODO: error policy
       throw std::runtime_error("bit length exceeds width of the data type");
     }
+    // the common case of the value fitting into the current target word, w/o loop
+    if (bitlength > 0 && bitlength < 8 * sizeof(ValueType) && bitlength <= TargetBitWidth - mFilledBits) {
+      auto activebits = value & (((ValueType)1 << bitlength) - 1);
+      mFilledBits += bitlength;
+      mCurrent |= target_type(activebits) << (TargetBitWidth - mFilledBits);
+      return bitlength;
+    }
     while (bitsToWrite > 0) {
       if (mFilledBits == TargetBitWidth) {
         mFilledBits = 0;
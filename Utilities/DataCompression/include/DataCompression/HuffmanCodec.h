@@ -21,6 +21,7 @@
 /// @since  2016-08-11
 /// @brief  Implementation of a Huffman codec
 
+#include <algorithm>
 #include <cstdint>
 #include <cerrno>
 #include <set>
@@ -248,6 +249,8 @@ class HuffmanModel : public _BASE
   using node_type = HuffmanNode<code_type>;
   using value_type = typename _BASE::value_type;
   static constexpr bool OrderMSB = orderMSB;
+  /// maximum number of leading code bits resolved at once by the decoding table
+  static constexpr int sMaxDecodingTableBits = 10;
 
   int init(double v = 1.) { return _BASE::initWeight(mAlphabet, v); }
 
@@ -294,12 +297,21 @@ class HuffmanModel : public _BASE
     // to let the dereferencing below throw an exception
     codeLength = 0;
     typename _BASE::value_type v = 0;
-    // dereference the iterator and get raw pointer from shared pointer
-    // TODO: work on shared pointers here as well
-    // the top node is the only element in the multiset after using the
-    // weighted sort algorithm to build the tree, all nodes are referenced
-    // from their parents in the tree.
-    const node_type* node = (*mTreeNodes.begin()).get();
+    const node_type* node = nullptr;
+    if (!mDecodingTable.empty()) {
+      // the leading bits of the code select the leave node directly, or the
+      // node from which the tree has to be followed for the longer codes
+      const auto& entry = mDecodingTable[getDecodingTableIndex(code)];
+      node = entry.node;
+      codeLength = entry.length;
+    } else {
+      // dereference the iterator and get raw pointer from shared pointer
+      // TODO: work on shared pointers here as well
+      // the top node is the only element in the multiset after using the
+      // weighted sort algorithm to build the tree, all nodes are referenced
+      // from their parents in the tree.
+      node = (*mTreeNodes.begin()).get();
+    }
     uint16_t codeMSB = code.size() - 1;
     while (node) {
       // N.B.: nodes have either both child nodes or none of them
@@ -403,6 +415,7 @@ class HuffmanModel : public _BASE
     // dereference iterator and shared_ptr to get the raw pointer
     // TODO: change method to work on shared instead of raw pointers
     assignCode((*mTreeNodes.begin()).get());
+    buildDecodingTable();
     return true;
   }
 
@@ -609,6 +622,7 @@ class HuffmanModel : public _BASE
                 << "; " << treeNodes.size() << " tree nodes(s), expected 1" << std::endl;
     }
     mTreeNodes.insert(treeNodes.begin()->second);
+    buildDecodingTable();
     return 0;
   }
 
@@ -652,12 +666,72 @@ class HuffmanModel : public _BASE
     return rightIndex + 1;
   }
 
+  /**
+   * @brief Build the table for decoding the leading bits of a code at once.
+   *
+   * The table is indexed by the first mDecodingTableBits bits of the code, in
+   * the order they are read by Decode. Every entry holds the leave node of the
+   * code starting with these bits together with its code length, or the tree
+   * node reached after them if the code is longer.
+   */
+  void buildDecodingTable()
+  {
+    mDecodingTable.clear();
+    if (mTreeNodes.size() == 0) {
+      return;
+    }
+    const node_type* topNode = (*mTreeNodes.begin()).get();
+    mDecodingTableBits = std::min({sMaxDecodingTableBits, getDepth(topNode), int(code_type().size())});
+    mDecodingTable.resize(std::size_t(1) << mDecodingTableBits);
+    fillDecodingTable(topNode, 0, 0);
+  }
+
+  int getDepth(const node_type* node) const
+  {
+    if (node == nullptr || node->getLeftChild() == nullptr) {
+      return 0;
+    }
+    return 1 + std::max(getDepth(node->getLeftChild()), getDepth(node->getRightChild()));
+  }
+
+  /// fill the entries of all indices starting with the depth bits of prefix leading to node
+  void fillDecodingTable(const node_type* node, int depth, std::size_t prefix)
+  {
+    if (node->getLeftChild() == nullptr || depth == mDecodingTableBits) {
+      const std::size_t nEntries = std::size_t(1) << (mDecodingTableBits - depth);
+      for (std::size_t i = 0; i < nEntries; i++) {
+        auto index = OrderMSB ? (prefix << (mDecodingTableBits - depth)) | i : prefix | (i << depth);
+        mDecodingTable[index] = {node, uint16_t(depth)};
+      }
+      return;
+    }
+    // bit '1' branch to the left, bit '0' branch to the right
+    fillDecodingTable(node->getLeftChild(), depth + 1, OrderMSB ? (prefix << 1) | 1 : prefix | (std::size_t(1) << depth));
+    fillDecodingTable(node->getRightChild(), depth + 1, OrderMSB ? (prefix << 1) : prefix);
+  }
+
+  std::size_t getDecodingTableIndex(const code_type& code) const
+  {
+    if (OrderMSB) {
+      return (code >> (code.size() - mDecodingTableBits)).to_ullong();
+    }
+    return (code & code_type((1ull << mDecodingTableBits) - 1)).to_ullong();
+  }
+
+  struct DecodingTableEntry {
+    const node_type* node = nullptr;
+    uint16_t length = 0;
+  };
+
   // the alphabet, determined by template parameter
   typename _BASE::alphabet_type mAlphabet;
   // Huffman leave nodes containing symbol index to code mapping
   std::vector<std::shared_ptr<node_type>> mLeaveNodes;
   // multiset, order determined by less functor working on pointers
   std::multiset<std::shared_ptr<node_type>, isless<std::shared_ptr<node_type>>> mTreeNodes;
+  // lookup of the nodes for the leading code bits, the nodes are owned by mTreeNodes
+  std::vector<DecodingTableEntry> mDecodingTable;
+  int mDecodingTableBits = 0;
 };
 
 } // namespace data_compression
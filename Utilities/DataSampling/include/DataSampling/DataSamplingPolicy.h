@@ -76,6 +76,11 @@ class DataSamplingPolicy
   const framework::OutputSpec* match(const framework::ConcreteDataMatcher& input) const;
   /// \brief Returns true if user-defined conditions of sampling are fulfilled.
   bool decide(const o2::framework::DataRef&);
+  /// \brief Accounts a decision which was taken by another policy with the same sampling, see hasSameSampling().
+  void registerDecision(bool decision);
+  /// \brief Returns true if the other policy requires the same data and samples it with the same conditions,
+  /// so that it would take the same decisions. It is known only for policies created from configuration.
+  bool hasSameSampling(const DataSamplingPolicy& other) const;
   /// \brief Returns Output for given InputSpec to pass data forward.
   framework::Output prepareOutput(const framework::ConcreteDataMatcher& input, framework::Lifetime lifetime = framework::Lifetime::Timeframe) const;
 
@@ -86,6 +91,9 @@ class DataSamplingPolicy
   std::string getFairMQOutputChannelName() const;
   uint32_t getTotalAcceptedMessages() const;
   uint32_t getTotalEvaluatedMessages() const;
+  uint64_t getTotalAcceptedBytes() const;
+  /// \brief Accounts the payload size of a part which was sampled by this policy.
+  void addAcceptedBytes(uint64_t bytes);
 
   static header::DataOrigin createPolicyDataOrigin();
   static header::DataDescription createPolicyDataDescription(std::string policyName, size_t id);
@@ -95,10 +103,13 @@ class DataSamplingPolicy
   PathMap mPaths;
   std::vector<std::unique_ptr<DataSamplingCondition>> mConditions;
   std::string mFairMQOutputChannel;
+  // configuration of the conditions, empty if they were not created from configuration
+  std::string mConditionsConfiguration;
 
   // stats
   uint32_t mTotalAcceptedMessages = 0;
   uint32_t mTotalEvaluatedMessages = 0;
+  uint64_t mTotalAcceptedBytes = 0;
 };
 
 } // namespace o2::utilities
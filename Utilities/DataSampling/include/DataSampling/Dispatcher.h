@@ -20,7 +20,9 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
+#include "Framework/ConcreteDataMatcher.h"
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/Task.h"
@@ -65,7 +67,21 @@ class Dispatcher : public framework::Task
   framework::Options getOptions();
 
  private:
-  DataSamplingHeader prepareDataSamplingHeader(const DataSamplingPolicy& policy);
+  /// A policy matching an input, with the data type of its output
+  struct Route {
+    size_t policyIndex;
+    framework::ConcreteDataTypeMatcher output;
+  };
+  struct ConcreteDataMatcherHash {
+    size_t operator()(const framework::ConcreteDataMatcher& matcher) const;
+  };
+
+  /// \brief Returns the policies matching the input, they are looked up once per input and then cached.
+  const std::vector<Route>& getRoutes(const framework::ConcreteDataMatcher& input);
+  /// \brief Groups the policies which would take the same sampling decisions, these are taken only once per input.
+  void prepareDecisionGroups();
+
+  DataSamplingHeader prepareDataSamplingHeader(const DataSamplingPolicy& policy, uint64_t sampleTime);
   header::Stack extractAdditionalHeaders(const char* inputHeaderStack) const;
   void reportStats(monitoring::Monitoring& monitoring) const;
   void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, const framework::Output& output) const;
@@ -75,6 +91,12 @@ class Dispatcher : public framework::Task
   std::string mReconfigurationSource;
   // policies should be shared between all pipeline threads
   std::vector<std::shared_ptr<DataSamplingPolicy>> mPolicies;
+  // routes of the inputs seen so far
+  std::unordered_map<framework::ConcreteDataMatcher, std::vector<Route>, ConcreteDataMatcherHash> mRoutes;
+  // index of the first policy which takes the same decisions, for each policy
+  std::vector<size_t> mDecisionGroups;
+  // decisions taken for the current input, for each group, -1 if not taken yet
+  std::vector<int8_t> mDecisions;
 };
 
 } // namespace o2::utilities
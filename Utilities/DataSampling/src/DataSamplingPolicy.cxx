@@ -22,6 +22,8 @@
 #include "Framework/Logger.h"
 
 #include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <sstream>
 
 using namespace o2::framework;
 
@@ -97,6 +99,9 @@ DataSamplingPolicy DataSamplingPolicy::fromConfiguration(const ptree& config)
     condition->configure(conditionConfig.second);
     policy.registerCondition(std::move(condition));
   }
+  std::stringstream conditionsConfiguration;
+  boost::property_tree::write_json(conditionsConfiguration, config.get_child("samplingConditions"), false);
+  policy.mConditionsConfiguration = conditionsConfiguration.str();
 
   policy.setFairMQOutputChannel(config.get_optional<std::string>("fairMQOutput").value_or(""));
 
@@ -122,6 +127,25 @@ bool DataSamplingPolicy::decide(const o2::framework::DataRef& dataRef)
   return decision;
 }
 
+void DataSamplingPolicy::registerDecision(bool decision)
+{
+  mTotalAcceptedMessages += decision;
+  mTotalEvaluatedMessages++;
+}
+
+bool DataSamplingPolicy::hasSameSampling(const DataSamplingPolicy& other) const
+{
+  if (mConditionsConfiguration.empty() || mConditionsConfiguration != other.mConditionsConfiguration || mPaths.size() != other.mPaths.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < mPaths.size(); i++) {
+    if (!(mPaths[i].first == other.mPaths[i].first)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Output DataSamplingPolicy::prepareOutput(const ConcreteDataMatcher& input, Lifetime lifetime) const
 {
   auto result = mPaths.find(input);
@@ -164,6 +188,14 @@ uint32_t DataSamplingPolicy::getTotalEvaluatedMessages() const
 {
   return mTotalEvaluatedMessages;
 }
+uint64_t DataSamplingPolicy::getTotalAcceptedBytes() const
+{
+  return mTotalAcceptedBytes;
+}
+void DataSamplingPolicy::addAcceptedBytes(uint64_t bytes)
+{
+  mTotalAcceptedBytes += bytes;
+}
 
 header::DataOrigin DataSamplingPolicy::createPolicyDataOrigin()
 {
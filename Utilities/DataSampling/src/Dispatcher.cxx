@@ -27,6 +27,9 @@
 #include <Configuration/ConfigurationInterface.h>
 #include <Configuration/ConfigurationFactory.h>
 
+#include <algorithm>
+#include <optional>
+
 using namespace o2::configuration;
 using namespace o2::monitoring;
 using namespace o2::framework;
@@ -71,6 +74,9 @@ void Dispatcher::init(InitContext& ctx)
     }
   }
 
+  mRoutes.clear();
+  prepareDecisionGroups();
+
   auto spec = ctx.services().get<const DeviceSpec>();
   mDeviceID.runtimeInit(spec.id.substr(0, DataSamplingHeader::deviceIDTypeSize).c_str());
 }
@@ -81,6 +87,8 @@ void Dispatcher::run(ProcessingContext& ctx)
   //  it is not trivial though, we would have to share state with the customize() method,
   //  which is not possible atm.
 
+  std::optional<uint64_t> sampleTime;
+
   for (auto inputIt = ctx.inputs().begin(); inputIt != ctx.inputs().end(); inputIt++) {
 
     const DataRef& firstPart = inputIt.getByPos(0);
@@ -90,14 +98,29 @@ void Dispatcher::run(ProcessingContext& ctx)
     const auto* firstInputHeader = header::get<header::DataHeader*>(firstPart.header);
     ConcreteDataMatcher inputMatcher{firstInputHeader->dataOrigin, firstInputHeader->dataDescription, firstInputHeader->subSpecification};
 
-    for (auto& policy : mPolicies) {
-      // fixme: in principle matching could be broken by having query "TST/RAWDATA/0" and having parts with just
-      //  the first subspec == 0, but others could be different. However, we trust that DPL does necessary checks
-      //  during workflow validation and when passing messages (e.g. query "TST/RAWDATA/0" should not match
-      //  a "TST/RAWDATA/*" output.
-      if (auto route = policy->match(inputMatcher); route != nullptr && policy->decide(firstPart)) {
-        auto routeAsConcreteDataType = DataSpecUtils::asConcreteDataTypeMatcher(*route);
-        auto dsheader = prepareDataSamplingHeader(*policy);
+    // fixme: in principle matching could be broken by having query "TST/RAWDATA/0" and having parts with just
+    //  the first subspec == 0, but others could be different. However, we trust that DPL does necessary checks
+    //  during workflow validation and when passing messages (e.g. query "TST/RAWDATA/0" should not match
+    //  a "TST/RAWDATA/*" output.
+    const auto& routes = getRoutes(inputMatcher);
+    std::fill(mDecisions.begin(), mDecisions.end(), -1);
+    for (const auto& route : routes) {
+      auto& policy = mPolicies[route.policyIndex];
+      // policies with the same sampling take the decision of the first one of their group
+      auto& groupDecision = mDecisions[mDecisionGroups[route.policyIndex]];
+      bool decision;
+      if (groupDecision < 0) {
+        decision = policy->decide(firstPart);
+        groupDecision = decision;
+      } else {
+        decision = groupDecision;
+        policy->registerDecision(decision);
+      }
+      if (decision) {
+        if (!sampleTime.has_value()) {
+          sampleTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        }
+        auto dsheader = prepareDataSamplingHeader(*policy, sampleTime.value());
         for (const auto& part : inputIt) {
           if (part.header != nullptr) {
             // We copy every header which is not DataHeader or DataProcessingHeader,
@@ -109,12 +132,13 @@ void Dispatcher::run(ProcessingContext& ctx)
             const auto* partInputHeader = header::get<header::DataHeader*>(part.header);
 
             Output output{
-              routeAsConcreteDataType.origin,
-              routeAsConcreteDataType.description,
+              route.output.origin,
+              route.output.description,
               partInputHeader->subSpecification,
               part.spec->lifetime,
               std::move(headerStack)};
             send(ctx.outputs(), part, output);
+            policy->addAcceptedBytes(partInputHeader->payloadSize);
           }
         }
       }
@@ -130,20 +154,59 @@ void Dispatcher::reportStats(Monitoring& monitoring) const
 {
   uint64_t dispatcherTotalEvaluatedMessages = 0;
   uint64_t dispatcherTotalAcceptedMessages = 0;
+  uint64_t dispatcherTotalAcceptedBytes = 0;
 
   for (const auto& policy : mPolicies) {
     dispatcherTotalEvaluatedMessages += policy->getTotalEvaluatedMessages();
     dispatcherTotalAcceptedMessages += policy->getTotalAcceptedMessages();
+    dispatcherTotalAcceptedBytes += policy->getTotalAcceptedBytes();
+    monitoring.send({policy->getTotalAcceptedBytes(), "Dispatcher_bytes_passed_" + policy->getName()}, DerivedMetricMode::RATE);
   }
 
   monitoring.send({dispatcherTotalEvaluatedMessages, "Dispatcher_messages_evaluated"});
   monitoring.send({dispatcherTotalAcceptedMessages, "Dispatcher_messages_passed"});
+  monitoring.send({dispatcherTotalAcceptedBytes, "Dispatcher_bytes_passed"}, DerivedMetricMode::RATE);
 }
 
-DataSamplingHeader Dispatcher::prepareDataSamplingHeader(const DataSamplingPolicy& policy)
+size_t Dispatcher::ConcreteDataMatcherHash::operator()(const ConcreteDataMatcher& matcher) const
 {
-  uint64_t sampleTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+  uint64_t hash = matcher.description.itg[0] ^ (matcher.description.itg[1] * 0x9e3779b97f4a7c15ull);
+  hash ^= ((static_cast<uint64_t>(matcher.origin.itg[0]) << 32) | matcher.subSpec) * 0xff51afd7ed558ccdull;
+  return std::hash<uint64_t>{}(hash);
+}
 
+const std::vector<Dispatcher::Route>& Dispatcher::getRoutes(const ConcreteDataMatcher& input)
+{
+  auto it = mRoutes.find(input);
+  if (it != mRoutes.end()) {
+    return it->second;
+  }
+  std::vector<Route> routes;
+  for (size_t i = 0; i < mPolicies.size(); i++) {
+    if (auto route = mPolicies[i]->match(input); route != nullptr) {
+      routes.push_back({i, DataSpecUtils::asConcreteDataTypeMatcher(*route)});
+    }
+  }
+  return mRoutes.emplace(input, std::move(routes)).first->second;
+}
+
+void Dispatcher::prepareDecisionGroups()
+{
+  mDecisionGroups.resize(mPolicies.size());
+  for (size_t i = 0; i < mPolicies.size(); i++) {
+    mDecisionGroups[i] = i;
+    for (size_t j = 0; j < i; j++) {
+      if (mDecisionGroups[j] == j && mPolicies[j]->hasSameSampling(*mPolicies[i])) {
+        mDecisionGroups[i] = j;
+        break;
+      }
+    }
+  }
+  mDecisions.assign(mPolicies.size(), -1);
+}
+
+DataSamplingHeader Dispatcher::prepareDataSamplingHeader(const DataSamplingPolicy& policy, uint64_t sampleTime)
+{
   return {
     sampleTime,
     policy.getTotalAcceptedMessages(),
@@ -169,12 +232,19 @@ header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
 void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output) const
 {
   const auto* inputHeader = header::get<header::DataHeader*>(inputData.header);
-  dataAllocator.snapshot(output, inputData.payload, inputHeader->payloadSize, inputHeader->payloadSerializationMethod);
+  if (inputData.payloadMessage != nullptr) {
+    // the payload is shared with the input message whenever the transport allows it
+    dataAllocator.forward(output, *inputData.payloadMessage, inputHeader->payloadSerializationMethod);
+  } else {
+    dataAllocator.snapshot(output, inputData.payload, inputHeader->payloadSize, inputHeader->payloadSerializationMethod);
+  }
 }
 
 void Dispatcher::registerPolicy(std::unique_ptr<DataSamplingPolicy>&& policy)
 {
   mPolicies.emplace_back(std::move(policy));
+  mRoutes.clear();
+  prepareDecisionGroups();
 }
 
 const std::string& Dispatcher::getName()
@@ -138,4 +138,40 @@ BOOST_AUTO_TEST_CASE(DataSamplingPolicyStaticMethods)
   BOOST_CHECK(DataSamplingPolicy::createPolicyDataDescription("asdf", 0) == DataDescription("asdf0"));
   BOOST_CHECK(DataSamplingPolicy::createPolicyDataDescription("asdfasdfasdfasdf", 0) == DataDescription("asdfasdfasdfas0"));
   BOOST_CHECK(DataSamplingPolicy::createPolicyDataDescription("asdfasdfasdfasdf", 10) == DataDescription("asdfasdfasdfas10"));
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(DataSamplingPolicySameSampling)
+{
+  using boost::property_tree::ptree;
+
+  ptree config;
+  config.put("id", "my_policy");
+  config.put("query", "c:TST/CHLEB/33;m:TST/MLEKO/33");
+  ptree samplingConditions;
+  ptree conditionRandom;
+  conditionRandom.put("condition", "random");
+  conditionRandom.put("fraction", "0.1");
+  conditionRandom.put("seed", "2137");
+  samplingConditions.push_back(std::make_pair("", conditionRandom));
+  config.add_child("samplingConditions", samplingConditions);
+
+  auto policy = DataSamplingPolicy::fromConfiguration(config);
+
+  // the outputs do not matter
+  config.put("id", "other_policy");
+  auto samePolicy = DataSamplingPolicy::fromConfiguration(config);
+  BOOST_CHECK(policy.hasSameSampling(samePolicy));
+  BOOST_CHECK(samePolicy.hasSameSampling(policy));
+
+  config.get_child("samplingConditions").begin()->second.put("seed", "2138");
+  auto otherSeed = DataSamplingPolicy::fromConfiguration(config);
+  BOOST_CHECK(!policy.hasSameSampling(otherSeed));
+
+  config.get_child("samplingConditions").begin()->second.put("seed", "2137");
+  config.put("query", "c:TST/CHLEB/33");
+  auto otherQuery = DataSamplingPolicy::fromConfiguration(config);
+  BOOST_CHECK(!policy.hasSameSampling(otherQuery));
+
+  // conditions which are not created from configuration are never assumed to be the same
+  DataSamplingPolicy fromMethods("my_policy");
+  BOOST_CHECK(!fromMethods.hasSameSampling(fromMethods));
+}
@@ -0,0 +1,73 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_HISTOGRAMDELTA_H
+#define ALICEO2_HISTOGRAMDELTA_H
+
+/// \file HistogramDelta.h
+/// \brief Sparse differences of histograms, which are published by Mergers instead of the whole objects
+///
+/// A delta contains only the bins which are not empty in a histogram holding the differences since the last
+/// publication. Its payload is not ROOT-serialized: it consists of the indices of the bins (uint32_t), followed by
+/// their contents and, if the histogram has them, their sums of squares of weights (double).
+/// The histogram to which a delta is applied has to have the same binning as the one it was made of.
+
+#include "Headers/DataHeader.h"
+
+#include <gsl/span>
+#include <vector>
+
+class TObject;
+class TH1;
+
+namespace o2::mergers
+{
+
+/// @brief A header which describes a sparse difference of a histogram
+struct HistogramDeltaHeader : public header::BaseHeader {
+
+  // static data for this header type/version
+  static const uint32_t sVersion;
+  static const o2::header::HeaderType sHeaderType;
+  static const o2::header::SerializationMethod sSerializationMethod;
+
+  static constexpr int nStats = 13; // TH1::kNstat
+
+  uint32_t publication = 0; // publication counter of the sender, full objects included
+  uint32_t nCells = 0;      // number of cells (bins with under- and overflows) of the histogram
+  uint32_t nBins = 0;       // number of bins stored in the payload
+  uint32_t hasSumw2 = 0;    // 1 if the sums of squares of weights are stored
+  double entries = 0;
+  double stats[nStats] = {0};
+
+  HistogramDeltaHeader();
+  HistogramDeltaHeader(const HistogramDeltaHeader&) = default;
+  HistogramDeltaHeader& operator=(const HistogramDeltaHeader&) = default;
+};
+
+namespace histogram_delta
+{
+
+/// \brief Returns true if the object is a histogram which can be published as a delta.
+bool isSupported(const TObject* object);
+
+/// \brief Stores the non-empty bins of the histogram in the payload.
+/// Returns false if the delta would not be smaller than a half of the histogram bins, then nothing is stored.
+bool encode(const TH1& histogram, HistogramDeltaHeader& header, std::vector<char>& payload);
+
+/// \brief Adds the delta to the histogram. Throws if the delta does not correspond to its binning.
+void apply(TH1& histogram, const HistogramDeltaHeader& header, gsl::span<const char> payload);
+
+} // namespace histogram_delta
+
+} // namespace o2::mergers
+
+#endif //ALICEO2_HISTOGRAMDELTA_H
@@ -53,18 +53,24 @@ class IntegratingMerger : public framework::Task
 
  private:
   void publish(framework::DataAllocator& allocator);
+  bool publishDelta(framework::DataAllocator& allocator);
+  void applyDelta(const framework::DataRef& ref);
   void clear();
 
  private:
   header::DataHeader::SubSpecificationType mSubSpec;
   ObjectStore mMergedObject = std::monostate{};
+  TObjectPtr mEmptyHistogram; // the last merged histogram, reset, which the deltas are added to when nothing was received
   MergerConfig mConfig;
   std::unique_ptr<monitoring::Monitoring> mCollector;
   int mCyclesSinceReset = 0;
+  uint32_t mPublications = 0;
 
   // stats
   int mTotalDeltasMerged = 0;
   int mDeltasMerged = 0;
+  int mSparseDeltasPublished = 0;
+  int mSparseDeltasDropped = 0;
 };
 
 } // namespace o2::mergers
@@ -24,8 +24,10 @@ class TObject;
 namespace o2::mergers::algorithm
 {
 
-/// \brief A function which merges TObjects
-void merge(TObject* const target, TObject* const other);
+/// \brief A function which merges TObjects.
+/// Histograms of the same type and binning are merged by adding their bins directly. The elements of collections
+/// which can be merged this way are merged in parallel by nThreads threads if OpenMP is enabled.
+void merge(TObject* const target, TObject* const other, int nThreads = 1);
 void deleteTCollections(TObject* obj);
 
 } // namespace o2::mergers::algorithm
@@ -46,6 +46,13 @@ enum class PublicationDecision {
   EachNSeconds,       // Merged object is published each N seconds.
 };
 
+enum class PublishedUpdates {
+  FullObjects, // Merged objects are published as a whole.
+  // Histograms are published as sparse deltas, when it saves space, and as a whole object each N cycles (0 - only
+  // the first time). It applies only to Mergers which reset the merged object after each publication.
+  SparseDeltas
+};
+
 enum class TopologySize {
   NumberOfLayers, // User specifies the number of layers in topology.
   ReductionFactor // User specifies how many sources should be handled by one merger (by maximum).
@@ -63,7 +70,9 @@ struct MergerConfig {
   ConfigEntry<MergedObjectTimespan, int> mergedObjectTimespan = {MergedObjectTimespan::FullHistory};
   ConfigEntry<PublicationDecision> publicationDecision = {PublicationDecision::EachNSeconds, 10};
   ConfigEntry<TopologySize, int> topologySize = {TopologySize::NumberOfLayers, 1};
+  ConfigEntry<PublishedUpdates, int> publishedUpdates = {PublishedUpdates::FullObjects};
   std::string monitoringUrl = "infologger:///debug?qc";
+  int mergingThreads = 1; // number of threads which merge the elements of collections
 };
 
 } // namespace o2::mergers
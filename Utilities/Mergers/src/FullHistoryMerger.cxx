@@ -136,7 +136,7 @@ void FullHistoryMerger::mergeCache()
     for (auto& [name, entry] : mCache) {
       (void)name;
       auto other = std::get<TObjectPtr>(entry);
-      algorithm::merge(target.get(), other.get());
+      algorithm::merge(target.get(), other.get(), mConfig.mergingThreads);
       mObjectsMerged++;
     }
 
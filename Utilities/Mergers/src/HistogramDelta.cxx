@@ -0,0 +1,169 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HistogramDelta.cxx
+/// \brief Implementation of sparse differences of histograms
+
+#include "Mergers/HistogramDelta.h"
+
+#include <TH1.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace o2::mergers
+{
+
+static_assert(HistogramDeltaHeader::nStats == TH1::kNstat, "The statistics of histograms do not fit in HistogramDeltaHeader");
+static_assert(sizeof(HistogramDeltaHeader) % 16 == 0, "HistogramDeltaHeader size is not a multiple of 16 bytes");
+
+HistogramDeltaHeader::HistogramDeltaHeader() : BaseHeader(sizeof(HistogramDeltaHeader), sHeaderType, sSerializationMethod, sVersion)
+{
+}
+
+// storage for HistogramDeltaHeader static members
+const uint32_t o2::mergers::HistogramDeltaHeader::sVersion = 1;
+const o2::header::HeaderType o2::mergers::HistogramDeltaHeader::sHeaderType = header::String2<uint64_t>("HistDlta");
+const o2::header::SerializationMethod o2::mergers::HistogramDeltaHeader::sSerializationMethod = o2::header::gSerializationMethodNone;
+
+namespace histogram_delta
+{
+
+namespace
+{
+
+// the bin indices are padded, so that the values which follow are aligned
+size_t indicesSize(size_t nBins)
+{
+  return (nBins * sizeof(uint32_t) + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+}
+
+size_t payloadSize(size_t nBins, bool hasSumw2)
+{
+  return indicesSize(nBins) + nBins * sizeof(double) * (hasSumw2 ? 2 : 1);
+}
+
+} // namespace
+
+bool isSupported(const TObject* object)
+{
+  auto* histogram = dynamic_cast<const TH1*>(object);
+  if (histogram == nullptr || histogram->InheritsFrom(TProfile::Class()) || histogram->InheritsFrom(TProfile2D::Class()) ||
+      histogram->InheritsFrom(TProfile3D::Class())) {
+    return false;
+  }
+  // extendable and labelled axes might end up with a different binning in the receiver
+  if (histogram->GetBuffer() != nullptr || histogram->CanExtendAllAxes() || histogram->TestBit(TH1::kIsAverage)) {
+    return false;
+  }
+  const TAxis* axes[] = {histogram->GetXaxis(), histogram->GetYaxis(), histogram->GetZaxis()};
+  for (int i = 0; i < histogram->GetDimension(); i++) {
+    if (axes[i]->GetLabels() != nullptr || axes[i]->CanExtend()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool encode(const TH1& histogram, HistogramDeltaHeader& header, std::vector<char>& payload)
+{
+  const int nCells = histogram.GetNcells();
+  const TArrayD* sumw2 = histogram.GetSumw2N() > 0 ? histogram.GetSumw2() : nullptr;
+
+  std::vector<uint32_t> bins;
+  for (int bin = 0; bin < nCells; bin++) {
+    if (histogram.GetBinContent(bin) != 0 || (sumw2 && sumw2->At(bin) != 0)) {
+      bins.push_back(bin);
+    }
+  }
+
+  size_t size = payloadSize(bins.size(), sumw2 != nullptr);
+  if (2 * size >= nCells * sizeof(double)) {
+    return false;
+  }
+
+  header.nCells = nCells;
+  header.nBins = bins.size();
+  header.hasSumw2 = sumw2 != nullptr;
+  header.entries = histogram.GetEntries();
+  histogram.GetStats(header.stats);
+
+  payload.assign(size, 0);
+  std::memcpy(payload.data(), bins.data(), bins.size() * sizeof(uint32_t));
+  auto* contents = reinterpret_cast<double*>(payload.data() + indicesSize(bins.size()));
+  for (size_t i = 0; i < bins.size(); i++) {
+    contents[i] = histogram.GetBinContent(bins[i]);
+  }
+  if (sumw2) {
+    auto* sumsOfSquares = contents + bins.size();
+    for (size_t i = 0; i < bins.size(); i++) {
+      sumsOfSquares[i] = sumw2->At(bins[i]);
+    }
+  }
+  return true;
+}
+
+void apply(TH1& histogram, const HistogramDeltaHeader& header, gsl::span<const char> payload)
+{
+  if (header.nCells != static_cast<uint32_t>(histogram.GetNcells())) {
+    throw std::runtime_error("The histogram delta has " + std::to_string(header.nCells) + " cells, while the histogram '" +
+                             histogram.GetName() + "' has " + std::to_string(histogram.GetNcells()) + ".");
+  }
+  if (payload.size() != payloadSize(header.nBins, header.hasSumw2)) {
+    throw std::runtime_error("The size of the histogram delta payload does not match its header.");
+  }
+
+  std::vector<uint32_t> bins(header.nBins);
+  std::memcpy(bins.data(), payload.data(), header.nBins * sizeof(uint32_t));
+  std::vector<double> contents(header.nBins);
+  std::memcpy(contents.data(), payload.data() + indicesSize(header.nBins), header.nBins * sizeof(double));
+  std::vector<double> sumsOfSquares;
+  if (header.hasSumw2) {
+    sumsOfSquares.resize(header.nBins);
+    std::memcpy(sumsOfSquares.data(), payload.data() + indicesSize(header.nBins) + header.nBins * sizeof(double), header.nBins * sizeof(double));
+  }
+  for (auto bin : bins) {
+    if (bin >= header.nCells) {
+      throw std::runtime_error("The histogram delta contains a bin out of range.");
+    }
+  }
+
+  // the statistics are taken before the bins change, since they might be computed from them
+  Double_t stats[TH1::kNstat] = {0};
+  histogram.GetStats(stats);
+  for (int i = 0; i < TH1::kNstat; i++) {
+    stats[i] += header.stats[i];
+  }
+  Double_t entries = histogram.GetEntries() + header.entries;
+
+  // as in TH1::Add, the sums of squares of weights are kept if any of the two has them
+  if (header.hasSumw2 && histogram.GetSumw2N() == 0) {
+    histogram.Sumw2();
+  }
+  TArrayD* sumw2 = histogram.GetSumw2N() > 0 ? histogram.GetSumw2() : nullptr;
+  for (size_t i = 0; i < bins.size(); i++) {
+    histogram.AddBinContent(bins[i], contents[i]);
+    if (sumw2) {
+      sumw2->fArray[bins[i]] += header.hasSumw2 ? sumsOfSquares[i] : contents[i];
+    }
+  }
+
+  histogram.PutStats(stats);
+  histogram.SetEntries(entries);
+}
+
+} // namespace histogram_delta
+
+} // namespace o2::mergers
@@ -16,6 +16,7 @@
 
 #include "Mergers/IntegratingMerger.h"
 
+#include "Mergers/HistogramDelta.h"
 #include "Mergers/MergerAlgorithm.h"
 #include "Mergers/MergerBuilder.h"
 
@@ -24,6 +25,8 @@
 #include "Framework/InputRecordWalker.h"
 #include "Framework/Logger.h"
 
+#include <TH1.h>
+
 using namespace o2::framework;
 
 namespace o2::mergers
@@ -49,14 +52,16 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
 
   for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
     if (ref.header != timerHeader) {
-      if (std::holds_alternative<std::monostate>(mMergedObject)) {
+      if (header::get<HistogramDeltaHeader*>(ref.header) != nullptr) {
+        applyDelta(ref);
+      } else if (std::holds_alternative<std::monostate>(mMergedObject)) {
         mMergedObject = object_store_helpers::extractObjectFrom(ref);
 
       } else if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
         // We expect that if the first object was TObject, then all should.
         auto other = TObjectPtr(framework::DataRefUtils::as<TObject>(ref).release(), algorithm::deleteTCollections);
         auto target = std::get<TObjectPtr>(mMergedObject);
-        algorithm::merge(target.get(), other.get());
+        algorithm::merge(target.get(), other.get(), mConfig.mergingThreads);
 
       } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
         // We expect that if the first object inherited MergeInterface, then all should.
@@ -83,6 +88,11 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
 // I am not calling it reset(), because it does not have to be performed during the FairMQs reset.
 void IntegratingMerger::clear()
 {
+  // The emptied histogram is kept, so that deltas can be added to it even if they arrive before any whole object.
+  if (std::holds_alternative<TObjectPtr>(mMergedObject) && histogram_delta::isSupported(std::get<TObjectPtr>(mMergedObject).get())) {
+    mEmptyHistogram = std::get<TObjectPtr>(mMergedObject);
+    static_cast<TH1*>(mEmptyHistogram.get())->Reset();
+  }
   mMergedObject = std::monostate{};
   mCyclesSinceReset = 0;
   mTotalDeltasMerged = 0;
@@ -101,18 +111,75 @@ void IntegratingMerger::publish(framework::DataAllocator& allocator)
     LOG(INFO) << "Published the merged object with " << mTotalDeltasMerged << " deltas in total,"
               << " including " << mDeltasMerged << " in the last cycle.";
   } else if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
-    allocator.snapshot(framework::OutputRef{MergerBuilder::mergerOutputBinding(), mSubSpec},
-                       *std::get<TObjectPtr>(mMergedObject));
-    LOG(INFO) << "Published the merged object with " << mTotalDeltasMerged << " deltas in total,"
-              << " including " << mDeltasMerged << " in the last cycle.";
+    if (publishDelta(allocator)) {
+      LOG(INFO) << "Published the delta of the merged object with " << mTotalDeltasMerged << " deltas in total,"
+                << " including " << mDeltasMerged << " in the last cycle.";
+    } else {
+      allocator.snapshot(framework::OutputRef{MergerBuilder::mergerOutputBinding(), mSubSpec},
+                         *std::get<TObjectPtr>(mMergedObject));
+      LOG(INFO) << "Published the merged object with " << mTotalDeltasMerged << " deltas in total,"
+                << " including " << mDeltasMerged << " in the last cycle.";
+    }
   } else {
     throw std::runtime_error("mMergedObject' variant has no value.");
   }
+  if (!std::holds_alternative<std::monostate>(mMergedObject)) {
+    mPublications++;
+  }
 
   mCollector->send({mTotalDeltasMerged, "total_deltas_merged"}, monitoring::DerivedMetricMode::RATE);
   mCollector->send({mDeltasMerged, "deltas_merged_since_last_publication"});
   mCollector->send({mCyclesSinceReset, "cycles_since_reset"});
+  if (mConfig.publishedUpdates.value == PublishedUpdates::SparseDeltas) {
+    mCollector->send({mSparseDeltasPublished, "sparse_deltas_published"});
+  }
+  mCollector->send({mSparseDeltasDropped, "sparse_deltas_dropped"});
   mDeltasMerged = 0;
 }
 
+bool IntegratingMerger::publishDelta(framework::DataAllocator& allocator)
+{
+  // A delta contains what has been merged since the last publication only if the object is reset after each one.
+  bool resetEachCycle = mConfig.mergedObjectTimespan.value == MergedObjectTimespan::LastDifference ||
+                        (mConfig.mergedObjectTimespan.value == MergedObjectTimespan::NCycles && mConfig.mergedObjectTimespan.param == 1);
+  int fullObjectCycles = mConfig.publishedUpdates.param;
+  bool fullObjectDue = mPublications == 0 || (fullObjectCycles > 0 && mPublications % fullObjectCycles == 0);
+  if (mConfig.publishedUpdates.value != PublishedUpdates::SparseDeltas || !resetEachCycle || fullObjectDue ||
+      !std::holds_alternative<TObjectPtr>(mMergedObject)) {
+    return false;
+  }
+  auto object = std::get<TObjectPtr>(mMergedObject);
+  if (!histogram_delta::isSupported(object.get())) {
+    return false;
+  }
+
+  HistogramDeltaHeader deltaHeader;
+  std::vector<char> payload;
+  if (!histogram_delta::encode(*static_cast<TH1*>(object.get()), deltaHeader, payload)) {
+    return false;
+  }
+  deltaHeader.publication = mPublications;
+  allocator.snapshot(framework::OutputRef{MergerBuilder::mergerOutputBinding(), mSubSpec, header::Stack{deltaHeader}},
+                     payload.data(), payload.size());
+  mSparseDeltasPublished++;
+  return true;
+}
+
+void IntegratingMerger::applyDelta(const framework::DataRef& ref)
+{
+  const auto* deltaHeader = header::get<HistogramDeltaHeader*>(ref.header);
+  const auto* dataHeader = header::get<header::DataHeader*>(ref.header);
+  if (std::holds_alternative<std::monostate>(mMergedObject) && mEmptyHistogram) {
+    mMergedObject = mEmptyHistogram;
+  }
+  TH1* target = std::holds_alternative<TObjectPtr>(mMergedObject) ? dynamic_cast<TH1*>(std::get<TObjectPtr>(mMergedObject).get()) : nullptr;
+  if (target == nullptr) {
+    // the binning is not known until a whole object is received
+    LOG(WARN) << "Dropping a histogram delta (publication " << deltaHeader->publication << "), because there is no histogram to add it to";
+    mSparseDeltasDropped++;
+    return;
+  }
+  histogram_delta::apply(*target, *deltaHeader, gsl::span<const char>(ref.payload, dataHeader->payloadSize));
+}
+
 } // namespace o2::mergers
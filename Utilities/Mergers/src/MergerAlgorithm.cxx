@@ -27,10 +27,96 @@
 #include <TObjArray.h>
 #include <TGraph.h>
 
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace o2::mergers::algorithm
 {
 
-void merge(TObject* const target, TObject* const other)
+namespace
+{
+
+bool haveSameBinning(const TAxis* target, const TAxis* other)
+{
+  if (target->GetNbins() != other->GetNbins() || target->GetXmin() != other->GetXmin() || target->GetXmax() != other->GetXmax()) {
+    return false;
+  }
+  // the bins of labelled axes might be ordered differently
+  if (target->GetLabels() != nullptr || other->GetLabels() != nullptr) {
+    return false;
+  }
+  const TArrayD* targetEdges = target->GetXbins();
+  const TArrayD* otherEdges = other->GetXbins();
+  return targetEdges->GetSize() == otherEdges->GetSize() &&
+         std::equal(targetEdges->GetArray(), targetEdges->GetArray() + targetEdges->GetSize(), otherEdges->GetArray());
+}
+
+/// Returns true if the objects are floating point histograms of the same type with the same binning,
+/// so that they can be merged by adding their bins.
+bool canMergeBinwise(TObject* const target, TObject* const other)
+{
+  const TClass* cl = target->IsA();
+  if (cl != other->IsA() || (cl != TH1F::Class() && cl != TH1D::Class() && cl != TH2F::Class() && cl != TH2D::Class() && cl != TH3F::Class() && cl != TH3D::Class())) {
+    return false;
+  }
+  auto* targetHisto = static_cast<TH1*>(target);
+  auto* otherHisto = static_cast<TH1*>(other);
+  if (targetHisto->GetBuffer() != nullptr || otherHisto->GetBuffer() != nullptr ||
+      targetHisto->TestBit(TH1::kIsAverage) || otherHisto->TestBit(TH1::kIsAverage) ||
+      (targetHisto->GetSumw2N() == 0) != (otherHisto->GetSumw2N() == 0)) {
+    return false;
+  }
+  int dimension = targetHisto->GetDimension();
+  return haveSameBinning(targetHisto->GetXaxis(), otherHisto->GetXaxis()) &&
+         (dimension < 2 || haveSameBinning(targetHisto->GetYaxis(), otherHisto->GetYaxis())) &&
+         (dimension < 3 || haveSameBinning(targetHisto->GetZaxis(), otherHisto->GetZaxis()));
+}
+
+template <typename T>
+void addArrays(T* __restrict target, const T* __restrict other, int size)
+{
+  for (int i = 0; i < size; i++) {
+    target[i] += other[i];
+  }
+}
+
+/// Merges histograms accepted by canMergeBinwise(). The result is the one of TH1::Merge, without its compatibility
+/// checks and the temporary objects it needs in general.
+void mergeBinwise(TObject* const target, TObject* const other)
+{
+  auto* targetHisto = static_cast<TH1*>(target);
+  auto* otherHisto = static_cast<TH1*>(other);
+
+  // the statistics are taken before the bins change, since they might be computed from them
+  Double_t targetStats[TH1::kNstat] = {0};
+  Double_t otherStats[TH1::kNstat] = {0};
+  targetHisto->GetStats(targetStats);
+  otherHisto->GetStats(otherStats);
+  for (int i = 0; i < TH1::kNstat; i++) {
+    targetStats[i] += otherStats[i];
+  }
+  Double_t entries = targetHisto->GetEntries() + otherHisto->GetEntries();
+
+  int nCells = targetHisto->GetNcells();
+  if (auto targetArray = dynamic_cast<TArrayD*>(target)) {
+    addArrays(targetArray->GetArray(), dynamic_cast<TArrayD*>(other)->GetArray(), nCells);
+  } else {
+    addArrays(dynamic_cast<TArrayF*>(target)->GetArray(), dynamic_cast<TArrayF*>(other)->GetArray(), nCells);
+  }
+  if (targetHisto->GetSumw2N() > 0) {
+    addArrays(targetHisto->GetSumw2()->GetArray(), otherHisto->GetSumw2()->GetArray(), nCells);
+  }
+
+  targetHisto->PutStats(targetStats);
+  targetHisto->SetEntries(entries);
+}
+
+} // namespace
+
+void merge(TObject* const target, TObject* const other, int nThreads)
 {
   if (target == nullptr) {
     throw std::runtime_error("Merging target is nullptr");
@@ -57,18 +143,49 @@ void merge(TObject* const target, TObject* const other)
                                "' is a TCollection, while the other object '" + other->GetName() + "' is not.");
     }
 
+    // The target objects are looked up by name. The first one with a given name is used, as in FindObject(),
+    // but we index them to avoid scanning long collections for each object.
+    std::unordered_map<std::string_view, TObject*> targetObjects;
+    auto targetIterator = targetCollection->MakeIterator();
+    while (auto targetObject = targetIterator->Next()) {
+      targetObjects.emplace(targetObject->GetName(), targetObject);
+    }
+    delete targetIterator;
+
+    // Pairs of histograms which are merged by adding their bins are independent, so we merge them at the end,
+    // possibly in parallel. There should be one pair per target, it is not the case only for corrupted collections.
+    std::vector<std::pair<TObject*, TObject*>> binwisePairs;
+    std::unordered_set<TObject*> binwiseTargets;
+
     auto otherIterator = otherCollection->MakeIterator();
     while (auto otherObject = otherIterator->Next()) {
-      TObject* targetObject = targetCollection->FindObject(otherObject->GetName());
-      if (targetObject) {
-        // That might be another collection or a concrete object to be merged, we walk on the collection recursively.
-        merge(targetObject, otherObject);
+      auto found = targetObjects.find(otherObject->GetName());
+      if (found != targetObjects.end()) {
+        TObject* targetObject = found->second;
+        if (canMergeBinwise(targetObject, otherObject) && binwiseTargets.insert(targetObject).second) {
+          binwisePairs.emplace_back(targetObject, otherObject);
+        } else {
+          // That might be another collection or a concrete object to be merged, we walk on the collection recursively.
+          merge(targetObject, otherObject, nThreads);
+        }
       } else {
         // We prefer to clone instead of passing the pointer in order to simplify deleting the `other`.
-        targetCollection->Add(otherObject->Clone());
+        TObject* clone = otherObject->Clone();
+        targetCollection->Add(clone);
+        targetObjects.emplace(clone->GetName(), clone);
       }
     }
     delete otherIterator;
+
+    int nPairs = binwisePairs.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads) if (nThreads > 1 && nPairs > 1)
+#endif
+    for (int i = 0; i < nPairs; i++) {
+      mergeBinwise(binwisePairs[i].first, binwisePairs[i].second);
+    }
+  } else if (canMergeBinwise(target, other)) {
+    mergeBinwise(target, other);
   } else {
     Long64_t errorCode = 0;
     TObjArray otherCollection;
@@ -74,6 +74,10 @@ std::string MergerInfrastructureBuilder::validateConfig()
     error += preamble + "MergedObjectTimespan::LastDifference does not apply to InputObjectsTimespan::FullHistory\n";
   }
 
+  if (mConfig.inputObjectTimespan.value == InputObjectsTimespan::FullHistory && mConfig.publishedUpdates.value == PublishedUpdates::SparseDeltas) {
+    error += preamble + "PublishedUpdates::SparseDeltas does not apply to InputObjectsTimespan::FullHistory\n";
+  }
+
   for (const auto& input : mInputs) {
     if (DataSpecUtils::match(input, mOutputSpec)) {
       error += preamble + "output '" + DataSpecUtils::label(mOutputSpec) + "' matches input '" + DataSpecUtils::label(input) + "'. That will cause a circular dependency!";
@@ -108,6 +112,9 @@ framework::WorkflowSpec MergerInfrastructureBuilder::generateInfrastructure()
     if (layer < mergersPerLayer.size() - 1) {
       // in intermediate layers we should reset the results, so the same data is not added many times.
       layerConfig.mergedObjectTimespan = {MergedObjectTimespan::NCycles, 1};
+    } else {
+      // the last layer publishes to the outside world, which expects whole objects.
+      layerConfig.publishedUpdates = {PublishedUpdates::FullObjects};
     }
     mergerBuilder.setConfig(layerConfig);
 
@@ -21,6 +21,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "Mergers/MergerAlgorithm.h"
+#include "Mergers/HistogramDelta.h"
 #include "Mergers/CustomMergeableTObject.h"
 #include "Mergers/CustomMergeableObject.h"
 
@@ -36,6 +37,10 @@
 #include <TGraph.h>
 #include <TProfile.h>
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 //using namespace o2::framework;
 using namespace o2::mergers;
 
@@ -300,6 +305,120 @@ BOOST_AUTO_TEST_CASE(MergerCollection)
   delete target;
 }
 
+BOOST_AUTO_TEST_CASE(MergerBinwise)
+{
+  // histograms of the same type and binning are merged by adding their bins, the result should be the one of TH1::Merge
+  auto fill = [](TH1* h, int n, double shift) {
+    for (int i = 0; i < n; i++) {
+      h->Fill(std::fmod(i * 0.37 + shift, 12.) - 1., 0.5 + (i % 3));
+    }
+  };
+  std::vector<TH1*> targets{new TH1F("target1", "target1", bins, min, max), new TH1D("target2", "target2", bins, min, max)};
+  std::vector<TH1*> others{new TH1F("other1", "other1", bins, min, max), new TH1D("other2", "other2", bins, min, max)};
+  targets[1]->Sumw2();
+  others[1]->Sumw2();
+  for (size_t i = 0; i < targets.size(); i++) {
+    fill(targets[i], 100, 0.);
+    fill(others[i], 50, 3.);
+    auto* expected = dynamic_cast<TH1*>(targets[i]->Clone("expected"));
+    TList list;
+    list.Add(others[i]);
+    expected->Merge(&list);
+
+    BOOST_CHECK_NO_THROW(algorithm::merge(targets[i], others[i]));
+    for (int bin = 0; bin <= int(bins) + 1; bin++) {
+      BOOST_CHECK_CLOSE(targets[i]->GetBinContent(bin), expected->GetBinContent(bin), 1e-4);
+      BOOST_CHECK_CLOSE(targets[i]->GetBinError(bin), expected->GetBinError(bin), 1e-4);
+    }
+    BOOST_CHECK_CLOSE(targets[i]->GetEntries(), expected->GetEntries(), 1e-6);
+    BOOST_CHECK_CLOSE(targets[i]->GetMean(), expected->GetMean(), 1e-4);
+    BOOST_CHECK_CLOSE(targets[i]->GetStdDev(), expected->GetStdDev(), 1e-4);
+    delete expected;
+    delete targets[i];
+    delete others[i];
+  }
+
+  // many histograms in a collection, some of them of a different type
+  const int nHistos = 200;
+  TObjArray* target = new TObjArray();
+  target->SetOwner(true);
+  TObjArray* other = new TObjArray();
+  other->SetOwner(true);
+  for (int i = 0; i < nHistos; i++) {
+    auto name = "histo" + std::to_string(i);
+    auto* targetHisto = new TH2F(name.c_str(), name.c_str(), bins, min, max, bins, min, max);
+    targetHisto->Fill(1, 1);
+    target->Add(targetHisto);
+    TH2* otherHisto = i % 10 ? (TH2*)new TH2F(name.c_str(), name.c_str(), bins, min, max, bins, min, max)
+                             : (TH2*)new TH2D(name.c_str(), name.c_str(), bins, min, max, bins, min, max);
+    otherHisto->Fill(1, 1, i);
+    other->Add(otherHisto);
+  }
+  BOOST_CHECK_NO_THROW(algorithm::merge(target, other, 4));
+  BOOST_REQUIRE_EQUAL(target->GetEntries(), nHistos);
+  for (int i = 0; i < nHistos; i++) {
+    auto* result = dynamic_cast<TH2F*>(target->At(i));
+    BOOST_REQUIRE(result != nullptr);
+    BOOST_CHECK_EQUAL(result->GetBinContent(result->FindBin(1, 1)), 1 + i);
+    BOOST_CHECK_EQUAL(result->GetEntries(), 2);
+  }
+  delete other;
+  delete target;
+}
+
+BOOST_AUTO_TEST_CASE(MergerHistogramDelta)
+{
+  TH2D* delta = new TH2D("delta", "delta", 100, 0, 100, 100, 0, 100);
+  delta->Sumw2();
+  delta->Fill(5, 5, 2.);
+  delta->Fill(5, 5);
+  delta->Fill(50, 70);
+  delta->Fill(-1, 200);
+
+  TH2D* target = dynamic_cast<TH2D*>(delta->Clone("target"));
+  target->Reset();
+  target->Fill(5, 5);
+  TH2D* expected = dynamic_cast<TH2D*>(target->Clone("expected"));
+  BOOST_REQUIRE_NO_THROW(algorithm::merge(expected, delta));
+
+  BOOST_REQUIRE(histogram_delta::isSupported(delta));
+  HistogramDeltaHeader header;
+  std::vector<char> payload;
+  BOOST_REQUIRE(histogram_delta::encode(*delta, header, payload));
+  BOOST_CHECK_EQUAL(header.nBins, 3);
+  BOOST_CHECK_EQUAL(header.nCells, delta->GetNcells());
+
+  BOOST_REQUIRE_NO_THROW(histogram_delta::apply(*target, header, gsl::span<const char>(payload.data(), payload.size())));
+  for (int bin = 0; bin < target->GetNcells(); bin++) {
+    BOOST_CHECK_EQUAL(target->GetBinContent(bin), expected->GetBinContent(bin));
+    BOOST_CHECK_CLOSE(target->GetBinError(bin), expected->GetBinError(bin), 1e-6);
+  }
+  BOOST_CHECK_EQUAL(target->GetEntries(), expected->GetEntries());
+  BOOST_CHECK_CLOSE(target->GetMean(1), expected->GetMean(1), 1e-6);
+  BOOST_CHECK_CLOSE(target->GetMean(2), expected->GetMean(2), 1e-6);
+
+  // a different binning
+  TH2D* other = new TH2D("other", "other", 10, 0, 100, 100, 0, 100);
+  BOOST_CHECK_THROW(histogram_delta::apply(*other, header, gsl::span<const char>(payload.data(), payload.size())), std::runtime_error);
+
+  // a delta would not be smaller than the histogram
+  TH1F* dense = new TH1F("dense", "dense", bins, min, max);
+  for (size_t i = 0; i < bins; i++) {
+    dense->Fill(i);
+  }
+  BOOST_CHECK(!histogram_delta::encode(*dense, header, payload));
+
+  TProfile* profile = new TProfile("profile", "profile", bins, min, max);
+  BOOST_CHECK(!histogram_delta::isSupported(profile));
+
+  delete profile;
+  delete dense;
+  delete other;
+  delete expected;
+  delete target;
+  delete delta;
+}
+
 BOOST_AUTO_TEST_CASE(Deleting)
 {
   TObjArray* main = new TObjArray();
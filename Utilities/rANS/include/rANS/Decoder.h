@@ -17,6 +17,7 @@
 #ifndef RANS_DECODER_H
 #define RANS_DECODER_H
 
+#include <array>
 #include <cstddef>
 #include <type_traits>
 #include <iostream>
@@ -45,7 +46,9 @@ class Decoder : public internal::DecoderBase<coder_T, stream_T, source_T>
  public:
   using internal::DecoderBase<coder_T, stream_T, source_T>::DecoderBase;
 
-  template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
+  /// decode messageLength symbols from the stream ending at inputEnd. nStreams_V has to match the
+  /// number of interleaved streams used by the encoder.
+  template <size_t nStreams_V = internal::DefaultNInterleavedStreams, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
   void process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength) const;
 
  private:
@@ -53,7 +56,7 @@ class Decoder : public internal::DecoderBase<coder_T, stream_T, source_T>
 };
 
 template <typename coder_T, typename stream_T, typename source_T>
-template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
+template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
 void Decoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength) const
 {
   using namespace internal;
@@ -72,26 +75,33 @@ void Decoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, source_IT
   // make Iter point to the last last element
   --inputIter;
 
-  ransDecoder_t rans0{this->mSymbolTablePrecission};
-  ransDecoder_t rans1{this->mSymbolTablePrecission};
-
-  inputIter = rans0.init(inputIter);
-  inputIter = rans1.init(inputIter);
+  static_assert(nStreams_V > 0);
+  auto decoders = makeCoders<ransDecoder_t, nStreams_V>(this->mSymbolTablePrecission);
+  for (auto& decoder : decoders) {
+    inputIter = decoder.init(inputIter);
+  }
 
-  for (size_t i = 0; i < (messageLength & ~1); i += 2) {
-    const int64_t s0 = this->mReverseLUT[rans0.get()];
-    const int64_t s1 = this->mReverseLUT[rans1.get()];
-    *it++ = s0;
-    *it++ = s1;
-    inputIter = rans0.advanceSymbol(inputIter, this->mSymbolTable[s0]);
-    inputIter = rans1.advanceSymbol(inputIter, this->mSymbolTable[s1]);
+  // Each round decodes one symbol per stream. The lookups of the different
+  // streams are independent and only the renormalization is sequential.
+  std::array<int64_t, nStreams_V> symbols{};
+  const size_t nFullRounds = messageLength / nStreams_V;
+  for (size_t i = 0; i < nFullRounds; ++i) {
+    for (size_t s = 0; s < nStreams_V; ++s) {
+      symbols[s] = this->mReverseLUT[decoders[s].get()];
+    }
+    for (size_t s = 0; s < nStreams_V; ++s) {
+      *it++ = symbols[s];
+    }
+    for (size_t s = 0; s < nStreams_V; ++s) {
+      inputIter = decoders[s].advanceSymbol(inputIter, this->mSymbolTable[symbols[s]]);
+    }
   }
 
-  // last byte, if message length was odd
-  if (messageLength & 1) {
-    const int64_t s0 = this->mReverseLUT[rans0.get()];
-    *it = s0;
-    inputIter = rans0.advanceSymbol(inputIter, this->mSymbolTable[s0]);
+  // trailing symbols, if the message length is not a multiple of the number of streams
+  for (size_t s = 0; s < messageLength % nStreams_V; ++s) {
+    const int64_t symbol = this->mReverseLUT[decoders[s].get()];
+    *it++ = symbol;
+    inputIter = decoders[s].advanceSymbol(inputIter, this->mSymbolTable[symbol]);
   }
   t.stop();
   LOG(debug1) << "Decoder::" << __func__ << " { DecodedSymbols: " << messageLength << ","
@@ -106,6 +106,12 @@ class FrequencyTable
   size_t mNumSamples{};
 };
 
+/// Compact table for wide, sparse alphabets: if the range of the frequency table exceeds maxRangeBits, the table is
+/// restricted to the narrowest range of symbols holding at least the fraction minCoverage of the samples.
+/// The symbols outside of it are escaped by the coders built from the table and stored as literals, while the
+/// symbol tables of the coders are sized by the compacted range. Otherwise a copy of the table is returned.
+FrequencyTable compactFrequencyTable(const FrequencyTable& frequencyTable, double minCoverage, size_t maxRangeBits);
+
 template <typename Source_IT, std::enable_if_t<internal::isIntegralIter_v<Source_IT>, bool>>
 void FrequencyTable::addSamples(Source_IT begin, Source_IT end)
 {
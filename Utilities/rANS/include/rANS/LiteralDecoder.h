@@ -44,7 +44,9 @@ class LiteralDecoder : public internal::DecoderBase<coder_T, stream_T, source_T>
  public:
   using internal::DecoderBase<coder_T, stream_T, source_T>::DecoderBase;
 
-  template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
+  /// decode messageLength symbols from the stream ending at inputEnd. nStreams_V has to match the
+  /// number of interleaved streams used by the encoder.
+  template <size_t nStreams_V = internal::DefaultNInterleavedStreams, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
   void process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, std::vector<source_T>& literals) const;
 
  private:
@@ -52,7 +54,7 @@ class LiteralDecoder : public internal::DecoderBase<coder_T, stream_T, source_T>
 };
 
 template <typename coder_T, typename stream_T, typename source_T>
-template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
+template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
 void LiteralDecoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, std::vector<source_T>& literals) const
 {
   using namespace internal;
@@ -83,19 +85,22 @@ void LiteralDecoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, so
   // make Iter point to the last last element
   --inputIter;
 
-  ransDecoder_t rans0{this->mSymbolTablePrecission};
-  ransDecoder_t rans1{this->mSymbolTablePrecission};
-  inputIter = rans0.init(inputIter);
-  inputIter = rans1.init(inputIter);
+  static_assert(nStreams_V > 0);
+  auto decoders = makeCoders<ransDecoder_t, nStreams_V>(this->mSymbolTablePrecission);
+  for (auto& decoder : decoders) {
+    inputIter = decoder.init(inputIter);
+  }
 
-  for (size_t i = 0; i < (messageLength & ~1); i += 2) {
-    std::tie(*it++, inputIter) = decode(rans0);
-    std::tie(*it++, inputIter) = decode(rans1);
+  const size_t nFullRounds = messageLength / nStreams_V;
+  for (size_t i = 0; i < nFullRounds; ++i) {
+    for (auto& decoder : decoders) {
+      std::tie(*it++, inputIter) = decode(decoder);
+    }
   }
 
-  // last byte, if message length was odd
-  if (messageLength & 1) {
-    std::tie(*it++, inputIter) = decode(rans0);
+  // trailing symbols, if the message length is not a multiple of the number of streams
+  for (size_t s = 0; s < messageLength % nStreams_V; ++s) {
+    std::tie(*it++, inputIter) = decode(decoders[s]);
   }
   t.stop();
   LOG(debug1) << "Decoder::" << __func__ << " { DecodedSymbols: " << messageLength << ","
@@ -42,7 +42,9 @@ class LiteralEncoder : public internal::EncoderBase<coder_T, stream_T, source_T>
   //inherit constructors;
   using internal::EncoderBase<coder_T, stream_T, source_T>::EncoderBase;
 
-  template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool> = true>
+  /// encode [inputBegin, inputEnd) to the stream starting at outputBegin. The symbol at position i
+  /// is coded by the state i % nStreams_V, so the decoder must use the same number of interleaved streams.
+  template <size_t nStreams_V = internal::DefaultNInterleavedStreams, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool> = true>
   stream_IT process(source_IT inputBegin, source_IT inputEnd, stream_IT outputBegin, std::vector<source_T>& literals) const;
 
  private:
@@ -50,7 +52,7 @@ class LiteralEncoder : public internal::EncoderBase<coder_T, stream_T, source_T>
 };
 
 template <typename coder_T, typename stream_T, typename source_T>
-template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool>>
+template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool>>
 stream_IT LiteralEncoder<coder_T, stream_T, source_T>::process(source_IT inputBegin, source_IT inputEnd, stream_IT outputBegin, std::vector<source_T>& literals) const
 {
   using namespace internal;
@@ -63,8 +65,8 @@ stream_IT LiteralEncoder<coder_T, stream_T, source_T>::process(source_IT inputBe
     return outputBegin;
   }
 
-  ransCoder_t rans0{this->mSymbolTablePrecission};
-  ransCoder_t rans1{this->mSymbolTablePrecission};
+  static_assert(nStreams_V > 0);
+  auto coders = makeCoders<ransCoder_t, nStreams_V>(this->mSymbolTablePrecission);
 
   stream_IT outputIter = outputBegin;
   source_IT inputIT = inputEnd;
@@ -80,17 +82,20 @@ stream_IT LiteralEncoder<coder_T, stream_T, source_T>::process(source_IT inputBe
     return coder.putSymbol(outputIter, encoderSymbol);
   };
 
-  // odd number of bytes?
-  if (inputBufferSize & 1) {
-    outputIter = encode(--inputIT, outputIter, rans0);
+  // trailing symbols which do not fill all the interleaved streams
+  for (size_t i = inputBufferSize; i % nStreams_V != 0;) {
+    --i;
+    outputIter = encode(--inputIT, outputIter, coders[i % nStreams_V]);
   }
 
   while (inputIT != inputBegin) { // NB: working in reverse!
-    outputIter = encode(--inputIT, outputIter, rans1);
-    outputIter = encode(--inputIT, outputIter, rans0);
+    for (size_t s = nStreams_V; s-- > 0;) {
+      outputIter = encode(--inputIT, outputIter, coders[s]);
+    }
+  }
+  for (size_t s = nStreams_V; s-- > 0;) {
+    outputIter = coders[s].flush(outputIter);
   }
-  outputIter = rans1.flush(outputIter);
-  outputIter = rans0.flush(outputIter);
   // first iterator past the range so that sizes, distances and iterators work correctly.
   ++outputIter;
 
@@ -17,11 +17,13 @@
 #ifndef RANS_INTERNAL_HELPER_H
 #define RANS_INTERNAL_HELPER_H
 
+#include <array>
 #include <cstddef>
 #include <cmath>
 #include <chrono>
 #include <type_traits>
 #include <iterator>
+#include <utility>
 
 namespace o2
 {
@@ -83,6 +85,22 @@ class RANSTimer
   std::chrono::time_point<std::chrono::high_resolution_clock> mStop;
 };
 
+// number of rANS states interleaved in a single stream by default
+inline constexpr size_t DefaultNInterleavedStreams = 2;
+
+template <typename coder_T, size_t... Is>
+inline std::array<coder_T, sizeof...(Is)> makeCoders(size_t symbolTablePrecission, std::index_sequence<Is...>)
+{
+  return {{((void)Is, coder_T{symbolTablePrecission})...}};
+}
+
+// create nStreams_V coders for the interleaved streams
+template <typename coder_T, size_t nStreams_V>
+inline std::array<coder_T, nStreams_V> makeCoders(size_t symbolTablePrecission)
+{
+  return makeCoders<coder_T>(symbolTablePrecission, std::make_index_sequence<nStreams_V>{});
+}
+
 template <typename T, typename IT>
 inline constexpr bool isCompatibleIter_v = std::is_convertible_v<typename std::iterator_traits<IT>::value_type, T>;
 template <typename IT>
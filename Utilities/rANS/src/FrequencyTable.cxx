@@ -61,6 +61,38 @@ void FrequencyTable::resizeFrequencyTable(symbol_t min, symbol_t max)
   LOG(trace) << "done resizing frequency table";
 }
 
+FrequencyTable compactFrequencyTable(const FrequencyTable& frequencyTable, double minCoverage, size_t maxRangeBits)
+{
+  if (frequencyTable.getNumSamples() == 0 || frequencyTable.getAlphabetRangeBits() <= maxRangeBits) {
+    return frequencyTable;
+  }
+  const FrequencyTable::count_t* freq = frequencyTable.data();
+  const size_t size = frequencyTable.size();
+  const size_t minSamples = std::max<size_t>(1, std::ceil(std::min(1., minCoverage) * frequencyTable.getNumSamples()));
+
+  // narrowest window [first, last] with at least minSamples, by moving its lower edge as long as it keeps enough samples
+  size_t first = 0, last = size - 1;
+  size_t lower = 0, inWindow = 0;
+  for (size_t upper = 0; upper < size; upper++) {
+    inWindow += freq[upper];
+    while (inWindow - freq[lower] >= minSamples) {
+      inWindow -= freq[lower++];
+    }
+    if (inWindow >= minSamples && upper - lower < last - first) {
+      first = lower;
+      last = upper;
+    }
+  }
+
+  FrequencyTable compacted;
+  const auto min = frequencyTable.getMinSymbol();
+  compacted.addFrequencies(freq + first, freq + last + 1, min + static_cast<FrequencyTable::symbol_t>(first), min + static_cast<FrequencyTable::symbol_t>(last));
+  LOG(debug) << "Compacted frequency table from [" << min << ", " << frequencyTable.getMaxSymbol() << "] to ["
+             << compacted.getMinSymbol() << ", " << compacted.getMaxSymbol() << "] with "
+             << compacted.getNumSamples() << " of " << frequencyTable.getNumSamples() << " samples";
+  return compacted;
+}
+
 std::ostream& operator<<(std::ostream& out, const FrequencyTable& fTable)
 {
   double entropy = 0;
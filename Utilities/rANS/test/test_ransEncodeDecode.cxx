@@ -148,6 +148,33 @@ struct EncodeDecodeLiteral : public EncodeDecodeBase<o2::rans::LiteralEncoder, o
   std::vector<typename Params<coder_T>::source_t> literals;
 };
 
+template <typename coder_T, class dictString_T, class testString_T, size_t nStreams_V>
+struct EncodeDecodeInterleaved : public EncodeDecodeBase<o2::rans::Encoder, o2::rans::Decoder, coder_T, dictString_T, testString_T> {
+  void encode() override
+  {
+    BOOST_CHECK_NO_THROW(this->encoder.template process<nStreams_V>(std::begin(this->source.data), std::end(this->source.data), std::back_inserter(this->encodeBuffer)));
+  };
+  void decode() override
+  {
+    BOOST_CHECK_NO_THROW(this->decoder.template process<nStreams_V>(this->encodeBuffer.end(), std::back_inserter(this->decodeBuffer), this->source.data.size()));
+  };
+};
+
+template <typename coder_T, class dictString_T, class testString_T, size_t nStreams_V>
+struct EncodeDecodeLiteralInterleaved : public EncodeDecodeBase<o2::rans::LiteralEncoder, o2::rans::LiteralDecoder, coder_T, dictString_T, testString_T> {
+  void encode() override
+  {
+    BOOST_CHECK_NO_THROW(this->encoder.template process<nStreams_V>(std::begin(this->source.data), std::end(this->source.data), std::back_inserter(this->encodeBuffer), literals));
+  };
+  void decode() override
+  {
+    BOOST_CHECK_NO_THROW(this->decoder.template process<nStreams_V>(this->encodeBuffer.end(), std::back_inserter(this->decodeBuffer), this->source.data.size(), literals));
+    BOOST_CHECK(literals.empty());
+  };
+
+  std::vector<typename Params<coder_T>::source_t> literals;
+};
+
 template <typename coder_T, class dictString_T, class testString_T>
 struct EncodeDecodeDedup : public EncodeDecodeBase<o2::rans::DedupEncoder, o2::rans::DedupDecoder, coder_T, dictString_T, testString_T> {
   void encode() override
@@ -178,7 +205,13 @@ using testCase_t = boost::mpl::vector<EncodeDecode<uint32_t, EmptyTestString, Em
                                       EncodeDecodeDedup<uint32_t, EmptyTestString, EmptyTestString>,
                                       EncodeDecodeDedup<uint64_t, EmptyTestString, EmptyTestString>,
                                       EncodeDecodeDedup<uint32_t, FullTestString, FullTestString>,
-                                      EncodeDecodeDedup<uint64_t, FullTestString, FullTestString>>;
+                                      EncodeDecodeDedup<uint64_t, FullTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint32_t, FullTestString, FullTestString, 8>,
+                                      EncodeDecodeInterleaved<uint64_t, FullTestString, FullTestString, 8>,
+                                      EncodeDecodeInterleaved<uint64_t, FullTestString, FullTestString, 7>,
+                                      EncodeDecodeLiteralInterleaved<uint64_t, FullTestString, FullTestString, 8>,
+                                      EncodeDecodeLiteralInterleaved<uint64_t, EmptyTestString, FullTestString, 8>,
+                                      EncodeDecodeLiteralInterleaved<uint32_t, EmptyTestString, FullTestString, 16>>;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_encodeDecode, testCase_T, testCase_t)
 {
@@ -128,3 +128,42 @@ BOOST_AUTO_TEST_CASE(test_addFrequencies)
 
   BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(fA), std::end(fA), std::begin(histAandB), std::end(histAandB));
 }
+
+BOOST_AUTO_TEST_CASE(test_compactFrequencyTable)
+{
+  // narrow peak of frequent symbols with rare outliers over a wide range
+  std::vector<int> A;
+  for (int i = 0; i < 1000; i++) {
+    A.push_back(i % 8);
+  }
+  A.push_back(-100000);
+  A.push_back(100000);
+
+  o2::rans::FrequencyTable fA;
+  fA.addSamples(std::begin(A), std::end(A));
+
+  // the range does not exceed the limit: unchanged
+  const auto fUnchanged = o2::rans::compactFrequencyTable(fA, 0.99, 20);
+  BOOST_CHECK_EQUAL(fUnchanged.getMinSymbol(), -100000);
+  BOOST_CHECK_EQUAL(fUnchanged.getMaxSymbol(), 100000);
+
+  const auto fCompact = o2::rans::compactFrequencyTable(fA, 0.99, 10);
+  BOOST_CHECK_EQUAL(fCompact.getMinSymbol(), 0);
+  BOOST_CHECK_EQUAL(fCompact.getMaxSymbol(), 7);
+  BOOST_CHECK_EQUAL(fCompact.getNumSamples(), 1000);
+  BOOST_CHECK_EQUAL(fCompact.getNUsedAlphabetSymbols(), 8);
+
+  // the full coverage keeps all the symbols
+  const auto fFull = o2::rans::compactFrequencyTable(fA, 1., 10);
+  BOOST_CHECK_EQUAL(fFull.size(), fA.size());
+
+  // the symbols outside of the compacted range are stored as literals
+  o2::rans::LiteralEncoder64<int> encoder{fCompact, 0};
+  o2::rans::LiteralDecoder64<int> decoder{fCompact, 0};
+  std::vector<uint32_t> encodeBuffer;
+  std::vector<int> literals, decoded;
+  encoder.process(std::begin(A), std::end(A), std::back_inserter(encodeBuffer), literals);
+  BOOST_CHECK_EQUAL(literals.size(), 2);
+  decoder.process(encodeBuffer.end(), std::back_inserter(decoded), A.size(), literals);
+  BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(decoded), std::end(decoded), std::begin(A), std::end(A));
+}
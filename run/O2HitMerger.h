@@ -27,7 +27,6 @@
 #include <DetectorsCommonDataFormats/NameConf.h>
 #include <gsl/gsl>
 #include "TFile.h"
-#include "TMemFile.h"
 #include "TTree.h"
 #include "TROOT.h"
 #include <memory>
@@ -63,6 +62,7 @@
 #include <vector>
 #include <csignal>
 #include <mutex>
+#include <future>
 #include <filesystem>
 
 #include "SimPublishChannelHelper.h"
@@ -220,8 +220,7 @@ class O2HitMerger : public FairMQDevice
 
     // clear "counter" datastructures
     mPartsCheckSum.clear();
-    mEventToTTreeMap.clear();
-    mEventToTMemFileMap.clear();
+    mEventParts.clear();
     mEntries = 0;
     mEventChecksum = 0;
     return true;
@@ -248,72 +247,63 @@ class O2HitMerger : public FairMQDevice
     return checksum == nparts * (nparts + 1) / 2;
   }
 
-  void consumeHits(int eventID, FairMQParts& data, int& index)
-  {
-    auto detIDmessage = std::move(data.At(index++));
-    // this should be a detector ID
-    if (detIDmessage->GetSize() == 4) {
-      auto ptr = (int*)detIDmessage->GetData();
-      o2::detectors::DetID id(ptr[0]);
-      LOG(DEBUG2) << "I1 " << ptr[0] << " NAME " << id.getName() << " MB "
-                  << data.At(index)->GetSize() / 1024. / 1024.;
-
-      TTree* tree = mEventToTTreeMap[eventID];
+  // in-memory collection of the data of one event, filled as the sub-events arrive
+  struct EventParts {
+    std::vector<o2::data::SubEventInfo> infos;                               // sub-event infos in arrival order
+    std::vector<std::unique_ptr<std::vector<o2::MCTrack>>> tracks;           // kinematics per sub-event
+    std::vector<std::unique_ptr<std::vector<o2::TrackReference>>> trackrefs; // track references per sub-event
+    std::vector<std::unique_ptr<o2::base::Detector::SubEventHits>> hits;     // hits per detector ID
+  };
 
-      // get the detector that can interpret it
-      auto detector = mDetectorInstances[id].get();
-      if (detector) {
-        detector->fillHitBranch(*tree, data, index);
-      }
+  // fetch (or create) the collection for this event
+  EventParts& getEventParts(int eventID)
+  {
+    const std::lock_guard<std::mutex> lock(mMapsMtx);
+    auto& event = mEventParts[eventID];
+    if (!event) {
+      event = std::make_unique<EventParts>();
+      event->hits.resize(mDetectorInstances.size());
     }
+    return *event;
   }
 
-  template <typename T>
-  void fillBranch(int eventID, std::string const& name, T* ptr)
+  // take the collection of this event out of the map (nullptr if nothing arrived for it)
+  std::unique_ptr<EventParts> releaseEventParts(int eventID)
   {
-    // fetch tree into which to fill
     const std::lock_guard<std::mutex> lock(mMapsMtx);
-    auto iter = mEventToTTreeMap.find(eventID);
-    if (iter == mEventToTTreeMap.end()) {
-      {
-        std::stringstream str;
-        str << "memfile" << eventID;
-        mEventToTMemFileMap[eventID] = new TMemFile(str.str().c_str(), "RECREATE");
-      }
-      {
-        std::stringstream str;
-        str << "o2sim" << eventID;
-        mEventToTTreeMap[eventID] = new TTree(str.str().c_str(), str.str().c_str());
-        mEventToTTreeMap[eventID]->SetDirectory(mEventToTMemFileMap[eventID]);
-      }
+    std::unique_ptr<EventParts> event;
+    auto iter = mEventParts.find(eventID);
+    if (iter != mEventParts.end()) {
+      event = std::move(iter->second);
+      mEventParts.erase(iter);
     }
-    TTree* tree = mEventToTTreeMap[eventID];
-
-    auto br = o2::base::getOrMakeBranch(*tree, name.c_str(), &ptr);
-    br->SetAddress(&ptr);
-    br->Fill();
-    br->ResetAddress();
+    return event;
   }
 
-  template <typename T>
-  void consumeData(int eventID, std::string name, FairMQParts& data, int& index)
+  void consumeHits(EventParts& event, int entry, FairMQParts& data, int& index)
   {
-    auto decodeddata = o2::base::decodeTMessage<T*>(data, index);
-    fillBranch(eventID, name, decodeddata);
-    delete decodeddata;
-    index++;
+    int detid = -1;
+    o2::base::HitEncoding encoding;
+    // this should be a detector ID header, telling how the hits are encoded
+    if (o2::base::decodeDetIDHeaderMessage(data, index++, detid, encoding)) {
+      o2::detectors::DetID id(detid);
+      LOG(DEBUG2) << "I1 " << detid << " NAME " << id.getName() << " ENCODING " << static_cast<int>(encoding) << " MB "
+                  << data.At(index)->GetSize() / 1024. / 1024.;
+
+      // get the detector that can interpret it
+      auto detector = mDetectorInstances[id].get();
+      if (detector) {
+        detector->collectHits(event.hits[id], entry, encoding, data, index);
+      }
+    }
   }
 
-  // fills a special branch of SubEventInfos in order to keep
-  // track of which entry corresponds to which event etc.
-  // also creates the MCEventHeader branch expected for physics analysis
-  void fillSubEventInfoEntry(o2::data::SubEventInfo& info)
+  template <typename T>
+  std::unique_ptr<T> consumeData(FairMQParts& data, int& index)
   {
-    auto infoptr = &info;
-    fillBranch(info.eventID, "SubEventInfo", infoptr);
-    // a separate branch for MCEventHeader to be backward compatible
-    auto headerptr = &info.mMCEventHeader;
-    fillBranch(info.eventID, "MCEventHeader.", headerptr);
+    std::unique_ptr<T> decodeddata(o2::base::decodeTMessage<T*>(data, index));
+    index++;
+    return decodeddata;
   }
 
   bool waitForControlInput()
@@ -368,24 +358,22 @@ class O2HitMerger : public FairMQDevice
   {
     bool expectmore = true;
     int index = 0;
-    auto infoptr = o2::base::decodeTMessage<o2::data::SubEventInfo*>(data, index++);
+    std::unique_ptr<o2::data::SubEventInfo> infoptr(o2::base::decodeTMessage<o2::data::SubEventInfo*>(data, index++));
     o2::data::SubEventInfo& info = *infoptr;
     auto accum = insertAdd<uint32_t, uint32_t>(mPartsCheckSum, info.eventID, (uint32_t)info.part);
 
     LOG(INFO) << "SIMDATA channel got " << data.Size() << " parts for event " << info.eventID << " part " << info.part << " out of " << info.nparts;
 
-    fillSubEventInfoEntry(info);
-    consumeData<std::vector<o2::MCTrack>>(info.eventID, "MCTrack", data, index);
-    consumeData<std::vector<o2::TrackReference>>(info.eventID, "TrackRefs", data, index);
+    // keep the sub-event in memory until the event is complete; the entry is the arrival index
+    // (this structure is only touched by the flushing thread once the event is complete)
+    auto& event = getEventParts(info.eventID);
+    const int entry = event.infos.size();
+    event.infos.push_back(info);
+    event.tracks.emplace_back(consumeData<std::vector<o2::MCTrack>>(data, index));
+    event.trackrefs.emplace_back(consumeData<std::vector<o2::TrackReference>>(data, index));
     while (index < data.Size()) {
-      consumeHits(info.eventID, data, index);
-    }
-    // set the number of entries in the tree
-    auto tree = mEventToTTreeMap[info.eventID];
-    auto memfile = mEventToTMemFileMap[info.eventID];
-    tree->SetEntries(tree->GetEntries() + 1);
-    LOG(INFO) << "tree has file " << tree->GetDirectory()->GetFile()->GetName();
-    // memfile->Write("", TObject::kOverwrite);
+      consumeHits(event, entry, data, index);
+    }
     mEntries++;
 
     if (isDataComplete<uint32_t>(accum, info.nparts)) {
@@ -425,67 +413,48 @@ class O2HitMerger : public FairMQDevice
     return expectmore;
   }
 
-  void cleanEvent(int eventID)
-  {
-    // remove tree for that eventID
-    const std::lock_guard<std::mutex> lock(mMapsMtx);
-    // mEventToTMemFileMap[eventID]->Close();
-    delete mEventToTTreeMap[eventID];
-    delete mEventToTMemFileMap[eventID];
-    mEventToTTreeMap.erase(eventID);
-    mEventToTMemFileMap.erase(eventID); // remove memfile
-  }
-
-  template <typename T>
-  void backInsert(T const& from, T& to)
-  {
-    std::copy(from.begin(), from.end(), std::back_inserter(to));
-  }
-
-  void reorderAndMergeMCTRacks(TTree& origin, TTree& target, const std::vector<int>& nprimaries, const std::vector<int>& nsubevents)
+  void reorderAndMergeMCTRacks(std::vector<std::unique_ptr<std::vector<MCTrack>>>& origin, TTree& target, const std::vector<int>& nprimaries, const std::vector<int>& nsubevents)
   {
-    std::vector<MCTrack>* incomingdata = nullptr;
     auto targetdata = std::make_unique<std::vector<MCTrack>>();
-    auto originbr = origin.GetBranch("MCTrack");
-    originbr->SetAddress(&incomingdata);
-    const auto entries = origin.GetEntries();
+    const auto entries = origin.size();
+    size_t ntracks = 0;
+    for (auto& incomingdata : origin) {
+      ntracks += incomingdata->size();
+    }
+    targetdata->reserve(ntracks);
     //
     // loop over subevents to store the primary events
     //
     Int_t nprimTot = 0;
-    for (auto entry = entries - 1; entry >= 0; --entry) {
+    for (long entry = entries - 1; entry >= 0; --entry) {
       int index = nsubevents[entry];
       nprimTot += nprimaries[index];
-      printf("merge %lld %5d %5d %5d \n", entry, index, nsubevents[entry], nsubevents[index]);
-      originbr->GetEntry(index);
-      for (Int_t i = 0; i < nprimaries[index]; i++) {
-        auto& track = incomingdata->at(i);
-        if (track.isTransported()) { // reset daughters only if track was transported, it will be fixed below
-          track.SetFirstDaughterTrackId(-1);
-          track.SetLastDaughterTrackId(-1);
+      printf("merge %ld %5d %5d %5d \n", entry, index, nsubevents[entry], nsubevents[index]);
+      auto& incomingdata = *origin[index];
+      auto first = targetdata->size();
+      targetdata->insert(targetdata->end(), incomingdata.begin(), incomingdata.begin() + nprimaries[index]);
+      for (auto track = targetdata->begin() + first; track != targetdata->end(); ++track) {
+        if (track->isTransported()) { // reset daughters only if track was transported, it will be fixed below
+          track->SetFirstDaughterTrackId(-1);
+          track->SetLastDaughterTrackId(-1);
         }
-        targetdata->push_back(track);
       }
-      incomingdata->clear();
-      delete incomingdata;
-      incomingdata = nullptr;
     }
     //
     // loop a second time to store the secondaries and fix the mother track IDs
     //
     Int_t idelta1 = nprimTot;
     Int_t idelta0 = 0;
-    for (auto entry = entries - 1; entry >= 0; --entry) {
+    for (long entry = entries - 1; entry >= 0; --entry) {
       int index = nsubevents[entry];
 
-      originbr->GetEntry(index);
-
-      Int_t npart = (int)(incomingdata->size());
+      auto& incomingdata = *origin[index];
+      Int_t npart = (int)(incomingdata.size());
       Int_t nprim = nprimaries[index];
       idelta1 -= nprim;
 
       for (Int_t i = nprim; i < npart; i++) {
-        auto& track = (*incomingdata)[i];
+        auto& track = incomingdata[i];
         Int_t cId = track.getMotherTrackId();
         if (cId >= nprim) {
           cId += idelta1;
@@ -506,9 +475,7 @@ class O2HitMerger : public FairMQDevice
       }
       idelta0 += nprim;
       idelta1 += npart;
-      incomingdata->clear();
-      delete incomingdata;
-      incomingdata = nullptr;
+      origin[index].reset();
     }
 
     //
@@ -521,49 +488,47 @@ class O2HitMerger : public FairMQDevice
   }
 
   template <typename T>
-  void remapTrackIdsAndMerge(std::string brname, TTree& origin, TTree& target,
+  void remapTrackIdsAndMerge(std::string brname, std::vector<std::unique_ptr<T>>& origin, TTree& target,
                              const std::vector<int>& trackoffsets, const std::vector<int>& nprimaries, const std::vector<int>& subevOrdered)
   {
     //
     // Remap the mother track IDs by adding an offset.
     // The offset calculated as the sum of the number of entries in the particle list of the previous subevents.
+    // The remapping is done in bulk over the range appended for each subevent.
     // This method is called by O2HitMerger::mergeAndFlushData(int)
     //
-    T* incomingdata = nullptr;
     std::unique_ptr<T> targetdata(nullptr);
-    auto originbr = origin.GetBranch(brname.c_str());
-    originbr->SetAddress(&incomingdata);
-    const auto entries = origin.GetEntries();
+    const auto entries = origin.size();
 
     if (entries == 1) {
       // nothing to do in case there is only one entry
-      originbr->GetEntry(0);
     } else {
       targetdata = std::make_unique<T>();
       // loop over subevents
       Int_t nprimTot = 0;
+      size_t nobjects = 0;
       for (auto entry = 0; entry < entries; entry++) {
         nprimTot += nprimaries[entry];
+        nobjects += origin[entry]->size();
       }
+      targetdata->reserve(nobjects);
       Int_t idelta0 = 0;
       Int_t idelta1 = nprimTot;
-      for (auto entry = entries - 1; entry >= 0; --entry) {
+      for (long entry = entries - 1; entry >= 0; --entry) {
         Int_t index = subevOrdered[entry];
         Int_t nprim = nprimaries[index];
-        originbr->GetEntry(index);
         idelta1 -= nprim;
-        for (auto& data : *incomingdata) {
-          updateTrackIdWithOffset(data, nprim, idelta0, idelta1);
-          targetdata->push_back(data);
+        auto first = targetdata->size();
+        targetdata->insert(targetdata->end(), origin[index]->begin(), origin[index]->end());
+        origin[index].reset();
+        for (auto data = targetdata->begin() + first; data != targetdata->end(); ++data) {
+          updateTrackIdWithOffset(*data, nprim, idelta0, idelta1);
         }
-        incomingdata->clear();
         idelta0 += nprim;
         idelta1 += trackoffsets[index];
-        delete incomingdata;
-        incomingdata = nullptr;
       }
     }
-    auto dataaddr = (entries == 1) ? incomingdata : targetdata.get();
+    auto dataaddr = (entries == 1) ? origin[0].get() : targetdata.get();
     auto targetbr = o2::base::getOrMakeBranch(target, brname.c_str(), &dataaddr);
     targetbr->SetAddress(&dataaddr);
     targetbr->Fill();
@@ -586,45 +551,6 @@ class O2HitMerger : public FairMQDevice
     ref.setTrackID(cId + ioffset);
   }
 
-  // this merges all entries from the TBranch brname from the origin TTree (containing one event only)
-  // into a single entry in a target TTree / same branch
-  // (assuming T is typically a vector; merging is simply done by appending)
-  template <typename T>
-  void merge(std::string brname, TTree& origin, TTree& target)
-  {
-    auto originbr = origin.GetBranch(brname.c_str());
-    auto targetdata = std::make_unique<T>();
-    T* incomingdata = nullptr;
-    originbr->SetAddress(&incomingdata);
-
-    const auto entries = origin.GetEntries();
-
-    T* filladdress = nullptr;
-    if (entries == 1) {
-      // this avoids useless copy in case there was no sub-event splitting; we just use the original data
-      originbr->GetEntry(0);
-      filladdress = incomingdata;
-    } else {
-      filladdress = targetdata.get();
-      for (auto entry = 0; entry < entries; ++entry) {
-        originbr->GetEntry(entry);
-        backInsert(*incomingdata, *targetdata);
-        delete incomingdata;
-        incomingdata = nullptr;
-      }
-    }
-
-    // fill target for this event
-    auto targetbr = o2::base::getOrMakeBranch(target, brname.c_str(), &filladdress);
-    targetbr->SetAddress(&filladdress);
-    targetbr->Fill();
-    targetbr->ResetAddress();
-    if (incomingdata) {
-      delete incomingdata;
-      incomingdata = nullptr;
-    }
-  }
-
   void initHitTreeAndOutFile(std::string prefix, int detID)
   {
     using o2::detectors::DetID;
@@ -639,8 +565,8 @@ class O2HitMerger : public FairMQDevice
     mDetectorToTTreeMap[detID]->SetDirectory(mDetectorOutFiles[detID]);
   }
 
-  // This method goes over the tree containing data for a given event; potentially merges
-  // it and flushes it into the actual output file.
+  // This method goes over the data collected for a given event; potentially merges
+  // it and flushes it into the actual output files.
   // The method can be called asynchronously to data collection
   bool mergeAndFlushData(int eventID)
   {
@@ -656,27 +582,19 @@ class O2HitMerger : public FairMQDevice
     while (canflush == true) {
       auto flusheventID = mNextFlushID;
       LOG(INFO) << "Merge and flush event " << flusheventID;
-      auto tree = mEventToTTreeMap[flusheventID];
-      if (!tree) {
-        LOG(INFO) << "NO TTREE FOUND FOR EVENT " << flusheventID;
-        if (!checkIfNextFlushable()) {
-          return false;
-        }
-      }
-
-      if (tree->GetEntries() == 0 || mNExpectedEvents == 0) {
-        LOG(INFO) << "NO ENTRY IN TTREE FOUND FOR EVENT " << flusheventID;
+      // the event is taken out of the collection; it is released at the end of this iteration
+      auto event = releaseEventParts(flusheventID);
+      if (!event || event->infos.size() == 0 || mNExpectedEvents == 0) {
+        LOG(INFO) << "NO DATA FOUND FOR EVENT " << flusheventID;
         if (!checkIfNextFlushable()) {
           return false;
         }
+        continue;
       }
 
       TStopwatch timer;
       timer.Start();
 
-      // calculate trackoffsets
-      auto infobr = tree->GetBranch("SubEventInfo");
-
       auto& confref = o2::conf::SimConfig::Instance();
 
       std::vector<int> trackoffsets; // collecting trackoffsets to be applied to correct
@@ -685,19 +603,16 @@ class O2HitMerger : public FairMQDevice
 
       o2::dataformats::MCEventHeader* eventheader = nullptr; // The event header
 
-      // the MC labels (trackID) for hits
-      o2::data::SubEventInfo* info = nullptr;
-      infobr->SetAddress(&info);
-      for (int i = 0; i < infobr->GetEntries(); ++i) {
-        infobr->GetEntry(i);
-        assert(info->npersistenttracks >= 0);
-        trackoffsets.emplace_back(info->npersistenttracks);
-        nprimaries.emplace_back(info->nprimarytracks);
-        nsubevents.emplace_back(info->part);
+      // calculate trackoffsets
+      for (auto& info : event->infos) {
+        assert(info.npersistenttracks >= 0);
+        trackoffsets.emplace_back(info.npersistenttracks);
+        nprimaries.emplace_back(info.nprimarytracks);
+        nsubevents.emplace_back(info.part);
         if (eventheader == nullptr) {
-          eventheader = &info->mMCEventHeader;
+          eventheader = &info.mMCEventHeader;
         } else {
-          eventheader->getMCEventStats().add(info->mMCEventHeader.getMCEventStats());
+          eventheader->getMCEventStats().add(info.mMCEventHeader.getMCEventStats());
         }
       }
 
@@ -705,56 +620,63 @@ class O2HitMerger : public FairMQDevice
       if (confref.isFilterOutNoHitEvents()) {
         if (eventheader && eventheader->getMCEventStats().getNHits() == 0) {
           LOG(INFO) << " Taking out event " << flusheventID << " due to no hits ";
-          cleanEvent(flusheventID);
           if (!checkIfNextFlushable()) {
             return true;
           }
+          continue;
         }
       }
 
-      // put the event headers into the new TTree
-      auto headerbr = o2::base::getOrMakeBranch(*mOutTree, "MCEventHeader.", &eventheader);
-      headerbr->SetAddress(&eventheader);
-      headerbr->Fill();
-      headerbr->ResetAddress();
-
       // attention: We need to make sure that we write everything in the same event order
       // but iteration over keys of a standard map in C++ is ordered
-
-      // b) merge the general data
-      //
-      // for MCTrack remap the motherIds and merge at the same go
-      const auto entries = tree->GetEntries();
+      const auto entries = event->infos.size();
       std::vector<int> subevOrdered((int)(nsubevents.size()));
-      for (auto entry = entries - 1; entry >= 0; --entry) {
+      for (long entry = entries - 1; entry >= 0; --entry) {
         subevOrdered[nsubevents[entry] - 1] = entry;
-        printf("HitMerger entry: %lld nprimry: %5d trackoffset: %5d \n", entry, nprimaries[entry], trackoffsets[entry]);
+        printf("HitMerger entry: %ld nprimry: %5d trackoffset: %5d \n", entry, nprimaries[entry], trackoffsets[entry]);
       }
 
-      reorderAndMergeMCTRacks(*tree, *mOutTree, nprimaries, subevOrdered);
-      Int_t ioffset = 0;
-      remapTrackIdsAndMerge<std::vector<o2::TrackReference>>("TrackRefs", *tree, *mOutTree, trackoffsets, nprimaries, subevOrdered);
-
       // c) do the merge procedure for all hits ... delegate this to detector specific functions
       // since they know about types; number of branches; etc.
       // this will also fix the trackIDs inside the hits
+      // every detector has its own output file, so this is done concurrently for the detectors
+      // while the kinematics is treated on this thread
+      std::vector<std::future<void>> hitflushes;
       for (int id = 0; id < mDetectorInstances.size(); ++id) {
-        auto& det = mDetectorInstances[id];
+        auto det = mDetectorInstances[id].get();
         if (det) {
-          auto hittree = mDetectorToTTreeMap[id];
-          det->mergeHitEntries(*tree, *hittree, trackoffsets, nprimaries, subevOrdered);
-          hittree->SetEntries(hittree->GetEntries() + 1);
-          LOG(INFO) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
-          mDetectorOutFiles[id]->Write("", TObject::kOverwrite);
+          auto hittree = mDetectorToTTreeMap.at(id);
+          auto hitfile = mDetectorOutFiles.at(id);
+          auto hits = event->hits[id].get();
+          hitflushes.emplace_back(std::async(std::launch::async, [det, hittree, hitfile, hits, &trackoffsets, &nprimaries, &subevOrdered]() {
+            det->mergeHitEntries(hits, *hittree, trackoffsets, nprimaries, subevOrdered);
+            hittree->SetEntries(hittree->GetEntries() + 1);
+            LOG(INFO) << "flushing tree to file " << hitfile->GetName();
+            hitfile->Write("", TObject::kOverwrite);
+          }));
         }
       }
 
+      // put the event headers into the new TTree
+      auto headerbr = o2::base::getOrMakeBranch(*mOutTree, "MCEventHeader.", &eventheader);
+      headerbr->SetAddress(&eventheader);
+      headerbr->Fill();
+      headerbr->ResetAddress();
+
+      // b) merge the general data
+      //
+      // for MCTrack remap the motherIds and merge at the same go
+      reorderAndMergeMCTRacks(event->tracks, *mOutTree, nprimaries, subevOrdered);
+      remapTrackIdsAndMerge<std::vector<o2::TrackReference>>("TrackRefs", event->trackrefs, *mOutTree, trackoffsets, nprimaries, subevOrdered);
+
       // increase the entry count in the tree
       mOutTree->SetEntries(mOutTree->GetEntries() + 1);
       LOG(INFO) << "outtree has file " << mOutTree->GetDirectory()->GetFile()->GetName();
       mOutFile->Write("", TObject::kOverwrite);
 
-      cleanEvent(flusheventID);
+      for (auto& flush : hitflushes) {
+        flush.get();
+      }
       LOG(INFO) << "Merge/flush for event " << flusheventID << " took " << timer.RealTime();
       if (!checkIfNextFlushable()) {
         return true;
@@ -773,10 +695,9 @@ class O2HitMerger : public FairMQDevice
   std::unordered_map<int, TTree*> mDetectorToTTreeMap; //! the trees
 
   // intermediate structures to collect data per event
-  std::unordered_map<int, TTree*> mEventToTTreeMap;       //! in memory trees to collect / presort incoming data per event
-  std::unordered_map<int, TMemFile*> mEventToTMemFileMap; //! files associated to the TTrees
-  std::thread mMergerIOThread;                            //! a thread used to do hit merging and IO flushing asynchronously
-  std::mutex mMapsMtx;                                    //!
+  std::unordered_map<int, std::unique_ptr<EventParts>> mEventParts; //! in memory buffers to collect / presort incoming data per event
+  std::thread mMergerIOThread;                                      //! a thread used to do hit merging and IO flushing asynchronously
+  std::mutex mMapsMtx;                                              //! protects mEventParts
   int mEntries = 0;         //! counts the number of entries in the branches
   int mEventChecksum = 0;   //! checksum for events
   int mNExpectedEvents = 0; //! number of events that we expect to receive
@@ -38,6 +38,10 @@
 #include <fstream>
 #include <iostream>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+#include <TRandom.h>
 #include "PrimaryServerState.h"
 #include "SimPublishChannelHelper.h"
 #include <chrono>
@@ -57,6 +61,7 @@ class O2PrimaryServerDevice final : public FairMQDevice
   ~O2PrimaryServerDevice() final
   {
     try {
+      stopPreGeneration();
       if (mGeneratorThread.joinable()) {
         mGeneratorThread.join();
       }
@@ -99,26 +104,182 @@ class O2PrimaryServerDevice final : public FairMQDevice
     }
 
     if (mPrimGen == nullptr) {
-      mPrimGen = new o2::eventgen::PrimaryGenerator;
-      o2::eventgen::GeneratorFactory::setPrimaryGenerator(conf, mPrimGen);
-
-      auto embedinto_filename = conf.getEmbedIntoFileName();
-      if (!embedinto_filename.empty()) {
-        mPrimGen->embedInto(embedinto_filename);
-      }
-
-      mPrimGen->Init();
-
+      mPrimGen = makePrimaryGenerator(conf);
       mPrimGeneratorCache[conf.getGenerator()] = mPrimGen;
     }
     mPrimGen->SetEvent(&mEventHeader);
+    initGeneratorSlots();
 
     LOG(INFO) << "Generator initialization took " << timer.CpuTime() << "s";
     if (mMaxEvents > 0) {
-      generateEvent(); // generate a first event
+      if (mGeneratorSlots.empty()) {
+        generateEvent(); // generate a first event
+      } else {
+        startPreGeneration();
+      }
     }
   }
 
+  o2::eventgen::PrimaryGenerator* makePrimaryGenerator(o2::conf::SimConfig const& conf)
+  {
+    auto primGen = new o2::eventgen::PrimaryGenerator;
+    o2::eventgen::GeneratorFactory::setPrimaryGenerator(conf, primGen);
+
+    auto embedinto_filename = conf.getEmbedIntoFileName();
+    if (!embedinto_filename.empty()) {
+      primGen->embedInto(embedinto_filename);
+    }
+
+    primGen->Init();
+    return primGen;
+  }
+
+  // sets up one generator instance per pre-generation thread (the first one being mPrimGen);
+  // leaves mGeneratorSlots empty if the events have to be generated on demand
+  void initGeneratorSlots()
+  {
+    const auto& conf = mSimConfig;
+    mGeneratorSlots.clear();
+    if (mNGenThreads <= 1) {
+      return;
+    }
+    if (!conf.getEmbedIntoFileName().empty()) {
+      // each instance would walk through the background events on its own
+      LOG(WARN) << "Generating events in advance is not supported for embedding; generating on demand";
+      return;
+    }
+
+    auto& cached = mPreGenGeneratorCache[conf.getGenerator()];
+    std::vector<o2::eventgen::PrimaryGenerator*> primGens{mPrimGen};
+    for (int slotID = 1; slotID < mNGenThreads; ++slotID) {
+      if (cached.size() < slotID) {
+        cached.push_back(makePrimaryGenerator(conf));
+      }
+      primGens.push_back(cached[slotID - 1]);
+    }
+
+    // the events only depend on their seed if every generator owns its random numbers,
+    // gRandom is shared by all instances
+    for (auto primGen : primGens) {
+      auto generators = primGen->GetListOfGenerators();
+      for (int igen = 0; igen < generators->GetEntries(); ++igen) {
+        auto o2gen = dynamic_cast<o2::eventgen::Generator*>(generators->At(igen));
+        if (!o2gen || !o2gen->setEventSeed(0)) {
+          LOG(WARN) << "Generator " << generators->At(igen)->GetName() << " has no random numbers of its own; generating events on demand";
+          return;
+        }
+      }
+    }
+
+    mGeneratorSlots.resize(primGens.size());
+    for (int slotID = 0; slotID < primGens.size(); ++slotID) {
+      auto& slot = mGeneratorSlots[slotID];
+      slot.primGen = primGens[slotID];
+      slot.stack = std::make_unique<o2::data::Stack>();
+      slot.stack->setExternalMode(true);
+      slot.primGen->SetEvent(&slot.header);
+    }
+    LOG(INFO) << "Generating events in advance with " << mGeneratorSlots.size() << " threads";
+  }
+
+  // the seed of the generators for a given event
+  unsigned int getEventSeed(int eventID) const
+  {
+    return (unsigned int)mInitialSeed * 2654435761u + eventID;
+  }
+
+  // generates the events eventID = slotID + 1 + k * nthreads with the generator of the slot
+  void preGenerateEvents(int slotID)
+  {
+    auto& slot = mGeneratorSlots[slotID];
+    const int nthreads = mGeneratorSlots.size();
+    for (int eventID = slotID + 1; eventID <= mMaxEvents; eventID += nthreads) {
+      {
+        // do not run too far ahead of the events being served
+        std::unique_lock<std::mutex> lock(mGeneratedEventsMtx);
+        mGeneratedEventsCV.wait(lock, [&]() { return mStopPreGeneration || eventID <= mNTakenEvents + 2 * nthreads; });
+        if (mStopPreGeneration) {
+          return;
+        }
+      }
+      TStopwatch timer;
+      timer.Start();
+      const auto seed = getEventSeed(eventID);
+      GeneratedEvent event;
+      try {
+        // the (expensive) generate-and-trigger loop only draws from the random numbers of this instance ...
+        auto generators = slot.primGen->GetListOfGenerators();
+        for (int igen = 0; igen < generators->GetEntries(); ++igen) {
+          auto o2gen = static_cast<o2::eventgen::Generator*>(generators->At(igen));
+          o2gen->setEventSeed(seed);
+          o2gen->prepareEvent();
+        }
+        // ... while the vertex is drawn from gRandom which is shared
+        std::lock_guard<std::mutex> lock(mGRandomMtx);
+        gRandom->SetSeed(seed);
+        slot.stack->Reset();
+        slot.primGen->GenerateEvent(slot.stack.get());
+        event.primaries = slot.stack->getPrimaries();
+        event.header = slot.header;
+      } catch (std::exception const& e) {
+        LOG(ERROR) << " Exception occurred during event gen ";
+      }
+      timer.Stop();
+      LOG(INFO) << "Event " << eventID << " generation took " << timer.CpuTime() << "s"
+                << " and produced " << event.primaries.size() << " primaries ";
+      {
+        std::lock_guard<std::mutex> lock(mGeneratedEventsMtx);
+        mGeneratedEvents.emplace(eventID, std::move(event));
+      }
+      mGeneratedEventsCV.notify_all();
+    }
+  }
+
+  void startPreGeneration()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mGeneratedEventsMtx);
+      mStopPreGeneration = false;
+      mNTakenEvents = 0;
+    }
+    for (int slotID = 0; slotID < mGeneratorSlots.size(); ++slotID) {
+      mPreGenerationThreads.emplace_back(&O2PrimaryServerDevice::preGenerateEvents, this, slotID);
+    }
+  }
+
+  void stopPreGeneration()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mGeneratedEventsMtx);
+      mStopPreGeneration = true;
+    }
+    mGeneratedEventsCV.notify_all();
+    for (auto& thread : mPreGenerationThreads) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    mPreGenerationThreads.clear();
+    mGeneratedEvents.clear();
+  }
+
+  // makes the event generated in advance the current one (waiting for it if needed)
+  void takeGeneratedEvent(int eventID)
+  {
+    std::unique_lock<std::mutex> lock(mGeneratedEventsMtx);
+    mGeneratedEventsCV.wait(lock, [&]() { return mStopPreGeneration || mGeneratedEvents.find(eventID) != mGeneratedEvents.end(); });
+    auto iter = mGeneratedEvents.find(eventID);
+    if (iter == mGeneratedEvents.end()) {
+      mCurrentEvent = GeneratedEvent{};
+      return;
+    }
+    mCurrentEvent = std::move(iter->second);
+    mGeneratedEvents.erase(iter);
+    mNTakenEvents = eventID;
+    lock.unlock();
+    mGeneratedEventsCV.notify_all();
+  }
+
   // function generating one event
   void generateEvent(/*bool changeState = false*/)
   {
@@ -219,6 +380,7 @@ class O2PrimaryServerDevice final : public FairMQDevice
     LOG(INFO) << "RNG INITIAL SEED " << mInitialSeed;
 
     mMaxEvents = conf.getNEvents();
+    mNGenThreads = vm["genThreads"].as<int>();
 
     // need to make ROOT thread-safe since we use ROOT services in all places
     ROOT::EnableThreadSafety();
@@ -261,6 +423,8 @@ class O2PrimaryServerDevice final : public FairMQDevice
     if (reconfig.stop) {
       return false;
     }
+    // the events generated in advance belong to the previous configuration
+    stopPreGeneration();
 
     // mSimConfig.getConfigData().mKeyValueTokens=reconfig.keyValueTokens;
     // Think about this:
@@ -410,9 +574,13 @@ class O2PrimaryServerDevice final : public FairMQDevice
       mNeedNewEvent = false;
       mPartCounter = 0;
       mEventCounter++;
+      if (!mGeneratorSlots.empty() && mEventCounter <= mMaxEvents) {
+        takeGeneratedEvent(mEventCounter);
+      }
     }
 
-    auto& prims = mStack->getPrimaries();
+    const bool pregenerated = !mGeneratorSlots.empty();
+    auto& prims = pregenerated ? mCurrentEvent.primaries : mStack->getPrimaries();
     auto numberofparts = (int)std::ceil(prims.size() / (1. * mChunkGranularity));
     // number of parts should be at least 1 (even if empty)
     numberofparts = std::max(1, numberofparts);
@@ -427,7 +595,7 @@ class O2PrimaryServerDevice final : public FairMQDevice
     i.nparts = numberofparts;
     i.seed = mEventCounter + mInitialSeed;
     i.index = m.mParticles.size();
-    i.mMCEventHeader = mEventHeader;
+    i.mMCEventHeader = pregenerated ? mCurrentEvent.header : mEventHeader;
     m.mSubEventInfo = i;
 
     if (workavailable) {
@@ -458,8 +626,10 @@ class O2PrimaryServerDevice final : public FairMQDevice
       mPartCounter++;
       if (mPartCounter == numberofparts) {
         mNeedNewEvent = true;
-        // start generation of a new event
-        mGeneratorThread = std::thread(&O2PrimaryServerDevice::generateEvent, this);
+        // start generation of a new event (unless it is generated in advance)
+        if (!pregenerated) {
+          mGeneratorThread = std::thread(&O2PrimaryServerDevice::generateEvent, this);
+        }
       }
 
       TMessage* tmsg = new TMessage(kMESS_OBJECT);
@@ -564,6 +734,28 @@ class O2PrimaryServerDevice final : public FairMQDevice
   //       and that parameter-based reconfiguration is not yet implemented (for which we would need to hash all
   //       configuration parameters as well)
   std::map<std::string, o2::eventgen::PrimaryGenerator*> mPrimGeneratorCache;
+  std::map<std::string, std::vector<o2::eventgen::PrimaryGenerator*>> mPreGenGeneratorCache; // additional instances for pre-generation
+
+  // generation of events in advance by several threads, each with its own generator instance
+  struct GeneratorSlot {
+    o2::eventgen::PrimaryGenerator* primGen = nullptr;
+    std::unique_ptr<o2::data::Stack> stack;
+    o2::dataformats::MCEventHeader header;
+  };
+  struct GeneratedEvent {
+    std::vector<TParticle> primaries;
+    o2::dataformats::MCEventHeader header;
+  };
+  int mNGenThreads = 1;                                 // number of threads generating events in advance (<= 1: on demand)
+  std::vector<GeneratorSlot> mGeneratorSlots;           //! generator instances of the threads (empty if generating on demand)
+  std::vector<std::thread> mPreGenerationThreads;       //!
+  std::map<int, GeneratedEvent> mGeneratedEvents;       //! events generated in advance, by event ID
+  GeneratedEvent mCurrentEvent;                         //! event being served (when generated in advance)
+  int mNTakenEvents = 0;                                //! ID of the last event taken from mGeneratedEvents
+  bool mStopPreGeneration = false;                      //!
+  std::mutex mGeneratedEventsMtx;                       //! protects the above
+  std::condition_variable mGeneratedEventsCV;           //!
+  std::mutex mGRandomMtx;                               //! gRandom is shared by the generator instances
 
   std::atomic<O2PrimaryServerState> mState{O2PrimaryServerState::Initializing};
   std::atomic<int> mWaitingControlInput{0};
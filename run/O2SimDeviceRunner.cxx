@@ -25,6 +25,10 @@
 #include <pthread.h> // to set cpu affinity
 #include <cmath>
 #include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 #include <unistd.h>
 #include "SimPublishChannelHelper.h"
 
@@ -204,6 +208,35 @@ void pinToCPU(unsigned int cpuid)
   }
 }
 
+// reports how much of the memory of a (forked) worker is still shared with the other workers
+void logSharedMemory(int workerID)
+{
+#ifndef __APPLE__
+  std::ifstream smaps("/proc/self/smaps_rollup");
+  std::string line;
+  long rss = 0, pss = 0, shared = 0, priv = 0;
+  while (std::getline(smaps, line)) {
+    std::istringstream entry(line);
+    std::string key;
+    long kb = 0;
+    entry >> key >> kb;
+    if (key == "Rss:") {
+      rss = kb;
+    } else if (key == "Pss:") {
+      pss = kb;
+    } else if (key == "Shared_Clean:" || key == "Shared_Dirty:") {
+      shared += kb;
+    } else if (key == "Private_Clean:" || key == "Private_Dirty:") {
+      priv += kb;
+    }
+  }
+  if (rss > 0) {
+    LOG(INFO) << "[W" << workerID << "] MEMORY RSS " << rss / 1024 << " MB, PSS " << pss / 1024 << " MB, SHARED "
+              << shared / 1024 << " MB, PRIVATE " << priv / 1024 << " MB";
+  }
+#endif
+}
+
 bool waitForControlInput()
 {
   auto factory = FairMQTransportFactory::CreateTransportFactory("zeromq");
@@ -360,6 +393,10 @@ int main(int argc, char* argv[])
     for (auto i = 0u; i < nworkers; ++i) {
       // we use the current process as one of the workers as it has nothing else to do
       auto pid = (i == nworkers - 1) ? 0 : fork();
+      if (pid < 0) {
+        LOG(ERROR) << "Could not fork sim worker " << i << ": " << strerror(errno);
+        continue;
+      }
       if (pid == 0) {
         // Each worker can publish its progress/state on a ZMQ channel.
         // We actually use a push/pull mechanism to collect all messages in the
@@ -397,12 +434,14 @@ int main(int argc, char* argv[])
         std::stringstream worker;
         worker << "WORKER" << i;
         o2::simpubsub::publishMessage(pushchannel, o2::simpubsub::simStatusString(worker.str(), "STATUS", "SETUP COMPLETED"));
+        logSharedMemory(i);
 
         auto& conf = o2::conf::SimConfig::Instance();
 
         bool more = true;
         while (more) {
           runSim(kernelSetup);
+          logSharedMemory(i);
 
           if (conf.asService()) {
             LOG(INFO) << "IN SERVICE MODE WAITING";